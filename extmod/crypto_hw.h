@@ -0,0 +1,51 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MICROPY_INCLUDED_EXTMOD_CRYPTO_HW_H
+#define MICROPY_INCLUDED_EXTMOD_CRYPTO_HW_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Crypto engine hooks, implemented by the port for MICROPY_PY_UHASHLIB_HW and
+// MICROPY_PY_UCRYPTOLIB_HW. Buffers are handed over as they are, which may be
+// unaligned and anywhere in RAM, the port does any cache maintenance. All return
+// 0 on success.
+
+#define MP_HW_HASH_SHA1     (0)
+#define MP_HW_HASH_SHA256   (1)
+
+// Size of the context the hash functions work on, it is in the hash object and
+// may be copied to take a digest without ending the hash.
+extern const size_t mp_hw_hash_ctx_size;
+int mp_hw_hash_init(void *ctx, int algo);
+int mp_hw_hash_update(void *ctx, const uint8_t *buf, size_t len);
+// out is 20 or 32 bytes.
+int mp_hw_hash_final(void *ctx, uint8_t *out);
+
+// AES-128 over len bytes (a multiple of 16). ECB if iv is NULL, else CBC with iv
+// updated to chain into the next call. in and out may be the same buffer.
+int mp_hw_aes(const uint8_t key[16], uint8_t iv[16], const uint8_t *in, uint8_t *out, size_t len, bool encrypt);
+
+#endif // MICROPY_INCLUDED_EXTMOD_CRYPTO_HW_H
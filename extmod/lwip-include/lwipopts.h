@@ -14,9 +14,33 @@ typedef uint32_t sys_prot_t;
 
 #define TCP_LISTEN_BACKLOG 1
 
-// We'll put these into a proper ifdef once somebody implements an ethernet driver
+#ifdef MICROPY_PY_LWIP_ETH
+#define LWIP_ARP 1
+#define LWIP_ETHERNET 1
+#define LWIP_DHCP 1
+#define LWIP_IGMP 1
+// The port's hardware RNG, for the IGMP report delays and DHCP transaction ids.
+uint32_t rng_get(void);
+#define LWIP_RAND() rng_get()
+
+#define TCP_MSS 1460
+#define TCP_WND (4 * TCP_MSS)
+#define TCP_SND_BUF (4 * TCP_MSS)
+#define MEM_SIZE (16 * 1024)
+#define MEM_ALIGNMENT 4
+
+// The MAC inserts and checks the checksums.
+#define CHECKSUM_GEN_IP 0
+#define CHECKSUM_GEN_UDP 0
+#define CHECKSUM_GEN_TCP 0
+#define CHECKSUM_GEN_ICMP 0
+#define CHECKSUM_CHECK_IP 0
+#define CHECKSUM_CHECK_UDP 0
+#define CHECKSUM_CHECK_TCP 0
+#else
 #define LWIP_ARP 0
 #define LWIP_ETHERNET 0
+#endif
 
 #define LWIP_DNS 1
 
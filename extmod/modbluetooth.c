@@ -57,7 +57,7 @@ STATIC const mp_obj_type_t bluetooth_uuid_type;
 typedef struct {
     mp_obj_base_t base;
     mp_obj_t irq_handler;
-    uint16_t irq_trigger;
+    uint32_t irq_trigger;
     bool irq_scheduled;
     mp_obj_t irq_data_tuple;
     uint8_t irq_data_addr_bytes[6];
@@ -293,6 +293,8 @@ STATIC mp_obj_t bluetooth_ble_config(size_t n_args, const mp_obj_t *args, mp_map
                 mp_bluetooth_get_device_addr(addr);
                 return mp_obj_new_bytes(addr, MP_ARRAY_SIZE(addr));
             }
+            case MP_QSTR_mtu:
+                return MP_OBJ_NEW_SMALL_INT(mp_bluetooth_get_preferred_mtu());
             default:
                 mp_raise_ValueError("unknown config param");
         }
@@ -339,6 +341,9 @@ STATIC mp_obj_t bluetooth_ble_config(size_t n_args, const mp_obj_t *args, mp_map
                         m_del(uint8_t, old_irq_data_buf, old_irq_data_alloc);
                         break;
                     }
+                    case MP_QSTR_mtu:
+                        bluetooth_handle_errno(mp_bluetooth_set_preferred_mtu(mp_obj_get_int(e->value)));
+                        break;
                     default:
                         mp_raise_ValueError("unknown config param");
                 }
@@ -642,6 +647,8 @@ STATIC mp_obj_t bluetooth_ble_gatts_notify(size_t n_args, const mp_obj_t *args)
     mp_int_t value_handle = mp_obj_get_int(args[2]);
 
     if (n_args == 4) {
+        // Sent straight from the buffer, a memoryview of a large one takes no copy and returns
+        // the bytes that fit the MTU.
         mp_buffer_info_t bufinfo = {0};
         mp_get_buffer_raise(args[3], &bufinfo, MP_BUFFER_READ);
         size_t len = bufinfo.len;
@@ -665,6 +672,12 @@ STATIC mp_obj_t bluetooth_ble_gatts_set_buffer(size_t n_args, const mp_obj_t *ar
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(bluetooth_ble_gatts_set_buffer_obj, 3, 4, bluetooth_ble_gatts_set_buffer);
 
+STATIC mp_obj_t bluetooth_ble_gattc_exchange_mtu(mp_obj_t self_in, mp_obj_t conn_handle_in) {
+    mp_int_t conn_handle = mp_obj_get_int(conn_handle_in);
+    return bluetooth_handle_errno(mp_bluetooth_gattc_exchange_mtu(conn_handle));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(bluetooth_ble_gattc_exchange_mtu_obj, bluetooth_ble_gattc_exchange_mtu);
+
 // ----------------------------------------------------------------------------
 // Bluetooth object: GATTC (Central/Scanner role)
 // ----------------------------------------------------------------------------
@@ -717,6 +730,62 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(bluetooth_ble_gattc_write_obj, 4, 5,
 
 #endif // MICROPY_PY_BLUETOOTH_ENABLE_CENTRAL_MODE
 
+// ----------------------------------------------------------------------------
+// Bluetooth object: L2CAP connection-oriented channels
+// ----------------------------------------------------------------------------
+
+#if MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+
+STATIC mp_obj_t bluetooth_ble_l2cap_listen(mp_obj_t self_in, mp_obj_t psm_in, mp_obj_t mtu_in) {
+    mp_int_t psm = mp_obj_get_int(psm_in);
+    mp_int_t mtu = mp_obj_get_int(mtu_in);
+    return bluetooth_handle_errno(mp_bluetooth_l2cap_listen(psm, mtu));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(bluetooth_ble_l2cap_listen_obj, bluetooth_ble_l2cap_listen);
+
+STATIC mp_obj_t bluetooth_ble_l2cap_connect(size_t n_args, const mp_obj_t *args) {
+    mp_int_t conn_handle = mp_obj_get_int(args[1]);
+    mp_int_t psm = mp_obj_get_int(args[2]);
+    mp_int_t mtu = mp_obj_get_int(args[3]);
+    return bluetooth_handle_errno(mp_bluetooth_l2cap_connect(conn_handle, psm, mtu));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(bluetooth_ble_l2cap_connect_obj, 4, 4, bluetooth_ble_l2cap_connect);
+
+STATIC mp_obj_t bluetooth_ble_l2cap_disconnect(mp_obj_t self_in, mp_obj_t conn_handle_in, mp_obj_t cid_in) {
+    mp_int_t conn_handle = mp_obj_get_int(conn_handle_in);
+    mp_int_t cid = mp_obj_get_int(cid_in);
+    return bluetooth_handle_errno(mp_bluetooth_l2cap_disconnect(conn_handle, cid));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(bluetooth_ble_l2cap_disconnect_obj, bluetooth_ble_l2cap_disconnect);
+
+// Returns False when the channel stalled, wait for the send ready event before the next one.
+STATIC mp_obj_t bluetooth_ble_l2cap_send(size_t n_args, const mp_obj_t *args) {
+    mp_int_t conn_handle = mp_obj_get_int(args[1]);
+    mp_int_t cid = mp_obj_get_int(args[2]);
+    mp_buffer_info_t bufinfo = {0};
+    mp_get_buffer_raise(args[3], &bufinfo, MP_BUFFER_READ);
+    bool stalled = false;
+    bluetooth_handle_errno(mp_bluetooth_l2cap_send(conn_handle, cid, bufinfo.buf, bufinfo.len, &stalled));
+    return mp_obj_new_bool(!stalled);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(bluetooth_ble_l2cap_send_obj, 4, 4, bluetooth_ble_l2cap_send);
+
+// Returns the bytes read into buf, or pending when buf is None.
+STATIC mp_obj_t bluetooth_ble_l2cap_recvinto(size_t n_args, const mp_obj_t *args) {
+    mp_int_t conn_handle = mp_obj_get_int(args[1]);
+    mp_int_t cid = mp_obj_get_int(args[2]);
+    mp_buffer_info_t bufinfo = {0};
+    if (args[3] != mp_const_none) {
+        mp_get_buffer_raise(args[3], &bufinfo, MP_BUFFER_WRITE);
+    }
+    size_t len = bufinfo.len;
+    bluetooth_handle_errno(mp_bluetooth_l2cap_recvinto(conn_handle, cid, bufinfo.buf, &len));
+    return MP_OBJ_NEW_SMALL_INT(len);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(bluetooth_ble_l2cap_recvinto_obj, 4, 4, bluetooth_ble_l2cap_recvinto);
+
+#endif // MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+
 // ----------------------------------------------------------------------------
 // Bluetooth object: Definition
 // ----------------------------------------------------------------------------
@@ -739,6 +808,7 @@ STATIC const mp_rom_map_elem_t bluetooth_ble_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_gatts_write), MP_ROM_PTR(&bluetooth_ble_gatts_write_obj) },
     { MP_ROM_QSTR(MP_QSTR_gatts_notify), MP_ROM_PTR(&bluetooth_ble_gatts_notify_obj) },
     { MP_ROM_QSTR(MP_QSTR_gatts_set_buffer), MP_ROM_PTR(&bluetooth_ble_gatts_set_buffer_obj) },
+    { MP_ROM_QSTR(MP_QSTR_gattc_exchange_mtu), MP_ROM_PTR(&bluetooth_ble_gattc_exchange_mtu_obj) },
     #if MICROPY_PY_BLUETOOTH_ENABLE_CENTRAL_MODE
     // GATT Client (i.e. central/scanner role)
     { MP_ROM_QSTR(MP_QSTR_gattc_discover_services), MP_ROM_PTR(&bluetooth_ble_gattc_discover_services_obj) },
@@ -747,6 +817,14 @@ STATIC const mp_rom_map_elem_t bluetooth_ble_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_gattc_read), MP_ROM_PTR(&bluetooth_ble_gattc_read_obj) },
     { MP_ROM_QSTR(MP_QSTR_gattc_write), MP_ROM_PTR(&bluetooth_ble_gattc_write_obj) },
     #endif
+    #if MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+    // L2CAP connection-oriented channels
+    { MP_ROM_QSTR(MP_QSTR_l2cap_listen), MP_ROM_PTR(&bluetooth_ble_l2cap_listen_obj) },
+    { MP_ROM_QSTR(MP_QSTR_l2cap_connect), MP_ROM_PTR(&bluetooth_ble_l2cap_connect_obj) },
+    { MP_ROM_QSTR(MP_QSTR_l2cap_disconnect), MP_ROM_PTR(&bluetooth_ble_l2cap_disconnect_obj) },
+    { MP_ROM_QSTR(MP_QSTR_l2cap_send), MP_ROM_PTR(&bluetooth_ble_l2cap_send_obj) },
+    { MP_ROM_QSTR(MP_QSTR_l2cap_recvinto), MP_ROM_PTR(&bluetooth_ble_l2cap_recvinto_obj) },
+    #endif
 };
 STATIC MP_DEFINE_CONST_DICT(bluetooth_ble_locals_dict, bluetooth_ble_locals_dict_table);
 
@@ -836,6 +914,8 @@ STATIC mp_obj_t bluetooth_ble_invoke_irq(mp_obj_t none_in) {
             MICROPY_PY_BLUETOOTH_EXIT
             break;
         }
+        // The ringbuf holds the bit number.
+        event = 1 << event;
 
         // Although we're in schedule context, this code still avoids using any allocations:
         //  - IRQs are disabled (to protect the ringbuf), and we need to avoid triggering GC
@@ -850,6 +930,23 @@ STATIC mp_obj_t bluetooth_ble_invoke_irq(mp_obj_t none_in) {
         } else if (event == MP_BLUETOOTH_IRQ_GATTS_WRITE) {
             // conn_handle, value_handle
             ringbuf_extract(&o->ringbuf, data_tuple, 2, 0, NULL, 0, 0, NULL, NULL);
+        } else if (event == MP_BLUETOOTH_IRQ_MTU_EXCHANGED) {
+            // conn_handle, mtu
+            ringbuf_extract(&o->ringbuf, data_tuple, 2, 0, NULL, 0, 0, NULL, NULL);
+        #if MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+        } else if (event == MP_BLUETOOTH_IRQ_L2CAP_ACCEPT || event == MP_BLUETOOTH_IRQ_L2CAP_CONNECT) {
+            // conn_handle, cid, psm, our_mtu, peer_mtu
+            ringbuf_extract(&o->ringbuf, data_tuple, 5, 0, NULL, 0, 0, NULL, NULL);
+        } else if (event == MP_BLUETOOTH_IRQ_L2CAP_DISCONNECT) {
+            // conn_handle, cid, psm, status
+            ringbuf_extract(&o->ringbuf, data_tuple, 4, 0, NULL, 0, 0, NULL, NULL);
+        } else if (event == MP_BLUETOOTH_IRQ_L2CAP_RECV) {
+            // conn_handle, cid
+            ringbuf_extract(&o->ringbuf, data_tuple, 2, 0, NULL, 0, 0, NULL, NULL);
+        } else if (event == MP_BLUETOOTH_IRQ_L2CAP_SEND_READY) {
+            // conn_handle, cid, status
+            ringbuf_extract(&o->ringbuf, data_tuple, 2, 1, NULL, 0, 0, NULL, NULL);
+        #endif // MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
         #if MICROPY_PY_BLUETOOTH_ENABLE_CENTRAL_MODE
         } else if (event == MP_BLUETOOTH_IRQ_SCAN_RESULT) {
             // addr_type, addr, connectable, rssi, adv_data
@@ -891,7 +988,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(bluetooth_ble_invoke_irq_obj, bluetooth_ble_inv
 // Callbacks are called in interrupt context (i.e. can't allocate), so we need to push the data
 // into the ringbuf and schedule the callback via mp_sched_schedule.
 
-STATIC bool enqueue_irq(mp_obj_bluetooth_ble_t *o, size_t len, uint16_t event) {
+STATIC bool enqueue_irq(mp_obj_bluetooth_ble_t *o, size_t len, uint32_t event) {
     if (!o || !(o->irq_trigger & event) || o->irq_handler == mp_const_none) {
         return false;
     }
@@ -900,7 +997,7 @@ STATIC bool enqueue_irq(mp_obj_bluetooth_ble_t *o, size_t len, uint16_t event) {
         // Ringbuffer doesn't have room (and is therefore non-empty).
 
         // If this is another scan result, or the front of the ringbuffer isn't a scan result, then nothing to do.
-        if (event == MP_BLUETOOTH_IRQ_SCAN_RESULT || ringbuf_peek16(&o->ringbuf) != MP_BLUETOOTH_IRQ_SCAN_RESULT) {
+        if (event == MP_BLUETOOTH_IRQ_SCAN_RESULT || ringbuf_peek16(&o->ringbuf) != __builtin_ctz(MP_BLUETOOTH_IRQ_SCAN_RESULT)) {
             return false;
         }
 
@@ -919,7 +1016,7 @@ STATIC bool enqueue_irq(mp_obj_bluetooth_ble_t *o, size_t len, uint16_t event) {
     }
 
     // Append this event, the caller will then append the arguments.
-    ringbuf_put16(&o->ringbuf, event);
+    ringbuf_put16(&o->ringbuf, __builtin_ctz(event));
     return true;
 }
 
@@ -956,6 +1053,69 @@ void mp_bluetooth_gatts_on_write(uint16_t conn_handle, uint16_t value_handle) {
     MICROPY_PY_BLUETOOTH_EXIT
 }
 
+void mp_bluetooth_gatts_on_mtu_exchanged(uint16_t conn_handle, uint16_t value) {
+    MICROPY_PY_BLUETOOTH_ENTER
+    mp_obj_bluetooth_ble_t *o = MP_OBJ_TO_PTR(MP_STATE_VM(bluetooth));
+    if (enqueue_irq(o, 2 + 2, MP_BLUETOOTH_IRQ_MTU_EXCHANGED)) {
+        ringbuf_put16(&o->ringbuf, conn_handle);
+        ringbuf_put16(&o->ringbuf, value);
+    }
+    schedule_ringbuf();
+    MICROPY_PY_BLUETOOTH_EXIT
+}
+
+#if MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+void mp_bluetooth_on_l2cap_connect(uint16_t event, uint16_t conn_handle, uint16_t cid, uint16_t psm, uint16_t our_mtu, uint16_t peer_mtu) {
+    MICROPY_PY_BLUETOOTH_ENTER
+    mp_obj_bluetooth_ble_t *o = MP_OBJ_TO_PTR(MP_STATE_VM(bluetooth));
+    if (enqueue_irq(o, 2 + 2 + 2 + 2 + 2, event)) {
+        ringbuf_put16(&o->ringbuf, conn_handle);
+        ringbuf_put16(&o->ringbuf, cid);
+        ringbuf_put16(&o->ringbuf, psm);
+        ringbuf_put16(&o->ringbuf, our_mtu);
+        ringbuf_put16(&o->ringbuf, peer_mtu);
+    }
+    schedule_ringbuf();
+    MICROPY_PY_BLUETOOTH_EXIT
+}
+
+void mp_bluetooth_on_l2cap_disconnect(uint16_t conn_handle, uint16_t cid, uint16_t psm, uint16_t status) {
+    MICROPY_PY_BLUETOOTH_ENTER
+    mp_obj_bluetooth_ble_t *o = MP_OBJ_TO_PTR(MP_STATE_VM(bluetooth));
+    if (enqueue_irq(o, 2 + 2 + 2 + 2, MP_BLUETOOTH_IRQ_L2CAP_DISCONNECT)) {
+        ringbuf_put16(&o->ringbuf, conn_handle);
+        ringbuf_put16(&o->ringbuf, cid);
+        ringbuf_put16(&o->ringbuf, psm);
+        ringbuf_put16(&o->ringbuf, status);
+    }
+    schedule_ringbuf();
+    MICROPY_PY_BLUETOOTH_EXIT
+}
+
+void mp_bluetooth_on_l2cap_recv(uint16_t conn_handle, uint16_t cid) {
+    MICROPY_PY_BLUETOOTH_ENTER
+    mp_obj_bluetooth_ble_t *o = MP_OBJ_TO_PTR(MP_STATE_VM(bluetooth));
+    if (enqueue_irq(o, 2 + 2, MP_BLUETOOTH_IRQ_L2CAP_RECV)) {
+        ringbuf_put16(&o->ringbuf, conn_handle);
+        ringbuf_put16(&o->ringbuf, cid);
+    }
+    schedule_ringbuf();
+    MICROPY_PY_BLUETOOTH_EXIT
+}
+
+void mp_bluetooth_on_l2cap_send_ready(uint16_t conn_handle, uint16_t cid, uint8_t status) {
+    MICROPY_PY_BLUETOOTH_ENTER
+    mp_obj_bluetooth_ble_t *o = MP_OBJ_TO_PTR(MP_STATE_VM(bluetooth));
+    if (enqueue_irq(o, 2 + 2 + 1, MP_BLUETOOTH_IRQ_L2CAP_SEND_READY)) {
+        ringbuf_put16(&o->ringbuf, conn_handle);
+        ringbuf_put16(&o->ringbuf, cid);
+        ringbuf_put(&o->ringbuf, status);
+    }
+    schedule_ringbuf();
+    MICROPY_PY_BLUETOOTH_EXIT
+}
+#endif // MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+
 #if MICROPY_PY_BLUETOOTH_ENABLE_CENTRAL_MODE
 void mp_bluetooth_gap_on_scan_complete(void) {
     MICROPY_PY_BLUETOOTH_ENTER
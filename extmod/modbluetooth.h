@@ -47,6 +47,11 @@
 #define MICROPY_PY_BLUETOOTH_GATTS_ON_READ_CALLBACK (0)
 #endif
 
+// Connection-oriented L2CAP channels (bulk transfers with credit-based flow control).
+#ifndef MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+#define MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS (0)
+#endif
+
 // This is used to protect the ringbuffer.
 #ifndef MICROPY_PY_BLUETOOTH_ENTER
 #define MICROPY_PY_BLUETOOTH_ENTER mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
@@ -86,8 +91,7 @@
 // Event codes for the IRQ handler.
 // Can also be combined to pass to the trigger param to select which events you
 // are interested in.
-// Note this is currently stored in a uint16_t (in irq_trigger, and the event
-// arg to the irq handler), so one spare value remaining.
+// irq_trigger is a uint32_t, the ringbuf holds the bit number of the event.
 #define MP_BLUETOOTH_IRQ_CENTRAL_CONNECT              (1 << 0)
 #define MP_BLUETOOTH_IRQ_CENTRAL_DISCONNECT           (1 << 1)
 #define MP_BLUETOOTH_IRQ_GATTS_WRITE                  (1 << 2)
@@ -103,7 +107,13 @@
 #define MP_BLUETOOTH_IRQ_GATTC_WRITE_STATUS           (1 << 12)
 #define MP_BLUETOOTH_IRQ_GATTC_NOTIFY                 (1 << 13)
 #define MP_BLUETOOTH_IRQ_GATTC_INDICATE               (1 << 14)
-#define MP_BLUETOOTH_IRQ_ALL                          (0xffff)
+#define MP_BLUETOOTH_IRQ_MTU_EXCHANGED                (1 << 15)
+#define MP_BLUETOOTH_IRQ_L2CAP_ACCEPT                 (1 << 16)
+#define MP_BLUETOOTH_IRQ_L2CAP_CONNECT                (1 << 17)
+#define MP_BLUETOOTH_IRQ_L2CAP_DISCONNECT             (1 << 18)
+#define MP_BLUETOOTH_IRQ_L2CAP_RECV                   (1 << 19)
+#define MP_BLUETOOTH_IRQ_L2CAP_SEND_READY             (1 << 20)
+#define MP_BLUETOOTH_IRQ_ALL                          (0x1fffff)
 
 /*
 These aren't included in the module for space reasons, but can be used
@@ -125,7 +135,13 @@ _IRQ_GATTC_READ_RESULT               = const(1 << 11)
 _IRQ_GATTC_WRITE_STATUS              = const(1 << 12)
 _IRQ_GATTC_NOTIFY                    = const(1 << 13)
 _IRQ_GATTC_INDICATE                  = const(1 << 14)
-_IRQ_ALL                             = const(0xffff)
+_IRQ_MTU_EXCHANGED                   = const(1 << 15)
+_IRQ_L2CAP_ACCEPT                    = const(1 << 16)
+_IRQ_L2CAP_CONNECT                   = const(1 << 17)
+_IRQ_L2CAP_DISCONNECT                = const(1 << 18)
+_IRQ_L2CAP_RECV                      = const(1 << 19)
+_IRQ_L2CAP_SEND_READY                = const(1 << 20)
+_IRQ_ALL                             = const(0x1fffff)
 */
 
 // Common UUID type.
@@ -189,6 +205,7 @@ int mp_bluetooth_gatts_write(uint16_t value_handle, const uint8_t *value, size_t
 // Notify the central that it should do a read.
 int mp_bluetooth_gatts_notify(uint16_t conn_handle, uint16_t value_handle);
 // Notify the central, including a data payload. (Note: does not set the gatts db value).
+// Sends at most ATT MTU - 3 bytes straight from value, value_len is updated to the bytes sent.
 int mp_bluetooth_gatts_notify_send(uint16_t conn_handle, uint16_t value_handle, const uint8_t *value, size_t *value_len);
 // Indicate the central.
 int mp_bluetooth_gatts_indicate(uint16_t conn_handle, uint16_t value_handle);
@@ -200,6 +217,32 @@ int mp_bluetooth_gatts_set_buffer(uint16_t value_handle, size_t len, bool append
 // Disconnect from a central or peripheral.
 int mp_bluetooth_gap_disconnect(uint16_t conn_handle);
 
+// Get/set the ATT MTU offered in the exchange (23 to 517), new connections use it.
+int mp_bluetooth_get_preferred_mtu(void);
+int mp_bluetooth_set_preferred_mtu(uint16_t mtu);
+
+// Initiate the ATT MTU exchange, either role may.
+int mp_bluetooth_gattc_exchange_mtu(uint16_t conn_handle);
+
+#if MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+// Accept incoming channels on the PSM, SDUs of up to mtu bytes.
+int mp_bluetooth_l2cap_listen(uint16_t psm, uint16_t mtu);
+
+// Open a channel to the PSM of the peer.
+int mp_bluetooth_l2cap_connect(uint16_t conn_handle, uint16_t psm, uint16_t mtu);
+
+// Close a channel.
+int mp_bluetooth_l2cap_disconnect(uint16_t conn_handle, uint16_t cid);
+
+// Send an SDU of up to the peer's MTU. Sets stalled if the peer ran out of credits, then
+// no more may be sent until the send ready event.
+int mp_bluetooth_l2cap_send(uint16_t conn_handle, uint16_t cid, const uint8_t *buf, size_t len, bool *stalled);
+
+// Copy up to len bytes of the received SDU into buf and update len. The peer gets new
+// credits once all of it was taken. buf NULL only returns the length pending.
+int mp_bluetooth_l2cap_recvinto(uint16_t conn_handle, uint16_t cid, uint8_t *buf, size_t *len);
+#endif
+
 #if MICROPY_PY_BLUETOOTH_ENABLE_CENTRAL_MODE
 // Start a discovery (scan). Set duration to zero to run continuously.
 int mp_bluetooth_gap_scan_start(int32_t duration_ms, int32_t interval_us, int32_t window_us);
@@ -240,6 +283,23 @@ void mp_bluetooth_gatts_on_write(uint16_t conn_handle, uint16_t value_handle);
 bool mp_bluetooth_gatts_on_read_request(uint16_t conn_handle, uint16_t value_handle);
 #endif
 
+// Call this when the ATT MTU of a connection was negotiated.
+void mp_bluetooth_gatts_on_mtu_exchanged(uint16_t conn_handle, uint16_t value);
+
+#if MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+// Notify modbluetooth that a channel was accepted (MP_BLUETOOTH_IRQ_L2CAP_ACCEPT) or connected (_CONNECT).
+void mp_bluetooth_on_l2cap_connect(uint16_t event, uint16_t conn_handle, uint16_t cid, uint16_t psm, uint16_t our_mtu, uint16_t peer_mtu);
+
+// Notify modbluetooth that a channel was closed, or failed to connect with a non-zero status.
+void mp_bluetooth_on_l2cap_disconnect(uint16_t conn_handle, uint16_t cid, uint16_t psm, uint16_t status);
+
+// Notify modbluetooth that an SDU is waiting for mp_bluetooth_l2cap_recvinto.
+void mp_bluetooth_on_l2cap_recv(uint16_t conn_handle, uint16_t cid);
+
+// Notify modbluetooth that a stalled channel can send again.
+void mp_bluetooth_on_l2cap_send_ready(uint16_t conn_handle, uint16_t cid, uint8_t status);
+#endif
+
 #if MICROPY_PY_BLUETOOTH_ENABLE_CENTRAL_MODE
 // Notify modbluetooth that scan has finished, either timeout, manually, or by some other action (e.g. connecting).
 void mp_bluetooth_gap_on_scan_complete(void);
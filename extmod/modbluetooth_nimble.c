@@ -253,6 +253,12 @@ STATIC void gatts_register_cb(struct ble_gatt_register_ctxt *ctxt, void *arg) {
     }
 }
 
+// Ask the controller for the longest link layer packets (Data Length Extension), so a large
+// ATT MTU isn't split into 27 byte PDUs. Controllers without it refuse, which is harmless.
+STATIC void gap_set_max_data_len(uint16_t conn_handle) {
+    ble_gap_set_data_len(conn_handle, BLE_HCI_SET_DATALEN_TX_OCTETS_MAX, BLE_HCI_SET_DATALEN_TX_TIME_MAX);
+}
+
 STATIC int gap_event_cb(struct ble_gap_event *event, void *arg) {
     DEBUG_EVENT_printf("gap_event_cb: type=%d\n", event->type);
     struct ble_gap_conn_desc desc;
@@ -265,6 +271,7 @@ STATIC int gap_event_cb(struct ble_gap_event *event, void *arg) {
                 ble_gap_conn_find(event->connect.conn_handle, &desc);
                 reverse_addr_byte_order(addr, desc.peer_id_addr.val);
                 mp_bluetooth_gap_on_connected_disconnected(MP_BLUETOOTH_IRQ_CENTRAL_CONNECT, event->connect.conn_handle, desc.peer_id_addr.type, addr);
+                gap_set_max_data_len(event->connect.conn_handle);
             } else {
                 // Connection failed.
                 mp_bluetooth_gap_on_connected_disconnected(MP_BLUETOOTH_IRQ_CENTRAL_DISCONNECT, event->connect.conn_handle, 0xff, addr);
@@ -276,6 +283,11 @@ STATIC int gap_event_cb(struct ble_gap_event *event, void *arg) {
             reverse_addr_byte_order(addr, event->disconnect.conn.peer_id_addr.val);
             mp_bluetooth_gap_on_connected_disconnected(MP_BLUETOOTH_IRQ_CENTRAL_DISCONNECT, event->disconnect.conn.conn_handle, event->disconnect.conn.peer_id_addr.type, addr);
             break;
+
+        case BLE_GAP_EVENT_MTU:
+            // Either side started the exchange.
+            mp_bluetooth_gatts_on_mtu_exchanged(event->mtu.conn_handle, event->mtu.value);
+            break;
     }
 
     return 0;
@@ -550,6 +562,19 @@ int mp_bluetooth_gap_disconnect(uint16_t conn_handle) {
     return ble_hs_err_to_errno(ble_gap_terminate(conn_handle, BLE_ERR_REM_USER_CONN_TERM));
 }
 
+int mp_bluetooth_get_preferred_mtu(void) {
+    return ble_att_preferred_mtu();
+}
+
+int mp_bluetooth_set_preferred_mtu(uint16_t mtu) {
+    return ble_hs_err_to_errno(ble_att_set_preferred_mtu(mtu));
+}
+
+int mp_bluetooth_gattc_exchange_mtu(uint16_t conn_handle) {
+    // The result comes as BLE_GAP_EVENT_MTU.
+    return ble_hs_err_to_errno(ble_gattc_exchange_mtu(conn_handle, NULL, NULL));
+}
+
 int mp_bluetooth_gatts_read(uint16_t value_handle, uint8_t **value, size_t *value_len) {
     mp_map_elem_t *elem = mp_map_lookup(MP_STATE_PORT(bluetooth_nimble_root_pointers)->gatts_db, MP_OBJ_NEW_SMALL_INT(value_handle), MP_MAP_LOOKUP);
     if (!elem) {
@@ -589,11 +614,17 @@ int mp_bluetooth_gatts_notify(uint16_t conn_handle, uint16_t value_handle) {
 }
 
 int mp_bluetooth_gatts_notify_send(uint16_t conn_handle, uint16_t value_handle, const uint8_t *value, size_t *value_len) {
+    // The part that fits one notification goes straight into the mbuf, the rest would be cut by the stack.
+    uint16_t mtu = ble_att_mtu(conn_handle);
+    if (mtu == 0) {
+        return MP_ENOTCONN;
+    }
+    *value_len = MIN(*value_len, mtu - 3);
     struct os_mbuf *om = ble_hs_mbuf_from_flat(value, *value_len);
     if (om == NULL) {
-        return -1;
+        return MP_ENOMEM;
     }
-    // TODO: check that notify_custom takes ownership of om, if not os_mbuf_free_chain(om).
+    // notify_custom takes ownership of om, also on error.
     return ble_hs_err_to_errno(ble_gattc_notify_custom(conn_handle, value_handle, om));
 }
 
@@ -614,6 +645,238 @@ int mp_bluetooth_gatts_set_buffer(uint16_t value_handle, size_t len, bool append
     return 0;
 }
 
+#if MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+
+// SDUs are received into mbufs of an MPS each, the pool holds one SDU of the MTU. The peer's
+// credits are what that SDU buffer takes. The next one is only handed to the stack once the
+// app took all of the last SDU, until then the peer runs out of credits and waits: that's
+// the flow control.
+#define L2CAP_SDU_BLOCK_SIZE (((MYNEWT_VAL(BLE_L2CAP_COC_MPS) + 3) / 4) * 4)
+
+typedef struct _mp_bluetooth_nimble_l2cap_channel_t {
+    struct ble_l2cap_chan *chan;
+    struct os_mbuf_pool sdu_mbuf_pool;
+    struct os_mempool sdu_mempool;
+    // The received SDU not yet taken by recvinto.
+    struct os_mbuf *rx_pending;
+    uint16_t mtu;
+    os_membuf_t sdu_mem[];
+} mp_bluetooth_nimble_l2cap_channel_t;
+
+STATIC int l2cap_channel_event(struct ble_l2cap_event *event, void *arg);
+
+STATIC int create_l2cap_channel(uint16_t mtu, mp_bluetooth_nimble_l2cap_channel_t **out) {
+    if (MP_STATE_PORT(bluetooth_nimble_root_pointers)->l2cap_chan) {
+        // Only one channel at a time.
+        return MP_EALREADY;
+    }
+    if (mtu < BLE_L2CAP_COC_MTU_MIN) {
+        return MP_EINVAL;
+    }
+
+    // One block more for the packet header of the first.
+    size_t blocks = ((mtu + L2CAP_SDU_BLOCK_SIZE - 1) / L2CAP_SDU_BLOCK_SIZE) + 1;
+    mp_bluetooth_nimble_l2cap_channel_t *chan = m_new_obj_var(mp_bluetooth_nimble_l2cap_channel_t, os_membuf_t, OS_MEMPOOL_SIZE(blocks, L2CAP_SDU_BLOCK_SIZE));
+    chan->chan = NULL;
+    chan->rx_pending = NULL;
+    chan->mtu = mtu;
+
+    int err = os_mempool_init(&chan->sdu_mempool, blocks, L2CAP_SDU_BLOCK_SIZE, chan->sdu_mem, "l2cap_sdu");
+    if (err == 0) {
+        err = os_mbuf_pool_init(&chan->sdu_mbuf_pool, &chan->sdu_mempool, L2CAP_SDU_BLOCK_SIZE, blocks);
+    }
+    if (err != 0) {
+        m_del_var(mp_bluetooth_nimble_l2cap_channel_t, os_membuf_t, OS_MEMPOOL_SIZE(blocks, L2CAP_SDU_BLOCK_SIZE), chan);
+        return MP_ENOMEM;
+    }
+
+    MP_STATE_PORT(bluetooth_nimble_root_pointers)->l2cap_chan = chan;
+    *out = chan;
+    return 0;
+}
+
+STATIC void destroy_l2cap_channel(mp_bluetooth_nimble_l2cap_channel_t *chan) {
+    if (chan->rx_pending) {
+        os_mbuf_free_chain(chan->rx_pending);
+        chan->rx_pending = NULL;
+    }
+    chan->chan = NULL;
+    // A listener keeps its buffers for the next connection.
+    if (!MP_STATE_PORT(bluetooth_nimble_root_pointers)->l2cap_listening) {
+        MP_STATE_PORT(bluetooth_nimble_root_pointers)->l2cap_chan = NULL;
+    }
+}
+
+STATIC mp_bluetooth_nimble_l2cap_channel_t *get_l2cap_channel(uint16_t conn_handle, uint16_t cid) {
+    mp_bluetooth_nimble_l2cap_channel_t *chan = MP_STATE_PORT(bluetooth_nimble_root_pointers)->l2cap_chan;
+    struct ble_l2cap_chan_info info;
+    if (!chan || !chan->chan || ble_l2cap_get_chan_info(chan->chan, &info) != 0 || info.scid != cid || ble_l2cap_get_conn_handle(chan->chan) != conn_handle) {
+        return NULL;
+    }
+    return chan;
+}
+
+// Gives the stack the buffer for the next SDU, and the peer the credits for it.
+STATIC int l2cap_recv_ready(mp_bluetooth_nimble_l2cap_channel_t *chan) {
+    struct os_mbuf *sdu_rx = os_mbuf_get_pkthdr(&chan->sdu_mbuf_pool, 0);
+    if (sdu_rx == NULL) {
+        return BLE_HS_ENOMEM;
+    }
+    return ble_l2cap_recv_ready(chan->chan, sdu_rx);
+}
+
+STATIC int l2cap_channel_event(struct ble_l2cap_event *event, void *arg) {
+    DEBUG_EVENT_printf("l2cap_channel_event: type=%d\n", event->type);
+    mp_bluetooth_nimble_l2cap_channel_t *chan = arg;
+    struct ble_l2cap_chan_info info;
+
+    switch (event->type) {
+        case BLE_L2CAP_EVENT_COC_CONNECTED:
+            chan->chan = event->connect.chan;
+            ble_l2cap_get_chan_info(event->connect.chan, &info);
+            if (event->connect.status == 0) {
+                // The incoming side already got BLE_L2CAP_EVENT_COC_ACCEPT.
+                if (!MP_STATE_PORT(bluetooth_nimble_root_pointers)->l2cap_listening) {
+                    mp_bluetooth_on_l2cap_connect(MP_BLUETOOTH_IRQ_L2CAP_CONNECT, event->connect.conn_handle, info.scid, info.psm, info.our_coc_mtu, info.peer_coc_mtu);
+                }
+            } else {
+                mp_bluetooth_on_l2cap_disconnect(event->connect.conn_handle, info.scid, info.psm, event->connect.status);
+                destroy_l2cap_channel(chan);
+            }
+            break;
+
+        case BLE_L2CAP_EVENT_COC_DISCONNECTED:
+            ble_l2cap_get_chan_info(event->disconnect.chan, &info);
+            mp_bluetooth_on_l2cap_disconnect(event->disconnect.conn_handle, info.scid, info.psm, 0);
+            destroy_l2cap_channel(chan);
+            break;
+
+        case BLE_L2CAP_EVENT_COC_ACCEPT:
+            if (chan->chan) {
+                // Busy with another connection.
+                return BLE_HS_ENOMEM;
+            }
+            chan->chan = event->accept.chan;
+            ble_l2cap_get_chan_info(event->accept.chan, &info);
+            mp_bluetooth_on_l2cap_connect(MP_BLUETOOTH_IRQ_L2CAP_ACCEPT, event->accept.conn_handle, info.scid, info.psm, info.our_coc_mtu, info.peer_coc_mtu);
+            return l2cap_recv_ready(chan);
+
+        case BLE_L2CAP_EVENT_COC_DATA_RECEIVED:
+            // No new buffer until recvinto took this one, see L2CAP_SDU_BLOCK_SIZE.
+            chan->rx_pending = event->receive.sdu_rx;
+            mp_bluetooth_on_l2cap_recv(event->receive.conn_handle, ble_l2cap_get_scid(event->receive.chan));
+            break;
+
+        case BLE_L2CAP_EVENT_COC_TX_UNSTALLED:
+            mp_bluetooth_on_l2cap_send_ready(event->tx_unstalled.conn_handle, ble_l2cap_get_scid(event->tx_unstalled.chan), event->tx_unstalled.status);
+            break;
+
+        default:
+            break;
+    }
+    return 0;
+}
+
+int mp_bluetooth_l2cap_listen(uint16_t psm, uint16_t mtu) {
+    mp_bluetooth_nimble_l2cap_channel_t *chan;
+    int err = create_l2cap_channel(mtu, &chan);
+    if (err != 0) {
+        return err;
+    }
+    MP_STATE_PORT(bluetooth_nimble_root_pointers)->l2cap_listening = true;
+    err = ble_l2cap_create_server(psm, mtu, &l2cap_channel_event, chan);
+    if (err != 0) {
+        MP_STATE_PORT(bluetooth_nimble_root_pointers)->l2cap_listening = false;
+        destroy_l2cap_channel(chan);
+    }
+    return ble_hs_err_to_errno(err);
+}
+
+int mp_bluetooth_l2cap_connect(uint16_t conn_handle, uint16_t psm, uint16_t mtu) {
+    mp_bluetooth_nimble_l2cap_channel_t *chan;
+    int err = create_l2cap_channel(mtu, &chan);
+    if (err != 0) {
+        return err;
+    }
+    struct os_mbuf *sdu_rx = os_mbuf_get_pkthdr(&chan->sdu_mbuf_pool, 0);
+    err = ble_l2cap_connect(conn_handle, psm, mtu, sdu_rx, &l2cap_channel_event, chan);
+    if (err != 0) {
+        os_mbuf_free_chain(sdu_rx);
+        destroy_l2cap_channel(chan);
+    }
+    return ble_hs_err_to_errno(err);
+}
+
+int mp_bluetooth_l2cap_disconnect(uint16_t conn_handle, uint16_t cid) {
+    mp_bluetooth_nimble_l2cap_channel_t *chan = get_l2cap_channel(conn_handle, cid);
+    if (!chan) {
+        return MP_EINVAL;
+    }
+    // Cleaned up by BLE_L2CAP_EVENT_COC_DISCONNECTED.
+    return ble_hs_err_to_errno(ble_l2cap_disconnect(chan->chan));
+}
+
+int mp_bluetooth_l2cap_send(uint16_t conn_handle, uint16_t cid, const uint8_t *buf, size_t len, bool *stalled) {
+    mp_bluetooth_nimble_l2cap_channel_t *chan = get_l2cap_channel(conn_handle, cid);
+    if (!chan) {
+        return MP_EINVAL;
+    }
+    struct ble_l2cap_chan_info info;
+    ble_l2cap_get_chan_info(chan->chan, &info);
+    if (len > info.peer_coc_mtu) {
+        return MP_EINVAL;
+    }
+
+    // The stack segments the SDU into PDUs of the peer's MPS as credits allow.
+    struct os_mbuf *sdu_tx = ble_hs_mbuf_from_flat(buf, len);
+    if (sdu_tx == NULL) {
+        return MP_ENOMEM;
+    }
+    int err = ble_l2cap_send(chan->chan, sdu_tx);
+    if (err == BLE_HS_ESTALLED) {
+        // Out of credits, the stack owns the SDU and finishes it when they come.
+        *stalled = true;
+        return 0;
+    }
+    if (err != 0) {
+        // Not taken, e.g. BLE_HS_EBUSY while the previous SDU is still stalled.
+        os_mbuf_free_chain(sdu_tx);
+    }
+    return ble_hs_err_to_errno(err);
+}
+
+int mp_bluetooth_l2cap_recvinto(uint16_t conn_handle, uint16_t cid, uint8_t *buf, size_t *len) {
+    mp_bluetooth_nimble_l2cap_channel_t *chan = get_l2cap_channel(conn_handle, cid);
+    if (!chan) {
+        return MP_EINVAL;
+    }
+
+    int err = 0;
+    MICROPY_PY_BLUETOOTH_ENTER
+    if (chan->rx_pending == NULL) {
+        *len = 0;
+    } else {
+        size_t avail = OS_MBUF_PKTLEN(chan->rx_pending);
+        if (buf == NULL) {
+            *len = avail;
+        } else {
+            *len = MIN(*len, avail);
+            os_mbuf_copydata(chan->rx_pending, 0, *len, buf);
+            if (*len == avail) {
+                os_mbuf_free_chain(chan->rx_pending);
+                chan->rx_pending = NULL;
+                err = l2cap_recv_ready(chan);
+            } else {
+                os_mbuf_adj(chan->rx_pending, *len);
+            }
+        }
+    }
+    MICROPY_PY_BLUETOOTH_EXIT
+    return ble_hs_err_to_errno(err);
+}
+
+#endif // MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+
 #if MICROPY_PY_BLUETOOTH_ENABLE_CENTRAL_MODE
 
 STATIC void gattc_on_data_available(uint16_t event, uint16_t conn_handle, uint16_t value_handle, const struct os_mbuf *om) {
@@ -697,6 +960,7 @@ STATIC int peripheral_gap_event_cb(struct ble_gap_event *event, void *arg) {
                 ble_gap_conn_find(event->connect.conn_handle, &desc);
                 reverse_addr_byte_order(addr, desc.peer_id_addr.val);
                 mp_bluetooth_gap_on_connected_disconnected(MP_BLUETOOTH_IRQ_PERIPHERAL_CONNECT, event->connect.conn_handle, desc.peer_id_addr.type, addr);
+                gap_set_max_data_len(event->connect.conn_handle);
             } else {
                 // Connection failed.
                 mp_bluetooth_gap_on_connected_disconnected(MP_BLUETOOTH_IRQ_PERIPHERAL_DISCONNECT, event->connect.conn_handle, 0xff, addr);
@@ -716,6 +980,10 @@ STATIC int peripheral_gap_event_cb(struct ble_gap_event *event, void *arg) {
             break;
         }
 
+        case BLE_GAP_EVENT_MTU:
+            mp_bluetooth_gatts_on_mtu_exchanged(event->mtu.conn_handle, event->mtu.value);
+            break;
+
         case BLE_GAP_EVENT_CONN_UPDATE:
             // TODO
             break;
@@ -36,6 +36,12 @@ typedef struct _mp_bluetooth_nimble_root_pointers_t {
     // Pending service definitions.
     size_t n_services;
     struct ble_gatt_svc_def *services[MP_BLUETOOTH_NIMBLE_MAX_SERVICES];
+
+    #if MICROPY_PY_BLUETOOTH_ENABLE_L2CAP_CHANNELS
+    // The L2CAP channel and its SDU buffers, kept for the next connection while listening.
+    struct _mp_bluetooth_nimble_l2cap_channel_t *l2cap_chan;
+    bool l2cap_listening;
+    #endif
 } mp_bluetooth_nimble_root_pointers_t;
 
 enum {
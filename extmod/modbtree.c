@@ -120,6 +120,38 @@ STATIC mp_obj_t btree_get(size_t n_args, const mp_obj_t *args) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(btree_get_obj, 2, 3, btree_get);
 
+// Stores (key, value) pairs that come in ascending key order. Each put then
+// takes the library's sorted data path, appending to the rightmost leaf
+// without a descent, and the leaves it splits off are left full.
+STATIC mp_obj_t btree_bulkload(mp_obj_t self_in, mp_obj_t items_in) {
+    mp_obj_btree_t *self = MP_OBJ_TO_PTR(self_in);
+    BTREE *t = self->db->internal;
+    mp_obj_iter_buf_t iter_buf;
+    mp_obj_t iterable = mp_getiter(items_in, &iter_buf);
+    mp_obj_t item;
+    mp_obj_t prev_obj = MP_OBJ_NULL;
+    DBT prev;
+    mp_int_t n = 0;
+    while ((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
+        mp_obj_t *kv;
+        mp_obj_get_array_fixed_n(item, 2, &kv);
+        DBT key, val;
+        key.data = (void*)mp_obj_str_get_data(kv[0], &key.size);
+        val.data = (void*)mp_obj_str_get_data(kv[1], &val.size);
+        if (prev_obj != MP_OBJ_NULL && t->bt_cmp(&key, &prev) < 0) {
+            mp_raise_ValueError("keys not in order");
+        }
+        int res = __bt_put(self->db, &key, &val, 0);
+        CHECK_ERROR(res);
+        // keeps the previous key's data alive
+        prev_obj = kv[0];
+        prev = key;
+        n++;
+    }
+    return MP_OBJ_NEW_SMALL_INT(n);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(btree_bulkload_obj, btree_bulkload);
+
 STATIC mp_obj_t btree_seq(size_t n_args, const mp_obj_t *args) {
     mp_obj_btree_t *self = MP_OBJ_TO_PTR(args[0]);
     int flags = MP_OBJ_SMALL_INT_VALUE(args[1]);
@@ -303,6 +335,7 @@ STATIC const mp_rom_map_elem_t btree_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&btree_flush_obj) },
     { MP_ROM_QSTR(MP_QSTR_get), MP_ROM_PTR(&btree_get_obj) },
     { MP_ROM_QSTR(MP_QSTR_put), MP_ROM_PTR(&btree_put_obj) },
+    { MP_ROM_QSTR(MP_QSTR_bulkload), MP_ROM_PTR(&btree_bulkload_obj) },
     { MP_ROM_QSTR(MP_QSTR_seq), MP_ROM_PTR(&btree_seq_obj) },
     { MP_ROM_QSTR(MP_QSTR_keys), MP_ROM_PTR(&btree_keys_obj) },
     { MP_ROM_QSTR(MP_QSTR_values), MP_ROM_PTR(&btree_values_obj) },
@@ -31,7 +31,34 @@
 
 #if MICROPY_PY_FRAMEBUF
 
-#include "ports/stm32/font_petme128_8x8.h"
+// A port with imlib can also draw text with its 8x10 glyphs, text(s, x, y, c, FONT_IMLIB).
+#ifndef MICROPY_PY_FRAMEBUF_IMLIB_FONT
+#define MICROPY_PY_FRAMEBUF_IMLIB_FONT (0)
+#endif
+
+#include "extmod/font_petme128_8x8.h"
+#if MICROPY_PY_FRAMEBUF_IMLIB_FONT
+#include "font.h"
+#endif
+
+// Fonts of text()
+#define FRAMEBUF_FONT_8X8 (0)
+#define FRAMEBUF_FONT_IMLIB (1)
+
+// A port can hand the fills and copies of the byte wide formats to a 2D engine or DMA.
+// Strides are in bytes, bytes_pp is 1 or 2 and col the value stored for the pixels. Both
+// return true when done, false leaves the job to the CPU.
+#ifndef MICROPY_PY_FRAMEBUF_HW_FILL
+#define MICROPY_PY_FRAMEBUF_HW_FILL(buf, stride, w, h, bytes_pp, col) (false)
+#endif
+#ifndef MICROPY_PY_FRAMEBUF_HW_COPY
+#define MICROPY_PY_FRAMEBUF_HW_COPY(dst, dst_stride, src, src_stride, w, h, bytes_pp) (false)
+#endif
+
+// A port can define MICROPY_PY_FRAMEBUF_VIEW(obj, &buf, &w, &h) so FrameBuffer(obj) draws
+// straight into the pixels of its image objects. It returns 0 for 1 bit pixels, LSB first in
+// rows padded to 32 bits, 1 for 8 bit pixels, 2 for big endian RGB565 or -1 if obj is not
+// an image.
 
 typedef struct _mp_obj_framebuf_t {
     mp_obj_base_t base;
@@ -59,6 +86,10 @@ typedef struct _mp_framebuf_p_t {
 #define FRAMEBUF_GS8      (6)
 #define FRAMEBUF_MHLSB    (3)
 #define FRAMEBUF_MHMSB    (4)
+// RGB565 with the bytes swapped, only for views of images
+#define FRAMEBUF_RGB565_BE (7)
+
+#define FRAMEBUF_SWAP16(col) ((((col) & 0xff) << 8) | (((col) >> 8) & 0xff))
 
 // Functions for MHLSB and MHMSB
 
@@ -122,16 +153,49 @@ STATIC uint32_t rgb565_getpixel(const mp_obj_framebuf_t *fb, int x, int y) {
     return ((uint16_t*)fb->buf)[x + y * fb->stride];
 }
 
-STATIC void rgb565_fill_rect(const mp_obj_framebuf_t *fb, int x, int y, int w, int h, uint32_t col) {
+// Fills the rows with the stored value col, two pixels to a word once aligned.
+STATIC void rgb565_fill_rect_raw(const mp_obj_framebuf_t *fb, int x, int y, int w, int h, uint16_t col) {
     uint16_t *b = &((uint16_t*)fb->buf)[x + y * fb->stride];
+    if (MICROPY_PY_FRAMEBUF_HW_FILL(b, fb->stride * 2, w, h, 2, col)) {
+        return;
+    }
+    uint32_t col2 = col | ((uint32_t)col << 16);
     while (h--) {
-        for (int ww = w; ww; --ww) {
-            *b++ = col;
+        uint16_t *p = b;
+        int ww = w;
+        if (((uintptr_t)p & 2) && ww) {
+            *p++ = col;
+            --ww;
+        }
+        for (; ww >= 2; ww -= 2, p += 2) {
+            *(uint32_t*)p = col2;
         }
-        b += fb->stride - w;
+        if (ww) {
+            *p = col;
+        }
+        b += fb->stride;
     }
 }
 
+STATIC void rgb565_fill_rect(const mp_obj_framebuf_t *fb, int x, int y, int w, int h, uint32_t col) {
+    rgb565_fill_rect_raw(fb, x, y, w, h, col);
+}
+
+// Functions for RGB565_BE format
+
+STATIC void rgb565_be_setpixel(const mp_obj_framebuf_t *fb, int x, int y, uint32_t col) {
+    ((uint16_t*)fb->buf)[x + y * fb->stride] = FRAMEBUF_SWAP16(col);
+}
+
+STATIC uint32_t rgb565_be_getpixel(const mp_obj_framebuf_t *fb, int x, int y) {
+    uint32_t col = ((uint16_t*)fb->buf)[x + y * fb->stride];
+    return FRAMEBUF_SWAP16(col);
+}
+
+STATIC void rgb565_be_fill_rect(const mp_obj_framebuf_t *fb, int x, int y, int w, int h, uint32_t col) {
+    rgb565_fill_rect_raw(fb, x, y, w, h, FRAMEBUF_SWAP16(col));
+}
+
 // Functions for GS2_HMSB format
 
 STATIC void gs2_hmsb_setpixel(const mp_obj_framebuf_t *fb, int x, int y, uint32_t col) {
@@ -220,6 +284,9 @@ STATIC uint32_t gs8_getpixel(const mp_obj_framebuf_t *fb, int x, int y) {
 
 STATIC void gs8_fill_rect(const mp_obj_framebuf_t *fb, int x, int y, int w, int h, uint32_t col) {
     uint8_t *pixel = &((uint8_t*)fb->buf)[(x + y * fb->stride)];
+    if (MICROPY_PY_FRAMEBUF_HW_FILL(pixel, fb->stride, w, h, 1, col & 0xff)) {
+        return;
+    }
     while (h--) {
         memset(pixel, col, w);
         pixel += fb->stride;
@@ -234,8 +301,22 @@ STATIC mp_framebuf_p_t formats[] = {
     [FRAMEBUF_GS8] = {gs8_setpixel, gs8_getpixel, gs8_fill_rect},
     [FRAMEBUF_MHLSB] = {mono_horiz_setpixel, mono_horiz_getpixel, mono_horiz_fill_rect},
     [FRAMEBUF_MHMSB] = {mono_horiz_setpixel, mono_horiz_getpixel, mono_horiz_fill_rect},
+    [FRAMEBUF_RGB565_BE] = {rgb565_be_setpixel, rgb565_be_getpixel, rgb565_be_fill_rect},
 };
 
+// Bytes per pixel of the formats blit and scroll copy rows of, 0 for the others.
+STATIC int bytes_per_pixel(const mp_obj_framebuf_t *fb) {
+    switch (fb->format) {
+        case FRAMEBUF_GS8:
+            return 1;
+        case FRAMEBUF_RGB565:
+        case FRAMEBUF_RGB565_BE:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
 static inline void setpixel(const mp_obj_framebuf_t *fb, int x, int y, uint32_t col) {
     formats[fb->format].setpixel(fb, x, y, col);
 }
@@ -259,7 +340,43 @@ STATIC void fill_rect(const mp_obj_framebuf_t *fb, int x, int y, int w, int h, u
     formats[fb->format].fill_rect(fb, x, y, xend - x, yend - y, col);
 }
 
+#ifdef MICROPY_PY_FRAMEBUF_VIEW
+// A FrameBuffer over the pixels of an image, nothing is copied or converted.
+STATIC mp_obj_t framebuf_make_view(const mp_obj_type_t *type, mp_obj_t img) {
+    mp_obj_framebuf_t *o = m_new_obj(mp_obj_framebuf_t);
+    o->base.type = type;
+    o->buf_obj = img;
+
+    int w, h;
+    switch (MICROPY_PY_FRAMEBUF_VIEW(img, &o->buf, &w, &h)) {
+        case 0:
+            o->format = FRAMEBUF_MHMSB;
+            o->stride = (w + 31) & ~31;
+            break;
+        case 1:
+            o->format = FRAMEBUF_GS8;
+            o->stride = w;
+            break;
+        case 2:
+            o->format = FRAMEBUF_RGB565_BE;
+            o->stride = w;
+            break;
+        default:
+            mp_raise_ValueError("invalid format");
+    }
+    o->width = w;
+    o->height = h;
+
+    return MP_OBJ_FROM_PTR(o);
+}
+#endif
+
 STATIC mp_obj_t framebuf_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    #ifdef MICROPY_PY_FRAMEBUF_VIEW
+    if (n_args == 1 && n_kw == 0) {
+        return framebuf_make_view(type, args[0]);
+    }
+    #endif
     mp_arg_check_num(n_args, n_kw, 4, 5, false);
 
     mp_obj_framebuf_t *o = m_new_obj(mp_obj_framebuf_t);
@@ -306,7 +423,7 @@ STATIC mp_int_t framebuf_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo,
     (void)flags;
     mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
     bufinfo->buf = self->buf;
-    bufinfo->len = self->stride * self->height * (self->format == FRAMEBUF_RGB565 ? 2 : 1);
+    bufinfo->len = self->stride * self->height * (bytes_per_pixel(self) == 2 ? 2 : 1);
     bufinfo->typecode = 'B'; // view framebuf as bytes
     return 0;
 }
@@ -495,6 +612,57 @@ STATIC mp_obj_t framebuf_blit(size_t n_args, const mp_obj_t *args) {
     int x0end = MIN(self->width, x + source->width);
     int y0end = MIN(self->height, y + source->height);
 
+    int bytes_pp = bytes_per_pixel(self);
+    if (bytes_pp && bytes_pp == bytes_per_pixel(source)) {
+        // Whole rows between the byte wide formats, only RGB565 to RGB565_BE converts.
+        int w = x0end - x0, h = y0end - y0;
+        size_t dst_stride = self->stride * bytes_pp, src_stride = source->stride * bytes_pp;
+        uint8_t *dst = (uint8_t*)self->buf + y0 * dst_stride + x0 * bytes_pp;
+        const uint8_t *src = (const uint8_t*)source->buf + y1 * src_stride + x1 * bytes_pp;
+        bool swap = self->format != source->format;
+        if (key == -1 && !swap) {
+            if (MICROPY_PY_FRAMEBUF_HW_COPY(dst, dst_stride, src, src_stride, w, h, bytes_pp)) {
+                return mp_const_none;
+            }
+            // Rows of a blit within one buffer are taken before they are written over.
+            ptrdiff_t step = dst_stride, src_step = src_stride;
+            if (dst > src) {
+                dst += (h - 1) * dst_stride;
+                src += (h - 1) * src_stride;
+                step = -step;
+                src_step = -src_step;
+            }
+            for (; h--; dst += step, src += src_step) {
+                memmove(dst, src, w * bytes_pp);
+            }
+        } else if (bytes_pp == 1) {
+            for (; h--; dst += dst_stride, src += src_stride) {
+                for (int i = 0; i < w; ++i) {
+                    if (src[i] != (uint32_t)key) {
+                        dst[i] = src[i];
+                    }
+                }
+            }
+        } else {
+            // key is a color of the source, compared with its pixels as they are stored
+            uint32_t key_raw = (source->format == FRAMEBUF_RGB565_BE) ? FRAMEBUF_SWAP16(key) : (uint32_t)key;
+            if (key < 0 || key > 0xffff) {
+                key_raw = (uint32_t)-1;
+            }
+            for (; h--; dst += dst_stride, src += src_stride) {
+                uint16_t *d = (uint16_t*)dst;
+                const uint16_t *s = (const uint16_t*)src;
+                for (int i = 0; i < w; ++i) {
+                    uint32_t col = s[i];
+                    if (col != key_raw) {
+                        d[i] = swap ? FRAMEBUF_SWAP16(col) : col;
+                    }
+                }
+            }
+        }
+        return mp_const_none;
+    }
+
     for (; y0 < y0end; ++y0) {
         int cx1 = x1;
         for (int cx0 = x0; cx0 < x0end; ++cx0) {
@@ -514,6 +682,27 @@ STATIC mp_obj_t framebuf_scroll(mp_obj_t self_in, mp_obj_t xstep_in, mp_obj_t ys
     mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
     mp_int_t xstep = mp_obj_get_int(xstep_in);
     mp_int_t ystep = mp_obj_get_int(ystep_in);
+    if (xstep <= -self->width || xstep >= self->width || ystep <= -self->height || ystep >= self->height) {
+        // Nothing stays in the framebuffer.
+        return mp_const_none;
+    }
+    int bytes_pp = bytes_per_pixel(self);
+    if (bytes_pp) {
+        // Rows of the byte wide formats are moved whole, first the ones moved away from.
+        int w = self->width - (xstep < 0 ? -xstep : xstep);
+        int h = self->height - (ystep < 0 ? -ystep : ystep);
+        ptrdiff_t stride = self->stride * bytes_pp;
+        uint8_t *dst = (uint8_t*)self->buf + MAX(ystep, 0) * stride + MAX(xstep, 0) * bytes_pp;
+        ptrdiff_t offset = ystep * stride + xstep * bytes_pp;
+        if (ystep > 0) {
+            dst += (h - 1) * stride;
+            stride = -stride;
+        }
+        for (; h--; dst += stride) {
+            memmove(dst, dst - offset, w * bytes_pp);
+        }
+        return mp_const_none;
+    }
     int sx, y, xend, yend, dx, dy;
     if (xstep < 0) {
         sx = 0;
@@ -552,6 +741,17 @@ STATIC mp_obj_t framebuf_text(size_t n_args, const mp_obj_t *args) {
     if (n_args >= 5) {
         col = mp_obj_get_int(args[4]);
     }
+    mp_int_t font_id = FRAMEBUF_FONT_8X8;
+    if (n_args >= 6) {
+        font_id = mp_obj_get_int(args[5]);
+        if (font_id != FRAMEBUF_FONT_8X8
+            #if MICROPY_PY_FRAMEBUF_IMLIB_FONT
+            && font_id != FRAMEBUF_FONT_IMLIB
+            #endif
+            ) {
+            mp_raise_ValueError("invalid font");
+        }
+    }
 
     // loop over chars
     for (; *str; ++str) {
@@ -560,6 +760,26 @@ STATIC mp_obj_t framebuf_text(size_t n_args, const mp_obj_t *args) {
         if (chr < 32 || chr > 127) {
             chr = 127;
         }
+        #if MICROPY_PY_FRAMEBUF_IMLIB_FONT
+        if (font_id == FRAMEBUF_FONT_IMLIB) {
+            // imlib has no glyph for 127
+            const glyph_t *g = &font[(chr < 127 ? chr : '?') - 32];
+            for (int j = 0; j < g->h; j++) {
+                int y = y0 + j;
+                if (0 <= y && y < self->height) { // clip y
+                    uint hline_data = g->data[j]; // each byte is a row of pixels, MSB on the left
+                    for (int i = 0; i < g->w; i++) {
+                        int x = x0 + i;
+                        if ((hline_data & (1 << (g->w - 1 - i))) && 0 <= x && x < self->width) {
+                            setpixel(self, x, y, col);
+                        }
+                    }
+                }
+            }
+            x0 += g->w;
+            continue;
+        }
+        #endif
         // get char data
         const uint8_t *chr_data = &font_petme128_8x8[(chr - 32) * 8];
         // loop over char data
@@ -578,7 +798,7 @@ STATIC mp_obj_t framebuf_text(size_t n_args, const mp_obj_t *args) {
     }
     return mp_const_none;
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(framebuf_text_obj, 4, 5, framebuf_text);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(framebuf_text_obj, 4, 6, framebuf_text);
 
 #if !MICROPY_ENABLE_DYNRUNTIME
 STATIC const mp_rom_map_elem_t framebuf_locals_dict_table[] = {
@@ -639,6 +859,10 @@ STATIC const mp_rom_map_elem_t framebuf_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_GS8), MP_ROM_INT(FRAMEBUF_GS8) },
     { MP_ROM_QSTR(MP_QSTR_MONO_HLSB), MP_ROM_INT(FRAMEBUF_MHLSB) },
     { MP_ROM_QSTR(MP_QSTR_MONO_HMSB), MP_ROM_INT(FRAMEBUF_MHMSB) },
+    { MP_ROM_QSTR(MP_QSTR_FONT_8X8), MP_ROM_INT(FRAMEBUF_FONT_8X8) },
+    #if MICROPY_PY_FRAMEBUF_IMLIB_FONT
+    { MP_ROM_QSTR(MP_QSTR_FONT_IMLIB), MP_ROM_INT(FRAMEBUF_FONT_IMLIB) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(framebuf_module_globals, framebuf_module_globals_table);
@@ -29,6 +29,7 @@
 #include <string.h>
 #include <stdio.h>
 
+#include "py/gc.h"
 #include "py/objlist.h"
 #include "py/runtime.h"
 #include "py/stream.h"
@@ -183,6 +184,104 @@ STATIC const mp_obj_type_t lwip_slip_type = {
 
 #endif // MICROPY_PY_LWIP_SLIP
 
+#ifdef MICROPY_PY_LWIP_ETH
+#include "lwip/dhcp.h"
+#include "netif/etharp.h"
+
+/******************************************************************************/
+// Ethernet object for modlwip. Requires a MAC driver for the port that provides
+// the netif init function and a poll for received frames and the link.
+
+err_t eth_netif_init(struct netif *netif);
+void eth_netif_poll(void *netif);
+
+typedef struct _lwip_eth_obj_t {
+    mp_obj_base_t base;
+    struct netif lwip_netif;
+} lwip_eth_obj_t;
+
+// The MAC is unique.
+STATIC lwip_eth_obj_t lwip_eth_obj;
+STATIC bool lwip_eth_lwip_inited;
+
+void mod_lwip_register_poll(void (*poll)(void *arg), void *poll_arg);
+void mod_lwip_deregister_poll(void (*poll)(void *arg), void *poll_arg);
+
+STATIC const mp_obj_type_t lwip_eth_type;
+
+// constructor lwip.eth(iplocal=string, netmask=string, gateway=string), DHCP without them
+STATIC mp_obj_t lwip_eth_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 0, 3, false);
+
+    ip_addr_t addr[3];
+    for (int i = 0; i < 3; i++) {
+        ip_addr_set_zero(&addr[i]);
+        if ((i < n_args) && (!ipaddr_aton(mp_obj_str_get_str(args[i]), &addr[i]))) {
+            mp_raise_ValueError("not a valid IP");
+        }
+    }
+
+    if (!lwip_eth_lwip_inited) {
+        lwip_init();
+        lwip_eth_lwip_inited = true;
+    }
+
+    // Started again after a soft reset.
+    struct netif *n = &lwip_eth_obj.lwip_netif;
+    if (lwip_eth_obj.base.type != NULL) {
+        mod_lwip_deregister_poll(eth_netif_poll, n);
+        dhcp_stop(n);
+        netif_remove(n);
+    }
+    lwip_eth_obj.base.type = &lwip_eth_type;
+
+    if (netif_add(n, &addr[0], &addr[1], &addr[2], NULL, eth_netif_init, ethernet_input) == NULL) {
+        mp_raise_OSError(MP_ENODEV);
+    }
+    netif_set_default(n);
+    netif_set_up(n);
+    if (n_args == 0) {
+        dhcp_start(n);
+    }
+    mod_lwip_register_poll(eth_netif_poll, n);
+
+    return (mp_obj_t)&lwip_eth_obj;
+}
+
+STATIC mp_obj_t lwip_eth_isconnected(mp_obj_t self_in) {
+    lwip_eth_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(netif_is_link_up(&self->lwip_netif) && (!ip_addr_isany(&self->lwip_netif.ip_addr)));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(lwip_eth_isconnected_obj, lwip_eth_isconnected);
+
+// (ip, netmask, gateway) as strings
+STATIC mp_obj_t lwip_eth_ifconfig(mp_obj_t self_in) {
+    lwip_eth_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    ip_addr_t *addr[3] = { &self->lwip_netif.ip_addr, &self->lwip_netif.netmask, &self->lwip_netif.gw };
+    mp_obj_t tuple[3];
+    for (int i = 0; i < 3; i++) {
+        tuple[i] = mp_obj_new_str(ipaddr_ntoa(addr[i]), strlen(ipaddr_ntoa(addr[i])));
+    }
+    return mp_obj_new_tuple(3, tuple);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(lwip_eth_ifconfig_obj, lwip_eth_ifconfig);
+
+STATIC const mp_rom_map_elem_t lwip_eth_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_isconnected), MP_ROM_PTR(&lwip_eth_isconnected_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ifconfig), MP_ROM_PTR(&lwip_eth_ifconfig_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(lwip_eth_locals_dict, lwip_eth_locals_dict_table);
+
+STATIC const mp_obj_type_t lwip_eth_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_eth,
+    .make_new = lwip_eth_make_new,
+    .locals_dict = (mp_obj_dict_t*)&lwip_eth_locals_dict,
+};
+
+#endif // MICROPY_PY_LWIP_ETH
+
 /******************************************************************************/
 // Table to convert lwIP err_t codes to socket errno codes, from the lwIP
 // socket API.
@@ -295,6 +394,9 @@ typedef struct _lwip_socket_obj_t {
         } connection;
     } incoming;
     mp_obj_t callback;
+    // buffer of the last send_buffer(), lwIP references it until ref_end is acked
+    mp_obj_t ref_buf;
+    u32_t ref_end;
     byte peer[4];
     mp_uint_t peer_port;
     mp_uint_t timeout;
@@ -649,8 +751,9 @@ STATIC mp_uint_t lwip_raw_udp_receive(lwip_socket_obj_t *socket, byte *buf, mp_u
         assert(socket->pcb.tcp);
 
 
-// Helper function for send/sendto to handle TCP packets
-STATIC mp_uint_t lwip_tcp_send(lwip_socket_obj_t *socket, const byte *buf, mp_uint_t len, int *_errno) {
+// Helper function for send/sendto to handle TCP packets. Without TCP_WRITE_FLAG_COPY
+// in apiflags lwIP references buf, see lwip_tcp_wait_ref.
+STATIC mp_uint_t lwip_tcp_send(lwip_socket_obj_t *socket, const byte *buf, mp_uint_t len, u8_t apiflags, int *_errno) {
     // Check for any pending errors
     STREAM_ERROR_CHECK(socket);
 
@@ -696,7 +799,7 @@ STATIC mp_uint_t lwip_tcp_send(lwip_socket_obj_t *socket, const byte *buf, mp_ui
     // committed to being able to write the data.
     err_t err;
     for (int i = 0; i < 200; ++i) {
-        err = tcp_write(socket->pcb.tcp, buf, write_len, TCP_WRITE_FLAG_COPY);
+        err = tcp_write(socket->pcb.tcp, buf, write_len, apiflags);
         if (err != ERR_MEM) {
             break;
         }
@@ -709,6 +812,10 @@ STATIC mp_uint_t lwip_tcp_send(lwip_socket_obj_t *socket, const byte *buf, mp_ui
         MICROPY_PY_LWIP_REENTER
     }
 
+    if (err == ERR_OK && !(apiflags & TCP_WRITE_FLAG_COPY)) {
+        socket->ref_end = socket->pcb.tcp->snd_lbb;
+    }
+
     // If the output buffer is getting full then send the data to the lower layers
     if (err == ERR_OK && tcp_sndbuf(socket->pcb.tcp) < TCP_SND_BUF / 4) {
         err = tcp_output(socket->pcb.tcp);
@@ -765,32 +872,59 @@ STATIC mp_uint_t lwip_tcp_receive(lwip_socket_obj_t *socket, byte *buf, mp_uint_
 
     assert(socket->pcb.tcp != NULL);
 
-    struct pbuf *p = socket->incoming.pbuf;
-
-    mp_uint_t remaining = p->len - socket->recv_offset;
-    if (len > remaining) {
-        len = remaining;
+    // Copy straight out of as many pbufs of the chain as fit, tcp_recved takes 16 bits.
+    if (len > 0xffff) {
+        len = 0xffff;
     }
-
-    memcpy(buf, (byte*)p->payload + socket->recv_offset, len);
-
-    remaining -= len;
-    if (remaining == 0) {
-        socket->incoming.pbuf = p->next;
-        // If we don't ref here, free() will free the entire chain,
-        // if we ref, it does what we need: frees 1st buf, and decrements
-        // next buf's refcount back to 1.
-        pbuf_ref(p->next);
-        pbuf_free(p);
-        socket->recv_offset = 0;
-    } else {
-        socket->recv_offset += len;
+    mp_uint_t total = 0;
+    struct pbuf *p = socket->incoming.pbuf;
+    while (p != NULL && total < len) {
+        mp_uint_t remaining = p->len - socket->recv_offset;
+        mp_uint_t n = MIN(remaining, len - total);
+
+        memcpy(buf + total, (byte*)p->payload + socket->recv_offset, n);
+        total += n;
+
+        if (n == remaining) {
+            socket->incoming.pbuf = p->next;
+            // If we don't ref here, free() will free the entire chain,
+            // if we ref, it does what we need: frees 1st buf, and decrements
+            // next buf's refcount back to 1.
+            pbuf_ref(p->next);
+            pbuf_free(p);
+            socket->recv_offset = 0;
+            p = socket->incoming.pbuf;
+        } else {
+            socket->recv_offset += n;
+        }
     }
-    tcp_recved(socket->pcb.tcp, len);
+    tcp_recved(socket->pcb.tcp, total);
 
     MICROPY_PY_LWIP_EXIT
 
-    return len;
+    return total;
+}
+
+// Waits at most timeout ms (-1 for ever) for the peer to ack the end of the last
+// send_buffer(), after that lwIP doesn't reference the buffer anymore and it may
+// change. A connection that went away has dropped its references too.
+STATIC bool lwip_tcp_wait_ref(lwip_socket_obj_t *socket, mp_uint_t timeout) {
+    mp_uint_t start = mp_hal_ticks_ms();
+    while (socket->ref_buf != MP_OBJ_NULL) {
+        MICROPY_PY_LWIP_ENTER
+        bool done = socket->pcb.tcp == NULL || socket->state < 0
+            || TCP_SEQ_GEQ(socket->pcb.tcp->lastack, socket->ref_end);
+        MICROPY_PY_LWIP_EXIT
+        if (done) {
+            socket->ref_buf = MP_OBJ_NULL;
+            break;
+        }
+        if (timeout != -1 && mp_hal_ticks_ms() - start > timeout) {
+            return false;
+        }
+        poll_sockets();
+    }
+    return true;
 }
 
 /*******************************************************************************/
@@ -871,6 +1005,7 @@ STATIC mp_obj_t lwip_socket_make_new(const mp_obj_type_t *type, size_t n_args, s
     socket->timeout = -1;
     socket->state = STATE_NEW;
     socket->recv_offset = 0;
+    socket->ref_buf = MP_OBJ_NULL;
     return MP_OBJ_FROM_PTR(socket);
 }
 
@@ -1010,6 +1145,7 @@ STATIC mp_obj_t lwip_socket_accept(mp_obj_t self_in) {
     socket2->state = STATE_CONNECTED;
     socket2->recv_offset = 0;
     socket2->callback = MP_OBJ_NULL;
+    socket2->ref_buf = MP_OBJ_NULL;
     tcp_arg(socket2->pcb.tcp, (void*)socket2);
     tcp_err(socket2->pcb.tcp, _lwip_tcp_error);
     tcp_recv(socket2->pcb.tcp, _lwip_tcp_recv);
@@ -1131,7 +1267,7 @@ STATIC mp_obj_t lwip_socket_send(mp_obj_t self_in, mp_obj_t buf_in) {
     mp_uint_t ret = 0;
     switch (socket->type) {
         case MOD_NETWORK_SOCK_STREAM: {
-            ret = lwip_tcp_send(socket, bufinfo.buf, bufinfo.len, &_errno);
+            ret = lwip_tcp_send(socket, bufinfo.buf, bufinfo.len, TCP_WRITE_FLAG_COPY, &_errno);
             break;
         }
         case MOD_NETWORK_SOCK_DGRAM:
@@ -1184,6 +1320,41 @@ STATIC mp_obj_t lwip_socket_recv(mp_obj_t self_in, mp_obj_t len_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(lwip_socket_recv_obj, lwip_socket_recv);
 
+// method socket.recv_into(buf[, nbytes])
+STATIC mp_obj_t lwip_socket_recv_into(size_t n_args, const mp_obj_t *args) {
+    lwip_socket_obj_t *socket = MP_OBJ_TO_PTR(args[0]);
+    int _errno;
+
+    lwip_socket_check_connected(socket);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+    mp_uint_t len = bufinfo.len;
+    if (n_args > 2) {
+        len = MIN(len, (mp_uint_t)mp_obj_get_int(args[2]));
+    }
+
+    mp_uint_t ret = 0;
+    switch (socket->type) {
+        case MOD_NETWORK_SOCK_STREAM: {
+            ret = lwip_tcp_receive(socket, bufinfo.buf, len, &_errno);
+            break;
+        }
+        case MOD_NETWORK_SOCK_DGRAM:
+        #if MICROPY_PY_LWIP_SOCK_RAW
+        case MOD_NETWORK_SOCK_RAW:
+        #endif
+            ret = lwip_raw_udp_receive(socket, bufinfo.buf, len, NULL, NULL, &_errno);
+            break;
+    }
+    if (ret == -1) {
+        mp_raise_OSError(_errno);
+    }
+
+    return mp_obj_new_int_from_uint(ret);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(lwip_socket_recv_into_obj, 2, 3, lwip_socket_recv_into);
+
 STATIC mp_obj_t lwip_socket_sendto(mp_obj_t self_in, mp_obj_t data_in, mp_obj_t addr_in) {
     lwip_socket_obj_t *socket = MP_OBJ_TO_PTR(self_in);
     int _errno;
@@ -1199,7 +1370,7 @@ STATIC mp_obj_t lwip_socket_sendto(mp_obj_t self_in, mp_obj_t data_in, mp_obj_t
     mp_uint_t ret = 0;
     switch (socket->type) {
         case MOD_NETWORK_SOCK_STREAM: {
-            ret = lwip_tcp_send(socket, bufinfo.buf, bufinfo.len, &_errno);
+            ret = lwip_tcp_send(socket, bufinfo.buf, bufinfo.len, TCP_WRITE_FLAG_COPY, &_errno);
             break;
         }
         case MOD_NETWORK_SOCK_DGRAM:
@@ -1284,7 +1455,7 @@ STATIC mp_obj_t lwip_socket_sendall(mp_obj_t self_in, mp_obj_t buf_in) {
             // TODO: In CPython3.5, socket timeout should apply to the
             // entire sendall() operation, not to individual send() chunks.
             while (bufinfo.len != 0) {
-                ret = lwip_tcp_send(socket, bufinfo.buf, bufinfo.len, &_errno);
+                ret = lwip_tcp_send(socket, bufinfo.buf, bufinfo.len, TCP_WRITE_FLAG_COPY, &_errno);
                 if (ret == -1) {
                     mp_raise_OSError(_errno);
                 }
@@ -1302,6 +1473,58 @@ STATIC mp_obj_t lwip_socket_sendall(mp_obj_t self_in, mp_obj_t buf_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(lwip_socket_sendall_obj, lwip_socket_sendall);
 
+// method socket.send_buffer(buf[, wait])
+// Sends all of buf like sendall() but lwIP references it instead of copying it, so it
+// must be a buffer that stays put, like a frame buffer. With wait the call returns once
+// the peer acked all of it, otherwise buf mustn't change until the next send_buffer()
+// or close() returns, they wait for it.
+STATIC mp_obj_t lwip_socket_send_buffer(size_t n_args, const mp_obj_t *args) {
+    lwip_socket_obj_t *socket = MP_OBJ_TO_PTR(args[0]);
+    lwip_socket_check_connected(socket);
+
+    if (socket->type != MOD_NETWORK_SOCK_STREAM) {
+        mp_raise_NotImplementedError(NULL);
+    }
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_READ);
+    bool wait = (n_args < 3) || mp_obj_is_true(args[2]);
+
+    if (!lwip_tcp_wait_ref(socket, socket->timeout)) {
+        mp_raise_OSError(MP_ETIMEDOUT);
+    }
+    if (socket->timeout == 0 && bufinfo.len > tcp_sndbuf(socket->pcb.tcp)) {
+        // same as sendall(), don't queue part of it
+        mp_raise_OSError(MP_EAGAIN);
+    }
+
+    socket->ref_buf = args[1];
+    socket->ref_end = socket->pcb.tcp->snd_lbb;
+    const byte *buf = bufinfo.buf;
+    mp_uint_t len = bufinfo.len;
+    int _errno;
+    while (len != 0) {
+        mp_uint_t ret = lwip_tcp_send(socket, buf, len, 0, &_errno);
+        if (ret == -1) {
+            mp_raise_OSError(_errno);
+        }
+        len -= ret;
+        buf += ret;
+    }
+
+    MICROPY_PY_LWIP_ENTER
+    if (socket->pcb.tcp != NULL) {
+        tcp_output(socket->pcb.tcp);
+    }
+    MICROPY_PY_LWIP_EXIT
+
+    if (wait && !lwip_tcp_wait_ref(socket, socket->timeout)) {
+        mp_raise_OSError(MP_ETIMEDOUT);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(lwip_socket_send_buffer_obj, 2, 3, lwip_socket_send_buffer);
+
 STATIC mp_obj_t lwip_socket_settimeout(mp_obj_t self_in, mp_obj_t timeout_in) {
     lwip_socket_obj_t *socket = MP_OBJ_TO_PTR(self_in);
     mp_uint_t timeout;
@@ -1408,7 +1631,7 @@ STATIC mp_uint_t lwip_socket_write(mp_obj_t self_in, const void *buf, mp_uint_t
 
     switch (socket->type) {
         case MOD_NETWORK_SOCK_STREAM:
-            return lwip_tcp_send(socket, buf, size, errcode);
+            return lwip_tcp_send(socket, buf, size, TCP_WRITE_FLAG_COPY, errcode);
         case MOD_NETWORK_SOCK_DGRAM:
         #if MICROPY_PY_LWIP_SOCK_RAW
         case MOD_NETWORK_SOCK_RAW:
@@ -1492,6 +1715,20 @@ STATIC mp_uint_t lwip_socket_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_
             return 0;
         }
 
+        // Data lwIP references from send_buffer() still goes out after tcp_close, give
+        // it the close timeout and drop it otherwise. Finalisers can't wait.
+        bool abort = false;
+        if (socket->ref_buf != MP_OBJ_NULL) {
+            MICROPY_PY_LWIP_EXIT
+            abort = gc_is_locked() || !lwip_tcp_wait_ref(socket, MICROPY_PY_LWIP_TCP_CLOSE_TIMEOUT_MS);
+            MICROPY_PY_LWIP_REENTER
+            socket->ref_buf = MP_OBJ_NULL;
+            if (socket->pcb.tcp == NULL) {
+                MICROPY_PY_LWIP_EXIT
+                return 0;
+            }
+        }
+
         // Deregister callback (pcb.tcp is set to NULL below so must deregister now)
         tcp_arg(socket->pcb.tcp, NULL);
         tcp_err(socket->pcb.tcp, NULL);
@@ -1508,7 +1745,10 @@ STATIC mp_uint_t lwip_socket_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_
                     // the latter may free the pcb; if it doesn't then the callback will be active.
                     tcp_poll(socket->pcb.tcp, _lwip_tcp_close_poll, MICROPY_PY_LWIP_TCP_CLOSE_TIMEOUT_MS / 500);
                 }
-                if (tcp_close(socket->pcb.tcp) != ERR_OK) {
+                if (abort) {
+                    tcp_poll(socket->pcb.tcp, NULL, 0);
+                    tcp_abort(socket->pcb.tcp);
+                } else if (tcp_close(socket->pcb.tcp) != ERR_OK) {
                     DEBUG_printf("lwip_close: had to call tcp_abort()\n");
                     tcp_abort(socket->pcb.tcp);
                 }
@@ -1543,9 +1783,11 @@ STATIC const mp_rom_map_elem_t lwip_socket_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_connect), MP_ROM_PTR(&lwip_socket_connect_obj) },
     { MP_ROM_QSTR(MP_QSTR_send), MP_ROM_PTR(&lwip_socket_send_obj) },
     { MP_ROM_QSTR(MP_QSTR_recv), MP_ROM_PTR(&lwip_socket_recv_obj) },
+    { MP_ROM_QSTR(MP_QSTR_recv_into), MP_ROM_PTR(&lwip_socket_recv_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_sendto), MP_ROM_PTR(&lwip_socket_sendto_obj) },
     { MP_ROM_QSTR(MP_QSTR_recvfrom), MP_ROM_PTR(&lwip_socket_recvfrom_obj) },
     { MP_ROM_QSTR(MP_QSTR_sendall), MP_ROM_PTR(&lwip_socket_sendall_obj) },
+    { MP_ROM_QSTR(MP_QSTR_send_buffer), MP_ROM_PTR(&lwip_socket_send_buffer_obj) },
     { MP_ROM_QSTR(MP_QSTR_settimeout), MP_ROM_PTR(&lwip_socket_settimeout_obj) },
     { MP_ROM_QSTR(MP_QSTR_setblocking), MP_ROM_PTR(&lwip_socket_setblocking_obj) },
     { MP_ROM_QSTR(MP_QSTR_setsockopt), MP_ROM_PTR(&lwip_socket_setsockopt_obj) },
@@ -1615,11 +1857,16 @@ STATIC mp_obj_t mod_lwip_reset() {
 }
 MP_DEFINE_CONST_FUN_OBJ_0(mod_lwip_reset_obj, mod_lwip_reset);
 
-STATIC mp_obj_t mod_lwip_callback() {
+// Also for ports to call from their event poll hook.
+void mod_lwip_poll(void) {
     if (lwip_poll_list.poll != NULL) {
         lwip_poll_list.poll(lwip_poll_list.poll_arg);
     }
     sys_check_timeouts();
+}
+
+STATIC mp_obj_t mod_lwip_callback() {
+    mod_lwip_poll();
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_0(mod_lwip_callback_obj, mod_lwip_callback);
@@ -1732,6 +1979,9 @@ STATIC const mp_rom_map_elem_t mp_module_lwip_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_socket), MP_ROM_PTR(&lwip_socket_type) },
 #ifdef MICROPY_PY_LWIP_SLIP
     { MP_ROM_QSTR(MP_QSTR_slip), MP_ROM_PTR(&lwip_slip_type) },
+#endif
+#ifdef MICROPY_PY_LWIP_ETH
+    { MP_ROM_QSTR(MP_QSTR_eth), MP_ROM_PTR(&lwip_eth_type) },
 #endif
     // class constants
     { MP_ROM_QSTR(MP_QSTR_AF_INET), MP_ROM_INT(MOD_NETWORK_AF_INET) },
@@ -54,13 +54,23 @@ struct ctr_params {
     uint8_t encrypted_counter[16];
 };
 
-#if MICROPY_SSL_AXTLS
+#if MICROPY_PY_UCRYPTOLIB_HW
+#include "py/mperrno.h"
+#include "extmod/crypto_hw.h"
+
+// The port's AES engine takes the key with every call, so nothing is scheduled here.
+struct hw_aes_ctx {
+    uint8_t key[16];
+    uint8_t iv[16];
+};
+#define AES_CTX_IMPL struct hw_aes_ctx
+
+#elif MICROPY_SSL_AXTLS
 #include "lib/axtls/crypto/crypto.h"
 
 #define AES_CTX_IMPL AES_CTX
-#endif
 
-#if MICROPY_SSL_MBEDTLS
+#elif MICROPY_SSL_MBEDTLS
 #include <mbedtls/aes.h>
 
 // we can't run mbedtls AES key schedule until we know whether we're used for encrypt or decrypt.
@@ -102,7 +112,77 @@ static inline struct ctr_params *ctr_params_from_aes(mp_obj_aes_t *o) {
     return (struct ctr_params*)&o[1];
 }
 
-#if MICROPY_SSL_AXTLS
+#if MICROPY_PY_UCRYPTOLIB_HW
+STATIC void aes_initial_set_key_impl(AES_CTX_IMPL *ctx, const uint8_t *key, size_t keysize, const uint8_t iv[16]) {
+    assert(16 == keysize);
+    memcpy(ctx->key, key, 16);
+    if (NULL != iv) {
+        memcpy(ctx->iv, iv, sizeof(ctx->iv));
+    }
+}
+
+STATIC void aes_final_set_key_impl(AES_CTX_IMPL *ctx, bool encrypt) {
+    (void)ctx;
+    (void)encrypt;
+}
+
+// Takes any number of whole blocks, the engine runs them back to back.
+STATIC void aes_process_ecb_impl(AES_CTX_IMPL *ctx, const uint8_t *in, uint8_t *out, size_t in_len, bool encrypt) {
+    if (mp_hw_aes(ctx->key, NULL, in, out, in_len, encrypt) != 0) {
+        mp_raise_OSError(MP_EIO);
+    }
+}
+
+STATIC void aes_process_cbc_impl(AES_CTX_IMPL *ctx, const uint8_t *in, uint8_t *out, size_t in_len, bool encrypt) {
+    if (mp_hw_aes(ctx->key, ctx->iv, in, out, in_len, encrypt) != 0) {
+        mp_raise_OSError(MP_EIO);
+    }
+}
+
+#if MICROPY_PY_UCRYPTOLIB_CTR
+#define HW_CTR_BLOCKS (8)
+
+// The keystream for a run of counter values is made by one ECB call; the counter part is
+// the same as for axTLS.
+STATIC void aes_process_ctr_impl(AES_CTX_IMPL *ctx, const uint8_t *in, uint8_t *out, size_t in_len, struct ctr_params *ctr_params) {
+    uint32_t stream[HW_CTR_BLOCKS * 4];
+    uint8_t *const counter = ctx->iv;
+    size_t n = ctr_params->offset;
+
+    while (in_len) {
+        if (n == 0) {
+            size_t blocks = MIN((in_len + 15) / 16, HW_CTR_BLOCKS);
+            uint8_t *ks = (uint8_t*)stream;
+            for (size_t b = 0; b < blocks; b++) {
+                memcpy(ks + b * 16, counter, 16);
+                // increment the 128-bit counter
+                for (int i = 15; i >= 0; --i) {
+                    if (++counter[i] != 0) {
+                        break;
+                    }
+                }
+            }
+            aes_process_ecb_impl(ctx, ks, ks, blocks * 16, true);
+
+            // All but the last block are used up here, that one is kept for the next call.
+            size_t used = (blocks - 1) * 16;
+            for (size_t i = 0; i < used; i++) {
+                *out++ = *in++ ^ ks[i];
+            }
+            in_len -= used;
+            memcpy(ctr_params->encrypted_counter, ks + used, 16);
+        }
+
+        *out++ = *in++ ^ ctr_params->encrypted_counter[n];
+        n = (n + 1) & 0xf;
+        in_len--;
+    }
+
+    ctr_params->offset = n;
+}
+#endif
+
+#elif MICROPY_SSL_AXTLS
 STATIC void aes_initial_set_key_impl(AES_CTX_IMPL *ctx, const uint8_t *key, size_t keysize, const uint8_t iv[16]) {
     assert(16 == keysize || 32 == keysize);
     AES_set_key(ctx, key, iv, (16 == keysize) ? AES_MODE_128 : AES_MODE_256);
@@ -166,9 +246,7 @@ STATIC void aes_process_ctr_impl(AES_CTX_IMPL *ctx, const uint8_t *in, uint8_t *
 }
 #endif
 
-#endif
-
-#if MICROPY_SSL_MBEDTLS
+#elif MICROPY_SSL_MBEDTLS
 STATIC void aes_initial_set_key_impl(AES_CTX_IMPL *ctx, const uint8_t *key, size_t keysize, const uint8_t iv[16]) {
     ctx->u.init_data.keysize = keysize;
     memcpy(ctx->u.init_data.key, key, keysize);
@@ -236,7 +314,11 @@ STATIC mp_obj_t ucryptolib_aes_make_new(const mp_obj_type_t *type, size_t n_args
 
     mp_buffer_info_t keyinfo;
     mp_get_buffer_raise(args[0], &keyinfo, MP_BUFFER_READ);
+    #if MICROPY_PY_UCRYPTOLIB_HW
+    if (16 != keyinfo.len) {
+    #else
     if (32 != keyinfo.len && 16 != keyinfo.len) {
+    #endif
         mp_raise_ValueError("key");
     }
 
@@ -306,6 +388,11 @@ STATIC mp_obj_t aes_process(size_t n_args, const mp_obj_t *args, bool encrypt) {
     }
 
     switch (self->block_mode) {
+        #if MICROPY_PY_UCRYPTOLIB_HW
+        case UCRYPTOLIB_MODE_ECB:
+            aes_process_ecb_impl(&self->ctx, in_bufinfo.buf, out_buf_ptr, in_bufinfo.len, encrypt);
+            break;
+        #else
         case UCRYPTOLIB_MODE_ECB: {
             uint8_t *in = in_bufinfo.buf, *out = out_buf_ptr;
             uint8_t *top = in + in_bufinfo.len;
@@ -314,6 +401,7 @@ STATIC mp_obj_t aes_process(size_t n_args, const mp_obj_t *args, bool encrypt) {
             }
             break;
         }
+        #endif
 
         case UCRYPTOLIB_MODE_CBC:
             aes_process_cbc_impl(&self->ctx, in_bufinfo.buf, out_buf_ptr, in_bufinfo.len, encrypt);
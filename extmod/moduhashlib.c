@@ -31,6 +31,11 @@
 
 #if MICROPY_PY_UHASHLIB
 
+#if MICROPY_PY_UHASHLIB_HW
+#include "py/mperrno.h"
+#include "extmod/crypto_hw.h"
+#endif
+
 #if MICROPY_SSL_MBEDTLS
 #include "mbedtls/version.h"
 #endif
@@ -63,10 +68,62 @@ typedef struct _mp_obj_hash_t {
     char state[0];
 } mp_obj_hash_t;
 
+#if MICROPY_PY_UHASHLIB_HW
+// The port's hash engine; update() hands the buffer over as it is, without copying it.
+STATIC mp_obj_t uhashlib_hw_make_new(const mp_obj_type_t *type, int algo) {
+    mp_obj_hash_t *o = m_new_obj_var(mp_obj_hash_t, char, mp_hw_hash_ctx_size);
+    o->base.type = type;
+    if (mp_hw_hash_init(o->state, algo) != 0) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC mp_obj_t uhashlib_hw_update(mp_obj_t self_in, mp_obj_t arg) {
+    mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(arg, &bufinfo, MP_BUFFER_READ);
+    if (mp_hw_hash_update(self->state, bufinfo.buf, bufinfo.len) != 0) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+
+STATIC mp_obj_t uhashlib_hw_digest(mp_obj_t self_in, size_t len) {
+    mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
+    vstr_t vstr;
+    vstr_init_len(&vstr, 32);
+    if (mp_hw_hash_final(self->state, (byte*)vstr.buf) != 0) {
+        mp_raise_OSError(MP_EIO);
+    }
+    vstr.len = len;
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+#endif
+
 #if MICROPY_PY_UHASHLIB_SHA256
 STATIC mp_obj_t uhashlib_sha256_update(mp_obj_t self_in, mp_obj_t arg);
 
-#if MICROPY_SSL_MBEDTLS
+#if MICROPY_PY_UHASHLIB_HW
+
+STATIC mp_obj_t uhashlib_sha256_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 0, 1, false);
+    mp_obj_t o = uhashlib_hw_make_new(type, MP_HW_HASH_SHA256);
+    if (n_args == 1) {
+        uhashlib_sha256_update(o, args[0]);
+    }
+    return o;
+}
+
+STATIC mp_obj_t uhashlib_sha256_update(mp_obj_t self_in, mp_obj_t arg) {
+    return uhashlib_hw_update(self_in, arg);
+}
+
+STATIC mp_obj_t uhashlib_sha256_digest(mp_obj_t self_in) {
+    return uhashlib_hw_digest(self_in, 32);
+}
+
+#elif MICROPY_SSL_MBEDTLS
 
 #if MBEDTLS_VERSION_NUMBER < 0x02070000
 #define mbedtls_sha256_starts_ret mbedtls_sha256_starts
@@ -155,7 +212,25 @@ STATIC const mp_obj_type_t uhashlib_sha256_type = {
 #if MICROPY_PY_UHASHLIB_SHA1
 STATIC mp_obj_t uhashlib_sha1_update(mp_obj_t self_in, mp_obj_t arg);
 
-#if MICROPY_SSL_AXTLS
+#if MICROPY_PY_UHASHLIB_HW
+STATIC mp_obj_t uhashlib_sha1_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 0, 1, false);
+    mp_obj_t o = uhashlib_hw_make_new(type, MP_HW_HASH_SHA1);
+    if (n_args == 1) {
+        uhashlib_sha1_update(o, args[0]);
+    }
+    return o;
+}
+
+STATIC mp_obj_t uhashlib_sha1_update(mp_obj_t self_in, mp_obj_t arg) {
+    return uhashlib_hw_update(self_in, arg);
+}
+
+STATIC mp_obj_t uhashlib_sha1_digest(mp_obj_t self_in) {
+    return uhashlib_hw_digest(self_in, 20);
+}
+
+#elif MICROPY_SSL_AXTLS
 STATIC mp_obj_t uhashlib_sha1_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     mp_arg_check_num(n_args, n_kw, 0, 1, false);
     mp_obj_hash_t *o = m_new_obj_var(mp_obj_hash_t, char, sizeof(SHA1_CTX));
@@ -182,9 +257,8 @@ STATIC mp_obj_t uhashlib_sha1_digest(mp_obj_t self_in) {
     SHA1_Final((byte*)vstr.buf, (SHA1_CTX*)self->state);
     return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
 }
-#endif
 
-#if MICROPY_SSL_MBEDTLS
+#elif MICROPY_SSL_MBEDTLS
 
 #if MBEDTLS_VERSION_NUMBER < 0x02070000
 #define mbedtls_sha1_starts_ret mbedtls_sha1_starts
@@ -25,6 +25,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "py/objlist.h"
 #include "py/objstringio.h"
@@ -34,10 +35,49 @@
 
 #if MICROPY_PY_UJSON
 
+#if MICROPY_PY_UJSON_DUMP_BUF
+// dump() collects the output in a stack buffer and writes it in chunks, rather
+// than calling the stream once per token.
+typedef struct _ujson_dump_buf_t {
+    mp_obj_t stream;
+    size_t len;
+    char buf[MICROPY_PY_UJSON_DUMP_BUF];
+} ujson_dump_buf_t;
+
+STATIC void ujson_dump_flush(ujson_dump_buf_t *b) {
+    if (b->len > 0) {
+        mp_stream_write(b->stream, b->buf, b->len, MP_STREAM_RW_WRITE);
+        b->len = 0;
+    }
+}
+
+STATIC void ujson_dump_strn(void *data, const char *str, size_t len) {
+    ujson_dump_buf_t *b = data;
+    if (b->len + len > sizeof(b->buf)) {
+        ujson_dump_flush(b);
+        if (len > sizeof(b->buf)) {
+            mp_stream_write(b->stream, str, len, MP_STREAM_RW_WRITE);
+            return;
+        }
+    }
+    memcpy(b->buf + b->len, str, len);
+    b->len += len;
+}
+#endif
+
 STATIC mp_obj_t mod_ujson_dump(mp_obj_t obj, mp_obj_t stream) {
     mp_get_stream_raise(stream, MP_STREAM_OP_WRITE);
+    #if MICROPY_PY_UJSON_DUMP_BUF
+    ujson_dump_buf_t b;
+    b.stream = stream;
+    b.len = 0;
+    mp_print_t print = {&b, ujson_dump_strn};
+    mp_obj_print_helper(&print, obj, PRINT_JSON);
+    ujson_dump_flush(&b);
+    #else
     mp_print_t print = {MP_OBJ_TO_PTR(stream), mp_stream_write_adaptor};
     mp_obj_print_helper(&print, obj, PRINT_JSON);
+    #endif
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_ujson_dump_obj, mod_ujson_dump);
@@ -87,27 +127,109 @@ STATIC byte ujson_stream_next(ujson_stream_t *s) {
     return s->cur;
 }
 
-STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
-    const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
-    ujson_stream_t s = {stream_obj, stream_p->read, 0, 0};
-    vstr_t vstr;
-    vstr_init(&vstr, 8);
+STATIC NORETURN void ujson_fail(void) {
+    mp_raise_ValueError("syntax error in JSON");
+}
+
+// Parses the primitive whose first character cur has been consumed.
+STATIC mp_obj_t ujson_parse_primitive(ujson_stream_t *s, vstr_t *vstr, byte cur) {
+    switch (cur) {
+        case 'n':
+            if (S_CUR(*s) == 'u' && S_NEXT(*s) == 'l' && S_NEXT(*s) == 'l') {
+                S_NEXT(*s);
+                return mp_const_none;
+            }
+            break;
+        case 'f':
+            if (S_CUR(*s) == 'a' && S_NEXT(*s) == 'l' && S_NEXT(*s) == 's' && S_NEXT(*s) == 'e') {
+                S_NEXT(*s);
+                return mp_const_false;
+            }
+            break;
+        case 't':
+            if (S_CUR(*s) == 'r' && S_NEXT(*s) == 'u' && S_NEXT(*s) == 'e') {
+                S_NEXT(*s);
+                return mp_const_true;
+            }
+            break;
+        case '"':
+            vstr_reset(vstr);
+            for (; !S_END(*s) && S_CUR(*s) != '"';) {
+                byte c = S_CUR(*s);
+                if (c == '\\') {
+                    c = S_NEXT(*s);
+                    switch (c) {
+                        case 'b': c = 0x08; break;
+                        case 'f': c = 0x0c; break;
+                        case 'n': c = 0x0a; break;
+                        case 'r': c = 0x0d; break;
+                        case 't': c = 0x09; break;
+                        case 'u': {
+                            mp_uint_t num = 0;
+                            for (int i = 0; i < 4; i++) {
+                                c = (S_NEXT(*s) | 0x20) - '0';
+                                if (c > 9) {
+                                    c -= ('a' - ('9' + 1));
+                                }
+                                num = (num << 4) | c;
+                            }
+                            vstr_add_char(vstr, num);
+                            goto str_cont;
+                        }
+                    }
+                }
+                vstr_add_byte(vstr, c);
+            str_cont:
+                S_NEXT(*s);
+            }
+            if (S_END(*s)) {
+                break;
+            }
+            S_NEXT(*s);
+            return mp_obj_new_str(vstr->buf, vstr->len);
+        case '-':
+        case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': {
+            bool flt = false;
+            vstr_reset(vstr);
+            for (;;) {
+                vstr_add_byte(vstr, cur);
+                cur = S_CUR(*s);
+                if (cur == '.' || cur == 'E' || cur == 'e') {
+                    flt = true;
+                } else if (cur == '+' || cur == '-' || unichar_isdigit(cur)) {
+                    // pass
+                } else {
+                    break;
+                }
+                S_NEXT(*s);
+            }
+            if (flt) {
+                return mp_parse_num_decimal(vstr->buf, vstr->len, false, false, NULL);
+            } else {
+                return mp_parse_num_integer(vstr->buf, vstr->len, 10, NULL);
+            }
+        }
+    }
+    ujson_fail();
+}
+
+// Parses one value starting at the current character and stops after it.
+STATIC mp_obj_t ujson_parse_value(ujson_stream_t *s, vstr_t *vstr) {
     mp_obj_list_t stack; // we use a list as a simple stack for nested JSON
     stack.len = 0;
     stack.items = NULL;
     mp_obj_t stack_top = MP_OBJ_NULL;
     mp_obj_type_t *stack_top_type = NULL;
     mp_obj_t stack_key = MP_OBJ_NULL;
-    S_NEXT(s);
     for (;;) {
         cont:
-        if (S_END(s)) {
+        if (S_END(*s)) {
             break;
         }
         mp_obj_t next = MP_OBJ_NULL;
         bool enter = false;
-        byte cur = S_CUR(s);
-        S_NEXT(s);
+        byte cur = S_CUR(*s);
+        S_NEXT(*s);
         switch (cur) {
             case ',':
             case ':':
@@ -116,89 +238,6 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
             case '\n':
             case '\r':
                 goto cont;
-            case 'n':
-                if (S_CUR(s) == 'u' && S_NEXT(s) == 'l' && S_NEXT(s) == 'l') {
-                    S_NEXT(s);
-                    next = mp_const_none;
-                } else {
-                    goto fail;
-                }
-                break;
-            case 'f':
-                if (S_CUR(s) == 'a' && S_NEXT(s) == 'l' && S_NEXT(s) == 's' && S_NEXT(s) == 'e') {
-                    S_NEXT(s);
-                    next = mp_const_false;
-                } else {
-                    goto fail;
-                }
-                break;
-            case 't':
-                if (S_CUR(s) == 'r' && S_NEXT(s) == 'u' && S_NEXT(s) == 'e') {
-                    S_NEXT(s);
-                    next = mp_const_true;
-                } else {
-                    goto fail;
-                }
-                break;
-            case '"':
-                vstr_reset(&vstr);
-                for (; !S_END(s) && S_CUR(s) != '"';) {
-                    byte c = S_CUR(s);
-                    if (c == '\\') {
-                        c = S_NEXT(s);
-                        switch (c) {
-                            case 'b': c = 0x08; break;
-                            case 'f': c = 0x0c; break;
-                            case 'n': c = 0x0a; break;
-                            case 'r': c = 0x0d; break;
-                            case 't': c = 0x09; break;
-                            case 'u': {
-                                mp_uint_t num = 0;
-                                for (int i = 0; i < 4; i++) {
-                                    c = (S_NEXT(s) | 0x20) - '0';
-                                    if (c > 9) {
-                                        c -= ('a' - ('9' + 1));
-                                    }
-                                    num = (num << 4) | c;
-                                }
-                                vstr_add_char(&vstr, num);
-                                goto str_cont;
-                            }
-                        }
-                    }
-                    vstr_add_byte(&vstr, c);
-                str_cont:
-                    S_NEXT(s);
-                }
-                if (S_END(s)) {
-                    goto fail;
-                }
-                S_NEXT(s);
-                next = mp_obj_new_str(vstr.buf, vstr.len);
-                break;
-            case '-':
-            case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': {
-                bool flt = false;
-                vstr_reset(&vstr);
-                for (;;) {
-                    vstr_add_byte(&vstr, cur);
-                    cur = S_CUR(s);
-                    if (cur == '.' || cur == 'E' || cur == 'e') {
-                        flt = true;
-                    } else if (cur == '+' || cur == '-' || unichar_isdigit(cur)) {
-                        // pass
-                    } else {
-                        break;
-                    }
-                    S_NEXT(s);
-                }
-                if (flt) {
-                    next = mp_parse_num_decimal(vstr.buf, vstr.len, false, false, NULL);
-                } else {
-                    next = mp_parse_num_integer(vstr.buf, vstr.len, 10, NULL);
-                }
-                break;
-            }
             case '[':
                 next = mp_obj_new_list(0, NULL);
                 enter = true;
@@ -215,7 +254,7 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
                 }
                 if (stack.len == 0) {
                     // finished; compound object
-                    goto success;
+                    return stack_top;
                 }
                 stack.len -= 1;
                 stack_top = stack.items[stack.len];
@@ -223,14 +262,15 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
                 goto cont;
             }
             default:
-                goto fail;
+                next = ujson_parse_primitive(s, vstr, cur);
+                break;
         }
         if (stack_top == MP_OBJ_NULL) {
             stack_top = next;
             stack_top_type = mp_obj_get_type(stack_top);
             if (!enter) {
                 // finished; single primitive only
-                goto success;
+                return stack_top;
             }
         } else {
             // append to list or dict
@@ -259,24 +299,32 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
             }
         }
     }
-    success:
+    if (stack_top != MP_OBJ_NULL && stack.len == 0) {
+        // input ended inside the outermost container, take what there is
+        return stack_top;
+    }
+    fail:
+    // ran out of input, or not exactly 1 object
+    ujson_fail();
+}
+
+STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
+    const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
+    ujson_stream_t s = {stream_obj, stream_p->read, 0, 0};
+    vstr_t vstr;
+    vstr_init(&vstr, 8);
+    S_NEXT(s);
+    mp_obj_t value = ujson_parse_value(&s, &vstr);
     // eat trailing whitespace
     while (unichar_isspace(S_CUR(s))) {
         S_NEXT(s);
     }
     if (!S_END(s)) {
         // unexpected chars
-        goto fail;
-    }
-    if (stack_top == MP_OBJ_NULL || stack.len != 0) {
-        // not exactly 1 object
-        goto fail;
+        ujson_fail();
     }
     vstr_clear(&vstr);
-    return stack_top;
-
-    fail:
-    mp_raise_ValueError("syntax error in JSON");
+    return value;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_load_obj, mod_ujson_load);
 
@@ -289,12 +337,178 @@ STATIC mp_obj_t mod_ujson_loads(mp_obj_t obj) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_loads_obj, mod_ujson_loads);
 
+#if MICROPY_PY_UJSON_PARSER
+// ujson.Parser(stream): a pull parser that reads the stream as it goes and
+// yields one event per token, so a document never has to be in RAM as a
+// whole.  Keys and primitives are in .value after their KEY/VALUE event;
+// load() builds the value that comes next, for small subtrees.  Several top
+// level values in a row (one per line telemetry) are allowed.
+
+enum {
+    UJSON_VALUE,
+    UJSON_KEY,
+    UJSON_START_ARRAY,
+    UJSON_END_ARRAY,
+    UJSON_START_OBJECT,
+    UJSON_END_OBJECT,
+};
+
+// one bit per open container
+#define UJSON_PARSER_MAX_DEPTH (32)
+
+typedef struct _mp_obj_ujson_parser_t {
+    mp_obj_base_t base;
+    ujson_stream_t s;
+    vstr_t vstr;
+    mp_obj_t value;
+    uint32_t in_object; // bit n is set if container n is an object
+    uint8_t depth;
+    bool expect_key;
+} mp_obj_ujson_parser_t;
+
+STATIC mp_obj_t ujson_parser_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+    const mp_stream_p_t *stream_p = mp_get_stream_raise(args[0], MP_STREAM_OP_READ);
+    mp_obj_ujson_parser_t *self = m_new_obj(mp_obj_ujson_parser_t);
+    self->base.type = type;
+    self->s.stream_obj = args[0];
+    self->s.read = stream_p->read;
+    self->s.errcode = 0;
+    self->s.cur = 0;
+    vstr_init(&self->vstr, 8);
+    self->value = mp_const_none;
+    self->in_object = 0;
+    self->depth = 0;
+    self->expect_key = false;
+    S_NEXT(self->s);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+STATIC bool ujson_parser_in_object(mp_obj_ujson_parser_t *self) {
+    return self->depth > 0 && (self->in_object & (1 << (self->depth - 1)));
+}
+
+// Skips separators, returns false at the end of the stream.
+STATIC bool ujson_parser_skip(mp_obj_ujson_parser_t *self) {
+    for (;;) {
+        switch (S_CUR(self->s)) {
+            case S_EOF:
+                if (self->depth != 0) {
+                    ujson_fail();
+                }
+                return false;
+            case ',':
+            case ':':
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                S_NEXT(self->s);
+                break;
+            default:
+                return true;
+        }
+    }
+}
+
+STATIC mp_obj_t ujson_parser_iternext(mp_obj_t self_in) {
+    mp_obj_ujson_parser_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!ujson_parser_skip(self)) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    byte cur = S_CUR(self->s);
+    S_NEXT(self->s);
+    bool in_object = ujson_parser_in_object(self);
+    int event;
+    switch (cur) {
+        case '[':
+        case '{':
+            if ((in_object && self->expect_key) || self->depth == UJSON_PARSER_MAX_DEPTH) {
+                ujson_fail();
+            }
+            if (cur == '{') {
+                self->in_object |= 1 << self->depth;
+                event = UJSON_START_OBJECT;
+            } else {
+                self->in_object &= ~(1 << self->depth);
+                event = UJSON_START_ARRAY;
+            }
+            self->depth += 1;
+            self->expect_key = (cur == '{');
+            self->value = mp_const_none;
+            return MP_OBJ_NEW_SMALL_INT(event);
+        case ']':
+        case '}':
+            if (self->depth == 0 || in_object != (cur == '}') || (in_object && !self->expect_key)) {
+                ujson_fail();
+            }
+            self->depth -= 1;
+            // the container was its parent's value
+            self->expect_key = ujson_parser_in_object(self);
+            self->value = mp_const_none;
+            return MP_OBJ_NEW_SMALL_INT(cur == '}' ? UJSON_END_OBJECT : UJSON_END_ARRAY);
+        default:
+            if (in_object && self->expect_key && cur != '"') {
+                ujson_fail();
+            }
+            self->value = ujson_parse_primitive(&self->s, &self->vstr, cur);
+            event = (in_object && self->expect_key) ? UJSON_KEY : UJSON_VALUE;
+            self->expect_key = in_object && !self->expect_key;
+            return MP_OBJ_NEW_SMALL_INT(event);
+    }
+}
+
+// Parser.load(): builds and returns the next value, consuming all its events.
+STATIC mp_obj_t ujson_parser_load(mp_obj_t self_in) {
+    mp_obj_ujson_parser_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!ujson_parser_skip(self) || (ujson_parser_in_object(self) && self->expect_key)) {
+        ujson_fail();
+    }
+    mp_obj_t value = ujson_parse_value(&self->s, &self->vstr);
+    self->expect_key = ujson_parser_in_object(self);
+    self->value = mp_const_none;
+    return value;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(ujson_parser_load_obj, ujson_parser_load);
+
+STATIC void ujson_parser_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    if (dest[0] != MP_OBJ_NULL) {
+        return;
+    }
+    mp_obj_ujson_parser_t *self = MP_OBJ_TO_PTR(self_in);
+    if (attr == MP_QSTR_value) {
+        dest[0] = self->value;
+    } else if (attr == MP_QSTR_load) {
+        dest[0] = MP_OBJ_FROM_PTR(&ujson_parser_load_obj);
+        dest[1] = self_in;
+    }
+}
+
+STATIC const mp_obj_type_t ujson_parser_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Parser,
+    .make_new = ujson_parser_make_new,
+    .getiter = mp_identity_getiter,
+    .iternext = ujson_parser_iternext,
+    .attr = ujson_parser_attr,
+};
+#endif
+
 STATIC const mp_rom_map_elem_t mp_module_ujson_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_ujson) },
     { MP_ROM_QSTR(MP_QSTR_dump), MP_ROM_PTR(&mod_ujson_dump_obj) },
     { MP_ROM_QSTR(MP_QSTR_dumps), MP_ROM_PTR(&mod_ujson_dumps_obj) },
     { MP_ROM_QSTR(MP_QSTR_load), MP_ROM_PTR(&mod_ujson_load_obj) },
     { MP_ROM_QSTR(MP_QSTR_loads), MP_ROM_PTR(&mod_ujson_loads_obj) },
+    #if MICROPY_PY_UJSON_PARSER
+    { MP_ROM_QSTR(MP_QSTR_Parser), MP_ROM_PTR(&ujson_parser_type) },
+    { MP_ROM_QSTR(MP_QSTR_VALUE), MP_ROM_INT(UJSON_VALUE) },
+    { MP_ROM_QSTR(MP_QSTR_KEY), MP_ROM_INT(UJSON_KEY) },
+    { MP_ROM_QSTR(MP_QSTR_START_ARRAY), MP_ROM_INT(UJSON_START_ARRAY) },
+    { MP_ROM_QSTR(MP_QSTR_END_ARRAY), MP_ROM_INT(UJSON_END_ARRAY) },
+    { MP_ROM_QSTR(MP_QSTR_START_OBJECT), MP_ROM_INT(UJSON_START_OBJECT) },
+    { MP_ROM_QSTR(MP_QSTR_END_OBJECT), MP_ROM_INT(UJSON_END_OBJECT) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_ujson_globals, mp_module_ujson_globals_table);
@@ -41,8 +41,14 @@
 
 #define FLAG_DEBUG 0x1000
 
+#define URE_PREFIX_MAX (8)
+
 typedef struct _mp_obj_re_t {
     mp_obj_base_t base;
+    // Literal bytes every match starts with, and whether it's anchored by ^.
+    uint8_t prefix_len;
+    bool bol;
+    char prefix[URE_PREFIX_MAX];
     ByteProg re;
 } mp_obj_re_t;
 
@@ -173,6 +179,56 @@ STATIC void re_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t
     mp_printf(print, "<re %p>", self);
 }
 
+// Walks the straight line code after the search prefix for the Char ops that
+// start every match, Saves take no input and are stepped over.
+STATIC void re_scan_prefix(mp_obj_re_t *o) {
+    const char *pc = o->re.insts + NON_ANCHORED_PREFIX;
+    o->prefix_len = 0;
+    o->bol = false;
+    for (;;) {
+        if (*pc == Save) {
+            pc += 2;
+        } else if (*pc == Bol && o->prefix_len == 0) {
+            o->bol = true;
+            pc++;
+        } else if (*pc == Char && o->prefix_len < URE_PREFIX_MAX) {
+            o->prefix[o->prefix_len++] = pc[1];
+            pc += 2;
+        } else {
+            break;
+        }
+    }
+}
+
+// Runs the program, a search only where memchr() finds the literal prefix.
+STATIC int ure_run(mp_obj_re_t *self, Subject *subj, const char **caps, int caps_num, bool is_anchored) {
+    // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
+    memset((char*)caps, 0, caps_num * sizeof(char*));
+    size_t n = self->prefix_len;
+    if (is_anchored || self->bol) {
+        if ((size_t)(subj->end - subj->begin) < n || memcmp(subj->begin, self->prefix, n) != 0) {
+            return 0;
+        }
+        return re1_5_recursiveloopprog(&self->re, subj, caps, caps_num, true);
+    }
+    if (n == 0) {
+        return re1_5_recursiveloopprog(&self->re, subj, caps, caps_num, false);
+    }
+    const char *sp = subj->begin;
+    while ((size_t)(subj->end - sp) >= n) {
+        sp = memchr(sp, self->prefix[0], subj->end - sp - n + 1);
+        if (sp == NULL) {
+            break;
+        }
+        if (memcmp(sp + 1, self->prefix + 1, n - 1) == 0
+            && re1_5_recursiveloopprog_from(&self->re, subj, sp, caps, caps_num)) {
+            return 1;
+        }
+        sp++;
+    }
+    return 0;
+}
+
 STATIC mp_obj_t ure_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     (void)n_args;
     mp_obj_re_t *self = MP_OBJ_TO_PTR(args[0]);
@@ -181,19 +237,22 @@ STATIC mp_obj_t ure_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     subj.begin = mp_obj_str_get_data(args[1], &len);
     subj.end = subj.begin + len;
     int caps_num = (self->re.sub + 1) * 2;
-    mp_obj_match_t *match = m_new_obj_var(mp_obj_match_t, char*, caps_num);
-    // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
-    memset((char*)match->caps, 0, caps_num * sizeof(char*));
-    int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, is_anchored);
-    if (res == 0) {
-        m_del_var(mp_obj_match_t, char*, caps_num, match);
-        return mp_const_none;
+    // Only a match gets a heap object, failing lines are the common case when scanning input.
+    const char **caps = mp_local_alloc(caps_num * sizeof(char*));
+    int res = ure_run(self, &subj, caps, caps_num, is_anchored);
+    mp_obj_t ret = mp_const_none;
+    if (res != 0) {
+        mp_obj_match_t *match = m_new_obj_var(mp_obj_match_t, char*, caps_num);
+        // cast is a workaround for a bug in msvc (see above)
+        memcpy((char*)match->caps, caps, caps_num * sizeof(char*));
+        match->base.type = &match_type;
+        match->num_matches = caps_num / 2; // caps_num counts start and end pointers
+        match->str = args[1];
+        ret = MP_OBJ_FROM_PTR(match);
     }
-
-    match->base.type = &match_type;
-    match->num_matches = caps_num / 2; // caps_num counts start and end pointers
-    match->str = args[1];
-    return MP_OBJ_FROM_PTR(match);
+    // cast is a workaround for a bug in msvc (see above)
+    mp_local_free((char**)caps);
+    return ret;
 }
 
 STATIC mp_obj_t re_match(size_t n_args, const mp_obj_t *args) {
@@ -206,6 +265,46 @@ STATIC mp_obj_t re_search(size_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(re_search_obj, 2, 4, re_search);
 
+#if MICROPY_PY_URE_MATCH_INTO
+
+// Like match()/search() but the result goes into m, a match object an earlier
+// call with this pattern returned, and m or None is returned. Nothing is
+// allocated; after None all of m's groups are None.
+STATIC mp_obj_t ure_exec_into(bool is_anchored, const mp_obj_t *args) {
+    mp_obj_re_t *self = MP_OBJ_TO_PTR(args[0]);
+    if (!mp_obj_is_type(args[2], &match_type)) {
+        mp_raise_TypeError(NULL);
+    }
+    mp_obj_match_t *match = MP_OBJ_TO_PTR(args[2]);
+    int caps_num = (self->re.sub + 1) * 2;
+    if (match->num_matches != caps_num / 2) {
+        mp_raise_ValueError(NULL);
+    }
+    Subject subj;
+    size_t len;
+    subj.begin = mp_obj_str_get_data(args[1], &len);
+    subj.end = subj.begin + len;
+    if (ure_run(self, &subj, match->caps, caps_num, is_anchored) == 0) {
+        return mp_const_none;
+    }
+    match->str = args[1];
+    return args[2];
+}
+
+STATIC mp_obj_t re_match_into(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    return ure_exec_into(true, args);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(re_match_into_obj, 3, 3, re_match_into);
+
+STATIC mp_obj_t re_search_into(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    return ure_exec_into(false, args);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(re_search_into_obj, 3, 3, re_search_into);
+
+#endif
+
 STATIC mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
     mp_obj_re_t *self = MP_OBJ_TO_PTR(args[0]);
     Subject subj;
@@ -223,9 +322,7 @@ STATIC mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
     mp_obj_t retval = mp_obj_new_list(0, NULL);
     const char **caps = mp_local_alloc(caps_num * sizeof(char*));
     while (true) {
-        // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
-        memset((char**)caps, 0, caps_num * sizeof(char*));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, caps, caps_num, false);
+        int res = ure_run(self, &subj, caps, caps_num, false);
 
         // if we didn't have a match, or had an empty match, it's time to stop
         if (!res || caps[0] == caps[1]) {
@@ -278,9 +375,7 @@ STATIC mp_obj_t re_sub_helper(mp_obj_t self_in, size_t n_args, const mp_obj_t *a
     match->str = where;
 
     for (;;) {
-        // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
-        memset((char*)match->caps, 0, caps_num * sizeof(char*));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, false);
+        int res = ure_run(self, &subj, match->caps, caps_num, false);
 
         // If we didn't have a match, or had an empty match, it's time to stop
         if (!res || match->caps[0] == match->caps[1]) {
@@ -369,6 +464,10 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(re_sub_obj, 3, 5, re_sub);
 STATIC const mp_rom_map_elem_t re_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_match), MP_ROM_PTR(&re_match_obj) },
     { MP_ROM_QSTR(MP_QSTR_search), MP_ROM_PTR(&re_search_obj) },
+    #if MICROPY_PY_URE_MATCH_INTO
+    { MP_ROM_QSTR(MP_QSTR_match_into), MP_ROM_PTR(&re_match_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_search_into), MP_ROM_PTR(&re_search_into_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_split), MP_ROM_PTR(&re_split_obj) },
     #if MICROPY_PY_URE_SUB
     { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&re_sub_obj) },
@@ -385,8 +484,42 @@ STATIC const mp_obj_type_t re_type = {
 };
 #endif
 
+#if MICROPY_PY_URE_CACHE
+
+// Patterns compiled without flags, as (pattern, re) pairs most recently used first.
+STATIC mp_obj_t re_cache_lookup(mp_obj_t pattern) {
+    mp_obj_t *cache = MP_STATE_VM(ure_cache);
+    for (size_t i = 0; i < MICROPY_PY_URE_CACHE * 2 && cache[i] != MP_OBJ_NULL; i += 2) {
+        if (cache[i] == pattern || mp_obj_equal(cache[i], pattern)) {
+            mp_obj_t re = cache[i + 1];
+            memmove(cache + 2, cache, i * sizeof(mp_obj_t));
+            cache[0] = pattern;
+            cache[1] = re;
+            return re;
+        }
+    }
+    return MP_OBJ_NULL;
+}
+
+STATIC void re_cache_store(mp_obj_t pattern, mp_obj_t re) {
+    mp_obj_t *cache = MP_STATE_VM(ure_cache);
+    memmove(cache + 2, cache, (MICROPY_PY_URE_CACHE - 1) * 2 * sizeof(mp_obj_t));
+    cache[0] = pattern;
+    cache[1] = re;
+}
+
+#endif
+
 STATIC mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
     (void)n_args;
+    #if MICROPY_PY_URE_CACHE
+    if (n_args == 1) {
+        mp_obj_t re = re_cache_lookup(args[0]);
+        if (re != MP_OBJ_NULL) {
+            return re;
+        }
+    }
+    #endif
     const char *re_str = mp_obj_str_get_str(args[0]);
     int size = re1_5_sizecode(re_str);
     if (size == -1) {
@@ -405,6 +538,12 @@ STATIC mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
 error:
         mp_raise_ValueError("Error in regex");
     }
+    re_scan_prefix(o);
+    #if MICROPY_PY_URE_CACHE
+    if (n_args == 1) {
+        re_cache_store(args[0], MP_OBJ_FROM_PTR(o));
+    }
+    #endif
     #if MICROPY_PY_URE_DEBUG
     if (flags & FLAG_DEBUG) {
         re1_5_dumpcode(&o->re);
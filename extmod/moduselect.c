@@ -49,8 +49,34 @@ typedef struct _poll_obj_t {
     mp_uint_t (*ioctl)(mp_obj_t obj, mp_uint_t request, uintptr_t arg, int *errcode);
     mp_uint_t flags;
     mp_uint_t flags_ret;
+    #if MICROPY_STREAMS_POLL_NOTIFY
+    mp_uint_t notify;
+    #endif
 } poll_obj_t;
 
+#if MICROPY_STREAMS_POLL_NOTIFY
+// The poll flags obj signals with mp_stream_poll_notify, 0 if it doesn't know the
+// request. Python streams may raise for it, that counts as 0 too.
+STATIC mp_uint_t poll_obj_notify(poll_obj_t *poll_obj) {
+    mp_uint_t notify = 0;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        int errcode;
+        notify = poll_obj->ioctl(poll_obj->obj, MP_STREAM_POLL_NOTIFY, 0, &errcode);
+        nlr_pop();
+    }
+    if (notify == MP_STREAM_ERROR) {
+        return 0;
+    }
+    return notify & (MP_STREAM_POLL_RD | MP_STREAM_POLL_WR);
+}
+
+// Whether poll_obj has to be polled on every wakeup, not only after it signalled.
+static inline bool poll_obj_unnotified(poll_obj_t *poll_obj) {
+    return (poll_obj->flags & ~poll_obj->notify & (MP_STREAM_POLL_RD | MP_STREAM_POLL_WR)) != 0;
+}
+#endif
+
 STATIC void poll_map_add(mp_map_t *poll_map, const mp_obj_t *obj, mp_uint_t obj_len, mp_uint_t flags, bool or_flags) {
     for (mp_uint_t i = 0; i < obj_len; i++) {
         mp_map_elem_t *elem = mp_map_lookup(poll_map, mp_obj_id(obj[i]), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
@@ -62,6 +88,9 @@ STATIC void poll_map_add(mp_map_t *poll_map, const mp_obj_t *obj, mp_uint_t obj_
             poll_obj->ioctl = stream_p->ioctl;
             poll_obj->flags = flags;
             poll_obj->flags_ret = 0;
+            #if MICROPY_STREAMS_POLL_NOTIFY
+            poll_obj->notify = poll_obj_notify(poll_obj);
+            #endif
             elem->value = MP_OBJ_FROM_PTR(poll_obj);
         } else {
             // object exists; update its flags
@@ -74,6 +103,36 @@ STATIC void poll_map_add(mp_map_t *poll_map, const mp_obj_t *obj, mp_uint_t obj_
     }
 }
 
+// poll one object, returns 1 if it's ready
+STATIC mp_uint_t poll_obj_poll(poll_obj_t *poll_obj, size_t *rwx_num) {
+    int errcode;
+    mp_int_t ret = poll_obj->ioctl(poll_obj->obj, MP_STREAM_POLL, poll_obj->flags, &errcode);
+    poll_obj->flags_ret = ret;
+
+    if (ret == -1) {
+        // error doing ioctl
+        mp_raise_OSError(errcode);
+    }
+
+    if (ret == 0) {
+        return 0;
+    }
+
+    // object is ready
+    if (rwx_num != NULL) {
+        if (ret & MP_STREAM_POLL_RD) {
+            rwx_num[0] += 1;
+        }
+        if (ret & MP_STREAM_POLL_WR) {
+            rwx_num[1] += 1;
+        }
+        if ((ret & ~(MP_STREAM_POLL_RD | MP_STREAM_POLL_WR)) != 0) {
+            rwx_num[2] += 1;
+        }
+    }
+    return 1;
+}
+
 // poll each object in the map
 STATIC mp_uint_t poll_map_poll(mp_map_t *poll_map, size_t *rwx_num) {
     mp_uint_t n_ready = 0;
@@ -81,33 +140,71 @@ STATIC mp_uint_t poll_map_poll(mp_map_t *poll_map, size_t *rwx_num) {
         if (!mp_map_slot_is_filled(poll_map, i)) {
             continue;
         }
+        n_ready += poll_obj_poll(MP_OBJ_TO_PTR(poll_map->table[i].value), rwx_num);
+    }
+    return n_ready;
+}
 
-        poll_obj_t *poll_obj = MP_OBJ_TO_PTR(poll_map->table[i].value);
-        int errcode;
-        mp_int_t ret = poll_obj->ioctl(poll_obj->obj, MP_STREAM_POLL, poll_obj->flags, &errcode);
-        poll_obj->flags_ret = ret;
-
-        if (ret == -1) {
-            // error doing ioctl
-            mp_raise_OSError(errcode);
+#if MICROPY_STREAMS_POLL_NOTIFY
+// After a wakeup, poll the objects that signalled since *seen, plus the unnotified
+// ones if scan is set. Everything is polled if events were missed.
+STATIC mp_uint_t poll_map_poll_events(mp_map_t *poll_map, size_t *rwx_num, mp_uint_t *seen, bool scan) {
+    mp_uint_t seq = mp_stream_poll_seq;
+    mp_uint_t n_ready = 0;
+    bool all = false;
+    for (; *seen != seq; ++*seen) {
+        const void *obj = mp_stream_poll_event(*seen);
+        if (obj == NULL) {
+            all = true;
+            break;
         }
-
-        if (ret != 0) {
-            // object is ready
-            n_ready += 1;
-            if (rwx_num != NULL) {
-                if (ret & MP_STREAM_POLL_RD) {
-                    rwx_num[0] += 1;
-                }
-                if (ret & MP_STREAM_POLL_WR) {
-                    rwx_num[1] += 1;
-                }
-                if ((ret & ~(MP_STREAM_POLL_RD | MP_STREAM_POLL_WR)) != 0) {
-                    rwx_num[2] += 1;
-                }
+        mp_map_elem_t *elem = mp_map_lookup(poll_map, mp_obj_id(MP_OBJ_FROM_PTR(obj)), MP_MAP_LOOKUP);
+        if (elem != NULL) {
+            poll_obj_t *poll_obj = MP_OBJ_TO_PTR(elem->value);
+            if (poll_obj->flags_ret == 0) {
+                n_ready += poll_obj_poll(poll_obj, rwx_num);
             }
         }
     }
+    *seen = seq;
+    if (scan || all) {
+        for (mp_uint_t i = 0; i < poll_map->alloc; ++i) {
+            if (!mp_map_slot_is_filled(poll_map, i)) {
+                continue;
+            }
+            poll_obj_t *poll_obj = MP_OBJ_TO_PTR(poll_map->table[i].value);
+            if (poll_obj->flags_ret == 0 && (all || poll_obj_unnotified(poll_obj))) {
+                n_ready += poll_obj_poll(poll_obj, rwx_num);
+            }
+        }
+    }
+    return n_ready;
+}
+#endif
+
+// poll the objects until one is ready or timeout ms have passed (-1 for no timeout),
+// sleeping in the event hook between polls
+STATIC mp_uint_t poll_map_wait(mp_map_t *poll_map, size_t *rwx_num, mp_uint_t timeout) {
+    mp_uint_t start_tick = mp_hal_ticks_ms();
+    #if MICROPY_STREAMS_POLL_NOTIFY
+    mp_uint_t seen = mp_stream_poll_seq;
+    bool scan = false;
+    for (mp_uint_t i = 0; i < poll_map->alloc; ++i) {
+        if (mp_map_slot_is_filled(poll_map, i) && poll_obj_unnotified(MP_OBJ_TO_PTR(poll_map->table[i].value))) {
+            scan = true;
+            break;
+        }
+    }
+    #endif
+    mp_uint_t n_ready = poll_map_poll(poll_map, rwx_num);
+    while (n_ready == 0 && (timeout == -1 || mp_hal_ticks_ms() - start_tick < timeout)) {
+        MICROPY_EVENT_POLL_HOOK
+        #if MICROPY_STREAMS_POLL_NOTIFY
+        n_ready = poll_map_poll_events(poll_map, rwx_num, &seen, scan);
+        #else
+        n_ready = poll_map_poll(poll_map, rwx_num);
+        #endif
+    }
     return n_ready;
 }
 
@@ -142,39 +239,32 @@ STATIC mp_obj_t select_select(size_t n_args, const mp_obj_t *args) {
     poll_map_add(&poll_map, w_array, rwx_len[1], MP_STREAM_POLL_WR, true);
     poll_map_add(&poll_map, x_array, rwx_len[2], MP_STREAM_POLL_ERR | MP_STREAM_POLL_HUP, true);
 
-    mp_uint_t start_tick = mp_hal_ticks_ms();
     rwx_len[0] = rwx_len[1] = rwx_len[2] = 0;
-    for (;;) {
-        // poll the objects
-        mp_uint_t n_ready = poll_map_poll(&poll_map, rwx_len);
-
-        if (n_ready > 0 || (timeout != -1 && mp_hal_ticks_ms() - start_tick >= timeout)) {
-            // one or more objects are ready, or we had a timeout
-            mp_obj_t list_array[3];
-            list_array[0] = mp_obj_new_list(rwx_len[0], NULL);
-            list_array[1] = mp_obj_new_list(rwx_len[1], NULL);
-            list_array[2] = mp_obj_new_list(rwx_len[2], NULL);
-            rwx_len[0] = rwx_len[1] = rwx_len[2] = 0;
-            for (mp_uint_t i = 0; i < poll_map.alloc; ++i) {
-                if (!mp_map_slot_is_filled(&poll_map, i)) {
-                    continue;
-                }
-                poll_obj_t *poll_obj = MP_OBJ_TO_PTR(poll_map.table[i].value);
-                if (poll_obj->flags_ret & MP_STREAM_POLL_RD) {
-                    ((mp_obj_list_t*)MP_OBJ_TO_PTR(list_array[0]))->items[rwx_len[0]++] = poll_obj->obj;
-                }
-                if (poll_obj->flags_ret & MP_STREAM_POLL_WR) {
-                    ((mp_obj_list_t*)MP_OBJ_TO_PTR(list_array[1]))->items[rwx_len[1]++] = poll_obj->obj;
-                }
-                if ((poll_obj->flags_ret & ~(MP_STREAM_POLL_RD | MP_STREAM_POLL_WR)) != 0) {
-                    ((mp_obj_list_t*)MP_OBJ_TO_PTR(list_array[2]))->items[rwx_len[2]++] = poll_obj->obj;
-                }
-            }
-            mp_map_deinit(&poll_map);
-            return mp_obj_new_tuple(3, list_array);
+    poll_map_wait(&poll_map, rwx_len, timeout);
+
+    // one or more objects are ready, or we had a timeout
+    mp_obj_t list_array[3];
+    list_array[0] = mp_obj_new_list(rwx_len[0], NULL);
+    list_array[1] = mp_obj_new_list(rwx_len[1], NULL);
+    list_array[2] = mp_obj_new_list(rwx_len[2], NULL);
+    rwx_len[0] = rwx_len[1] = rwx_len[2] = 0;
+    for (mp_uint_t i = 0; i < poll_map.alloc; ++i) {
+        if (!mp_map_slot_is_filled(&poll_map, i)) {
+            continue;
+        }
+        poll_obj_t *poll_obj = MP_OBJ_TO_PTR(poll_map.table[i].value);
+        if (poll_obj->flags_ret & MP_STREAM_POLL_RD) {
+            ((mp_obj_list_t*)MP_OBJ_TO_PTR(list_array[0]))->items[rwx_len[0]++] = poll_obj->obj;
+        }
+        if (poll_obj->flags_ret & MP_STREAM_POLL_WR) {
+            ((mp_obj_list_t*)MP_OBJ_TO_PTR(list_array[1]))->items[rwx_len[1]++] = poll_obj->obj;
+        }
+        if ((poll_obj->flags_ret & ~(MP_STREAM_POLL_RD | MP_STREAM_POLL_WR)) != 0) {
+            ((mp_obj_list_t*)MP_OBJ_TO_PTR(list_array[2]))->items[rwx_len[2]++] = poll_obj->obj;
         }
-        do {EventPollHook();} while(0);
     }
+    mp_map_deinit(&poll_map);
+    return mp_obj_new_tuple(3, list_array);
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_select_select_obj, 3, 4, select_select);
 
@@ -245,18 +335,7 @@ STATIC mp_uint_t poll_poll_internal(uint n_args, const mp_obj_t *args) {
 
     self->flags = flags;
 
-    mp_uint_t start_tick = mp_hal_ticks_ms();
-    mp_uint_t n_ready;
-    for (;;) {
-        // poll the objects
-        n_ready = poll_map_poll(&self->poll_map, NULL);
-        if (n_ready > 0 || (timeout != -1 && mp_hal_ticks_ms() - start_tick >= timeout)) {
-            break;
-        }
-        MICROPY_EVENT_POLL_HOOK
-    }
-
-    return n_ready;
+    return poll_map_wait(&self->poll_map, NULL, timeout);
 }
 
 STATIC mp_obj_t poll_poll(size_t n_args, const mp_obj_t *args) {
@@ -56,15 +56,23 @@ typedef struct _mp_obj_ssl_socket_t {
     mbedtls_pk_context pkey;
 } mp_obj_ssl_socket_t;
 
+// A finished handshake, given back to wrap_socket() to resume it on a new connection.
+typedef struct _mp_obj_ssl_session_t {
+    mp_obj_base_t base;
+    mbedtls_ssl_session session;
+} mp_obj_ssl_session_t;
+
 struct ssl_args {
     mp_arg_val_t key;
     mp_arg_val_t cert;
     mp_arg_val_t server_side;
     mp_arg_val_t server_hostname;
     mp_arg_val_t do_handshake;
+    mp_arg_val_t session;
 };
 
 STATIC const mp_obj_type_t ussl_socket_type;
+STATIC const mp_obj_type_t ussl_session_type;
 
 #ifdef MBEDTLS_DEBUG_C
 STATIC void mbedtls_debug(void *ctx, int level, const char *file, int line, const char *str) {
@@ -169,6 +177,18 @@ STATIC mp_obj_ssl_socket_t *socket_new(mp_obj_t sock, struct ssl_args *args) {
 
     mbedtls_ssl_set_bio(&o->ssl, &o->sock, _mbedtls_ssl_send, _mbedtls_ssl_recv, NULL);
 
+    if (args->session.u_obj != mp_const_none) {
+        if (!MP_OBJ_IS_TYPE(args->session.u_obj, &ussl_session_type)) {
+            mp_raise_TypeError("session expected");
+        }
+        mp_obj_ssl_session_t *s = MP_OBJ_TO_PTR(args->session.u_obj);
+        // The server falls back to a full handshake if it has forgotten the session.
+        ret = mbedtls_ssl_set_session(&o->ssl, &s->session);
+        if (ret != 0) {
+            goto cleanup;
+        }
+    }
+
     if (args->key.u_obj != mp_const_none) {
         size_t key_len;
         const byte *key = (const byte*)mp_obj_str_get_data(args->key.u_obj, &key_len);
@@ -238,6 +258,26 @@ STATIC mp_obj_t mod_ssl_getpeercert(mp_obj_t o_in, mp_obj_t binary_form) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_ssl_getpeercert_obj, mod_ssl_getpeercert);
 
+STATIC mp_obj_t mod_ssl_session(mp_obj_t o_in) {
+    mp_obj_ssl_socket_t *o = MP_OBJ_TO_PTR(o_in);
+#if MICROPY_PY_USSL_FINALISER
+    mp_obj_ssl_session_t *s = m_new_obj_with_finaliser(mp_obj_ssl_session_t);
+#else
+    mp_obj_ssl_session_t *s = m_new_obj(mp_obj_ssl_session_t);
+#endif
+    s->base.type = &ussl_session_type;
+    mbedtls_ssl_session_init(&s->session);
+    int ret = mbedtls_ssl_get_session(&o->ssl, &s->session);
+    if (ret == MBEDTLS_ERR_SSL_ALLOC_FAILED) {
+        mp_raise_OSError(MP_ENOMEM);
+    } else if (ret != 0) {
+        // no finished client handshake
+        return mp_const_none;
+    }
+    return MP_OBJ_FROM_PTR(s);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ssl_session_obj, mod_ssl_session);
+
 STATIC void socket_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
     (void)kind;
     mp_obj_ssl_socket_t *self = MP_OBJ_TO_PTR(self_in);
@@ -322,6 +362,7 @@ STATIC const mp_rom_map_elem_t ussl_socket_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&mp_stream_close_obj) },
 #endif
     { MP_ROM_QSTR(MP_QSTR_getpeercert), MP_ROM_PTR(&mod_ssl_getpeercert_obj) },
+    { MP_ROM_QSTR(MP_QSTR_session), MP_ROM_PTR(&mod_ssl_session_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(ussl_socket_locals_dict, ussl_socket_locals_dict_table);
@@ -343,6 +384,29 @@ STATIC const mp_obj_type_t ussl_socket_type = {
     .locals_dict = (void*)&ussl_socket_locals_dict,
 };
 
+#if MICROPY_PY_USSL_FINALISER
+STATIC mp_obj_t session_del(mp_obj_t self_in) {
+    mp_obj_ssl_session_t *self = MP_OBJ_TO_PTR(self_in);
+    mbedtls_ssl_session_free(&self->session);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(session_del_obj, session_del);
+
+STATIC const mp_rom_map_elem_t ussl_session_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&session_del_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(ussl_session_locals_dict, ussl_session_locals_dict_table);
+#endif
+
+STATIC const mp_obj_type_t ussl_session_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_session,
+#if MICROPY_PY_USSL_FINALISER
+    .locals_dict = (void*)&ussl_session_locals_dict,
+#endif
+};
+
 STATIC mp_obj_t mod_ssl_wrap_socket(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     // TODO: Implement more args
     static const mp_arg_t allowed_args[] = {
@@ -351,6 +415,7 @@ STATIC mp_obj_t mod_ssl_wrap_socket(size_t n_args, const mp_obj_t *pos_args, mp_
         { MP_QSTR_server_side, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
         { MP_QSTR_server_hostname, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_PTR(&mp_const_none_obj)} },
         { MP_QSTR_do_handshake, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_session, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_PTR(&mp_const_none_obj)} },
     };
 
     // TODO: Check that sock implements stream protocol
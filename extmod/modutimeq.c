@@ -207,6 +207,268 @@ STATIC const mp_rom_map_elem_t utimeq_locals_dict_table[] = {
 
 STATIC MP_DEFINE_CONST_DICT(utimeq_locals_dict, utimeq_locals_dict_table);
 
+#if MICROPY_PY_UTIMEQ_WHEEL
+
+// Hierarchical timer wheel with the same push/pop/peektime interface as utimeq.
+//
+// Level L has 64 slots, each one a FIFO list of the entries whose time shares every
+// digit above L with the wheel's cursor (now) and has digit L equal to the slot index.
+// An entry is placed by the highest 6-bit digit where its time differs from now, so
+// push is O(1). Popping takes the first used slot of level 0; when level 0 is empty the
+// next used slot of the lowest used level is cascaded down one block. Entries of the
+// same time always share a slot so they pop in the order they were pushed, and a push
+// before the cursor rebases the wheel, so the order is always exact like utimeq's.
+// The ticks period must be a power of two (the default one is).
+
+#define WHEEL_BITS (6)
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_LEVELS ((BYTES_PER_WORD * 8 - 2 + WHEEL_BITS - 1) / WHEEL_BITS)
+#define WHEEL_NIL (0xffff)
+
+typedef struct _wheel_entry_t {
+    mp_uint_t time;
+    mp_obj_t callback;
+    mp_obj_t args;
+    uint16_t next;
+} wheel_entry_t;
+
+typedef struct _mp_obj_wheel_t {
+    mp_obj_base_t base;
+    mp_uint_t now;
+    uint16_t alloc;
+    uint16_t len;
+    uint16_t free;
+    uint32_t used[WHEEL_LEVELS][WHEEL_SLOTS / 32];
+    uint16_t head[WHEEL_LEVELS][WHEEL_SLOTS];
+    uint16_t tail[WHEEL_LEVELS][WHEEL_SLOTS];
+    wheel_entry_t items[];
+} mp_obj_wheel_t;
+
+static inline mp_uint_t wheel_delta(mp_obj_wheel_t *self, mp_uint_t time) {
+    return (time - self->now) & (MODULO - 1);
+}
+
+static inline uint32_t wheel_ctz(uint32_t x) {
+    #if defined(__GNUC__)
+    return __builtin_ctz(x);
+    #else
+    uint32_t n = 0;
+    for (; !(x & 1); x >>= 1) {
+        n++;
+    }
+    return n;
+    #endif
+}
+
+// First used slot at or after start in level, WHEEL_SLOTS if none.
+STATIC mp_uint_t wheel_find(mp_obj_wheel_t *self, mp_uint_t level, mp_uint_t start) {
+    for (mp_uint_t w = start / 32; w < WHEEL_SLOTS / 32; w++) {
+        uint32_t bits = self->used[level][w];
+        if (w == start / 32) {
+            bits &= ~0u << (start % 32);
+        }
+        if (bits) {
+            return (w * 32) + wheel_ctz(bits);
+        }
+    }
+    return WHEEL_SLOTS;
+}
+
+STATIC void wheel_link(mp_obj_wheel_t *self, uint16_t i) {
+    wheel_entry_t *e = &self->items[i];
+    mp_uint_t level = 0;
+    for (mp_uint_t x = (e->time ^ self->now) >> WHEEL_BITS; x; x >>= WHEEL_BITS) {
+        level++;
+    }
+    mp_uint_t slot = (e->time >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+    e->next = WHEEL_NIL;
+    if (self->head[level][slot] == WHEEL_NIL) {
+        self->head[level][slot] = i;
+        self->used[level][slot / 32] |= 1u << (slot % 32);
+    } else {
+        self->items[self->tail[level][slot]].next = i;
+    }
+    self->tail[level][slot] = i;
+}
+
+// Takes the list of a slot off the wheel, returns its head.
+STATIC uint16_t wheel_take(mp_obj_wheel_t *self, mp_uint_t level, mp_uint_t slot) {
+    uint16_t i = self->head[level][slot];
+    self->head[level][slot] = WHEEL_NIL;
+    self->used[level][slot / 32] &= ~(1u << (slot % 32));
+    return i;
+}
+
+// Next used slot of the lowest used level, looking past the cursor's own digit above
+// level 0 and wrapping around on the top level. Returns false if the wheel is empty.
+STATIC bool wheel_next(mp_obj_wheel_t *self, mp_uint_t *level_out, mp_uint_t *slot_out) {
+    for (mp_uint_t level = 0; level < WHEEL_LEVELS; level++) {
+        mp_uint_t digit = (self->now >> (level * WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+        mp_uint_t slot = wheel_find(self, level, level ? (digit + 1) : digit);
+        if (slot == WHEEL_SLOTS && level == WHEEL_LEVELS - 1) {
+            slot = wheel_find(self, level, 0);
+        }
+        if (slot != WHEEL_SLOTS) {
+            *level_out = level;
+            *slot_out = slot;
+            return true;
+        }
+    }
+    return false;
+}
+
+STATIC mp_obj_t wheel_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+    mp_uint_t alloc = mp_obj_get_int(args[0]);
+    if (alloc >= WHEEL_NIL) {
+        mp_raise_ValueError(NULL);
+    }
+    mp_obj_wheel_t *o = m_new_obj_var(mp_obj_wheel_t, wheel_entry_t, alloc);
+    memset(o, 0, sizeof(*o) + (sizeof(*o->items) * alloc));
+    memset(o->head, 0xff, sizeof(o->head));
+    o->base.type = type;
+    o->alloc = alloc;
+    for (mp_uint_t i = 0; i < alloc; i++) {
+        o->items[i].next = (i + 1 < alloc) ? (i + 1) : WHEEL_NIL;
+    }
+    o->free = alloc ? 0 : WHEEL_NIL;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC mp_obj_t wheel_push(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    mp_obj_wheel_t *self = MP_OBJ_TO_PTR(args[0]);
+    if (self->free == WHEEL_NIL) {
+        mp_raise_msg(&mp_type_IndexError, "queue overflow");
+    }
+    mp_uint_t time = mp_obj_get_int(args[1]) & (MODULO - 1);
+    if (self->len == 0) {
+        self->now = time;
+    } else if (wheel_delta(self, time) >= (MODULO / 2)) {
+        // Before the cursor, lay the wheel out again around the new time.
+        uint16_t list = WHEEL_NIL, last = WHEEL_NIL;
+        for (mp_uint_t level = 0; level < WHEEL_LEVELS; level++) {
+            for (mp_uint_t slot = 0; slot < WHEEL_SLOTS; slot++) {
+                if (self->head[level][slot] != WHEEL_NIL) {
+                    uint16_t tail = self->tail[level][slot];
+                    uint16_t head = wheel_take(self, level, slot);
+                    if (last == WHEEL_NIL) {
+                        list = head;
+                    } else {
+                        self->items[last].next = head;
+                    }
+                    last = tail;
+                }
+            }
+        }
+        self->now = time;
+        while (list != WHEEL_NIL) {
+            uint16_t next = self->items[list].next;
+            wheel_link(self, list);
+            list = next;
+        }
+    }
+    uint16_t i = self->free;
+    wheel_entry_t *e = &self->items[i];
+    self->free = e->next;
+    e->time = time;
+    e->callback = args[2];
+    e->args = args[3];
+    wheel_link(self, i);
+    self->len++;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(wheel_push_obj, 4, 4, wheel_push);
+
+STATIC mp_obj_t wheel_pop(mp_obj_t self_in, mp_obj_t list_ref) {
+    mp_obj_wheel_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_list_t *ret = MP_OBJ_TO_PTR(list_ref);
+    if (!mp_obj_is_type(list_ref, &mp_type_list) || ret->len < 3) {
+        mp_raise_TypeError(NULL);
+    }
+    mp_uint_t level, slot;
+    if (!wheel_next(self, &level, &slot)) {
+        mp_raise_msg(&mp_type_IndexError, "empty heap");
+    }
+    // Cascade down until the earliest entries are in level 0.
+    while (level) {
+        mp_uint_t shift = level * WHEEL_BITS;
+        mp_uint_t above = (level == WHEEL_LEVELS - 1) ? 0 : (self->now & ~((((mp_uint_t)WHEEL_SLOTS) << shift) - 1));
+        self->now = (above | (slot << shift)) & (MODULO - 1);
+        for (uint16_t i = wheel_take(self, level, slot); i != WHEEL_NIL;) {
+            uint16_t next = self->items[i].next;
+            wheel_link(self, i);
+            i = next;
+        }
+        wheel_next(self, &level, &slot);
+    }
+    uint16_t i = self->head[0][slot];
+    wheel_entry_t *e = &self->items[i];
+    self->head[0][slot] = e->next;
+    if (e->next == WHEEL_NIL) {
+        self->used[0][slot / 32] &= ~(1u << (slot % 32));
+    }
+    self->now = e->time;
+    ret->items[0] = MP_OBJ_NEW_SMALL_INT(e->time);
+    ret->items[1] = e->callback;
+    ret->items[2] = e->args;
+    e->callback = MP_OBJ_NULL; // so we don't retain a pointer
+    e->args = MP_OBJ_NULL;
+    e->next = self->free;
+    self->free = i;
+    self->len--;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(wheel_pop_obj, wheel_pop);
+
+// Doesn't move the cursor, so pushes made while waiting for the first entry stay O(1).
+STATIC mp_obj_t wheel_peektime(mp_obj_t self_in) {
+    mp_obj_wheel_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_uint_t level, slot;
+    if (!wheel_next(self, &level, &slot)) {
+        mp_raise_msg(&mp_type_IndexError, "empty heap");
+    }
+    uint16_t i = self->head[level][slot];
+    mp_uint_t time = self->items[i].time;
+    if (level) {
+        // Entries above level 0 aren't ordered within their slot.
+        for (i = self->items[i].next; i != WHEEL_NIL; i = self->items[i].next) {
+            if (wheel_delta(self, self->items[i].time) < wheel_delta(self, time)) {
+                time = self->items[i].time;
+            }
+        }
+    }
+    return MP_OBJ_NEW_SMALL_INT(time);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(wheel_peektime_obj, wheel_peektime);
+
+STATIC mp_obj_t wheel_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
+    mp_obj_wheel_t *self = MP_OBJ_TO_PTR(self_in);
+    switch (op) {
+        case MP_UNARY_OP_BOOL: return mp_obj_new_bool(self->len != 0);
+        case MP_UNARY_OP_LEN: return MP_OBJ_NEW_SMALL_INT(self->len);
+        default: return MP_OBJ_NULL; // op not supported
+    }
+}
+
+STATIC const mp_rom_map_elem_t wheel_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_push), MP_ROM_PTR(&wheel_push_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pop), MP_ROM_PTR(&wheel_pop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_peektime), MP_ROM_PTR(&wheel_peektime_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(wheel_locals_dict, wheel_locals_dict_table);
+
+STATIC const mp_obj_type_t wheel_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Wheel,
+    .make_new = wheel_make_new,
+    .unary_op = wheel_unary_op,
+    .locals_dict = (void*)&wheel_locals_dict,
+};
+
+#endif // MICROPY_PY_UTIMEQ_WHEEL
+
 STATIC const mp_obj_type_t utimeq_type = {
     { &mp_type_type },
     .name = MP_QSTR_utimeq,
@@ -218,6 +480,9 @@ STATIC const mp_obj_type_t utimeq_type = {
 STATIC const mp_rom_map_elem_t mp_module_utimeq_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_utimeq) },
     { MP_ROM_QSTR(MP_QSTR_utimeq), MP_ROM_PTR(&utimeq_type) },
+    #if MICROPY_PY_UTIMEQ_WHEEL
+    { MP_ROM_QSTR(MP_QSTR_Wheel), MP_ROM_PTR(&wheel_type) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_utimeq_globals, mp_module_utimeq_globals_table);
@@ -94,7 +94,8 @@ STATIC mp_obj_t decompio_make_new(const mp_obj_type_t *type, size_t n_args, size
 header_error:
             mp_raise_ValueError("compression header");
         }
-        dict_sz = 1 << dict_opt;
+        // The header gives log2 of the window less 8 (CINFO).
+        dict_sz = 1 << (dict_opt + 8);
     } else {
         dict_sz = 1 << -dict_opt;
     }
@@ -146,6 +147,323 @@ STATIC const mp_obj_type_t decompio_type = {
 };
 #endif
 
+#if MICROPY_PY_UZLIB_COMPIO
+
+// Streaming compressor: LZ77 over a sliding window, matches found through
+// hash chains, coded as static Huffman deflate blocks. The window, hash heads
+// and chain links come from the GC heap, i.e. DTCM on the RT10xx ports.
+
+#define COMPIO_MIN_MATCH (3)
+#define COMPIO_MAX_MATCH (258)
+// Enough input ahead of pos for the longest match, more is waited for unless flushing.
+#define COMPIO_LOOKAHEAD (COMPIO_MAX_MATCH + COMPIO_MIN_MATCH)
+#define COMPIO_OUT_SIZE (256)
+#define COMPIO_HASH_BITS_MAX (13)
+
+enum { COMPIO_RAW, COMPIO_ZLIB, COMPIO_GZIP };
+
+typedef struct _mp_obj_compio_t {
+    mp_obj_base_t base;
+    mp_obj_t dest_stream;
+    struct Outbuf out;
+    // 2 window sizes, the lower half is the history once pos gets into the upper one.
+    byte *win;
+    uint16_t *head;
+    uint16_t *prev;
+    unsigned int win_len;
+    unsigned int pos;
+    uint32_t checksum;
+    uint32_t in_len;
+    uint16_t max_chain;
+    uint16_t nice_len;
+    uint8_t wbits;
+    uint8_t hash_bits;
+    uint8_t format;
+    bool closed;
+} mp_obj_compio_t;
+
+// Chain length and the match length that ends the search early, per level.
+STATIC const uint16_t compio_levels[10][2] = {
+    {0, 0}, {4, 8}, {8, 16}, {16, 32}, {32, 32},
+    {64, 128}, {128, 128}, {256, 258}, {1024, 258}, {4096, 258},
+};
+
+STATIC void compio_drain(mp_obj_compio_t *o) {
+    if (o->out.outlen == 0) {
+        return;
+    }
+    int err;
+    mp_uint_t out_sz = mp_stream_write_exactly(o->dest_stream, o->out.outbuf, o->out.outlen, &err);
+    o->out.outlen = 0;
+    if (err != 0) {
+        mp_raise_OSError(err);
+    }
+    (void)out_sz;
+}
+
+STATIC void compio_put_bytes(mp_obj_compio_t *o, uint32_t v, int n, bool big_endian) {
+    for (int i = 0; i < n; i++) {
+        int shift = big_endian ? ((n - 1 - i) * 8) : (i * 8);
+        outbits(&o->out, (v >> shift) & 0xff, 8);
+    }
+}
+
+// Links p into its hash chain, returns the previous position with the same hash (0 for none).
+STATIC inline unsigned int compio_insert(mp_obj_compio_t *o, unsigned int p) {
+    const byte *s = o->win + p;
+    int shift = (o->hash_bits + 2) / 3;
+    unsigned int h = ((s[0] << (2 * shift)) ^ (s[1] << shift) ^ s[2]) & ((1 << o->hash_bits) - 1);
+    unsigned int cand = o->head[h];
+    o->prev[p & ((1 << o->wbits) - 1)] = cand;
+    o->head[h] = p;
+    return cand;
+}
+
+STATIC unsigned int compio_longest_match(mp_obj_compio_t *o, unsigned int cand, unsigned int max_len, unsigned int *dist) {
+    const byte *scan = o->win + o->pos;
+    unsigned int wsize = 1 << o->wbits;
+    unsigned int limit = (o->pos > wsize) ? (o->pos - wsize) : 0;
+    unsigned int chain = o->max_chain;
+    unsigned int best = COMPIO_MIN_MATCH - 1;
+    while (cand > limit && chain--) {
+        const byte *m = o->win + cand;
+        if (m[best] == scan[best] && m[0] == scan[0]) {
+            unsigned int len = 1;
+            while (len < max_len && m[len] == scan[len]) {
+                len++;
+            }
+            if (len > best) {
+                best = len;
+                *dist = o->pos - cand;
+                if (len >= o->nice_len || len == max_len) {
+                    break;
+                }
+            }
+        }
+        cand = o->prev[cand & (wsize - 1)];
+    }
+    return (best >= COMPIO_MIN_MATCH) ? best : 0;
+}
+
+STATIC void compio_deflate(mp_obj_compio_t *o, bool flush) {
+    unsigned int lookahead = flush ? 1 : COMPIO_LOOKAHEAD;
+    while (o->win_len - o->pos >= lookahead) {
+        // A token is at most 31 bits on top of the pending ones.
+        if (o->out.outlen > COMPIO_OUT_SIZE - 4) {
+            compio_drain(o);
+        }
+        unsigned int avail = o->win_len - o->pos;
+        unsigned int len = 0, dist = 0;
+        if (avail >= COMPIO_MIN_MATCH) {
+            unsigned int cand = compio_insert(o, o->pos);
+            if (o->max_chain) {
+                len = compio_longest_match(o, cand, MIN(avail, COMPIO_MAX_MATCH), &dist);
+            }
+        }
+        if (len) {
+            zlib_match(&o->out, dist, len);
+            unsigned int end = o->pos + len;
+            while (++o->pos < end) {
+                if (o->win_len - o->pos >= COMPIO_MIN_MATCH) {
+                    compio_insert(o, o->pos);
+                }
+            }
+        } else {
+            zlib_literal(&o->out, o->win[o->pos++]);
+        }
+    }
+}
+
+// Drops the lower window, positions that fall out of it become 0 (end of chain).
+STATIC void compio_slide(mp_obj_compio_t *o) {
+    unsigned int wsize = 1 << o->wbits;
+    memcpy(o->win, o->win + wsize, wsize);
+    o->win_len -= wsize;
+    o->pos -= wsize;
+    for (unsigned int i = 0; i < (1u << o->hash_bits); i++) {
+        o->head[i] = (o->head[i] >= wsize) ? (o->head[i] - wsize) : 0;
+    }
+    for (unsigned int i = 0; i < wsize; i++) {
+        o->prev[i] = (o->prev[i] >= wsize) ? (o->prev[i] - wsize) : 0;
+    }
+}
+
+STATIC mp_obj_t compio_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 3, false);
+    mp_get_stream_raise(args[0], MP_STREAM_OP_WRITE);
+
+    // Same wbits convention as DecompIO: 9..15 zlib, 16 + wbits gzip, -wbits raw deflate.
+    mp_int_t wbits = (n_args > 1) ? mp_obj_get_int(args[1]) : 12;
+    mp_int_t level = (n_args > 2) ? mp_obj_get_int(args[2]) : 6;
+    int format = COMPIO_ZLIB;
+    if (wbits >= 16) {
+        format = COMPIO_GZIP;
+        wbits -= 16;
+    } else if (wbits < 0) {
+        format = COMPIO_RAW;
+        wbits = -wbits;
+    }
+    if (wbits < 9 || wbits > 15 || level < 0 || level > 9) {
+        mp_raise_ValueError(NULL);
+    }
+
+    mp_obj_compio_t *o = m_new_obj(mp_obj_compio_t);
+    o->base.type = type;
+    o->dest_stream = args[0];
+    o->wbits = wbits;
+    o->hash_bits = MIN(wbits - 1, COMPIO_HASH_BITS_MAX);
+    o->format = format;
+    o->max_chain = compio_levels[level][0];
+    o->nice_len = compio_levels[level][1];
+    o->win = m_new(byte, 2 << wbits);
+    o->head = m_new0(uint16_t, 1 << o->hash_bits);
+    o->prev = m_new0(uint16_t, 1 << wbits);
+    o->win_len = 0;
+    o->pos = 0;
+    o->in_len = 0;
+    o->closed = false;
+    memset(&o->out, 0, sizeof(o->out));
+    o->out.outbuf = m_new(byte, COMPIO_OUT_SIZE);
+    o->out.outsize = COMPIO_OUT_SIZE;
+
+    if (format == COMPIO_ZLIB) {
+        int cmf = ((wbits - 8) << 4) | 8;
+        int flg = ((level < 2) ? 0 : (level < 6) ? 1 : (level == 6) ? 2 : 3) << 6;
+        flg += 31 - (((cmf << 8) | flg) % 31);
+        compio_put_bytes(o, (cmf << 8) | flg, 2, true);
+        o->checksum = 1;
+    } else if (format == COMPIO_GZIP) {
+        // No name, no mtime, OS unknown.
+        compio_put_bytes(o, 0x00088b1f, 4, false);
+        compio_put_bytes(o, 0, 4, false);
+        compio_put_bytes(o, 0xff00, 2, false);
+        o->checksum = 0xffffffff;
+    }
+    zlib_start_block(&o->out);
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC mp_uint_t compio_write(mp_obj_t o_in, const void *buf, mp_uint_t size, int *errcode) {
+    mp_obj_compio_t *o = MP_OBJ_TO_PTR(o_in);
+    if (o->closed) {
+        *errcode = MP_EINVAL;
+        return MP_STREAM_ERROR;
+    }
+
+    unsigned int wsize = 1 << o->wbits;
+    const byte *src = buf;
+    mp_uint_t left = size;
+    while (left) {
+        if (o->win_len == 2 * wsize) {
+            compio_slide(o);
+        }
+        unsigned int n = MIN(left, 2 * wsize - o->win_len);
+        memcpy(o->win + o->win_len, src, n);
+        if (o->format == COMPIO_ZLIB) {
+            o->checksum = uzlib_adler32(src, n, o->checksum);
+        } else if (o->format == COMPIO_GZIP) {
+            o->checksum = uzlib_crc32(src, n, o->checksum);
+        }
+        o->win_len += n;
+        o->in_len += n;
+        src += n;
+        left -= n;
+        compio_deflate(o, false);
+    }
+    return size;
+}
+
+// Codes everything written so far and ends the block, an empty final block
+// when closing, else an empty stored block which brings the output to a byte
+// boundary (zlib's Z_SYNC_FLUSH).
+STATIC void compio_finish(mp_obj_compio_t *o, bool final) {
+    compio_deflate(o, true);
+    if (o->out.outlen > COMPIO_OUT_SIZE - 16) {
+        compio_drain(o);
+    }
+    zlib_finish_block(&o->out);
+    outbits(&o->out, final, 1);
+    outbits(&o->out, final ? 1 : 0, 2);
+    if (final) {
+        zlib_finish_block(&o->out);
+    }
+    if (o->out.noutbits) {
+        outbits(&o->out, 0, 8 - o->out.noutbits);
+    }
+    if (final) {
+        if (o->format == COMPIO_ZLIB) {
+            compio_put_bytes(o, o->checksum, 4, true);
+        } else if (o->format == COMPIO_GZIP) {
+            compio_put_bytes(o, o->checksum ^ 0xffffffff, 4, false);
+            compio_put_bytes(o, o->in_len, 4, false);
+        }
+    } else {
+        compio_put_bytes(o, 0xffff0000, 4, false);
+        zlib_start_block(&o->out);
+    }
+    compio_drain(o);
+}
+
+STATIC mp_uint_t compio_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    mp_obj_compio_t *o = MP_OBJ_TO_PTR(o_in);
+    (void)arg;
+    switch (request) {
+        case MP_STREAM_FLUSH:
+            if (o->closed) {
+                *errcode = MP_EINVAL;
+                return MP_STREAM_ERROR;
+            }
+            compio_finish(o, false);
+            return 0;
+        case MP_STREAM_CLOSE:
+            // The destination stays open, it's the caller's.
+            if (!o->closed) {
+                o->closed = true;
+                compio_finish(o, true);
+                m_del(byte, o->win, 2 << o->wbits);
+                m_del(uint16_t, o->head, 1 << o->hash_bits);
+                m_del(uint16_t, o->prev, 1 << o->wbits);
+                m_del(byte, o->out.outbuf, COMPIO_OUT_SIZE);
+                o->win = NULL;
+            }
+            return 0;
+        default:
+            *errcode = MP_EINVAL;
+            return MP_STREAM_ERROR;
+    }
+}
+
+STATIC mp_obj_t compio___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    return mp_stream_close(args[0]);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(compio___exit___obj, 4, 4, compio___exit__);
+
+STATIC const mp_rom_map_elem_t compio_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&mp_stream_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&mp_identity_obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&compio___exit___obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(compio_locals_dict, compio_locals_dict_table);
+
+STATIC const mp_stream_p_t compio_stream_p = {
+    .write = compio_write,
+    .ioctl = compio_ioctl,
+};
+
+STATIC const mp_obj_type_t compio_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_CompIO,
+    .make_new = compio_make_new,
+    .protocol = &compio_stream_p,
+    .locals_dict = (void*)&compio_locals_dict,
+};
+
+#endif // MICROPY_PY_UZLIB_COMPIO
+
 STATIC mp_obj_t mod_uzlib_decompress(size_t n_args, const mp_obj_t *args) {
     mp_obj_t data = args[0];
     mp_buffer_info_t bufinfo;
@@ -210,6 +528,9 @@ STATIC const mp_rom_map_elem_t mp_module_uzlib_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uzlib) },
     { MP_ROM_QSTR(MP_QSTR_decompress), MP_ROM_PTR(&mod_uzlib_decompress_obj) },
     { MP_ROM_QSTR(MP_QSTR_DecompIO), MP_ROM_PTR(&decompio_type) },
+    #if MICROPY_PY_UZLIB_COMPIO
+    { MP_ROM_QSTR(MP_QSTR_CompIO), MP_ROM_PTR(&compio_type) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_uzlib_globals, mp_module_uzlib_globals_table);
@@ -228,5 +549,8 @@ const mp_obj_module_t mp_module_uzlib = {
 #include "uzlib/tinfgzip.c"
 #include "uzlib/adler32.c"
 #include "uzlib/crc32.c"
+#if MICROPY_PY_UZLIB_COMPIO
+#include "uzlib/defl_static.c"
+#endif
 
 #endif // MICROPY_PY_UZLIB
@@ -47,10 +47,8 @@
 
 #define mp_obj_fat_vfs_t fs_user_mount_t
 
-STATIC mp_import_stat_t fat_vfs_import_stat(void *vfs_in, const char *path) {
-    fs_user_mount_t *vfs = vfs_in;
+STATIC mp_import_stat_t fat_vfs_stat_path(fs_user_mount_t *vfs, const char *path) {
     FILINFO fno;
-    assert(vfs != NULL);
     FRESULT res = f_stat(&vfs->fatfs, path, &fno);
     if (res == FR_OK) {
         if ((fno.fattrib & AM_DIR) != 0) {
@@ -62,6 +60,46 @@ STATIC mp_import_stat_t fat_vfs_import_stat(void *vfs_in, const char *path) {
     return MP_IMPORT_STAT_NO_EXIST;
 }
 
+#if MICROPY_FATFS_STAT_CACHE
+void fat_vfs_stat_cache_flush(fs_user_mount_t *vfs) {
+    memset(vfs->stat_cache, 0, sizeof(vfs->stat_cache));
+}
+
+// An import tries .py, .mpy and the package directory under every sys.path entry,
+// each one a directory walk. Keep the answers, the least recently used falls off.
+STATIC mp_import_stat_t fat_vfs_import_stat(void *vfs_in, const char *path) {
+    fs_user_mount_t *vfs = vfs_in;
+    assert(vfs != NULL);
+    size_t len = strlen(path);
+    if ((len == 0) || (len > FAT_VFS_STAT_CACHE_PATH)) {
+        return fat_vfs_stat_path(vfs, path);
+    }
+
+    fat_vfs_stat_entry_t *cache = vfs->stat_cache;
+    size_t i = 0;
+    while ((i < (MICROPY_FATFS_STAT_CACHE - 1))
+        && ((cache[i].len != len) || memcmp(cache[i].path, path, len))) {
+        i++;
+    }
+
+    fat_vfs_stat_entry_t entry = cache[i];
+    if ((entry.len != len) || memcmp(entry.path, path, len)) {
+        entry.len = len;
+        entry.stat = fat_vfs_stat_path(vfs, path);
+        memcpy(entry.path, path, len);
+    }
+    memmove(&cache[1], &cache[0], i * sizeof(fat_vfs_stat_entry_t));
+    cache[0] = entry;
+    return entry.stat;
+}
+#else
+STATIC mp_import_stat_t fat_vfs_import_stat(void *vfs_in, const char *path) {
+    fs_user_mount_t *vfs = vfs_in;
+    assert(vfs != NULL);
+    return fat_vfs_stat_path(vfs, path);
+}
+#endif
+
 STATIC mp_obj_t fat_vfs_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     mp_arg_check_num(n_args, n_kw, 1, 1, false);
 
@@ -263,6 +301,8 @@ STATIC mp_obj_t fat_vfs_chdir(mp_obj_t vfs_in, mp_obj_t path_in) {
     path = mp_obj_str_get_str(path_in);
 
     FRESULT res = f_chdir(&self->fatfs, path);
+    // relative import paths now resolve somewhere else
+    fat_vfs_stat_cache_flush(self);
 
     if (res != FR_OK) {
         mp_raise_OSError(fresult_to_errno_table[res]);
@@ -30,10 +30,34 @@
 #include "lib/oofatfs/ff.h"
 #include "extmod/vfs.h"
 
+// Number of import_stat() answers each mount remembers, 0 disables the cache.
+#ifndef MICROPY_FATFS_STAT_CACHE
+#define MICROPY_FATFS_STAT_CACHE (0)
+#endif
+
+// Read-ahead block for small reads of read-only files, in bytes, 0 disables it.
+#ifndef MICROPY_FATFS_READAHEAD
+#define MICROPY_FATFS_READAHEAD (0)
+#endif
+
+#if MICROPY_FATFS_STAT_CACHE
+// Longer paths are looked up every time.
+#define FAT_VFS_STAT_CACHE_PATH (30)
+
+typedef struct _fat_vfs_stat_entry_t {
+    uint8_t len; // 0 for an unused entry
+    uint8_t stat; // mp_import_stat_t
+    char path[FAT_VFS_STAT_CACHE_PATH];
+} fat_vfs_stat_entry_t;
+#endif
+
 typedef struct _fs_user_mount_t {
     mp_obj_base_t base;
     mp_vfs_blockdev_t blockdev;
     FATFS fatfs;
+    #if MICROPY_FATFS_STAT_CACHE
+    fat_vfs_stat_entry_t stat_cache[MICROPY_FATFS_STAT_CACHE]; // most recent first
+    #endif
 } fs_user_mount_t;
 
 extern const byte fresult_to_errno_table[20];
@@ -43,4 +67,11 @@ extern const mp_obj_type_t mp_type_vfs_fat_textio;
 
 MP_DECLARE_CONST_FUN_OBJ_3(fat_vfs_open_obj);
 
+#if MICROPY_FATFS_STAT_CACHE
+// Called whenever the volume may have changed: mount, sector writes, trim and chdir.
+void fat_vfs_stat_cache_flush(fs_user_mount_t *vfs);
+#else
+#define fat_vfs_stat_cache_flush(vfs)
+#endif
+
 #endif // MICROPY_INCLUDED_EXTMOD_VFS_FAT_H
@@ -86,6 +86,7 @@ DRESULT disk_write (
     }
 
     int ret = mp_vfs_blockdev_write(&vfs->blockdev, sector, count, buff);
+    fat_vfs_stat_cache_flush(vfs);
 
     if (ret == -MP_EROFS) {
         // read-only block device
@@ -150,9 +151,25 @@ DRESULT disk_ioctl (
             *((DWORD*)buff) = 1; // erase block size in units of sector size
             return RES_OK;
 
+        #if FF_USE_TRIM
+        case CTRL_TRIM: {
+            // buff holds the first and last sector, the ioctl takes one block at a time
+            DWORD *range = (DWORD*)buff;
+            for (DWORD sector = range[0]; sector <= range[1]; sector++) {
+                mp_vfs_blockdev_ioctl(&vfs->blockdev, MP_BLOCKDEV_IOCTL_BLOCK_TRIM, sector);
+            }
+            fat_vfs_stat_cache_flush(vfs);
+            return RES_OK;
+        }
+        #endif
+
         case IOCTL_INIT:
         case IOCTL_STATUS: {
             DSTATUS stat;
+            if (cmd == IOCTL_INIT) {
+                // (re)mount or mkfs, whatever the mount's memory held is stale
+                fat_vfs_stat_cache_flush(vfs);
+            }
             if (ret != mp_const_none && MP_OBJ_SMALL_INT_VALUE(ret) != 0) {
                 // error initialising
                 stat = STA_NOINIT;
@@ -28,6 +28,7 @@
 #if MICROPY_VFS && MICROPY_VFS_FAT
 
 #include <stdio.h>
+#include <string.h>
 
 #include "py/runtime.h"
 #include "py/stream.h"
@@ -94,6 +95,15 @@ const char *ffs_strerror(FRESULT res)
 typedef struct _pyb_file_obj_t {
     mp_obj_base_t base;
     FIL fp;
+    #if MICROPY_FATFS_READAHEAD
+    // Read-only files get a MICROPY_FATFS_READAHEAD block on their first small read
+    // (the module reader asks for 24 bytes at a time), fp is ra_len - ra_pos bytes
+    // ahead of the stream position.
+    bool ra_ok;
+    uint16_t ra_pos;
+    uint16_t ra_len;
+    uint8_t *ra_buf;
+    #endif
 } pyb_file_obj_t;
 
 STATIC void file_obj_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
@@ -101,8 +111,67 @@ STATIC void file_obj_print(const mp_print_t *print, mp_obj_t self_in, mp_print_k
     mp_printf(print, "<io.%s %p>", mp_obj_get_type_str(self_in), MP_OBJ_TO_PTR(self_in));
 }
 
+#if MICROPY_FATFS_READAHEAD
+STATIC void file_obj_readahead_free(pyb_file_obj_t *self) {
+    if (self->ra_buf != NULL) {
+        m_del(uint8_t, self->ra_buf, MICROPY_FATFS_READAHEAD);
+        self->ra_buf = NULL;
+    }
+    self->ra_ok = false;
+    self->ra_pos = self->ra_len = 0;
+}
+
+STATIC mp_uint_t file_obj_readahead(pyb_file_obj_t *self, uint8_t *buf, mp_uint_t size, int *errcode) {
+    mp_uint_t done = MIN(size, (mp_uint_t)(self->ra_len - self->ra_pos));
+    memcpy(buf, self->ra_buf + self->ra_pos, done);
+    self->ra_pos += done;
+    if (done == size) {
+        return done;
+    }
+
+    UINT sz_out;
+    FRESULT res;
+    if ((size - done) >= MICROPY_FATFS_READAHEAD) {
+        // big enough to go straight to the file
+        res = f_read(&self->fp, buf + done, size - done, &sz_out);
+    } else {
+        UINT ra_len;
+        res = f_read(&self->fp, self->ra_buf, MICROPY_FATFS_READAHEAD, &ra_len);
+        self->ra_len = ra_len;
+        sz_out = MIN(size - done, ra_len);
+        memcpy(buf + done, self->ra_buf, sz_out);
+        self->ra_pos = sz_out;
+    }
+    if (res != FR_OK) {
+        self->ra_pos = self->ra_len = 0;
+        if (done == 0) {
+            *errcode = fresult_to_errno_table[res];
+            return MP_STREAM_ERROR;
+        }
+        return done;
+    }
+    return done + sz_out;
+}
+
+// Stream position, fp is ahead by whatever is left in the read-ahead block.
+STATIC FSIZE_t file_obj_tell(pyb_file_obj_t *self) {
+    return f_tell(&self->fp) - (self->ra_len - self->ra_pos);
+}
+#else
+#define file_obj_tell(self) f_tell(&(self)->fp)
+#endif
+
 STATIC mp_uint_t file_obj_read(mp_obj_t self_in, void *buf, mp_uint_t size, int *errcode) {
     pyb_file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    #if MICROPY_FATFS_READAHEAD
+    if (self->ra_ok && (self->ra_buf == NULL) && (size < MICROPY_FATFS_READAHEAD)) {
+        self->ra_buf = m_new_maybe(uint8_t, MICROPY_FATFS_READAHEAD);
+        self->ra_ok = (self->ra_buf != NULL);
+    }
+    if (self->ra_buf != NULL) {
+        return file_obj_readahead(self, buf, size, errcode);
+    }
+    #endif
     UINT sz_out;
     FRESULT res = f_read(&self->fp, buf, size, &sz_out);
     if (res != FR_OK) {
@@ -140,22 +209,36 @@ STATIC mp_uint_t file_obj_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg,
 
     if (request == MP_STREAM_SEEK) {
         struct mp_stream_seek_t *s = (struct mp_stream_seek_t*)(uintptr_t)arg;
+        FSIZE_t pos = file_obj_tell(self);
 
         switch (s->whence) {
             case 0: // SEEK_SET
-                f_lseek(&self->fp, s->offset);
+                pos = s->offset;
                 break;
 
             case 1: // SEEK_CUR
-                f_lseek(&self->fp, f_tell(&self->fp) + s->offset);
+                pos += s->offset;
                 break;
 
             case 2: // SEEK_END
-                f_lseek(&self->fp, f_size(&self->fp) + s->offset);
+                pos = f_size(&self->fp) + s->offset;
                 break;
         }
 
-        s->offset = f_tell(&self->fp);
+        #if MICROPY_FATFS_READAHEAD
+        // seeks inside the read-ahead block (tell() among them) don't touch the file
+        FSIZE_t ra_start = f_tell(&self->fp) - self->ra_len;
+        if ((self->ra_buf != NULL) && (pos >= ra_start) && (pos <= f_tell(&self->fp))) {
+            self->ra_pos = pos - ra_start;
+        } else {
+            self->ra_pos = self->ra_len = 0;
+            f_lseek(&self->fp, pos);
+        }
+        #else
+        f_lseek(&self->fp, pos);
+        #endif
+
+        s->offset = file_obj_tell(self);
         return 0;
 
     } else if (request == MP_STREAM_FLUSH) {
@@ -167,6 +250,9 @@ STATIC mp_uint_t file_obj_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg,
         return 0;
 
     } else if (request == MP_STREAM_CLOSE) {
+        #if MICROPY_FATFS_READAHEAD
+        file_obj_readahead_free(self);
+        #endif
         // if fs==NULL then the file is closed and in that case this method is a no-op
         if (self->fp.obj.fs != NULL) {
             FRESULT res = f_close(&self->fp);
@@ -235,6 +321,16 @@ STATIC mp_obj_t file_open(fs_user_mount_t *vfs, const mp_obj_type_t *type, mp_ar
         mp_raise_OSError(fresult_to_errno_table[res]);
     }
 
+    #if MICROPY_FATFS_READAHEAD
+    o->ra_ok = (mode == FA_READ);
+    o->ra_pos = o->ra_len = 0;
+    o->ra_buf = NULL;
+    #endif
+    if (mode & FA_WRITE) {
+        // the directory entry may have been created
+        fat_vfs_stat_cache_flush(vfs);
+    }
+
     // for 'a' mode, we must begin at the end of the file
     if ((mode & FA_OPEN_ALWAYS) != 0) {
         f_lseek(&o->fp, f_size(&o->fp));
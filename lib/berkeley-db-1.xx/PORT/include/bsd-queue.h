@@ -1 +1 @@
-queue.h
\ No newline at end of file
+#include "queue.h"
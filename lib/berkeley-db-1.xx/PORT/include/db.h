@@ -1 +1 @@
-../../include/db.h
\ No newline at end of file
+#include "../../include/db.h"
@@ -1 +1 @@
-../../include/filevtable.h
\ No newline at end of file
+#include "../../include/filevtable.h"
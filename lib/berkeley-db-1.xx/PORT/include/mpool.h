@@ -1 +1 @@
-../../include/mpool.h
\ No newline at end of file
+#include "../../include/mpool.h"
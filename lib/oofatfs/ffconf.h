@@ -77,7 +77,11 @@
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 
+#ifdef MICROPY_FATFS_USE_EXPAND
+#define FF_USE_EXPAND   (MICROPY_FATFS_USE_EXPAND)
+#else
 #define FF_USE_EXPAND   0
+#endif
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
 
@@ -263,7 +267,11 @@
 /  GET_SECTOR_SIZE command. */
 
 
+#ifdef MICROPY_FATFS_USE_TRIM
+#define FF_USE_TRIM     (MICROPY_FATFS_USE_TRIM)
+#else
 #define FF_USE_TRIM     0
+#endif
 /* This option switches support for ATA-TRIM. (0:Disable or 1:Enable)
 /  To enable Trim function, also CTRL_TRIM command should be implemented to the
 /  disk_ioctl() function. */
@@ -35,6 +35,7 @@
 #include "py/repl.h"
 #include "py/gc.h"
 #include "py/frozenmod.h"
+#include "py/persistentcode.h"
 #include "py/mphal.h"
 #if MICROPY_HW_ENABLE_USB
 #include "irq.h"
@@ -61,6 +62,28 @@ STATIC bool repl_display_debugging_info = 0;
 // EXEC_FLAG_PRINT_EOF prints 2 EOF chars: 1 after normal output, 1 after exception output
 // EXEC_FLAG_ALLOW_DEBUGGING allows debugging info to be printed after executing the code
 // EXEC_FLAG_IS_REPL is used for REPL inputs (flag passed on to mp_compile)
+#if MICROPY_COMP_STREAM
+// compiles and runs the statements of lex one at a time, mp_compile frees each parse
+// tree before the next statement is parsed
+STATIC void parse_compile_execute_stream(mp_lexer_t *lex, bool is_repl) {
+    mp_parse_stream_t ps;
+    mp_parse_stream_init(&ps, lex);
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_obj_t stmt_fun;
+        while ((stmt_fun = mp_compile_stream_next(&ps, lex->source_name, is_repl)) != MP_OBJ_NULL) {
+            mp_call_function_0(stmt_fun);
+        }
+        nlr_pop();
+        mp_parse_stream_deinit(&ps);
+    } else {
+        // close the file before passing the exception on
+        mp_parse_stream_deinit(&ps);
+        nlr_jump(nlr.ret_val);
+    }
+}
+#endif
+
 STATIC int parse_compile_execute(const void *source, mp_parse_input_kind_t input_kind, int exec_flags) {
     int ret = 0;
     uint32_t start = 0;
@@ -70,7 +93,7 @@ STATIC int parse_compile_execute(const void *source, mp_parse_input_kind_t input
 
     nlr_buf_t nlr;
     if (nlr_push(&nlr) == 0) {
-        mp_obj_t module_fun;
+        mp_obj_t module_fun = MP_OBJ_NULL;
         #if MICROPY_MODULE_FROZEN_MPY
         if (exec_flags & EXEC_FLAG_SOURCE_IS_RAW_CODE) {
             // source is a raw_code object, create the function
@@ -88,19 +111,31 @@ STATIC int parse_compile_execute(const void *source, mp_parse_input_kind_t input
             } else {
                 lex = (mp_lexer_t*)source;
             }
-            // source is a lexer, parse and compile the script
-            qstr source_name = lex->source_name;
-            mp_parse_tree_t parse_tree = mp_parse(lex, input_kind);
-            module_fun = mp_compile(&parse_tree, source_name, exec_flags & EXEC_FLAG_IS_REPL);
+            #if MICROPY_COMP_STREAM
+            if (input_kind == MP_PARSE_FILE_INPUT) {
+                // source is a lexer, each statement is executed as soon as it is compiled
+                mp_hal_set_interrupt_char(CHAR_CTRL_C); // allow ctrl-C to interrupt us
+                start = mp_hal_ticks_ms();
+                parse_compile_execute_stream(lex, exec_flags & EXEC_FLAG_IS_REPL);
+            } else
+            #endif
+            {
+                // source is a lexer, parse and compile the script
+                qstr source_name = lex->source_name;
+                mp_parse_tree_t parse_tree = mp_parse(lex, input_kind);
+                module_fun = mp_compile(&parse_tree, source_name, exec_flags & EXEC_FLAG_IS_REPL);
+            }
             #else
             mp_raise_msg(&mp_type_RuntimeError, "script compilation not supported");
             #endif
         }
 
         // execute code
-        mp_hal_set_interrupt_char(CHAR_CTRL_C); // allow ctrl-C to interrupt us
-        start = mp_hal_ticks_ms();
-        mp_call_function_0(module_fun);
+        if (module_fun != MP_OBJ_NULL) {
+            mp_hal_set_interrupt_char(CHAR_CTRL_C); // allow ctrl-C to interrupt us
+            start = mp_hal_ticks_ms();
+            mp_call_function_0(module_fun);
+        }
 
         // disable interrupt
         mp_hal_set_interrupt_char(-1);
@@ -556,6 +591,14 @@ int pyexec_str(vstr_t *str) {
     return parse_compile_execute(str, MP_PARSE_FILE_INPUT, EXEC_FLAG_RERAISE | EXEC_FLAG_SOURCE_IS_VSTR);
 }
 
+#if MICROPY_PERSISTENT_CODE_LOAD && MICROPY_MODULE_FROZEN_MPY
+// str holds a .mpy file as mpy-cross writes it, nothing is compiled
+int pyexec_mpy(vstr_t *str) {
+    mp_raw_code_t *rc = mp_raw_code_load_mem((const byte*)str->buf, str->len);
+    return parse_compile_execute(rc, MP_PARSE_FILE_INPUT, EXEC_FLAG_RERAISE | EXEC_FLAG_SOURCE_IS_RAW_CODE);
+}
+#endif
+
 int pyexec_file_if_exists(const char *filename) {
     #if MICROPY_MODULE_FROZEN
     if (mp_frozen_stat(filename) == MP_IMPORT_STAT_FILE) {
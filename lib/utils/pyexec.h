@@ -47,6 +47,7 @@ int pyexec_raw_repl(void);
 int pyexec_friendly_repl(void);
 int pyexec_file(const char *filename);
 int pyexec_str(vstr_t *str);
+int pyexec_mpy(vstr_t *str);
 int pyexec_file_if_exists(const char *filename);
 int pyexec_frozen_module(const char *name);
 void pyexec_event_repl_init(void);
@@ -50,6 +50,7 @@
 #define MICROPY_COMP_RETURN_IF_EXPR (1)
 
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (0)
+#define MICROPY_OPT_SUPERINSTRUCTIONS (1)
 
 #define MICROPY_READER_POSIX        (1)
 #define MICROPY_ENABLE_RUNTIME      (0)
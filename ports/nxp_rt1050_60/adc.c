@@ -31,9 +31,17 @@
 #include "py/binary.h"
 #include "py/mphal.h"
 #include "adc.h"
+#include "irq.h"
 #include "pin.h"
 #include "timer.h"
+#ifdef BOARD_OMVRT1
+#include "qtimer.h"
+#endif
 #include "fsl_adc.h"
+#include "fsl_adc_etc.h"
+#include "fsl_dmamux.h"
+#include "fsl_edma.h"
+#include "dma.h"
 
 #include "genhdr/pins.h"
 
@@ -46,6 +54,13 @@
 ///
 ///     adc = pyb.ADC(pin)              # create an analog object from a pin
 ///     val = adc.read()                # read an analog value
+///     # with a QTimer (omvrt1):
+///     adc.read_timed_into(buf, tim)   # fill buf, one sample per period of QTimer tim
+///     adc.stream(buf, tim, cb)        # fill buf over and over, cb(half) per half
+///     adc.stop()                      # end the stream
+///
+///     adc = pyb.ADC((pin0, pin1))     # a scan group: each period converts every pin
+///     vals = adc.read()               # and read() returns a tuple
 ///
 ///     adc = pyb.ADCAll(resolution)    # creale an ADCAll object
 ///     val = adc.read_channel(channel) # read the given channel
@@ -94,12 +109,33 @@
                                  ((CHANNEL) == ADC_CHANNEL_15)          )
 
 
+#define ADC_SCAN_MAX        (8)     // one conversion per HC register of ADC1
+#define ADC_ETC_TRIGGER     (0)     // ADC_ETC trigger of ADC1 that XBARA feeds
+
 typedef struct _pyb_obj_adc_t {
     mp_obj_base_t base;
     mp_obj_t pin_name;
     int channel;
+    uint8_t nchannels;      // more than 1 for a scan group, channel is then the first
+    uint8_t channels[ADC_SCAN_MAX];
 } pyb_obj_adc_t;
 
+#ifdef BOARD_OMVRT1
+// Timed reads: the timer triggers ADC_ETC through XBARA, ADC_ETC runs the group's chain
+// and eDMA copies its results to the buffer, so no sample waits for the CPU. There is one
+// trigger and one channel for it, so one timed read at a time. Buffer and callback are
+// in MP_STATE_PORT(adc_stream_buf/cb).
+typedef struct _adc_stream_t {
+    pyb_qtimer_obj_t *timer;
+    uint16_t *dst;
+    size_t len;                 // samples in dst
+    volatile bool pending[2];   // callback of the half not run yet
+    volatile uint32_t overruns; // halves filled again before their callback ran
+} adc_stream_t;
+
+STATIC adc_stream_t adc_stream;
+#endif
+
 adc_config_t adcConfigStruct;	
 // convert user-facing channel number into internal channel number
 static inline uint32_t adc_get_internal_channel(uint32_t channel) {
@@ -160,26 +196,186 @@ STATIC uint32_t adc_config_and_read_channel( uint32_t channel) {
     return adc_read_channel();
 }
 
-/******************************************************************************/
-/* MicroPython bindings : adc object (single channel)                         */
+#ifdef BOARD_OMVRT1
+STATIC void adc_check_idle(void) {
+    if (adc_stream.timer) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "ADC is in a timed read"));
+    }
+}
 
-STATIC void adc_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
-    pyb_obj_adc_t *self = MP_OBJ_TO_PTR(self_in);
-    mp_print_str(print, "<ADC on ");
-    mp_obj_print_helper(print, self->pin_name, PRINT_STR);
-    mp_printf(print, " channel=%u>", self->channel);
+STATIC void adc_etc_start(pyb_obj_adc_t *self) {
+    // the HCs of the chain convert whatever channel ADC_ETC hands them
+    adc_channel_config_t hc = { .channelNumber = 16, .enableInterruptOnConversionCompleted = false };
+    for (int i = 0; i < self->nchannels; i++) {
+        ADC_SetChannelConfig(ADC_BASE, i, &hc);
+    }
+    ADC_EnableHardwareTrigger(ADC_BASE, true);
+
+    adc_etc_config_t etc;
+    ADC_ETC_GetDefaultConfig(&etc);
+    etc.XBARtriggerMask = 1U << ADC_ETC_TRIGGER;
+    ADC_ETC_Init(ADC_ETC, &etc);
+
+    adc_etc_trigger_config_t trig = {
+        .enableSyncMode = false,
+        .enableSWTriggerMode = false,
+        .triggerChainLength = self->nchannels - 1,
+        .triggerPriority = 0,
+        .sampleIntervalDelay = 0,
+        .initialDelay = 0,
+    };
+    ADC_ETC_SetTriggerConfig(ADC_ETC, ADC_ETC_TRIGGER, &trig);
+    for (int i = 0; i < self->nchannels; i++) {
+        adc_etc_trigger_chain_config_t chain = {
+            .enableB2BMode = true,
+            .ADCHCRegisterSelect = 1U << i,
+            .ADCChannelSelect = self->channels[i],
+            .InterruptEnable = kADC_ETC_InterruptDisable,
+        };
+        ADC_ETC_SetTriggerChainConfig(ADC_ETC, ADC_ETC_TRIGGER, i, &chain);
+    }
+    ADC_ETC_EnableDMA(ADC_ETC, ADC_ETC_TRIGGER);
 }
 
-/// \classmethod \constructor(pin)
-/// Create an ADC object associated with the given pin.
-/// This allows you to then read analog values on that pin.
-STATIC mp_obj_t adc_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
-    // check number of arguments
-    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+// A minor loop per trigger copies the chain's results, which sit in 16-bit halves of
+// consecutive RESULT registers. Circular wraps dst and interrupts at each half.
+STATIC void adc_dma_start(uint16_t *dst, size_t len, size_t nchannels, bool circular) {
+    dma_edma_init();
+    DMAMUX_SetSource(DMAMUX, DMA_CH_ADC, kDmaRequestMuxADC_ETC);
+    DMAMUX_EnableChannel(DMAMUX, DMA_CH_ADC);
+    EDMA_ResetChannel(DMA0, DMA_CH_ADC);
+
+    uint32_t minor = nchannels * sizeof(uint16_t);
+    DMA0->TCD[DMA_CH_ADC].SADDR = (uint32_t)&ADC_ETC->TRIG[ADC_ETC_TRIGGER].TRIGn_RESULT_1_0;
+    DMA0->TCD[DMA_CH_ADC].SOFF = sizeof(uint16_t);
+    DMA0->TCD[DMA_CH_ADC].ATTR = DMA_ATTR_SSIZE(kEDMA_TransferSize2Bytes) | DMA_ATTR_DSIZE(kEDMA_TransferSize2Bytes);
+    DMA0->TCD[DMA_CH_ADC].NBYTES_MLNO = minor;
+    DMA0->TCD[DMA_CH_ADC].SLAST = -(int32_t)minor;
+    DMA0->TCD[DMA_CH_ADC].DADDR = (uint32_t)dst;
+    DMA0->TCD[DMA_CH_ADC].DOFF = sizeof(uint16_t);
+    DMA0->TCD[DMA_CH_ADC].CITER_ELINKNO = len / nchannels;
+    DMA0->TCD[DMA_CH_ADC].BITER_ELINKNO = len / nchannels;
+    if (circular) {
+        DMA0->TCD[DMA_CH_ADC].DLAST_SGA = -(int32_t)(len * sizeof(uint16_t));
+        DMA0->TCD[DMA_CH_ADC].CSR = DMA_CSR_INTHALF_MASK | DMA_CSR_INTMAJOR_MASK;
+        NVIC_SetPriority(DMA15_DMA31_IRQn, IRQ_PRI_DMA);
+        EnableIRQ(DMA15_DMA31_IRQn);
+    } else {
+        DMA0->TCD[DMA_CH_ADC].DLAST_SGA = 0;
+        DMA0->TCD[DMA_CH_ADC].CSR = DMA_CSR_DREQ_MASK;
+    }
 
-    // 1st argument is the pin name
-    mp_obj_t pin_obj = args[0];
+    dma_begin_read(dst, len * sizeof(uint16_t));
+    EDMA_EnableChannelRequest(DMA0, DMA_CH_ADC);
+}
+
+STATIC void adc_stream_start(pyb_obj_adc_t *self, mp_obj_t buf, mp_obj_t timer_in, mp_obj_t callback) {
+    adc_check_idle();
+    if (!MP_OBJ_IS_TYPE(timer_in, &pyb_qtimer_type)) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_TypeError, "need a QTimer"));
+    }
+    pyb_qtimer_obj_t *timer = MP_OBJ_TO_PTR(timer_in);
+    if (!timer->isActive || timer->irq_handler) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "QTimer not running or in use"));
+    }
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_WRITE);
+    if (mp_binary_get_size('@', bufinfo.typecode, NULL) != sizeof(uint16_t)) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "need an array of 16-bit samples"));
+    }
+    // whole scans, for a stream whole scans per half
+    size_t len = bufinfo.len / sizeof(uint16_t);
+    size_t scan = self->nchannels * (callback != MP_OBJ_NULL ? 2 : 1);
+    if (len == 0 || (len % scan) || (len / self->nchannels) > DMA_CITER_ELINKNO_CITER_MASK) {
+        nlr_raise(mp_obj_new_exception_msg_varg(&mp_type_ValueError,
+            "buffer must hold a multiple of %d samples, at most %d scans", scan, DMA_CITER_ELINKNO_CITER_MASK));
+    }
+
+    adc_stream.timer = timer;
+    adc_stream.dst = bufinfo.buf;
+    adc_stream.len = len;
+    adc_stream.pending[0] = adc_stream.pending[1] = false;
+    adc_stream.overruns = 0;
+    MP_STATE_PORT(adc_stream_buf) = buf;
+    MP_STATE_PORT(adc_stream_cb) = callback;
+
+    adc_etc_start(self);
+    adc_dma_start(adc_stream.dst, len, self->nchannels, callback != MP_OBJ_NULL);
+    if (!qtimer_start_trigger(timer, kXBARA1_OutputAdcEtcXbar0Trig0)) {
+        adc_stream_stop();
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "only QTimers of TMR3 and TMR4 can trigger the ADC"));
+    }
+}
+
+void adc_stream_stop(void) {
+    if (adc_stream.timer == NULL) {
+        return;
+    }
+    qtimer_stop_trigger(adc_stream.timer);
+    EDMA_DisableChannelRequest(DMA0, DMA_CH_ADC);
+    DisableIRQ(DMA15_DMA31_IRQn);
+    DMAMUX_DisableChannel(DMAMUX, DMA_CH_ADC);
+    ADC_ETC_DisableDMA(ADC_ETC, ADC_ETC_TRIGGER);
+    ADC_ETC_Deinit(ADC_ETC);
+    ADC_EnableHardwareTrigger(ADC_BASE, false);
+    dma_end_read(adc_stream.dst, adc_stream.len * sizeof(uint16_t));
+
+    adc_stream.timer = NULL;
+    MP_STATE_PORT(adc_stream_buf) = MP_OBJ_NULL;
+    MP_STATE_PORT(adc_stream_cb) = MP_OBJ_NULL;
+}
+
+// Scheduled per filled half, which counts as overrun if it fills again before this returns.
+STATIC mp_obj_t adc_stream_dispatch(mp_obj_t half_in) {
+    mp_int_t half = MP_OBJ_SMALL_INT_VALUE(half_in);
+    mp_obj_t callback = MP_STATE_PORT(adc_stream_cb);
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        if (callback != MP_OBJ_NULL) {
+            mp_call_function_1(callback, half_in);
+        }
+        nlr_pop();
+        adc_stream.pending[half] = false;
+    } else {
+        adc_stream.pending[half] = false;
+        nlr_jump(nlr.ret_val);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(adc_stream_dispatch_obj, adc_stream_dispatch);
+
+void DMA15_DMA31_IRQHandler(void) {
+    adc_stream_t *s = &adc_stream;
+    int half = 0;
+    if (DMA0->TCD[DMA_CH_ADC].CSR & DMA_CSR_DONE_MASK) {
+        DMA0->CDNE = DMA_CH_ADC;
+        half = 1;
+    }
+    DMA0->CINT = DMA_CH_ADC;
+
+    uint16_t *p = s->dst + half * (s->len / 2);
+    dma_end_read(p, s->len / 2 * sizeof(uint16_t));
+    if (s->pending[half]) {
+        s->overruns++;
+    } else if (mp_sched_schedule(MP_OBJ_FROM_PTR(&adc_stream_dispatch_obj), MP_OBJ_NEW_SMALL_INT(half))) {
+        s->pending[half] = true;
+    } else {
+        s->overruns++;
+    }
+    __DSB();
+}
+#else
+// timed reads need a QTimer
+STATIC void adc_check_idle(void) {
+}
 
+void adc_stream_stop(void) {
+}
+#endif
+
+// the pin or channel number of obj
+STATIC uint32_t adc_get_channel(mp_obj_t pin_obj) {
     uint32_t channel;
 
     if (MP_OBJ_IS_INT(pin_obj)) {
@@ -205,29 +401,125 @@ STATIC mp_obj_t adc_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_
                 "channel %d not available on this board", channel));
         }
     }
+    return channel;
+}
+
+/******************************************************************************/
+/* MicroPython bindings : adc object (single channel)                         */
+
+STATIC void adc_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    pyb_obj_adc_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_print_str(print, "<ADC on ");
+    mp_obj_print_helper(print, self->pin_name, PRINT_STR);
+    mp_printf(print, " channel=%u>", self->channel);
+}
+
+/// \classmethod \constructor(pin)
+/// Create an ADC object associated with the given pin.
+/// This allows you to then read analog values on that pin.
+/// With a tuple or list of up to 8 pins it is a scan group, converting them all in order.
+STATIC mp_obj_t adc_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    // check number of arguments
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+
+    // 1st argument is the pin name, or a sequence of them
+    mp_obj_t pin_obj = args[0];
+    size_t npins = 1;
+    mp_obj_t *pins = &pin_obj;
+    if (MP_OBJ_IS_TYPE(pin_obj, &mp_type_tuple) || MP_OBJ_IS_TYPE(pin_obj, &mp_type_list)) {
+        mp_obj_get_array(pin_obj, &npins, &pins);
+        if (npins < 1 || npins > ADC_SCAN_MAX) {
+            nlr_raise(mp_obj_new_exception_msg_varg(&mp_type_ValueError, "a scan group has 1 to %d pins", ADC_SCAN_MAX));
+        }
+    }
 
     pyb_obj_adc_t *o = m_new_obj(pyb_obj_adc_t);
     memset(o, 0, sizeof(*o));
     o->base.type = &pyb_adc_type;
     o->pin_name = pin_obj;
-    o->channel = channel;
-    adc_init_single(o);
+    o->nchannels = npins;
+    for (size_t i = 0; i < npins; i++) {
+        o->channels[i] = adc_get_channel(pins[i]);
+        o->channel = o->channels[i];
+        adc_init_single(o);
+    }
+    o->channel = o->channels[0];
 
     return MP_OBJ_FROM_PTR(o);
 }
 
 /// \method read()
 /// Read the value on the analog pin and return it.  The returned value
-/// will be between 0 and 4095.
+/// will be between 0 and 4095. A scan group returns a tuple, one value per pin.
 STATIC mp_obj_t adc_read(mp_obj_t self_in) {
     pyb_obj_adc_t *self = MP_OBJ_TO_PTR(self_in);
-    return mp_obj_new_int(adc_config_and_read_channel(self->channel));
+    adc_check_idle();
+    if (self->nchannels == 1) {
+        return mp_obj_new_int(adc_config_and_read_channel(self->channel));
+    }
+    mp_obj_t vals[ADC_SCAN_MAX];
+    for (int i = 0; i < self->nchannels; i++) {
+        vals[i] = mp_obj_new_int(adc_config_and_read_channel(self->channels[i]));
+    }
+    return mp_obj_new_tuple(self->nchannels, vals);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(adc_read_obj, adc_read);
 
+#ifdef BOARD_OMVRT1
+/// \method read_timed_into(buf, timer)
+/// Fill buf, an array of 16-bit samples, with one scan per period of the QTimer timer of
+/// TMR3 or TMR4, and return when it is full. A scan group interleaves its pins. The
+/// timer's own callback doesn't run meanwhile.
+STATIC mp_obj_t adc_read_timed_into(mp_obj_t self_in, mp_obj_t buf, mp_obj_t timer) {
+    pyb_obj_adc_t *self = MP_OBJ_TO_PTR(self_in);
+    adc_stream_start(self, buf, timer, MP_OBJ_NULL);
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        while (!(DMA0->TCD[DMA_CH_ADC].CSR & DMA_CSR_DONE_MASK)) {
+            MICROPY_EVENT_POLL_HOOK
+        }
+        nlr_pop();
+        adc_stream_stop();
+    } else {
+        adc_stream_stop();
+        nlr_jump(nlr.ret_val);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(adc_read_timed_into_obj, adc_read_timed_into);
+
+/// \method stream(buf, timer, callback)
+/// As read_timed_into(), but without end: when a half of buf is full callback(half) is
+/// scheduled with half 0 or 1, while the other half fills. Returns at once.
+STATIC mp_obj_t adc_start_stream(size_t n_args, const mp_obj_t *args) {
+    pyb_obj_adc_t *self = MP_OBJ_TO_PTR(args[0]);
+    if (!mp_obj_is_callable(args[3])) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_TypeError, "callback must be callable"));
+    }
+    adc_stream_start(self, args[1], args[2], args[3]);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(adc_start_stream_obj, 4, 4, adc_start_stream);
+
+/// \method stop()
+/// End the stream. Returns the number of halves that filled again before their callback
+/// had returned.
+STATIC mp_obj_t adc_stop(mp_obj_t self_in) {
+    uint32_t overruns = adc_stream.overruns;
+    adc_stream_stop();
+    return mp_obj_new_int_from_uint(overruns);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(adc_stop_obj, adc_stop);
+#endif
+
 
 STATIC const mp_rom_map_elem_t adc_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&adc_read_obj) },
+    #ifdef BOARD_OMVRT1
+    { MP_ROM_QSTR(MP_QSTR_read_timed_into), MP_ROM_PTR(&adc_read_timed_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stream), MP_ROM_PTR(&adc_start_stream_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&adc_stop_obj) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(adc_locals_dict, adc_locals_dict_table);
@@ -307,6 +599,7 @@ STATIC mp_obj_t adc_all_make_new(const mp_obj_type_t *type, size_t n_args, size_
 
 STATIC mp_obj_t adc_all_read_channel(mp_obj_t self_in, mp_obj_t channel) {
     pyb_adc_all_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    adc_check_idle();
     uint32_t chan = adc_get_internal_channel(mp_obj_get_int(channel));
     uint32_t data = adc_config_and_read_channel(chan);
     return mp_obj_new_int(data);
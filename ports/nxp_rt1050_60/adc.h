@@ -40,4 +40,6 @@
 #define ADC_CHANNEL_14 14
 #define ADC_CHANNEL_15 15
 extern const mp_obj_type_t pyb_adc_type;
+// ends a timed read or stream of any ADC object, nothing if there is none
+void adc_stream_stop(void);
 extern const mp_obj_type_t pyb_adc_all_type;
@@ -0,0 +1,234 @@
+#include <math.h>
+#include <string.h>
+#include "../math/mat.h"
+#include "ekf_fusion.h"
+
+/*
+    predict:    q' = q + dt/2 * q x (0, g - b), b' = b
+    correct:    accelerometer against R(q)' (0 0 1), then magnetometer against R(q)' m_ref,
+                one after the other so each only needs a 3 x 3 inverse
+*/
+
+#define EKF_ACC_GATE    (0.2F)  /* skip the accelerometer when |a| is further than this from 1g */
+
+void ekf_init(ekf_t *s)
+{
+    memset(s, 0, sizeof(ekf_t));
+    s->x[0] = 1.0F;
+    s->gyro_var = 1e-4F;
+    s->bias_var = 1e-8F;
+    s->acc_var = 1e-2F;
+    s->mag_var = 5e-2F;
+}
+
+static bool ekf_normalize(float *v)
+{
+    float n = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (n == 0.0F) {
+        return false;
+    }
+    v[0] /= n;
+    v[1] /= n;
+    v[2] /= n;
+    return true;
+}
+
+/* world magnetic field from m (normalized, body) at the current attitude */
+static void ekf_set_m_ref(ekf_t *s, const float *m)
+{
+    float mw[3];
+    quatf_rot_inv(s->x, m, mw);
+    s->m_ref[0] = sqrtf(mw[0] * mw[0] + mw[1] * mw[1]);
+    s->m_ref[1] = 0.0F;
+    s->m_ref[2] = mw[2];
+    s->m_inited = true;
+}
+
+/* the attitude from the first sample: tilt from gravity, heading from the magnetometer */
+static void ekf_first(ekf_t *s, const float *a, const float *m, bool has_m)
+{
+    float *q = s->x;
+    if (a[2] > -0.999F) {
+        /* shortest arc from a to (0 0 1) */
+        q[0] = 1.0F + a[2];
+        q[1] = a[1];
+        q[2] = -a[0];
+        q[3] = 0.0F;
+    } else {
+        q[0] = 0.0F;
+        q[1] = 1.0F;
+        q[2] = q[3] = 0.0F;
+    }
+    quatf_normalize(q);
+
+    if (has_m) {
+        float mw[3];
+        quatf_rot_inv(q, m, mw);
+        float half = 0.5F * atan2f(mw[1], mw[0]);
+        float qz[4] = { cosf(half), 0.0F, 0.0F, -sinf(half) }, r[4];
+        quatf_mul(qz, q, r);
+        memcpy(q, r, sizeof(r));
+        ekf_set_m_ref(s, m);
+    }
+
+    mat_identity(s->P, EKF_N);
+    for (int i = 0; i < EKF_N; i++) {
+        s->P[i * EKF_N + i] = (i < 4) ? 1e-2F : 1e-4F;
+    }
+    s->inited = true;
+}
+
+static void ekf_predict(ekf_t *s, const float *g, float dt)
+{
+    float *q = s->x;
+    float w[3] = { g[0] - s->x[4], g[1] - s->x[5], g[2] - s->x[6] };
+    float h = 0.5F * dt;
+
+    /* Xi(q): q x (0, w) = Xi(q) w */
+    float xi[4 * 3] = {
+        -q[1], -q[2], -q[3],
+         q[0], -q[3],  q[2],
+         q[3],  q[0], -q[1],
+        -q[2],  q[1],  q[0],
+    };
+
+    /* F = | I + dt/2 Omega(w)   -dt/2 Xi(q) |
+           | 0                    I          | */
+    float F[EKF_N * EKF_N];
+    mat_identity(F, EKF_N);
+    const float omega[4 * 4] = {
+        0.0F,  -w[0], -w[1], -w[2],
+        w[0],   0.0F,  w[2], -w[1],
+        w[1],  -w[2],  0.0F,  w[0],
+        w[2],   w[1], -w[0],  0.0F,
+    };
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            F[i * EKF_N + j] += h * omega[i * 4 + j];
+        }
+        for (int j = 0; j < 3; j++) {
+            F[i * EKF_N + 4 + j] = -h * xi[i * 3 + j];
+        }
+    }
+
+    float qn[4];
+    for (int i = 0; i < 4; i++) {
+        qn[i] = q[i] + h * (xi[i * 3] * w[0] + xi[i * 3 + 1] * w[1] + xi[i * 3 + 2] * w[2]);
+    }
+    memcpy(q, qn, sizeof(qn));
+    quatf_normalize(q);
+
+    /* P = F P F' + Q, Q = gyro noise through Xi, bias random walk */
+    float T[EKF_N * EKF_N];
+    mat_mul(F, s->P, T, EKF_N, EKF_N, EKF_N);
+    mat_mul_bt(T, F, s->P, EKF_N, EKF_N, EKF_N);
+
+    float xixt[4 * 4];
+    mat_mul_bt(xi, xi, xixt, 4, 3, 4);
+    float kq = h * h * s->gyro_var;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            s->P[i * EKF_N + j] += kq * xixt[i * 4 + j];
+        }
+    }
+    for (int i = 4; i < EKF_N; i++) {
+        s->P[i * EKF_N + i] += s->bias_var * dt;
+    }
+}
+
+/* one 3-axis correction against z = R(q)' r, r = (rx 0 rz) */
+static void ekf_correct(ekf_t *s, const float *z, const float *r, float var)
+{
+    const float *q = s->x;
+    float w = q[0], x = q[1], y = q[2], qz = q[3];
+    float rx = r[0], rz = r[2];
+
+    float hq[3];
+    quatf_rot(q, r, hq);
+
+    /* H = d(R(q)' r) / d(w x y z), the bias columns are 0 */
+    float H[3 * EKF_N];
+    memset(H, 0, sizeof(H));
+    H[0] = -2 * rz * y;
+    H[1] =  2 * rz * qz;
+    H[2] = -4 * rx * y - 2 * rz * w;
+    H[3] = -4 * rx * qz + 2 * rz * x;
+    H[EKF_N + 0] = -2 * rx * qz + 2 * rz * x;
+    H[EKF_N + 1] =  2 * rx * y + 2 * rz * w;
+    H[EKF_N + 2] =  2 * rx * x + 2 * rz * qz;
+    H[EKF_N + 3] = -2 * rx * w + 2 * rz * y;
+    H[2 * EKF_N + 0] =  2 * rx * y;
+    H[2 * EKF_N + 1] =  2 * rx * qz - 4 * rz * x;
+    H[2 * EKF_N + 2] =  2 * rx * w - 4 * rz * y;
+    H[2 * EKF_N + 3] =  2 * rx * x;
+
+    /* S = H P H' + R, K = P H' inv(S) */
+    float PHt[EKF_N * 3], S[3 * 3], Si[3 * 3], K[EKF_N * 3];
+    mat_mul_bt(s->P, H, PHt, EKF_N, EKF_N, 3);
+    mat_mul(H, PHt, S, 3, EKF_N, 3);
+    S[0] += var;
+    S[4] += var;
+    S[8] += var;
+    if (!mat3_inv(S, Si)) {
+        return;
+    }
+    mat_mul(PHt, Si, K, EKF_N, 3, 3);
+
+    float e[3] = { z[0] - hq[0], z[1] - hq[1], z[2] - hq[2] };
+    for (int i = 0; i < EKF_N; i++) {
+        s->x[i] += K[i * 3] * e[0] + K[i * 3 + 1] * e[1] + K[i * 3 + 2] * e[2];
+    }
+    quatf_normalize(s->x);
+
+    /* P = P - K (P H')' */
+    float T[EKF_N * EKF_N];
+    mat_mul_bt(K, PHt, T, EKF_N, 3, EKF_N);
+    mat_add_scaled(s->P, T, -1.0F, EKF_N, EKF_N);
+    mat_symmetrize(s->P, EKF_N);
+}
+
+void ekf_update(ekf_t *s, v3_t g, v3_t a, v3_t m, float deltaT)
+{
+    float av[3] = { a.x, a.y, a.z };
+    float mv[3] = { m.x, m.y, m.z };
+    float gv[3] = { g.x, g.y, g.z };
+    float norm_a = v_norm(a);
+    bool has_a = ekf_normalize(av);
+    bool has_m = ekf_normalize(mv);
+
+    if (!s->inited) {
+        if (has_a) {
+            ekf_first(s, av, mv, has_m);
+        }
+        return;
+    }
+
+    ekf_predict(s, gv, deltaT);
+
+    /* only while the accelerometer sees little but gravity */
+    if (has_a && fabsf(norm_a - 1.0F) < EKF_ACC_GATE) {
+        static const float up[3] = { 0.0F, 0.0F, 1.0F };
+        ekf_correct(s, av, up, s->acc_var);
+    }
+    if (has_m) {
+        if (!s->m_inited) {
+            ekf_set_m_ref(s, mv);
+        } else {
+            ekf_correct(s, mv, s->m_ref, s->mag_var);
+        }
+    }
+}
+
+void ekf_get_q(ekf_t *s, q_t *q)
+{
+    q->w = s->x[0];
+    q->x = s->x[1];
+    q->y = s->x[2];
+    q->z = s->x[3];
+}
+
+v3_t ekf_get_bias(ekf_t *s)
+{
+    v3_t b = { s->x[4], s->x[5], s->x[6] };
+    return b;
+}
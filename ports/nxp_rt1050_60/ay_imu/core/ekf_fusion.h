@@ -0,0 +1,35 @@
+#ifndef __EKF_FUSION_H__
+#define __EKF_FUSION_H__
+
+#include <stdbool.h>
+#include "../math/quaternion.h"
+
+/*
+    9-DOF extended Kalman filter.
+    state: attitude quaternion (w x y z, body to world as f1) and gyro bias (x y z)
+    measurements: gravity direction from the accelerometer, magnetic field direction
+*/
+
+#define EKF_N   (7)
+
+typedef struct
+{
+    float x[EKF_N];
+    float P[EKF_N * EKF_N];
+    float m_ref[3];         /* world magnetic field direction, x is magnetic north */
+    bool inited;
+    bool m_inited;
+    /* noise, as variances */
+    float gyro_var;         /* (rad/s)^2 */
+    float bias_var;         /* (rad/s)^2 per s */
+    float acc_var;          /* of the normalized accelerometer */
+    float mag_var;          /* of the normalized magnetometer */
+}ekf_t;
+
+void ekf_init(ekf_t *s);
+/* same units as f1_ahrs_update(), m may be all 0 without a magnetometer */
+void ekf_update(ekf_t *s, v3_t g, v3_t a, v3_t m, float deltaT);
+void ekf_get_q(ekf_t *s, q_t *q);
+v3_t ekf_get_bias(ekf_t *s);
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * Autonomous IMU sampling.
+ *
+ * Every period of the QTIMER its IRQ first fuses the samples the bus delivered since the
+ * last one, then starts the next read. The read is an interrupt driven LPI2C transfer
+ * straight into the ring, whose completion IRQ only hands the sample over. The two IRQs
+ * are the ring's one producer and one consumer, so it needs no locks, and the script only
+ * ever sees the attitude.
+ */
+#include <string.h>
+
+#include "py/mpconfig.h"
+#include "py/ringbuf.h"
+#include "imu_sampler.h"
+
+typedef struct _imu_sampler_t {
+	imu_sampler_config_t cfg;
+	pyb_qtimer_obj_t *timer;
+	lpi2c_master_handle_t handle;
+	lpi2c_master_transfer_t xfer;
+	ringbuf_t ring;
+	uint8_t sample_len;
+	volatile bool busy;     // a read is on the bus
+	volatile bool valid;    // q holds a fused sample
+	volatile uint32_t fused;
+	volatile uint32_t missed;   // periods without a read: bus still busy, ring full or errors
+	q_t q;
+} imu_sampler_t;
+
+static imu_sampler_t imu_sampler;
+static uint8_t imu_sampler_buf[IMU_SAMPLER_RING_SAMPLES * IMU_SAMPLER_SAMPLE_MAX];
+
+#define IMU_SAMPLER_S16(p) ((float) (int16_t) (((p)[0] << 8) | (p)[1]))
+
+static v3_t imu_sampler_decode(const uint8_t *p, float scale)
+{
+	v3_t v = {
+		IMU_SAMPLER_S16(p) * scale,
+		IMU_SAMPLER_S16(p + 2) * scale,
+		IMU_SAMPLER_S16(p + 4) * scale,
+	};
+	return v;
+}
+
+static void imu_sampler_fuse(imu_sampler_t *s, const uint8_t *p)
+{
+	v3_t m = { 0, 0, 0 };
+	v3_t a = imu_sampler_decode(p, s->cfg.scale[0]);
+	p += 6 + s->cfg.gap;
+	v3_t g = imu_sampler_decode(p, s->cfg.scale[1]);
+	if (s->cfg.mag) {
+		m = imu_sampler_decode(p + 6, s->cfg.scale[2]);
+	}
+
+	q_t q;
+	if (s->cfg.ekf) {
+		ekf_update(s->cfg.ekf, g, a, m, s->timer->period);
+		ekf_get_q(s->cfg.ekf, &q);
+	} else {
+		f1_ahrs_update(&q, g, a, m, s->timer->period);
+		f1_get_q(&q);
+	}
+	s->q = q;
+	s->valid = true;
+	s->fused++;
+}
+
+static void imu_sampler_done(LPI2C_Type *base, lpi2c_master_handle_t *handle, status_t status, void *userData)
+{
+	imu_sampler_t *s = userData;
+	if (status == kStatus_Success) {
+		ringbuf_put_commit(&s->ring, s->sample_len);
+	} else {
+		s->missed++;
+	}
+	s->busy = false;
+}
+
+static void imu_sampler_tick(void)
+{
+	imu_sampler_t *s = &imu_sampler;
+	uint8_t *p;
+
+	// Both ends move a whole sample at a time and the ring holds a whole number of them,
+	// so a sample never wraps.
+	while (ringbuf_get_span(&s->ring, &p) >= s->sample_len) {
+		imu_sampler_fuse(s, p);
+		ringbuf_get_commit(&s->ring, s->sample_len);
+	}
+
+	if (s->busy || (ringbuf_put_span(&s->ring, &p) < s->sample_len)) {
+		s->missed++;
+		return;
+	}
+	s->xfer.data = p;
+	s->busy = true;
+	if (LPI2C_MasterTransferNonBlocking(s->cfg.i2c, &s->handle, &s->xfer) != kStatus_Success) {
+		s->busy = false;
+		s->missed++;
+	}
+}
+
+bool imu_sampler_start(const imu_sampler_config_t *cfg, pyb_qtimer_obj_t *timer)
+{
+	imu_sampler_t *s = &imu_sampler;
+	if (s->timer) {
+		return false;
+	}
+
+	memset(s, 0, sizeof(*s));
+	s->cfg = *cfg;
+	s->sample_len = 12 + cfg->gap + (cfg->mag ? 6 : 0);
+	s->ring.buf = imu_sampler_buf;
+	s->ring.size = IMU_SAMPLER_RING_SAMPLES * s->sample_len;
+	s->xfer.slaveAddress = cfg->addr;
+	s->xfer.direction = kLPI2C_Read;
+	s->xfer.subaddress = cfg->memaddr;
+	s->xfer.subaddressSize = 1;
+	s->xfer.dataSize = s->sample_len;
+	s->xfer.flags = kLPI2C_TransferDefaultFlag;
+
+	// Above the timer, so a read finishes while the timer IRQ fuses.
+	LPI2C_MasterTransferCreateHandle(cfg->i2c, &s->handle, imu_sampler_done, s);
+	NVIC_SetPriority(cfg->irqn, 14);
+
+	s->timer = timer;
+	timer->irq_handler = imu_sampler_tick;
+	return true;
+}
+
+void imu_sampler_stop(void)
+{
+	imu_sampler_t *s = &imu_sampler;
+	if (s->timer == NULL) {
+		return;
+	}
+
+	mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+	s->timer->irq_handler = NULL;
+	if (s->busy) {
+		LPI2C_MasterTransferAbort(s->cfg.i2c, &s->handle);
+		s->busy = false;
+	}
+	MICROPY_END_ATOMIC_SECTION(atomic_state);
+	s->timer = NULL;
+}
+
+bool imu_sampler_active(void)
+{
+	return imu_sampler.timer != NULL;
+}
+
+bool imu_sampler_get_q(q_t *q)
+{
+	mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+	*q = imu_sampler.q;
+	bool valid = imu_sampler.valid;
+	MICROPY_END_ATOMIC_SECTION(atomic_state);
+	return valid;
+}
+
+void imu_sampler_get_stats(uint32_t *fused, uint32_t *missed)
+{
+	*fused = imu_sampler.fused;
+	*missed = imu_sampler.missed;
+}
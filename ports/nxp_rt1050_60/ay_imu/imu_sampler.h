@@ -0,0 +1,37 @@
+#ifndef _IMU_SAMPLER_H_
+#define _IMU_SAMPLER_H_
+// Autonomous IMU sampling: a QTIMER reads the sensor over LPI2C without the script, the
+// samples go through a ring and are fused in the timer's IRQ, lowest priority.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "fsl_lpi2c.h"
+#include "core/fusion.h"
+#include "core/ekf_fusion.h"
+#include "qtimer.h"
+
+#define IMU_SAMPLER_RING_SAMPLES    (16)
+// accel + gap + gyro + mag, big-endian int16 x/y/z each
+#define IMU_SAMPLER_SAMPLE_MAX      (6 + 4 + 6 + 6)
+
+typedef struct _imu_sampler_config_t {
+	LPI2C_Type *i2c;
+	IRQn_Type irqn;
+	uint8_t addr;
+	uint8_t memaddr;
+	uint8_t gap;    // bytes between accel and gyro, 2 for the MPU6050's temperature
+	bool mag;       // mag x/y/z follow the gyro
+	float scale[3]; // per LSB: accel, gyro, mag
+	ekf_t *ekf;     // fuse with this EKF, NULL for f1
+} imu_sampler_config_t;
+
+// Starts sampling once per period of timer, which must be running. Returns false if the
+// sampler already runs.
+bool imu_sampler_start(const imu_sampler_config_t *cfg, pyb_qtimer_obj_t *timer);
+void imu_sampler_stop(void);
+bool imu_sampler_active(void);
+// The attitude after the last fused sample, false before the first one.
+bool imu_sampler_get_q(q_t *q);
+void imu_sampler_get_stats(uint32_t *fused, uint32_t *missed);
+
+#endif
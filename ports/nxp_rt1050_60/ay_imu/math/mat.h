@@ -0,0 +1,130 @@
+#ifndef __MAT_H__
+#define __MAT_H__
+
+/*
+    Fixed-size matrix and quaternion math, header only.
+
+    Matrices are row-major float arrays whose sizes are known where they are used, so with
+    the sizes constant the loops below inline and unroll; nothing is passed by value and
+    nothing is allocated. Quaternions are float[4] in the order of q_t: w, x, y, z.
+*/
+
+#include <math.h>
+#include <string.h>
+
+static inline void mat_identity(float *a, int n)
+{
+    memset(a, 0, sizeof(float) * n * n);
+    for (int i = 0; i < n; i++) {
+        a[i * n + i] = 1.0F;
+    }
+}
+
+/* c(n x p) = a(n x m) * b(m x p), c must not be a or b */
+static inline void mat_mul(const float *a, const float *b, float *c, int n, int m, int p)
+{
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < p; j++) {
+            float s = 0.0F;
+            for (int k = 0; k < m; k++) {
+                s += a[i * m + k] * b[k * p + j];
+            }
+            c[i * p + j] = s;
+        }
+    }
+}
+
+/* c(n x p) = a(n x m) * b(p x m)', c must not be a or b */
+static inline void mat_mul_bt(const float *a, const float *b, float *c, int n, int m, int p)
+{
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < p; j++) {
+            float s = 0.0F;
+            for (int k = 0; k < m; k++) {
+                s += a[i * m + k] * b[j * m + k];
+            }
+            c[i * p + j] = s;
+        }
+    }
+}
+
+/* a(n x m) += k * b(n x m) */
+static inline void mat_add_scaled(float *a, const float *b, float k, int n, int m)
+{
+    for (int i = 0; i < n * m; i++) {
+        a[i] += k * b[i];
+    }
+}
+
+/* a(n x n) = (a + a') / 2, keeps covariances symmetric against rounding */
+static inline void mat_symmetrize(float *a, int n)
+{
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            float s = 0.5F * (a[i * n + j] + a[j * n + i]);
+            a[i * n + j] = a[j * n + i] = s;
+        }
+    }
+}
+
+/* r = inv(a) for 3 x 3, returns 0 if a is singular */
+static inline int mat3_inv(const float *a, float *r)
+{
+    float c00 = a[4] * a[8] - a[5] * a[7];
+    float c01 = a[5] * a[6] - a[3] * a[8];
+    float c02 = a[3] * a[7] - a[4] * a[6];
+    float det = a[0] * c00 + a[1] * c01 + a[2] * c02;
+    if (fabsf(det) < 1e-12F) {
+        return 0;
+    }
+    float inv = 1.0F / det;
+    r[0] = c00 * inv;
+    r[1] = (a[2] * a[7] - a[1] * a[8]) * inv;
+    r[2] = (a[1] * a[5] - a[2] * a[4]) * inv;
+    r[3] = c01 * inv;
+    r[4] = (a[0] * a[8] - a[2] * a[6]) * inv;
+    r[5] = (a[2] * a[3] - a[0] * a[5]) * inv;
+    r[6] = c02 * inv;
+    r[7] = (a[1] * a[6] - a[0] * a[7]) * inv;
+    r[8] = (a[0] * a[4] - a[1] * a[3]) * inv;
+    return 1;
+}
+
+/* r = p * q (Hamilton, as q_mul()), r must not be p or q */
+static inline void quatf_mul(const float *p, const float *q, float *r)
+{
+    r[0] = p[0] * q[0] - p[1] * q[1] - p[2] * q[2] - p[3] * q[3];
+    r[1] = p[0] * q[1] + p[1] * q[0] + p[2] * q[3] - p[3] * q[2];
+    r[2] = p[0] * q[2] - p[1] * q[3] + p[2] * q[0] + p[3] * q[1];
+    r[3] = p[0] * q[3] + p[1] * q[2] - p[2] * q[1] + p[3] * q[0];
+}
+
+static inline void quatf_normalize(float *q)
+{
+    float n = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+    if (n > 0.0F) {
+        n = 1.0F / sqrtf(n);
+        q[0] *= n;
+        q[1] *= n;
+        q[2] *= n;
+        q[3] *= n;
+    }
+}
+
+/* r = v rotated into the frame of q, as q_rot() */
+static inline void quatf_rot(const float *q, const float *v, float *r)
+{
+    float w = q[0], x = q[1], y = q[2], z = q[3];
+    r[0] = v[0] * (1 - 2 * y * y - 2 * z * z) + v[1] * 2 * (x * y + w * z) + v[2] * 2 * (x * z - w * y);
+    r[1] = v[0] * 2 * (x * y - w * z) + v[1] * (1 - 2 * x * x - 2 * z * z) + v[2] * 2 * (y * z + w * x);
+    r[2] = v[0] * 2 * (x * z + w * y) + v[1] * 2 * (y * z - w * x) + v[2] * (1 - 2 * x * x - 2 * y * y);
+}
+
+/* r = v rotated out of the frame of q, the inverse of quatf_rot() */
+static inline void quatf_rot_inv(const float *q, const float *v, float *r)
+{
+    float qc[4] = { q[0], -q[1], -q[2], -q[3] };
+    quatf_rot(qc, v, r);
+}
+
+#endif
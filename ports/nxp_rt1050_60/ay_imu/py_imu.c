@@ -14,6 +14,8 @@
 #include "fusion.h"
 #include "eular.h"
 #include "py_imu.h"
+#include "imu_sampler.h"
+#include "i2c.h"
 pyb_imu_obj_t pyb_imu_obj[1] = {
 	{&pyb_imu_type, fusion_out_euler}, 
 };
@@ -34,6 +36,8 @@ STATIC mp_obj_t pyb_imu_init_helper(pyb_imu_obj_t *self, mp_uint_t n_args, const
 		{ MP_QSTR_scale_g,    MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
 		{ MP_QSTR_scale_m,    MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
         { MP_QSTR_delta_ms,   MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },      
+		{ MP_QSTR_average,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+		{ MP_QSTR_ekf,        MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
 		// <<<
     };
 	static const mp_float_t dfltCArgs[4] = {2.0 / 32768.0, 1000.0 * (3.141592654 / 180.0) / 32768.0, 0.01, 0.05};
@@ -49,6 +53,15 @@ STATIC mp_obj_t pyb_imu_init_helper(pyb_imu_obj_t *self, mp_uint_t n_args, const
 		} else 
 			self->args[i] = dfltCArgs[i];
 	}
+	if (args[5].u_int < 0 || args[5].u_int > FIR_MAX_BUF_SIZE) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "average out of range!"));
+	}
+	self->average = args[5].u_int;
+	for (i=0; i<3 && self->average; i++) {
+		moving_average_init(self->acc_avg + i, self->average);
+	}
+	self->use_ekf = args[6].u_bool;
+	ekf_init(&self->ekf);
 	
     return mp_const_none;
 }
@@ -91,6 +104,38 @@ typedef struct _mp_obj_float_t {
 } mp_obj_float_t;
 
 
+// One sample through the accelerometer filter and the fusion, the attitude ends up in q.
+STATIC void imu_fuse(pyb_imu_obj_t *self, imu_param_t *imu, float itv_ms, q_t *q) {
+	uint32_t i;
+	for (i=0; i<3 && self->average; i++) {
+		moving_average_run(self->acc_avg + i, imu->agm[0] + i, imu->agm[0] + i);
+	}
+	if (self->use_ekf) {
+		ekf_update(&self->ekf, imu->vs[1], imu->vs[0], imu->vs[2], itv_ms);
+		ekf_get_q(&self->ekf, q);
+	} else {
+		f1_ahrs_update(q, imu->vs[1], imu->vs[0], imu->vs[2], itv_ms);
+		f1_get_q(q);
+	}
+}
+
+STATIC mp_obj_t imu_new_result(pyb_imu_obj_t *self, q_t *q, bool quat) {
+	mp_obj_t items[4];
+	eular_t e;
+	if (!quat && self->outMode == fusion_out_euler) {
+		quat2angle(q, &e, "ZYX");
+		items[0] = mp_obj_new_float((mp_float_t) e.pitch);
+		items[1] = mp_obj_new_float((mp_float_t) e.roll);
+		items[2] = mp_obj_new_float((mp_float_t) e.yaw);
+		return mp_obj_new_tuple(3, items);
+	}
+	items[0] = mp_obj_new_float((mp_float_t) q->x);
+	items[1] = mp_obj_new_float((mp_float_t) q->y);
+	items[2] = mp_obj_new_float((mp_float_t) q->z);
+	items[3] = mp_obj_new_float((mp_float_t) q->w);
+	return mp_obj_new_tuple(4, items);
+}
+
 STATIC mp_obj_t pyb_imu_step(size_t n_args, const mp_obj_t *args) {
 
 	pyb_imu_obj_t *self = MP_OBJ_TO_PTR(args[0]);
@@ -101,11 +146,8 @@ STATIC mp_obj_t pyb_imu_step(size_t n_args, const mp_obj_t *args) {
 	uint32_t i, j;
 	int32_t s32Val;
 	q_t q;
-	eular_t e;
 	imu_param_t imu;
 	memset(&imu, 0, sizeof(imu));
-	mp_obj_tuple_t *pObjTuple;
-	mp_obj_t items[4];	
 	for (i=0; i<3; i++) {
 		if (args[i + 1] != (const mp_obj_t)&mp_const_none_obj ) {
 			pyb_buf_get_for_send(args[i + 1], bufinfos + i, data);
@@ -125,36 +167,133 @@ STATIC mp_obj_t pyb_imu_step(size_t n_args, const mp_obj_t *args) {
 	if (args[4] != MP_OBJ_NULL) {
 		itv_ms = mp_obj_get_float(args[4]);
 	}
-	uint32_t retFObjCnt = self->outMode == fusion_out_euler ? 3 : 4;	
-	
-	f1_ahrs_update(&q, imu.vs[1], imu.vs[0], imu.vs[2], itv_ms);	
-	
-	if (self->outMode == fusion_out_euler) {
-		f1_get_q(&q);
-		quat2angle(&q, &e, "ZYX");
-		items[0] = mp_obj_new_float((mp_float_t) e.pitch);
-		items[1] = mp_obj_new_float((mp_float_t) e.roll);
-		items[2] = mp_obj_new_float((mp_float_t) e.yaw);
-	} else {
-		items[0] = mp_obj_new_float((mp_float_t) q.x);
-		items[1] = mp_obj_new_float((mp_float_t) q.y);
-		items[2] = mp_obj_new_float((mp_float_t) q.z);	
-		items[3] = mp_obj_new_float((mp_float_t) q.w);	
+	imu_fuse(self, &imu, itv_ms, &q);
+	return imu_new_result(self, &q, false);
+}
+
+// step_block(buf, n, delta_ms[, every]): n samples from an array('h') of raw FIFO data, 9 values
+// per sample (accel, gyro, mag x/y/z in native order) or 6 without a magnetometer, all in one
+// go. Returns the final quaternion (x, y, z, w), or with every > 0 that and a list of the
+// results in the init() mode for every every-th sample.
+STATIC mp_obj_t pyb_imu_step_block(size_t n_args, const mp_obj_t *args) {
+	pyb_imu_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+	mp_buffer_info_t bufinfo;
+	mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_READ);
+	mp_int_t n = mp_obj_get_int(args[2]);
+	float itv_ms = mp_obj_get_float(args[3]);
+	mp_int_t every = (n_args > 4) ? mp_obj_get_int(args[4]) : 0;
+	if (bufinfo.typecode != 'h') {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_TypeError, "must be an array('h') of sensor raw data!"));
+	}
+	size_t count = bufinfo.len / sizeof(int16_t);
+	if (n <= 0 || every < 0 || (count != (size_t)n * 9 && count != (size_t)n * 6)) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "must be 6 or 9 values per sample!"));
 	}
 
-	pObjTuple = (mp_obj_tuple_t*) mp_obj_new_tuple(retFObjCnt, (mp_obj_t)items);
+	size_t stride = count / n;
+	const int16_t *p = bufinfo.buf;
+	mp_obj_t list = every ? mp_obj_new_list(0, NULL) : MP_OBJ_NULL;
+	imu_param_t imu;
+	memset(&imu, 0, sizeof(imu));
+	q_t q;
+	for (mp_int_t s = 0; s < n; s++, p += stride) {
+		for (size_t i = 0; i < stride; i++) {
+			imu.agm[i / 3][i % 3] = (float) p[i] * self->args[i / 3];
+		}
+		imu_fuse(self, &imu, itv_ms, &q);
+		if (every && ((s + 1) % every) == 0) {
+			mp_obj_list_append(list, imu_new_result(self, &q, false));
+		}
+	}
+
+	mp_obj_t ret = imu_new_result(self, &q, true);
+	if (every) {
+		mp_obj_t items[2] = { ret, list };
+		return mp_obj_new_tuple(2, items);
+	}
+	return ret;
+}
+
+// start(i2c, addr, memaddr, timer, *, gap=0, mag=False): from now on timer, a running
+// QTIMER, reads a sample from memaddr of the sensor at addr once per period, laid out as
+// step() takes it, and fuses it in its IRQ. The bus is the sampler's until stop().
+STATIC mp_obj_t pyb_imu_start(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_i2c,      MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_addr,     MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_memaddr,  MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_timer,    MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_gap,      MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_mag,      MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+	pyb_imu_obj_t *self = pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+	if (!MP_OBJ_IS_TYPE(args[0].u_obj, &pyb_i2c_type) || !MP_OBJ_IS_TYPE(args[3].u_obj, &pyb_qtimer_type)) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_TypeError, "need an I2C and a QTIMER!"));
+	}
+	if (args[4].u_int < 0 || args[4].u_int > 4) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "gap must be 0-4 bytes!"));
+	}
+	pyb_i2c_obj_t *i2c = MP_OBJ_TO_PTR(args[0].u_obj);
+	static const IRQn_Type lpi2c_irqs[] = LPI2C_IRQS;
+	imu_sampler_config_t cfg = {
+		.i2c = i2c->pI2C,
+		.irqn = lpi2c_irqs[i2c->ndx],
+		.addr = args[1].u_int,
+		.memaddr = args[2].u_int,
+		.gap = args[4].u_int,
+		.mag = args[5].u_bool,
+		.scale = { self->args[0], self->args[1], self->args[2] },
+		.ekf = self->use_ekf ? &self->ekf : NULL,
+	};
+	if (!imu_sampler_start(&cfg, MP_OBJ_TO_PTR(args[3].u_obj))) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "sampler already running!"));
+	}
+	return mp_const_none;
+}
+
+STATIC mp_obj_t pyb_imu_stop(mp_obj_t self_in) {
+	imu_sampler_stop();
+	return mp_const_none;
+}
+
+// The attitude after the last sampled sample in the init() mode, None before there is one.
+STATIC mp_obj_t pyb_imu_attitude(mp_obj_t self_in) {
+	q_t q;
+	if (!imu_sampler_get_q(&q)) {
+		return mp_const_none;
+	}
+	return imu_new_result(MP_OBJ_TO_PTR(self_in), &q, false);
+}
 
-	return (mp_obj_t)pObjTuple;
+// (fused, missed): samples fused, and periods the sampler couldn't read one.
+STATIC mp_obj_t pyb_imu_stats(mp_obj_t self_in) {
+	uint32_t fused, missed;
+	imu_sampler_get_stats(&fused, &missed);
+	mp_obj_t items[2] = { mp_obj_new_int_from_uint(fused), mp_obj_new_int_from_uint(missed) };
+	return mp_obj_new_tuple(2, items);
 }
 
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(pyb_imu_init_obj, 1, pyb_imu_init);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(pyb_imu_start_obj, 1, pyb_imu_start);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_imu_stop_obj, pyb_imu_stop);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_imu_attitude_obj, pyb_imu_attitude);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_imu_stats_obj, pyb_imu_stats);
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_imu_deinit_obj, pyb_imu_deinit);
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pyb_imu_step_obj, 4, 5, pyb_imu_step);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pyb_imu_step_block_obj, 4, 5, pyb_imu_step_block);
 
 STATIC const mp_rom_map_elem_t imu_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_init), MP_ROM_PTR(&pyb_imu_init_obj) },
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&pyb_imu_deinit_obj) },
 	{ MP_ROM_QSTR(MP_QSTR_step), MP_ROM_PTR(&pyb_imu_step_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_step_block), MP_ROM_PTR(&pyb_imu_step_block_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_start), MP_ROM_PTR(&pyb_imu_start_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&pyb_imu_stop_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_attitude), MP_ROM_PTR(&pyb_imu_attitude_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&pyb_imu_stats_obj) },
 };
 
 
@@ -4,6 +4,8 @@
 
 #include "core/fusion.h"
 #include "core/integration.h"
+#include "core/ekf_fusion.h"
+#include "filter/moving_average.h"
 
 typedef enum _enum_fusion_out_t
 {
@@ -28,6 +30,10 @@ typedef struct _pyb_imu_obj_t {
     mp_obj_base_t base;
 	enum_fusion_out_t outMode;
 	mp_float_t args[4]; // 0 = scale_a, 1 = scale_g, 2 = scale_m, 3 = delta_ms
+	uint8_t average; // moving average width over the accelerometer, 0 = off
+	fir_t acc_avg[3];
+	bool use_ekf; // EKF instead of f1
+	ekf_t ekf;
 }pyb_imu_obj_t;
 
 
@@ -6,6 +6,7 @@
 #define MICROPY_HW_UART_REPL    	(repl_uart_id)	// uart ID of REPL uart, must be the same as repl_uart_id in uart.h
 #define MICROPY_HW_HAS_SWITCH       (1)
 #define MICROPY_HW_HAS_FLASH        (0)
+#define MICROPY_HW_FLASH_FS_LFS2    (0)		// 1: /flash is littlefs on the raw HyperFlash instead of FAT on the FLEG FTL
 #define MICROPY_HW_HAS_SDCARD       (1)
 #define MICROPY_HW_HAS_LCD          (0)
 #define MICROPY_HW_ENABLE_RNG       (1)
@@ -5,4 +5,6 @@ SDK_MCU = CPU_MIMXRT1052DVL6A
 AF_FILE = boards/mimxrt105x_af.csv
 #LD_FILE = MIMXRT1052xxxxx.ld
 LD_FILE = MIMXRT1052_omv.ld
-#LD_FILE = test.ld
\ No newline at end of file
+#LD_FILE = test.ld
+# FlexRAM banks, see FLEXRAM_PROFILE in the Makefile
+FLEXRAM_PROFILE ?= vision
@@ -82,6 +82,9 @@
 // Enable LENET (200+ KB).
 #define OMV_ENABLE_LENET
 
+// Enable the MJPEG over HTTP stream server (omv.stream_server()), it needs the WINC driver.
+#define OMV_ENABLE_STREAM_SERVER
+
 // Bootloader LED GPIO port/pin
 #define OMV_BOOTLDR_LED_PIN     (GPIO_PIN_1)
 #define OMV_BOOTLDR_LED_PORT    (GPIOC)
@@ -93,6 +96,12 @@
 // Low and high JPEG QS.
 #define JPEG_QUALITY_LOW        35
 #define JPEG_QUALITY_HIGH       80
+
+// Power model of the capture energy estimates in sensor.get_stats(), mW with the core at
+// 600MHz. Rough figures for a board without an LCD, measure yours to refine them.
+#define OMV_PWR_STATIC_MW       (250)   // sensor, SDRAM, regulators, leakage: not clock scaled
+#define OMV_PWR_RUN_MW          (150)   // core running, scales with its clock
+#define OMV_PWR_WFI_MW          (40)    // core gated in WFI with its buses still clocked
 #define OMV_UMM_BLOCK_SIZE      16
 // Linker script constants (see the linker script template stm32fxxx.ld.S).
 // Note: fb_alloc is a stack-based, dynamically allocated memory on FB.
@@ -103,6 +112,19 @@
 
 #define OMV_FB_SIZE         (301 * 1024)  // FB memory: header + VGA/GS image
 #define OMV_FB_ALLOC_SIZE   (120 * 1024)   // minimum fb alloc size
+// fb_alloc tiers for FB_ALLOC_PREFER_SPEED (line buffers, NN scratch), 0 to disable.
+// The linker places .fb_alloc_dtcm in DTCM and .fb_alloc_ocram in the OCRAM banks of the
+// FLEXRAM_PROFILE, which takes them all when it has any.
+#define OMV_FB_ALLOC_DTCM_SIZE  (16 * 1024)
+#if (FLEXRAM_OCRAM_SIZE > 0)
+#define OMV_FB_ALLOC_OCRAM_SIZE (FLEXRAM_OCRAM_SIZE)
+#else
+#define OMV_FB_ALLOC_OCRAM_SIZE (0 * 1024)
+#endif
+// Scratch arena for imlib list nodes and temporary arrays, 0 to keep them on the GC heap.
+#define OMV_XALLOC_ARENA_SIZE   (8 * 1024)
+// fb_alloc read-ahead of file_buffer_on(), the file parsers and model loaders.
+#define OMV_FILE_BUFFER_SIZE    (16 * 1024)
 #define OMV_STACK_SIZE      (8 * 1024)
 
 #define OMV_JPEG_BUF_SIZE   (24 * 1024) // IDE JPEG buffer (header + data).
@@ -0,0 +1,52 @@
+/*
+ * Boot phase timeline, pyb.boot_times().
+ *
+ * main() marks the end of each step of the start-up with the microseconds since the
+ * timeline started, the sensor marks the first frame it hands out. Python reads them back to
+ * see where the time to the first frame goes.
+ */
+#include "py/runtime.h"
+#include "py/mphal.h"
+#include "boottime.h"
+
+typedef struct {
+	qstr phase;
+	uint32_t us;
+} boot_phase_t;
+
+static boot_phase_t s_phases[BOOT_TIME_PHASES];
+static uint32_t s_phaseCnt;
+static uint32_t s_base;
+
+void boot_time_reset(uint32_t first_soft_reset)
+{
+	s_phaseCnt = 0;
+	s_base = first_soft_reset ? 0 : mp_hal_ticks_us();
+}
+
+void boot_time_mark(qstr phase)
+{
+	uint32_t i;
+	for (i = 0; i < s_phaseCnt; i++) {
+		if (s_phases[i].phase == phase)
+			return;
+	}
+	if (i < BOOT_TIME_PHASES) {
+		s_phases[i].phase = phase;
+		s_phases[i].us = mp_hal_ticks_us() - s_base;
+		s_phaseCnt = i + 1;
+	}
+}
+
+mp_obj_t boot_time_list(void)
+{
+	mp_obj_t list = mp_obj_new_list(0, NULL);
+	for (uint32_t i = 0; i < s_phaseCnt; i++) {
+		mp_obj_t t[2] = {
+			MP_OBJ_NEW_QSTR(s_phases[i].phase),
+			mp_obj_new_int_from_uint(s_phases[i].us),
+		};
+		mp_obj_list_append(list, mp_obj_new_tuple(2, t));
+	}
+	return list;
+}
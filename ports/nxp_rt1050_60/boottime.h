@@ -0,0 +1,18 @@
+/*
+ * Boot phase timeline behind pyb.boot_times().
+ *
+ */
+#ifndef __BOOTTIME_H__
+#define __BOOTTIME_H__
+#include <stdint.h>
+#include "py/obj.h"
+
+#define BOOT_TIME_PHASES	16	// marks kept, later ones are dropped
+
+// Starts a new timeline, at power-up from the SysTick start, at a soft reset from now.
+void boot_time_reset(uint32_t first_soft_reset);
+// Marks the end of a boot phase, once per timeline. Cheap enough for any code path.
+void boot_time_mark(qstr phase);
+// [(phase, us), ...] of the current timeline, in the order marked.
+mp_obj_t boot_time_list(void);
+#endif // __BOOTTIME_H__
@@ -0,0 +1,36 @@
+/*
+ * Allocator for berkeley-db (btree module).
+ *
+ * The library's malloc calls are renamed to these by BTREE_DEFS_EXTRA. Everything it
+ * allocates, the cached pages included, comes from the GC heap: page sized blocks go
+ * to the large object pool, and the stream object the tree reads through is kept
+ * alive by the DB structure pointing to it. Failures return NULL, the library unwinds
+ * itself and btree raises OSError.
+ *
+ */
+#include <string.h>
+#include "py/gc.h"
+
+#if MICROPY_PY_BTREE
+
+void *btree_malloc(size_t size) {
+    return gc_alloc(size, false);
+}
+
+void *btree_calloc(size_t n, size_t size) {
+    void *p = gc_alloc(n * size, false);
+    if (p != NULL) {
+        memset(p, 0, n * size);
+    }
+    return p;
+}
+
+void *btree_realloc(void *ptr, size_t size) {
+    return gc_realloc(ptr, size, true);
+}
+
+void btree_free(void *ptr) {
+    gc_free(ptr);
+}
+
+#endif // MICROPY_PY_BTREE
@@ -2236,5 +2236,8434 @@ QDEF(MP_QSTR_recvfrom, (const byte*)"\x91\x90\x08" "recvfrom")
 QDEF(MP_QSTR_sendto, (const byte*)"\x22\x03\x06" "sendto")
 QDEF(MP_QSTR_setsockopt, (const byte*)"\x38\xe8\x0a" "setsockopt")
 QDEF(MP_QSTR_getaddrinfo, (const byte*)"\x6e\x18\x0b" "getaddrinfo")
+QDEF(MP_QSTR_SINGLE_BUFFER, (const byte*)"\xe0\x50\x0d" "SINGLE_BUFFER")
+QDEF(MP_QSTR_DOUBLE_BUFFER, (const byte*)"\xcf\x24\x0d" "DOUBLE_BUFFER")
+QDEF(MP_QSTR_TRIPLE_BUFFER, (const byte*)"\xec\x79\x0d" "TRIPLE_BUFFER")
+QDEF(MP_QSTR_set_framebuffers, (const byte*)"\xf6\x9a\x10" "set_framebuffers")
+QDEF(MP_QSTR_get_framebuffers, (const byte*)"\x62\xe6\x10" "get_framebuffers")
+QDEF(MP_QSTR_snapshot_async, (const byte*)"\x30\xd9\x0e" "snapshot_async")
+QDEF(MP_QSTR_set_frame_callback, (const byte*)"\xb3\x07\x12" "set_frame_callback")
+QDEF(MP_QSTR_get_frame_info, (const byte*)"\x80\x74\x0e" "get_frame_info")
+QDEF(MP_QSTR_set_gray_lut, (const byte*)"\x27\x5a\x0c" "set_gray_lut")
+QDEF(MP_QSTR_set_gray_gain, (const byte*)"\xeb\x1a\x0d" "set_gray_gain")
+QDEF(MP_QSTR_set_lcd_direct, (const byte*)"\xc1\x3d\x0e" "set_lcd_direct")
+QDEF(MP_QSTR_set_motion_detect, (const byte*)"\x7e\x2a\x11" "set_motion_detect")
+QDEF(MP_QSTR_get_motion_mask, (const byte*)"\x19\x13\x0f" "get_motion_mask")
+QDEF(MP_QSTR_stats, (const byte*)"\xc4\xf0\x05" "stats")
+QDEF(MP_QSTR_frames, (const byte*)"\x0b\xd9\x06" "frames")
+QDEF(MP_QSTR_dropped, (const byte*)"\xfd\x23\x07" "dropped")
+QDEF(MP_QSTR_fifo_overflows, (const byte*)"\xb3\x22\x0e" "fifo_overflows")
+QDEF(MP_QSTR_irq_cycles_max, (const byte*)"\x78\x68\x0e" "irq_cycles_max")
+QDEF(MP_QSTR_irq_cycles_mean, (const byte*)"\xeb\x85\x0f" "irq_cycles_mean")
+QDEF(MP_QSTR_jpeg_ms, (const byte*)"\xbc\xbd\x07" "jpeg_ms")
+QDEF(MP_QSTR_wait_us, (const byte*)"\xb7\x11\x07" "wait_us")
+QDEF(MP_QSTR_wait_us_total, (const byte*)"\xea\xd5\x0d" "wait_us_total")
+QDEF(MP_QSTR_fragment_misses, (const byte*)"\x08\xbb\x0f" "fragment_misses")
+QDEF(MP_QSTR_set_usb_irq_in_snapshot, (const byte*)"\x62\xd9\x17" "set_usb_irq_in_snapshot")
+QDEF(MP_QSTR_set_soft_auto_exposure, (const byte*)"\x0a\x06\x16" "set_soft_auto_exposure")
+QDEF(MP_QSTR_target, (const byte*)"\xf4\x36\x06" "target")
+QDEF(MP_QSTR_max_exposure_us, (const byte*)"\x84\x5e\x0f" "max_exposure_us")
+QDEF(MP_QSTR_set_auto_exposure_roi, (const byte*)"\x70\x92\x15" "set_auto_exposure_roi")
+QDEF(MP_QSTR_weight, (const byte*)"\x85\x73\x06" "weight")
+QDEF(MP_QSTR_get_luma_histogram, (const byte*)"\x96\x37\x12" "get_luma_histogram")
+QDEF(MP_QSTR_fb_stats, (const byte*)"\x9f\x8a\x08" "fb_stats")
+QDEF(MP_QSTR_fb_reset_peak, (const byte*)"\x0b\xd9\x0d" "fb_reset_peak")
+QDEF(MP_QSTR_peak, (const byte*)"\xfa\xc0\x04" "peak")
+QDEF(MP_QSTR_allocs, (const byte*)"\x1b\x3e\x06" "allocs")
+QDEF(MP_QSTR_fails, (const byte*)"\x74\x99\x05" "fails")
+QDEF(MP_QSTR_avail, (const byte*)"\x36\x79\x05" "avail")
+QDEF(MP_QSTR_depths, (const byte*)"\x9b\x19\x06" "depths")
+QDEF(MP_QSTR_umm_stats, (const byte*)"\x2e\x48\x09" "umm_stats")
+QDEF(MP_QSTR_heap, (const byte*)"\xf9\x5d\x04" "heap")
+QDEF(MP_QSTR_used, (const byte*)"\x42\xf1\x04" "used")
+QDEF(MP_QSTR_slab_allocs, (const byte*)"\xb8\xbb\x0b" "slab_allocs")
+QDEF(MP_QSTR_free, (const byte*)"\xf1\x3a\x04" "free")
+QDEF(MP_QSTR_free_blocks, (const byte*)"\x54\xbd\x0b" "free_blocks")
+QDEF(MP_QSTR_largest_free, (const byte*)"\xf4\xb0\x0c" "largest_free")
+QDEF(MP_QSTR_slab_pages, (const byte*)"\x46\xf5\x0a" "slab_pages")
+QDEF(MP_QSTR_slab_used, (const byte*)"\x61\x9a\x09" "slab_used")
+QDEF(MP_QSTR_slab_in_use, (const byte*)"\x3d\xe1\x0b" "slab_in_use")
+QDEF(MP_QSTR_alloc_slot, (const byte*)"\xb3\x3f\x0a" "alloc_slot")
+QDEF(MP_QSTR_get_slot, (const byte*)"\x48\xe9\x08" "get_slot")
+QDEF(MP_QSTR_free_slots, (const byte*)"\x79\x1b\x0a" "free_slots")
+QDEF(MP_QSTR_into, (const byte*)"\xb9\xb5\x04" "into")
+QDEF(MP_QSTR_sweep, (const byte*)"\xd1\x69\x05" "sweep")
+QDEF(MP_QSTR_sweep_budget, (const byte*)"\xcb\x75\x0c" "sweep_budget")
+QDEF(MP_QSTR_alloc_stats, (const byte*)"\x76\xaf\x0b" "alloc_stats")
+QDEF(MP_QSTR_Pool, (const byte*)"\x99\x9e\x04" "Pool")
+QDEF(MP_QSTR_put, (const byte*)"\x74\x70\x03" "put")
+QDEF(MP_QSTR_pipeline, (const byte*)"\xc7\x38\x08" "pipeline")
+QDEF(MP_QSTR_quad_decimate, (const byte*)"\x0d\xe3\x0d" "quad_decimate")
+QDEF(MP_QSTR_refine_edges, (const byte*)"\xb9\xfc\x0c" "refine_edges")
+QDEF(MP_QSTR_track, (const byte*)"\xaa\x43\x05" "track")
+QDEF(MP_QSTR_locate, (const byte*)"\x35\xa2\x06" "locate")
+QDEF(MP_QSTR_max_codes, (const byte*)"\xf0\x99\x09" "max_codes")
+QDEF(MP_QSTR_get_statistics_rois, (const byte*)"\x11\x3f\x13" "get_statistics_rois")
+QDEF(MP_QSTR_integral, (const byte*)"\x6b\xb0\x08" "integral")
+QDEF(MP_QSTR_track_points, (const byte*)"\x0a\x95\x0c" "track_points")
+QDEF(MP_QSTR_points, (const byte*)"\x7a\x57\x06" "points")
+QDEF(MP_QSTR_window, (const byte*)"\x89\xc3\x06" "window")
+QDEF(MP_QSTR_levels, (const byte*)"\x40\xc6\x06" "levels")
+QDEF(MP_QSTR_max_iterations, (const byte*)"\xca\x75\x0e" "max_iterations")
+QDEF(MP_QSTR_max_points, (const byte*)"\x31\xf6\x0a" "max_points")
+QDEF(MP_QSTR_Recorder, (const byte*)"\x7f\xc5\x08" "Recorder")
+QDEF(MP_QSTR_buffer_size, (const byte*)"\xbf\xd5\x0b" "buffer_size")
+QDEF(MP_QSTR_file_size, (const byte*)"\x59\xa6\x09" "file_size")
+QDEF(MP_QSTR_segment_size, (const byte*)"\xfc\xfb\x0c" "segment_size")
+QDEF(MP_QSTR_set_delta_preview, (const byte*)"\x75\x80\x11" "set_delta_preview")
+QDEF(MP_QSTR_keyframe_interval, (const byte*)"\x8f\xf3\x11" "keyframe_interval")
+QDEF(MP_QSTR_max_bytes, (const byte*)"\xb7\x33\x09" "max_bytes")
+QDEF(MP_QSTR_VCP_plus_MSC_plus_VND, (const byte*)"\x61\x0f\x0b" "VCP+MSC+VND")
+QDEF(MP_QSTR_forward_batch, (const byte*)"\x1d\xce\x0d" "forward_batch")
+QDEF(MP_QSTR_store, (const byte*)"\x1a\x0a\x05" "store")
+QDEF(MP_QSTR_store_list, (const byte*)"\x27\x55\x0a" "store_list")
+QDEF(MP_QSTR_store_erase, (const byte*)"\xe5\x7d\x0b" "store_erase")
+QDEF(MP_QSTR_profile, (const byte*)"\x4e\xd2\x07" "profile")
+QDEF(MP_QSTR_Pipeline, (const byte*)"\xa7\x7d\x08" "Pipeline")
+QDEF(MP_QSTR_cascade, (const byte*)"\xd7\xc6\x07" "cascade")
+QDEF(MP_QSTR_gate, (const byte*)"\xf2\x91\x04" "gate")
+QDEF(MP_QSTR_variance, (const byte*)"\xc0\x55\x08" "variance")
+QDEF(MP_QSTR_motion, (const byte*)"\xdb\x2b\x06" "motion")
+QDEF(MP_QSTR_tf_cascade, (const byte*)"\xda\x00\x0a" "tf_cascade")
+QDEF(MP_QSTR_read_async, (const byte*)"\x4e\xb7\x0a" "read_async")
+QDEF(MP_QSTR_VfsLfs2, (const byte*)"\xed\x75\x07" "VfsLfs2")
+QDEF(MP_QSTR_readsize, (const byte*)"\xd2\xc9\x08" "readsize")
+QDEF(MP_QSTR_progsize, (const byte*)"\x0a\xd3\x08" "progsize")
+QDEF(MP_QSTR_lookahead, (const byte*)"\xeb\x20\x09" "lookahead")
+QDEF(MP_QSTR_create_contiguous, (const byte*)"\x3a\x80\x11" "create_contiguous")
+QDEF(MP_QSTR_ContiguousFile, (const byte*)"\x47\x2d\x0e" "ContiguousFile")
+QDEF(MP_QSTR_out, (const byte*)"\x2b\x5f\x03" "out")
+QDEF(MP_QSTR_as_array, (const byte*)"\x11\x75\x08" "as_array")
+QDEF(MP_QSTR_ops, (const byte*)"\xc9\x5e\x03" "ops")
+QDEF(MP_QSTR_clip, (const byte*)"\xd3\xd4\x04" "clip")
+QDEF(MP_QSTR_dot, (const byte*)"\x3a\x1f\x03" "dot")
+QDEF(MP_QSTR_convert, (const byte*)"\xf2\x9e\x07" "convert")
+QDEF(MP_QSTR_recv_into, (const byte*)"\xe4\x5d\x09" "recv_into")
+QDEF(MP_QSTR_Parser, (const byte*)"\x42\x30\x06" "Parser")
+QDEF(MP_QSTR_VALUE, (const byte*)"\xae\xea\x05" "VALUE")
+QDEF(MP_QSTR_START_ARRAY, (const byte*)"\x63\xdc\x0b" "START_ARRAY")
+QDEF(MP_QSTR_END_ARRAY, (const byte*)"\x6c\xeb\x09" "END_ARRAY")
+QDEF(MP_QSTR_START_OBJECT, (const byte*)"\x8f\x5b\x0c" "START_OBJECT")
+QDEF(MP_QSTR_END_OBJECT, (const byte*)"\xa0\x6c\x0a" "END_OBJECT")
+QDEF(MP_QSTR_CompIO, (const byte*)"\x12\x22\x06" "CompIO")
+QDEF(MP_QSTR_match_into, (const byte*)"\xb5\x16\x0a" "match_into")
+QDEF(MP_QSTR_search_into, (const byte*)"\xa8\x3c\x0b" "search_into")
+QDEF(MP_QSTR_bulkload, (const byte*)"\xb3\x30\x08" "bulkload")
+QDEF(MP_QSTR_Wheel, (const byte*)"\x96\xf6\x05" "Wheel")
+QDEF(MP_QSTR_stream_server, (const byte*)"\x63\xe5\x0d" "stream_server")
+QDEF(MP_QSTR_stream_stop, (const byte*)"\xbe\x3f\x0b" "stream_stop")
+QDEF(MP_QSTR_stream_clients, (const byte*)"\xec\xcf\x0e" "stream_clients")
+QDEF(MP_QSTR_clients, (const byte*)"\x6f\x7e\x07" "clients")
+QDEF(MP_QSTR_frame_size, (const byte*)"\x42\x69\x0a" "frame_size")
+QDEF(MP_QSTR_session, (const byte*)"\x7b\xc8\x07" "session")
+QDEF(MP_QSTR_sha1, (const byte*)"\x8e\xac\x04" "sha1")
+QDEF(MP_QSTR_ucryptolib, (const byte*)"\x34\xda\x0a" "ucryptolib")
+QDEF(MP_QSTR_aes, (const byte*)"\x32\x32\x03" "aes")
+QDEF(MP_QSTR_encrypt, (const byte*)"\xc2\x78\x07" "encrypt")
+QDEF(MP_QSTR_decrypt, (const byte*)"\xa8\x72\x07" "decrypt")
+QDEF(MP_QSTR_MODE_ECB, (const byte*)"\xbd\x1b\x08" "MODE_ECB")
+QDEF(MP_QSTR_MODE_CBC, (const byte*)"\x1b\x23\x08" "MODE_CBC")
+QDEF(MP_QSTR_MODE_CTR, (const byte*)"\x5c\x22\x08" "MODE_CTR")
+QDEF(MP_QSTR_LockType, (const byte*)"\x36\x20\x08" "LockType")
+QDEF(MP_QSTR__thread, (const byte*)"\xd4\x02\x07" "_thread")
+QDEF(MP_QSTR_acquire, (const byte*)"\x1d\xd3\x07" "acquire")
+QDEF(MP_QSTR_allocate_lock, (const byte*)"\xec\xed\x0d" "allocate_lock")
+QDEF(MP_QSTR_get_ident, (const byte*)"\xfe\xb1\x09" "get_ident")
+QDEF(MP_QSTR_lock, (const byte*)"\xae\x23\x04" "lock")
+QDEF(MP_QSTR_locked, (const byte*)"\x0f\xba\x06" "locked")
+QDEF(MP_QSTR_stack_size, (const byte*)"\x31\x3b\x0a" "stack_size")
+QDEF(MP_QSTR_start_new_thread, (const byte*)"\xd7\x25\x10" "start_new_thread")
+QDEF(MP_QSTR_submit, (const byte*)"\x11\x2f\x06" "submit")
+QDEF(MP_QSTR_Future, (const byte*)"\xe0\xdc\x06" "Future")
+QDEF(MP_QSTR_done, (const byte*)"\x45\x03\x04" "done")
+QDEF(MP_QSTR_result, (const byte*)"\x6c\xb9\x06" "result")
+QDEF(MP_QSTR_wb, (const byte*)"\x70\x70\x02" "wb")
+QDEF(MP_QSTR_uasyncio, (const byte*)"\x30\x1a\x08" "uasyncio")
+QDEF(MP_QSTR_IORead, (const byte*)"\x71\x93\x06" "IORead")
+QDEF(MP_QSTR_IOReadDone, (const byte*)"\xd1\xa5\x0a" "IOReadDone")
+QDEF(MP_QSTR_Capture, (const byte*)"\x81\x56\x07" "Capture")
+QDEF(MP_QSTR_rx_span, (const byte*)"\xbc\x5c\x07" "rx_span")
+QDEF(MP_QSTR_rx_consume, (const byte*)"\xfc\x36\x0a" "rx_consume")
+QDEF(MP_QSTR_sched_stats, (const byte*)"\xc2\xf3\x0b" "sched_stats")
+QDEF(MP_QSTR_Biquad, (const byte*)"\x6f\xd2\x06" "Biquad")
+QDEF(MP_QSTR_FIR, (const byte*)"\x18\xb3\x03" "FIR")
+QDEF(MP_QSTR_process, (const byte*)"\x4e\x38\x07" "process")
+QDEF(MP_QSTR_taps, (const byte*)"\x93\x9d\x04" "taps")
+QDEF(MP_QSTR_decimate, (const byte*)"\x13\x87\x08" "decimate")
+QDEF(MP_QSTR_read_timed_into, (const byte*)"\xba\x5f\x0f" "read_timed_into")
+QDEF(MP_QSTR_stream, (const byte*)"\x59\xd4\x06" "stream")
+QDEF(MP_QSTR_IOCTL_LEPTON_GET_FRAME, (const byte*)"\xa0\x00\x16" "IOCTL_LEPTON_GET_FRAME")
+QDEF(MP_QSTR_IOCTL_LEPTON_GET_STATS, (const byte*)"\xdc\x2c\x16" "IOCTL_LEPTON_GET_STATS")
+QDEF(MP_QSTR_dma, (const byte*)"\x6d\x1f\x03" "dma")
+QDEF(MP_QSTR_txdone, (const byte*)"\xc9\xff\x06" "txdone")
+QDEF(MP_QSTR_rx_packet, (const byte*)"\x78\x4c\x09" "rx_packet")
+QDEF(MP_QSTR_set_mode, (const byte*)"\x3b\x30\x08" "set_mode")
+QDEF(MP_QSTR_perf, (const byte*)"\xc4\xbe\x04" "perf")
+QDEF(MP_QSTR_deadline, (const byte*)"\x2f\x53\x08" "deadline")
+QDEF(MP_QSTR_overlay_stats, (const byte*)"\x61\xa8\x0d" "overlay_stats")
+QDEF(MP_QSTR_lab_tab, (const byte*)"\x82\x94\x07" "lab_tab")
+QDEF(MP_QSTR_haar, (const byte*)"\xff\x6e\x04" "haar")
+QDEF(MP_QSTR_flashpgm, (const byte*)"\xcf\xda\x08" "flashpgm")
+QDEF(MP_QSTR_boot_times, (const byte*)"\x2a\x30\x0a" "boot_times")
+QDEF(MP_QSTR_sdcard, (const byte*)"\xc6\x07\x06" "sdcard")
+QDEF(MP_QSTR_boot_py, (const byte*)"\x05\xdc\x07" "boot_py")
+QDEF(MP_QSTR_main_py, (const byte*)"\xd8\x5b\x07" "main_py")
+QDEF(MP_QSTR_first_frame, (const byte*)"\x3d\x54\x0b" "first_frame")
+QDEF(MP_QSTR_usb, (const byte*)"\x61\x64\x03" "usb")
+QDEF(MP_QSTR_run_us_total, (const byte*)"\x48\x4c\x0c" "run_us_total")
+QDEF(MP_QSTR_run_uj_total, (const byte*)"\x51\x2a\x0c" "run_uj_total")
+QDEF(MP_QSTR_wait_uj_total, (const byte*)"\x73\x22\x0d" "wait_uj_total")
+QDEF(MP_QSTR_uj_per_frame, (const byte*)"\x20\x2d\x0c" "uj_per_frame")
+QDEF(MP_QSTR_set_low_power, (const byte*)"\x0c\xc5\x0d" "set_low_power")
+QDEF(MP_QSTR_LP_OFF, (const byte*)"\x29\xe9\x06" "LP_OFF")
+QDEF(MP_QSTR_LP_WFI, (const byte*)"\x3e\x0b\x06" "LP_WFI")
+QDEF(MP_QSTR_LP_SCALE, (const byte*)"\xde\x55\x08" "LP_SCALE")
+QDEF(MP_QSTR_Tracker, (const byte*)"\x3d\x0c\x07" "Tracker")
+QDEF(MP_QSTR_max_age, (const byte*)"\x0d\x7e\x07" "max_age")
+QDEF(MP_QSTR_min_hits, (const byte*)"\x56\xb4\x08" "min_hits")
+QDEF(MP_QSTR_iou_threshold, (const byte*)"\x9e\xa6\x0d" "iou_threshold")
+QDEF(MP_QSTR_tracker, (const byte*)"\x1d\xca\x07" "tracker")
+QDEF(MP_QSTR_tracks, (const byte*)"\x99\xb8\x06" "tracks")
+QDEF(MP_QSTR_find_codes, (const byte*)"\x01\x37\x0a" "find_codes")
+QDEF(MP_QSTR_qrcodes, (const byte*)"\x58\x26\x07" "qrcodes")
+QDEF(MP_QSTR_apriltags, (const byte*)"\xc2\xa7\x09" "apriltags")
+QDEF(MP_QSTR_barcodes, (const byte*)"\x4a\xfe\x08" "barcodes")
+QDEF(MP_QSTR_append_db, (const byte*)"\x12\x05\x09" "append_db")
+QDEF(MP_QSTR_load_db, (const byte*)"\x1a\x53\x07" "load_db")
+QDEF(MP_QSTR_match_db, (const byte*)"\x8f\xdf\x08" "match_db")
+QDEF(MP_QSTR_kp_db, (const byte*)"\x67\xf9\x05" "kp_db")
+QDEF(MP_QSTR_FrameBuffer, (const byte*)"\xd8\xbe\x0b" "FrameBuffer")
+QDEF(MP_QSTR_FrameBuffer1, (const byte*)"\xe9\x99\x0c" "FrameBuffer1")
+QDEF(MP_QSTR_GS2_HMSB, (const byte*)"\x28\xc3\x08" "GS2_HMSB")
+QDEF(MP_QSTR_GS4_HMSB, (const byte*)"\x6e\x73\x08" "GS4_HMSB")
+QDEF(MP_QSTR_GS8, (const byte*)"\xa9\xc0\x03" "GS8")
+QDEF(MP_QSTR_MONO_HLSB, (const byte*)"\x4c\x98\x09" "MONO_HLSB")
+QDEF(MP_QSTR_MONO_HMSB, (const byte*)"\xcd\x83\x09" "MONO_HMSB")
+QDEF(MP_QSTR_MONO_VLSB, (const byte*)"\x12\xfc\x09" "MONO_VLSB")
+QDEF(MP_QSTR_MVLSB, (const byte*)"\x03\x14\x05" "MVLSB")
+QDEF(MP_QSTR_blit, (const byte*)"\xf6\x50\x04" "blit")
+QDEF(MP_QSTR_fill_rect, (const byte*)"\x35\xed\x09" "fill_rect")
+QDEF(MP_QSTR_framebuf, (const byte*)"\x69\x82\x08" "framebuf")
+QDEF(MP_QSTR_hline, (const byte*)"\x83\x3c\x05" "hline")
+QDEF(MP_QSTR_pixel, (const byte*)"\x4d\xf0\x05" "pixel")
+QDEF(MP_QSTR_scroll, (const byte*)"\x28\x5a\x06" "scroll")
+QDEF(MP_QSTR_text, (const byte*)"\x98\xaf\x04" "text")
+QDEF(MP_QSTR_vline, (const byte*)"\x1d\xf6\x05" "vline")
+QDEF(MP_QSTR_fast, (const byte*)"\x65\x15\x04" "fast")
+QDEF(MP_QSTR_read_port, (const byte*)"\x11\x14\x09" "read_port")
+QDEF(MP_QSTR_write_port, (const byte*)"\x9e\x1f\x0a" "write_port")
+QDEF(MP_QSTR_PinFast, (const byte*)"\xd2\x74\x07" "PinFast")
+QDEF(MP_QSTR_psr, (const byte*)"\xb4\x70\x03" "psr")
+QDEF(MP_QSTR_play, (const byte*)"\x21\xde\x04" "play")
+QDEF(MP_QSTR_trajectory, (const byte*)"\x5e\x92\x0a" "trajectory")
+QDEF(MP_QSTR_buf, (const byte*)"\x74\x49\x03" "buf")
+QDEF(MP_QSTR_capture, (const byte*)"\x61\xb6\x07" "capture")
+QDEF(MP_QSTR_position, (const byte*)"\x1c\x04\x08" "position")
+QDEF(MP_QSTR_velocity, (const byte*)"\x32\xdd\x08" "velocity")
+QDEF(MP_QSTR_state, (const byte*)"\xd2\xf0\x05" "state")
+QDEF(MP_QSTR_set_perf_profile, (const byte*)"\xcd\xa8\x10" "set_perf_profile")
+QDEF(MP_QSTR_get_perf_profile, (const byte*)"\x59\xdd\x10" "get_perf_profile")
+QDEF(MP_QSTR_getbuffer, (const byte*)"\x13\x39\x09" "getbuffer")
+QDEF(MP_QSTR_max_results, (const byte*)"\x74\xba\x0b" "max_results")
+QDEF(MP_QSTR_sort_by, (const byte*)"\x9b\xc1\x07" "sort_by")
+QDEF(MP_QSTR_lazy, (const byte*)"\x4b\x3e\x04" "lazy")
+QDEF(MP_QSTR_FONT_8X8, (const byte*)"\x71\xef\x08" "FONT_8X8")
+QDEF(MP_QSTR_FONT_IMLIB, (const byte*)"\x6a\xbf\x0a" "FONT_IMLIB")
+QDEF(MP_QSTR_hint, (const byte*)"\x5e\x4d\x04" "hint")
+QDEF(MP_QSTR_BILINEAR, (const byte*)"\xb3\xd1\x08" "BILINEAR")
 
-
+#ifdef QINDEX
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_b_or)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_is_kanji)
+QINDEX(MP_QSTR_get_fb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sleep_us)
+QINDEX(MP_QSTR_GPIO)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CDC_plus_MSC)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_acos)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCTRL_TOF)
+QINDEX(MP_QSTR_exec)
+QINDEX(MP_QSTR_IER_REIE)
+QINDEX(MP_QSTR_forward)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_modf)
+QINDEX(MP_QSTR_mode)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___pow__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LockType)
+QINDEX(MP_QSTR_TMR_CAPT)
+QINDEX(MP_QSTR_ADC_R6)
+QINDEX(MP_QSTR_ADC_R7)
+QINDEX(MP_QSTR_ADC_R4)
+QINDEX(MP_QSTR_ADC_R5)
+QINDEX(MP_QSTR_ADC_R2)
+QINDEX(MP_QSTR_ADC_R3)
+QINDEX(MP_QSTR_ADC_R0)
+QINDEX(MP_QSTR_ADC_R1)
+QINDEX(MP_QSTR_get_supported_frequencies)
+QINDEX(MP_QSTR_flow)
+QINDEX(MP_QSTR_image)
+QINDEX(MP_QSTR_single)
+QINDEX(MP_QSTR_writechar)
+QINDEX(MP_QSTR_PDF417)
+QINDEX(MP_QSTR_create_contiguous)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PALETTE_RAINBOW)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLX_CFXWM_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_draw_rectangle)
+QINDEX(MP_QSTR_IndentationError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FCTRL2_NOCOMB_BF)
+QINDEX(MP_QSTR_IOCTL_SET_TRIGGERED_MODE)
+QINDEX(MP_QSTR_af_list)
+QINDEX(MP_QSTR_ldr)
+QINDEX(MP_QSTR_len)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG0_ENABLE)
+QINDEX(MP_QSTR_CVAL1_CAPTVAL1_BF)
+QINDEX(MP_QSTR_Image)
+QINDEX(MP_QSTR_b_lq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_led)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___qualname__)
+QINDEX(MP_QSTR_find_rects)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_usocket)
+QINDEX(MP_QSTR_set_delta_preview)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_clear)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CODE93)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ADC_HS)
+QINDEX(MP_QSTR_LPSPI_RDR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SWCOUT_SM2OUT23)
+QINDEX(MP_QSTR_enable_irq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR22_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Switch)
+QINDEX(MP_QSTR_CAN1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EINPROGRESS)
+QINDEX(MP_QSTR_CAN2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_period)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_FRAME)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rsplit)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GS8)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_z_translation)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ticks_diff)
+QINDEX(MP_QSTR_LPI2C_VERID)
+QINDEX(MP_QSTR_MDER_RDDE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_illuminvar)
+QINDEX(MP_QSTR_invert)
+QINDEX(MP_QSTR_DATABAR_EXP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_USDHC1)
+QINDEX(MP_QSTR_USDHC2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_unsharp)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCTRL_IEF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SWCOUT_SM2OUT45)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_tf_cascade)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_INTEN_CA1IE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DTSRCSEL_SM3SEL45_BF)
+QINDEX(MP_QSTR_POLLERR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_WPA)
+QINDEX(MP_QSTR_put_pixel)
+QINDEX(MP_QSTR_FLEXIO1)
+QINDEX(MP_QSTR_FLEXIO2)
+QINDEX(MP_QSTR_buffer)
+QINDEX(MP_QSTR_theta_margin)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_KeyError)
+QINDEX(MP_QSTR_lookahead)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_shutdown)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Ellipsis)
+QINDEX(MP_QSTR_GPC)
+QINDEX(MP_QSTR_corners)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_put_ltext)
+QINDEX(MP_QSTR_peak)
+QINDEX(MP_QSTR_islower)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_degrees)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSCTRL_DBG_EN_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CCR_SCKDIV_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sha256)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SWCOUT_SM1OUT23)
+QINDEX(MP_QSTR_wait_for_sta)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_locals)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_slab_in_use)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_yuv_to_grayscale)
+QINDEX(MP_QSTR_ISBN10)
+QINDEX(MP_QSTR_ISBN13)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_millis)
+QINDEX(MP_QSTR_mask_circle)
+QINDEX(MP_QSTR_read_ta)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_flush)
+QINDEX(MP_QSTR_fault_debug)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR12_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_QQVGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_POLLIN)
+QINDEX(MP_QSTR_LPSPI_CCR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OverflowError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IER_FCIE)
+QINDEX(MP_QSTR_select)
+QINDEX(MP_QSTR_iter)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_atanh)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sort_by)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_add_frame)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lsr)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_search)
+QINDEX(MP_QSTR_register)
+QINDEX(MP_QSTR_vcmp)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_draw_string)
+QINDEX(MP_QSTR_qstr_info)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CV_CV2_BF)
+QINDEX(MP_QSTR_padding)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lsl)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ARTOOLKIT)
+QINDEX(MP_QSTR_issubset)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_UINT8)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLB_EDGCNTB_EN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CODE39)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SIER_SDIE)
+QINDEX(MP_QSTR_x_hist_bins)
+QINDEX(MP_QSTR_atan2)
+QINDEX(MP_QSTR_get_xy)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_major_axis_line)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_tanh)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FIR_SHIELD)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR1_NOSTALL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ifconfig)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ADC_GS)
+QINDEX(MP_QSTR_CAPTCOMPA_EDGCNTA_BF)
+QINDEX(MP_QSTR_MCCR1_CLKLO_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_time)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SWCOUT_SM1OUT45)
+QINDEX(MP_QSTR_set_windowing)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ADC_GC)
+QINDEX(MP_QSTR_CAPTCTRLX_EDGX0_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rgb_to_grayscale)
+QINDEX(MP_QSTR_tuple)
+QINDEX(MP_QSTR_rows)
+QINDEX(MP_QSTR_INTEN_CB0IE)
+QINDEX(MP_QSTR_tan)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLA_CFAWM_BF)
+QINDEX(MP_QSTR_CompIO)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GeneratorExit)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_erode)
+QINDEX(MP_QSTR_mosi)
+QINDEX(MP_QSTR_print_exception)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MSR_TDF)
+QINDEX(MP_QSTR_set_framesize)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_char_vflip)
+QINDEX(MP_QSTR_function)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_tick)
+QINDEX(MP_QSTR___mul__)
+QINDEX(MP_QSTR_SCTRL_TOFIE)
+QINDEX(MP_QSTR_TCTRL_OUT_TRIG_EN_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_locate)
+QINDEX(MP_QSTR_ROMC)
+QINDEX(MP_QSTR_EACCES)
+QINDEX(MP_QSTR_a_mode)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCCR0_CLKHI_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GPIO_EDGE_SEL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BFINT32)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFG_ADTRG)
+QINDEX(MP_QSTR_MODE_CTR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MODE_STA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_FSTS)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_movt)
+QINDEX(MP_QSTR_movw)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMAEN_CB1DE)
+QINDEX(MP_QSTR_ADC_CV)
+QINDEX(MP_QSTR_SCTRL_IPS)
+QINDEX(MP_QSTR_eci)
+QINDEX(MP_QSTR_FRAMESIZE_WQXGA2)
+QINDEX(MP_QSTR_framebuf)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fw_version)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_wait_uj_total)
+QINDEX(MP_QSTR_LPI2C_MFSR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ioctl)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_area_threshold)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BEE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_elapsed_millis)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_HS_COCO0)
+QINDEX(MP_QSTR_OPEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BFINT16)
+QINDEX(MP_QSTR_match)
+QINDEX(MP_QSTR_bound_method)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR18_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GPIO4)
+QINDEX(MP_QSTR_GPIO5)
+QINDEX(MP_QSTR_WHITE)
+QINDEX(MP_QSTR_sync)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GPIO1)
+QINDEX(MP_QSTR_GPIO2)
+QINDEX(MP_QSTR_GPIO3)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_KeyboardInterrupt)
+QINDEX(MP_QSTR_min)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fifo_overflows)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_stdev)
+QINDEX(MP_QSTR___gt__)
+QINDEX(MP_QSTR_utf_hyphen_8)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG4_DONE2)
+QINDEX(MP_QSTR_kptmatch)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_STDR_DATA_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___add__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mem_free)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF4_PWM1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__thread)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FRAMESIZE_QHD)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR6_BF)
+QINDEX(MP_QSTR_SCTRL_IEFIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FRCTRL_FRAC_PU)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ADC2)
+QINDEX(MP_QSTR_ADC1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_vsqrt)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_circles)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_merge_cb)
+QINDEX(MP_QSTR_CVAL0_CAPTVAL0_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_WEP)
+QINDEX(MP_QSTR_stdout)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_end)
+QINDEX(MP_QSTR_DMAEN_CA0DE)
+QINDEX(MP_QSTR_OUT)
+QINDEX(MP_QSTR_draw_edges)
+QINDEX(MP_QSTR_sleep_ms)
+QINDEX(MP_QSTR_quad_decimate)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_acosh)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_current_frequencies)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_endswith)
+QINDEX(MP_QSTR_MODE_CBC)
+QINDEX(MP_QSTR_CTRL2_FRCEN)
+QINDEX(MP_QSTR_uheapq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sendto)
+QINDEX(MP_QSTR_cpufreq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GS2_HMSB)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EAN13)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLB_EDGB0_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG7_DONE1)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG7_DONE0)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG4_ERR)
+QINDEX(MP_QSTR_perimeter)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_done)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PinBase)
+QINDEX(MP_QSTR_QSIF)
+QINDEX(MP_QSTR_theta)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF0_PWM2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_xy)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_viper)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EBADF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_yuv_to_lab)
+QINDEX(MP_QSTR_setdefault)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_exposure_us)
+QINDEX(MP_QSTR_space_sigma)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_log2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_bytearray)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ure)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_window)
+QINDEX(MP_QSTR_midpoint_pool)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SIER_AVIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_is_binary)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_erf)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_generator)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_listdir)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_isnan)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_INTEN_CX1IE)
+QINDEX(MP_QSTR_save)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_track)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCTRL_RUN_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lock)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLA_ONESHOTA)
+QINDEX(MP_QSTR_max)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MIER_TDIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_toggle)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_map)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CORNER_AGAST)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG1_ENABLE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___path__)
+QINDEX(MP_QSTR_set_auto_gain)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DISMAP_DIS1A_BF)
+QINDEX(MP_QSTR_MONO_HMSB)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_fill_color)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_CTRL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MemoryError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__lt_stdin_gt_)
+QINDEX(MP_QSTR_mod)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_l_mean)
+QINDEX(MP_QSTR_AF1_PWM4)
+QINDEX(MP_QSTR_zoom)
+QINDEX(MP_QSTR_AF1_PWM2)
+QINDEX(MP_QSTR_mov)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF1_PWM1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_dropped)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lens_corr)
+QINDEX(MP_QSTR_UPCA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_UPCE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL2_PWM45_INIT)
+QINDEX(MP_QSTR_LPI2C1)
+QINDEX(MP_QSTR_to_rainbow)
+QINDEX(MP_QSTR_LPI2C3)
+QINDEX(MP_QSTR_LPI2C2)
+QINDEX(MP_QSTR_gaussian)
+QINDEX(MP_QSTR_LPI2C4)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_INTEN_REIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_position)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mem)
+QINDEX(MP_QSTR_sqrt)
+QINDEX(MP_QSTR_stdin)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_gaussian_blur)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_float)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_loop)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG6_ERR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG0_ERR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_corner_detector)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___aenter__)
+QINDEX(MP_QSTR_PWM_FCTRL2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_PRE_DIVIDER_BF)
+QINDEX(MP_QSTR_alpha)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_MCTRL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IER_TDIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_floating_threshold)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_usb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_load)
+QINDEX(MP_QSTR_LPI2C_MFCR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_802_1X)
+QINDEX(MP_QSTR_memoryview)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_difference)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_version_minor)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mcu)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_lbp)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCR_FILTEN)
+QINDEX(MP_QSTR_bind)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GC_ACFGT)
+QINDEX(MP_QSTR_write_readinto)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCCR0_DATAVD_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SASR_RADDR_BF)
+QINDEX(MP_QSTR_bins)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Signal)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_template_roi)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VAL3_VAL3_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FCR_RXWATER_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCR_FILTDZ)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_throw)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sharpen)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_divmod)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSCTRL_ALT_LOAD)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_exp)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR0_HREN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SSR_FEF)
+QINDEX(MP_QSTR_digest)
+QINDEX(MP_QSTR_DOUBLE_BUFFER)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AIPSTZ1)
+QINDEX(MP_QSTR_AIPSTZ2)
+QINDEX(MP_QSTR_AIPSTZ3)
+QINDEX(MP_QSTR_AIPSTZ4)
+QINDEX(MP_QSTR_ICR1_ICR13_BF)
+QINDEX(MP_QSTR_alloc_extra_fb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_minor_axis_line)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DR_DR_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_STS)
+QINDEX(MP_QSTR_fmod)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR23_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FLEXSPI)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IMR_IMR_BF)
+QINDEX(MP_QSTR_PARAM_RXFIFO_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_exposure_us)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_low_power)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LONG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLX_ONESHOTX)
+QINDEX(MP_QSTR_l_uq)
+QINDEX(MP_QSTR_append_db)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ticks_cpu)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_size)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MASK_MASKB_BF)
+QINDEX(MP_QSTR_FRCTRL_FRAC23_EN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___class__)
+QINDEX(MP_QSTR___bool__)
+QINDEX(MP_QSTR_clock)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_jpeg_encode_for_ide)
+QINDEX(MP_QSTR_MODE_BSP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_readfrom_mem)
+QINDEX(MP_QSTR_OV2640)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_columns)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_parity)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG2_ERR)
+QINDEX(MP_QSTR_set_framerate)
+QINDEX(MP_QSTR_replace)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_payload)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_asin)
+QINDEX(MP_QSTR_USBPHY1)
+QINDEX(MP_QSTR_USBPHY2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_draw_line)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_OCTRL)
+QINDEX(MP_QSTR_elongation)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ENOENT)
+QINDEX(MP_QSTR___init__)
+QINDEX(MP_QSTR_mapper)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_stream_server)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fw_dump)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_imagewriter)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_POLLOUT)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_connected)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Recorder)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EHOSTUNREACH)
+QINDEX(MP_QSTR_partition)
+QINDEX(MP_QSTR_CTRL_SOFTRST)
+QINDEX(MP_QSTR_mrs)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_a_bins)
+QINDEX(MP_QSTR_SSR_SARF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_hmirror)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MRDR_DATA_BF)
+QINDEX(MP_QSTR_xwin_min)
+QINDEX(MP_QSTR_isenabled)
+QINDEX(MP_QSTR_collect)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OSError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ENOMEM)
+QINDEX(MP_QSTR_disconnect)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_yuv_to_binary)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mpy)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SVGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lab_to_yuv)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOReadDone)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_USB_ANALOG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___write_reg)
+QINDEX(MP_QSTR_PWM_CVAL0)
+QINDEX(MP_QSTR_PWM_CVAL1)
+QINDEX(MP_QSTR_PWM_CVAL2)
+QINDEX(MP_QSTR_PWM_CVAL3)
+QINDEX(MP_QSTR_PWM_CVAL4)
+QINDEX(MP_QSTR_PWM_CVAL5)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_MEASUREMENT_RANGE)
+QINDEX(MP_QSTR_adaptive)
+QINDEX(MP_QSTR_ViperTypeError)
+QINDEX(MP_QSTR_mean_pool)
+QINDEX(MP_QSTR_soft_reset)
+QINDEX(MP_QSTR_start_new_thread)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_round)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_irq_cycles_mean)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OCTRL_PWMBFS_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SOFT_RESET)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BFUINT32)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_soft_auto_exposure)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_jpeg_encoded_for_ide)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_l_bins)
+QINDEX(MP_QSTR_LOAD_LOAD_BF)
+QINDEX(MP_QSTR_TAG25H9)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_INIT)
+QINDEX(MP_QSTR_SIER_TDIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TAG25H7)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mul)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VERID_MAJOR_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_binary_to_lab)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BFUINT16)
+QINDEX(MP_QSTR_levels)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_brightness)
+QINDEX(MP_QSTR_Clock)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_print)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_qrcodes)
+QINDEX(MP_QSTR_file_size)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_framebuffers)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FCTRL_FIE_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ULONGLONG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMAEN_CX0DE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TMR_CNTR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_floor)
+QINDEX(MP_QSTR_localtime)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CVAL2CYC_CVAL2CYC_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR0_CIRFIFO)
+QINDEX(MP_QSTR_IOCTL_LEPTON_RUN_COMMAND)
+QINDEX(MP_QSTR_EIO)
+QINDEX(MP_QSTR_xwin_max)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCTRL_LDOK_BF)
+QINDEX(MP_QSTR_uarray)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ADC_ETC)
+QINDEX(MP_QSTR_UXGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_area)
+QINDEX(MP_QSTR_RSR_SOF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_RED)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_eval)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GPIO_IMR)
+QINDEX(MP_QSTR_iou_threshold)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLX_CX0CNT_BF)
+QINDEX(MP_QSTR_normalized)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___ge__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_IER)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uio)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sinh)
+QINDEX(MP_QSTR_CTRL_PRSC_BF)
+QINDEX(MP_QSTR_VERID_MINOR_BF)
+QINDEX(MP_QSTR_bias)
+QINDEX(MP_QSTR_draw_image)
+QINDEX(MP_QSTR_CR_RST)
+QINDEX(MP_QSTR_FCTRL_FLVL_BF)
+QINDEX(MP_QSTR_LPSPI_VERID)
+QINDEX(MP_QSTR_CVAL4CYC_CVAL4CYC_BF)
+QINDEX(MP_QSTR_args)
+QINDEX(MP_QSTR_l_median)
+QINDEX(MP_QSTR_find_lines)
+QINDEX(MP_QSTR_r_max)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_argv)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FSTS_FHALF_BF)
+QINDEX(MP_QSTR_cascade)
+QINDEX(MP_QSTR_color)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_D14_SDA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMAEN_FAND)
+QINDEX(MP_QSTR_modify)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Cascade)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FFILT_FILT_PER_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MFCR_RXWATER_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_pcolor)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFG_ADICLK_BF)
+QINDEX(MP_QSTR_CR_RTF)
+QINDEX(MP_QSTR_SR_RDF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_kp_desc)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rgb_to_yuv)
+QINDEX(MP_QSTR_thickness)
+QINDEX(MP_QSTR_decimate)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EDGE_SIMPLE)
+QINDEX(MP_QSTR_FLOAT64)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CVAL3_CAPTVAL3_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMR0_MATCH0_BF)
+QINDEX(MP_QSTR_PWM_CNT)
+QINDEX(MP_QSTR_b_nor)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_close)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DISMAP_DIS0X_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCFGR1_ADDRCFG_BF)
+QINDEX(MP_QSTR_GPIO_ISR)
+QINDEX(MP_QSTR_binary_to_grayscale)
+QINDEX(MP_QSTR_FIR_MLX90620)
+QINDEX(MP_QSTR_FIR_MLX90621)
+QINDEX(MP_QSTR_label)
+QINDEX(MP_QSTR_rmdir)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CR_RRF)
+QINDEX(MP_QSTR_CAPTCOMPA_EDGCMPA_BF)
+QINDEX(MP_QSTR_AF7_LPSPI3)
+QINDEX(MP_QSTR_CAPTCOMPB_EDGCMPB_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_QCIF)
+QINDEX(MP_QSTR_length)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_arch)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SR_REF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SAI2)
+QINDEX(MP_QSTR_SAI3)
+QINDEX(MP_QSTR_b_bins)
+QINDEX(MP_QSTR_SAI1)
+QINDEX(MP_QSTR_laplacian)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rgb_gain_db)
+QINDEX(MP_QSTR_pixels_threshold)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_percentile)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_auto_whitebal)
+QINDEX(MP_QSTR_HOLD_HOLD_BF)
+QINDEX(MP_QSTR_OFS_OFS_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLA_CA0CNT_BF)
+QINDEX(MP_QSTR_FIR_MLX90640)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_opt_level)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_resolution)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ValueError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_vflip)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG4_REQ)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG7_REQ)
+QINDEX(MP_QSTR_PWM_CVAL0CYC)
+QINDEX(MP_QSTR_IPPROTO_ICMP)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG0_REQ)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG3_REQ)
+QINDEX(MP_QSTR_INTEN_CX0IE)
+QINDEX(MP_QSTR_r_min)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG3_DONE2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_frame_callback)
+QINDEX(MP_QSTR_FLOAT32)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ZeroDivisionError)
+QINDEX(MP_QSTR_ENODEV)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_apriltags)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG2_DONE0)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG2_DONE1)
+QINDEX(MP_QSTR_ICR1_ICR5_BF)
+QINDEX(MP_QSTR_sdcard)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_vldr)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_symmetric_difference)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOCTL_LEPTON_SET_ATTRIBUTE)
+QINDEX(MP_QSTR_heappop)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_apriltags)
+QINDEX(MP_QSTR_MSR_DMF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_isupper)
+QINDEX(MP_QSTR_gain_db)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ENOBUFS)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_binary_to_rgb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_cpsid)
+QINDEX(MP_QSTR_cpsie)
+QINDEX(MP_QSTR_sleep)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uos)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SIER_RSIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ADCAll)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___lshift__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_b_value)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_NoneType)
+QINDEX(MP_QSTR_mem8)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DTSRCSEL_SM0SEL45_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_line_segments)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG2_ENABLE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCFGR0_HREN)
+QINDEX(MP_QSTR_find_eye)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_l_lq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_umm_stats)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_XTALOSC24M)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DISMAP_DIS1X_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_setsockopt)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_route)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CVAL0CYC_CVAL0CYC_BF)
+QINDEX(MP_QSTR_next)
+QINDEX(MP_QSTR___build_class__)
+QINDEX(MP_QSTR_ticks)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCR_TXMSK)
+QINDEX(MP_QSTR_CAPTCTRLB_INP_SELB)
+QINDEX(MP_QSTR_ustruct)
+QINDEX(MP_QSTR_bits)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSCTRL_TCF2EN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_execfile)
+QINDEX(MP_QSTR_FCTRL_FSAFE_BF)
+QINDEX(MP_QSTR_clip_limit)
+QINDEX(MP_QSTR_TAG36H10)
+QINDEX(MP_QSTR_TAG36H11)
+QINDEX(MP_QSTR___lt__)
+QINDEX(MP_QSTR_OPEN_DRAIN)
+QINDEX(MP_QSTR_network)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_overlay_stats)
+QINDEX(MP_QSTR_MFSR_RXCOUNT_BF)
+QINDEX(MP_QSTR_extend)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ecc_level)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CR_MEN)
+QINDEX(MP_QSTR_HaarCascade)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_extent)
+QINDEX(MP_QSTR_startswith)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TMR_LOAD)
+QINDEX(MP_QSTR_irq_cycles_max)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_x_scale)
+QINDEX(MP_QSTR_index)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_RADIOMETRY)
+QINDEX(MP_QSTR_session)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_have_cdc)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCCR1_DATAVD_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_compress_for_ide)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_HC_AIEN)
+QINDEX(MP_QSTR_security)
+QINDEX(MP_QSTR_memaddr)
+QINDEX(MP_QSTR_l_mode)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_write)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR0_HRSEL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TEMPMON)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCFGR1_ACKSTALL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_micros)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR10_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_gain_db)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SLEW_FAST)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ubinascii)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_perf_profile)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_setattr)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EWM)
+QINDEX(MP_QSTR_delattr)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_bin)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCTRL_EEOF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IPPROTO_RAW)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___hash__)
+QINDEX(MP_QSTR_isdisjoint)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_DISMAP0)
+QINDEX(MP_QSTR_PWM_DISMAP1)
+QINDEX(MP_QSTR_min_corners)
+QINDEX(MP_QSTR_readonly)
+QINDEX(MP_QSTR_FSTS_FFULL_BF)
+QINDEX(MP_QSTR_unique_id)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_pack_into)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___sub__)
+QINDEX(MP_QSTR_CTRL_SPLIT)
+QINDEX(MP_QSTR_D1_TX)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LP_OFF)
+QINDEX(MP_QSTR_MCCR1_CLKHI_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_MIER)
+QINDEX(MP_QSTR_dict_view)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_ONCE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CMPLD2_COMPARATOR_LOAD_2_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SNVS)
+QINDEX(MP_QSTR_lab_to_binary)
+QINDEX(MP_QSTR_is_alphanumeric)
+QINDEX(MP_QSTR_rtc)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_frame_size)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DATABAR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_vcvt_f32_s32)
+QINDEX(MP_QSTR_get_slot)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_INTEN_RIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_window_close)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_connected_sta)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_draw_circle)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ImageWriter)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_buf)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ywin_min)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_to_rgb565)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_accept)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_scale_factor)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_names)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR1_PINCFG_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GC_ADACKEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_globals)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_B128X128)
+QINDEX(MP_QSTR_vmrs)
+QINDEX(MP_QSTR_read_buf_len)
+QINDEX(MP_QSTR_y_spacing)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLX_CX1CNT_BF)
+QINDEX(MP_QSTR_SCFGR1_TXDSTALL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uerrno)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_y_stride)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_ATTRIBUTE)
+QINDEX(MP_QSTR_mean)
+QINDEX(MP_QSTR_property)
+QINDEX(MP_QSTR_SCTRL_OEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_enclosed_ellipse)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PARAM_MRXFIFO_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR20_BF)
+QINDEX(MP_QSTR_sweep)
+QINDEX(MP_QSTR_readsize)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_window_scroll)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCFGR1_GCEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Exception)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_compile)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_transpose)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLA_EDGA1_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LookupError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VAL0_VAL0_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MTDR_CMD_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_contrast)
+QINDEX(MP_QSTR_mem16)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_z_rotation)
+QINDEX(MP_QSTR_lbp_desc)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_store)
+QINDEX(MP_QSTR_USB_VCP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GPIO_DR)
+QINDEX(MP_QSTR_tracker)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_reverse)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_intersection)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_family)
+QINDEX(MP_QSTR__lt_genexpr_gt_)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_r_margin)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_l_min)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mem32)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_encode)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_threshold_cb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_run_uj_total)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MSC)
+QINDEX(MP_QSTR_MSB)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_B64X64)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_remove)
+QINDEX(MP_QSTR_PWM_MASK)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ywin_max)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCFGR3_PINLOW_BF)
+QINDEX(MP_QSTR___iadd__)
+QINDEX(MP_QSTR_OCTRL_PWMB_IN)
+QINDEX(MP_QSTR_version_info)
+QINDEX(MP_QSTR_SASR_ANV)
+QINDEX(MP_QSTR_ilistdir)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_closure)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_POLLHUP)
+QINDEX(MP_QSTR_alloc_emergency_exception_buf)
+QINDEX(MP_QSTR_timeout_char)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_motion_detect)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_little)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DISMAP_DIS0A_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF2_LPI2C3)
+QINDEX(MP_QSTR_set_title)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fb_stats)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCTRL_CAPTURE_MODE_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_DMR1)
+QINDEX(MP_QSTR_LPSPI_DMR0)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_QQCIF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_b_max)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VALUE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ptr32)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL2_FORCE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CVAL2_CAPTVAL2_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL2_PWM23_INIT)
+QINDEX(MP_QSTR_FSR_RXCOUNT_BF)
+QINDEX(MP_QSTR_set_special_effect)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR28_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCR_PRESCALE_BF)
+QINDEX(MP_QSTR_settimeout)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCFGR2_FILTSCL_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_vmov)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_midpoint_pooled)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_a_max)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ptr16)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_B64X32)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG5_ERR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG7_ERR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ssid)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_EXT0_TRIG_PRIORITY_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___repr__)
+QINDEX(MP_QSTR_Mjpeg)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_bkg_color)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CODABAR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_l_max)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR4_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ECONNABORTED)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IPPROTO_IPV6)
+QINDEX(MP_QSTR_FIR_AMG8833)
+QINDEX(MP_QSTR_IPPROTO_IPV4)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_put_text)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_y_scale)
+QINDEX(MP_QSTR_IER_WCIE)
+QINDEX(MP_QSTR_a2b_base64)
+QINDEX(MP_QSTR_LP_WFI)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCR_SEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG1_DONE1)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG1_DONE0)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_start_ap)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___aiter__)
+QINDEX(MP_QSTR_get_count)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mem_alloc)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_filter_outliers)
+QINDEX(MP_QSTR_skip_frames)
+QINDEX(MP_QSTR_MCFGR1_MATCFG_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR1_MATCFG_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_machine)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_keepends)
+QINDEX(MP_QSTR_nodename)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_END_ARRAY)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_max_theta_diff)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_reg)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_WQXGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG3_ENABLE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_native)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_selective_search)
+QINDEX(MP_QSTR_CAPTCTRLX_INP_SELX)
+QINDEX(MP_QSTR_heappush)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_to_grayscale)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_font)
+QINDEX(MP_QSTR_mktime)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rng)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_INIT_INIT_BF)
+QINDEX(MP_QSTR_PWM_FFILT)
+QINDEX(MP_QSTR_TCTRL_TRGFRQ)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_isfinite)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TMR_COMP1)
+QINDEX(MP_QSTR_TMR_COMP2)
+QINDEX(MP_QSTR_roi)
+QINDEX(MP_QSTR_b_min)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_CR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_REFRESH)
+QINDEX(MP_QSTR_setinterrupt)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lower)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_families)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_b_mode)
+QINDEX(MP_QSTR_get_rgb_gain_db)
+QINDEX(MP_QSTR_PWRON_RESET)
+QINDEX(MP_QSTR_motion)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FRACVAL5_FRACVAL5_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rindex)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mjpeg)
+QINDEX(MP_QSTR_a_min)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CORNER_FAST)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_HID)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG1_ERR)
+QINDEX(MP_QSTR_polar)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG3_ERR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SAMR_ADDR0_BF)
+QINDEX(MP_QSTR_border_width)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_HIZ)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___xor__)
+QINDEX(MP_QSTR_EAGAIN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_QQQVGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR1_MASTER)
+QINDEX(MP_QSTR_y_hist_bins_max)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_high)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ArithmeticError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ECONNREFUSED)
+QINDEX(MP_QSTR_AF7_GPT2)
+QINDEX(MP_QSTR_cmp)
+QINDEX(MP_QSTR_Tracker)
+QINDEX(MP_QSTR_CAPTCTRLA_EDGCNTA_EN)
+QINDEX(MP_QSTR_SSR_SBF)
+QINDEX(MP_QSTR_PWM_CVAL1CYC)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_INTEN)
+QINDEX(MP_QSTR_run_us_total)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCOMPX_EDGCMPX_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_clz)
+QINDEX(MP_QSTR_wlan)
+QINDEX(MP_QSTR_delay)
+QINDEX(MP_QSTR_sensor)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_x_rotation)
+QINDEX(MP_QSTR_ldrh)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_put_newline)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_SCR)
+QINDEX(MP_QSTR_ldrb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_socket)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_RGB565)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCTRL_OPS)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_getvalue)
+QINDEX(MP_QSTR_rx_packet)
+QINDEX(MP_QSTR_cos)
+QINDEX(MP_QSTR_LPSPI_FCR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MSR_ALF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__lt_lambda_gt_)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMAEN_CAPTDE_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCR_DBGEN)
+QINDEX(MP_QSTR_PWM_TCTRL)
+QINDEX(MP_QSTR_sha1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_refresh)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IER_RDIE)
+QINDEX(MP_QSTR_x_stride)
+QINDEX(MP_QSTR_END_OBJECT)
+QINDEX(MP_QSTR_SCFGR1_IGNACK)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_AUX_TEMPERATURE)
+QINDEX(MP_QSTR_rotation_corr)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_palettes)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_heap_lock)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG2_DONE2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_DBLEN)
+QINDEX(MP_QSTR_PTR)
+QINDEX(MP_QSTR_classmethod)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MSC_plus_HID)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLX_EDGCNTX_EN)
+QINDEX(MP_QSTR_popitem)
+QINDEX(MP_QSTR_random)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_qrcode)
+QINDEX(MP_QSTR_top_hat)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lgamma)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rho)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_font_trasparency)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FSTS_FFLAG_BF)
+QINDEX(MP_QSTR_get_backlight)
+QINDEX(MP_QSTR_readID)
+QINDEX(MP_QSTR_chr)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_STATS)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ENET)
+QINDEX(MP_QSTR_schedule)
+QINDEX(MP_QSTR_GDIR_GDIR_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_zip)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_y_rotation)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ENC4)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ENC1)
+QINDEX(MP_QSTR_issuperset)
+QINDEX(MP_QSTR_ENC3)
+QINDEX(MP_QSTR_ENC2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_unpack_from)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR11_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_implementation)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMA_IEFDE)
+QINDEX(MP_QSTR_TMR_DMA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_pad_expert_cfg)
+QINDEX(MP_QSTR_DMA0)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uj_per_frame)
+QINDEX(MP_QSTR_sub)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sum)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR21_BF)
+QINDEX(MP_QSTR_ICR2_ICR31_BF)
+QINDEX(MP_QSTR_key)
+QINDEX(MP_QSTR_yuv_to_rgb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fill_rect)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_polarity)
+QINDEX(MP_QSTR_set_pen_color)
+QINDEX(MP_QSTR_asm_thumb)
+QINDEX(MP_QSTR_D0_RX)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ContiguousFile)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EDGE_SEL_GPIO_EDGE_SEL_BF)
+QINDEX(MP_QSTR_str)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EEXIST)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_heap_unlock)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLA_EDGA0_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_INTEN_CA0IE)
+QINDEX(MP_QSTR_mono_space)
+QINDEX(MP_QSTR_hint)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCR_BYSW)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF4_LPSPI1)
+QINDEX(MP_QSTR_version_patch)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFG_ADSTS_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SSR_SDF)
+QINDEX(MP_QSTR_ULONG)
+QINDEX(MP_QSTR_AF3_LPI2C1)
+QINDEX(MP_QSTR_solidity)
+QINDEX(MP_QSTR_dumps)
+QINDEX(MP_QSTR_AF1_GPT1)
+QINDEX(MP_QSTR_writeto_mem)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BLACK)
+QINDEX(MP_QSTR_IndexError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_object)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__slash_flash_slash_lib)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DBG_RXD)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OCTRL_PWMAFS_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_deinit)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_count)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mount)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_SR)
+QINDEX(MP_QSTR_OCTRL_POLA)
+QINDEX(MP_QSTR_OCTRL_POLB)
+QINDEX(MP_QSTR_TextIOWrapper)
+QINDEX(MP_QSTR_heapify)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL2_RELOAD_SEL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OCTRL_POLX)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_NameError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_usb_mode)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOCTL_LEPTON_SET_MEASUREMENT_MODE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_cpu)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_statistics)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__lt_dictcomp_gt_)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_spi)
+QINDEX(MP_QSTR___str__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TDR_DATA_BF)
+QINDEX(MP_QSTR_set_colorbar)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_power)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOMUXC_SNVS)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_allocate_lock)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SRDR_RXEMPTY)
+QINDEX(MP_QSTR_MIER_RDIE)
+QINDEX(MP_QSTR_put_char)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OUTEN_PWMA_EN_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_NATIVE)
+QINDEX(MP_QSTR_STAR_TXNACK)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_HYS)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IPPROTO_IP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SR_MBF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__slash_flash)
+QINDEX(MP_QSTR_scan)
+QINDEX(MP_QSTR_string_rotation)
+QINDEX(MP_QSTR_forward_batch)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_af)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMAEN_CB0DE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR29_BF)
+QINDEX(MP_QSTR_readfrom_mem_into)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCFGR2_CLKHOLD_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PXP)
+QINDEX(MP_QSTR_JPEG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_thresholds)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_SSR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CV_CV1_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uselect)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fy)
+QINDEX(MP_QSTR_fx)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VAL5_VAL5_BF)
+QINDEX(MP_QSTR_gc)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MSR_SDF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCOMPX_EDGCNTX_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_FSR)
+QINDEX(MP_QSTR_LPI2C_SCFGR1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_SCFGR2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_OUTEN)
+QINDEX(MP_QSTR_a1)
+QINDEX(MP_QSTR_a2)
+QINDEX(MP_QSTR_a3)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCFGR2_FILTSCL_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mean_pooled)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_path)
+QINDEX(MP_QSTR_DMR1_MATCH1_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_draw_ta)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_l_value)
+QINDEX(MP_QSTR_ticks_add)
+QINDEX(MP_QSTR_get_font_height)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_reversed)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_urandom)
+QINDEX(MP_QSTR_WDOG2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MASK_UPDATE_MASK_BF)
+QINDEX(MP_QSTR_WDOG1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_QQSIF)
+QINDEX(MP_QSTR_cyf)
+QINDEX(MP_QSTR_SIER_SARIE)
+QINDEX(MP_QSTR_sys)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG4_DONE0)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG4_DONE1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_string_vflip)
+QINDEX(MP_QSTR_bl)
+QINDEX(MP_QSTR_listen)
+QINDEX(MP_QSTR_TAG16H5)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MSR_FEF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_cxf)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_bx)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCCR0_SETHOLD_BF)
+QINDEX(MP_QSTR_FRCTRL_FRAC45_EN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_MCTRL2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rbit)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_draw_ellipse)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_cx)
+QINDEX(MP_QSTR_cy)
+QINDEX(MP_QSTR_vneg)
+QINDEX(MP_QSTR_haar)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR3_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FRCTRL_TEST)
+QINDEX(MP_QSTR_submit)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sep)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_udelay)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set)
+QINDEX(MP_QSTR_id)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_asinh)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_b2a_base64)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_string_hmirror)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ldexp)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_nn)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_PCS_BF)
+QINDEX(MP_QSTR_MCFGR0_CIRFIFO)
+QINDEX(MP_QSTR_binary)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FLEXRAM)
+QINDEX(MP_QSTR_bilateral)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___traceback__)
+QINDEX(MP_QSTR_load_descriptor)
+QINDEX(MP_QSTR_PGC)
+QINDEX(MP_QSTR_movwt)
+QINDEX(MP_QSTR_sda)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCTRL_INPUT)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PA4)
+QINDEX(MP_QSTR_CDC)
+QINDEX(MP_QSTR_staticmethod)
+QINDEX(MP_QSTR_PA5)
+QINDEX(MP_QSTR_on)
+QINDEX(MP_QSTR_PA1)
+QINDEX(MP_QSTR_PA2)
+QINDEX(MP_QSTR_PA3)
+QINDEX(MP_QSTR_PA6)
+QINDEX(MP_QSTR_PA7)
+QINDEX(MP_QSTR_VCP_plus_MSC_plus_VND)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PA8)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FONT_8X8)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_COMP2_COMPARISON_2_BF)
+QINDEX(MP_QSTR_alloc_stats)
+QINDEX(MP_QSTR_or)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___dir__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GPIO_ICR2)
+QINDEX(MP_QSTR_GPIO_ICR1)
+QINDEX(MP_QSTR_PB4)
+QINDEX(MP_QSTR_PB3)
+QINDEX(MP_QSTR_start)
+QINDEX(MP_QSTR_PB1)
+QINDEX(MP_QSTR_SIER_AM0IE)
+QINDEX(MP_QSTR___truediv__)
+QINDEX(MP_QSTR_tv)
+QINDEX(MP_QSTR_PB2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PMU)
+QINDEX(MP_QSTR_rgb_channel)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SyntaxError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_board_type)
+QINDEX(MP_QSTR_CFG_ADIV_BF)
+QINDEX(MP_QSTR_text)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EISDIR)
+QINDEX(MP_QSTR_SDCard)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_y_overlap)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG1_DONE2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_histogram)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BFUINT8)
+QINDEX(MP_QSTR_write_image)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_qrcodes)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___aexit__)
+QINDEX(MP_QSTR_CTRL2_INIT_SEL_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CCM)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_reset_cause)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_MRDR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_hid)
+QINDEX(MP_QSTR_LCDIF)
+QINDEX(MP_QSTR_OUTEN_PWMX_EN_BF)
+QINDEX(MP_QSTR_draw_ir)
+QINDEX(MP_QSTR_bootloader)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_dump)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_release)
+QINDEX(MP_QSTR_stream_clients)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SWCOUT_SM3OUT23)
+QINDEX(MP_QSTR_threshold)
+QINDEX(MP_QSTR_b_median)
+QINDEX(MP_QSTR_TMR_ENBL)
+QINDEX(MP_QSTR_version_string)
+QINDEX(MP_QSTR_rotation)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_scl)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sck)
+QINDEX(MP_QSTR_unlink)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_gamma)
+QINDEX(MP_QSTR___bases__)
+QINDEX(MP_QSTR_getcwd)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ceil)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PIT)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_crop)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_callable)
+QINDEX(MP_QSTR_SR_TDF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_struct)
+QINDEX(MP_QSTR_set_binning)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rpartition)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR26_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BF_LEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_auto_exposure)
+QINDEX(MP_QSTR_pi)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FRACVAL3_FRACVAL3_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLA_INP_SELA)
+QINDEX(MP_QSTR_QQVGA2)
+QINDEX(MP_QSTR___pos__)
+QINDEX(MP_QSTR_SR_TCF)
+QINDEX(MP_QSTR_boot_times)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFG_OVWREN)
+QINDEX(MP_QSTR_AOI2)
+QINDEX(MP_QSTR_SWCOUT_SM3OUT45)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AOI1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MSR_NDF)
+QINDEX(MP_QSTR_set_mode)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SSR_TDF)
+QINDEX(MP_QSTR_b_mean)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Parser)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SXGA)
+QINDEX(MP_QSTR_remove_shadows)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_callback)
+QINDEX(MP_QSTR_pixel)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_USB1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_USB2)
+QINDEX(MP_QSTR_ptr)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_histeq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_CVAL2CYC)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_integral)
+QINDEX(MP_QSTR_SR_TEF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SAMR_ADDR1_BF)
+QINDEX(MP_QSTR_IN_PUP_WEAK)
+QINDEX(MP_QSTR_hex)
+QINDEX(MP_QSTR_wb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FRCTRL_FRAC1_EN)
+QINDEX(MP_QSTR_put)
+QINDEX(MP_QSTR_mkfs)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SIER_FEIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rssi)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_COMPMODE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CIF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_hasattr)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_recvfrom)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TMR_CMPLD2)
+QINDEX(MP_QSTR_TMR_CMPLD1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DER_TDDE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_FCTRL)
+QINDEX(MP_QSTR_LPSPI3)
+QINDEX(MP_QSTR_LPSPI2)
+QINDEX(MP_QSTR_LPSPI1)
+QINDEX(MP_QSTR_OCTRL_PWMXFS_BF)
+QINDEX(MP_QSTR_FSTS_FFPIN_BF)
+QINDEX(MP_QSTR_CFG_ADHSC)
+QINDEX(MP_QSTR_B128X64)
+QINDEX(MP_QSTR_LPSPI4)
+QINDEX(MP_QSTR_set_lens_correction)
+QINDEX(MP_QSTR_blob)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VCP_plus_HID)
+QINDEX(MP_QSTR_clear_screen)
+QINDEX(MP_QSTR_loads)
+QINDEX(MP_QSTR_sin)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_bulkload)
+QINDEX(MP_QSTR_psr)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_hash)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_group)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCTRL_TCFIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VAL2_VAL2_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_stats)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SDER_AVDE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MIER_SDIE)
+QINDEX(MP_QSTR_SWCOUT_SM0OUT23)
+QINDEX(MP_QSTR_maxsize)
+QINDEX(MP_QSTR_state)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL2_INDEP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DTSRCSEL_SM0SEL23_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DTSRCSEL_SM2SEL23_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SINGLE_BUFFER)
+QINDEX(MP_QSTR_CCR_DBT_BF)
+QINDEX(MP_QSTR___len__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG4_ENABLE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ujson)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_StopAsyncIteration)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_largest_free)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_blit)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_SDER)
+QINDEX(MP_QSTR___module__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_discard)
+QINDEX(MP_QSTR_TCR_FRAMESZ_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_KEY)
+QINDEX(MP_QSTR_OFS_SIGN)
+QINDEX(MP_QSTR_tell)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EADDRINUSE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_UnicodeError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_max_keypoints)
+QINDEX(MP_QSTR_SRC)
+QINDEX(MP_QSTR_channel)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SIER_TAIE)
+QINDEX(MP_QSTR_CTRL_LENGTH)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_RESOLUTION)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_isinf)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_log10)
+QINDEX(MP_QSTR_readfrom)
+QINDEX(MP_QSTR_used)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GC_ACREN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCR_CONTC)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_x1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_x2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__lt_setcomp_gt_)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_RTWDOG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ticks_us)
+QINDEX(MP_QSTR_SSR_TAF)
+QINDEX(MP_QSTR_XGA)
+QINDEX(MP_QSTR_DTSRCSEL_SM1SEL45_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_RuntimeError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_x_spacing)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_clear_fb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MODE_P2P)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_y1)
+QINDEX(MP_QSTR_y2)
+QINDEX(MP_QSTR_None)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_displacement)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___divmod__)
+QINDEX(MP_QSTR_MASK_MASKX_BF)
+QINDEX(MP_QSTR_TMR4)
+QINDEX(MP_QSTR_seed_threshold)
+QINDEX(MP_QSTR_TMR2)
+QINDEX(MP_QSTR_TMR3)
+QINDEX(MP_QSTR_scale)
+QINDEX(MP_QSTR_TMR1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_udiv)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR30_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SWCOUT_SM0OUT45)
+QINDEX(MP_QSTR_addrsize)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Flash)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SDER_RDDE)
+QINDEX(MP_QSTR_STS_CMPF_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_HALF)
+QINDEX(MP_QSTR_HARD_RESET)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BILINEAR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_wait_us)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_pack)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_D10_SS)
+QINDEX(MP_QSTR_CSU)
+QINDEX(MP_QSTR_IER_DMIE)
+QINDEX(MP_QSTR_MASK_MASKA_BF)
+QINDEX(MP_QSTR_errno)
+QINDEX(MP_QSTR_grayscale_to_binary)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rgb_to_lab)
+QINDEX(MP_QSTR_sendbreak)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCTRL_PWAOT0)
+QINDEX(MP_QSTR_IOCTL_GET_TRIGGERED_MODE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_hard_reset)
+QINDEX(MP_QSTR_mem_info)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_STS_CFB1)
+QINDEX(MP_QSTR_STS_CFB0)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSI)
+QINDEX(MP_QSTR_AF0_LPI2C4)
+QINDEX(MP_QSTR_ADC_CFG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CVAL5_CAPTVAL5_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rgb_to_binary)
+QINDEX(MP_QSTR_NEGATIVE)
+QINDEX(MP_QSTR_hys)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_HQVGA)
+QINDEX(MP_QSTR_board_id)
+QINDEX(MP_QSTR_modules)
+QINDEX(MP_QSTR_pyb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_gate)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_builtins)
+QINDEX(MP_QSTR_uctypes)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_ident)
+QINDEX(MP_QSTR_BIG_ENDIAN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BaseException)
+QINDEX(MP_QSTR_MIER_ALIE)
+QINDEX(MP_QSTR_WDT_RESET)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR1_AUTOPCS)
+QINDEX(MP_QSTR_GS_AWKST)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR1_SAMPLE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_iterable)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_FRACVAL5)
+QINDEX(MP_QSTR_PWM_FRACVAL4)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_FRACVAL1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_FRACVAL3)
+QINDEX(MP_QSTR_PWM_FRACVAL2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VOID)
+QINDEX(MP_QSTR_aes)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_D4)
+QINDEX(MP_QSTR_SCFGR1_HSMEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_D8)
+QINDEX(MP_QSTR_SSR_AVF)
+QINDEX(MP_QSTR_STS_CFA0)
+QINDEX(MP_QSTR_STS_CFA1)
+QINDEX(MP_QSTR_CTRL_LDMOD)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ticks_ms)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_add)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_CAPTCTRLX)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_profile)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_A4)
+QINDEX(MP_QSTR_A5)
+QINDEX(MP_QSTR_CAPTCTRLB_CFBWM_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_A0)
+QINDEX(MP_QSTR_A1)
+QINDEX(MP_QSTR_A2)
+QINDEX(MP_QSTR_A3)
+QINDEX(MP_QSTR_DEEPSLEEP_RESETABC)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_bytes)
+QINDEX(MP_QSTR_PWM_CAPTCTRLB)
+QINDEX(MP_QSTR_PWM_CAPTCTRLA)
+QINDEX(MP_QSTR_trajectory)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CR_DBGEN)
+QINDEX(MP_QSTR_CTRL_EXT1_TRIG_ENABLE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_vsync_output)
+QINDEX(MP_QSTR_set_hmirror)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_put_diamond)
+QINDEX(MP_QSTR_set_auto_exposure_roi)
+QINDEX(MP_QSTR_Biquad)
+QINDEX(MP_QSTR_ADC_CAL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_expm1)
+QINDEX(MP_QSTR_flash)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR1_PCSCFG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_array)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_OUTMODE_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_getter)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fabs)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_abs)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_deepsleep)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_decrypt)
+QINDEX(MP_QSTR_put_pixel_physical)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ANALOG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_chdir)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG0_DONE2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_a_uq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_super)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSCTRL_FAULT)
+QINDEX(MP_QSTR_BINARY)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___iter__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_MSR)
+QINDEX(MP_QSTR_CODE128)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_DTSRCSEL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_y_margin)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PALETTE_IRONBOW)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_readchar)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_compressed_for_ide)
+QINDEX(MP_QSTR_update_display)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_features)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fix_rotation_scale)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_keys)
+QINDEX(MP_QSTR___next__)
+QINDEX(MP_QSTR_STS_CFX0)
+QINDEX(MP_QSTR_STS_CFX1)
+QINDEX(MP_QSTR_CTRL_COINIT)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_vcvt_s32_f32)
+QINDEX(MP_QSTR_FRAMESIZE_FHD)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_progsize)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_FRCTRL)
+QINDEX(MP_QSTR_and)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_any)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_int)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FIR)
+QINDEX(MP_QSTR_get_motion_mask)
+QINDEX(MP_QSTR_load_db)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_acquire)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_xor)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_format)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_pop)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_pow)
+QINDEX(MP_QSTR_choice)
+QINDEX(MP_QSTR_FHD)
+QINDEX(MP_QSTR_deadline)
+QINDEX(MP_QSTR_LPI2C_PARAM)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MDMR_MATCH1_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_r_step)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ADC_HC7)
+QINDEX(MP_QSTR_ADC_HC6)
+QINDEX(MP_QSTR_ADC_HC5)
+QINDEX(MP_QSTR_ADC_HC4)
+QINDEX(MP_QSTR_all)
+QINDEX(MP_QSTR_ADC_HC2)
+QINDEX(MP_QSTR_ADC_HC1)
+QINDEX(MP_QSTR_ADC_HC0)
+QINDEX(MP_QSTR_ADC_HC3)
+QINDEX(MP_QSTR___matmul__)
+QINDEX(MP_QSTR_CMP1)
+QINDEX(MP_QSTR_CMP2)
+QINDEX(MP_QSTR_CMP3)
+QINDEX(MP_QSTR_CTRL2_FORCE_SEL_BF)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG3_DONE0)
+QINDEX(MP_QSTR_CMP4)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG3_DONE1)
+QINDEX(MP_QSTR_patch_program)
+QINDEX(MP_QSTR__lt_string_gt_)
+QINDEX(MP_QSTR_sizeof)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_alt)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR2_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MIER_FEIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_splitlines)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GS4_HMSB)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IORead)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SR_DMF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_weight)
+QINDEX(MP_QSTR_a_lq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___main__)
+QINDEX(MP_QSTR_keyframe_interval)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCFGR1_PRESCALE_BF)
+QINDEX(MP_QSTR_b_xnor)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SR_WCF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_D3_INT1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_split)
+QINDEX(MP_QSTR_max_bytes)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FONT6x13)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_version)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sched_stats)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MT9V034)
+QINDEX(MP_QSTR_DCDC)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_HD)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___le__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_D2_INT0)
+QINDEX(MP_QSTR_TCR_CPOL)
+QINDEX(MP_QSTR_CAPTCTRLB_ONESHOTB)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_HQQVGA)
+QINDEX(MP_QSTR_set_vflip)
+QINDEX(MP_QSTR_SIER_GCIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_items)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCR_CPHA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCR_CONT)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_info)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_KPP)
+QINDEX(MP_QSTR_SSR_BBF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_pin)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_kbd_intr)
+QINDEX(MP_QSTR_CFGR1_OUTCFG)
+QINDEX(MP_QSTR_pid)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_height)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_CVAL3CYC)
+QINDEX(MP_QSTR___file__)
+QINDEX(MP_QSTR_PARAM_TXFIFO_BF)
+QINDEX(MP_QSTR_MVLSB)
+QINDEX(MP_QSTR_gettime)
+QINDEX(MP_QSTR_imagereader)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_y_hist_bins)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR0_RDMO)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_reset)
+QINDEX(MP_QSTR_a_median)
+QINDEX(MP_QSTR_insert)
+QINDEX(MP_QSTR_Pin)
+QINDEX(MP_QSTR_read_port)
+QINDEX(MP_QSTR_avg)
+QINDEX(MP_QSTR_COMP1_COMPARISON_1_BF)
+QINDEX(MP_QSTR_unregister)
+QINDEX(MP_QSTR_SCTRL_MSTR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_init)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_upper)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_copysign)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_from_bytes)
+QINDEX(MP_QSTR_OCTRL_PWMX_IN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_first_frame)
+QINDEX(MP_QSTR_timeout)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OCOTP)
+QINDEX(MP_QSTR_draw_arrow)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG5_ENABLE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_value)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR1_PCSPOL_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_min_hits)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_stream)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_frequency)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCFGR0_RDMO)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_STAR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_blur)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR27_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GS_ADACT)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___dict__)
+QINDEX(MP_QSTR_board)
+QINDEX(MP_QSTR_get_frame_info)
+QINDEX(MP_QSTR_lab_tab)
+QINDEX(MP_QSTR___anext__)
+QINDEX(MP_QSTR_CVAL4_CAPTVAL4_BF)
+QINDEX(MP_QSTR_draw_cross)
+QINDEX(MP_QSTR_LONGLONG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_STDR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_and_)
+QINDEX(MP_QSTR_arg)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_QQQQVGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SIF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SD_B0_00)
+QINDEX(MP_QSTR_SD_B0_01)
+QINDEX(MP_QSTR_SD_B0_02)
+QINDEX(MP_QSTR_SD_B0_03)
+QINDEX(MP_QSTR_P1)
+QINDEX(MP_QSTR_P4)
+QINDEX(MP_QSTR_P3)
+QINDEX(MP_QSTR_P2)
+QINDEX(MP_QSTR_P5)
+QINDEX(MP_QSTR_P6)
+QINDEX(MP_QSTR_USHORT)
+QINDEX(MP_QSTR_INTEN_CMPIE_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SOCK_DGRAM)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_slice)
+QINDEX(MP_QSTR_cmath)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__lt_module_gt_)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_DER)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FRACVAL4_FRACVAL4_BF)
+QINDEX(MP_QSTR_LPI2C_MCR)
+QINDEX(MP_QSTR_file)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSCTRL_TCF1EN)
+QINDEX(MP_QSTR_SSR_BEF)
+QINDEX(MP_QSTR_fill)
+QINDEX(MP_QSTR_set_font)
+QINDEX(MP_QSTR_hamming)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PinFast)
+QINDEX(MP_QSTR_clip)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_RDR_DATA_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_XBARB2)
+QINDEX(MP_QSTR_XBARB3)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_response)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_a_stdev)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FCR_TXWATER_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SD)
+QINDEX(MP_QSTR_pend_throw)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_XBARA1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_nand)
+QINDEX(MP_QSTR_uniform)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_track_points)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_median)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_as_array)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCFGR1_PINCFG_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_STS_RF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_density)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_display)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CVAL3CYC_CVAL3CYC_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMAEN_VALDE)
+QINDEX(MP_QSTR_width)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_store_list)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_ticks)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rstrip)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCFGR1_IGNACK)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_WVGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EALREADY)
+QINDEX(MP_QSTR_slab_pages)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OV7725)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sorted)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_FULL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_asr)
+QINDEX(MP_QSTR_fast)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___neg__)
+QINDEX(MP_QSTR_magnitude)
+QINDEX(MP_QSTR_phase)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_grayscale_to_yuv)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_writevto)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___new__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_version_major)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF_INET6)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mask_ellipse)
+QINDEX(MP_QSTR__space_)
+QINDEX(MP_QSTR_PWM_FTST)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MODE_FIRMWARE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__slash_)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__star_)
+QINDEX(MP_QSTR_SSR_RSF)
+QINDEX(MP_QSTR_apriltag)
+QINDEX(MP_QSTR_seed)
+QINDEX(MP_QSTR_SSR_AM1F)
+QINDEX(MP_QSTR_dilate)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_mkdir)
+QINDEX(MP_QSTR_seek)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_name)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lab_to_grayscale)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GS_CALF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_CFGR0)
+QINDEX(MP_QSTR_LPSPI_CFGR1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__0x0a_)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_into)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF1_LPI2C3)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_buffer_size)
+QINDEX(MP_QSTR_e)
+QINDEX(MP_QSTR_variance)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FileIO)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_b)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_max_iterations)
+QINDEX(MP_QSTR_sweep_budget)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_h)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OCTRL_PWMA_IN)
+QINDEX(MP_QSTR_AD_B1_03)
+QINDEX(MP_QSTR_AD_B1_02)
+QINDEX(MP_QSTR_AD_B1_01)
+QINDEX(MP_QSTR_AD_B1_00)
+QINDEX(MP_QSTR__lt_listcomp_gt_)
+QINDEX(MP_QSTR_AD_B1_06)
+QINDEX(MP_QSTR_AD_B1_05)
+QINDEX(MP_QSTR_AD_B1_04)
+QINDEX(MP_QSTR_AD_B1_07)
+QINDEX(MP_QSTR_w)
+QINDEX(MP_QSTR_match_descriptor)
+QINDEX(MP_QSTR_AD_B1_08)
+QINDEX(MP_QSTR_y)
+QINDEX(MP_QSTR_CSCTRL_ROC)
+QINDEX(MP_QSTR_MCFGR0_HRPOL)
+QINDEX(MP_QSTR_CFG_ADLSMP)
+QINDEX(MP_QSTR_strength)
+QINDEX(MP_QSTR_x)
+QINDEX(MP_QSTR_r)
+QINDEX(MP_QSTR_debug)
+QINDEX(MP_QSTR_stat)
+QINDEX(MP_QSTR_LP_SCALE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_wait_us_total)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VfsLfs2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AD_B1_10)
+QINDEX(MP_QSTR_AD_B1_11)
+QINDEX(MP_QSTR_SSR_AM0F)
+QINDEX(MP_QSTR_ICR2_ICR17_BF)
+QINDEX(MP_QSTR_INT64)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_x_margin)
+QINDEX(MP_QSTR___delitem__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCTRL_IPOL_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCTRL2_MONPLL_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FILT_FILT_PER_BF)
+QINDEX(MP_QSTR_color_palette)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_vline)
+QINDEX(MP_QSTR_namedtuple)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TypeError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_max_points)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_hog)
+QINDEX(MP_QSTR_VCP)
+QINDEX(MP_QSTR_DTCNT0_DTCNT0_BF)
+QINDEX(MP_QSTR_MFCR_TXWATER_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lab_to_rgb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rho_margin)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_step)
+QINDEX(MP_QSTR_find_keypoints)
+QINDEX(MP_QSTR_INT32)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_USB_HID)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_R_CDATA_BF)
+QINDEX(MP_QSTR_capture)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ADC)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCTRL_PWBOT1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MIER_NDIE)
+QINDEX(MP_QSTR_STS_RUF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OV9650)
+QINDEX(MP_QSTR_WINC)
+QINDEX(MP_QSTR_WAKEUP)
+QINDEX(MP_QSTR_StringIO)
+QINDEX(MP_QSTR_erfc)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Capture)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_linpolar)
+QINDEX(MP_QSTR_MCFGR2_FILTSDA_BF)
+QINDEX(MP_QSTR_MIER_EPIE)
+QINDEX(MP_QSTR_INT16)
+QINDEX(MP_QSTR_disable)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___abs__)
+QINDEX(MP_QSTR_Wheel)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sysname)
+QINDEX(MP_QSTR_D11_MO)
+QINDEX(MP_QSTR_stop)
+QINDEX(MP_QSTR_SEMC)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCR_WIDTH_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_update)
+QINDEX(MP_QSTR_match_into)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_send)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCR_RXMSK)
+QINDEX(MP_QSTR_CNT_CNT_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SRDR_DATA_BF)
+QINDEX(MP_QSTR_pixformat)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SOCK_RAW)
+QINDEX(MP_QSTR_read_channel)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_put_line)
+QINDEX(MP_QSTR_CTRL_CM_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_xnor)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAL_CAL_CODE_BF)
+QINDEX(MP_QSTR_target)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_dry_run)
+QINDEX(MP_QSTR_b_nand)
+QINDEX(MP_QSTR_rx_consume)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_codes)
+QINDEX(MP_QSTR_EDGE_CANNY)
+QINDEX(MP_QSTR_get_regression)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_QXGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_DT_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BytesIO)
+QINDEX(MP_QSTR_PWM4)
+QINDEX(MP_QSTR_PWM3)
+QINDEX(MP_QSTR_PWM2)
+QINDEX(MP_QSTR_PWM1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSCTRL_TCF2)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG5_REQ)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSCTRL_TCF1)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG1_REQ)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG6_REQ)
+QINDEX(MP_QSTR_MFSR_TXCOUNT_BF)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG2_REQ)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_SCS_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_draw_keypoints)
+QINDEX(MP_QSTR_strb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_INT)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_strh)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL2_CLK_SEL_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCR_MEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_imag)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_read_async)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EAN8)
+QINDEX(MP_QSTR__brace_open__colon__hash_b_brace_close_)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EAN5)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EAN2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_gain_db_ceiling)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___mod__)
+QINDEX(MP_QSTR_CAPTCTRLB_CB0CNT_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___del__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_append)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_self)
+QINDEX(MP_QSTR_negate)
+QINDEX(MP_QSTR_ENOTCONN)
+QINDEX(MP_QSTR_points)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_UINT32)
+QINDEX(MP_QSTR_SEARCH_DS)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TMR_FILT)
+QINDEX(MP_QSTR_FCTRL_FAUTO_BF)
+QINDEX(MP_QSTR_MODE_AP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCR_RST)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DBG_TXD)
+QINDEX(MP_QSTR_MDMR_MATCH0_BF)
+QINDEX(MP_QSTR_DecompIO)
+QINDEX(MP_QSTR_get_luma_histogram)
+QINDEX(MP_QSTR_stack_use)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOMUXC_SNVS_GPR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_pixel)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_save_descriptor)
+QINDEX(MP_QSTR_SEARCH_EX)
+QINDEX(MP_QSTR_effort)
+QINDEX(MP_QSTR_CAPTCTRLA_ARMA)
+QINDEX(MP_QSTR_EOPNOTSUPP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_nop)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG7_DONE2)
+QINDEX(MP_QSTR_nor)
+QINDEX(MP_QSTR_SRDR_SOF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_chrominvar)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_repl_info)
+QINDEX(MP_QSTR_getattr)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG6_DONE0)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG6_DONE1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_UINT16)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLB_ARMB)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_main)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_repr)
+QINDEX(MP_QSTR_LPI2C_MTDR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IER_TEIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCTRL_VAL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ldrex)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FILT_FILT_CNT_BF)
+QINDEX(MP_QSTR_y_translation)
+QINDEX(MP_QSTR_robust)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_isalpha)
+QINDEX(MP_QSTR_AF_INET)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCFGR2_DATAVD_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___invert__)
+QINDEX(MP_QSTR_fir)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCR_RRF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ImageReader)
+QINDEX(MP_QSTR___isub__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_decision_margin)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_VAL3)
+QINDEX(MP_QSTR_PWM_VAL2)
+QINDEX(MP_QSTR_PWM_VAL1)
+QINDEX(MP_QSTR_PWM_VAL0)
+QINDEX(MP_QSTR_get_threshold)
+QINDEX(MP_QSTR_frexp)
+QINDEX(MP_QSTR_PWM_VAL5)
+QINDEX(MP_QSTR_DTSRCSEL_SM3SEL23_BF)
+QINDEX(MP_QSTR_PWM_VAL4)
+QINDEX(MP_QSTR_SoftSPI)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_repl_uart)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_x_hist_bins_max)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_displacement)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_MEASUREMENT_MODE)
+QINDEX(MP_QSTR_OUT_WEAK)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_bkcolor)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR14_BF)
+QINDEX(MP_QSTR_PinAF)
+QINDEX(MP_QSTR_rename)
+QINDEX(MP_QSTR_SCR_RTF)
+QINDEX(MP_QSTR_SSR_RDF)
+QINDEX(MP_QSTR_find_datamatrices)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CNTR_COUNTER_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___getattr__)
+QINDEX(MP_QSTR_ICR1_ICR1_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___exit__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_snapshot)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MONO_HLSB)
+QINDEX(MP_QSTR_calcsize)
+QINDEX(MP_QSTR_process)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_gpio)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___rshift__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_isspace)
+QINDEX(MP_QSTR_port)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_symmetric_difference_update)
+QINDEX(MP_QSTR_CVAL5CYC_CVAL5CYC_BF)
+QINDEX(MP_QSTR_UINT64)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCOMPB_EDGCNTB_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_binary_to_yuv)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_patch_version)
+QINDEX(MP_QSTR_setblocking)
+QINDEX(MP_QSTR_getaddrinfo)
+QINDEX(MP_QSTR_SCFGR1_SAEN)
+QINDEX(MP_QSTR_x_overlap)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMA_CMPLD1DE)
+QINDEX(MP_QSTR_MDER_TDDE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_STS_REF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TCR_LSBF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FSR_TXCOUNT_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_TDR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_tracks)
+QINDEX(MP_QSTR_Net)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_miso)
+QINDEX(MP_QSTR_DTSRCSEL_SM2SEL45_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCFGR1_RXCFG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_stderr)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG6_ENABLE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSCTRL_CL1_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_b_stdev)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_contrast_threshold)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_color_palette)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_gainceiling)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_copy_to_fb)
+QINDEX(MP_QSTR_fps)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_encrypt)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_NotImplementedError)
+QINDEX(MP_QSTR_pipeline)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_dealloc_extra_fb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_a_mean)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DER_RDDE)
+QINDEX(MP_QSTR_GREEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___name__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MSR_EPF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_TCR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_present)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_baudrate)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ETIMEDOUT)
+QINDEX(MP_QSTR_black_hat)
+QINDEX(MP_QSTR_merge_distance)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_writeto)
+QINDEX(MP_QSTR_setter)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SSR_GCF)
+QINDEX(MP_QSTR_frames)
+QINDEX(MP_QSTR_fb_reset_peak)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_blobs)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCFGR2_FILTSDA_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_getbuffer)
+QINDEX(MP_QSTR_statvfs)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DTSRCSEL_SM1SEL23_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_firstbit)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_window_open)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_CVAL4CYC)
+QINDEX(MP_QSTR___getitem__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MRDR_RXEMPTY)
+QINDEX(MP_QSTR_get_stats)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_snapshot_async)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_avail)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fw_update)
+QINDEX(MP_QSTR_platform)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_PARAM)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR9_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_roundness)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR16_BF)
+QINDEX(MP_QSTR_ICR2_ICR24_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GC_ADCO)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_addressof)
+QINDEX(MP_QSTR_trunc)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TMR_HOLD)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCFGR1_TIMECFG)
+QINDEX(MP_QSTR_logpolar)
+QINDEX(MP_QSTR_byteorder)
+QINDEX(MP_QSTR_set_usb_irq_in_snapshot)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_kp_db)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_readlines)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_result)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_boot_dot_py)
+QINDEX(MP_QSTR_fails)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOMUXC)
+QINDEX(MP_QSTR_ENBL_ENBL_BF)
+QINDEX(MP_QSTR_VAL4_VAL4_BF)
+QINDEX(MP_QSTR_isconnected)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_poll)
+QINDEX(MP_QSTR_depths)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_pixels)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___call__)
+QINDEX(MP_QSTR_convexity)
+QINDEX(MP_QSTR_LEPTON)
+QINDEX(MP_QSTR_decode)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MIER_DMIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF2_LPUART1)
+QINDEX(MP_QSTR_unhexlify)
+QINDEX(MP_QSTR_AF2_LPUART3)
+QINDEX(MP_QSTR_AF2_LPUART2)
+QINDEX(MP_QSTR_DMAEN_CX1DE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_read)
+QINDEX(MP_QSTR_AF2_LPUART6)
+QINDEX(MP_QSTR_AF2_LPUART8)
+QINDEX(MP_QSTR_D12_MI)
+QINDEX(MP_QSTR_UART)
+QINDEX(MP_QSTR_MCR_DOZEN)
+QINDEX(MP_QSTR_CCM_ANALOG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_module)
+QINDEX(MP_QSTR_CFG_MODE_BF)
+QINDEX(MP_QSTR_real)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AD_B0_13)
+QINDEX(MP_QSTR_AD_B0_12)
+QINDEX(MP_QSTR_AD_B0_11)
+QINDEX(MP_QSTR_AD_B0_10)
+QINDEX(MP_QSTR_standby)
+QINDEX(MP_QSTR_set_quality)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CVAL1CYC_CVAL1CYC_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lstrip)
+QINDEX(MP_QSTR_rect)
+QINDEX(MP_QSTR_recv)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FrameBuffer1)
+QINDEX(MP_QSTR_CTRL_EXT1_TRIG_PRIORITY_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TRIPLE_BUFFER)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AD_B0_02)
+QINDEX(MP_QSTR_AD_B0_03)
+QINDEX(MP_QSTR_max_codes)
+QINDEX(MP_QSTR_AD_B0_01)
+QINDEX(MP_QSTR_PWM_DMAEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_NORMAL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_readline)
+QINDEX(MP_QSTR_IOMUXC_GPR)
+QINDEX(MP_QSTR_AD_B0_09)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_statistics)
+QINDEX(MP_QSTR_PSR_PSR_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_disable_irq)
+QINDEX(MP_QSTR_SWIM)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_zero)
+QINDEX(MP_QSTR_TMR_CSCTRL)
+QINDEX(MP_QSTR_MCCR0_CLKLO_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_YUV422)
+QINDEX(MP_QSTR_is_numeric)
+QINDEX(MP_QSTR_MIER_PLTIE)
+QINDEX(MP_QSTR_FRAMESIZE_HD)
+QINDEX(MP_QSTR_FRAMESIZE_QXGA)
+QINDEX(MP_QSTR_locked)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ucollections)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL2_WAITEN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCR_RTF)
+QINDEX(MP_QSTR_MSR_RDF)
+QINDEX(MP_QSTR_SCFGR1_TXCFG)
+QINDEX(MP_QSTR_set_gray_lut)
+QINDEX(MP_QSTR_scroll)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_enclosing_circle)
+QINDEX(MP_QSTR_uasyncio)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ucryptolib)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_elapsed_micros)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FFILT_FILT_CNT_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_midpoint)
+QINDEX(MP_QSTR_BFINT8)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CDC_plus_HID)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ARRAY)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FRACVAL1_FRACVAL1_BF)
+QINDEX(MP_QSTR_to_bitmap)
+QINDEX(MP_QSTR_slab_used)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSCTRL_UP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_code)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rgbtuple)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__percent__hash_o)
+QINDEX(MP_QSTR___enter__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_edges)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_enumerate)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_input)
+QINDEX(MP_QSTR_max_results)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uart)
+QINDEX(MP_QSTR_OUTEN_PWMB_EN_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__percent__hash_x)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FTST_FTEST)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ptr8)
+QINDEX(MP_QSTR_HQQQVGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_a_value)
+QINDEX(MP_QSTR_mask)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AssertionError)
+QINDEX(MP_QSTR_MCFGR0_HRSEL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_difference_update)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_compress)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_isdigit)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_dupterm)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_pixel)
+QINDEX(MP_QSTR_gamma_corr)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_addr)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MSR_PLTF)
+QINDEX(MP_QSTR_D9_PWM4)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCCR1_SETHOLD_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PARAM_MTXFIFO_BF)
+QINDEX(MP_QSTR_TRNG)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_clear_background)
+QINDEX(MP_QSTR_sdiv)
+QINDEX(MP_QSTR_flashpgm)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_open)
+QINDEX(MP_QSTR_DCP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FFILT_GSTR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_histogram)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_TRIG_ENABLE_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_TSC_BYPASS)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_freq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCTRL_CLDOK_BF)
+QINDEX(MP_QSTR_set_gray_gain)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_free)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_SIER)
+QINDEX(MP_QSTR_utimeq)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_framebuffers)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_cmp_lbp)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___repl_print__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CCR_PCSSCK_BF)
+QINDEX(MP_QSTR_fragment_misses)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___and__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_find_barcodes)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCR_RST)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VfsFat)
+QINDEX(MP_QSTR___int__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_barcode)
+QINDEX(MP_QSTR_ECONNRESET)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_merge)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_MDER)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_buffering)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_DIR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_WQXGA2)
+QINDEX(MP_QSTR_D5_PWM1)
+QINDEX(MP_QSTR_stack_size)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_math)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___or__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BLUE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG5_DONE1)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG5_DONE0)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GPIO_GDIR)
+QINDEX(MP_QSTR_IPPROTO_UDP)
+QINDEX(MP_QSTR_char_hmirror)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rotation_rad)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_flood_fill)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCR_RRF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_decompress)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_CAPTCOMPB)
+QINDEX(MP_QSTR_PWM_CAPTCOMPA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FONT5x7)
+QINDEX(MP_QSTR_uzlib)
+QINDEX(MP_QSTR_deleter)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_D7_PWM3)
+QINDEX(MP_QSTR_GRAYSCALE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPUART8)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPUART3)
+QINDEX(MP_QSTR_LPUART2)
+QINDEX(MP_QSTR_LPUART1)
+QINDEX(MP_QSTR_free_slots)
+QINDEX(MP_QSTR_LPUART7)
+QINDEX(MP_QSTR_LPUART6)
+QINDEX(MP_QSTR_LPUART5)
+QINDEX(MP_QSTR_LPUART4)
+QINDEX(MP_QSTR_PWM_CAPTCOMPX)
+QINDEX(MP_QSTR_ISR_ISR_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLX_ARMX)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SPDIF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_START_OBJECT)
+QINDEX(MP_QSTR_D6_PWM2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR0_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_color_palette)
+QINDEX(MP_QSTR_align)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_gif)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_MCCR1)
+QINDEX(MP_QSTR_LPI2C_MCCR0)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_nn_class)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SR_FCF)
+QINDEX(MP_QSTR_slab_allocs)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_b_xor)
+QINDEX(MP_QSTR_MODE_ECB)
+QINDEX(MP_QSTR_LITTLE_ENDIAN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TMR_SCTRL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Gif)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_cartoon)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CR_DOZEN)
+QINDEX(MP_QSTR_cosh)
+QINDEX(MP_QSTR_b_and)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_main_py)
+QINDEX(MP_QSTR_PWM_SWCOUT)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_softmax)
+QINDEX(MP_QSTR_copy)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_EXT0_TRIG_ENABLE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_compactness)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SDER_TDDE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_SAMR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_percentile)
+QINDEX(MP_QSTR_SHORT)
+QINDEX(MP_QSTR_QHD)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_segment_size)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_vid)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FRACVAL2_FRACVAL2_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLA_CA1CNT_BF)
+QINDEX(MP_QSTR_DMA_CTRL_TRIG7_ENABLE)
+QINDEX(MP_QSTR_encoding)
+QINDEX(MP_QSTR_unpack)
+QINDEX(MP_QSTR_get_similarity)
+QINDEX(MP_QSTR_boot_py)
+QINDEX(MP_QSTR_micropython)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MONO_VLSB)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_data)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ImportError)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_l_stdev)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_MDMR)
+QINDEX(MP_QSTR_quality)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_readblocks)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_omv)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMA_CMPLD2DE)
+QINDEX(MP_QSTR___read_reg)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_pixformat)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_dict)
+QINDEX(MP_QSTR_MSR_MBF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_compressed)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_offset)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_bssid)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_FPA_TEMPERATURE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_START_ARRAY)
+QINDEX(MP_QSTR_SCFGR1_RXSTALL)
+QINDEX(MP_QSTR_CAPTCTRLB_CB1CNT_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_goodness)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_data_type)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_HEIGHT)
+QINDEX(MP_QSTR_hline)
+QINDEX(MP_QSTR_QVGA)
+QINDEX(MP_QSTR_CSCTRL_CL2_BF)
+QINDEX(MP_QSTR_set_saturation)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LED)
+QINDEX(MP_QSTR_min_scale)
+QINDEX(MP_QSTR_off)
+QINDEX(MP_QSTR_CTRL2_DBGEN)
+QINDEX(MP_QSTR_peektime)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_capacity)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR15_BF)
+QINDEX(MP_QSTR_help)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_bytearray_at)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MTDR_DATA_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DTCNT1_DTCNT1_BF)
+QINDEX(MP_QSTR_idle)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_join)
+QINDEX(MP_QSTR_ICR1_ICR8_BF)
+QINDEX(MP_QSTR_fastslew)
+QINDEX(MP_QSTR_get_hist)
+QINDEX(MP_QSTR_put_text_xy)
+QINDEX(MP_QSTR_search_into)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_randint)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG6_DONE2)
+QINDEX(MP_QSTR_ICR2_ICR25_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uname)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_refine_edges)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rx_span)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_TSC)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_line)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LCD)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_rfind)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_RSR_RXEMPTY)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GPIO_PSR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CSCTRL_TCI)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Future)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_DMA_MODE_SEL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_assign)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_DTCNT1)
+QINDEX(MP_QSTR_PWM_DTCNT0)
+QINDEX(MP_QSTR_StopIteration)
+QINDEX(MP_QSTR_bool)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_frozenset)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_union)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_oct)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_intersection_update)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_errorcode)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF1_TMR3)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFG_AVGS_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_bytecode)
+QINDEX(MP_QSTR_UINT)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_list)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_velocity)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fromkeys)
+QINDEX(MP_QSTR_TMR_CTRL)
+QINDEX(MP_QSTR_VERID_FEATURE_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GC_ACFE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_datamatrix)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_BF_POS)
+QINDEX(MP_QSTR_ipoll)
+QINDEX(MP_QSTR_free_blocks)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_char_rotation)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_put_circle)
+QINDEX(MP_QSTR_get_perf_profile)
+QINDEX(MP_QSTR_margin)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_DBLX)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uhashlib)
+QINDEX(MP_QSTR_getrandbits)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_WPA2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_grayscale_to_rgb)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_pull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_SRDR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_taps)
+QINDEX(MP_QSTR_GPT2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GPT1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLX_EDGX1_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_next_frame)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Pipeline)
+QINDEX(MP_QSTR_BAYER)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_strex)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_WVGA2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_read_ir)
+QINDEX(MP_QSTR_WPA_PSK)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_bytes_at)
+QINDEX(MP_QSTR_circle)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_jpeg_ms)
+QINDEX(MP_QSTR__slash_sd)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_sort)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_lcd_direct)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_CVAL5CYC)
+QINDEX(MP_QSTR_complex)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IN_PDN)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_intensity)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_INT8)
+QINDEX(MP_QSTR_default)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFGR0_HRPOL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL2_PWMX_INIT)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PARAM_PCSNUM_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_connect)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uint)
+QINDEX(MP_QSTR_TCR_PCS_BF)
+QINDEX(MP_QSTR_utime)
+QINDEX(MP_QSTR_store_erase)
+QINDEX(MP_QSTR_recv_into)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SIER_RDIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GC_CAL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CTRL_LDFQ_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_heap)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCTRL_FORCE)
+QINDEX(MP_QSTR_INTEN_CB1IE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_blend)
+QINDEX(MP_QSTR_enable)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFG_REFSEL_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_max_age)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_range)
+QINDEX(MP_QSTR_allocs)
+QINDEX(MP_QSTR_ord)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_atan)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AttributeError)
+QINDEX(MP_QSTR_play)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_filter)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_strip)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPI2C_MCFGR3)
+QINDEX(MP_QSTR_LPI2C_MCFGR2)
+QINDEX(MP_QSTR___setitem__)
+QINDEX(MP_QSTR_LPI2C_MCFGR0)
+QINDEX(MP_QSTR_LPI2C_MCFGR1)
+QINDEX(MP_QSTR_SOCK_STREAM)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___import__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR2_ICR19_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCFGR1_AUTOSTOP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_iterator)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_barcodes)
+QINDEX(MP_QSTR_GC_AVGE)
+QINDEX(MP_QSTR_lazy)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SCFGR1_ADRSTALL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_fcolor)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_OD_PUP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CCR_SCKPCS_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_clients)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___eq__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_maximum_space_recursion_space_depth_space_exceeded)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_values)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_max_exposure_us)
+QINDEX(MP_QSTR_exit)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_ICR1_ICR7_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FIR_NONE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_brightness)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_scale_mul)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_Pool)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_GC_DMAEN)
+QINDEX(MP_QSTR_wfi)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_randrange)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF5_GPIO1)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF5_GPIO3)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_AF5_GPIO5)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IPPROTO_TCP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR__slash_sd_slash_lib)
+QINDEX(MP_QSTR_isinstance)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_push)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOCTL_LEPTON_SET_MEASUREMENT_RANGE)
+QINDEX(MP_QSTR_perf)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG0_DONE0)
+QINDEX(MP_QSTR_DONE0_1_IRQ_TRIG0_DONE1)
+QINDEX(MP_QSTR_vstr)
+QINDEX(MP_QSTR_ops)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_PWM_CTRL2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_backlight)
+QINDEX(MP_QSTR_get_pixel_physical)
+QINDEX(MP_QSTR_opt)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_to_bytes)
+QINDEX(MP_QSTR_LSB)
+QINDEX(MP_QSTR_FrameBuffer)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_umount)
+QINDEX(MP_QSTR_put_box)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VAL1_VAL1_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DISMAP_DIS1B_BF)
+QINDEX(MP_QSTR_DISMAP_DIS0B_BF)
+QINDEX(MP_QSTR_mask_rectangle)
+QINDEX(MP_QSTR_OrderedDict)
+QINDEX(MP_QSTR_convert)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_VCP_plus_MSC)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_dir)
+QINDEX(MP_QSTR_CMPLD1_COMPARATOR_LOAD_1_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_div)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_writeblocks)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_statistics_rois)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FRAMESIZE_WQXGA)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SystemExit)
+QINDEX(MP_QSTR_log)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_HC_ADCH_BF)
+QINDEX(MP_QSTR_grayscale_to_lab)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IN_PUP)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_hexlify)
+QINDEX(MP_QSTR_I25)
+QINDEX(MP_QSTR_out)
+QINDEX(MP_QSTR_LPI2C_SASR)
+QINDEX(MP_QSTR_doc)
+QINDEX(MP_QSTR_find_template)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_low)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_dot)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___floordiv__)
+QINDEX(MP_QSTR_D15_SCL)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_readinto)
+QINDEX(MP_QSTR_DMAEN_CA1DE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MCFGR2_BUSIDLE_BF)
+QINDEX(MP_QSTR_center)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_color_sigma)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_set_contrast)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_b_uq)
+QINDEX(MP_QSTR_EINVAL)
+QINDEX(MP_QSTR_I2C)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___reversed__)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_FONT_IMLIB)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_dma)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_MSR_BBF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_LPSPI_RSR)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CFG_ADLPC)
+QINDEX(MP_QSTR_readfrom_into)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_radians)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DMAMUX)
+QINDEX(MP_QSTR_TMR)
+QINDEX(MP_QSTR_match_db)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EOFError)
+QINDEX(MP_QSTR_SCTRL_TCF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_D13_CK)
+QINDEX(MP_QSTR_umachine)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_uniqueID)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_type)
+QINDEX(MP_QSTR_write_port)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_get_id)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_main_dot_py)
+QINDEX(MP_QSTR_x_translation)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_lcd)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_alloc_slot)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_issubclass)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_DONE2_ERR_IRQ_TRIG5_DONE2)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_read_timed_into)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_stream_stop)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_const)
+QINDEX(MP_QSTR_similarity)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR___contains__)
+QINDEX(MP_QSTR_ADC_OFS)
+QINDEX(MP_QSTR_rotation_deg)
+QINDEX(MP_QSTR_txdone)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPTCTRLB_EDGB1_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IER_TCIE)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_CAPT_CAPTURE_BF)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_EPERM)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_SIER_AM1F)
+QINDEX(MP_QSTR_morph)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTRnull)
+QINDEX(MP_QSTR_IOCTL_LEPTON_GET_WIDTH)
+QINDEX(MP_QSTR_SIER_BEIE)
+QINDEX(MP_QSTR_USBNC1)
+QINDEX(MP_QSTR_USBNC2)
+QINDEX(MP_QSTR_FRAMESIZE_XGA)
+QINDEX_END(2470)
+#endif
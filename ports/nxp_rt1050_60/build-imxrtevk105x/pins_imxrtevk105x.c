@@ -35,7 +35,7 @@
     .port = PORT_ ## p_port, \
     .pin = (p_pin), \
     .num_af = (sizeof(p_af) / sizeof(pin_af_obj_t)), \
-    .pin_mask = (1 << ((p_pin) & 0x0f)), \
+    .pin_mask = (1u << (p_pin)), \
     .gpio = GPIO ## p_port, \
     .af = p_af, \
     .adc_num = p_adc_num, \
@@ -0,0 +1,115 @@
+/*
+ * DCP crypto engine, backs uhashlib sha1/sha256, ucryptolib aes and the mbedtls port.
+ *
+ * Data goes to the DCP straight from where it is, SDRAM included: inputs are cleaned
+ * out of the D-cache first and outputs invalidated after. Only buffers the DCP can't
+ * take as they are (not word aligned) are moved through a small bounce buffer.
+ */
+#include <string.h>
+
+#include "py/mpconfig.h"
+#include "dma.h"
+#include "dcp.h"
+#include "extmod/crypto_hw.h"
+
+#define DCP_BOUNCE_SIZE     (256)
+
+dcp_handle_t dcp_hash_handle;
+static bool dcp_inited;
+
+void dcp_init(void)
+{
+    if (!dcp_inited) {
+        dcp_config_t config;
+        DCP_GetDefaultConfig(&config);
+        DCP_Init(DCP, &config);
+        dcp_hash_handle.channel = kDCP_Channel0;
+        dcp_hash_handle.keySlot = kDCP_KeySlot0;
+        dcp_inited = true;
+    }
+}
+
+const size_t mp_hw_hash_ctx_size = sizeof(dcp_hash_ctx_t);
+
+int mp_hw_hash_init(void *ctx, int algo)
+{
+    dcp_init();
+    // Every context points at the one handle, so copies of it stay valid.
+    return DCP_HASH_Init(DCP, &dcp_hash_handle, ctx, (algo == MP_HW_HASH_SHA1) ? kDCP_Sha1 : kDCP_Sha256) != kStatus_Success;
+}
+
+int mp_hw_hash_update(void *ctx, const uint8_t *buf, size_t len)
+{
+    // Whole blocks are read by the DCP from buf, the rest is copied into the context.
+    dma_begin_write(buf, len);
+    return DCP_HASH_Update(DCP, ctx, buf, len) != kStatus_Success;
+}
+
+int mp_hw_hash_final(void *ctx, uint8_t *out)
+{
+    size_t len = 32;
+    return DCP_HASH_Finish(DCP, ctx, out, &len) != kStatus_Success;
+}
+
+static status_t dcp_aes_run(dcp_handle_t *handle, uint32_t *iv, const uint8_t *in, uint8_t *out, size_t len, bool encrypt)
+{
+    // The next IV is the last cipher block, when decrypting in place it goes with in.
+    uint32_t next[4];
+    if (iv && !encrypt) {
+        memcpy(next, in + len - 16, 16);
+    }
+
+    dma_begin_write(in, len);
+    dma_begin_read(out, len);
+    status_t status;
+    if (iv == NULL) {
+        status = encrypt ? DCP_AES_EncryptEcb(DCP, handle, in, out, len) : DCP_AES_DecryptEcb(DCP, handle, in, out, len);
+    } else if (encrypt) {
+        status = DCP_AES_EncryptCbc(DCP, handle, in, out, len, (const uint8_t *)iv);
+    } else {
+        status = DCP_AES_DecryptCbc(DCP, handle, in, out, len, (const uint8_t *)iv);
+    }
+    dma_end_read(out, len);
+
+    if (iv) {
+        memcpy(iv, encrypt ? (const void *)(out + len - 16) : (const void *)next, 16);
+    }
+    return status;
+}
+
+int mp_hw_aes(const uint8_t key[16], uint8_t iv[16], const uint8_t *in, uint8_t *out, size_t len, bool encrypt)
+{
+    dcp_handle_t handle = { .channel = kDCP_Channel0, .keySlot = kDCP_PayloadKey };
+    uint32_t key_w[4], iv_w[4];
+    status_t status;
+
+    if (len == 0) {
+        return 0;
+    }
+    dcp_init();
+    memcpy(key_w, key, 16);
+    if (DCP_AES_SetKey(DCP, &handle, (const uint8_t *)key_w, 16) != kStatus_Success) {
+        return -1;
+    }
+    if (iv) {
+        memcpy(iv_w, iv, 16);
+    }
+
+    if ((((uintptr_t)in | (uintptr_t)out) & 3) == 0) {
+        status = dcp_aes_run(&handle, iv ? iv_w : NULL, in, out, len, encrypt);
+    } else {
+        uint32_t bounce[DCP_BOUNCE_SIZE / 4];
+        status = kStatus_Success;
+        for (size_t n; len && (status == kStatus_Success); in += n, out += n, len -= n) {
+            n = (len < DCP_BOUNCE_SIZE) ? len : DCP_BOUNCE_SIZE;
+            memcpy(bounce, in, n);
+            status = dcp_aes_run(&handle, iv ? iv_w : NULL, (const uint8_t *)bounce, (uint8_t *)bounce, n, encrypt);
+            memcpy(out, bounce, n);
+        }
+    }
+
+    if (iv) {
+        memcpy(iv, iv_w, 16);
+    }
+    return status != kStatus_Success;
+}
@@ -0,0 +1,11 @@
+/*
+ * DCP crypto engine, see dcp.c.
+ */
+#ifndef __DCP_H__
+#define __DCP_H__
+#include "fsl_dcp.h"
+
+// Shared by all hash contexts, they keep a pointer to it.
+extern dcp_handle_t dcp_hash_handle;
+void dcp_init(void);
+#endif // __DCP_H__
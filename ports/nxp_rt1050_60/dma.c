@@ -28,6 +28,7 @@
 #include <string.h>
 #include <stdint.h>
 #include "fsl_edma.h"
+#include "fsl_dmamux.h"
 #include "hal_wrapper.h"
 #include "dma.h"
 #include "py/obj.h"
@@ -86,4 +87,15 @@ void dma_idle_handler(uint32_t tick) {
 	}
 }
 
-#endif
\ No newline at end of file
+#endif
+
+void dma_edma_init(void) {
+	static bool inited = false;
+	if (!inited) {
+		edma_config_t config;
+		EDMA_GetDefaultConfig(&config);
+		EDMA_Init(DMA0, &config);
+		DMAMUX_Init(DMAMUX);
+		inited = true;
+	}
+}
@@ -28,6 +28,7 @@
 #define __MICROPY_INCLUDED_STMHAL_DMA_H__
 
 #include "fsl_edma.h"
+#include "fsl_cache.h"
 
 typedef union {
     uint32_t bmChnEn[2];
@@ -42,4 +43,59 @@ void dma_invalidate_channel(uint32_t dmaNdx, void *ph);
 // called from systick to process DMA idle timer
 void dma_idle_handler(uint32_t tick);
 
+// eDMA channels are given out statically, by peripheral.
+#define DMA_CH_LPSPI_RX(n)  ((n) * 2 - 2)   // LPSPI1-4: 0/1 .. 6/7
+#define DMA_CH_LPSPI_TX(n)  ((n) * 2 - 1)
+#define DMA_CH_PWM_PLAY     (8)             // pwm.c, FlexPWM value requests
+#define DMA_CH_PWM_LDOK     (9)             // linked from DMA_CH_PWM_PLAY, sets LDOK
+#define DMA_CH_RPM_CAPTURE  (10)            // rpm.c, QTIMER1 timer 3 capture
+#define DMA_CH_OVERLAY      (14)            // overlay_manager.c, memory to memory
+#define DMA_CH_ADC          (15)
+#define DMA_CH_LPUART_TX(n) (15 + (n))      // LPUART1-8: 16 .. 23
+#define DMA_CH_LPUART_RX(n) (23 + (n))      // 24 .. 31, circular without IRQ, adc.c owns 15/31's
+
+// Brings up eDMA and DMAMUX on first use, they then stay on.
+void dma_edma_init(void);
+
+// D-cache maintenance for memory shared with bus masters (CSI, PXP, LCDIF, USDHC).
+// Only the lines covering [addr, addr + size) are maintained, and memory the CPU does not
+// cache is skipped: ITCM/DTCM and the non-cacheable last MB of SDRAM (see BOARD_ConfigMPU()).
+#define DMA_CACHE_LINE_SIZE (FSL_FEATURE_L1DCACHE_LINESIZE_BYTE)
+// Static DMA buffers should not share cache lines with other data.
+#define DMA_BUF_ALIGN       __attribute__((aligned(DMA_CACHE_LINE_SIZE)))
+#define DMA_IS_CACHED(addr) (((uint32_t)(addr) >= 0x20200000) && \
+                            (((uint32_t)(addr) - 0x81F00000) >= 0x100000))
+
+// The CPU wrote the buffer and a bus master is about to read it.
+static inline void dma_begin_write(const void *addr, uint32_t size)
+{
+    if (size && DMA_IS_CACHED(addr)) {
+        DCACHE_CleanByRange((uint32_t) addr, size);
+    }
+}
+
+// A bus master is about to write the buffer. Lines it only partly covers are cleaned so
+// the neighbouring bytes survive, the others are dropped without being written back.
+static inline void dma_begin_read(void *addr, uint32_t size)
+{
+    if (size && DMA_IS_CACHED(addr)) {
+        uint32_t start = (uint32_t) addr, end = start + size;
+        if (start & (DMA_CACHE_LINE_SIZE - 1)) {
+            DCACHE_CleanByRange(start, 1);
+        }
+        if (end & (DMA_CACHE_LINE_SIZE - 1)) {
+            DCACHE_CleanByRange(end - 1, 1);
+        }
+        DCACHE_InvalidateByRange(start, size);
+    }
+}
+
+// The bus master is done writing, drop stale lines before the CPU reads the buffer.
+static inline void dma_end_read(void *addr, uint32_t size)
+{
+    if (size && DMA_IS_CACHED(addr)) {
+        DCACHE_InvalidateByRange((uint32_t) addr, size);
+    }
+}
+
 #endif //__MICROPY_INCLUDED_STMHAL_DMA_H__
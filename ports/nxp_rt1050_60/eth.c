@@ -0,0 +1,339 @@
+/*
+ * ENET with the board's KSZ8081 RMII PHY as an lwIP netif, polled through modlwip.
+ *
+ * Received frames go to lwIP in the buffers the MAC wrote them to. Every RX buffer has a
+ * pbuf_custom: the descriptor it leaves is re-armed with a spare buffer at once and lwIP
+ * freeing the pbuf puts the buffer back with the spares. A frame is dropped, its buffer
+ * re-armed, only while lwIP holds all the spares. Sent frames are copied into the TX
+ * descriptors' buffers, lwIP's headers are not on the alignment the MAC wants. The MAC
+ * inserts the IP, TCP, UDP and ICMP checksums of sent frames and discards the received ones
+ * whose checksums are wrong, lwipopts.h leaves them out of lwIP.
+ */
+#include <string.h>
+
+#include "py/mpconfig.h"
+#include "py/mphal.h"
+#include "board.h"
+#include "fsl_enet.h"
+#include "fsl_iomuxc.h"
+#include "dma.h"
+#include "eth.h"
+
+#include "lwip/pbuf.h"
+#include "lwip/stats.h"
+#include "lwip/igmp.h"
+#include "netif/etharp.h"
+
+#if MICROPY_PY_LWIP
+#define ETH_RX_RING             (8)
+#define ETH_RX_BUFS             (24)    // the ring's and the spares lent to lwIP
+#define ETH_TX_RING             (4)
+#define ETH_BUF_SIZE            (1536)  // a frame, on the buffer alignment
+#define ETH_BUF_ALIGN           (64)
+#define ETH_TX_TIMEOUT_MS       (10)
+#define ETH_PHY_TIMEOUT_MS      (100)
+#define ETH_LINK_POLL_MS        (500)
+#define ETH_PAD_CONFIG          (0xB0E9U)
+
+#define ETH_RX_ERR_MASK         (ENET_BUFFDESCRIPTOR_RX_TRUNC_MASK | ENET_BUFFDESCRIPTOR_RX_OVERRUN_MASK | \
+                                 ENET_BUFFDESCRIPTOR_RX_CRC_MASK | ENET_BUFFDESCRIPTOR_RX_NOOCTET_MASK | \
+                                 ENET_BUFFDESCRIPTOR_RX_LENVLIOLATE_MASK)
+
+// KSZ8081 registers.
+#define PHY_BMCR                (0x00)
+#define PHY_BMSR                (0x01)
+#define PHY_CTRL1               (0x1E)
+#define PHY_CTRL2               (0x1F)
+#define PHY_BMCR_RESET          (0x8000)
+#define PHY_BMCR_ANEG_EN        (0x1000)
+#define PHY_BMCR_ANEG_RESTART   (0x0200)
+#define PHY_BMSR_LINK           (0x0004)
+#define PHY_CTRL1_100M          (0x0002)    // of the operation mode in bits 2..0
+#define PHY_CTRL1_FULL_DUPLEX   (0x0004)
+#define PHY_CTRL2_REFCLK_50M    (0x0080)
+
+typedef struct _eth_rx_buf_t {
+    struct pbuf_custom p;   // first, lwIP frees it as the pbuf
+    uint8_t *data;
+    struct _eth_rx_buf_t *next;
+} eth_rx_buf_t;
+
+AT_NONCACHEABLE_SECTION_ALIGN(static volatile enet_rx_bd_struct_t eth_rx_bd[ETH_RX_RING], ETH_BUF_ALIGN);
+AT_NONCACHEABLE_SECTION_ALIGN(static volatile enet_tx_bd_struct_t eth_tx_bd[ETH_TX_RING], ETH_BUF_ALIGN);
+static uint8_t eth_rx_data[ETH_RX_BUFS][ETH_BUF_SIZE] __attribute__((aligned(ETH_BUF_ALIGN)));
+static uint8_t eth_tx_data[ETH_TX_RING][ETH_BUF_SIZE] __attribute__((aligned(ETH_BUF_ALIGN)));
+
+static enet_handle_t eth_handle;
+static eth_rx_buf_t eth_rx_bufs[ETH_RX_BUFS];
+static eth_rx_buf_t *eth_rx_ring[ETH_RX_RING];  // the buffer of each RX descriptor
+static eth_rx_buf_t *eth_rx_spare;
+static int eth_rx_next, eth_tx_next;
+static uint32_t eth_link_ticks;
+
+static void eth_rx_buf_free(struct pbuf *p)
+{
+    eth_rx_buf_t *buf = (eth_rx_buf_t *) p;
+    buf->next = eth_rx_spare;
+    eth_rx_spare = buf;
+}
+
+static void eth_rx_arm(int i, eth_rx_buf_t *buf)
+{
+    // lwIP may have left dirty lines in the buffer, they must not be written back over a frame.
+    dma_begin_read(buf->data, ETH_BUF_SIZE);
+    eth_rx_ring[i] = buf;
+    eth_rx_bd[i].buffer = buf->data;
+    eth_rx_bd[i].length = 0;
+    __DMB();
+    eth_rx_bd[i].control = ENET_BUFFDESCRIPTOR_RX_EMPTY_MASK | ((i == (ETH_RX_RING - 1)) ? ENET_BUFFDESCRIPTOR_RX_WRAP_MASK : 0);
+    __DSB();
+    ENET_ActiveRead(ENET);
+}
+
+static void eth_rx(struct netif *netif)
+{
+    for (int n = 0; n < ETH_RX_RING; n++) {
+        int i = eth_rx_next;
+        uint16_t control = eth_rx_bd[i].control;
+        if (control & ENET_BUFFDESCRIPTOR_RX_EMPTY_MASK) {
+            break;
+        }
+
+        eth_rx_next = (i + 1) % ETH_RX_RING;
+        eth_rx_buf_t *buf = eth_rx_ring[i];
+        uint16_t len = eth_rx_bd[i].length;
+
+        // A frame always fits a buffer, so it is the last of its frame.
+        if ((control & ETH_RX_ERR_MASK) || (!(control & ENET_BUFFDESCRIPTOR_RX_LAST_MASK)) || (eth_rx_spare == NULL)) {
+            LINK_STATS_INC(link.drop);
+            eth_rx_arm(i, buf);
+            continue;
+        }
+
+        eth_rx_buf_t *spare = eth_rx_spare;
+        eth_rx_spare = spare->next;
+        eth_rx_arm(i, spare);
+
+        // Lines read in speculatively while the MAC wrote.
+        dma_end_read(buf->data, len);
+        struct pbuf *p = pbuf_alloced_custom(PBUF_RAW, len, PBUF_REF, &buf->p, buf->data, ETH_BUF_SIZE);
+        LINK_STATS_INC(link.recv);
+        if (netif->input(p, netif) != ERR_OK) {
+            pbuf_free(p);
+        }
+    }
+}
+
+static err_t eth_linkoutput(struct netif *netif, struct pbuf *p)
+{
+    int i = eth_tx_next;
+    if (p->tot_len > ETH_BUF_SIZE) {
+        LINK_STATS_INC(link.lenerr);
+        return ERR_BUF;
+    }
+
+    // A full frame is on the wire in 120 us at 100 Mbit/s.
+    for (mp_uint_t t0 = mp_hal_ticks_ms(); eth_tx_bd[i].control & ENET_BUFFDESCRIPTOR_TX_READY_MASK; ) {
+        if ((mp_hal_ticks_ms() - t0) > ETH_TX_TIMEOUT_MS) {
+            LINK_STATS_INC(link.drop);
+            return ERR_TIMEOUT;
+        }
+    }
+
+    uint8_t *data = eth_tx_data[i];
+    pbuf_copy_partial(p, data, p->tot_len, 0);
+    dma_begin_write(data, p->tot_len);
+    eth_tx_bd[i].buffer = data;
+    eth_tx_bd[i].length = p->tot_len;
+    __DMB();
+    eth_tx_bd[i].control = ENET_BUFFDESCRIPTOR_TX_READY_MASK | ENET_BUFFDESCRIPTOR_TX_LAST_MASK |
+        ENET_BUFFDESCRIPTOR_TX_TRANMITCRC_MASK | ((i == (ETH_TX_RING - 1)) ? ENET_BUFFDESCRIPTOR_TX_WRAP_MASK : 0);
+    __DSB();
+    ENET->TDAR = ENET_TDAR_TDAR_MASK;
+
+    eth_tx_next = (i + 1) % ETH_TX_RING;
+    LINK_STATS_INC(link.xmit);
+    return ERR_OK;
+}
+
+static bool eth_smi_wait(void)
+{
+    for (mp_uint_t t0 = mp_hal_ticks_ms(); !(ENET_GetInterruptStatus(ENET) & kENET_MiiInterrupt); ) {
+        if ((mp_hal_ticks_ms() - t0) > ETH_PHY_TIMEOUT_MS) {
+            return false;
+        }
+    }
+    ENET_ClearInterruptStatus(ENET, kENET_MiiInterrupt);
+    return true;
+}
+
+static uint32_t eth_phy_read(uint32_t reg)
+{
+    ENET_ClearInterruptStatus(ENET, kENET_MiiInterrupt);
+    ENET_StartSMIRead(ENET, BOARD_ENET0_PHY_ADDRESS, reg, kENET_MiiReadValidFrame);
+    // With no PHY the data line floats high, as for a PHY in reset.
+    return eth_smi_wait() ? ENET_ReadSMIData(ENET) : 0xFFFF;
+}
+
+static void eth_phy_write(uint32_t reg, uint32_t data)
+{
+    ENET_ClearInterruptStatus(ENET, kENET_MiiInterrupt);
+    ENET_StartSMIWrite(ENET, BOARD_ENET0_PHY_ADDRESS, reg, kENET_MiiWriteValidFrame, data);
+    eth_smi_wait();
+}
+
+static bool eth_phy_init(void)
+{
+    eth_phy_write(PHY_BMCR, PHY_BMCR_RESET);
+    for (mp_uint_t t0 = mp_hal_ticks_ms(); eth_phy_read(PHY_BMCR) & PHY_BMCR_RESET; ) {
+        if ((mp_hal_ticks_ms() - t0) > ETH_PHY_TIMEOUT_MS) {
+            return false;
+        }
+    }
+    // The RT1050 drives the 50 MHz reference clock.
+    eth_phy_write(PHY_CTRL2, eth_phy_read(PHY_CTRL2) | PHY_CTRL2_REFCLK_50M);
+    eth_phy_write(PHY_BMCR, PHY_BMCR_ANEG_EN | PHY_BMCR_ANEG_RESTART);
+    return true;
+}
+
+// The MAC and PHY follow the link, auto negotiation gives its speed and duplex.
+static void eth_link_poll(struct netif *netif)
+{
+    if ((mp_hal_ticks_ms() - eth_link_ticks) < ETH_LINK_POLL_MS) {
+        return;
+    }
+    eth_link_ticks = mp_hal_ticks_ms();
+
+    // The link status latches low, the second read is the current one.
+    eth_phy_read(PHY_BMSR);
+    bool up = eth_phy_read(PHY_BMSR) & PHY_BMSR_LINK;
+    if (up && (!netif_is_link_up(netif))) {
+        uint32_t ctrl1 = eth_phy_read(PHY_CTRL1);
+        ENET_SetMII(ENET, (ctrl1 & PHY_CTRL1_100M) ? kENET_MiiSpeed100M : kENET_MiiSpeed10M,
+            (ctrl1 & PHY_CTRL1_FULL_DUPLEX) ? kENET_MiiFullDuplex : kENET_MiiHalfDuplex);
+        netif_set_link_up(netif);
+    } else if ((!up) && netif_is_link_up(netif)) {
+        netif_set_link_down(netif);
+    }
+}
+
+// RMII pins of the EVK's PHY. Its reset pin is also the user LED, the PHY is reset over MDIO.
+static void eth_init_pins(void)
+{
+    CLOCK_EnableClock(kCLOCK_Iomuxc);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_B1_04_ENET_RX_DATA00, 0);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_B1_05_ENET_RX_DATA01, 0);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_B1_06_ENET_RX_EN, 0);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_B1_07_ENET_TX_DATA00, 0);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_B1_08_ENET_TX_DATA01, 0);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_B1_09_ENET_TX_EN, 0);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_B1_10_ENET_REF_CLK, 1);   // the clock driven is also read back
+    IOMUXC_SetPinMux(IOMUXC_GPIO_B1_11_ENET_RX_ER, 0);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_EMC_40_ENET_MDC, 0);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_EMC_41_ENET_MDIO, 0);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_B1_04_ENET_RX_DATA00, ETH_PAD_CONFIG);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_B1_05_ENET_RX_DATA01, ETH_PAD_CONFIG);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_B1_06_ENET_RX_EN, ETH_PAD_CONFIG);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_B1_07_ENET_TX_DATA00, ETH_PAD_CONFIG);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_B1_08_ENET_TX_DATA01, ETH_PAD_CONFIG);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_B1_09_ENET_TX_EN, ETH_PAD_CONFIG);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_B1_10_ENET_REF_CLK, 0x31U);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_B1_11_ENET_RX_ER, ETH_PAD_CONFIG);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_EMC_40_ENET_MDC, ETH_PAD_CONFIG);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_EMC_41_ENET_MDIO, ETH_PAD_CONFIG);
+}
+
+#if LWIP_IGMP
+// The MAC filters multicast by a hash, leaving a group leaves the others of its bit too.
+static err_t eth_igmp_mac_filter(struct netif *netif, ip_addr_t *group, u8_t action)
+{
+    uint8_t mac[6] = { 0x01, 0x00, 0x5E, ip4_addr2(group) & 0x7F, ip4_addr3(group), ip4_addr4(group) };
+    if (action == IGMP_ADD_MAC_FILTER) {
+        ENET_AddMulticastGroup(ENET, mac);
+    } else {
+        ENET_LeaveMulticastGroup(ENET, mac);
+    }
+    return ERR_OK;
+}
+#endif
+
+// The fused MAC address, a locally administered one from the chip's unique ID without it.
+static void eth_mac_addr(uint8_t *mac)
+{
+    uint32_t lo = OCOTP->MAC0, hi = OCOTP->MAC1 & 0xFFFF;
+    if ((lo == 0) && (hi == 0)) {
+        lo = OCOTP->CFG0 ^ OCOTP->CFG1;
+        hi = 0x0200 | ((OCOTP->CFG1 >> 16) & 0xFC);
+    }
+    mac[0] = hi >> 8;
+    mac[1] = hi;
+    mac[2] = lo >> 24;
+    mac[3] = lo >> 16;
+    mac[4] = lo >> 8;
+    mac[5] = lo;
+}
+
+err_t eth_netif_init(struct netif *netif)
+{
+    netif->name[0] = 'e';
+    netif->name[1] = 't';
+    netif->output = etharp_output;
+    netif->linkoutput = eth_linkoutput;
+    netif->mtu = 1500;
+    netif->hwaddr_len = ETHARP_HWADDR_LEN;
+    netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET;
+    #if LWIP_IGMP
+    netif->flags |= NETIF_FLAG_IGMP;
+    netif->igmp_mac_filter = eth_igmp_mac_filter;
+    #endif
+    eth_mac_addr(netif->hwaddr);
+
+    eth_init_pins();
+    const clock_enet_pll_config_t pll_config = {
+        .enableClkOutput0 = true,
+        .loopDivider0 = 1,  // 50 MHz
+    };
+    CLOCK_InitEnetPll(&pll_config);
+    IOMUXC_EnableMode(IOMUXC_GPR, kIOMUXC_GPR_ENET1TxClkOutputDir, true);
+
+    enet_config_t config;
+    ENET_GetDefaultConfig(&config);
+    config.rxAccelerConfig = kENET_RxAccelIpCheckEnabled | kENET_RxAccelProtoCheckEnabled |
+        kENET_RxAccelMacCheckEnabled | kENET_RxAccelPadRemoveEnabled;
+    config.txAccelerConfig = kENET_TxAccelIpCheckEnabled | kENET_TxAccelProtoCheckEnabled;
+    const enet_buffer_config_t buffer_config = {
+        .rxBdNumber = ETH_RX_RING,
+        .txBdNumber = ETH_TX_RING,
+        .rxBuffSizeAlign = ETH_BUF_SIZE,
+        .txBuffSizeAlign = ETH_BUF_SIZE,
+        .rxBdStartAddrAlign = eth_rx_bd,
+        .txBdStartAddrAlign = eth_tx_bd,
+        .rxBufferAlign = eth_rx_data[0],
+        .txBufferAlign = eth_tx_data[0],
+    };
+    ENET_Init(ENET, &eth_handle, &config, &buffer_config, netif->hwaddr, CLOCK_GetFreq(kCLOCK_IpgClk));
+
+    // The first buffers to the ring, the others are the spares.
+    eth_rx_spare = NULL;
+    for (int i = ETH_RX_BUFS - 1; i >= 0; i--) {
+        eth_rx_bufs[i].p.custom_free_function = eth_rx_buf_free;
+        eth_rx_bufs[i].data = eth_rx_data[i];
+        if (i < ETH_RX_RING) {
+            eth_rx_arm(i, eth_rx_bufs + i);
+        } else {
+            eth_rx_buf_free(&eth_rx_bufs[i].p.pbuf);
+        }
+    }
+    eth_rx_next = 0;
+    eth_tx_next = 0;
+    eth_link_ticks = mp_hal_ticks_ms() - ETH_LINK_POLL_MS;
+
+    return eth_phy_init() ? ERR_OK : ERR_IF;
+}
+
+void eth_netif_poll(void *netif)
+{
+    eth_link_poll(netif);
+    eth_rx(netif);
+}
+#endif // MICROPY_PY_LWIP
@@ -0,0 +1,11 @@
+/*
+ * ENET as an lwIP netif, see eth.c.
+ */
+#ifndef __ETH_H__
+#define __ETH_H__
+#include "lwip/netif.h"
+
+// The init function of netif_add() and the poll modlwip runs for the interface.
+err_t eth_netif_init(struct netif *netif);
+void eth_netif_poll(void *netif);
+#endif // __ETH_H__
@@ -40,3 +40,37 @@ DWORD get_fattime(void) {
     return ((2000 - 1980 + 17) << 25) | (8) << 21 | ((15) << 16) | ((23) << 11) | ((34) << 5) | (45 / 2);
     #endif
 }
+
+#if FF_FS_REENTRANT
+// One lock for all volumes. A thread waiting for it drops the GIL, the holder may need the
+// GIL back to finish (it is released during SD transfers).
+STATIC mp_thread_mutex_t fatfs_mutex;
+
+int ff_cre_syncobj(FATFS *fatfs, FF_SYNC_t *sobj) {
+    (void)fatfs;
+    *sobj = &fatfs_mutex;
+    return 1;
+}
+
+int ff_del_syncobj(FF_SYNC_t sobj) {
+    (void)sobj;
+    return 1;
+}
+
+int ff_req_grant(FF_SYNC_t sobj) {
+    if (!mp_thread_is_python()) {
+        return mp_thread_mutex_lock(sobj, 1);
+    }
+    if (mp_thread_mutex_lock(sobj, 0)) {
+        return 1;
+    }
+    MP_THREAD_GIL_EXIT();
+    mp_thread_mutex_lock(sobj, 1);
+    MP_THREAD_GIL_ENTER();
+    return 1;
+}
+
+void ff_rel_grant(FF_SYNC_t sobj) {
+    mp_thread_mutex_unlock(sobj);
+}
+#endif
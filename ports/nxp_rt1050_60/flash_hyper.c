@@ -7,6 +7,7 @@
 #include "fsl_common.h"
 #include "flegftl_cfg.h"
 #include "overlay_manager.h"
+#include "perf_profile.h"
 
 /*******************************************************************************
 * Definitions
@@ -275,7 +276,7 @@ status_t flexspi_nor_wait_bus_busy(FLEXSPI_Type *base)
 }
 
 #define DIV_ERASE_PGM	4
-#define DIV_READ		0
+#define DIV_READ		perf_flexspi_div // 0 unless omv.set_perf_profile() changed it
 static void SetFlexSPIDiv(uint32_t div)
 {
 	FLEXSPI_Type *base = FLEXSPI;
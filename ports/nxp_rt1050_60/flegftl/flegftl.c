@@ -121,6 +121,130 @@ typedef union _logBatch_t
 	uint8_t log[32];	// log units for 128KB and 64KB EU size, 8 bit per PU index
 }logBatch_t;
 
+int _ReadEUlog(FlegDevice_t *pDev, uint32_t peu, Fleg_LPUmap_t *pMap);
+void _ReadMeta(FlegDevice_t *pDev, int peu, FlegMeta_t *pMeta);
+
+#if FLEG_MAP_CACHE_CNT > 0
+// >>> LRU cache of parsed EU logs, saves scanning the log in flash for every page read.
+// Entries are kept in step with the log by FLEG_AppendLog() and dropped when the PEU is erased.
+Fleg_MapCache_t *_MapCacheFind(FlegDevice_t *pDev, uint32_t peu) {
+	uint32_t i;
+	for (i = 0; i < FLEG_MAP_CACHE_CNT; i++) {
+		if (pDev->mapCache[i].lruTick && pDev->mapCache[i].map.peuNdx == peu)
+			return &pDev->mapCache[i];
+	}
+	return 0;
+}
+
+Fleg_MapCache_t *_MapCacheGet(FlegDevice_t *pDev, uint32_t peu) {
+	uint32_t i;
+	FlegMeta_t meta;
+	Fleg_MapCache_t *pEnt = _MapCacheFind(pDev, peu);
+	if (pEnt) {
+		pDev->stat.mapCacheHitCnt++;
+	}
+	else {
+		// parse the log into the least recently used slot
+		pEnt = &pDev->mapCache[0];
+		for (i = 1; i < FLEG_MAP_CACHE_CNT && pEnt->lruTick; i++) {
+			if (pDev->mapCache[i].lruTick == 0 || pDev->mapCache[i].lruTick - pEnt->lruTick >= 0x80000000)
+				pEnt = &pDev->mapCache[i];
+		}
+		_ReadMeta(pDev, peu, &meta);
+		_ReadEUlog(pDev, peu, &pEnt->map);
+		pEnt->map.peuNdx = (uint16_t)peu;
+		pEnt->peuDst = meta.peuDst;
+		pDev->stat.mapCacheMissCnt++;
+	}
+	if (++pDev->mapCacheTick == 0)
+		pDev->mapCacheTick = 1;	// 0 marks unused slots
+	pEnt->lruTick = pDev->mapCacheTick;
+	return pEnt;
+}
+
+void _MapCacheDrop(FlegDevice_t *pDev, uint32_t peu) {
+	Fleg_MapCache_t *pEnt = _MapCacheFind(pDev, peu);
+	if (pEnt)
+		pEnt->lruTick = 0;
+}
+
+void _MapCacheSetDst(FlegDevice_t *pDev, uint32_t peu, uint16_t peuDst) {
+	Fleg_MapCache_t *pEnt = _MapCacheFind(pDev, peu);
+	if (pEnt)
+		pEnt->peuDst = peuDst;
+}
+// <<<
+#endif
+
+#if FLEG_CKPT
+// >>> mount checkpoints. Every PEU is journaled before its meta is programmed or it is erased,
+// so the newest checkpoint plus rescanning the journaled PEUs gives what FLEG_DeviceScan() would
+#define _CKPT_PAYLOAD(pDev)			((uint8_t*)&(pDev)->bmVrgn)
+#define _CKPT_PAYLOAD_SIZE(pDev)	((uint32_t)((uint8_t*)&(pDev)->peuErsCnts[FLEG_PEU_CNT] - _CKPT_PAYLOAD(pDev)))
+#define _CKPT_SLOT_CNT(pDev)		((pDev)->euSize / (pDev)->pageSize / FLEG_CKPT_SLOT_PAGES)
+#define _CKPT_SLOT_OFS(pDev, slot)	(FLEG_CKPT_EU * (pDev)->euSize + (slot) * FLEG_CKPT_SLOT_PAGES * (pDev)->pageSize)
+
+uint32_t _Crc32(uint32_t crc, const void *pvDat, uint32_t cnt) {
+	const uint8_t *p = (const uint8_t*)pvDat;
+	uint32_t i;
+	crc = ~crc;
+	while (cnt--) {
+		crc ^= *p++;
+		for (i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+	}
+	return ~crc;
+}
+
+uint32_t _CkptCrc(const FlegCkptHdr_t *pHdr, const uint8_t *pPayload) {
+	uint32_t ofs = FLEG_GET_FIELD_OFS(seqNum, FlegCkptHdr_t);
+	uint32_t crc = _Crc32(0, (const uint8_t*)pHdr + ofs, sizeof(FlegCkptHdr_t) - ofs);
+	return _Crc32(crc, pPayload, pHdr->payloadSize);
+}
+
+// write the maps in RAM as the newest checkpoint, its journal starts empty
+int _CkptWrite(FlegDevice_t *pDev) {
+	FlegCkptHdr_t hdr;
+	uint32_t i, byteOfs, pgCnt, size = _CKPT_PAYLOAD_SIZE(pDev);
+	FLEGASSERT(size <= (FLEG_CKPT_SLOT_PAGES - 1) * pDev->pageSize);
+	if (pDev->ckptFreeSlot >= _CKPT_SLOT_CNT(pDev)) {
+		// start over, a reset before the new checkpoint is written just finds none
+		pDev->ops.pfnErs(FLEG_CKPT_EU);
+		pDev->ckptFreeSlot = 0;
+	}
+	hdr.magic = FLEG_CKPT_MAGIC;
+	hdr.seqNum = pDev->ckptSeq + 1;
+	hdr.lazyPEU = pDev->lazyPEU, hdr.bkupPEU = pDev->bkupPEU;
+	hdr.payloadSize = size;
+	hdr.crc = _CkptCrc(&hdr, _CKPT_PAYLOAD(pDev));
+	// payload first, the header makes the slot count
+	byteOfs = _CKPT_SLOT_OFS(pDev, pDev->ckptFreeSlot);
+	for (i = 0; i < size; i += pgCnt) {
+		pgCnt = size - i < pDev->pageSize ? size - i : pDev->pageSize;
+		pDev->ops.pfnPagePgm((byteOfs + pDev->pageSize + i) / pDev->pageSize, 0, pgCnt, _CKPT_PAYLOAD(pDev) + i);
+	}
+	pDev->ops.pfnPagePgm(byteOfs / pDev->pageSize, 0, sizeof(hdr), &hdr);
+	pDev->ckptSeq = hdr.seqNum;
+	pDev->ckptSlot = pDev->ckptFreeSlot++;
+	pDev->ckptJrnlCnt = 0;
+	pDev->stat.ckptWrCnt++;
+	return 0;
+}
+
+// journal a PEU whose meta is about to change, before it is programmed or erased
+void _CkptTouch(FlegDevice_t *pDev, uint32_t peu) {
+	uint16_t peu16 = (uint16_t)peu;
+	uint32_t byteOfs;
+	if (pDev->ckptSlot >= _CKPT_SLOT_CNT(pDev) || pDev->ckptJrnlCnt >= FLEG_CKPT_JRNL_CNT)
+		_CkptWrite(pDev);
+	byteOfs = _CKPT_SLOT_OFS(pDev, pDev->ckptSlot) + FLEG_CKPT_JRNL_OFS + 2 * pDev->ckptJrnlCnt++;
+	pDev->ops.pfnPagePgm(byteOfs / pDev->pageSize, byteOfs % pDev->pageSize, 2, &peu16);
+}
+// <<<
+#else
+#define _CkptTouch(pDev, peu)
+#endif
+
 int _FindPPUNdx(FlegDevice_t *pDev, uint32_t lpuNdx, uint32_t peu) {
 	uint32_t byteOfs;
 	uint32_t batchNdx, batchCnt, logPerBatch, i;
@@ -168,17 +292,36 @@ int FLEG_PageRead(FlegDevice_t *pDev, uint32_t lpu, void *pvBuf) {
 	uint32_t ppu = pDev->ppuPerEU;
 	uint16_t peuDst;
 	int ret = -1L;
+	if (peu >= pDev->euCnt) {
+		// LEU never written
+		memset(pvBuf, 0xFFFFFFFF, pDev->pageSize);
+		return 1;
+	}
+#if FLEG_MAP_CACHE_CNT > 0
+	if (peu == pDev->lazyPEU) {
+		// check if the lpu has moved
+		peuDst = _MapCacheGet(pDev, peu)->peuDst;
+		ppu = _MapCacheGet(pDev, peuDst)->map.lpuMap[lpuNdx];
+		if (ppu < pDev->ppuPerEU)
+			peu = peuDst;
+	}
+	if (ppu >= pDev->ppuPerEU) {
+		ppu = _MapCacheGet(pDev, peu)->map.lpuMap[lpuNdx];
+	}
+#else
 	if (peu == pDev->lazyPEU) {
 		// check if the lpu has moved
 		
 		uint32_t byteOfs = peu * pDev->euSize + FLEG_GET_FIELD_OFS(peuDst, FlegMeta_t);
 		pDev->ops.pfnRead(byteOfs, &peuDst, 2);
 		ppu = _FindPPUNdx(pDev, lpuNdx, peuDst);
-		peu = peuDst;
+		if (ppu < pDev->ppuPerEU)
+			peu = peuDst;
 	}
 	if (ppu >= pDev->ppuPerEU) {
 		ppu = _FindPPUNdx(pDev, lpuNdx, peu);
 	}
+#endif
 	if (ppu >= pDev->ppuPerEU) {
 		memset(pvBuf, 0xFFFFFFFF, pDev->pageSize);
 		ret = 1;
@@ -210,7 +353,7 @@ void _ReadMeta(FlegDevice_t *pDev, int peu, FlegMeta_t *pMeta) {
 	pDev->ops.pfnRead(byteOfs, pMeta, sizeof(FlegMeta_t));
 }
 
-int _ParseEUlog(FlegDevice_t *pDev, uint32_t peu, Fleg_LPUmap_t *pMap) {
+int _ReadEUlog(FlegDevice_t *pDev, uint32_t peu, Fleg_LPUmap_t *pMap) {
 	uint32_t byteOfs;
 	uint32_t batchNdx, batchCnt, logPerBatch, i;
 	uint32_t lpuNdx, ppuNdx = 0;
@@ -263,6 +406,29 @@ Cleanup:
 	return 0;
 }
 
+int _ParseEUlog(FlegDevice_t *pDev, uint32_t peu, Fleg_LPUmap_t *pMap) {
+#if FLEG_MAP_CACHE_CNT > 0
+	memcpy(pMap, &_MapCacheGet(pDev, peu)->map, sizeof(Fleg_LPUmap_t));
+	return 0;
+#else
+	return _ReadEUlog(pDev, peu, pMap);
+#endif
+}
+
+void _MapCacheLog(FlegDevice_t *pDev, uint32_t peu, uint32_t lpuNdx, uint32_t ppuNdx) {
+#if FLEG_MAP_CACHE_CNT > 0
+	// apply the new log item to the cached map the way _ReadEUlog() would parse it
+	Fleg_MapCache_t *pEnt = _MapCacheFind(pDev, peu);
+	if (pEnt) {
+		if (FLEG_L1BmAryTake(pEnt->map.bmsVrgnPPU, ppuNdx))
+			pEnt->map.vrgnPPUcnt--;
+		if (pEnt->map.lpuMap[lpuNdx] >= pDev->ppuPerEU)
+			pEnt->map.inuseLPUcnt++;
+		pEnt->map.lpuMap[lpuNdx] = ppuNdx;
+	}
+#endif
+}
+
 int FLEG_AppendLog(FlegDevice_t *pDev, uint32_t peu, uint32_t lpuNdx, uint32_t ppuNdx, Fleg_LPUmap_t *pMap) {
 	uint32_t byteOfs;
 	byteOfs = pDev->euSize * peu + _FLEG_MAPLOG_OFS;
@@ -275,6 +441,32 @@ int FLEG_AppendLog(FlegDevice_t *pDev, uint32_t peu, uint32_t lpuNdx, uint32_t p
 	pDev->ops.pfnPagePgm(byteOfs / pDev->pageSize, byteOfs % pDev->pageSize, 
 		pDev->euSize >= 256 * 1024 ? 2 : 1, &lpuNdx);
 	pMap->lpuMap[lpuNdx] = ppuNdx;
+	_MapCacheLog(pDev, peu, lpuNdx, ppuNdx);
+	return 0;
+}
+
+// log cnt consecutive LPUs written to consecutive PPUs, one program per flash page of log
+// instead of one per item. Items are built in pageBuf, so cnt is at most a page of them
+int FLEG_AppendLogs(FlegDevice_t *pDev, uint32_t peu, uint32_t lpuNdx, uint32_t ppuNdx, uint32_t cnt, Fleg_LPUmap_t *pMap) {
+	uint32_t i, byteOfs, byteCnt, pgCnt, itemSize = pDev->euSize >= 256 * 1024 ? 2 : 1;
+	uint16_t *pLog16 = (uint16_t*)pDev->pageBuf;
+	FLEGASSERT(cnt * itemSize <= pDev->pageSize);
+	for (i = 0; i < cnt; i++) {
+		if (itemSize == 2)
+			pLog16[i] = (uint16_t)(lpuNdx + i);
+		else
+			pDev->pageBuf[i] = (uint8_t)(lpuNdx + i);
+		pMap->lpuMap[lpuNdx + i] = ppuNdx + i;
+		_MapCacheLog(pDev, peu, lpuNdx + i, ppuNdx + i);
+	}
+	byteOfs = pDev->euSize * peu + _FLEG_MAPLOG_OFS + itemSize * ppuNdx;
+	for (i = 0, byteCnt = cnt * itemSize; i < byteCnt; i += pgCnt, byteOfs += pgCnt) {
+		// the log area may span flash pages
+		pgCnt = pDev->pageSize - byteOfs % pDev->pageSize;
+		if (pgCnt > byteCnt - i)
+			pgCnt = byteCnt - i;
+		pDev->ops.pfnPagePgm(byteOfs / pDev->pageSize, byteOfs % pDev->pageSize, pgCnt, pDev->pageBuf + i);
+	}
 	return 0;
 }
 
@@ -331,6 +523,7 @@ int __ClaimOrTakePEU(
 			isErase = 0;	// no need to erase virgin PEU ---- already virgin
 		}
 	}
+	_CkptTouch(pDev, peu);
 	_ReadMeta(pDev, peu, &meta);
 	meta.peuDst = meta.peuSrc = meta.leuNdx = meta.seqNum = 0xFFFF;
 	if (leu < pDev->euCnt) {
@@ -343,6 +536,9 @@ int __ClaimOrTakePEU(
 	if (isErase) {
 		pDev->peuErsCnts[peu] = ++meta.ersCnt;
 		pDev->ops.pfnErs(peu);
+#if FLEG_MAP_CACHE_CNT > 0
+		_MapCacheDrop(pDev, peu);
+#endif
 		pDev->stat.peuErsCnt++;
 	}
 
@@ -353,6 +549,17 @@ int __ClaimOrTakePEU(
 	return peu;
 }
 
+// after a garbage PEU is claimed, schedule a wear balance if in-use PEUs fall too far behind
+void _CheckWearBalance(FlegDevice_t *pDev) {
+	if (pDev->balanceDelta > (int)(FLEG_WB_THRESHOLD + pDev->wbTolerance)) {
+		pDev->isToWB = 1;
+	}
+	else {
+		if (pDev->wbTolerance > 0)
+			pDev->wbTolerance--;
+	}
+}
+
 int _ClaimGarbagePEU(FlegDevice_t *pDev, int peu) {
 	return __ClaimOrTakePEU(pDev, (uint32_t)-1L, peu, 0);
 }
@@ -392,16 +599,31 @@ void _InitLazyMoveContext(FlegPageWrCtx_t *pCtx, uint32_t peuDst) {
 				pCtx->lazySrc.lpuMap[lpuIter] = (pundx_t)pDev->ppuPerEU;
 				pCtx->lazySrc.inuseLPUcnt--;
 			}
+#if FLEG_TRIM
+			else if (pCtx->lazySrc.lpuMap[lpuIter] < pDev->ppuPerEU &&
+				FLEG_L1BmAryIsFree(pDev->bmTrim, pCtx->srcMeta.leuNdx * pDev->lpuPerEU + lpuIter))
+			{
+				// trimmed, nobody reads it any more, so it needs no seat in dstPEU
+				FLEG_L1BmAryFree(pCtx->lazySrc.bmsGrbgLPU, lpuIter);
+				pCtx->lazySrc.lpuMap[lpuIter] = (pundx_t)pDev->ppuPerEU;
+				pCtx->lazySrc.inuseLPUcnt--;
+				pDev->stat.trimSkipCnt++;
+			}
+#endif
 		}
 	}
 }
 
 int _BeginLazyMove(FlegPageWrCtx_t *pCtx, uint32_t peuSrc) {
+	_CkptTouch(pCtx->pDev, peuSrc);
 	pCtx->srcMeta.peuDst = pCtx->pDev->bkupPEU;
 	pCtx->pDev->lazyPEU = peuSrc;
 	uint32_t byteOfs = peuSrc * pCtx->pDev->euSize;
 	uint32_t pageNum = byteOfs / pCtx->pDev->pageSize;
 	pCtx->pDev->ops.pfnPagePgm(pageNum, 0, sizeof(pCtx->srcMeta), &pCtx->srcMeta);
+#if FLEG_MAP_CACHE_CNT > 0
+	_MapCacheSetDst(pCtx->pDev, peuSrc, pCtx->srcMeta.peuDst);
+#endif
 	pCtx->pDev->stat.lazyMoveCnt++;
 	return 0;
 }
@@ -426,12 +648,16 @@ int _BeginLazyMove(FlegPageWrCtx_t *pCtx, uint32_t peuSrc) {
 int _FlushLazyMove(FlegPageWrCtx_t *pCtx);
 int _EndLazyMove(FlegPageWrCtx_t *pCtx) {
 	FlegDevice_t *pDev = pCtx->pDev;
+	_CkptTouch(pDev, pCtx->lazyDst.peuNdx);
 	pCtx->dstMeta.peuSrc = pCtx->lazySrc.peuNdx;
 	uint32_t byteOfs = pCtx->lazyDst.peuNdx * pDev->euSize;
 	pCtx->dstMeta.seqNum = pCtx->srcMeta.seqNum + 1;
 	pCtx->dstMeta.leuNdx = pCtx->srcMeta.leuNdx;
 	pCtx->dstMeta.roEuKB = pDev->euSize >> 10, pCtx->dstMeta.roLpuPerEU = pCtx->pDev->lpuPerEU;
 	pDev->ops.pfnPagePgm(byteOfs / pDev->pageSize, 0, sizeof(FlegMeta_t), &pCtx->dstMeta);
+#if FLEG_MAP_CACHE_CNT > 0
+	_MapCacheSetDst(pDev, pCtx->lazyDst.peuNdx, pCtx->dstMeta.peuDst);
+#endif
 	pDev->leuMap[pCtx->srcMeta.leuNdx] = pCtx->lazyDst.peuNdx;
 	pDev->lazyPEU = 0xFFFF;
 	pDev->bkupPEU = 0xFFFF;
@@ -441,13 +667,7 @@ int _EndLazyMove(FlegPageWrCtx_t *pCtx) {
 	if (pCtx->pDev->bkupPEU >= pCtx->pDev->euCnt) {
 		// no virgin PEU for back up, claim one garbage PEU, should search for fewest erased PEU
 		pCtx->pDev->bkupPEU = _ClaimGarbagePEU(pCtx->pDev, (uint32_t)-1L);
-		if (pCtx->pDev->balanceDelta > (int)(FLEG_WB_THRESHOLD + pCtx->pDev->wbTolerance)) {
-			pCtx->pDev->isToWB = 1;
-		}
-		else {
-			if (pCtx->pDev->wbTolerance > 0)
-				pCtx->pDev->wbTolerance--;
-		}
+		_CheckWearBalance(pCtx->pDev);
 	}
 	{
 		if (pDev->leuMap[0] == pDev->leuMap[1] || pDev->leuMap[1] == pDev->leuMap[2] || pDev->leuMap[2] == pDev->leuMap[0]) {
@@ -457,13 +677,12 @@ int _EndLazyMove(FlegPageWrCtx_t *pCtx) {
 	return 0;
 }
 
-int _FlushLazyMove(FlegPageWrCtx_t *pCtx) {
-	// todo: move all inuse LPUs
-	static int cnt = 0;
-	uint32_t lpuIter, srcPPU, dstPPU;
+// copy up to maxCnt inuse LPUs of the lazy source to the lazy destination, returns the count copied
+int _MoveLazyPages(FlegPageWrCtx_t *pCtx, uint32_t maxCnt) {
+	uint32_t lpuIter, srcPPU, dstPPU, movedCnt = 0;
 	FlegDevice_t *pDev = pCtx->pDev;
 	uint32_t byteOfs;
-	for (lpuIter = 0; lpuIter < pDev->lpuPerEU; lpuIter++) {
+	for (lpuIter = 0; lpuIter < pDev->lpuPerEU && movedCnt < maxCnt; lpuIter++) {
 		srcPPU = pCtx->lazySrc.lpuMap[lpuIter];
 		if (srcPPU >= pDev->ppuPerEU) {
 			continue;
@@ -475,16 +694,22 @@ int _FlushLazyMove(FlegPageWrCtx_t *pCtx) {
 		dstPPU = FLEG_L1BmAryAlloc(pCtx->lazyDst.bmsVrgnPPU, sizeof(pCtx->lazyDst.bmsVrgnPPU) / 4);
 		if (!(dstPPU < pDev->ppuPerEU)) {
 			return -1L;
-			pCtx = pCtx;
 		}
 		_DoWritePage(pDev, pCtx->lazyDst.peuNdx, lpuIter, dstPPU, pDev->pageBuf);
 		FLEG_AppendLog(pDev, pCtx->lazyDst.peuNdx, lpuIter, dstPPU, &pCtx->lazyDst);
 		FLEG_L1BmAryFree(pCtx->lazySrc.bmsGrbgLPU, lpuIter);
+		pCtx->lazySrc.lpuMap[lpuIter] = (pundx_t)pDev->ppuPerEU;
 		pCtx->lazySrc.inuseLPUcnt--;
 		pCtx->pDev->stat.lazyMoveFlushCnt++;
+		movedCnt++;
 	}
+	return movedCnt;
+}
+
+int _FlushLazyMove(FlegPageWrCtx_t *pCtx) {
+	if (_MoveLazyPages(pCtx, (uint32_t)-1L) < 0)
+		return -1L;
 	_EndLazyMove(pCtx);
-	cnt++;
 	return 0;
 }
 
@@ -495,6 +720,9 @@ int FLEG_PageWrite(FlegDevice_t *pDev, uint32_t lpu, const void *pcvBuf) {
 	uint32_t isToFlushAfterPgWr = 0;
 	FlegPageWrCtx_t ctx;
 	ctx.pDev = pDev, ctx.pcvBuf = pcvBuf, ctx.lpuNum = lpu;
+#if FLEG_TRIM
+	FLEG_L1BmAryTake(pDev->bmTrim, lpu);
+#endif
 	if (peu >= pDev->euCnt)
 	{
 		// not yet alloced
@@ -589,64 +817,245 @@ NoOngoinLazyMove:
 	return 0;
 }
 
+int FLEG_PagesRead(FlegDevice_t *pDev, uint32_t lpu, uint32_t cnt, void *pvBuf) {
+	uint8_t *pBuf = (uint8_t*)pvBuf;
+	uint32_t leu, lpuNdx, peu, runCnt, ppu, i, n;
+	Fleg_LPUmap_t *pMap;
+	while (cnt) {
+		leu = lpu / pDev->lpuPerEU, lpuNdx = lpu % pDev->lpuPerEU;
+		peu = pDev->leuMap[leu];
+		runCnt = pDev->lpuPerEU - lpuNdx;
+		if (runCnt > cnt)
+			runCnt = cnt;
+		if (peu >= pDev->euCnt || peu == pDev->lazyPEU) {
+			// never written, or split over the lazy move source and destination
+			for (i = 0; i < runCnt; i++) {
+				if (FLEG_PageRead(pDev, lpu + i, pBuf + i * pDev->pageSize) < 0)
+					return -1L;
+			}
+		}
+		else {
+			// look the map up once for the pages in this LEU
+#if FLEG_MAP_CACHE_CNT > 0
+			pMap = &_MapCacheGet(pDev, peu)->map;
+#else
+			pMap = &pDev->lpuMap;
+			_ReadEUlog(pDev, peu, pMap);
+#endif
+			for (i = 0; i < runCnt; i += n) {
+				ppu = pMap->lpuMap[lpuNdx + i];
+				if (ppu >= pDev->ppuPerEU) {
+					memset(pBuf + i * pDev->pageSize, 0xFF, pDev->pageSize);
+					n = 1;
+					continue;
+				}
+				// pages written together sit in consecutive PPUs, read them in one go
+				for (n = 1; i + n < runCnt && pMap->lpuMap[lpuNdx + i + n] == ppu + n; n++) {
+				}
+				pDev->ops.pfnRead(peu * pDev->euSize + FLEG_EU_META_SIZE + ppu * pDev->pageSize,
+					pBuf + i * pDev->pageSize, n * pDev->pageSize);
+			}
+		}
+		lpu += runCnt, cnt -= runCnt, pBuf += runCnt * pDev->pageSize;
+	}
+	return 0;
+}
+
+int FLEG_PagesWrite(FlegDevice_t *pDev, uint32_t lpu, uint32_t cnt, const void *pcvBuf) {
+	const uint8_t *pBuf = (const uint8_t*)pcvBuf;
+	uint32_t leu, lpuNdx, peu, ppu0, ppu, maxCnt, n;
+	uint32_t logCnt = pDev->pageSize / (pDev->euSize >= 256 * 1024 ? 2 : 1);
+	while (cnt) {
+		leu = lpu / pDev->lpuPerEU, lpuNdx = lpu % pDev->lpuPerEU;
+		peu = pDev->leuMap[leu];
+		n = 0;
+		if (peu < pDev->euCnt && peu != pDev->lazyPEU) {
+			// take the virgin PPUs of the PEU, they are handed out in order, so they are consecutive
+			maxCnt = pDev->lpuPerEU - lpuNdx;
+			if (maxCnt > cnt)
+				maxCnt = cnt;
+			if (maxCnt > logCnt)
+				maxCnt = logCnt;
+			_ParseEUlog(pDev, peu, &pDev->lpuMap);
+			ppu0 = FLEG_L1BmAryAlloc(pDev->lpuMap.bmsVrgnPPU, FLEG_ARRAY_SIZE(pDev->lpuMap.bmsVrgnPPU));
+			for (ppu = ppu0; ppu < pDev->ppuPerEU; ) {
+				_DoWritePage(pDev, peu, lpuNdx + n, ppu, pBuf + n * pDev->pageSize);
+#if FLEG_TRIM
+				FLEG_L1BmAryTake(pDev->bmTrim, lpu + n);
+#endif
+				if (++n == maxCnt)
+					break;
+				ppu = FLEG_L1BmAryAlloc(pDev->lpuMap.bmsVrgnPPU, FLEG_ARRAY_SIZE(pDev->lpuMap.bmsVrgnPPU));
+				FLEGASSERT(ppu >= pDev->ppuPerEU || ppu == ppu0 + n);
+			}
+			if (n) {
+				FLEG_AppendLogs(pDev, peu, lpuNdx, ppu0, n, &pDev->lpuMap);
+				pDev->stat.pageWrCnt += n;
+			}
+		}
+		if (n == 0) {
+			// not allocated yet, lazy move source, or full: the single page path sorts it out
+			if (FLEG_PageWrite(pDev, lpu, pBuf) < 0)
+				return -1L;
+			n = 1;
+		}
+		lpu += n, cnt -= n, pBuf += n * pDev->pageSize;
+	}
+	return 0;
+}
+
+int FLEG_PageTrim(FlegDevice_t *pDev, uint32_t lpu, uint32_t cnt) {
+#if FLEG_TRIM
+	for (; cnt && lpu < pDev->lpuCnt; lpu++, cnt--)
+		FLEG_L1BmAryFree(pDev->bmTrim, lpu);
+#endif
+	return 0;
+}
+
+uint32_t _CountPEU(FlegL3Bm_t *pBm, uint32_t euCnt) {
+	uint32_t peuIter, cnt = 0;
+	for (peuIter = 0; peuIter < euCnt; peuIter++)
+		cnt += FLEG_L3BmIsFree(pBm, peuIter);
+	return cnt;
+}
+
+// erase the fewest erased garbage PEU and return it to the virgin pool, its erase count is kept
+// in a meta whose leuNdx is still 0xFFFF, so a scan still sees a virgin PEU
+int _PreErasePEU(FlegDevice_t *pDev) {
+	FlegMeta_t meta;
+	int peu;
+	if (_CountPEU(&pDev->bmGrbg, pDev->euCnt) == 0)
+		return -1L;
+	peu = _TakeFewestErsdGrbgPEU(pDev);
+	_CkptTouch(pDev, peu);
+	_ReadMeta(pDev, peu, &meta);
+	pDev->peuErsCnts[peu] = ++meta.ersCnt;
+	pDev->ops.pfnErs(peu);
+	pDev->stat.peuErsCnt++;
+#if FLEG_MAP_CACHE_CNT > 0
+	_MapCacheDrop(pDev, peu);
+#endif
+	meta.peuDst = meta.peuSrc = meta.leuNdx = meta.seqNum = 0xFFFF;
+	meta.roEuKB = pDev->euSize / 1024, meta.roLpuPerEU = pDev->lpuPerEU;
+	pDev->ops.pfnPagePgm(peu * pDev->euSize / pDev->pageSize, 0, sizeof(meta), &meta);
+	FLEG_L3BmFree(&pDev->bmVrgn, peu);
+	_CheckWearBalance(pDev);
+	return peu;
+}
+
+int FLEG_Background(FlegDevice_t *pDev) {
+	FlegPageWrCtx_t ctx;
+	ctx.pDev = pDev;
+	if (pDev->lazyPEU < pDev->euCnt) {
+		// finish the lazy move a few pages at a time, so writes don't have to flush it
+		_ReadMeta(pDev, pDev->lazyPEU, &ctx.srcMeta);
+		_InitLazyMoveContext(&ctx, (uint32_t)-1L);
+		if (_MoveLazyPages(&ctx, FLEG_BG_MOVE_PAGES) < 0)
+			return 0;
+		if (ctx.lazySrc.inuseLPUcnt == 0)
+			_EndLazyMove(&ctx);
+		return 1;
+	}
+	if (_CountPEU(&pDev->bmVrgn, pDev->euCnt) < FLEG_PREERASE_CNT) {
+		if (_PreErasePEU(pDev) >= 0)
+			return 1;
+	}
+#if FLEG_CKPT
+	if (pDev->ckptJrnlCnt >= FLEG_CKPT_BG_CNT) {
+		// keep the PEUs mount has to rescan few
+		_CkptWrite(pDev);
+		return 1;
+	}
+#endif
+	return 0;
+}
+
+// classify one PEU by its meta, returns 1 if it is virgin
+uint32_t _ScanPEU(FlegDevice_t *pDev, uint32_t peuNdx)
+{
+	uint32_t oldPEUndx;
+	FlegMeta_t meta;
+	_ReadMeta(pDev, peuNdx, &meta);
+	pDev->peuErsCnts[peuNdx] = (uint32_t)-1L;
+	pDev->stat.mountScanCnt++;
+	if (meta.leuNdx == 0xFFFF) {
+		// virgin
+		FLEG_L3BmFree(&pDev->bmVrgn, peuNdx);
+		return 1;
+	}
+	// found a meta data in this EU frame
+	pDev->peuErsCnts[peuNdx] = meta.ersCnt;
+
+	oldPEUndx = pDev->leuMap[meta.leuNdx];
+	if (oldPEUndx == 0xFFFF) {
+		// this is 1st time we found a non free EU
+		// assume this group is not trash, until we found a group with larger seqNum
+		pDev->leuMap[meta.leuNdx] = peuNdx;
+		return 0;
+	}
+	// here: we found the same LEU in different PEU
+	// then one must be trash, we need to determine
+	{
+		FlegMeta_t altMeta;
+		pDev->ops.pfnRead(oldPEUndx * pDev->euSize, &altMeta, sizeof(FlegMeta_t));
+		uint16_t dltSeq = altMeta.seqNum - meta.seqNum;
+		if (dltSeq >= 32768) {
+			// alt is old, we replace the old with new
+			FLEG_L3BmSetBit(&pDev->bmGrbg, oldPEUndx);
+			pDev->leuMap[meta.leuNdx] = peuNdx;
+			
+		}
+		else {
+			// alt is newer, mark this new found as trash
+			FLEG_L3BmSetBit(&pDev->bmGrbg, peuNdx);
+		}
+	}
+	return 0;
+}
+
 int FLEG_DeviceScan(FlegDevice_t *pDev)
 {
 	uint32_t peuNdx = 0;
 	volatile uint32_t dbgIsFmt = 0;
 	FlegMeta_t meta;
 	pDev->lazyPEU = 0xFFFF, pDev->bkupPEU = 0xFFFF;
+#if FLEG_MAP_CACHE_CNT > 0
+	memset(pDev->mapCache, 0, sizeof(pDev->mapCache));
+	pDev->mapCacheTick = 0;
+#endif
 	memset(&pDev->bmVrgn, 0, sizeof(pDev->bmVrgn));
 	memset(&pDev->bmGrbg, 0, sizeof(pDev->bmGrbg));
 	memset(pDev->leuMap, -1L, sizeof(pDev->leuMap));
+#if FLEG_TRIM
+	memset(pDev->bmTrim, 0, sizeof(pDev->bmTrim));
+#endif
 	if (dbgIsFmt) {
 		for (peuNdx = 0 ; peuNdx < pDev->euCnt; peuNdx++) {
 			pDev->ops.pfnErs(peuNdx);
 		}
 	}
 	for (peuNdx = 0 ; peuNdx < pDev->euCnt; peuNdx++) {
-		{
-			// scan meta items
-			uint32_t oldPEUndx;
-			_ReadMeta(pDev, peuNdx, &meta);
-			pDev->peuErsCnts[peuNdx] = (uint32_t)-1L;
-			if (meta.leuNdx == 0xFFFF) {
-				// virgin
-				FLEG_L3BmFree(&pDev->bmVrgn, peuNdx);
-				pDev->bkupPEU = peuNdx;	// use it as backup EU for moving
-				continue;
-			}
-			// found a meta data in this EU frame
-			pDev->peuErsCnts[peuNdx] = meta.ersCnt;
-
-			oldPEUndx = pDev->leuMap[meta.leuNdx];
-			if (oldPEUndx == 0xFFFF) {
-				// this is 1st time we found a non free EU
-				// assume this group is not trash, until we found a group with larger seqNum
-				pDev->leuMap[meta.leuNdx] = peuNdx;
-				if (meta.peuDst != 0xFFFF)
-					pDev->lazyPEU = peuNdx;
-				continue;
-			}
-			// here: we found the same LEU in different PEU
-			// then one must be trash, we need to determine
-			{
-				FlegMeta_t altMeta;
-				pDev->ops.pfnRead(oldPEUndx * pDev->euSize, &altMeta, sizeof(FlegMeta_t));
-				uint16_t dltSeq = altMeta.seqNum - meta.seqNum;
-				if (dltSeq >= 32768) {
-					// alt is old, we replace the old with new
-					FLEG_L3BmSetBit(&pDev->bmGrbg, oldPEUndx);
-					pDev->leuMap[meta.leuNdx] = peuNdx;
-					if (meta.peuDst != 0xFFFF)
-						pDev->lazyPEU = peuNdx;
-					
-				}
-				else {
-					// alt is newer, mark this new found as trash
-					FLEG_L3BmSetBit(&pDev->bmGrbg, peuNdx);
-				}
-			}
-		}
+		// scan meta items
+		if (_ScanPEU(pDev, peuNdx))
+			pDev->bkupPEU = peuNdx;	// use it as backup EU for moving
+	}
+
+	// the lazy move, if any, is on the newest PEU of its LEU that names a destination. Older
+	// PEUs of the LEU that are garbage but not erased yet may still name one, so this is only
+	// known once all PEUs are scanned
+	for (peuNdx = 0; peuNdx < FLEG_LEU_CNT; peuNdx++) {
+		if (pDev->leuMap[peuNdx] >= pDev->euCnt)
+			continue;
+		_ReadMeta(pDev, pDev->leuMap[peuNdx], &meta);
+		if (meta.peuDst != 0xFFFF)
+			pDev->lazyPEU = pDev->leuMap[peuNdx];
+	}
+
+	if (pDev->lazyPEU < pDev->euCnt) {
+		// the lazy move destination has no meta of its own yet and looks virgin, but it is the
+		// backup PEU, not just any of the (pre-erased) virgin PEUs
+		_ReadMeta(pDev, pDev->lazyPEU, &meta);
+		pDev->bkupPEU = meta.peuDst;
 	}
 
 	// though backup PEU is "virgin", we must not use it for take virgin PEUs, 
@@ -657,6 +1066,100 @@ int FLEG_DeviceScan(FlegDevice_t *pDev)
 	return 0;
 }
 
+#if FLEG_CKPT
+// load the newest checkpoint and rescan the PEUs journaled after it, with its lazy move source
+// and backup PEU, they change without a meta of their own. Returns -1 if there is no checkpoint
+// or its CRC is bad, FLEG_DeviceScan() has to do then
+int _CkptLoad(FlegDevice_t *pDev)
+{
+	FlegCkptHdr_t hdr;
+	FlegMeta_t meta;
+	uint32_t bmRescan[(FLEG_PEU_CNT + 31) / 32];
+	uint32_t slot, slotCnt = _CKPT_SLOT_CNT(pDev), lastSlot = slotCnt, word, i, peu;
+	uint16_t *pJrnl = (uint16_t*)(pDev->pageBuf + FLEG_CKPT_JRNL_OFS);
+	for (slot = 0; slot < slotCnt; slot++) {
+		pDev->ops.pfnRead(_CKPT_SLOT_OFS(pDev, slot), &hdr.magic, 4);
+		pDev->ops.pfnRead(_CKPT_SLOT_OFS(pDev, slot) + pDev->pageSize, &word, 4);
+		if (hdr.magic == 0xFFFFFFFF && word == 0xFFFFFFFF)
+			break;	// slots are written in order, the rest are blank
+		if (hdr.magic == FLEG_CKPT_MAGIC)
+			lastSlot = slot;
+	}
+	if (lastSlot == slotCnt)
+		return -1L;
+	pDev->ops.pfnRead(_CKPT_SLOT_OFS(pDev, lastSlot), pDev->pageBuf, pDev->pageSize);
+	memcpy(&hdr, pDev->pageBuf, sizeof(hdr));
+	if (hdr.payloadSize != _CKPT_PAYLOAD_SIZE(pDev))
+		return -1L;
+	pDev->ops.pfnRead(_CKPT_SLOT_OFS(pDev, lastSlot) + pDev->pageSize, _CKPT_PAYLOAD(pDev), hdr.payloadSize);
+	if (_CkptCrc(&hdr, _CKPT_PAYLOAD(pDev)) != hdr.crc)
+		return -1L;
+
+#if FLEG_MAP_CACHE_CNT > 0
+	memset(pDev->mapCache, 0, sizeof(pDev->mapCache));
+	pDev->mapCacheTick = 0;
+#endif
+#if FLEG_TRIM
+	memset(pDev->bmTrim, 0, sizeof(pDev->bmTrim));
+#endif
+	pDev->ckptSeq = hdr.seqNum;
+	pDev->ckptSlot = (uint16_t)lastSlot, pDev->ckptFreeSlot = (uint16_t)slot;
+
+	// the journal is still in pageBuf
+	memset(bmRescan, 0, sizeof(bmRescan));
+	for (i = 0; i < FLEG_CKPT_JRNL_CNT && pJrnl[i] != 0xFFFF; i++) {
+		if (pJrnl[i] < pDev->euCnt)
+			FLEG_L1BmAryFree(bmRescan, pJrnl[i]);
+	}
+	pDev->ckptJrnlCnt = (uint16_t)i;
+	if (hdr.lazyPEU < pDev->euCnt)
+		FLEG_L1BmAryFree(bmRescan, hdr.lazyPEU);
+	if (hdr.bkupPEU < pDev->euCnt)
+		FLEG_L1BmAryFree(bmRescan, hdr.bkupPEU);
+
+	// forget what the checkpoint knew of them, a LEU whose PEU changed is journaled in its new PEU
+	for (i = 0; i < FLEG_LEU_CNT; i++) {
+		if (pDev->leuMap[i] < pDev->euCnt && FLEG_L1BmAryIsFree(bmRescan, pDev->leuMap[i]))
+			pDev->leuMap[i] = 0xFFFF;
+	}
+	for (peu = 0; peu < pDev->euCnt; peu++) {
+		if (FLEG_L1BmAryIsFree(bmRescan, peu)) {
+			FLEG_L3BmTake(&pDev->bmVrgn, peu);
+			FLEG_L3BmTake(&pDev->bmGrbg, peu);
+		}
+	}
+	for (peu = 0; peu < pDev->euCnt; peu++) {
+		if (FLEG_L1BmAryIsFree(bmRescan, peu))
+			_ScanPEU(pDev, peu);
+	}
+
+	// the lazy move source, if any, is one of the rescanned PEUs, see FLEG_DeviceScan()
+	pDev->lazyPEU = 0xFFFF, pDev->bkupPEU = 0xFFFF;
+	for (peu = 0; peu < pDev->euCnt; peu++) {
+		if (!FLEG_L1BmAryIsFree(bmRescan, peu))
+			continue;
+		_ReadMeta(pDev, peu, &meta);
+		if (meta.leuNdx < FLEG_LEU_CNT && pDev->leuMap[meta.leuNdx] == peu && meta.peuDst != 0xFFFF)
+			pDev->lazyPEU = peu, pDev->bkupPEU = meta.peuDst;
+	}
+	if (pDev->bkupPEU >= pDev->euCnt) {
+		// any virgin PEU does as backup, the checkpoint's one if it still is
+		if (hdr.bkupPEU < pDev->euCnt && FLEG_L3BmIsFree(&pDev->bmVrgn, hdr.bkupPEU)) {
+			pDev->bkupPEU = hdr.bkupPEU;
+		}
+		else {
+			for (peu = pDev->euCnt; peu-- > 0 && pDev->bkupPEU == 0xFFFF; ) {
+				if (FLEG_L3BmIsFree(&pDev->bmVrgn, peu))
+					pDev->bkupPEU = peu;
+			}
+		}
+	}
+	FLEG_L3BmTake(&pDev->bmVrgn, pDev->bkupPEU);
+	FLEG_L3BmTake(&pDev->bmGrbg, pDev->bkupPEU);
+	return 0;
+}
+#endif
+
 int FLEG_BeginMove(uint32_t grpNdx) {
 	return 0;
 }
@@ -690,6 +1193,15 @@ int FLEG_Init(FlegDevice_t *pDev, FlegDeviceMetrics_t *pMetrics,
 	pDev->ops.pfn16bitPgm = pfn16bitPgm;
 	pDev->ops.pfnRead = pfnRead;
 	pDev->ops.pfnFlush = pfnFlush;
+#if FLEG_CKPT
+	if (_CkptLoad(pDev) < 0) {
+		FLEG_DeviceScan(pDev);
+		// so the next mount has one, in a freshly erased checkpoint EU
+		pDev->ckptFreeSlot = 0xFFFF;
+		_CkptWrite(pDev);
+	}
+#else
 	FLEG_DeviceScan(pDev);
+#endif
 	return 0;
 }
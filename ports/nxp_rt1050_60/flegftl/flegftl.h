@@ -97,11 +97,41 @@ typedef struct _Fleg_LPUmap_t {
 	pundx_t lpuMap[(FLEG_LPU_PER_EU + 3) & ~3];
 }Fleg_LPUmap_t;
 
+// parsed EU log, only what _ParseEUlog() derives from flash is kept here
+typedef struct _Fleg_MapCache_t {
+	uint32_t lruTick;	// 0 for unused slots
+	uint16_t peuDst;	// meta peuDst, the lazy move destination of this PEU
+	Fleg_LPUmap_t map;
+}Fleg_MapCache_t;
+
 typedef struct _Fleg_EuMapLog_t
 {
 	uint16_t mapLog[FLEG_MAX_LPU_PER_EU][2];
 }Fleg_EuMapLog_t;
 
+#if FLEG_CKPT
+// >>> mount checkpoint, one slot of FLEG_CKPT_SLOT_PAGES pages in the checkpoint EU. Page 0 is
+// the header, then the journal of PEUs whose meta changed after it. The pages after it hold
+// bmVrgn, bmGrbg, leuMap and peuErsCnts as they are laid out in FlegDevice_t
+#define FLEG_CKPT_MAGIC			0x54504B43	// "CKPT"
+#define FLEG_CKPT_SLOT_PAGES	4
+#define FLEG_CKPT_JRNL_OFS		32
+#define FLEG_CKPT_JRNL_CNT		((FLEG_PAGE_SIZE - FLEG_CKPT_JRNL_OFS) / 2)
+typedef struct _FlegCkptHdr_t
+{
+	uint32_t magic;
+	uint32_t crc;	// of the fields below and the payload
+	uint32_t seqNum;
+	uint16_t lazyPEU;
+	uint16_t bkupPEU;
+	uint32_t payloadSize;
+}FlegCkptHdr_t;
+
+#if FLEG_CKPT_EU < FLEG_EU_CNT
+#error "FLEG_CKPT_EU must be past the FTL's EUs"
+#endif
+#endif
+
 #if FLEG_L1BM_ITEM_CNT < ((FLEG_EU_CNT + 31) / 32)
 #error "insufficient FLEG_L1BM_ITEM_CNT"
 #endif
@@ -170,6 +200,11 @@ typedef struct _FlegStat_t
 	uint32_t gcCnt;	// garbage claim cnt
 	uint32_t lazyMoveCnt;
 	uint32_t lazyMoveFlushCnt;
+	uint32_t mapCacheHitCnt;
+	uint32_t mapCacheMissCnt;
+	uint32_t trimSkipCnt;	// trimmed LPUs lazy moves did not copy
+	uint32_t ckptWrCnt;
+	uint32_t mountScanCnt;	// PEU metas mount classified, all of them without a checkpoint
 }FlegStat_t;
 
 typedef struct _FlegDevice_t
@@ -191,18 +226,34 @@ typedef struct _FlegDevice_t
 	uint16_t bkupPEU;	// backup EU index for moving a EU into when group can't be transfered
 	uint16_t lazyPEU;
 	FlegDeviceOpts_t ops;
+	// >>> the checkpoint payload, bmVrgn up to peuErsCnts must stay together
 	FlegL3Bm_t bmVrgn;	// virgin EUs  :whose bits are virgin ---- kept in erased state.
 	FlegL3Bm_t bmGrbg;	// garbage EUs :whose bits are not virgin and group has mapped to others.
 	uint16_t leuMap[FLEG_LEU_CNT];	// group to group frame map
 	uint32_t peuErsCnts[FLEG_PEU_CNT];
+	// <<<
 	union {
 		uint8_t pageBuf[FLEG_PAGE_SIZE];
 		uint64_t pageBuf64[FLEG_PAGE_SIZE / 8];	// make it align to 64 bit
 		FlegMeta_t euMeta;
 	};
 	Fleg_LPUmap_t lpuMap;
+#if FLEG_TRIM
+	uint32_t bmTrim[(FLEG_LPU_CNT + 31) / 32];	// set for LPUs the file system freed, RAM only
+#endif
+#if FLEG_MAP_CACHE_CNT > 0
+	uint32_t mapCacheTick;
+	Fleg_MapCache_t mapCache[FLEG_MAP_CACHE_CNT];
+#endif
+#if FLEG_CKPT
+	uint32_t ckptSeq;		// of the newest checkpoint
+	uint16_t ckptSlot;		// slot of the newest checkpoint, its journal takes the PEUs changed since
+	uint16_t ckptFreeSlot;	// next slot to write
+	uint16_t ckptJrnlCnt;
+#endif
 }FlegDevice_t;
 
+// rebuilds the maps from the meta of every PEU
 int FLEG_DeviceScan(FlegDevice_t *pDev);
 
 // pMetrics could be NULL : Use default metrics configured by FLEG_XXX macros in fleg
@@ -214,6 +265,18 @@ int FLEG_Init(FlegDevice_t *pDev, FlegDeviceMetrics_t *pMetrics,
 
 int FLEG_PageRead(FlegDevice_t *pDev, uint32_t lpu, void *pvBuf);
 int FLEG_PageWrite(FlegDevice_t *pDev, uint32_t lpu, const void *pcvBuf);
+// cnt consecutive LPUs. Pages of the same LEU share one map lookup, reads of consecutive PPUs
+// are done in one pfnRead, writes log all the pages that fit the PEU in one go.
+int FLEG_PagesRead(FlegDevice_t *pDev, uint32_t lpu, uint32_t cnt, void *pvBuf);
+int FLEG_PagesWrite(FlegDevice_t *pDev, uint32_t lpu, uint32_t cnt, const void *pcvBuf);
+// the data of cnt LPUs from lpu on is no longer needed (FatFS CTRL_TRIM). Reads may still return
+// the old data, but lazy moves don't copy it. Only kept until the next write of the LPU or reset.
+int FLEG_PageTrim(FlegDevice_t *pDev, uint32_t lpu, uint32_t cnt);
+// one bounded step of idle time work: copy a few pages of the ongoing lazy move, erase one
+// garbage PEU into the pre-erased pool, or write a checkpoint. Returns 1 if it did something,
+// 0 if nothing is left.
+// Must not run while FLEG_PageRead()/FLEG_PageWrite() is in progress.
+int FLEG_Background(FlegDevice_t *pDev);
 
 
 
@@ -12,6 +12,13 @@
 #define FLEG_ADDR0				0
 #define FLEG_WB_THRESHOLD		100		// wear balance threshold
 #define FLEG_FLASH_OFFSET		0x00800000
+#define FLEG_MAP_CACHE_CNT		8		// parsed EU maps kept in RAM (~1kB each for 256kB EU), 0 to disable
+#define FLEG_PREERASE_CNT		2		// erased PEUs FLEG_Background() keeps ready, so writes don't erase inline
+#define FLEG_BG_MOVE_PAGES		16		// pages of a lazy move FLEG_Background() copies per call
+#define FLEG_TRIM				1		// track trimmed LPUs (1 bit each, ~12kB), so lazy moves skip them
+#define FLEG_CKPT				1		// mount from a checkpoint of the EU maps instead of reading every EU meta
+#define FLEG_CKPT_EU			223		// EU index of the checkpoints, past the FLEG_EU_CNT ones (last EU of the 64MB HyperFlash)
+#define FLEG_CKPT_BG_CNT		32		// FLEG_Background() writes a new checkpoint once this many PEUs changed
 // <<<
 
 // >>> below configurations are calcuated based on basic configs, user must calculate correctly!
@@ -33,6 +33,10 @@
 #include "py/mpthread.h"
 #include "gccollect.h"
 #include "systick.h"
+#include "trace.h"
+#ifndef OMV_MPY_ONLY
+#include "xalloc.h"
+#endif
 
 mp_uint_t gc_helper_get_regs_and_sp(mp_uint_t *regs);
 
@@ -43,6 +47,7 @@ void gc_collect(void) {
     #endif
 
     // start the GC
+    trace_event(TRACE_GC_BEGIN, 0);
     gc_collect_start();
 
     // get the registers and the sp
@@ -63,6 +68,11 @@ void gc_collect(void) {
 		#endif
     #endif
 	#endif
+    #ifndef OMV_MPY_ONLY
+    // imlib scratch nodes outside the GC heap point to GC objects
+    xalloc_arena_gc_collect();
+    #endif
+
     // trace root pointers from any threads
     #if MICROPY_PY_THREAD
     mp_thread_gc_others();
@@ -70,6 +80,7 @@ void gc_collect(void) {
 
     // end the GC
     gc_collect_end();
+    trace_event(TRACE_GC_END, 0);
 
     #if 0
     // print GC info
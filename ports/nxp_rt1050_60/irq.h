@@ -109,6 +109,10 @@ MP_DECLARE_CONST_FUN_OBJ_0(pyb_irq_stats_obj);
 #define IRQ_PRI_SYSTICK         1
 #define IRQ_SUBPRI_SYSTICK                  0
 
+// micropython.profile() samples, above everything it should see
+#define IRQ_PRI_PROF            1
+#define IRQ_SUBPRI_PROF                     0
+
 // Flash IRQ must be higher priority than interrupts of all those components
 // that rely on the flash storage.
 #define IRQ_PRI_FLASH           2
@@ -131,6 +135,14 @@ MP_DECLARE_CONST_FUN_OBJ_0(pyb_irq_stats_obj);
 #define IRQ_PRI_UART            10
 #define IRQ_SUBPRI_UART                     0
 
+// camera register batches, each IRQ only starts the next transfer
+#define IRQ_PRI_I2C             10
+#define IRQ_SUBPRI_I2C                      0
+
+// ADC stream halves, only schedules the callback
+#define IRQ_PRI_DMA             10
+#define IRQ_SUBPRI_DMA                      0
+
 // USB IRQ can take long time to complete, so make priority low
 #define IRQ_PRI_USB_OTG1        12
 #define IRQ_SUBPRI_OTG_FS                   0
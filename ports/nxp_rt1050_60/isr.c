@@ -78,10 +78,12 @@
 #include "timer.h"
 #include "uart.h"
 #include "storage.h"
+#include "sdcard.h"
 #include "can.h"
 #include "dma.h"
 #include "i2c.h"
 #include "usb_app.h"
+#include "systick.h"
 #include "mpconfigboard.h"
 extern void __fatal_error(const char*);
 // extern PCD_HandleTypeDef pcd_fs_handle;
@@ -415,6 +417,9 @@ void DebugMon_Handler(void) {
   */
 extern void dma_idle_handler(uint32_t tick);
 extern void SDMMC_Tick_Handler(void);
+#if defined(OMV_ENABLE_LEPTON)
+extern void lepton_tick_handler(uint32_t tick);
+#endif
 
 #if SYSTICK_PRESCALE > 1
 ExceptionRegisters_t s_traces[256];
@@ -423,109 +428,6 @@ uint32_t s_prescale;
 #endif
 #include "sensor.h"
 
-#define PROFILING	1
-#ifdef PROFILING
-
-#define PROF_CNT		20
-#define PROF_ERR		16
-#define PROF_MASK 		(~(PROF_ERR - 1))
-#define PROF_HITCNT_INC	100
-// whether hitCnt should decay, faster decay makes most time consuming functions
-// seems to have even more hit count
-#define PROF_DECAY	
-uint32_t s_ignrList[] = {
-	// (uint32_t)sensor_snapshot + 0x40 ,
-};
-
-typedef struct {
-	uint32_t baseAddr;	// (aligned) base address range of PC sample
-	uint32_t hitCnt;    // hit count (a decay mecahnism automatically drops it)
-	uint32_t hitRatio;	// 10-bit resolution hit ratio, 
-	uint32_t rsvd;		// reserved for better view in memory window
-} ProfUnit_t;
-
-typedef struct {
-	uint8_t decayNdx;  // which item to decay its hitCnt 
-	uint32_t profCnt;  // totoal hit count of profiling
-	ProfUnit_t items[PROF_CNT];
-}Prof_t;
-Prof_t s_prof;
-
-void _ProfOnHit(ProfUnit_t *pItem, uint32_t pc) 
-{
-	pItem->baseAddr = pc & PROF_MASK;
-	s_prof.profCnt+= PROF_HITCNT_INC;
-	pItem->hitCnt += PROF_HITCNT_INC;
-	pItem->hitRatio = 
-		(uint32_t)(((uint64_t)(pItem->hitCnt) << 10) / s_prof.profCnt);
-	// sort items descending
-	ProfUnit_t tmpItem;	
-	for (;pItem != s_prof.items && pItem[0].hitCnt > pItem[-1].hitCnt; pItem--) 
-	{
-		tmpItem = pItem[0]; pItem[0] = pItem[-1] ; pItem[-1] = tmpItem;
-	}
-}
-void ProfUpdateRate(float res)
-{
-  uint32_t i; 
-  float profCnt = s_prof.profCnt;
-  ProfUnit_t *pItem = s_prof.items;
-  for (i=0; i<PROF_CNT; i++, pItem++) {
-	pItem->hitRatio = 
-	  (uint32_t)( (float)(pItem->hitCnt) * res / profCnt);
-  }
-}
-void ProfReset(void)
-{
-  memset(&s_prof, 0, sizeof(s_prof));
-}
-void Profiling(uint32_t pc) 
-{
-	uint32_t i;
-	ProfUnit_t *pItem = &s_prof.items[0];
-	// filter ignore list
-	for (i=0; i<ARRAY_SIZE(s_ignrList); i++) {
-		if (pc - s_ignrList[i] < PROF_ERR)
-			return;
-	}
-	#ifdef PROF_DECAY
-		// apply decaying, we do not decay to zero, this means PC samples do not
-		// get removed automatically, only can be pushed by later new more frequent
-		// hit PC samples 
-		if (s_prof.items[s_prof.decayNdx].hitCnt > 1) {
-			s_prof.items[s_prof.decayNdx].hitCnt--;
-			s_prof.profCnt--;
-		}
-		if (++s_prof.decayNdx == PROF_CNT)
-			s_prof.decayNdx = 0;
-	#endif	
-	uint32_t freeNdx = PROF_CNT;
-	// >>> traverse to search existing same PC sample
-	for (i=0, pItem = s_prof.items; i<PROF_CNT; i++, pItem++) {
-		if (pItem->baseAddr == (pc & PROF_MASK)) {
-			_ProfOnHit(pItem, pc);
-			break;
-		} else if (freeNdx == PROF_CNT && pItem->hitCnt == 0){
-			// record empty item, in case need to use for new PC sample
-			freeNdx = i;
-		}
-	}
-	if (i == PROF_CNT) {
-		if (freeNdx < PROF_CNT) {
-			// does not find, allocate for new
-			_ProfOnHit(s_prof.items + freeNdx, pc);
-		} else {
-		  // replace the last one. We must give new samples chance to compete to
-		  // get into the list.
-		  freeNdx = PROF_CNT - 1;
-		  s_prof.profCnt -= s_prof.items[freeNdx].hitCnt;
-		  s_prof.items[freeNdx].hitCnt = 0;
-		  _ProfOnHit(s_prof.items + freeNdx, pc);
-		}
-	}
-}
-#endif
-
 __WEAK void SwTimerHandler(void) {}
 extern void RPM_TickHandler();
 extern void SRPM_TickHandler(void);
@@ -551,11 +453,8 @@ void SysTick_C_Handler(ExceptionRegisters_t *regs) {
 	s_prescale = 0;
 	#endif
 	
-	#ifdef PROFILING
-	Profiling(regs->pc);
-	#endif	
-
     uwTick += 1;
+	systick_tick_done();
 	#ifdef OMVRT1
 	RPM_TickHandler();
 	SRPM_TickHandler();
@@ -563,6 +462,9 @@ void SysTick_C_Handler(ExceptionRegisters_t *regs) {
 	SwTimerHandler();
 	
 	SDMMC_Tick_Handler();
+	#if defined(OMV_ENABLE_LEPTON)
+	lepton_tick_handler(uwTick);
+	#endif
     // Read the systick control regster. This has the side effect of clearing
     // the COUNTFLAG bit, which makes the logic in mp_hal_ticks_us
     // work properly.
@@ -583,7 +485,7 @@ void SysTick_C_Handler(ExceptionRegisters_t *regs) {
     }
 	*/
 
-    #if MICROPY_PY_THREAD
+    #if MICROPY_PY_PYBTHREAD
     if (pyb_thread_enabled) {
         if (pyb_thread_cur->timeslice == 0) {
             if (pyb_thread_cur->run_next != pyb_thread_cur) {
@@ -649,4 +551,14 @@ void Reserved168_IRQHandler(void) {
 	__DSB();
 }
 
+// Starts the next queued SD card transfer.
+void Reserved169_IRQHandler(void) {
+    IRQ_ENTER(Reserved169_IRQn);
+	#if MICROPY_HW_HAS_SDCARD
+	sdcard_irq_handler();
+	#endif
+	IRQ_EXIT(Reserved169_IRQn);
+	__DSB();
+}
+
 
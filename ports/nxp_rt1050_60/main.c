@@ -39,11 +39,16 @@
 #include "lib/oofatfs/ff.h"
 #include "extmod/vfs.h"
 #include "extmod/vfs_fat.h"
+#include "extmod/vfs_lfs.h"
+#include "py/stream.h"
 #include "fsl_debug_console.h"
 #include "systick.h"
 #include "pendsv.h"
 #include "pybthread.h"
 #include "gccollect.h"
+#include "nativecode.h"
+#include "profiler.h"
+#include "boottime.h"
 #include "modmachine.h"
 // #include "i2c.h"
 // #include "spi.h"
@@ -57,6 +62,7 @@
 #include "rtc.h"
 #include "storage.h"
 #include "sdcard.h"
+#include "adc.h"
 #include "rng.h"
 
 #include "pwm.h"
@@ -283,15 +289,122 @@ static const char fresh_readme_txt[] __ALIGNED(4) =
 ;
 
 // avoid inlining to avoid stack usage within main()
-#if MICROPY_HW_HAS_FLASH
-MP_NOINLINE STATIC bool init_flash_fs(uint reset_mode) {
-    // init the vfs object
-    fs_user_mount_t *vfs_fat = &fs_user_mount_flash;
-    vfs_fat->blockdev.flags = 0;
-    pyb_flash_init_vfs(vfs_fat);
+#if MICROPY_HW_HAS_FLASH && MICROPY_HW_FLASH_FS_LFS2
+// littlefs on the raw HyperFlash, one block per erase unit.  Reads and programs are whole
+// pages, so no page is programmed twice and the 2KB caches (4 pages) keep small files inline
+// in their directory, they never cost an erase unit of their own.  The lookahead covers all
+// erase units, so allocation scans the flash once per mount.
+#define FLASH_LFS_READ_SIZE     (512)
+#define FLASH_LFS_PROG_SIZE     (512)
+#define FLASH_LFS_LOOKAHEAD     (32)
+
+STATIC mp_obj_t flash_lfs_mount(mp_obj_t bdev, bool mkfs) {
+    mp_obj_t args[7] = {
+        bdev,
+        MP_OBJ_NEW_QSTR(MP_QSTR_readsize), MP_OBJ_NEW_SMALL_INT(FLASH_LFS_READ_SIZE),
+        MP_OBJ_NEW_QSTR(MP_QSTR_progsize), MP_OBJ_NEW_SMALL_INT(FLASH_LFS_PROG_SIZE),
+        MP_OBJ_NEW_QSTR(MP_QSTR_lookahead), MP_OBJ_NEW_SMALL_INT(FLASH_LFS_LOOKAHEAD),
+    };
+    if (mkfs) {
+        mp_call_function_n_kw(mp_load_attr(MP_OBJ_FROM_PTR(&mp_type_vfs_lfs2), MP_QSTR_mkfs), 1, 3, args);
+    }
+    return mp_type_vfs_lfs2.make_new(&mp_type_vfs_lfs2, 1, 3, args);
+}
+
+STATIC void flash_lfs_write_file(const char *path, const char *data, size_t len) {
+    mp_obj_t args[2] = { mp_obj_new_str(path, strlen(path)), MP_OBJ_NEW_QSTR(MP_QSTR_w) };
+    mp_obj_t f = mp_vfs_open(2, args, (mp_map_t*)&mp_const_empty_map);
+    mp_stream_write(f, data, len, MP_STREAM_RW_WRITE);
+    mp_stream_close(f);
+}
+
+// The littlefs object lives on the heap, so even a fast soft reset mounts it again.
+MP_NOINLINE STATIC bool init_flash_fs(uint reset_mode, bool keep) {
+    (void)keep;
+    mp_obj_t bdev = pyb_flash_type.make_new(&pyb_flash_type, 0, 0, NULL);
+    mp_obj_t vfs_lfs = MP_OBJ_NULL;
+    bool fresh = false;
 
     // try to mount the flash
-    FRESULT res = f_mount(&vfs_fat->fatfs);
+    nlr_buf_t nlr;
+    if (reset_mode != 3) {
+        if (nlr_push(&nlr) == 0) {
+            vfs_lfs = flash_lfs_mount(bdev, false);
+            nlr_pop();
+        }
+    }
+
+    if (vfs_lfs == MP_OBJ_NULL) {
+        // no filesystem, or asked to reset it, so create a fresh one
+        if (nlr_push(&nlr) == 0) {
+            vfs_lfs = flash_lfs_mount(bdev, true);
+            nlr_pop();
+        } else {
+            printf("PYB: can't create flash filesystem\n");
+            return false;
+        }
+        fresh = true;
+    }
+
+    // mount the flash device (there should be no other devices mounted at this point)
+    // we allocate this structure on the heap because vfs->next is a root pointer
+    mp_vfs_mount_t *vfs = m_new_obj_maybe(mp_vfs_mount_t);
+    if (vfs == NULL) {
+        printf("PYB: can't mount flash\n");
+        return false;
+    }
+    vfs->str = "/flash";
+    vfs->len = 6;
+    vfs->obj = vfs_lfs;
+    vfs->next = NULL;
+    MP_STATE_VM(vfs_mount_table) = vfs;
+
+    // The current directory is used as the boot up directory.
+    // It is set to the internal flash filesystem by default.
+    MP_STATE_PORT(vfs_cur) = vfs;
+
+    bool need_boot_py = (mp_vfs_import_stat("/flash/boot.py") != MP_IMPORT_STAT_FILE);
+    if (fresh || need_boot_py) {
+        // LED on to indicate creation of the files
+        led_state(PYB_LED_GREEN, 1);
+        uint32_t start_tick = HAL_GetTick();
+
+        if (nlr_push(&nlr) == 0) {
+            if (fresh) {
+                flash_lfs_write_file("/flash/main.py", fresh_main_py, sizeof(fresh_main_py) - 1);
+                flash_lfs_write_file("/flash/pybcdc.inf", fresh_pybcdc_inf, sizeof(fresh_pybcdc_inf) - 1);
+                flash_lfs_write_file("/flash/README.txt", fresh_readme_txt, sizeof(fresh_readme_txt) - 1);
+                flash_lfs_write_file("/flash/selftest.py", fresh_selftest_py, sizeof(fresh_selftest_py) - 1);
+            }
+            if (need_boot_py) {
+                flash_lfs_write_file("/flash/boot.py", fresh_boot_py, sizeof(fresh_boot_py) - 1);
+            }
+            nlr_pop();
+        } else {
+            printf("PYB: can't create flash files\n");
+        }
+
+        // keep LED on for at least 200ms
+        sys_tick_wait_at_least(start_tick, 200);
+        led_state(PYB_LED_GREEN, 0);
+    }
+
+    return true;
+}
+#elif MICROPY_HW_HAS_FLASH
+MP_NOINLINE STATIC bool init_flash_fs(uint reset_mode, bool keep) {
+    fs_user_mount_t *vfs_fat = &fs_user_mount_flash;
+    FRESULT res = FR_OK;
+
+    // a fast soft reset keeps the volume FatFs has mounted, unless it was unmounted
+    if (!keep || vfs_fat->fatfs.fs_type == 0) {
+        // init the vfs object
+        vfs_fat->blockdev.flags = 0;
+        pyb_flash_init_vfs(vfs_fat);
+
+        // try to mount the flash
+        res = f_mount(&vfs_fat->fatfs);
+    }
 
     if (reset_mode == 3 || res == FR_NO_FILESYSTEM) {
         // no filesystem, or asked to reset it, so create a fresh one
@@ -387,26 +500,45 @@ MP_NOINLINE STATIC bool init_flash_fs(uint reset_mode) {
     return true;
 }
 #endif
+
+// Hand the heap to the GC.  With split pools the upper part of it becomes the
+// large object pool, so image sized buffers are not fragmented by small objects.
+STATIC void gc_init_heap(void *start, void *end) {
+    #if MICROPY_GC_SPLIT_POOLS
+    uint8_t *split = (uint8_t*)start + ((uint8_t*)end - (uint8_t*)start) / 100 * (100 - MICROPY_GC_LARGE_POOL_PERCENT);
+    split = (uint8_t*)((uint32_t)split & ~(MICROPY_BYTES_PER_GC_BLOCK - 1));
+    gc_init(start, split);
+    gc_add_large_pool(split, end);
+    #else
+    gc_init(start, end);
+    #endif
+}
+
 #if MICROPY_HW_HAS_SDCARD
-STATIC bool init_sdcard_fs(bool first_soft_reset) {
+// The partitions' FatFs volumes live outside the heap so a fast soft reset can keep them.
+STATIC fs_user_mount_t fs_user_mount_sd[4];
+
+STATIC bool init_sdcard_fs(bool first_soft_reset, bool keep) {
     bool first_part = true;
     for (int part_num = 1; part_num <= 4; ++part_num) {
         // create vfs object
-        fs_user_mount_t *vfs_fat = m_new_obj_maybe(fs_user_mount_t);
+        fs_user_mount_t *vfs_fat = &fs_user_mount_sd[part_num - 1];
         mp_vfs_mount_t *vfs = m_new_obj_maybe(mp_vfs_mount_t);
-        if (vfs == NULL || vfs_fat == NULL) {
+        if (vfs == NULL) {
             break;
         }
-        vfs_fat->blockdev.flags = MP_BLOCKDEV_FLAG_FREE_OBJ;
-        sdcard_init_vfs(vfs_fat, part_num);
+        FRESULT res = FR_OK;
+        if (!keep || vfs_fat->fatfs.fs_type == 0) {
+            vfs_fat->blockdev.flags = 0;
+            sdcard_init_vfs(vfs_fat, part_num);
 
-        // try to mount the partition
-        FRESULT res = f_mount(&vfs_fat->fatfs);
+            // try to mount the partition
+            res = f_mount(&vfs_fat->fatfs);
+        }
 
         if (res != FR_OK) {
             // couldn't mount
-			
-            m_del_obj(fs_user_mount_t, vfs_fat);
+            vfs_fat->fatfs.fs_type = 0;
             m_del_obj(mp_vfs_mount_t, vfs);
         } else {
             // mounted via FatFs, now mount the SD partition in the VFS
@@ -567,7 +699,10 @@ HAL_StatusTypeDef HAL_Init(void)
 	return HAL_OK;
 }
 
-#define DTCM_END  0x20078000 // 0x20074000  // leave 16kB, letnet can makes openmv access out of range.
+#ifndef FLEXRAM_DTCM_SIZE
+#define FLEXRAM_DTCM_SIZE 0x78000
+#endif
+#define DTCM_END  (0x20000000 + FLEXRAM_DTCM_SIZE) // 0x20074000  // leave 16kB, letnet can makes openmv access out of range.
 #define OCRAM_END 0x20280000
 #ifdef USE_OCRAM
 #define RAM_START 0x20200000
@@ -635,6 +770,8 @@ __WEAK void sensor_init() {}
 #include "usbdbg.h"
 
 extern int OpenMV_Main(uint32_t first_soft_reset);
+extern int sensor_boot_start();
+extern void task_init0(void);
 
 extern int TestCchBug(void);
 
@@ -708,6 +845,7 @@ extern uint16_t g_uid[4];
 __WEAK void dcmc_init0(void){}
 __WEAK void i2c_init0(void){}
 __WEAK void pwm_init0(void){}
+__WEAK void pwm_play_stop(void){}
 __WEAK void rpm_init0(void){}
 __WEAK void spi_init0(void){}
 __WEAK void srpm_init0(void){}
@@ -753,7 +891,7 @@ int main(void) {
     #endif
 
     // basic sub-system init
-    #if MICROPY_PY_THREAD
+    #if MICROPY_PY_PYBTHREAD
     pyb_thread_init(&pyb_thread_main);
     #endif
     pendsv_init();
@@ -775,6 +913,12 @@ int main(void) {
     bool first_soft_reset = true;
 	retCode = true;
 soft_reset:
+	boot_time_reset(first_soft_reset);
+	// machine.soft_reset(True): only the Python heap and the script state are new, the
+	// FatFs volumes, the FLEG map, USB and the sensor's registers carry on as they are
+	machine_fast_reset = machine_fast_reset_pending && !first_soft_reset;
+	machine_fast_reset_pending = false;
+	#if !MICROPY_HW_FAST_BOOT
 	{
 		uint32_t wait;
 		uint32_t i = 0;
@@ -786,6 +930,7 @@ soft_reset:
 		}
 		led_state(1, 0);
 	}
+	#endif
 	
     led_state(1, 1);
 	#if defined(MICROPY_HW_LED2)
@@ -807,12 +952,21 @@ soft_reset:
 		rtc_info_init();
         rtc_init_start();
 #endif
+	boot_time_mark(MP_QSTR_machine);
+
+#if MICROPY_HW_FAST_BOOT
+	// the sensor settles while the rest boots
+	if (!machine_fast_reset) {
+		sensor_boot_start();
+		boot_time_mark(MP_QSTR_sensor);
+	}
+#endif
 
     // more sub-system init
 #if MICROPY_HW_HAS_SDCARD
     if (first_soft_reset) {
         sdcard_init();
-		#ifndef __CC_ARM
+		#if !defined(__CC_ARM) && !MICROPY_HW_FAST_BOOT
 		{
 			volatile uint32_t t1, t2;
 			t1 = HAL_GetTick();
@@ -820,6 +974,7 @@ soft_reset:
 			while (HAL_GetTick() < t2) {HAL_WFI();}
 		}
 		#endif
+		boot_time_mark(MP_QSTR_sdcard);
     }
 #endif
     if (first_soft_reset) {
@@ -849,15 +1004,16 @@ soft_reset:
 	} else {
 		_heap_end = DTCM_END;
 	}
-    gc_init((void*) _heap_start, (void*) _heap_end);
+    gc_init_heap((void*) _heap_start, (void*) _heap_end);
 #elif defined(__GNUC__)
     // Stack limit should be less than real stack size, so we have a chance
     // to recover from limit hit.  (Limit is measured in bytes.)
     // Note: stack control relies on main thread being initialised above
     mp_stack_set_top(&_estack);
     mp_stack_set_limit(&_stack_size);
-    gc_init(&_heap_start, &_heap_end);	
+    gc_init_heap(&_heap_start, &_heap_end);	
 #endif
+    native_code_init();
 	MP_STATE_PORT(omv_ide_irq) = 0;
 
     // Micro Python init
@@ -865,6 +1021,7 @@ soft_reset:
     mp_obj_list_init(mp_sys_path, 0);
     mp_obj_list_append(mp_sys_path, MP_OBJ_NEW_QSTR(MP_QSTR_)); // current dir (or base dir of the script)
     mp_obj_list_init(mp_sys_argv, 0);
+	boot_time_mark(MP_QSTR_heap);
 
     // Initialise low-level sub-systems.  Here we need to very basic things like
     // zeroing out memory and resetting any of the sub-systems.  Following this
@@ -911,7 +1068,7 @@ soft_reset:
     // Create it if needed, mount in on /flash, and set it as current dir.
 	bool mounted_flash;
 	#if MICROPY_HW_HAS_FLASH && !defined(XIP_EXTERNAL_FLASH) && defined(EVK1050_60_HYPER) 
-    mounted_flash = init_flash_fs(reset_mode);
+    mounted_flash = init_flash_fs(reset_mode, machine_fast_reset);
 	#else
 	mounted_flash = 0;
 	#endif
@@ -921,10 +1078,14 @@ soft_reset:
     // if an SD card is present then mount it on /sd/
     if (sdcard_is_present()) {
         // if there is a file in the flash called "SKIPSD", then we don't mount the SD card
+        #if MICROPY_HW_FLASH_FS_LFS2
+        if (!mounted_flash || mp_vfs_import_stat("/flash/SKIPSD") != MP_IMPORT_STAT_FILE) {
+        #else
         if (!mounted_flash || f_stat(&fs_user_mount_flash.fatfs, "/SKIPSD", NULL) != FR_OK) {
+        #endif
 			int retry = 16;
 			while (retry--) {
-				mounted_sdcard = init_sdcard_fs(first_soft_reset);
+				mounted_sdcard = init_sdcard_fs(first_soft_reset, machine_fast_reset);
 				if (mounted_sdcard)
 					break;
 				else
@@ -941,6 +1102,8 @@ soft_reset:
 	}
 #endif
 
+	boot_time_mark(MP_QSTR_mount);
+
     // set sys.path based on mounted filesystems (/sd is first so it can override /flash)
     if (mounted_sdcard) {
         mp_obj_list_append(mp_sys_path, MP_OBJ_NEW_QSTR(MP_QSTR__slash_sd));
@@ -973,6 +1136,7 @@ soft_reset:
     }
 	#endif
 
+	boot_time_mark(MP_QSTR_boot_py);
     led_state(1, 0);
     led_state(2, 0);
     led_state(3, 0);
@@ -982,7 +1146,7 @@ soft_reset:
     // or whose initialisation can be safely deferred until after running
     // boot.py.
 
-#if defined(USE_DEVICE_MODE)
+#if defined(USE_DEVICE_MODE) && !MICROPY_HW_FAST_BOOT
     // init USB device to default setting if it was not already configured
     if (first_soft_reset) {
 	    if (!(pyb_usb_flags & PYB_USB_FLAG_USB_MODE_CALLED)) {
@@ -1018,6 +1182,16 @@ soft_reset:
 //PRINTF("%x%x\n",g_uid[1],g_uid[0]);
 
 
+#if defined(USE_DEVICE_MODE) && MICROPY_HW_FAST_BOOT
+    // last, so the host's MSC reads do not hold up the mounts and the rest of the init
+    if (first_soft_reset) {
+	    if (!(pyb_usb_flags & PYB_USB_FLAG_USB_MODE_CALLED)) {
+	        pyb_usb_dev_init(USBD_VID, USBD_PID_CDC_MSC, USBD_MODE_CDC_MSC, NULL);
+	    }
+    }
+	boot_time_mark(MP_QSTR_usb);
+#endif
+
     // At this point everything is fully configured and initialised.
 
  	VCOM_Open();
@@ -1031,6 +1205,18 @@ soft_reset_exit:
     printf("PYB: sync filesystems\n");
     storage_flush();
 	#endif
+	#if MICROPY_HW_HAS_SDCARD
+	// a read_async() may still be filling a buffer on the heap
+	sdcard_wait_idle();
+	#endif
+	// as may an ADC stream, PWM.play() and Servo.trajectory()
+	adc_stream_stop();
+	pwm_play_stop();
+	servo_trajectory_stop();
+	// and the omv.submit() worker may be in the middle of a task
+	task_init0();
+	// the profiler's Python lines refer to qstrs of this session
+	profiler_start(0, 1);
     printf("PYB: soft reboot\n");
     // rocky ignore: timer_deinit();
     
@@ -1039,7 +1225,7 @@ soft_reset_exit:
     // rocky ignore: can_deinit();
 #endif
 
-    #if MICROPY_PY_THREAD
+    #if MICROPY_PY_PYBTHREAD
     pyb_thread_deinit();
     #endif
 
@@ -1223,7 +1409,7 @@ soft_reset:
 	} else {
 		_heap_end = DTCM_END;
 	}
-    gc_init((void*) _heap_start, (void*) _heap_end);
+    gc_init_heap((void*) _heap_start, (void*) _heap_end);
 	PRINTF("PY heap:0x%x, size:%dKb\r\n",_heap_start,(_heap_end-_heap_start)/1024);
 #elif defined(__GNUC__)
     // Stack limit should be less than real stack size, so we have a chance
@@ -1231,8 +1417,9 @@ soft_reset:
     // Note: stack control relies on main thread being initialised above
     mp_stack_set_top(&_estack);
     mp_stack_set_limit(&_stack_size);
-    gc_init(&_heap_start, &_heap_end);	
+    gc_init_heap(&_heap_start, &_heap_end);	
 #endif
+    native_code_init();
 	MP_STATE_PORT(omv_ide_irq) = 0;
 
     // Micro Python init
@@ -1286,7 +1473,7 @@ soft_reset:
     // Create it if needed, mount in on /flash, and set it as current dir.
 	bool mounted_flash;
 	#if !defined(XIP_EXTERNAL_FLASH) && defined(EVK1050_60_HYPER) 
-    mounted_flash = init_flash_fs(reset_mode);
+    mounted_flash = init_flash_fs(reset_mode, false);
 	#else
 	mounted_flash = 0;
 	#endif
@@ -1296,10 +1483,14 @@ soft_reset:
     // if an SD card is present then mount it on /sd/
     if (sdcard_is_present()) {
         // if there is a file in the flash called "SKIPSD", then we don't mount the SD card
+        #if MICROPY_HW_FLASH_FS_LFS2
+        if (!mounted_flash || mp_vfs_import_stat("/flash/SKIPSD") != MP_IMPORT_STAT_FILE) {
+        #else
         if (!mounted_flash || f_stat(&fs_user_mount_flash.fatfs, "/SKIPSD", NULL) != FR_OK) {
+        #endif
 			int retry = 16;
 			while (retry--) {
-				mounted_sdcard = init_sdcard_fs(first_soft_reset);
+				mounted_sdcard = init_sdcard_fs(first_soft_reset, false);
 				if (mounted_sdcard)
 					break;
 				else
@@ -1407,6 +1598,18 @@ soft_reset_exit:
     printf("PYB: sync filesystems\n");
     storage_flush();
 	#endif
+	#if MICROPY_HW_HAS_SDCARD
+	// a read_async() may still be filling a buffer on the heap
+	sdcard_wait_idle();
+	#endif
+	// as may an ADC stream, PWM.play() and Servo.trajectory()
+	adc_stream_stop();
+	pwm_play_stop();
+	servo_trajectory_stop();
+	// and the omv.submit() worker may be in the middle of a task
+	task_init0();
+	// the profiler's Python lines refer to qstrs of this session
+	profiler_start(0, 1);
 
     printf("PYB: soft reboot\n");
     // rocky ignore: timer_deinit();
@@ -1417,7 +1620,7 @@ soft_reset_exit:
 #endif
 
     #if MICROPY_PY_THREAD
-    pyb_thread_deinit();
+    mp_thread_deinit();
     #endif
 
     first_soft_reset = false;
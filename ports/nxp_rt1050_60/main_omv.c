@@ -53,8 +53,10 @@
 
 #include "sensor.h"
 #include "usbdbg.h"
+#include "boottime.h"
 #include "sdram.h"
 #include "fb_alloc.h"
+#include "xalloc.h"
 #include "ff_wrapper.h"
 
 #include "usb_app.h"
@@ -66,6 +68,8 @@
 #include "py_fir.h"
 
 #include "framebuffer.h"
+#include "stream_server.h"
+#include "task.h"
 #include "fsl_debug_console.h"
 
 #include "ini.h"
@@ -265,6 +269,65 @@ FRESULT exec_boot_script(const char *path, bool selftest, bool interruptible)
     return f_res;
 }
 extern void ProfReset(void);
+
+// (size, mtime) of a module's file, MP_OBJ_NULL if it can't be read.
+STATIC mp_obj_t hot_reload_stamp(mp_obj_t file)
+{
+    mp_obj_t stamp = MP_OBJ_NULL;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_obj_t *st;
+        mp_obj_get_array_fixed_n(mp_vfs_stat(file), 10, &st);
+        stamp = mp_obj_new_tuple(2, (mp_obj_t[]) {st[6], st[8]});
+        nlr_pop();
+    }
+    return stamp;
+}
+
+// Hot reloaded scripts share the modules they import, the files of those are stamped when
+// first seen. With drop those whose file changed since are dropped from sys.modules, the
+// next import compiles them again, the others stay as they are.
+STATIC void hot_reload_modules(bool drop)
+{
+    if (MP_STATE_PORT(omv_hot_stamps) == MP_OBJ_NULL) {
+        MP_STATE_PORT(omv_hot_stamps) = mp_obj_new_dict(0);
+    }
+    mp_map_t *stamps = mp_obj_dict_get_map(MP_STATE_PORT(omv_hot_stamps));
+    mp_map_t *mods = &MP_STATE_VM(mp_loaded_modules_dict).map;
+    for (size_t i = 0; i < mods->alloc; i++) {
+        if (!mp_map_slot_is_filled(mods, i) || !mp_obj_is_type(mods->table[i].value, &mp_type_module)) {
+            continue;
+        }
+        mp_obj_t name = mods->table[i].key;
+        mp_obj_module_t *mod = MP_OBJ_TO_PTR(mods->table[i].value);
+        mp_map_elem_t *file = mp_map_lookup(&mod->globals->map, MP_OBJ_NEW_QSTR(MP_QSTR___file__), MP_MAP_LOOKUP);
+        mp_obj_t stamp = (file == NULL) ? MP_OBJ_NULL : hot_reload_stamp(file->value);
+        if (stamp == MP_OBJ_NULL) {
+            continue; // built in or frozen
+        }
+        mp_map_elem_t *seen = mp_map_lookup(stamps, name, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+        if (seen->value == MP_OBJ_NULL) {
+            seen->value = stamp;
+        } else if (drop && !mp_obj_equal(seen->value, stamp)) {
+            mp_map_lookup(stamps, name, MP_MAP_LOOKUP_REMOVE_IF_FOUND);
+            mp_map_lookup(mods, name, MP_MAP_LOOKUP_REMOVE_IF_FOUND);
+        }
+    }
+}
+
+// Starts a hot reloaded script: the frame buffer, the sensor and imlib's tables stay as the
+// last one left them, its fb_alloc()s, background tasks and globals go.
+STATIC void hot_reload_begin(void)
+{
+	#ifndef OMV_MPY_ONLY
+	fb_free_all();
+	task_init0();
+	#endif
+	hot_reload_modules(true);
+	mp_map_t *globals = &MP_STATE_VM(dict_main).map;
+	mp_map_clear(globals);
+	mp_obj_dict_store(MP_OBJ_FROM_PTR(&MP_STATE_VM(dict_main)), MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR___main__));
+}
 __WEAK int OverlaySwitch(uint8_t ovlyNdx) {return 0;}
 __WEAK int OverlaySetToDefault(void) {return 0;}
 
@@ -275,6 +338,7 @@ int OpenMV_Main(uint32_t first_soft_reset)
 {
 	int ret = 0;
 	PRINTF("Enter OpenMV main\r\n");
+	MP_STATE_PORT(omv_hot_stamps) = MP_OBJ_NULL;
 	// SCnSCB->ACTLR |= SCnSCB_ACTLR_DISDEFWBUF_Msk;
 /*    
 	extint_init0();
@@ -291,6 +355,14 @@ int OpenMV_Main(uint32_t first_soft_reset)
 */
 	#ifndef OMV_MPY_ONLY
 	fb_alloc_init0();
+	fb_slots_init0();
+	xalloc_arena_init0();
+	imlib_thresholds_lut_init0();
+	imlib_pyramid_init0();
+	imlib_remap_init0();
+	mjpeg_rec_init0();
+	stream_server_init0();
+	task_init0();
 	#endif
     file_buffer_init0();
     // py_lcd_init0();
@@ -335,6 +407,7 @@ int OpenMV_Main(uint32_t first_soft_reset)
 				nlr_buf_t nlr;
 				if (nlr_push(&nlr) == 0) {
                     g_isMainDotPyRunning = 1;
+					boot_time_mark(MP_QSTR_main_py);
 					int ret = pyexec_file("main.py");
                     g_isMainDotPyRunning = 0;
 					if (ret & PYEXEC_FORCED_EXIT) {
@@ -407,9 +480,21 @@ RunREPL:
 				rtt_main_thread_enable_sig(1);
 			#endif
 			// rocky: 2019.03.27 19:00 reset fb alloc memory for new script
+			if (usbdbg_get_hot_reload()) {
+				hot_reload_begin();
+			} else {
 			#ifndef OMV_MPY_ONLY
 			fb_alloc_init0();
+			fb_slots_init0();
+			xalloc_arena_init0();
+			imlib_thresholds_lut_init0();
+			imlib_pyramid_init0();
+			imlib_remap_init0();
+			mjpeg_rec_init0();
+			stream_server_init0();
+			task_init0();
 			#endif
+			}
 #if 0
 			vstr_t *buf = usbdbg_get_script();
 			mp_obj_t code = pyexec_compile_str(buf);	
@@ -418,20 +503,43 @@ RunREPL:
             pyexec_exec_code(code);
 #else
 			usbdbg_set_irq_enabled(true);
-			pyexec_str(usbdbg_get_script());
+			if (usbdbg_script_is_mpy()) {
+				pyexec_mpy(usbdbg_get_script());
+			} else {
+				pyexec_str(usbdbg_get_script());
+			}
 #endif
             nlr_pop();
         } else {
             mp_obj_print_exception(&mp_plat_print, (mp_obj_t)nlr.ret_val);
+			#ifndef OMV_MPY_ONLY
+			sensor_abort();
+			#endif
             usbdbg_stop_script();
+            if (usbdbg_get_hot_reload()) {
+                hot_reload_modules(false);
+            }
             goto RunREPL;   // rocky: script is stopped, waiting for next script
         }
+
+		// without a soft reset the next script starts as soon as it is sent
+		if (usbdbg_get_hot_reload()) {
+			#ifndef OMV_MPY_ONLY
+			sensor_abort();
+			#endif
+			usbdbg_stop_script();
+			hot_reload_modules(false);
+			goto RunREPL;
+		}
 		
 		#ifdef MICROPY_PY_RTTHREAD
 			rtt_main_thread_enable_sig(0);
 		#endif
     }
 cleanup:
+	#ifndef OMV_MPY_ONLY
+	sensor_abort();
+	#endif
 	usbdbg_set_irq_enabled(true);
     // Disable all other IRQs except Systick and Flash IRQs
     // Note: FS IRQ is disable, since we're going for a soft-reset.
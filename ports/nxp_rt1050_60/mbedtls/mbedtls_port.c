@@ -0,0 +1,120 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "py/mpconfig.h"
+#include "py/misc.h"
+#include "rng.h"
+#include "extmod/crypto_hw.h"
+
+#include "mbedtls/aes.h"
+#include "mbedtls/sha256.h"
+
+// mbedtls keeps everything it allocates under the ssl socket object, so the GC sees it.
+void *m_calloc_mbedtls(size_t nmemb, size_t size) {
+    void *ptr = m_malloc_maybe(nmemb * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+
+void m_free_mbedtls(void *ptr) {
+    m_free(ptr);
+}
+
+int mbedtls_hardware_poll(void *data, unsigned char *output, size_t len, size_t *olen) {
+    (void)data;
+    if (rng_get_entropy(output, len) != 0) {
+        *olen = 0;
+        return -1;
+    }
+    *olen = len;
+    return 0;
+}
+
+/******************************************************************************/
+// AES-128 and SHA-256 on the DCP, see dcp.c.
+
+// The key is kept in the context (nr and rk as the software version has them) and sent as
+// the payload key with every block.
+int mbedtls_aes_setkey_enc(mbedtls_aes_context *ctx, const unsigned char *key, unsigned int keybits) {
+    if (keybits != 128) {
+        return MBEDTLS_ERR_AES_INVALID_KEY_LENGTH;
+    }
+    ctx->nr = 10;
+    ctx->rk = ctx->buf;
+    memcpy(ctx->rk, key, 16);
+    return 0;
+}
+
+int mbedtls_aes_setkey_dec(mbedtls_aes_context *ctx, const unsigned char *key, unsigned int keybits) {
+    return mbedtls_aes_setkey_enc(ctx, key, keybits);
+}
+
+int mbedtls_internal_aes_encrypt(mbedtls_aes_context *ctx, const unsigned char input[16], unsigned char output[16]) {
+    return mp_hw_aes((const uint8_t *)ctx->rk, NULL, input, output, 16, true) ? MBEDTLS_ERR_AES_HW_ACCEL_FAILED : 0;
+}
+
+int mbedtls_internal_aes_decrypt(mbedtls_aes_context *ctx, const unsigned char input[16], unsigned char output[16]) {
+    return mp_hw_aes((const uint8_t *)ctx->rk, NULL, input, output, 16, false) ? MBEDTLS_ERR_AES_HW_ACCEL_FAILED : 0;
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context *ctx) {
+    memset(ctx, 0, sizeof(mbedtls_sha256_context));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context *ctx) {
+    if (ctx != NULL) {
+        memset(ctx, 0, sizeof(mbedtls_sha256_context));
+    }
+}
+
+void mbedtls_sha256_clone(mbedtls_sha256_context *dst, const mbedtls_sha256_context *src) {
+    *dst = *src;
+}
+
+// The DCP has no SHA-224.
+int mbedtls_sha256_starts_ret(mbedtls_sha256_context *ctx, int is224) {
+    if (is224) {
+        return MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED;
+    }
+    ctx->is224 = is224;
+    return mp_hw_hash_init(&ctx->ctx, MP_HW_HASH_SHA256) ? MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED : 0;
+}
+
+int mbedtls_sha256_update_ret(mbedtls_sha256_context *ctx, const unsigned char *input, size_t ilen) {
+    return mp_hw_hash_update(&ctx->ctx, input, ilen) ? MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED : 0;
+}
+
+int mbedtls_sha256_finish_ret(mbedtls_sha256_context *ctx, unsigned char output[32]) {
+    return mp_hw_hash_final(&ctx->ctx, output) ? MBEDTLS_ERR_SHA256_HW_ACCEL_FAILED : 0;
+}
+
+int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx, const unsigned char data[64]) {
+    return mbedtls_sha256_update_ret(ctx, data, 64);
+}
@@ -0,0 +1,13 @@
+/*
+ * SHA-256 on the DCP, see mbedtls_port.c.
+ */
+#ifndef MICROPY_INCLUDED_SHA256_ALT_H
+#define MICROPY_INCLUDED_SHA256_ALT_H
+#include "fsl_dcp.h"
+
+typedef struct mbedtls_sha256_context {
+    dcp_hash_ctx_t ctx;
+    int is224;
+} mbedtls_sha256_context;
+
+#endif /* MICROPY_INCLUDED_SHA256_ALT_H */
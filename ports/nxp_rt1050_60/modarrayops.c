@@ -0,0 +1,832 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// uarray.ops: element-wise math on array and bytearray buffers.
+//
+// Integer results saturate to the range of the destination type, like the
+// CMSIS q7/q15 functions.  8 and 16 bit buffers of the same type are worked on
+// a word at a time with the Cortex-M7 SIMD instructions, everything else goes
+// through typed C loops.  In-place functions return None.
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include "fsl_common.h"
+
+#include "py/runtime.h"
+#include "py/binary.h"
+#include "py/objint.h"
+
+#if MICROPY_PY_UARRAY_OPS
+
+typedef struct _ops_buf_t {
+    void *buf;
+    size_t len;
+    char typecode;
+} ops_buf_t;
+
+// The integer element types, with their ranges.
+#define OPS_INT_TYPES(X) \
+    X('b', int8_t, INT8_MIN, INT8_MAX) \
+    X('B', uint8_t, 0, UINT8_MAX) \
+    X('h', int16_t, INT16_MIN, INT16_MAX) \
+    X('H', uint16_t, 0, UINT16_MAX) \
+    X('i', int32_t, INT32_MIN, INT32_MAX) \
+    X('I', uint32_t, 0, UINT32_MAX)
+
+STATIC void ops_get_buffer(mp_obj_t obj, ops_buf_t *b, mp_uint_t flags) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(obj, &bufinfo, flags);
+    char typecode = bufinfo.typecode;
+    size_t sz = 4;
+    switch (typecode) {
+        case BYTEARRAY_TYPECODE:
+            typecode = 'B';
+            // fall through
+        case 'b':
+        case 'B':
+            sz = 1;
+            break;
+        case 'h':
+        case 'H':
+            sz = 2;
+            break;
+        case 'l':
+            typecode = 'i';
+            break;
+        case 'L':
+            typecode = 'I';
+            break;
+        case 'i':
+        case 'I':
+        case 'f':
+            break;
+        default:
+            mp_raise_ValueError("unsupported typecode");
+    }
+    b->buf = bufinfo.buf;
+    b->len = bufinfo.len / sz;
+    b->typecode = typecode;
+}
+
+STATIC inline int64_t ops_clamp(int64_t v, int64_t lo, int64_t hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// Rounds to the nearest integer and saturates.
+STATIC inline int64_t ops_clamp_float(float v, int64_t lo, int64_t hi) {
+    if (!(v > (float)lo)) {
+        // also catches nan
+        return lo;
+    } else if (v >= (float)hi) {
+        return hi;
+    }
+    return lroundf(v);
+}
+
+// Element access for the mixed type paths.
+STATIC int64_t ops_get_int(const ops_buf_t *b, size_t i) {
+    switch (b->typecode) {
+        #define X(tc, T, MIN, MAX) case tc: return ((T*)b->buf)[i];
+        OPS_INT_TYPES(X)
+        #undef X
+        default:
+            return ops_clamp_float(((float*)b->buf)[i], INT32_MIN, INT32_MAX);
+    }
+}
+
+STATIC float ops_get_float(const ops_buf_t *b, size_t i) {
+    if (b->typecode == 'f') {
+        return ((float*)b->buf)[i];
+    }
+    return ops_get_int(b, i);
+}
+
+STATIC void ops_set_int(const ops_buf_t *b, size_t i, int64_t v) {
+    switch (b->typecode) {
+        #define X(tc, T, MIN, MAX) case tc: ((T*)b->buf)[i] = ops_clamp(v, MIN, MAX); break;
+        OPS_INT_TYPES(X)
+        #undef X
+        default:
+            ((float*)b->buf)[i] = v;
+            break;
+    }
+}
+
+STATIC void ops_set_float(const ops_buf_t *b, size_t i, float v) {
+    switch (b->typecode) {
+        #define X(tc, T, MIN, MAX) case tc: ((T*)b->buf)[i] = ops_clamp_float(v, MIN, MAX); break;
+        OPS_INT_TYPES(X)
+        #undef X
+        default:
+            ((float*)b->buf)[i] = v;
+            break;
+    }
+}
+
+// Number of elements both buffers have.
+STATIC size_t ops_len2(const ops_buf_t *a, const ops_buf_t *b) {
+    return MIN(a->len, b->len);
+}
+
+STATIC bool ops_word_aligned(const ops_buf_t *a, const ops_buf_t *b) {
+    return (((uintptr_t)a->buf | (uintptr_t)b->buf) & 3) == 0;
+}
+
+// Saturating add/subtract of same type 8/16 bit buffers, 4 or 2 lanes per word.
+// Returns the number of elements done.
+STATIC size_t ops_simd_add(const ops_buf_t *d, const ops_buf_t *s, size_t n, bool sub) {
+    if (d->typecode != s->typecode || !ops_word_aligned(d, s)) {
+        return 0;
+    }
+    uint32_t *dw = d->buf;
+    const uint32_t *sw = s->buf;
+    size_t lanes;
+    switch (d->typecode) {
+        case 'b':
+            lanes = 4;
+            for (size_t k = 0; k < n / 4; k++) {
+                dw[k] = sub ? __QSUB8(dw[k], sw[k]) : __QADD8(dw[k], sw[k]);
+            }
+            break;
+        case 'B':
+            lanes = 4;
+            for (size_t k = 0; k < n / 4; k++) {
+                dw[k] = sub ? __UQSUB8(dw[k], sw[k]) : __UQADD8(dw[k], sw[k]);
+            }
+            break;
+        case 'h':
+            lanes = 2;
+            for (size_t k = 0; k < n / 2; k++) {
+                dw[k] = sub ? __QSUB16(dw[k], sw[k]) : __QADD16(dw[k], sw[k]);
+            }
+            break;
+        case 'H':
+            lanes = 2;
+            for (size_t k = 0; k < n / 2; k++) {
+                dw[k] = sub ? __UQSUB16(dw[k], sw[k]) : __UQADD16(dw[k], sw[k]);
+            }
+            break;
+        default:
+            return 0;
+    }
+    return n / lanes * lanes;
+}
+
+STATIC void ops_add_sub(mp_obj_t dst_in, mp_obj_t src_in, bool sub) {
+    ops_buf_t d;
+    ops_get_buffer(dst_in, &d, MP_BUFFER_RW);
+
+    if (mp_obj_is_int(src_in) || mp_obj_is_float(src_in)) {
+        // a scalar offset
+        if (d.typecode == 'f') {
+            float k = mp_obj_get_float(src_in);
+            k = sub ? -k : k;
+            float *p = d.buf;
+            for (size_t i = 0; i < d.len; i++) {
+                p[i] += k;
+            }
+            return;
+        }
+        int64_t k = mp_obj_get_int(src_in);
+        k = sub ? -k : k;
+        switch (d.typecode) {
+            #define X(tc, T, MIN, MAX) case tc: { \
+                T *p = d.buf; \
+                for (size_t i = 0; i < d.len; i++) { \
+                    p[i] = ops_clamp(p[i] + k, MIN, MAX); \
+                } \
+                break; \
+            }
+            OPS_INT_TYPES(X)
+            #undef X
+        }
+        return;
+    }
+
+    ops_buf_t s;
+    ops_get_buffer(src_in, &s, MP_BUFFER_READ);
+    size_t n = ops_len2(&d, &s);
+    size_t i = ops_simd_add(&d, &s, n, sub);
+    if (d.typecode == 'f') {
+        float *p = d.buf;
+        if (s.typecode == 'f') {
+            const float *q = s.buf;
+            for (; i < n; i++) {
+                p[i] = sub ? (p[i] - q[i]) : (p[i] + q[i]);
+            }
+        } else {
+            for (; i < n; i++) {
+                p[i] = sub ? (p[i] - ops_get_float(&s, i)) : (p[i] + ops_get_float(&s, i));
+            }
+        }
+    } else {
+        for (; i < n; i++) {
+            int64_t a = ops_get_int(&d, i), b = ops_get_int(&s, i);
+            ops_set_int(&d, i, sub ? (a - b) : (a + b));
+        }
+    }
+}
+
+// add(dst, src): dst[i] += src[i], src is a buffer or a number
+STATIC mp_obj_t ops_add(mp_obj_t dst_in, mp_obj_t src_in) {
+    ops_add_sub(dst_in, src_in, false);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(ops_add_obj, ops_add);
+
+// sub(dst, src): dst[i] -= src[i], src is a buffer or a number
+STATIC mp_obj_t ops_sub(mp_obj_t dst_in, mp_obj_t src_in) {
+    ops_add_sub(dst_in, src_in, true);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(ops_sub_obj, ops_sub);
+
+// mul(dst, src): dst[i] *= src[i]
+STATIC mp_obj_t ops_mul(mp_obj_t dst_in, mp_obj_t src_in) {
+    ops_buf_t d, s;
+    ops_get_buffer(dst_in, &d, MP_BUFFER_RW);
+    ops_get_buffer(src_in, &s, MP_BUFFER_READ);
+    size_t n = ops_len2(&d, &s);
+    if (d.typecode == s.typecode) {
+        switch (d.typecode) {
+            #define X(tc, T, MIN, MAX) case tc: { \
+                T *p = d.buf; \
+                const T *q = s.buf; \
+                for (size_t i = 0; i < n; i++) { \
+                    p[i] = ops_clamp((int64_t)p[i] * q[i], MIN, MAX); \
+                } \
+                return mp_const_none; \
+            }
+            OPS_INT_TYPES(X)
+            #undef X
+            default: {
+                float *p = d.buf;
+                const float *q = s.buf;
+                for (size_t i = 0; i < n; i++) {
+                    p[i] *= q[i];
+                }
+                return mp_const_none;
+            }
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (d.typecode == 'f' || s.typecode == 'f') {
+            ops_set_float(&d, i, ops_get_float(&d, i) * ops_get_float(&s, i));
+        } else {
+            ops_set_int(&d, i, ops_get_int(&d, i) * ops_get_int(&s, i));
+        }
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(ops_mul_obj, ops_mul);
+
+// scale(buf, k, offset=0): buf[i] = buf[i] * k + offset, rounded for integer buffers
+STATIC mp_obj_t ops_scale(size_t n_args, const mp_obj_t *args) {
+    ops_buf_t b;
+    ops_get_buffer(args[0], &b, MP_BUFFER_RW);
+    float k = mp_obj_get_float(args[1]);
+    float offset = n_args > 2 ? mp_obj_get_float(args[2]) : 0.0f;
+    switch (b.typecode) {
+        #define X(tc, T, MIN, MAX) case tc: { \
+            T *p = b.buf; \
+            for (size_t i = 0; i < b.len; i++) { \
+                p[i] = ops_clamp_float(p[i] * k + offset, MIN, MAX); \
+            } \
+            break; \
+        }
+        OPS_INT_TYPES(X)
+        #undef X
+        default: {
+            float *p = b.buf;
+            for (size_t i = 0; i < b.len; i++) {
+                p[i] = p[i] * k + offset;
+            }
+            break;
+        }
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ops_scale_obj, 2, 3, ops_scale);
+
+// clip(buf, lo, hi): limits every element to [lo, hi]
+STATIC mp_obj_t ops_clip(mp_obj_t buf_in, mp_obj_t lo_in, mp_obj_t hi_in) {
+    ops_buf_t b;
+    ops_get_buffer(buf_in, &b, MP_BUFFER_RW);
+    if (b.typecode == 'f') {
+        float lo = mp_obj_get_float(lo_in), hi = mp_obj_get_float(hi_in);
+        float *p = b.buf;
+        for (size_t i = 0; i < b.len; i++) {
+            p[i] = p[i] < lo ? lo : (p[i] > hi ? hi : p[i]);
+        }
+        return mp_const_none;
+    }
+    int64_t lo = mp_obj_get_int(lo_in), hi = mp_obj_get_int(hi_in);
+    switch (b.typecode) {
+        #define X(tc, T, MIN, MAX) case tc: { \
+            T l = ops_clamp(lo, MIN, MAX), h = ops_clamp(hi, MIN, MAX); \
+            T *p = b.buf; \
+            for (size_t i = 0; i < b.len; i++) { \
+                p[i] = p[i] < l ? l : (p[i] > h ? h : p[i]); \
+            } \
+            break; \
+        }
+        OPS_INT_TYPES(X)
+        #undef X
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(ops_clip_obj, ops_clip);
+
+// 32-bit SIMD accumulators are folded into the 64-bit total this often
+#define OPS_ACC_WORDS (16384)
+
+// sum(buf): the sum of the elements, an int or a float
+STATIC mp_obj_t ops_sum(mp_obj_t buf_in) {
+    ops_buf_t b;
+    ops_get_buffer(buf_in, &b, MP_BUFFER_READ);
+    if (b.typecode == 'f') {
+        const float *p = b.buf;
+        float acc[4] = {0};
+        size_t i = 0;
+        for (; i + 4 <= b.len; i += 4) {
+            acc[0] += p[i];
+            acc[1] += p[i + 1];
+            acc[2] += p[i + 2];
+            acc[3] += p[i + 3];
+        }
+        for (; i < b.len; i++) {
+            acc[0] += p[i];
+        }
+        return mp_obj_new_float((acc[0] + acc[1]) + (acc[2] + acc[3]));
+    }
+
+    int64_t total = 0;
+    size_t i = 0;
+    if (((uintptr_t)b.buf & 3) == 0) {
+        const uint32_t *w = b.buf;
+        size_t words = 0;
+        switch (b.typecode) {
+            case 'b':
+                words = b.len / 4;
+                for (size_t k = 0; k < words;) {
+                    int32_t acc = 0;
+                    for (size_t e = MIN(words, k + OPS_ACC_WORDS); k < e; k++) {
+                        acc = __SMLAD(__SXTB16(w[k]), 0x00010001, acc);
+                        acc = __SMLAD(__SXTB16(__ROR(w[k], 8)), 0x00010001, acc);
+                    }
+                    total += acc;
+                }
+                i = words * 4;
+                break;
+            case 'B':
+                words = b.len / 4;
+                for (size_t k = 0; k < words;) {
+                    uint32_t acc = 0;
+                    for (size_t e = MIN(words, k + OPS_ACC_WORDS); k < e; k++) {
+                        acc = __USADA8(w[k], 0, acc);
+                    }
+                    total += acc;
+                }
+                i = words * 4;
+                break;
+            case 'h':
+                words = b.len / 2;
+                for (size_t k = 0; k < words; k++) {
+                    total = __SMLALD(w[k], 0x00010001, total);
+                }
+                i = words * 2;
+                break;
+        }
+    }
+    for (; i < b.len; i++) {
+        total += ops_get_int(&b, i);
+    }
+    return mp_obj_new_int_from_ll(total);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(ops_sum_obj, ops_sum);
+
+// dot(a, b): the sum of a[i] * b[i], an int or a float
+STATIC mp_obj_t ops_dot(mp_obj_t a_in, mp_obj_t b_in) {
+    ops_buf_t a, b;
+    ops_get_buffer(a_in, &a, MP_BUFFER_READ);
+    ops_get_buffer(b_in, &b, MP_BUFFER_READ);
+    size_t n = ops_len2(&a, &b);
+    if (a.typecode == 'f' || b.typecode == 'f') {
+        float acc[4] = {0};
+        size_t i = 0;
+        if (a.typecode == 'f' && b.typecode == 'f') {
+            const float *p = a.buf, *q = b.buf;
+            for (; i + 4 <= n; i += 4) {
+                acc[0] += p[i] * q[i];
+                acc[1] += p[i + 1] * q[i + 1];
+                acc[2] += p[i + 2] * q[i + 2];
+                acc[3] += p[i + 3] * q[i + 3];
+            }
+        }
+        for (; i < n; i++) {
+            acc[0] += ops_get_float(&a, i) * ops_get_float(&b, i);
+        }
+        return mp_obj_new_float((acc[0] + acc[1]) + (acc[2] + acc[3]));
+    }
+
+    int64_t total = 0;
+    size_t i = 0;
+    if (a.typecode == b.typecode && ops_word_aligned(&a, &b)) {
+        const uint32_t *p = a.buf, *q = b.buf;
+        size_t words;
+        switch (a.typecode) {
+            case 'b':
+                words = n / 4;
+                for (size_t k = 0; k < words;) {
+                    int32_t acc = 0;
+                    for (size_t e = MIN(words, k + OPS_ACC_WORDS); k < e; k++) {
+                        acc = __SMLAD(__SXTB16(p[k]), __SXTB16(q[k]), acc);
+                        acc = __SMLAD(__SXTB16(__ROR(p[k], 8)), __SXTB16(__ROR(q[k], 8)), acc);
+                    }
+                    total += acc;
+                }
+                i = words * 4;
+                break;
+            case 'h':
+                words = n / 2;
+                for (size_t k = 0; k < words; k++) {
+                    total = __SMLALD(p[k], q[k], total);
+                }
+                i = words * 2;
+                break;
+        }
+    }
+    for (; i < n; i++) {
+        total += ops_get_int(&a, i) * ops_get_int(&b, i);
+    }
+    return mp_obj_new_int_from_ll(total);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(ops_dot_obj, ops_dot);
+
+STATIC mp_obj_t ops_min_max(mp_obj_t buf_in, bool is_max) {
+    ops_buf_t b;
+    ops_get_buffer(buf_in, &b, MP_BUFFER_READ);
+    if (b.len == 0) {
+        mp_raise_ValueError("empty buffer");
+    }
+    switch (b.typecode) {
+        #define X(tc, T, MIN, MAX) case tc: { \
+            const T *p = b.buf; \
+            T m = p[0]; \
+            for (size_t i = 1; i < b.len; i++) { \
+                m = (is_max ? (p[i] > m) : (p[i] < m)) ? p[i] : m; \
+            } \
+            return mp_obj_new_int_from_ll(m); \
+        }
+        OPS_INT_TYPES(X)
+        #undef X
+        default: {
+            const float *p = b.buf;
+            float m = p[0];
+            for (size_t i = 1; i < b.len; i++) {
+                m = (is_max ? (p[i] > m) : (p[i] < m)) ? p[i] : m;
+            }
+            return mp_obj_new_float(m);
+        }
+    }
+}
+
+// min(buf), max(buf): the smallest or largest element
+STATIC mp_obj_t ops_min(mp_obj_t buf_in) {
+    return ops_min_max(buf_in, false);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(ops_min_obj, ops_min);
+
+STATIC mp_obj_t ops_max(mp_obj_t buf_in) {
+    return ops_min_max(buf_in, true);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(ops_max_obj, ops_max);
+
+// convert(dst, src, scale=1): dst[i] = src[i] * scale in the type of dst
+STATIC mp_obj_t ops_convert(size_t n_args, const mp_obj_t *args) {
+    ops_buf_t d, s;
+    ops_get_buffer(args[0], &d, MP_BUFFER_WRITE);
+    ops_get_buffer(args[1], &s, MP_BUFFER_READ);
+    size_t n = ops_len2(&d, &s);
+    float k = n_args > 2 ? mp_obj_get_float(args[2]) : 1.0f;
+
+    if (d.typecode == 'f') {
+        // the usual ADC/IMU samples to float step
+        float *p = d.buf;
+        switch (s.typecode) {
+            #define X(tc, T, MIN, MAX) case tc: { \
+                const T *q = s.buf; \
+                for (size_t i = 0; i < n; i++) { \
+                    p[i] = q[i] * k; \
+                } \
+                break; \
+            }
+            OPS_INT_TYPES(X)
+            #undef X
+            default: {
+                const float *q = s.buf;
+                for (size_t i = 0; i < n; i++) {
+                    p[i] = q[i] * k;
+                }
+                break;
+            }
+        }
+    } else if (n_args > 2 || s.typecode == 'f') {
+        for (size_t i = 0; i < n; i++) {
+            ops_set_float(&d, i, ops_get_float(&s, i) * k);
+        }
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            ops_set_int(&d, i, ops_get_int(&s, i));
+        }
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ops_convert_obj, 2, 3, ops_convert);
+
+/******************************************************************************/
+// Filters keep their state between calls, so a stream is filtered one buffer at a time.
+// process(src, dst=src) takes 'f' or 'h' arrays of the same type, works in place when dst
+// is src and never allocates; the state is bound to the typecode it first sees until reset().
+
+#define OPS_FIR_BLOCK (32)
+
+// The floats of an array, list or tuple of numbers, in a new block.
+STATIC float *ops_get_floats(mp_obj_t obj, size_t *n) {
+    size_t len = mp_obj_get_int(mp_obj_len(obj));
+    if (len == 0) {
+        mp_raise_ValueError("empty coefficients");
+    }
+    float *f = m_new(float, len);
+    mp_obj_t iter = mp_getiter(obj, NULL), item;
+    for (size_t i = 0; i < len && (item = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION; i++) {
+        f[i] = mp_obj_get_float(item);
+    }
+    *n = len;
+    return f;
+}
+
+// src and dst=src for process(), returns the number of elements of src.
+STATIC size_t ops_filter_buffers(size_t n_args, const mp_obj_t *args, ops_buf_t *s, ops_buf_t *d) {
+    ops_get_buffer(args[1], s, MP_BUFFER_READ);
+    ops_get_buffer(n_args > 2 ? args[2] : args[1], d, MP_BUFFER_WRITE);
+    if ((s->typecode != 'f' && s->typecode != 'h') || d->typecode != s->typecode) {
+        mp_raise_ValueError("need 'f' or 'h' arrays of one type");
+    }
+    return s->len;
+}
+
+STATIC void ops_filter_bind(char *state_typecode, char typecode) {
+    if (*state_typecode == 0) {
+        *state_typecode = typecode;
+    } else if (*state_typecode != typecode) {
+        mp_raise_ValueError("state is for another typecode, reset() first");
+    }
+}
+
+// Biquad(coeffs): a cascade of second order sections in transposed direct form II, as
+// arm_biquad_cascade_df2T_f32. coeffs has 5 per section, b0 b1 b2 a1 a2, with a1 and a2
+// negated as CMSIS has them: y = b0*x + b1*x1 + b2*x2 + a1*y1 + a2*y2. 'h' samples are
+// filtered in float and rounded back.
+typedef struct _ops_biquad_obj_t {
+    mp_obj_base_t base;
+    size_t stages;
+    float *coeffs;
+    float *state;   // d1 d2 per section
+} ops_biquad_obj_t;
+
+STATIC const mp_obj_type_t ops_biquad_type;
+
+STATIC mp_obj_t ops_biquad_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+    ops_biquad_obj_t *self = m_new_obj(ops_biquad_obj_t);
+    self->base.type = &ops_biquad_type;
+    size_t n;
+    self->coeffs = ops_get_floats(args[0], &n);
+    if (n % 5) {
+        mp_raise_ValueError("need 5 coefficients per section");
+    }
+    self->stages = n / 5;
+    self->state = m_new0(float, self->stages * 2);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+STATIC inline float ops_biquad_step(const float *c, float *d, float x) {
+    float y = c[0] * x + d[0];
+    d[0] = c[1] * x + c[3] * y + d[1];
+    d[1] = c[2] * x + c[4] * y;
+    return y;
+}
+
+STATIC mp_obj_t ops_biquad_process(size_t n_args, const mp_obj_t *args) {
+    ops_biquad_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    ops_buf_t s, d;
+    size_t n = ops_filter_buffers(n_args, args, &s, &d);
+    if (d.len < n) {
+        mp_raise_ValueError("dst too short");
+    }
+
+    if (s.typecode == 'f') {
+        // a section at a time over the whole buffer, the later ones in place in dst
+        const float *x = s.buf;
+        float *y = d.buf;
+        for (size_t k = 0; k < self->stages; k++, x = y) {
+            const float *c = self->coeffs + k * 5;
+            float *st = self->state + k * 2;
+            for (size_t i = 0; i < n; i++) {
+                y[i] = ops_biquad_step(c, st, x[i]);
+            }
+        }
+    } else {
+        // every section per sample, so nothing is rounded in between
+        const int16_t *x = s.buf;
+        int16_t *y = d.buf;
+        for (size_t i = 0; i < n; i++) {
+            float v = x[i];
+            for (size_t k = 0; k < self->stages; k++) {
+                v = ops_biquad_step(self->coeffs + k * 5, self->state + k * 2, v);
+            }
+            y[i] = ops_clamp_float(v, INT16_MIN, INT16_MAX);
+        }
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ops_biquad_process_obj, 2, 3, ops_biquad_process);
+
+STATIC mp_obj_t ops_biquad_reset(mp_obj_t self_in) {
+    ops_biquad_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    memset(self->state, 0, sizeof(float) * self->stages * 2);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(ops_biquad_reset_obj, ops_biquad_reset);
+
+STATIC const mp_rom_map_elem_t ops_biquad_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_process), MP_ROM_PTR(&ops_biquad_process_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&ops_biquad_reset_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(ops_biquad_locals_dict, ops_biquad_locals_dict_table);
+
+STATIC const mp_obj_type_t ops_biquad_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Biquad,
+    .make_new = ops_biquad_make_new,
+    .locals_dict = (mp_obj_dict_t*)&ops_biquad_locals_dict,
+};
+
+// FIR(taps, decimate=1): y[n] = sum(taps[k] * x[n - k]), as arm_fir_f32 for 'f' and as
+// arm_fir_q15 for 'h', where the taps are taken in Q15 (|tap| < 1) and the sums shifted
+// back by 15 and saturated. With decimate > 1 only every decimate-th output is computed and
+// written, as arm_fir_decimate does, and the count carries over between calls.
+// process() returns the number of samples written to dst.
+typedef struct _ops_fir_obj_t {
+    mp_obj_base_t base;
+    uint16_t ntaps;
+    uint16_t decimate;
+    uint16_t phase;     // inputs since the last output
+    char typecode;      // of the samples in state, 0 before the first
+    float *taps;
+    int16_t *taps_q15;
+    void *state;        // the last ntaps - 1 inputs, then room for a block
+} ops_fir_obj_t;
+
+STATIC const mp_obj_type_t ops_fir_type;
+
+STATIC mp_obj_t ops_fir_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_taps, ARG_decimate };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_taps, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_decimate, MP_ARG_INT, {.u_int = 1} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    ops_fir_obj_t *self = m_new_obj(ops_fir_obj_t);
+    self->base.type = &ops_fir_type;
+    size_t n;
+    float *taps = ops_get_floats(args[ARG_taps].u_obj, &n);
+    if (n > UINT16_MAX || args[ARG_decimate].u_int < 1 || args[ARG_decimate].u_int > UINT16_MAX) {
+        mp_raise_ValueError(NULL);
+    }
+    self->ntaps = n;
+    self->decimate = args[ARG_decimate].u_int;
+    self->phase = 0;
+    self->typecode = 0;
+    self->taps = taps;
+    self->taps_q15 = m_new(int16_t, n);
+    for (size_t i = 0; i < n; i++) {
+        self->taps_q15[i] = ops_clamp_float(taps[i] * 32768.0f, INT16_MIN, INT16_MAX);
+    }
+    self->state = m_new0(float, n - 1 + OPS_FIR_BLOCK);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+// One output from the ntaps inputs ending at x, oldest first.
+#define OPS_FIR_DOT(T, ACC, taps, x, ntaps, acc) {     const T *xp = (x);     for (size_t k = 0; k < (ntaps); k++) {         (acc) += (ACC)(taps)[k] * xp[-(ptrdiff_t)k];     } }
+
+STATIC mp_obj_t ops_fir_process(size_t n_args, const mp_obj_t *args) {
+    ops_fir_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    ops_buf_t s, d;
+    size_t n = ops_filter_buffers(n_args, args, &s, &d);
+    if (d.len < (self->phase + n) / self->decimate) {
+        mp_raise_ValueError("dst too short");
+    }
+    ops_filter_bind(&self->typecode, s.typecode);
+
+    size_t hist = self->ntaps - 1, out = 0;
+    size_t sz = (s.typecode == 'f') ? sizeof(float) : sizeof(int16_t);
+    uint8_t *state = self->state;
+    for (size_t i = 0; i < n;) {
+        // the block goes in behind the history first, so in place dst can't clobber it
+        size_t b = MIN(n - i, OPS_FIR_BLOCK);
+        memcpy(state + hist * sz, (uint8_t*)s.buf + i * sz, b * sz);
+        for (size_t j = 0; j < b; j++) {
+            if (++self->phase < self->decimate) {
+                continue;
+            }
+            self->phase = 0;
+            if (s.typecode == 'f') {
+                float acc = 0.0f;
+                OPS_FIR_DOT(float, float, self->taps, (float*)state + hist + j, self->ntaps, acc);
+                ((float*)d.buf)[out++] = acc;
+            } else {
+                int64_t acc = 0;
+                OPS_FIR_DOT(int16_t, int32_t, self->taps_q15, (int16_t*)state + hist + j, self->ntaps, acc);
+                ((int16_t*)d.buf)[out++] = ops_clamp(acc >> 15, INT16_MIN, INT16_MAX);
+            }
+        }
+        memmove(state, state + b * sz, hist * sz);
+        i += b;
+    }
+    return MP_OBJ_NEW_SMALL_INT(out);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ops_fir_process_obj, 2, 3, ops_fir_process);
+
+STATIC mp_obj_t ops_fir_reset(mp_obj_t self_in) {
+    ops_fir_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    memset(self->state, 0, sizeof(float) * (self->ntaps - 1 + OPS_FIR_BLOCK));
+    self->phase = 0;
+    self->typecode = 0;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(ops_fir_reset_obj, ops_fir_reset);
+
+STATIC const mp_rom_map_elem_t ops_fir_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_process), MP_ROM_PTR(&ops_fir_process_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&ops_fir_reset_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(ops_fir_locals_dict, ops_fir_locals_dict_table);
+
+STATIC const mp_obj_type_t ops_fir_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_FIR,
+    .make_new = ops_fir_make_new,
+    .locals_dict = (mp_obj_dict_t*)&ops_fir_locals_dict,
+};
+
+STATIC const mp_rom_map_elem_t mp_module_uarray_ops_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_ops) },
+    { MP_ROM_QSTR(MP_QSTR_add), MP_ROM_PTR(&ops_add_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&ops_sub_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mul), MP_ROM_PTR(&ops_mul_obj) },
+    { MP_ROM_QSTR(MP_QSTR_scale), MP_ROM_PTR(&ops_scale_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clip), MP_ROM_PTR(&ops_clip_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sum), MP_ROM_PTR(&ops_sum_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dot), MP_ROM_PTR(&ops_dot_obj) },
+    { MP_ROM_QSTR(MP_QSTR_min), MP_ROM_PTR(&ops_min_obj) },
+    { MP_ROM_QSTR(MP_QSTR_max), MP_ROM_PTR(&ops_max_obj) },
+    { MP_ROM_QSTR(MP_QSTR_convert), MP_ROM_PTR(&ops_convert_obj) },
+    { MP_ROM_QSTR(MP_QSTR_Biquad), MP_ROM_PTR(&ops_biquad_type) },
+    { MP_ROM_QSTR(MP_QSTR_FIR), MP_ROM_PTR(&ops_fir_type) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(mp_module_uarray_ops_globals, mp_module_uarray_ops_globals_table);
+
+const mp_obj_module_t mp_module_uarray_ops = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t*)&mp_module_uarray_ops_globals,
+};
+
+#endif // MICROPY_PY_UARRAY_OPS
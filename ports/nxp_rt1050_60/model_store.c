@@ -0,0 +1,154 @@
+/*
+ * Flash resident model store.
+ *
+ * Entries are appended back to back, each one a header page (header plus the first
+ * bytes of the model) followed by the rest of the model. The header page is programmed
+ * last, so a model that was cut short by a reset is never found.
+ *
+ */
+#include <string.h>
+#include "fsl_flexspi.h"
+#include "flash_hyper.h"
+#include "flash_pgm.h"
+#include "overlay_manager.h"
+#include "model_store.h"
+
+#define MODEL_STORE_MAGIC       (0x4C444F4D) // "MODL"
+#define MODEL_STORE_PAGE_SIZE   (512)
+#define MODEL_STORE_ALIGN(x)    (((x) + (MODEL_STORE_PAGE_SIZE - 1)) & ~(MODEL_STORE_PAGE_SIZE - 1))
+#define MODEL_STORE_XIP(offset) ((const uint8_t *) (FlexSPI_AMBA_BASE + MODEL_STORE_FLASH_OFFSET + (offset)))
+
+static uint32_t model_store_header[MODEL_STORE_PAGE_SIZE / 4];
+static uint32_t model_store_page[MODEL_STORE_PAGE_SIZE / 4];
+
+static uint32_t model_store_offset(const model_store_entry_t *entry)
+{
+    return ((const uint8_t *) entry) - MODEL_STORE_XIP(0);
+}
+
+static uint32_t model_store_entry_size(const model_store_entry_t *entry)
+{
+    return MODEL_STORE_ALIGN(sizeof(model_store_entry_t) + entry->size);
+}
+
+const model_store_entry_t *model_store_next(const model_store_entry_t *prev)
+{
+    uint32_t offset = (prev == NULL) ? 0 : (model_store_offset(prev) + model_store_entry_size(prev));
+    if ((offset + sizeof(model_store_entry_t)) > MODEL_STORE_FLASH_SIZE) {
+        return NULL;
+    }
+
+    const model_store_entry_t *entry = (const model_store_entry_t *) MODEL_STORE_XIP(offset);
+    if ((entry->magic != MODEL_STORE_MAGIC)
+    || (entry->size > (MODEL_STORE_FLASH_SIZE - offset - sizeof(model_store_entry_t)))) {
+        return NULL;
+    }
+    return entry;
+}
+
+const uint8_t *model_store_find(const char *name, uint32_t *size)
+{
+    const model_store_entry_t *found = NULL;
+    for (const model_store_entry_t *entry = model_store_next(NULL); entry; entry = model_store_next(entry)) {
+        if (!strncmp(entry->name, name, MODEL_STORE_NAME_LEN)) {
+            found = entry;
+        }
+    }
+
+    if (found == NULL) {
+        return NULL;
+    }
+    *size = found->size;
+    return (const uint8_t *) (found + 1);
+}
+
+// Where the next entry goes.
+static uint32_t model_store_end()
+{
+    uint32_t offset = 0;
+    for (const model_store_entry_t *entry = model_store_next(NULL); entry; entry = model_store_next(entry)) {
+        offset = model_store_offset(entry) + model_store_entry_size(entry);
+    }
+    return offset;
+}
+
+uint32_t model_store_avail()
+{
+    uint32_t room = MODEL_STORE_FLASH_SIZE - model_store_end();
+    return (room > sizeof(model_store_entry_t)) ? (room - sizeof(model_store_entry_t)) : 0;
+}
+
+static bool model_store_erased(uint32_t offset, uint32_t size)
+{
+    const uint32_t *p = (const uint32_t *) MODEL_STORE_XIP(offset);
+    for (uint32_t i = 0; i < (size / 4); i++) {
+        if (p[i] != 0xFFFFFFFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int model_store_program(uint32_t offset, const uint32_t *src)
+{
+    OVERLAY_SWITCH();
+    int ret = flexspi_nor_flash_page_program(FLEXSPI, MODEL_STORE_FLASH_OFFSET + offset, src);
+    OVERLAY_RESTORE();
+    // Reads go through XIP, drop the stale lines.
+    SCB_InvalidateDCache_by_Addr((uint32_t *) MODEL_STORE_XIP(offset), MODEL_STORE_PAGE_SIZE);
+    return ret;
+}
+
+int model_store_add(const char *name, uint32_t size, model_store_read_t read, void *arg)
+{
+    uint32_t offset = model_store_end();
+    uint32_t total = MODEL_STORE_ALIGN(sizeof(model_store_entry_t) + size);
+
+    if ((strlen(name) >= MODEL_STORE_NAME_LEN) || (total > (MODEL_STORE_FLASH_SIZE - offset))) {
+        return -1;
+    }
+
+    // Pages left over by an interrupted add can't be programmed again until the store is erased.
+    if (!model_store_erased(offset, total)) {
+        return -1;
+    }
+
+    model_store_entry_t *entry = (model_store_entry_t *) model_store_header;
+    memset(model_store_header, 0xFF, sizeof(model_store_header));
+    memset(entry, 0, sizeof(model_store_entry_t));
+    entry->magic = MODEL_STORE_MAGIC;
+    entry->size = size;
+    strncpy(entry->name, name, MODEL_STORE_NAME_LEN);
+
+    uint32_t head = MODEL_STORE_PAGE_SIZE - sizeof(model_store_entry_t);
+    head = (size < head) ? size : head;
+    if (read(arg, entry + 1, head) != 0) {
+        return -1;
+    }
+
+    for (uint32_t pos = head, page = offset + MODEL_STORE_PAGE_SIZE; pos < size;
+         pos += MODEL_STORE_PAGE_SIZE, page += MODEL_STORE_PAGE_SIZE) {
+        uint32_t len = ((size - pos) < MODEL_STORE_PAGE_SIZE) ? (size - pos) : MODEL_STORE_PAGE_SIZE;
+        memset(model_store_page, 0xFF, sizeof(model_store_page));
+        if ((read(arg, model_store_page, len) != 0) || (model_store_program(page, model_store_page) != 0)) {
+            return -1;
+        }
+    }
+
+    return model_store_program(offset, model_store_header);
+}
+
+int model_store_erase()
+{
+    int ret = 0;
+    for (uint32_t offset = 0; offset < MODEL_STORE_FLASH_SIZE; offset += FLEG_EU_SIZE) {
+        // An erase takes a while, skip units that are already blank.
+        if (!model_store_erased(offset, FLEG_EU_SIZE)) {
+            OVERLAY_SWITCH();
+            ret |= flexspi_nor_flash_erase_sector(FLEXSPI, MODEL_STORE_FLASH_OFFSET + offset);
+            OVERLAY_RESTORE();
+        }
+    }
+    SCB_InvalidateDCache_by_Addr((uint32_t *) MODEL_STORE_XIP(0), MODEL_STORE_FLASH_SIZE);
+    return ret;
+}
@@ -0,0 +1,43 @@
+/*
+ * Flash resident model store.
+ *
+ * Models (nn .network or TFLite files) are kept in the HyperFlash past the flash
+ * disk and used in place through the FlexSPI XIP window, no RAM copy is made.
+ *
+ */
+#ifndef __MODEL_STORE_H__
+#define __MODEL_STORE_H__
+#include <stdint.h>
+#include "flegftl_cfg.h"
+
+// The erase units after the ones the flash disk (FTL) owns, up to the FTL's checkpoint EU.
+#define MODEL_STORE_FLASH_OFFSET    (FLEG_FLASH_OFFSET + (FLEG_EU_CNT * FLEG_EU_SIZE))
+#if FLEG_CKPT
+#define MODEL_STORE_FLASH_SIZE      ((FLEG_CKPT_EU - FLEG_EU_CNT) * FLEG_EU_SIZE)
+#else
+#define MODEL_STORE_FLASH_SIZE      ((64 * 1024 * 1024) - MODEL_STORE_FLASH_OFFSET)
+#endif
+#define MODEL_STORE_NAME_LEN        (52)
+
+// Entries are page aligned, the data follows its 64 byte header so it starts on a cache line.
+typedef struct model_store_entry {
+    uint32_t magic;
+    uint32_t size;
+    uint32_t reserved;
+    char name[MODEL_STORE_NAME_LEN];
+} model_store_entry_t;
+
+// Fills len bytes of the model being added, returns 0 on success.
+typedef int (*model_store_read_t)(void *arg, void *buf, uint32_t len);
+
+// Returns the XIP address of the last model stored as name, or NULL.
+const uint8_t *model_store_find(const char *name, uint32_t *size);
+// Walks the stored models, returns the entry after prev (NULL for the first) or NULL at the end.
+const model_store_entry_t *model_store_next(const model_store_entry_t *prev);
+// Room left for a model.
+uint32_t model_store_avail();
+// Appends a model of size bytes, returns -1 if it doesn't fit or programming failed.
+int model_store_add(const char *name, uint32_t size, model_store_read_t read, void *arg);
+// Erases the whole store.
+int model_store_erase();
+#endif // __MODEL_STORE_H__
@@ -148,7 +148,7 @@ STATIC mp_obj_t machine_info(mp_uint_t n_args, const mp_obj_t *args) {
         }
     }
 
-    #if MICROPY_PY_THREAD
+    #if MICROPY_PY_PYBTHREAD
     pyb_thread_dump();
     #endif
 
@@ -175,11 +175,16 @@ STATIC mp_obj_t machine_reset(void) {
 }
 MP_DEFINE_CONST_FUN_OBJ_0(machine_reset_obj, machine_reset);
 
-STATIC mp_obj_t machine_soft_reset(void) {
+bool machine_fast_reset_pending;
+bool machine_fast_reset;
+
+// machine.soft_reset([fast]), a fast one keeps the mounts and the sensor's configuration
+STATIC mp_obj_t machine_soft_reset(size_t n_args, const mp_obj_t *args) {
+    machine_fast_reset_pending = (n_args > 0) && mp_obj_is_true(args[0]);
     pyexec_system_exit = PYEXEC_FORCED_EXIT;
     nlr_raise(mp_obj_new_exception(&mp_type_SystemExit));
 }
-MP_DEFINE_CONST_FUN_OBJ_0(machine_soft_reset_obj, machine_soft_reset);
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(machine_soft_reset_obj, 0, 1, machine_soft_reset);
 
 // Activate the bootloader without BOOT* pins.
 STATIC NORETURN mp_obj_t machine_bootloader(void) {
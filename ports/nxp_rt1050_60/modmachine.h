@@ -33,6 +33,12 @@
 
 void machine_init(void);
 
+// Set by machine.soft_reset(True) for the soft reset it raises.
+extern bool machine_fast_reset_pending;
+// The session running now was started by such a fast soft reset: the Python heap and the
+// script state are new, the mounted file systems, USB and the sensor's registers are not.
+extern bool machine_fast_reset;
+
 MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(machine_info_obj);
 MP_DECLARE_CONST_FUN_OBJ_0(machine_unique_id_obj);
 MP_DECLARE_CONST_FUN_OBJ_0(machine_reset_obj);
@@ -76,6 +76,7 @@
 #include "tmr.h"
 #include "dcmc.h"
 #include "srpm.h"
+#include "boottime.h"
 
 extern int pyb_hard_fault_debug;
 
@@ -119,6 +120,18 @@ STATIC mp_obj_t pyb_elapsed_micros(mp_obj_t start) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_elapsed_micros_obj, pyb_elapsed_micros);
 
+/// \function boot_times()
+/// Returns a list of `(phase, us)` tuples, the microseconds from power-up, or from
+/// the soft reset, to the end of each start-up phase, up to the first frame taken.
+///
+/// Example:
+///     for phase, us in pyb.boot_times():
+///         print(phase, us / 1000)
+STATIC mp_obj_t pyb_boot_times(void) {
+    return boot_time_list();
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(pyb_boot_times_obj, pyb_boot_times);
+
 MP_DECLARE_CONST_FUN_OBJ_KW(pyb_main_obj); // defined in main.c
 
 STATIC const mp_rom_map_elem_t pyb_module_globals_table[] = {
@@ -144,6 +157,7 @@ STATIC const mp_rom_map_elem_t pyb_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&machine_sleep_obj) },
     { MP_ROM_QSTR(MP_QSTR_standby), MP_ROM_PTR(&machine_deepsleep_obj) },
     { MP_ROM_QSTR(MP_QSTR_main), MP_ROM_PTR(&pyb_main_obj) },
+    { MP_ROM_QSTR(MP_QSTR_boot_times), MP_ROM_PTR(&pyb_boot_times_obj) },
     { MP_ROM_QSTR(MP_QSTR_repl_uart), MP_ROM_PTR(&mod_os_dupterm_obj) },
 
 	{ MP_ROM_QSTR(MP_QSTR_usb_mode), MP_ROM_PTR(&pyb_usb_mode_obj) },
@@ -31,11 +31,13 @@
 #include "py/runtime.h"
 #include "py/objtuple.h"
 #include "py/objstr.h"
+#include "py/mperrno.h"
 #include "lib/timeutils/timeutils.h"
 #include "lib/oofatfs/ff.h"
 #include "lib/oofatfs/diskio.h"
 #include "extmod/vfs.h"
 #include "extmod/vfs_fat.h"
+#include "extmod/vfs_lfs.h"
 #include "genhdr/mpversion.h"
 #include "rng.h"
 #include "uart.h"
@@ -129,6 +131,167 @@ STATIC mp_obj_t os_dupterm(mp_uint_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_os_dupterm_obj, 0, 1, os_dupterm);
 
+/// \function create_contiguous(path, size)
+/// Create a file of up to `size` bytes in one contiguous run of clusters on a
+/// FAT filesystem.  The returned object's write() goes straight to the block
+/// device a sector at a time, there are no FAT lookups or updates until close()
+/// gives the unused part back.
+#define CONTIG_SECTOR_SIZE  (FF_MIN_SS)
+
+typedef struct _os_contig_file_obj_t {
+    mp_obj_base_t base;
+    FIL fp;
+    fs_user_mount_t *vfs;
+    uint32_t sector;    // first sector of the file
+    uint32_t size;      // preallocated bytes
+    uint32_t pos;       // bytes written, the ones past the last full sector are in buf
+    bool open;
+    uint8_t buf[CONTIG_SECTOR_SIZE] __attribute__((aligned(4)));
+} os_contig_file_obj_t;
+
+STATIC const mp_obj_type_t os_contig_file_type;
+
+STATIC os_contig_file_obj_t *os_contig_file_get(mp_obj_t self_in) {
+    os_contig_file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!self->open) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "I/O operation on closed file"));
+    }
+    return self;
+}
+
+STATIC void os_contig_file_put(os_contig_file_obj_t *self, uint32_t sector, uint32_t count, const uint8_t *src) {
+    if (mp_vfs_blockdev_write(&self->vfs->blockdev, self->sector + sector, count, src) != 0) {
+        mp_raise_OSError(MP_EIO);
+    }
+}
+
+STATIC mp_obj_t os_create_contiguous(mp_obj_t path_in, mp_obj_t size_in) {
+    const char *path_out;
+    mp_vfs_mount_t *vfs = mp_vfs_lookup_path(mp_obj_str_get_str(path_in), &path_out);
+    if (vfs == MP_VFS_NONE || vfs == MP_VFS_ROOT || mp_obj_get_type(vfs->obj) != &mp_fat_vfs_type) {
+        mp_raise_OSError(MP_ENODEV);
+    }
+    mp_int_t size = mp_obj_get_int(size_in);
+    if (size <= 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "size must be > 0"));
+    }
+
+    os_contig_file_obj_t *self = m_new_obj_with_finaliser(os_contig_file_obj_t);
+    self->base.type = &os_contig_file_type;
+    self->vfs = MP_OBJ_TO_PTR(vfs->obj);
+    self->size = ((size + CONTIG_SECTOR_SIZE - 1) / CONTIG_SECTOR_SIZE) * CONTIG_SECTOR_SIZE;
+    self->pos = 0;
+    self->open = false;
+
+    FRESULT res = f_open(&self->vfs->fatfs, &self->fp, path_out, FA_WRITE | FA_CREATE_ALWAYS);
+    if (res == FR_OK) {
+        res = f_expand(&self->fp, self->size, 1);
+        if (res != FR_OK) {
+            f_close(&self->fp);
+        }
+    }
+    if (res != FR_OK) {
+        mp_raise_OSError(fresult_to_errno_table[res]);
+    }
+    FATFS *fs = self->fp.obj.fs;
+    self->sector = fs->database + ((self->fp.obj.sclust - 2) * fs->csize);
+    self->open = true;
+    return MP_OBJ_FROM_PTR(self);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(os_create_contiguous_obj, os_create_contiguous);
+
+STATIC mp_obj_t os_contig_file_write(mp_obj_t self_in, mp_obj_t buf_in) {
+    os_contig_file_obj_t *self = os_contig_file_get(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    const uint8_t *src = bufinfo.buf;
+    uint32_t len = bufinfo.len;
+    if (len > (self->size - self->pos)) {
+        mp_raise_OSError(MP_ENOSPC);
+    }
+
+    // top up the partial sector first
+    uint32_t fill = self->pos % CONTIG_SECTOR_SIZE;
+    if (fill && len) {
+        uint32_t n = MIN(len, CONTIG_SECTOR_SIZE - fill);
+        memcpy(self->buf + fill, src, n);
+        src += n, len -= n, self->pos += n;
+        if ((fill + n) == CONTIG_SECTOR_SIZE) {
+            os_contig_file_put(self, (self->pos / CONTIG_SECTOR_SIZE) - 1, 1, self->buf);
+        }
+    }
+    // whole sectors straight from the caller's buffer, as one multi block write
+    if (len >= CONTIG_SECTOR_SIZE) {
+        uint32_t count = len / CONTIG_SECTOR_SIZE;
+        os_contig_file_put(self, self->pos / CONTIG_SECTOR_SIZE, count, src);
+        src += count * CONTIG_SECTOR_SIZE, len -= count * CONTIG_SECTOR_SIZE, self->pos += count * CONTIG_SECTOR_SIZE;
+    }
+    if (len) {
+        memcpy(self->buf, src, len);
+        self->pos += len;
+    }
+    return MP_OBJ_NEW_SMALL_INT(bufinfo.len);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(os_contig_file_write_obj, os_contig_file_write);
+
+STATIC mp_obj_t os_contig_file_tell(mp_obj_t self_in) {
+    return mp_obj_new_int_from_uint(os_contig_file_get(self_in)->pos);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(os_contig_file_tell_obj, os_contig_file_tell);
+
+STATIC mp_obj_t os_contig_file_close(mp_obj_t self_in) {
+    os_contig_file_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!self->open) {
+        return mp_const_none;
+    }
+    self->open = false;
+    uint32_t fill = self->pos % CONTIG_SECTOR_SIZE;
+    bool ok = true;
+    if (fill) {
+        memset(self->buf + fill, 0, CONTIG_SECTOR_SIZE - fill);
+        ok = mp_vfs_blockdev_write(&self->vfs->blockdev, self->sector + (self->pos / CONTIG_SECTOR_SIZE), 1, self->buf) == 0;
+    }
+    // give the unused part of the preallocation back
+    FRESULT res = f_lseek(&self->fp, self->pos);
+    if (res == FR_OK) {
+        res = f_truncate(&self->fp);
+    }
+    FRESULT res_close = f_close(&self->fp);
+    if (res == FR_OK) {
+        res = res_close;
+    }
+    if (res != FR_OK) {
+        mp_raise_OSError(fresult_to_errno_table[res]);
+    }
+    if (!ok) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(os_contig_file_close_obj, os_contig_file_close);
+
+STATIC mp_obj_t os_contig_file___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    return os_contig_file_close(args[0]);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(os_contig_file___exit___obj, 4, 4, os_contig_file___exit__);
+
+STATIC const mp_rom_map_elem_t os_contig_file_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&os_contig_file_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_tell), MP_ROM_PTR(&os_contig_file_tell_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&os_contig_file_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&os_contig_file_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&mp_identity_obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&os_contig_file___exit___obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(os_contig_file_locals_dict, os_contig_file_locals_dict_table);
+
+STATIC const mp_obj_type_t os_contig_file_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_ContiguousFile,
+    .locals_dict = (mp_obj_dict_t*)&os_contig_file_locals_dict,
+};
+
 STATIC const mp_rom_map_elem_t os_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uos) },
 
@@ -147,6 +310,7 @@ STATIC const mp_rom_map_elem_t os_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_unlink), MP_ROM_PTR(&mp_vfs_remove_obj) }, // unlink aliases to remove
 
     { MP_ROM_QSTR(MP_QSTR_sync), MP_ROM_PTR(&mod_os_sync_obj) },
+    { MP_ROM_QSTR(MP_QSTR_create_contiguous), MP_ROM_PTR(&os_create_contiguous_obj) },
 
     /// \constant sep - separation character used in paths
     { MP_ROM_QSTR(MP_QSTR_sep), MP_ROM_QSTR(MP_QSTR__slash_) },
@@ -160,6 +324,9 @@ STATIC const mp_rom_map_elem_t os_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_mount), MP_ROM_PTR(&mp_vfs_mount_obj) },
     { MP_ROM_QSTR(MP_QSTR_umount), MP_ROM_PTR(&mp_vfs_umount_obj) },
     { MP_ROM_QSTR(MP_QSTR_VfsFat), MP_ROM_PTR(&mp_fat_vfs_type) },
+    #if MICROPY_VFS_LFS2
+    { MP_ROM_QSTR(MP_QSTR_VfsLfs2), MP_ROM_PTR(&mp_type_vfs_lfs2) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(os_module_globals, os_module_globals_table);
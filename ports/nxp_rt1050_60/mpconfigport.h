@@ -42,6 +42,11 @@ typedef signed int ssize_t;
 
 // emitters
 #define MICROPY_PERSISTENT_CODE_LOAD (1)
+// modules.xmpy in the model store (nn.store()) is imported in place, a new one
+// takes effect at the next soft reset
+#define MICROPY_MODULE_FROZEN_XIP   (1)
+const uint8_t *model_store_find(const char *name, uint32_t *size);
+#define MICROPY_MODULE_FROZEN_XIP_IMAGE(len) model_store_find("modules.xmpy", (len))
 #define MICROPY_EMIT_THUMB          (1)
 #define MICROPY_EMIT_INLINE_THUMB   (1)
 
@@ -49,6 +54,7 @@ typedef signed int ssize_t;
 #define MICROPY_COMP_MODULE_CONST   (1)
 #define MICROPY_COMP_TRIPLE_TUPLE_ASSIGN (1)
 #define MICROPY_COMP_RETURN_IF_EXPR (1)
+#define MICROPY_COMP_STREAM         (1)
 
 // optimisations
 #ifndef __ICCARM__
@@ -58,36 +64,84 @@ typedef signed int ssize_t;
 #else
 #define MICROPY_OPT_COMPUTED_GOTO   (0)
 #endif
+#if defined(__GNUC__) && !defined(__CC_ARM)
+// the VM runs from ITCM, the startup code copies .hot_text there (boards/hot_text.ld)
+#define MICROPY_HOT_TEXT __attribute__((section(".hot_text")))
+#endif
+
+// native code (.mpy built with mpy-cross -march=armv7emsp or armv7emdp, @native, @viper) goes to ITCM when it fits
+void *native_code_commit(void *buf, size_t len, void *reloc);
+#define MP_PLAT_COMMIT_EXEC(buf, len, reloc) native_code_commit(buf, len, reloc)
 
 #define MICROPY_OBJ_BASE_ALIGNMENT __ALIGNED(4)
 
 
-#define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (0)
+#define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (1)
+#define MICROPY_OPT_CACHE_MAP_LOOKUP_SIDE_TABLE (256)
+#define MICROPY_OPT_MAP_COMPACT (1)
+#define MICROPY_OPT_SUPERINSTRUCTIONS (1)
+#if defined(__GNUC__) && !defined(__CC_ARM)
+// frozen bytecode stays in the image (vectors to __etext) and .xmpy bytecode in the
+// FlexSPI XIP window, their cache bytes go in the side table
+extern const char __VECTOR_TABLE[], __etext[];
+#define MICROPY_BC_IS_READONLY(ip)  (((const char*)(ip) >= __VECTOR_TABLE && (const char*)(ip) < __etext) \
+    || ((uintptr_t)(ip) - FlexSPI_AMBA_BASE) < 0x10000000)
+#endif
 #define MICROPY_OPT_MPZ_BITWISE     (1)
+#define MICROPY_QSTR_HASH_INDEX     (1)
 
 // Python internal features
 #define MICROPY_READER_VFS          (1)
 #define MICROPY_ENABLE_GC           (1)
 #define MICROPY_ENABLE_FINALISER    (1)
+#define MICROPY_GC_SPLIT_POOLS      (1)
+#define MICROPY_GC_LARGE_THRESHOLD  (1024)
+// share of the heap given to the large object pool, see gc_init_heap in main.c
+#define MICROPY_GC_LARGE_POOL_PERCENT (50)
+#define MICROPY_GC_INCREMENTAL_SWEEP (1)
+// blocks swept per EventPollHook while a sweep is pending
+#define MICROPY_GC_IDLE_SWEEP_BLOCKS (256)
 #define MICROPY_STACK_CHECK         (1)
 #define MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF (1)
 #define MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE (0)
 #define MICROPY_KBD_EXCEPTION       (1)
+#define MICROPY_PREALLOC_EXCEPTIONS (1)
 #define MICROPY_HELPER_REPL         (1)
 #define MICROPY_REPL_EMACS_KEYS     (1)
 #define MICROPY_REPL_AUTO_INDENT    (1)
 #define MICROPY_LONGINT_IMPL        (MICROPY_LONGINT_IMPL_MPZ)
+#define MICROPY_LONGINT_MPZ_INLINE  (1)
 #define MICROPY_ENABLE_SOURCE_LINE  (1)
 #undef MICROPY_FLOAT_IMPL
 #define MICROPY_FLOAT_IMPL          (MICROPY_FLOAT_IMPL_FLOAT)
+#define MICROPY_FLOAT_FORMAT_FAST   (1)
+// floats are held in the object word (30-bit, 2 mantissa bits short) so float math doesn't allocate
+#define MICROPY_OBJ_REPR            (MICROPY_OBJ_REPR_C)
 #define MICROPY_STREAMS_NON_BLOCK   (1)
+// btree reads its stream through the posix style wrappers
+#define MICROPY_STREAMS_POSIX_API   (MICROPY_PY_BTREE)
+// UART and USB VCP signal readiness, uselect only re-polls them when they do
+#define MICROPY_STREAMS_POLL_NOTIFY (8)
 #define MICROPY_MODULE_WEAK_LINKS   (1)
 #define MICROPY_CAN_OVERRIDE_BUILTINS (1)
 #define MICROPY_USE_INTERNAL_ERRNO  (1)
 #define MICROPY_ENABLE_SCHEDULER    (1)
 #define MICROPY_SCHEDULER_DEPTH     (8)
+// Level 1 callbacks also run from inside long imlib calls (mp_sched_check_in)
+#define MICROPY_SCHEDULER_PRIORITIES (2)
+#define MICROPY_SCHEDULER_STATS     (1)
+#define MICROPY_SCHEDULER_TICKS()   mp_hal_ticks_us()
 #define MICROPY_VFS                 (1)
 #define MICROPY_VFS_FAT             (1)
+#ifndef MICROPY_HW_FLASH_FS_LFS2
+#define MICROPY_HW_FLASH_FS_LFS2    (0)
+#endif
+// Boot straight to the first frame: no LED countdown or SD card settle wait, the sensor is
+// reset while the file systems mount, USB and the LCD come up last. See pyb.boot_times().
+#ifndef MICROPY_HW_FAST_BOOT
+#define MICROPY_HW_FAST_BOOT        (0)
+#endif
+#define MICROPY_VFS_LFS2            (MICROPY_HW_FLASH_FS_LFS2)
 
 #define MICROPY_PY_NETWORK			(1)
 #define MICROPY_PY_USOCKET			(1)
@@ -98,6 +152,7 @@ typedef signed int ssize_t;
 #define MICROPY_PY_BUILTINS_STR_PARTITION (1)
 #define MICROPY_PY_BUILTINS_STR_SPLITLINES (1)
 #define MICROPY_PY_BUILTINS_MEMORYVIEW (1)
+#define MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND (1)
 #define MICROPY_PY_BUILTINS_FROZENSET (1)
 #define MICROPY_PY_BUILTINS_SLICE_ATTRS (1)
 #define MICROPY_PY_ALL_SPECIAL_METHODS (1)
@@ -109,7 +164,12 @@ typedef signed int ssize_t;
 #define MICROPY_PY_BUILTINS_HELP_TEXT stmhal_help_text
 #define MICROPY_PY_BUILTINS_HELP_MODULES (1)
 #define MICROPY_PY_MICROPYTHON_MEM_INFO (1)
+#define MICROPY_PY_MICROPYTHON_ALLOC_STATS (1)
+#define MICROPY_PY_MICROPYTHON_PROFILE (1)
+#define MICROPY_PY_MICROPYTHON_POOL (1)
+#define MICROPY_PY_MICROPYTHON_POOL_ARENA_SIZE (8 * 1024)
 #define MICROPY_PY_ARRAY_SLICE_ASSIGN (1)
+#define MICROPY_PY_UARRAY_OPS       (1)
 #define MICROPY_PY_COLLECTIONS_ORDEREDDICT (1)
 #define MICROPY_PY_MATH_SPECIAL_FUNCTIONS (1)
 #define MICROPY_PY_CMATH            (1)
@@ -123,21 +183,31 @@ typedef signed int ssize_t;
 #define MICROPY_PY_SYS_PLATFORM     "pyboard"
 #endif
 #define MICROPY_PY_UERRNO           (1)
-#define MICROPY_PY_THREAD           (0)
-#define MICROPY_PY_THREAD_GIL       (0)
 
 // extended modules
 #define MICROPY_PY_UCTYPES          (1)
 #define MICROPY_PY_UZLIB            (1)
+#define MICROPY_PY_UZLIB_COMPIO     (1)
 #define MICROPY_PY_UJSON            (1)
+#define MICROPY_PY_UJSON_PARSER     (1)
+#define MICROPY_PY_UJSON_DUMP_BUF   (128)
 #define MICROPY_PY_URE              (1)
+#define MICROPY_PY_URE_MATCH_INTO   (1)
+#define MICROPY_PY_URE_CACHE        (4)
 #define MICROPY_PY_UHEAPQ           (1)
 #define MICROPY_PY_UHASHLIB         (1)
+#define MICROPY_PY_UHASHLIB_SHA1    (1)
+#define MICROPY_PY_UHASHLIB_HW      (1)
+#define MICROPY_PY_UCRYPTOLIB       (1)
+#define MICROPY_PY_UCRYPTOLIB_CTR   (1)
+#define MICROPY_PY_UCRYPTOLIB_CONSTS (1)
+#define MICROPY_PY_UCRYPTOLIB_HW    (1)
 #define MICROPY_PY_UBINASCII        (1)
 #define MICROPY_PY_URANDOM          (1)
 #define MICROPY_PY_URANDOM_EXTRA_FUNCS (1)
 #define MICROPY_PY_USELECT          (1)
 #define MICROPY_PY_UTIMEQ           (1)
+#define MICROPY_PY_UTIMEQ_WHEEL     (1)
 #define MICROPY_PY_UTIME_MP_HAL     (1)
 #define MICROPY_PY_MACHINE          (1)
 #define MICROPY_PY_MACHINE_PULSE    (0)
@@ -150,7 +220,18 @@ typedef signed int ssize_t;
 // #define MICROPY_PY_MACHINE_SPI_MAKE_NEW machine_hard_spi_make_new
 #define MICROPY_PY_MACHINE_SPI_MIN_DELAY (0)
 #define MICROPY_PY_MACHINE_SPI_MAX_BAUDRATE (SystemCoreClock / 48)
-#define MICROPY_PY_FRAMEBUF         (0)
+#define MICROPY_PY_FRAMEBUF         (1)
+#define MICROPY_PY_FRAMEBUF_IMLIB_FONT (1)
+// RGB565 and GS8 blits and RGB565 fills of a few KB and up go to the PXP, see omv/pxp_2d.h
+int pxp_2d_copy(uint8_t *dst, uint32_t dst_pitch, const uint8_t *src, uint32_t src_pitch, int w, int h, int bytes_pp);
+int pxp_2d_fill(uint8_t *dst, uint32_t dst_pitch, int w, int h, uint16_t col);
+#define MICROPY_PY_FRAMEBUF_HW_COPY(dst, dst_stride, src, src_stride, w, h, bytes_pp) \
+    (pxp_2d_copy((dst), (dst_stride), (src), (src_stride), (w), (h), (bytes_pp)) == 0)
+#define MICROPY_PY_FRAMEBUF_HW_FILL(buf, stride, w, h, bytes_pp, col) \
+    (((bytes_pp) == 2) && (pxp_2d_fill((uint8_t *) (buf), (stride), (w), (h), (col)) == 0))
+// FrameBuffer(img) draws into the pixels of an image, see py_image.c
+int py_image_framebuf_view(void *obj, void **buf, int *w, int *h);
+#define MICROPY_PY_FRAMEBUF_VIEW(obj, buf, w, h) py_image_framebuf_view((obj), (buf), (w), (h))
 #ifndef MICROPY_PY_USOCKET
 #define MICROPY_PY_USOCKET          (0)
 #endif
@@ -160,12 +241,37 @@ typedef signed int ssize_t;
 
 //#define MICROPY_PY_RTTHREAD
 
+// _thread runs on RT-Thread threads (mpthreadport.c); pybthread's scheduler is not used for it
+#ifdef MICROPY_PY_RTTHREAD
+#define MICROPY_PY_THREAD           (1)
+#define MICROPY_PY_THREAD_GIL       (1)
+#define MICROPY_PY_THREAD_GIL_VM_DIVISOR (32)
+#define MICROPY_FATFS_REENTRANT     (1)
+#define MICROPY_FATFS_SYNC_T        void*
+#else
+#define MICROPY_PY_THREAD           (0)
+#define MICROPY_PY_THREAD_GIL       (0)
+#endif
+#if MICROPY_PY_THREAD && !defined(MICROPY_PY_RTTHREAD)
+#define MICROPY_PY_PYBTHREAD        (1)
+#else
+#define MICROPY_PY_PYBTHREAD        (0)
+#endif
+
 // fatfs configuration used in ffconf.h
+#if MICROPY_FATFS_REENTRANT
+#define MICROPY_FATFS_ENABLE_LFN       (2) /* LFN buffer on the stack of the calling thread */
+#else
 #define MICROPY_FATFS_ENABLE_LFN       (1)
+#endif
 #define MICROPY_FATFS_LFN_CODE_PAGE    (437) /* 1=SFN/ANSI 437=LFN/U.S.(OEM) */
 #define MICROPY_FATFS_USE_LABEL        (1)
 #define MICROPY_FATFS_RPATH            (2)
 #define MICROPY_FATFS_MULTI_PARTITION  (1)
+#define MICROPY_FATFS_USE_EXPAND       (1) /* mjpeg.Recorder preallocates contiguous files */
+#define MICROPY_FATFS_USE_TRIM         (1) /* freed clusters are not copied by FTL lazy moves */
+#define MICROPY_FATFS_STAT_CACHE       (8) /* import_stat() answers kept per mount */
+#define MICROPY_FATFS_READAHEAD        (2048) /* module and asset reads, 4 sectors per f_read */
 
 // TODO these should be generic, not bound to fatfs
 #define mp_type_fileio mp_type_vfs_fat_fileio
@@ -327,12 +433,55 @@ extern const struct _mp_obj_module_t gif_module;
     mp_obj_t pyb_config_main; \
     \
     mp_obj_t omv_ide_irq; \
+    /* file stamps of the modules hot reloaded scripts imported */ \
+    mp_obj_t omv_hot_stamps; \
+    \
+    mp_obj_t sensor_frame_cb; \
 	\
     mp_obj_t pyb_switch_callback; \
     \
     mp_obj_t pin_class_mapper; \
     mp_obj_t pin_class_map_dict; \
     \
+    /* last compiled imlib thresholds LUT */ \
+    void *imlib_thresholds_lut; \
+    \
+    /* imlib pyramid / integral image cache of the current frame */ \
+    void *imlib_pyramid; \
+    \
+    /* imlib lens_corr() / rotation_corr() remap tables */ \
+    void *imlib_remap[2]; \
+    \
+    /* mjpeg recorder that is writing in the background */ \
+    void *mjpeg_rec; \
+    \
+    /* omv.stream_server() clients and frame slots */ \
+    void *stream_server; \
+    \
+    /* omv.submit() tasks waiting to run */ \
+    void *omv_tasks; \
+    \
+    /* buffer and callback of the pending SDCard.read_async() */ \
+    mp_obj_t sdcard_async_buf; \
+    mp_obj_t sdcard_async_cb; \
+    \
+    /* buffer and callback of the ADC's timed read */ \
+    mp_obj_t adc_stream_buf; \
+    mp_obj_t adc_stream_cb; \
+    \
+    /* buffers and callbacks of PWM.play() and Servo.trajectory() (SERVO_NUM) */ \
+    mp_obj_t pwm_play_buf; \
+    mp_obj_t pwm_play_cb; \
+    mp_obj_t servo_traj_buf[4]; \
+    mp_obj_t servo_traj_cb[4]; \
+    \
+    /* buffer and callback of RPM.capture() */ \
+    mp_obj_t rpm_capture_buf; \
+    mp_obj_t rpm_capture_cb; \
+    \
+    /* the two frames lcd.display() draws in turn while the other goes out */ \
+    void *lcd_frames; \
+    \
     mp_obj_t pyb_extint_callback[8]; \
     \
     /* Used to do callbacks to Python code on interrupt */ \
@@ -392,6 +541,10 @@ static inline mp_uint_t disable_irq(void) {
 extern void EventPollHook(void);
 #define MICROPY_EVENT_POLL_HOOK do {EventPollHook();} while(0);
 
+// scheduled callbacks show up in the event trace, omv/trace.c
+extern void trace_sched_hook(bool running);
+#define MICROPY_SCHED_HOOK(running) trace_sched_hook(running)
+
 // There is no classical C heap in bare-metal ports, only Python
 // garbage-collected heap. For completeness, emulate C heap via
 // GC heap. Note that MicroPython core never uses malloc() and friends,
@@ -5,3 +5,13 @@ MICROPY_PY_WIZNET5K ?= 0
 
 # cc3k module for wifi support
 MICROPY_PY_CC3K ?= 0
+
+# btree module, a board can size it for its heap: page size and the pages an
+# open database caches when btree.open() isn't given cachesize
+MICROPY_PY_BTREE ?= 1
+BTREE_PAGESIZE ?= 4096
+BTREE_MINCACHE ?= 8
+
+# ussl module on mbedtls (lib/mbedtls checked out separately), AES and SHA-256
+# run on the DCP and the entropy comes from the TRNG, see mbedtls/
+MICROPY_SSL_MBEDTLS ?= 0
@@ -4,6 +4,7 @@
 #include "py/runtime.h"
 #include "py/mperrno.h"
 #include "py/mphal.h"
+#include "py/gc.h"
 #include "usb_app.h"
 #include "uart.h"
 #include "fsl_gpio.h"
@@ -23,16 +24,46 @@ NORETURN void mp_hal_raise(HAL_StatusTypeDef status) {
     mp_raise_OSError(mp_hal_status_to_errno_table[status]);
 }
 __WEAK void usbdbg_try_run_script(void) {}
+__WEAK void mjpeg_rec_poll(void) {}
+__WEAK void stream_server_poll(void) {}
+__WEAK void task_poll(void) {}
+extern void mod_lwip_poll(void);
 extern void mp_handle_pending(void); 
 void EventPollHook(void) {
+#if MICROPY_PY_THREAD && !MICROPY_PY_PYBTHREAD
+    // the port's kernel threads (omv.submit() worker, ...) get here through streams that wait
+    if (!mp_thread_is_python()) {
+        rt_thread_delay(1);
+        return;
+    }
+#endif
     mp_handle_pending(); 
     usbdbg_try_run_script();
-#if MICROPY_PY_THREAD
+    // use idle time to move recorded video to the SD card
+    mjpeg_rec_poll();
+    // and to send the stream server's frames
+    stream_server_poll();
+    // and to run omv.submit() tasks
+    task_poll();
+#if MICROPY_PY_LWIP
+    // and to take in the frames received and run lwIP's timers
+    mod_lwip_poll();
+#endif
+#if MICROPY_GC_INCREMENTAL_SWEEP
+    // use idle time to finish a sweep a collection left over
+    gc_sweep_step(MICROPY_GC_IDLE_SWEEP_BLOCKS);
+#endif
+#if MICROPY_PY_PYBTHREAD
     if (pyb_thread_enabled) { 
         MP_THREAD_GIL_EXIT(); 
         pyb_thread_yield(); 
         MP_THREAD_GIL_ENTER(); 
     } 
+#elif MICROPY_PY_THREAD
+    // the other Python threads run while this one waits
+    MP_THREAD_GIL_EXIT();
+    rt_thread_yield();
+    MP_THREAD_GIL_ENTER();
 #endif
     HAL_WFI();
 }
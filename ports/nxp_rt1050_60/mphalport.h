@@ -56,13 +56,13 @@ static inline void mp_hal_pin_write(GPIO_Type *pPort, uint32_t pin, uint32_t bit
 	GPIO_PinWrite(pPort, pin, bitLevel);
 }
 
+// RT105x GPIOs have no DR_SET/DR_CLEAR, a read-modify-write of DR as GPIO_PinWrite does it.
 static inline void mp_hal_pin_high(const pin_obj_t *pPin) {
-	GPIO_PinWrite(pPin->gpio, pPin->pin, 1);
-	
+	pPin->gpio->DR |= pPin->pin_mask;
 }
 
 static inline void mp_hal_pin_low(const pin_obj_t *pPin) {
-	GPIO_PinWrite(pPin->gpio, pPin->pin, 0);
+	pPin->gpio->DR &= ~pPin->pin_mask;
 }
 
 static inline void mp_hal_pin_toggle(const pin_obj_t *pPin)
@@ -84,7 +84,7 @@ static inline void mp_hal_pin_toggle(const pin_obj_t *pPin)
 #define mp_hal_pin_open_drain(p) mp_hal_pin_config_alt((p), GPIO_MODE_OUTPUT_OD_PUP, AF_FN_GPIO)
 #define mp_hal_pin_od_low(p)    mp_hal_pin_low(p)
 #define mp_hal_pin_od_high(p)   mp_hal_pin_high(p)
-#define mp_hal_pin_read(p)      (GPIO_PinReadPadStatus(_find_gpio(p), (p)->pin))
+#define mp_hal_pin_read(p)      (((p)->gpio->PSR >> (p)->pin) & 1)
 #define mp_hal_pin_write(p, v)  do { if (v) { mp_hal_pin_high(p); } else { mp_hal_pin_low(p); } } while (0)
 
 void mp_hal_gpio_clock_enable(uint32_t portNum);
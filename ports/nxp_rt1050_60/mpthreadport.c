@@ -34,6 +34,168 @@
 
 #if MICROPY_PY_THREAD
 
+#ifdef MICROPY_PY_RTTHREAD
+#include <rthw.h>
+#include "py/runtime.h"
+
+// Python threads are RT-Thread threads at the priority of the one starting them, taking turns
+// on the GIL. The list node is on the GC heap, the thread and its stack on the kernel heap.
+typedef struct _mp_thread_t {
+    rt_thread_t id;
+    void *(*entry)(void*);
+    void *arg;                  // thread Python args, a GC root pointer
+    struct _mp_thread_t *next;
+} mp_thread_t;
+
+// the mutex controls access to the linked list
+STATIC mp_thread_mutex_t thread_mutex;
+// held through GIL-free C sections, they share fb_alloc
+STATIC mp_thread_mutex_t native_mutex;
+STATIC mp_thread_t thread_main;
+STATIC mp_thread_t *thread_list;
+
+void mp_thread_init(void) {
+    mp_thread_mutex_init(&thread_mutex);
+    mp_thread_set_state(&mp_state_ctx.thread);
+    thread_main.id = rt_thread_self();
+    thread_main.next = NULL;
+    thread_list = &thread_main;
+}
+
+// Stops the threads the last script left running, before its heap goes.
+void mp_thread_deinit(void) {
+    mp_thread_mutex_lock(&thread_mutex, 1);
+    for (mp_thread_t *th = thread_list; th != NULL; th = th->next) {
+        if (th->id != rt_thread_self()) {
+            rt_thread_delete(th->id);
+        }
+    }
+    thread_list = &thread_main;
+    thread_main.next = NULL;
+    mp_thread_mutex_unlock(&thread_mutex);
+    mp_thread_mutex_init(&native_mutex);
+}
+
+void mp_thread_gc_others(void) {
+    mp_thread_mutex_lock(&thread_mutex, 1);
+    for (mp_thread_t *th = thread_list; th != NULL; th = th->next) {
+        gc_collect_root((void**)&th, 1);
+        gc_collect_root(&th->arg, 1);
+        if (th->id != rt_thread_self()) {
+            // a switched out thread has its registers pushed below sp
+            void **sp = th->id->sp;
+            void **top = (void**)((uint8_t*)th->id->stack_addr + th->id->stack_size);
+            gc_collect_root(sp, top - sp);
+        }
+    }
+    mp_thread_mutex_unlock(&thread_mutex);
+}
+
+STATIC void mp_thread_entry(void *arg) {
+    mp_thread_t *th = arg;
+    th->entry(th->arg);
+}
+
+void mp_thread_create(void *(*entry)(void*), void *arg, size_t *stack_size) {
+    if (*stack_size == 0) {
+        *stack_size = 4096; // default stack size
+    } else if (*stack_size < 2048) {
+        *stack_size = 2048; // minimum stack size
+    }
+
+    // round stack size to a multiple of the word size
+    *stack_size &= ~(sizeof(uint32_t) - 1);
+
+    // allocate linked-list node (must be done outside thread_mutex lock)
+    mp_thread_t *th = m_new_obj(mp_thread_t);
+    th->entry = entry;
+    th->arg = arg;
+
+    mp_thread_mutex_lock(&thread_mutex, 1);
+
+    // create thread, time sliced with the others at the same priority
+    th->id = rt_thread_create("mp", mp_thread_entry, th, *stack_size,
+        rt_thread_self()->current_priority, 20);
+    if (th->id == RT_NULL) {
+        mp_thread_mutex_unlock(&thread_mutex);
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "can't create thread"));
+    }
+    th->next = thread_list;
+    thread_list = th;
+    rt_thread_startup(th->id);
+
+    mp_thread_mutex_unlock(&thread_mutex);
+
+    // adjust stack_size to provide room to recover from hitting the limit
+    *stack_size -= 1024;
+}
+
+void mp_thread_start(void) {
+}
+
+void mp_thread_finish(void) {
+    // the kernel frees the thread once its entry returns
+    mp_thread_mutex_lock(&thread_mutex, 1);
+    for (mp_thread_t **th = &thread_list; *th != NULL; th = &(*th)->next) {
+        if ((*th)->id == rt_thread_self()) {
+            *th = (*th)->next;
+            break;
+        }
+    }
+    mp_thread_mutex_unlock(&thread_mutex);
+}
+
+// The GIL goes before taking the native lock and comes back after it is released, no thread
+// waits for one while holding the other.
+void mp_thread_native_enter(void) {
+    MP_THREAD_GIL_EXIT();
+    mp_thread_mutex_lock(&native_mutex, 1);
+}
+
+void mp_thread_native_exit(void) {
+    mp_thread_mutex_unlock(&native_mutex);
+    MP_THREAD_GIL_ENTER();
+}
+
+int mp_thread_mutex_lock(mp_thread_mutex_t *m, int wait) {
+    for (int tries = 0;; tries++) {
+        rt_base_t level = rt_hw_interrupt_disable();
+        if (!m->locked) {
+            m->locked = 1;
+            if (tries) {
+                m->waiting--;
+            }
+            rt_hw_interrupt_enable(level);
+            return 1;
+        }
+        if (!wait) {
+            rt_hw_interrupt_enable(level);
+            return 0;
+        }
+        if (!tries) {
+            m->waiting++;
+        }
+        rt_hw_interrupt_enable(level);
+        // The holder is usually a thread at the same priority that yields back on unlock,
+        // a lower priority one only gets to run while this one sleeps.
+        if (tries < 8) {
+            rt_thread_yield();
+        } else {
+            rt_thread_delay(1);
+        }
+    }
+}
+
+void mp_thread_mutex_unlock(mp_thread_mutex_t *m) {
+    m->locked = 0;
+    // hand over to a waiter, otherwise the GIL is back with this thread before it notices
+    if (m->waiting && (rt_interrupt_get_nest() == 0)) {
+        rt_thread_yield();
+    }
+}
+
+#else
+
 // the mutex controls access to the linked list
 STATIC mp_thread_mutex_t thread_mutex;
 
@@ -91,4 +253,6 @@ void mp_thread_start(void) {
 void mp_thread_finish(void) {
 }
 
+#endif
+
 #endif // MICROPY_PY_THREAD
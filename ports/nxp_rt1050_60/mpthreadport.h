@@ -27,6 +27,45 @@
 #define __MICROPY_INCLUDED_STMHAL_MPTHREADPORT_H__
 
 #include "py/mpthread.h"
+
+#ifdef MICROPY_PY_RTTHREAD
+#include "rtthread.h"
+
+// Locks are not kernel objects: _thread locks live on the GC heap and are never deleted, so
+// they can't sit in the kernel's object lists. All zeroes is an unlocked mutex.
+typedef struct _mp_thread_mutex_t {
+    volatile uint8_t locked;
+    volatile uint8_t waiting;
+} mp_thread_mutex_t;
+
+void mp_thread_init(void);
+void mp_thread_deinit(void);
+void mp_thread_gc_others(void);
+void mp_thread_native_enter(void);
+void mp_thread_native_exit(void);
+int mp_thread_mutex_lock(mp_thread_mutex_t *m, int wait);
+void mp_thread_mutex_unlock(mp_thread_mutex_t *m);
+
+static inline void mp_thread_set_state(void *state) {
+    rt_thread_self()->user_data = (rt_uint32_t)state;
+}
+
+static inline struct _mp_state_thread_t *mp_thread_get_state(void) {
+    return (struct _mp_state_thread_t*)rt_thread_self()->user_data;
+}
+
+// The port's own kernel threads (mjpeg writer, stream server) have no Python state and never
+// hold the GIL, code they share with Python threads only drops it for the latter.
+static inline int mp_thread_is_python(void) {
+    return !rt_interrupt_get_nest() && (rt_thread_self()->user_data != 0);
+}
+
+static inline void mp_thread_mutex_init(mp_thread_mutex_t *m) {
+    m->locked = 0;
+    m->waiting = 0;
+}
+
+#else
 #include "pybthread.h"
 
 typedef pyb_mutex_t mp_thread_mutex_t;
@@ -54,4 +93,6 @@ static inline void mp_thread_mutex_unlock(mp_thread_mutex_t *m) {
     pyb_mutex_unlock(m);
 }
 
+#endif
+
 #endif // __MICROPY_INCLUDED_STMHAL_MPTHREADPORT_H__
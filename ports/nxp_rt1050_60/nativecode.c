@@ -0,0 +1,58 @@
+/*
+ * Placement of native code loaded at run time.
+ *
+ * Native code from .mpy files and from @micropython.native/viper functions is moved into the ITCM
+ * left after .itcm_text while there is room, where it runs without wait states and without the
+ * caches. Once ITCM is full the code stays in the GC heap, which is cached, so the D-cache is
+ * cleaned and the I-cache invalidated over it before it runs.
+ *
+ */
+#include <string.h>
+#include "py/mpconfig.h"
+#include "py/misc.h"
+#include "py/persistentcode.h"
+#include "fsl_cache.h"
+#include "nativecode.h"
+
+#if defined(__GNUC__) && !defined(__CC_ARM)
+extern uint8_t __itcm_heap_start[], __itcm_heap_end[];
+static uint8_t *native_itcm_ptr;
+#endif
+
+void native_code_init(void)
+{
+    #if defined(__GNUC__) && !defined(__CC_ARM)
+    native_itcm_ptr = __itcm_heap_start;
+    #endif
+}
+
+void *native_code_commit(void *buf, size_t len, void *reloc)
+{
+    uint8_t *code = buf;
+
+    #if defined(__GNUC__) && !defined(__CC_ARM)
+    // Literal pools in the code are word aligned.
+    size_t size = (len + 3) & ~3;
+    if (native_itcm_ptr && ((native_itcm_ptr + size) <= __itcm_heap_end)) {
+        code = native_itcm_ptr;
+        native_itcm_ptr += size;
+        memcpy(code, buf, len);
+        m_del(byte, buf, len);
+    }
+    #endif
+
+    #if MICROPY_PERSISTENT_CODE_LOAD
+    if (reloc) {
+        mp_native_relocate(reloc, code, (uintptr_t) code);
+    }
+    #endif
+
+    if (code == buf) {
+        L1CACHE_CleanDCacheByRange((uint32_t) code, len);
+        L1CACHE_InvalidateICacheByRange((uint32_t) code, len);
+    } else {
+        __DSB();
+        __ISB();
+    }
+    return code;
+}
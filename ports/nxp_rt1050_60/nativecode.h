@@ -0,0 +1,13 @@
+/*
+ * Placement of native code loaded at run time.
+ *
+ */
+#ifndef __NATIVECODE_H__
+#define __NATIVECODE_H__
+#include <stddef.h>
+
+// Drops everything placed in ITCM, called on soft reset with the heap that referenced it.
+void native_code_init(void);
+// MP_PLAT_COMMIT_EXEC, returns where the code of len bytes in buf runs from.
+void *native_code_commit(void *buf, size_t len, void *reloc);
+#endif // __NATIVECODE_H__
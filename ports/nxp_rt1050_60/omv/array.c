@@ -32,6 +32,17 @@ void array_alloc_init(array_t **a, array_dtor_t dtor, int size)
     *a = array;
 }
 
+// Same as array_alloc() but from the xalloc arena, for arrays that die before the call returns.
+void array_alloc_scratch(array_t **a, array_dtor_t dtor)
+{
+    array_t *array = xalloc_arena(sizeof(array_t));
+    array->index  = 0;
+    array->length = ARRAY_INIT_SIZE;
+    array->dtor   = dtor;
+    array->data   = xalloc_arena(ARRAY_INIT_SIZE * sizeof(void*));
+    *a = array;
+}
+
 void array_clear(array_t *array)
 {
     if (array->dtor != NULL) {
@@ -39,7 +50,7 @@ void array_clear(array_t *array)
             array->dtor(array->data[i]);
         }
     }
-    xfree(array->data);
+    xfree_arena(array->data);
     array->index = 0;
     array->length = 0;
     array->data = NULL;
@@ -50,7 +61,7 @@ void array_clear(array_t *array)
 void array_free(array_t *array)
 {
     array_clear(array);
-    xfree(array);
+    xfree_arena(array);
 }
 
 int array_length(array_t *array)
@@ -67,7 +78,7 @@ void array_push_back(array_t *array, void *element)
 {
     if (array->index == array->length) {
         array->length += ARRAY_INIT_SIZE;
-        array->data    = xrealloc(array->data, array->length * sizeof(void*));
+        array->data    = xrealloc_arena(array->data, array->length * sizeof(void*));
     }
     array->data[array->index++] = element;
 }
@@ -116,7 +127,7 @@ void array_resize(array_t *array, int num)
             }
             // resize array
             array->length = num;
-            array->data = xrealloc(array->data, array->length * sizeof(void*));
+            array->data = xrealloc_arena(array->data, array->length * sizeof(void*));
         }
     }
 }
@@ -21,6 +21,7 @@ typedef struct {
 } array_t;
 void array_alloc(array_t **a, array_dtor_t dtor);
 void array_alloc_init(array_t **a, array_dtor_t dtor, int size);
+void array_alloc_scratch(array_t **a, array_dtor_t dtor);
 void array_clear(array_t *array);
 void array_free(array_t *array);
 int array_length(array_t *array);
@@ -14,6 +14,8 @@
 #include "clock_config.h"
 #include <systick.h>
 #include "omv_boardconfig.h"
+#include "py/mpconfig.h"
+#include "irq.h"
 #include "cambus.h"
 
 /* Select USB1 PLL (480 MHz) as master lpi2c clock source */
@@ -26,8 +28,10 @@
 
 #ifdef BOARD_OMVRT1
 #define I2C_MASTER_BASE (LPI2C4_BASE)
+#define I2C_MASTER_IRQn (LPI2C4_IRQn)
 #else
 #define I2C_MASTER_BASE (LPI2C1_BASE)
+#define I2C_MASTER_IRQn (LPI2C1_IRQn)
 #endif
 
 #define I2C_MASTER ((LPI2C_Type *)I2C_MASTER_BASE)
@@ -35,7 +39,10 @@
 #define LPI2C_MASTER_SLAVE_ADDR_7BIT 0x7EU
 #define LPI2C_BAUDRATE 100000U
 #define LPI2C_DATA_LENGTH 2U
+#define CAMBUS_BATCH_TIMEOUT (1000)
 volatile bool g_MasterCompletionFlag = false;
+static uint32_t cambus_writes;
+
 static void lpi2c_master_callback(LPI2C_Type *base, lpi2c_master_handle_t *handle, status_t status, void *userData)
 {
     /* Signal transfer success when received success status. */
@@ -153,6 +160,7 @@ int cambus_writeb(uint8_t slv_addr, uint8_t reg_addr, uint8_t reg_data)
     data[size++] = (uint8_t)reg_addr;
     data[size++] = reg_data;
     status_t status;
+    cambus_writes++;
     while(1)
     {
 	status = LPI2C_MasterStart(I2C_MASTER, slv_addr, kLPI2C_Write);
@@ -227,6 +235,7 @@ int cambus_writew(uint8_t slv_addr, uint8_t reg_addr, uint16_t reg_data)
     status_t reVal = kStatus_Fail;
     lpi2c_master_transfer_t masterXfer = {0};
     reg_data = (reg_data >> 8) | (reg_data << 8);
+    cambus_writes++;
     //__disable_irq();
       while (1)
     {
@@ -345,3 +354,149 @@ lpi2c_master_transfer_t masterXfer = {0};
     g_MasterCompletionFlag = false;
  //   __enable_irq();
     return 0;*/
+
+/* Register batches: a chain of non-blocking transfers, whose completion IRQ starts the
+   next one, so the bus never waits for the CPU and the CPU only for the whole batch. */
+typedef struct _cambus_batch_t {
+    lpi2c_master_handle_t handle;
+    lpi2c_master_transfer_t xfer;
+    const uint8_t (*regs)[2];   // a write table, or
+    cambus_op_t *ops;           // a list of reads and writes
+    uint32_t next, num;
+    bool addr_sent;             // a read's register address is out, its data comes next
+    volatile bool busy;
+    volatile status_t status;
+} cambus_batch_t;
+
+static cambus_batch_t cambus_batch_state;
+
+static status_t cambus_batch_start(cambus_batch_t *b)
+{
+    lpi2c_master_transfer_t *x = &b->xfer;
+    const uint8_t *reg, *val;
+    if (b->regs) {
+        reg = &b->regs[b->next][0];
+        val = &b->regs[b->next][1];
+    } else {
+        reg = &b->ops[b->next].reg;
+        val = &b->ops[b->next].val;
+    }
+
+    x->direction = kLPI2C_Write;
+    x->dataSize = 1;
+    if (b->ops && b->ops[b->next].read) {
+        // SCCB wants a stop, not a repeated start, between the address and the read
+        x->subaddressSize = 0;
+        if (!b->addr_sent) {
+            x->data = (void*)reg;
+            b->addr_sent = true;
+        } else {
+            x->direction = kLPI2C_Read;
+            x->data = (void*)val;
+            b->addr_sent = false;
+            b->next++;
+        }
+    } else {
+        x->subaddress = *reg;
+        x->subaddressSize = 1;
+        x->data = (void*)val;
+        b->next++;
+    }
+    return LPI2C_MasterTransferNonBlocking(I2C_MASTER, &b->handle, x);
+}
+
+static void cambus_batch_callback(LPI2C_Type *base, lpi2c_master_handle_t *handle, status_t status, void *userData)
+{
+    cambus_batch_t *b = userData;
+    if (status == kStatus_Success && (b->next < b->num || b->addr_sent)) {
+        status = cambus_batch_start(b);
+        if (status == kStatus_Success) {
+            return;
+        }
+    }
+    b->status = status;
+    b->busy = false;
+}
+
+static int cambus_batch_begin(cambus_batch_t *b, uint8_t slv_addr, uint32_t num)
+{
+    b->status = kStatus_Success;
+    if (num == 0) {
+        return 0;
+    }
+    cambus_writes++;
+    // cambus_readw()/writew() take the bus' IRQ over with a handle of their own
+    LPI2C_MasterTransferCreateHandle(I2C_MASTER, &b->handle, cambus_batch_callback, b);
+    NVIC_SetPriority(I2C_MASTER_IRQn, IRQ_PRI_I2C);
+    b->xfer.slaveAddress = slv_addr;
+    b->xfer.flags = kLPI2C_TransferDefaultFlag;
+    b->next = 0;
+    b->num = num;
+    b->addr_sent = false;
+    b->busy = true;
+    if (cambus_batch_start(b) != kStatus_Success) {
+        b->status = kStatus_Fail;
+        b->busy = false;
+        return -1;
+    }
+    return 0;
+}
+
+static int cambus_batch_end(cambus_batch_t *b)
+{
+    uint32_t start = systick_current_millis();
+    while (b->busy) {
+        if (systick_current_millis() - start > CAMBUS_BATCH_TIMEOUT) {
+            LPI2C_MasterTransferAbort(I2C_MASTER, &b->handle);
+            b->status = kStatus_Timeout;
+            b->busy = false;
+            return -1;
+        }
+        __WFI();
+    }
+    return (b->status == kStatus_Success) ? 0 : -1;
+}
+
+int cambus_batch(uint8_t slv_addr, cambus_op_t *ops, int num)
+{
+    cambus_batch_t *b = &cambus_batch_state;
+    b->regs = NULL;
+    b->ops = ops;
+    if (cambus_batch_begin(b, slv_addr, num) != 0) {
+        return -1;
+    }
+    return cambus_batch_end(b);
+}
+
+int cambus_batch_async(uint8_t slv_addr, cambus_op_t *ops, int num)
+{
+    cambus_batch_t *b = &cambus_batch_state;
+    b->regs = NULL;
+    b->ops = ops;
+    return cambus_batch_begin(b, slv_addr, num);
+}
+
+int cambus_batch_wait(void)
+{
+    return cambus_batch_end(&cambus_batch_state);
+}
+
+int cambus_write_regs(uint8_t slv_addr, const uint8_t (*regs)[2], int num)
+{
+    cambus_batch_t *b = &cambus_batch_state;
+    if (num < 0) {
+        for (num = 0; regs[num][0]; num++) {
+        }
+    }
+    b->regs = regs;
+    b->ops = NULL;
+    if (cambus_batch_begin(b, slv_addr, num) != 0) {
+        return -1;
+    }
+    return cambus_batch_end(b);
+}
+
+uint32_t cambus_write_count(void)
+{
+    return cambus_writes;
+}
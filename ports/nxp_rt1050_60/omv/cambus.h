@@ -19,4 +19,22 @@ int cambus_readw(uint8_t slv_addr, uint8_t reg_addr,  uint16_t *reg_data);
 int cambus_writew(uint8_t slv_addr, uint8_t reg_addr, uint16_t reg_data);
 int cambus_readw2(uint8_t slv_addr, uint16_t reg_addr,  uint16_t *reg_data);
 int cambus_writew2(uint8_t slv_addr, uint16_t reg_addr, uint16_t reg_data);
+
+// One register access of a batch, val is written or receives what was read.
+typedef struct _cambus_op_t {
+    uint8_t reg;
+    uint8_t val;
+    uint8_t read;
+} cambus_op_t;
+// Runs the ops back to back from the I2C IRQ, the caller sleeps until the last one is
+// done. Stops at the first failure.
+int cambus_batch(uint8_t slv_addr, cambus_op_t *ops, int num);
+// Writes a {reg, val} table the same way, num < 0 for one that ends with reg 0.
+int cambus_write_regs(uint8_t slv_addr, const uint8_t (*regs)[2], int num);
+// Only starts the batch, from IRQs too, ops must then stay valid until cambus_batch_wait()
+// has returned the result.
+int cambus_batch_async(uint8_t slv_addr, cambus_op_t *ops, int num);
+int cambus_batch_wait(void);
+// Writes and batches started so far, to tell whether the sensor was touched since.
+uint32_t cambus_write_count(void);
 #endif // __CAMBUS_H__
@@ -10,6 +10,8 @@
 #include "fb_alloc.h"
 #include "framebuffer.h"
 #include "omv_boardconfig.h"
+#include "perf.h"
+#include "trace.h"
 
 #ifdef __CC_ARM
     extern char Image$$OMV_FB_END$$Base;
@@ -31,8 +33,110 @@
     #endif
 #endif
 
+// Tiers for FB_ALLOC_PREFER_SPEED, tried in order before the framebuffer stack.
+// Each is a separate downward stack, its entries only leave a header on the main stack,
+// so marks and frees work the same for all of them.
+#ifndef OMV_FB_ALLOC_DTCM_SIZE
+#define OMV_FB_ALLOC_DTCM_SIZE  (0)
+#endif
+#ifndef OMV_FB_ALLOC_OCRAM_SIZE
+#define OMV_FB_ALLOC_OCRAM_SIZE (0)
+#endif
+#define FB_TIER_FLAG_MASK       0x3
+#define FB_TIER_DTCM_FLAG       0x2
+#define FB_TIER_OCRAM_FLAG      0x3
+#define FB_TIER_COUNT           ((OMV_FB_ALLOC_DTCM_SIZE > 0) + (OMV_FB_ALLOC_OCRAM_SIZE > 0))
+
+#if (FB_TIER_COUNT > 0)
+typedef struct {
+    char *base;
+    char *top;
+    char *pointer;
+    uint32_t flag;
+} fb_tier_t;
+
+#if (OMV_FB_ALLOC_DTCM_SIZE > 0)
+static char fb_tier_dtcm[OMV_FB_ALLOC_DTCM_SIZE] __attribute__((section(".fb_alloc_dtcm"), aligned(32)));
+#endif
+#if (OMV_FB_ALLOC_OCRAM_SIZE > 0)
+static char fb_tier_ocram[OMV_FB_ALLOC_OCRAM_SIZE] __attribute__((section(".fb_alloc_ocram"), aligned(32)));
+#endif
+
+static fb_tier_t fb_tiers[FB_TIER_COUNT] = {
+    #if (OMV_FB_ALLOC_DTCM_SIZE > 0)
+    { fb_tier_dtcm, fb_tier_dtcm + OMV_FB_ALLOC_DTCM_SIZE, fb_tier_dtcm + OMV_FB_ALLOC_DTCM_SIZE, FB_TIER_DTCM_FLAG },
+    #endif
+    #if (OMV_FB_ALLOC_OCRAM_SIZE > 0)
+    { fb_tier_ocram, fb_tier_ocram + OMV_FB_ALLOC_OCRAM_SIZE, fb_tier_ocram + OMV_FB_ALLOC_OCRAM_SIZE, FB_TIER_OCRAM_FLAG },
+    #endif
+};
+#endif
+
 volatile char *pointer = &_fballoc;
+// Bottom of the reserved area (frame slots), the stack grows down from here.
+static char *pointer_top = &_fballoc;
 static int marks = 0;
+
+// Always on usage counters, [0] is the whole stack and [1 + n] the allocations made
+// inside n marks (the last entry also counts anything deeper).
+static fb_alloc_stats_t fb_stats[1 + FB_ALLOC_STATS_DEPTHS];
+static int fb_stats_max_depth;
+
+static inline fb_alloc_stats_t *fb_stats_depth()
+{
+    return &fb_stats[1 + ((marks < FB_ALLOC_STATS_DEPTHS) ? marks : (FB_ALLOC_STATS_DEPTHS - 1))];
+}
+
+static void fb_stats_alloc(uint32_t size)
+{
+    fb_alloc_stats_t *d = fb_stats_depth();
+    fb_stats[0].bytes += size;
+    fb_stats[0].allocs += 1;
+    if (fb_stats[0].bytes > fb_stats[0].peak) {
+        fb_stats[0].peak = fb_stats[0].bytes;
+    }
+    d->bytes += size;
+    d->allocs += 1;
+    if (d->bytes > d->peak) {
+        d->peak = d->bytes;
+    }
+    if (marks > fb_stats_max_depth) {
+        fb_stats_max_depth = marks;
+    }
+}
+
+static void fb_stats_fail()
+{
+    fb_stats[0].fails += 1;
+    fb_stats_depth()->fails += 1;
+}
+
+// Pop the top entry of the main stack and of the tier it points to, returns its size.
+static uint32_t fb_pop()
+{
+    uint32_t size = *((uint32_t *) pointer);
+    uint32_t flag = size & FB_TIER_FLAG_MASK;
+    size &= ~FB_TIER_FLAG_MASK;
+    fb_stats[0].bytes -= size - sizeof(uint32_t);
+    fb_stats_depth()->bytes -= size - sizeof(uint32_t);
+    #if defined(OMV_FB_OVERLAY_MEMORY)
+    if (flag == FB_OVERLAY_MEMORY_FLAG) {
+        pointer_overlay += size - sizeof(uint32_t);
+    }
+    #endif
+    #if (FB_TIER_COUNT > 0)
+    for (int i = 0; i < FB_TIER_COUNT; i++) {
+        if (flag == fb_tiers[i].flag) {
+            // only the header is on the main stack
+            fb_tiers[i].pointer += size - sizeof(uint32_t);
+            pointer += sizeof(uint32_t);
+            return size;
+        }
+    }
+    #endif
+    pointer += size;
+    return size;
+}
 __weak NORETURN void fb_alloc_fail()
 {
     nlr_raise(mp_obj_new_exception_msg(&mp_type_MemoryError,
@@ -43,10 +147,19 @@ __weak NORETURN void fb_alloc_fail()
 void fb_alloc_init0()
 {
     pointer = &_fballoc;
+    pointer_top = &_fballoc;
     marks = 0;
+    for (int i = 0; i < (1 + FB_ALLOC_STATS_DEPTHS); i++) {
+        fb_stats[i].bytes = 0;
+    }
     #if defined(OMV_FB_OVERLAY_MEMORY)
     pointer_overlay = &_fballoc_overlay;
     #endif
+    #if (FB_TIER_COUNT > 0)
+    for (int i = 0; i < FB_TIER_COUNT; i++) {
+        fb_tiers[i].pointer = fb_tiers[i].top;
+    }
+    #endif
 }
 
 uint32_t fb_avail()
@@ -56,12 +169,19 @@ uint32_t fb_avail()
     return (temp < sizeof(uint32_t)) ? 0 : temp;
 }
 
+// Bytes between start and the current top of the fb_alloc stack.
+uint32_t fb_avail_from(void *start)
+{
+    return ((char *) pointer > (char *) start) ? (pointer - ((char *) start)) : 0;
+}
+
 void fb_alloc_mark()
 {
-    char *new_pointer = pointer - sizeof(uint32_t);
+    char *new_pointer = (char *) pointer - sizeof(uint32_t);
 
     // Check if allocation overwrites the framebuffer pixels
     if (new_pointer < (char *) MAIN_FB_PIXELS()) {
+        fb_stats_fail();
         nlr_raise_for_fb_alloc_mark(mp_obj_new_exception_msg(&mp_type_MemoryError,
             "Out of fast Frame Buffer Stack Memory!"
             " Please reduce the resolution of the image you are running this algorithm on to bypass this issue!"));
@@ -73,59 +193,67 @@ void fb_alloc_mark()
     *((uint32_t *) new_pointer) = sizeof(uint32_t); // Save size.
     pointer = new_pointer;
     marks += 1;
-    #if defined(FB_ALLOC_STATS)
-    alloc_bytes = 0;
-    alloc_bytes_peak = 0;
-    #endif
+    trace_event(TRACE_FB_MARK, marks);
+    if (marks < FB_ALLOC_STATS_DEPTHS) {
+        fb_stats_depth()->bytes = 0;
+    }
 }
 
 void fb_alloc_free_till_mark()
 {
     if (!marks) return;
-    while (pointer < &_fballoc) {
-        uint32_t size = *((uint32_t *) pointer);
-        #if defined(OMV_FB_OVERLAY_MEMORY)
-        if (size & FB_OVERLAY_MEMORY_FLAG) { // Check for fast flag.
-            size &= ~FB_OVERLAY_MEMORY_FLAG; // Remove it.
-            pointer_overlay += size - sizeof(uint32_t);
-        }
-        #endif
-        pointer += size; // Get size and pop.
+    while (pointer < pointer_top) {
+        uint32_t size = fb_pop(); // Get size and pop.
         if (size == sizeof(uint32_t)) break; // Break on first marker.
     }
     marks -= 1;
-    #if defined(FB_ALLOC_STATS)
-    printf("fb_alloc peak memory: %lu\n", alloc_bytes_peak);
-    #endif
+    trace_event(TRACE_FB_FREE, marks);
 }
 
 // returns null pointer without error if size==0
 void *fb_alloc(uint32_t size, int hints)
 {
+    OMV_PROF_SCOPE("fb_alloc");
     if (!size) {
         return NULL;
     }
 
     size = ((size+sizeof(uint32_t)-1)/sizeof(uint32_t))*sizeof(uint32_t);// Round Up
-    char *result = pointer - size;
+
+    #if (FB_TIER_COUNT > 0)
+    if (hints & FB_ALLOC_PREFER_SPEED) {
+        for (int i = 0; i < FB_TIER_COUNT; i++) {
+            fb_tier_t *tier = &fb_tiers[i];
+            if ((uint32_t) (tier->pointer - tier->base) >= size) {
+                char *new_pointer = pointer - sizeof(uint32_t);
+                if (new_pointer < (char *) MAIN_FB_PIXELS()) {
+                    fb_stats_fail();
+                    fb_alloc_fail();
+                }
+                tier->pointer -= size;
+                *((uint32_t *) new_pointer) = (size + sizeof(uint32_t)) | tier->flag; // Save size.
+                pointer = new_pointer;
+                fb_stats_alloc(size);
+                return tier->pointer;
+            }
+        }
+    }
+    #endif
+
+    char *result = (char *) pointer - size;
     char *new_pointer = result - sizeof(uint32_t);
 
     // Check if allocation overwrites the framebuffer pixels
     // rocky: this means extra buffer must be immediately after pixels.
     if (new_pointer < (char *) MAIN_FB_PIXELS()) {
+        fb_stats_fail();
         fb_alloc_fail();
     }
 
     // size is always 4/8/12/etc. so the value below must be 8 or more.
     *((uint32_t *) new_pointer) = size + sizeof(uint32_t); // Save size.
     pointer = new_pointer;
-    #if defined(FB_ALLOC_STATS)
-    alloc_bytes += size;
-    if (alloc_bytes > alloc_bytes_peak) {
-        alloc_bytes_peak = alloc_bytes;
-    }
-    printf("fb_alloc %lu bytes\n", size);
-    #endif
+    fb_stats_alloc(size);
     #if defined(OMV_FB_OVERLAY_MEMORY)
     if ((!(hints & FB_ALLOC_PREFER_SIZE))
     && (((uint32_t) (pointer_overlay - OMV_FB_OVERLAY_MEMORY_ORIGIN)) >= size)) {
@@ -162,19 +290,13 @@ void *fb_alloc_all(uint32_t *size, int hints)
     }
     #endif
     *size = (temp / sizeof(uint32_t)) * sizeof(uint32_t); // Round Down
-    char *result = pointer - *size;
+    char *result = (char *) pointer - *size;
     char *new_pointer = result - sizeof(uint32_t);
 
     // size is always 4/8/12/etc. so the value below must be 8 or more.
     *((uint32_t *) new_pointer) = *size + sizeof(uint32_t); // Save size.
     pointer = new_pointer;
-    #if defined(FB_ALLOC_STATS)
-    alloc_bytes += *size;
-    if (alloc_bytes > alloc_bytes_peak) {
-        alloc_bytes_peak = alloc_bytes;
-    }
-    printf("fb_alloc_all %lu bytes\n", *size);
-    #endif
+    fb_stats_alloc(*size);
     #if defined(OMV_FB_OVERLAY_MEMORY)
     if (!(hints & FB_ALLOC_PREFER_SIZE)) {
         // Return overlay memory instead.
@@ -196,35 +318,63 @@ void *fb_alloc0_all(uint32_t *size, int hints)
 
 void fb_free()
 {
-    if (pointer < &_fballoc) {
-        uint32_t size = *((uint32_t *) pointer);
-        #if defined(OMV_FB_OVERLAY_MEMORY)
-        if (size & FB_OVERLAY_MEMORY_FLAG) { // Check for fast flag.
-            size &= ~FB_OVERLAY_MEMORY_FLAG; // Remove it.
-            pointer_overlay += size - sizeof(uint32_t);
-        }
-        #endif
-        #if defined(FB_ALLOC_STATS)
-        alloc_bytes -= size;
-        #endif
-        pointer += size; // Get size and pop.
+    if (pointer < pointer_top) {
+        fb_pop(); // Get size and pop.
     }
 }
 
 void fb_free_all()
 {
-    while (pointer < &_fballoc) {
-        uint32_t size = *((uint32_t *) pointer);
-        #if defined(OMV_FB_OVERLAY_MEMORY)
-        if (size & FB_OVERLAY_MEMORY_FLAG) { // Check for fast flag.
-            size &= ~FB_OVERLAY_MEMORY_FLAG; // Remove it.
-            pointer_overlay += size - sizeof(uint32_t);
-        }
-        #endif
-        #if defined(FB_ALLOC_STATS)
-        alloc_bytes -= size;
-        #endif
-        pointer += size; // Get size and pop.
+    while (pointer < pointer_top) {
+        fb_pop(); // Get size and pop.
     }
     marks = 0;
 }
+
+void *fb_alloc_reserve(uint32_t size)
+{
+    // The stack must be empty, its base moves down.
+    if (pointer != pointer_top) {
+        return NULL;
+    }
+
+    char *new_top = (char *) (((uintptr_t) (pointer_top - size)) & ~31);
+
+    if ((new_top - sizeof(uint32_t)) < (char *) MAIN_FB_PIXELS()) {
+        return NULL;
+    }
+
+    pointer = pointer_top = new_top;
+    return new_top;
+}
+
+int fb_alloc_release_reserved()
+{
+    if (pointer != pointer_top) {
+        return -1;
+    }
+
+    pointer = pointer_top = &_fballoc;
+    return 0;
+}
+
+int fb_alloc_get_stats(fb_alloc_stats_t *total, fb_alloc_stats_t *depths)
+{
+    *total = fb_stats[0];
+    if (depths) {
+        for (int i = 0; i < FB_ALLOC_STATS_DEPTHS; i++) {
+            depths[i] = fb_stats[1 + i];
+        }
+    }
+    return IM_MIN(fb_stats_max_depth + 1, FB_ALLOC_STATS_DEPTHS);
+}
+
+void fb_alloc_reset_peak()
+{
+    for (int i = 0; i < (1 + FB_ALLOC_STATS_DEPTHS); i++) {
+        fb_stats[i].peak = fb_stats[i].bytes;
+        fb_stats[i].allocs = 0;
+        fb_stats[i].fails = 0;
+    }
+    fb_stats_max_depth = marks;
+}
@@ -10,11 +10,19 @@
 #define __FB_ALLOC_H__
 #include <stdint.h>
 #define FB_ALLOC_NO_HINT 0
-#define FB_ALLOC_PREFER_SPEED 1
+#define FB_ALLOC_PREFER_SPEED 1 // DTCM, then OCRAM tier (see OMV_FB_ALLOC_DTCM_SIZE), then the framebuffer stack
 #define FB_ALLOC_PREFER_SIZE 2
+#define FB_ALLOC_STATS_DEPTHS 8
+typedef struct fb_alloc_stats {
+    uint32_t bytes;     // allocated now
+    uint32_t peak;      // most allocated at once
+    uint32_t allocs;
+    uint32_t fails;     // allocations that raised MemoryError
+} fb_alloc_stats_t;
 void fb_alloc_fail();
 void fb_alloc_init0();
 uint32_t fb_avail();
+uint32_t fb_avail_from(void *start);
 void fb_alloc_mark();
 void fb_alloc_free_till_mark();
 void *fb_alloc(uint32_t size, int hints);
@@ -23,4 +31,14 @@ void *fb_alloc_all(uint32_t *size, int hints); // returns pointer and sets size
 void *fb_alloc0_all(uint32_t *size, int hints); // returns pointer and sets size
 void fb_free();
 void fb_free_all();
+// Takes size bytes (32 byte aligned) off the top of the stack until fb_alloc_init0(), only
+// when nothing is allocated. Returns NULL otherwise or if there is no room.
+void *fb_alloc_reserve(uint32_t size);
+// Gives all reserved memory back, returns -1 (and keeps it) while anything is allocated.
+int fb_alloc_release_reserved();
+// Fills total and, if not NULL, FB_ALLOC_STATS_DEPTHS per mark depth entries.
+// Returns how many depths have been used.
+int fb_alloc_get_stats(fb_alloc_stats_t *total, fb_alloc_stats_t *depths);
+// Restart peaks, allocation and failure counts from the current usage.
+void fb_alloc_reset_peak();
 #endif /* __FF_ALLOC_H__ */
@@ -10,6 +10,7 @@
 #include "common.h"
 #include "fb_alloc.h"
 #include "ff_wrapper.h"
+#include "omv_boardconfig.h"
 #define FF_MIN(x,y) (((x)<(y))?(x):(y))
 
 NORETURN static void ff_fail(FIL *fp, FRESULT res)
@@ -99,6 +100,7 @@ void file_sync(FIL *fp)
 // These wrapper functions are used for backward compatibility with
 // OpenMV code using vanilla FatFS. Note: Extracted from cc3200 ftp.c
 
+#if MICROPY_VFS_FAT
 STATIC FATFS *lookup_path(const TCHAR **path) {
     mp_vfs_mount_t *fs = mp_vfs_lookup_path(*path, path);
     if (fs == MP_VFS_NONE || fs == MP_VFS_ROOT) {
@@ -107,6 +109,13 @@ STATIC FATFS *lookup_path(const TCHAR **path) {
     // here we assume that the mounted device is FATFS
     return &((fs_user_mount_t*)MP_OBJ_TO_PTR(fs->obj))->fatfs;
 }
+#else
+// Without FatFS (the host port) the f_* functions open host paths as they are.
+STATIC FATFS *lookup_path(const TCHAR **path) {
+    static FATFS fatfs;
+    return &fatfs;
+}
+#endif
 
 FRESULT f_open_helper(FIL *fp, const TCHAR *path, BYTE mode) {
     FATFS *fs = lookup_path(&path);
@@ -171,8 +180,15 @@ FRESULT f_rename_helper(const TCHAR *path_old, const TCHAR *path_new) {
 // we use a temporary buffer to fix the alignment and to speed everything up.
 
 // We use this temporary buffer for both reads and writes. The buffer allows us
-// to do multi-block reads and writes which signifcantly speed things up.
+// to do multi-block reads and writes which signifcantly speed things up. It is
+// OMV_FILE_BUFFER_SIZE at most so the code parsing the file can still fb_alloc,
+// and reads of a buffer or more go around it straight into the destination.
+
+#ifndef OMV_FILE_BUFFER_SIZE
+#define OMV_FILE_BUFFER_SIZE    (16 * 1024)
+#endif
 
+static FIL *file_buffer_fp = 0;
 static uint32_t file_buffer_offset = 0;
 static uint8_t *file_buffer_pointer = 0;
 static uint32_t file_buffer_size = 0;
@@ -180,12 +196,19 @@ static uint32_t file_buffer_index = 0;
 
 void file_buffer_init0()
 {
+    file_buffer_fp = 0;
     file_buffer_offset = 0;
     file_buffer_pointer = 0;
     file_buffer_size = 0;
     file_buffer_index = 0;
 }
 
+// Only the file the buffer was turned on for goes through it.
+ALWAYS_INLINE static bool file_buffered(FIL *fp)
+{
+    return file_buffer_pointer && (fp == file_buffer_fp);
+}
+
 ALWAYS_INLINE static void file_fill(FIL *fp)
 {
     if (file_buffer_index == file_buffer_size) {
@@ -237,12 +260,14 @@ uint32_t file_size_w_buf(FIL *fp)
 void file_buffer_on(FIL *fp)
 {
 	#ifndef OMV_MPY_ONLY
-    file_buffer_offset = f_tell(fp) % 4;
-    file_buffer_pointer = fb_alloc_all(&file_buffer_size, FB_ALLOC_PREFER_SIZE) + file_buffer_offset;
-    if (!file_buffer_size) {
+    uint32_t size = FF_MIN(fb_avail(), OMV_FILE_BUFFER_SIZE) & ~3;
+    if (size < 8) {
         nlr_raise(mp_obj_new_exception_msg(&mp_type_MemoryError, "No memory!"));
     }
-    file_buffer_size -= file_buffer_offset;
+    file_buffer_fp = fp;
+    file_buffer_offset = f_tell(fp) % 4;
+    file_buffer_pointer = (uint8_t *) fb_alloc(size, FB_ALLOC_PREFER_SIZE) + file_buffer_offset;
+    file_buffer_size = size - file_buffer_offset;
     file_buffer_index = 0;
     if (fp->flag & FA_READ) {
         uint32_t file_remaining = f_size(fp) - f_tell(fp);
@@ -264,27 +289,50 @@ void file_buffer_off(FIL *fp)
         if (bytes != file_buffer_index) ff_write_fail(fp);
     }
     file_buffer_pointer = 0;
+    file_buffer_fp = 0;
     fb_free();
 }
 
-void read_byte(FIL *fp, uint8_t *value)
+// Reads size bytes through the buffer, refilling it as it runs out.
+static void file_read_buffered(FIL *fp, void *buf, UINT size)
 {
-    if (file_buffer_pointer) {
-        // We get a massive speed boost by buffering up as much data as possible
-        // via massive reads. So much so that the time wasted by
-        // all these operations does not cost us.
-        for (size_t i = 0; i < sizeof(*value); i++) {
-            file_fill(fp);
-            ((uint8_t *) value)[i] = file_buffer_pointer[file_buffer_index++];
-        }
-    } else {
-        UINT bytes;
-        FRESULT res = f_read(fp, value, sizeof(*value), &bytes);
-        if (res != FR_OK) ff_fail(fp, res);
-        if (bytes != sizeof(*value)) ff_read_fail(fp);
+    uint8_t *data = buf;
+    while (size) {
+        file_fill(fp);
+        uint32_t file_buffer_space_left = file_buffer_size - file_buffer_index;
+        uint32_t can_do = FF_MIN(size, file_buffer_space_left);
+        memcpy(data, file_buffer_pointer+file_buffer_index, can_do);
+        file_buffer_index += can_do;
+        data += can_do;
+        size -= can_do;
     }
 }
 
+static void file_read_unbuffered(FIL *fp, void *data, UINT size)
+{
+    UINT bytes;
+    FRESULT res = f_read(fp, data, size, &bytes);
+    if (res != FR_OK) ff_fail(fp, res);
+    if (bytes != size) ff_read_fail(fp);
+}
+
+// Fields are copied out of the buffer, the f_read per field is what made parsing slow.
+#define FILE_READ_FIELD(fp, value) do { \
+    if (file_buffered(fp) && ((file_buffer_index + sizeof(*(value))) <= file_buffer_size)) { \
+        memcpy((value), file_buffer_pointer + file_buffer_index, sizeof(*(value))); \
+        file_buffer_index += sizeof(*(value)); \
+    } else if (file_buffered(fp)) { \
+        file_read_buffered((fp), (value), sizeof(*(value))); \
+    } else { \
+        file_read_unbuffered((fp), (value), sizeof(*(value))); \
+    } \
+} while (0)
+
+void read_byte(FIL *fp, uint8_t *value)
+{
+    FILE_READ_FIELD(fp, value);
+}
+
 void read_byte_expect(FIL *fp, uint8_t value)
 {
     uint8_t compare;
@@ -300,20 +348,7 @@ void read_byte_ignore(FIL *fp)
 
 void read_word(FIL *fp, uint16_t *value)
 {
-    if (file_buffer_pointer) {
-        // We get a massive speed boost by buffering up as much data as possible
-        // via massive reads. So much so that the time wasted by
-        // all these operations does not cost us.
-        for (size_t i = 0; i < sizeof(*value); i++) {
-            file_fill(fp);
-            ((uint8_t *) value)[i] = file_buffer_pointer[file_buffer_index++];
-        }
-    } else {
-        UINT bytes;
-        FRESULT res = f_read(fp, value, sizeof(*value), &bytes);
-        if (res != FR_OK) ff_fail(fp, res);
-        if (bytes != sizeof(*value)) ff_read_fail(fp);
-    }
+    FILE_READ_FIELD(fp, value);
 }
 
 void read_word_expect(FIL *fp, uint16_t value)
@@ -331,20 +366,7 @@ void read_word_ignore(FIL *fp)
 
 void read_long(FIL *fp, uint32_t *value)
 {
-    if (file_buffer_pointer) {
-        // We get a massive speed boost by buffering up as much data as possible
-        // via massive reads. So much so that the time wasted by
-        // all these operations does not cost us.
-        for (size_t i = 0; i < sizeof(*value); i++) {
-            file_fill(fp);
-            ((uint8_t *) value)[i] = file_buffer_pointer[file_buffer_index++];
-        }
-    } else {
-        UINT bytes;
-        FRESULT res = f_read(fp, value, sizeof(*value), &bytes);
-        if (res != FR_OK) ff_fail(fp, res);
-        if (bytes != sizeof(*value)) ff_read_fail(fp);
-    }
+    FILE_READ_FIELD(fp, value);
 }
 
 void read_long_expect(FIL *fp, uint32_t value)
@@ -360,32 +382,37 @@ void read_long_ignore(FIL *fp)
     read_long(fp, &trash);
 }
 
-void read_data(FIL *fp, void *data, UINT size)
+void read_data(FIL *fp, void *buf, UINT size)
 {
-    if (file_buffer_pointer) {
-        // We get a massive speed boost by buffering up as much data as possible
-        // via massive reads. So much so that the time wasted by
-        // all these operations does not cost us.
-        while (size) {
-            file_fill(fp);
-            uint32_t file_buffer_space_left = file_buffer_size - file_buffer_index;
-            uint32_t can_do = FF_MIN(size, file_buffer_space_left);
+    uint8_t *data = buf;
+    if (file_buffered(fp)) {
+        // Empty the buffer first. Whole buffers' worth of what is left go straight to
+        // the destination, FatFs then reads their sectors into it without a copy. The
+        // disk functions want those 4-byte aligned, the buffer keeps the file's
+        // alignment the same way.
+        uint32_t file_buffer_left = file_buffer_size - file_buffer_index;
+        if ((size - FF_MIN(size, file_buffer_left)) >= file_buffer_size) {
+            uint32_t can_do = FF_MIN(size, file_buffer_left);
             memcpy(data, file_buffer_pointer+file_buffer_index, can_do);
             file_buffer_index += can_do;
             data += can_do;
             size -= can_do;
+            if (!(((uint32_t) data - f_tell(fp)) % 4)) {
+                uint32_t direct = size - (size % file_buffer_size);
+                file_read_unbuffered(fp, data, direct);
+                data += direct;
+                size -= direct;
+            }
         }
+        file_read_buffered(fp, data, size);
     } else {
-        UINT bytes;
-        FRESULT res = f_read(fp, data, size, &bytes);
-        if (res != FR_OK) ff_fail(fp, res);
-        if (bytes != size) ff_read_fail(fp);
+        file_read_unbuffered(fp, data, size);
     }
 }
 
 void write_byte(FIL *fp, uint8_t value)
 {
-    if (file_buffer_pointer) {
+    if (file_buffered(fp)) {
         // We get a massive speed boost by buffering up as much data as possible
         // before a write to the SD card. So much so that the time wasted by
         // all these operations does not cost us.
@@ -403,7 +430,7 @@ void write_byte(FIL *fp, uint8_t value)
 
 void write_word(FIL *fp, uint16_t value)
 {
-    if (file_buffer_pointer) {
+    if (file_buffered(fp)) {
         // We get a massive speed boost by buffering up as much data as possible
         // before a write to the SD card. So much so that the time wasted by
         // all these operations does not cost us.
@@ -421,7 +448,7 @@ void write_word(FIL *fp, uint16_t value)
 
 void write_long(FIL *fp, uint32_t value)
 {
-    if (file_buffer_pointer) {
+    if (file_buffered(fp)) {
         // We get a massive speed boost by buffering up as much data as possible
         // before a write to the SD card. So much so that the time wasted by
         // all these operations does not cost us.
@@ -437,9 +464,10 @@ void write_long(FIL *fp, uint32_t value)
     }
 }
 
-void write_data(FIL *fp, const void *data, UINT size)
+void write_data(FIL *fp, const void *buf, UINT size)
 {
-    if (file_buffer_pointer) {
+    const uint8_t *data = buf;
+    if (file_buffered(fp)) {
         // We get a massive speed boost by buffering up as much data as possible
         // before a write to the SD card. So much so that the time wasted by
         // all these operations does not cost us.
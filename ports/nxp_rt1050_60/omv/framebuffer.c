@@ -9,6 +9,7 @@
 #include "imlib.h"
 #include "omv_boardconfig.h"
 #include "framebuffer.h"
+#include "py/mphal.h"
 #ifdef __CC_ARM
 __WEAK bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc) {return 1;}
 
@@ -28,13 +29,51 @@ extern char _jpeg_buf;
 jpegbuffer_t *jpeg_fb_framebuffer = (jpegbuffer_t *) &_jpeg_buf;
 
 #endif
+
+uint32_t fb_ring_size;
+
+static int fb_ide_framing = FB_IDE_FRAMING_TEXT;
+
+// zlib CRC-32 from uzlib, pass 0xFFFFFFFF first and invert the result.
+extern uint32_t uzlib_crc32(const void *data, unsigned int length, uint32_t crc);
+extern void VCOM_OmvWriteAlways(const uint8_t *buf, uint32_t len);
+extern void usb_vnd_cancel(void);
+
+volatile bool fb_streaming;
+
+int fb_set_ide_framing(int framing)
+{
+    if ((framing != FB_IDE_FRAMING_TEXT) && (framing != FB_IDE_FRAMING_BINARY)) {
+        return -1;
+    }
+    fb_ide_framing = framing;
+    return 0;
+}
+
+int fb_get_ide_framing()
+{
+    return fb_ide_framing;
+}
+
 int encode_for_ide_new_size(image_t *img)
 {
+    if (fb_ide_framing == FB_IDE_FRAMING_BINARY) {
+        return FB_IDE_FRAME_HEADER + img->bpp;
+    }
     return (((img->bpp * 8) + 5) / 6) + 2;
 }
 
 void encode_for_ide(uint8_t *ptr, image_t *img)
 {
+    if (fb_ide_framing == FB_IDE_FRAMING_BINARY) {
+        uint32_t header[3] = { FB_IDE_FRAME_MAGIC, img->bpp, 0 };
+        uint32_t crc = uzlib_crc32(&header[1], sizeof(uint32_t), 0xFFFFFFFF);
+        header[2] = uzlib_crc32(img->data, img->bpp, crc) ^ 0xFFFFFFFF;
+        memcpy(ptr, header, FB_IDE_FRAME_HEADER);
+        memcpy(ptr + FB_IDE_FRAME_HEADER, img->data, img->bpp);
+        return;
+    }
+
     *ptr++ = 0xFE;
 
     for(int i = 0, j = (img->bpp / 3) * 3; i < j; i += 3) {
@@ -82,17 +121,198 @@ uint32_t fb_buffer_size()
         case IMAGE_BPP_BAYER: {
             return MAIN_FB()->w * MAIN_FB()->h;
         }
+        case IMAGE_BPP_YUV422: {
+            return (MAIN_FB()->w * MAIN_FB()->h) * sizeof(uint16_t);
+        }
         default: { // JPEG
             return MAIN_FB()->bpp;
         }
     }
 }
 
+void fb_wait_stream()
+{
+    for (mp_uint_t t0 = mp_hal_ticks_ms(); fb_streaming && ((mp_hal_ticks_ms() - t0) < FB_STREAM_WAIT_MS);) {
+    }
+    if (fb_streaming) {
+        // The host stopped reading, the stream done callback clears the flag.
+        usb_vnd_cancel();
+        fb_streaming = false;
+    }
+}
+
+// Delta preview state, tile signatures are those of the last packet that was built.
+static struct {
+    bool enabled;
+    int keyframe_interval;
+    int threshold;
+    int countdown;  // packets until the next keyframe
+    int w, h, bpp;  // frame the signatures belong to, 0 forces a keyframe
+    uint8_t sig[FB_DELTA_MAX_TILES][4];
+} fb_delta;
+
+int fb_set_delta_preview(bool enable, int keyframe_interval, int threshold)
+{
+    if ((keyframe_interval < 1) || (threshold < 0) || (threshold > 255)) {
+        return -1;
+    }
+
+    fb_delta.enabled = enable;
+    fb_delta.keyframe_interval = keyframe_interval;
+    fb_delta.threshold = threshold;
+    fb_delta.w = fb_delta.h = fb_delta.bpp = 0;
+    return 0;
+}
+
+// The mean brightness of the four 8x8 quarters of a tile, clipped to the frame.
+static void fb_delta_signature(image_t *img, int tx, int ty, uint8_t *sig)
+{
+    for (int q = 0; q < 4; q++) {
+        int x_start = (tx * FB_DELTA_TILE) + ((q & 1) * (FB_DELTA_TILE / 2));
+        int y_start = (ty * FB_DELTA_TILE) + ((q >> 1) * (FB_DELTA_TILE / 2));
+        int x_end = IM_MIN(x_start + (FB_DELTA_TILE / 2), img->w);
+        int y_end = IM_MIN(y_start + (FB_DELTA_TILE / 2), img->h);
+        uint32_t sum = 0;
+
+        for (int y = y_start; y < y_end; y++) {
+            if (img->bpp == IMAGE_BPP_GRAYSCALE) {
+                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+                for (int x = x_start; x < x_end; x++) {
+                    sum += IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                }
+            } else {
+                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+                for (int x = x_start; x < x_end; x++) {
+                    sum += COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                }
+            }
+        }
+
+        int n = IM_MAX(x_end - x_start, 0) * IM_MAX(y_end - y_start, 0);
+        sig[q] = n ? (sum / n) : 0;
+    }
+}
+
+// Builds a delta packet of src in dst, see fb_delta_header_t. Returns true on overflow like
+// jpeg_compress(), dst->bpp is the packet size and 0 when no tile changed.
+static bool fb_delta_compress(image_t *src, image_t *dst, int quality)
+{
+    int tiles_w = (src->w + FB_DELTA_TILE - 1) / FB_DELTA_TILE;
+    int tiles_h = (src->h + FB_DELTA_TILE - 1) / FB_DELTA_TILE;
+    int tiles = tiles_w * tiles_h;
+
+    if (((src->bpp != IMAGE_BPP_GRAYSCALE) && (src->bpp != IMAGE_BPP_RGB565))
+    || (tiles > FB_DELTA_MAX_TILES) || (tiles_w > 255) || (tiles_h > 255)) {
+        return jpeg_compress(src, dst, quality, false);
+    }
+
+    fb_alloc_mark();
+    uint8_t (*sig)[4] = fb_alloc(tiles * sizeof(sig[0]), FB_ALLOC_NO_HINT);
+    uint16_t *changed = fb_alloc(tiles * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+    int count = 0;
+
+    bool keyframe = (fb_delta.w != src->w) || (fb_delta.h != src->h) || (fb_delta.bpp != src->bpp)
+            || (fb_delta.countdown <= 0);
+
+    for (int i = 0; i < tiles; i++) {
+        fb_delta_signature(src, i % tiles_w, i / tiles_w, sig[i]);
+        for (int q = 0; (!keyframe) && (q < 4); q++) {
+            if (abs(sig[i][q] - fb_delta.sig[i][q]) > fb_delta.threshold) {
+                changed[count++] = i;
+                break;
+            }
+        }
+    }
+
+    // Past half the frame one JPEG of all of it is smaller than the tiles.
+    keyframe = keyframe || ((count * 2) > tiles);
+
+    if ((!keyframe) && (!count)) {
+        fb_delta.countdown--;
+        fb_alloc_free_till_mark();
+        dst->bpp = 0;
+        return false;
+    }
+
+    fb_delta_header_t *header = (fb_delta_header_t *) dst->pixels;
+    int columns = keyframe ? 0 : IM_MIN(count, tiles_w);
+    int list_size = keyframe ? 0 : (((count * 2) + 3) & ~3);
+    int offset = sizeof(fb_delta_header_t) + list_size;
+
+    if (offset >= dst->bpp) {
+        fb_alloc_free_till_mark();
+        return true;
+    }
+
+    header->magic = FB_DELTA_MAGIC;
+    header->tiles = keyframe ? 0 : count;
+    header->tile_size = FB_DELTA_TILE;
+    header->columns = columns;
+
+    image_t out = {.w=src->w, .h=src->h, .bpp=dst->bpp - offset, .pixels=dst->pixels + offset};
+    bool overflow;
+
+    if (keyframe) {
+        overflow = jpeg_compress(src, &out, quality, false);
+    } else {
+        uint8_t *list = dst->pixels + sizeof(fb_delta_header_t);
+        int bytes_per_pixel = (src->bpp == IMAGE_BPP_GRAYSCALE) ? 1 : 2;
+        int rows = (count + columns - 1) / columns;
+        image_t mosaic = {.w=columns * FB_DELTA_TILE, .h=rows * FB_DELTA_TILE, .bpp=src->bpp};
+        mosaic.pixels = fb_alloc0(mosaic.w * mosaic.h * bytes_per_pixel, FB_ALLOC_NO_HINT);
+
+        for (int i = 0; i < count; i++) {
+            int tx = changed[i] % tiles_w, ty = changed[i] / tiles_w;
+            int x = tx * FB_DELTA_TILE, y = ty * FB_DELTA_TILE;
+            int w = IM_MIN(FB_DELTA_TILE, src->w - x), h = IM_MIN(FB_DELTA_TILE, src->h - y);
+            uint8_t *dst_ptr = mosaic.pixels + ((((i / columns) * FB_DELTA_TILE * mosaic.w)
+                    + ((i % columns) * FB_DELTA_TILE)) * bytes_per_pixel);
+            uint8_t *src_ptr = src->pixels + (((y * src->w) + x) * bytes_per_pixel);
+
+            for (int j = 0; j < h; j++) {
+                memcpy(dst_ptr + (j * mosaic.w * bytes_per_pixel), src_ptr + (j * src->w * bytes_per_pixel),
+                        w * bytes_per_pixel);
+            }
+
+            list[(i * 2) + 0] = tx;
+            list[(i * 2) + 1] = ty;
+        }
+
+        for (int i = count * 2; i < list_size; i++) {
+            list[i] = 0;
+        }
+
+        out.w = mosaic.w;
+        out.h = mosaic.h;
+        overflow = jpeg_compress(&mosaic, &out, quality, false);
+    }
+
+    if (!overflow) {
+        // Only what was sent becomes the reference, unchanged tiles keep drifting against it.
+        if (keyframe) {
+            memcpy(fb_delta.sig, sig, tiles * sizeof(sig[0]));
+            fb_delta.w = src->w;
+            fb_delta.h = src->h;
+            fb_delta.bpp = src->bpp;
+            fb_delta.countdown = fb_delta.keyframe_interval;
+        } else {
+            for (int i = 0; i < count; i++) {
+                memcpy(fb_delta.sig[changed[i]], sig[changed[i]], sizeof(sig[0]));
+            }
+        }
+        fb_delta.countdown--;
+        dst->bpp = offset + out.bpp;
+    }
+
+    fb_alloc_free_till_mark();
+    return overflow;
+}
+
 void fb_update_jpeg_buffer()
 {
     static int overflow_count = 0;
 
-    if ((MAIN_FB()->bpp > 3) && JPEG_FB()->enabled && JPEG_FB()->size == 0) {
+    if ((MAIN_FB()->bpp >= IMAGE_BPP_JPEG) && JPEG_FB()->enabled && JPEG_FB()->size == 0) {
         bool does_not_fit = false;
         // Lock FB
         if (mutex_try_lock(&JPEG_FB()->lock, MUTEX_TID_OMV)) {
@@ -114,6 +334,10 @@ void fb_update_jpeg_buffer()
             fb_alloc_mark();
             uint8_t *temp = fb_alloc(new_size, FB_ALLOC_NO_HINT);
             encode_for_ide(temp, &out);
+            // The text encoding is too slow to stream, framed binary goes out as is.
+            if (fb_ide_framing == FB_IDE_FRAMING_BINARY) {
+                VCOM_OmvWriteAlways(temp, new_size);
+            }
             // (MP_PYTHON_PRINTER)->print_strn((MP_PYTHON_PRINTER)->data, (const char *) temp, new_size);
             fb_alloc_free_till_mark();
         }
@@ -124,7 +348,8 @@ void fb_update_jpeg_buffer()
             image_t src = {.w=MAIN_FB()->w, .h=MAIN_FB()->h, .bpp=MAIN_FB()->bpp,     .pixels=MAIN_FB()->pixels};
             image_t dst = {.w=MAIN_FB()->w, .h=MAIN_FB()->h, .bpp=(OMV_JPEG_BUF_SIZE-64),  .pixels=JPEG_FB()->pixels};
             // Note: lower quality saves USB bandwidth and results in a faster IDE FPS.
-            bool overflow = jpeg_compress(&src, &dst, JPEG_FB()->quality, false);
+            bool overflow = fb_delta.enabled ? fb_delta_compress(&src, &dst, JPEG_FB()->quality)
+                                             : jpeg_compress(&src, &dst, JPEG_FB()->quality, false);
             if (overflow == true) {
                 // JPEG buffer overflowed, reduce JPEG quality for the next frame
                 // and skip the current frame. The IDE doesn't receive this frame.
@@ -143,7 +368,7 @@ void fb_update_jpeg_buffer()
                        < ((fb_buffer_size() > JPEG_QUALITY_THRESH) ? JPEG_QUALITY_LOW:JPEG_QUALITY_HIGH)) {
                     JPEG_FB()->quality++;
                 }
-                // Set FB from JPEG image
+                // Set FB from JPEG image, a delta packet with no changed tiles stays empty.
                 JPEG_FB()->w = dst.w; JPEG_FB()->h = dst.h; JPEG_FB()->size = dst.bpp;
             }
 
@@ -152,3 +377,65 @@ void fb_update_jpeg_buffer()
         }
     }
 }
+
+static fb_slot_t fb_slots[FB_SLOT_MAX];
+static int fb_slot_count;
+
+void fb_slots_init0()
+{
+    memset(fb_slots, 0, sizeof(fb_slots));
+    fb_slot_count = 0;
+}
+
+fb_slot_t *fb_slot_find(const char *name)
+{
+    for (int i = 0; i < fb_slot_count; i++) {
+        if (!strncmp(fb_slots[i].name, name, FB_SLOT_NAME_LEN)) {
+            return &fb_slots[i];
+        }
+    }
+    return NULL;
+}
+
+fb_slot_t *fb_slot_from_pixels(const uint8_t *pixels)
+{
+    for (int i = 0; i < fb_slot_count; i++) {
+        if (fb_slots[i].pixels == pixels) {
+            return &fb_slots[i];
+        }
+    }
+    return NULL;
+}
+
+fb_slot_t *fb_slot_alloc(const char *name, int w, int h, int bpp)
+{
+    if (fb_slot_count == FB_SLOT_MAX) {
+        return NULL;
+    }
+
+    uint32_t size = (bpp == IMAGE_BPP_BINARY) ? (((w + UINT32_T_MASK) >> UINT32_T_SHIFT) * h * sizeof(uint32_t))
+                                               : (w * h * bpp);
+    uint8_t *pixels = fb_alloc_reserve(size);
+    if (!pixels) {
+        return NULL;
+    }
+
+    fb_slot_t *slot = &fb_slots[fb_slot_count++];
+    strncpy(slot->name, name, FB_SLOT_NAME_LEN - 1);
+    slot->name[FB_SLOT_NAME_LEN - 1] = 0;
+    slot->w = w;
+    slot->h = h;
+    slot->bpp = bpp;
+    slot->size = size;
+    slot->pixels = pixels;
+    return slot;
+}
+
+bool fb_slot_free_all()
+{
+    if (fb_alloc_release_reserved() != 0) {
+        return false;
+    }
+    fb_slots_init0();
+    return true;
+}
@@ -9,6 +9,7 @@
 #ifndef __FRAMEBUFFER_H__
 #define __FRAMEBUFFER_H__
 #include <stdint.h>
+#include <stdbool.h>
 #include "imlib.h"
 #include "mutex.h"
 
@@ -35,22 +36,83 @@ typedef struct jpegbuffer {
 
 extern jpegbuffer_t *jpeg_fb_framebuffer;
 
+// Bytes reserved after MAIN_FB()->pixels for the sensor capture ring (0 when single buffered).
+extern uint32_t fb_ring_size;
+
 // Use these macros to get a pointer to main or JPEG framebuffer.
 #define MAIN_FB()           (fb_framebuffer)
 #define JPEG_FB()           (jpeg_fb_framebuffer)
 
 
 // Use this macro to get a pointer to the free SRAM area located after the framebuffer.
-#define MAIN_FB_PIXELS()    (MAIN_FB()->pixels + fb_buffer_size())
+#define MAIN_FB_PIXELS()    (MAIN_FB()->pixels + IM_MAX(fb_buffer_size(), fb_ring_size))
 
 // Use this macro to get a pointer to the free SRAM area located after the framebuffer.
 #define JPEG_FB_PIXELS()    (JPEG_FB()->pixels + JPEG_FB()->size)
 
+// Frames sent to the IDE in the console stream. The text framing packs 6 bits in each byte
+// between 0xFE markers so it survives any terminal, at a third more bytes. The binary framing
+// is used once the host asks for it (USBDBG_FB_FRAMING): the magic, the payload length and the
+// CRC-32 (zlib) of the length and payload, all little endian words, then the payload as is.
+#define FB_IDE_FRAMING_TEXT     (0)
+#define FB_IDE_FRAMING_BINARY   (1)
+#define FB_IDE_FRAME_MAGIC      (0x46564D4F) // "OMVF"
+#define FB_IDE_FRAME_HEADER     (12)
+// Returns -1 if the framing is unknown.
+int fb_set_ide_framing(int framing);
+int fb_get_ide_framing();
 int encode_for_ide_new_size(image_t *img);
 void encode_for_ide(uint8_t *ptr, image_t *img);
 // Returns the main frame buffer size, factoring in pixel formats.
 uint32_t fb_buffer_size();
 
+// Set while the IDE reads MAIN_FB()->pixels from the vendor bulk endpoint (USBDBG_FRAME_STREAM).
+// A capture into the main frame first waits for it, up to FB_STREAM_WAIT_MS, then drops it.
+#define FB_STREAM_WAIT_MS   (100)
+extern volatile bool fb_streaming;
+void fb_wait_stream();
+
 // Transfers the frame buffer to the jpeg frame buffer if not locked.
 void fb_update_jpeg_buffer();
+
+// Delta preview: instead of a JPEG of every frame the JPEG buffer holds a packet with the
+// FB_DELTA_TILE square tiles that changed since the last packet, packed in one JPEG mosaic,
+// and a whole frame keyframe every keyframe_interval frames. A tile changed when the mean
+// of one of its 8x8 quarters moved by more than threshold. Frames that cannot be tiled
+// (JPEG, bayer or too large) are still sent as plain JPEGs.
+#define FB_DELTA_TILE       (16)
+#define FB_DELTA_MAX_TILES  ((640 / FB_DELTA_TILE) * (480 / FB_DELTA_TILE))
+#define FB_DELTA_MAGIC      (0x544C4544) // "DELT"
+typedef struct fb_delta_header {
+    uint32_t magic;
+    uint16_t tiles;     // 0 for a keyframe
+    uint8_t tile_size;
+    uint8_t columns;    // tiles per mosaic row
+    // Followed by the x, y tile coordinates of each tile (bytes, padded to 4), then the JPEG:
+    // the whole frame for a keyframe, else the mosaic, tile i at (i % columns, i / columns).
+} fb_delta_header_t;
+
+// Returns -1 if the interval or threshold is invalid.
+int fb_set_delta_preview(bool enable, int keyframe_interval, int threshold);
+
+// Named frame slots: fixed address frames reserved at the top of the fb_alloc region,
+// for background models and reference frames that must outlive a snapshot.
+#define FB_SLOT_MAX         (4)
+#define FB_SLOT_NAME_LEN    (16)
+typedef struct fb_slot {
+    char name[FB_SLOT_NAME_LEN];
+    int w, h, bpp;
+    uint32_t size;
+    uint8_t *pixels;
+} fb_slot_t;
+
+// Forgets all slots, call after fb_alloc_init0().
+void fb_slots_init0();
+fb_slot_t *fb_slot_find(const char *name);
+// Finds the slot owning pixels, NULL if they are not slot memory.
+fb_slot_t *fb_slot_from_pixels(const uint8_t *pixels);
+// Returns NULL if the table is full, the fb_alloc stack is in use or out of memory.
+fb_slot_t *fb_slot_alloc(const char *name, int w, int h, int bpp);
+// Fails (returns false) while anything is on the fb_alloc stack.
+bool fb_slot_free_all();
 #endif /* __FRAMEBUFFER_H__ */
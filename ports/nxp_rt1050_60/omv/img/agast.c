@@ -5,16 +5,8 @@
 #include "fb_alloc.h"
 #include "gc.h"
 
-#define MAX_ROW         (480)
-#define MAX_CORNERS     (2000)
 #define Compare(X, Y) ((X)>=(Y))
 
-typedef struct {
-    uint16_t x;
-    uint16_t y;
-    uint16_t score;
-} corner_t;
-
 static int s_width=-1;
 static int_fast16_t s_offset0;
 static int_fast16_t s_offset1;
@@ -25,9 +17,8 @@ static int_fast16_t s_offset5;
 static int_fast16_t s_offset6;
 static int_fast16_t s_offset7;
 
-static corner_t *agast58_detect(image_t *img, int b, int* num_corners, rectangle_t *roi);
+static void agast58_detect(image_t *img, int b, rectangle_t *roi, array_t *keypoints);
 static int agast58_score(const unsigned char* p, int bstart);
-static void nonmax_suppression(corner_t *corners, int num_corners, array_t *keypoints);
 
 static kp_t *alloc_keypoint(uint16_t x, uint16_t y, uint16_t score)
 {
@@ -58,103 +49,27 @@ static void init5_8_pattern(int image_width)
 
 void agast_detect(image_t *image, array_t *keypoints, int threshold, rectangle_t *roi)
 {
-    int num_corners=0;
 	init5_8_pattern(image->w);
 
-    // Find corners
-    corner_t *corners = agast58_detect(image, threshold, &num_corners, roi);
-    if (num_corners) {
-        // Score corners
-        for(int i=0; i<num_corners; i++) {
-            corners[i].score = agast58_score(image->pixels + (corners[i].y*image->w + corners[i].x), threshold);
-        }
-        // Non-max suppression
-        nonmax_suppression(corners, num_corners, keypoints);
-    }
-
-    // Free corners;
-    fb_free();
+    // Find, score and suppress corners
+    agast58_detect(image, threshold, roi, keypoints);
 }
 
-static void nonmax_suppression(corner_t *corners, int num_corners, array_t *keypoints)
+// Corner scores are kept for the last 3 rows only, as score+1 so 0 means no corner. A row is
+// suppressed as soon as the row below it is scored. Returns false when out of memory.
+static bool nonmax_suppression_row(array_t *keypoints, const uint16_t *above, const uint16_t *row,
+                                   const uint16_t *below, int x_offset, int w, int y)
 {
     gc_info_t info;
 
-	int last_row;
-	int16_t row_start[MAX_ROW+1];
-	const int sz = num_corners;
-
-	/* Point above points (roughly) to the pixel above
-       the one of interest, if there is a feature there.*/
-	int point_above = 0;
-	int point_below = 0;
-
-	/* Find where each row begins (the corners are output in raster scan order).
-       A beginning of -1 signifies that there are no corners on that row. */
-	last_row  = corners[sz-1].y;
-
-	for(int i=0; i<last_row+1; i++) {
-		row_start[i] = -1;
-    }
-
-    for (int i=0, prev_row=-1; i<sz; i++) {
-        corner_t *c = &corners[i];
-        if (c->y != prev_row) {
-            row_start[c->y] = i;
-            prev_row = c->y;
-        }
-    }
-
-    for(int i=0; i<sz; i++) {
-        corner_t pos = corners[i];
-        uint16_t score = pos.score;
-
-        /*Check left */
-        if (i > 0) {
-            if (corners[i-1].x == pos.x-1 && corners[i-1].y == pos.y && Compare(corners[i-1].score, score)) {
-                goto nonmax;
-            }
-        }
-
-        /*Check right*/
-        if (i < (sz - 1)) {
-            if (corners[i+1].x == pos.x+1 && corners[i+1].y == pos.y && Compare(corners[i+1].score, score)) {
-                goto nonmax;
-            }
-        }
-
-        /*Check above (if there is a valid row above)*/
-        if (pos.y != 0 && row_start[pos.y - 1] != -1)  {
-            /*Make sure that current point_above is one row above.*/
-            if(corners[point_above].y < pos.y - 1)
-                point_above = row_start[pos.y-1];
-
-            /*Make point_above point to the first of the pixels above the current point, if it exists.*/
-            for (; corners[point_above].y < pos.y && corners[point_above].x < pos.x - 1; point_above++) {
-
-            }
-
-            for (int j=point_above; corners[j].y < pos.y && corners[j].x <= pos.x + 1; j++) {
-                int x = corners[j].x;
-                if( (x == pos.x - 1 || x ==pos.x || x == pos.x+1) && Compare(corners[j].score, score))
-                    goto nonmax;
-            }
-        }
-
-        /*Check below (if there is anything below)*/
-        if (pos.y != last_row && row_start[pos.y + 1] != -1 && point_below < sz) /*Nothing below*/ {
-            if (corners[point_below].y < pos.y + 1)
-                point_below = row_start[pos.y+1];
-
-            /* Make point below point to one of the pixels belowthe current point, if it exists.*/
-            for (; point_below < sz && corners[point_below].y == pos.y+1 && corners[point_below].x < pos.x - 1; point_below++) {
-            }
+    for (int x=1; x<(w-1); x++) {
+        int score = row[x];
 
-            for (int j=point_below; j < sz && corners[j].y == pos.y+1 && corners[j].x <= pos.x + 1; j++) {
-                int x = corners[j].x;
-                if( (x == pos.x - 1 || x ==pos.x || x == pos.x+1) && Compare(corners[j].score, score))
-                    goto nonmax;
-            }
+        if ((!score)
+        || Compare(row[x-1], score) || Compare(row[x+1], score)
+        || Compare(above[x-1], score) || Compare(above[x], score) || Compare(above[x+1], score)
+        || Compare(below[x-1], score) || Compare(below[x], score) || Compare(below[x+1], score)) {
+            continue;
         }
 
         gc_info(&info);
@@ -166,20 +81,43 @@ static void nonmax_suppression(corner_t *corners, int num_corners, array_t *keyp
             // If it didn't work break
             gc_info(&info);
             if (info.free < MIN_MEM) {
-                break;
+                return false;
             }
         }
 
         #undef MIN_MEM
-        array_push_back(keypoints, alloc_keypoint(pos.x, pos.y, pos.score));
-        nonmax:
-        ;
+        array_push_back(keypoints, alloc_keypoint(x_offset + x, y, score - 1));
+    }
+
+    return true;
+}
+
+#if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+// A 5 of 8 arc always covers 2 adjacent pixels of left/top/right/bottom, test those for 4 pixels
+// at once and return a byte mask of the pixels that can still be corners. b4 is b+1 in each byte.
+static inline uint32_t agast58_pretest(const uint8_t *p, uint32_t b4)
+{
+    uint32_t c4 = *((uint32_t *) p);
+    uint32_t cb4 = __UQADD8(c4, b4);    // p[k] > *p + b when p[k] >= cb4
+    uint32_t c_b4 = __UQSUB8(c4, b4);   // p[k] < *p - b when c_b4 >= p[k]
+    const int_fast16_t offsets[4] = {s_offset0, s_offset2, s_offset4, s_offset6};
+    uint32_t bright[4], dark[4];
+
+    for (int i=0; i<4; i++) {
+        uint32_t v = *((uint32_t *) (p + offsets[i]));
+        __USUB8(v, cb4);
+        bright[i] = __SEL(0xffffffff, 0x00000000);
+        __USUB8(c_b4, v);
+        dark[i] = __SEL(0xffffffff, 0x00000000);
     }
+
+    return (bright[0] & bright[1]) | (bright[1] & bright[2]) | (bright[2] & bright[3]) | (bright[3] & bright[0])
+         | (dark[0] & dark[1]) | (dark[1] & dark[2]) | (dark[2] & dark[3]) | (dark[3] & dark[0]);
 }
+#endif
 
-static corner_t *agast58_detect(image_t *img, int b, int* num_corners, rectangle_t *roi)
+static void agast58_detect(image_t *img, int b, rectangle_t *roi, array_t *keypoints)
 {
-	int total=0;
 	register int x, y;
 	register int xsizeB=(roi->x+roi->w) - 2;
 	register int ysizeB=(roi->y+roi->h) - 1;
@@ -196,13 +134,28 @@ static corner_t *agast58_detect(image_t *img, int b, int* num_corners, rectangle
 	offset7=s_offset7;
 	width=s_width;
 
-    // Try to alloc MAX_CORNERS or the actual max corners we can alloc.
-    int max_corners = IM_MIN(MAX_CORNERS, (fb_avail() / sizeof(corner_t)));
-    corner_t *corners = (corner_t*) fb_alloc(max_corners * sizeof(corner_t), FB_ALLOC_NO_HINT);
+	int w=roi->w;
+	int y_start=roi->y+1;
+
+	if((y_start >= ysizeB) || ((roi->x+1) > xsizeB))
+		return;
+
+	uint16_t *scores = fb_alloc0(3 * w * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+	uint16_t *row = NULL;
+	#if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+	uint32_t b4 = IM_MIN(b + 1, 255) * 0x01010101;
+	uint32_t candidates = 0;
+	int candidates_x = 0;
+	#endif
 
-	for(y=roi->y+1; y < ysizeB; y++)
+	for(y=y_start; y < ysizeB; y++)
 	{										
 		x=roi->x;
+		row = scores + ((y % 3) * w);
+		memset(row, 0, w * sizeof(uint16_t));
+		#if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+		candidates_x = x - 4;
+		#endif
 		while(1)							
 		{									
 homogeneous:
@@ -215,6 +168,15 @@ homogeneous:
 				register const unsigned char* const p = img->pixels + y*width + x;
 				register const int cb = *p + b;
 				register const int c_b = *p - b;
+				#if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+				if((x - candidates_x) >= 4)
+				{
+					candidates_x = x;
+					candidates = ((x + 3) <= xsizeB) ? agast58_pretest(p, b4) : 0xffffffff;
+				}
+				if(!(candidates & (0xff << ((x - candidates_x) * 8))))
+					goto homogeneous;
+				#endif
 				if(p[offset0] > cb)
 				  if(p[offset2] > cb)
 					if(p[offset3] > cb)
@@ -551,6 +513,15 @@ structured:
 				register const unsigned char* const p = img->pixels + y*width + x;
 				register const int cb = *p + b;
 				register const int c_b = *p - b;
+				#if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+				if((x - candidates_x) >= 4)
+				{
+					candidates_x = x;
+					candidates = ((x + 3) <= xsizeB) ? agast58_pretest(p, b4) : 0xffffffff;
+				}
+				if(!(candidates & (0xff << ((x - candidates_x) * 8))))
+					goto homogeneous;
+				#endif
 				if(p[offset0] > cb)
 				  if(p[offset2] > cb)
 					if(p[offset3] > cb)
@@ -890,24 +861,26 @@ structured:
 			}
 }
 success_homogeneous:
-			corners[total].x = x;				
-			corners[total].y = y;				
-			if(++total == max_corners) {
-                goto done;
-            }
+			row[x - roi->x] = agast58_score(img->pixels + y*width + x, b) + 1;
 			goto homogeneous;				
 success_structured:
-			corners[total].x = x;				
-			corners[total].y = y;				
-			if(++total == max_corners) {
-                goto done;
-            }
+			row[x - roi->x] = agast58_score(img->pixels + y*width + x, b) + 1;
 			goto structured;				
 		}									
+
+		// Row y-1 has both of its neighbour rows now.
+		if((y > y_start) && !nonmax_suppression_row(keypoints, scores + (((y - 2) % 3) * w),
+					scores + (((y - 1) % 3) * w), row, roi->x, w, y - 1))
+			goto done;
 	}										
+
+	// The last row has nothing below it.
+	memset(scores + ((ysizeB % 3) * w), 0, w * sizeof(uint16_t));
+	nonmax_suppression_row(keypoints, scores + (((ysizeB - 2) % 3) * w),
+			scores + (((ysizeB - 1) % 3) * w), scores + ((ysizeB % 3) * w), roi->x, w, ysizeB - 1);
+
 done:
-	*num_corners = total;
-	return corners;								
+	fb_free();
 }
 
 //using also bisection as propsed by Edward Rosten in FAST,
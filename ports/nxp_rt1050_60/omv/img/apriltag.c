@@ -5184,13 +5184,18 @@ struct apriltag_detector
     ///////////////////////////////////////////////////////////////
     // User-configurable parameters.
 
+    // detection of quads can be done on a lower-resolution image,
+    // improving speed at a cost of pose accuracy and a slight
+    // decrease in detection rate. Decoding the binary payload is
+    // still done at full resolution.
+    int quad_decimate;
+
     // When non-zero, the edges of the each quad are adjusted to "snap
     // to" strong gradients nearby. This is useful when decimation is
     // employed, as it can increase the quality of the initial quad
     // estimate substantially. Generally recommended to be on (1).
     //
-    // Very computationally inexpensive. Option is ignored if
-    // quad_decimate = 1.
+    // Very computationally inexpensive.
     int refine_edges;
 
     // when non-zero, detections are refined in a way intended to
@@ -9223,12 +9228,12 @@ static inline uint32_t u64hash_2(uint64_t x) {
     return (uint32_t) x;
 }
 
-struct uint32_zarray_entry
+struct uint32_cluster_entry
 {
     uint32_t id;
+    uint32_t next; // index of the next entry in the bucket, UINT32_MAX if none.
+    int size;      // points counted by the first pass.
     zarray_t *cluster;
-
-    struct uint32_zarray_entry *next;
 };
 
 #ifndef M_PI
@@ -10573,127 +10578,162 @@ zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im, bool ove
         do_unionfind_line(uf, threshim, h, w, ts, y);
     }
 
-    uint32_t nclustermap;
-    struct uint32_zarray_entry **clustermap = fb_alloc0_all(&nclustermap, FB_ALLOC_PREFER_SPEED);
-    nclustermap /= sizeof(struct uint32_zarray_entry*);
-    if (!nclustermap) fb_alloc_fail();
+    // Clusters are built in two passes over the image. The first one counts the points of each
+    // cluster, the second one stores them in arrays allocated once at their final size. Points
+    // used to be appended one at a time, growing each array by 8 elements with umm_realloc().
+    int nclustermap = imax((w * h) / 8, 1024);
+    uint32_t *clustermap = fb_alloc(nclustermap * sizeof(uint32_t), FB_ALLOC_PREFER_SPEED);
+    memset(clustermap, 0xFF, nclustermap * sizeof(uint32_t));
 
-    for (int y = 1; y < h-1; y++) {
-        for (int x = 1; x < w-1; x++) {
+    uint32_t nentries;
+    struct uint32_cluster_entry *entries = fb_alloc_all(&nentries, FB_ALLOC_PREFER_SPEED);
+    nentries /= sizeof(struct uint32_cluster_entry);
+    if (!nentries) fb_alloc_fail();
+    uint32_t nentries_used = 0;
 
-            uint8_t v0 = threshim->buf[y*ts + x];
-            if (v0 == 127)
-                continue;
+    zarray_t *clusters = NULL;
 
-            // XXX don't query this until we know we need it?
-            uint32_t rep0 = unionfind_get_representative(uf, y*w + x);
+    for (int pass = 0; pass < 2; pass++) {
+        for (int y = 1; y < h-1; y++) {
+            for (int x = 1; x < w-1; x++) {
 
-            // whenever we find two adjacent pixels such that one is
-            // white and the other black, we add the point half-way
-            // between them to a cluster associated with the unique
-            // ids of the white and black regions.
-            //
-            // We additionally compute the gradient direction (i.e., which
-            // direction was the white pixel?) Note: if (v1-v0) == 255, then
-            // (dx,dy) points towards the white pixel. if (v1-v0) == -255, then
-            // (dx,dy) points towards the black pixel. p.gx and p.gy will thus
-            // be -255, 0, or 255.
-            //
-            // Note that any given pixel might be added to multiple
-            // different clusters. But in the common case, a given
-            // pixel will be added multiple times to the same cluster,
-            // which increases the size of the cluster and thus the
-            // computational costs.
-            //
-            // A possible optimization would be to combine entries
-            // within the same cluster.
+                uint8_t v0 = threshim->buf[y*ts + x];
+                if (v0 == 127)
+                    continue;
+
+                // XXX don't query this until we know we need it?
+                uint32_t rep0 = unionfind_get_representative(uf, y*w + x);
+
+                // whenever we find two adjacent pixels such that one is
+                // white and the other black, we add the point half-way
+                // between them to a cluster associated with the unique
+                // ids of the white and black regions.
+                //
+                // We additionally compute the gradient direction (i.e., which
+                // direction was the white pixel?) Note: if (v1-v0) == 255, then
+                // (dx,dy) points towards the white pixel. if (v1-v0) == -255, then
+                // (dx,dy) points towards the black pixel. p.gx and p.gy will thus
+                // be -255, 0, or 255.
+                //
+                // Note that any given pixel might be added to multiple
+                // different clusters. But in the common case, a given
+                // pixel will be added multiple times to the same cluster,
+                // which increases the size of the cluster and thus the
+                // computational costs.
+                //
+                // A possible optimization would be to combine entries
+                // within the same cluster.
 
 #define DO_CONN(dx, dy)                                                 \
-            if (1) {                                                    \
-                uint8_t v1 = threshim->buf[y*ts + dy*ts + x + dx];      \
-                                                                        \
-                while (v0 + v1 == 255) {                                   \
-                    uint32_t rep1 = unionfind_get_representative(uf, y*w + dy*w + x + dx); \
-                    uint32_t clusterid;                                 \
-                    if (rep0 < rep1)                                    \
-                        clusterid = (rep1 << 16) + rep0;                \
-                    else                                                \
-                        clusterid = (rep0 << 16) + rep1;                \
-                                                                        \
-                    /* XXX lousy hash function */                       \
-                    uint32_t clustermap_bucket = u64hash_2(clusterid) % nclustermap; \
-                    struct uint32_zarray_entry *entry = clustermap[clustermap_bucket]; \
-                    while (entry && entry->id != clusterid)     {       \
-                        entry = entry->next;                            \
-                    }                                                   \
-                                                                        \
-                    if (!entry) {                                       \
-                        entry = umm_calloc(1, sizeof(struct uint32_zarray_entry)); \
-                        if (!entry) break;                              \
-                        entry->id = clusterid;                          \
-                        entry->cluster = zarray_create_fail_ok(sizeof(struct pt)); \
-                        if (!entry->cluster) {                          \
-                            free(entry);                                \
-                            break;                                      \
-                        }                                               \
-                        entry->next = clustermap[clustermap_bucket];    \
-                        clustermap[clustermap_bucket] = entry;          \
-                    }                                                   \
-                                                                        \
-                    struct pt p = { .x = 2*x + dx, .y = 2*y + dy, .gx = dx*((int) v1-v0), .gy = dy*((int) v1-v0)}; \
-                    zarray_add_fail_ok(entry->cluster, &p);             \
-                    break;                                              \
-                }                                                       \
-            }
+                if (1) {                                                    \
+                    uint8_t v1 = threshim->buf[y*ts + dy*ts + x + dx];      \
+                                                                            \
+                    while (v0 + v1 == 255) {                                \
+                        uint32_t rep1 = unionfind_get_representative(uf, y*w + dy*w + x + dx); \
+                        uint32_t clusterid;                                 \
+                        if (rep0 < rep1)                                    \
+                            clusterid = (rep1 << 16) + rep0;                \
+                        else                                                \
+                            clusterid = (rep0 << 16) + rep1;                \
+                                                                            \
+                        /* XXX lousy hash function */                       \
+                        uint32_t clustermap_bucket = u64hash_2(clusterid) % nclustermap; \
+                        uint32_t e = clustermap[clustermap_bucket];         \
+                        while ((e != UINT32_MAX) && (entries[e].id != clusterid)) { \
+                            e = entries[e].next;                            \
+                        }                                                   \
+                                                                            \
+                        if (!pass) {                                        \
+                            if (e == UINT32_MAX) {                          \
+                                if (nentries_used == nentries) break;       \
+                                e = nentries_used++;                        \
+                                entries[e].id = clusterid;                  \
+                                entries[e].size = 0;                        \
+                                entries[e].cluster = NULL;                  \
+                                entries[e].next = clustermap[clustermap_bucket]; \
+                                clustermap[clustermap_bucket] = e;          \
+                            }                                               \
+                            entries[e].size++;                              \
+                            break;                                          \
+                        }                                                   \
+                                                                            \
+                        if ((e == UINT32_MAX) || (!entries[e].cluster)) break; \
+                                                                            \
+                        zarray_t *cluster = entries[e].cluster;             \
+                        struct pt *p = ((struct pt *) cluster->data) + cluster->size++; \
+                        p->x = 2*x + dx;                                    \
+                        p->y = 2*y + dy;                                    \
+                        p->theta = 0;                                       \
+                        p->gx = dx*((int) v1-v0);                           \
+                        p->gy = dy*((int) v1-v0);                           \
+                        break;                                              \
+                    }                                                       \
+                }
 
-            // do 4 connectivity. NB: Arguments must be [-1, 1] or we'll overflow .gx, .gy
-            DO_CONN(1, 0);
-            DO_CONN(0, 1);
+                // do 4 connectivity. NB: Arguments must be [-1, 1] or we'll overflow .gx, .gy
+                DO_CONN(1, 0);
+                DO_CONN(0, 1);
 
 #ifdef IMLIB_ENABLE_FINE_APRILTAGS
-            // do 8 connectivity
-            DO_CONN(-1, 1);
-            DO_CONN(1, 1);
+                // do 8 connectivity
+                DO_CONN(-1, 1);
+                DO_CONN(1, 1);
 #endif
+            }
         }
-    }
-#undef DO_CONN
 
-    ////////////////////////////////////////////////////////
-    // step 3. process each connected component.
-    zarray_t *clusters = zarray_create_fail_ok(sizeof(zarray_t*)); //, uint32_zarray_hash_size(clustermap));
-    if (clusters) {
-        for (int i = 0; i < nclustermap; i++) {
+        if (!pass) {
+            // Only clusters that step 3 would keep get memory. A cluster should contain only
+            // boundary points around the tag, it cannot be bigger than the whole screen. (Reject
+            // large connected blobs that will be prohibitively slow to fit quads to.) A typical
+            // point along an edge is added three times (because it has 3 neighbors). The maximum
+            // perimeter is 2w+2h.
+            int nclusters = 0;
+            for (uint32_t e = 0; e < nentries_used; e++) {
+                if ((entries[e].size >= td->qtp.min_cluster_pixels) && (entries[e].size <= 3*(2*w+2*h))) {
+                    nclusters++;
+                }
+            }
 
-            for (struct uint32_zarray_entry *entry = clustermap[i]; entry; entry = entry->next) {
-                // XXX reject clusters here?
-                zarray_add_fail_ok(clusters, &entry->cluster);
+            clusters = zarray_create_fail_ok(sizeof(zarray_t*));
+            if (!clusters) break;
+
+            clusters->data = umm_malloc(imax(nclusters, 1) * sizeof(zarray_t*));
+            if (!clusters->data) {
+                free(clusters);
+                clusters = NULL;
+                break;
             }
-        }
-    }
+            clusters->alloc = imax(nclusters, 1);
 
+            for (uint32_t e = 0; e < nentries_used; e++) {
+                if ((entries[e].size < td->qtp.min_cluster_pixels) || (entries[e].size > 3*(2*w+2*h))) {
+                    continue;
+                }
 
-    int sz = clusters ? zarray_size(clusters) : 0;
+                zarray_t *cluster = zarray_create_fail_ok(sizeof(struct pt));
+                if (!cluster) continue;
 
-    if (1) {
-      for (int i = 0; i < nclustermap; i++) {
-        struct uint32_zarray_entry *entry = clustermap[i];
-        while (entry) {
-          // free any leaked cluster (zarray_add_fail_ok)
-          bool leaked = true;
-          for (int j = 0; j < sz && leaked; j++) {
-              zarray_t *cluster;
-              zarray_get(clusters, j, &cluster);
-              leaked &= entry->cluster != cluster;
-          }
-          if (leaked) free(entry->cluster);
-          struct uint32_zarray_entry *tmp = entry->next;
-          free(entry);
-          entry = tmp;
+                cluster->data = umm_malloc(entries[e].size * sizeof(struct pt));
+                if (!cluster->data) {
+                    free(cluster);
+                    continue;
+                }
+                cluster->alloc = entries[e].size;
+
+                entries[e].cluster = cluster;
+                zarray_add(clusters, &cluster);
+            }
         }
-      }
-      fb_free(); // clustermap
     }
+#undef DO_CONN
+
+    fb_free(); // entries
+    fb_free(); // clustermap
+
+    ////////////////////////////////////////////////////////
+    // step 3. process each connected component.
+    int sz = clusters ? zarray_size(clusters) : 0;
 
     unionfind_destroy();
 
@@ -11061,6 +11101,7 @@ apriltag_detector_t *apriltag_detector_create()
 
     td->tag_families = zarray_create(sizeof(apriltag_family_t*));
 
+    td->quad_decimate = 1;
     td->refine_edges = 1;
     td->refine_pose = 0;
     td->refine_decode = 0;
@@ -11531,7 +11572,7 @@ static void refine_edges(apriltag_detector_t *td, image_u8_t *im_orig, struct qu
             // search on another pixel in the first place. Likewise,
             // for very small tags, we don't want the range to be too
             // big.
-            float range = 1.0 + 1;
+            float range = td->quad_decimate + 1;
 
             // XXX tunable step size.
             for (float n = -range; n <= range; n +=  0.25) {
@@ -11664,8 +11705,45 @@ zarray_t *apriltag_detector_detect(apriltag_detector_t *td, image_u8_t *im_orig)
     // Step 1. Detect quads according to requested image decimation
     // and blurring parameters.
 
+    image_u8_t *quad_im = im_orig;
+    image_u8_t im_decimate;
+
+    if (td->quad_decimate > 1) {
+        int factor = td->quad_decimate;
+        im_decimate.width = im_orig->width / factor;
+        im_decimate.height = im_orig->height / factor;
+        im_decimate.stride = im_decimate.width;
+        im_decimate.buf = fb_alloc(im_decimate.width * im_decimate.height, FB_ALLOC_NO_HINT);
+
+        for (int y = 0; y < im_decimate.height; y++) {
+            uint8_t *src_row = im_orig->buf + (y * factor * im_orig->stride);
+            uint8_t *dst_row = im_decimate.buf + (y * im_decimate.stride);
+            for (int x = 0; x < im_decimate.width; x++) {
+                dst_row[x] = src_row[x * factor];
+            }
+        }
+
+        quad_im = &im_decimate;
+    }
+
 //    zarray_t *quads = apriltag_quad_gradient(td, im_orig);
-    zarray_t *quads = apriltag_quad_thresh(td, im_orig, false);
+    zarray_t *quads = apriltag_quad_thresh(td, quad_im, false);
+
+    // adjust centers of pixels so that they correspond to the
+    // original full-resolution image.
+    if (quad_im != im_orig) {
+        fb_free(); // im_decimate.buf
+
+        for (int i = 0; i < zarray_size(quads); i++) {
+            struct quad *q;
+            zarray_get_volatile(quads, i, &q);
+
+            for (int j = 0; j < 4; j++) {
+                q->p[j][0] *= td->quad_decimate;
+                q->p[j][1] *= td->quad_decimate;
+            }
+        }
+    }
 
     zarray_t *detections = zarray_create(sizeof(apriltag_detection_t*));
 
@@ -11893,17 +11971,22 @@ void apriltag_detections_destroy(zarray_t *detections)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void imlib_find_apriltags(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_families_t families,
-                          float fx, float fy, float cx, float cy)
+// Appends the tags found in roi to out, cx/cy are relative to roi.
+void imlib_find_apriltags_roi(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_families_t families,
+                              float fx, float fy, float cx, float cy, int decimate, bool refine_edges)
 {
     // Frame Buffer Memory Usage...
     // -> GRAYSCALE Input Image = w*h*1
-    // -> GRAYSCALE Threhsolded Image = w*h*1
-    // -> UnionFind = w*h*2 (+w*h*1 for hash table)
+    // -> GRAYSCALE Decimated Image = (w/d)*(h/d)*1 (only when decimating)
+    // -> GRAYSCALE Threhsolded Image = (w/d)*(h/d)*1
+    // -> UnionFind = (w/d)*(h/d)*2 (+(w/d)*(h/d)*1 for hash table)
     size_t resolution = roi->w * roi->h;
-    size_t fb_alloc_need = resolution * (1 + 1 + 2 + 1); // read above...
+    size_t quad_resolution = (roi->w / decimate) * (roi->h / decimate);
+    size_t fb_alloc_need = resolution + (quad_resolution * ((decimate > 1) + 1 + 2 + 1)); // read above...
     umm_init_x(((fb_avail() - fb_alloc_need) / resolution) * resolution);
     apriltag_detector_t *td = apriltag_detector_create();
+    td->quad_decimate = decimate;
+    td->refine_edges = refine_edges;
 
     if (families & TAG16H5) {
         apriltag_detector_add_family(td, (apriltag_family_t *) &tag16h5);
@@ -11972,7 +12055,6 @@ void imlib_find_apriltags(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_
     }
 
     zarray_t *detections = apriltag_detector_detect(td, &im);
-    list_init(out, sizeof(find_apriltags_list_lnk_data_t));
 
     for (int i = 0, j = zarray_size(detections); i < j; i++) {
         apriltag_detection_t *det;
@@ -12050,9 +12132,82 @@ void imlib_find_apriltags(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_
     fb_free(); // umm_init_x();
 }
 
+// Tag bounding boxes of the last call, used to search only around them in the next frames.
+static struct {
+    rectangle_t roi;
+    rectangle_t rects[IMLIB_APRILTAGS_TRACK_MAX];
+    int rects_len;
+    int frames; // since the last full scan
+} apriltags_track;
+
+void imlib_find_apriltags(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_families_t families,
+                          float fx, float fy, float cx, float cy, int decimate, bool refine_edges, int track)
+{
+    OMV_PROF_SCOPE("imlib_find_apriltags");
+    list_init(out, sizeof(find_apriltags_list_lnk_data_t));
+
+    if (track && apriltags_track.rects_len && (apriltags_track.frames < track)
+    && rectangle_equal_fast(&apriltags_track.roi, roi)) {
+        // Grow each box by half its size so a tag moving between frames stays inside it, then
+        // merge the windows that overlap so no tag is decoded twice.
+        rectangle_t windows[IMLIB_APRILTAGS_TRACK_MAX];
+        int windows_len = 0;
+
+        for (int i = 0; i < apriltags_track.rects_len; i++) {
+            rectangle_t *r = &apriltags_track.rects[i];
+            int margin = (IM_MAX(r->w, r->h) / 2) + 4;
+            rectangle_t window;
+            rectangle_init(&window, r->x - margin, r->y - margin, r->w + (margin * 2), r->h + (margin * 2));
+            rectangle_intersected(&window, roi);
+
+            if (((window.w / decimate) < 4) || ((window.h / decimate) < 4)) {
+                continue;
+            }
+
+            for (int j = 0; j < windows_len; ) {
+                if (rectangle_overlap(&window, &windows[j])) {
+                    rectangle_united(&window, &windows[j]);
+                    windows[j] = windows[--windows_len];
+                    j = 0; // The bigger window may overlap one already checked.
+                } else {
+                    j++;
+                }
+            }
+
+            windows[windows_len++] = window;
+        }
+
+        for (int i = 0; i < windows_len; i++) {
+            rectangle_t *w = &windows[i];
+            imlib_find_apriltags_roi(out, ptr, w, families, fx, fy,
+                                     cx - (w->x - roi->x), cy - (w->y - roi->y), decimate, refine_edges);
+        }
+
+        apriltags_track.frames += 1;
+    }
+
+    // Nothing tracked (or every tag got lost), scan the whole roi.
+    if (!list_size(out)) {
+        imlib_find_apriltags_roi(out, ptr, roi, families, fx, fy, cx, cy, decimate, refine_edges);
+        apriltags_track.frames = 0;
+    }
+
+    apriltags_track.roi = *roi;
+    apriltags_track.rects_len = 0;
+
+    if (track) {
+        for (list_lnk_t *it = iterator_start_from_head(out); it && (apriltags_track.rects_len < IMLIB_APRILTAGS_TRACK_MAX); it = iterator_next(it)) {
+            find_apriltags_list_lnk_data_t lnk_data;
+            iterator_get(out, it, &lnk_data);
+            apriltags_track.rects[apriltags_track.rects_len++] = lnk_data.rect;
+        }
+    }
+}
+
 #ifdef IMLIB_ENABLE_FIND_RECTS
 void imlib_find_rects(list_t *out, image_t *ptr, rectangle_t *roi, uint32_t threshold)
 {
+    OMV_PROF_SCOPE("imlib_find_rects");
     // Frame Buffer Memory Usage...
     // -> GRAYSCALE Input Image = w*h*1
     // -> GRAYSCALE Threhsolded Image = w*h*1
@@ -12277,21 +12432,23 @@ void imlib_find_rects(list_t *out, image_t *ptr, rectangle_t *roi, uint32_t thre
 
 #ifdef IMLIB_ENABLE_ROTATION_CORR
 // http://jepsonsblog.blogspot.com/2012/11/rotation-in-3d-using-opencvs.html
-void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation, float z_rotation,
-                         float x_translation, float y_translation,
-                         float zoom)
+//
+// Returns the output to source pixel homography or NULL if it is singular. params are {x_rotation,
+// y_rotation, z_rotation, x_translation, y_translation, zoom}.
+static matd_t *imlib_rotation_corr_transform(int img_w, int img_h, const float *params)
 {
-    umm_init_x(4000); // 200 20 byte heap blocks...
+    float x_rotation = params[0], y_rotation = params[1], z_rotation = params[2];
+    float x_translation = params[3], y_translation = params[4], zoom = params[5];
 
     float fov = (M_PI_2 * 2) / 3; // 60 deg FOV
     float fov_2 = fov / 2.0;
-    float d = fast_sqrtf((img->w * img->w) + (img->h * img->h));
+    float d = fast_sqrtf((img_w * img_w) + (img_h * img_h));
     float h = d / (2.0 * tanf(fov_2));
     float h_z = h * zoom;
 
     matd_t *A1 = matd_create(4, 3);
-    MATD_EL(A1, 0, 0) = 1;  MATD_EL(A1, 0, 1) = 0;  MATD_EL(A1, 0, 2) = -img->w / 2.0;
-    MATD_EL(A1, 1, 0) = 0;  MATD_EL(A1, 1, 1) = 1;  MATD_EL(A1, 1, 2) = -img->h / 2.0;
+    MATD_EL(A1, 0, 0) = 1;  MATD_EL(A1, 0, 1) = 0;  MATD_EL(A1, 0, 2) = -img_w / 2.0;
+    MATD_EL(A1, 1, 0) = 0;  MATD_EL(A1, 1, 1) = 1;  MATD_EL(A1, 1, 2) = -img_h / 2.0;
     MATD_EL(A1, 2, 0) = 0;  MATD_EL(A1, 2, 1) = 0;  MATD_EL(A1, 2, 2) = 0;
     MATD_EL(A1, 3, 0) = 0;  MATD_EL(A1, 3, 1) = 0;  MATD_EL(A1, 3, 2) = 1; // needed for h translation
 
@@ -12322,8 +12479,8 @@ void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation, float
     MATD_EL(T, 3, 0) = 0;   MATD_EL(T, 3, 1) = 0;   MATD_EL(T, 3, 2) = 0;   MATD_EL(T, 3, 3) = 1;
 
     matd_t *A2 = matd_create(3, 4);
-    MATD_EL(A2, 0, 0) = h_z;    MATD_EL(A2, 0, 1) = 0;      MATD_EL(A2, 0, 2) = img->w / 2.0;   MATD_EL(A2, 0, 3) = 0;
-    MATD_EL(A2, 1, 0) = 0;      MATD_EL(A2, 1, 1) = h_z;    MATD_EL(A2, 1, 2) = img->h / 2.0;   MATD_EL(A2, 1, 3) = 0;
+    MATD_EL(A2, 0, 0) = h_z;    MATD_EL(A2, 0, 1) = 0;      MATD_EL(A2, 0, 2) = img_w / 2.0;   MATD_EL(A2, 0, 3) = 0;
+    MATD_EL(A2, 1, 0) = 0;      MATD_EL(A2, 1, 1) = h_z;    MATD_EL(A2, 1, 2) = img_h / 2.0;   MATD_EL(A2, 1, 3) = 0;
     MATD_EL(A2, 2, 0) = 0;      MATD_EL(A2, 2, 1) = 0;      MATD_EL(A2, 2, 2) = 1;              MATD_EL(A2, 2, 3) = 0;
 
     matd_t *T1 = matd_op("M*M", R, A1);
@@ -12331,6 +12488,60 @@ void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation, float
     matd_t *T3 = matd_op("M*M", A2, T2);
     matd_t *T4 = matd_inverse(T3);
 
+    matd_destroy(T3);
+    matd_destroy(T2);
+    matd_destroy(T1);
+    matd_destroy(A2);
+    matd_destroy(T);
+    matd_destroy(R);
+    matd_destroy(RZ);
+    matd_destroy(RY);
+    matd_destroy(RX);
+    matd_destroy(A1);
+
+    return T4;
+}
+
+// Remap table entry of output pixel (x, y).
+static inline uint32_t imlib_rotation_corr_entry(matd_t *T4, int x, int y, int w, int h)
+{
+    float sourceX, sourceY; homography_project(T4, x, y, &sourceX, &sourceY);
+    int sourceX2 = round(sourceX);
+    int sourceY2 = round(sourceY);
+
+    if ((0 <= sourceX2) && (sourceX2 < w) && (0 <= sourceY2) && (sourceY2 < h)) {
+        return IMLIB_REMAP_ENTRY(sourceX2, sourceY2);
+    }
+
+    return IMLIB_REMAP_NONE;
+}
+
+static void imlib_rotation_corr_fill(uint32_t *table, int w, int h, const float *params)
+{
+    matd_t *T4 = imlib_rotation_corr_transform(w, h, params);
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            *(table++) = T4 ? imlib_rotation_corr_entry(T4, x, y, w, h) : IMLIB_REMAP_NONE;
+        }
+    }
+
+    if (T4) matd_destroy(T4);
+}
+
+// The source pixels are looked up in a cached remap table (see remap.c) when there is room for
+// one, so the homography only runs again when the size or the parameters change.
+void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation, float z_rotation,
+                         float x_translation, float y_translation,
+                         float zoom)
+{
+    OMV_PROF_SCOPE("imlib_rotation_corr");
+    umm_init_x(4000); // 200 20 byte heap blocks...
+
+    float params[6] = {x_rotation, y_rotation, z_rotation, x_translation, y_translation, zoom};
+    const uint32_t *table = imlib_remap_table(IMLIB_REMAP_ROTATION_CORR, img->w, img->h, params, 6, imlib_rotation_corr_fill);
+    matd_t *T4 = table ? NULL : imlib_rotation_corr_transform(img->w, img->h, params);
+
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
             // Create a temp copy of the image to pull pixels from.
@@ -12338,14 +12549,14 @@ void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation, float
             memcpy(tmp, img->data, ((img->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * img->h);
             memset(img->data, 0, ((img->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * img->h);
 
-            if (T4) for (int y = 0, yy = img->h; y < yy; y++) {
+            if (table || T4) for (int y = 0, yy = img->h; y < yy; y++) {
                 uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
                 for (int x = 0, xx = img->w; x < xx; x++) {
-                    float sourceX, sourceY; homography_project(T4, x, y, &sourceX, &sourceY);
-                    int sourceX2 = round(sourceX);
-                    int sourceY2 = round(sourceY);
+                    uint32_t entry = table ? table[(img->w * y) + x] : imlib_rotation_corr_entry(T4, x, y, img->w, img->h);
+                    int sourceX2 = IMLIB_REMAP_X(entry);
+                    int sourceY2 = IMLIB_REMAP_Y(entry);
 
-                    if ((0 <= sourceX2) && (sourceX2 < img->w) && (0 <= sourceY2) && (sourceY2 < img->h)) {
+                    if (entry != IMLIB_REMAP_NONE) {
                         uint32_t *ptr = tmp + (((img->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * sourceY2);
                         int pixel = IMAGE_GET_BINARY_PIXEL_FAST(ptr, sourceX2);
                         IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x, pixel);
@@ -12362,14 +12573,14 @@ void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation, float
             memcpy(tmp, img->data, img->w * img->h * sizeof(uint8_t));
             memset(img->data, 0, img->w * img->h * sizeof(uint8_t));
 
-            if (T4) for (int y = 0, yy = img->h; y < yy; y++) {
+            if (table || T4) for (int y = 0, yy = img->h; y < yy; y++) {
                 uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
                 for (int x = 0, xx = img->w; x < xx; x++) {
-                    float sourceX, sourceY; homography_project(T4, x, y, &sourceX, &sourceY);
-                    int sourceX2 = round(sourceX);
-                    int sourceY2 = round(sourceY);
+                    uint32_t entry = table ? table[(img->w * y) + x] : imlib_rotation_corr_entry(T4, x, y, img->w, img->h);
+                    int sourceX2 = IMLIB_REMAP_X(entry);
+                    int sourceY2 = IMLIB_REMAP_Y(entry);
 
-                    if ((0 <= sourceX2) && (sourceX2 < img->w) && (0 <= sourceY2) && (sourceY2 < img->h)) {
+                    if (entry != IMLIB_REMAP_NONE) {
                         uint8_t *ptr = tmp + (img->w * sourceY2);
                         int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(ptr, sourceX2);
                         IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row_ptr, x, pixel);
@@ -12386,14 +12597,14 @@ void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation, float
             memcpy(tmp, img->data, img->w * img->h * sizeof(uint16_t));
             memset(img->data, 0, img->w * img->h * sizeof(uint16_t));
 
-            if (T4) for (int y = 0, yy = img->h; y < yy; y++) {
+            if (table || T4) for (int y = 0, yy = img->h; y < yy; y++) {
                 uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
                 for (int x = 0, xx = img->w; x < xx; x++) {
-                    float sourceX, sourceY; homography_project(T4, x, y, &sourceX, &sourceY);
-                    int sourceX2 = round(sourceX);
-                    int sourceY2 = round(sourceY);
+                    uint32_t entry = table ? table[(img->w * y) + x] : imlib_rotation_corr_entry(T4, x, y, img->w, img->h);
+                    int sourceX2 = IMLIB_REMAP_X(entry);
+                    int sourceY2 = IMLIB_REMAP_Y(entry);
 
-                    if ((0 <= sourceX2) && (sourceX2 < img->w) && (0 <= sourceY2) && (sourceY2 < img->h)) {
+                    if (entry != IMLIB_REMAP_NONE) {
                         uint16_t *ptr = tmp + (img->w * sourceY2);
                         int pixel = IMAGE_GET_RGB565_PIXEL_FAST(ptr, sourceX2);
                         IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x, pixel);
@@ -12410,16 +12621,6 @@ void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation, float
     }
 
     if (T4) matd_destroy(T4);
-    matd_destroy(T3);
-    matd_destroy(T2);
-    matd_destroy(T1);
-    matd_destroy(A2);
-    matd_destroy(T);
-    matd_destroy(R);
-    matd_destroy(RZ);
-    matd_destroy(RY);
-    matd_destroy(RX);
-    matd_destroy(A1);
 
     fb_free(); // umm_init_x();
 }
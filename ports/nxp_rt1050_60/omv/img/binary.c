@@ -6,52 +6,101 @@
 #include "imlib.h"
 
 #ifdef IMLIB_ENABLE_BINARY_OPS
+// The merge of the thresholded pixels t into the old pixels under the mask m, as bits or lanes.
+static inline __attribute__((always_inline)) uint32_t binary_merge(uint32_t t, uint32_t m, uint32_t old, bool zero)
+{
+    return zero ? (old & ~(t & m)) : ((t & m) | (old & ~m));
+}
+
+// The thresholded pixels of a row are packed 32 to a word as they are tested and merged into
+// the output a word at a time, of 32 binary, 4 grayscale or 2 RGB565 pixels, with the mask
+// row read as bits. The words of an output row are written after the input pixels under them
+// were read, an output row is never longer than its input row, so in place to_bitmap works.
 void imlib_binary(image_t *out, image_t *img, list_t *thresholds, bool invert, bool zero, image_t *mask)
 {
-    image_t bmp;
-    bmp.w = img->w;
-    bmp.h = img->h;
-    bmp.bpp = IMAGE_BPP_BINARY;
-    bmp.data = fb_alloc0(image_size(&bmp), FB_ALLOC_NO_HINT);
-
-    for (list_lnk_t *it = iterator_start_from_head(thresholds); it; it = iterator_next(it)) {
-        color_thresholds_list_lnk_data_t lnk_data;
-        iterator_get(thresholds, it, &lnk_data);
-        switch(img->bpp) {
+    OMV_PROF_SCOPE("imlib_binary");
+    int w = img->w, words = (w + UINT32_T_MASK) >> UINT32_T_SHIFT;
+    uint32_t *bits = fb_alloc(words * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+    uint32_t *mask_buf = mask ? fb_alloc(words * sizeof(uint32_t), FB_ALLOC_NO_HINT) : NULL;
+    // The last word also holds the padding of the row.
+    uint32_t tail = (w & UINT32_T_MASK) ? ((1U << (w & UINT32_T_MASK)) - 1) : 0xFFFFFFFF;
+
+    const uint8_t *lut = (img->bpp == IMAGE_BPP_RGB565) ? imlib_thresholds_lut(thresholds, invert) : NULL;
+    uint8_t *gray_lut = NULL;
+    bool binary_hits[2] = {false, false};
+
+    if (img->bpp == IMAGE_BPP_GRAYSCALE) {
+        // One table load per pixel covers every threshold, as the RGB565 table.
+        gray_lut = fb_alloc0(COLOR_GRAYSCALE_MAX + 1, FB_ALLOC_NO_HINT);
+        for (list_lnk_t *it = iterator_start_from_head(thresholds); it; it = iterator_next(it)) {
+            color_thresholds_list_lnk_data_t lnk_data;
+            iterator_get(thresholds, it, &lnk_data);
+            for (int i = COLOR_GRAYSCALE_MIN; i <= COLOR_GRAYSCALE_MAX; i++) {
+                gray_lut[i] |= COLOR_THRESHOLD_GRAYSCALE(i, &lnk_data, invert);
+            }
+        }
+    } else if (img->bpp == IMAGE_BPP_BINARY) {
+        for (list_lnk_t *it = iterator_start_from_head(thresholds); it; it = iterator_next(it)) {
+            color_thresholds_list_lnk_data_t lnk_data;
+            iterator_get(thresholds, it, &lnk_data);
+            binary_hits[0] |= COLOR_THRESHOLD_BINARY(0, &lnk_data, invert);
+            binary_hits[1] |= COLOR_THRESHOLD_BINARY(1, &lnk_data, invert);
+        }
+    } else if ((img->bpp == IMAGE_BPP_RGB565) && (!lut)) {
+        #if defined(IMLIB_ENABLE_LAB_LUT)
+        OverlaySwitch(OVLY_LAB_TAB);
+        #endif
+    }
+
+    // The pixels of a thresholded or masked out word as the output's lanes.
+    uint32_t one = 0xFFFFFFFF, low = 0;
+    if (out->bpp == IMAGE_BPP_RGB565) {
+        one = COLOR_BINARY_TO_RGB565(1) * 0x00010001;
+        low = COLOR_BINARY_TO_RGB565(0) * 0x00010001;
+    }
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        switch (img->bpp) {
             case IMAGE_BPP_BINARY: {
-                for (int y = 0, yy = img->h; y < yy; y++) {
-                    uint32_t *old_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                    uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                    for (int x = 0, xx = img->w; x < xx; x++) {
-                        if (COLOR_THRESHOLD_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(old_row_ptr, x), &lnk_data, invert)) {
-                            IMAGE_SET_BINARY_PIXEL_FAST(bmp_row_ptr, x);
-                        }
-                    }
+                uint32_t *old_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+                uint32_t hits_1 = binary_hits[1] ? 0xFFFFFFFF : 0, hits_0 = binary_hits[0] ? 0xFFFFFFFF : 0;
+                for (int i = 0; i < words; i++) {
+                    bits[i] = (old_row_ptr[i] & hits_1) | (~old_row_ptr[i] & hits_0);
                 }
                 break;
             }
             case IMAGE_BPP_GRAYSCALE: {
-                for (int y = 0, yy = img->h; y < yy; y++) {
-                    uint8_t *old_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                    uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                    for (int x = 0, xx = img->w; x < xx; x++) {
-                        if (COLOR_THRESHOLD_GRAYSCALE(IMAGE_GET_GRAYSCALE_PIXEL_FAST(old_row_ptr, x), &lnk_data, invert)) {
-                            IMAGE_SET_BINARY_PIXEL_FAST(bmp_row_ptr, x);
-                        }
+                uint8_t *old_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+                for (int i = 0, x = 0; i < words; i++) {
+                    uint32_t word = 0;
+                    for (int b = 0, bb = IM_MIN(w - x, 32); b < bb; b++, x++) {
+                        word |= ((uint32_t) gray_lut[old_row_ptr[x]]) << b;
                     }
+                    bits[i] = word;
                 }
                 break;
             }
             case IMAGE_BPP_RGB565: {
-				#if defined(IMLIB_ENABLE_LAB_LUT)
-				OverlaySwitch(OVLY_LAB_TAB);
-				#endif
-                for (int y = 0, yy = img->h; y < yy; y++) {
-                    uint16_t *old_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                    uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                    for (int x = 0, xx = img->w; x < xx; x++) {
-                        if (COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(old_row_ptr, x), &lnk_data, invert)) {
-                            IMAGE_SET_BINARY_PIXEL_FAST(bmp_row_ptr, x);
+                uint16_t *old_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+                if (lut) {
+                    for (int i = 0, x = 0; i < words; i++) {
+                        uint32_t word = 0;
+                        for (int b = 0, bb = IM_MIN(w - x, 32); b < bb; b++, x++) {
+                            word |= ((uint32_t) (lut[old_row_ptr[x]] != 0)) << b;
+                        }
+                        bits[i] = word;
+                    }
+                } else {
+                    memset(bits, 0, words * sizeof(uint32_t));
+                    for (list_lnk_t *it = iterator_start_from_head(thresholds); it; it = iterator_next(it)) {
+                        color_thresholds_list_lnk_data_t lnk_data;
+                        iterator_get(thresholds, it, &lnk_data);
+                        for (int i = 0, x = 0; i < words; i++) {
+                            uint32_t word = 0;
+                            for (int b = 0, bb = IM_MIN(w - x, 32); b < bb; b++, x++) {
+                                word |= ((uint32_t) COLOR_THRESHOLD_RGB565(old_row_ptr[x], &lnk_data, invert)) << b;
+                            }
+                            bits[i] |= word;
                         }
                     }
                 }
@@ -61,146 +110,69 @@ void imlib_binary(image_t *out, image_t *img, list_t *thresholds, bool invert, b
                 break;
             }
         }
-    }
 
-        switch(img->bpp) {
+        const uint32_t *mask_row_ptr = mask ? image_get_mask_row(mask, w, y, mask_buf) : NULL;
+
+        switch (out->bpp) {
             case IMAGE_BPP_BINARY: {
-                if (!zero) {
-                    for (int y = 0, yy = img->h; y < yy; y++) {
-                    uint32_t *old_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                    uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                        uint32_t *out_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y);
-                        for (int x = 0, xx = img->w; x < xx; x++) {
-                        int pixel = ((!mask) || image_get_mask_pixel(mask, x, y))
-                            ? IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x)
-                            : IMAGE_GET_BINARY_PIXEL_FAST(old_row_ptr, x);
-                        IMAGE_PUT_BINARY_PIXEL_FAST(out_row_ptr, x, pixel);
-                        }
-                    }
-                } else {
-                    for (int y = 0, yy = img->h; y < yy; y++) {
-                    uint32_t *old_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                    uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                        uint32_t *out_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y);
-                        for (int x = 0, xx = img->w; x < xx; x++) {
-                        int pixel = IMAGE_GET_BINARY_PIXEL_FAST(old_row_ptr, x);
-                        if (((!mask) || image_get_mask_pixel(mask, x, y))
-                            && IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x)) pixel = 0;
-                        IMAGE_PUT_BINARY_PIXEL_FAST(out_row_ptr, x, pixel);
+                uint32_t *out_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y);
+                uint32_t out_padding = out_row_ptr[words - 1] & ~tail;
+                for (int i = 0, x = 0; i < words; i++, x += 32) {
+                    uint32_t m = mask_row_ptr ? mask_row_ptr[i] : 0xFFFFFFFF;
+                    uint32_t old = 0;
+                    // The output is only the thresholded pixels when nothing of the old is kept.
+                    if (zero || (m != 0xFFFFFFFF)) {
+                        if (img->bpp == IMAGE_BPP_BINARY) {
+                            old = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y)[i];
+                        } else if (img->bpp == IMAGE_BPP_GRAYSCALE) {
+                            uint8_t *old_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+                            for (int b = 0, bb = IM_MIN(w - x, 32); b < bb; b++) {
+                                old |= ((uint32_t) COLOR_GRAYSCALE_TO_BINARY(old_row_ptr[x + b])) << b;
+                            }
+                        } else {
+                            uint16_t *old_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+                            for (int b = 0, bb = IM_MIN(w - x, 32); b < bb; b++) {
+                                old |= ((uint32_t) COLOR_RGB565_TO_BINARY(old_row_ptr[x + b])) << b;
+                            }
                         }
                     }
+                    out_row_ptr[i] = binary_merge(bits[i], m, old, zero);
                 }
+                out_row_ptr[words - 1] = (out_row_ptr[words - 1] & tail) | out_padding;
                 break;
             }
             case IMAGE_BPP_GRAYSCALE: {
-                if (out->bpp == IMAGE_BPP_BINARY) {
-                    if (!zero) {
-                        for (int y = 0, yy = img->h; y < yy; y++) {
-                        uint8_t *old_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                        uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                            uint32_t *out_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y);
-                            for (int x = 0, xx = img->w; x < xx; x++) {
-                            int pixel = ((!mask) || image_get_mask_pixel(mask, x, y))
-                                ? IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x)
-                                : COLOR_GRAYSCALE_TO_BINARY(IMAGE_GET_GRAYSCALE_PIXEL_FAST(old_row_ptr, x));
-                            IMAGE_PUT_BINARY_PIXEL_FAST(out_row_ptr, x, pixel);
-                            }
-                        }
-                    } else {
-                        for (int y = 0, yy = img->h; y < yy; y++) {
-                        uint8_t *old_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                        uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                            uint32_t *out_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y);
-                            for (int x = 0, xx = img->w; x < xx; x++) {
-                            int pixel = COLOR_GRAYSCALE_TO_BINARY(IMAGE_GET_GRAYSCALE_PIXEL_FAST(old_row_ptr, x));
-                            if (((!mask) || image_get_mask_pixel(mask, x, y))
-                                && IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x)) pixel = 0;
-                            IMAGE_PUT_BINARY_PIXEL_FAST(out_row_ptr, x, pixel);
-                            }
-                        }
-                    }
-                } else {
-                    if (!zero) {
-                        for (int y = 0, yy = img->h; y < yy; y++) {
-                        uint8_t *old_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                        uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                        uint8_t *out_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(out, y);
-                            for (int x = 0, xx = img->w; x < xx; x++) {
-                            int pixel = ((!mask) || image_get_mask_pixel(mask, x, y))
-                                ? COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x))
-                                : IMAGE_GET_GRAYSCALE_PIXEL_FAST(old_row_ptr, x);
-                            IMAGE_PUT_GRAYSCALE_PIXEL_FAST(out_row_ptr, x, pixel);
-                            }
-                        }
-                    } else {
-                        for (int y = 0, yy = img->h; y < yy; y++) {
-                        uint8_t *old_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                        uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                        uint8_t *out_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(out, y);
-                            for (int x = 0, xx = img->w; x < xx; x++) {
-                            int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(old_row_ptr, x);
-                            if (((!mask) || image_get_mask_pixel(mask, x, y))
-                                && IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x)) pixel = 0;
-                            IMAGE_PUT_GRAYSCALE_PIXEL_FAST(out_row_ptr, x, pixel);
-                            }
-                        }
-                    }
+                uint8_t *old_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+                uint8_t *out_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(out, y);
+                int x = 0;
+                for (; (x + 4) <= w; x += 4) {
+                    int shift = x & UINT32_T_MASK;
+                    uint32_t t = IMAGE_MASK_BITS_TO_BYTE_LANES(bits[x >> UINT32_T_SHIFT] >> shift);
+                    uint32_t m = mask_row_ptr ? IMAGE_MASK_BITS_TO_BYTE_LANES(mask_row_ptr[x >> UINT32_T_SHIFT] >> shift) : 0xFFFFFFFF;
+                    __UNALIGNED_UINT32_WRITE(out_row_ptr + x, binary_merge(t, m, __UNALIGNED_UINT32_READ(old_row_ptr + x), zero));
+                }
+                for (; x < w; x++) {
+                    uint32_t t = IMAGE_GET_BINARY_PIXEL_FAST(bits, x) ? 0xFF : 0;
+                    uint32_t m = ((!mask_row_ptr) || IMAGE_GET_BINARY_PIXEL_FAST(mask_row_ptr, x)) ? 0xFF : 0;
+                    out_row_ptr[x] = binary_merge(t, m, old_row_ptr[x], zero);
                 }
                 break;
             }
             case IMAGE_BPP_RGB565: {
-                if (out->bpp == IMAGE_BPP_BINARY) {
-                    if (!zero) {
-                        for (int y = 0, yy = img->h; y < yy; y++) {
-                        uint16_t *old_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                        uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                            uint32_t *out_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y);
-                            for (int x = 0, xx = img->w; x < xx; x++) {
-                            int pixel = ((!mask) || image_get_mask_pixel(mask, x, y))
-                                ? IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x)
-                                : COLOR_RGB565_TO_BINARY(IMAGE_GET_RGB565_PIXEL_FAST(old_row_ptr, x));
-                            IMAGE_PUT_BINARY_PIXEL_FAST(out_row_ptr, x, pixel);
-                            }
-                        }
-                    } else {
-                        for (int y = 0, yy = img->h; y < yy; y++) {
-                        uint16_t *old_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                        uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                            uint32_t *out_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y);
-                            for (int x = 0, xx = img->w; x < xx; x++) {
-                            int pixel = COLOR_RGB565_TO_BINARY(IMAGE_GET_RGB565_PIXEL_FAST(old_row_ptr, x));
-                            if (((!mask) || image_get_mask_pixel(mask, x, y))
-                                && IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x)) pixel = 0;
-                            IMAGE_PUT_BINARY_PIXEL_FAST(out_row_ptr, x, pixel);
-                                }
-                            }
-                        }
-                } else {
-                    if (!zero) {
-                        for (int y = 0, yy = img->h; y < yy; y++) {
-                        uint16_t *old_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                        uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                            uint16_t *out_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(out, y);
-                            for (int x = 0, xx = img->w; x < xx; x++) {
-                            int pixel = ((!mask) || image_get_mask_pixel(mask, x, y))
-                                ? COLOR_BINARY_TO_RGB565(IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x))
-                                : IMAGE_GET_RGB565_PIXEL_FAST(old_row_ptr, x);
-                            IMAGE_PUT_RGB565_PIXEL_FAST(out_row_ptr, x, pixel);
-                            }
-                        }
-                    } else {
-                        for (int y = 0, yy = img->h; y < yy; y++) {
-                        uint16_t *old_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                        uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                            uint16_t *out_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(out, y);
-                            for (int x = 0, xx = img->w; x < xx; x++) {
-                            int pixel = IMAGE_GET_RGB565_PIXEL_FAST(old_row_ptr, x);
-                            if (((!mask) || image_get_mask_pixel(mask, x, y))
-                                && IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x)) pixel = 0;
-                            IMAGE_PUT_RGB565_PIXEL_FAST(out_row_ptr, x, pixel);
-                            }
-                        }
-                    }
+                uint16_t *old_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+                uint16_t *out_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(out, y);
+                int x = 0;
+                for (; (x + 2) <= w; x += 2) {
+                    int shift = x & UINT32_T_MASK;
+                    uint32_t t = IMAGE_MASK_BITS_TO_HALFWORD_LANES(bits[x >> UINT32_T_SHIFT] >> shift);
+                    uint32_t m = mask_row_ptr ? IMAGE_MASK_BITS_TO_HALFWORD_LANES(mask_row_ptr[x >> UINT32_T_SHIFT] >> shift) : 0xFFFFFFFF;
+                    t = (t & one) | (~t & low);
+                    __UNALIGNED_UINT32_WRITE(out_row_ptr + x, binary_merge(t, m, __UNALIGNED_UINT32_READ(old_row_ptr + x), zero));
+                }
+                for (; x < w; x++) {
+                    uint32_t t = IMAGE_GET_BINARY_PIXEL_FAST(bits, x) ? one : low;
+                    uint32_t m = ((!mask_row_ptr) || IMAGE_GET_BINARY_PIXEL_FAST(mask_row_ptr, x)) ? 0xFFFF : 0;
+                    out_row_ptr[x] = binary_merge(t, m, old_row_ptr[x], zero);
                 }
                 break;
             }
@@ -208,12 +180,20 @@ void imlib_binary(image_t *out, image_t *img, list_t *thresholds, bool invert, b
                 break;
             }
         }
+    }
 
-    fb_free();
+    if (gray_lut) {
+        fb_free(); // gray_lut
+    }
+    if (mask_buf) {
+        fb_free(); // mask_buf
+    }
+    fb_free(); // bits
 }
 
 void imlib_invert(image_t *img)
 {
+    OMV_PROF_SCOPE("imlib_invert");
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
             for (uint32_t *start = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, 0),
@@ -245,6 +225,110 @@ void imlib_invert(image_t *img)
     }
 }
 
+// Ops on another image or a scalar in memory skip imlib_image_operation(): the ops are
+// bitwise, the same for any bpp, so all pixels of an unmasked image are one run of words. A
+// masked op runs a row at a time, the bits of the mask row spread to the pixels of a word. As
+// the line ops, nand is a & ~b, nor a | ~b and xnor a ^ ~b.
+typedef enum b_op {
+    B_OP_AND,
+    B_OP_NAND,
+    B_OP_OR,
+    B_OP_NOR,
+    B_OP_XOR,
+    B_OP_XNOR
+} b_op_t;
+
+static inline __attribute__((always_inline)) uint32_t b_op_word(b_op_t op, uint32_t a, uint32_t b)
+{
+    switch (op) {
+        case B_OP_AND: return a & b;
+        case B_OP_NAND: return a & ~b;
+        case B_OP_OR: return a | b;
+        case B_OP_NOR: return a | ~b;
+        case B_OP_XOR: return a ^ b;
+        default: return a ^ ~b;
+    }
+}
+
+// The w pixels of a row at d of which the ones with their bit set in m change.
+static inline __attribute__((always_inline)) void b_op_row(int bpp, uint8_t *d, const uint8_t *s, int s_step,
+                                                           int w, const uint32_t *m, b_op_t op)
+{
+    int x = 0, bytes = 0;
+
+    switch (bpp) {
+        case IMAGE_BPP_BINARY: {
+            for (int i = 0, ii = (w + UINT32_T_MASK) >> UINT32_T_SHIFT; i < ii; i++, d += 4, s += s_step) {
+                uint32_t a = __UNALIGNED_UINT32_READ(d), r = b_op_word(op, a, __UNALIGNED_UINT32_READ(s));
+                __UNALIGNED_UINT32_WRITE(d, (r & m[i]) | (a & ~m[i]));
+            }
+            return;
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            for (; (x + 4) <= w; x += 4, d += 4, s += s_step) {
+                uint32_t a = __UNALIGNED_UINT32_READ(d), r = b_op_word(op, a, __UNALIGNED_UINT32_READ(s));
+                uint32_t lanes = IMAGE_MASK_BITS_TO_BYTE_LANES(m[x >> UINT32_T_SHIFT] >> (x & UINT32_T_MASK));
+                __UNALIGNED_UINT32_WRITE(d, (r & lanes) | (a & ~lanes));
+            }
+            bytes = 1;
+            break;
+        }
+        case IMAGE_BPP_RGB565: {
+            for (; (x + 2) <= w; x += 2, d += 4, s += s_step) {
+                uint32_t a = __UNALIGNED_UINT32_READ(d), r = b_op_word(op, a, __UNALIGNED_UINT32_READ(s));
+                uint32_t lanes = IMAGE_MASK_BITS_TO_HALFWORD_LANES(m[x >> UINT32_T_SHIFT] >> (x & UINT32_T_MASK));
+                __UNALIGNED_UINT32_WRITE(d, (r & lanes) | (a & ~lanes));
+            }
+            bytes = 2;
+            break;
+        }
+        default: {
+            return;
+        }
+    }
+
+    // The last pixels, byte by byte of the other's (or the scalar's) next word.
+    for (int i = 0; x < w; x++) {
+        for (int j = 0; j < bytes; j++, i++, d++) {
+            if (IMAGE_GET_BINARY_PIXEL_FAST(m, x)) {
+                *d = b_op_word(op, *d, s[i]);
+            }
+        }
+    }
+}
+
+static inline __attribute__((always_inline)) void b_op_in_memory(image_t *img, image_t *other, int scalar, image_t *mask, b_op_t op)
+{
+    // A scalar is read as the other image with a step of 0.
+    uint32_t scalar_word = imlib_image_operation_scalar(img, scalar);
+    const uint8_t *s = other ? other->data : ((uint8_t *) &scalar_word);
+    int s_step = other ? sizeof(uint32_t) : 0;
+
+    if (mask) {
+        size_t row_size = (img->bpp == IMAGE_BPP_BINARY) ? IMAGE_BINARY_LINE_LEN_BYTES(img) : (img->w * img->bpp);
+        uint32_t *buf = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img), FB_ALLOC_NO_HINT);
+
+        for (int y = 0, yy = img->h; y < yy; y++, s += other ? row_size : 0) {
+            const uint32_t *m = image_get_mask_row(mask, img->w, y, buf);
+            b_op_row(img->bpp, img->data + (row_size * y), s, s_step, img->w, m, op);
+        }
+
+        fb_free();
+        return;
+    }
+
+    size_t size = image_size(img);
+    uint32_t *d = (uint32_t *) img->data;
+
+    for (size_t n = size / sizeof(uint32_t); n; n--, d++, s += s_step) {
+        *d = b_op_word(op, *d, __UNALIGNED_UINT32_READ(s));
+    }
+
+    for (size_t i = 0, ii = size % sizeof(uint32_t); i < ii; i++) {
+        ((uint8_t *) d)[i] = b_op_word(op, ((uint8_t *) d)[i], s[i]);
+    }
+}
+
 static void imlib_b_and_line_op(image_t *img, int line, void *other, void *data, bool vflipped)
 {
     image_t *mask = (image_t *) data;
@@ -312,6 +396,11 @@ static void imlib_b_and_line_op(image_t *img, int line, void *other, void *data,
 
 void imlib_b_and(image_t *img, const char *path, image_t *other, int scalar, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_b_and");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        b_op_in_memory(img, other, scalar, mask, B_OP_AND);
+        return;
+    }
     imlib_image_operation(img, path, other, scalar, imlib_b_and_line_op, mask);
 }
 
@@ -382,6 +471,11 @@ static void imlib_b_nand_line_op(image_t *img, int line, void *other, void *data
 
 void imlib_b_nand(image_t *img, const char *path, image_t *other, int scalar, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_b_nand");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        b_op_in_memory(img, other, scalar, mask, B_OP_NAND);
+        return;
+    }
     imlib_image_operation(img, path, other, scalar, imlib_b_nand_line_op, mask);
 }
 
@@ -452,6 +546,11 @@ static void imlib_b_or_line_op(image_t *img, int line, void *other, void *data,
 
 void imlib_b_or(image_t *img, const char *path, image_t *other, int scalar, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_b_or");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        b_op_in_memory(img, other, scalar, mask, B_OP_OR);
+        return;
+    }
     imlib_image_operation(img, path, other, scalar, imlib_b_or_line_op, mask);
 }
 
@@ -522,6 +621,11 @@ static void imlib_b_nor_line_op(image_t *img, int line, void *other, void *data,
 
 void imlib_b_nor(image_t *img, const char *path, image_t *other, int scalar, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_b_nor");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        b_op_in_memory(img, other, scalar, mask, B_OP_NOR);
+        return;
+    }
     imlib_image_operation(img, path, other, scalar,imlib_b_nor_line_op,  mask);
 }
 
@@ -592,6 +696,11 @@ static void imlib_b_xor_line_op(image_t *img, int line, void *other, void *data,
 
 void imlib_b_xor(image_t *img, const char *path, image_t *other, int scalar, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_b_xor");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        b_op_in_memory(img, other, scalar, mask, B_OP_XOR);
+        return;
+    }
     imlib_image_operation(img, path, other, scalar, imlib_b_xor_line_op, mask);
 }
 
@@ -662,45 +771,181 @@ static void imlib_b_xnor_line_op(image_t *img, int line, void *other, void *data
 
 void imlib_b_xnor(image_t *img, const char *path, image_t *other, int scalar, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_b_xnor");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        b_op_in_memory(img, other, scalar, mask, B_OP_XNOR);
+        return;
+    }
     imlib_image_operation(img, path, other, scalar, imlib_b_xnor_line_op, mask);
 }
 
+// Adds (d = 1) or removes (d = -1) the binary value of each pixel of row y to the column counts.
+static void imlib_erode_dilate_acc_row(image_t *img, uint16_t *cols, int y, int d)
+{
+    switch(img->bpp) {
+        case IMAGE_BPP_BINARY: {
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                cols[x] += d * IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x);
+            }
+            break;
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                cols[x] += d * COLOR_GRAYSCALE_TO_BINARY(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x));
+            }
+            break;
+        }
+        case IMAGE_BPP_RGB565: {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                cols[x] += d * COLOR_RGB565_TO_BINARY(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+            }
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+// Plain erode (all kernel pixels set) and dilate (any kernel pixel set) of a binary image are
+// an AND / OR of the window, done 32 pixels at a time: first down the rows of the window and
+// then across by shifting the row words. Clamped pixels at the edges repeat a pixel already
+// in the window so they never change the result and are just skipped. Pixels outside the mask
+// keep their value, the mask row is read as bits.
+static void imlib_erode_dilate_binary_words(image_t *img, int ksize, int e_or_d, image_t *mask)
+{
+    int brows = ksize + 1;
+    image_t buf;
+    buf.w = img->w;
+    buf.h = brows;
+    buf.bpp = img->bpp;
+    buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_PREFER_SPEED);
+
+    int words = IMAGE_BINARY_LINE_LEN(img);
+    uint32_t *v_row_ptr = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img), FB_ALLOC_PREFER_SPEED);
+    uint32_t *mask_buf = mask ? fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img), FB_ALLOC_NO_HINT) : NULL;
+    uint32_t fill = e_or_d ? 0 : 0xFFFFFFFF; // Bits past the edges leave the AND / OR as is.
+    uint32_t tail = (img->w & UINT32_T_MASK) ? (0xFFFFFFFF << (img->w & UINT32_T_MASK)) : 0;
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        memcpy(v_row_ptr, IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y), IMAGE_BINARY_LINE_LEN_BYTES(img));
+
+        for (int j = 1; j <= ksize; j++) {
+            uint32_t *t_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, IM_MAX(y - j, 0));
+            uint32_t *b_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, IM_MIN(y + j, (img->h - 1)));
+
+            for (int i = 0; i < words; i++) {
+                v_row_ptr[i] = e_or_d ? (v_row_ptr[i] | t_row_ptr[i] | b_row_ptr[i])
+                                      : (v_row_ptr[i] & t_row_ptr[i] & b_row_ptr[i]);
+            }
+        }
+
+        v_row_ptr[words - 1] = e_or_d ? (v_row_ptr[words - 1] & (~tail)) : (v_row_ptr[words - 1] | tail);
+
+        uint32_t *buf_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows));
+
+        for (int i = 0; i < words; i++) {
+            uint32_t prev = i ? v_row_ptr[i - 1] : fill;
+            uint32_t next = ((i + 1) < words) ? v_row_ptr[i + 1] : fill;
+            uint32_t acc = v_row_ptr[i];
+
+            for (int d = 1; d <= ksize; d++) {
+                uint32_t r = (v_row_ptr[i] >> d) | (next << (UINT32_T_BITS - d)); // Pixel x + d.
+                uint32_t l = (v_row_ptr[i] << d) | (prev >> (UINT32_T_BITS - d)); // Pixel x - d.
+                acc = e_or_d ? (acc | r | l) : (acc & r & l);
+            }
+
+            buf_row_ptr[i] = acc;
+        }
+
+        if (mask) {
+            const uint32_t *mask_row_ptr = image_get_mask_row(mask, img->w, y, mask_buf);
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+            for (int i = 0; i < words; i++) {
+                buf_row_ptr[i] = (buf_row_ptr[i] & mask_row_ptr[i]) | (row_ptr[i] & ~mask_row_ptr[i]);
+            }
+        }
+
+        buf_row_ptr[words - 1] &= ~tail;
+
+        if (y >= ksize) { // Transfer buffer lines...
+            memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, (y - ksize)),
+                   IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
+                   IMAGE_BINARY_LINE_LEN_BYTES(img));
+        }
+    }
+
+    // Copy any remaining lines from the buffer image...
+    for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
+        memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y),
+               IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows)),
+               IMAGE_BINARY_LINE_LEN_BYTES(img));
+    }
+
+    if (mask_buf) {
+        fb_free(); // mask_buf
+    }
+    fb_free(); // v_row_ptr
+    fb_free(); // buf
+}
+
 static void imlib_erode_dilate(image_t *img, int ksize, int threshold, int e_or_d, image_t *mask)
 {
+    if ((img->bpp == IMAGE_BPP_BINARY) && (ksize < UINT32_T_BITS)
+    && (e_or_d ? (threshold == 0) : (threshold == ((((ksize * 2) + 1) * ((ksize * 2) + 1)) - 1)))) {
+        imlib_erode_dilate_binary_words(img, ksize, e_or_d, mask);
+        return;
+    }
+
     int brows = ksize + 1;
     image_t buf;
     buf.w = img->w;
     buf.h = brows;
     buf.bpp = img->bpp;
 
+    // The window sum of a pixel is the sum of the column counts under it. Moving down a row adds
+    // one row to the column counts and drops another, moving across a pixel adds one column count
+    // to the window sum and drops another.
+    uint16_t *cols = fb_alloc(img->w * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
+    memset(cols, 0, img->w * sizeof(uint16_t));
+    uint32_t *mask_buf = mask ? fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img), FB_ALLOC_NO_HINT) : NULL;
+
+    for (int j = -ksize; j <= ksize; j++) {
+        imlib_erode_dilate_acc_row(img, cols, IM_MIN(IM_MAX(j, 0), (img->h - 1)), 1);
+    }
+
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
-            buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
+            buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_PREFER_SPEED);
 
             for (int y = 0, yy = img->h; y < yy; y++) {
                 uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
                 uint32_t *buf_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows));
+                const uint32_t *mask_row_ptr = mask ? image_get_mask_row(mask, img->w, y, mask_buf) : NULL;
+
+                int sum = 0;
+
+                for (int k = -ksize; k <= ksize; k++) {
+                    sum += cols[IM_MIN(IM_MAX(k, 0), (img->w - 1))];
+                }
 
                 for (int x = 0, xx = img->w; x < xx; x++) {
+                    if (x) { // Slide the window sum across...
+                        sum += cols[IM_MIN(x + ksize, (xx - 1))] - cols[IM_MAX(x - ksize - 1, 0)];
+                    }
+
                     int pixel = IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x);
                     IMAGE_PUT_BINARY_PIXEL_FAST(buf_row_ptr, x, pixel);
 
-                    if ((mask && (!image_get_mask_pixel(mask, x, y)))
+                    if ((mask_row_ptr && (!IMAGE_GET_BINARY_PIXEL_FAST(mask_row_ptr, x)))
                     || (pixel == e_or_d)) {
                         continue; // Short circuit.
                     }
 
-                    int acc = e_or_d ? 0 : -1; // Don't count center pixel...
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint32_t *k_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            acc += IMAGE_GET_BINARY_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                        }
-                    }
+                    int acc = e_or_d ? sum : (sum - 1); // Don't count center pixel...
 
                     if (!e_or_d) {
                         // Preserve original pixel value... or clear it.
@@ -711,6 +956,11 @@ static void imlib_erode_dilate(image_t *img, int ksize, int threshold, int e_or_
                     }
                 }
 
+                if ((y + 1) < yy) { // Move the column counts down before the image row is overwritten...
+                    imlib_erode_dilate_acc_row(img, cols, IM_MIN(y + ksize + 1, (yy - 1)), 1);
+                    imlib_erode_dilate_acc_row(img, cols, IM_MAX(y - ksize, 0), -1);
+                }
+
                 if (y >= ksize) { // Transfer buffer lines...
                     memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, (y - ksize)),
                            IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
@@ -725,36 +975,37 @@ static void imlib_erode_dilate(image_t *img, int ksize, int threshold, int e_or_
                        IMAGE_BINARY_LINE_LEN_BYTES(img));
             }
 
-            fb_free();
+            fb_free(); // buf
             break;
         }
         case IMAGE_BPP_GRAYSCALE: {
-            buf.data = fb_alloc(IMAGE_GRAYSCALE_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
+            buf.data = fb_alloc(IMAGE_GRAYSCALE_LINE_LEN_BYTES(img) * brows, FB_ALLOC_PREFER_SPEED);
 
             for (int y = 0, yy = img->h; y < yy; y++) {
                 uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
                 uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
+                const uint32_t *mask_row_ptr = mask ? image_get_mask_row(mask, img->w, y, mask_buf) : NULL;
+
+                int sum = 0;
+
+                for (int k = -ksize; k <= ksize; k++) {
+                    sum += cols[IM_MIN(IM_MAX(k, 0), (img->w - 1))];
+                }
 
                 for (int x = 0, xx = img->w; x < xx; x++) {
+                    if (x) { // Slide the window sum across...
+                        sum += cols[IM_MIN(x + ksize, (xx - 1))] - cols[IM_MAX(x - ksize - 1, 0)];
+                    }
+
                     int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
                     IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, pixel);
 
-                    if ((mask && (!image_get_mask_pixel(mask, x, y)))
+                    if ((mask_row_ptr && (!IMAGE_GET_BINARY_PIXEL_FAST(mask_row_ptr, x)))
                     || (COLOR_GRAYSCALE_TO_BINARY(pixel) == e_or_d)) {
                         continue; // Short circuit.
                     }
 
-                    int acc = e_or_d ? 0 : -1; // Don't count center pixel...
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint8_t *k_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            acc += COLOR_GRAYSCALE_TO_BINARY(IMAGE_GET_GRAYSCALE_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1))));
-                        }
-                    }
+                    int acc = e_or_d ? sum : (sum - 1); // Don't count center pixel...
 
                     if (!e_or_d) {
                         // Preserve original pixel value... or clear it.
@@ -767,6 +1018,11 @@ static void imlib_erode_dilate(image_t *img, int ksize, int threshold, int e_or_
                     }
                 }
 
+                if ((y + 1) < yy) { // Move the column counts down before the image row is overwritten...
+                    imlib_erode_dilate_acc_row(img, cols, IM_MIN(y + ksize + 1, (yy - 1)), 1);
+                    imlib_erode_dilate_acc_row(img, cols, IM_MAX(y - ksize, 0), -1);
+                }
+
                 if (y >= ksize) { // Transfer buffer lines...
                     memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, (y - ksize)),
                            IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
@@ -781,36 +1037,37 @@ static void imlib_erode_dilate(image_t *img, int ksize, int threshold, int e_or_
                        IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
             }
 
-            fb_free();
+            fb_free(); // buf
             break;
         }
         case IMAGE_BPP_RGB565: {
-            buf.data = fb_alloc(IMAGE_RGB565_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
+            buf.data = fb_alloc(IMAGE_RGB565_LINE_LEN_BYTES(img) * brows, FB_ALLOC_PREFER_SPEED);
 
             for (int y = 0, yy = img->h; y < yy; y++) {
                 uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
                 uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
+                const uint32_t *mask_row_ptr = mask ? image_get_mask_row(mask, img->w, y, mask_buf) : NULL;
+
+                int sum = 0;
+
+                for (int k = -ksize; k <= ksize; k++) {
+                    sum += cols[IM_MIN(IM_MAX(k, 0), (img->w - 1))];
+                }
 
                 for (int x = 0, xx = img->w; x < xx; x++) {
+                    if (x) { // Slide the window sum across...
+                        sum += cols[IM_MIN(x + ksize, (xx - 1))] - cols[IM_MAX(x - ksize - 1, 0)];
+                    }
+
                     int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
                     IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
 
-                    if ((mask && (!image_get_mask_pixel(mask, x, y)))
+                    if ((mask_row_ptr && (!IMAGE_GET_BINARY_PIXEL_FAST(mask_row_ptr, x)))
                     || (COLOR_RGB565_TO_BINARY(pixel) == e_or_d)) {
                         continue; // Short circuit.
                     }
 
-                    int acc = e_or_d ? 0 : -1; // Don't count center pixel...
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint16_t *k_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            acc += COLOR_RGB565_TO_BINARY(IMAGE_GET_RGB565_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1))));
-                        }
-                    }
+                    int acc = e_or_d ? sum : (sum - 1); // Don't count center pixel...
 
                     if (!e_or_d) {
                         // Preserve original pixel value... or clear it.
@@ -823,6 +1080,11 @@ static void imlib_erode_dilate(image_t *img, int ksize, int threshold, int e_or_
                     }
                 }
 
+                if ((y + 1) < yy) { // Move the column counts down before the image row is overwritten...
+                    imlib_erode_dilate_acc_row(img, cols, IM_MIN(y + ksize + 1, (yy - 1)), 1);
+                    imlib_erode_dilate_acc_row(img, cols, IM_MAX(y - ksize, 0), -1);
+                }
+
                 if (y >= ksize) { // Transfer buffer lines...
                     memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, (y - ksize)),
                            IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
@@ -837,17 +1099,23 @@ static void imlib_erode_dilate(image_t *img, int ksize, int threshold, int e_or_
                        IMAGE_RGB565_LINE_LEN_BYTES(img));
             }
 
-            fb_free();
+            fb_free(); // buf
             break;
         }
         default: {
             break;
         }
     }
+
+    if (mask_buf) {
+        fb_free(); // mask_buf
+    }
+    fb_free(); // cols
 }
 
 void imlib_erode(image_t *img, int ksize, int threshold, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_erode");
     // Threshold should be equal to (((ksize*2)+1)*((ksize*2)+1))-1
     // for normal operation. E.g. for ksize==3 -> threshold==8
     // Basically you're adjusting the number of data that
@@ -858,6 +1126,7 @@ void imlib_erode(image_t *img, int ksize, int threshold, image_t *mask)
 
 void imlib_dilate(image_t *img, int ksize, int threshold, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_dilate");
     // Threshold should be equal to 0
     // for normal operation. E.g. for ksize==3 -> threshold==0
     // Basically you're adjusting the number of data that
@@ -868,18 +1137,21 @@ void imlib_dilate(image_t *img, int ksize, int threshold, image_t *mask)
 
 void imlib_open(image_t *img, int ksize, int threshold, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_open");
     imlib_erode(img, ksize, (((ksize*2)+1)*((ksize*2)+1))-1 - threshold, mask);
     imlib_dilate(img, ksize, 0 + threshold, mask);
 }
 
 void imlib_close(image_t *img, int ksize, int threshold, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_close");
     imlib_dilate(img, ksize, 0 + threshold, mask);
     imlib_erode(img, ksize, (((ksize*2)+1)*((ksize*2)+1))-1 - threshold, mask);
 }
 
 void imlib_top_hat(image_t *img, int ksize, int threshold, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_top_hat");
     image_t temp;
     temp.w = img->w;
     temp.h = img->h;
@@ -893,6 +1165,7 @@ void imlib_top_hat(image_t *img, int ksize, int threshold, image_t *mask)
 
 void imlib_black_hat(image_t *img, int ksize, int threshold, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_black_hat");
     image_t temp;
     temp.w = img->w;
     temp.h = img->h;
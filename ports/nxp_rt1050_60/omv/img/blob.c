@@ -4,6 +4,7 @@
  */
 
 #include "imlib.h"
+#include "py/runtime.h"
 
 typedef struct xylr {
     int16_t x, y, l, r, t_l, b_l;
@@ -124,6 +125,594 @@ static float calc_roundness(float blob_a, float blob_b, float blob_c)
     return IM_DIV(roundness_min, roundness_max);
 }
 
+// Single pass find_blobs() engine. Each pixel is classified once against every threshold (first match
+// wins, like the per-threshold passes which skip pixels an earlier threshold already claimed), each row
+// is run-length encoded and runs are connected to the runs of the previous row with union-find. Blob
+// statistics are accumulated per run and combined when two labels merge, so nothing is re-scanned.
+// Labels are recycled as soon as a blob ends so the label arena only has to hold the live blobs.
+
+#define FIND_BLOBS_SINGLE_PASS_MAX_THRESHOLDS 32
+#define FIND_BLOBS_NO_CLASS 0xFF
+#define FIND_BLOBS_NO_LABEL 0xFFFF
+#define FIND_BLOBS_NO_SEED UINT32_MAX
+#define FIND_BLOBS_FREE_LABEL INT16_MIN
+
+// Per-threshold pass test for RGB565, the thresholds LUT already has invert applied.
+#define FIND_BLOBS_THRESHOLD_RGB565(pixel) \
+    (lut ? COLOR_THRESHOLD_LUT(lut, (pixel), code) : COLOR_THRESHOLD_RGB565((pixel), &lnk_data, invert))
+
+typedef struct find_blobs_run {
+    int16_t l, r;
+    uint16_t label;
+    uint8_t code;
+}
+find_blobs_run_t;
+
+typedef struct find_blobs_label {
+    uint16_t parent;
+    int16_t seen_y;
+    uint8_t code;
+    uint32_t seed;
+    int pixels, perimeter, cx, cy;
+    long long a, b, c;
+    float corners_acc[FIND_BLOBS_CORNERS_RESOLUTION];
+    point_t corners[FIND_BLOBS_CORNERS_RESOLUTION];
+    int corners_n[FIND_BLOBS_CORNERS_RESOLUTION];
+}
+find_blobs_label_t;
+
+typedef struct find_blobs_sorted_blob {
+    uint32_t seed;
+    find_blobs_list_lnk_data_t blob;
+}
+find_blobs_sorted_blob_t;
+
+static void find_blobs_classify_row(uint8_t *cls, image_t *ptr, rectangle_t *roi, int y,
+                                    color_thresholds_list_lnk_data_t *t, int t_count, bool invert, const uint8_t *lut)
+{
+    switch(ptr->bpp) {
+        case IMAGE_BPP_BINARY: {
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
+            uint8_t lut[2];
+            for (int p = 0; p < 2; p++) {
+                lut[p] = FIND_BLOBS_NO_CLASS;
+                for (int k = 0; k < t_count; k++) {
+                    if (COLOR_THRESHOLD_BINARY(p, &t[k], invert)) {
+                        lut[p] = k;
+                        break;
+                    }
+                }
+            }
+            // Uniform words fill 32 classes, the others 4 at a time by spreading the bits to byte
+            // lanes that pick the class of each.
+            uint32_t cls_0 = lut[0] * 0x01010101U, cls_1 = lut[1] * 0x01010101U;
+            int x = roi->x, xx = roi->x + roi->w;
+            for (; (x + 4) <= xx; x += 4, cls += 4) {
+                int shift = x & UINT32_T_MASK;
+                uint32_t bits = row_ptr[x >> UINT32_T_SHIFT] >> shift;
+                if ((!shift) && ((x + UINT32_T_BITS) <= xx) && ((bits == 0) || (bits == 0xFFFFFFFF))) {
+                    memset(cls, lut[bits & 1], UINT32_T_BITS);
+                    cls += UINT32_T_BITS - 4;
+                    x += UINT32_T_BITS - 4;
+                    continue;
+                }
+                if (shift > (UINT32_T_BITS - 4)) {
+                    bits |= row_ptr[(x >> UINT32_T_SHIFT) + 1] << (UINT32_T_BITS - shift);
+                }
+                uint32_t lanes = IMAGE_MASK_BITS_TO_BYTE_LANES(bits);
+                __UNALIGNED_UINT32_WRITE(cls, (cls_1 & lanes) | (cls_0 & ~lanes));
+            }
+            for (; x < xx; x++) {
+                *cls++ = lut[IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x)];
+            }
+            break;
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
+            int last_pixel = -1;
+            uint8_t last_cls = FIND_BLOBS_NO_CLASS;
+            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                if (pixel != last_pixel) {
+                    last_pixel = pixel;
+                    last_cls = FIND_BLOBS_NO_CLASS;
+                    for (int k = 0; k < t_count; k++) {
+                        if (COLOR_THRESHOLD_GRAYSCALE(pixel, &t[k], invert)) {
+                            last_cls = k;
+                            break;
+                        }
+                    }
+                }
+                *cls++ = last_cls;
+            }
+            break;
+        }
+        case IMAGE_BPP_RGB565: {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
+            int last_pixel = -1;
+            uint8_t last_cls = FIND_BLOBS_NO_CLASS;
+            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+                if (lut) {
+                    int bits = lut[pixel];
+                    last_cls = FIND_BLOBS_NO_CLASS;
+                    for (int k = 0; bits; k++, bits >>= 1) {
+                        if (bits & 1) {
+                            last_cls = k;
+                            break;
+                        }
+                    }
+                } else if (pixel != last_pixel) {
+                    // One Lab lookup per pixel value, shared by all of the thresholds.
+                    int l = COLOR_RGB565_TO_L(pixel);
+                    int a = COLOR_RGB565_TO_A(pixel);
+                    int b = COLOR_RGB565_TO_B(pixel);
+                    last_pixel = pixel;
+                    last_cls = FIND_BLOBS_NO_CLASS;
+                    for (int k = 0; k < t_count; k++) {
+                        if (((t[k].LMin <= l) && (l <= t[k].LMax) &&
+                             (t[k].AMin <= a) && (a <= t[k].AMax) &&
+                             (t[k].BMin <= b) && (b <= t[k].BMax)) ^ invert) {
+                            last_cls = k;
+                            break;
+                        }
+                    }
+                }
+                *cls++ = last_cls;
+            }
+            break;
+        }
+        case IMAGE_BPP_YUV422: {
+            // lut holds the imlib_yuv_thresholds_lut() words, a pixel pair shares its U and V bits.
+            const uint32_t *yuv_lut = (const uint32_t *) lut;
+            uint32_t flip = invert ? ((t_count < 32) ? ((1U << t_count) - 1) : 0xFFFFFFFF) : 0;
+            uint8_t *row_ptr = IMAGE_COMPUTE_YUV422_PIXEL_ROW_PTR(ptr, y);
+            uint32_t uv = 0;
+            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                if ((x == roi->x) || (!(x & 1))) {
+                    uint8_t *pair = row_ptr + ((x & ~1) * 2);
+                    uv = yuv_lut[256 + pair[1]] & yuv_lut[512 + pair[3]];
+                }
+                uint32_t bits = (yuv_lut[row_ptr[x * 2]] & uv) ^ flip;
+                *cls++ = bits ? __CLZ(__RBIT(bits)) : FIND_BLOBS_NO_CLASS;
+            }
+            break;
+        }
+        default: {
+            memset(cls, FIND_BLOBS_NO_CLASS, roi->w);
+            break;
+        }
+    }
+}
+
+static int find_blobs_label_find(find_blobs_label_t *labels, int label)
+{
+    int root = label;
+
+    while (labels[root].parent != root) {
+        root = labels[root].parent;
+    }
+
+    while (labels[label].parent != root) {
+        int next = labels[label].parent;
+        labels[label].parent = root;
+        label = next;
+    }
+
+    return root;
+}
+
+static void find_blobs_label_merge(find_blobs_label_t *labels, int dst_label, int src_label)
+{
+    find_blobs_label_t *dst = &labels[dst_label];
+    find_blobs_label_t *src = &labels[src_label];
+
+    for (int i = 0; i < FIND_BLOBS_CORNERS_RESOLUTION; i++) {
+        if (src->corners_acc[i] < dst->corners_acc[i]) {
+            dst->corners_acc[i] = src->corners_acc[i];
+            dst->corners[i] = src->corners[i];
+            dst->corners_n[i] = src->corners_n[i];
+        } else if (src->corners_acc[i] == dst->corners_acc[i]) {
+            int n = dst->corners_n[i] + src->corners_n[i];
+            dst->corners[i].x = ((dst->corners[i].x * dst->corners_n[i]) + (src->corners[i].x * src->corners_n[i])) / n;
+            dst->corners[i].y = ((dst->corners[i].y * dst->corners_n[i]) + (src->corners[i].y * src->corners_n[i])) / n;
+            dst->corners_n[i] = n;
+        }
+    }
+
+    dst->seed = IM_MIN(dst->seed, src->seed);
+    dst->pixels += src->pixels;
+    dst->perimeter += src->perimeter;
+    dst->cx += src->cx;
+    dst->cy += src->cy;
+    dst->a += src->a;
+    dst->b += src->b;
+    dst->c += src->c;
+    src->parent = dst_label;
+}
+
+static void find_blobs_emit(list_t *blobs, find_blobs_label_t *label, unsigned int area_threshold, unsigned int pixels_threshold,
+                            bool (*threshold_cb)(void*,find_blobs_list_lnk_data_t*), void *threshold_cb_arg)
+{
+    // The per-threshold passes only start a blob from a pixel on the stride grid.
+    if (label->seed == FIND_BLOBS_NO_SEED) {
+        return;
+    }
+
+    rectangle_t rect;
+    rect.x = label->corners[(FIND_BLOBS_CORNERS_RESOLUTION*0)/4].x; // l
+    rect.y = label->corners[(FIND_BLOBS_CORNERS_RESOLUTION*1)/4].y; // t
+    rect.w = label->corners[(FIND_BLOBS_CORNERS_RESOLUTION*2)/4].x - label->corners[(FIND_BLOBS_CORNERS_RESOLUTION*0)/4].x + 1; // r - l + 1
+    rect.h = label->corners[(FIND_BLOBS_CORNERS_RESOLUTION*3)/4].y - label->corners[(FIND_BLOBS_CORNERS_RESOLUTION*1)/4].y + 1; // b - t + 1
+
+    if (((rect.w * rect.h) < area_threshold) || (label->pixels < pixels_threshold)) {
+        return;
+    }
+
+    float b_mx = label->cx / ((float) label->pixels);
+    float b_my = label->cy / ((float) label->pixels);
+    int mx = fast_roundf(b_mx); // x centroid
+    int my = fast_roundf(b_my); // y centroid
+    int small_blob_a = label->a - ((mx * label->cx) + (mx * label->cx)) + (label->pixels * mx * mx);
+    int small_blob_b = label->b - ((mx * label->cy) + (my * label->cx)) + (label->pixels * mx * my);
+    int small_blob_c = label->c - ((my * label->cy) + (my * label->cy)) + (label->pixels * my * my);
+
+    find_blobs_sorted_blob_t tmp;
+    tmp.seed = label->seed;
+    memcpy(tmp.blob.corners, label->corners, FIND_BLOBS_CORNERS_RESOLUTION * sizeof(point_t));
+    memcpy(&tmp.blob.rect, &rect, sizeof(rectangle_t));
+    tmp.blob.pixels = label->pixels;
+    tmp.blob.perimeter = label->perimeter;
+    tmp.blob.code = 1 << label->code;
+    tmp.blob.count = 1;
+    tmp.blob.centroid_x = b_mx;
+    tmp.blob.centroid_y = b_my;
+    tmp.blob.rotation = (small_blob_a != small_blob_c) ? (fast_atan2f(2 * small_blob_b, small_blob_a - small_blob_c) / 2.0f) : 0.0f;
+    tmp.blob.roundness = calc_roundness(small_blob_a, small_blob_b, small_blob_c);
+    tmp.blob.x_hist_bins_count = 0;
+    tmp.blob.x_hist_bins = NULL;
+    tmp.blob.y_hist_bins_count = 0;
+    tmp.blob.y_hist_bins = NULL;
+    // These store the current average accumulation.
+    tmp.blob.centroid_x_acc = tmp.blob.centroid_x * tmp.blob.pixels;
+    tmp.blob.centroid_y_acc = tmp.blob.centroid_y * tmp.blob.pixels;
+    tmp.blob.rotation_acc_x = cosf(tmp.blob.rotation) * tmp.blob.pixels;
+    tmp.blob.rotation_acc_y = sinf(tmp.blob.rotation) * tmp.blob.pixels;
+    tmp.blob.roundness_acc = tmp.blob.roundness * tmp.blob.pixels;
+
+    if ((threshold_cb_arg != NULL) && (!threshold_cb(threshold_cb_arg, &tmp.blob))) {
+        return;
+    }
+
+    // Keep the per-threshold pass order: by threshold and then by the raster position of the seed.
+    size_t index = list_size(blobs);
+    for (list_lnk_t *it = iterator_start_from_tail(blobs); it; it = iterator_prev(it), index--) {
+        find_blobs_sorted_blob_t other;
+        iterator_get(blobs, it, &other);
+        if ((other.blob.code < tmp.blob.code) || ((other.blob.code == tmp.blob.code) && (other.seed < tmp.seed))) {
+            break;
+        }
+    }
+
+    list_insert(blobs, &tmp, index);
+}
+
+// Retires the labels of the previous row: merged labels are freed and blobs no run of row y touches
+// are finished and emitted.
+static void find_blobs_retire(list_t *blobs, find_blobs_label_t *labels, uint16_t *free_label,
+                              find_blobs_run_t *runs, int runs_n, int y,
+                              unsigned int area_threshold, unsigned int pixels_threshold,
+                              bool (*threshold_cb)(void*,find_blobs_list_lnk_data_t*), void *threshold_cb_arg)
+{
+    for (int i = 0; i < runs_n; i++) {
+        int l = runs[i].label;
+        find_blobs_label_t *label = &labels[l];
+
+        if (label->seen_y == FIND_BLOBS_FREE_LABEL) {
+            continue;
+        }
+
+        if (label->parent == l) {
+            if (label->seen_y == y) {
+                continue;
+            }
+
+            find_blobs_emit(blobs, label, area_threshold, pixels_threshold, threshold_cb, threshold_cb_arg);
+        }
+
+        label->seen_y = FIND_BLOBS_FREE_LABEL;
+        label->parent = *free_label;
+        *free_label = l;
+    }
+}
+
+static bool find_blobs_single_pass(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int x_stride, unsigned int y_stride,
+                                   list_t *thresholds, bool invert, const uint8_t *lut,
+                                   unsigned int area_threshold, unsigned int pixels_threshold,
+                                   bool (*threshold_cb)(void*,find_blobs_list_lnk_data_t*), void *threshold_cb_arg)
+{
+    color_thresholds_list_lnk_data_t t[FIND_BLOBS_SINGLE_PASS_MAX_THRESHOLDS];
+    int t_count = 0;
+
+    for (list_lnk_t *it = iterator_start_from_head(thresholds); it; it = iterator_next(it)) {
+        iterator_get(thresholds, it, &t[t_count++]);
+    }
+
+    int x_max = roi->x + roi->w - 1;
+    int y_max = roi->y + roi->h - 1;
+
+    // Every label starts from the same corner maximums as the per-threshold passes.
+    find_blobs_label_t init;
+    for (int i = 0; i < FIND_BLOBS_CORNERS_RESOLUTION; i++) {
+        init.corners[i].x = IM_MAX(IM_MIN(x_max * sign(cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i]), x_max), 0);
+        init.corners[i].y = IM_MAX(IM_MIN(y_max * sign(sin_table[FIND_BLOBS_ANGLE_RESOLUTION*i]), y_max), 0);
+        init.corners_acc[i] = (init.corners[i].x * cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i]) +
+                              (init.corners[i].y * sin_table[FIND_BLOBS_ANGLE_RESOLUTION*i]);
+        init.corners_n[i] = 1;
+    }
+
+    uint8_t *cls = fb_alloc(roi->w * 3, FB_ALLOC_PREFER_SPEED);
+    find_blobs_run_t *prev_runs = fb_alloc(roi->w * 2 * sizeof(find_blobs_run_t), FB_ALLOC_PREFER_SPEED);
+    find_blobs_run_t *cur_runs = prev_runs + roi->w;
+    int prev_runs_n = 0;
+
+    uint32_t labels_size;
+    find_blobs_label_t *labels = fb_alloc_all(&labels_size, FB_ALLOC_NO_HINT);
+    int labels_max = IM_MIN(labels_size / sizeof(find_blobs_label_t), FIND_BLOBS_NO_LABEL);
+    int labels_used = 0;
+    uint16_t free_label = FIND_BLOBS_NO_LABEL;
+
+    list_t blobs;
+    list_init(&blobs, sizeof(find_blobs_sorted_blob_t));
+
+    bool ok = true;
+    find_blobs_classify_row(cls, ptr, roi, roi->y, t, t_count, invert, lut);
+
+    for (int y = roi->y, yy = roi->y + roi->h; ok && (y < yy); y++) {
+        mp_sched_check_in();
+        int row = y - roi->y;
+        uint8_t *cls_above = (y > roi->y) ? (cls + (((row + 2) % 3) * roi->w)) : NULL;
+        uint8_t *cls_row = cls + ((row % 3) * roi->w);
+        uint8_t *cls_below = (y < y_max) ? (cls + (((row + 1) % 3) * roi->w)) : NULL;
+        if (cls_below) find_blobs_classify_row(cls_below, ptr, roi, y + 1, t, t_count, invert, lut);
+
+        bool seed_row = ((row % y_stride) == 0);
+        int seed_base = roi->x + (y % x_stride);
+        int cur_runs_n = 0;
+
+        for (int x = 0, j = 0; x < roi->w; ) {
+            int code = cls_row[x];
+
+            // Background and long runs are skipped a word of classes at a time.
+            if (code == FIND_BLOBS_NO_CLASS) {
+                for (x++; ((x + 4) <= roi->w) && (__UNALIGNED_UINT32_READ(cls_row + x) == (FIND_BLOBS_NO_CLASS * 0x01010101U)); x += 4);
+                continue;
+            }
+
+            int run_l = x;
+            for (uint32_t code_word = code * 0x01010101U;
+                 ((x + 4) <= roi->w) && (__UNALIGNED_UINT32_READ(cls_row + x) == code_word); x += 4);
+            while ((x < roi->w) && (cls_row[x] == code)) x++;
+            int run_r = x - 1;
+
+            int left = roi->x + run_l, right = roi->x + run_r;
+            int sum = sum_m_to_n(left, right);
+            int sum_2 = sum_2_m_to_n(left, right);
+            int cnt = right - left + 1;
+            int avg = sum / cnt;
+
+            // Same perimeter rule as the flood fill: pixels above/below the interior of the run that aren't
+            // part of the blob or an earlier threshold count, the whole run counts along the roi edge.
+            int perimeter = 2;
+            for (int k = 0; k < 2; k++) {
+                uint8_t *cls_side = k ? cls_below : cls_above;
+                if (!cls_side) {
+                    perimeter += cnt;
+                } else {
+                    for (int i = run_l + 1; i < run_r; i++) {
+                        perimeter += cls_side[i] > code;
+                    }
+                }
+            }
+
+            // Connect to the runs of the previous row, both lists are sorted left to right.
+            int label = FIND_BLOBS_NO_LABEL;
+            while ((j < prev_runs_n) && (prev_runs[j].r < run_l)) j++;
+            for (int k = j; (k < prev_runs_n) && (prev_runs[k].l <= run_r); k++) {
+                if (prev_runs[k].code == code) {
+                    int root = find_blobs_label_find(labels, prev_runs[k].label);
+                    if (label == FIND_BLOBS_NO_LABEL) {
+                        label = root;
+                    } else if (root != label) {
+                        find_blobs_label_merge(labels, label, root);
+                    }
+                }
+            }
+
+            if (label == FIND_BLOBS_NO_LABEL) {
+                if (free_label != FIND_BLOBS_NO_LABEL) {
+                    label = free_label;
+                    free_label = labels[label].parent;
+                } else if (labels_used < labels_max) {
+                    label = labels_used++;
+                } else {
+                    ok = false;
+                    break;
+                }
+
+                memcpy(&labels[label], &init, sizeof(find_blobs_label_t));
+                labels[label].parent = label;
+                labels[label].code = code;
+                labels[label].seed = FIND_BLOBS_NO_SEED;
+                labels[label].pixels = 0;
+                labels[label].perimeter = 0;
+                labels[label].cx = 0;
+                labels[label].cy = 0;
+                labels[label].a = 0;
+                labels[label].b = 0;
+                labels[label].c = 0;
+            }
+
+            find_blobs_label_t *l = &labels[label];
+
+            for (int i = 0; i < FIND_BLOBS_CORNERS_RESOLUTION; i++) {
+                int x_new = (cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i] > 0) ? left :
+                            ((cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i] == 0) ? avg :
+                                                                              right);
+                float z = (x_new * cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i]) +
+                          (y * sin_table[FIND_BLOBS_ANGLE_RESOLUTION*i]);
+                if (z < l->corners_acc[i]) {
+                    l->corners_acc[i] = z;
+                    l->corners[i].x = x_new;
+                    l->corners[i].y = y;
+                    l->corners_n[i] = 1;
+                } else if (z == l->corners_acc[i]) {
+                    l->corners[i].x = cumulative_moving_average(l->corners[i].x, x_new, l->corners_n[i]);
+                    l->corners[i].y = cumulative_moving_average(l->corners[i].y, y, l->corners_n[i]);
+                    l->corners_n[i] += 1;
+                }
+            }
+
+            if (seed_row) {
+                int seed_x = (left <= seed_base) ? seed_base :
+                             (seed_base + ((((left - seed_base) + x_stride - 1) / x_stride) * x_stride));
+                if (seed_x <= right) {
+                    l->seed = IM_MIN(l->seed, (uint32_t) ((y * ptr->w) + seed_x));
+                }
+            }
+
+            l->pixels += cnt;
+            l->perimeter += perimeter;
+            l->cx += sum;
+            l->cy += y * cnt;
+            l->a += sum_2;
+            l->b += y * sum;
+            l->c += y * y * cnt;
+
+            cur_runs[cur_runs_n].l = run_l;
+            cur_runs[cur_runs_n].r = run_r;
+            cur_runs[cur_runs_n].label = label;
+            cur_runs[cur_runs_n].code = code;
+            cur_runs_n++;
+        }
+
+        if (!ok) {
+            break;
+        }
+
+        for (int i = 0; i < cur_runs_n; i++) {
+            cur_runs[i].label = find_blobs_label_find(labels, cur_runs[i].label);
+            labels[cur_runs[i].label].seen_y = y;
+        }
+
+        find_blobs_retire(&blobs, labels, &free_label, prev_runs, prev_runs_n, y,
+                          area_threshold, pixels_threshold, threshold_cb, threshold_cb_arg);
+
+        find_blobs_run_t *tmp_runs = prev_runs;
+        prev_runs = cur_runs;
+        cur_runs = tmp_runs;
+        prev_runs_n = cur_runs_n;
+    }
+
+    if (ok) {
+        find_blobs_retire(&blobs, labels, &free_label, prev_runs, prev_runs_n, roi->y + roi->h,
+                          area_threshold, pixels_threshold, threshold_cb, threshold_cb_arg);
+
+        while (list_size(&blobs)) {
+            find_blobs_sorted_blob_t tmp;
+            list_pop_front(&blobs, &tmp);
+            list_push_back(out, &tmp.blob);
+        }
+    } else {
+        list_clear(&blobs);
+    }
+
+    if (labels) fb_free(); // labels
+    fb_free(); // runs
+    fb_free(); // cls
+    return ok;
+}
+
+static void find_blobs_merge(list_t *out, int margin,
+                             bool (*merge_cb)(void*,find_blobs_list_lnk_data_t*,find_blobs_list_lnk_data_t*), void *merge_cb_arg,
+                             unsigned int x_hist_bins_max, unsigned int y_hist_bins_max)
+{
+    for(;;) {
+        bool merge_occured = false;
+
+        list_t out_temp;
+        list_init(&out_temp, sizeof(find_blobs_list_lnk_data_t));
+
+        while(list_size(out)) {
+            find_blobs_list_lnk_data_t lnk_blob;
+            list_pop_front(out, &lnk_blob);
+
+            for (size_t k = 0, l = list_size(out); k < l; k++) {
+                find_blobs_list_lnk_data_t tmp_blob;
+                list_pop_front(out, &tmp_blob);
+
+                rectangle_t temp;
+                temp.x = IM_MAX(IM_MIN(tmp_blob.rect.x - margin, INT16_MAX), INT16_MIN);
+                temp.y = IM_MAX(IM_MIN(tmp_blob.rect.y - margin, INT16_MAX), INT16_MIN);
+                temp.w = IM_MAX(IM_MIN(tmp_blob.rect.w + (margin * 2), INT16_MAX), 0);
+                temp.h = IM_MAX(IM_MIN(tmp_blob.rect.h + (margin * 2), INT16_MAX), 0);
+
+                if (rectangle_overlap(&(lnk_blob.rect), &temp)
+                && ((merge_cb_arg == NULL) || merge_cb(merge_cb_arg, &lnk_blob, &tmp_blob))) {
+                    // Have to merge these first before merging rects.
+                    if (x_hist_bins_max) merge_bins(lnk_blob.rect.x, lnk_blob.rect.x + lnk_blob.rect.w - 1, &lnk_blob.x_hist_bins, &lnk_blob.x_hist_bins_count,
+                                                    tmp_blob.rect.x, tmp_blob.rect.x + tmp_blob.rect.w - 1, &tmp_blob.x_hist_bins, &tmp_blob.x_hist_bins_count,
+                                                    x_hist_bins_max);
+                    if (y_hist_bins_max) merge_bins(lnk_blob.rect.y, lnk_blob.rect.y + lnk_blob.rect.h - 1, &lnk_blob.y_hist_bins, &lnk_blob.y_hist_bins_count,
+                                                    tmp_blob.rect.y, tmp_blob.rect.y + tmp_blob.rect.h - 1, &tmp_blob.y_hist_bins, &tmp_blob.y_hist_bins_count,
+                                                    y_hist_bins_max);
+                    // Merge corners...
+                    for (int i = 0; i < FIND_BLOBS_CORNERS_RESOLUTION; i++) {
+                        float z_dst = (lnk_blob.corners[i].x * cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i]) +
+                                      (lnk_blob.corners[i].y * sin_table[FIND_BLOBS_ANGLE_RESOLUTION*i]);
+                        float z_src = (tmp_blob.corners[i].x * cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i]) +
+                                      (tmp_blob.corners[i].y * cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i]);
+                        if (z_src < z_dst) {
+                            lnk_blob.corners[i].x = tmp_blob.corners[i].x;
+                            lnk_blob.corners[i].y = tmp_blob.corners[i].y;
+                        }
+                    }
+                    // Merge rects...
+                    rectangle_united(&(lnk_blob.rect), &(tmp_blob.rect));
+                    // Merge counters...
+                    lnk_blob.pixels += tmp_blob.pixels; // won't overflow
+                    lnk_blob.perimeter += tmp_blob.perimeter; // won't overflow
+                    lnk_blob.code |= tmp_blob.code; // won't overflow
+                    lnk_blob.count += tmp_blob.count; // won't overflow
+                    // Merge accumulators...
+                    lnk_blob.centroid_x_acc += tmp_blob.centroid_x_acc;
+                    lnk_blob.centroid_y_acc += tmp_blob.centroid_y_acc;
+                    lnk_blob.rotation_acc_x += tmp_blob.rotation_acc_x;
+                    lnk_blob.rotation_acc_y += tmp_blob.rotation_acc_y;
+                    lnk_blob.roundness_acc += tmp_blob.roundness_acc;
+                    // Compute current values...
+                    lnk_blob.centroid_x = lnk_blob.centroid_x_acc / lnk_blob.pixels;
+                    lnk_blob.centroid_y = lnk_blob.centroid_y_acc / lnk_blob.pixels;
+                    lnk_blob.rotation = fast_atan2f(lnk_blob.rotation_acc_y / lnk_blob.pixels,
+                                                    lnk_blob.rotation_acc_x / lnk_blob.pixels);
+                    lnk_blob.roundness = lnk_blob.roundness_acc / lnk_blob.pixels;
+                    merge_occured = true;
+                } else {
+                    list_push_back(out, &tmp_blob);
+                }
+            }
+
+            list_push_back(&out_temp, &lnk_blob);
+        }
+
+        list_copy(out, &out_temp);
+
+        if (!merge_occured) {
+            break;
+        }
+    }
+}
+
 void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int x_stride, unsigned int y_stride,
                      list_t *thresholds, bool invert, unsigned int area_threshold, unsigned int pixels_threshold,
                      bool merge, int margin,
@@ -131,6 +720,65 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                       bool (*merge_cb)(void*,find_blobs_list_lnk_data_t*,find_blobs_list_lnk_data_t*), void *merge_cb_arg,
                       unsigned int x_hist_bins_max, unsigned int y_hist_bins_max)
 {
+    OMV_PROF_SCOPE("imlib_find_blobs");
+    list_init(out, sizeof(find_blobs_list_lnk_data_t));
+
+    if (ptr->bpp == IMAGE_BPP_YUV422) {
+        // The thresholds are Y, U and V ranges, classified in place from a LUT per channel.
+        uint32_t *yuv_lut = fb_alloc(3 * 256 * sizeof(uint32_t), FB_ALLOC_PREFER_SPEED);
+        imlib_yuv_thresholds_lut(thresholds, yuv_lut);
+
+        if ((!x_hist_bins_max) && (!y_hist_bins_max)
+        && find_blobs_single_pass(out, ptr, roi, x_stride, y_stride, thresholds, invert, (const uint8_t *) yuv_lut,
+                                  area_threshold, pixels_threshold, threshold_cb, threshold_cb_arg)) {
+            if (merge) {
+                find_blobs_merge(out, margin, merge_cb, merge_cb_arg, x_hist_bins_max, y_hist_bins_max);
+            }
+        } else {
+            // The classes as a grayscale image, class k is threshold (k, k) of the per-threshold passes.
+            image_t cls_img;
+            cls_img.w = ptr->w;
+            cls_img.h = ptr->h;
+            cls_img.bpp = IMAGE_BPP_GRAYSCALE;
+            cls_img.data = fb_alloc(image_size(&cls_img), FB_ALLOC_NO_HINT);
+
+            int t_count = list_size(thresholds);
+            for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                find_blobs_classify_row(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&cls_img, y) + roi->x, ptr, roi, y,
+                                        NULL, t_count, invert, (const uint8_t *) yuv_lut);
+            }
+
+            list_t cls_thresholds;
+            list_init(&cls_thresholds, sizeof(color_thresholds_list_lnk_data_t));
+            for (int k = 0; k < t_count; k++) {
+                color_thresholds_list_lnk_data_t lnk_data = { .LMin = k, .LMax = k };
+                list_push_back(&cls_thresholds, &lnk_data);
+            }
+
+            imlib_find_blobs(out, &cls_img, roi, x_stride, y_stride, &cls_thresholds, false, area_threshold, pixels_threshold,
+                             merge, margin, threshold_cb, threshold_cb_arg, merge_cb, merge_cb_arg,
+                             x_hist_bins_max, y_hist_bins_max);
+
+            list_free(&cls_thresholds);
+            fb_free(); // cls_img
+        }
+
+        fb_free(); // yuv_lut
+        return;
+    }
+
+    const uint8_t *lut = (ptr->bpp == IMAGE_BPP_RGB565) ? imlib_thresholds_lut(thresholds, invert) : NULL;
+
+    if ((list_size(thresholds) > 1) && (list_size(thresholds) <= FIND_BLOBS_SINGLE_PASS_MAX_THRESHOLDS)
+    && (!x_hist_bins_max) && (!y_hist_bins_max)
+    && find_blobs_single_pass(out, ptr, roi, x_stride, y_stride, thresholds, invert, lut, area_threshold, pixels_threshold,
+                              threshold_cb, threshold_cb_arg)) {
+        if (merge) {
+            find_blobs_merge(out, margin, merge_cb, merge_cb_arg, x_hist_bins_max, y_hist_bins_max);
+        }
+        return;
+    }
+
     // Same size as the image so we don't have to translate.
     image_t bmp;
     bmp.w = ptr->w;
@@ -148,8 +796,6 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
     size_t lifo_len;
     lifo_alloc_all(&lifo, &lifo_len, sizeof(xylr_t));
 
-    list_init(out, sizeof(find_blobs_list_lnk_data_t));
-
     size_t code = 0;
     for (list_lnk_t *it = iterator_start_from_head(thresholds); it; it = iterator_next(it)) {
         color_thresholds_list_lnk_data_t lnk_data;
@@ -682,7 +1328,7 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                     uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
                     for (int x = roi->x + (y % x_stride), xx = roi->x + roi->w, x_max = xx - 1; x < xx; x += x_stride) {
                         if ((!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x))
-                        && COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x), &lnk_data, invert)) {
+                        && FIND_BLOBS_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x))) {
                             int old_x = x;
                             int old_y = y;
 
@@ -718,13 +1364,13 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
 
                                 while ((left > roi->x)
                                 && (!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row, left - 1))
-                                && COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, left - 1), &lnk_data, invert)) {
+                                && FIND_BLOBS_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, left - 1))) {
                                     left--;
                                 }
 
                                 while ((right < (roi->x + roi->w - 1))
                                 && (!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row, right + 1))
-                                && COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, right + 1), &lnk_data, invert)) {
+                                && FIND_BLOBS_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, right + 1))) {
                                     right++;
                                 }
 
@@ -781,7 +1427,7 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                                 bool ok = true; // Does nothing if thresholding is skipped.
 
                                                 if ((!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row, i))
-                                                && (ok = COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, i), &lnk_data, invert))) {
+                                                && (ok = FIND_BLOBS_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, i)))) {
                                                     xylr_t context;
                                                     context.x = x;
                                                     context.y = y;
@@ -814,7 +1460,7 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                                 bool ok = true; // Does nothing if thresholding is skipped.
 
                                                 if ((!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row, i))
-                                                && (ok = COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, i), &lnk_data, invert))) {
+                                                && (ok = FIND_BLOBS_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, i)))) {
                                                     xylr_t context;
                                                     context.x = x;
                                                     context.y = y;
@@ -950,80 +1596,7 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
     fb_free(); // bitmap
 
     if (merge) {
-        for(;;) {
-            bool merge_occured = false;
-
-            list_t out_temp;
-            list_init(&out_temp, sizeof(find_blobs_list_lnk_data_t));
-
-            while(list_size(out)) {
-                find_blobs_list_lnk_data_t lnk_blob;
-                list_pop_front(out, &lnk_blob);
-
-                for (size_t k = 0, l = list_size(out); k < l; k++) {
-                    find_blobs_list_lnk_data_t tmp_blob;
-                    list_pop_front(out, &tmp_blob);
-
-                    rectangle_t temp;
-                    temp.x = IM_MAX(IM_MIN(tmp_blob.rect.x - margin, INT16_MAX), INT16_MIN);
-                    temp.y = IM_MAX(IM_MIN(tmp_blob.rect.y - margin, INT16_MAX), INT16_MIN);
-                    temp.w = IM_MAX(IM_MIN(tmp_blob.rect.w + (margin * 2), INT16_MAX), 0);
-                    temp.h = IM_MAX(IM_MIN(tmp_blob.rect.h + (margin * 2), INT16_MAX), 0);
-
-                    if (rectangle_overlap(&(lnk_blob.rect), &temp)
-                    && ((merge_cb_arg == NULL) || merge_cb(merge_cb_arg, &lnk_blob, &tmp_blob))) {
-                        // Have to merge these first before merging rects.
-                        if (x_hist_bins_max) merge_bins(lnk_blob.rect.x, lnk_blob.rect.x + lnk_blob.rect.w - 1, &lnk_blob.x_hist_bins, &lnk_blob.x_hist_bins_count,
-                                                        tmp_blob.rect.x, tmp_blob.rect.x + tmp_blob.rect.w - 1, &tmp_blob.x_hist_bins, &tmp_blob.x_hist_bins_count,
-                                                        x_hist_bins_max);
-                        if (y_hist_bins_max) merge_bins(lnk_blob.rect.y, lnk_blob.rect.y + lnk_blob.rect.h - 1, &lnk_blob.y_hist_bins, &lnk_blob.y_hist_bins_count,
-                                                        tmp_blob.rect.y, tmp_blob.rect.y + tmp_blob.rect.h - 1, &tmp_blob.y_hist_bins, &tmp_blob.y_hist_bins_count,
-                                                        y_hist_bins_max);
-                        // Merge corners...
-                        for (int i = 0; i < FIND_BLOBS_CORNERS_RESOLUTION; i++) {
-                            float z_dst = (lnk_blob.corners[i].x * cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i]) +
-                                          (lnk_blob.corners[i].y * sin_table[FIND_BLOBS_ANGLE_RESOLUTION*i]);
-                            float z_src = (tmp_blob.corners[i].x * cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i]) +
-                                          (tmp_blob.corners[i].y * cos_table[FIND_BLOBS_ANGLE_RESOLUTION*i]);
-                            if (z_src < z_dst) {
-                                lnk_blob.corners[i].x = tmp_blob.corners[i].x;
-                                lnk_blob.corners[i].y = tmp_blob.corners[i].y;
-                            }
-                        }
-                        // Merge rects...
-                        rectangle_united(&(lnk_blob.rect), &(tmp_blob.rect));
-                        // Merge counters...
-                        lnk_blob.pixels += tmp_blob.pixels; // won't overflow
-                        lnk_blob.perimeter += tmp_blob.perimeter; // won't overflow
-                        lnk_blob.code |= tmp_blob.code; // won't overflow
-                        lnk_blob.count += tmp_blob.count; // won't overflow
-                        // Merge accumulators...
-                        lnk_blob.centroid_x_acc += tmp_blob.centroid_x_acc;
-                        lnk_blob.centroid_y_acc += tmp_blob.centroid_y_acc;
-                        lnk_blob.rotation_acc_x += tmp_blob.rotation_acc_x;
-                        lnk_blob.rotation_acc_y += tmp_blob.rotation_acc_y;
-                        lnk_blob.roundness_acc += tmp_blob.roundness_acc;
-                        // Compute current values...
-                        lnk_blob.centroid_x = lnk_blob.centroid_x_acc / lnk_blob.pixels;
-                        lnk_blob.centroid_y = lnk_blob.centroid_y_acc / lnk_blob.pixels;
-                        lnk_blob.rotation = fast_atan2f(lnk_blob.rotation_acc_y / lnk_blob.pixels,
-                                                        lnk_blob.rotation_acc_x / lnk_blob.pixels);
-                        lnk_blob.roundness = lnk_blob.roundness_acc / lnk_blob.pixels;
-                        merge_occured = true;
-                    } else {
-                        list_push_back(out, &tmp_blob);
-                    }
-                }
-
-                list_push_back(&out_temp, &lnk_blob);
-            }
-
-            list_copy(out, &out_temp);
-
-            if (!merge_occured) {
-                break;
-            }
-        }
+        find_blobs_merge(out, margin, merge_cb, merge_cb_arg, x_hist_bins_max, y_hist_bins_max);
     }
 }
 
@@ -28,6 +28,9 @@
  *
  *  The code is ANSI-C and is also C++ compliant.
  *
+ *  Only the histogram clipping and mapping of the article are used below,
+ *  imlib_clahe_histeq() does the contextual regions natively on 8-bit images.
+ *
  *  Author: Karel Zuiderveld, Computer Vision Research Group,
  *           Utrecht, The Netherlands (karel@cv.ruu.nl)
  */
@@ -40,125 +43,15 @@ typedef unsigned short kz_pixel_t;       /* for 12 bit-per-pixel images (default
 # define uiNR_OF_GREY (4096)
 #endif
 
-/******** Prototype of CLAHE function. Put this in a separate include file. *****/
-int CLAHE(kz_pixel_t* pImage, unsigned int uiXRes, unsigned int uiYRes, kz_pixel_t Min,
-          kz_pixel_t Max, unsigned int uiNrX, unsigned int uiNrY,
-          unsigned int uiNrBins, float fCliplimit);
-
 /*********************** Local prototypes ************************/
 static void ClipHistogram (unsigned long*, unsigned int, unsigned long);
-static void MakeHistogram (kz_pixel_t*, unsigned int, unsigned int, unsigned int,
-                           unsigned long*, unsigned int, kz_pixel_t*);
 static void MapHistogram (unsigned long*, kz_pixel_t, kz_pixel_t,
                           unsigned int, unsigned long);
-static void MakeLut (kz_pixel_t*, kz_pixel_t, kz_pixel_t, unsigned int);
-static void Interpolate (kz_pixel_t*, int, unsigned long*, unsigned long*,
-                         unsigned long*, unsigned long*, unsigned int, unsigned int, kz_pixel_t*);
 
 /**************  Start of actual code **************/
 const unsigned int uiMAX_REG_X = 16;      /* max. # contextual regions in x-direction */
 const unsigned int uiMAX_REG_Y = 16;      /* max. # contextual regions in y-direction */
 
-/************************** main function CLAHE ******************/
-int CLAHE (kz_pixel_t* pImage, unsigned int uiXRes, unsigned int uiYRes,
-           kz_pixel_t Min, kz_pixel_t Max, unsigned int uiNrX, unsigned int uiNrY,
-           unsigned int uiNrBins, float fCliplimit)
-/*   pImage - Pointer to the input/output image
- *   uiXRes - Image resolution in the X direction
- *   uiYRes - Image resolution in the Y direction
- *   Min - Minimum greyvalue of input image (also becomes minimum of output image)
- *   Max - Maximum greyvalue of input image (also becomes maximum of output image)
- *   uiNrX - Number of contextial regions in the X direction (min 2, max uiMAX_REG_X)
- *   uiNrY - Number of contextial regions in the Y direction (min 2, max uiMAX_REG_Y)
- *   uiNrBins - Number of greybins for histogram ("dynamic range")
- *   float fCliplimit - Normalized cliplimit (higher values give more contrast)
- * The number of "effective" greylevels in the output image is set by uiNrBins; selecting
- * a small value (eg. 128) speeds up processing and still produce an output image of
- * good quality. The output image will have the same minimum and maximum value as the input
- * image. A clip limit smaller than 1 results in standard (non-contrast limited) AHE.
- */
-{
-    unsigned int uiX, uiY;                /* counters */
-    unsigned int uiXSize, uiYSize, uiSubX, uiSubY; /* size of context. reg. and subimages */
-    unsigned int uiXL, uiXR, uiYU, uiYB;  /* auxiliary variables interpolation routine */
-    unsigned long ulClipLimit, ulNrPixels;/* clip limit and region pixel count */
-    kz_pixel_t* pImPointer;               /* pointer to image */
-    kz_pixel_t aLUT[uiNR_OF_GREY];        /* lookup table used for scaling of input image */
-    unsigned long* pulHist, *pulMapArray; /* pointer to histogram and mappings*/
-    unsigned long* pulLU, *pulLB, *pulRU, *pulRB; /* auxiliary pointers interpolation */
-
-    if (uiNrX > uiMAX_REG_X) return -1;   /* # of regions x-direction too large */
-    if (uiNrY > uiMAX_REG_Y) return -2;   /* # of regions y-direction too large */
-    if (uiXRes % uiNrX) return -3;        /* x-resolution no multiple of uiNrX */
-    if (uiYRes % uiNrY) return -4;        /* y-resolution no multiple of uiNrY */
-    if (Max >= uiNR_OF_GREY) return -5;   /* maximum too large */
-    if (Min >= Max) return -6;            /* minimum equal or larger than maximum */
-    if (uiNrX < 2 || uiNrY < 2) return -7;/* at least 4 contextual regions required */
-    if (fCliplimit == 1.0) return 0;      /* is OK, immediately returns original image. */
-    if (uiNrBins == 0) uiNrBins = 128;    /* default value when not specified */
-
-    pulMapArray=(unsigned long *)fb_alloc(sizeof(unsigned long)*uiNrX*uiNrY*uiNrBins, FB_ALLOC_NO_HINT);
-    if (pulMapArray == 0) return -8;      /* Not enough memory! (try reducing uiNrBins) */
-
-    uiXSize = uiXRes/uiNrX; uiYSize = uiYRes/uiNrY;  /* Actual size of contextual regions */
-    ulNrPixels = (unsigned long)uiXSize * (unsigned long)uiYSize;
-
-    if(fCliplimit > 0.0) {                /* Calculate actual cliplimit  */
-       ulClipLimit = (unsigned long) (fCliplimit * (uiXSize * uiYSize) / uiNrBins);
-       ulClipLimit = (ulClipLimit < 1UL) ? 1UL : ulClipLimit;
-    }
-    else ulClipLimit = 1UL<<14;           /* Large value, do not clip (AHE) */
-    MakeLut(aLUT, Min, Max, uiNrBins);    /* Make lookup table for mapping of greyvalues */
-    /* Calculate greylevel mappings for each contextual region */
-    for (uiY = 0, pImPointer = pImage; uiY < uiNrY; uiY++) {
-        for (uiX = 0; uiX < uiNrX; uiX++, pImPointer += uiXSize) {
-            pulHist = &pulMapArray[uiNrBins * (uiY * uiNrX + uiX)];
-            MakeHistogram(pImPointer,uiXRes,uiXSize,uiYSize,pulHist,uiNrBins,aLUT);
-            ClipHistogram(pulHist, uiNrBins, ulClipLimit);
-            MapHistogram(pulHist, Min, Max, uiNrBins, ulNrPixels);
-        }
-        pImPointer += (uiYSize - 1) * uiXRes;             /* skip lines, set pointer */
-    }
-
-    /* Interpolate greylevel mappings to get CLAHE image */
-    for (pImPointer = pImage, uiY = 0; uiY <= uiNrY; uiY++) {
-        if (uiY == 0) {                                   /* special case: top row */
-            uiSubY = uiYSize >> 1;  uiYU = 0; uiYB = 0;
-        }
-        else {
-            if (uiY == uiNrY) {                           /* special case: bottom row */
-                uiSubY = (uiYSize+1) >> 1;        uiYU = uiNrY-1;  uiYB = uiYU;
-            }
-            else {                                        /* default values */
-                uiSubY = uiYSize; uiYU = uiY - 1; uiYB = uiYU + 1;
-            }
-        }
-        for (uiX = 0; uiX <= uiNrX; uiX++) {
-            if (uiX == 0) {                               /* special case: left column */
-                uiSubX = uiXSize >> 1; uiXL = 0; uiXR = 0;
-            }
-            else {
-                if (uiX == uiNrX) {                       /* special case: right column */
-                    uiSubX = (uiXSize+1) >> 1;  uiXL = uiNrX - 1; uiXR = uiXL;
-                }
-                else {                                    /* default values */
-                    uiSubX = uiXSize; uiXL = uiX - 1; uiXR = uiXL + 1;
-                }
-            }
-
-            pulLU = &pulMapArray[uiNrBins * (uiYU * uiNrX + uiXL)];
-            pulRU = &pulMapArray[uiNrBins * (uiYU * uiNrX + uiXR)];
-            pulLB = &pulMapArray[uiNrBins * (uiYB * uiNrX + uiXL)];
-            pulRB = &pulMapArray[uiNrBins * (uiYB * uiNrX + uiXR)];
-            Interpolate(pImPointer,uiXRes,pulLU,pulRU,pulLB,pulRB,uiSubX,uiSubY,aLUT);
-            pImPointer += uiSubX;                         /* set pointer on next matrix */
-        }
-        pImPointer += (uiSubY - 1) * uiXRes;
-    }
-    fb_free();                                            /* free space for histograms */
-    return 0;                                             /* return status OK */
-}
-
 void ClipHistogram (unsigned long* pulHistogram, unsigned int
                     uiNrGreylevels, unsigned long ulClipLimit)
 /* This function performs clipping of the histogram and redistribution of bins.
@@ -210,29 +103,6 @@ void ClipHistogram (unsigned long* pulHistogram, unsigned int
     }
 }
 
-void MakeHistogram (kz_pixel_t* pImage, unsigned int uiXRes,
-                    unsigned int uiSizeX, unsigned int uiSizeY,
-                    unsigned long* pulHistogram,
-                    unsigned int uiNrGreylevels, kz_pixel_t* pLookupTable)
-/* This function classifies the greylevels present in the array image into
- * a greylevel histogram. The pLookupTable specifies the relationship
- * between the greyvalue of the pixel (typically between 0 and 4095) and
- * the corresponding bin in the histogram (usually containing only 128 bins).
- */
-{
-    kz_pixel_t* pImagePointer;
-    unsigned int i;
-
-    for (i = 0; i < uiNrGreylevels; i++) pulHistogram[i] = 0L; /* clear histogram */
-
-    for (i = 0; i < uiSizeY; i++) {
-                pImagePointer = &pImage[uiSizeX];
-                while (pImage < pImagePointer) pulHistogram[pLookupTable[*pImage++]]++;
-                pImagePointer += uiXRes;
-                pImage = &pImagePointer[-(int)uiSizeX]; /* go to bdeginning of next row */
-    }
-}
-
 void MapHistogram (unsigned long* pulHistogram, kz_pixel_t Min, kz_pixel_t Max,
                    unsigned int uiNrGreylevels, unsigned long ulNrOfPixels)
 /* This function calculates the equalized lookup table (mapping) by
@@ -249,112 +119,86 @@ void MapHistogram (unsigned long* pulHistogram, kz_pixel_t Min, kz_pixel_t Max,
     }
 }
 
-void MakeLut (kz_pixel_t * pLUT, kz_pixel_t Min, kz_pixel_t Max, unsigned int uiNrBins)
-/* To speed up histogram clipping, the input image [Min,Max] is scaled down to
- * [0,uiNrBins-1]. This function calculates the LUT.
- */
+// Native 8-bit CLAHE.
+//
+// The image is treated as padded to a multiple of the tile grid and centred in it, the
+// padding being black as it was for the copy the generic CLAHE() ran on. Padding pixels
+// are counted into bin 0 of the edge tiles instead of being stored. The image is then
+// equalized in place, a band of rows between two rows of tile centres at a time. A band
+// only needs the LUTs of the tile rows above and below it, so two tile rows of 256 entry
+// 8-bit LUTs are live. Each band of a tile row is done after that tile row's histograms
+// were taken, and no band reaches into the tile row below, so histograms always see the
+// original pixels.
+//
+// The bilinear blend is integer and the divide by the area of the blended region is a
+// multiply and shift, exact for any area (n / d == (n * m) >> k for m == ceil(2^k / d),
+// k == 31 + log2(d) rounded up, n < 2^31).
+
+typedef struct clahe_div {
+    uint32_t mul;
+    int shift;
+} clahe_div_t;
+
+static void clahe_div_init(clahe_div_t *div, uint32_t d)
 {
-    int i;
-    const kz_pixel_t BinSize = (kz_pixel_t) (1 + (Max - Min) / uiNrBins);
-
-    for (i = Min; i <= Max; i++)  pLUT[i] = (i - Min) / BinSize;
+    div->shift = 31 + ((d > 1) ? IM_LOG2_32(d - 1) : 0);
+    div->mul = ((1ULL << div->shift) + d - 1) / d;
 }
 
-void Interpolate (kz_pixel_t * pImage, int uiXRes, unsigned long * pulMapLU,
-                  unsigned long * pulMapRU, unsigned long * pulMapLB,  unsigned long * pulMapRB,
-                  unsigned int uiXSize, unsigned int uiYSize, kz_pixel_t * pLUT)
-/* pImage      - pointer to input/output image
- * uiXRes      - resolution of image in x-direction
- * pulMap*     - mappings of greylevels from histograms
- * uiXSize     - uiXSize of image submatrix
- * uiYSize     - uiYSize of image submatrix
- * pLUT        - lookup table containing mapping greyvalues to bins
- * This function calculates the new greylevel assignments of pixels within a submatrix
- * of the image with size uiXSize and uiYSize. This is done by a bilinear interpolation
- * between four different mappings in order to eliminate boundary artifacts.
- * It uses a division; since division is often an expensive operation, I added code to
- * perform a logical shift instead when feasible.
- */
+// Gets the Y values of row y, the row itself on grayscale images.
+static uint8_t *clahe_get_row(image_t *img, int y, uint8_t *buf)
 {
-    const unsigned int uiIncr = uiXRes-uiXSize; /* Pointer increment after processing row */
-    kz_pixel_t GreyValue; unsigned int uiNum = uiXSize*uiYSize; /* Normalization factor */
-
-    unsigned int uiXCoef, uiYCoef, uiXInvCoef, uiYInvCoef, uiShift = 0;
-
-    if (uiNum & (uiNum - 1)) /* If uiNum is not a power of two, use division */
-    for (uiYCoef = 0, uiYInvCoef = uiYSize; uiYCoef < uiYSize;
-         uiYCoef++, uiYInvCoef--,pImage+=uiIncr) {
-        for (uiXCoef = 0, uiXInvCoef = uiXSize; uiXCoef < uiXSize;
-             uiXCoef++, uiXInvCoef--) {
-            GreyValue = pLUT[*pImage];             /* get histogram bin value */
-            *pImage++ = (kz_pixel_t ) ((uiYInvCoef * (uiXInvCoef*pulMapLU[GreyValue]
-                                      + uiXCoef * pulMapRU[GreyValue])
-                                      + uiYCoef * (uiXInvCoef * pulMapLB[GreyValue]
-                                      + uiXCoef * pulMapRB[GreyValue])) / uiNum);
+    switch(img->bpp) {
+        case IMAGE_BPP_BINARY: {
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                buf[x] = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+            }
+            return buf;
         }
-    }
-    else {                   /* avoid the division and use a right shift instead */
-        while (uiNum >>= 1) uiShift++;             /* Calculate 2log of uiNum */
-        for (uiYCoef = 0, uiYInvCoef = uiYSize; uiYCoef < uiYSize;
-             uiYCoef++, uiYInvCoef--,pImage+=uiIncr) {
-             for (uiXCoef = 0, uiXInvCoef = uiXSize; uiXCoef < uiXSize;
-               uiXCoef++, uiXInvCoef--) {
-               GreyValue = pLUT[*pImage];         /* get histogram bin value */
-               *pImage++ = (kz_pixel_t)((uiYInvCoef* (uiXInvCoef * pulMapLU[GreyValue]
-                                      + uiXCoef * pulMapRU[GreyValue])
-                                      + uiYCoef * (uiXInvCoef * pulMapLB[GreyValue]
-                                      + uiXCoef * pulMapRB[GreyValue])) >> uiShift);
+        case IMAGE_BPP_GRAYSCALE: {
+            return IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+        }
+        case IMAGE_BPP_RGB565: {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                buf[x] = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
             }
+            return buf;
+        }
+        default: {
+            return buf;
         }
     }
 }
 
-void imlib_clahe_histeq(image_t *img, float clip_limit, image_t *mask)
+// Puts back the equalized Y values of row y where the mask is set.
+static void clahe_put_row(image_t *img, int y, const uint8_t *buf, image_t *mask)
 {
-    int xTileSize = IM_MAX(uiMAX_REG_X >> (10 - IM_MIN(IM_LOG2_32(img->w), 10)), 2);
-    int yTileSize = IM_MAX(uiMAX_REG_Y >> (10 - IM_MIN(IM_LOG2_32(img->h), 10)), 2);
-    int pImageW = img->w + ((img->w % xTileSize) ? (xTileSize - (img->w % xTileSize)) : 0);
-    int pImageH = img->h + ((img->h % yTileSize) ? (yTileSize - (img->h % yTileSize)) : 0);
-    int xOffset = (pImageW - img->w) / 2;
-    int yOffset = (pImageH - img->h) / 2;
-
-    image_t temp;
-    temp.w = img->w;
-    temp.h = img->h;
-    temp.bpp = img->bpp;
-    temp.data = fb_alloc0(pImageW * pImageH * sizeof(kz_pixel_t), FB_ALLOC_NO_HINT);
-
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset,
-                        COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x)));
-                }
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                if (mask && (!image_get_mask_pixel(mask, x, y))) continue;
+                IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x, COLOR_GRAYSCALE_TO_BINARY(buf[x]));
             }
             break;
         }
         case IMAGE_BPP_GRAYSCALE: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset,
-                        IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x));
-                }
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                if (mask && (!image_get_mask_pixel(mask, x, y))) continue;
+                IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row_ptr, x, buf[x]);
             }
             break;
         }
         case IMAGE_BPP_RGB565: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset,
-                        COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x)));
-                }
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                if (mask && (!image_get_mask_pixel(mask, x, y))) continue;
+                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+                IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x,
+                    imlib_yuv_to_rgb(buf[x], COLOR_RGB565_TO_U(pixel), COLOR_RGB565_TO_V(pixel)));
             }
             break;
         }
@@ -362,58 +206,109 @@ void imlib_clahe_histeq(image_t *img, float clip_limit, image_t *mask)
             break;
         }
     }
+}
 
-    CLAHE((kz_pixel_t *) temp.data,
-          pImageW, pImageH,
-          COLOR_GRAYSCALE_MIN, COLOR_GRAYSCALE_MAX,
-          xTileSize, yTileSize,
-          COLOR_GRAYSCALE_MAX - COLOR_GRAYSCALE_MIN + 1,
-          clip_limit);
+void imlib_clahe_histeq(image_t *img, float clip_limit, image_t *mask)
+{
+    OMV_PROF_SCOPE("imlib_clahe_histeq");
+    int xTileSize = IM_MAX(uiMAX_REG_X >> (10 - IM_MIN(IM_LOG2_32(img->w), 10)), 2);
+    int yTileSize = IM_MAX(uiMAX_REG_Y >> (10 - IM_MIN(IM_LOG2_32(img->h), 10)), 2);
+    int pImageW = img->w + ((img->w % xTileSize) ? (xTileSize - (img->w % xTileSize)) : 0);
+    int pImageH = img->h + ((img->h % yTileSize) ? (yTileSize - (img->h % yTileSize)) : 0);
+    int xOffset = (pImageW - img->w) / 2;
+    int yOffset = (pImageH - img->h) / 2;
 
-    switch(img->bpp) {
-        case IMAGE_BPP_BINARY: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) continue;
-                    IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x,
-                        COLOR_GRAYSCALE_TO_BINARY(IMAGE_GET_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset)));
+    if (clip_limit == 1.0) return; // as CLAHE(), 1.0 leaves the image unchanged
+
+    int xSize = pImageW / xTileSize, ySize = pImageH / yTileSize; // size of the tiles
+    unsigned long nrPixels = xSize * ySize;
+    unsigned long clipLimit = 1UL << 14; // large value, do not clip (AHE)
+
+    if (clip_limit > 0.0) {
+        clipLimit = (unsigned long) (clip_limit * (xSize * ySize) / uiNR_OF_GREY);
+        clipLimit = IM_MAX(clipLimit, 1UL);
+    }
+
+    unsigned long *hist = fb_alloc(xTileSize * uiNR_OF_GREY * sizeof(unsigned long), FB_ALLOC_NO_HINT);
+    uint8_t *luts = fb_alloc(2 * xTileSize * uiNR_OF_GREY, FB_ALLOC_NO_HINT);
+    clahe_div_t *divs = fb_alloc((xTileSize + 1) * sizeof(clahe_div_t), FB_ALLOC_NO_HINT);
+    uint8_t *buf = fb_alloc(img->w, FB_ALLOC_NO_HINT);
+    bool in_place = (img->bpp == IMAGE_BPP_GRAYSCALE) && (!mask);
+
+    for (int ty = 0; ty <= yTileSize; ty++) {
+        if (ty < yTileSize) {
+            // Histograms and LUTs of tile row ty.
+            memset(hist, 0, xTileSize * uiNR_OF_GREY * sizeof(unsigned long));
+            int y0 = IM_MAX(ty * ySize, yOffset) - yOffset;
+            int y1 = IM_MIN((ty + 1) * ySize, yOffset + img->h) - yOffset;
+
+            for (int y = y0; y < y1; y++) {
+                uint8_t *row = clahe_get_row(img, y, buf);
+                for (int tx = 0; tx < xTileSize; tx++) {
+                    unsigned long *h = hist + (tx * uiNR_OF_GREY);
+                    for (int x = IM_MAX(tx * xSize, xOffset) - xOffset,
+                         xx = IM_MIN((tx + 1) * xSize, xOffset + img->w) - xOffset; x < xx; x++) {
+                        h[row[x]]++;
+                    }
                 }
             }
-            break;
-        }
-        case IMAGE_BPP_GRAYSCALE: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) continue;
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row_ptr, x,
-                        IMAGE_GET_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset));
+
+            uint8_t *lut = luts + ((ty & 1) * xTileSize * uiNR_OF_GREY);
+            for (int tx = 0; tx < xTileSize; tx++) {
+                unsigned long *h = hist + (tx * uiNR_OF_GREY);
+                int cols = IM_MIN((tx + 1) * xSize, xOffset + img->w) - IM_MAX(tx * xSize, xOffset);
+                h[0] += nrPixels - (IM_MAX(cols, 0) * IM_MAX(y1 - y0, 0)); // padding
+                ClipHistogram(h, uiNR_OF_GREY, clipLimit);
+                MapHistogram(h, COLOR_GRAYSCALE_MIN, COLOR_GRAYSCALE_MAX, uiNR_OF_GREY, nrPixels);
+                for (int i = 0; i < uiNR_OF_GREY; i++) {
+                    lut[(tx * uiNR_OF_GREY) + i] = h[i];
                 }
             }
-            break;
         }
-        case IMAGE_BPP_RGB565: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) continue;
-                    int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
-                    IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x,
-                        imlib_yuv_to_rgb(IMAGE_GET_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset),
-                                         COLOR_RGB565_TO_U(pixel),
-                                         COLOR_RGB565_TO_V(pixel)));
+
+        // The band between the centres of tile rows ty - 1 and ty, half a tile at the edges.
+        int subY = (!ty) ? (ySize >> 1) : ((ty == yTileSize) ? ((ySize + 1) >> 1) : ySize);
+        int bandY = (!ty) ? 0 : ((ySize >> 1) + ((ty - 1) * ySize));
+        int yU = IM_MAX(ty - 1, 0), yB = IM_MIN(ty, yTileSize - 1);
+        const uint8_t *lutU = luts + ((yU & 1) * xTileSize * uiNR_OF_GREY);
+        const uint8_t *lutB = luts + ((yB & 1) * xTileSize * uiNR_OF_GREY);
+
+        for (int tx = 0; tx <= xTileSize; tx++) {
+            int subX = (!tx) ? (xSize >> 1) : ((tx == xTileSize) ? ((xSize + 1) >> 1) : xSize);
+            if (subX && subY) clahe_div_init(&divs[tx], subX * subY);
+        }
+
+        for (int y = IM_MAX(bandY, yOffset) - yOffset,
+             yy = IM_MIN(bandY + subY, yOffset + img->h) - yOffset; y < yy; y++) {
+            uint32_t yCoef = y + yOffset - bandY, yInvCoef = subY - yCoef;
+            uint8_t *row = clahe_get_row(img, y, buf);
+            if ((!in_place) && (row != buf)) row = memcpy(buf, row, img->w); // masked grayscale
+
+            for (int tx = 0; tx <= xTileSize; tx++) {
+                int subX = (!tx) ? (xSize >> 1) : ((tx == xTileSize) ? ((xSize + 1) >> 1) : xSize);
+                int bandX = (!tx) ? 0 : ((xSize >> 1) + ((tx - 1) * xSize));
+                int xL = IM_MAX(tx - 1, 0), xR = IM_MIN(tx, xTileSize - 1);
+                const uint8_t *lu = lutU + (xL * uiNR_OF_GREY), *ru = lutU + (xR * uiNR_OF_GREY);
+                const uint8_t *lb = lutB + (xL * uiNR_OF_GREY), *rb = lutB + (xR * uiNR_OF_GREY);
+                uint32_t mul = divs[tx].mul;
+                int shift = divs[tx].shift;
+
+                for (int x = IM_MAX(bandX, xOffset) - xOffset,
+                     xx = IM_MIN(bandX + subX, xOffset + img->w) - xOffset; x < xx; x++) {
+                    uint32_t xCoef = x + xOffset - bandX, xInvCoef = subX - xCoef;
+                    int g = row[x];
+                    uint32_t v = (yInvCoef * ((xInvCoef * lu[g]) + (xCoef * ru[g])))
+                               + (yCoef * ((xInvCoef * lb[g]) + (xCoef * rb[g])));
+                    row[x] = (((uint64_t) v) * mul) >> shift;
                 }
             }
-            break;
-        }
-        default: {
-            break;
+
+            if (!in_place) clahe_put_row(img, y, row, mask);
         }
     }
 
-    fb_free();
+    fb_free(); // buf
+    fb_free(); // divs
+    fb_free(); // luts
+    fb_free(); // hist
 }
@@ -231,7 +231,7 @@ void list_free(list_t *ptr)
 {
     for (list_lnk_t *i = ptr->head_ptr; i; ) {
         list_lnk_t *j = i->next_ptr;
-        xfree(i);
+        xfree_arena(i);
         i = j;
     }
 }
@@ -252,7 +252,7 @@ size_t list_size(list_t *ptr)
 
 void list_push_front(list_t *ptr, void *data)
 {
-    list_lnk_t *tmp = (list_lnk_t *) xalloc(sizeof(list_lnk_t) + ptr->data_len);
+    list_lnk_t *tmp = (list_lnk_t *) xalloc_arena(sizeof(list_lnk_t) + ptr->data_len);
     memcpy(tmp->data, data, ptr->data_len);
 
     if (ptr->size++) {
@@ -270,7 +270,7 @@ void list_push_front(list_t *ptr, void *data)
 
 void list_push_back(list_t *ptr, void *data)
 {
-    list_lnk_t *tmp = (list_lnk_t *) xalloc(sizeof(list_lnk_t) + ptr->data_len);
+    list_lnk_t *tmp = (list_lnk_t *) xalloc_arena(sizeof(list_lnk_t) + ptr->data_len);
     memcpy(tmp->data, data, ptr->data_len);
 
     if (ptr->size++) {
@@ -298,7 +298,7 @@ void list_pop_front(list_t *ptr, void *data)
 	}
 	ptr->head_ptr = tmp->next_ptr;
     ptr->size -= 1;
-    xfree(tmp);
+    xfree_arena(tmp);
 }
 
 void list_pop_back(list_t *ptr, void *data)
@@ -312,7 +312,7 @@ void list_pop_back(list_t *ptr, void *data)
     tmp->prev_ptr->next_ptr = NULL;
     ptr->tail_ptr = tmp->prev_ptr;
     ptr->size -= 1;
-    xfree(tmp);
+    xfree_arena(tmp);
 }
 
 void list_get_front(list_t *ptr, void *data)
@@ -350,7 +350,7 @@ void list_insert(list_t *ptr, void *data, size_t index)
             index -= 1;
         }
 
-        list_lnk_t *tmp = (list_lnk_t *) xalloc(sizeof(list_lnk_t) + ptr->data_len);
+        list_lnk_t *tmp = (list_lnk_t *) xalloc_arena(sizeof(list_lnk_t) + ptr->data_len);
         memcpy(tmp->data, data, ptr->data_len);
 
         tmp->next_ptr = i;
@@ -369,7 +369,7 @@ void list_insert(list_t *ptr, void *data, size_t index)
             index -= 1;
         }
 
-        list_lnk_t *tmp = (list_lnk_t *) xalloc(sizeof(list_lnk_t) + ptr->data_len);
+        list_lnk_t *tmp = (list_lnk_t *) xalloc_arena(sizeof(list_lnk_t) + ptr->data_len);
         memcpy(tmp->data, data, ptr->data_len);
 
         tmp->next_ptr = i;
@@ -402,7 +402,7 @@ void list_remove(list_t *ptr, void *data, size_t index)
         i->prev_ptr->next_ptr = i->next_ptr;
         i->next_ptr->prev_ptr = i->prev_ptr;
         ptr->size -= 1;
-        xfree(i);
+        xfree_arena(i);
 
     } else {
 
@@ -421,7 +421,7 @@ void list_remove(list_t *ptr, void *data, size_t index)
         i->prev_ptr->next_ptr = i->next_ptr;
         i->next_ptr->prev_ptr = i->prev_ptr;
         ptr->size -= 1;
-        xfree(i);
+        xfree_arena(i);
     }
 }
 
@@ -0,0 +1,132 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Bilinear demosaic of raw Bayer frames.
+ *
+ * Raw frames are BGGR: even rows are B G B G ..., odd rows G R G R .... The missing colors of
+ * a pixel are the means of its 2 or 4 nearest neighbours of that color, with the frame edges
+ * mirrored so every pixel has them. The means are floored halving adds of byte lanes, 4 pixels
+ * to a word (UHADD8 on the Cortex-M7, the same bit trick elsewhere): each row gets the means of
+ * the rows above and below it once, then the colors of 4 pixels are picked by column parity
+ * from their own, vertical, horizontal, cross and diagonal means and packed to grayscale or
+ * RGB565. Only the pixels of the ROI asked for are demosaiced.
+ */
+#include "imlib.h"
+#include "fb_alloc.h"
+
+#if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+#define DEBAYER_HADD8(a, b) __UHADD8((a), (b))
+#else
+// a + b = 2 * (a & b) + (a ^ b), without the bits shifted into the next lane.
+#define DEBAYER_HADD8(a, b) (((a) & (b)) + ((((a) ^ (b)) >> 1) & 0x7F7F7F7F))
+#endif
+
+// Lanes of m from a, the others from b.
+#define DEBAYER_SEL(m, a, b) (((a) & (m)) | ((b) & ~(m)))
+
+// (x * n + 127) / 255 of the 8 bit values in the low bytes of the halfword lanes, the rounding
+// of rb825_table and g826_table: x / 255 = (x + 1 + (x / 256)) / 256 while x < 65535.
+static inline uint32_t debayer_scale(uint32_t x, uint32_t n)
+{
+    x = (x * n) + 0x007F007F;
+    return ((x + 0x00010001 + ((x >> 8) & 0x00FF00FF)) >> 8) & 0x003F003F;
+}
+
+// Byte swapped RGB565 of the 8 bit colors in the low bytes of the halfword lanes.
+static inline uint32_t debayer_rgb565(uint32_t r, uint32_t g, uint32_t b)
+{
+    r = debayer_scale(r, 31);
+    g = debayer_scale(g, 63);
+    b = debayer_scale(b, 31);
+    return (r << 3) | ((g >> 3) & 0x00070007) | ((g & 0x00070007) << 13) | (b << 8);
+}
+
+// Pixels x - 1 to x + w of row y, rows and columns out of the frame mirrored.
+static void debayer_row(uint8_t *dst, image_t *src, int x, int y, int w)
+{
+    y = (y < 0) ? 1 : ((y >= src->h) ? (src->h - 2) : y);
+    const uint8_t *row_ptr = src->data + (IM_MAX(IM_MIN(y, src->h - 1), 0) * src->w);
+
+    memcpy(dst + 1, row_ptr + x, w);
+    dst[0] = row_ptr[(x > 0) ? (x - 1) : IM_MIN(1, src->w - 1)];
+    dst[w + 1] = row_ptr[((x + w) < src->w) ? (x + w) : IM_MAX(src->w - 2, 0)];
+}
+
+void imlib_debayer(image_t *dst, image_t *src, rectangle_t *roi)
+{
+    OMV_PROF_SCOPE("imlib_debayer");
+    int w = roi->w;
+    // The 2 mirrored pixels and the last word read past them.
+    int len = ((w + 2 + 3) & ~3) + 4;
+    uint8_t *rows = fb_alloc0(len * 4, FB_ALLOC_PREFER_SPEED);
+    uint8_t *up = rows, *cur = rows + len, *down = rows + (len * 2), *v = rows + (len * 3);
+    // Lanes of the even columns, the lanes of a word start at the parity of roi->x.
+    uint32_t even = (roi->x & 1) ? 0xFF00FF00 : 0x00FF00FF;
+
+    debayer_row(up, src, roi->x, roi->y - 1, w);
+    debayer_row(cur, src, roi->x, roi->y, w);
+
+    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+        debayer_row(down, src, roi->x, y + 1, w);
+
+        for (int i = 0; i < len; i += 4) {
+            *((uint32_t *) (v + i)) = DEBAYER_HADD8(*((uint32_t *) (up + i)), *((uint32_t *) (down + i)));
+        }
+
+        for (int x = 0; x < w; x += 4) {
+            // Lane i is pixel roi->x + x + i, at x + i + 1 of the rows.
+            uint32_t c = __UNALIGNED_UINT32_READ(cur + x + 1);
+            uint32_t vc = __UNALIGNED_UINT32_READ(v + x + 1);
+            uint32_t hm = DEBAYER_HADD8(__UNALIGNED_UINT32_READ(cur + x), __UNALIGNED_UINT32_READ(cur + x + 2));
+            uint32_t dm = DEBAYER_HADD8(__UNALIGNED_UINT32_READ(v + x), __UNALIGNED_UINT32_READ(v + x + 2));
+            uint32_t xm = DEBAYER_HADD8(hm, vc);
+            uint32_t r, g, b;
+
+            if (y & 1) { // G R G R
+                r = DEBAYER_SEL(even, hm, c);
+                g = DEBAYER_SEL(even, c, xm);
+                b = DEBAYER_SEL(even, vc, dm);
+            } else { // B G B G
+                r = DEBAYER_SEL(even, dm, vc);
+                g = DEBAYER_SEL(even, xm, c);
+                b = DEBAYER_SEL(even, c, hm);
+            }
+
+            uint32_t out[2];
+            int n = IM_MIN(w - x, 4);
+
+            if (dst->bpp == IMAGE_BPP_GRAYSCALE) {
+                // Y = (38 R + 75 G + 15 B) / 128 in halfword lanes, lanes 0 and 2 then 1 and 3.
+                uint32_t y02 = ((r & 0x00FF00FF) * 38) + ((g & 0x00FF00FF) * 75) + ((b & 0x00FF00FF) * 15);
+                uint32_t y13 = (((r >> 8) & 0x00FF00FF) * 38) + (((g >> 8) & 0x00FF00FF) * 75) + (((b >> 8) & 0x00FF00FF) * 15);
+                out[0] = ((y02 >> 7) & 0x00FF00FF) | ((y13 << 1) & 0xFF00FF00);
+                uint8_t *dst_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(dst, y) + roi->x + x;
+                if (n == 4) {
+                    __UNALIGNED_UINT32_WRITE(dst_ptr, out[0]);
+                } else {
+                    memcpy(dst_ptr, out, n);
+                }
+            } else {
+                uint32_t p02 = debayer_rgb565(r & 0x00FF00FF, g & 0x00FF00FF, b & 0x00FF00FF);
+                uint32_t p13 = debayer_rgb565((r >> 8) & 0x00FF00FF, (g >> 8) & 0x00FF00FF, (b >> 8) & 0x00FF00FF);
+                out[0] = (p02 & 0xFFFF) | (p13 << 16);
+                out[1] = (p02 >> 16) | (p13 & 0xFFFF0000);
+                uint16_t *dst_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst, y) + roi->x + x;
+                if (n == 4) {
+                    __UNALIGNED_UINT32_WRITE(dst_ptr, out[0]);
+                    __UNALIGNED_UINT32_WRITE(dst_ptr + 2, out[1]);
+                } else {
+                    memcpy(dst_ptr, out, n * sizeof(uint16_t));
+                }
+            }
+        }
+
+        uint8_t *t = up;
+        up = cur;
+        cur = down;
+        down = t;
+    }
+
+    fb_free(); // rows
+}
@@ -7,6 +7,7 @@
 #include "fmath.h"
 #include <stdio.h>
 #include "imlib.h"
+#include "systick.h"
 #ifdef IMLIB_ENABLE_DATAMATRICES
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-variable"
@@ -6261,27 +6262,47 @@ dmtxMatrix3Print(DmtxMatrix3 m)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, int effort)
+// Number of scan locations between two checks of the timeout.
+#define DMTX_TIMEOUT_STEP 32
+
+// Same as dmtxRegionFindNext() but also gives up once timeout ms have elapsed since start (0 means
+// no timeout). The iteration count carries over between calls so effort caps the whole search.
+static DmtxRegion *dmtxRegionFindNextTimeout(DmtxDecode *dec, int max_iterations, int *current_iterations,
+                                             uint32_t start, int timeout)
 {
-    uint8_t *grayscale_image = (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->data : fb_alloc(roi->w * roi->h, FB_ALLOC_NO_HINT);
-    umm_init_x(fb_avail());
+    for (;;) {
+        int iterations = max_iterations;
 
-    DmtxImage *image = dmtxImageCreate(grayscale_image,
-                                       (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->w : roi->w,
-                                       (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->h : roi->h,
-                                       DmtxPack8bppK);
-    DmtxDecode *decode = dmtxDecodeCreate(image, 1);
-    dmtxDecodeSetProp(decode, DmtxPropXmin, (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? roi->x : 0);
-    dmtxDecodeSetProp(decode, DmtxPropYmin, (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? roi->y : 0);
-    dmtxDecodeSetProp(decode, DmtxPropXmax, ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? roi->x : 0) + (roi->w - 1));
-    dmtxDecodeSetProp(decode, DmtxPropYmax, ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? roi->y : 0) + (roi->h - 1));
+        if (timeout > 0) {
+            if ((systick_current_millis() - start) >= ((uint32_t) timeout)) {
+                return NULL;
+            }
+
+            iterations = IM_MIN(max_iterations, *current_iterations + DMTX_TIMEOUT_STEP);
+        }
+
+        DmtxRegion *region = dmtxRegionFindNext(dec, iterations, current_iterations);
+
+        // Stop on a region, at the end of the scan grid or when the effort is used up.
+        if (region || (*current_iterations < iterations) || (iterations == max_iterations)) {
+            return region;
+        }
+    }
+}
+
+void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, int effort, bool locate, int timeout)
+{
+    OMV_PROF_SCOPE("imlib_find_datamatrices");
+    uint32_t start = systick_current_millis();
+    uint8_t *grayscale_image = (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->data : fb_alloc(roi->w * roi->h, FB_ALLOC_NO_HINT);
+    uint8_t *grayscale_image_tmp = grayscale_image;
 
     switch (ptr->bpp) {
         case IMAGE_BPP_BINARY: {
             for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
                 uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
                 for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
-                    *(grayscale_image++) = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                    *(grayscale_image_tmp++) = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
                 }
             }
             break;
@@ -6293,7 +6314,7 @@ void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, int ef
             for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
                 uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
                 for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
-                    *(grayscale_image++) = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                    *(grayscale_image_tmp++) = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
                 }
             }
             break;
@@ -6304,76 +6325,120 @@ void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, int ef
         }
     }
 
+    // Grayscale images are decoded in place, the others are copied into a buffer of the roi size.
+    image_t img;
+    rectangle_t img_roi;
+    image_init(&img, (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->w : roi->w,
+                     (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->h : roi->h,
+                     IMAGE_BPP_GRAYSCALE, grayscale_image);
+    rectangle_init(&img_roi, (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? roi->x : 0,
+                             (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? roi->y : 0,
+                             roi->w, roi->h);
+
+    list_t rois;
+
+    if (locate) {
+        imlib_find_symbol_rois(&rois, &img, &img_roi);
+    } else {
+        list_init(&rois, sizeof(rectangle_t));
+        list_push_back(&rois, &img_roi);
+    }
+
     list_init(out, sizeof(find_datamatrices_list_lnk_data_t));
 
+    if (!list_size(&rois)) {
+        list_free(&rois);
+        if (ptr->bpp != IMAGE_BPP_GRAYSCALE) fb_free(); // grayscale_image;
+        return;
+    }
+
+    umm_init_x(fb_avail());
+
+    DmtxImage *image = dmtxImageCreate(grayscale_image, img.w, img.h, DmtxPack8bppK);
+    DmtxDecode *decode = dmtxDecodeCreate(image, 1);
+
     int max_iterations = effort;
     int current_iterations = 0;
-    for (DmtxRegion *region = dmtxRegionFindNext(decode, max_iterations, &current_iterations); region; region = dmtxRegionFindNext(decode, max_iterations, &current_iterations)) {
-        DmtxMessage *message = dmtxDecodeMatrixRegion(decode, region, DmtxUndefined);
 
-        if (message) {
-            find_datamatrices_list_lnk_data_t lnk_data;
+    while (list_size(&rois)) {
+        rectangle_t lnk_roi;
+        list_pop_front(&rois, &lnk_roi);
 
-            DmtxVector2 p[4];
+        // Scan limits are in libdmtx coordinates which have y pointing up.
+        dmtxDecodeSetProp(decode, DmtxPropXmin, lnk_roi.x);
+        dmtxDecodeSetProp(decode, DmtxPropYmin, img.h - (lnk_roi.y + lnk_roi.h));
+        dmtxDecodeSetProp(decode, DmtxPropXmax, lnk_roi.x + (lnk_roi.w - 1));
+        dmtxDecodeSetProp(decode, DmtxPropYmax, img.h - 1 - lnk_roi.y);
 
-            p[0].X = p[0].Y = p[1].Y = p[3].X = 0.0;
-            p[1].X = p[3].Y = p[2].X = p[2].Y = 1.0;
+        for (DmtxRegion *region = dmtxRegionFindNextTimeout(decode, max_iterations, &current_iterations, start, timeout); region; region = dmtxRegionFindNextTimeout(decode, max_iterations, &current_iterations, start, timeout)) {
+            DmtxMessage *message = dmtxDecodeMatrixRegion(decode, region, DmtxUndefined);
 
-            dmtxMatrix3VMultiplyBy(&p[0], region->fit2raw);
-            dmtxMatrix3VMultiplyBy(&p[1], region->fit2raw);
-            dmtxMatrix3VMultiplyBy(&p[2], region->fit2raw);
-            dmtxMatrix3VMultiplyBy(&p[3], region->fit2raw);
+            if (message) {
+                find_datamatrices_list_lnk_data_t lnk_data;
 
-            int height = dmtxDecodeGetProp(decode, DmtxPropHeight);
+                DmtxVector2 p[4];
 
-            rectangle_init(&(lnk_data.rect),
-                           fast_roundf(p[0].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x),
-                           height - 1 - fast_roundf(p[0].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y),
-                           0,
-                           0);
+                p[0].X = p[0].Y = p[1].Y = p[3].X = 0.0;
+                p[1].X = p[3].Y = p[2].X = p[2].Y = 1.0;
 
-            for (size_t k = 1, l = (sizeof(p) / sizeof(p[0])); k < l; k++) {
-                rectangle_t temp;
-                rectangle_init(&temp,
-                               fast_roundf(p[k].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x),
-                               height - 1 - fast_roundf(p[k].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y),
+                dmtxMatrix3VMultiplyBy(&p[0], region->fit2raw);
+                dmtxMatrix3VMultiplyBy(&p[1], region->fit2raw);
+                dmtxMatrix3VMultiplyBy(&p[2], region->fit2raw);
+                dmtxMatrix3VMultiplyBy(&p[3], region->fit2raw);
+
+                int height = dmtxDecodeGetProp(decode, DmtxPropHeight);
+
+                rectangle_init(&(lnk_data.rect),
+                               fast_roundf(p[0].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x),
+                               height - 1 - fast_roundf(p[0].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y),
                                0,
                                0);
-                rectangle_united(&(lnk_data.rect), &temp);
+
+                for (size_t k = 1, l = (sizeof(p) / sizeof(p[0])); k < l; k++) {
+                    rectangle_t temp;
+                    rectangle_init(&temp,
+                                   fast_roundf(p[k].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x),
+                                   height - 1 - fast_roundf(p[k].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y),
+                                   0,
+                                   0);
+                    rectangle_united(&(lnk_data.rect), &temp);
+                }
+
+                // Add corners...
+                lnk_data.corners[0].x =              fast_roundf(p[3].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x); // top-left
+                lnk_data.corners[0].y = height - 1 - fast_roundf(p[3].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y); // top-left
+                lnk_data.corners[1].x =              fast_roundf(p[2].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x); // top-right
+                lnk_data.corners[1].y = height - 1 - fast_roundf(p[2].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y); // top-right
+                lnk_data.corners[2].x =              fast_roundf(p[1].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x); // bottom-right
+                lnk_data.corners[2].y = height - 1 - fast_roundf(p[1].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y); // bottom-right
+                lnk_data.corners[3].x =              fast_roundf(p[0].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x); // bottom-left
+                lnk_data.corners[3].y = height - 1 - fast_roundf(p[0].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y); // bottom-left
+
+                // Payload is NOT already null terminated.
+                lnk_data.payload_len = message->outputIdx;
+                lnk_data.payload = xalloc(message->outputIdx);
+                memcpy(lnk_data.payload, message->output, message->outputIdx);
+
+                int rotate = fast_roundf((((2 * M_PI) + fast_atan2f(p[1].Y - p[0].Y, p[1].X - p[0].X)) * 180) / M_PI);
+                if(rotate >= 360) rotate -= 360;
+
+                lnk_data.rotation = rotate;
+                lnk_data.rows = dmtxGetSymbolAttribute(DmtxSymAttribSymbolRows, region->sizeIdx);
+                lnk_data.columns = dmtxGetSymbolAttribute(DmtxSymAttribSymbolCols, region->sizeIdx);
+                lnk_data.capacity = dmtxGetSymbolAttribute(DmtxSymAttribSymbolDataWords, region->sizeIdx);
+                lnk_data.padding = message->padCount;
+
+                list_push_back(out, &lnk_data);
+
+                dmtxMessageDestroy(&message);
             }
 
-            // Add corners...
-            lnk_data.corners[0].x =              fast_roundf(p[3].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x); // top-left
-            lnk_data.corners[0].y = height - 1 - fast_roundf(p[3].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y); // top-left
-            lnk_data.corners[1].x =              fast_roundf(p[2].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x); // top-right
-            lnk_data.corners[1].y = height - 1 - fast_roundf(p[2].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y); // top-right
-            lnk_data.corners[2].x =              fast_roundf(p[1].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x); // bottom-right
-            lnk_data.corners[2].y = height - 1 - fast_roundf(p[1].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y); // bottom-right
-            lnk_data.corners[3].x =              fast_roundf(p[0].X) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x); // bottom-left
-            lnk_data.corners[3].y = height - 1 - fast_roundf(p[0].Y) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y); // bottom-left
-
-            // Payload is NOT already null terminated.
-            lnk_data.payload_len = message->outputIdx;
-            lnk_data.payload = xalloc(message->outputIdx);
-            memcpy(lnk_data.payload, message->output, message->outputIdx);
-
-            int rotate = fast_roundf((((2 * M_PI) + fast_atan2f(p[1].Y - p[0].Y, p[1].X - p[0].X)) * 180) / M_PI);
-            if(rotate >= 360) rotate -= 360;
-
-            lnk_data.rotation = rotate;
-            lnk_data.rows = dmtxGetSymbolAttribute(DmtxSymAttribSymbolRows, region->sizeIdx);
-            lnk_data.columns = dmtxGetSymbolAttribute(DmtxSymAttribSymbolCols, region->sizeIdx);
-            lnk_data.capacity = dmtxGetSymbolAttribute(DmtxSymAttribSymbolDataWords, region->sizeIdx);
-            lnk_data.padding = message->padCount;
-
-            list_push_back(out, &lnk_data);
-
-            dmtxMessageDestroy(&message);
+            dmtxRegionDestroy(&region);
         }
-
-        dmtxRegionDestroy(&region);
     }
 
+    list_free(&rois);
+
     dmtxDecodeDestroy(&decode);
     dmtxImageDestroy(&image);
 
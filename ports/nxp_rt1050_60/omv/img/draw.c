@@ -5,6 +5,9 @@
 
 #include "font.h"
 #include "imlib.h"
+#ifdef IMLIB_ENABLE_PXP
+#include "pxp_2d.h"
+#endif
 
 // Get pixel (handles boundary check and image type check).
 int imlib_get_pixel(image_t *img, int x, int y)
@@ -53,15 +56,75 @@ void imlib_set_pixel(image_t *img, int x, int y, int p)
     }
 }
 
+// Fill [x0, x1] of row y, both already clipped to the image.
+static void span_fill(image_t *img, int x0, int x1, int y, int c)
+{
+    switch(img->bpp) {
+        case IMAGE_BPP_BINARY: {
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+            int i0 = x0 >> UINT32_T_SHIFT, i1 = x1 >> UINT32_T_SHIFT;
+            uint32_t m0 = 0xFFFFFFFF << (x0 & UINT32_T_MASK);
+            uint32_t m1 = 0xFFFFFFFF >> (UINT32_T_MASK - (x1 & UINT32_T_MASK));
+            uint32_t v = (c & 1) ? 0xFFFFFFFF : 0;
+            if (i0 == i1) {
+                m0 &= m1;
+            } else {
+                for (int i = i0 + 1; i < i1; i++) row_ptr[i] = v;
+                row_ptr[i1] = (row_ptr[i1] & ~m1) | (v & m1);
+            }
+            row_ptr[i0] = (row_ptr[i0] & ~m0) | (v & m0);
+            break;
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            memset(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y) + x0, c, x1 - x0 + 1);
+            break;
+        }
+        case IMAGE_BPP_RGB565: {
+            uint16_t *ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y) + x0;
+            uint16_t *end = ptr + (x1 - x0 + 1);
+            // Two pixels per 32-bit store once aligned.
+            if ((((uintptr_t) ptr) & 2) && (ptr < end)) *ptr++ = c;
+            uint32_t c2 = (c & 0xFFFF) | (c << 16);
+            for (; (end - ptr) >= 2; ptr += 2) *((uint32_t *) ptr) = c2;
+            if (ptr < end) *ptr = c;
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+// Fill a rectangle, clipped to the image once and then drawn as row spans.
+static void rect_fill(image_t *img, int x, int y, int w, int h, int c)
+{
+    int x0 = IM_MAX(x, 0), x1 = IM_MIN(x + w, img->w) - 1;
+    int y0 = IM_MAX(y, 0), y1 = IM_MIN(y + h, img->h) - 1;
+
+    if (x0 <= x1) {
+        for (; y0 <= y1; y0++) {
+            span_fill(img, x0, x1, y0, c);
+        }
+    }
+}
+
 // https://stackoverflow.com/questions/1201200/fast-algorithm-for-drawing-filled-circles
 static void point_fill(image_t *img, int cx, int cy, int r0, int r1, int c)
 {
+    if (!r0 && !r1) {
+        imlib_set_pixel(img, cx + r0, cy + r0, c);
+        return;
+    }
+
+    // Each row of the disc (x * x) + (y * y) <= (r0 * r0) boxed by [r0, r1] is one span.
     for (int y = r0; y <= r1; y++) {
-        for (int x = r0; x <= r1; x++) {
-            if (((x * x) + (y * y)) <= (r0 * r0)) {
-                imlib_set_pixel(img, cx + x, cy + y, c);
-            }
-        }
+        int d = (r0 * r0) - (y * y);
+        if (d < 0) continue;
+        int w = fast_floorf(fast_sqrtf(d));
+        while (((w + 1) * (w + 1)) <= d) w++;
+        while ((w * w) > d) w--;
+        int x0 = IM_MAX(r0, -w), x1 = IM_MIN(r1, w);
+        rect_fill(img, cx + x0, cy + y, x1 - x0 + 1, 1, c);
     }
 }
 
@@ -87,37 +150,28 @@ void imlib_draw_line(image_t *img, int x0, int y0, int x1, int y1, int c, int th
 
 static void xLine(image_t *img, int x1, int x2, int y, int c)
 {
-    while (x1 <= x2) imlib_set_pixel(img, x1++, y, c);
+    rect_fill(img, x1, y, x2 - x1 + 1, 1, c);
 }
 
 static void yLine(image_t *img, int x, int y1, int y2, int c)
 {
-    while (y1 <= y2) imlib_set_pixel(img, x, y1++, c);
+    rect_fill(img, x, y1, 1, y2 - y1 + 1, c);
 }
 
 void imlib_draw_rectangle(image_t *img, int rx, int ry, int rw, int rh, int c, int thickness, bool fill)
 {
     if (fill) {
-
-        for (int y = ry, yy = ry + rh; y < yy; y++) {
-            for (int x = rx, xx = rx + rw; x < xx; x++) {
-                imlib_set_pixel(img, x, y, c);
-            }
-        }
-
+        rect_fill(img, rx, ry, rw, rh, c);
     } else if (thickness > 0) {
         int thickness0 = (thickness - 0) / 2;
         int thickness1 = (thickness - 1) / 2;
+        int k = ry + rh - 1, l = rx + rw - 1;
 
-        for (int i = rx - thickness0, j = rx + rw + thickness1, k = ry + rh - 1; i < j; i++) {
-            yLine(img, i, ry - thickness0, ry + thickness1, c);
-            yLine(img, i, k - thickness0, k + thickness1, c);
-        }
-
-        for (int i = ry - thickness0, j = ry + rh + thickness1, k = rx + rw - 1; i < j; i++) {
-            xLine(img, rx - thickness0, rx + thickness1, i, c);
-            xLine(img, k - thickness0, k + thickness1, i, c);
-        }
+        // Top, bottom, left and right bands.
+        rect_fill(img, rx - thickness0, ry - thickness0, rw + thickness0 + thickness1, thickness, c);
+        rect_fill(img, rx - thickness0, k - thickness0, rw + thickness0 + thickness1, thickness, c);
+        rect_fill(img, rx - thickness0, ry - thickness0, thickness, rh + thickness0 + thickness1, c);
+        rect_fill(img, l - thickness0, ry - thickness0, thickness, rh + thickness0 + thickness1, c);
     }
 }
 
@@ -288,11 +342,48 @@ void imlib_draw_ellipse(image_t *img, int cx, int cy, int rx, int ry, int rotati
     scratch_draw_rotated_ellipse(img, cx, cy, rx * 2, ry * 2, r, fill, c, thickness);
 }
 
+// Where each glyph column and row starts once scaled, for the last scale drawn. Column c
+// covers [x[c], x[c + 1]) of a scaled glyph, the pixels with floor(x / scale) == c.
+typedef struct glyph_scale {
+    float scale;
+    int w, h, xx, yy;
+    int16_t x[8 + 1];
+    int16_t y[sizeof(((glyph_t *) 0)->data) + 1];
+} glyph_scale_t;
+
+static glyph_scale_t glyph_scale;
+
+static const glyph_scale_t *glyph_scale_get(const glyph_t *g, float scale)
+{
+    glyph_scale_t *gs = &glyph_scale;
+
+    if ((gs->scale != scale) || (gs->w != g->w) || (gs->h != g->h) || (!gs->w)) {
+        gs->scale = scale;
+        gs->w = g->w;
+        gs->h = g->h;
+        gs->xx = fast_floorf(g->w * scale);
+        gs->yy = fast_floorf(g->h * scale);
+
+        for (int i = 0, x = 0; i <= g->w; i++) {
+            while ((x < gs->xx) && (fast_floorf(x / scale) < i)) x++;
+            gs->x[i] = x;
+        }
+
+        for (int i = 0, y = 0; i <= g->h; i++) {
+            while ((y < gs->yy) && (fast_floorf(y / scale) < i)) y++;
+            gs->y[i] = y;
+        }
+    }
+
+    return gs;
+}
+
 // char rotation == 0, 90, 180, 360, etc.
 // string rotation == 0, 90, 180, 360, etc.
 void imlib_draw_string(image_t *img, int x_off, int y_off, const char *str, int c, float scale, int x_spacing, int y_spacing, bool mono_space,
                        int char_rotation, bool char_hmirror, bool char_vflip, int string_rotation, bool string_hmirror, bool string_vflip)
 {
+    OMV_PROF_SCOPE("imlib_draw_string");
     char_rotation %= 360;
     if (char_rotation < 0) char_rotation += 360;
     char_rotation = (char_rotation / 90) * 90;
@@ -362,13 +453,41 @@ void imlib_draw_string(image_t *img, int x_off, int y_off, const char *str, int
         }
         }
 
-        for (int y = 0, yy = fast_floorf(g->h * scale); y < yy; y++) {
-            for (int x = 0, xx = fast_floorf(g->w * scale); x < xx; x++) {
-                if (g->data[fast_floorf(y / scale)] & (1 << (g->w - 1 - fast_floorf(x / scale)))) {
-                    int16_t x_tmp = x_off + (char_hmirror ? (xx - x - 1) : x), y_tmp = y_off + (char_vflip ? (yy - y - 1) : y);
-                    point_rotate(x_tmp, y_tmp, IM_DEG2RAD(char_rotation), x_off + (xx / 2), y_off + (yy / 2), &x_tmp, &y_tmp);
-                    point_rotate(x_tmp, y_tmp, IM_DEG2RAD(string_rotation), org_x_off, org_y_off, &x_tmp, &y_tmp);
-                    imlib_set_pixel(img, x_tmp, y_tmp, c);
+        const glyph_scale_t *gs = glyph_scale_get(g, scale);
+        int xx = gs->xx, yy = gs->yy;
+
+        if ((!char_rotation) && (!string_rotation)) {
+            // Each run of set bits in a glyph row, over the rows repeating it, is one rectangle.
+            for (int r = 0, r_end; r < g->h; r = r_end) {
+                int bits = g->data[r];
+                for (r_end = r + 1; (r_end < g->h) && (g->data[r_end] == bits); r_end++);
+                int y0 = char_vflip ? (yy - gs->y[r_end]) : gs->y[r];
+                int y1 = char_vflip ? (yy - gs->y[r]) : gs->y[r_end];
+
+                for (int i = 0, i_end; i < g->w; i = i_end) {
+                    if (!(bits & (1 << (g->w - 1 - i)))) {
+                        i_end = i + 1;
+                        continue;
+                    }
+
+                    for (i_end = i + 1; (i_end < g->w) && (bits & (1 << (g->w - 1 - i_end))); i_end++);
+                    int x0 = char_hmirror ? (xx - gs->x[i_end]) : gs->x[i];
+                    int x1 = char_hmirror ? (xx - gs->x[i]) : gs->x[i_end];
+                    rect_fill(img, x_off + x0, y_off + y0, x1 - x0, y1 - y0, c);
+                }
+            }
+        } else {
+            for (int r = 0; r < g->h; r++) {
+                for (int y = gs->y[r]; y < gs->y[r + 1]; y++) {
+                    for (int i = 0; i < g->w; i++) {
+                        if (!(g->data[r] & (1 << (g->w - 1 - i)))) continue;
+                        for (int x = gs->x[i]; x < gs->x[i + 1]; x++) {
+                            int16_t x_tmp = x_off + (char_hmirror ? (xx - x - 1) : x), y_tmp = y_off + (char_vflip ? (yy - y - 1) : y);
+                            point_rotate(x_tmp, y_tmp, IM_DEG2RAD(char_rotation), x_off + (xx / 2), y_off + (yy / 2), &x_tmp, &y_tmp);
+                            point_rotate(x_tmp, y_tmp, IM_DEG2RAD(string_rotation), org_x_off, org_y_off, &x_tmp, &y_tmp);
+                            imlib_set_pixel(img, x_tmp, y_tmp, c);
+                        }
+                    }
                 }
             }
         }
@@ -469,10 +588,23 @@ static int safe_map_pixel(image_t *dst, image_t *src, int pixel)
     }
 }
 
-void imlib_draw_image(image_t *img, image_t *other, int x_off, int y_off, float x_scale, float y_scale, float alpha, image_t *mask)
+void imlib_draw_image(image_t *img, image_t *other, int x_off, int y_off, float x_scale, float y_scale, float alpha, image_t *mask, int hint)
 {
+    OMV_PROF_SCOPE("imlib_draw_image");
     float over_xscale = IM_DIV(1.0, x_scale), over_yscale = IM_DIV(1.0f, y_scale), beta = 1 - alpha;
 
+#ifdef IMLIB_ENABLE_PXP
+    if ((!mask) && (alpha == 1) && (other->data != img->data)) {
+        rectangle_t roi;
+        rectangle_init(&roi, x_off, y_off, fast_floorf(other->w * x_scale), fast_floorf(other->h * y_scale));
+        // The PXP scaler is bilinear, it only scales when asked to so both paths give the same pixels.
+        bool same_size = (roi.w == other->w) && (roi.h == other->h);
+        if ((same_size || (hint & IMAGE_HINT_BILINEAR)) && (pxp_2d_blit(other, NULL, img, &roi, 0) == 0)) {
+            return;
+        }
+    }
+#endif
+
     for (int y = 0, yy = fast_floorf(other->h * y_scale); y < yy; y++) {
         int other_y = fast_floorf(y * over_yscale);
 
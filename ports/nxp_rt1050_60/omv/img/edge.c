@@ -20,6 +20,7 @@ typedef struct gvec {
 
 void imlib_edge_simple(image_t *src, rectangle_t *roi, int low_thresh, int high_thresh)
 {
+    OMV_PROF_SCOPE("imlib_edge_simple");
     imlib_morph(src, 1, kernel_high_pass_3, 1.0f, 0.0f, false, 0, false, NULL);
     list_t thresholds;
     list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
@@ -34,6 +35,7 @@ void imlib_edge_simple(image_t *src, rectangle_t *roi, int low_thresh, int high_
 
 void imlib_edge_canny(image_t *src, rectangle_t *roi, int low_thresh, int high_thresh)
 {
+    OMV_PROF_SCOPE("imlib_edge_canny");
     int w = src->w;
 
     gvec_t *gm = fb_alloc0(roi->w*roi->h*sizeof*gm, FB_ALLOC_NO_HINT);
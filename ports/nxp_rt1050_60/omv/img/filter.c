@@ -3,11 +3,11 @@
  * This work is licensed under the MIT license, see the file LICENSE for details.
  */
 
-#include "fsort.h"
 #include "imlib.h"
 
 void imlib_histeq(image_t *img, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_histeq");
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
             int a = img->w * img->h;
@@ -116,8 +116,56 @@ void imlib_histeq(image_t *img, image_t *mask)
 // ksize == n -> ((n*2)+1)x((n*2)+1) kernel
 
 #ifdef IMLIB_ENABLE_MEAN
+// Adds (d = 1) or removes (d = -1) row y to the column sums (one per channel for RGB565).
+static void imlib_mean_filter_acc_row(image_t *img, uint32_t *cols, int y, int d)
+{
+    switch(img->bpp) {
+        case IMAGE_BPP_BINARY: {
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                cols[x] += d * IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x);
+            }
+            break;
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+            int x = 0, xx = img->w;
+#if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+            for (; (x + 3) < xx; x += 4) { // Four pixels per load...
+                uint32_t pixels = *((uint32_t *) (row_ptr + x));
+                uint32_t pixels_even = __UXTB16(pixels); // pixels 0 and 2
+                uint32_t pixels_odd = __UXTB16(__ROR(pixels, 8)); // pixels 1 and 3
+                cols[x + 0] += d * ((int) (pixels_even & 0xFFFF));
+                cols[x + 1] += d * ((int) (pixels_odd & 0xFFFF));
+                cols[x + 2] += d * ((int) (pixels_even >> 16));
+                cols[x + 3] += d * ((int) (pixels_odd >> 16));
+            }
+#endif
+            for (; x < xx; x++) {
+                cols[x] += d * IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+            }
+            break;
+        }
+        case IMAGE_BPP_RGB565: {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+            uint32_t *g_cols = cols + img->w, *b_cols = g_cols + img->w;
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+                cols[x] += d * COLOR_RGB565_TO_R5(pixel);
+                g_cols[x] += d * COLOR_RGB565_TO_G6(pixel);
+                b_cols[x] += d * COLOR_RGB565_TO_B5(pixel);
+            }
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
 void imlib_mean_filter(image_t *img, const int ksize, bool threshold, int offset, bool invert, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_mean_filter");
     int brows = ksize + 1;
     image_t buf;
     buf.w = img->w;
@@ -126,32 +174,41 @@ void imlib_mean_filter(image_t *img, const int ksize, bool threshold, int offset
 
     float over_n = 1.0f / (((ksize*2)+1)*((ksize*2)+1));
 
+    // Each window sum is kept up to date from the column sums below it instead of being summed
+    // again for every pixel. Moving down a row adds one row to the column sums and drops another,
+    // moving across a pixel adds one column sum to the window sum and drops another.
+    int channels = (img->bpp == IMAGE_BPP_RGB565) ? 3 : 1;
+    uint32_t *cols = fb_alloc0(img->w * channels * sizeof(uint32_t), FB_ALLOC_PREFER_SPEED);
+    uint32_t *g_cols = cols + img->w, *b_cols = g_cols + img->w;
+
+    for (int j = -ksize; j <= ksize; j++) {
+        imlib_mean_filter_acc_row(img, cols, IM_MIN(IM_MAX(j, 0), (img->h - 1)), 1);
+    }
+
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
-            buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
+            buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_PREFER_SPEED);
 
             for (int y = 0, yy = img->h; y < yy; y++) {
                 uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
                 uint32_t *buf_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows));
 
+                int acc = 0;
+
+                for (int k = -ksize; k <= ksize; k++) {
+                    acc += cols[IM_MIN(IM_MAX(k, 0), (img->w - 1))];
+                }
+
                 for (int x = 0, xx = img->w; x < xx; x++) {
+                    if (x) { // Slide the window sum across...
+                        acc += cols[IM_MIN(x + ksize, (xx - 1))] - cols[IM_MAX(x - ksize - 1, 0)];
+                    }
+
                     if (mask && (!image_get_mask_pixel(mask, x, y))) {
                         IMAGE_PUT_BINARY_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
                         continue; // Short circuit.
                     }
 
-                    int acc = 0;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint32_t *k_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            acc += IMAGE_GET_BINARY_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                        }
-                    }
-
                     int pixel = fast_floorf(acc * over_n);
 
                     if (threshold) {
@@ -165,6 +222,11 @@ void imlib_mean_filter(image_t *img, const int ksize, bool threshold, int offset
                     IMAGE_PUT_BINARY_PIXEL_FAST(buf_row_ptr, x, pixel);
                 }
 
+                if ((y + 1) < yy) { // Move the column sums down before the image row is overwritten...
+                    imlib_mean_filter_acc_row(img, cols, IM_MIN(y + ksize + 1, (yy - 1)), 1);
+                    imlib_mean_filter_acc_row(img, cols, IM_MAX(y - ksize, 0), -1);
+                }
+
                 if (y >= ksize) { // Transfer buffer lines...
                     memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, (y - ksize)),
                            IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
@@ -179,34 +241,32 @@ void imlib_mean_filter(image_t *img, const int ksize, bool threshold, int offset
                        IMAGE_BINARY_LINE_LEN_BYTES(img));
             }
 
-            fb_free();
+            fb_free(); // buf
             break;
         }
         case IMAGE_BPP_GRAYSCALE: {
-            buf.data = fb_alloc(IMAGE_GRAYSCALE_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
+            buf.data = fb_alloc(IMAGE_GRAYSCALE_LINE_LEN_BYTES(img) * brows, FB_ALLOC_PREFER_SPEED);
 
             for (int y = 0, yy = img->h; y < yy; y++) {
                 uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
                 uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
 
+                int acc = 0;
+
+                for (int k = -ksize; k <= ksize; k++) {
+                    acc += cols[IM_MIN(IM_MAX(k, 0), (img->w - 1))];
+                }
+
                 for (int x = 0, xx = img->w; x < xx; x++) {
+                    if (x) { // Slide the window sum across...
+                        acc += cols[IM_MIN(x + ksize, (xx - 1))] - cols[IM_MAX(x - ksize - 1, 0)];
+                    }
+
                     if (mask && (!image_get_mask_pixel(mask, x, y))) {
                         IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x));
                         continue; // Short circuit.
                     }
 
-                    int acc = 0;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint8_t *k_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            acc += IMAGE_GET_GRAYSCALE_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                        }
-                    }
-
                     int pixel = fast_floorf(acc * over_n);
 
                     if (threshold) {
@@ -220,6 +280,11 @@ void imlib_mean_filter(image_t *img, const int ksize, bool threshold, int offset
                     IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, pixel);
                 }
 
+                if ((y + 1) < yy) { // Move the column sums down before the image row is overwritten...
+                    imlib_mean_filter_acc_row(img, cols, IM_MIN(y + ksize + 1, (yy - 1)), 1);
+                    imlib_mean_filter_acc_row(img, cols, IM_MAX(y - ksize, 0), -1);
+                }
+
                 if (y >= ksize) { // Transfer buffer lines...
                     memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, (y - ksize)),
                            IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
@@ -234,37 +299,38 @@ void imlib_mean_filter(image_t *img, const int ksize, bool threshold, int offset
                        IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
             }
 
-            fb_free();
+            fb_free(); // buf
             break;
         }
         case IMAGE_BPP_RGB565: {
-            buf.data = fb_alloc(IMAGE_RGB565_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
+            buf.data = fb_alloc(IMAGE_RGB565_LINE_LEN_BYTES(img) * brows, FB_ALLOC_PREFER_SPEED);
 
             for (int y = 0, yy = img->h; y < yy; y++) {
                 uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
                 uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
 
+                int r_acc = 0, g_acc = 0, b_acc = 0;
+
+                for (int k = -ksize; k <= ksize; k++) {
+                    int col = IM_MIN(IM_MAX(k, 0), (img->w - 1));
+                    r_acc += cols[col];
+                    g_acc += g_cols[col];
+                    b_acc += b_cols[col];
+                }
+
                 for (int x = 0, xx = img->w; x < xx; x++) {
+                    if (x) { // Slide the window sums across...
+                        int col_in = IM_MIN(x + ksize, (xx - 1)), col_out = IM_MAX(x - ksize - 1, 0);
+                        r_acc += cols[col_in] - cols[col_out];
+                        g_acc += g_cols[col_in] - g_cols[col_out];
+                        b_acc += b_cols[col_in] - b_cols[col_out];
+                    }
+
                     if (mask && (!image_get_mask_pixel(mask, x, y))) {
                         IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
                         continue; // Short circuit.
                     }
 
-                    int r_acc = 0, g_acc = 0, b_acc = 0;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint16_t *k_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            int pixel = IMAGE_GET_RGB565_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                            r_acc += COLOR_RGB565_TO_R5(pixel);
-                            g_acc += COLOR_RGB565_TO_G6(pixel);
-                            b_acc += COLOR_RGB565_TO_B5(pixel);
-                        }
-                    }
-
                     int pixel = COLOR_R5_G6_B5_TO_RGB565(fast_floorf(r_acc * over_n),
                                                          fast_floorf(g_acc * over_n),
                                                          fast_floorf(b_acc * over_n));
@@ -280,6 +346,11 @@ void imlib_mean_filter(image_t *img, const int ksize, bool threshold, int offset
                     IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
                 }
 
+                if ((y + 1) < yy) { // Move the column sums down before the image row is overwritten...
+                    imlib_mean_filter_acc_row(img, cols, IM_MIN(y + ksize + 1, (yy - 1)), 1);
+                    imlib_mean_filter_acc_row(img, cols, IM_MAX(y - ksize, 0), -1);
+                }
+
                 if (y >= ksize) { // Transfer buffer lines...
                     memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, (y - ksize)),
                            IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
@@ -294,18 +365,188 @@ void imlib_mean_filter(image_t *img, const int ksize, bool threshold, int offset
                        IMAGE_RGB565_LINE_LEN_BYTES(img));
             }
 
-            fb_free();
+            fb_free(); // buf
             break;
         }
         default: {
             break;
         }
     }
+
+    fb_free(); // cols
 }
 #endif // IMLIB_ENABLE_MEAN
 
-#ifdef IMLIB_ENABLE_MEDIAN
-void imlib_median_filter(image_t *img, const int ksize, float percentile, bool threshold, int offset, bool invert, image_t *mask)
+#if defined(IMLIB_ENABLE_MEDIAN) || defined(IMLIB_ENABLE_MODE) || defined(IMLIB_ENABLE_MIDPOINT)
+// Median, mode and midpoint all only need the histogram of the window. Each channel keeps the
+// histogram of the current window, which is updated by adding the column entering the window
+// and removing the column leaving it as the window moves across a row (O(ksize) per pixel
+// instead of O(ksize^2)). The statistic itself is tracked incrementally too.
+typedef enum hist_filter_op {
+    HIST_FILTER_MEDIAN,
+    HIST_FILTER_MODE,
+    HIST_FILTER_MIDPOINT
+} hist_filter_op_t;
+
+typedef struct hist_filter_channel {
+    int *bins;
+    int bins_len;
+    int value; // median: current percentile value, mode: current mode, midpoint: min
+    int count; // median: pixels below value, mode: pixels equal to value, midpoint: max
+} hist_filter_channel_t;
+
+static void hist_filter_channel_reset(hist_filter_channel_t *ch, hist_filter_op_t op)
+{
+    memset(ch->bins, 0, ch->bins_len * sizeof(int));
+
+    switch (op) {
+        case HIST_FILTER_MIDPOINT: {
+            ch->value = ch->bins_len - 1;
+            ch->count = 0;
+            break;
+        }
+        default: {
+            ch->value = 0;
+            ch->count = 0;
+            break;
+        }
+    }
+}
+
+static inline void hist_filter_channel_add(hist_filter_channel_t *ch, hist_filter_op_t op, int pixel)
+{
+    int count = ++ch->bins[pixel];
+
+    switch (op) {
+        case HIST_FILTER_MEDIAN: {
+            if (pixel < ch->value) ch->count += 1;
+            break;
+        }
+        case HIST_FILTER_MODE: {
+            if (count > ch->count) {
+                ch->count = count;
+                ch->value = pixel;
+            }
+            break;
+        }
+        case HIST_FILTER_MIDPOINT: {
+            ch->value = IM_MIN(ch->value, pixel);
+            ch->count = IM_MAX(ch->count, pixel);
+            break;
+        }
+    }
+}
+
+// The window is never empty when a pixel is removed (the entering column is added first).
+static inline void hist_filter_channel_remove(hist_filter_channel_t *ch, hist_filter_op_t op, int pixel)
+{
+    int count = --ch->bins[pixel];
+
+    switch (op) {
+        case HIST_FILTER_MEDIAN: {
+            if (pixel < ch->value) ch->count -= 1;
+            break;
+        }
+        case HIST_FILTER_MODE: {
+            if (pixel == ch->value) {
+                ch->count = count;
+
+                for (int i = 0; i < ch->bins_len; i++) {
+                    if (ch->bins[i] > ch->count) {
+                        ch->count = ch->bins[i];
+                        ch->value = i;
+                    }
+                }
+            }
+            break;
+        }
+        case HIST_FILTER_MIDPOINT: {
+            if (!count) {
+                if (pixel == ch->value) while (!ch->bins[ch->value]) ch->value++;
+                if (pixel == ch->count) while (!ch->bins[ch->count]) ch->count--;
+            }
+            break;
+        }
+    }
+}
+
+// Returns the sorted window pixel at index - i.e. the value with index pixels below it.
+static inline int hist_filter_channel_percentile(hist_filter_channel_t *ch, int index)
+{
+    while (ch->count > index) {
+        ch->value -= 1;
+        ch->count -= ch->bins[ch->value];
+    }
+
+    while ((ch->count + ch->bins[ch->value]) <= index) {
+        ch->count += ch->bins[ch->value];
+        ch->value += 1;
+    }
+
+    return ch->value;
+}
+
+// Adds (d = 1) or removes (d = -1) the window column at x (rows y - ksize ... y + ksize).
+static void hist_filter_column(image_t *img, hist_filter_channel_t *chs, hist_filter_op_t op,
+                               int ksize, int x, int y, int d)
+{
+    x = IM_MIN(IM_MAX(x, 0), (img->w - 1));
+
+    for (int j = -ksize; j <= ksize; j++) {
+        int yy = IM_MIN(IM_MAX(y + j, 0), (img->h - 1));
+
+        switch(img->bpp) {
+            case IMAGE_BPP_BINARY: {
+                int pixel = IMAGE_GET_BINARY_PIXEL_FAST(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, yy), x);
+                if (d > 0) hist_filter_channel_add(&chs[0], op, pixel);
+                else hist_filter_channel_remove(&chs[0], op, pixel);
+                break;
+            }
+            case IMAGE_BPP_GRAYSCALE: {
+                int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, yy), x);
+                if (d > 0) hist_filter_channel_add(&chs[0], op, pixel);
+                else hist_filter_channel_remove(&chs[0], op, pixel);
+                break;
+            }
+            case IMAGE_BPP_RGB565: {
+                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, yy), x);
+                if (d > 0) {
+                    hist_filter_channel_add(&chs[0], op, COLOR_RGB565_TO_R5(pixel));
+                    hist_filter_channel_add(&chs[1], op, COLOR_RGB565_TO_G6(pixel));
+                    hist_filter_channel_add(&chs[2], op, COLOR_RGB565_TO_B5(pixel));
+                } else {
+                    hist_filter_channel_remove(&chs[0], op, COLOR_RGB565_TO_R5(pixel));
+                    hist_filter_channel_remove(&chs[1], op, COLOR_RGB565_TO_G6(pixel));
+                    hist_filter_channel_remove(&chs[2], op, COLOR_RGB565_TO_B5(pixel));
+                }
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+    }
+}
+
+static int hist_filter_channel_result(hist_filter_channel_t *ch, hist_filter_op_t op, int int_percentile,
+                                      float min_bias, float max_bias)
+{
+    switch (op) {
+        case HIST_FILTER_MEDIAN: {
+            return hist_filter_channel_percentile(ch, int_percentile);
+        }
+        case HIST_FILTER_MIDPOINT: {
+            return fast_floorf((ch->value*min_bias)+(ch->count*max_bias));
+        }
+        default: {
+            return ch->value;
+        }
+    }
+}
+
+// arg is the percentile for median and the bias for midpoint.
+static void imlib_hist_filter(image_t *img, const int ksize, hist_filter_op_t op, float arg,
+                              bool threshold, int offset, bool invert, image_t *mask)
 {
     int brows = ksize + 1;
     image_t buf;
@@ -313,38 +554,67 @@ void imlib_median_filter(image_t *img, const int ksize, float percentile, bool t
     buf.h = brows;
     buf.bpp = img->bpp;
 
-    int n = ((ksize*2)+1)*((ksize*2)+1), int_percentile = fast_floorf(percentile * (n - 1));
+    int n = ((ksize*2)+1)*((ksize*2)+1), int_percentile = fast_floorf(arg * (n - 1));
+    float max_bias = arg, min_bias = 1.0f - arg;
+
+    hist_filter_channel_t chs[3];
+    int chs_len = 0, line_len_bytes = 0;
 
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
-            buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
-            int *data = fb_alloc(n*sizeof(int), FB_ALLOC_NO_HINT);
+            line_len_bytes = IMAGE_BINARY_LINE_LEN_BYTES(img);
+            chs[chs_len++].bins_len = COLOR_BINARY_MAX-COLOR_BINARY_MIN+1;
+            break;
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            line_len_bytes = IMAGE_GRAYSCALE_LINE_LEN_BYTES(img);
+            chs[chs_len++].bins_len = COLOR_GRAYSCALE_MAX-COLOR_GRAYSCALE_MIN+1;
+            break;
+        }
+        case IMAGE_BPP_RGB565: {
+            line_len_bytes = IMAGE_RGB565_LINE_LEN_BYTES(img);
+            chs[chs_len++].bins_len = COLOR_R5_MAX-COLOR_R5_MIN+1;
+            chs[chs_len++].bins_len = COLOR_G6_MAX-COLOR_G6_MIN+1;
+            chs[chs_len++].bins_len = COLOR_B5_MAX-COLOR_B5_MIN+1;
+            break;
+        }
+        default: {
+            return;
+        }
+    }
 
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                uint32_t *buf_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows));
+    buf.data = fb_alloc(line_len_bytes * brows, FB_ALLOC_NO_HINT);
 
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
-                        IMAGE_PUT_BINARY_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
-                        continue; // Short circuit.
-                    }
+    for (int i = 0; i < chs_len; i++) {
+        chs[i].bins = fb_alloc(chs[i].bins_len * sizeof(int), FB_ALLOC_NO_HINT);
+    }
 
-                    int *data_ptr = data;
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        for (int i = 0; i < chs_len; i++) {
+            hist_filter_channel_reset(&chs[i], op);
+        }
 
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint32_t *k_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
+        for (int k = -ksize; k <= ksize; k++) {
+            hist_filter_column(img, chs, op, ksize, k, y, 1);
+        }
 
-                        for (int k = -ksize; k <= ksize; k++) {
-                            *data_ptr++ = IMAGE_GET_BINARY_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                        }
-                    }
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            if (x) { // Slide the window across...
+                hist_filter_column(img, chs, op, ksize, x + ksize, y, 1);
+                hist_filter_column(img, chs, op, ksize, x - ksize - 1, y, -1);
+            }
+
+            switch(img->bpp) {
+                case IMAGE_BPP_BINARY: {
+                    uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+                    uint32_t *buf_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows));
 
-                    fsort(data, n);
+                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
+                        IMAGE_PUT_BINARY_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                        break; // Short circuit.
+                    }
 
-                    int pixel = data[int_percentile];
+                    int pixel = hist_filter_channel_result(&chs[0], op, int_percentile, min_bias, max_bias);
 
                     if (threshold) {
                         if (((pixel - offset) < IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x)) ^ invert) {
@@ -355,55 +625,18 @@ void imlib_median_filter(image_t *img, const int ksize, float percentile, bool t
                     }
 
                     IMAGE_PUT_BINARY_PIXEL_FAST(buf_row_ptr, x, pixel);
+                    break;
                 }
+                case IMAGE_BPP_GRAYSCALE: {
+                    uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+                    uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
 
-                if (y >= ksize) { // Transfer buffer lines...
-                    memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, (y - ksize)),
-                           IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
-                           IMAGE_BINARY_LINE_LEN_BYTES(img));
-                }
-            }
-
-            // Copy any remaining lines from the buffer image...
-            for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
-                memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y),
-                       IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows)),
-                       IMAGE_BINARY_LINE_LEN_BYTES(img));
-            }
-
-            fb_free();
-            fb_free();
-            break;
-        }
-        case IMAGE_BPP_GRAYSCALE: {
-            buf.data = fb_alloc(IMAGE_GRAYSCALE_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
-            int *data = fb_alloc(n*sizeof(int), FB_ALLOC_NO_HINT);
-
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
-
-                for (int x = 0, xx = img->w; x < xx; x++) {
                     if (mask && (!image_get_mask_pixel(mask, x, y))) {
                         IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x));
-                        continue; // Short circuit.
-                    }
-
-                    int *data_ptr = data;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint8_t *k_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            *data_ptr++ = IMAGE_GET_GRAYSCALE_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                        }
+                        break; // Short circuit.
                     }
 
-                    fsort(data, n);
-
-                    int pixel = data[int_percentile];
+                    int pixel = hist_filter_channel_result(&chs[0], op, int_percentile, min_bias, max_bias);
 
                     if (threshold) {
                         if (((pixel - offset) < IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x)) ^ invert) {
@@ -414,64 +647,20 @@ void imlib_median_filter(image_t *img, const int ksize, float percentile, bool t
                     }
 
                     IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, pixel);
+                    break;
                 }
+                case IMAGE_BPP_RGB565: {
+                    uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+                    uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
 
-                if (y >= ksize) { // Transfer buffer lines...
-                    memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, (y - ksize)),
-                           IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
-                           IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
-                }
-            }
-
-            // Copy any remaining lines from the buffer image...
-            for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
-                memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y),
-                       IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows)),
-                       IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
-            }
-
-            fb_free();
-            fb_free();
-            break;
-        }
-        case IMAGE_BPP_RGB565: {
-            buf.data = fb_alloc(IMAGE_RGB565_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
-            int *r_data = fb_alloc(n*sizeof(int), FB_ALLOC_NO_HINT);
-            int *g_data = fb_alloc(n*sizeof(int), FB_ALLOC_NO_HINT);
-            int *b_data = fb_alloc(n*sizeof(int), FB_ALLOC_NO_HINT);
-
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
-
-                for (int x = 0, xx = img->w; x < xx; x++) {
                     if (mask && (!image_get_mask_pixel(mask, x, y))) {
                         IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
-                        continue; // Short circuit.
+                        break; // Short circuit.
                     }
 
-                    int *r_data_ptr = r_data, *g_data_ptr = g_data, *b_data_ptr = b_data;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint16_t *k_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            int pixel = IMAGE_GET_RGB565_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                            *r_data_ptr++ = COLOR_RGB565_TO_R5(pixel);
-                            *g_data_ptr++ = COLOR_RGB565_TO_G6(pixel);
-                            *b_data_ptr++ = COLOR_RGB565_TO_B5(pixel);
-                        }
-                    }
-
-                    fsort(r_data, n);
-                    fsort(g_data, n);
-                    fsort(b_data, n);
-
-                    int pixel = COLOR_R5_G6_B5_TO_RGB565(r_data[int_percentile],
-                                                         g_data[int_percentile],
-                                                         b_data[int_percentile]);
+                    int pixel = COLOR_R5_G6_B5_TO_RGB565(hist_filter_channel_result(&chs[0], op, int_percentile, min_bias, max_bias),
+                                                         hist_filter_channel_result(&chs[1], op, int_percentile, min_bias, max_bias),
+                                                         hist_filter_channel_result(&chs[2], op, int_percentile, min_bias, max_bias));
 
                     if (threshold) {
                         if (((COLOR_RGB565_TO_Y(pixel) - offset) < COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x))) ^ invert) {
@@ -482,468 +671,57 @@ void imlib_median_filter(image_t *img, const int ksize, float percentile, bool t
                     }
 
                     IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
+                    break;
                 }
-
-                if (y >= ksize) { // Transfer buffer lines...
-                    memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, (y - ksize)),
-                           IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
-                           IMAGE_RGB565_LINE_LEN_BYTES(img));
+                default: {
+                    break;
                 }
             }
-
-            // Copy any remaining lines from the buffer image...
-            for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
-                memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y),
-                       IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows)),
-                       IMAGE_RGB565_LINE_LEN_BYTES(img));
-            }
-
-            fb_free();
-            fb_free();
-            fb_free();
-            fb_free();
-            break;
         }
-        default: {
-            break;
+
+        if (y >= ksize) { // Transfer buffer lines...
+            memcpy(img->data + (line_len_bytes * (y - ksize)),
+                   buf.data + (line_len_bytes * ((y - ksize) % brows)),
+                   line_len_bytes);
         }
     }
+
+    // Copy any remaining lines from the buffer image...
+    for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
+        memcpy(img->data + (line_len_bytes * y),
+               buf.data + (line_len_bytes * (y % brows)),
+               line_len_bytes);
+    }
+
+    for (int i = 0; i < chs_len; i++) {
+        fb_free(); // bins
+    }
+
+    fb_free(); // buf
+}
+#endif
+
+#ifdef IMLIB_ENABLE_MEDIAN
+void imlib_median_filter(image_t *img, const int ksize, float percentile, bool threshold, int offset, bool invert, image_t *mask)
+{
+    OMV_PROF_SCOPE("imlib_median_filter");
+    imlib_hist_filter(img, ksize, HIST_FILTER_MEDIAN, percentile, threshold, offset, invert, mask);
 }
 #endif // IMLIB_ENABLE_MEDIAN
 
 #ifdef IMLIB_ENABLE_MODE
 void imlib_mode_filter(image_t *img, const int ksize, bool threshold, int offset, bool invert, image_t *mask)
 {
-    int brows = ksize + 1;
-    image_t buf;
-    buf.w = img->w;
-    buf.h = brows;
-    buf.bpp = img->bpp;
-
-    switch(img->bpp) {
-        case IMAGE_BPP_BINARY: {
-            buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
-            int *bins = fb_alloc((COLOR_BINARY_MAX-COLOR_BINARY_MIN+1)*sizeof(int), FB_ALLOC_NO_HINT);
-
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                uint32_t *buf_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows));
-
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
-                        IMAGE_PUT_BINARY_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
-                        continue; // Short circuit.
-                    }
-
-                    memset(bins, 0, (COLOR_BINARY_MAX-COLOR_BINARY_MIN+1)*sizeof(int));
-
-                    int mcount = 0, mode = 0;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint32_t *k_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            int pixel = IMAGE_GET_BINARY_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                            bins[pixel]++;
-
-                            if (bins[pixel] > mcount) {
-                                mcount = bins[pixel];
-                                mode = pixel;
-                            }
-                        }
-                    }
-
-                    int pixel = mode;
-
-                    if (threshold) {
-                        if (((pixel - offset) < IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x)) ^ invert) {
-                            pixel = COLOR_BINARY_MAX;
-                        } else {
-                            pixel = COLOR_BINARY_MIN;
-                        }
-                    }
-
-                    IMAGE_PUT_BINARY_PIXEL_FAST(buf_row_ptr, x, pixel);
-                }
-
-                if (y >= ksize) { // Transfer buffer lines...
-                    memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, (y - ksize)),
-                           IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
-                           IMAGE_BINARY_LINE_LEN_BYTES(img));
-                }
-            }
-
-            // Copy any remaining lines from the buffer image...
-            for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
-                memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y),
-                       IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows)),
-                       IMAGE_BINARY_LINE_LEN_BYTES(img));
-            }
-
-            fb_free();
-            fb_free();
-            break;
-        }
-        case IMAGE_BPP_GRAYSCALE: {
-            buf.data = fb_alloc(IMAGE_GRAYSCALE_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
-            int *bins = fb_alloc((COLOR_GRAYSCALE_MAX-COLOR_GRAYSCALE_MIN+1)*sizeof(int), FB_ALLOC_NO_HINT);
-
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
-
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
-                        IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x));
-                        continue; // Short circuit.
-                    }
-
-                    memset(bins, 0, (COLOR_GRAYSCALE_MAX-COLOR_GRAYSCALE_MIN+1)*sizeof(int));
-
-                    int mcount = 0, mode = 0;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint8_t *k_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                            bins[pixel]++;
-
-                            if (bins[pixel] > mcount) {
-                                mcount = bins[pixel];
-                                mode = pixel;
-                            }
-                        }
-                    }
-
-                    int pixel = mode;
-
-                    if (threshold) {
-                        if (((pixel - offset) < IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x)) ^ invert) {
-                            pixel = COLOR_GRAYSCALE_BINARY_MAX;
-                        } else {
-                            pixel = COLOR_GRAYSCALE_BINARY_MIN;
-                        }
-                    }
-
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, pixel);
-                }
-
-                if (y >= ksize) { // Transfer buffer lines...
-                    memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, (y - ksize)),
-                           IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
-                           IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
-                }
-            }
-
-            // Copy any remaining lines from the buffer image...
-            for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
-                memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y),
-                       IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows)),
-                       IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
-            }
-
-            fb_free();
-            fb_free();
-            break;
-        }
-        case IMAGE_BPP_RGB565: {
-            buf.data = fb_alloc(IMAGE_RGB565_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
-            int *r_bins = fb_alloc((COLOR_R5_MAX-COLOR_R5_MIN+1)*sizeof(int), FB_ALLOC_NO_HINT);
-            int *g_bins = fb_alloc((COLOR_G6_MAX-COLOR_G6_MIN+1)*sizeof(int), FB_ALLOC_NO_HINT);
-            int *b_bins = fb_alloc((COLOR_B5_MAX-COLOR_B5_MIN+1)*sizeof(int), FB_ALLOC_NO_HINT);
-
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
-
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
-                        IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
-                        continue; // Short circuit.
-                    }
-
-                    memset(r_bins, 0, (COLOR_R5_MAX-COLOR_R5_MIN+1)*sizeof(int));
-                    memset(g_bins, 0, (COLOR_G6_MAX-COLOR_G6_MIN+1)*sizeof(int));
-                    memset(b_bins, 0, (COLOR_B5_MAX-COLOR_B5_MIN+1)*sizeof(int));
-
-                    int r_mcount = 0, r_mode = 0;
-                    int g_mcount = 0, g_mode = 0;
-                    int b_mcount = 0, b_mode = 0;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint16_t *k_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            int pixel = IMAGE_GET_RGB565_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                            int r_pixel = COLOR_RGB565_TO_R5(pixel);
-                            int g_pixel = COLOR_RGB565_TO_G6(pixel);
-                            int b_pixel = COLOR_RGB565_TO_B5(pixel);
-                            r_bins[r_pixel]++;
-                            g_bins[g_pixel]++;
-                            b_bins[b_pixel]++;
-
-                            if (r_bins[r_pixel] > r_mcount) {
-                                r_mcount = r_bins[r_pixel];
-                                r_mode = r_pixel;
-                            }
-
-                            if (g_bins[g_pixel] > g_mcount) {
-                                g_mcount = g_bins[g_pixel];
-                                g_mode = g_pixel;
-                            }
-
-                            if (b_bins[b_pixel] > b_mcount) {
-                                b_mcount = b_bins[b_pixel];
-                                b_mode = b_pixel;
-                            }
-                        }
-                    }
-
-                    int pixel = COLOR_R5_G6_B5_TO_RGB565(r_mode, g_mode, b_mode);
-
-                    if (threshold) {
-                        if (((COLOR_RGB565_TO_Y(pixel) - offset) < COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x))) ^ invert) {
-                            pixel = COLOR_RGB565_BINARY_MAX;
-                        } else {
-                            pixel = COLOR_RGB565_BINARY_MIN;
-                        }
-                    }
-
-                    IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
-                }
-
-                if (y >= ksize) { // Transfer buffer lines...
-                    memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, (y - ksize)),
-                           IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
-                           IMAGE_RGB565_LINE_LEN_BYTES(img));
-                }
-            }
-
-            // Copy any remaining lines from the buffer image...
-            for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
-                memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y),
-                       IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows)),
-                       IMAGE_RGB565_LINE_LEN_BYTES(img));
-            }
-
-            fb_free();
-            fb_free();
-            fb_free();
-            fb_free();
-            break;
-        }
-        default: {
-            break;
-        }
-    }
+    OMV_PROF_SCOPE("imlib_mode_filter");
+    imlib_hist_filter(img, ksize, HIST_FILTER_MODE, 0.0f, threshold, offset, invert, mask);
 }
 #endif // IMLIB_ENABLE_MODE
 
 #ifdef IMLIB_ENABLE_MIDPOINT
 void imlib_midpoint_filter(image_t *img, const int ksize, float bias, bool threshold, int offset, bool invert, image_t *mask)
 {
-    int brows = ksize + 1;
-    image_t buf;
-    buf.w = img->w;
-    buf.h = brows;
-    buf.bpp = img->bpp;
-
-    float max_bias = bias, min_bias = 1.0f - bias;
-
-    switch(img->bpp) {
-        case IMAGE_BPP_BINARY: {
-            buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
-
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                uint32_t *buf_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows));
-
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
-                        IMAGE_PUT_BINARY_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
-                        continue; // Short circuit.
-                    }
-
-                    int min = COLOR_BINARY_MAX, max = COLOR_BINARY_MIN;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint32_t *k_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            int pixel = IMAGE_GET_BINARY_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                            min = IM_MIN(min, pixel);
-                            max = IM_MAX(max, pixel);
-                        }
-                    }
-
-                    int pixel = fast_floorf((min*min_bias)+(max*max_bias));
-
-                    if (threshold) {
-                        if (((pixel - offset) < IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x)) ^ invert) {
-                            pixel = COLOR_BINARY_MAX;
-                        } else {
-                            pixel = COLOR_BINARY_MIN;
-                        }
-                    }
-
-                    IMAGE_PUT_BINARY_PIXEL_FAST(buf_row_ptr, x, pixel);
-                }
-
-                if (y >= ksize) { // Transfer buffer lines...
-                    memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, (y - ksize)),
-                           IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
-                           IMAGE_BINARY_LINE_LEN_BYTES(img));
-                }
-            }
-
-            // Copy any remaining lines from the buffer image...
-            for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
-                memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y),
-                       IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&buf, (y % brows)),
-                       IMAGE_BINARY_LINE_LEN_BYTES(img));
-            }
-
-            fb_free();
-            break;
-        }
-        case IMAGE_BPP_GRAYSCALE: {
-            buf.data = fb_alloc(IMAGE_GRAYSCALE_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
-
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
-
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
-                        IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x));
-                        continue; // Short circuit.
-                    }
-
-                    int min = COLOR_GRAYSCALE_MAX, max = COLOR_GRAYSCALE_MIN;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint8_t *k_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                            min = IM_MIN(min, pixel);
-                            max = IM_MAX(max, pixel);
-                        }
-                    }
-
-                    int pixel = fast_floorf((min*min_bias)+(max*max_bias));
-
-                    if (threshold) {
-                        if (((pixel - offset) < IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x)) ^ invert) {
-                            pixel = COLOR_GRAYSCALE_BINARY_MAX;
-                        } else {
-                            pixel = COLOR_GRAYSCALE_BINARY_MIN;
-                        }
-                    }
-
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, pixel);
-                }
-
-                if (y >= ksize) { // Transfer buffer lines...
-                    memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, (y - ksize)),
-                           IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
-                           IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
-                }
-            }
-
-            // Copy any remaining lines from the buffer image...
-            for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
-                memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y),
-                       IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows)),
-                       IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
-            }
-
-            fb_free();
-            break;
-        }
-        case IMAGE_BPP_RGB565: {
-            buf.data = fb_alloc(IMAGE_RGB565_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
-
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
-
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
-                        IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
-                        continue; // Short circuit.
-                    }
-
-                    int r_min = COLOR_R5_MAX, r_max = COLOR_R5_MIN;
-                    int g_min = COLOR_G6_MAX, g_max = COLOR_G6_MIN;
-                    int b_min = COLOR_B5_MAX, b_max = COLOR_B5_MIN;
-
-                    for (int j = -ksize; j <= ksize; j++) {
-                        uint16_t *k_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img,
-                            IM_MIN(IM_MAX(y + j, 0), (img->h - 1)));
-
-                        for (int k = -ksize; k <= ksize; k++) {
-                            int pixel = IMAGE_GET_RGB565_PIXEL_FAST(k_row_ptr,
-                                IM_MIN(IM_MAX(x + k, 0), (img->w - 1)));
-                            int r_pixel = COLOR_RGB565_TO_R5(pixel);
-                            int g_pixel = COLOR_RGB565_TO_G6(pixel);
-                            int b_pixel = COLOR_RGB565_TO_B5(pixel);
-                            r_min = IM_MIN(r_min, r_pixel);
-                            r_max = IM_MAX(r_max, r_pixel);
-                            g_min = IM_MIN(g_min, g_pixel);
-                            g_max = IM_MAX(g_max, g_pixel);
-                            b_min = IM_MIN(b_min, b_pixel);
-                            b_max = IM_MAX(b_max, b_pixel);
-                        }
-                    }
-
-                    int pixel = COLOR_R5_G6_B5_TO_RGB565(fast_floorf((r_min*min_bias)+(r_max*max_bias)),
-                                                         fast_floorf((g_min*min_bias)+(g_max*max_bias)),
-                                                         fast_floorf((b_min*min_bias)+(b_max*max_bias)));
-
-                    if (threshold) {
-                        if (((COLOR_RGB565_TO_Y(pixel) - offset) < COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x))) ^ invert) {
-                            pixel = COLOR_RGB565_BINARY_MAX;
-                        } else {
-                            pixel = COLOR_RGB565_BINARY_MIN;
-                        }
-                    }
-
-                    IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
-                }
-
-                if (y >= ksize) { // Transfer buffer lines...
-                    memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, (y - ksize)),
-                           IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
-                           IMAGE_RGB565_LINE_LEN_BYTES(img));
-                }
-            }
-
-            // Copy any remaining lines from the buffer image...
-            for (int y = img->h - ksize, yy = img->h; y < yy; y++) {
-                memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y),
-                       IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows)),
-                       IMAGE_RGB565_LINE_LEN_BYTES(img));
-            }
-
-            fb_free();
-            break;
-        }
-        default: {
-            break;
-        }
-    }
+    OMV_PROF_SCOPE("imlib_midpoint_filter");
+    imlib_hist_filter(img, ksize, HIST_FILTER_MIDPOINT, bias, threshold, offset, invert, mask);
 }
 #endif // IMLIB_ENABLE_MIDPOINT
 
@@ -951,6 +729,7 @@ void imlib_midpoint_filter(image_t *img, const int ksize, float bias, bool thres
 
 void imlib_morph(image_t *img, const int ksize, const int *krn, const float m, const int b, bool threshold, int offset, bool invert, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_morph");
     int brows = ksize + 1;
     image_t buf;
     buf.w = img->w;
@@ -1147,6 +926,7 @@ static float distance(int x, int y)
 
 void imlib_bilateral_filter(image_t *img, const int ksize, float color_sigma, float space_sigma, bool threshold, int offset, bool invert, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_bilateral_filter");
     int brows = ksize + 1;
     image_t buf;
     buf.w = img->w;
@@ -1504,6 +1284,7 @@ static void imlib_cartoon_filter_fill(image_t *img, int line, int l, int r, void
 
 void imlib_cartoon_filter(image_t *img, float seed_threshold, float floating_threshold, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_cartoon_filter");
     image_t mean_image, fill_image;
 
     mean_image.w = img->w;
@@ -19,7 +19,28 @@ const float __atanf_lut[4] = {
     +0.1555786518463281f,    //p5
     +0.9997878412794807f     //p1
 };
-#ifndef __CC_ARM
+#if defined(OMV_HOST)
+// The host port (ports/omv_host): what the instructions below compute, in C.
+float ALWAYS_INLINE fast_sqrtf(float x)
+{
+    return __builtin_sqrtf(x);
+}
+
+int ALWAYS_INLINE fast_floorf(float x)
+{
+    return (int) x; // vcvt truncates
+}
+
+int ALWAYS_INLINE fast_ceilf(float x)
+{
+    return (int) (x + 0.9999f);
+}
+
+int ALWAYS_INLINE fast_roundf(float x)
+{
+    return (int) __builtin_nearbyintf(x); // vcvtr rounds to nearest even
+}
+#elif !defined(__CC_ARM)
 float ALWAYS_INLINE fast_sqrtf(float x)
 {
     asm volatile (
@@ -102,7 +123,12 @@ float fast_cbrtf(float x)
    v.ix = 0x2a511cd0 + v.ix;  // Initial guess.
    return v.x;
 }
-#ifndef __CC_ARM
+#if defined(OMV_HOST)
+float ALWAYS_INLINE fast_fabsf(float x)
+{
+    return __builtin_fabsf(x);
+}
+#elif !defined(__CC_ARM)
 float ALWAYS_INLINE fast_fabsf(float x)
 {
     asm volatile (
@@ -116,4 +116,6 @@ float fast_log2(float x);
 float fast_powf(float a, float b);
 extern const float cos_table[360];
 extern const float sin_table[360];
+extern const int16_t cos_table_q15[360];
+extern const int16_t sin_table_q15[360];
 #endif // __FMATH_H__
@@ -10,7 +10,14 @@
 #include "fb_alloc.h"
 #include "ff_wrapper.h"
 #include "imlib.h"
-#define BLOCK_SIZE (126) // (2^7) - 2 // (DO NOT CHANGE!)
+#define LZW_MIN_CODE_SIZE   (7) // 128 color palette
+#define LZW_CLEAR_CODE      (1 << LZW_MIN_CODE_SIZE)
+#define LZW_END_CODE        (LZW_CLEAR_CODE + 1)
+#define LZW_MAX_CODE_SIZE   (12)
+#define LZW_MAX_CODES       (1 << LZW_MAX_CODE_SIZE)
+// Open addressing table of the codes, prime and 80% full with all the codes in it.
+#define LZW_HASH_SIZE       (5003)
+#define LZW_HASH_SHIFT      (4)
 
 void gif_open(FIL *fp, int width, int height, bool color, bool loop)
 {
@@ -44,8 +51,90 @@ void gif_open(FIL *fp, int width, int height, bool color, bool loop)
     file_buffer_off(fp);
 }
 
+typedef struct gif_lzw {
+    FIL *fp;
+    int32_t *keys;  // (prefix << 8) | pixel of each code, -1 if empty
+    uint16_t *codes;
+    int next_code;
+    int code_size;
+    int prefix;     // code of the string matched so far, -1 at the start
+    uint32_t bits;
+    int bit_count;
+    uint8_t block[256]; // sub-block length, then its bytes
+} gif_lzw_t;
+
+static void gif_lzw_reset(gif_lzw_t *lzw)
+{
+    memset(lzw->keys, 0xFF, LZW_HASH_SIZE * sizeof(int32_t));
+    lzw->next_code = LZW_END_CODE + 1;
+    lzw->code_size = LZW_MIN_CODE_SIZE + 1;
+}
+
+static void gif_lzw_flush(gif_lzw_t *lzw)
+{
+    if (lzw->block[0]) {
+        write_data(lzw->fp, lzw->block, lzw->block[0] + 1);
+        lzw->block[0] = 0;
+    }
+}
+
+static void gif_lzw_put(gif_lzw_t *lzw, int code)
+{
+    lzw->bits |= code << lzw->bit_count;
+    lzw->bit_count += lzw->code_size;
+
+    while (lzw->bit_count >= 8) {
+        lzw->block[++lzw->block[0]] = lzw->bits;
+        lzw->bits >>= 8;
+        lzw->bit_count -= 8;
+        if (lzw->block[0] == 255) {
+            gif_lzw_flush(lzw);
+        }
+    }
+}
+
+static void gif_lzw_add(gif_lzw_t *lzw, int pixel)
+{
+    if (lzw->prefix < 0) {
+        lzw->prefix = pixel;
+        return;
+    }
+
+    int32_t key = (lzw->prefix << 8) | pixel;
+    int i = (pixel << LZW_HASH_SHIFT) ^ lzw->prefix;
+    int step = i ? (LZW_HASH_SIZE - i) : 1;
+
+    for (; lzw->keys[i] >= 0; i = (i < step) ? (i - step + LZW_HASH_SIZE) : (i - step)) {
+        if (lzw->keys[i] == key) {
+            lzw->prefix = lzw->codes[i];
+            return;
+        }
+    }
+
+    gif_lzw_put(lzw, lzw->prefix);
+
+    if (lzw->next_code < LZW_MAX_CODES) {
+        // The decoder widens its codes once it has the code before this one.
+        if (lzw->next_code == (1 << lzw->code_size)) {
+            lzw->code_size++;
+        }
+        lzw->keys[i] = key;
+        lzw->codes[i] = lzw->next_code++;
+    } else {
+        gif_lzw_put(lzw, LZW_CLEAR_CODE);
+        gif_lzw_reset(lzw);
+    }
+
+    lzw->prefix = pixel;
+}
+
 void gif_add_frame(FIL *fp, image_t *img, uint16_t delay)
 {
+    // The code table goes first, the file buffer takes all that is left.
+    gif_lzw_t lzw = { .fp = fp, .prefix = -1 };
+    lzw.keys = fb_alloc(LZW_HASH_SIZE * sizeof(int32_t), FB_ALLOC_PREFER_SPEED);
+    lzw.codes = fb_alloc(LZW_HASH_SIZE * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
+
     file_buffer_on(fp);
 
     if (delay) {
@@ -58,55 +147,59 @@ void gif_add_frame(FIL *fp, image_t *img, uint16_t delay)
     write_long(fp, 0);
     write_word(fp, img->w);
     write_word(fp, img->h);
-    write_data(fp, (uint8_t []) {0x00, 0x07}, 2); // 7-bits
+    write_data(fp, (uint8_t []) {0x00, LZW_MIN_CODE_SIZE}, 2); // 7-bits
 
-    int bytes  = img->h * img->w;
-    int blocks = (bytes + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    gif_lzw_reset(&lzw);
+    gif_lzw_put(&lzw, LZW_CLEAR_CODE);
 
     if (IM_IS_GS(img)) {
-        for (int y=0; y<blocks; y++) {
-            int block_size = IM_MIN(BLOCK_SIZE, bytes - (y*BLOCK_SIZE));
-            write_byte(fp, 1 + block_size);
-            write_byte(fp, 0x80); // clear code
-            for (int x=0; x<block_size; x++) {
-                write_byte(fp, img->pixels[(y*BLOCK_SIZE)+x]>>1);
+        for (int y=0; y<img->h; y++) {
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+            for (int x=0; x<img->w; x++) {
+                gif_lzw_add(&lzw, IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x)>>1);
             }
         }
     } else if (IM_IS_RGB565(img)) {
-        for (int y=0; y<blocks; y++) {
-            int block_size = IM_MIN(BLOCK_SIZE, bytes - (y*BLOCK_SIZE));
-            write_byte(fp, 1 + block_size);
-            write_byte(fp, 0x80); // clear code
-            for (int x=0; x<block_size; x++) {
-                int pixel = ((uint16_t *) img->pixels)[(y*BLOCK_SIZE)+x];
+        for (int y=0; y<img->h; y++) {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+            for (int x=0; x<img->w; x++) {
+                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
                 int red = IM_R565(pixel)>>3;
                 int green = IM_G565(pixel)>>3;
                 int blue = IM_B565(pixel)>>3;
-                write_byte(fp, (red<<5) | (green<<2) | blue);
+                gif_lzw_add(&lzw, (red<<5) | (green<<2) | blue);
             }
         }
     } else if (IM_IS_BAYER(img)) {
-        for (int y=0; y<blocks; y++) {
-            int block_size = IM_MIN(BLOCK_SIZE, bytes - (y*BLOCK_SIZE));
-            write_byte(fp, 1 + block_size);
-            write_byte(fp, 0x80); // clear code
-            for (int x=0; x<block_size; x++) {
+        for (int y=0; y<img->h; y++) {
+            for (int x=0; x<img->w; x++) {
                 int r=0, g=0, b=0;
-                int x_offs = ((y*BLOCK_SIZE) + x) % img->w;
-                int y_offs = (y*BLOCK_SIZE) / img->w;
-                if (x_offs > 0 && y_offs > 0 && x_offs < img->w-1 && y_offs < img->h-1) {
-                    COLOR_BAYER_TO_RGB565(img, x_offs, y_offs, r, g, b);
+                if (x > 0 && y > 0 && x < img->w-1 && y < img->h-1) {
+                    COLOR_BAYER_TO_RGB565(img, x, y, r, g, b);
                 }
                 r >>=3; g >>=3; b >>=3;
-                write_byte(fp, (r<<5) | (g<<2) | b);
+                gif_lzw_add(&lzw, (r<<5) | (g<<2) | b);
             }
         }
     }
 
-
-    write_data(fp, (uint8_t []) {0x01, 0x81, 0x00}, 3); // end code
+    if (lzw.prefix >= 0) {
+        gif_lzw_put(&lzw, lzw.prefix);
+        // As after any other code, the decoder widens its codes before the end code.
+        if ((lzw.next_code < LZW_MAX_CODES) && (lzw.next_code == (1 << lzw.code_size))) {
+            lzw.code_size++;
+        }
+    }
+    gif_lzw_put(&lzw, LZW_END_CODE);
+    if (lzw.bit_count) {
+        lzw.block[++lzw.block[0]] = lzw.bits;
+    }
+    gif_lzw_flush(&lzw);
+    write_byte(fp, 0x00); // end of the image data
 
     file_buffer_off(fp);
+    fb_free();
+    fb_free();
 }
 
 void gif_close(FIL *fp)
@@ -72,18 +72,14 @@ static int run_cascade_classifier(cascade_t* cascade, point_t pt)
     return 1;
 }
 
-array_t *imlib_detect_objects(image_t *image, cascade_t *cascade, rectangle_t *roi)
+// Moving window integral images of each scaled image, used when both full integral images
+// don't fit in the frame buffer.
+static void detect_objects_mw(image_t *image, cascade_t *cascade, rectangle_t *roi, array_t *objects)
 {
     // Integral images
     mw_image_t sum;
     mw_image_t ssq;
 
-    // Detected objects array
-    array_t *objects;
-
-    // Allocate the objects array
-    array_alloc(&objects, xfree);
-
     // Set cascade image pointers
     cascade->img = image;
     cascade->sum = &sum;
@@ -152,6 +148,194 @@ array_t *imlib_detect_objects(image_t *image, cascade_t *cascade, rectangle_t *r
 
     imlib_integral_mw_free(&ssq);
     imlib_integral_mw_free(&sum);
+}
+
+// A rectangle of a weak classifier scaled to the current window size. The corners are offsets
+// from the window origin in the integral image and the weight is rescaled by the area lost or
+// gained when rounding the rectangle so that the feature responses match the unscaled cascade.
+typedef struct haar_rect {
+    int32_t tl, tr, bl, br;
+    int32_t weight;
+} haar_rect_t;
+
+// The cascade scaled to the current window size. Stages are scaled the first time a window
+// reaches them since most windows are rejected by the first few stages.
+typedef struct haar_scale {
+    float factor;
+    int stride;
+    int n_stages;       // Number of stages scaled so far.
+    int n_features;     // Number of features scaled so far.
+    int n_rectangles;   // Number of rectangles scaled so far.
+    haar_rect_t *rects;
+    int32_t *stages_thresh;
+} haar_scale_t;
+
+static void scale_stage(cascade_t *cascade, haar_scale_t *scale)
+{
+    for (int j=0; j<cascade->stages_array[scale->n_stages]; j++, scale->n_features++) {
+        for (int k=0; k<cascade->num_rectangles_array[scale->n_features]; k++, scale->n_rectangles++) {
+            int i = scale->n_rectangles;
+            int x = cascade->rectangles_array[(i<<2) + 0];
+            int y = cascade->rectangles_array[(i<<2) + 1];
+            int w = cascade->rectangles_array[(i<<2) + 2];
+            int h = cascade->rectangles_array[(i<<2) + 3];
+            int sx = fast_roundf(x*scale->factor);
+            int sy = fast_roundf(y*scale->factor);
+            int sw = IM_MAX(fast_roundf(w*scale->factor), 1);
+            int sh = IM_MAX(fast_roundf(h*scale->factor), 1);
+            scale->rects[i].tl = (sy*scale->stride) + sx;
+            scale->rects[i].tr = (sy*scale->stride) + sx + sw;
+            scale->rects[i].bl = ((sy+sh)*scale->stride) + sx;
+            scale->rects[i].br = ((sy+sh)*scale->stride) + sx + sw;
+            scale->rects[i].weight = fast_roundf((cascade->weights_array[i]<<12) * ((float) (w*h) / (sw*sh)));
+        }
+    }
+
+    scale->n_stages++;
+}
+
+// Returns 1 if an object was detected, 0 if the window was rejected by a later stage and -1 if it
+// was rejected by the first stage (or skipped) which means that the next window is unlikely to
+// contain an object either.
+static int run_cascade_classifier_ii(cascade_t *cascade, haar_scale_t *scale,
+                                     const uint32_t *sum, const uint32_t *ssq, int win_w, int win_h)
+{
+    int n = win_w * win_h;
+    int bl = win_h * scale->stride;
+    uint32_t i_s = sum[bl + win_w] + sum[0] - sum[win_w] - sum[bl];
+    uint32_t i_sq = ssq[bl + win_w] + ssq[0] - ssq[win_w] - ssq[bl];
+    float m = ((float) i_s) / n;
+    float v = (((float) i_sq) / n) - (m*m);
+
+    // Skip homogeneous regions.
+    if (v<(50*50)) {
+        return -1;
+    }
+
+    // Standard deviation of the window at the unscaled window size.
+    int32_t std = fast_sqrtf(v) * (cascade->window.w * cascade->window.h);
+    const haar_rect_t *rects = scale->rects;
+
+    for (int i=0, t_idx=0; i<cascade->n_stages; i++) {
+        if (i == scale->n_stages) {
+            scale_stage(cascade, scale);
+        }
+
+        int stage_sum = 0;
+        for (int j=0; j<cascade->stages_array[i]; j++, t_idx++) {
+            int32_t sumw = 0;
+            for (int k=0, l=cascade->num_rectangles_array[t_idx]; k<l; k++, rects++) {
+                sumw += ((int32_t) (sum[rects->br] + sum[rects->tl] - sum[rects->tr] - sum[rects->bl])) * rects->weight;
+            }
+            // The node threshold is multiplied by the standard deviation of the sub window
+            stage_sum += (sumw >= (cascade->tree_thresh_array[t_idx] * std)) ?
+                cascade->alpha2_array[t_idx] : cascade->alpha1_array[t_idx];
+        }
+        // If the sum is below the stage threshold, no objects were detected
+        if (stage_sum < scale->stages_thresh[i]) {
+            return i ? 0 : -1;
+        }
+    }
+    return 1;
+}
+
+// Evaluates the scaled cascade on full integral images of the roi, computed once (or shared with
+// other detectors run on the same frame) for all scales instead of rebuilding integral images of
+// each scaled image.
+static void detect_objects_ii(cascade_t *cascade, rectangle_t *roi, array_t *objects,
+                              const uint32_t *sum, const uint32_t *ssq, int stride)
+{
+    haar_scale_t scale;
+    scale.stride = stride;
+    scale.rects = fb_alloc(cascade->n_rectangles * sizeof(haar_rect_t), FB_ALLOC_PREFER_SPEED);
+    scale.stages_thresh = fb_alloc(cascade->n_stages * sizeof(int32_t), FB_ALLOC_NO_HINT);
+
+    for (int i=0; i<cascade->n_stages; i++) {
+        scale.stages_thresh[i] = ceilf(cascade->threshold * cascade->stages_thresh_array[i]);
+    }
+
+    // Same scanning steps as the scaled images (see detect_objects_mw()).
+    int step = IM_MIN((roi->w*50)/1000, cascade->window.h);
+
+    for(float factor=1.0f; ; factor *= cascade->scale_factor) {
+        int win_w = fast_roundf(cascade->window.w*factor);
+        int win_h = fast_roundf(cascade->window.h*factor);
+
+        // Break if the window doesn't fit in the image anymore
+        if (win_w >= roi->w || win_h >= roi->h) {
+            break;
+        }
+
+        scale.factor = factor;
+        scale.n_stages = 0;
+        scale.n_features = 0;
+        scale.n_rectangles = 0;
+
+        step = IM_MAX(step/factor, 1);
+        int y_step = IM_MAX(fast_roundf(step*factor), 1);
+        // Windows rejected by the first stage skip the next window when it overlaps enough.
+        int x_skip = ((step*2) <= (cascade->window.w/4)) ? (y_step*2) : y_step;
+
+        for (int y=0; (y+win_h)<roi->h; y+=y_step) {
+            const uint32_t *sum_row = sum + (y*stride);
+            const uint32_t *ssq_row = ssq + (y*stride);
+
+            for (int x=0; (x+win_w)<roi->w; ) {
+                int r = run_cascade_classifier_ii(cascade, &scale, sum_row + x, ssq_row + x, win_w, win_h);
+                // If an object is detected, record the coordinates of the filter window
+                if (r > 0) {
+                    array_push_back(objects, rectangle_alloc(x + roi->x, y + roi->y, win_w, win_h));
+                }
+                x += (r < 0) ? x_skip : y_step;
+            }
+        }
+    }
+
+    fb_free();
+    fb_free();
+}
+
+static void integral_image_ss(image_t *image, rectangle_t *roi, uint32_t *sum, uint32_t *ssq)
+{
+    for (int y=0; y<roi->h; y++) {
+        for (uint32_t s=0, sq=0, x=0; x<roi->w; x++) {
+            uint32_t p = IM_TO_GS_PIXEL(image, roi->x + x, roi->y + y);
+            s += p;
+            sq += p * p;
+            sum[(y*roi->w)+x] = s + (y ? sum[((y-1)*roi->w)+x] : 0);
+            ssq[(y*roi->w)+x] = sq + (y ? ssq[((y-1)*roi->w)+x] : 0);
+        }
+    }
+}
+
+array_t *imlib_detect_objects(image_t *image, cascade_t *cascade, rectangle_t *roi)
+{
+    OMV_PROF_SCOPE("imlib_detect_objects");
+    // Detected objects array
+    array_t *objects;
+
+    // Allocate the objects array
+    array_alloc(&objects, xfree);
+
+    // Integral images of the frame buffer are shared with other detectors run on the frame
+    i_image_t *sum = (image->bpp == IMAGE_BPP_GRAYSCALE) ? imlib_pyramid_integral(image, false) : NULL;
+    i_image_t *ssq = sum ? imlib_pyramid_integral(image, true) : NULL;
+    uint32_t rects_size = (cascade->n_rectangles * sizeof(haar_rect_t)) + (cascade->n_stages * sizeof(int32_t)) + 64;
+    uint32_t ii_size = roi->w * roi->h * sizeof(uint32_t);
+
+    if (sum && ssq) {
+        detect_objects_ii(cascade, roi, objects,
+                          sum->data + (roi->y*sum->w) + roi->x, ssq->data + (roi->y*ssq->w) + roi->x, sum->w);
+    } else if (fb_avail() >= ((ii_size * 2) + rects_size)) {
+        uint32_t *sum_data = fb_alloc(ii_size, FB_ALLOC_NO_HINT);
+        uint32_t *ssq_data = fb_alloc(ii_size, FB_ALLOC_NO_HINT);
+        integral_image_ss(image, roi, sum_data, ssq_data);
+        detect_objects_ii(cascade, roi, objects, sum_data, ssq_data, roi->w);
+        fb_free();
+        fb_free();
+    } else {
+        detect_objects_mw(image, cascade, roi, objects);
+    }
 
     if (array_length(objects) > 1)   {
         // Merge objects detected at different scales
@@ -249,6 +433,7 @@ error:
 
 int imlib_load_cascade(cascade_t *cascade, const char *path)
 {
+    OMV_PROF_SCOPE("imlib_load_cascade");
     // built-in cascade
     if (strcmp(path, "frontalface") == 0) {
         cascade->window.w            = frontalface_window_w;
@@ -14,7 +14,8 @@
 #include "xalloc.h"
 
 #ifdef IMLIB_ENABLE_HOG
-#define N_BINS      (9)
+#define N_BINS      (HOG_BINS)
+#define HOG_PLANES  (N_BINS+1) // the bins and the gradient energy
 typedef struct bin {
     int d;
     int m;
@@ -32,102 +33,140 @@ int bin_array_comp(const void *obj0, const void *obj1)
     return 0;
 }
 
-void imlib_find_hog(image_t *src, rectangle_t *roi, int cell_size)
+// The bin of the gradient's direction, |atan2(vx, vy)| in 20 degree bins with 180 wrapping to
+// bin 0, in fixed point: the direction is past the edge at 20 * i degrees when the cross
+// product with that edge's unit vector (Q15 tables) is >= 0.
+static inline int hog_bin(int vx, int vy)
+{
+    if (!vx) {
+        return 0;
+    }
+
+    int ax = abs(vx), t = 0;
+    for (int i=1; i<N_BINS; i++) {
+        t += ((ax * cos_table_q15[i*20]) - (vy * sin_table_q15[i*20])) >= 0;
+    }
+
+    return t;
+}
+
+// Integral histogram of HoG cells: entry (cx, cy) is the sum of the gradient histograms and
+// the gradient energy of the cells above and left of cell (cx, cy). Any window of cells is
+// then 4 lookups per bin, see imlib_hog_integral_window().
+void imlib_hog_integral(image_t *src, rectangle_t *roi, int cell_size, hog_integral_t *ii)
 {
     int s = src->w;
     int w = roi->x+roi->w-1;
     int h = roi->y+roi->h-1;
-
-    int block_size = cell_size * 2;
     int x_cells = (roi->w/cell_size);
     int y_cells = (roi->h/cell_size);
-
-    // TODO: Assert row->w/h >= cell_size *2;
-    float *hog = fb_alloc0(x_cells * y_cells * N_BINS * sizeof*hog, FB_ALLOC_NO_HINT);
-
-    //2. Finding Image Gradients
-    for (int y=roi->y, hog_index=0; y<h; y+=block_size) {
-        for (int x=roi->x; x<w; x+=block_size) {
-            float k = 0.0f;
-            for (int cy=0; cy<block_size; cy++) {
-                for (int cx=0; cx<block_size; cx++) {
-                    if ((y+cy) > 0 && (y+cy) < h && (x+cx) > 0 && (x+cx) < w) {
-                        // Find horizontal/vertical direction
-                        int vx = src->data[(y+cy+0)*s+(x+cx+1)] - src->data[(y+cy-0)*s+(x+cx-1)];
-                        int vy = src->data[(y+cy+1)*s+(x+cx+0)] - src->data[(y+cy-1)*s+(x+cx-0)];
-                        // Find magnitude
-                        float m = fast_sqrtf(vx*vx + vy*vy);
-                        if(((int) m) > 1) {
-                            k += m*m;
-                            // Find and quantize gradient degree
-                            // TODO atan2f is swapped for visualization
-                            int t = ((int) fast_fabsf((atan2f(vx, vy)*180.0f/M_PI))) / 20;
-                            t = (t == 9)? 0 : t;
-
-                            // hog[((cy/cell_size) * x_cells + (cx/cell_size)) * N_BINS + t] += m;
-                            hog[hog_index + (((cy/8)*2+(cx/8)) * N_BINS) + t] += m;
-                        }
-                    }
-                }
+    int stride = (x_cells+1)*HOG_PLANES;
+
+    ii->cell_size = cell_size;
+    ii->x_cells = x_cells;
+    ii->y_cells = y_cells;
+    ii->data = fb_alloc0((y_cells+1) * stride * sizeof(float), FB_ALLOC_NO_HINT);
+
+    // Cell sums, at (cx + 1, cy + 1)
+    for (int y=IM_MAX(roi->y, 1), yy=IM_MIN(h, roi->y+(y_cells*cell_size)); y<yy; y++) {
+        float *row = ii->data + ((((y-roi->y)/cell_size)+1) * stride);
+        for (int x=IM_MAX(roi->x, 1), xx=IM_MIN(w, roi->x+(x_cells*cell_size)); x<xx; x++) {
+            // Find horizontal/vertical direction
+            int vx = src->data[(y+0)*s+(x+1)] - src->data[(y-0)*s+(x-1)];
+            int vy = src->data[(y+1)*s+(x+0)] - src->data[(y-1)*s+(x-0)];
+            int m2 = vx*vx + vy*vy;
+            if (m2 >= 4) { // magnitude > 1
+                float *cell = row + ((((x-roi->x)/cell_size)+1) * HOG_PLANES);
+                cell[hog_bin(vx, vy)] += fast_sqrtf(m2);
+                cell[N_BINS] += m2;
             }
+        }
+    }
 
-            // Normalize the last block
-            k = sqrtf(k);
-            for (int i=hog_index; i<(hog_index+(N_BINS*4)); i++) {
-                    hog[i] = hog[i]/k;
+    // Prefix sums
+    for (int cy=1; cy<=y_cells; cy++) {
+        float *row = ii->data + (cy * stride);
+        for (int cx=1; cx<=x_cells; cx++) {
+            float *cell = row + (cx * HOG_PLANES);
+            for (int i=0; i<HOG_PLANES; i++) {
+                cell[i] += cell[i-HOG_PLANES] + cell[i-stride] - cell[i-HOG_PLANES-stride];
             }
-
-            hog_index += (N_BINS*4);
         }
     }
+}
+
+// Gradient histogram (N_BINS) of the window of cells at cell (cx, cy), returns its energy.
+float imlib_hog_integral_window(hog_integral_t *ii, int cx, int cy, int cw, int ch, float *hist)
+{
+    int stride = (ii->x_cells+1)*HOG_PLANES;
+    float *a = ii->data + (cy*stride) + (cx*HOG_PLANES);
+    float *b = a + (cw*HOG_PLANES), *c = a + (ch*stride), *d = c + (cw*HOG_PLANES);
+
+    for (int i=0; i<N_BINS; i++) {
+        hist[i] = d[i] - b[i] - c[i] + a[i];
+    }
+
+    return d[N_BINS] - b[N_BINS] - c[N_BINS] + a[N_BINS];
+}
+
+void imlib_find_hog(image_t *src, rectangle_t *roi, int cell_size)
+{
+    OMV_PROF_SCOPE("imlib_find_hog");
+    hog_integral_t ii;
+    imlib_hog_integral(src, roi, cell_size, &ii);
+
+    int x_cells = ii.x_cells;
+    int y_cells = ii.y_cells;
 
     memset(src->pixels, 0, src->w*src->h);
 
     array_t *gds;
     bin_t bins[9];
-    array_alloc(&gds, NULL);
+    array_alloc_scratch(&gds, NULL);
 
     for (int i=0; i<N_BINS; i++) {
         array_push_back(gds, &bins[i]);
     }
 
     int l = cell_size/2;
-    // Note cells are not ordered histograms of 4 cells
-    for (int by=0, hog_index=0; by<y_cells; by+=2) {
+    // Blocks of 2x2 cells, each cell normalized by the block's gradient energy
+    for (int by=0; by<y_cells; by+=2) {
         for (int bx=0; bx<x_cells; bx+=2) {
-            for (int y=0; y<2; y++) {
-                for (int x=0; x<2; x++) {
+            float hist[N_BINS];
+            float k = fast_sqrtf(imlib_hog_integral_window(&ii, bx, by, IM_MIN(x_cells-bx, 2), IM_MIN(y_cells-by, 2), hist));
+            for (int y=by; y<IM_MIN(by+2, y_cells); y++) {
+                for (int x=bx; x<IM_MIN(bx+2, x_cells); x++) {
+                    imlib_hog_integral_window(&ii, x, y, 1, 1, hist);
+
                     // Sort and draw bins
-                    for (int i=hog_index; i<hog_index+N_BINS; i++) {
-                        int m = (int)(hog[i]*255);
+                    for (int i=0; i<N_BINS; i++) {
+                        int m = (k > 0.0f) ? (int)(hist[i]*255/k) : 0;
                         if (m > 255) {
                             m = 255;
                         } else if (m < 0) {
                             m = 0;
                         }
-                        bin_t *bin = array_at(gds, (i%N_BINS));
+                        bin_t *bin = array_at(gds, i);
                         bin->m = m;
-                        bin->d = ((i%N_BINS)*20);
+                        bin->d = (i*20);
                     }
 
                     array_sort(gds, bin_array_comp);
 
-                    int x1 = (x+bx) * cell_size + l;
-                    int y1 = (y+by) * cell_size + l;
+                    int x1 = x * cell_size + l;
+                    int y1 = y * cell_size + l;
                     for (int i=0; i<N_BINS; i++) {
                         bin_t *bin = array_at(gds, i);
                         int x2 = l * cos_table[bin->d];
                         int y2 = l * sin_table[bin->d];
                         imlib_draw_line(src, (x1 - x2), (y1 + y2), (x1 + x2), (y1 - y2), bin->m, 1);
                     }
-
-                    hog_index += N_BINS;
                 }
             }
         }
     }
 
-    xfree(gds);
+    array_free(gds);
     fb_free();
 }
 #endif // IMLIB_ENABLE_HOG
@@ -4,11 +4,68 @@
  */
 
 #include "imlib.h"
+#include "py/runtime.h"
 
 #ifdef IMLIB_ENABLE_FIND_LINES
+// Coarse accumulator cells are FIND_LINES_COARSE x FIND_LINES_COARSE accumulator cells.
+#define FIND_LINES_COARSE_SHIFT 2
+#define FIND_LINES_COARSE (1 << FIND_LINES_COARSE_SHIFT)
+#define FIND_LINES_VOTE_MAGNITUDE_BITS 11 // The sobel magnitude is at most 1443.
+
+typedef struct find_lines_acc {
+    uint32_t *acc; // Accumulator, or NULL if the votes are recorded for the coarse to fine search.
+    uint32_t *coarse;
+    uint32_t *votes;
+    size_t votes_len;
+    int theta_size, coarse_theta_size, r_diag_len_div, hough_divide;
+} find_lines_acc_t;
+
+static inline void find_lines_vote(find_lines_acc_t *acc, int x, int y, int x_acc, int y_acc)
+{
+    // Flat regions have no gradient and vote nothing.
+    if (!(x_acc || y_acc)) return;
+
+    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 180; // * (180 / PI)
+    if (theta < 0) theta += 180;
+    int rho = (((((x * cos_table_q15[theta]) + (y * sin_table_q15[theta])) + 16384) >> 15) / acc->hough_divide) + acc->r_diag_len_div;
+    int acc_theta = (theta / acc->hough_divide) + 1; // add offset
+    int acc_index = (rho * acc->theta_size) + acc_theta;
+    int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
+
+    if (acc->acc) {
+        acc->acc[acc_index] += magnitude;
+    } else {
+        acc->coarse[((rho >> FIND_LINES_COARSE_SHIFT) * acc->coarse_theta_size) + (acc_theta >> FIND_LINES_COARSE_SHIFT)] += magnitude;
+        acc->votes[acc->votes_len++] = (acc_index << FIND_LINES_VOTE_MAGNITUDE_BITS) | magnitude;
+    }
+}
+
+static void find_lines_push(list_t *out, uint32_t magnitude, int x, int y, find_lines_acc_t *acc)
+{
+    find_lines_list_lnk_data_t lnk_line;
+    memset(&lnk_line, 0, sizeof(find_lines_list_lnk_data_t));
+
+    lnk_line.magnitude = magnitude;
+    lnk_line.theta = (x - 1) * acc->hough_divide; // remove offset
+    lnk_line.rho = (y - acc->r_diag_len_div) * acc->hough_divide;
+
+    list_push_back(out, &lnk_line);
+}
+
+// Returns the accumulator cell of the coarse to fine search, cells of coarse cells below the
+// threshold are 0 (they are less than the threshold, so they never beat a peak either).
+static inline uint32_t find_lines_fine_get(find_lines_acc_t *acc, uint32_t *tiles, int x, int y)
+{
+    uint32_t tile = acc->coarse[((y >> FIND_LINES_COARSE_SHIFT) * acc->coarse_theta_size) + (x >> FIND_LINES_COARSE_SHIFT)];
+    if (tile == UINT32_MAX) return 0;
+    return tiles[(tile << (FIND_LINES_COARSE_SHIFT * 2))
+               + ((y & (FIND_LINES_COARSE - 1)) << FIND_LINES_COARSE_SHIFT) + (x & (FIND_LINES_COARSE - 1))];
+}
+
 void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int x_stride, unsigned int y_stride,
                       uint32_t threshold, unsigned int theta_margin, unsigned int rho_margin)
 {
+    OMV_PROF_SCOPE("imlib_find_lines");
     int r_diag_len, r_diag_len_div, theta_size, r_size, hough_divide = 1; // divides theta and rho accumulators
 
     for (;;) { // shrink to fit...
@@ -21,11 +78,36 @@ void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
         if (hough_divide > 4) fb_alloc_fail(); // support 1, 2, 4
     }
 
-    uint32_t *acc = fb_alloc0(sizeof(uint32_t) * theta_size * r_size, FB_ALLOC_NO_HINT);
+    find_lines_acc_t acc;
+    acc.theta_size = theta_size;
+    acc.coarse_theta_size = (theta_size + FIND_LINES_COARSE - 1) >> FIND_LINES_COARSE_SHIFT;
+    acc.r_diag_len_div = r_diag_len_div;
+    acc.hough_divide = hough_divide;
+    acc.votes_len = 0;
+
+    // Coarse to fine: votes are summed in a coarse accumulator and recorded, and only the fine
+    // cells of coarse cells reaching the threshold are accumulated afterwards. This avoids
+    // clearing and searching the whole accumulator. Used when there's still room for the whole
+    // accumulator so that it can fall back to it if too many coarse cells reach the threshold.
+    size_t acc_size = sizeof(uint32_t) * theta_size * r_size;
+    size_t coarse_size = sizeof(uint32_t) * acc.coarse_theta_size * ((r_size + FIND_LINES_COARSE - 1) >> FIND_LINES_COARSE_SHIFT);
+    size_t votes_size = sizeof(uint32_t) * (((roi->h - 2 + y_stride - 1) / y_stride) * ((roi->w - 2 + x_stride - 1) / x_stride));
+    bool coarse_to_fine = ((roi->w > 2) && (roi->h > 2) && ((coarse_size + votes_size) < acc_size)
+                        && ((theta_size * r_size) < (1 << (32 - FIND_LINES_VOTE_MAGNITUDE_BITS)))
+                        && ((coarse_size + votes_size + acc_size + 64) <= fb_avail()));
+
+    if (coarse_to_fine) {
+        acc.acc = NULL;
+        acc.coarse = fb_alloc0(coarse_size, FB_ALLOC_NO_HINT);
+        acc.votes = fb_alloc(votes_size, FB_ALLOC_NO_HINT);
+    } else {
+        acc.acc = fb_alloc0(acc_size, FB_ALLOC_NO_HINT);
+    }
 
     switch (ptr->bpp) {
         case IMAGE_BPP_BINARY: {
             for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+                mp_sched_check_in();
                 uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
                 for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
                     int pixel; // Sobel Algorithm Below
@@ -76,20 +158,14 @@ void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
 
                     row_ptr -= ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
 
-                    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 180; // * (180 / PI)
-                    if (theta < 0) theta += 180;
-                    int rho = (fast_roundf(((x - roi->x) * cos_table[theta]) +
-                                ((y - roi->y) * sin_table[theta])) / hough_divide) + r_diag_len_div;
-                    int acc_index = (rho * theta_size) + ((theta / hough_divide) + 1); // add offset
-
-                    int acc_value = acc[acc_index] + fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
-                    acc[acc_index] = acc_value;
+                    find_lines_vote(&acc, x - roi->x, y - roi->y, x_acc, y_acc);
                 }
             }
             break;
         }
         case IMAGE_BPP_GRAYSCALE: {
             for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+                mp_sched_check_in();
                 uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
                 for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
                     int pixel; // Sobel Algorithm Below
@@ -140,20 +216,14 @@ void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
 
                     row_ptr -= ptr->w;
 
-                    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 180; // * (180 / PI)
-                    if (theta < 0) theta += 180;
-                    int rho = (fast_roundf(((x - roi->x) * cos_table[theta])
-                                + ((y - roi->y) * sin_table[theta])) / hough_divide) + r_diag_len_div;
-                    int acc_index = (rho * theta_size) + ((theta / hough_divide) + 1); // add offset
-
-                    int acc_value = acc[acc_index] + fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
-                    acc[acc_index] = acc_value;
+                    find_lines_vote(&acc, x - roi->x, y - roi->y, x_acc, y_acc);
                 }
             }
             break;
         }
         case IMAGE_BPP_RGB565: {
             for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+                mp_sched_check_in();
                 uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
                 for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
                     int pixel; // Sobel Algorithm Below
@@ -204,14 +274,7 @@ void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
 
                     row_ptr -= ptr->w;
 
-                    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 180; // * (180 / PI)
-                    if (theta < 0) theta += 180;
-                    int rho = (fast_roundf(((x - roi->x) * cos_table[theta])
-                                + ((y - roi->y) * sin_table[theta])) / hough_divide) + r_diag_len_div;
-                    int acc_index = (rho * theta_size) + ((theta / hough_divide) + 1); // add offset
-
-                    int acc_value = acc[acc_index] + fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
-                    acc[acc_index] = acc_value;
+                    find_lines_vote(&acc, x - roi->x, y - roi->y, x_acc, y_acc);
                 }
             }
             break;
@@ -223,33 +286,93 @@ void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
 
     list_init(out, sizeof(find_lines_list_lnk_data_t));
 
-    for (int y = 1, yy = r_size - 1; y < yy; y++) {
-        uint32_t *row_ptr = acc + (theta_size * y);
+    uint32_t *tiles = NULL;
 
-        for (int x = 1, xx = theta_size - 1; x < xx; x++) {
-            if ((row_ptr[x] >= threshold)
-            &&  (row_ptr[x] >= row_ptr[x-theta_size-1])
-            &&  (row_ptr[x] >= row_ptr[x-theta_size])
-            &&  (row_ptr[x] >= row_ptr[x-theta_size+1])
-            &&  (row_ptr[x] >= row_ptr[x-1])
-            &&  (row_ptr[x] >= row_ptr[x+1])
-            &&  (row_ptr[x] >= row_ptr[x+theta_size-1])
-            &&  (row_ptr[x] >= row_ptr[x+theta_size])
-            &&  (row_ptr[x] >= row_ptr[x+theta_size+1])) {
+    if (coarse_to_fine) {
+        // Number the coarse cells reaching the threshold.
+        size_t tiles_len = 0;
+        for (size_t i = 0, j = coarse_size / sizeof(uint32_t); i < j; i++) {
+            acc.coarse[i] = (acc.coarse[i] >= threshold) ? tiles_len++ : UINT32_MAX;
+        }
 
-                find_lines_list_lnk_data_t lnk_line;
-                memset(&lnk_line, 0, sizeof(find_lines_list_lnk_data_t));
+        size_t tiles_size = sizeof(uint32_t) * (tiles_len << (FIND_LINES_COARSE_SHIFT * 2));
 
-                lnk_line.magnitude = row_ptr[x];
-                lnk_line.theta = (x - 1) * hough_divide; // remove offset
-                lnk_line.rho = (y - r_diag_len_div) * hough_divide;
+        if (tiles_size <= acc_size) {
+            tiles = fb_alloc0(tiles_size + sizeof(uint32_t), FB_ALLOC_NO_HINT);
+        } else {
+            acc.acc = fb_alloc0(acc_size, FB_ALLOC_NO_HINT);
+        }
 
-                list_push_back(out, &lnk_line);
+        for (size_t i = 0; i < acc.votes_len; i++) {
+            int acc_index = acc.votes[i] >> FIND_LINES_VOTE_MAGNITUDE_BITS;
+            int magnitude = acc.votes[i] & ((1 << FIND_LINES_VOTE_MAGNITUDE_BITS) - 1);
+
+            if (acc.acc) {
+                acc.acc[acc_index] += magnitude;
+            } else {
+                int x = acc_index % theta_size, y = acc_index / theta_size;
+                uint32_t tile = acc.coarse[((y >> FIND_LINES_COARSE_SHIFT) * acc.coarse_theta_size) + (x >> FIND_LINES_COARSE_SHIFT)];
+                if (tile != UINT32_MAX) {
+                    tiles[(tile << (FIND_LINES_COARSE_SHIFT * 2))
+                        + ((y & (FIND_LINES_COARSE - 1)) << FIND_LINES_COARSE_SHIFT) + (x & (FIND_LINES_COARSE - 1))] += magnitude;
+                }
             }
         }
     }
 
-    fb_free(); // acc
+    if (tiles) {
+        // Same scan order as below, visiting only the cells of coarse cells above the threshold.
+        for (int y = 1, yy = r_size - 1; y < yy; y++) {
+            uint32_t *coarse_row = acc.coarse + ((y >> FIND_LINES_COARSE_SHIFT) * acc.coarse_theta_size);
+
+            for (int i = 0; i < acc.coarse_theta_size; i++) {
+                if (coarse_row[i] == UINT32_MAX) continue;
+
+                for (int x = IM_MAX(i << FIND_LINES_COARSE_SHIFT, 1),
+                     xx = IM_MIN((i + 1) << FIND_LINES_COARSE_SHIFT, theta_size - 1); x < xx; x++) {
+                    uint32_t value = find_lines_fine_get(&acc, tiles, x, y);
+
+                    if ((value >= threshold)
+                    &&  (value >= find_lines_fine_get(&acc, tiles, x - 1, y - 1))
+                    &&  (value >= find_lines_fine_get(&acc, tiles, x, y - 1))
+                    &&  (value >= find_lines_fine_get(&acc, tiles, x + 1, y - 1))
+                    &&  (value >= find_lines_fine_get(&acc, tiles, x - 1, y))
+                    &&  (value >= find_lines_fine_get(&acc, tiles, x + 1, y))
+                    &&  (value >= find_lines_fine_get(&acc, tiles, x - 1, y + 1))
+                    &&  (value >= find_lines_fine_get(&acc, tiles, x, y + 1))
+                    &&  (value >= find_lines_fine_get(&acc, tiles, x + 1, y + 1))) {
+                        find_lines_push(out, value, x, y, &acc);
+                    }
+                }
+            }
+        }
+    } else {
+        for (int y = 1, yy = r_size - 1; y < yy; y++) {
+            uint32_t *row_ptr = acc.acc + (theta_size * y);
+
+            for (int x = 1, xx = theta_size - 1; x < xx; x++) {
+                if ((row_ptr[x] >= threshold)
+                &&  (row_ptr[x] >= row_ptr[x-theta_size-1])
+                &&  (row_ptr[x] >= row_ptr[x-theta_size])
+                &&  (row_ptr[x] >= row_ptr[x-theta_size+1])
+                &&  (row_ptr[x] >= row_ptr[x-1])
+                &&  (row_ptr[x] >= row_ptr[x+1])
+                &&  (row_ptr[x] >= row_ptr[x+theta_size-1])
+                &&  (row_ptr[x] >= row_ptr[x+theta_size])
+                &&  (row_ptr[x] >= row_ptr[x+theta_size+1])) {
+                    find_lines_push(out, row_ptr[x], x, y, &acc);
+                }
+            }
+        }
+    }
+
+    if (coarse_to_fine) {
+        fb_free(); // tiles or acc
+        fb_free(); // votes
+        fb_free(); // coarse
+    } else {
+        fb_free(); // acc
+    }
 
     for (;;) { // Merge overlapping.
         bool merge_occured = false;
@@ -357,6 +480,7 @@ void imlib_find_line_segments(list_t *out, image_t *ptr, rectangle_t *roi, unsig
                               uint32_t threshold, unsigned int theta_margin, unsigned int rho_margin,
                               uint32_t segment_threshold)
 {
+    OMV_PROF_SCOPE("imlib_find_line_segments");
     const unsigned int max_theta_diff = 15;
     const unsigned int max_gap_pixels = 5;
 
@@ -456,6 +580,7 @@ void imlib_find_circles(list_t *out, image_t *ptr, rectangle_t *roi, unsigned in
                         uint32_t threshold, unsigned int x_margin, unsigned int y_margin, unsigned int r_margin,
                         unsigned int r_min, unsigned int r_max, unsigned int r_step)
 {
+    OMV_PROF_SCOPE("imlib_find_circles");
     uint16_t *theta_acc = fb_alloc0(sizeof(uint16_t) * roi->w * roi->h, FB_ALLOC_NO_HINT);
     uint16_t *magnitude_acc = fb_alloc0(sizeof(uint16_t) * roi->w * roi->h, FB_ALLOC_NO_HINT);
 
@@ -512,6 +637,9 @@ void imlib_find_circles(list_t *out, image_t *ptr, rectangle_t *roi, unsigned in
 
                     row_ptr -= ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
 
+                    // Flat regions have no gradient and vote nothing.
+                    if (!(x_acc || y_acc)) continue;
+
                     int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 360; // * (180 / PI)
                     if (theta < 0) theta += 360;
                     int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
@@ -575,6 +703,9 @@ void imlib_find_circles(list_t *out, image_t *ptr, rectangle_t *roi, unsigned in
 
                     row_ptr -= ptr->w;
 
+                    // Flat regions have no gradient and vote nothing.
+                    if (!(x_acc || y_acc)) continue;
+
                     int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 360; // * (180 / PI)
                     if (theta < 0) theta += 360;
                     int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
@@ -638,6 +769,9 @@ void imlib_find_circles(list_t *out, image_t *ptr, rectangle_t *roi, unsigned in
 
                     row_ptr -= ptr->w;
 
+                    // Flat regions have no gradient and vote nothing.
+                    if (!(x_acc || y_acc)) continue;
+
                     int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 360; // * (180 / PI)
                     if (theta < 0) theta += 360;
                     int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
@@ -702,9 +836,9 @@ void imlib_find_circles(list_t *out, image_t *ptr, rectangle_t *roi, unsigned in
                 // Only graidents pointing inside of the circle sum up to produce a large magnitude.
 
                 for (;;) { // Hi to lo edge direction
-                    int a = fast_roundf(x + (r * cos_table[theta])) - r;
+                    int a = x + (((r * cos_table_q15[theta]) + 16384) >> 15) - r;
                     if ((a < 0) || (w_size <= a)) break; // circle doesn't fit in the window
-                    int b = fast_roundf(y + (r * sin_table[theta])) - r;
+                    int b = y + (((r * sin_table_q15[theta]) + 16384) >> 15) - r;
                     if ((b < 0) || (h_size <= b)) break; // circle doesn't fit in the window
                     int acc_index = (((b / hough_divide) + 1) * a_size) + ((a / hough_divide) + 1); // add offset
 
@@ -714,9 +848,9 @@ void imlib_find_circles(list_t *out, image_t *ptr, rectangle_t *roi, unsigned in
                 }
 
                 for (;;) { // Lo to hi edge direction
-                    int a = fast_roundf(x + (r * cos_table[(theta + 180) % 360])) - r;
+                    int a = x + (((r * cos_table_q15[(theta + 180) % 360]) + 16384) >> 15) - r;
                     if ((a < 0) || (w_size <= a)) break; // circle doesn't fit in the window
-                    int b = fast_roundf(y + (r * sin_table[(theta + 180) % 360])) - r;
+                    int b = y + (((r * sin_table_q15[(theta + 180) % 360]) + 16384) >> 15) - r;
                     if ((b < 0) || (h_size <= b)) break; // circle doesn't fit in the window
                     int acc_index = (((b / hough_divide) + 1) * a_size) + ((a / hough_divide) + 1); // add offset
 
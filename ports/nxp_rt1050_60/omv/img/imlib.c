@@ -13,6 +13,7 @@
 #include "ff_wrapper.h"
 #include "imlib.h"
 #include "common.h"
+#include "xalloc.h"
 #include "omv_boardconfig.h"
 
 /////////////////
@@ -247,6 +248,9 @@ size_t image_size(image_t *ptr)
         case IMAGE_BPP_BAYER: {
             return ptr->w * ptr->h;
         }
+        case IMAGE_BPP_YUV422: {
+            return IMAGE_YUV422_LINE_LEN_BYTES(ptr) * ptr->h;
+        }
         default: { // JPEG
             return ptr->bpp;
         }
@@ -275,6 +279,23 @@ bool image_get_mask_pixel(image_t *ptr, int x, int y)
     return false;
 }
 
+const uint32_t *image_get_mask_row(image_t *ptr, int w, int y, uint32_t *buf)
+{
+    if ((ptr->bpp == IMAGE_BPP_BINARY) && (w <= ptr->w) && (0 <= y) && (y < ptr->h)) {
+        return IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
+    }
+
+    memset(buf, 0, ((w + UINT32_T_MASK) >> UINT32_T_SHIFT) * sizeof(uint32_t));
+
+    for (int x = 0, xx = IM_MIN(w, ptr->w); x < xx; x++) {
+        if (image_get_mask_pixel(ptr, x, y)) {
+            IMAGE_SET_BINARY_PIXEL_FAST(buf, x);
+        }
+    }
+
+    return buf;
+}
+
 // Gamma uncompress
 extern const float xyz_table[256];
 
@@ -414,8 +435,102 @@ uint16_t imlib_yuv_to_rgb(uint8_t y, int8_t u, int8_t v)
     return COLOR_R8_G8_B8_TO_RGB565(r, g, b);
 }
 
+#ifdef IMLIB_ENABLE_THRESHOLDS_LUT
+typedef struct color_thresholds_lut {
+    color_thresholds_list_lnk_data_t thresholds[COLOR_THRESHOLDS_LUT_MAX];
+    size_t thresholds_len;
+    bool invert;
+    uint8_t table[65536];
+} color_thresholds_lut_t;
+#endif
+
+// Soft reset, the table went away with the GC heap.
+void imlib_thresholds_lut_init0()
+{
+    #ifdef IMLIB_ENABLE_THRESHOLDS_LUT
+    MP_STATE_PORT(imlib_thresholds_lut) = NULL;
+    #endif
+}
+
+// Compiles a Lab thresholds list into one table entry per RGB565 value (see COLOR_THRESHOLD_LUT()).
+// The table is kept and only rebuilt when the list or invert changes, so a script thresholding
+// every frame with the same list pays for it once. Returns NULL if the list is too long or the
+// GC heap has no room, callers then threshold each pixel as before.
+const uint8_t *imlib_thresholds_lut(list_t *thresholds, bool invert)
+{
+    #ifdef IMLIB_ENABLE_THRESHOLDS_LUT
+    size_t len = list_size(thresholds);
+
+    if ((!len) || (len > COLOR_THRESHOLDS_LUT_MAX)) {
+        return NULL;
+    }
+
+    color_thresholds_list_lnk_data_t t[COLOR_THRESHOLDS_LUT_MAX];
+    size_t i = 0;
+    for (list_lnk_t *it = iterator_start_from_head(thresholds); it; it = iterator_next(it)) {
+        iterator_get(thresholds, it, &t[i++]);
+    }
+
+    color_thresholds_lut_t *lut = MP_STATE_PORT(imlib_thresholds_lut);
+
+    if (lut && (lut->thresholds_len == len) && (lut->invert == invert)
+    && (!memcmp(lut->thresholds, t, len * sizeof(color_thresholds_list_lnk_data_t)))) {
+        return lut->table;
+    }
+
+    if (!lut) {
+        lut = xalloc_try_alloc(sizeof(color_thresholds_lut_t));
+        if (!lut) {
+            return NULL;
+        }
+        MP_STATE_PORT(imlib_thresholds_lut) = lut;
+    }
+
+    #if defined(IMLIB_ENABLE_LAB_LUT)
+    OverlaySwitch(OVLY_LAB_TAB);
+    #endif
+    for (int pixel = 0; pixel < 65536; pixel++) {
+        int l = COLOR_RGB565_TO_L(pixel);
+        int a = COLOR_RGB565_TO_A(pixel);
+        int b = COLOR_RGB565_TO_B(pixel);
+        int bits = 0;
+        for (i = 0; i < len; i++) {
+            bits |= (((t[i].LMin <= l) && (l <= t[i].LMax) &&
+                      (t[i].AMin <= a) && (a <= t[i].AMax) &&
+                      (t[i].BMin <= b) && (b <= t[i].BMax)) ^ invert) << i;
+        }
+        lut->table[pixel] = bits;
+    }
+
+    memcpy(lut->thresholds, t, len * sizeof(color_thresholds_list_lnk_data_t));
+    lut->thresholds_len = len;
+    lut->invert = invert;
+    return lut->table;
+    #else
+    return NULL;
+    #endif
+}
+
+// YUV thresholds are separable, so one bit per threshold and channel value covers them all in
+// 3 KB, cheap enough to build on every call.
+void imlib_yuv_thresholds_lut(list_t *thresholds, uint32_t *lut)
+{
+    memset(lut, 0, 3 * 256 * sizeof(uint32_t));
+    int i = 0;
+    for (list_lnk_t *it = iterator_start_from_head(thresholds); it && (i < COLOR_YUV_THRESHOLDS_MAX); it = iterator_next(it), i++) {
+        color_thresholds_list_lnk_data_t t;
+        iterator_get(thresholds, it, &t);
+        for (int v = 0; v < 256; v++) {
+            lut[v] |= ((uint32_t) ((t.LMin <= v) && (v <= t.LMax))) << i;
+            lut[256 + v] |= ((uint32_t) ((t.AMin <= (v - 128)) && ((v - 128) <= t.AMax))) << i;
+            lut[512 + v] |= ((uint32_t) ((t.BMin <= (v - 128)) && ((v - 128) <= t.BMax))) << i;
+        }
+    }
+}
+
 void imlib_bayer_to_rgb565(image_t *img, int w, int h, int xoffs, int yoffs, uint16_t *rgbbuf)
 {
+    OMV_PROF_SCOPE("imlib_bayer_to_rgb565");
     int r, g, b;
     for (int y=yoffs; y<yoffs+h; y++) {
         for (int x=xoffs; x<xoffs+w; x++) {
@@ -472,6 +587,16 @@ void imlib_bayer_to_rgb565(image_t *img, int w, int h, int xoffs, int yoffs, uin
         }
     }
 }
+
+// The grayscale or RGB565 pixels of roi of a raw Bayer or YUV422 image, dst is src's size.
+void imlib_unpack(image_t *dst, image_t *src, rectangle_t *roi)
+{
+    if (src->bpp == IMAGE_BPP_BAYER) {
+        imlib_debayer(dst, src, roi);
+    } else {
+        imlib_yuv422_unpack(dst, src, roi);
+    }
+}
 ////////////////////////////////////////////////////////////////////////////////
 
 static save_image_format_t imblib_parse_extension(image_t *img, const char *path)
@@ -499,7 +624,7 @@ static save_image_format_t imblib_parse_extension(image_t *img, const char *path
                &&  ((p[-2] == 'm') || (p[-2] == 'M'))
                &&  ((p[-3] == 'b') || (p[-3] == 'B'))
                &&  ((p[-4] == '.') || (p[-4] == '.'))) {
-                    if (IM_IS_JPEG(img) || IM_IS_BAYER(img)) {
+                    if (IM_IS_JPEG(img) || IM_IS_BAYER(img) || IM_IS_YUV422(img)) {
                         nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "Image is not BMP!"));
                     }
                     return FORMAT_BMP;
@@ -693,8 +818,38 @@ void imlib_image_operation(image_t *img, const char *path, image_t *other, int s
     }
 }
 
+bool imlib_image_operation_in_memory(image_t *img, const char *path, image_t *other, image_t *mask)
+{
+    if (path || (!IMAGE_IS_MUTABLE(img)) || (((uintptr_t) img->data) & 3)) {
+        return false;
+    }
+    if (other && (!IM_EQUAL(img, other))) {
+        ff_not_equal(NULL);
+    }
+    return true;
+}
+
+uint32_t imlib_image_operation_scalar(image_t *img, int scalar)
+{
+    switch (img->bpp) {
+        case IMAGE_BPP_BINARY: {
+            return (scalar & 1) ? 0xFFFFFFFF : 0;
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            return (scalar & 0xFF) * 0x01010101;
+        }
+        case IMAGE_BPP_RGB565: {
+            return (scalar & 0xFFFF) * 0x00010001;
+        }
+        default: {
+            return 0;
+        }
+    }
+}
+
 void imlib_load_image(image_t *img, const char *path)
 {
+    OMV_PROF_SCOPE("imlib_load_image");
     FIL fp;
     file_read_open(&fp, path);
     char magic[2];
@@ -717,6 +872,7 @@ void imlib_load_image(image_t *img, const char *path)
 
 void imlib_save_image(image_t *img, const char *path, rectangle_t *roi, int quality)
 {
+    OMV_PROF_SCOPE("imlib_save_image");
     switch (imblib_parse_extension(img, path)) {
         case FORMAT_BMP:
             bmp_write_subimg(img, path, roi);
@@ -736,7 +892,7 @@ void imlib_save_image(image_t *img, const char *path, rectangle_t *roi, int qual
             break;
         case FORMAT_DONT_CARE:
             // Path doesn't have an extension.
-            if (IM_IS_JPEG(img)) {
+            if (IM_IS_JPEG(img) || IM_IS_YUV422(img)) {
                 char *new_path = strcat(strcpy(fb_alloc(strlen(path)+5, FB_ALLOC_NO_HINT), path), ".jpg");
                 jpeg_write(img, new_path, quality);
                 fb_free();
@@ -760,6 +916,7 @@ void imlib_save_image(image_t *img, const char *path, rectangle_t *roi, int qual
 
 void imlib_zero(image_t *img, image_t *mask, bool invert)
 {
+    OMV_PROF_SCOPE("imlib_zero");
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
             for (int y = 0, yy = img->h; y < yy; y++) {
@@ -802,123 +959,148 @@ void imlib_zero(image_t *img, image_t *mask, bool invert)
 
 // A simple algorithm for correcting lens distortion.
 // See http://www.tannerhelland.com/4743/simple-algorithm-correcting-lens-distortion/
+//
+// Output row y only reads source rows within the largest displacement of y, so the image is
+// corrected in place, one row at a time. Rows are saved to a ring before they are overwritten
+// and only the rows that later output rows still read are kept around (a band of a few rows
+// around y instead of a copy of the whole frame).
+//
+// The source pixels are looked up in a cached remap table (see remap.c) when there is room for
+// one, so the float math only runs again when the size, strength or zoom change.
+static int imlib_lens_corr_source_y(int newX, int newY, int halfHeight, float lens_corr_radius, float zoom)
+{
+    float r = lens_corr_radius * fast_sqrtf((newX * newX) + (newY * newY));
+    float theta = (r < 0.0000001f) ? 1.0f : (fast_atanf(r) / r);
+    return halfHeight + fast_floorf(theta * (newY * zoom));
+}
+
+// Remap table entry of output pixel (x, y), params are {lens_corr_radius, zoom}.
+static inline uint32_t imlib_lens_corr_entry(int x, int y, int w, int h, const float *params)
+{
+    int halfWidth = w / 2;
+    int halfHeight = h / 2;
+    int newX = x - halfWidth;
+    int newY = y - halfHeight;
+
+    float r = params[0] * fast_sqrtf((newX * newX) + (newY * newY));
+    float theta = (r < 0.0000001f) ? 1.0f : (fast_atanf(r) / r);
+    int sourceX = halfWidth + fast_floorf(theta * (newX * params[1]));
+    int sourceY = halfHeight + fast_floorf(theta * (newY * params[1]));
+
+    if ((0 <= sourceX) && (sourceX < w) && (0 <= sourceY) && (sourceY < h)) {
+        return IMLIB_REMAP_ENTRY(sourceX, sourceY);
+    }
+
+    return IMLIB_REMAP_NONE;
+}
+
+static void imlib_lens_corr_fill(uint32_t *table, int w, int h, const float *params)
+{
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            *(table++) = imlib_lens_corr_entry(x, y, w, h, params);
+        }
+    }
+}
+
 void imlib_lens_corr(image_t *img, float strength, float zoom)
 {
+    OMV_PROF_SCOPE("imlib_lens_corr");
     zoom = 1 / zoom;
     int halfWidth = img->w / 2;
     int halfHeight = img->h / 2;
     float lens_corr_radius = strength / fast_sqrtf((img->w * img->w) + (img->h * img->h));
+    float params[2] = {lens_corr_radius, zoom};
+    int line_len_bytes = 0;
 
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
-            // Create a temp copy of the image to pull pixels from.
-            uint32_t *tmp = fb_alloc(((img->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * img->h, FB_ALLOC_NO_HINT);
-            memcpy(tmp, img->data, ((img->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * img->h);
-            memset(img->data, 0, ((img->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * img->h);
-
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                int newY = y - halfHeight;
-                int newY2 = newY * newY;
-                float zoomedY = newY * zoom;
-
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    int newX = x - halfWidth;
-                    int newX2 = newX * newX;
-                    float zoomedX = newX * zoom;
-
-                    float r = lens_corr_radius * fast_sqrtf(newX2 + newY2);
-                    float theta = (r < 0.0000001f) ? 1.0f : (fast_atanf(r) / r);
-                    int sourceX = halfWidth + fast_floorf(theta * zoomedX);
-                    int sourceY = halfHeight + fast_floorf(theta * zoomedY);
-
-                    if ((0 <= sourceX) && (sourceX < img->w) && (0 <= sourceY) && (sourceY < img->h)) {
-                        uint32_t *ptr = tmp + (((img->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * sourceY);
-                        int pixel = IMAGE_GET_BINARY_PIXEL_FAST(ptr, sourceX);
-                        IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x, pixel);
-                    }
-                }
-            }
-
-            fb_free();
+            line_len_bytes = IMAGE_BINARY_LINE_LEN_BYTES(img);
             break;
         }
         case IMAGE_BPP_GRAYSCALE: {
-            // Create a temp copy of the image to pull pixels from.
-            uint8_t *tmp = fb_alloc(img->w * img->h * sizeof(uint8_t), FB_ALLOC_NO_HINT);
-            memcpy(tmp, img->data, img->w * img->h * sizeof(uint8_t));
-            memset(img->data, 0, img->w * img->h * sizeof(uint8_t));
+            line_len_bytes = IMAGE_GRAYSCALE_LINE_LEN_BYTES(img);
+            break;
+        }
+        case IMAGE_BPP_RGB565: {
+            line_len_bytes = IMAGE_RGB565_LINE_LEN_BYTES(img);
+            break;
+        }
+        default: {
+            return;
+        }
+    }
 
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                int newY = y - halfHeight;
-                int newY2 = newY * newY;
-                float zoomedY = newY * zoom;
+    // keep[y] is the lowest source row read by output rows y and below. Theta only depends on the
+    // distance to the center so the source rows of a line are extreme at its center and edge
+    // pixels (the slack covers fast_atanf() not being exactly monotonic).
+    int *keep = fb_alloc(img->h * sizeof(int), FB_ALLOC_NO_HINT);
+    int ring_rows = 1;
 
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    int newX = x - halfWidth;
-                    int newX2 = newX * newX;
-                    float zoomedX = newX * zoom;
-
-                    float r = lens_corr_radius * fast_sqrtf(newX2 + newY2);
-                    float theta = (r < 0.0000001f) ? 1.0f : (fast_atanf(r) / r);
-                    int sourceX = halfWidth + fast_floorf(theta * zoomedX);
-                    int sourceY = halfHeight + fast_floorf(theta * zoomedY);
-
-                    if ((0 <= sourceX) && (sourceX < img->w) && (0 <= sourceY) && (sourceY < img->h)) {
-                        uint8_t *ptr = tmp + (img->w * sourceY);
-                        int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(ptr, sourceX);
-                        IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row_ptr, x, pixel);
-                    }
-                }
-            }
+    for (int y = img->h - 1; y >= 0; y--) {
+        int newY = y - halfHeight;
+        int center = imlib_lens_corr_source_y(0, newY, halfHeight, lens_corr_radius, zoom);
+        int edge = imlib_lens_corr_source_y(-halfWidth, newY, halfHeight, lens_corr_radius, zoom);
+        keep[y] = IM_MAX(IM_MIN(IM_MIN(center, edge) - 2, y), 0);
 
-            fb_free();
-            break;
+        if ((y + 1) < img->h) {
+            keep[y] = IM_MIN(keep[y], keep[y + 1]);
         }
-        case IMAGE_BPP_RGB565: {
-            // Create a temp copy of the image to pull pixels from.
-            uint16_t *tmp = fb_alloc(img->w * img->h * sizeof(uint16_t), FB_ALLOC_NO_HINT);
-            memcpy(tmp, img->data, img->w * img->h * sizeof(uint16_t));
-            memset(img->data, 0, img->w * img->h * sizeof(uint16_t));
 
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                int newY = y - halfHeight;
-                int newY2 = newY * newY;
-                float zoomedY = newY * zoom;
+        ring_rows = IM_MAX(ring_rows, y - keep[y] + 1);
+    }
 
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    int newX = x - halfWidth;
-                    int newX2 = newX * newX;
-                    float zoomedX = newX * zoom;
-
-                    float r = lens_corr_radius * fast_sqrtf(newX2 + newY2);
-                    float theta = (r < 0.0000001f) ? 1.0f : (fast_atanf(r) / r);
-                    int sourceX = halfWidth + fast_floorf(theta * zoomedX);
-                    int sourceY = halfHeight + fast_floorf(theta * zoomedY);
-
-                    if ((0 <= sourceX) && (sourceX < img->w) && (0 <= sourceY) && (sourceY < img->h)) {
-                        uint16_t *ptr = tmp + (img->w * sourceY);
-                        int pixel = IMAGE_GET_RGB565_PIXEL_FAST(ptr, sourceX);
-                        IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x, pixel);
-                    }
+    uint8_t *ring = fb_alloc(line_len_bytes * ring_rows, FB_ALLOC_NO_HINT);
+    const uint32_t *table = imlib_remap_table(IMLIB_REMAP_LENS_CORR, img->w, img->h, params, 2, imlib_lens_corr_fill);
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        memcpy(ring + (line_len_bytes * (y % ring_rows)), img->data + (line_len_bytes * y), line_len_bytes);
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            uint32_t entry = table ? *(table++) : imlib_lens_corr_entry(x, y, img->w, img->h, params);
+            int sourceX = IMLIB_REMAP_X(entry);
+            int sourceY = IMLIB_REMAP_Y(entry);
+
+            // Rows up to y have been overwritten, their original pixels are in the ring.
+            uint8_t *ptr = (entry == IMLIB_REMAP_NONE) ? NULL : (sourceY <= y)
+                         ? (ring + (line_len_bytes * (sourceY % ring_rows)))
+                         : (img->data + (line_len_bytes * sourceY));
+
+            switch(img->bpp) {
+                case IMAGE_BPP_BINARY: {
+                    uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+                    int pixel = ptr ? IMAGE_GET_BINARY_PIXEL_FAST((uint32_t *) ptr, sourceX) : 0;
+                    IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x, pixel);
+                    break;
+                }
+                case IMAGE_BPP_GRAYSCALE: {
+                    uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+                    int pixel = ptr ? IMAGE_GET_GRAYSCALE_PIXEL_FAST(ptr, sourceX) : 0;
+                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row_ptr, x, pixel);
+                    break;
+                }
+                case IMAGE_BPP_RGB565: {
+                    uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+                    int pixel = ptr ? IMAGE_GET_RGB565_PIXEL_FAST((uint16_t *) ptr, sourceX) : 0;
+                    IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x, pixel);
+                    break;
+                }
+                default: {
+                    break;
                 }
             }
-
-            fb_free();
-            break;
-        }
-        default: {
-            break;
         }
     }
+
+    fb_free(); // ring
+    fb_free(); // keep
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 int imlib_image_mean(image_t *src, int *r_mean, int *g_mean, int *b_mean)
 {
+    OMV_PROF_SCOPE("imlib_image_mean");
     int r_s = 0;
     int g_s = 0;
     int b_s = 0;
@@ -961,6 +1143,7 @@ int imlib_image_mean(image_t *src, int *r_mean, int *g_mean, int *b_mean)
 // One pass standard deviation.
 int imlib_image_std(image_t *src)
 {
+    OMV_PROF_SCOPE("imlib_image_std");
     int w=src->w;
     int h=src->h;
     int n=w*h;
@@ -990,6 +1173,7 @@ int imlib_image_std(image_t *src)
 
 void imlib_sepconv3(image_t *img, const int8_t *krn, const float m, const int b)
 {
+    OMV_PROF_SCOPE("imlib_sepconv3");
     int ksize = 3;
     // TODO: Support RGB
     int *buffer = fb_alloc(img->w * sizeof(*buffer) * 2, FB_ALLOC_NO_HINT);
@@ -1020,3 +1204,252 @@ void imlib_sepconv3(image_t *img, const int8_t *krn, const float m, const int b)
     }
     fb_free();
 }
+
+#if defined(IMLIB_ENABLE_DATAMATRICES) || defined(IMLIB_ENABLE_BARCODES)
+// Symbol locator shared by the data matrix and bar code decoders. Splits the roi of a grayscale
+// image into blocks, keeps the blocks with a high density of strong gradients (module and bar
+// edges) and returns the bounding boxes of the connected groups of them, padded by a quiet zone
+// margin and merged when they overlap. Falls back to the whole roi when the dense blocks cover
+// too much of the image for the locator to help.
+#define SYMBOL_ROIS_BLOCK 8
+#define SYMBOL_ROIS_EDGE_THRESHOLD 24
+#define SYMBOL_ROIS_MIN_EDGES 12 // out of SYMBOL_ROIS_BLOCK^2
+#define SYMBOL_ROIS_MIN_BLOCKS 2
+#define SYMBOL_ROIS_MARGIN 2 // in blocks
+#define SYMBOL_ROIS_MAX 16
+
+void imlib_find_symbol_rois(list_t *out, image_t *ptr, rectangle_t *roi)
+{
+    OMV_PROF_SCOPE("imlib_find_symbol_rois");
+    list_init(out, sizeof(rectangle_t));
+
+    int bw = (roi->w + SYMBOL_ROIS_BLOCK - 1) / SYMBOL_ROIS_BLOCK;
+    int bh = (roi->h + SYMBOL_ROIS_BLOCK - 1) / SYMBOL_ROIS_BLOCK;
+    uint8_t *blocks = fb_alloc0(bw * bh, FB_ALLOC_NO_HINT);
+    uint32_t *stack = fb_alloc(bw * bh * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+    rectangle_t *rects = fb_alloc(SYMBOL_ROIS_MAX * sizeof(rectangle_t), FB_ALLOC_NO_HINT);
+    int rects_len = 0;
+    bool overflow = false;
+
+    // Count the edge pixels of each block (forward differences, the last row/col has none).
+    for (int y = roi->y, yy = roi->y + roi->h - 1; y < yy; y++) {
+        uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
+        uint8_t *next_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y + 1);
+        uint8_t *block_row = blocks + (((y - roi->y) / SYMBOL_ROIS_BLOCK) * bw);
+
+        for (int x = roi->x, xx = roi->x + roi->w - 1; x < xx; x++) {
+            int pixel = row_ptr[x];
+            int dx = abs(row_ptr[x + 1] - pixel);
+            int dy = abs(next_row_ptr[x] - pixel);
+
+            if (IM_MAX(dx, dy) > SYMBOL_ROIS_EDGE_THRESHOLD) {
+                block_row[(x - roi->x) / SYMBOL_ROIS_BLOCK] += 1;
+            }
+        }
+    }
+
+    // 0 = sparse, 1 = dense, 2 = dense and grouped.
+    for (int i = 0, j = bw * bh; i < j; i++) {
+        blocks[i] = blocks[i] >= SYMBOL_ROIS_MIN_EDGES;
+    }
+
+    for (int i = 0, j = bw * bh; (i < j) && (!overflow); i++) {
+        if (blocks[i] != 1) {
+            continue;
+        }
+
+        int stack_len = 0, count = 0;
+        int bx_min = i % bw, bx_max = bx_min, by_min = i / bw, by_max = by_min;
+        stack[stack_len++] = i;
+        blocks[i] = 2;
+
+        while (stack_len) {
+            int b = stack[--stack_len], bx = b % bw, by = b / bw;
+            bx_min = IM_MIN(bx_min, bx);
+            bx_max = IM_MAX(bx_max, bx);
+            by_min = IM_MIN(by_min, by);
+            by_max = IM_MAX(by_max, by);
+            count += 1;
+
+            if ((bx > 0) && (blocks[b - 1] == 1)) { blocks[b - 1] = 2; stack[stack_len++] = b - 1; }
+            if ((bx < (bw - 1)) && (blocks[b + 1] == 1)) { blocks[b + 1] = 2; stack[stack_len++] = b + 1; }
+            if ((by > 0) && (blocks[b - bw] == 1)) { blocks[b - bw] = 2; stack[stack_len++] = b - bw; }
+            if ((by < (bh - 1)) && (blocks[b + bw] == 1)) { blocks[b + bw] = 2; stack[stack_len++] = b + bw; }
+        }
+
+        if (count < SYMBOL_ROIS_MIN_BLOCKS) {
+            continue;
+        }
+
+        int x_min = roi->x + ((bx_min - SYMBOL_ROIS_MARGIN) * SYMBOL_ROIS_BLOCK);
+        int y_min = roi->y + ((by_min - SYMBOL_ROIS_MARGIN) * SYMBOL_ROIS_BLOCK);
+        int x_max = roi->x + ((bx_max + SYMBOL_ROIS_MARGIN + 1) * SYMBOL_ROIS_BLOCK);
+        int y_max = roi->y + ((by_max + SYMBOL_ROIS_MARGIN + 1) * SYMBOL_ROIS_BLOCK);
+
+        rectangle_t temp;
+        rectangle_init(&temp, x_min, y_min, x_max - x_min, y_max - y_min);
+        rectangle_intersected(&temp, roi);
+
+        // Merge with the overlapping rects, the union may in turn overlap others.
+        for (int k = 0; k < rects_len; ) {
+            if (rectangle_overlap(&temp, &rects[k])) {
+                rectangle_united(&temp, &rects[k]);
+                rects[k] = rects[--rects_len];
+                k = 0;
+            } else {
+                k++;
+            }
+        }
+
+        if (rects_len < SYMBOL_ROIS_MAX) {
+            rects[rects_len++] = temp;
+        } else {
+            overflow = true;
+        }
+    }
+
+    int area = 0;
+
+    for (int i = 0; i < rects_len; i++) {
+        area += rects[i].w * rects[i].h;
+    }
+
+    if (overflow || (area > ((roi->w * roi->h) / 2))) {
+        list_push_back(out, roi);
+    } else {
+        for (int i = 0; i < rects_len; i++) {
+            list_push_back(out, &rects[i]);
+        }
+    }
+
+    fb_free();
+    fb_free();
+    fb_free();
+}
+#endif // IMLIB_ENABLE_DATAMATRICES || IMLIB_ENABLE_BARCODES
+
+#if defined(IMLIB_ENABLE_QRCODES) && defined(IMLIB_ENABLE_APRILTAGS) && defined(IMLIB_ENABLE_BARCODES)
+// Moves the codes a decoder found in one window to the codes of all of them. The windows the
+// locator grows for tags and qrcodes may overlap, a code centered inside one already found is
+// found again and dropped. All the lnk types start with the corners and rect.
+static void find_codes_append(list_t *out, list_t *in, bool payload)
+{
+    union {
+        find_qrcodes_list_lnk_data_t qrcode;
+        find_apriltags_list_lnk_data_t apriltag;
+        find_barcodes_list_lnk_data_t barcode;
+    } lnk_data;
+
+    while (list_size(in)) {
+        list_pop_front(in, &lnk_data);
+        rectangle_t *r = &lnk_data.qrcode.rect;
+        int x = r->x + (r->w / 2), y = r->y + (r->h / 2);
+        bool found = false;
+
+        for (list_lnk_t *it = iterator_start_from_head(out); it && (!found); it = iterator_next(it)) {
+            rectangle_t *o = &((find_qrcodes_list_lnk_data_t *) it->data)->rect;
+            found = (o->x <= x) && (x < (o->x + o->w)) && (o->y <= y) && (y < (o->y + o->h));
+        }
+
+        if (!found) {
+            list_push_back(out, &lnk_data);
+        } else if (payload) {
+            xfree(lnk_data.qrcode.payload);
+        }
+    }
+}
+
+void imlib_find_codes(list_t *qrcodes, list_t *apriltags, list_t *barcodes, image_t *ptr, rectangle_t *roi,
+                      apriltag_families_t families, float fx, float fy, float cx, float cy)
+{
+    OMV_PROF_SCOPE("imlib_find_codes");
+    if (qrcodes) list_init(qrcodes, sizeof(find_qrcodes_list_lnk_data_t));
+    if (apriltags) list_init(apriltags, sizeof(find_apriltags_list_lnk_data_t));
+    if (barcodes) list_init(barcodes, sizeof(find_barcodes_list_lnk_data_t));
+
+    // The grayscale the decoders share, in the coordinates of the image so no code is translated.
+    image_t img;
+    image_init(&img, ptr->w, ptr->h, IMAGE_BPP_GRAYSCALE,
+               (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->data : fb_alloc(ptr->w * ptr->h, FB_ALLOC_NO_HINT));
+
+    for (int y = roi->y, yy = roi->y + roi->h; (ptr->bpp != IMAGE_BPP_GRAYSCALE) && (y < yy); y++) {
+        uint8_t *img_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&img, y);
+        switch (ptr->bpp) {
+            case IMAGE_BPP_BINARY: {
+                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
+                for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                    img_row_ptr[x] = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                }
+                break;
+            }
+            case IMAGE_BPP_RGB565: {
+                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
+                for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                    img_row_ptr[x] = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                }
+                break;
+            }
+            default: {
+                memset(img_row_ptr + roi->x, 0, roi->w);
+                break;
+            }
+        }
+    }
+
+    // One gradient pass finds the windows with symbols in them, each decoder then only
+    // thresholds and scans those instead of the whole roi.
+    list_t rois;
+    imlib_find_symbol_rois(&rois, &img, roi);
+
+    for (list_lnk_t *it = iterator_start_from_head(&rois); (qrcodes || apriltags) && it; it = iterator_next(it)) {
+        rectangle_t window;
+        iterator_get(&rois, it, &window);
+        list_t out;
+
+        // The locator's dense blocks stop where the modules do, the quads of tags and the finder
+        // patterns of qrcodes also need the border and quiet zone around them. Grown windows are
+        // not merged, a merge of close ones would soon be the whole roi.
+        if (!rectangle_equal_fast(&window, roi)) {
+            rectangle_init(&window, window.x - (window.w / 4), window.y - (window.h / 4),
+                           window.w + (window.w / 2), window.h + (window.h / 2));
+            rectangle_intersected(&window, roi);
+        }
+
+        if (qrcodes) {
+            imlib_find_qrcodes(&out, &img, &window, false, 0);
+            find_codes_append(qrcodes, &out, true);
+        }
+
+        int decimate = 1;
+        #ifndef IMLIB_ENABLE_HIGH_RES_APRILTAGS
+        // The limit of find_apriltags() is on the image quads are searched in, the windows
+        // larger than it (the whole roi when the locator gives up) are decimated to fit.
+        while (((window.w / decimate) * (window.h / decimate)) >= 65536) {
+            decimate += 1;
+        }
+        #endif
+
+        if (apriltags && ((window.w / decimate) >= 4) && ((window.h / decimate) >= 4)) {
+            list_init(&out, sizeof(find_apriltags_list_lnk_data_t));
+            imlib_find_apriltags_roi(&out, &img, &window, families, fx, fy,
+                                     cx - (window.x - roi->x), cy - (window.y - roi->y), decimate, true);
+            find_codes_append(apriltags, &out, false);
+        }
+    }
+
+    // Bars are all edges, the windows of the locator cover them.
+    for (list_lnk_t *it = iterator_start_from_head(&rois); barcodes && it; it = iterator_next(it)) {
+        rectangle_t window;
+        iterator_get(&rois, it, &window);
+        list_t out;
+        imlib_find_barcodes(&out, &img, &window, false);
+        find_codes_append(barcodes, &out, true);
+    }
+
+    list_free(&rois);
+
+    if (ptr->bpp != IMAGE_BPP_GRAYSCALE) {
+        fb_free(); // img
+    }
+}
+#endif // IMLIB_ENABLE_QRCODES && IMLIB_ENABLE_APRILTAGS && IMLIB_ENABLE_BARCODES
@@ -24,6 +24,7 @@
 #include "fmath.h"
 #include "collections.h"
 #include "imlib_config.h"
+#include "perf.h"
 #ifdef MCU_SERIES_RT105
 #include "overlay_manager.h"
 #endif
@@ -162,6 +163,10 @@ color_thresholds_list_lnk_data_t;
     (_threshold->BMin <= _b) && (_b <= _threshold->BMax)) ^ _invert; \
 })
 
+// Bit n of a thresholds LUT entry is set when the RGB565 value passes threshold n (invert applied).
+#define COLOR_THRESHOLDS_LUT_MAX 8
+#define COLOR_THRESHOLD_LUT(lut, pixel, n) (((lut)[(pixel)] >> (n)) & 1)
+
 #define COLOR_BOUND_BINARY(pixel0, pixel1, threshold) \
 ({ \
     __typeof__ (pixel0) _pixel0 = (pixel0); \
@@ -369,7 +374,8 @@ typedef enum image_bpp
     IMAGE_BPP_GRAYSCALE,    // BPP = 1
     IMAGE_BPP_RGB565,       // BPP = 2
     IMAGE_BPP_BAYER,        // BPP = 3
-    IMAGE_BPP_JPEG          // BPP > 3
+    IMAGE_BPP_YUV422,       // BPP = 4
+    IMAGE_BPP_JPEG          // BPP > 4
 }
 image_bpp_t;
 
@@ -387,6 +393,14 @@ void image_init(image_t *ptr, int w, int h, int bpp, void *data);
 void image_copy(image_t *dst, image_t *src);
 size_t image_size(image_t *ptr);
 bool image_get_mask_pixel(image_t *ptr, int x, int y);
+// Row y of a mask as bits of pixels 0 to w - 1, each as image_get_mask_pixel() gives it. The
+// row of a binary mask at least w wide is returned as is, others are packed into buf, a
+// binary row of w pixels.
+const uint32_t *image_get_mask_row(image_t *ptr, int w, int y, uint32_t *buf);
+// Spreads 4 (2) mask bits into the byte (halfword) lanes of a word of 4 grayscale (2 RGB565)
+// pixels.
+#define IMAGE_MASK_BITS_TO_BYTE_LANES(bits) (((((bits) & 0xF) * 0x00204081) & 0x01010101) * 0xFF)
+#define IMAGE_MASK_BITS_TO_HALFWORD_LANES(bits) (((((bits) & 0x3) * 0x8001) & 0x00010001) * 0xFFFF)
 
 #define IMAGE_IS_MUTABLE(image) \
 ({ \
@@ -396,13 +410,15 @@ bool image_get_mask_pixel(image_t *ptr, int x, int y);
     (_image->bpp == IMAGE_BPP_RGB565); \
 })
 
+// Also the raw sensor formats, Bayer and YUV422.
 #define IMAGE_IS_MUTABLE_BAYER(image) \
 ({ \
     __typeof__ (image) _image = (image); \
     (_image->bpp == IMAGE_BPP_BINARY) || \
     (_image->bpp == IMAGE_BPP_GRAYSCALE) || \
     (_image->bpp == IMAGE_BPP_RGB565) || \
-    (_image->bpp == IMAGE_BPP_BAYER); \
+    (_image->bpp == IMAGE_BPP_BAYER) || \
+    (_image->bpp == IMAGE_BPP_YUV422); \
 })
 
 #define IMAGE_BINARY_LINE_LEN(image) (((image)->w + UINT32_T_MASK) >> UINT32_T_SHIFT)
@@ -414,6 +430,9 @@ bool image_get_mask_pixel(image_t *ptr, int x, int y);
 #define IMAGE_RGB565_LINE_LEN(image) ((image)->w)
 #define IMAGE_RGB565_LINE_LEN_BYTES(image) (IMAGE_RGB565_LINE_LEN(image) * sizeof(uint16_t))
 
+// YUV422 is the sensor's Y0 U Y1 V, a pair of pixels shares U and V (offset by 128).
+#define IMAGE_YUV422_LINE_LEN_BYTES(image) ((image)->w * 2)
+
 #define IMAGE_GET_BINARY_PIXEL(image, x, y) \
 ({ \
     __typeof__ (image) _image = (image); \
@@ -483,6 +502,47 @@ bool image_get_mask_pixel(image_t *ptr, int x, int y);
     ((uint16_t *) _image->data)[(_image->w * _y) + _x] = _v; \
 })
 
+#define IMAGE_GET_YUV422_Y(image, x, y) \
+({ \
+    __typeof__ (image) _image = (image); \
+    __typeof__ (x) _x = (x); \
+    __typeof__ (y) _y = (y); \
+    ((uint8_t *) _image->data)[((_image->w * _y) + _x) * 2]; \
+})
+
+#define IMAGE_PUT_YUV422_Y(image, x, y, v) \
+({ \
+    __typeof__ (image) _image = (image); \
+    __typeof__ (x) _x = (x); \
+    __typeof__ (y) _y = (y); \
+    __typeof__ (v) _v = (v); \
+    ((uint8_t *) _image->data)[((_image->w * _y) + _x) * 2] = _v; \
+})
+
+// U (V) of the pixel pair of x, less 128.
+#define IMAGE_GET_YUV422_U(image, x, y) \
+({ \
+    __typeof__ (image) _image = (image); \
+    __typeof__ (x) _x = (x); \
+    __typeof__ (y) _y = (y); \
+    ((int) ((uint8_t *) _image->data)[(((_image->w * _y) + (_x & ~1)) * 2) + 1]) - 128; \
+})
+
+#define IMAGE_GET_YUV422_V(image, x, y) \
+({ \
+    __typeof__ (image) _image = (image); \
+    __typeof__ (x) _x = (x); \
+    __typeof__ (y) _y = (y); \
+    ((int) ((uint8_t *) _image->data)[(((_image->w * _y) + (_x & ~1)) * 2) + 3]) - 128; \
+})
+
+#define IMAGE_COMPUTE_YUV422_PIXEL_ROW_PTR(image, y) \
+({ \
+    __typeof__ (image) _image = (image); \
+    __typeof__ (y) _y = (y); \
+    ((uint8_t *) _image->data) + (_image->w * _y * 2); \
+})
+
 #ifdef __arm__
     #define IMAGE_REV_RGB565_PIXEL(pixel) \
     ({ \
@@ -790,9 +850,13 @@ extern const int kernel_high_pass_3[9];
     ({ __typeof__ (img) _img = (img); \
        _img->bpp == 3; })
 
+#define IM_IS_YUV422(img) \
+    ({ __typeof__ (img) _img = (img); \
+       _img->bpp == 4; })
+
 #define IM_IS_JPEG(img) \
     ({ __typeof__ (img) _img = (img); \
-       _img->bpp >= 4; })
+       _img->bpp >= 5; })
 
 #define IM_IS_MUTABLE(img) \
     ({ __typeof__ (img) _img = (img); \
@@ -993,6 +1057,7 @@ typedef void (*flood_fill_call_back_t)(image_t *, int, int, int, void *);
 typedef enum descriptor_type {
     DESC_LBP,
     DESC_ORB,
+    DESC_ORB_DB,
 } descriptor_t;
 
 typedef enum edge_detector_type {
@@ -1016,6 +1081,29 @@ typedef enum corner_detector_type {
     CORNER_AGAST
 } corner_detector_t;
 
+// imlib_draw_image() hints.
+#define IMAGE_HINT_BILINEAR (1 << 0) // Scaling may be bilinear (PXP), else it is nearest neighbor.
+
+typedef enum pipeline_op_type {
+    PIPELINE_GAMMA_CORR,
+    PIPELINE_NEGATE,
+    PIPELINE_BINARY,
+    PIPELINE_MORPH,
+} pipeline_op_type_t;
+
+typedef struct pipeline_op {
+    pipeline_op_type_t type;
+    float gamma, contrast, brightness;  // PIPELINE_GAMMA_CORR
+    list_t *thresholds;                 // PIPELINE_BINARY
+    bool invert, zero;
+    int ksize;                          // PIPELINE_MORPH
+    const int *krn;
+    float m;
+    int b;
+} pipeline_op_t;
+
+#define IMLIB_PIPELINE_OPS_MAX (16)
+
 typedef struct histogram {
     int LBinCount;
     float *LBins;
@@ -1149,6 +1237,15 @@ int8_t imlib_rgb565_to_v(uint16_t pixel);
 uint16_t imlib_lab_to_rgb(uint8_t l, int8_t a, int8_t b);
 uint16_t imlib_yuv_to_rgb(uint8_t y, int8_t u, int8_t v);
 void imlib_bayer_to_rgb565(image_t *img, int w, int h, int xoffs, int yoffs, uint16_t *rgbbuf);
+void imlib_debayer(image_t *dst, image_t *src, rectangle_t *roi);
+void imlib_yuv422_unpack(image_t *dst, image_t *src, rectangle_t *roi);
+void imlib_unpack(image_t *dst, image_t *src, rectangle_t *roi);
+// Bits of the thresholds (Y, U and V bounds) each Y, U and V byte is inside of, invert not
+// applied: a pixel is inside threshold n if bit n of lut[y] & lut[256 + u] & lut[512 + v] is.
+#define COLOR_YUV_THRESHOLDS_MAX 32
+void imlib_yuv_thresholds_lut(list_t *thresholds, uint32_t *lut);
+const uint8_t *imlib_thresholds_lut(list_t *thresholds, bool invert);
+void imlib_thresholds_lut_init0();
 
 /* Image file functions */
 void ppm_read_geometry(FIL *fp, image_t *img, const char *path, ppm_read_settings_t *rs);
@@ -1160,12 +1257,43 @@ void bmp_read_pixels(FIL *fp, image_t *img, int n_lines, bmp_read_settings_t *rs
 void bmp_read(image_t *img, const char *path);
 void bmp_write_subimg(image_t *img, const char *path, rectangle_t *r);
 bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc);
+// Receives the compressed stream in order, returns false to abort the encode.
+typedef bool (*jpeg_sink_t)(void *arg, const uint8_t *data, int size);
+#define JPEG_SINK_BUF_MIN   (512)
+#define JPEG_SINK_BUF_SIZE  (4096)
+// Encodes through the dst->bpp bytes at dst->pixels (at least JPEG_SINK_BUF_MIN), flushed to the
+// sink when full and after every MCU row. dst->bpp is set to the total size. Returns true on error.
+bool jpeg_compress_sink(image_t *src, image_t *dst, int quality, jpeg_sink_t sink, void *sink_arg);
+// Like jpeg_compress() without realloc, but only the software encoder and no fb_alloc(), so it
+// may run outside the VM's thread. Returns true on error.
+bool jpeg_compress_soft(image_t *src, image_t *dst, int quality);
+// Encodes into the dst->bpp bytes at dst->pixels, coefficients are dropped per MCU row to stay in
+// them and quality (at most the one given) is picked from the previous call. Returns true on error.
+#define JPEG_BUDGET_MIN     (1024)
+bool jpeg_compress_budget(image_t *src, image_t *dst, int quality);
+// FIL sink.
+bool jpeg_file_sink(void *fp, const uint8_t *data, int size);
+// Encoder backends, jpeg_compress() and jpeg_compress_sink() offer each frame to them and
+// fall back to the software encoder.
+typedef struct jpeg_backend {
+    // Encodes the whole frame, returns 0 when done, 1 on error or -1 to pass the frame on.
+    int (*compress)(image_t *src, image_t *dst, int quality, bool realloc, jpeg_sink_t sink, void *sink_arg);
+    // Converts an RGB565 frame to a Y plane and an interleaved CbCr 4:2:0 plane for the software
+    // encoder, returns 0 when done or -1 when the frame is not supported.
+    int (*ycbcr420)(image_t *src, uint8_t *planes);
+} jpeg_backend_t;
 void jpeg_read_geometry(FIL *fp, image_t *img, const char *path);
 void jpeg_read_pixels(FIL *fp, image_t *img);
 void jpeg_read(image_t *img, const char *path);
 void jpeg_write(image_t *img, const char *path, int quality);
 bool imlib_read_geometry(FIL *fp, image_t *img, const char *path, img_read_settings_t *rs);
 void imlib_image_operation(image_t *img, const char *path, image_t *other, int scalar, line_op_t op, void *data);
+// True when an op on other or the scalar can skip imlib_image_operation() and run on words of
+// the image's pixels (no file, the image word aligned), it has to match other's geometry. A
+// mask is read a row of bits at a time, see image_get_mask_row().
+bool imlib_image_operation_in_memory(image_t *img, const char *path, image_t *other, image_t *mask);
+// The scalar of an op as the pixels of a word of the image.
+uint32_t imlib_image_operation_scalar(image_t *img, int scalar);
 void imlib_load_image(image_t *img, const char *path);
 void imlib_save_image(image_t *img, const char *path, rectangle_t *roi, int quality);
 
@@ -1175,9 +1303,39 @@ void gif_add_frame(FIL *fp, image_t *img, uint16_t delay);
 void gif_close(FIL *fp);
 
 /* MJPEG functions */
-void mjpeg_open(FIL *fp, int width, int height);
-void mjpeg_add_frame(FIL *fp, uint32_t *frames, uint32_t *bytes, image_t *img, int quality);
-void mjpeg_close(FIL *fp, uint32_t *frames, uint32_t *bytes, float fps);
+// Every frame is indexed. With a segment_size the file is OpenDML, a new RIFF is started each
+// segment_size bytes and the header is brought up to date in the file before it.
+typedef struct mjpeg {
+    FIL fp;
+    uint32_t frames;        // in all segments
+    uint32_t bytes;         // frame data in all segments
+    uint32_t segment_size;  // 0 for a single RIFF
+    uint32_t index_size;    // super index entries in the header
+    uint32_t segments;      // ended segments
+    uint32_t riff;          // RIFF of the open segment
+    uint32_t movi;          // movi FOURCC of the open segment
+    uint32_t riff_frames;   // frames in the first RIFF
+    uint32_t start;         // ticks at open, the frame rate is estimated until closed
+    uint32_t *index;        // frame sizes of the open segment
+    uint32_t index_frames;
+    uint32_t index_alloc;
+} mjpeg_t;
+void mjpeg_open(mjpeg_t *mjpeg, int width, int height, uint32_t segment_size);
+void mjpeg_add_frame(mjpeg_t *mjpeg, image_t *img, int quality);
+void mjpeg_close(mjpeg_t *mjpeg, float fps);
+// Recorder that buffers compressed frames in a ring and moves them to the card in the background,
+// from its own thread with RT-Thread or else from mjpeg_rec_poll() in the idle loop. file_size
+// bytes are preallocated contiguously if not 0, which lets it write card sectors directly.
+typedef struct mjpeg_rec mjpeg_rec_t;
+mjpeg_rec_t *mjpeg_rec_open(const char *path, int width, int height, uint32_t buffer_size, uint32_t file_size);
+void mjpeg_rec_add_frame(mjpeg_rec_t *rec, image_t *img, int quality);
+// Writes everything buffered that fills whole card sectors.
+void mjpeg_rec_flush(mjpeg_rec_t *rec);
+uint32_t mjpeg_rec_size(mjpeg_rec_t *rec);
+void mjpeg_rec_close(mjpeg_rec_t *rec, float fps);
+void mjpeg_rec_poll();
+// Stops a recorder left running by the last script, its file is not finished.
+void mjpeg_rec_init0();
 
 /* Point functions */
 point_t *point_alloc(int16_t x, int16_t y);
@@ -1216,6 +1374,32 @@ void imlib_integral_image_sq(struct image *src, struct integral_image *sum);
 void imlib_integral_image_scaled(struct image *src, struct integral_image *sum);
 uint32_t imlib_integral_lookup(struct integral_image *src, int x, int y, int w, int h);
 
+/* Per frame pyramid / integral image cache */
+#define IMLIB_PYRAMID_LEVELS_MAX (8)
+void imlib_pyramid_init0();
+void imlib_pyramid_invalidate(void *data);
+void imlib_pyramid_scale(image_t *src, image_t *dst);
+image_t *imlib_pyramid_level(image_t *img, int w, int h);
+i_image_t *imlib_pyramid_integral(image_t *img, bool sq);
+image_t *imlib_pyramid_unpack(image_t *img, rectangle_t *roi, int bpp);
+
+/* lens_corr() / rotation_corr() remap table cache */
+#define IMLIB_REMAP_LENS_CORR (0)
+#define IMLIB_REMAP_ROTATION_CORR (1)
+#define IMLIB_REMAP_TYPES (2) // see imlib_remap in mpconfigport.h
+#define IMLIB_REMAP_PARAMS_MAX (6)
+// Table entries are the source pixel of each output pixel as (y << 16) | x.
+#define IMLIB_REMAP_NONE (0xFFFFFFFF) // source pixel outside of the image
+#define IMLIB_REMAP_ENTRY(x, y) ((((uint32_t) (y)) << 16) | ((uint32_t) (x)))
+#define IMLIB_REMAP_X(entry) ((entry) & 0xFFFF)
+#define IMLIB_REMAP_Y(entry) ((entry) >> 16)
+typedef void (*imlib_remap_fill_t)(uint32_t *table, int w, int h, const float *params);
+void imlib_remap_init0();
+const uint32_t *imlib_remap_table(int type, int w, int h, const float *params, int params_len, imlib_remap_fill_t fill);
+
+/* Model input: crop, bilinear resize and per channel table (c * 256 bytes, NULL for raw pixels) */
+int imlib_resize_to_tensor(image_t *img, rectangle_t *roi, int w, int h, int c, const uint8_t *lut, uint8_t *out);
+
 // Integral moving window
 void imlib_integral_mw_alloc(mw_image_t *sum, int w, int h);
 void imlib_integral_mw_free(mw_image_t *sum);
@@ -1243,6 +1427,19 @@ int orb_match_keypoints(array_t *kpts1, array_t *kpts2, int *match, int threshol
 int orb_filter_keypoints(array_t *kpts, rectangle_t *r, point_t *c);
 int orb_save_descriptor(FIL *fp, array_t *kpts);
 int orb_load_descriptor(FIL *fp, array_t *kpts);
+// Keypoint descriptor database, the keypoints of all objects one after another.
+typedef struct orb_db {
+    int count;
+    uint32_t *ids;
+    int *starts; // The first keypoint of each object and the end, count + 1 entries.
+    array_t *kpts;
+} orb_db_t;
+#define ORB_DB_INVALID  (-1) // Not a descriptor database.
+#define ORB_DB_FULL     (-2) // No index entry left.
+int orb_db_append(FIL *fp, array_t *kpts, uint32_t id, uint32_t capacity);
+int orb_db_load(FIL *fp, orb_db_t *db);
+// Votes of the keypoints for the objects of the database, returns the number of votes.
+int orb_db_match(orb_db_t *db, array_t *kpts, int threshold, int *votes);
 float orb_cluster_dist(int cx, int cy, void *kp);
 
 /* LBP Operator */
@@ -1263,6 +1460,14 @@ void imlib_edge_simple(image_t *src, rectangle_t *roi, int low_thresh, int high_
 void imlib_edge_canny(image_t *src, rectangle_t *roi, int low_thresh, int high_thresh);
 
 // HoG
+#define HOG_BINS (9)
+typedef struct hog_integral {
+    int cell_size;
+    int x_cells, y_cells;
+    float *data; // fb_alloc'd, (x_cells + 1) * (y_cells + 1) * (HOG_BINS + 1)
+} hog_integral_t;
+void imlib_hog_integral(image_t *src, rectangle_t *roi, int cell_size, hog_integral_t *ii);
+float imlib_hog_integral_window(hog_integral_t *ii, int cx, int cy, int cw, int ch, float *hist);
 void imlib_find_hog(image_t *src, rectangle_t *roi, int cell_size);
 
 // Helper Functions
@@ -1279,7 +1484,7 @@ void imlib_draw_circle(image_t *img, int cx, int cy, int r, int c, int thickness
 void imlib_draw_ellipse(image_t *img, int cx, int cy, int rx, int ry, int rotation, int c, int thickness, bool fill);
 void imlib_draw_string(image_t *img, int x_off, int y_off, const char *str, int c, float scale, int x_spacing, int y_spacing, bool mono_space,
                        int char_rotation, bool char_hmirror, bool char_vflip, int string_rotation, bool string_hmirror, bool string_hflip);
-void imlib_draw_image(image_t *img, image_t *other, int x_off, int y_off, float x_scale, float y_scale, float alpha, image_t *mask);
+void imlib_draw_image(image_t *img, image_t *other, int x_off, int y_off, float x_scale, float y_scale, float alpha, image_t *mask, int hint);
 void imlib_flood_fill(image_t *img, int x, int y,
                       float seed_threshold, float floating_threshold,
                       int c, bool invert, bool clear_background, image_t *mask);
@@ -1320,6 +1525,7 @@ void imlib_midpoint_filter(image_t *img, const int ksize, float bias, bool thres
 void imlib_morph(image_t *img, const int ksize, const int *krn, const float m, const int b, bool threshold, int offset, bool invert, image_t *mask);
 void imlib_bilateral_filter(image_t *img, const int ksize, float color_sigma, float space_sigma, bool threshold, int offset, bool invert, image_t *mask);
 void imlib_cartoon_filter(image_t *img, float seed_threshold, float floating_threshold, image_t *mask);
+void imlib_pipeline(image_t *img, const pipeline_op_t *ops, int ops_len);
 // Image Correction
 void imlib_logpolar_int(image_t *dst, image_t *src, rectangle_t *roi, bool linear, bool reverse); // helper/internal
 void imlib_logpolar(image_t *img, bool linear, bool reverse);
@@ -1334,6 +1540,7 @@ void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation,
 // Statistics
 void imlib_get_similarity(image_t *img, const char *path, image_t *other, int scalar, float *avg, float *std, float *min, float *max);
 void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_t *thresholds, bool invert);
+void imlib_get_histograms(histogram_t *out, image_t *ptr, rectangle_t *rois, int rois_len, list_t *thresholds, bool invert, bool integral);
 void imlib_get_percentile(percentile_t *out, image_bpp_t bpp, histogram_t *ptr, float percentile);
 void imlib_get_threshold(threshold_t *out, image_bpp_t bpp, histogram_t *ptr);
 void imlib_get_statistics(statistics_t *out, image_bpp_t bpp, histogram_t *ptr);
@@ -1361,11 +1568,57 @@ void imlib_find_circles(list_t *out, image_t *ptr, rectangle_t *roi, unsigned in
 void imlib_find_rects(list_t *out, image_t *ptr, rectangle_t *roi,
                       uint32_t threshold);
 // 1/2D Bar Codes
-void imlib_find_qrcodes(list_t *out, image_t *ptr, rectangle_t *roi);
+void imlib_find_qrcodes(list_t *out, image_t *ptr, rectangle_t *roi, bool locate, int max_codes);
+#define IMLIB_APRILTAGS_TRACK_MAX (16)
 void imlib_find_apriltags(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_families_t families,
-                          float fx, float fy, float cx, float cy);
-void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, int effort);
-void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi);
+                          float fx, float fy, float cx, float cy, int decimate, bool refine_edges, int track);
+// One search of the roi without the tracking of imlib_find_apriltags(), appends to out.
+void imlib_find_apriltags_roi(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_families_t families,
+                              float fx, float fy, float cx, float cy, int decimate, bool refine_edges);
+void imlib_find_symbol_rois(list_t *out, image_t *ptr, rectangle_t *roi);
+void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, int effort, bool locate, int timeout);
+void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi, bool locate);
+// QR codes, AprilTags and bar codes in one pass: one grayscale conversion and one gradient map of
+// the roi, the decoders run in the windows imlib_find_symbol_rois() finds. NULL lists are skipped.
+void imlib_find_codes(list_t *qrcodes, list_t *apriltags, list_t *barcodes, image_t *ptr, rectangle_t *roi,
+                      apriltag_families_t families, float fx, float fy, float cx, float cy);
+// Optical Flow
+typedef struct track_points_list_lnk_data {
+    float x0, y0; // position in the previous image
+    float x1, y1; // position in the current image
+    float error; // mean absolute difference of the tracked windows, in gray levels
+    bool found;
+} track_points_list_lnk_data_t;
+
+void imlib_track_points_corners(list_t *out, image_t *ptr, rectangle_t *roi, int threshold, int max_points,
+                                corner_detector_t corner_detector);
+void imlib_track_points(list_t *points, image_t *ptr, image_t *prev, int window, int levels, int max_iterations);
+// Multi-object Tracking
+#define TRACKER_MAX_TRACKS (32)
+
+typedef struct tracker_kalman {
+    float x, v; // position and velocity
+    float p00, p01, p11; // covariance
+} tracker_kalman_t;
+
+typedef struct tracker_track {
+    tracker_kalman_t kf[4]; // center x, center y, width, height
+    rectangle_t rect; // box of the last update, predicted when missed
+    uint32_t id; // 0 until confirmed
+    uint16_t hit_streak, misses;
+} tracker_track_t;
+
+typedef struct tracker {
+    int max_age, min_hits;
+    int32_t iou_threshold; // 16 bit fixed point
+    uint32_t next_id;
+    int count;
+    tracker_track_t tracks[TRACKER_MAX_TRACKS];
+} tracker_t;
+
+void imlib_tracker_init(tracker_t *tracker, int max_age, int min_hits, float iou_threshold);
+// Detections are the rectangle_t at rect_offset in the list's items, ids gets the id of each or -1.
+void imlib_tracker_update(tracker_t *tracker, list_t *detections, size_t rect_offset, int *ids);
 // Template Matching
 void imlib_phasecorrelate(image_t *img0, image_t *img1, rectangle_t *roi0, rectangle_t *roi1, bool logpolar, bool fix_rotation_scale,
                           float *x_translation, float *y_translation, float *rotation, float *scale, float *response);
@@ -27,6 +27,7 @@ void imlib_integral_image_free(i_image_t *sum)
 
 void imlib_integral_image(image_t *src, i_image_t *sum)
 {
+    OMV_PROF_SCOPE("imlib_integral_image");
     typeof(*src->data) *img_data = src->data;
     typeof(*sum->data) *sum_data = sum->data;
 
@@ -49,6 +50,7 @@ void imlib_integral_image(image_t *src, i_image_t *sum)
 
 void imlib_integral_image_scaled(image_t *src, i_image_t *sum)
 {
+    OMV_PROF_SCOPE("imlib_integral_image_scaled");
     typeof(*src->data) *img_data = src->data;
     typeof(*sum->data) *sum_data = sum->data;
 
@@ -78,6 +80,7 @@ void imlib_integral_image_scaled(image_t *src, i_image_t *sum)
 
 void imlib_integral_image_sq(image_t *src, i_image_t *sum)
 {
+    OMV_PROF_SCOPE("imlib_integral_image_sq");
     typeof(*src->data) *img_data = src->data;
     typeof(*sum->data) *sum_data = sum->data;
 
@@ -20,6 +20,11 @@
 #include "ff_wrapper.h"
 #include "imlib.h"
 #include "omv_boardconfig.h"
+#if defined(IMLIB_ENABLE_PXP_JPEG)
+#include "pxp_2d.h"
+#endif
+#include "py/mpstate.h"
+#include "py/runtime.h"
 
 #define TIME_JPEG   (0)
 
@@ -236,7 +241,7 @@ void HAL_JPEG_ErrorCallback(JPEG_HandleTypeDef *hjpeg)
     printf("JPEG decode/encode error\n");
 }
 
-bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
+static int jpeg_hw_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_sink_t sink, void *sink_arg)
 {
 #if (TIME_JPEG==1)
     uint32_t start = HAL_GetTick();
@@ -286,13 +291,13 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
 
     if (HAL_JPEG_ConfigEncoding(&JPEG_Handle, &JPEG_Info) != HAL_OK) {
         // Initialization error
-        return true;
+        return 1;
     }
 
     // NOTE: output buffer size is stored in dst->bpp
     if (HAL_JPEG_Encode(&JPEG_Handle, get_mcu(), jpeg_enc.mcu_size, dst->pixels, dst->bpp, 3000) != HAL_OK) {
         // Initialization error
-        return true;
+        return 1;
     }
 
     // Set output size
@@ -304,10 +309,40 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
 
     HAL_JPEG_DeInit(&JPEG_Handle);
 
-    return jpeg_enc.overflow;
+    if (jpeg_enc.overflow) {
+        return 1;
+    }
+
+    // The hardware encoder writes the whole frame to dst, which is then passed to the sink at once.
+    if (sink && (!sink(sink_arg, dst->pixels, dst->bpp))) {
+        return 1;
+    }
+
+    return 0;
 }
 
-#else
+static const jpeg_backend_t jpeg_backend_hw = {
+    .compress = jpeg_hw_compress,
+};
+#endif //defined OMV_HARDWARE_JPEG
+
+#if defined(IMLIB_ENABLE_PXP_JPEG)
+static const jpeg_backend_t jpeg_backend_pxp = {
+    .ycbcr420 = pxp_2d_ycbcr420,
+};
+#endif
+
+// Backends in the order they are tried, the software encoder below takes everything they pass on.
+static const jpeg_backend_t *const jpeg_backends[] = {
+    #if (OMV_HARDWARE_JPEG == 1)
+    &jpeg_backend_hw,
+    #endif
+    #if defined(IMLIB_ENABLE_PXP_JPEG)
+    &jpeg_backend_pxp,
+    #endif
+    NULL
+};
+
 // Software JPEG implementation.
 #define FIX_0_382683433  ((int32_t)   98)
 #define FIX_0_541196100  ((int32_t)  139)
@@ -324,10 +359,18 @@ typedef struct {
     int bitc, bitb;
     bool realloc;
     bool overflow;
+    jpeg_sink_t sink; // If set buf is only a staging buffer, flushed when full and per MCU row.
+    void *sink_arg;
+    uint32_t sent;
+    int budget;     // If set the encode is held under budget bytes by dropping AC coefficients.
+    int cutoff;     // Last zigzag coefficient kept.
+    int row_start;  // Bytes written when the last MCU row started.
+    int row_y;
+    bool clipped;   // The cutoff was tightened at least once.
 } jpeg_buf_t;
 
-// Quantization tables
-static float fdtbl_Y[64], fdtbl_UV[64];
+// Quantization tables, reciprocals of the scaled quantizers in Q30
+static int32_t qtbl_Y[64], qtbl_UV[64];
 static uint8_t YTable[64], UVTable[64];
 
 // RGB565 to YUV table
@@ -472,16 +515,34 @@ static const JPEG_TAB uint16_t UVAC_HT[256][2] = {
     {0xFFFC, 0x0010},{0xFFFD, 0x0010},{0xFFFE, 0x0010},{0x0000, 0x0000},{0x0000, 0x0000},{0x0000, 0x0000},{0x0000, 0x0000},{0x0000, 0x0000},
 };
 
+static void jpeg_flush(jpeg_buf_t *jpeg_buf)
+{
+    if (jpeg_buf->sink && jpeg_buf->idx && (!jpeg_buf->overflow)) {
+        if (!jpeg_buf->sink(jpeg_buf->sink_arg, jpeg_buf->buf, jpeg_buf->idx)) {
+            jpeg_buf->overflow = true;
+        }
+        jpeg_buf->sent += jpeg_buf->idx;
+        jpeg_buf->idx = 0;
+    }
+}
+
 static void jpeg_put_char(jpeg_buf_t *jpeg_buf, char c)
 {
     if ((jpeg_buf->idx+1) >= jpeg_buf->length) {
-        if (jpeg_buf->realloc == false) {
-            // Can't realloc buffer
-            jpeg_buf->overflow = true;
-            return;
+        if (jpeg_buf->sink) {
+            jpeg_flush(jpeg_buf);
+            if (jpeg_buf->overflow) {
+                return;
+            }
+        } else {
+            if (jpeg_buf->realloc == false) {
+                // Can't realloc buffer
+                jpeg_buf->overflow = true;
+                return;
+            }
+            jpeg_buf->length += 1024;
+            jpeg_buf->buf = xrealloc(jpeg_buf->buf, jpeg_buf->length);
         }
-        jpeg_buf->length += 1024;
-        jpeg_buf->buf = xrealloc(jpeg_buf->buf, jpeg_buf->length);
     }
 
     jpeg_buf->buf[jpeg_buf->idx++]=c;
@@ -490,54 +551,67 @@ static void jpeg_put_char(jpeg_buf_t *jpeg_buf, char c)
 static void jpeg_put_bytes(jpeg_buf_t *jpeg_buf, const void *data, int size)
 {
     if ((jpeg_buf->idx+size) >= jpeg_buf->length) {
-        if (jpeg_buf->realloc == false) {
-            // Can't realloc buffer
-            jpeg_buf->overflow = true;
-            return;
+        if (jpeg_buf->sink) {
+            // Headers only, they fit a staging buffer of JPEG_SINK_BUF_MIN bytes.
+            jpeg_flush(jpeg_buf);
+            if (jpeg_buf->overflow || ((jpeg_buf->idx+size) >= jpeg_buf->length)) {
+                jpeg_buf->overflow = true;
+                return;
+            }
+        } else {
+            if (jpeg_buf->realloc == false) {
+                // Can't realloc buffer
+                jpeg_buf->overflow = true;
+                return;
+            }
+            jpeg_buf->length += 1024;
+            jpeg_buf->buf = xrealloc(jpeg_buf->buf, jpeg_buf->length);
         }
-        jpeg_buf->length += 1024;
-        jpeg_buf->buf = xrealloc(jpeg_buf->buf, jpeg_buf->length);
     }
 
     memcpy(jpeg_buf->buf+jpeg_buf->idx, data, size);
     jpeg_buf->idx += size;
 }
 
-static void jpeg_writeBits(jpeg_buf_t *jpeg_buf, const uint16_t *bs)
+// The bits are accumulated in a 32-bit word and the whole bytes are written out after every
+// code, at most 7 bits are left pending between calls.
+static inline void jpeg_writeBits(jpeg_buf_t *jpeg_buf, uint32_t code, int size)
 {
-    jpeg_buf->bitc += bs[1];
-    jpeg_buf->bitb |= bs[0] << (24 - jpeg_buf->bitc);
+    uint32_t bitb = (jpeg_buf->bitb << size) | code;
+    int bitc = jpeg_buf->bitc + size;
 
-    while (jpeg_buf->bitc > 7) {
-        uint8_t c = (jpeg_buf->bitb >> 16) & 255;
+    while (bitc > 7) {
+        bitc -= 8;
+        uint8_t c = bitb >> bitc;
         jpeg_put_char(jpeg_buf, c);
         if(c == 255) {
             jpeg_put_char(jpeg_buf, 0);
         }
-        jpeg_buf->bitb <<= 8;
-        jpeg_buf->bitc -= 8;
     }
+
+    jpeg_buf->bitb = bitb;
+    jpeg_buf->bitc = bitc;
 }
 
 //Huffman-encoded magnitude value
-static void jpeg_calcBits(int val, uint16_t bits[2]) {
+static inline void jpeg_writeMag(jpeg_buf_t *jpeg_buf, const uint16_t (*HT)[2], int run, int val)
+{
     int t1=val;
     if (val<0) {
         t1 = -val;
         val = val-1;
     }
-    bits[1] = 32-__CLZ(t1);
-    bits[0] = val & ((1<<bits[1])-1);
+    int size = 32-__CLZ(t1);
+    jpeg_writeBits(jpeg_buf, HT[(run<<4)+size][0], HT[(run<<4)+size][1]);
+    jpeg_writeBits(jpeg_buf, val & ((1<<size)-1), size);
 }
 
-static int jpeg_processDU(jpeg_buf_t *jpeg_buf, int8_t *CDU, float *fdtbl, int DC, const uint16_t (*HTDC)[2], const uint16_t (*HTAC)[2])
+static int jpeg_processDU(jpeg_buf_t *jpeg_buf, int8_t *CDU, const int32_t *qtbl, int DC, const uint16_t (*HTDC)[2], const uint16_t (*HTAC)[2])
 {
     int DU[64];
     int DUQ[64];
     int z1, z2, z3, z4, z5, z11, z13;
     int t0, t1, t2, t3, t4, t5, t6, t7, t10, t11, t12, t13;
-    const uint16_t EOB[2] = { HTAC[0x00][0], HTAC[0x00][1] };
-    const uint16_t M16zeroes[2] = { HTAC[0xF0][0], HTAC[0xF0][1] };
 
     // DCT rows
     for (int i=8, *p=DU; i>0; i--, p+=8, CDU+=8) {
@@ -582,8 +656,10 @@ static int jpeg_processDU(jpeg_buf_t *jpeg_buf, int8_t *CDU, float *fdtbl, int D
         p[7] = z11 - z4;
     }
 
-    // DCT columns
-    for (int i=8, *p=DU; i>0; i--, p++) {
+    // DCT columns, the outputs are quantized and zigzagged on the way out. The AAN output scale
+    // is folded into the quantizer reciprocals, a Q30 multiply rounds them to the nearest integer.
+    #define JPEG_QUANT(k, x) (DUQ[s_jpeg_ZigZag[k]] = (int) ((((int64_t) (x) * qtbl[k]) + (1 << 29)) >> 30))
+    for (int i=0, *p=DU; i<8; i++, p++) {
         t0 = p[0]  + p[56];
         t1 = p[8]  + p[48];
         t2 = p[16] + p[40];
@@ -601,10 +677,10 @@ static int jpeg_processDU(jpeg_buf_t *jpeg_buf, int8_t *CDU, float *fdtbl, int D
         t12 = t1 - t2;
         z1 = MULTIPLY(t12 + t13, FIX_0_707106781); // c4
 
-        p[0] = t10 + t11; 		// phase 3
-        p[32] = t10 - t11;
-        p[16] = t13 + z1; 		// phase 5
-        p[48] = t13 - z1;
+        JPEG_QUANT(i,    t10 + t11); 		// phase 3
+        JPEG_QUANT(i+32, t10 - t11);
+        JPEG_QUANT(i+16, t13 + z1); 		// phase 5
+        JPEG_QUANT(i+48, t13 - z1);
 
         // Odd part
         t10 = t4 + t5; 		// phase 2
@@ -619,61 +695,73 @@ static int jpeg_processDU(jpeg_buf_t *jpeg_buf, int8_t *CDU, float *fdtbl, int D
         z11 = t7 + z3;		// phase 5
         z13 = t7 - z3;
 
-        p[40] = z13 + z2;// phase 6
-        p[24] = z13 - z2;
-        p[8] = z11 + z4;
-        p[56] = z11 - z4;
+        JPEG_QUANT(i+40, z13 + z2);// phase 6
+        JPEG_QUANT(i+24, z13 - z2);
+        JPEG_QUANT(i+8,  z11 + z4);
+        JPEG_QUANT(i+56, z11 - z4);
     }
+    #undef JPEG_QUANT
 
-    // first non-zero element in reverse order
-    int end0pos = 0;
-    // Quantize/descale/zigzag the coefficients
-    for(int i=0; i<64; ++i) {
-		DUQ[s_jpeg_ZigZag[i]] = fast_roundf(DU[i]*fdtbl[i]);
-        if (s_jpeg_ZigZag[i] > end0pos && DUQ[s_jpeg_ZigZag[i]]) {
-            end0pos = s_jpeg_ZigZag[i];
-        }
+    // last non-zero element in zigzag order
+    int end0pos = jpeg_buf->cutoff;
+    while (end0pos && !DUQ[end0pos]) {
+        end0pos--;
     }
 
     // Encode DC
-    int diff = DUQ[0] - DC;
-    if (diff == 0) {
-        jpeg_writeBits(jpeg_buf, HTDC[0]);
-    } else {
-        uint16_t bits[2];
-        jpeg_calcBits(diff, bits);
-        jpeg_writeBits(jpeg_buf, HTDC[bits[1]]);
-        jpeg_writeBits(jpeg_buf, bits);
-    }
+    jpeg_writeMag(jpeg_buf, HTDC, 0, DUQ[0] - DC);
 
     // Encode ACs
-    if(end0pos == 0) {
-        jpeg_writeBits(jpeg_buf, EOB);
-        return DUQ[0];
-    }
-
     for(int i = 1; i <= end0pos; ++i) {
-        int startpos = i;
-        for (; DUQ[i]==0 && i<=end0pos ; ++i) {
+        int nrzeroes = 0;
+        for (; !DUQ[i]; ++i) {
+            nrzeroes++;
         }
-        int nrzeroes = i-startpos;
-        if ( nrzeroes >= 16 ) {
-            int lng = nrzeroes>>4;
-            for (int nrmarker=1; nrmarker <= lng; ++nrmarker)
-                jpeg_writeBits(jpeg_buf, M16zeroes);
-            nrzeroes &= 15;
+        for (; nrzeroes >= 16; nrzeroes -= 16) {
+            jpeg_writeBits(jpeg_buf, HTAC[0xF0][0], HTAC[0xF0][1]);
         }
-        uint16_t bits[2];
-        jpeg_calcBits(DUQ[i], bits);
-        jpeg_writeBits(jpeg_buf, HTAC[(nrzeroes<<4)+bits[1]]);
-        jpeg_writeBits(jpeg_buf, bits);
+        jpeg_writeMag(jpeg_buf, HTAC, nrzeroes, DUQ[i]);
     }
     if(end0pos != 63) {
-        jpeg_writeBits(jpeg_buf, EOB);
+        jpeg_writeBits(jpeg_buf, HTAC[0x00][0], HTAC[0x00][1]);
     }
     return DUQ[0];
 }
 
+// Bytes kept back for the EOI marker and the final bit alignment.
+#define JPEG_BUDGET_RESERVE (4)
+
+// Called after every MCU row of a budgeted encode. The cost of the last row is projected over
+// the rest of the frame and the AC cutoff is tightened or relaxed so the projection fits in the
+// bytes left. Baseline JPEG can't change tables in a scan, dropping the high frequencies is the
+// only way to re-quantise part of the frame.
+static void jpeg_budget(jpeg_buf_t *jpeg_buf, int y, int h)
+{
+    if ((!jpeg_buf->budget) || (y >= h)) {
+        return;
+    }
+
+    int used = jpeg_buf->sent + jpeg_buf->idx;
+    int row_bytes = used - jpeg_buf->row_start;
+    int left = jpeg_buf->budget - JPEG_BUDGET_RESERVE - used;
+    int rows = IM_MAX(y - jpeg_buf->row_y, 1);
+    // One row more than is left, the slack absorbs a row that comes out larger than the last.
+    int projected = (int) (((int64_t) row_bytes * (h - y + rows)) / rows);
+
+    jpeg_buf->row_start = used;
+    jpeg_buf->row_y = y;
+
+    if (left <= 0) {
+        jpeg_buf->clipped = true;
+        jpeg_buf->cutoff = 0;
+    } else if (projected > left) {
+        jpeg_buf->clipped = true;
+        jpeg_buf->cutoff = IM_MAX((int) ((((int64_t) jpeg_buf->cutoff + 1) * left) / projected) - 1, 0);
+    } else if ((projected * 2) < left) {
+        jpeg_buf->cutoff = IM_MIN(jpeg_buf->cutoff + 8, 63);
+    }
+}
+
 static void jpeg_init(int quality)
 {
     static int q =0;
@@ -692,8 +780,8 @@ static void jpeg_init(int quality)
 
         for(int r = 0, k = 0; r < 8; ++r) {
             for(int c = 0; c < 8; ++c, ++k) {
-                fdtbl_Y[k]  = 1.0f / (aasf[r] * aasf[c] * YTable [s_jpeg_ZigZag[k]] * 8.0f);
-                fdtbl_UV[k] = 1.0f / (aasf[r] * aasf[c] * UVTable[s_jpeg_ZigZag[k]] * 8.0f);
+                qtbl_Y[k]  = fast_roundf(1073741824.0f / (aasf[r] * aasf[c] * YTable [s_jpeg_ZigZag[k]] * 8.0f));
+                qtbl_UV[k] = fast_roundf(1073741824.0f / (aasf[r] * aasf[c] * UVTable[s_jpeg_ZigZag[k]] * 8.0f));
             }
         }
     }
@@ -804,6 +892,28 @@ static void jpeg_write_headers(jpeg_buf_t *jpeg_buf, int w, int h, int bpp, jpeg
     jpeg_put_bytes(jpeg_buf, (uint8_t [3]){0x00, 0x3F, 0x0}, 3);
 }
 
+// RGB565 (byte swapped) to YCbCr, in integer math with 15-bit fractions. Y is shifted to -128..127.
+// The pair (r, g) is packed in one word and the transforms are dual 16-bit multiply accumulates.
+#define JPEG_Y_RG   (0x4AEE262A) // (19182 << 16) | 9770
+#define JPEG_CB_RG  (0xD599EA67) // (-10855 << 16) | -5529
+#define JPEG_CR_RG  (0xCA8E4000) // (-13682 << 16) | 16384
+
+static inline int8_t jpeg_rgb565_to_y(uint32_t pixel)
+{
+    uint32_t rg = __PKHBT(rb528_table[(pixel >> 3) & 0x1f], g628_table[((pixel & 7) << 3) | (pixel >> 13)], 16);
+    int b = rb528_table[(pixel >> 8) & 0x1f];
+    return (__SMLAD(rg, JPEG_Y_RG, b * 3736) >> 15) - 128; // .299*r + .587*g + .114*b
+}
+
+static inline void jpeg_rgb565_to_ycbcr(uint32_t pixel, int8_t *y, int8_t *u, int8_t *v)
+{
+    uint32_t rg = __PKHBT(rb528_table[(pixel >> 3) & 0x1f], g628_table[((pixel & 7) << 3) | (pixel >> 13)], 16);
+    int b = rb528_table[(pixel >> 8) & 0x1f];
+    *y = (__SMLAD(rg, JPEG_Y_RG, b * 3736) >> 15) - 128; // .299*r + .587*g + .114*b
+    *u = ((int) __SMLAD(rg, JPEG_CB_RG, b << 14)) >> 15; // -0.168736*r + -0.331264*g + 0.5*b
+    *v = ((int) __SMLAD(rg, JPEG_CR_RG, b * -2664)) >> 15; // 0.5*r + -0.418688*g + -0.081312*b
+}
+
 void jpeg_get_mcu(image_t *img, int mcu_w, int mcu_h, int x_offs, int y_offs, int bpp, void *buf)
 {
     switch (bpp) {
@@ -878,9 +988,42 @@ void jpeg_get_mcu(image_t *img, int mcu_w, int mcu_h, int x_offs, int y_offs, in
     }
 }
 
-bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
+// Returns the Y and CbCr 4:2:0 planes of src from the first backend that converts it, or NULL
+// when none does or there is no room for them. The planes must be freed with fb_free().
+static uint8_t *jpeg_ycbcr420(image_t *src)
+{
+    uint32_t planes_size = (src->w * src->h) + ((src->w * src->h) / 2);
+    uint8_t *planes = NULL;
+
+    for (const jpeg_backend_t *const *backend = jpeg_backends; *backend; backend++) {
+        if ((*backend)->ycbcr420) {
+            if (!planes) {
+                if (fb_avail() < (planes_size + sizeof(uint32_t))) {
+                    return NULL;
+                }
+                planes = fb_alloc(planes_size, FB_ALLOC_PREFER_SIZE);
+            }
+            if ((*backend)->ycbcr420(src, planes) == 0) {
+                return planes;
+            }
+        }
+    }
+
+    if (planes) {
+        fb_free();
+    }
+    return NULL;
+}
+
+// Set when the last budgeted encode had to drop coefficients, the next one starts from its cutoff.
+static bool jpeg_budget_clipped;
+static int jpeg_budget_cutoff = 63;
+
+// soft keeps to the software encoder and off fb_alloc, for threads other than the VM's.
+static bool jpeg_encode_run(image_t *src, image_t *dst, int quality, bool realloc, jpeg_sink_t sink, void *sink_arg, int budget, bool soft)
 {
     int DCY=0, DCU=0, DCV=0;
+    uint8_t *planes = NULL;
     #if (TIME_JPEG==1)
     uint32_t start = HAL_GetTick();
     #endif
@@ -894,6 +1037,11 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
         .bitb = 0,
         .realloc = realloc,
         .overflow = false,
+        .sink = sink,
+        .sink_arg = sink_arg,
+        .sent = 0,
+        .budget = budget,
+        .cutoff = budget ? jpeg_budget_cutoff : 63,
     };
 
     // Initialize quantization tables
@@ -909,13 +1057,19 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
         jpeg_subsample = JPEG_SUBSAMPLE_2x2;
     }
 
+    if (src->bpp == IMAGE_BPP_YUV422) {
+        // The sensor already subsampled the chroma.
+        jpeg_subsample = JPEG_SUBSAMPLE_2x1;
+    }
+
     // Write JPEG headers
-    if (src->bpp == 3) { // BAYER
-        // Will be converted to RGB565
+    if ((src->bpp == 3) || (src->bpp == IMAGE_BPP_YUV422)) { // BAYER or YUV422
+        // Will be converted to RGB565, YUV422 is encoded as such
         jpeg_write_headers(&jpeg_buf, src->w, src->h, 2, jpeg_subsample);
     } else {
         jpeg_write_headers(&jpeg_buf, src->w, src->h, (src->bpp == 0) ? 1 : src->bpp, jpeg_subsample);
     }
+    jpeg_buf.row_start = jpeg_buf.sent + jpeg_buf.idx;
 
     // Encode 8x8 macroblocks
     if (src->bpp == 0) {
@@ -923,10 +1077,13 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
 
         // Copy 8x8 MCUs
         for (int y=0; y<src->h; y+=8) {
+            mp_sched_check_in();
             for (int x=0; x<src->w; x+=8) {
                 jpeg_get_mcu(src, 8, 8, x, y, src->bpp, YDU);
-                DCY = jpeg_processDU(&jpeg_buf, YDU, fdtbl_Y, DCY, YDC_HT, YAC_HT);
+                DCY = jpeg_processDU(&jpeg_buf, YDU, qtbl_Y, DCY, YDC_HT, YAC_HT);
             }
+            jpeg_flush(&jpeg_buf); // MCU row done
+            jpeg_budget(&jpeg_buf, y + 8, src->h);
             if (jpeg_buf.overflow) {
                 goto jpeg_overflow;
             }
@@ -935,10 +1092,13 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
         int8_t YDU[64];
         // Copy 8x8 MCUs
         for (int y=0; y<src->h; y+=8) {
+            mp_sched_check_in();
             for (int x=0; x<src->w; x+=8) {
                 jpeg_get_mcu(src, 8, 8, x, y, src->bpp, YDU);
-                DCY = jpeg_processDU(&jpeg_buf, YDU, fdtbl_Y, DCY, YDC_HT, YAC_HT);
+                DCY = jpeg_processDU(&jpeg_buf, YDU, qtbl_Y, DCY, YDC_HT, YAC_HT);
             }
+            jpeg_flush(&jpeg_buf); // MCU row done
+            jpeg_budget(&jpeg_buf, y + 8, src->h);
             if (jpeg_buf.overflow) {
                 goto jpeg_overflow;
             }
@@ -946,12 +1106,12 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
     } else if (src->bpp == 2) {// TODO assuming RGB565
         switch (jpeg_subsample) {
             case JPEG_SUBSAMPLE_1x1: {
-                uint16_t pixel, *pRow;;
+                uint16_t *pRow;
                 int dx, dy;
-                int r, g, b; // to separate RGB565 into R8,G8,B8
                 int8_t YDU[64], UDU[64], VDU[64];
                 int8_t *pY, *pU, *pV;
                 for (int y=0; y<src->h; y+=8) {
+                    mp_sched_check_in();
                     dy = 8;
                     if (y+8 > src->h) // over bottom edge
                         dy = src->h - y;
@@ -969,21 +1129,16 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
                             pRow += x;
                             pY = &YDU[(ty*8)]; pU = &UDU[ty*8]; pV=&VDU[ty*8];
                             for (int tx=0; tx<dx; tx++) { // columns
-                                pixel = *pRow++;
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                *pY++ = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15) -128; // .299*r + .587*g + .114*b
-                                *pU++ = (uint8_t)(((b << 14) - (r * 5529) - (g * 10855)) >> 15); // -0.168736*r + -0.331264*g + 0.5*b
-                                *pV++ = (uint8_t)(((r << 14) - (g * 13682) - (b * 2664)) >> 15); // 0.5*r + -0.418688*g + -0.081312*b
+                                jpeg_rgb565_to_ycbcr(*pRow++, pY++, pU++, pV++);
                             } // for tx
                         } // for ty
 
-                        DCY = jpeg_processDU(&jpeg_buf, YDU, fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCU = jpeg_processDU(&jpeg_buf, UDU, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
-                        DCV = jpeg_processDU(&jpeg_buf, VDU, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU, qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCU = jpeg_processDU(&jpeg_buf, UDU, qtbl_UV, DCU, UVDC_HT, UVAC_HT);
+                        DCV = jpeg_processDU(&jpeg_buf, VDU, qtbl_UV, DCV, UVDC_HT, UVAC_HT);
                     }
+                    jpeg_flush(&jpeg_buf); // MCU row done
+                    jpeg_budget(&jpeg_buf, y + 8, src->h);
                     if (jpeg_buf.overflow) {
                         goto jpeg_overflow;
                     }
@@ -991,12 +1146,12 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
                 break;
             }
             case JPEG_SUBSAMPLE_2x1: {
-                uint16_t pixel, *pRow;
+                uint16_t *pRow;
                 int dx, dy;
-                int r, g, b; // to separate RGB565 into R8,G8,B8
                 int8_t YDU[128], UDU[64], VDU[64];
                 int8_t *pY, *pU, *pV;
                 for (int y=0; y<src->h; y+=8) {
+                    mp_sched_check_in();
                     dy = 8;
                     if (y+8 > src->h) // over bottom edge
                         dy = src->h - y;
@@ -1012,30 +1167,20 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
                                 if (tx == 8) // second column of Y MCUs
                                    pY += (64-8);
 
-                                pixel = pRow[0]; // left
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                pY[0] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15) -128; // .299*r + .587*g + .114*b
-                                *pU++ = (uint8_t)(((b << 14) - (r * 5529) - (g * 10855)) >> 15); // -0.168736*r + -0.331264*g + 0.5*b
-                                *pV++ = (uint8_t)(((r << 14) - (g * 13682) - (b * 2664)) >> 15); // 0.5*r + -0.418688*g + -0.081312*b
-                                pixel = pRow[1]; // right
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                pY[1] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15)-128; // .299*r + .587*g + .114*b
+                                jpeg_rgb565_to_ycbcr(pRow[0], &pY[0], pU++, pV++); // left
+                                pY[1] = jpeg_rgb565_to_y(pRow[1]); // right
 
 				pY += 2; pRow += 2;
                             } // for tx
                         } // for ty
 
-                        DCY = jpeg_processDU(&jpeg_buf, YDU,    fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCY = jpeg_processDU(&jpeg_buf, YDU+64, fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCU = jpeg_processDU(&jpeg_buf, UDU, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
-                        DCV = jpeg_processDU(&jpeg_buf, VDU, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU,    qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU+64, qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCU = jpeg_processDU(&jpeg_buf, UDU, qtbl_UV, DCU, UVDC_HT, UVAC_HT);
+                        DCV = jpeg_processDU(&jpeg_buf, VDU, qtbl_UV, DCV, UVDC_HT, UVAC_HT);
                     }
+                    jpeg_flush(&jpeg_buf); // MCU row done
+                    jpeg_budget(&jpeg_buf, y + 8, src->h);
                     if (jpeg_buf.overflow) {
                         goto jpeg_overflow;
                     }
@@ -1043,13 +1188,14 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
                 break;
             }
             case JPEG_SUBSAMPLE_2x2: {
-                uint16_t pixel, *pRow;
+                uint16_t *pRow;
                 int dx, dy;
-                int r, g, b; // to separate RGB565 into R8,G8,B8
                 int8_t YDU[256], UDU[64], VDU[64];
                 int8_t *pY, *pU, *pV;
+                planes = soft ? NULL : jpeg_ycbcr420(src);
 
                 for (int y=0; y<src->h; y+=16) {
+                    mp_sched_check_in();
                     dy = 16;
                     if (y+16 > src->h) // over bottom edge
                         dy = src->h - y;
@@ -1062,7 +1208,23 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
                             memset(UDU,0,sizeof(UDU));
                             memset(VDU,0,sizeof(VDU));
                         }
-                        for (int ty=0; ty<dy; ty+=2) { // row pairs
+                        for (int ty=0; planes && ty<dy; ty+=2) { // row pairs, converted by a backend
+                            const uint8_t *pYP = planes + ((y+ty) * src->w) + x;
+                            const uint8_t *pCP = planes + (src->w * src->h) + (((y+ty) / 2) * src->w) + x;
+                            pY = &YDU[(ty*8)]; pU = &UDU[ty*4]; pV=&VDU[ty*4];
+                            if (ty >= 8) // second row of Y MCUs
+                                pY += (128 - 64);
+                            for (int tx=0; tx<dx; tx+=2) { // column pairs
+                                if (tx == 8) // second column of Y MCUs
+                                   pY += (64-8);
+
+                                pY[0] = pYP[0] - 128; pY[1] = pYP[1] - 128;
+                                pY[8] = pYP[src->w] - 128; pY[9] = pYP[src->w+1] - 128;
+                                pU[0] = pCP[0] - 128; pV[0] = pCP[1] - 128;
+                                pY += 2; pU++; pV++; pYP += 2; pCP += 2;
+                            } // for tx
+                        } // for ty
+                        for (int ty=0; (!planes) && ty<dy; ty+=2) { // row pairs
                             pRow = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(src, y+ty);
                             pRow += x;
                             pY = &YDU[(ty*8)]; pU = &UDU[ty*4]; pV=&VDU[ty*4];
@@ -1072,45 +1234,25 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
                                 if (tx == 8) // second column of Y MCUs
                                    pY += (64-8);
 
-                                pixel = pRow[0]; // top left
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                pY[0] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15) -128; // .299*r + .587*g + .114*b
-                                pU[0] = (uint8_t)(((b << 14) - (r * 5529) - (g * 10855)) >> 15); // -0.168736*r + -0.331264*g + 0.5*b
-                                pV[0] = (uint8_t)(((r << 14) - (g * 13682) - (b * 2664)) >> 15); // 0.5*r + -0.418688*g + -0.081312*b
-                                pixel = pRow[1]; // top right
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                pY[1] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15)-128; // .299*r + .587*g + .114*b
-
-                                pixel = pRow[src->w]; // bottom left
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                pY[8] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15)-128; // .299*r + .587*g + .114*b
+                                jpeg_rgb565_to_ycbcr(pRow[0], &pY[0], &pU[0], &pV[0]); // top left
+                                pY[1] = jpeg_rgb565_to_y(pRow[1]); // top right
+
+                                pY[8] = jpeg_rgb565_to_y(pRow[src->w]); // bottom left
                                 
-                                pixel = pRow[1+src->w]; // bottom right
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                pY[9] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15)-128; // .299*r + .587*g + .114*b
+                                pY[9] = jpeg_rgb565_to_y(pRow[1+src->w]); // bottom right
 				pY += 2; pU++; pV++; pRow += 2;
                             } // for tx
                         } // for ty
 
-                        DCY = jpeg_processDU(&jpeg_buf, YDU,     fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCY = jpeg_processDU(&jpeg_buf, YDU+64,  fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCY = jpeg_processDU(&jpeg_buf, YDU+128, fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCY = jpeg_processDU(&jpeg_buf, YDU+192, fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCU = jpeg_processDU(&jpeg_buf, UDU, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
-                        DCV = jpeg_processDU(&jpeg_buf, VDU, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU,     qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU+64,  qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU+128, qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU+192, qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCU = jpeg_processDU(&jpeg_buf, UDU, qtbl_UV, DCU, UVDC_HT, UVAC_HT);
+                        DCV = jpeg_processDU(&jpeg_buf, VDU, qtbl_UV, DCV, UVDC_HT, UVAC_HT);
                     }
+                    jpeg_flush(&jpeg_buf); // MCU row done
+                    jpeg_budget(&jpeg_buf, y + 16, src->h);
                     if (jpeg_buf.overflow) {
                         goto jpeg_overflow;
                     }
@@ -1122,28 +1264,23 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
         switch (jpeg_subsample) {
             case JPEG_SUBSAMPLE_1x1: {
                 int8_t YDU[64], UDU[64], VDU[64];
-                uint16_t pixel, rgbbuf[64];
-                int r, g, b;
+                uint16_t rgbbuf[64];
                 for (int y=0; y<src->h; y+=8) {
+                    mp_sched_check_in();
                     for (int x=0; x<src->w; x+=8) {
                         imlib_bayer_to_rgb565(src, 8, 8, x, y, rgbbuf);
                         for (int ty=0, idx=0; ty<8; ty++, idx+=8) {
                             for (int tx=0; tx<8; tx++) {
-                                pixel = rgbbuf[idx+tx];
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                YDU[idx+tx] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15) -128; // .299*r + .587*g + .114*b
-                                UDU[idx+tx] = (uint8_t)(((b << 14) - (r * 5529) - (g * 10855)) >> 15); // -0.168736*r + -0.331264*g + 0.5*b
-                                VDU[idx+tx] = (uint8_t)(((r << 14) - (g * 13682) - (b * 2664)) >> 15); // 0.5*r + -0.418688*g + -0.081312*b
+                                jpeg_rgb565_to_ycbcr(rgbbuf[idx+tx], &YDU[idx+tx], &UDU[idx+tx], &VDU[idx+tx]);
                             } // for tx
                         } // for ty
 
-                        DCY = jpeg_processDU(&jpeg_buf, YDU, fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCU = jpeg_processDU(&jpeg_buf, UDU, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
-                        DCV = jpeg_processDU(&jpeg_buf, VDU, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU, qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCU = jpeg_processDU(&jpeg_buf, UDU, qtbl_UV, DCU, UVDC_HT, UVAC_HT);
+                        DCV = jpeg_processDU(&jpeg_buf, VDU, qtbl_UV, DCV, UVDC_HT, UVAC_HT);
                     }
+                    jpeg_flush(&jpeg_buf); // MCU row done
+                    jpeg_budget(&jpeg_buf, y + 8, src->h);
                     if (jpeg_buf.overflow) {
                         goto jpeg_overflow;
                     }
@@ -1151,39 +1288,30 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
                 break;
             }
             case JPEG_SUBSAMPLE_2x1: {
-                uint16_t pixel, rgbbuf[128];
+                uint16_t rgbbuf[128];
                 int8_t YDU[128], UDU[64], VDU[64];
-                int r, g, b, idx, ofs;
+                int idx, ofs;
                 for (int y=0; y<src->h; y+=8) {
+                    mp_sched_check_in();
                     for (int x=0; x<src->w; x+=16) {
                         imlib_bayer_to_rgb565(src, 16, 8, x, y, rgbbuf);
                         for (int ty=0; ty<8; ty++) {
                             idx = ty*8; ofs = ty*16;
                             for (int tx=0; tx<8; tx++) {
                                 if (tx == 4) idx += (64-8); // right MCU
-                                pixel = rgbbuf[ofs+tx*2];
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                YDU[idx+tx*2] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15) -128; // .299*r + .587*g + .114*b
-                                UDU[(ty*8)+tx] = (uint8_t)(((b << 14) - (r * 5529) - (g * 10855)) >> 15); // -0.168736*r + -0.331264*g + 0.5*b
-                                VDU[(ty*8)+tx] = (uint8_t)(((r << 14) - (g * 13682) - (b * 2664)) >> 15); // 0.5*r + -0.418688*g + -0.081312*b
-
-                                pixel = rgbbuf[ofs+tx*2+1];
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                YDU[idx+tx*2+1] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15) -128; // .299*r + .587*g + .114*b
+                                jpeg_rgb565_to_ycbcr(rgbbuf[ofs+tx*2], &YDU[idx+tx*2], &UDU[(ty*8)+tx], &VDU[(ty*8)+tx]);
+
+                                YDU[idx+tx*2+1] = jpeg_rgb565_to_y(rgbbuf[ofs+tx*2+1]);
                             } // for tx
                         } // for ty
 
-                        DCY = jpeg_processDU(&jpeg_buf, YDU,    fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCY = jpeg_processDU(&jpeg_buf, YDU+64, fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCU = jpeg_processDU(&jpeg_buf, UDU, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
-                        DCV = jpeg_processDU(&jpeg_buf, VDU, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU,    qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU+64, qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCU = jpeg_processDU(&jpeg_buf, UDU, qtbl_UV, DCU, UVDC_HT, UVAC_HT);
+                        DCV = jpeg_processDU(&jpeg_buf, VDU, qtbl_UV, DCV, UVDC_HT, UVAC_HT);
                     }
+                    jpeg_flush(&jpeg_buf); // MCU row done
+                    jpeg_budget(&jpeg_buf, y + 8, src->h);
                     if (jpeg_buf.overflow) {
                         goto jpeg_overflow;
                     }
@@ -1191,11 +1319,11 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
                 break;
             }
             case JPEG_SUBSAMPLE_2x2: {
-                uint16_t pixel, *pRow, rgbbuf[256];
+                uint16_t *pRow, rgbbuf[256];
                 int8_t YDU[256], UDU[64], VDU[64];
                 int8_t *pY, *pU, *pV;
-                int r, g, b;
                 for (int y=0; y<src->h; y+=16) {
+                    mp_sched_check_in();
                     for (int x=0; x<src->w; x+=16) {
                         imlib_bayer_to_rgb565(src, 16, 16, x, y, rgbbuf);
                         for (int ty=0; ty<16; ty+=2) { // row pairs
@@ -1207,45 +1335,25 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
                                 if (tx == 8) // second column of Y MCUs
                                    pY += (64-8);
 
-                                pixel = pRow[0]; // top left
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                pY[0] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15) -128; // .299*r + .587*g + .114*b
-                                pU[0] = (uint8_t)(((b << 14) - (r * 5529) - (g * 10855)) >> 15); // -0.168736*r + -0.331264*g + 0.5*b
-                                pV[0] = (uint8_t)(((r << 14) - (g * 13682) - (b * 2664)) >> 15); // 0.5*r + -0.418688*g + -0.081312*b
-                                pixel = pRow[1]; // top right
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                pY[1] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15)-128; // .299*r + .587*g + .114*b
-
-                                pixel = pRow[16]; // bottom left
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                pY[8] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15)-128; // .299*r + .587*g + .114*b
-
-                                pixel = pRow[17]; // bottom right
-                                r = rb528_table[(pixel >> 3) & 0x1f]; // extract R8/G8/B8
-                                g = g628_table[((pixel & 7) << 3) | (pixel >> 13)];
-                                b = rb528_table[(pixel >> 8) & 0x1f];
-                                // faster to keep all calculations in integer math with 15-bit fractions
-                                pY[9] = (uint8_t)(((r * 9770) + (g * 19182) + (b * 3736)) >> 15)-128; // .299*r + .587*g + .114*b
+                                jpeg_rgb565_to_ycbcr(pRow[0], &pY[0], &pU[0], &pV[0]); // top left
+                                pY[1] = jpeg_rgb565_to_y(pRow[1]); // top right
+
+                                pY[8] = jpeg_rgb565_to_y(pRow[16]); // bottom left
+
+                                pY[9] = jpeg_rgb565_to_y(pRow[17]); // bottom right
                                 pY += 2; pU++; pV++; pRow += 2;
                             } // for tx
                         } // for ty
 
-                        DCY = jpeg_processDU(&jpeg_buf, YDU,     fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCY = jpeg_processDU(&jpeg_buf, YDU+64,  fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCY = jpeg_processDU(&jpeg_buf, YDU+128, fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCY = jpeg_processDU(&jpeg_buf, YDU+192, fdtbl_Y, DCY, YDC_HT, YAC_HT);
-                        DCU = jpeg_processDU(&jpeg_buf, UDU, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
-                        DCV = jpeg_processDU(&jpeg_buf, VDU, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU,     qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU+64,  qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU+128, qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCY = jpeg_processDU(&jpeg_buf, YDU+192, qtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCU = jpeg_processDU(&jpeg_buf, UDU, qtbl_UV, DCU, UVDC_HT, UVAC_HT);
+                        DCV = jpeg_processDU(&jpeg_buf, VDU, qtbl_UV, DCV, UVDC_HT, UVAC_HT);
                     }
+                    jpeg_flush(&jpeg_buf); // MCU row done
+                    jpeg_budget(&jpeg_buf, y + 16, src->h);
                     if (jpeg_buf.overflow) {
                         goto jpeg_overflow;
                     }
@@ -1253,18 +1361,59 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
                 break;
             }
         }
+    } else if (src->bpp == IMAGE_BPP_YUV422) {
+        // Y0 U Y1 V are the samples of a 2x1 MCU as they are, less 128.
+        uint8_t *pRow;
+        int dx, dy;
+        int8_t YDU[128], UDU[64], VDU[64];
+        int8_t *pY, *pU, *pV;
+        for (int y=0; y<src->h; y+=8) {
+            mp_sched_check_in();
+            dy = 8;
+            if (y+8 > src->h) // over bottom edge
+                dy = src->h - y;
+            for (int x=0; x<src->w; x+=16) {
+                dx = 16;
+                if (x+16 > src->w) // over right edge
+                    dx = src->w - x;
+                for (int ty=0; ty<dy; ty++) { // rows
+                    pRow = IMAGE_COMPUTE_YUV422_PIXEL_ROW_PTR(src, y+ty) + (x * 2);
+                    pY = &YDU[(ty*8)]; pU = &UDU[ty*8]; pV=&VDU[ty*8];
+                    for (int tx=0; tx<dx; tx+=2) { // column pairs
+                        if (tx == 8) // second column of Y MCUs
+                            pY += (64-8);
+
+                        pY[0] = pRow[0] - 128; // left
+                        *pU++ = pRow[1] - 128;
+                        pY[1] = pRow[2] - 128; // right
+                        *pV++ = pRow[3] - 128;
+                        pY += 2; pRow += 4;
+                    } // for tx
+                } // for ty
+
+                DCY = jpeg_processDU(&jpeg_buf, YDU,    qtbl_Y, DCY, YDC_HT, YAC_HT);
+                DCY = jpeg_processDU(&jpeg_buf, YDU+64, qtbl_Y, DCY, YDC_HT, YAC_HT);
+                DCU = jpeg_processDU(&jpeg_buf, UDU, qtbl_UV, DCU, UVDC_HT, UVAC_HT);
+                DCV = jpeg_processDU(&jpeg_buf, VDU, qtbl_UV, DCV, UVDC_HT, UVAC_HT);
+            }
+            jpeg_flush(&jpeg_buf); // MCU row done
+            jpeg_budget(&jpeg_buf, y + 8, src->h);
+            if (jpeg_buf.overflow) {
+                goto jpeg_overflow;
+            }
+        }
     }
 
 
     // Do the bit alignment of the EOI marker
-    static const uint16_t fillBits[] = {0x7F, 7};
-    jpeg_writeBits(&jpeg_buf, fillBits);
+    jpeg_writeBits(&jpeg_buf, 0x7F, 7);
 
     // EOI
     jpeg_put_char(&jpeg_buf, 0xFF);
     jpeg_put_char(&jpeg_buf, 0xD9);
+    jpeg_flush(&jpeg_buf);
 
-    dst->bpp = jpeg_buf.idx;
+    dst->bpp = jpeg_buf.sent + jpeg_buf.idx;
     dst->data = jpeg_buf.buf;
 
     #if (TIME_JPEG==1)
@@ -1272,9 +1421,98 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
     #endif
 
 jpeg_overflow:
+    if (planes) {
+        fb_free();
+    }
+    if (budget) {
+        jpeg_budget_clipped = jpeg_buf.clipped;
+        jpeg_budget_cutoff = jpeg_buf.cutoff;
+    }
     return jpeg_buf.overflow;
 }
-#endif //defined OMV_HARDWARE_JPEG
+
+#if MICROPY_PY_THREAD
+// The tables jpeg_init() fills are shared, the omv.submit() worker encodes too.
+static mp_thread_mutex_t jpeg_mutex;
+
+static bool jpeg_encode(image_t *src, image_t *dst, int quality, bool realloc, jpeg_sink_t sink, void *sink_arg, int budget, bool soft)
+{
+    mp_thread_mutex_lock(&jpeg_mutex, 1);
+    if (soft) {
+        // Never raises, no realloc, sink or fb_alloc(), and the worker has no nlr state.
+        bool ret = jpeg_encode_run(src, dst, quality, realloc, sink, sink_arg, budget, soft);
+        mp_thread_mutex_unlock(&jpeg_mutex);
+        return ret;
+    }
+
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        bool ret = jpeg_encode_run(src, dst, quality, realloc, sink, sink_arg, budget, soft);
+        nlr_pop();
+        mp_thread_mutex_unlock(&jpeg_mutex);
+        return ret;
+    }
+    mp_thread_mutex_unlock(&jpeg_mutex);
+    nlr_jump(nlr.ret_val);
+}
+#else
+#define jpeg_encode jpeg_encode_run
+#endif
+
+static bool jpeg_backend_encode(image_t *src, image_t *dst, int quality, bool realloc, jpeg_sink_t sink, void *sink_arg)
+{
+    for (const jpeg_backend_t *const *backend = jpeg_backends; *backend; backend++) {
+        if ((*backend)->compress) {
+            int ret = (*backend)->compress(src, dst, quality, realloc, sink, sink_arg);
+            if (ret >= 0) {
+                return ret;
+            }
+        }
+    }
+
+    return jpeg_encode(src, dst, quality, realloc, sink, sink_arg, 0, false);
+}
+
+bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc)
+{
+    OMV_PROF_SCOPE("jpeg_compress");
+    return jpeg_backend_encode(src, dst, quality, realloc, NULL, NULL);
+}
+
+bool jpeg_compress_sink(image_t *src, image_t *dst, int quality, jpeg_sink_t sink, void *sink_arg)
+{
+    OMV_PROF_SCOPE("jpeg_compress_sink");
+    return jpeg_backend_encode(src, dst, quality, false, sink, sink_arg);
+}
+
+bool jpeg_compress_soft(image_t *src, image_t *dst, int quality)
+{
+    return jpeg_encode(src, dst, quality, false, NULL, NULL, 0, true);
+}
+
+// Quality of the last budgeted frame and the bytes it took, the next frame starts from them.
+static int jpeg_budget_quality, jpeg_budget_bytes;
+
+bool jpeg_compress_budget(image_t *src, image_t *dst, int quality)
+{
+    int budget = dst->bpp, target = budget - (budget / 8);
+    int q = jpeg_budget_quality ? IM_MIN(jpeg_budget_quality, quality) : quality;
+
+    // Scale by the bytes the last frame took against the target, a clipped frame wanted more.
+    if (jpeg_budget_bytes > target || jpeg_budget_clipped) {
+        int bytes = jpeg_budget_clipped ? budget : jpeg_budget_bytes;
+        q = IM_MAX(IM_MIN((int) (((int64_t) q * target) / bytes), q - 1), 1);
+    } else if (jpeg_budget_bytes && (jpeg_budget_bytes < (target - (target / 4)))) {
+        q = IM_MIN(q + IM_MAX((quality - q) / 4, 1), quality);
+    }
+
+    // The hardware backends can't re-quantise mid frame, the software encoder does the row control.
+    bool overflow = jpeg_encode(src, dst, q, false, NULL, NULL, budget, false);
+
+    jpeg_budget_quality = overflow ? IM_MAX(q / 2, 1) : q;
+    jpeg_budget_bytes = overflow ? budget : dst->bpp;
+    return overflow;
+}
 
 // This function inits the geometry values of an image.
 void jpeg_read_geometry(FIL *fp, image_t *img, const char *path)
@@ -1337,6 +1575,12 @@ void jpeg_read(image_t *img, const char *path)
     file_close(&fp);
 }
 
+bool jpeg_file_sink(void *fp, const uint8_t *data, int size)
+{
+    write_data((FIL *) fp, data, size);
+    return true;
+}
+
 void jpeg_write(image_t *img, const char *path, int quality)
 {
     FIL fp;
@@ -1344,14 +1588,10 @@ void jpeg_write(image_t *img, const char *path, int quality)
     if (IM_IS_JPEG(img)) {
         write_data(&fp, img->pixels, img->bpp);
     } else {
-        uint32_t size;
-        uint8_t *buffer = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE);
-        image_t out = { .w=img->w, .h=img->h, .bpp=size, .pixels=buffer };
-        // When jpeg_compress needs more memory than in currently allocated it
-        // will try to realloc. MP will detect that the pointer is outside of
-        // the heap and return NULL which will cause an out of memory error.
-        jpeg_compress(img, &out, quality, false);
-        write_data(&fp, out.pixels, out.bpp);
+        uint8_t *buffer = fb_alloc(JPEG_SINK_BUF_SIZE, FB_ALLOC_NO_HINT);
+        image_t out = { .w=img->w, .h=img->h, .bpp=JPEG_SINK_BUF_SIZE, .pixels=buffer };
+        // The file is written as the frame is encoded, write_data() raises on errors.
+        jpeg_compress_sink(img, &out, quality, jpeg_file_sink, &fp);
         fb_free();
     }
     file_close(&fp);
@@ -10,6 +10,7 @@
 #include <limits.h>
 #include <arm_math.h>
 #include <stdio.h>
+#include <string.h>
 #include "imlib.h"
 #include "array.h"
 #include "xalloc.h"
@@ -28,6 +29,9 @@ __WEAK uint32_t rng_randint(uint32_t min, uint32_t max) {
 
 extern uint32_t rng_randint(uint32_t min, uint32_t max);
 
+// Bounds the iterations if assignments keep flipping between equally near centroids.
+#define KMEANS_MAX_ITERATIONS   (100)
+
 static cluster_t *cluster_alloc(int cx, int cy)
 {
     cluster_t *c=NULL;
@@ -49,103 +53,107 @@ static void cluster_free(void *c)
     xfree(cl);
 }
 
-static void cluster_reset(array_t *clusters, array_t *points)
+// Clusters the points (kp_t) around k centroids. The coordinates and the cluster of each
+// point are kept in one contiguous block while iterating, the clusters' arrays of points
+// are only built once at the end. They point to the kp_t of points, which is left as it is.
+// A NULL dist_func is the Euclidean distance, done in integers.
+array_t *cluster_kmeans(array_t *points, int k, cluster_dist_t dist_func)
 {
-    // Reset all clusters
-    for (int j=0; j<array_length(clusters); j++) {
-         cluster_t *cl = array_at(clusters, j);
-         while (array_length(cl->points)) {
-             array_push_back(points, array_pop_back(cl->points));
-         }
-         array_free(cl->points);
-         array_alloc(&cl->points, NULL);
+    // Alloc clusters array
+    array_t *clusters=NULL;
+    array_alloc(&clusters, cluster_free);
+
+    int n = array_length(points);
+    if (!n || (k <= 0)) {
+        return clusters;
     }
-}
+    k = IM_MIN(k, UINT16_MAX);
 
-static int cluster_update(array_t *clusters)
-{
-    // Update clusters
-    for (int j=0; j<array_length(clusters); j++) {
-        cluster_t *cl = array_at(clusters, j);
-        int cx = cl->x, cy = cl->y;
-        int cl_size = array_length(cl->points);
-
-        // Sum all points in this cluster
-        for (int i=0; i<cl_size; i++) {
-            kp_t *p = array_at(cl->points, i);
-            cl->x += p->x;
-            cl->y += p->y;
-            // Find out the max x and y while we're at it
-            if (p->x > cl->w) {
-                cl->w = p->x;
+    int32_t *cx = xalloc((k * 5 * sizeof(int32_t)) + (n * 3 * sizeof(uint16_t)));
+    int32_t *cy = cx + k, *sx = cy + k, *sy = sx + k, *cn = sy + k;
+    uint16_t *px = (uint16_t *) (cn + k), *py = px + n, *pc = py + n;
+
+    for (int i=0; i<n; i++) {
+        kp_t *p = array_at(points, i);
+        px[i] = p->x;
+        py[i] = p->y;
+        pc[i] = UINT16_MAX;
+    }
+
+    // Select K clusters randomly
+    for (int j=0; j<k; j++) {
+        int pidx = rng_randint(0, n-1);
+        cx[j] = px[pidx];
+        cy[j] = py[pidx];
+    }
+
+    for (int iter=0, changed=1; changed && (iter<KMEANS_MAX_ITERATIONS); iter++) {
+        changed = 0;
+
+        // Add points to the nearest cluster
+        for (int i=0; i<n; i++) {
+            int nearest = 0;
+            if (dist_func) {
+                float distance = FLT_MAX;
+                for (int j=0; j<k; j++) {
+                    float d = dist_func(cx[j], cy[j], array_at(points, i));
+                    if (d < distance) {
+                        distance = d;
+                        nearest = j;
+                    }
+                }
+            } else {
+                uint32_t distance = UINT32_MAX;
+                for (int j=0; j<k; j++) {
+                    int dx = cx[j] - px[i], dy = cy[j] - py[i];
+                    uint32_t d = (dx * dx) + (dy * dy);
+                    if (d < distance) {
+                        distance = d;
+                        nearest = j;
+                    }
+                }
             }
-            if (p->y > cl->h) {
-                cl->h = p->y;
+            if (pc[i] != nearest) {
+                pc[i] = nearest;
+                changed = 1;
             }
         }
 
-        // Update centroid
-        cl->x = cl->x/cl_size;
-        cl->y = cl->y/cl_size;
-        // Update cluster size
-        cl->w = (cl->w - cl->x) * 2;
-        cl->h = (cl->h - cl->y) * 2;
-        if (cl->x == cx && cl->y == cy) {
-            // Cluster centroid did not change
-            return 0;
+        // Update centroids, an empty cluster keeps its centroid
+        memset(sx, 0, k * 3 * sizeof(int32_t));
+        for (int i=0; i<n; i++) {
+            sx[pc[i]] += px[i];
+            sy[pc[i]] += py[i];
+            cn[pc[i]] += 1;
         }
-    }
-
-    return 1;
-}
-
-static void cluster_points(array_t *clusters, array_t *points, cluster_dist_t dist_func)
-{
-    // Add objects to cluster
-    while (array_length(points)) {
-        float distance = FLT_MAX;
-        cluster_t *cl_nearest = NULL;
-        kp_t *p = array_pop_back(points);
-
-        for (int j=0; j<array_length(clusters); j++) {
-            cluster_t *cl = array_at(clusters, j);
-            float d = dist_func(cl->x, cl->y, p);
-            if (d < distance) {
-                distance = d;
-                cl_nearest = cl;
+        for (int j=0; j<k; j++) {
+            if (cn[j]) {
+                cx[j] = sx[j] / cn[j];
+                cy[j] = sy[j] / cn[j];
             }
         }
-        // Add pointer to point to cluster.
-        // Note: Objects in the cluster are not free'd
-        array_push_back(cl_nearest->points, p);
     }
-}
-
-array_t *cluster_kmeans(array_t *points, int k, cluster_dist_t dist_func)
-{
-    // Alloc clusters array
-    array_t *clusters=NULL;
-    array_alloc(&clusters, cluster_free);
 
-    // Select K clusters randomly
-    for (int i=0; i<k; i++) {
-        int pidx = rng_randint(0, array_length(points)-1);
-        kp_t *p = array_at(points, pidx);
-        array_push_back(clusters, cluster_alloc(p->x, p->y));
+    // Cluster size is twice the largest distance of a point from the centroid
+    for (int j=0; j<k; j++) {
+        sx[j] = cx[j];
+        sy[j] = cy[j];
+    }
+    for (int i=0; i<n; i++) {
+        sx[pc[i]] = IM_MAX(sx[pc[i]], px[i]);
+        sy[pc[i]] = IM_MAX(sy[pc[i]], py[i]);
+    }
+    for (int j=0; j<k; j++) {
+        cluster_t *cl = cluster_alloc(cx[j], cy[j]);
+        cl->w = (sx[j] - cx[j]) * 2;
+        cl->h = (sy[j] - cy[j]) * 2;
+        array_push_back(clusters, cl);
+    }
+    for (int i=0; i<n; i++) {
+        cluster_t *cl = array_at(clusters, pc[i]);
+        array_push_back(cl->points, array_at(points, i));
     }
 
-    int cl_changed = 1;
-    do {
-        // Reset clusters
-        cluster_reset(clusters, points);
-
-        // Add points to clusters
-        cluster_points(clusters, points, dist_func);
-
-        // Update centroids
-        cl_changed = cluster_update(clusters);
-
-    } while (cl_changed);
-
+    xfree(cx);
     return clusters;
 }
@@ -50,29 +50,64 @@ const static uint8_t uniform_tbl[256] = {
     47, 48, 58, 49, 58, 58, 58, 50, 51, 52, 58, 53, 54, 55, 56, 57
 };
 
+#if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+// Bit k of the codes of 4 pixels at once: __USUB8 sets the GE flag of each byte where the
+// neighbour is >= the centre, __SEL then picks the bit for those bytes. A statement each,
+// the GE flags are shared.
+#define LBP_BIT4(lbp4, n, p, k) \
+    do { \
+        __USUB8((n), (p)); \
+        (lbp4) |= __SEL(0x01010101 << (k), 0); \
+    } while (0)
+#endif
+
 uint8_t *imlib_lbp_desc(image_t *image, rectangle_t *roi)
 {
     int s = image->w; //stride
-    int RX = roi->w/LBP_NUM_REGIONS;
-    int RY = roi->h/LBP_NUM_REGIONS;
+    int RX = IM_MAX(roi->w/LBP_NUM_REGIONS, 1);
+    int RY = IM_MAX(roi->h/LBP_NUM_REGIONS, 1);
     uint8_t *data = image->data;
     uint8_t *desc = xalloc0(LBP_DESC_SIZE);
 
     for (int y=roi->y; y<(roi->y+roi->h)-3; y++) {
-        int y_idx = ((y-roi->y)/RY)*LBP_NUM_REGIONS;
-        for (int x=roi->x; x<(roi->x+roi->w)-3; x++) {
+        // The last region takes the rows and columns that don't divide evenly.
+        int y_idx = IM_MIN((y-roi->y)/RY, LBP_NUM_REGIONS-1)*LBP_NUM_REGIONS;
+        const uint8_t *r0 = data+(y*s), *r1 = r0+s, *r2 = r1+s;
+        int x = roi->x, xx = (roi->x+roi->w)-3;
+
+        #if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+        for (; (x+4)<=xx; x+=4) {
+            uint32_t p = *((uint32_t *) (r1+x+1));
+            uint32_t lbp4 = 0;
+            LBP_BIT4(lbp4, *((uint32_t *) (r0+x+0)), p, 0);
+            LBP_BIT4(lbp4, *((uint32_t *) (r0+x+1)), p, 1);
+            LBP_BIT4(lbp4, *((uint32_t *) (r0+x+2)), p, 2);
+            LBP_BIT4(lbp4, *((uint32_t *) (r1+x+2)), p, 3);
+            LBP_BIT4(lbp4, *((uint32_t *) (r2+x+2)), p, 4);
+            LBP_BIT4(lbp4, *((uint32_t *) (r2+x+1)), p, 5);
+            LBP_BIT4(lbp4, *((uint32_t *) (r2+x+0)), p, 6);
+            LBP_BIT4(lbp4, *((uint32_t *) (r1+x+0)), p, 7);
+
+            for (int i=0; i<4; i++, lbp4>>=8) {
+                int hist_idx = y_idx+IM_MIN((x+i-roi->x)/RX, LBP_NUM_REGIONS-1);
+                desc[hist_idx*LBP_HIST_SIZE+uniform_tbl[lbp4 & 0xFF]]++;
+            }
+        }
+        #endif
+
+        for (; x<xx; x++) {
             uint8_t lbp=0;
-            uint8_t p = data[(y+1)*s+x+1];
-            int hist_idx = y_idx+(x-roi->x)/RX;
-
-            lbp |= (data[(y+0)*s+x+0] >= p) << 0;
-            lbp |= (data[(y+0)*s+x+1] >= p) << 1;
-            lbp |= (data[(y+0)*s+x+2] >= p) << 2;
-            lbp |= (data[(y+1)*s+x+2] >= p) << 3;
-            lbp |= (data[(y+2)*s+x+2] >= p) << 4;
-            lbp |= (data[(y+2)*s+x+1] >= p) << 5;
-            lbp |= (data[(y+2)*s+x+0] >= p) << 6;
-            lbp |= (data[(y+1)*s+x+0] >= p) << 7;
+            uint8_t p = r1[x+1];
+            int hist_idx = y_idx+IM_MIN((x-roi->x)/RX, LBP_NUM_REGIONS-1);
+
+            lbp |= (r0[x+0] >= p) << 0;
+            lbp |= (r0[x+1] >= p) << 1;
+            lbp |= (r0[x+2] >= p) << 2;
+            lbp |= (r1[x+2] >= p) << 3;
+            lbp |= (r2[x+2] >= p) << 4;
+            lbp |= (r2[x+1] >= p) << 5;
+            lbp |= (r2[x+0] >= p) << 6;
+            lbp |= (r1[x+0] >= p) << 7;
 
             desc[hist_idx*LBP_HIST_SIZE+uniform_tbl[lbp]]++;
         }
@@ -460,20 +460,14 @@ float * lsd(int * n_out, unsigned char * img, int X, int Y);
 /** Label for pixels already used in detection. */
 #define USED    1
 
-/*----------------------------------------------------------------------------*/
-/** Chained list of coordinates.
- */
-struct coorlist
-{
-  int16_t x,y;
-  struct coorlist * next;
-};
-
 /*----------------------------------------------------------------------------*/
 /** A point (or pixel).
  */
 struct lsd_point {int16_t x,y;};
 
+/** Initial number of points of the region buffer, it grows on demand. */
+#define REG_INI_SIZE 512
+
 
 /*----------------------------------------------------------------------------*/
 /*------------------------- Miscellaneous functions --------------------------*/
@@ -1104,32 +1098,34 @@ static image_double gaussian_sampler( image_double in, float scale,
     The result is:
     - an image_int with the angle at each pixel, or NOTDEF if not defined.
     - the image_int 'modgrad' (a pointer is passed as argument)
-      with the gradient magnitude at each point.
-    - a list of pixels 'list_p' roughly ordered by decreasing
-      gradient magnitude. (The order is made by classifying points
-      into bins by gradient magnitude. The parameters 'n_bins' and
+      with the gradient magnitude at each point where the angle is
+      defined (zero elsewhere).
+    - an array of pixels 'list_p' of size 'list_size' roughly ordered
+      by decreasing gradient magnitude. (The order is made by classifying
+      points into bins by gradient magnitude. The parameters 'n_bins' and
       'max_grad' specify the number of bins and the gradient modulus
       at the highest bin. The pixels in the list would be in
       decreasing gradient magnitude, up to a precision of the size of
-      the bins.)
-    - a pointer 'mem_p' to the memory used by 'list_p' to be able to
-      free the memory when it is not used anymore.
+      the bins.) Only pixels with a defined angle are listed, the others
+      can never seed a region.
+
+    The gradient is computed with integers and compared squared against
+    the threshold, so the square root and the angle are only evaluated
+    on the few pixels that pass it.
  */
 static image_int ll_angle( image_char in, float threshold,
-                           struct coorlist ** list_p, void ** mem_p,
+                           struct lsd_point ** list_p, unsigned int * list_size,
                            image_int * modgrad, unsigned int n_bins )
 {
   image_int g;
   unsigned int n,p,x,y,adr,i;
-  float com1,com2,gx,gy,norm,norm2;
+  int com1,com2,gx,gy,norm2;
+  float norm,threshold2;
   /* the rest of the variables are used for pseudo-ordering
      the gradient magnitude values */
-  int list_count = 0;
-  struct coorlist * list;
-  struct coorlist ** range_l_s; /* array of pointers to start of bin list */
-  struct coorlist ** range_l_e; /* array of pointers to end of bin list */
-  struct coorlist * start;
-  struct coorlist * end;
+  unsigned int list_count = 0;
+  struct lsd_point * list;
+  unsigned int * range_l; /* bin sizes, then offset of each bin in 'list' */
   float max_grad = 0.0;
 
   /* check parameters */
@@ -1137,7 +1133,7 @@ static image_int ll_angle( image_char in, float threshold,
     error("ll_angle: invalid image.");
   if( threshold < 0.0 ) error("ll_angle: 'threshold' must be positive.");
   if( list_p == NULL ) error("ll_angle: NULL pointer 'list_p'.");
-  if( mem_p == NULL ) error("ll_angle: NULL pointer 'mem_p'.");
+  if( list_size == NULL ) error("ll_angle: NULL pointer 'list_size'.");
   if( modgrad == NULL ) error("ll_angle: NULL pointer 'modgrad'.");
   if( n_bins == 0 ) error("ll_angle: 'n_bins' must be positive.");
 
@@ -1145,23 +1141,15 @@ static image_int ll_angle( image_char in, float threshold,
   n = in->ysize;
   p = in->xsize;
 
+  /* norm <= threshold  <=>  norm2 / 4 <= threshold^2 */
+  threshold2 = 4.0 * threshold * threshold;
+
   /* allocate output image */
   g = new_image_int(in->xsize,in->ysize);
 
   /* get memory for the image of gradient modulus */
   *modgrad = new_image_int(in->xsize,in->ysize);
 
-  /* get memory for "ordered" list of pixels */
-  list = (struct coorlist *) calloc( (size_t) (n*p), sizeof(struct coorlist) );
-  *mem_p = (void *) list;
-  range_l_s = (struct coorlist **) calloc( (size_t) n_bins,
-                                           sizeof(struct coorlist *) );
-  range_l_e = (struct coorlist **) calloc( (size_t) n_bins,
-                                           sizeof(struct coorlist *) );
-  if( list == NULL || range_l_s == NULL || range_l_e == NULL )
-    error("not enough memory.");
-  for(i=0;i<n_bins;i++) range_l_s[i] = range_l_e[i] = NULL;
-
   /* 'undefined' on the down and right boundaries */
   for(x=0;x<p;x++) g->data[(n-1)*p+x] = NOTDEF;
   for(y=0;y<n;y++) g->data[p*y+p-1]   = NOTDEF;
@@ -1189,66 +1177,75 @@ static image_int ll_angle( image_char in, float threshold,
         gx = com1+com2; /* gradient x component */
         gy = com1-com2; /* gradient y component */
         norm2 = gx*gx+gy*gy;
-        norm = sqrt( norm2 / 4.0 ); /* gradient norm */
-
-        (*modgrad)->data[adr] = norm; /* store gradient norm */
 
-        if( norm <= threshold ) /* norm too small, gradient no defined */
+        if( (float) norm2 <= threshold2 ) /* norm too small, gradient no defined */
           g->data[adr] = NOTDEF_INT; //radToDeg(NOTDEF); /* gradient angle not defined */
         else
           {
+            norm = sqrt( (float) norm2 / 4.0 ); /* gradient norm */
+
+            (*modgrad)->data[adr] = norm; /* store gradient norm */
+
             /* gradient angle computation */
-            g->data[adr] = radToDeg(atan2(gx,-gy));
+            g->data[adr] = radToDeg(atan2((float) gx,(float) -gy));
 
             /* look for the maximum of the gradient */
             if( norm > max_grad ) max_grad = norm;
+
+            ++list_count;
           }
       }
 
+  /* get memory for "ordered" list of pixels */
+  list = (struct lsd_point *) malloc( (size_t) (list_count ? list_count : 1) *
+                                      sizeof(struct lsd_point) );
+  range_l = (unsigned int *) calloc( (size_t) n_bins, sizeof(unsigned int) );
+  if( list == NULL || range_l == NULL ) error("not enough memory.");
+
   /* compute histogram of gradient values */
   for(x=0;x<p-1;x++)
     for(y=0;y<n-1;y++)
-      {
-        norm = (*modgrad)->data[y*p+x];
+      if( g->data[y*p+x] != NOTDEF_INT )
+        {
+          norm = (*modgrad)->data[y*p+x];
 
-        /* store the point in the right bin according to its norm */
-        i = (unsigned int) (norm * (float) n_bins / max_grad);
-        if( i >= n_bins ) i = n_bins-1;
-        if( range_l_e[i] == NULL )
-          range_l_s[i] = range_l_e[i] = list+list_count++;
-        else
-          {
-            range_l_e[i]->next = list+list_count;
-            range_l_e[i] = list+list_count++;
-          }
-        range_l_e[i]->x = (int) x;
-        range_l_e[i]->y = (int) y;
-        range_l_e[i]->next = NULL;
-      }
+          /* count the point in the right bin according to its norm */
+          i = (unsigned int) (norm * (float) n_bins / max_grad);
+          if( i >= n_bins ) i = n_bins-1;
+          ++range_l[i];
+        }
 
   /* Make the list of pixels (almost) ordered by norm value.
      It starts by the larger bin, so the list starts by the
      pixels with the highest gradient value. Pixels would be ordered
      by norm value, up to a precision given by max_grad/n_bins.
    */
-  for(i=n_bins-1; i>0 && range_l_s[i]==NULL; i--);
-  start = range_l_s[i];
-  end = range_l_e[i];
-  if( start != NULL )
-    while(i>0)
-      {
-        --i;
-        if( range_l_s[i] != NULL )
-          {
-            end->next = range_l_s[i];
-            end = range_l_e[i];
-          }
-      }
-  *list_p = start;
+  for(i=n_bins,adr=0; i-->0; )
+    {
+      unsigned int size = range_l[i];
+      range_l[i] = adr;
+      adr += size;
+    }
+
+  for(x=0;x<p-1;x++)
+    for(y=0;y<n-1;y++)
+      if( g->data[y*p+x] != NOTDEF_INT )
+        {
+          norm = (*modgrad)->data[y*p+x];
+
+          /* store the point in the right bin according to its norm */
+          i = (unsigned int) (norm * (float) n_bins / max_grad);
+          if( i >= n_bins ) i = n_bins-1;
+          list[range_l[i]].x = (int) x;
+          list[range_l[i]].y = (int) y;
+          ++range_l[i];
+        }
+
+  *list_p = list;
+  *list_size = list_count;
 
   /* free memory */
-  free( (void *) range_l_s );
-  free( (void *) range_l_e );
+  free( (void *) range_l );
 
   return g;
 }
@@ -2167,10 +2164,11 @@ static void region2rect( struct lsd_point * reg, int reg_size,
 /** Build a region of pixels that share the same angle, up to a
     tolerance 'prec', starting at point (x,y).
  */
-static void region_grow( int x, int y, image_int angles, struct lsd_point * reg,
-                         int * reg_size, float * reg_angle, image_char used,
-                         float prec )
+static void region_grow( int x, int y, image_int angles, struct lsd_point ** reg_p,
+                         int * reg_max, int * reg_size, float * reg_angle,
+                         image_char used, float prec )
 {
+  struct lsd_point * reg = *reg_p;
   float sumdx,sumdy;
   int xx,yy,i;
   int l_size; // local copy
@@ -2216,7 +2214,13 @@ static void region_grow( int x, int y, image_int angles, struct lsd_point * reg,
         if( used->data[xx+yy*xsize] != USED &&
             isaligned_fast((float)angles->data[(yy*xsize)+xx],l_angle,prec) )
           {
-            /* add point */
+            /* add point, growing the region buffer if needed */
+            if( l_size == *reg_max )
+              {
+                *reg_max *= 2;
+                reg = *reg_p = (struct lsd_point *)
+                  realloc( (void *) reg, (size_t) *reg_max * sizeof(struct lsd_point) );
+              }
             used->data[xx+yy*xsize] = USED;
             reg[l_size].x = xx;
             reg[l_size].y = yy;
@@ -2429,10 +2433,12 @@ static int reduce_region_radius( struct lsd_point * reg, int * reg_size,
     produce a rectangle with the right density of region points,
     'reduce_region_radius' is called to try to satisfy this condition.
  */
-static int refine( struct lsd_point * reg, int * reg_size, image_int modgrad,
-                   float reg_angle, float prec, float p, struct rect * rec,
-                   image_char used, image_int angles, float density_th )
+static int refine( struct lsd_point ** reg_p, int * reg_max, int * reg_size,
+                   image_int modgrad, float reg_angle, float prec, float p,
+                   struct rect * rec, image_char used, image_int angles,
+                   float density_th )
 {
+  struct lsd_point * reg = *reg_p;
   float angle,ang_d,mean_angle,tau,density,xc,yc,ang_c,sum,s_sum;
   int i,n;
 
@@ -2478,7 +2484,8 @@ static int refine( struct lsd_point * reg, int * reg_size, image_int modgrad,
                          + mean_angle*mean_angle ); /* 2 * standard deviation */
 
   /* find a new region from the same starting point and new angle tolerance */
-  region_grow(reg[0].x,reg[0].y,angles,reg,reg_size,&reg_angle,used,tau);
+  region_grow(reg[0].x,reg[0].y,angles,reg_p,reg_max,reg_size,&reg_angle,used,tau);
+  reg = *reg_p;
 
   /* if the region is too small, reject */
   if( *reg_size < 2 ) return FALSE;
@@ -2520,11 +2527,11 @@ float * LineSegmentDetection( int * n_out,
   image_int scaled_image,angles,modgrad;
   image_char used;
   image_int region = NULL;
-  struct coorlist * list_p;
-  void * mem_p;
+  struct lsd_point * list_p;
+  unsigned int list_size,l;
   struct rect rec;
   struct lsd_point * reg;
-  int reg_size,min_reg_size,i;
+  int reg_size,reg_max,min_reg_size,i;
   unsigned int xsize,ysize;
   float rho,reg_angle,prec,p,log_nfa,logNT;
   int ls_count = 0;                   /* line segments are numbered 1,2,3,... */
@@ -2558,7 +2565,7 @@ float * LineSegmentDetection( int * n_out,
 //      free_image_double(scaled_image);
 //    }
 //  else
-    angles = ll_angle( image, rho, &list_p, &mem_p, &modgrad,
+    angles = ll_angle( image, rho, &list_p, &list_size, &modgrad,
                        (unsigned int) n_bins );
   xsize = angles->xsize;
   ysize = angles->ysize;
@@ -2586,21 +2593,20 @@ float * LineSegmentDetection( int * n_out,
 //  if( reg_img != NULL && reg_x != NULL && reg_y != NULL ) /* save region data */
 //    region = new_image_int_ini(angles->xsize,angles->ysize,0);
   used = new_image_char_ini(xsize,ysize,NOTUSED);
-  reg = (struct lsd_point *) calloc( (size_t) (xsize*ysize), sizeof(struct lsd_point) );
+  /* the region buffer is reused by all regions and only grows when a
+     region does not fit, instead of being sized for the whole image */
+  reg_max = REG_INI_SIZE;
+  reg = (struct lsd_point *) malloc( (size_t) reg_max * sizeof(struct lsd_point) );
   if( reg == NULL ) error("not enough memory!");
 
 
-  /* search for line segments */
-  for(; list_p != NULL; list_p = list_p->next )
-    if( used->data[ list_p->x + list_p->y * used->xsize ] == NOTUSED &&
-        angles->data[ list_p->x + list_p->y * angles->xsize ] != NOTDEF_INT )
-//        degToRad(angles->data[ list_p->x + list_p->y * angles->xsize ]) != NOTDEF )
-       /* there is no risk of float comparison problems here
-          because we are only interested in the exact NOTDEF value */
+  /* search for line segments (all listed pixels have a defined angle) */
+  for(l=0; l<list_size; l++)
+    if( used->data[ list_p[l].x + list_p[l].y * used->xsize ] == NOTUSED )
       {
         /* find the region of connected point and ~equal angle */
-        region_grow( list_p->x, list_p->y, angles, reg, &reg_size,
-                     &reg_angle, used, prec );
+        region_grow( list_p[l].x, list_p[l].y, angles, &reg, &reg_max,
+                     &reg_size, &reg_angle, used, prec );
 
         /* reject small regions */
         if( reg_size < min_reg_size ) continue;
@@ -2617,7 +2623,7 @@ float * LineSegmentDetection( int * n_out,
            by R. Grompone von Gioi, J. Jakubowicz, J.M. Morel, and G. Randall.
            The original algorithm is obtained with density_th = 0.0.
          */
-        if( !refine( reg, &reg_size, modgrad, reg_angle,
+        if( !refine( &reg, &reg_max, &reg_size, modgrad, reg_angle,
                      prec, p, &rec, used, angles, density_th ) ) continue;
 
         /* compute NFA value */
@@ -2662,7 +2668,7 @@ float * LineSegmentDetection( int * n_out,
   free_image_int(modgrad);
   free_image_char(used);
   free( (void *) reg );
-  free( (void *) mem_p );
+  free( (void *) list_p );
 
 //  /* return the result */
 //  if( reg_img != NULL && reg_x != NULL && reg_y != NULL )
@@ -2741,7 +2747,11 @@ float * lsd(int * n_out, unsigned char * img, int X, int Y)
 
 void imlib_lsd_find_line_segments(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int merge_distance, unsigned int max_theta_diff)
 {
-    uint8_t *grayscale_image = fb_alloc(roi->w * roi->h, FB_ALLOC_NO_HINT);
+    OMV_PROF_SCOPE("imlib_lsd_find_line_segments");
+    // A grayscale roi spanning whole rows is already contiguous, so it is used in place.
+    bool in_place = (ptr->bpp == IMAGE_BPP_GRAYSCALE) && (roi->x == 0) && (roi->w == ptr->w);
+    uint8_t *grayscale_image = in_place ? IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, roi->y)
+                                        : fb_alloc(roi->w * roi->h, FB_ALLOC_NO_HINT);
     uint8_t *grayscale_image_tmp = grayscale_image;
     umm_init_x(fb_avail());
 
@@ -2756,6 +2766,7 @@ void imlib_lsd_find_line_segments(list_t *out, image_t *ptr, rectangle_t *roi, u
             break;
         }
         case IMAGE_BPP_GRAYSCALE: {
+            if (in_place) break;
             for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
                 uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
                 for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
@@ -2817,7 +2828,7 @@ void imlib_lsd_find_line_segments(list_t *out, image_t *ptr, rectangle_t *roi, u
     }
 
     fb_free(); // umm_init_x();
-    fb_free(); // grayscale_image;
+    if (!in_place) fb_free(); // grayscale_image;
 }
 
 #pragma GCC diagnostic pop
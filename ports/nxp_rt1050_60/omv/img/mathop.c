@@ -8,6 +8,7 @@
 #ifdef IMLIB_ENABLE_MATH_OPS
 void imlib_gamma_corr(image_t *img, float gamma, float contrast, float brightness)
 {
+    OMV_PROF_SCOPE("imlib_gamma_corr");
     gamma = IM_DIV(1.0, gamma);
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
@@ -104,6 +105,7 @@ void imlib_gamma_corr(image_t *img, float gamma, float contrast, float brightnes
 
 void imlib_negate(image_t *img)
 {
+    OMV_PROF_SCOPE("imlib_negate");
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
             for (int y = 0, yy = img->h; y < yy; y++) {
@@ -213,6 +215,7 @@ static void imlib_replace_line_op(image_t *img, int line, void *other, void *dat
 
 void imlib_replace(image_t *img, const char *path, image_t *other, int scalar, bool hmirror, bool vflip, bool transpose, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_replace");
     bool in_place = img->data == other->data;
     image_t temp;
 
@@ -242,6 +245,191 @@ void imlib_replace(image_t *img, const char *path, image_t *other, int scalar, b
     }
 }
 
+// Ops on another image or a scalar in memory skip imlib_image_operation() and its per line
+// callback. The pixels of an image are contiguous, so an unmasked op is one loop over all of
+// them, a word at a time: 32 binary pixels, 4 grayscale pixels in the SIMD byte lanes or 2
+// (byte swapped) RGB565 pixels, red and blue split in byte lanes and green in 2 more. A
+// masked op runs a row at a time on the bits of the mask row, spread to the lanes of a word.
+// Blending is in 8 bit fixed point, alpha is a multiple of 1/256 from Python, so it matches
+// the float line op.
+typedef enum mathop {
+    MATHOP_ADD,
+    MATHOP_SUB,
+    MATHOP_RSUB,
+    MATHOP_MIN,
+    MATHOP_MAX,
+    MATHOP_DIFFERENCE,
+    MATHOP_BLEND
+} mathop_t;
+
+#define MATHOP_INLINE       inline __attribute__((always_inline))
+#define MATHOP_RB_LANES(p)  ((((p) >> 3) & 0x001F001F) | ((p) & 0x1F001F00))
+#define MATHOP_G_LANES(p)   ((((p) & 0x00070007) << 3) | (((p) >> 13) & 0x00070007))
+#define MATHOP_RGB565(rb, g) \
+    ((((rb) & 0x001F001F) << 3) | ((rb) & 0x1F001F00) | (((g) >> 3) & 0x00070007) | (((g) & 0x00070007) << 13))
+
+static MATHOP_INLINE int mathop_pixel(mathop_t op, int a, int b, int max, int alpha)
+{
+    switch (op) {
+        case MATHOP_ADD: return IM_MIN(a + b, max);
+        case MATHOP_SUB: return IM_MAX(a - b, 0);
+        case MATHOP_RSUB: return IM_MAX(b - a, 0);
+        case MATHOP_MIN: return IM_MIN(a, b);
+        case MATHOP_MAX: return IM_MAX(a, b);
+        case MATHOP_DIFFERENCE: return abs(a - b);
+        default: return ((a * alpha) + (b * (256 - alpha))) >> 8;
+    }
+}
+
+static MATHOP_INLINE uint32_t mathop_binary_word(mathop_t op, uint32_t a, uint32_t b, int alpha)
+{
+    switch (op) {
+        case MATHOP_ADD: return a | b;
+        case MATHOP_SUB: return a & ~b;
+        case MATHOP_RSUB: return b & ~a;
+        case MATHOP_MIN: return a & b;
+        case MATHOP_MAX: return a | b;
+        case MATHOP_DIFFERENCE: return a ^ b;
+        default: return (a & b) | ((alpha == 256) ? a : 0) | ((alpha == 0) ? b : 0);
+    }
+}
+
+#if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+// 4 byte lanes of values up to max (in each lane).
+static MATHOP_INLINE uint32_t mathop_lanes(mathop_t op, uint32_t a, uint32_t b, uint32_t max, int alpha)
+{
+    switch (op) {
+        case MATHOP_ADD: {
+            if (max == 0xFFFFFFFF) {
+                return __UQADD8(a, b);
+            }
+            uint32_t s = a + b;
+            __USUB8(s, max);
+            return __SEL(max, s);
+        }
+        case MATHOP_SUB: return __UQSUB8(a, b);
+        case MATHOP_RSUB: return __UQSUB8(b, a);
+        case MATHOP_MIN: {
+            __USUB8(a, b);
+            return __SEL(b, a);
+        }
+        case MATHOP_MAX: {
+            __USUB8(a, b);
+            return __SEL(a, b);
+        }
+        case MATHOP_DIFFERENCE: return __UQSUB8(a, b) | __UQSUB8(b, a);
+        default: {
+            if (alpha == 128) {
+                return __UHADD8(a, b);
+            }
+            // Lanes 0 and 2 then 1 and 3 as halfwords, a value times alpha fits in 16 bits.
+            uint32_t p02 = ((a & 0x00FF00FF) * alpha) + ((b & 0x00FF00FF) * (256 - alpha));
+            uint32_t p13 = (((a >> 8) & 0x00FF00FF) * alpha) + (((b >> 8) & 0x00FF00FF) * (256 - alpha));
+            return ((p02 >> 8) & 0x00FF00FF) | (p13 & 0xFF00FF00);
+        }
+    }
+}
+#endif
+
+// n pixels at d, s_step is 1 for the pixels of another image at s, 0 for the scalar word at s.
+// Only the pixels with their bit set in m change, all of them without m.
+static MATHOP_INLINE void mathop_run(int bpp, void *d, const uint8_t *s, int s_step, size_t n,
+                                     const uint32_t *m, mathop_t op, int alpha)
+{
+    switch (bpp) {
+        case IMAGE_BPP_BINARY: {
+            uint32_t *d32 = (uint32_t *) d;
+            for (size_t i = 0, ii = (n + UINT32_T_MASK) >> UINT32_T_SHIFT; i < ii; i++, s += s_step * 4) {
+                uint32_t a = d32[i], r = mathop_binary_word(op, a, __UNALIGNED_UINT32_READ(s), alpha);
+                d32[i] = m ? ((r & m[i]) | (a & ~m[i])) : r;
+            }
+            break;
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            uint8_t *d8 = (uint8_t *) d;
+            size_t x = 0;
+            #if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+            for (; (x + 4) <= n; x += 4, d8 += 4, s += s_step * 4) {
+                uint32_t a = __UNALIGNED_UINT32_READ(d8);
+                uint32_t r = mathop_lanes(op, a, __UNALIGNED_UINT32_READ(s), 0xFFFFFFFF, alpha);
+                if (m) {
+                    uint32_t lanes = IMAGE_MASK_BITS_TO_BYTE_LANES(m[x >> UINT32_T_SHIFT] >> (x & UINT32_T_MASK));
+                    r = (r & lanes) | (a & ~lanes);
+                }
+                __UNALIGNED_UINT32_WRITE(d8, r);
+            }
+            #endif
+            for (; x < n; x++, d8++, s += s_step) {
+                if ((!m) || IMAGE_GET_BINARY_PIXEL_FAST(m, x)) {
+                    *d8 = mathop_pixel(op, *d8, *s, COLOR_GRAYSCALE_MAX, alpha);
+                }
+            }
+            break;
+        }
+        case IMAGE_BPP_RGB565: {
+            uint16_t *d16 = (uint16_t *) d;
+            size_t x = 0;
+            #if defined(ARM_MATH_CM7) || defined(ARM_MATH_CM4)
+            // Blending other than halfway has no byte lane form, it's done per pixel.
+            if ((op != MATHOP_BLEND) || (alpha == 128)) {
+                for (; (x + 2) <= n; x += 2, d16 += 2, s += s_step * 4) {
+                    uint32_t a = __UNALIGNED_UINT32_READ(d16), b = __UNALIGNED_UINT32_READ(s);
+                    uint32_t rb = mathop_lanes(op, MATHOP_RB_LANES(a), MATHOP_RB_LANES(b), 0x1F1F1F1F, alpha);
+                    uint32_t g = mathop_lanes(op, MATHOP_G_LANES(a), MATHOP_G_LANES(b), 0x003F003F, alpha);
+                    uint32_t r = MATHOP_RGB565(rb, g);
+                    if (m) {
+                        uint32_t lanes = IMAGE_MASK_BITS_TO_HALFWORD_LANES(m[x >> UINT32_T_SHIFT] >> (x & UINT32_T_MASK));
+                        r = (r & lanes) | (a & ~lanes);
+                    }
+                    __UNALIGNED_UINT32_WRITE(d16, r);
+                }
+            }
+            #endif
+            for (; x < n; x++, d16++, s += s_step * 2) {
+                if ((!m) || IMAGE_GET_BINARY_PIXEL_FAST(m, x)) {
+                    int a = *d16, b = __UNALIGNED_UINT16_READ(s);
+                    int r = mathop_pixel(op, COLOR_RGB565_TO_R5(a), COLOR_RGB565_TO_R5(b), COLOR_R5_MAX, alpha);
+                    int g = mathop_pixel(op, COLOR_RGB565_TO_G6(a), COLOR_RGB565_TO_G6(b), COLOR_G6_MAX, alpha);
+                    int bl = mathop_pixel(op, COLOR_RGB565_TO_B5(a), COLOR_RGB565_TO_B5(b), COLOR_B5_MAX, alpha);
+                    *d16 = COLOR_R5_G6_B5_TO_RGB565(r, g, bl);
+                }
+            }
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+static MATHOP_INLINE void mathop_in_memory(image_t *img, image_t *other, int scalar, image_t *mask, mathop_t op, int alpha)
+{
+    // The scalar is read as another image that doesn't move.
+    uint32_t scalar_word = imlib_image_operation_scalar(img, scalar);
+    const uint8_t *s = other ? ((uint8_t *) other->data) : ((uint8_t *) &scalar_word);
+    int s_step = other ? 1 : 0;
+
+    if (!mask) {
+        size_t n = (img->bpp == IMAGE_BPP_BINARY) ? (image_size(img) * 8) : (img->w * img->h);
+        if (other) {
+            mathop_run(img->bpp, img->data, s, 1, n, NULL, op, alpha);
+        } else {
+            mathop_run(img->bpp, img->data, s, 0, n, NULL, op, alpha);
+        }
+        return;
+    }
+
+    size_t row_size = (img->bpp == IMAGE_BPP_BINARY) ? IMAGE_BINARY_LINE_LEN_BYTES(img) : (img->w * img->bpp);
+    uint32_t *buf = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img), FB_ALLOC_NO_HINT);
+
+    for (int y = 0, yy = img->h; y < yy; y++, s += row_size * s_step) {
+        const uint32_t *m = image_get_mask_row(mask, img->w, y, buf);
+        mathop_run(img->bpp, img->data + (row_size * y), s, s_step, img->w, m, op, alpha);
+    }
+
+    fb_free();
+}
+
 static void imlib_add_line_op(image_t *img, int line, void *other, void *data, bool vflipped)
 {
     image_t *mask = (image_t *) data;
@@ -298,6 +486,11 @@ static void imlib_add_line_op(image_t *img, int line, void *other, void *data, b
 
 void imlib_add(image_t *img, const char *path, image_t *other, int scalar, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_add");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        mathop_in_memory(img, other, scalar, mask, MATHOP_ADD, 0);
+        return;
+    }
     imlib_image_operation(img, path, other, scalar, imlib_add_line_op, mask);
 }
 
@@ -369,6 +562,15 @@ static void imlib_sub_line_op(image_t *img, int line, void *other, void *data, b
 
 void imlib_sub(image_t *img, const char *path, image_t *other, int scalar, bool reverse, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_sub");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        if (reverse) {
+            mathop_in_memory(img, other, scalar, mask, MATHOP_RSUB, 0);
+        } else {
+            mathop_in_memory(img, other, scalar, mask, MATHOP_SUB, 0);
+        }
+        return;
+    }
     imlib_sub_line_op_state_t state;
     state.reverse = reverse;
     state.mask = mask;
@@ -453,6 +655,7 @@ static void imlib_mul_line_op(image_t *img, int line, void *other, void *data, b
 
 void imlib_mul(image_t *img, const char *path, image_t *other, int scalar, bool invert, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_mul");
     imlib_mul_line_op_state_t state;
     state.invert = invert;
     state.mask = mask;
@@ -543,6 +746,7 @@ static void imlib_div_line_op(image_t *img, int line, void *other, void *data, b
 
 void imlib_div(image_t *img, const char *path, image_t *other, int scalar, bool invert, bool mod, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_div");
     imlib_div_line_op_state_t state;
     state.invert = invert;
     state.mod = mod;
@@ -601,6 +805,11 @@ static void imlib_min_line_op(image_t *img, int line, void *other, void *data, b
 
 void imlib_min(image_t *img, const char *path, image_t *other, int scalar, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_min");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        mathop_in_memory(img, other, scalar, mask, MATHOP_MIN, 0);
+        return;
+    }
     imlib_image_operation(img, path, other, scalar, imlib_min_line_op, mask);
 }
 
@@ -655,6 +864,11 @@ static void imlib_max_line_op(image_t *img, int line, void *other, void *data, b
 
 void imlib_max(image_t *img, const char *path, image_t *other, int scalar, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_max");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        mathop_in_memory(img, other, scalar, mask, MATHOP_MAX, 0);
+        return;
+    }
     imlib_image_operation(img, path, other, scalar, imlib_max_line_op, mask);
 }
 
@@ -709,6 +923,11 @@ static void imlib_difference_line_op(image_t *img, int line, void *other, void *
 
 void imlib_difference(image_t *img, const char *path, image_t *other, int scalar, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_difference");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        mathop_in_memory(img, other, scalar, mask, MATHOP_DIFFERENCE, 0);
+        return;
+    }
     imlib_image_operation(img, path, other, scalar,imlib_difference_line_op,  mask);
 }
 
@@ -769,6 +988,11 @@ static void imlib_blend_line_op(image_t *img, int line, void *other, void *data,
 
 void imlib_blend(image_t *img, const char *path, image_t *other, int scalar, float alpha, image_t *mask)
 {
+    OMV_PROF_SCOPE("imlib_blend");
+    if (imlib_image_operation_in_memory(img, path, other, mask)) {
+        mathop_in_memory(img, other, scalar, mask, MATHOP_BLEND, fast_roundf(IM_MIN(IM_MAX(alpha, 0.0f), 1.0f) * 256));
+        return;
+    }
     imlib_blend_line_op_t state;
     state.alpha = alpha;
     state.mask = mask;
@@ -9,6 +9,8 @@
 #include "fb_alloc.h"
 #include "ff_wrapper.h"
 #include "imlib.h"
+#include "xalloc.h"
+#include "systick.h"
 #define SIZE_OFFSET             (1*4)
 #define MICROS_OFFSET           (8*4)
 #define FRAMES_OFFSET           (12*4)
@@ -16,16 +18,34 @@
 #define LENGTH_0_OFFSET         (21*4)
 #define RATE_1_OFFSET           (33*4)
 #define LENGTH_1_OFFSET         (35*4)
-#define MOVI_OFFSET             (54*4)
+#define HEADER_SIZE             (56*4)
+#define FLAGS_OFFSET            (11*4)
+// OpenDML super index and extended header, in the stream list after strf.
+#define INDX_OFFSET             (53*4)
+#define INDX_SIZE(n)            (32 + ((n) * 16))
+#define ODML_SIZE               (12 + 8 + 248)
+#define DMLH_OFFSET(n)          (INDX_OFFSET + INDX_SIZE(n) + 20)
+#define EXTENDED_SIZE(n)        ((n) ? (INDX_SIZE(n) + ODML_SIZE) : 0)
 
-void mjpeg_open(FIL *fp, int width, int height)
+#define AVIF_HASINDEX           (0x10)
+#define AVIIF_KEYFRAME          (0x10)
+#define AVI_INDEX_OF_INDEXES    (0)
+#define AVI_INDEX_OF_CHUNKS     (1)
+
+// Most segments the super index has room for, and the largest RIFF OpenDML allows.
+#define MJPEG_INDEX_MAX         (256)
+#define MJPEG_SEGMENT_MAX       (1024*1024*1024)
+
+// Writes a header of header_size bytes, padded with a JUNK chunk when larger than needed.
+// index_size super index entries are reserved for OpenDML segments, 0 writes a plain AVI.
+static void mjpeg_write_header(FIL *fp, int width, int height, uint32_t index_size, uint32_t header_size)
 {
     write_data(fp, "RIFF", 4); // FOURCC fcc; - 0
     write_long(fp, 0); // DWORD cb; size - updated on close - 1
     write_data(fp, "AVI ", 4); // FOURCC fcc; - 2
 
     write_data(fp, "LIST", 4); // FOURCC fcc; - 3
-    write_long(fp, 192); // DWORD cb; - 4
+    write_long(fp, 192 + EXTENDED_SIZE(index_size)); // DWORD cb; - 4
     write_data(fp, "hdrl", 4); // FOURCC fcc; - 5
 
     write_data(fp, "avih", 4); // FOURCC fcc; - 6
@@ -33,7 +53,7 @@ void mjpeg_open(FIL *fp, int width, int height)
     write_long(fp, 0); // DWORD dwMicroSecPerFrame; micros - updated on close - 8
     write_long(fp, 0); // DWORD dwMaxBytesPerSec; updated on close - 9
     write_long(fp, 4); // DWORD dwPaddingGranularity; - 10
-    write_long(fp, 0); // DWORD dwFlags; - 11
+    write_long(fp, 0); // DWORD dwFlags; updated once indexed - 11
     write_long(fp, 0); // DWORD dwTotalFrames; frames - updated on close - 12
     write_long(fp, 0); // DWORD dwInitialFrames; - 13
     write_long(fp, 1); // DWORD dwStreams; - 14
@@ -46,7 +66,7 @@ void mjpeg_open(FIL *fp, int width, int height)
     write_long(fp, 0); // DWORD dwLength; length - updated on close - 21
 
     write_data(fp, "LIST", 4); // FOURCC fcc; - 22
-    write_long(fp, 116); // DWORD cb; - 23
+    write_long(fp, 116 + (index_size ? INDX_SIZE(index_size) : 0)); // DWORD cb; - 23
     write_data(fp, "strl", 4); // FOURCC fcc; - 24
 
     write_data(fp, "strh", 4); // FOURCC fcc; - 25
@@ -83,41 +103,44 @@ void mjpeg_open(FIL *fp, int width, int height)
     write_long(fp, 0); // DWORD biClrUsed; - 51
     write_long(fp, 0); // DWORD biClrImportant; - 52
 
+    if (index_size) {
+        write_data(fp, "indx", 4); // FOURCC fcc; - 53
+        write_long(fp, INDX_SIZE(index_size) - 8); // DWORD cb;
+        write_word(fp, 4); // WORD wLongsPerEntry;
+        write_data(fp, (uint8_t [2]){0, AVI_INDEX_OF_INDEXES}, 2); // BYTE bIndexSubType; BYTE bIndexType;
+        write_long(fp, 0); // DWORD nEntriesInUse; updated per segment
+        write_data(fp, "00dc", 4); // DWORD dwChunkId;
+        for (uint32_t i = 0; i < (3 + (index_size * 4)); i++) {
+            write_long(fp, 0); // DWORD dwReserved[3]; entries - updated per segment
+        }
+
+        write_data(fp, "LIST", 4); // FOURCC fcc;
+        write_long(fp, ODML_SIZE - 8); // DWORD cb;
+        write_data(fp, "odml", 4); // FOURCC fcc;
+        write_data(fp, "dmlh", 4); // FOURCC fcc;
+        write_long(fp, 248); // DWORD cb;
+        for (uint32_t i = 0; i < 62; i++) {
+            write_long(fp, 0); // DWORD dwTotalFrames; frames - updated per segment
+        }
+    }
+
+    uint32_t size = HEADER_SIZE + EXTENDED_SIZE(index_size);
+    if (header_size > size) {
+        write_data(fp, "JUNK", 4); // FOURCC fcc;
+        write_long(fp, header_size - size - 8); // DWORD cb;
+        for (uint32_t i = 0; i < (header_size - size - 8); i += 4) {
+            write_long(fp, 0);
+        }
+    }
+
     write_data(fp, "LIST", 4); // FOURCC fcc; - 53
     write_long(fp, 0); // DWORD cb; movi - updated on close - 54
     write_data(fp, "movi", 4); // FOURCC fcc; - 55
 }
 
-void mjpeg_add_frame(FIL *fp, uint32_t *frames, uint32_t *bytes, image_t *img, int quality)
+// Writes the frame rate and the lengths, which are only known for sure once recording stops.
+static void mjpeg_write_rates(FIL *fp, uint32_t *frames, uint32_t *bytes, float fps)
 {
-    write_data(fp, "00dc", 4); // FOURCC fcc;
-    *frames += 1;
-    if (IM_IS_JPEG(img)) {
-        int pad = (((img->bpp + 3) / 4) * 4) - img->bpp;
-        write_long(fp, img->bpp + pad); // DWORD cb;
-        write_data(fp, img->pixels, img->bpp + pad); // reading past okay
-        *bytes += img->bpp + pad;
-    } else {
-        uint32_t size;
-        uint8_t *buffer = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE);
-        image_t out = { .w=img->w, .h=img->h, .bpp=size, .pixels=buffer };
-        // When jpeg_compress needs more memory than in currently allocated it
-        // will try to realloc. MP will detect that the pointer is outside of
-        // the heap and return NULL which will cause an out of memory error.
-        jpeg_compress(img, &out, quality, true);
-        int pad = (((out.bpp + 3) / 4) * 4) - out.bpp;
-        write_long(fp, out.bpp + pad); // DWORD cb;
-        write_data(fp, out.pixels, out.bpp + pad); // reading past okay
-        *bytes += out.bpp + pad;
-        fb_free();
-    }
-}
-
-void mjpeg_close(FIL *fp, uint32_t *frames, uint32_t *bytes, float fps)
-{
-    // Needed
-    file_seek(fp, SIZE_OFFSET);
-    write_long(fp, 216 + (*frames * 8) + *bytes);
     // Needed
     file_seek(fp, MICROS_OFFSET);
     write_long(fp, (!fast_roundf(fps)) ? 0 :
@@ -141,8 +164,502 @@ void mjpeg_close(FIL *fp, uint32_t *frames, uint32_t *bytes, float fps)
     file_seek(fp, LENGTH_1_OFFSET);
     write_long(fp, (!fast_roundf(fps)) ? 0 :
             fast_roundf((*frames * 1000) / fps));
+}
+
+// Starts a RIFF AVIX segment, the first segment is the RIFF AVI with the header.
+static void mjpeg_begin_segment(mjpeg_t *mjpeg)
+{
+    mjpeg->riff = f_tell(&mjpeg->fp);
+    write_data(&mjpeg->fp, "RIFF", 4); // FOURCC fcc;
+    write_long(&mjpeg->fp, 0); // DWORD cb; size - updated when the segment ends
+    write_data(&mjpeg->fp, "AVIX", 4); // FOURCC fcc;
+    write_data(&mjpeg->fp, "LIST", 4); // FOURCC fcc;
+    write_long(&mjpeg->fp, 0); // DWORD cb; movi - updated when the segment ends
+    write_data(&mjpeg->fp, "movi", 4); // FOURCC fcc;
+    mjpeg->movi = f_tell(&mjpeg->fp) - 4;
+}
+
+// Indexes the open segment and patches every size the header has up to it, then syncs
+// the file so a recording cut off later still plays up to here.
+static void mjpeg_end_segment(mjpeg_t *mjpeg, float fps)
+{
+    FIL *fp = &mjpeg->fp;
+    uint32_t ix = f_tell(fp), n = mjpeg->index_frames;
+
+    if (mjpeg->index_size) {
+        write_data(fp, "ix00", 4); // FOURCC fcc;
+        write_long(fp, 24 + (n * 8)); // DWORD cb;
+        write_word(fp, 2); // WORD wLongsPerEntry;
+        write_data(fp, (uint8_t [2]){0, AVI_INDEX_OF_CHUNKS}, 2); // BYTE bIndexSubType; BYTE bIndexType;
+        write_long(fp, n); // DWORD nEntriesInUse;
+        write_data(fp, "00dc", 4); // DWORD dwChunkId;
+        write_long(fp, mjpeg->movi); // QWORD qwBaseOffset;
+        write_long(fp, 0);
+        write_long(fp, 0); // DWORD dwReserved;
+        for (uint32_t i = 0, offset = 4; i < n; offset += 8 + mjpeg->index[i++]) {
+            write_long(fp, offset + 8); // DWORD dwOffset; frame data
+            write_long(fp, mjpeg->index[i]); // DWORD dwSize; key frame
+        }
+    }
+
+    uint32_t movi_end = f_tell(fp);
+
+    // Players that only know AVI 1.0 read the first RIFF and its idx1.
+    if (!mjpeg->segments) {
+        write_data(fp, "idx1", 4); // FOURCC fcc;
+        write_long(fp, n * 16); // DWORD cb;
+        for (uint32_t i = 0, offset = 4; i < n; offset += 8 + mjpeg->index[i++]) {
+            write_data(fp, "00dc", 4); // DWORD dwChunkId;
+            write_long(fp, AVIIF_KEYFRAME); // DWORD dwFlags;
+            write_long(fp, offset); // DWORD dwOffset; chunk from movi
+            write_long(fp, mjpeg->index[i]); // DWORD dwSize;
+        }
+        mjpeg->riff_frames = n;
+    }
+
+    uint32_t riff_end = f_tell(fp);
+    file_seek(fp, mjpeg->riff + 4);
+    write_long(fp, riff_end - mjpeg->riff - 8); // DWORD cb; RIFF
+    file_seek(fp, mjpeg->movi - 4);
+    write_long(fp, movi_end - mjpeg->movi); // DWORD cb; movi
+
+    if (mjpeg->index_size) {
+        file_seek(fp, INDX_OFFSET + 12);
+        write_long(fp, mjpeg->segments + 1); // DWORD nEntriesInUse;
+        file_seek(fp, INDX_OFFSET + INDX_SIZE(mjpeg->segments));
+        write_long(fp, ix); // QWORD qwOffset;
+        write_long(fp, 0);
+        write_long(fp, movi_end - ix); // DWORD dwSize;
+        write_long(fp, n); // DWORD dwDuration;
+        file_seek(fp, DMLH_OFFSET(mjpeg->index_size));
+        write_long(fp, mjpeg->frames); // DWORD dwTotalFrames;
+    }
+
+    mjpeg_write_rates(fp, &mjpeg->frames, &mjpeg->bytes, fps);
+    // The main header only counts the frames of the first RIFF.
+    file_seek(fp, FLAGS_OFFSET);
+    write_long(fp, AVIF_HASINDEX); // DWORD dwFlags;
+    write_long(fp, mjpeg->riff_frames); // DWORD dwTotalFrames;
+
+    file_seek(fp, riff_end);
+    file_sync(fp);
+    mjpeg->segments += 1;
+    mjpeg->index_frames = 0;
+}
+
+void mjpeg_open(mjpeg_t *mjpeg, int width, int height, uint32_t segment_size)
+{
+    mjpeg->frames = 0;
+    mjpeg->bytes = 0;
+    mjpeg->segment_size = IM_MIN(segment_size, MJPEG_SEGMENT_MAX);
+    // Enough segments for the largest FAT file.
+    mjpeg->index_size = (!mjpeg->segment_size) ? 0 :
+            IM_MIN((UINT32_MAX / mjpeg->segment_size) + 1, MJPEG_INDEX_MAX);
+    mjpeg->segments = 0;
+    mjpeg->riff_frames = 0;
+    mjpeg->start = systick_current_millis();
+    mjpeg->index = NULL;
+    mjpeg->index_frames = 0;
+    mjpeg->index_alloc = 0;
+
+    mjpeg_write_header(&mjpeg->fp, width, height, mjpeg->index_size,
+            HEADER_SIZE + EXTENDED_SIZE(mjpeg->index_size));
+    mjpeg->riff = 0;
+    mjpeg->movi = f_tell(&mjpeg->fp) - 4;
+}
+
+void mjpeg_add_frame(mjpeg_t *mjpeg, image_t *img, int quality)
+{
+    FIL *fp = &mjpeg->fp;
+
+    // The next segment is only started for a frame, so none is left empty. The last
+    // segment takes whatever does not fit in the super index.
+    if (mjpeg->segment_size && mjpeg->index_frames
+    && ((f_tell(fp) - mjpeg->riff) >= mjpeg->segment_size)
+    && ((mjpeg->segments + 1) < mjpeg->index_size)) {
+        uint32_t elapsed = systick_current_millis() - mjpeg->start;
+        mjpeg_end_segment(mjpeg, (!elapsed) ? 0.0f : ((mjpeg->frames * 1000.0f) / elapsed));
+        mjpeg_begin_segment(mjpeg);
+    }
+
+    if (mjpeg->index_frames == mjpeg->index_alloc) {
+        mjpeg->index_alloc = IM_MAX(mjpeg->index_alloc * 2, 256);
+        mjpeg->index = xrealloc(mjpeg->index, mjpeg->index_alloc * sizeof(uint32_t));
+    }
+
+    write_data(fp, "00dc", 4); // FOURCC fcc;
+    uint32_t size;
+    if (IM_IS_JPEG(img)) {
+        int pad = (((img->bpp + 3) / 4) * 4) - img->bpp;
+        write_long(fp, img->bpp + pad); // DWORD cb;
+        write_data(fp, img->pixels, img->bpp + pad); // reading past okay
+        size = img->bpp + pad;
+    } else {
+        // The frame is written as it is encoded, the chunk size is patched afterwards.
+        uint32_t size_offset = f_tell(fp);
+        write_long(fp, 0); // DWORD cb; - updated below
+        uint8_t *buffer = fb_alloc(JPEG_SINK_BUF_SIZE, FB_ALLOC_NO_HINT);
+        image_t out = { .w=img->w, .h=img->h, .bpp=JPEG_SINK_BUF_SIZE, .pixels=buffer };
+        jpeg_compress_sink(img, &out, quality, jpeg_file_sink, fp);
+        int pad = (((out.bpp + 3) / 4) * 4) - out.bpp;
+        write_data(fp, (uint8_t [4]){0, 0, 0, 0}, pad);
+        uint32_t end_offset = f_tell(fp);
+        file_seek(fp, size_offset);
+        write_long(fp, out.bpp + pad); // DWORD cb;
+        file_seek(fp, end_offset);
+        size = out.bpp + pad;
+        fb_free();
+    }
+
+    mjpeg->index[mjpeg->index_frames++] = size;
+    mjpeg->frames += 1;
+    mjpeg->bytes += size;
+}
+
+void mjpeg_close(mjpeg_t *mjpeg, float fps)
+{
+    mjpeg_end_segment(mjpeg, fps);
+    file_close(&mjpeg->fp);
+    xfree(mjpeg->index);
+    mjpeg->index = NULL;
+}
+
+#ifdef IMLIB_ENABLE_MJPEG_RECORDER
+#include <mp.h>
+#include "sdcard.h"
+#ifdef MICROPY_PY_RTTHREAD
+#include "rtthread.h"
+#endif
+
+#define REC_SECTOR_SIZE         (512)
+// The header fills the first sector so frames are written in whole sectors.
+#define REC_HEADER_SIZE         (REC_SECTOR_SIZE)
+// Most the idle loop writes in one go.
+#define REC_POLL_SIZE           (32*REC_SECTOR_SIZE)
+
+#ifdef MICROPY_PY_RTTHREAD
+#define REC_THREAD_STACK_SIZE   (2048)
+#define REC_THREAD_TICKS        (5)
+#endif
+
+struct mjpeg_rec {
+    FIL fp;
+    uint32_t frames;
+    uint32_t bytes;
+    uint8_t *ring;
+    uint32_t ring_size;
+    uint32_t wr;            // end of the frame being added
+    volatile uint32_t head; // end of the last added frame
+    volatile uint32_t tail; // end of what is on the card
+    uint32_t file_size;     // preallocated, 0 if none
+    uint32_t sector;        // card sector of the preallocated file, 0 to write through FatFS
+    volatile bool error;
+    #ifdef MICROPY_PY_RTTHREAD
+    rt_thread_t thread;
+    rt_sem_t wake, done;
+    volatile bool stop;
+    #endif
+};
+
+static void mjpeg_write_trailer(FIL *fp, uint32_t *frames, uint32_t *bytes, float fps, uint32_t header_size)
+{
     // Needed
-    file_seek(fp, MOVI_OFFSET);
+    file_seek(fp, SIZE_OFFSET);
+    write_long(fp, (header_size - 8) + (*frames * 8) + *bytes);
+    mjpeg_write_rates(fp, frames, bytes, fps);
+    // Needed
+    file_seek(fp, header_size - 8);
     write_long(fp, 4 + (*frames * 8) + *bytes);
     file_close(fp);
 }
+
+// Moves the stream between tail and head to the card, max_size bytes at most. Only whole
+// sectors are written unless all is set, which is done once at the end.
+static bool mjpeg_rec_write(mjpeg_rec_t *rec, uint32_t max_size, bool all)
+{
+    uint32_t head = rec->head, tail = rec->tail;
+
+    while ((head != tail) && max_size) {
+        uint32_t offset = tail % rec->ring_size;
+        uint32_t size = IM_MIN(IM_MIN(head - tail, rec->ring_size - offset), max_size);
+        if (!all) {
+            size -= size % REC_SECTOR_SIZE;
+        }
+        if (!size) {
+            break;
+        }
+
+        if (rec->sector) {
+            // The tail of the last sector is past the end of the file once it is truncated.
+            uint32_t sector = rec->sector + ((REC_HEADER_SIZE + tail) / REC_SECTOR_SIZE);
+            uint32_t count = (size + REC_SECTOR_SIZE - 1) / REC_SECTOR_SIZE;
+            if (sdcard_write_blocks(rec->ring + offset, sector, count) != 0) {
+                return false;
+            }
+        } else {
+            UINT written;
+            if ((f_write(&rec->fp, rec->ring + offset, size, &written) != FR_OK) || (written != size)) {
+                return false;
+            }
+        }
+
+        tail += size;
+        max_size -= size;
+        rec->tail = tail;
+    }
+
+    return true;
+}
+
+#ifdef MICROPY_PY_RTTHREAD
+static void mjpeg_rec_thread_entry(void *parameter)
+{
+    mjpeg_rec_t *rec = parameter;
+
+    while (!rec->stop) {
+        rt_sem_take(rec->wake, RT_WAITING_FOREVER);
+        if ((!rec->error) && (!mjpeg_rec_write(rec, UINT32_MAX, false))) {
+            rec->error = true;
+        }
+    }
+
+    rt_sem_release(rec->done);
+}
+#endif
+
+static void mjpeg_rec_stop(mjpeg_rec_t *rec)
+{
+    #ifdef MICROPY_PY_RTTHREAD
+    if (rec->thread) {
+        rec->stop = true;
+        rt_sem_release(rec->wake);
+        rt_sem_take(rec->done, RT_WAITING_FOREVER);
+        rt_sem_delete(rec->wake);
+        rt_sem_delete(rec->done);
+        rec->thread = NULL;
+    }
+    #endif
+
+    if (MP_STATE_PORT(mjpeg_rec) == rec) {
+        MP_STATE_PORT(mjpeg_rec) = NULL;
+    }
+}
+
+NORETURN static void mjpeg_rec_fail(mjpeg_rec_t *rec, const char *msg)
+{
+    mjpeg_rec_stop(rec);
+    f_close(&rec->fp);
+    nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, msg));
+}
+
+// Waits until size more bytes fit in the ring behind the frame being added.
+static bool mjpeg_rec_reserve(mjpeg_rec_t *rec, uint32_t size)
+{
+    // The last partial sector of the added frames stays in the ring while it waits.
+    if (((rec->wr - rec->head) + size + REC_SECTOR_SIZE) > rec->ring_size) {
+        return false;
+    }
+
+    while (((rec->wr - rec->tail) + size) > rec->ring_size) {
+        if (rec->error) {
+            return false;
+        }
+        #ifdef MICROPY_PY_RTTHREAD
+        if (rec->thread) {
+            rt_sem_release(rec->wake);
+            rt_thread_delay(1);
+            continue;
+        }
+        #endif
+        if (!mjpeg_rec_write(rec, UINT32_MAX, false)) {
+            rec->error = true;
+        }
+    }
+
+    return true;
+}
+
+static void mjpeg_rec_put(mjpeg_rec_t *rec, uint32_t pos, const uint8_t *data, uint32_t size)
+{
+    while (size) {
+        uint32_t offset = pos % rec->ring_size;
+        uint32_t n = IM_MIN(size, rec->ring_size - offset);
+        memcpy(rec->ring + offset, data, n);
+        pos += n;
+        data += n;
+        size -= n;
+    }
+}
+
+static bool mjpeg_rec_sink(void *arg, const uint8_t *data, int size)
+{
+    mjpeg_rec_t *rec = arg;
+
+    if (!mjpeg_rec_reserve(rec, size)) {
+        return false;
+    }
+
+    mjpeg_rec_put(rec, rec->wr, data, size);
+    rec->wr += size;
+    return true;
+}
+
+mjpeg_rec_t *mjpeg_rec_open(const char *path, int width, int height, uint32_t buffer_size, uint32_t file_size)
+{
+    if (MP_STATE_PORT(mjpeg_rec)) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "Another recorder is running!"));
+    }
+
+    mjpeg_rec_t *rec = xalloc0(sizeof(mjpeg_rec_t));
+    rec->ring_size = IM_MAX(((buffer_size + REC_SECTOR_SIZE - 1) / REC_SECTOR_SIZE), 8) * REC_SECTOR_SIZE;
+    rec->ring = xalloc(rec->ring_size);
+
+    file_write_open(&rec->fp, path);
+
+    if (file_size) {
+        file_size = ((file_size + REC_SECTOR_SIZE - 1) / REC_SECTOR_SIZE) * REC_SECTOR_SIZE;
+        if (f_expand(&rec->fp, file_size, 1) == FR_OK) {
+            rec->file_size = file_size;
+            // Contiguous clusters on the SD card can be written without FatFS.
+            FATFS *fs = rec->fp.obj.fs;
+            fs_user_mount_t *vfs = fs->drv;
+            if ((vfs->blockdev.flags & MP_BLOCKDEV_FLAG_NATIVE)
+            && (vfs->blockdev.writeblocks[2] == MP_OBJ_FROM_PTR(sdcard_write_blocks))) {
+                rec->sector = fs->database + ((rec->fp.obj.sclust - 2) * fs->csize);
+            }
+        }
+    }
+
+    mjpeg_write_header(&rec->fp, width, height, 0, REC_HEADER_SIZE);
+    file_sync(&rec->fp);
+
+    #ifdef MICROPY_PY_RTTHREAD
+    // Without FatFS in the way a thread can write while the script goes on.
+    if (rec->sector) {
+        rec->wake = rt_sem_create("mjpeg", 0, RT_IPC_FLAG_FIFO);
+        rec->done = rt_sem_create("mjpeg", 0, RT_IPC_FLAG_FIFO);
+        rec->thread = rt_thread_create("mjpeg", mjpeg_rec_thread_entry, rec,
+                REC_THREAD_STACK_SIZE, RT_MAIN_THREAD_PRIORITY, REC_THREAD_TICKS);
+        if (rec->thread) {
+            rt_thread_startup(rec->thread);
+        } else {
+            rt_sem_delete(rec->wake);
+            rt_sem_delete(rec->done);
+        }
+    }
+    #endif
+
+    MP_STATE_PORT(mjpeg_rec) = rec;
+    return rec;
+}
+
+void mjpeg_rec_add_frame(mjpeg_rec_t *rec, image_t *img, int quality)
+{
+    uint32_t start = rec->wr;
+    bool ok = (!rec->error) && mjpeg_rec_sink(rec, (const uint8_t *) "00dc\0\0\0\0", 8);
+
+    if (ok && IM_IS_JPEG(img)) {
+        ok = mjpeg_rec_sink(rec, img->pixels, img->bpp);
+    } else if (ok) {
+        uint8_t *buffer = fb_alloc(JPEG_SINK_BUF_SIZE, FB_ALLOC_NO_HINT);
+        image_t out = { .w=img->w, .h=img->h, .bpp=JPEG_SINK_BUF_SIZE, .pixels=buffer };
+        ok = !jpeg_compress_sink(img, &out, quality, mjpeg_rec_sink, rec);
+        fb_free();
+    }
+
+    uint32_t size = rec->wr - start - 8;
+    int pad = (((size + 3) / 4) * 4) - size;
+    ok = ok && mjpeg_rec_sink(rec, (const uint8_t *) "\0\0\0", pad);
+
+    if (ok && rec->sector && ((REC_HEADER_SIZE + rec->wr) > rec->file_size)) {
+        rec->wr = start;
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "Recording file is full!"));
+    }
+
+    if (!ok) {
+        rec->wr = start;
+        if (rec->error) {
+            mjpeg_rec_fail(rec, "Failed to write requested bytes!");
+        }
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_MemoryError, "Frame does not fit in the recorder buffer!"));
+    }
+
+    size += pad;
+    mjpeg_rec_put(rec, start + 4, (const uint8_t *) &size, 4); // DWORD cb;
+    rec->frames += 1;
+    rec->bytes += size;
+
+    __DMB(); // the frame is in the ring before the writer sees it
+    rec->head = rec->wr;
+
+    #ifdef MICROPY_PY_RTTHREAD
+    if (rec->thread) {
+        rt_sem_release(rec->wake);
+    }
+    #endif
+}
+
+void mjpeg_rec_flush(mjpeg_rec_t *rec)
+{
+    #ifdef MICROPY_PY_RTTHREAD
+    if (rec->thread) {
+        while ((!rec->error) && ((rec->head - rec->tail) >= REC_SECTOR_SIZE)) {
+            rt_sem_release(rec->wake);
+            rt_thread_delay(1);
+        }
+    }
+    #endif
+
+    if ((rec->error) || (!mjpeg_rec_write(rec, UINT32_MAX, false))) {
+        mjpeg_rec_fail(rec, "Failed to write requested bytes!");
+    }
+}
+
+uint32_t mjpeg_rec_size(mjpeg_rec_t *rec)
+{
+    return REC_HEADER_SIZE + rec->head;
+}
+
+void mjpeg_rec_close(mjpeg_rec_t *rec, float fps)
+{
+    mjpeg_rec_stop(rec);
+
+    if ((rec->error) || (!mjpeg_rec_write(rec, UINT32_MAX, true))) {
+        mjpeg_rec_fail(rec, "Failed to write requested bytes!");
+    }
+
+    // Give the unused part of the preallocation back.
+    if (rec->file_size) {
+        file_seek(&rec->fp, REC_HEADER_SIZE + rec->head);
+        file_truncate(&rec->fp);
+    }
+
+    mjpeg_write_trailer(&rec->fp, &rec->frames, &rec->bytes, fps, REC_HEADER_SIZE);
+}
+#endif // IMLIB_ENABLE_MJPEG_RECORDER
+
+void mjpeg_rec_poll()
+{
+    #ifdef IMLIB_ENABLE_MJPEG_RECORDER
+    mjpeg_rec_t *rec = MP_STATE_PORT(mjpeg_rec);
+
+    #ifdef MICROPY_PY_RTTHREAD
+    if (rec && rec->thread) {
+        return;
+    }
+    #endif
+
+    if (rec && (!rec->error) && (!mjpeg_rec_write(rec, REC_POLL_SIZE, false))) {
+        rec->error = true;
+    }
+    #endif
+}
+
+void mjpeg_rec_init0()
+{
+    #ifdef IMLIB_ENABLE_MJPEG_RECORDER
+    if (MP_STATE_PORT(mjpeg_rec)) {
+        mjpeg_rec_stop(MP_STATE_PORT(mjpeg_rec));
+    }
+    #endif
+}
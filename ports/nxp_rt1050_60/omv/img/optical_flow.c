@@ -0,0 +1,301 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Sparse pyramidal Lucas-Kanade optical flow.
+ *
+ * Points are tracked from the previous image to the current one coarse to fine over the
+ * Gaussian pyramid levels (shared with the other detectors through the pyramid cache). At each
+ * level the window around the point in the previous image is sampled once, with its gradients
+ * and the 2x2 structure tensor, and the window in the current image is warped to the estimate
+ * and compared until the update is below 1/100 of a pixel. Windows are sampled with 14 bit
+ * bilinear weights to 5 bit fixed point intensities and all per pixel sums are integers, only
+ * the 2x2 solve is done in float.
+ */
+#include "imlib.h"
+
+#ifdef IMLIB_ENABLE_TRACK_POINTS
+#define LK_W_BITS       (14) // Bilinear weights precision.
+#define LK_I_BITS       (5)  // Sampled intensities precision.
+#define LK_DESCALE(x)   (((x) + (1 << (LK_W_BITS - LK_I_BITS - 1))) >> (LK_W_BITS - LK_I_BITS))
+// Gradients are central differences of the sampled intensities, twice the real gradient.
+#define LK_G_SCALE      (4.0f * (1 << LK_I_BITS) * (1 << LK_I_BITS))
+#define LK_MIN_EIG      (2.0f) // Smallest eigenvalue (per pixel, in gray levels^2) of a trackable window.
+#define LK_EPSILON      (0.01f)
+
+typedef struct lk_window {
+    int r, w; // window radius and size
+    int16_t *ival; // previous image window with a 1 pixel border, (w+2)x(w+2)
+    int16_t *jval; // current image window, wxw
+    int16_t *ix, *iy; // previous image window gradients, wxw
+} lk_window_t;
+
+// Samples a w x h patch with its top left corner at (x, y), the image border is replicated.
+static void lk_sample(image_t *img, float x, float y, int w, int h, int16_t *out)
+{
+    int ix = fast_floorf(x);
+    int iy = fast_floorf(y);
+    float a = x - ix, b = y - iy;
+    int iw00 = fast_roundf((1.0f - a) * (1.0f - b) * (1 << LK_W_BITS));
+    int iw01 = fast_roundf(a * (1.0f - b) * (1 << LK_W_BITS));
+    int iw10 = fast_roundf((1.0f - a) * b * (1 << LK_W_BITS));
+    int iw11 = (1 << LK_W_BITS) - iw00 - iw01 - iw10;
+
+    if ((ix >= 0) && (iy >= 0) && ((ix + w) < img->w) && ((iy + h) < img->h)) {
+        for (int j = 0; j < h; j++) {
+            uint8_t *row0 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, iy + j) + ix;
+            uint8_t *row1 = row0 + img->w;
+
+            for (int i = 0; i < w; i++) {
+                *out++ = LK_DESCALE((row0[i] * iw00) + (row0[i + 1] * iw01) + (row1[i] * iw10) + (row1[i + 1] * iw11));
+            }
+        }
+    } else {
+        for (int j = 0; j < h; j++) {
+            uint8_t *row0 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, IM_MIN(IM_MAX(iy + j, 0), img->h - 1));
+            uint8_t *row1 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, IM_MIN(IM_MAX(iy + j + 1, 0), img->h - 1));
+
+            for (int i = 0; i < w; i++) {
+                int x0 = IM_MIN(IM_MAX(ix + i, 0), img->w - 1);
+                int x1 = IM_MIN(IM_MAX(ix + i + 1, 0), img->w - 1);
+                *out++ = LK_DESCALE((row0[x0] * iw00) + (row0[x1] * iw01) + (row1[x0] * iw10) + (row1[x1] * iw11));
+            }
+        }
+    }
+}
+
+static bool lk_inside(image_t *img, float x, float y)
+{
+    return (x >= 0.0f) && (y >= 0.0f) && (x <= (img->w - 1)) && (y <= (img->h - 1));
+}
+
+// Moves (*nx, *ny) in next to the best match of the window around (px, py) in prev. Returns
+// false if the window is untrackable or its center leaves either image.
+static bool lk_track_level(image_t *prev, image_t *next, lk_window_t *win, int max_iterations,
+                           float px, float py, float *nx, float *ny, float *error)
+{
+    int r = win->r, w = win->w, ws = w + 2;
+
+    if (!lk_inside(prev, px, py)) {
+        return false;
+    }
+
+    lk_sample(prev, px - r - 1, py - r - 1, ws, ws, win->ival);
+
+    int64_t a11 = 0, a12 = 0, a22 = 0;
+
+    for (int j = 0; j < w; j++) {
+        int16_t *row = win->ival + ((j + 1) * ws) + 1;
+        int16_t *ix = win->ix + (j * w);
+        int16_t *iy = win->iy + (j * w);
+
+        for (int i = 0; i < w; i++) {
+            int gx = row[i + 1] - row[i - 1];
+            int gy = row[i + ws] - row[i - ws];
+            ix[i] = gx;
+            iy[i] = gy;
+            a11 += gx * gx;
+            a12 += gx * gy;
+            a22 += gy * gy;
+        }
+    }
+
+    float g11 = a11, g12 = a12, g22 = a22;
+    float det = (g11 * g22) - (g12 * g12);
+    float min_eig = (g11 + g22 - fast_sqrtf(((g11 - g22) * (g11 - g22)) + (4.0f * g12 * g12)))
+                  / (2.0f * w * w * LK_G_SCALE);
+
+    if ((min_eig < LK_MIN_EIG) || (det < 1.0f)) {
+        return false;
+    }
+
+    // The gradients are twice the real ones, which scales the update by 1/2.
+    float inv_det = 2.0f / det;
+    float x = *nx, y = *ny, prev_dx = 0.0f, prev_dy = 0.0f;
+
+    for (int k = 0; k < max_iterations; k++) {
+        if (!lk_inside(next, x, y)) {
+            return false;
+        }
+
+        lk_sample(next, x - r, y - r, w, w, win->jval);
+        int64_t b1 = 0, b2 = 0;
+
+        for (int j = 0; j < w; j++) {
+            int16_t *irow = win->ival + ((j + 1) * ws) + 1;
+            int16_t *jrow = win->jval + (j * w);
+            int16_t *ix = win->ix + (j * w);
+            int16_t *iy = win->iy + (j * w);
+
+            for (int i = 0; i < w; i++) {
+                int diff = jrow[i] - irow[i];
+                b1 += diff * ix[i];
+                b2 += diff * iy[i];
+            }
+        }
+
+        float dx = ((g12 * b2) - (g22 * b1)) * inv_det;
+        float dy = ((g12 * b1) - (g11 * b2)) * inv_det;
+        x += dx;
+        y += dy;
+
+        if (((dx * dx) + (dy * dy)) < (LK_EPSILON * LK_EPSILON)) {
+            break;
+        }
+
+        // Stepping back and forth between two positions, settle in the middle.
+        if (k && (fast_fabsf(dx + prev_dx) < LK_EPSILON) && (fast_fabsf(dy + prev_dy) < LK_EPSILON)) {
+            x -= dx * 0.5f;
+            y -= dy * 0.5f;
+            break;
+        }
+
+        prev_dx = dx;
+        prev_dy = dy;
+    }
+
+    if (!lk_inside(next, x, y)) {
+        return false;
+    }
+
+    if (error) {
+        lk_sample(next, x - r, y - r, w, w, win->jval);
+        uint32_t sum = 0;
+
+        for (int j = 0; j < w; j++) {
+            int16_t *irow = win->ival + ((j + 1) * ws) + 1;
+            int16_t *jrow = win->jval + (j * w);
+
+            for (int i = 0; i < w; i++) {
+                sum += abs(jrow[i] - irow[i]);
+            }
+        }
+
+        *error = sum / (float) (w * w * (1 << LK_I_BITS));
+    }
+
+    *nx = x;
+    *ny = y;
+    return true;
+}
+
+// Fills levels[0..levels_len) with the img pyramid, level i is (w >> i) x (h >> i).
+static void lk_pyramid(image_t *img, image_t *levels, int levels_len)
+{
+    for (int i = 0; i < levels_len; i++) {
+        image_t *level = &levels[i];
+        level->w = img->w >> i;
+        level->h = img->h >> i;
+        level->bpp = IMAGE_BPP_GRAYSCALE;
+
+        image_t *cached = imlib_pyramid_level(img, level->w, level->h);
+
+        if (cached) {
+            level->data = cached->data;
+        } else {
+            level->data = fb_alloc(level->w * level->h, FB_ALLOC_NO_HINT);
+            imlib_pyramid_scale(img, level);
+        }
+    }
+}
+
+static int lk_kpt_comp(const kp_t *kp1, const kp_t *kp2)
+{
+    // Descending order
+    return kp2->score - kp1->score;
+}
+
+void imlib_track_points_corners(list_t *out, image_t *ptr, rectangle_t *roi, int threshold, int max_points,
+                                corner_detector_t corner_detector)
+{
+    OMV_PROF_SCOPE("imlib_track_points_corners");
+    list_init(out, sizeof(track_points_list_lnk_data_t));
+
+    image_t level;
+    lk_pyramid(ptr, &level, 1);
+
+    array_t *kpts;
+    array_alloc(&kpts, xfree);
+
+    #ifdef IMLIB_ENABLE_FAST
+    if (corner_detector == CORNER_FAST) {
+        fast_detect(&level, kpts, threshold, roi);
+    }
+    else
+    #endif
+    {
+        agast_detect(&level, kpts, threshold, roi);
+    }
+
+    array_sort(kpts, (array_comp_t) lk_kpt_comp);
+
+    for (int i = 0, ii = IM_MIN(array_length(kpts), max_points); i < ii; i++) {
+        kp_t *kpt = array_at(kpts, i);
+        track_points_list_lnk_data_t lnk_data;
+        lnk_data.x0 = lnk_data.x1 = kpt->x;
+        lnk_data.y0 = lnk_data.y1 = kpt->y;
+        lnk_data.error = 0.0f;
+        lnk_data.found = true;
+        list_push_back(out, &lnk_data);
+    }
+
+    array_free(kpts);
+}
+
+void imlib_track_points(list_t *points, image_t *ptr, image_t *prev, int window, int levels, int max_iterations)
+{
+    OMV_PROF_SCOPE("imlib_track_points");
+    lk_window_t win;
+    win.r = IM_MAX(window / 2, 1);
+    win.w = (win.r * 2) + 1;
+
+    // Drop the levels too small to hold a window.
+    levels = IM_MAX(IM_MIN(levels, IMLIB_PYRAMID_LEVELS_MAX), 1);
+    while ((levels > 1) && (((ptr->w >> (levels - 1)) < (win.w + 3)) || ((ptr->h >> (levels - 1)) < (win.w + 3)))) {
+        levels -= 1;
+    }
+
+    image_t *prev_levels = fb_alloc(levels * sizeof(image_t), FB_ALLOC_NO_HINT);
+    image_t *next_levels = fb_alloc(levels * sizeof(image_t), FB_ALLOC_NO_HINT);
+    lk_pyramid(prev, prev_levels, levels);
+    lk_pyramid(ptr, next_levels, levels);
+
+    // Freed by the caller along with the pyramid levels not taken from the cache.
+    win.ival = fb_alloc((win.w + 2) * (win.w + 2) * sizeof(int16_t), FB_ALLOC_NO_HINT);
+    win.jval = fb_alloc(win.w * win.w * sizeof(int16_t), FB_ALLOC_NO_HINT);
+    win.ix = fb_alloc(win.w * win.w * sizeof(int16_t), FB_ALLOC_NO_HINT);
+    win.iy = fb_alloc(win.w * win.w * sizeof(int16_t), FB_ALLOC_NO_HINT);
+
+    for (list_lnk_t *it = iterator_start_from_head(points); it; it = iterator_next(it)) {
+        track_points_list_lnk_data_t lnk_data;
+        iterator_get(points, it, &lnk_data);
+
+        // Flow is carried down the levels in the coordinates of each level. A level the
+        // window does not fit in keeps the estimate of the level above it.
+        float dx = 0.0f, dy = 0.0f;
+        lnk_data.found = false;
+
+        for (int i = levels - 1; i >= 0; i--) {
+            float scale = 1.0f / (1 << i);
+            float px = lnk_data.x0 * scale, py = lnk_data.y0 * scale;
+            float nx = px + dx, ny = py + dy;
+
+            if (lk_track_level(&prev_levels[i], &next_levels[i], &win, max_iterations,
+                               px, py, &nx, &ny, i ? NULL : &lnk_data.error)) {
+                dx = nx - px;
+                dy = ny - py;
+                lnk_data.found = !i;
+            }
+
+            if (i) {
+                dx *= 2.0f;
+                dy *= 2.0f;
+            }
+        }
+
+        lnk_data.x1 = lnk_data.x0 + dx;
+        lnk_data.y1 = lnk_data.y0 + dy;
+        iterator_set(points, it, &lnk_data);
+    }
+}
+#endif // IMLIB_ENABLE_TRACK_POINTS
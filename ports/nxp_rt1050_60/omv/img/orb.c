@@ -334,20 +334,6 @@ static int comp_angle(image_t *img, kp_t *kp, float *a, float *b)
     return angle;
 }
 
-static void image_scale(image_t *src, image_t *dst)
-{
-    int x_ratio = (int)((src->w<<16)/dst->w) +1;
-    int y_ratio = (int)((src->h<<16)/dst->h) +1;
-
-	for (int y=0; y<dst->h; y++) {
-        int sy = (y*y_ratio)>>16;
-		for (int x=0; x<dst->w; x++) {
-            int sx = (x*x_ratio)>>16;
-			dst->pixels[y*dst->w+x] = IM_TO_GS_PIXEL(src, sx, sy);
-		}
-	}
-}
-
 array_t *orb_find_keypoints(image_t *img, bool normalized, int threshold,
         float scale_factor, int max_keypoints, corner_detector_t corner_detector, rectangle_t *roi)
 {
@@ -377,12 +363,16 @@ array_t *orb_find_keypoints(image_t *img, bool normalized, int threshold,
             break;
         }
 
-        img_scaled.pixels = fb_alloc(img_scaled.w * img_scaled.h, FB_ALLOC_NO_HINT);
-        // Down scale image
-        image_scale(img, &img_scaled);
+        // Down scale and Gaussian smooth the image before extracting keypoints,
+        // the frame buffer levels are shared with other detectors run on the frame.
+        image_t *level = imlib_pyramid_level(img, img_scaled.w, img_scaled.h);
 
-        // Gaussian smooth the image before extracting keypoints
-        imlib_sepconv3(&img_scaled, kernel_gauss_3, 1.0f/16.0f, 0.0f);
+        if (level) {
+            img_scaled.pixels = level->pixels;
+        } else {
+            img_scaled.pixels = fb_alloc(img_scaled.w * img_scaled.h, FB_ALLOC_NO_HINT);
+            imlib_pyramid_scale(img, &img_scaled);
+        }
 
 		// Find kpts
         #ifdef IMLIB_ENABLE_FAST
@@ -457,7 +447,9 @@ array_t *orb_find_keypoints(image_t *img, bool normalized, int threshold,
         }
 
         // Free current scale
-        fb_free();
+        if (!level) {
+            fb_free();
+        }
 
         if (normalized) {
             break;
@@ -473,44 +465,206 @@ array_t *orb_find_keypoints(image_t *img, bool normalized, int threshold,
 	return kpts;
 }
 
-// This is a modifed popcount that counts every 2 different bits as 1.
-// This is what should actually be used with wta_k == 3 or 4.
-static inline uint32_t popcount(uint32_t i)
+// Descriptor distance, a modified popcount that counts every 2 different bits as 1. This is
+// what should actually be used with wta_k == 3 or 4. The pair bits of four words are added in
+// parallel and the horizontal add is done once per descriptor.
+static inline int desc_dist(const uint8_t *desc1, const uint8_t *desc2)
+{
+    const uint32_t *a = (const uint32_t *) desc1;
+    const uint32_t *b = (const uint32_t *) desc2;
+    uint32_t sum = 0;
+
+    for (int m=0; m<(KDESC_SIZE/4); m+=4) {
+        uint32_t x0 = a[m+0] ^ b[m+0];
+        uint32_t x1 = a[m+1] ^ b[m+1];
+        uint32_t x2 = a[m+2] ^ b[m+2];
+        uint32_t x3 = a[m+3] ^ b[m+3];
+
+        // One bit per different pair.
+        x0 = (x0 | (x0 >> 1)) & 0x55555555;
+        x1 = (x1 | (x1 >> 1)) & 0x55555555;
+        x2 = (x2 | (x2 >> 1)) & 0x55555555;
+        x3 = (x3 | (x3 >> 1)) & 0x55555555;
+
+        // 2-bit fields (max 2) -> 4-bit fields (max 8) -> 8-bit fields (max 16).
+        uint32_t s0 = x0 + x1;
+        uint32_t s1 = x2 + x3;
+        s0 = (s0 & 0x33333333) + ((s0 >> 2) & 0x33333333);
+        s1 = (s1 & 0x33333333) + ((s1 >> 2) & 0x33333333);
+        s0 = s0 + s1;
+        sum += (s0 & 0x0F0F0F0F) + ((s0 >> 4) & 0x0F0F0F0F);
+    }
+
+    // The total is at most 128 so the top byte can't overflow.
+    return (sum * 0x01010101) >> 24;
+}
+
+// Multi-index hash over the descriptors: each descriptor byte (4 pairs) is a substring with its
+// own table of 256 buckets. Two descriptors closer than ORB_INDEX_RADIUS must have at least one
+// identical byte, so the union of the buckets of a query holds every keypoint within the radius,
+// and the nearest two are exact when they are found inside it. Only used on large keypoint sets
+// (e.g. stored object descriptors), the rest of the set is searched when a lookup can't tell.
+#define ORB_INDEX_RADIUS    (KDESC_SIZE)
+#define ORB_INDEX_BUCKETS   (256)
+#define ORB_INDEX_MIN_KPTS  (64)
+
+typedef struct {
+    int size;
+    uint16_t *offsets;  // KDESC_SIZE x (ORB_INDEX_BUCKETS+1) bucket offsets.
+    uint16_t *entries;  // KDESC_SIZE x size keypoint indices sorted by bucket.
+    uint32_t *marks;    // One bit per keypoint, candidates of the current query.
+} orb_index_t;
+
+// Allocates the index in the frame buffer stack, returns false if it doesn't fit.
+static bool orb_index_build(orb_index_t *index, array_t *kpts)
+{
+    int size = array_length(kpts);
+    int marks_size = ((size + 31) / 32) * sizeof(uint32_t);
+    int offsets_size = KDESC_SIZE * (ORB_INDEX_BUCKETS + 1) * sizeof(uint16_t);
+    int entries_size = KDESC_SIZE * size * sizeof(uint16_t);
+
+    if ((size < ORB_INDEX_MIN_KPTS) || (size > UINT16_MAX)
+    || ((int) fb_avail() < (offsets_size + entries_size + marks_size + 64))) {
+        return false;
+    }
+
+    index->size = size;
+    index->offsets = fb_alloc0(offsets_size, FB_ALLOC_NO_HINT);
+    index->entries = fb_alloc(entries_size, FB_ALLOC_NO_HINT);
+    index->marks = fb_alloc(marks_size, FB_ALLOC_NO_HINT);
+
+    // Counting sort of the keypoints on each descriptor byte.
+    for (int i=0; i<size; i++) {
+        kp_t *kp = array_at(kpts, i);
+        for (int p=0; p<KDESC_SIZE; p++) {
+            index->offsets[(p * (ORB_INDEX_BUCKETS + 1)) + kp->desc[p] + 1] += 1;
+        }
+    }
+
+    for (int p=0; p<KDESC_SIZE; p++) {
+        uint16_t *offsets = index->offsets + (p * (ORB_INDEX_BUCKETS + 1));
+        for (int v=0; v<ORB_INDEX_BUCKETS; v++) {
+            offsets[v+1] += offsets[v];
+        }
+    }
+
+    for (int p=0; p<KDESC_SIZE; p++) {
+        uint16_t *offsets = index->offsets + (p * (ORB_INDEX_BUCKETS + 1));
+        uint16_t *entries = index->entries + (p * size);
+        uint16_t fill[ORB_INDEX_BUCKETS];
+        memcpy(fill, offsets, sizeof(fill));
+        for (int i=0; i<size; i++) {
+            kp_t *kp = array_at(kpts, i);
+            entries[fill[kp->desc[p]]++] = i;
+        }
+    }
+
+    return true;
+}
+
+static void orb_index_free(orb_index_t *index)
+{
+    fb_free(); // marks
+    fb_free(); // entries
+    fb_free(); // offsets
+}
+
+typedef struct {
+    kp_t *kp;
+    int index;
+    int dist1;
+    int dist2;
+} orb_match_t;
+
+// Keeps the best two distances, ties go to the lower index like a linear search would.
+static inline void orb_match_update(orb_match_t *m, kp_t *kp2, int i, int dist)
+{
+    if ((dist < m->dist1) || ((dist == m->dist1) && (i < m->index))) {
+        m->kp = kp2;
+        m->index = i;
+        m->dist2 = m->dist1;
+        m->dist1 = dist;
+    } else if (dist < m->dist2) {
+        m->dist2 = dist;
+    }
+}
+
+// Marks the candidates sharing a descriptor byte with desc.
+static void orb_index_query(orb_index_t *index, const uint8_t *desc)
+{
+    memset(index->marks, 0, ((index->size + 31) / 32) * sizeof(uint32_t));
+
+    for (int p=0; p<KDESC_SIZE; p++) {
+        uint16_t *offsets = index->offsets + (p * (ORB_INDEX_BUCKETS + 1)) + desc[p];
+        uint16_t *entries = index->entries + (p * index->size);
+        for (int e=offsets[0], e_end=offsets[1]; e<e_end; e++) {
+            index->marks[entries[e] >> 5] |= 1 << (entries[e] & 31);
+        }
+    }
+}
+
+// Anything left out by a query is at least ORB_INDEX_RADIUS away, the best match must be closer
+// and the second best either closer too or far enough that the ratio test passes regardless.
+static inline bool orb_index_exact(int dist1, int dist2, int threshold)
 {
-     i = i - ((i >> 1) & 0x55555555);
-     i = ((i & 0xAAAAAAAA)>>1) | (i & 0x55555555);
-     i = (i & 0x33333333) + ((i >> 2) & 0x33333333);
-     return (((i + (i >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+    return (dist1 < ORB_INDEX_RADIUS) && ((dist2 < ORB_INDEX_RADIUS)
+        || ((dist1 * 100) < ((threshold + 1) * ORB_INDEX_RADIUS)));
 }
 
-static kp_t *find_best_match(kp_t *kp1, array_t *kpts, int *dist_out1, int *dist_out2, int *index)
+// Searches the candidates sharing a descriptor byte with kp1. Returns false if the keypoints
+// left out could change the result of the ratio test, the caller then searches those too.
+static bool orb_index_match(orb_index_t *index, kp_t *kp1, array_t *kpts, int threshold, orb_match_t *m)
 {
-    kp_t *min_kp=NULL;
-    int min_dist1 = MAX_KP_DIST;
-    int min_dist2 = MAX_KP_DIST;
+    orb_index_query(index, kp1->desc);
+
+    for (int w=0, marks_len=(index->size + 31) / 32; w<marks_len; w++) {
+        for (uint32_t bits=index->marks[w]; bits; bits&=bits-1) {
+            int i = (w * 32) + __CLZ(__RBIT(bits));
+            kp_t *kp2 = array_at(kpts, i);
+
+            if (kp2->matched == 0) {
+                orb_match_update(m, kp2, i, desc_dist(kp1->desc, kp2->desc));
+            }
+        }
+    }
+
+    return orb_index_exact(m->dist1, m->dist2, threshold);
+}
+
+static kp_t *find_best_match(kp_t *kp1, array_t *kpts, orb_index_t *index, int threshold, int *dist_out1, int *dist_out2, int *index_out)
+{
+    orb_match_t m = { .kp = NULL, .index = 0, .dist1 = MAX_KP_DIST, .dist2 = MAX_KP_DIST };
     int kpts_size = array_length(kpts);
 
-    for (int i=0; i<kpts_size; i++) {
-        int dist = 0;
-        kp_t *kp2 = array_at(kpts, i);
+    if (!index || !orb_index_match(index, kp1, kpts, threshold, &m)) {
+        for (int i=0; i<kpts_size; i++) {
+            kp_t *kp2 = array_at(kpts, i);
 
-        if (kp2->matched == 0) {
-            for (int m=0; m<(KDESC_SIZE/4); m++) {
-                dist += popcount(((uint32_t*)(kp1->desc))[m] ^ ((uint32_t*)(kp2->desc))[m]);
+            // Skip the candidates the index already compared.
+            if (index && (index->marks[i >> 5] & (1 << (i & 31)))) {
+                continue;
             }
 
-            if (dist < min_dist1) {
-                *index = i;
-                min_kp = kp2;
-                min_dist2 = min_dist1;
-                min_dist1 = dist;
+            if (kp2->matched == 0) {
+                orb_match_update(&m, kp2, i, desc_dist(kp1->desc, kp2->desc));
             }
         }
     }
 
-    *dist_out1 = min_dist1;
-    *dist_out2 = min_dist2;
-    return min_kp;
+    if (m.kp) {
+        *index_out = m.index;
+    }
+
+    *dist_out1 = m.dist1;
+    *dist_out2 = m.dist2;
+    return m.kp;
+}
+
+// Distance ratio test between the best two matches, min_dist1*100/min_dist2 > threshold
+// without the division (min_dist2 is 0 on duplicate keypoints).
+static inline bool ratio_test_fails(int min_dist1, int min_dist2, int threshold)
+{
+    return (min_dist1 * 100) >= ((threshold + 1) * min_dist2);
 }
 
 int orb_match_keypoints(array_t *kpts1, array_t *kpts2, int *match, int threshold, rectangle_t *r, point_t *c, int *angle)
@@ -523,6 +677,11 @@ int orb_match_keypoints(array_t *kpts1, array_t *kpts2, int *match, int threshol
     r->w = r->h = 0;
     r->x = r->y = 20000;
 
+    // Index the larger sets (i.e. stored object descriptors), small sets are searched linearly.
+    orb_index_t index1_buf, index2_buf;
+    orb_index_t *index1 = orb_index_build(&index1_buf, kpts1) ? &index1_buf : NULL;
+    orb_index_t *index2 = orb_index_build(&index2_buf, kpts2) ? &index2_buf : NULL;
+
     // Match keypoints and find "good matches" This runs 2/3 tests found in the RobustMatcher from the OpenCV programming cookbook.
     // The first test is based on the distance ratio between the two best matches for a feature, to remove ambiguous matches.
     // Second test is the symmetry test (corss-matching) both points in a match must be the best matching feature of each other.
@@ -535,16 +694,16 @@ int orb_match_keypoints(array_t *kpts1, array_t *kpts2, int *match, int threshol
         kp_t *kp1 = array_at(kpts1, i);
 
         // Find the best match in second set
-        min_kp = find_best_match(kp1, kpts2, &min_dist1, &min_dist2, &kp_index2);
+        min_kp = find_best_match(kp1, kpts2, index2, threshold, &min_dist1, &min_dist2, &kp_index2);
         // Test the distance ratio between the best two matches
-        if ((min_dist1*100/min_dist2) > threshold) {
+        if (ratio_test_fails(min_dist1, min_dist2, threshold)) {
             continue;
         }
 
         // Cross-match the keypoint in the first set
-        kp_t *kp2 = find_best_match(min_kp, kpts1, &min_dist1, &min_dist2, &kp_index1);
+        kp_t *kp2 = find_best_match(min_kp, kpts1, index1, threshold, &min_dist1, &min_dist2, &kp_index1);
         // Test the distance ratio between the best two matches
-        if ((min_dist1*100/min_dist2) > threshold) {
+        if (ratio_test_fails(min_dist1, min_dist2, threshold)) {
             continue;
         }
 
@@ -565,6 +724,14 @@ int orb_match_keypoints(array_t *kpts1, array_t *kpts2, int *match, int threshol
         }
     }
 
+    if (index2) {
+        orb_index_free(index2);
+    }
+
+    if (index1) {
+        orb_index_free(index1);
+    }
+
     if (matches == 0) {
         r->x = r->y = 0;
         return 0;
@@ -793,6 +960,223 @@ error:
     return res;
 }
 
+// Descriptor database files: the DESC_ORB_DB type, the capacity and count of the objects, an
+// index of capacity (id, offset) entries and the orb_save_descriptor() records of the objects
+// appended after it. A record is written before the index entry and count that make it part of
+// the database, an append cut short leaves the database as it was.
+int orb_db_append(FIL *fp, array_t *kpts, uint32_t id, uint32_t capacity)
+{
+    UINT bytes;
+    FRESULT res;
+    uint32_t header[3] = { DESC_ORB_DB, capacity, 0 }; // type, capacity, count
+    uint32_t entry[2] = { 0, 0 }; // id, offset
+
+    if (f_size(fp) == 0) {
+        // New database, write the header and an empty index.
+        res = f_write(fp, header, sizeof(header), &bytes);
+        if (res != FR_OK || bytes != sizeof(header)) {
+            goto error;
+        }
+
+        for (int i=0; i<capacity; i++) {
+            res = f_write(fp, entry, sizeof(entry), &bytes);
+            if (res != FR_OK || bytes != sizeof(entry)) {
+                goto error;
+            }
+        }
+    } else {
+        res = f_read(fp, header, sizeof(header), &bytes);
+        if (res != FR_OK || bytes != sizeof(header)) {
+            goto error;
+        }
+    }
+
+    if (header[0] != DESC_ORB_DB) {
+        return ORB_DB_INVALID;
+    }
+
+    if (header[2] >= header[1]) {
+        return ORB_DB_FULL;
+    }
+
+    // Append the record.
+    entry[0] = id;
+    entry[1] = f_size(fp);
+    res = f_lseek(fp, entry[1]);
+    if (res != FR_OK) {
+        goto error;
+    }
+
+    res = orb_save_descriptor(fp, kpts);
+    if (res != FR_OK) {
+        goto error;
+    }
+
+    // Then the index entry and count.
+    res = f_lseek(fp, sizeof(header) + (header[2] * sizeof(entry)));
+    if (res != FR_OK) {
+        goto error;
+    }
+
+    res = f_write(fp, entry, sizeof(entry), &bytes);
+    if (res != FR_OK || bytes != sizeof(entry)) {
+        goto error;
+    }
+
+    header[2] += 1;
+    res = f_lseek(fp, 0);
+    if (res != FR_OK) {
+        goto error;
+    }
+
+    res = f_write(fp, header, sizeof(header), &bytes);
+    if (res != FR_OK || bytes != sizeof(header)) {
+        goto error;
+    }
+
+error:
+    return res;
+}
+
+int orb_db_load(FIL *fp, orb_db_t *db)
+{
+    UINT bytes;
+    FRESULT res;
+    uint32_t header[3], entry[2];
+
+    db->count = 0;
+    array_alloc(&db->kpts, xfree);
+
+    res = f_read(fp, header, sizeof(header), &bytes);
+    if (res != FR_OK || bytes != sizeof(header)) {
+        goto error;
+    }
+
+    if ((header[0] != DESC_ORB_DB) || (header[2] > header[1])) {
+        return ORB_DB_INVALID;
+    }
+
+    db->ids = xalloc(IM_MAX(header[2], 1) * sizeof(uint32_t));
+    db->starts = xalloc((header[2] + 1) * sizeof(int));
+    db->starts[0] = 0;
+
+    for (int i=0; i<header[2]; i++) {
+        res = f_lseek(fp, sizeof(header) + (i * sizeof(entry)));
+        if (res != FR_OK) {
+            goto error;
+        }
+
+        res = f_read(fp, entry, sizeof(entry), &bytes);
+        if (res != FR_OK || bytes != sizeof(entry)) {
+            goto error;
+        }
+
+        res = f_lseek(fp, entry[1]);
+        if (res != FR_OK) {
+            goto error;
+        }
+
+        res = orb_load_descriptor(fp, db->kpts);
+        if (res != FR_OK) {
+            goto error;
+        }
+
+        db->ids[i] = entry[0];
+        db->starts[i + 1] = array_length(db->kpts);
+        db->count = i + 1;
+    }
+
+error:
+    return res;
+}
+
+typedef struct {
+    int object;
+    int dist1;
+    int dist2; // Of the nearest keypoint of another object.
+} orb_db_match_t;
+
+// The ratio test is against the nearest keypoint of another object, keypoints repeated within
+// one object don't make its matches ambiguous.
+static inline void orb_db_match_update(orb_db_match_t *m, int object, int dist)
+{
+    if (dist < m->dist1) {
+        if (object != m->object) {
+            m->dist2 = m->dist1;
+        }
+        m->object = object;
+        m->dist1 = dist;
+    } else if ((object != m->object) && (dist < m->dist2)) {
+        m->dist2 = dist;
+    }
+}
+
+int orb_db_match(orb_db_t *db, array_t *kpts, int threshold, int *votes)
+{
+    int db_size = array_length(db->kpts);
+    int kpts_size = array_length(kpts);
+    int matches = 0;
+
+    memset(votes, 0, db->count * sizeof(int));
+
+    if (!db_size) {
+        return 0;
+    }
+
+    // The object of each database keypoint.
+    uint16_t *objects = fb_alloc(db_size * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+    for (int i=0; i<db->count; i++) {
+        for (int j=db->starts[i]; j<db->starts[i + 1]; j++) {
+            objects[j] = i;
+        }
+    }
+
+    orb_index_t index_buf;
+    orb_index_t *index = orb_index_build(&index_buf, db->kpts) ? &index_buf : NULL;
+
+    for (int i=0; i<kpts_size; i++) {
+        kp_t *kp1 = array_at(kpts, i);
+        orb_db_match_t m = { .object = -1, .dist1 = MAX_KP_DIST, .dist2 = MAX_KP_DIST };
+
+        if (index) {
+            orb_index_query(index, kp1->desc);
+
+            for (int w=0, marks_len=(db_size + 31) / 32; w<marks_len; w++) {
+                for (uint32_t bits=index->marks[w]; bits; bits&=bits-1) {
+                    int j = (w * 32) + __CLZ(__RBIT(bits));
+                    kp_t *kp2 = array_at(db->kpts, j);
+                    orb_db_match_update(&m, objects[j], desc_dist(kp1->desc, kp2->desc));
+                }
+            }
+        }
+
+        if (!index || !orb_index_exact(m.dist1, m.dist2, threshold)) {
+            for (int j=0; j<db_size; j++) {
+                // Skip the candidates the index already compared.
+                if (index && (index->marks[j >> 5] & (1 << (j & 31)))) {
+                    continue;
+                }
+
+                kp_t *kp2 = array_at(db->kpts, j);
+                orb_db_match_update(&m, objects[j], desc_dist(kp1->desc, kp2->desc));
+            }
+        }
+
+        // Each keypoint passing the ratio test votes for the object of its nearest keypoint.
+        if ((m.object >= 0) && !ratio_test_fails(m.dist1, m.dist2, threshold)) {
+            votes[m.object] += 1;
+            matches += 1;
+        }
+    }
+
+    if (index) {
+        orb_index_free(index);
+    }
+
+    fb_free(); // objects
+    return matches;
+}
+
 float orb_cluster_dist(int cx, int cy, void *kp_in)
 {
     float sum=0.0f;
@@ -120,6 +120,7 @@ void imlib_logpolar_int(image_t *dst, image_t *src, rectangle_t *roi, bool linea
 #if defined(IMLIB_ENABLE_LOGPOLAR) || defined(IMLIB_ENABLE_LINPOLAR)
 void imlib_logpolar(image_t *img, bool linear, bool reverse)
 {
+    OMV_PROF_SCOPE("imlib_logpolar");
     image_t img_2;
     img_2.w = img->w;
     img_2.h = img->h;
@@ -144,6 +145,7 @@ void imlib_logpolar(image_t *img, bool linear, bool reverse)
 void imlib_phasecorrelate(image_t *img0, image_t *img1, rectangle_t *roi0, rectangle_t *roi1, bool logpolar, bool fix_rotation_scale,
                           float *x_translation, float *y_translation, float *rotation, float *scale, float *response)
 {
+    OMV_PROF_SCOPE("imlib_phasecorrelate");
     // Step 1 - Get Rotation/Scale Differences
     if ((!logpolar) && fix_rotation_scale) {
         fft2d_controller_t fft0, fft1;
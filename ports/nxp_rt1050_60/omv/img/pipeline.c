@@ -0,0 +1,322 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Fused point op / convolution pipeline.
+ *
+ * Calling gamma_corr(), gaussian() and binary() one after the other walks the whole frame once
+ * per call. The pipeline folds each run of point ops into tables (one for binary and grayscale,
+ * one per channel for RGB565 where threshold tests stay per pixel) and streams the frame through
+ * every convolution with a ring of ksize * 2 + 1 lines, so each pixel is loaded and stored once.
+ * Lines are pulled from the last stage: a convolution asks the stage before it for the lines it
+ * needs, down to the source which reads the image. An image line is only overwritten after every
+ * stage is done with it. The result is the same as making the calls one after the other.
+ */
+#include "imlib.h"
+#include "fb_alloc.h"
+
+#ifdef IMLIB_ENABLE_PIPELINE
+typedef struct pipeline_point {
+    const pipeline_op_t *op;    // PIPELINE_BINARY op, NULL for the channel tables.
+    const uint8_t *lut;         // Thresholds table of op, NULL to test each threshold.
+    uint8_t r_lut[COLOR_R5_MAX + 1];
+    uint8_t g_lut[COLOR_G6_MAX + 1];
+    uint8_t b_lut[COLOR_B5_MAX + 1];
+} pipeline_point_t;
+
+typedef struct pipeline_stage {
+    const pipeline_op_t *krn;   // Convolution feeding this stage, NULL for the source.
+    uint8_t *lut;               // Binary/grayscale point ops folded into one table.
+    pipeline_point_t *points;   // RGB565 point ops, consecutive channel ops folded together.
+    int points_len;
+    uint8_t *ring;              // Lines of the previous stage (krn->ksize * 2 + 1).
+    int next;                   // Next line of the previous stage to store in the ring.
+} pipeline_stage_t;
+
+static int pipeline_gamma_corr(const pipeline_op_t *op, int i, int max)
+{
+    float gamma = IM_DIV(1.0, op->gamma);
+    float scale = max;
+    float div = 1 / scale;
+    int p = ((fast_powf(i * div, gamma) * op->contrast) + op->brightness) * scale;
+    return IM_MIN(IM_MAX(p, 0), max);
+}
+
+// Binary and grayscale pixels go through the same table, binary ones are 0 or 1.
+static int pipeline_point_op(const pipeline_op_t *op, int p, int max)
+{
+    switch (op->type) {
+        case PIPELINE_GAMMA_CORR: {
+            return pipeline_gamma_corr(op, p, max);
+        }
+        case PIPELINE_NEGATE: {
+            return max - p;
+        }
+        case PIPELINE_BINARY: {
+            bool bmp = false;
+            for (list_lnk_t *it = iterator_start_from_head(op->thresholds); it; it = iterator_next(it)) {
+                color_thresholds_list_lnk_data_t lnk_data;
+                iterator_get(op->thresholds, it, &lnk_data);
+                bmp |= COLOR_THRESHOLD_GRAYSCALE(p, &lnk_data, op->invert);
+            }
+            return op->zero ? (bmp ? 0 : p) : (bmp * max);
+        }
+        default: {
+            return p;
+        }
+    }
+}
+
+static void pipeline_compile(image_t *img, pipeline_stage_t *stage, const pipeline_op_t *ops, int ops_len, bool *thresholds_lut_used)
+{
+    if (img->bpp != IMAGE_BPP_RGB565) {
+        int max = (img->bpp == IMAGE_BPP_BINARY) ? COLOR_BINARY_MAX : COLOR_GRAYSCALE_MAX;
+        stage->lut = fb_alloc(max + 1, FB_ALLOC_PREFER_SPEED);
+
+        for (int i = 0; i <= max; i++) {
+            int p = i;
+            for (int j = 0; j < ops_len; j++) {
+                p = pipeline_point_op(&ops[j], p, max);
+            }
+            stage->lut[i] = p;
+        }
+        return;
+    }
+
+    stage->points = fb_alloc(ops_len * sizeof(pipeline_point_t), FB_ALLOC_PREFER_SPEED);
+    stage->points_len = 0;
+
+    for (int j = 0; j < ops_len; j++) {
+        // The tables hold the identity until a channel op lands on them.
+        if ((ops[j].type == PIPELINE_BINARY) || (!stage->points_len) || stage->points[stage->points_len - 1].op) {
+            pipeline_point_t *point = &stage->points[stage->points_len++];
+            point->op = NULL;
+            point->lut = NULL;
+            for (int i = 0; i <= COLOR_R5_MAX; i++) point->r_lut[i] = i;
+            for (int i = 0; i <= COLOR_G6_MAX; i++) point->g_lut[i] = i;
+            for (int i = 0; i <= COLOR_B5_MAX; i++) point->b_lut[i] = i;
+        }
+
+        pipeline_point_t *point = &stage->points[stage->points_len - 1];
+
+        if (ops[j].type == PIPELINE_BINARY) {
+            point->op = &ops[j];
+            // There is only one compiled table, the first binary op of the pipeline gets it.
+            if (!*thresholds_lut_used) {
+                point->lut = imlib_thresholds_lut(ops[j].thresholds, ops[j].invert);
+                *thresholds_lut_used = true;
+            }
+        } else {
+            for (int i = 0; i <= COLOR_R5_MAX; i++) point->r_lut[i] = pipeline_point_op(&ops[j], point->r_lut[i], COLOR_R5_MAX);
+            for (int i = 0; i <= COLOR_G6_MAX; i++) point->g_lut[i] = pipeline_point_op(&ops[j], point->g_lut[i], COLOR_G6_MAX);
+            for (int i = 0; i <= COLOR_B5_MAX; i++) point->b_lut[i] = pipeline_point_op(&ops[j], point->b_lut[i], COLOR_B5_MAX);
+        }
+    }
+}
+
+static void pipeline_apply(image_t *img, pipeline_stage_t *stage, void *line)
+{
+    if (img->bpp != IMAGE_BPP_RGB565) {
+        uint8_t *line_ptr = line;
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            line_ptr[x] = stage->lut[line_ptr[x]];
+        }
+        return;
+    }
+
+    uint16_t *line_ptr = line;
+    int binary_max = COLOR_BINARY_TO_RGB565(1);
+    int binary_min = COLOR_BINARY_TO_RGB565(0);
+
+    for (int i = 0; i < stage->points_len; i++) {
+        pipeline_point_t *point = &stage->points[i];
+
+        if (!point->op) {
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                int p = line_ptr[x];
+                line_ptr[x] = COLOR_R5_G6_B5_TO_RGB565(point->r_lut[COLOR_RGB565_TO_R5(p)],
+                                                       point->g_lut[COLOR_RGB565_TO_G6(p)],
+                                                       point->b_lut[COLOR_RGB565_TO_B5(p)]);
+            }
+            continue;
+        }
+
+        const pipeline_op_t *op = point->op;
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            int p = line_ptr[x];
+            bool bmp = false;
+            if (point->lut) {
+                bmp = point->lut[p];
+            } else {
+                for (list_lnk_t *it = iterator_start_from_head(op->thresholds); it; it = iterator_next(it)) {
+                    color_thresholds_list_lnk_data_t lnk_data;
+                    iterator_get(op->thresholds, it, &lnk_data);
+                    bmp |= COLOR_THRESHOLD_RGB565(p, &lnk_data, op->invert);
+                }
+            }
+            line_ptr[x] = op->zero ? (bmp ? 0 : p) : (bmp ? binary_max : binary_min);
+        }
+    }
+}
+
+static void pipeline_convolve(image_t *img, pipeline_stage_t *stage, int y, void *line)
+{
+    const pipeline_op_t *krn = stage->krn;
+    int ksize = krn->ksize, rows = (ksize * 2) + 1;
+
+    if (img->bpp != IMAGE_BPP_RGB565) {
+        int max = (img->bpp == IMAGE_BPP_BINARY) ? COLOR_BINARY_MAX : COLOR_GRAYSCALE_MAX;
+        uint8_t *line_ptr = line;
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            int acc = 0, ptr = 0;
+
+            for (int j = -ksize; j <= ksize; j++) {
+                uint8_t *k_row_ptr = stage->ring + (img->w * (IM_MIN(IM_MAX(y + j, 0), (img->h - 1)) % rows));
+
+                for (int k = -ksize; k <= ksize; k++) {
+                    acc += krn->krn[ptr++] * k_row_ptr[IM_MIN(IM_MAX(x + k, 0), (img->w - 1))];
+                }
+            }
+
+            line_ptr[x] = IM_MAX(IM_MIN(fast_floorf(acc * krn->m) + krn->b, max), 0);
+        }
+        return;
+    }
+
+    uint16_t *line_ptr = line;
+
+    for (int x = 0, xx = img->w; x < xx; x++) {
+        int r_acc = 0, g_acc = 0, b_acc = 0, ptr = 0;
+
+        for (int j = -ksize; j <= ksize; j++) {
+            uint16_t *k_row_ptr = ((uint16_t *) stage->ring) + (img->w * (IM_MIN(IM_MAX(y + j, 0), (img->h - 1)) % rows));
+
+            for (int k = -ksize; k <= ksize; k++) {
+                int pixel = k_row_ptr[IM_MIN(IM_MAX(x + k, 0), (img->w - 1))];
+                r_acc += krn->krn[ptr] * COLOR_RGB565_TO_R5(pixel);
+                g_acc += krn->krn[ptr] * COLOR_RGB565_TO_G6(pixel);
+                b_acc += krn->krn[ptr++] * COLOR_RGB565_TO_B5(pixel);
+            }
+        }
+
+        line_ptr[x] = COLOR_R5_G6_B5_TO_RGB565(IM_MAX(IM_MIN(fast_floorf(r_acc * krn->m) + krn->b, COLOR_R5_MAX), COLOR_R5_MIN),
+                                               IM_MAX(IM_MIN(fast_floorf(g_acc * krn->m) + krn->b, COLOR_G6_MAX), COLOR_G6_MIN),
+                                               IM_MAX(IM_MIN(fast_floorf(b_acc * krn->m) + krn->b, COLOR_B5_MAX), COLOR_B5_MIN));
+    }
+}
+
+// Writes line y of stage s (after its point ops) to line. Lines are asked for in order.
+static void pipeline_line(image_t *img, pipeline_stage_t *stages, int s, int y, void *line)
+{
+    pipeline_stage_t *stage = &stages[s];
+
+    if (!stage->krn) {
+        switch (img->bpp) {
+            case IMAGE_BPP_BINARY: {
+                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+                uint8_t *line_ptr = line;
+                for (int x = 0, xx = img->w; x < xx; x++) {
+                    line_ptr[x] = IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x);
+                }
+                break;
+            }
+            case IMAGE_BPP_GRAYSCALE: {
+                memcpy(line, IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y), IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
+                break;
+            }
+            case IMAGE_BPP_RGB565: {
+                memcpy(line, IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y), IMAGE_RGB565_LINE_LEN_BYTES(img));
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+    } else {
+        int ksize = stage->krn->ksize, rows = (ksize * 2) + 1;
+        size_t line_len = img->w * ((img->bpp == IMAGE_BPP_RGB565) ? sizeof(uint16_t) : sizeof(uint8_t));
+
+        for (int yy = IM_MIN(y + ksize, img->h - 1); stage->next <= yy; stage->next++) {
+            pipeline_line(img, stages, s - 1, stage->next, stage->ring + (line_len * (stage->next % rows)));
+        }
+
+        pipeline_convolve(img, stage, y, line);
+    }
+
+    pipeline_apply(img, stage, line);
+}
+
+void imlib_pipeline(image_t *img, const pipeline_op_t *ops, int ops_len)
+{
+    OMV_PROF_SCOPE("imlib_pipeline");
+    if ((!img->w) || (!img->h)) {
+        return;
+    }
+
+    fb_alloc_mark();
+
+    int stages_len = 1;
+    for (int i = 0; i < ops_len; i++) {
+        if (ops[i].type == PIPELINE_MORPH) {
+            stages_len += 1;
+        }
+    }
+
+    pipeline_stage_t *stages = fb_alloc0(stages_len * sizeof(pipeline_stage_t), FB_ALLOC_NO_HINT);
+    size_t line_len = img->w * ((img->bpp == IMAGE_BPP_RGB565) ? sizeof(uint16_t) : sizeof(uint8_t));
+    bool thresholds_lut_used = false;
+
+    for (int s = 0, i = 0; s < stages_len; s++) {
+        if (s) {
+            stages[s].krn = &ops[i++];
+            stages[s].ring = fb_alloc(line_len * ((stages[s].krn->ksize * 2) + 1), FB_ALLOC_PREFER_SPEED);
+        }
+
+        int j = i;
+        while ((j < ops_len) && (ops[j].type != PIPELINE_MORPH)) {
+            j++;
+        }
+
+        pipeline_compile(img, &stages[s], ops + i, j - i, &thresholds_lut_used);
+        i = j;
+    }
+
+    #if defined(IMLIB_ENABLE_LAB_LUT)
+    if (img->bpp == IMAGE_BPP_RGB565) {
+        OverlaySwitch(OVLY_LAB_TAB);
+    }
+    #endif
+
+    void *line = fb_alloc(line_len, FB_ALLOC_PREFER_SPEED);
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        pipeline_line(img, stages, stages_len - 1, y, line);
+
+        switch (img->bpp) {
+            case IMAGE_BPP_BINARY: {
+                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+                uint8_t *line_ptr = line;
+                for (int x = 0, xx = img->w; x < xx; x++) {
+                    IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x, line_ptr[x]);
+                }
+                break;
+            }
+            case IMAGE_BPP_GRAYSCALE: {
+                memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y), line, IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
+                break;
+            }
+            case IMAGE_BPP_RGB565: {
+                memcpy(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y), line, IMAGE_RGB565_LINE_LEN_BYTES(img));
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+    }
+
+    fb_alloc_free_till_mark();
+}
+#endif // IMLIB_ENABLE_PIPELINE
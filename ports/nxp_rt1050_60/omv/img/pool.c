@@ -11,6 +11,7 @@
 #ifdef IMLIB_ENABLE_MIDPOINT_POOLING
 void imlib_midpoint_pool(image_t *img_i, image_t *img_o, int x_div, int y_div, const int bias)
 {
+    OMV_PROF_SCOPE("imlib_midpoint_pool");
     int min_bias = (256-bias);
     int max_bias = bias;
     switch(img_i->bpp)
@@ -94,6 +95,7 @@ void imlib_midpoint_pool(image_t *img_i, image_t *img_o, int x_div, int y_div, c
 #ifdef IMLIB_ENABLE_MEAN_POOLING
 void imlib_mean_pool(image_t *img_i, image_t *img_o, int x_div, int y_div)
 {
+    OMV_PROF_SCOPE("imlib_mean_pool");
     int n = x_div * y_div;
     switch(img_i->bpp)
     {
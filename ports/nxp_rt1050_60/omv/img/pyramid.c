@@ -0,0 +1,226 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Per frame image pyramid and integral image cache.
+ *
+ * Detectors run one after the other on the same frame used to rebuild the same downscaled
+ * levels and integral images on every call. The cache keeps them on the GC heap, built lazily
+ * the first time a detector asks for them, and drops them when the frame buffer changes:
+ * on snapshot(), when the frame is passed to anything that can modify it and when an image is
+ * copied to the frame buffer. Only the main frame buffer is cached, other images change in
+ * too many ways to track. Every lookup may return NULL (not the frame buffer, no room on the
+ * heap, too many levels); callers then build their own copy in the frame buffer stack.
+ *
+ * Raw Bayer and YUV422 frames also keep their grayscale and RGB565 copies, frame sized but
+ * only filled in for the union of the ROIs asked for so far.
+ */
+#include <mp.h>
+#include "imlib.h"
+#include "xalloc.h"
+#include "framebuffer.h"
+
+#ifdef IMLIB_ENABLE_PYRAMID_CACHE
+typedef struct imlib_pyramid {
+    void *data; // Frame buffer pixels the cache was built from, NULL if empty.
+    int w, h, bpp;
+    image_t levels[IMLIB_PYRAMID_LEVELS_MAX];
+    int levels_len;
+    i_image_t sum;
+    i_image_t sumsq;
+    image_t unpacked[2]; // Grayscale and RGB565.
+    rectangle_t unpacked_valid[2];
+} imlib_pyramid_t;
+
+static imlib_pyramid_t *imlib_pyramid_get(image_t *img)
+{
+    if (img->data != MAIN_FB()->pixels) {
+        return NULL;
+    }
+
+    imlib_pyramid_t *pyramid = MP_STATE_PORT(imlib_pyramid);
+
+    if (!pyramid) {
+        pyramid = xalloc_try_alloc(sizeof(imlib_pyramid_t));
+        if (!pyramid) {
+            return NULL;
+        }
+        memset(pyramid, 0, sizeof(imlib_pyramid_t));
+        MP_STATE_PORT(imlib_pyramid) = pyramid;
+    }
+
+    if ((pyramid->data != img->data) || (pyramid->w != img->w) || (pyramid->h != img->h) || (pyramid->bpp != img->bpp)) {
+        imlib_pyramid_invalidate(NULL);
+        pyramid->data = img->data;
+        pyramid->w = img->w;
+        pyramid->h = img->h;
+        pyramid->bpp = img->bpp;
+    }
+
+    return pyramid;
+}
+#endif // IMLIB_ENABLE_PYRAMID_CACHE
+
+void imlib_pyramid_init0()
+{
+    #ifdef IMLIB_ENABLE_PYRAMID_CACHE
+    MP_STATE_PORT(imlib_pyramid) = NULL;
+    #endif
+}
+
+void imlib_pyramid_invalidate(void *data)
+{
+    #ifdef IMLIB_ENABLE_PYRAMID_CACHE
+    imlib_pyramid_t *pyramid = MP_STATE_PORT(imlib_pyramid);
+
+    if ((!pyramid) || (!pyramid->data) || (data && (data != pyramid->data))) {
+        return;
+    }
+
+    for (int i = 0; i < pyramid->levels_len; i++) {
+        xfree(pyramid->levels[i].data);
+    }
+
+    if (pyramid->sum.data) {
+        xfree(pyramid->sum.data);
+    }
+
+    if (pyramid->sumsq.data) {
+        xfree(pyramid->sumsq.data);
+    }
+
+    for (int i = 0; i < 2; i++) {
+        if (pyramid->unpacked[i].data) {
+            xfree(pyramid->unpacked[i].data);
+        }
+    }
+
+    memset(pyramid, 0, sizeof(imlib_pyramid_t));
+    #endif
+}
+
+// Nearest neighbour downscale to a grayscale image followed by a 3x3 Gaussian.
+void imlib_pyramid_scale(image_t *src, image_t *dst)
+{
+    int x_ratio = (int)((src->w<<16)/dst->w) +1;
+    int y_ratio = (int)((src->h<<16)/dst->h) +1;
+
+    for (int y=0; y<dst->h; y++) {
+        int sy = (y*y_ratio)>>16;
+        for (int x=0; x<dst->w; x++) {
+            int sx = (x*x_ratio)>>16;
+            dst->pixels[y*dst->w+x] = IM_TO_GS_PIXEL(src, sx, sy);
+        }
+    }
+
+    imlib_sepconv3(dst, kernel_gauss_3, 1.0f/16.0f, 0.0f);
+}
+
+image_t *imlib_pyramid_level(image_t *img, int w, int h)
+{
+    #ifdef IMLIB_ENABLE_PYRAMID_CACHE
+    imlib_pyramid_t *pyramid = imlib_pyramid_get(img);
+
+    if (!pyramid) {
+        return NULL;
+    }
+
+    for (int i = 0; i < pyramid->levels_len; i++) {
+        if ((pyramid->levels[i].w == w) && (pyramid->levels[i].h == h)) {
+            return &pyramid->levels[i];
+        }
+    }
+
+    if (pyramid->levels_len == IMLIB_PYRAMID_LEVELS_MAX) {
+        return NULL;
+    }
+
+    image_t *level = &pyramid->levels[pyramid->levels_len];
+    level->w = w;
+    level->h = h;
+    level->bpp = IMAGE_BPP_GRAYSCALE;
+    level->data = xalloc_try_alloc(w * h);
+
+    if (!level->data) {
+        return NULL;
+    }
+
+    imlib_pyramid_scale(img, level);
+    pyramid->levels_len += 1;
+    return level;
+    #else
+    return NULL;
+    #endif
+}
+
+i_image_t *imlib_pyramid_integral(image_t *img, bool sq)
+{
+    #ifdef IMLIB_ENABLE_PYRAMID_CACHE
+    imlib_pyramid_t *pyramid = imlib_pyramid_get(img);
+
+    if (!pyramid) {
+        return NULL;
+    }
+
+    i_image_t *sum = sq ? &pyramid->sumsq : &pyramid->sum;
+
+    if (!sum->data) {
+        sum->data = xalloc_try_alloc(img->w * img->h * sizeof(*sum->data));
+        if (!sum->data) {
+            return NULL;
+        }
+        sum->w = img->w;
+        sum->h = img->h;
+
+        if (sq) {
+            imlib_integral_image_sq(img, sum);
+        } else {
+            imlib_integral_image(img, sum);
+        }
+    }
+
+    return sum;
+    #else
+    return NULL;
+    #endif
+}
+
+image_t *imlib_pyramid_unpack(image_t *img, rectangle_t *roi, int bpp)
+{
+    #ifdef IMLIB_ENABLE_PYRAMID_CACHE
+    imlib_pyramid_t *pyramid = imlib_pyramid_get(img);
+
+    if ((!pyramid) || ((img->bpp != IMAGE_BPP_BAYER) && (img->bpp != IMAGE_BPP_YUV422))) {
+        return NULL;
+    }
+
+    image_t *dst = &pyramid->unpacked[bpp - 1];
+    rectangle_t *valid = &pyramid->unpacked_valid[bpp - 1];
+
+    if (!dst->data) {
+        dst->data = xalloc_try_alloc(img->w * img->h * bpp);
+        if (!dst->data) {
+            return NULL;
+        }
+        dst->w = img->w;
+        dst->h = img->h;
+        dst->bpp = bpp;
+        valid->w = 0;
+        valid->h = 0;
+    }
+
+    if ((roi->x < valid->x) || (roi->y < valid->y)
+    || ((roi->x + roi->w) > (valid->x + valid->w)) || ((roi->y + roi->h) > (valid->y + valid->h))) {
+        rectangle_t todo = *roi;
+        if (valid->w && valid->h) {
+            rectangle_united(&todo, valid);
+        }
+        imlib_unpack(dst, img, &todo);
+        *valid = todo;
+    }
+
+    return dst;
+    #else
+    return NULL;
+    #endif
+}
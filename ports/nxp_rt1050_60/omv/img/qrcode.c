@@ -2964,8 +2964,244 @@ const char *quirc_strerror(quirc_decode_error_t err)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void imlib_find_qrcodes(list_t *out, image_t *ptr, rectangle_t *roi)
+// Finder pattern locator. Scans every other row of the roi for the 1:1:3:1:1 run pattern of the
+// finder patterns (thresholded against a moving average like quirc does) and groups the hits into
+// candidates. Returns false when there are less than 3 candidates (no code can be in the image),
+// otherwise crop is set to the bounding box of the candidates plus a quiet zone margin.
+#define QRCODE_LOCATE_Y_STRIDE 2
+#define QRCODE_LOCATE_MAX_CANDIDATES 32
+
+typedef struct qrcode_locate_candidate {
+    int x_min, x_max, y_min, y_max, w, last_y, last_cx;
+} qrcode_locate_candidate_t;
+
+static int qrcode_locate_get_pixel(image_t *ptr, int x, int y)
+{
+    switch(ptr->bpp) {
+        case IMAGE_BPP_BINARY: {
+            return COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL(ptr, x, y));
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            return IMAGE_GET_GRAYSCALE_PIXEL(ptr, x, y);
+        }
+        case IMAGE_BPP_RGB565: {
+            return RGB565_TO_Y_FAST(IMAGE_GET_RGB565_PIXEL(ptr, x, y));
+        }
+        default: {
+            return 0;
+        }
+    }
+}
+
+// Walks the column through a horizontal hit from the middle of the capstone outwards and checks
+// that it crosses the same black, white, black runs vertically. Rules out most of the texture a
+// single row can match.
+static bool qrcode_locate_check_column(image_t *ptr, rectangle_t *roi, int x, int y, int avg, int err, int threshold)
+{
+    int runs[2][3];
+
+    for (int d = 0; d < 2; d++) {
+        int step = d ? 1 : -1;
+        int yy = y;
+
+        for (int i = 0; i < 3; i++) {
+            bool black = !(i & 1);
+            runs[d][i] = 0;
+
+            while ((roi->y <= yy) && (yy < (roi->y + roi->h)) && ((qrcode_locate_get_pixel(ptr, x, yy) < threshold) == black)) {
+                if (++runs[d][i] > ((3 * avg) + err)) {
+                    return false;
+                }
+
+                yy += step;
+            }
+
+            if (!runs[d][i]) {
+                return false;
+            }
+        }
+    }
+
+    int stone = runs[0][0] + runs[1][0] - 1;
+
+    if ((stone < ((3 * avg) - err)) || (stone > ((3 * avg) + err))) {
+        return false;
+    }
+
+    for (int d = 0; d < 2; d++) {
+        for (int i = 1; i < 3; i++) {
+            if ((runs[d][i] < (avg - err)) || (runs[d][i] > (avg + err))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool qrcode_locate(image_t *ptr, rectangle_t *roi, rectangle_t *crop)
+{
+    uint8_t *row = fb_alloc(roi->w, FB_ALLOC_NO_HINT);
+    uint32_t *sum = fb_alloc((roi->w + 1) * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+    qrcode_locate_candidate_t *candidates = fb_alloc(QRCODE_LOCATE_MAX_CANDIDATES * sizeof(qrcode_locate_candidate_t), FB_ALLOC_NO_HINT);
+    int candidates_len = 0;
+    int threshold_s = IM_MAX(roi->w / 16, 1);
+
+    for (int y = roi->y, yy = roi->y + roi->h; (y < yy) && (candidates_len < QRCODE_LOCATE_MAX_CANDIDATES); y += QRCODE_LOCATE_Y_STRIDE) {
+        switch(ptr->bpp) {
+            case IMAGE_BPP_BINARY: {
+                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
+                for (int x = 0; x < roi->w; x++) {
+                    row[x] = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, roi->x + x));
+                }
+                break;
+            }
+            case IMAGE_BPP_GRAYSCALE: {
+                memcpy(row, IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y) + roi->x, roi->w);
+                break;
+            }
+            case IMAGE_BPP_RGB565: {
+                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
+                for (int x = 0; x < roi->w; x++) {
+                    row[x] = RGB565_TO_Y_FAST(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, roi->x + x));
+                }
+                break;
+            }
+            default: {
+                memset(row, 0, roi->w);
+                break;
+            }
+        }
+
+        sum[0] = 0;
+        for (int x = 0; x < roi->w; x++) {
+            sum[x + 1] = sum[x] + row[x];
+        }
+
+        int pb[5] = {0, 0, 0, 0, 0};
+        int run_length = 0, run_count = 0, last_color = 0;
+
+        for (int x = 0; x <= roi->w; x++) {
+            int color = 0;
+
+            if (x < roi->w) {
+                int x0 = IM_MAX(x - threshold_s, 0), x1 = IM_MIN(x + threshold_s + 1, roi->w);
+                // Same threshold as quirc: darker than 95% of the local average is black.
+                color = (row[x] * (x1 - x0) * 100) < ((sum[x1] - sum[x0]) * (100 - THRESHOLD_T));
+            }
+
+            if (x && (color == last_color)) {
+                run_length++;
+                continue;
+            }
+
+            memmove(pb, pb + 1, sizeof(pb[0]) * 4);
+            pb[4] = run_length;
+            run_length = 1;
+            run_count++;
+            last_color = color;
+
+            if ((!color) && (run_count >= 5)) {
+                static const int check[5] = {1, 1, 3, 1, 1};
+                int avg = (pb[0] + pb[1] + pb[3] + pb[4]) / 4;
+                int err = avg * 3 / 4;
+                bool ok = avg > 0;
+
+                for (int i = 0; ok && (i < 5); i++) {
+                    if ((pb[i] < (check[i] * avg - err)) || (pb[i] > (check[i] * avg + err))) {
+                        ok = false;
+                    }
+                }
+
+                int w = pb[0] + pb[1] + pb[2] + pb[3] + pb[4];
+                int cx = roi->x + x - pb[4] - pb[3] - (pb[2] / 2);
+
+                if (ok) {
+                    int x0 = IM_MAX(cx - roi->x - threshold_s, 0), x1 = IM_MIN(cx - roi->x + threshold_s + 1, roi->w);
+                    int threshold = ((sum[x1] - sum[x0]) * (100 - THRESHOLD_T)) / ((x1 - x0) * 100);
+                    ok = qrcode_locate_check_column(ptr, roi, cx, y, avg, err, threshold);
+                }
+
+                if (ok) {
+                    int i = 0;
+
+                    for (; i < candidates_len; i++) {
+                        qrcode_locate_candidate_t *c = &candidates[i];
+                        if (((y - c->last_y) <= (QRCODE_LOCATE_Y_STRIDE * 2)) && (abs(cx - c->last_cx) <= IM_MAX(c->w / 2, 1))) {
+                            c->x_min = IM_MIN(c->x_min, cx - (w / 2));
+                            c->x_max = IM_MAX(c->x_max, cx + (w / 2));
+                            c->y_max = y;
+                            c->w = IM_MAX(c->w, w);
+                            c->last_y = y;
+                            c->last_cx = cx;
+                            break;
+                        }
+                    }
+
+                    if ((i == candidates_len) && (candidates_len < QRCODE_LOCATE_MAX_CANDIDATES)) {
+                        qrcode_locate_candidate_t *c = &candidates[candidates_len++];
+                        c->x_min = cx - (w / 2);
+                        c->x_max = cx + (w / 2);
+                        c->y_min = y;
+                        c->y_max = y;
+                        c->w = w;
+                        c->last_y = y;
+                        c->last_cx = cx;
+                    }
+                }
+            }
+        }
+    }
+
+    bool found = candidates_len >= 3;
+
+    if (found && (candidates_len < QRCODE_LOCATE_MAX_CANDIDATES)) {
+        // Pad each candidate by its width: the rows above and below the capstone plus the quiet zone.
+        int x_min = INT_MAX, y_min = INT_MAX, x_max = INT_MIN, y_max = INT_MIN;
+
+        for (int i = 0; i < candidates_len; i++) {
+            qrcode_locate_candidate_t *c = &candidates[i];
+            x_min = IM_MIN(x_min, c->x_min - c->w);
+            y_min = IM_MIN(y_min, c->y_min - c->w);
+            x_max = IM_MAX(x_max, c->x_max + c->w);
+            y_max = IM_MAX(y_max, c->y_max + c->w);
+        }
+
+        rectangle_t temp;
+        rectangle_init(&temp, x_min, y_min, x_max - x_min + 1, y_max - y_min + 1);
+        rectangle_init(crop, roi->x, roi->y, roi->w, roi->h);
+
+        if (!rectangle_overlap(crop, &temp)) {
+            found = false;
+        } else {
+            rectangle_intersected(crop, &temp);
+        }
+    } else {
+        // Too many candidates to track, decode the whole roi.
+        rectangle_init(crop, roi->x, roi->y, roi->w, roi->h);
+    }
+
+    fb_free();
+    fb_free();
+    fb_free();
+    return found;
+}
+
+void imlib_find_qrcodes(list_t *out, image_t *ptr, rectangle_t *roi_in, bool locate, int max_codes)
 {
+    OMV_PROF_SCOPE("imlib_find_qrcodes");
+    list_init(out, sizeof(find_qrcodes_list_lnk_data_t));
+
+    rectangle_t roi_crop, *roi = roi_in;
+
+    if (locate) {
+        if (!qrcode_locate(ptr, roi_in, &roi_crop)) {
+            return;
+        }
+
+        roi = &roi_crop;
+    }
+
     struct quirc *controller = quirc_new();
     quirc_resize(controller, roi->w, roi->h);
     uint8_t *grayscale_image = quirc_begin(controller, NULL, NULL);
@@ -3007,9 +3243,8 @@ void imlib_find_qrcodes(list_t *out, image_t *ptr, rectangle_t *roi)
     }
 
     quirc_end(controller);
-    list_init(out, sizeof(find_qrcodes_list_lnk_data_t));
 
-    for (int i = 0, j = quirc_count(controller); i < j; i++) {
+    for (int i = 0, j = quirc_count(controller); (i < j) && ((max_codes <= 0) || (list_size(out) < max_codes)); i++) {
         struct quirc_code *code = fb_alloc(sizeof(struct quirc_code), FB_ALLOC_NO_HINT);
         struct quirc_data *data = fb_alloc(sizeof(struct quirc_data), FB_ALLOC_NO_HINT);
         quirc_extract(controller, i, code);
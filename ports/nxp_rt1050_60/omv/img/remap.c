@@ -0,0 +1,81 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Remap table cache.
+ *
+ * lens_corr() and rotation_corr() map every output pixel to a source pixel with float math that
+ * only depends on the image size and the correction parameters, which scripts keep constant from
+ * frame to frame. The cache keeps the last map of each correction on the GC heap as packed source
+ * coordinates and hands it back while the size and the parameters stay the same, so a steady
+ * correction costs one table read per pixel. Every lookup may return NULL (no room on the heap);
+ * callers then compute the map per pixel as before.
+ */
+#include <mp.h>
+#include "imlib.h"
+#include "xalloc.h"
+
+#ifdef IMLIB_ENABLE_REMAP_CACHE
+typedef struct imlib_remap {
+    bool valid;
+    int w, h;
+    int params_len;
+    float params[IMLIB_REMAP_PARAMS_MAX];
+    uint32_t *table;
+} imlib_remap_t;
+#endif // IMLIB_ENABLE_REMAP_CACHE
+
+void imlib_remap_init0()
+{
+    #ifdef IMLIB_ENABLE_REMAP_CACHE
+    for (int i = 0; i < IMLIB_REMAP_TYPES; i++) {
+        MP_STATE_PORT(imlib_remap)[i] = NULL;
+    }
+    #endif
+}
+
+const uint32_t *imlib_remap_table(int type, int w, int h, const float *params, int params_len, imlib_remap_fill_t fill)
+{
+    #ifdef IMLIB_ENABLE_REMAP_CACHE
+    imlib_remap_t *remap = MP_STATE_PORT(imlib_remap)[type];
+
+    if (!remap) {
+        remap = xalloc_try_alloc(sizeof(imlib_remap_t));
+        if (!remap) {
+            return NULL;
+        }
+        memset(remap, 0, sizeof(imlib_remap_t));
+        MP_STATE_PORT(imlib_remap)[type] = remap;
+    }
+
+    if (remap->valid && (remap->w == w) && (remap->h == h) && (remap->params_len == params_len)
+    && (!memcmp(remap->params, params, params_len * sizeof(float)))) {
+        return remap->table;
+    }
+
+    remap->valid = false;
+
+    if (remap->table && ((remap->w * remap->h) != (w * h))) {
+        xfree(remap->table);
+        remap->table = NULL;
+    }
+
+    if (!remap->table) {
+        remap->table = xalloc_try_alloc(w * h * sizeof(uint32_t));
+        if (!remap->table) {
+            return NULL;
+        }
+    }
+
+    fill(remap->table, w, h, params);
+
+    remap->w = w;
+    remap->h = h;
+    remap->params_len = params_len;
+    memcpy(remap->params, params, params_len * sizeof(float));
+    remap->valid = true;
+    return remap->table;
+    #else
+    return NULL;
+    #endif
+}
@@ -33,16 +33,23 @@ typedef struct {
     uni_elt *elts;
 } universe;
 
+// w is the squared RGB888 distance of the two pixels, < (3 * 255 * 255) < 2^18.
 typedef struct {
-    float    w;
+    uint32_t w;
     uint16_t a;
     uint16_t b;
 } edge;
 
+#define EDGE_RADIX_BITS (9)
+#define EDGE_RADIX_SIZE (1 << EDGE_RADIX_BITS)
+#define EDGE_RADIX_MASK (EDGE_RADIX_SIZE - 1)
+
+// Region histograms are 25 bins per channel, normalized to their largest bin in Q15.
+#define HIST_BINS   (75)
+#define HIST_ONE    (1 << 15)
+
 static inline int min (int a, int b) { return (a < b) ? a : b; }
 static inline int max (int a, int b) { return (a > b) ? a : b; }
-static inline float minf (float a, float b) { return (a < b) ? a : b; }
-static inline float maxf (float a, float b) { return (a > b) ? a : b; }
 extern uint32_t rng_randint(uint32_t min, uint32_t max);
 
 static universe *universe_create(int elements)
@@ -104,13 +111,13 @@ static void universe_set_id(universe * this, int x, int id)
     this->elts[x].rank = id;
 }
 
-static inline float color_similarity (float * hist1, float * hist2)
+static inline float color_similarity (uint16_t * hist1, uint16_t * hist2)
 {
-    float sim = 0;
-    for (int i = 0; i < 75; ++i) {
-        sim += minf(hist1[i], hist2[i]);
+    uint32_t sim = 0;
+    for (int i = 0; i < HIST_BINS; ++i) {
+        sim += min(hist1[i], hist2[i]);
     }
-    return sim;
+    return sim / (float) HIST_ONE;
 }
 
 static inline float size_similarity (int a, int b, int size)
@@ -125,9 +132,7 @@ static inline float fill_similarity (region * ra, region * rb, int a, int b, int
     return 1.0f - (width*height - a - b)/size;
 }
 
-static inline float square(float x) { return x*x; };
-
-static inline float diff(image_t *img, int x1, int y1, int x2, int y2)
+static inline uint32_t diff(image_t *img, int x1, int y1, int x2, int y2)
 {
     uint16_t p1 = IMAGE_GET_RGB565_PIXEL(img, x1, y1);
     uint16_t p2 = IMAGE_GET_RGB565_PIXEL(img, x2, y2);
@@ -139,22 +144,39 @@ static inline float diff(image_t *img, int x1, int y1, int x2, int y2)
 
     uint8_t b1  = COLOR_RGB565_TO_B8(p1);
     uint8_t b2  = COLOR_RGB565_TO_B8(p2);
-   // dissimilarity measure between pixels
-   return  sqrtf((r1-r2) * (r1-r2) + (g1-g2) * (g1-g2) + (b1-b2) * (b1-b2));
+   // dissimilarity measure between pixels, squared
+   return  (r1-r2) * (r1-r2) + (g1-g2) * (g1-g2) + (b1-b2) * (b1-b2);
 }
 
-int comp (const void * elem1, const void * elem2) 
+// LSD radix sort of the edges by weight, two passes of EDGE_RADIX_BITS through tmp.
+static void edges_sort(edge *edges, int num_edges)
 {
-    edge *f = (edge*) elem1;
-    edge *s = (edge*) elem2;
-    if (f->w > s->w) return  1;
-    if (f->w < s->w) return -1;
-    return 0;
+    edge *tmp = fb_alloc(num_edges * sizeof(edge), FB_ALLOC_NO_HINT);
+    uint32_t *count = fb_alloc(EDGE_RADIX_SIZE * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+
+    for (int shift = 0; shift < (EDGE_RADIX_BITS * 2); shift += EDGE_RADIX_BITS) {
+        edge *src = shift ? tmp : edges, *dst = shift ? edges : tmp;
+        memset(count, 0, EDGE_RADIX_SIZE * sizeof(uint32_t));
+        for (int i=0; i<num_edges; i++) {
+            count[(src[i].w >> shift) & EDGE_RADIX_MASK]++;
+        }
+        for (int i=0, sum=0; i<EDGE_RADIX_SIZE; i++) {
+            int n = count[i];
+            count[i] = sum;
+            sum += n;
+        }
+        for (int i=0; i<num_edges; i++) {
+            dst[count[(src[i].w >> shift) & EDGE_RADIX_MASK]++] = src[i];
+        }
+    }
+
+    fb_free();
+    fb_free();
 }
 
 static void segment_graph(universe *u, int num_vertices, int num_edges, edge *edges, float c)
 {
-    qsort (edges, num_edges, sizeof(edge), comp);
+    edges_sort(edges, num_edges);
 
     float *threshold = fb_alloc(num_vertices * sizeof(float), FB_ALLOC_NO_HINT);
     for (int i=0; i<num_vertices; i++) {
@@ -166,10 +188,11 @@ static void segment_graph(universe *u, int num_vertices, int num_edges, edge *ed
         int a = universe_find (u, pedge->a);
         int b = universe_find (u, pedge->b);
         if (a != b) {
-            if ((pedge->w <= threshold[a]) && (pedge->w <= threshold[b])) {
+            float w = fast_sqrtf(pedge->w);
+            if ((w <= threshold[a]) && (w <= threshold[b])) {
                 universe_join (u, a, b);
                 a = universe_find (u, a);
-                threshold[a] = pedge->w + THRESHOLD(universe_size (u, a), c);
+                threshold[a] = w + THRESHOLD(universe_size (u, a), c);
             }
         }
     }
@@ -194,6 +217,7 @@ static void image_scale(image_t *src, image_t *dst)
 
 array_t *imlib_selective_search(image_t *src, float t, int min_size, float a1, float a2, float a3)
 {
+    OMV_PROF_SCOPE("imlib_selective_search");
     int i,j;
     int num = 0;
     int width=0, height=0;
@@ -278,25 +302,19 @@ array_t *imlib_selective_search(image_t *src, float t, int min_size, float a1, f
 
     int next_component = 0;
     int   *counts = (int*) fb_alloc0(num_ccs * sizeof(int), FB_ALLOC_NO_HINT);
-    int   *components= (int*) fb_alloc(num_ccs * sizeof(int), FB_ALLOC_NO_HINT);
-    float *histogram = (float*) fb_alloc0(num_ccs * sizeof(float) * 75, FB_ALLOC_NO_HINT);
+    uint16_t *histogram = (uint16_t*) fb_alloc0(num_ccs * sizeof(uint16_t) * HIST_BINS, FB_ALLOC_NO_HINT);
+    // Component of each set root, numbered as the roots are first seen.
+    uint16_t *components = (uint16_t*) fb_alloc(width * height * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+    memset(components, 0xFF, width * height * sizeof(uint16_t));
 
     // Calc histograms
     for (int y=0; y<height; y++) {
         for (int x = 0; x<width; x++) {
-            int component_id = -1;
             int comp = universe_find(u, y * width + x);
-            for (i=0; i<next_component; i++) {
-                if (components[i] == comp) {
-                    component_id = i;
-                    break;
-                }
-            }
-            if (i == next_component) {
-                components[next_component] = comp;
-                component_id = next_component;
-                ++next_component;
+            if (components[comp] == UINT16_MAX) {
+                components[comp] = next_component++;
             }
+            int component_id = components[comp];
             universe_set_id(u, y * width + x, component_id);
             region * r = regions + component_id;
             r->y = min(r->y, y);
@@ -309,21 +327,21 @@ array_t *imlib_selective_search(image_t *src, float t, int min_size, float a1, f
             int g_bin = min(COLOR_RGB565_TO_G8(p), 240)/10;
             int b_bin = min(COLOR_RGB565_TO_B8(p), 240)/10;
 
-            histogram[75*component_id +  0 + r_bin]++;
-            histogram[75*component_id + 25 + g_bin]++;
-            histogram[75*component_id + 50 + b_bin]++;
+            histogram[HIST_BINS*component_id +  0 + r_bin]++;
+            histogram[HIST_BINS*component_id + 25 + g_bin]++;
+            histogram[HIST_BINS*component_id + 50 + b_bin]++;
             counts[component_id]++;
         }
     }
 
     // Normalize histograms
     for (i=0; i<num_ccs; i++) {
-        float max_val = 0;
-        for (j=0; j<75; j++) {
-            max_val = max(max_val, histogram[75*i + j]);
+        uint32_t max_val = 1;
+        for (j=0; j<HIST_BINS; j++) {
+            max_val = max(max_val, histogram[HIST_BINS*i + j]);
         }
-        for (j=0; j<75; j++) {
-            histogram[75*i + j] /= max_val;
+        for (j=0; j<HIST_BINS; j++) {
+            histogram[HIST_BINS*i + j] = (histogram[HIST_BINS*i + j] * HIST_ONE) / max_val;
         }
     }
 
@@ -350,7 +368,7 @@ array_t *imlib_selective_search(image_t *src, float t, int min_size, float a1, f
     float * similarity_table = (float*) fb_alloc(num_ccs * num_ccs * sizeof(float), FB_ALLOC_NO_HINT);
     for (i = 0; i < num_ccs; ++i) {
         for (j = i + 1; j < num_ccs; ++j) {
-            float color_sim = a1 * color_similarity (histogram + 75 * i, histogram + 75 * j);
+            float color_sim = a1 * color_similarity (histogram + HIST_BINS * i, histogram + HIST_BINS * j);
             float size_sim  = a2 * size_similarity (counts[i], counts[j], size);
             float fill_sim  = a3 * fill_similarity (regions + i, regions + j, counts[i], counts[j], size);
             float similarity = color_sim + size_sim + fill_sim;
@@ -404,9 +422,9 @@ array_t *imlib_selective_search(image_t *src, float t, int min_size, float a1, f
         }
 
 
-        for (i=0; i<75; i++) {
-            histogram[75*best_i + i] = (counts[best_i] * histogram[75*best_i + i]
-                    + counts[best_j] * histogram[75*best_j + i])/(counts[best_i] + counts[best_j]);
+        for (i=0; i<HIST_BINS; i++) {
+            histogram[HIST_BINS*best_i + i] = ((uint32_t) counts[best_i] * histogram[HIST_BINS*best_i + i]
+                    + (uint32_t) counts[best_j] * histogram[HIST_BINS*best_j + i])/(counts[best_i] + counts[best_j]);
         }
         counts[best_i] += counts[best_j];
 
@@ -421,7 +439,7 @@ array_t *imlib_selective_search(image_t *src, float t, int min_size, float a1, f
             if (adjacency[best_i * num_ccs + i] == 0) {
                 continue;
             }
-            float color_sim = a1 * color_similarity (histogram + 75 * i, histogram + 75 * best_i);
+            float color_sim = a1 * color_similarity (histogram + HIST_BINS * i, histogram + HIST_BINS * best_i);
             float size_sim  = a2 * size_similarity (counts[i], counts[best_i], size);
             float fill_sim  = a3 * fill_similarity (regions + i, regions + best_i, counts[i], counts[best_i], size);
             float similarity = color_sim + size_sim + fill_sim;
@@ -154,6 +154,7 @@ static void imlib_remove_shadows_line_op(image_t *img, int line, void *other, vo
 
 void imlib_remove_shadows(image_t *img, const char *path, image_t *other, int scalar, bool single)
 {
+    OMV_PROF_SCOPE("imlib_remove_shadows");
     if (!single) {
         imlib_remove_shadows_line_op_state_t state;
 
@@ -368,6 +369,7 @@ extern const float xyz_table[256];
 
 void imlib_chrominvar(image_t *img)
 {
+    OMV_PROF_SCOPE("imlib_chrominvar");
     switch(img->bpp) {
         case IMAGE_BPP_BINARY: {
             break;
@@ -1,3 +1,5 @@
+#include <stdint.h>
+
 const float sin_table[360] = {
      0.000000f,  0.017452f,  0.034899f,  0.052336f,  0.069756f,  0.087156f,  0.104528f,  0.121869f,
      0.139173f,  0.156434f,  0.173648f,  0.190809f,  0.207912f,  0.224951f,  0.241922f,  0.258819f,
@@ -93,3 +95,70 @@ const float cos_table[360] = {
      0.961262f,  0.965926f,  0.970296f,  0.974370f,  0.978148f,  0.981627f,  0.984808f,  0.987688f,
      0.990268f,  0.992546f,  0.994522f,  0.996195f,  0.997564f,  0.998630f,  0.999391f,  0.999848f
 };
+
+// Q15 versions of the tables above (1.0 saturates to 32767).
+const int16_t sin_table_q15[360] = {
+         0,    572,   1144,   1715,   2286,   2856,   3425,   3993,   4560,   5126,   5690,   6252,
+      6813,   7371,   7927,   8481,   9032,   9580,  10126,  10668,  11207,  11743,  12275,  12803,
+     13328,  13848,  14365,  14876,  15384,  15886,  16384,  16877,  17364,  17847,  18324,  18795,
+     19261,  19720,  20174,  20622,  21063,  21498,  21926,  22348,  22763,  23170,  23571,  23965,
+     24351,  24730,  25102,  25466,  25822,  26170,  26510,  26842,  27166,  27482,  27789,  28088,
+     28378,  28660,  28932,  29197,  29452,  29698,  29935,  30163,  30382,  30592,  30792,  30983,
+     31164,  31336,  31499,  31651,  31795,  31928,  32052,  32166,  32270,  32365,  32449,  32524,
+     32588,  32643,  32688,  32723,  32748,  32763,  32767,  32763,  32748,  32723,  32688,  32643,
+     32588,  32524,  32449,  32365,  32270,  32166,  32052,  31928,  31795,  31651,  31499,  31336,
+     31164,  30983,  30792,  30592,  30382,  30163,  29935,  29698,  29452,  29197,  28932,  28660,
+     28378,  28088,  27789,  27482,  27166,  26842,  26510,  26170,  25822,  25466,  25102,  24730,
+     24351,  23965,  23571,  23170,  22763,  22348,  21926,  21498,  21063,  20622,  20174,  19720,
+     19261,  18795,  18324,  17847,  17364,  16877,  16384,  15886,  15384,  14876,  14365,  13848,
+     13328,  12803,  12275,  11743,  11207,  10668,  10126,   9580,   9032,   8481,   7927,   7371,
+      6813,   6252,   5690,   5126,   4560,   3993,   3425,   2856,   2286,   1715,   1144,    572,
+         0,   -572,  -1144,  -1715,  -2286,  -2856,  -3425,  -3993,  -4560,  -5126,  -5690,  -6252,
+     -6813,  -7371,  -7927,  -8481,  -9032,  -9580, -10126, -10668, -11207, -11743, -12275, -12803,
+    -13328, -13848, -14365, -14876, -15384, -15886, -16384, -16877, -17364, -17847, -18324, -18795,
+    -19261, -19720, -20174, -20622, -21063, -21498, -21926, -22348, -22763, -23170, -23571, -23965,
+    -24351, -24730, -25102, -25466, -25822, -26170, -26510, -26842, -27166, -27482, -27789, -28088,
+    -28378, -28660, -28932, -29197, -29452, -29698, -29935, -30163, -30382, -30592, -30792, -30983,
+    -31164, -31336, -31499, -31651, -31795, -31928, -32052, -32166, -32270, -32365, -32449, -32524,
+    -32588, -32643, -32688, -32723, -32748, -32763, -32768, -32763, -32748, -32723, -32688, -32643,
+    -32588, -32524, -32449, -32365, -32270, -32166, -32052, -31928, -31795, -31651, -31499, -31336,
+    -31164, -30983, -30792, -30592, -30382, -30163, -29935, -29698, -29452, -29197, -28932, -28660,
+    -28378, -28088, -27789, -27482, -27166, -26842, -26510, -26170, -25822, -25466, -25102, -24730,
+    -24351, -23965, -23571, -23170, -22763, -22348, -21926, -21498, -21063, -20622, -20174, -19720,
+    -19261, -18795, -18324, -17847, -17364, -16877, -16384, -15886, -15384, -14876, -14365, -13848,
+    -13328, -12803, -12275, -11743, -11207, -10668, -10126,  -9580,  -9032,  -8481,  -7927,  -7371,
+     -6813,  -6252,  -5690,  -5126,  -4560,  -3993,  -3425,  -2856,  -2286,  -1715,  -1144,   -572
+};
+
+const int16_t cos_table_q15[360] = {
+     32767,  32763,  32748,  32723,  32688,  32643,  32588,  32524,  32449,  32365,  32270,  32166,
+     32052,  31928,  31795,  31651,  31499,  31336,  31164,  30983,  30792,  30592,  30382,  30163,
+     29935,  29698,  29452,  29197,  28932,  28660,  28378,  28088,  27789,  27482,  27166,  26842,
+     26510,  26170,  25822,  25466,  25102,  24730,  24351,  23965,  23571,  23170,  22763,  22348,
+     21926,  21498,  21063,  20622,  20174,  19720,  19261,  18795,  18324,  17847,  17364,  16877,
+     16384,  15886,  15384,  14876,  14365,  13848,  13328,  12803,  12275,  11743,  11207,  10668,
+     10126,   9580,   9032,   8481,   7927,   7371,   6813,   6252,   5690,   5126,   4560,   3993,
+      3425,   2856,   2286,   1715,   1144,    572,      0,   -572,  -1144,  -1715,  -2286,  -2856,
+     -3425,  -3993,  -4560,  -5126,  -5690,  -6252,  -6813,  -7371,  -7927,  -8481,  -9032,  -9580,
+    -10126, -10668, -11207, -11743, -12275, -12803, -13328, -13848, -14365, -14876, -15384, -15886,
+    -16384, -16877, -17364, -17847, -18324, -18795, -19261, -19720, -20174, -20622, -21063, -21498,
+    -21926, -22348, -22763, -23170, -23571, -23965, -24351, -24730, -25102, -25466, -25822, -26170,
+    -26510, -26842, -27166, -27482, -27789, -28088, -28378, -28660, -28932, -29197, -29452, -29698,
+    -29935, -30163, -30382, -30592, -30792, -30983, -31164, -31336, -31499, -31651, -31795, -31928,
+    -32052, -32166, -32270, -32365, -32449, -32524, -32588, -32643, -32688, -32723, -32748, -32763,
+    -32768, -32763, -32748, -32723, -32688, -32643, -32588, -32524, -32449, -32365, -32270, -32166,
+    -32052, -31928, -31795, -31651, -31499, -31336, -31164, -30983, -30792, -30592, -30382, -30163,
+    -29935, -29698, -29452, -29197, -28932, -28660, -28378, -28088, -27789, -27482, -27166, -26842,
+    -26510, -26170, -25822, -25466, -25102, -24730, -24351, -23965, -23571, -23170, -22763, -22348,
+    -21926, -21498, -21063, -20622, -20174, -19720, -19261, -18795, -18324, -17847, -17364, -16877,
+    -16384, -15886, -15384, -14876, -14365, -13848, -13328, -12803, -12275, -11743, -11207, -10668,
+    -10126,  -9580,  -9032,  -8481,  -7927,  -7371,  -6813,  -6252,  -5690,  -5126,  -4560,  -3993,
+     -3425,  -2856,  -2286,  -1715,  -1144,   -572,      0,    572,   1144,   1715,   2286,   2856,
+      3425,   3993,   4560,   5126,   5690,   6252,   6813,   7371,   7927,   8481,   9032,   9580,
+     10126,  10668,  11207,  11743,  12275,  12803,  13328,  13848,  14365,  14876,  15384,  15886,
+     16384,  16877,  17364,  17847,  18324,  18795,  19261,  19720,  20174,  20622,  21063,  21498,
+     21926,  22348,  22763,  23170,  23571,  23965,  24351,  24730,  25102,  25466,  25822,  26170,
+     26510,  26842,  27166,  27482,  27789,  28088,  28378,  28660,  28932,  29197,  29452,  29698,
+     29935,  30163,  30382,  30592,  30792,  30983,  31164,  31336,  31499,  31651,  31795,  31928,
+     32052,  32166,  32270,  32365,  32449,  32524,  32588,  32643,  32688,  32723,  32748,  32763
+};
@@ -113,6 +113,7 @@ void imlib_similarity_line_op(image_t *img, int line, void *other, void *data, b
 
 void imlib_get_similarity(image_t *img, const char *path, image_t *other, int scalar, float *avg, float *std, float *min, float *max)
 {
+    OMV_PROF_SCOPE("imlib_get_similarity");
     int h_blocks = (img->w + 7) / 8;
     int v_blocks = (img->h + 7) / 8;
     int blocks = h_blocks * v_blocks;
@@ -146,6 +147,7 @@ void imlib_get_similarity(image_t *img, const char *path, image_t *other, int sc
 
 void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_t *thresholds, bool invert)
 {
+    OMV_PROF_SCOPE("imlib_get_histogram");
     switch(ptr->bpp) {
         case IMAGE_BPP_BINARY: {
             memset(out->LBins, 0, out->LBinCount * sizeof(uint32_t));
@@ -298,8 +300,204 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
     }
 }
 
+// Bin indices of one row of the bounding box. Each pixel gets one index per channel, the L bins
+// first, then the A and B bins, and a weight of how many thresholds it matches (1 without).
+static void imlib_get_histograms_row(image_t *ptr, int y, rectangle_t *bbox,
+                                     color_thresholds_list_lnk_data_t *thresholds, int thresholds_len, bool invert,
+                                     histogram_t *hist, uint16_t *row_bins, uint16_t *row_weights)
+{
+    switch(ptr->bpp) {
+        case IMAGE_BPP_BINARY: {
+            float mult = (hist->LBinCount - 1) / ((float) (COLOR_BINARY_MAX - COLOR_BINARY_MIN));
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
+            for (int x = bbox->x, xx = bbox->x + bbox->w, i = 0; x < xx; x++, i++) {
+                int pixel = IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x);
+                int weight = thresholds_len ? 0 : 1;
+                for (int t = 0; t < thresholds_len; t++) {
+                    weight += COLOR_THRESHOLD_BINARY(pixel, &thresholds[t], invert);
+                }
+                row_weights[i] = weight;
+                row_bins[i] = fast_floorf((pixel - COLOR_BINARY_MIN) * mult);
+            }
+            break;
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            float mult = (hist->LBinCount - 1) / ((float) (COLOR_GRAYSCALE_MAX - COLOR_GRAYSCALE_MIN));
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
+            for (int x = bbox->x, xx = bbox->x + bbox->w, i = 0; x < xx; x++, i++) {
+                int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                int weight = thresholds_len ? 0 : 1;
+                for (int t = 0; t < thresholds_len; t++) {
+                    weight += COLOR_THRESHOLD_GRAYSCALE(pixel, &thresholds[t], invert);
+                }
+                row_weights[i] = weight;
+                row_bins[i] = fast_floorf((pixel - COLOR_GRAYSCALE_MIN) * mult);
+            }
+            break;
+        }
+        case IMAGE_BPP_RGB565: {
+            float l_mult = (hist->LBinCount - 1) / ((float) (COLOR_L_MAX - COLOR_L_MIN));
+            float a_mult = (hist->ABinCount - 1) / ((float) (COLOR_A_MAX - COLOR_A_MIN));
+            float b_mult = (hist->BBinCount - 1) / ((float) (COLOR_B_MAX - COLOR_B_MIN));
+            int a_offset = hist->LBinCount;
+            int b_offset = hist->LBinCount + hist->ABinCount;
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
+            for (int x = bbox->x, xx = bbox->x + bbox->w, i = 0; x < xx; x++, i++) {
+                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+                int weight = thresholds_len ? 0 : 1;
+                for (int t = 0; t < thresholds_len; t++) {
+                    weight += COLOR_THRESHOLD_RGB565(pixel, &thresholds[t], invert);
+                }
+                row_weights[i] = weight;
+                if (weight) {
+                    row_bins[(i * 3) + 0] = fast_floorf((COLOR_RGB565_TO_L(pixel) - COLOR_L_MIN) * l_mult);
+                    row_bins[(i * 3) + 1] = fast_floorf((COLOR_RGB565_TO_A(pixel) - COLOR_A_MIN) * a_mult) + a_offset;
+                    row_bins[(i * 3) + 2] = fast_floorf((COLOR_RGB565_TO_B(pixel) - COLOR_B_MIN) * b_mult) + b_offset;
+                }
+            }
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+// Histograms of several ROIs in one raster pass over their bounding box, the same result as
+// calling imlib_get_histogram() on each. Pixels are converted and thresholded once however many
+// ROIs cover them. With integral set the pass builds an integral histogram of the bounding box
+// instead (if it fits) and each ROI histogram is then 4 lookups per bin whatever its size, this
+// only pays off with few bins and large overlapping ROIs. out holds rois_len histograms with the
+// same bin counts, the ROIs must be clipped to the image.
+void imlib_get_histograms(histogram_t *out, image_t *ptr, rectangle_t *rois, int rois_len, list_t *thresholds, bool invert, bool integral)
+{
+    OMV_PROF_SCOPE("imlib_get_histograms");
+    int channels = (ptr->bpp == IMAGE_BPP_RGB565) ? 3 : 1;
+    int bins_len = out->LBinCount + ((channels == 3) ? (out->ABinCount + out->BBinCount) : 0);
+
+    rectangle_t bbox;
+    rectangle_copy(&bbox, &rois[0]);
+    for (int i = 1; i < rois_len; i++) {
+        rectangle_united(&bbox, &rois[i]);
+    }
+
+    int thresholds_len = thresholds ? list_size(thresholds) : 0;
+    color_thresholds_list_lnk_data_t *thresholds_array =
+        fb_alloc((thresholds_len + 1) * sizeof(color_thresholds_list_lnk_data_t), FB_ALLOC_NO_HINT);
+    for (int i = 0; i < thresholds_len; i++) {
+        list_get(thresholds, &thresholds_array[i], i);
+    }
+
+    uint32_t *counts = fb_alloc0(rois_len * bins_len * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+    uint16_t *row_bins = fb_alloc(bbox.w * channels * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+    uint16_t *row_weights = fb_alloc(bbox.w * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+
+    #if defined(IMLIB_ENABLE_LAB_LUT)
+    if (ptr->bpp == IMAGE_BPP_RGB565) {
+        OverlaySwitch(OVLY_LAB_TAB);
+    }
+    #endif
+
+    // One uint32_t per bin per pixel, plus a row and a column of zeros.
+    int integral_w = (bbox.w + 1) * bins_len;
+    int integral_h_max = (((int) (fb_avail() / sizeof(uint32_t))) - bins_len - 64) / integral_w;
+    integral = integral && ((bbox.h + 1) <= integral_h_max);
+
+    if (integral) {
+        uint32_t *sums = fb_alloc0((bbox.h + 1) * integral_w * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+        uint32_t *row_sums = fb_alloc(bins_len * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+
+        for (int y = 0; y < bbox.h; y++) {
+            uint32_t *above = sums + (y * integral_w) + bins_len;
+            uint32_t *row = above + integral_w;
+            memset(row_sums, 0, bins_len * sizeof(uint32_t));
+            imlib_get_histograms_row(ptr, bbox.y + y, &bbox, thresholds_array, thresholds_len, invert,
+                                     out, row_bins, row_weights);
+
+            for (int x = 0; x < bbox.w; x++, above += bins_len, row += bins_len) {
+                for (int c = 0; c < channels; c++) {
+                    row_sums[row_bins[(x * channels) + c]] += row_weights[x];
+                }
+                for (int b = 0; b < bins_len; b++) {
+                    row[b] = above[b] + row_sums[b];
+                }
+            }
+        }
+
+        for (int i = 0; i < rois_len; i++) {
+            int x0 = rois[i].x - bbox.x, x1 = x0 + rois[i].w;
+            int y0 = rois[i].y - bbox.y, y1 = y0 + rois[i].h;
+            uint32_t *tl = sums + (y0 * integral_w) + (x0 * bins_len);
+            uint32_t *tr = sums + (y0 * integral_w) + (x1 * bins_len);
+            uint32_t *bl = sums + (y1 * integral_w) + (x0 * bins_len);
+            uint32_t *br = sums + (y1 * integral_w) + (x1 * bins_len);
+            uint32_t *roi_counts = counts + (i * bins_len);
+            for (int b = 0; b < bins_len; b++) {
+                roi_counts[b] = br[b] - bl[b] - tr[b] + tl[b];
+            }
+        }
+
+        fb_free(); // row_sums
+        fb_free(); // sums
+    } else {
+        for (int y = bbox.y, yy = bbox.y + bbox.h; y < yy; y++) {
+            imlib_get_histograms_row(ptr, y, &bbox, thresholds_array, thresholds_len, invert,
+                                     out, row_bins, row_weights);
+
+            for (int i = 0; i < rois_len; i++) {
+                if ((y < rois[i].y) || ((rois[i].y + rois[i].h) <= y)) {
+                    continue;
+                }
+
+                uint32_t *roi_counts = counts + (i * bins_len);
+                for (int x = rois[i].x - bbox.x, xx = x + rois[i].w; x < xx; x++) {
+                    int weight = row_weights[x];
+                    if (weight) {
+                        for (int c = 0; c < channels; c++) {
+                            roi_counts[row_bins[(x * channels) + c]] += weight;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Every counted pixel is in exactly one L bin.
+    for (int i = 0; i < rois_len; i++) {
+        uint32_t *roi_counts = counts + (i * bins_len);
+        uint32_t pixel_count = 0;
+
+        for (int b = 0; b < out[i].LBinCount; b++) {
+            pixel_count += roi_counts[b];
+        }
+
+        float pixels = IM_DIV(1, ((float) pixel_count));
+
+        for (int b = 0; b < out[i].LBinCount; b++) {
+            out[i].LBins[b] = roi_counts[b] * pixels;
+        }
+
+        if (channels == 3) {
+            for (int b = 0; b < out[i].ABinCount; b++) {
+                out[i].ABins[b] = roi_counts[out[i].LBinCount + b] * pixels;
+            }
+
+            for (int b = 0; b < out[i].BBinCount; b++) {
+                out[i].BBins[b] = roi_counts[out[i].LBinCount + out[i].ABinCount + b] * pixels;
+            }
+        }
+    }
+
+    fb_free(); // row_weights
+    fb_free(); // row_bins
+    fb_free(); // counts
+    fb_free(); // thresholds_array
+}
+
+
 void imlib_get_percentile(percentile_t *out, image_bpp_t bpp, histogram_t *ptr, float percentile)
 {
+    OMV_PROF_SCOPE("imlib_get_percentile");
     memset(out, 0, sizeof(percentile_t));
     switch(bpp) {
         case IMAGE_BPP_BINARY: {
@@ -414,6 +612,7 @@ static int ostu(int bincount, float *bins)
 
 void imlib_get_threshold(threshold_t *out, image_bpp_t bpp, histogram_t *ptr)
 {
+    OMV_PROF_SCOPE("imlib_get_threshold");
     memset(out, 0, sizeof(threshold_t));
     switch(bpp) {
         case IMAGE_BPP_BINARY: {
@@ -438,6 +637,7 @@ void imlib_get_threshold(threshold_t *out, image_bpp_t bpp, histogram_t *ptr)
 
 void imlib_get_statistics(statistics_t *out, image_bpp_t bpp, histogram_t *ptr)
 {
+    OMV_PROF_SCOPE("imlib_get_statistics");
     memset(out, 0, sizeof(statistics_t));
     switch(bpp) {
         case IMAGE_BPP_BINARY: {
@@ -720,6 +920,7 @@ static int get_median_l(long long *array, long long array_sum, int array_len)
 bool imlib_get_regression(find_lines_list_lnk_data_t *out, image_t *ptr, rectangle_t *roi, unsigned int x_stride, unsigned int y_stride,
                           list_t *thresholds, bool invert, unsigned int area_threshold, unsigned int pixels_threshold, bool robust)
 {
+    OMV_PROF_SCOPE("imlib_get_regression");
     bool result = false;
     memset(out, 0, sizeof(find_lines_list_lnk_data_t));
 
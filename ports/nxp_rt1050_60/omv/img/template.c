@@ -17,6 +17,11 @@
 
 #include "imlib.h"
 #include "xalloc.h"
+#include "fft.h"
+
+// Largest FFT sizes supported by fft.c (real rows and complex columns).
+#define TEMPLATE_FFT_W_POW2_MAX 10
+#define TEMPLATE_FFT_H_POW2_MAX 9
 
 static void set_dsp(int cx, int cy, point_t *pts, bool sdsp, int step)
 {
@@ -120,12 +125,16 @@ static float find_block_ncc(image_t *f, image_t *t, i_image_t *sum, int t_mean,
 
 float imlib_template_match_ds(image_t *f, image_t *t, rectangle_t *r)
 {
+    OMV_PROF_SCOPE("imlib_template_match_ds");
     point_t pts[9];
 
-    // Integral images
-    i_image_t sum;
-    imlib_integral_image_alloc(&sum, f->w, f->h);
-    imlib_integral_image(f, &sum);
+    // Integral images (the frame buffer one is shared with other detectors run on the frame)
+    i_image_t sum_buf, *sum = imlib_pyramid_integral(f, false);
+    if (!sum) {
+        sum = &sum_buf;
+        imlib_integral_image_alloc(sum, f->w, f->h);
+        imlib_integral_image(f, sum);
+    }
 
     // Normalized sum of squares of the template
     int t_mean = 0;
@@ -164,7 +173,7 @@ float imlib_template_match_ds(image_t *f, image_t *t, rectangle_t *r)
             if (pts[i].x >= f->w || pts[i].y >= f->h) {
                 continue;
             }
-            float blk_xc = find_block_ncc(f, t, &sum, t_mean, t_sumsq, pts[i].x, pts[i].y);
+            float blk_xc = find_block_ncc(f, t, sum, t_mean, t_sumsq, pts[i].x, pts[i].y);
             if (blk_xc > max_xc) {
                 px = pts[i].x;
                 py = pts[i].y;
@@ -202,12 +211,125 @@ float imlib_template_match_ds(image_t *f, image_t *t, rectangle_t *r)
         r->h = f->h - cy;
     }
 
-    imlib_integral_image_free(&sum);
+    if (sum == &sum_buf) {
+        imlib_integral_image_free(sum);
+    }
 
     //printf("max xc: %f\n", (double) max_xc);
     return max_xc;
 }
 
+static int template_clog2(int x)
+{
+    int y = 0;
+    while ((1 << y) < x) y++;
+    return y;
+}
+
+// Returns true if the cross-correlation of the roi and the template is cheaper to compute with
+// 2D FFTs than by summing the products at each position.
+static bool template_match_use_fft(image_t *t, rectangle_t *roi, int step)
+{
+    int w_pow2 = template_clog2(roi->w);
+    int h_pow2 = template_clog2(roi->h);
+
+    if ((w_pow2 < 1) || (w_pow2 > TEMPLATE_FFT_W_POW2_MAX) || (h_pow2 < 1) || (h_pow2 > TEMPLATE_FFT_H_POW2_MAX)) {
+        return false;
+    }
+
+    // Two complex buffers, the zero padded template and some room for the row FFTs.
+    uint32_t fft_size = (2 * (2 * (1 << w_pow2) * (1 << h_pow2) * sizeof(float))) + (roi->w * roi->h) + (8 * (1 << w_pow2) * sizeof(float));
+
+    if (fft_size > fb_avail()) {
+        return false;
+    }
+
+    // Three 2D FFTs cost about 32 multiply-adds per point per pass (float and bit reversal overhead).
+    uint64_t positions = (uint64_t) (((roi->w - t->w) / step) + 1) * (((roi->h - t->h) / step) + 1);
+    uint64_t direct_cost = positions * t->w * t->h;
+    uint64_t fft_cost = (uint64_t) 32 * (1 << w_pow2) * (1 << h_pow2) * (w_pow2 + h_pow2);
+    return direct_cost > fft_cost;
+}
+
+// Computes the NCC numerator at every position from the cross-correlation of the roi and the
+// template done with FFTs, the denominator comes from the integral images like below.
+static float template_match_fft(image_t *f, image_t *t, rectangle_t *roi, int step, rectangle_t *r,
+                                i_image_t *sum, i_image_t *sumsq, int t_mean, int den_b)
+{
+    float corr = 0.0f;
+    int n = t->w * t->h;
+    uint32_t t_sum = 0;
+
+    // Zero padded copy of the template the size of the roi.
+    image_t tp;
+    tp.w = roi->w;
+    tp.h = roi->h;
+    tp.bpp = IMAGE_BPP_GRAYSCALE;
+    tp.data = fb_alloc0(tp.w * tp.h, FB_ALLOC_NO_HINT);
+
+    for (int y=0; y<t->h; y++) {
+        memcpy(tp.data + (y*tp.w), t->data + (y*t->w), t->w);
+        for (int x=0; x<t->w; x++) {
+            t_sum += t->data[(y*t->w)+x];
+        }
+    }
+
+    rectangle_t tp_rect;
+    rectangle_init(&tp_rect, 0, 0, tp.w, tp.h);
+
+    fft2d_controller_t fft_f, fft_t;
+    fft2d_alloc(&fft_f, f, roi);
+    fft2d_alloc(&fft_t, &tp, &tp_rect);
+    fft2d_run(&fft_f);
+    fft2d_run(&fft_t);
+
+    int w = (1 << fft_f.w_pow2);
+    int h = (1 << fft_f.h_pow2);
+
+    for (int i = 0, j = h * w * 2; i < j; i += 2) {
+        float fa_r = fft_f.data[i+0];
+        float fa_i = fft_f.data[i+1];
+        float fb_r = fft_t.data[i+0];
+        float fb_i = -fft_t.data[i+1]; // complex conjugate...
+        fft_f.data[i+0] = (fa_r * fb_r) - (fa_i * fb_i);
+        fft_f.data[i+1] = (fa_r * fb_i) + (fa_i * fb_r);
+    }
+
+    ifft2d_run(&fft_f);
+
+    for (int v=roi->y; v<=(roi->y+roi->h-t->h); v+=step) {
+    for (int u=roi->x; u<=(roi->x+roi->w-t->w); u+=step) {
+        uint32_t f_sum = imlib_integral_lookup(sum, u, v, t->w, t->h);
+        uint32_t f_sumsq = imlib_integral_lookup(sumsq, u, v, t->w, t->h);
+        uint32_t f_mean = f_sum / (float) n;
+
+        // sum((f - f_mean) * (t - t_mean)) expanded around sum(f * t).
+        // Note that the output of the FFT is packed with real data in both
+        // the real and imaginary parts... (right side of the array is zero).
+        float f_t = fft_f.data[((v - roi->y) * w * 2) + (u - roi->x)];
+        float num = f_t - (t_mean * (float) f_sum) - (f_mean * (float) t_sum) + ((float) n * f_mean * t_mean);
+
+        uint32_t den_a = f_sumsq - f_sum * (f_sum / (float) n);
+
+        // Find normalized cross-correlation
+        float c = num/(fast_sqrtf(den_a) * fast_sqrtf(den_b));
+
+        if (c > corr) {
+            corr = c;
+            r->x = u;
+            r->y = v;
+            r->w = t->w;
+            r->h = t->h;
+        }
+    }
+    }
+
+    fft2d_dealloc(); // fft_t
+    fft2d_dealloc(); // fft_f
+    fb_free(); // tp
+    return corr;
+}
+
 /* The NCC can be optimized using integral images and rectangular basis functions.
  * See Kai Briechle's paper "Template Matching using Fast Normalized Cross Correlation".
  *
@@ -216,18 +338,25 @@ float imlib_template_match_ds(image_t *f, image_t *t, rectangle_t *r)
  */
 float imlib_template_match_ex(image_t *f, image_t *t, rectangle_t *roi, int step, rectangle_t *r)
 {
+    OMV_PROF_SCOPE("imlib_template_match_ex");
     int den_b=0;
     float corr=0.0f;
 
-    // Integral images
-    i_image_t sum;
-    i_image_t sumsq;
+    // Integral images (the frame buffer ones are shared with other detectors run on the frame)
+    i_image_t sum_buf, *sum = imlib_pyramid_integral(f, false);
+    i_image_t sumsq_buf, *sumsq = imlib_pyramid_integral(f, true);
 
-    imlib_integral_image_alloc(&sum, f->w, f->h);
-    imlib_integral_image_alloc(&sumsq, f->w, f->h);
+    if (!sum) {
+        sum = &sum_buf;
+        imlib_integral_image_alloc(sum, f->w, f->h);
+        imlib_integral_image(f, sum);
+    }
 
-    imlib_integral_image(f, &sum);
-    imlib_integral_image_sq(f, &sumsq);
+    if (!sumsq) {
+        sumsq = &sumsq_buf;
+        imlib_integral_image_alloc(sumsq, f->w, f->h);
+        imlib_integral_image_sq(f, sumsq);
+    }
 
     // Normalized sum of squares of the template
     int t_mean = 0;
@@ -238,39 +367,49 @@ float imlib_template_match_ex(image_t *f, image_t *t, rectangle_t *roi, int step
         den_b += c*c;
     }
 
-    for (int v=roi->y; v<=(roi->y+roi->h-t->h); v+=step) {
-    for (int u=roi->x; u<=(roi->x+roi->w-t->w); u+=step) {
-        int num = 0;
-        // The mean of the current patch
-        uint32_t f_sum = imlib_integral_lookup(&sum, u, v, t->w, t->h);
-        uint32_t f_sumsq = imlib_integral_lookup(&sumsq, u, v, t->w, t->h);
-        uint32_t f_mean = f_sum / (float) (t->w*t->h);
-
-        // Normalized sum of squares of the image
-        for (int y=v; y<(v+t->h); y++) {
-            for (int x=u; x<(u+t->w); x++) {
-                int a = (int)f->data[y*f->w+x]-f_mean;
-                int b = (int)t->data[(y-v)*t->w+(x-u)]-t_mean;
-                num += a*b;
+    // Large templates correlate faster in the frequency domain.
+    if (template_match_use_fft(t, roi, step)) {
+        corr = template_match_fft(f, t, roi, step, r, sum, sumsq, t_mean, den_b);
+    } else {
+        for (int v=roi->y; v<=(roi->y+roi->h-t->h); v+=step) {
+        for (int u=roi->x; u<=(roi->x+roi->w-t->w); u+=step) {
+            int num = 0;
+            // The mean of the current patch
+            uint32_t f_sum = imlib_integral_lookup(sum, u, v, t->w, t->h);
+            uint32_t f_sumsq = imlib_integral_lookup(sumsq, u, v, t->w, t->h);
+            uint32_t f_mean = f_sum / (float) (t->w*t->h);
+
+            // Normalized sum of squares of the image
+            for (int y=v; y<(v+t->h); y++) {
+                for (int x=u; x<(u+t->w); x++) {
+                    int a = (int)f->data[y*f->w+x]-f_mean;
+                    int b = (int)t->data[(y-v)*t->w+(x-u)]-t_mean;
+                    num += a*b;
+                }
             }
-        }
 
-        uint32_t den_a = f_sumsq - f_sum * (f_sum / (float) (t->w * t->h));
+            uint32_t den_a = f_sumsq - f_sum * (f_sum / (float) (t->w * t->h));
 
-        // Find normalized cross-correlation
-        float c = num/(fast_sqrtf(den_a) * fast_sqrtf(den_b));
+            // Find normalized cross-correlation
+            float c = num/(fast_sqrtf(den_a) * fast_sqrtf(den_b));
 
-        if (c > corr) {
-            corr = c;
-            r->x = u;
-            r->y = v;
-            r->w = t->w;
-            r->h = t->h;
+            if (c > corr) {
+                corr = c;
+                r->x = u;
+                r->y = v;
+                r->w = t->w;
+                r->h = t->h;
+            }
+        }
         }
     }
+
+    if (sumsq == &sumsq_buf) {
+        imlib_integral_image_free(sumsq);
     }
 
-    imlib_integral_image_free(&sum);
-    imlib_integral_image_free(&sumsq);
+    if (sum == &sum_buf) {
+        imlib_integral_image_free(sum);
+    }
     return corr;
 }
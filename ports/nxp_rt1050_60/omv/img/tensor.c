@@ -0,0 +1,130 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Model input preparation.
+ *
+ * Crops the ROI, resizes it with a fixed point bilinear filter, converts it to 1 or 3 channels
+ * and maps every value through a per channel table, all in one pass over the output. The table
+ * folds in whatever the model wants done to a pixel (mean subtraction, input scaling and int8
+ * saturation for nn data layers), NULL keeps the raw 8-bit values (tf). One loop per source
+ * format and channel count.
+ */
+#include "imlib.h"
+
+#define TENSOR_Q    (8)
+#define TENSOR_ONE  (1 << TENSOR_Q)
+
+// Source pixels on both sides of an output pixel and the Q8 weight of the second one.
+typedef struct tensor_tap {
+    int p0, p1;
+    int w;
+} tensor_tap_t;
+
+// First sample position (pixel centers aligned) and step in Q16 for n samples over size pixels.
+static void tensor_step(int n, int size, int *start, int *step)
+{
+    *step = (size << 16) / n;
+    *start = (*step / 2) - (1 << 15);
+}
+
+static inline void tensor_tap(tensor_tap_t *tap, int pos, int offset, int size)
+{
+    int p0 = IM_MAX(pos, 0) >> 16;
+    if (p0 >= (size - 1)) {
+        tap->p0 = tap->p1 = offset + size - 1;
+        tap->w = 0;
+    } else {
+        tap->p0 = offset + p0;
+        tap->p1 = tap->p0 + 1;
+        tap->w = (IM_MAX(pos, 0) >> (16 - TENSOR_Q)) & (TENSOR_ONE - 1);
+    }
+}
+
+static uint8_t tensor_identity[256];
+
+// Q8 horizontal blends of the two source rows, then the vertical blend, rounded back to 8 bits.
+static inline int tensor_blend(int p00, int p01, int p10, int p11, int wx, int wy)
+{
+    int top = (p00 * (TENSOR_ONE - wx)) + (p01 * wx);
+    int bot = (p10 * (TENSOR_ONE - wx)) + (p11 * wx);
+    return ((top * (TENSOR_ONE - wy)) + (bot * wy) + (1 << ((2 * TENSOR_Q) - 1))) >> (2 * TENSOR_Q);
+}
+
+int imlib_resize_to_tensor(image_t *img, rectangle_t *roi, int w, int h, int c, const uint8_t *lut, uint8_t *out)
+{
+    OMV_PROF_SCOPE("imlib_resize_to_tensor");
+    if (((img->bpp != IMAGE_BPP_GRAYSCALE) && (img->bpp != IMAGE_BPP_RGB565)) || ((c != 1) && (c != 3))) {
+        return -1;
+    }
+
+    // Runs inside tf callbacks with the frame buffer stack taken, nothing is allocated.
+    if (lut == NULL) {
+        if (tensor_identity[255] == 0) {
+            for (int i = 0; i < 256; i++) {
+                tensor_identity[i] = i;
+            }
+        }
+        lut = tensor_identity;
+    }
+
+    // 3 channel tables are R, G, B.
+    bool single = (c == 1) || (lut == tensor_identity);
+    const uint8_t *lut_r = lut;
+    const uint8_t *lut_g = single ? lut : (lut + 256);
+    const uint8_t *lut_b = single ? lut : (lut + 512);
+
+    int x_start, x_step, y_start, y_step;
+    tensor_step(w, roi->w, &x_start, &x_step);
+    tensor_step(h, roi->h, &y_start, &y_step);
+
+    for (int y = 0; y < h; y++) {
+        tensor_tap_t row, col;
+        tensor_tap(&row, y_start + (y * y_step), roi->y, roi->h);
+        int wy = row.w;
+
+        if (img->bpp == IMAGE_BPP_GRAYSCALE) {
+            uint8_t *row0 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, row.p0);
+            uint8_t *row1 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, row.p1);
+            if (c == 1) { // GS to GS
+                for (int x = 0; x < w; x++) {
+                    tensor_tap(&col, x_start + (x * x_step), roi->x, roi->w);
+                    *out++ = lut_r[tensor_blend(row0[col.p0], row0[col.p1], row1[col.p0], row1[col.p1], col.w, wy)];
+                }
+            } else { // GS to RGB888
+                for (int x = 0; x < w; x++, out += 3) {
+                    tensor_tap(&col, x_start + (x * x_step), roi->x, roi->w);
+                    int v = tensor_blend(row0[col.p0], row0[col.p1], row1[col.p0], row1[col.p1], col.w, wy);
+                    out[0] = lut_r[v];
+                    out[1] = lut_g[v];
+                    out[2] = lut_b[v];
+                }
+            }
+        } else {
+            uint16_t *row0 = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, row.p0);
+            uint16_t *row1 = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, row.p1);
+            if (c == 1) { // RGB565 to GS
+                for (int x = 0; x < w; x++) {
+                    tensor_tap(&col, x_start + (x * x_step), roi->x, roi->w);
+                    *out++ = lut_r[tensor_blend(COLOR_RGB565_TO_GRAYSCALE(row0[col.p0]),
+                                                COLOR_RGB565_TO_GRAYSCALE(row0[col.p1]),
+                                                COLOR_RGB565_TO_GRAYSCALE(row1[col.p0]),
+                                                COLOR_RGB565_TO_GRAYSCALE(row1[col.p1]), col.w, wy)];
+                }
+            } else { // RGB565 to RGB888
+                for (int x = 0; x < w; x++, out += 3) {
+                    tensor_tap(&col, x_start + (x * x_step), roi->x, roi->w);
+                    int p00 = row0[col.p0], p01 = row0[col.p1], p10 = row1[col.p0], p11 = row1[col.p1];
+                    out[0] = lut_r[tensor_blend(COLOR_RGB565_TO_R8(p00), COLOR_RGB565_TO_R8(p01),
+                                                COLOR_RGB565_TO_R8(p10), COLOR_RGB565_TO_R8(p11), col.w, wy)];
+                    out[1] = lut_g[tensor_blend(COLOR_RGB565_TO_G8(p00), COLOR_RGB565_TO_G8(p01),
+                                                COLOR_RGB565_TO_G8(p10), COLOR_RGB565_TO_G8(p11), col.w, wy)];
+                    out[2] = lut_b[tensor_blend(COLOR_RGB565_TO_B8(p00), COLOR_RGB565_TO_B8(p01),
+                                                COLOR_RGB565_TO_B8(p10), COLOR_RGB565_TO_B8(p11), col.w, wy)];
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,293 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Multi-object tracking of detection boxes (SORT).
+ *
+ * Every track runs a constant velocity Kalman filter on its box center and size, one 2 state
+ * filter (position, velocity) per axis since the axes are independent. Each update predicts
+ * the tracks to the current frame, assigns detections to the predicted boxes by the Hungarian
+ * algorithm on 16 bit fixed point IoU costs and rejects pairs below the IoU threshold. Matched
+ * tracks are corrected, unmatched detections start new tracks and tracks unmatched for more
+ * than max_age updates are dropped. A track gets its id once it matched min_hits updates in a
+ * row and keeps it for as long as it lives, so ids are handed out in order and never reused.
+ */
+#include <limits.h>
+#include "imlib.h"
+#include "fb_alloc.h"
+
+#ifdef IMLIB_ENABLE_TRACKER
+#define TRACKER_IOU_ONE     (1 << 16)
+// Noise variances of SORT: positions are measured to a pixel, sizes to 3 and the initial
+// velocities are unknown.
+#define TRACKER_P_POS       (10.0f)
+#define TRACKER_P_VEL       (10000.0f)
+#define TRACKER_Q_POS       (1.0f)
+#define TRACKER_Q_VEL       (0.01f)
+#define TRACKER_R_POS       (1.0f)
+#define TRACKER_R_SIZE      (10.0f)
+
+static void tracker_kalman_init(tracker_kalman_t *k, float z)
+{
+    k->x = z;
+    k->v = 0.0f;
+    k->p00 = TRACKER_P_POS;
+    k->p01 = 0.0f;
+    k->p11 = TRACKER_P_VEL;
+}
+
+// x' = x + v, P' = F * P * F^T + Q with F = [1 1; 0 1].
+static void tracker_kalman_predict(tracker_kalman_t *k)
+{
+    k->x += k->v;
+    k->p00 += (2.0f * k->p01) + k->p11 + TRACKER_Q_POS;
+    k->p01 += k->p11;
+    k->p11 += TRACKER_Q_VEL;
+}
+
+// Corrects with the measured position z of variance r, H = [1 0].
+static void tracker_kalman_update(tracker_kalman_t *k, float z, float r)
+{
+    float s = k->p00 + r;
+    float k0 = k->p00 / s;
+    float k1 = k->p01 / s;
+    float y = z - k->x;
+    k->x += k0 * y;
+    k->v += k1 * y;
+    k->p11 -= k1 * k->p01;
+    k->p01 -= k0 * k->p01;
+    k->p00 -= k0 * k->p00;
+}
+
+static void tracker_track_rect(tracker_track_t *track)
+{
+    int w = IM_MAX(fast_roundf(track->kf[2].x), 1);
+    int h = IM_MAX(fast_roundf(track->kf[3].x), 1);
+    track->rect.x = fast_roundf(track->kf[0].x - (w * 0.5f));
+    track->rect.y = fast_roundf(track->kf[1].x - (h * 0.5f));
+    track->rect.w = w;
+    track->rect.h = h;
+}
+
+static void tracker_track_init(tracker_track_t *track, rectangle_t *r)
+{
+    tracker_kalman_init(&track->kf[0], r->x + (r->w * 0.5f));
+    tracker_kalman_init(&track->kf[1], r->y + (r->h * 0.5f));
+    tracker_kalman_init(&track->kf[2], r->w);
+    tracker_kalman_init(&track->kf[3], r->h);
+    track->rect = *r;
+    track->id = 0;
+    track->hit_streak = 1;
+    track->misses = 0;
+}
+
+static void tracker_track_predict(tracker_track_t *track)
+{
+    for (int i = 0; i < 4; i++) {
+        tracker_kalman_predict(&track->kf[i]);
+    }
+    // A box shrinking past nothing would come back inside out.
+    for (int i = 2; i < 4; i++) {
+        if (track->kf[i].x < 1.0f) {
+            track->kf[i].x = 1.0f;
+            track->kf[i].v = 0.0f;
+        }
+    }
+    tracker_track_rect(track);
+}
+
+static void tracker_track_update(tracker_track_t *track, rectangle_t *r)
+{
+    tracker_kalman_update(&track->kf[0], r->x + (r->w * 0.5f), TRACKER_R_POS);
+    tracker_kalman_update(&track->kf[1], r->y + (r->h * 0.5f), TRACKER_R_POS);
+    tracker_kalman_update(&track->kf[2], r->w, TRACKER_R_SIZE);
+    tracker_kalman_update(&track->kf[3], r->h, TRACKER_R_SIZE);
+    tracker_track_rect(track);
+}
+
+// IoU of two boxes, 16 bit fixed point.
+static int32_t tracker_iou(rectangle_t *a, rectangle_t *b)
+{
+    int w = IM_MIN(a->x + a->w, b->x + b->w) - IM_MAX(a->x, b->x);
+    int h = IM_MIN(a->y + a->h, b->y + b->h) - IM_MAX(a->y, b->y);
+    if ((w <= 0) || (h <= 0)) {
+        return 0;
+    }
+    uint32_t intersection = w * h;
+    uint32_t area_union = (a->w * a->h) + (b->w * b->h) - intersection;
+    return (((uint64_t) intersection) << 16) / area_union;
+}
+
+// Minimum cost assignment of the n rows of the n x m cost matrix to columns, n <= m, by the
+// O(n^2 m) shortest augmenting path form of the Hungarian algorithm. Leaves in col_row[j] the
+// row assigned to column j, or -1. The arrays are indexed from 1, 0 is the virtual start.
+static void tracker_hungarian(const int32_t *cost, int n, int m, int *col_row)
+{
+    int32_t *u = fb_alloc((n + 1) * sizeof(int32_t), FB_ALLOC_PREFER_SPEED);
+    int32_t *v = fb_alloc((m + 1) * sizeof(int32_t), FB_ALLOC_PREFER_SPEED);
+    int32_t *minv = fb_alloc((m + 1) * sizeof(int32_t), FB_ALLOC_PREFER_SPEED);
+    int *p = fb_alloc((m + 1) * sizeof(int), FB_ALLOC_PREFER_SPEED);
+    int *way = fb_alloc((m + 1) * sizeof(int), FB_ALLOC_PREFER_SPEED);
+    uint8_t *used = fb_alloc(m + 1, FB_ALLOC_PREFER_SPEED);
+
+    memset(u, 0, (n + 1) * sizeof(int32_t));
+    memset(v, 0, (m + 1) * sizeof(int32_t));
+    memset(p, 0, (m + 1) * sizeof(int));
+
+    for (int i = 1; i <= n; i++) {
+        int j0 = 0;
+        p[0] = i;
+        for (int j = 0; j <= m; j++) {
+            minv[j] = INT32_MAX;
+            used[j] = false;
+        }
+
+        do {
+            used[j0] = true;
+            int i0 = p[j0], j1 = 0;
+            int32_t delta = INT32_MAX;
+            const int32_t *row = cost + ((i0 - 1) * m) - 1;
+
+            for (int j = 1; j <= m; j++) {
+                if (!used[j]) {
+                    int32_t cur = row[j] - u[i0] - v[j];
+                    if (cur < minv[j]) {
+                        minv[j] = cur;
+                        way[j] = j0;
+                    }
+                    if (minv[j] < delta) {
+                        delta = minv[j];
+                        j1 = j;
+                    }
+                }
+            }
+
+            for (int j = 0; j <= m; j++) {
+                if (used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+
+            j0 = j1;
+        } while (p[j0]);
+
+        // Flip the augmenting path.
+        do {
+            int j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0);
+    }
+
+    for (int j = 1; j <= m; j++) {
+        col_row[j - 1] = p[j] - 1;
+    }
+
+    fb_free(); // used
+    fb_free(); // way
+    fb_free(); // p
+    fb_free(); // minv
+    fb_free(); // v
+    fb_free(); // u
+}
+
+void imlib_tracker_init(tracker_t *tracker, int max_age, int min_hits, float iou_threshold)
+{
+    tracker->max_age = max_age;
+    tracker->min_hits = IM_MAX(min_hits, 1);
+    tracker->iou_threshold = fast_roundf(iou_threshold * TRACKER_IOU_ONE);
+    tracker->next_id = 1;
+    tracker->count = 0;
+}
+
+void imlib_tracker_update(tracker_t *tracker, list_t *detections, size_t rect_offset, int *ids)
+{
+    int n_tracks = tracker->count;
+    int n_dets = list_size(detections);
+
+    for (int i = 0; i < n_tracks; i++) {
+        tracker_track_predict(&tracker->tracks[i]);
+    }
+
+    // The detection boxes and the track each is assigned to.
+    rectangle_t *dets = fb_alloc(IM_MAX(n_dets, 1) * sizeof(rectangle_t), FB_ALLOC_NO_HINT);
+    int *det_track = fb_alloc(IM_MAX(n_dets, 1) * sizeof(int), FB_ALLOC_NO_HINT);
+    int d = 0;
+    for (list_lnk_t *it = iterator_start_from_head(detections); it; it = iterator_next(it), d++) {
+        memcpy(dets + d, it->data + rect_offset, sizeof(rectangle_t));
+        det_track[d] = -1;
+    }
+
+    if (n_tracks && n_dets) {
+        // The rows are the smaller side.
+        bool by_track = n_tracks <= n_dets;
+        int n = by_track ? n_tracks : n_dets;
+        int m = by_track ? n_dets : n_tracks;
+        int32_t *cost = fb_alloc(n * m * sizeof(int32_t), FB_ALLOC_NO_HINT);
+        int32_t *iou = fb_alloc(n * m * sizeof(int32_t), FB_ALLOC_NO_HINT);
+        int *col_row = fb_alloc(m * sizeof(int), FB_ALLOC_NO_HINT);
+
+        for (int t = 0; t < n_tracks; t++) {
+            for (int j = 0; j < n_dets; j++) {
+                int k = by_track ? ((t * m) + j) : ((j * m) + t);
+                iou[k] = tracker_iou(&tracker->tracks[t].rect, dets + j);
+                cost[k] = TRACKER_IOU_ONE - iou[k];
+            }
+        }
+
+        tracker_hungarian(cost, n, m, col_row);
+
+        for (int c = 0; c < m; c++) {
+            int r = col_row[c];
+            if ((r >= 0) && (iou[(r * m) + c] >= tracker->iou_threshold)) {
+                det_track[by_track ? c : r] = by_track ? r : c;
+            }
+        }
+
+        fb_free(); // col_row
+        fb_free(); // iou
+        fb_free(); // cost
+    }
+
+    for (int t = 0; t < n_tracks; t++) {
+        tracker->tracks[t].misses += 1;
+    }
+
+    for (int j = 0; j < n_dets; j++) {
+        tracker_track_t *track;
+        if (det_track[j] >= 0) {
+            track = tracker->tracks + det_track[j];
+            tracker_track_update(track, dets + j);
+            track->hit_streak = (track->misses == 1) ? (track->hit_streak + 1) : 1;
+            track->misses = 0;
+        } else if (tracker->count < TRACKER_MAX_TRACKS) {
+            track = tracker->tracks + tracker->count++;
+            tracker_track_init(track, dets + j);
+        } else {
+            ids[j] = -1;
+            continue;
+        }
+
+        if ((!track->id) && (track->hit_streak >= tracker->min_hits)) {
+            track->id = tracker->next_id++;
+        }
+
+        ids[j] = track->id ? track->id : -1;
+    }
+
+    // Drop the lost tracks, new ones were not predicted and have no misses.
+    int count = 0;
+    for (int t = 0; t < tracker->count; t++) {
+        if (tracker->tracks[t].misses <= tracker->max_age) {
+            tracker->tracks[count++] = tracker->tracks[t];
+        }
+    }
+    tracker->count = count;
+
+    fb_free(); // det_track
+    fb_free(); // dets
+}
+#endif // IMLIB_ENABLE_TRACKER
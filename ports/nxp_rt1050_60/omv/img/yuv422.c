@@ -0,0 +1,62 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * YUV422 frames to grayscale and RGB565.
+ *
+ * The sensor's YUV422 is Y0 U Y1 V, two pixels to a word. Grayscale is the Y bytes packed 4 to
+ * a word, no arithmetic at all. RGB565 works a pair of pixels at a time: the chroma terms of
+ * imlib_yuv_to_rgb() are computed once for the U and V the pair shares and added to both Y.
+ * Only the pixels of the ROI asked for are converted.
+ */
+#include "imlib.h"
+
+static void yuv422_to_grayscale_row(uint8_t *dst, const uint8_t *src, int n)
+{
+    int i = 0;
+
+    for (; (i + 4) <= n; i += 4) {
+        uint32_t w0 = __UNALIGNED_UINT32_READ(src + (i * 2));
+        uint32_t w1 = __UNALIGNED_UINT32_READ(src + (i * 2) + 4);
+        __UNALIGNED_UINT32_WRITE(dst + i, (w0 & 0xFF) | ((w0 >> 8) & 0xFF00) | ((w1 & 0xFF) << 16) | ((w1 << 8) & 0xFF000000));
+    }
+
+    for (; i < n; i++) {
+        dst[i] = src[i * 2];
+    }
+}
+
+static void yuv422_to_rgb565_row(uint16_t *dst, const uint8_t *src, int x, int n)
+{
+    for (int i = 0; i < n; ) {
+        // The pair of pixel x + i.
+        const uint8_t *pair = src + ((x + i) & ~1) * 2;
+        int u = pair[1] - 128, v = pair[3] - 128;
+        int dr = (91881 * v) >> 16;
+        int dg = ((22554 * u) + (46802 * v)) >> 16;
+        int db = (116130 * u) >> 16;
+
+        for (int j = (x + i) & 1; (j < 2) && (i < n); j++, i++) {
+            int y = pair[j * 2];
+            int r = IM_MAX(IM_MIN(y + dr, COLOR_R8_MAX), COLOR_R8_MIN);
+            int g = IM_MAX(IM_MIN(y - dg, COLOR_G8_MAX), COLOR_G8_MIN);
+            int b = IM_MAX(IM_MIN(y + db, COLOR_B8_MAX), COLOR_B8_MIN);
+            dst[i] = COLOR_R8_G8_B8_TO_RGB565(r, g, b);
+        }
+    }
+}
+
+void imlib_yuv422_unpack(image_t *dst, image_t *src, rectangle_t *roi)
+{
+    OMV_PROF_SCOPE("imlib_yuv422_unpack");
+
+    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+        const uint8_t *src_row_ptr = IMAGE_COMPUTE_YUV422_PIXEL_ROW_PTR(src, y);
+
+        if (dst->bpp == IMAGE_BPP_GRAYSCALE) {
+            yuv422_to_grayscale_row(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(dst, y) + roi->x, src_row_ptr + (roi->x * 2), roi->w);
+        } else {
+            yuv422_to_rgb565_row(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst, y) + roi->x, src_row_ptr, roi->x, roi->w);
+        }
+    }
+}
@@ -8706,33 +8706,18 @@ void zbar_scanner_get_state (const zbar_scanner_t *scn,
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi)
+void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi, bool locate)
 {
+    OMV_PROF_SCOPE("imlib_find_barcodes");
     uint8_t *grayscale_image = (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->data : fb_alloc(roi->w * roi->h, FB_ALLOC_NO_HINT);
-    umm_init_x(fb_avail());
-    zbar_image_scanner_t *scanner = zbar_image_scanner_create();
-    zbar_image_scanner_set_config(scanner, 0, ZBAR_CFG_ENABLE, 1);
-
-    zbar_image_t image;
-    image.format = *((int *) "Y800");
-    image.width = (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->w : roi->w;
-    image.height = (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->h : roi->h;
-    image.data = grayscale_image;
-    image.datalen = ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->w : roi->w) * ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->h : roi->h);
-    image.crop_x = (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? roi->x : 0;
-    image.crop_y = (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? roi->y : 0;
-    image.crop_w = roi->w;
-    image.crop_h = roi->h;
-    image.userdata = 0;
-    image.seq = 0;
-    image.syms = 0;
+    uint8_t *grayscale_image_tmp = grayscale_image;
 
     switch (ptr->bpp) {
         case IMAGE_BPP_BINARY: {
             for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
                 uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
                 for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
-                    *(grayscale_image++) = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                    *(grayscale_image_tmp++) = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
                 }
             }
             break;
@@ -8744,7 +8729,7 @@ void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi)
             for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
                 uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
                 for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
-                    *(grayscale_image++) = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                    *(grayscale_image_tmp++) = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
                 }
             }
             break;
@@ -8755,79 +8740,130 @@ void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi)
         }
     }
 
+    // Grayscale images are scanned in place, the others are copied into a buffer of the roi size.
+    image_t img;
+    rectangle_t img_roi;
+    image_init(&img, (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->w : roi->w,
+                     (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? ptr->h : roi->h,
+                     IMAGE_BPP_GRAYSCALE, grayscale_image);
+    rectangle_init(&img_roi, (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? roi->x : 0,
+                             (ptr->bpp == IMAGE_BPP_GRAYSCALE) ? roi->y : 0,
+                             roi->w, roi->h);
+
+    list_t rois;
+
+    if (locate) {
+        imlib_find_symbol_rois(&rois, &img, &img_roi);
+    } else {
+        list_init(&rois, sizeof(rectangle_t));
+        list_push_back(&rois, &img_roi);
+    }
+
     list_init(out, sizeof(find_barcodes_list_lnk_data_t));
 
-    if (zbar_scan_image(scanner, &image) > 0) {
-        for (const zbar_symbol_t *symbol = (image.syms) ? image.syms->head : NULL; symbol; symbol = zbar_symbol_next(symbol)) {
-            if (zbar_symbol_get_loc_size(symbol) > 0) {
-                find_barcodes_list_lnk_data_t lnk_data;
-
-                rectangle_init(&(lnk_data.rect),
-                               zbar_symbol_get_loc_x(symbol, 0) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x),
-                               zbar_symbol_get_loc_y(symbol, 0) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y),
-                               (zbar_symbol_get_loc_size(symbol) == 1) ? 1 : 0,
-                               (zbar_symbol_get_loc_size(symbol) == 1) ? 1 : 0);
-
-                for (size_t k = 1, l = zbar_symbol_get_loc_size(symbol); k < l; k++) {
-                    rectangle_t temp;
-                    rectangle_init(&temp,
-                                   zbar_symbol_get_loc_x(symbol, k) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x),
-                                   zbar_symbol_get_loc_y(symbol, k) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y),
-                                   0,
-                                   0);
-                    rectangle_united(&(lnk_data.rect), &temp);
-                }
+    if (!list_size(&rois)) {
+        list_free(&rois);
+        if (ptr->bpp != IMAGE_BPP_GRAYSCALE) fb_free(); // grayscale_image;
+        return;
+    }
 
-                // Add corners...
-                lnk_data.corners[0].x = lnk_data.rect.x;                   // top-left
-                lnk_data.corners[0].y = lnk_data.rect.y;                   // top-left
-                lnk_data.corners[1].x = lnk_data.rect.x + lnk_data.rect.w; // top-right
-                lnk_data.corners[1].y = lnk_data.rect.y;                   // top-right
-                lnk_data.corners[2].x = lnk_data.rect.x + lnk_data.rect.w; // bottom-right
-                lnk_data.corners[2].y = lnk_data.rect.y + lnk_data.rect.h; // bottom-right
-                lnk_data.corners[3].x = lnk_data.rect.x;                   // bottom-left
-                lnk_data.corners[3].y = lnk_data.rect.y + lnk_data.rect.h; // bottom-left
-
-                // Payload is already null terminated.
-                lnk_data.payload_len = zbar_symbol_get_data_length(symbol);
-                lnk_data.payload = xalloc(zbar_symbol_get_data_length(symbol));
-                memcpy(lnk_data.payload, zbar_symbol_get_data(symbol), zbar_symbol_get_data_length(symbol));
-
-                switch (zbar_symbol_get_type(symbol)) {
-                    case ZBAR_EAN2: lnk_data.type = BARCODE_EAN2; break;
-                    case ZBAR_EAN5: lnk_data.type = BARCODE_EAN5; break;
-                    case ZBAR_EAN8: lnk_data.type = BARCODE_EAN8; break;
-                    case ZBAR_UPCE: lnk_data.type = BARCODE_UPCE; break;
-                    case ZBAR_ISBN10: lnk_data.type = BARCODE_ISBN10; break;
-                    case ZBAR_UPCA: lnk_data.type = BARCODE_UPCA; break;
-                    case ZBAR_EAN13: lnk_data.type = BARCODE_EAN13; break;
-                    case ZBAR_ISBN13: lnk_data.type = BARCODE_ISBN13; break;
-                    case ZBAR_I25: lnk_data.type = BARCODE_I25; break;
-                    case ZBAR_DATABAR: lnk_data.type = BARCODE_DATABAR; break;
-                    case ZBAR_DATABAR_EXP: lnk_data.type = BARCODE_DATABAR_EXP; break;
-                    case ZBAR_CODABAR: lnk_data.type = BARCODE_CODABAR; break;
-                    case ZBAR_CODE39: lnk_data.type = BARCODE_CODE39; break;
-                    case ZBAR_PDF417: lnk_data.type = BARCODE_PDF417; break;
-                    case ZBAR_CODE93: lnk_data.type = BARCODE_CODE93; break;
-                    case ZBAR_CODE128: lnk_data.type = BARCODE_CODE128; break;
-                    default: continue;
-                }
+    umm_init_x(fb_avail());
+    zbar_image_scanner_t *scanner = zbar_image_scanner_create();
+    zbar_image_scanner_set_config(scanner, 0, ZBAR_CFG_ENABLE, 1);
 
-                switch (zbar_symbol_get_orientation(symbol)) {
-                    case ZBAR_ORIENT_UP: lnk_data.rotation = 0; break;
-                    case ZBAR_ORIENT_RIGHT: lnk_data.rotation = 270; break;
-                    case ZBAR_ORIENT_DOWN: lnk_data.rotation = 180; break;
-                    case ZBAR_ORIENT_LEFT: lnk_data.rotation = 90; break;
-                    default: continue;
-                }
+    zbar_image_t image;
+    image.format = *((int *) "Y800");
+    image.width = img.w;
+    image.height = img.h;
+    image.data = grayscale_image;
+    image.datalen = img.w * img.h;
+    image.userdata = 0;
+    image.seq = 0;
+    image.syms = 0;
 
-                lnk_data.quality = zbar_symbol_get_quality(symbol);
+    while (list_size(&rois)) {
+        rectangle_t lnk_roi;
+        list_pop_front(&rois, &lnk_roi);
+
+        image.crop_x = lnk_roi.x;
+        image.crop_y = lnk_roi.y;
+        image.crop_w = lnk_roi.w;
+        image.crop_h = lnk_roi.h;
+
+        if (zbar_scan_image(scanner, &image) > 0) {
+            for (const zbar_symbol_t *symbol = (image.syms) ? image.syms->head : NULL; symbol; symbol = zbar_symbol_next(symbol)) {
+                if (zbar_symbol_get_loc_size(symbol) > 0) {
+                    find_barcodes_list_lnk_data_t lnk_data;
+
+                    rectangle_init(&(lnk_data.rect),
+                                   zbar_symbol_get_loc_x(symbol, 0) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x),
+                                   zbar_symbol_get_loc_y(symbol, 0) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y),
+                                   (zbar_symbol_get_loc_size(symbol) == 1) ? 1 : 0,
+                                   (zbar_symbol_get_loc_size(symbol) == 1) ? 1 : 0);
+
+                    for (size_t k = 1, l = zbar_symbol_get_loc_size(symbol); k < l; k++) {
+                        rectangle_t temp;
+                        rectangle_init(&temp,
+                                       zbar_symbol_get_loc_x(symbol, k) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->x),
+                                       zbar_symbol_get_loc_y(symbol, k) + ((ptr->bpp == IMAGE_BPP_GRAYSCALE) ? 0 : roi->y),
+                                       0,
+                                       0);
+                        rectangle_united(&(lnk_data.rect), &temp);
+                    }
 
-                list_push_back(out, &lnk_data);
+                    // Add corners...
+                    lnk_data.corners[0].x = lnk_data.rect.x;                   // top-left
+                    lnk_data.corners[0].y = lnk_data.rect.y;                   // top-left
+                    lnk_data.corners[1].x = lnk_data.rect.x + lnk_data.rect.w; // top-right
+                    lnk_data.corners[1].y = lnk_data.rect.y;                   // top-right
+                    lnk_data.corners[2].x = lnk_data.rect.x + lnk_data.rect.w; // bottom-right
+                    lnk_data.corners[2].y = lnk_data.rect.y + lnk_data.rect.h; // bottom-right
+                    lnk_data.corners[3].x = lnk_data.rect.x;                   // bottom-left
+                    lnk_data.corners[3].y = lnk_data.rect.y + lnk_data.rect.h; // bottom-left
+
+                    // Payload is already null terminated.
+                    lnk_data.payload_len = zbar_symbol_get_data_length(symbol);
+                    lnk_data.payload = xalloc(zbar_symbol_get_data_length(symbol));
+                    memcpy(lnk_data.payload, zbar_symbol_get_data(symbol), zbar_symbol_get_data_length(symbol));
+
+                    switch (zbar_symbol_get_type(symbol)) {
+                        case ZBAR_EAN2: lnk_data.type = BARCODE_EAN2; break;
+                        case ZBAR_EAN5: lnk_data.type = BARCODE_EAN5; break;
+                        case ZBAR_EAN8: lnk_data.type = BARCODE_EAN8; break;
+                        case ZBAR_UPCE: lnk_data.type = BARCODE_UPCE; break;
+                        case ZBAR_ISBN10: lnk_data.type = BARCODE_ISBN10; break;
+                        case ZBAR_UPCA: lnk_data.type = BARCODE_UPCA; break;
+                        case ZBAR_EAN13: lnk_data.type = BARCODE_EAN13; break;
+                        case ZBAR_ISBN13: lnk_data.type = BARCODE_ISBN13; break;
+                        case ZBAR_I25: lnk_data.type = BARCODE_I25; break;
+                        case ZBAR_DATABAR: lnk_data.type = BARCODE_DATABAR; break;
+                        case ZBAR_DATABAR_EXP: lnk_data.type = BARCODE_DATABAR_EXP; break;
+                        case ZBAR_CODABAR: lnk_data.type = BARCODE_CODABAR; break;
+                        case ZBAR_CODE39: lnk_data.type = BARCODE_CODE39; break;
+                        case ZBAR_PDF417: lnk_data.type = BARCODE_PDF417; break;
+                        case ZBAR_CODE93: lnk_data.type = BARCODE_CODE93; break;
+                        case ZBAR_CODE128: lnk_data.type = BARCODE_CODE128; break;
+                        default: continue;
+                    }
+
+                    switch (zbar_symbol_get_orientation(symbol)) {
+                        case ZBAR_ORIENT_UP: lnk_data.rotation = 0; break;
+                        case ZBAR_ORIENT_RIGHT: lnk_data.rotation = 270; break;
+                        case ZBAR_ORIENT_DOWN: lnk_data.rotation = 180; break;
+                        case ZBAR_ORIENT_LEFT: lnk_data.rotation = 90; break;
+                        default: continue;
+                    }
+
+                    lnk_data.quality = zbar_symbol_get_quality(symbol);
+
+                    list_push_back(out, &lnk_data);
+                }
             }
         }
     }
 
+    list_free(&rois);
+
     for (;;) { // Merge overlapping.
         bool merge_occured = false;
 
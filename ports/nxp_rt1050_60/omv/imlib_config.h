@@ -12,6 +12,15 @@
 // Enable LAB LUT
 #define IMLIB_ENABLE_LAB_LUT
 
+// Enable the cached thresholds LUT (64KB on the GC heap)
+#define IMLIB_ENABLE_THRESHOLDS_LUT
+
+// Enable the per frame pyramid / integral image cache (on the GC heap)
+#define IMLIB_ENABLE_PYRAMID_CACHE
+
+// Enable the lens_corr() / rotation_corr() remap table cache (on the GC heap)
+#define IMLIB_ENABLE_REMAP_CACHE
+
 // Enable YUV LUT
 #define IMLIB_ENABLE_YUV_LUT
 
@@ -51,6 +60,9 @@
 // Enable Laplacian
 #define IMLIB_ENABLE_LAPLACIAN
 
+// Enable pipeline()
+#define IMLIB_ENABLE_PIPELINE
+
 // Enable bilateral()
 #define IMLIB_ENABLE_BILATERAL
 
@@ -75,12 +87,24 @@
 // Enable invariant table
 //#define IMLIB_ENABLE_INVARIANT_TABLE
 
+// Offload draw_image(), to_grayscale() and CNN input scaling to PXP
+#define IMLIB_ENABLE_PXP
+
+// Let PXP convert RGB565 frames to YCbCr 4:2:0 for the JPEG encoder (needs IMLIB_ENABLE_PXP)
+#define IMLIB_ENABLE_PXP_JPEG
+
 // Enable rotation_corr()
 #define IMLIB_ENABLE_ROTATION_CORR
 
 // Enable phasecorrelate()
 #define IMLIB_ENABLE_FIND_DISPLACEMENT
 
+// Enable track_points()
+#define IMLIB_ENABLE_TRACK_POINTS
+
+// Enable Tracker()
+#define IMLIB_ENABLE_TRACKER
+
 // rotation_corr() is required by phasecorrelate()
 #if defined(IMLIB_ENABLE_FIND_DISPLACEMENT)\
     && !defined(IMLIB_ENABLE_ROTATION_CORR)
@@ -148,4 +172,17 @@
 // Enable selective_search()
 #define IMLIB_ENABLE_SELECTIVE_SEARCH
 
+// Enable mjpeg.Recorder()
+#define IMLIB_ENABLE_MJPEG_RECORDER
+
+// Enable OMV_PROF_SCOPE() cycle counts of imlib, the sensor and fb_alloc, read with omv.perf()
+//#define OMV_ENABLE_PERF
+
+// The host port (ports/omv_host) has no PXP and no SD card to record to.
+#ifdef OMV_HOST
+#undef IMLIB_ENABLE_PXP
+#undef IMLIB_ENABLE_PXP_JPEG
+#undef IMLIB_ENABLE_MJPEG_RECORDER
+#endif
+
 #endif //__IMLIB_CONFIG_H__
@@ -17,9 +17,9 @@
 #include "framebuffer.h"
 #include "omv_boardconfig.h"
 #include "common.h"
+#include "spi.h"
 
 #if defined(OMV_ENABLE_LEPTON)
-#include "crc16.h"
 #include "LEPTON_SDK.h"
 #include "LEPTON_AGC.h"
 #include "LEPTON_SYS.h"
@@ -39,10 +39,30 @@
 #define VOSPI_HEADER_CRC(buf)   (((buf[2] << 8) | (buf[3] << 0)))
 #define VOSPI_FIRST_PACKET      (0)
 #define VOSPI_FIRST_SEGMENT     (1)
+
+// VoSPI capture runs on its own. Two packet receives are queued on the SPI DMA so the bus
+// never stops, each one's completion checks the packet, puts its line into the frame being
+// reassembled and queues the receive again. Complete frames go into a ring of three, so
+// snapshot() always finds the newest one while the capture goes on in another. Losing sync
+// raises CS and the systick starts the capture again once VoSPI timed out.
+#ifndef LEPTON_SPI_BUS
+#define LEPTON_SPI_BUS          (PYB_SPI_4)
+#endif
+#ifndef LEPTON_SPI_BAUDRATE
+#define LEPTON_SPI_BAUDRATE     (20000000)
+#endif
+// the RX channel completes a transfer
+#define LEPTON_SPI_DMA_IRQn     (DMA0_DMA16_IRQn + DMA_CH_LPSPI_RX(LEPTON_SPI_BUS))
 #define LEPTON_TIMEOUT          (1000)
 #define DEFAULT_MIN_TEMP        (-17.7778f)
 #define DEFAULT_MAX_TEMP        (37.7778f)
 
+#define VOSPI_RESYNC_MS         (200) // CS high for longer than 185 ms
+#define VOSPI_PACKET_ALLOC      ((VOSPI_PACKET_SIZE + DMA_CACHE_LINE_SIZE - 1) & ~(DMA_CACHE_LINE_SIZE - 1))
+#define VOSPI_FRAMES            (3)
+#define VOSPI_FRAME_SIZE        (VOSPI_NUMBER_PACKETS * 4 * VOSPI_LINE_SIZE) // Lepton 3, 4 segments
+#define VOSPI_NO_FRAME          (-1)
+
 static bool radiometry = false;
 static int h_res = 0;
 static int v_res = 0;
@@ -52,55 +72,95 @@ static bool measurement_mode = false;
 static float min_temp = DEFAULT_MIN_TEMP;
 static float max_temp = DEFAULT_MAX_TEMP;
 
-static SPI_HandleTypeDef SPIHandle;
-static DMA_HandleTypeDef DMAHandle;
 LEP_CAMERA_PORT_DESC_T   LEPHandle;
-extern uint8_t _line_buf;
-extern uint8_t _vospi_buf;
-
-static bool vospi_resync = true;
-static uint8_t *vospi_packet = &_line_buf;
-static uint8_t *vospi_buffer = &_vospi_buf;
-static volatile uint32_t vospi_pid = 0;
-static volatile uint32_t vospi_seg = 1;
+
+static volatile enum { VOSPI_IDLE, VOSPI_WAIT, VOSPI_RUN } vospi_state = VOSPI_IDLE;
+static volatile uint32_t vospi_wait_tick;
+DMA_BUF_ALIGN static uint8_t vospi_packet[2][VOSPI_PACKET_ALLOC];
+static uint8_t vospi_frames[VOSPI_FRAMES][VOSPI_FRAME_SIZE] __attribute__((aligned(4)));
+// ring slots: being reassembled, newest complete one, the one handed to the script
+static int vospi_fill = 0;
+static volatile int vospi_ready = VOSPI_NO_FRAME;
+static volatile int vospi_held = VOSPI_NO_FRAME;
+static uint32_t vospi_pid = 0;
+static uint32_t vospi_seg = 1;
 static uint32_t vospi_packets = 60;
+static volatile uint32_t vospi_frame_count, vospi_crc_errors, vospi_resyncs;
 static int lepton_reset(sensor_t *sensor, bool measurement_mode);
+static void lepton_vospi_done(void *arg, status_t status);
+
+// CRC-16-CCITT of a packet, taking the ID nibble and the CRC field as 0. The DCP only does
+// CRC-32, so a nibble table fast enough for the DMA IRQ.
+static uint16_t lepton_calc_crc(const uint8_t *buf)
+{
+    static const uint16_t table[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+        0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+    };
+    uint16_t crc = 0;
+    for (int i = 0; i < VOSPI_PACKET_SIZE; i++) {
+        uint8_t b = (i == 0) ? (buf[0] & 0x0F) : ((i == 2) || (i == 3)) ? 0 : buf[i];
+        crc = (crc << 4) ^ table[((crc >> 12) ^ (b >> 4)) & 0xF];
+        crc = (crc << 4) ^ table[((crc >> 12) ^ b) & 0xF];
+    }
+    return crc;
+}
 
-void LEPTON_SPI_IRQHandler(void)
+static void lepton_vospi_queue(uint8_t *packet, uint32_t flags)
 {
-    HAL_SPI_IRQHandler(&SPIHandle);
+    spi_dma_desc_t desc = {
+        .rx = packet,
+        .len = VOSPI_PACKET_SIZE,
+        .cs = pyb_spi_obj[LEPTON_SPI_BUS].pSSEL,
+        .flags = flags,
+        .done = lepton_vospi_done,
+        .arg = packet,
+    };
+    spi_dma_queue(LEPTON_SPI_BUS, &desc);
 }
 
-void LEPTON_SPI_DMA_IRQHandler(void)
+// Stops the capture with CS high, to start again from the systick VOSPI_RESYNC_MS later
+// if restart.
+static void lepton_vospi_stop(bool restart)
 {
-    HAL_DMA_IRQHandler(SPIHandle.hdmarx);
+    // first, so a completion coming in before the abort does not queue again
+    vospi_state = VOSPI_IDLE;
+    spi_dma_abort(LEPTON_SPI_BUS);
+    mp_hal_pin_high(pyb_spi_obj[LEPTON_SPI_BUS].pSSEL);
+    if (restart) {
+        vospi_wait_tick = HAL_GetTick();
+        vospi_state = VOSPI_WAIT;
+    }
 }
 
-static void lepton_sync()
+// From the systick.
+void lepton_tick_handler(uint32_t tick)
 {
-    HAL_SPI_Abort(&SPIHandle);
-
-    // Disable DMA IRQ
-    HAL_NVIC_DisableIRQ(LEPTON_SPI_DMA_IRQn);
-
-    debug_printf("resync...\n");
-    systick_sleep(200);
-
-    vospi_resync = false;
-    vospi_pid = VOSPI_FIRST_PACKET;
-    vospi_seg = VOSPI_FIRST_SEGMENT;
-
-    HAL_NVIC_EnableIRQ(LEPTON_SPI_DMA_IRQn);
-    HAL_SPI_Receive_DMA(&SPIHandle, vospi_packet, VOSPI_PACKET_SIZE);
+    if ((vospi_state == VOSPI_WAIT) && ((tick - vospi_wait_tick) >= VOSPI_RESYNC_MS)) {
+        vospi_pid = VOSPI_FIRST_PACKET;
+        vospi_seg = VOSPI_FIRST_SEGMENT;
+        vospi_state = VOSPI_RUN;
+        // CS stays low between packets.
+        lepton_vospi_queue(vospi_packet[0], SPI_DMA_CS_ASSERT);
+        lepton_vospi_queue(vospi_packet[1], 0);
+    }
 }
 
-static uint16_t lepton_calc_crc(uint8_t *buf)
+// Hands the newest complete frame to the script, it stays valid until the next call. NULL
+// if none completed since the last call and new_only, else the last one handed out if any.
+static uint8_t *lepton_vospi_take(bool new_only)
 {
-    buf[0] &= 0x0F;
-    buf[1] &= 0xFF;
-    buf[2] = 0;
-    buf[3] = 0;
-    return CalcCRC16Bytes(VOSPI_PACKET_SIZE, (char *) buf);
+    uint8_t *frame = NULL;
+    NVIC_DisableIRQ(LEPTON_SPI_DMA_IRQn);
+    if (vospi_ready != VOSPI_NO_FRAME) {
+        vospi_held = vospi_ready;
+        vospi_ready = VOSPI_NO_FRAME;
+        frame = vospi_frames[vospi_held];
+    } else if (!new_only && (vospi_held != VOSPI_NO_FRAME)) {
+        frame = vospi_frames[vospi_held];
+    }
+    NVIC_EnableIRQ(LEPTON_SPI_DMA_IRQn);
+    return frame;
 }
 
 static int sleep(sensor_t *sensor, int enable)
@@ -321,6 +381,22 @@ static int ioctl(sensor_t *sensor, int request, va_list ap)
             *ptr_max_temp = max_temp;
             break;
         }
+        case IOCTL_LEPTON_GET_FRAME: {
+            // The raw big-endian 14/16-bit frame, valid until the next snapshot or call.
+            uint8_t **frame = va_arg(ap, uint8_t **);
+            *frame = lepton_vospi_take(false);
+            ret = (*frame != NULL) ? 0 : -1;
+            break;
+        }
+        case IOCTL_LEPTON_GET_STATS: {
+            uint32_t *frames = va_arg(ap, uint32_t *);
+            uint32_t *crc_errors = va_arg(ap, uint32_t *);
+            uint32_t *resyncs = va_arg(ap, uint32_t *);
+            *frames = vospi_frame_count;
+            *crc_errors = vospi_crc_errors;
+            *resyncs = vospi_resyncs;
+            break;
+        }
         default: {
             ret = -1;
             break;
@@ -333,6 +409,12 @@ static int ioctl(sensor_t *sensor, int request, va_list ap)
 
 static int lepton_reset(sensor_t *sensor, bool measurement_mode)
 {
+    // The frames of the old settings are gone.
+    lepton_vospi_stop(false);
+    vospi_fill = 0;
+    vospi_ready = VOSPI_NO_FRAME;
+    vospi_held = VOSPI_NO_FRAME;
+
     DCMI_PWDN_LOW();
     systick_sleep(10);
 
@@ -407,8 +489,8 @@ static int lepton_reset(sensor_t *sensor, bool measurement_mode)
         vospi_packets = 60;
     }
 
-    // resync and enable DMA before the first snapshot.
-    vospi_resync = true;
+    // The capture starts once VoSPI timed out.
+    lepton_vospi_stop(true);
     return 0;
 }
 
@@ -425,24 +507,43 @@ static int reset(sensor_t *sensor)
     return lepton_reset(sensor, false);
 }
 
-void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+static void lepton_vospi_frame_done(void)
 {
-    (void) lepton_calc_crc; // to shut the compiler up.
+    vospi_ready = vospi_fill;
+    vospi_frame_count++;
+    // of three slots one is neither the newest nor held
+    for (int i = 0; i < VOSPI_FRAMES; i++) {
+        if ((i != vospi_ready) && (i != vospi_held)) {
+            vospi_fill = i;
+            break;
+        }
+    }
+}
 
-    if (vospi_resync == true) {
-        return; // nothing to do here
+static void lepton_vospi_done(void *arg, status_t status)
+{
+    uint8_t *packet = arg;
+    bool resync = (status != kStatus_Success);
+
+    if (vospi_state != VOSPI_RUN) {
+        return; // being stopped
     }
 
-    if (vospi_pid < vospi_packets && (vospi_packet[0] & 0xF) != 0xF) {
-        uint32_t pid = VOSPI_HEADER_PID(vospi_packet);
-        uint32_t seg = VOSPI_HEADER_SEG(vospi_packet);
-        if (pid != (vospi_pid % VOSPI_NUMBER_PACKETS)) {
+    if (!resync && (packet[0] & 0xF) != 0xF) {
+        uint32_t pid = VOSPI_HEADER_PID(packet);
+        uint32_t seg = VOSPI_HEADER_SEG(packet);
+        if (VOSPI_HEADER_CRC(packet) != lepton_calc_crc(packet)) {
+            // Lose the frame, not the sync: the next one starts at its first packet.
+            vospi_crc_errors++;
+            vospi_pid = VOSPI_FIRST_PACKET;
+            vospi_seg = VOSPI_FIRST_SEGMENT;
+        } else if (pid != (vospi_pid % VOSPI_NUMBER_PACKETS)) {
             if (vospi_pid == VOSPI_FIRST_PACKET) {
                 // Wait for the first packet of the first segement.
                 vospi_pid = VOSPI_FIRST_PACKET;
                 vospi_seg = VOSPI_FIRST_SEGMENT;
             } else { // lost sync
-                vospi_resync = true;
+                resync = true;
                 debug_printf("lost sync, packet id:%lu expected id:%lu \n", pid, vospi_pid);
             }
         } else if (vospi_packets > 60 && pid == VOSPI_SPECIAL_PACKET && seg != vospi_seg ) {
@@ -451,17 +552,29 @@ void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
                 vospi_pid = VOSPI_FIRST_PACKET;
                 vospi_seg = VOSPI_FIRST_SEGMENT;
             } else { // lost sync
-                vospi_resync = true;
+                resync = true;
                 debug_printf("lost sync, segment id:%lu expected id:%lu\n", seg, vospi_seg);
             }
         } else {
-            memcpy(vospi_buffer + vospi_pid * VOSPI_LINE_SIZE,
-                    vospi_packet + VOSPI_HEADER_SIZE, VOSPI_LINE_SIZE);
+            memcpy(vospi_frames[vospi_fill] + vospi_pid * VOSPI_LINE_SIZE,
+                    packet + VOSPI_HEADER_SIZE, VOSPI_LINE_SIZE);
             if ((++vospi_pid % VOSPI_NUMBER_PACKETS) == 0) {
                 vospi_seg++;
             }
+            if (vospi_pid == vospi_packets) {
+                lepton_vospi_frame_done();
+                vospi_pid = VOSPI_FIRST_PACKET;
+                vospi_seg = VOSPI_FIRST_SEGMENT;
+            }
         }
     }
+
+    if (resync) {
+        vospi_resyncs++;
+        lepton_vospi_stop(true);
+    } else {
+        lepton_vospi_queue(packet, 0);
+    }
 }
 
 static int sensor_check_buffsize(sensor_t *sensor)
@@ -503,24 +616,15 @@ static int snapshot(sensor_t *sensor, image_t *image, streaming_cb_t streaming_c
     bool streaming = (streaming_cb != NULL); // Streaming mode.
 
     do {
-        // The SPI DMA device is always clocking the FLIR Lepton in the background.
-        // The code below resets the vospi control values to let data be pulled in.
-        // If we need to re-sync we do it. Otherwise, after we finish pulling data
-        // in we exit and let the SPI bus keep running. Then on the next call to
-        // snapshot we read in more data and pull in the next frame.
-        HAL_NVIC_DisableIRQ(LEPTON_SPI_DMA_IRQn);
-        vospi_pid = VOSPI_FIRST_PACKET;
-        vospi_seg = VOSPI_FIRST_SEGMENT;
-        HAL_NVIC_EnableIRQ(LEPTON_SPI_DMA_IRQn);
+        // The capture runs in the background and keeps the newest frame, take it or
+        // wait for the next one.
+        uint8_t *frame;
 
         // Snapshot start tick
         uint32_t tick_start = HAL_GetTick();
         bool reset_tried = false;
 
-        do {
-            if (vospi_resync == true) {
-                lepton_sync();
-            }
+        while ((frame = lepton_vospi_take(true)) == NULL) {
             if (frame_ready == true && streaming_cb != NULL) {
                 // Start streaming the frame while a new one is captured.
                 streaming = streaming_cb(image);
@@ -545,14 +649,8 @@ static int snapshot(sensor_t *sensor, image_t *image, streaming_cb_t streaming_c
                 if (ret < 0) {
                     return -1;
                 }
-
-                // Reset the VOSPI interface again.
-                HAL_NVIC_DisableIRQ(LEPTON_SPI_DMA_IRQn);
-                vospi_pid = VOSPI_FIRST_PACKET;
-                vospi_seg = VOSPI_FIRST_SEGMENT;
-                HAL_NVIC_EnableIRQ(LEPTON_SPI_DMA_IRQn);
             }
-        } while (vospi_pid < vospi_packets); // only checking one volatile var so atomic.
+        }
 
         MAIN_FB()->w = MAIN_FB()->u;
         MAIN_FB()->h = MAIN_FB()->v;
@@ -576,7 +674,7 @@ static int snapshot(sensor_t *sensor, image_t *image, streaming_cb_t streaming_c
         image->bpp = MAIN_FB()->bpp; // invalid
         image->data = MAIN_FB()->pixels; // valid
 
-        uint16_t *src = (uint16_t*) vospi_buffer;
+        uint16_t *src = (uint16_t*) frame;
 
         float x_scale = resolution[sensor->framesize][0] / ((float) h_res);
         float y_scale = resolution[sensor->framesize][1] / ((float) v_res);
@@ -678,65 +776,8 @@ int lepton_init(sensor_t *sensor)
     SENSOR_HW_FLAGS_SET(sensor, SENSOR_HW_FLAGS_FSYNC, 0);
     SENSOR_HW_FLAGS_SET(sensor, SENSOR_HW_FLAGS_JPEGE, 0);
 
-    // Configure the DMA handler for Transmission process
-    DMAHandle.Instance                 = LEPTON_SPI_DMA_STREAM;
-    DMAHandle.Init.Request             = LEPTON_SPI_DMA_REQUEST;
-    DMAHandle.Init.Mode                = DMA_CIRCULAR;
-    DMAHandle.Init.Priority            = DMA_PRIORITY_HIGH;
-    DMAHandle.Init.Direction           = DMA_PERIPH_TO_MEMORY;
-    // When the DMA is configured in direct mode (the FIFO is disabled), the source and
-    // destination transfer widths are equal, and both defined by PSIZE (MSIZE is ignored).
-    // Additionally, burst transfers are not possible (MBURST and PBURST are both ignored).
-    DMAHandle.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
-    DMAHandle.Init.FIFOThreshold       = DMA_FIFO_THRESHOLD_FULL;
-    // Note MBURST and PBURST are ignored.
-    DMAHandle.Init.MemBurst            = DMA_MBURST_INC4;
-    DMAHandle.Init.PeriphBurst         = DMA_PBURST_INC4;
-    DMAHandle.Init.MemDataAlignment    = DMA_MDATAALIGN_WORD;
-    DMAHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
-    DMAHandle.Init.MemInc              = DMA_MINC_ENABLE;
-    DMAHandle.Init.PeriphInc           = DMA_PINC_DISABLE;
-
-    // NVIC configuration for DMA transfer complete interrupt
-    NVIC_SetPriority(LEPTON_SPI_DMA_IRQn, IRQ_PRI_DMA21);
-    HAL_NVIC_DisableIRQ(LEPTON_SPI_DMA_IRQn);
-
-    HAL_DMA_DeInit(&DMAHandle);
-    if (HAL_DMA_Init(&DMAHandle) != HAL_OK) {
-        // Initialization Error
-        return -1;
-    }
-
-    memset(&SPIHandle, 0, sizeof(SPIHandle));
-    SPIHandle.Instance               = LEPTON_SPI;
-    SPIHandle.Init.NSS               = SPI_NSS_HARD_OUTPUT;
-    SPIHandle.Init.NSSPMode          = SPI_NSS_PULSE_DISABLE;
-    SPIHandle.Init.NSSPolarity       = SPI_NSS_POLARITY_LOW;
-    SPIHandle.Init.Mode              = SPI_MODE_MASTER;
-    SPIHandle.Init.TIMode            = SPI_TIMODE_DISABLE;
-    SPIHandle.Init.Direction         = SPI_DIRECTION_2LINES_RXONLY;
-    SPIHandle.Init.DataSize          = SPI_DATASIZE_8BIT;
-    SPIHandle.Init.FifoThreshold     = SPI_FIFO_THRESHOLD_04DATA;
-    SPIHandle.Init.FirstBit          = SPI_FIRSTBIT_MSB;
-    SPIHandle.Init.CLKPhase          = SPI_PHASE_2EDGE;
-    SPIHandle.Init.CLKPolarity       = SPI_POLARITY_HIGH;
-    SPIHandle.Init.BaudRatePrescaler = LEPTON_SPI_PRESCALER;
-    // Recommanded setting to avoid glitches
-    SPIHandle.Init.MasterKeepIOState = SPI_MASTER_KEEP_IO_STATE_ENABLE;
-
-    if (HAL_SPI_Init(&SPIHandle) != HAL_OK) {
-        LEPTON_SPI_RESET();
-        LEPTON_SPI_RELEASE();
-        LEPTON_SPI_CLK_DISABLE();
-        return -1;
-    }
-
-    // Associate the initialized DMA handle to the the SPI handle
-    __HAL_LINKDMA(&SPIHandle, hdmarx, DMAHandle);
-
-    // NVIC configuration for SPI transfer complete interrupt
-    NVIC_SetPriority(LEPTON_SPI_IRQn, IRQ_PRI_DCMI);
-    HAL_NVIC_EnableIRQ(LEPTON_SPI_IRQn);
+    // VoSPI is mode 3, reset() starts the capture.
+    spi_init_master(LEPTON_SPI_BUS, LEPTON_SPI_BAUDRATE, 1, 1);
 
     return 0;
 }
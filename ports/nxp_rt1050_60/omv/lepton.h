@@ -13,4 +13,6 @@
 #include "sensor.h"
 #define LEPTON_XCLK_FREQ 24000000
 int lepton_init(sensor_t *sensor);
+// Restarts the VoSPI capture after a resync, from the systick.
+void lepton_tick_handler(uint32_t tick);
 #endif // __LEPTON_H__
@@ -16,9 +16,28 @@ caffe_layers = {
     'convolution'   : 1,
     'relu'          : 2,
     'pooling'       : 3,
-    'innerproduct'  : 4
+    'innerproduct'  : 4,
+    'depthwise'     : 5,
+    'pointwise'     : 6
 }
 
+def get_layer_type(caffe_model, layer):
+    """Returns the converter layer type, grouped convolutions with one
+       input channel per group are depthwise and 1x1 convolutions are pointwise"""
+    layer_type = caffe_model.layer_type[layer]
+    if layer_type == 'depthwiseconvolution':
+        return 'depthwise'
+    if layer_type == 'convolution':
+        wt_shape = caffe_model.layer_wt_shape[layer]
+        if caffe_model.group[layer] > 1 and wt_shape[1] == 1:
+            return 'depthwise'
+        if caffe_model.group[layer] > 1:
+            print("Grouped convolution %s is not supported, can't convert this network."%(layer))
+            sys.exit(1)
+        if caffe_model.kernel_size[layer] == 1:
+            return 'pointwise'
+    return layer_type
+
 def get_mean_values(mean_file):
     mean_vals = [0, 0, 0]
     if (mean_file):
@@ -75,6 +94,47 @@ def convert_to_x4_weights(weights):
         counter = counter + 4
     return new_weights
 
+def arena_align(size):
+    return (size + 3) & ~3
+
+def plan_network(layers):
+    """Plans the activation arena, must match nn_plan_network() in nn.c.
+       Every step only needs its input, output and scratch buffer: the input and
+       output sit at opposite ends of the arena and swap ends every layer, the
+       scratch buffer goes in the gap and ReLU works in place. The last layer
+       writes to the network output instead of the arena."""
+    sizes = []
+    for i, (layer_type, shape, k_size) in enumerate(layers):
+        if layer_type == 'relu':
+            sizes += [(0, 0, 0)]
+            continue
+        prev = layers[i-1][1] if i > 0 else [0, 0, 0, 0]
+        in_size = arena_align(prev[1]*prev[2]*prev[3])
+        out_size = 0 if i == len(layers)-1 else arena_align(shape[1]*shape[2]*shape[3])
+        col_size = {
+            'convolution'  : 2*2*prev[1]*k_size*k_size,
+            'depthwise'    : 2*prev[1]*k_size*k_size,
+            'pointwise'    : 2*2*prev[1],
+            'pooling'      : 2*shape[3]*prev[1],
+            'innerproduct' : 2*prev[1]*prev[2]*prev[3],
+        }.get(layer_type, 0)
+        sizes += [(in_size, arena_align(col_size), out_size)]
+
+    arena_size = max(sum(x) for x in sizes)
+    plan = []
+    in_top = True
+    for i, (layer_type, shape, k_size) in enumerate(layers):
+        if layer_type == 'relu':
+            plan += [(plan[-1][0], 0)]
+            continue
+        in_size, col_size, out_size = sizes[i]
+        if in_top:
+            plan += [(0, out_size)]
+        else:
+            plan += [(arena_size - out_size, in_size)]
+        in_top = not in_top
+    return arena_size, plan
+
 def dump_network(caffe_model, file_name):
     fout = open(file_name, 'wb')
     net = caffe.Net(caffe_model.model_file, caffe_model.quant_weight_file, caffe.TEST)
@@ -85,7 +145,7 @@ def dump_network(caffe_model, file_name):
     num_layers = 0
     # Check and count layers
     for layer in caffe_model.layer:
-        layer_type = caffe_model.layer_type[layer]
+        layer_type = get_layer_type(caffe_model, layer)
         if layer_type in caffe_layers:
             num_layers += 1
         elif layer_type != 'accuracy':
@@ -95,9 +155,12 @@ def dump_network(caffe_model, file_name):
     # Write number of layers
     fout.write(struct.pack('i', num_layers))
 
+    # Layer type, shape and kernel size for the arena plan
+    plan_layers = []
+
     for layer in caffe_model.layer:
         layer_no = caffe_model.layer.index(layer)
-        layer_type = caffe_model.layer_type[layer]
+        layer_type = get_layer_type(caffe_model, layer)
 
         if not layer_type in caffe_layers:
             print('NOTE: skipping layer "%s"' %(layer_type))
@@ -116,6 +179,7 @@ def dump_network(caffe_model, file_name):
         caffe_model.layer_shape[layer] = shape
 
         print('Layer: {0: <8} Type: {1: <15}Shape: {2: <20}'.format(layer, layer_type, str(shape)))
+        plan_layers += [(layer_type, shape, caffe_model.kernel_size.get(layer, 1))]
 
         if layer_type == 'data':
             # Write r_mean, g_mean, b_mean
@@ -128,23 +192,27 @@ def dump_network(caffe_model, file_name):
             # Write pool type
             fout.write(struct.pack('i', caffe_model.pool_type[layer]))
 
-        if layer_type in ['convolution', 'innerproduct']:
+        if layer_type in ['convolution', 'depthwise', 'pointwise', 'innerproduct']:
             # Write lshift, rshift
             fout.write(struct.pack('i', max(0, caffe_model.bias_lshift[layer])))
             fout.write(struct.pack('i', max(0, caffe_model.act_rshift[layer])))
 
-        if layer_type in ['convolution', 'pooling']:
+        if layer_type in ['convolution', 'depthwise', 'pointwise', 'pooling']:
             # Write k_size, k_pad, k_stride
             fout.write(struct.pack('i', caffe_model.kernel_size[layer]))
             fout.write(struct.pack('i', caffe_model.pad[layer]))
             fout.write(struct.pack('i', caffe_model.stride[layer]))
 
-        if layer_type == 'convolution':
+        if layer_type in ['convolution', 'depthwise', 'pointwise']:
             net.params[layer][0].data[:] = np.round(net.params[layer][0].data*(2**caffe_model.wt_dec_bits[layer]))
             net.params[layer][1].data[:] = np.round(net.params[layer][1].data*(2**caffe_model.bias_dec_bits[layer]))
 
-            #CHW to HWC layout conversion
-            reordered_wts = np.swapaxes(np.swapaxes(net.params[layer][0].data, 1, 2), 2, 3).flatten()
+            if layer_type == 'depthwise':
+                # (C_out, 1, H, W) to HWC_out, output channel is the innermost
+                reordered_wts = np.transpose(net.params[layer][0].data[:, 0, :, :], (1, 2, 0)).flatten()
+            else:
+                #CHW to HWC layout conversion
+                reordered_wts = np.swapaxes(np.swapaxes(net.params[layer][0].data, 1, 2), 2, 3).flatten()
 
             # Write weights size and array
             fout.write(struct.pack('i', len(reordered_wts)))
@@ -178,6 +246,14 @@ def dump_network(caffe_model, file_name):
             fout.write(struct.pack('i', len(net.params[layer][1].data)))
             for i in net.params[layer][1].data: fout.write(struct.pack('b', int(i)))
 
+    # Write the activation arena size and per layer output/scratch offsets
+    arena_size, plan = plan_network(plan_layers)
+    fout.write(struct.pack('4c', b'P', b'L', b'A', b'N'))
+    fout.write(struct.pack('i', arena_size))
+    for out_offset, col_offset in plan:
+        fout.write(struct.pack('2i', out_offset, col_offset))
+    print('Activation arena: %d bytes'%(arena_size))
+
     fout.close()
 
 
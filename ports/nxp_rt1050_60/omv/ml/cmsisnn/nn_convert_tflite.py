@@ -0,0 +1,235 @@
+# This file is part of the OpenMV project.
+# Copyright (c) 2013-2017 Ibrahim Abdelkader <iabdalkader@openmv.io> & Kwabena W. Agyeman <kwagyeman@openmv.io>
+# This work is licensed under the MIT license, see the file LICENSE for details.
+#
+# TFLite int8 to CMSIS NN binary converter.
+#
+# Full integer quantized TFLite models (int8 activations, per channel int8 weights)
+# are written as _S8 layers, which nn.load() runs with the same arena, profiler and
+# flash model store as the Caffe networks.
+
+import numpy as np
+import struct, sys, argparse, math
+import tflite
+from tflite.BuiltinOperator import BuiltinOperator
+from tflite.ActivationFunctionType import ActivationFunctionType
+from tflite.Padding import Padding
+
+nn_layers = {
+    'data'          : 0,
+    'pooling'       : 3,
+    'conv_s8'       : 7,
+    'dwconv_s8'     : 8,
+    'ip_s8'         : 9
+}
+
+# Ops without any work in the HWC arena.
+skip_ops = [BuiltinOperator.RESHAPE, BuiltinOperator.QUANTIZE, BuiltinOperator.DEQUANTIZE, BuiltinOperator.SOFTMAX]
+
+# Input ranges the image is scaled to before the model's own input quantization.
+input_ranges = {
+    '0_1'   : (1.0/255.0, 0.0),
+    '-1_1'  : (2.0/255.0, -1.0),
+    '0_255' : (1.0, 0.0)
+}
+
+def op_code(model, op):
+    code = model.OperatorCodes(op.OpcodeIndex())
+    return max(code.BuiltinCode(), code.DeprecatedBuiltinCode())
+
+def op_options(op, cls):
+    table = op.BuiltinOptions()
+    options = cls()
+    options.Init(table.Bytes, table.Pos)
+    return options
+
+def tensor_quant(tensor):
+    q = tensor.Quantization()
+    return q.ScaleAsNumpy(), q.ZeroPointAsNumpy()
+
+def tensor_data(model, tensor, dtype):
+    return np.frombuffer(model.Buffers(tensor.Buffer()).DataAsNumpy().tobytes(), dtype=dtype)
+
+def hwc_shape(tensor):
+    """NHWC or NC tensor shape to the runtime's (n, c, h, w)"""
+    shape = list(tensor.ShapeAsNumpy())
+    if len(shape) == 4:
+        return [1, shape[3], shape[1], shape[2]]
+    return [1, int(np.prod(shape[1:])), 1, 1]
+
+def quantize_multiplier(scale):
+    """Real multiplier to a Q31 mantissa and power of two shift, as TFLite's QuantizeMultiplier()"""
+    if scale == 0:
+        return 0, 0
+    m, shift = math.frexp(scale)
+    q = int(round(m * (1 << 31)))
+    if q == (1 << 31):
+        q //= 2
+        shift += 1
+    if shift < -31:
+        return 0, 0
+    return q, shift
+
+def activation_range(activation, scale, zero_point):
+    act_min, act_max = -128, 127
+    if activation == ActivationFunctionType.RELU:
+        act_min = max(act_min, zero_point)
+    elif activation == ActivationFunctionType.RELU6:
+        act_min = max(act_min, zero_point)
+        act_max = min(act_max, zero_point + int(round(6.0 / scale)))
+    elif activation == ActivationFunctionType.RELU_N1_TO_1:
+        act_min = max(act_min, zero_point + int(round(-1.0 / scale)))
+        act_max = min(act_max, zero_point + int(round(1.0 / scale)))
+    elif activation != ActivationFunctionType.NONE:
+        print("Fused activation %d is not supported, can't convert this network."%(activation))
+        sys.exit(1)
+    return act_min, act_max
+
+def same_padding(in_size, out_size, k_size, stride):
+    """Top/left padding, TFLite puts the odd pixel at the bottom/right"""
+    return max((out_size - 1) * stride + k_size - in_size, 0) // 2
+
+def write_array(fout, fmt, data):
+    fout.write(struct.pack('i', len(data)))
+    fout.write(struct.pack('%d%s'%(len(data), fmt), *[int(x) for x in data]))
+
+def write_weights(fout, wts):
+    # Pad to a word so the int32 arrays after it stay aligned when run from flash.
+    wts = list(wts) + [0] * (-len(wts) % 4)
+    write_array(fout, 'b', wts)
+
+def dump_network(model_file, output_file, input_range):
+    buf = open(model_file, 'rb').read()
+    model = tflite.Model.GetRootAsModel(buf, 0)
+    graph = model.Subgraphs(0)
+    layers = []
+
+    # Model input, after the QUANTIZE op of float input models.
+    input_tensor = graph.Tensors(graph.Inputs(0))
+    for i in range(graph.OperatorsLength()):
+        op = graph.Operators(i)
+        if op_code(model, op) == BuiltinOperator.QUANTIZE and op.Inputs(0) == graph.Inputs(0):
+            input_tensor = graph.Tensors(op.Outputs(0))
+
+    in_scale, in_zp = tensor_quant(input_tensor)
+    a, b = input_ranges[input_range]
+    ratio = a / in_scale[0]
+    k = int(round(math.log(ratio, 2)))
+    if abs(ratio - 2**k) > (0.02 * 2**k) or (7 - k) < 1:
+        print("Input scale %f can't be done with a power of two, can't convert this network."%(in_scale[0]))
+        sys.exit(1)
+    mean = int(round(-(b / in_scale[0] + in_zp[0]) / 2**k))
+    layers += [('data', hwc_shape(input_tensor), struct.pack('4i', mean, mean, mean, 7 - k))]
+
+    for i in range(graph.OperatorsLength()):
+        op = graph.Operators(i)
+        code = op_code(model, op)
+        if code in skip_ops:
+            print('NOTE: skipping op %d'%(code))
+            continue
+
+        inp = graph.Tensors(op.Inputs(0))
+        out = graph.Tensors(op.Outputs(0))
+        in_shape, out_shape = hwc_shape(inp), hwc_shape(out)
+        in_scale, in_zp = tensor_quant(inp)
+        out_scale, out_zp = tensor_quant(out)
+
+        if code in [BuiltinOperator.CONV_2D, BuiltinOperator.DEPTHWISE_CONV_2D, BuiltinOperator.FULLY_CONNECTED]:
+            wt = graph.Tensors(op.Inputs(1))
+            wt_shape = list(wt.ShapeAsNumpy())
+            wt_scale, _ = tensor_quant(wt)
+            wts = tensor_data(model, wt, np.int8)
+            channels = out_shape[1]
+            if op.InputsLength() > 2 and op.Inputs(2) >= 0:
+                bias = tensor_data(model, graph.Tensors(op.Inputs(2)), np.int32)
+            else:
+                bias = np.zeros(channels, dtype=np.int32)
+
+            # Per channel requantization, per tensor weights are repeated.
+            wt_scale = np.resize(wt_scale, channels)
+            mult, shift = zip(*[quantize_multiplier(in_scale[0] * s / out_scale[0]) for s in wt_scale])
+
+            if code == BuiltinOperator.FULLY_CONNECTED:
+                options = op_options(op, tflite.FullyConnectedOptions)
+                layer_type = 'ip_s8'
+                params = b''
+            else:
+                if code == BuiltinOperator.CONV_2D:
+                    options = op_options(op, tflite.Conv2DOptions)
+                    layer_type = 'conv_s8'
+                    k_h, k_w = wt_shape[1], wt_shape[2]
+                else:
+                    options = op_options(op, tflite.DepthwiseConv2DOptions)
+                    layer_type = 'dwconv_s8'
+                    k_h, k_w = wt_shape[1], wt_shape[2]
+                stride = options.StrideW()
+                if k_h != k_w or stride != options.StrideH():
+                    print("Non-square kernels and strides are not supported, can't convert this network.")
+                    sys.exit(1)
+                if options.DilationWFactor() != 1 or options.DilationHFactor() != 1:
+                    print("Dilated convolutions are not supported, can't convert this network.")
+                    sys.exit(1)
+                pad = 0
+                if options.Padding() == Padding.SAME:
+                    pad = same_padding(in_shape[2], out_shape[2], k_h, stride)
+                params = struct.pack('3i', k_h, pad, stride)
+
+            act_min, act_max = activation_range(options.FusedActivationFunction(), out_scale[0], int(out_zp[0]))
+            record = struct.pack('4i', -int(in_zp[0]), int(out_zp[0]), act_min, act_max) + params
+            layers += [(layer_type, out_shape, (record, wts, bias, mult, shift))]
+
+        elif code in [BuiltinOperator.MAX_POOL_2D, BuiltinOperator.AVERAGE_POOL_2D]:
+            options = op_options(op, tflite.Pool2DOptions)
+            k_size, stride = options.FilterWidth(), options.StrideW()
+            if k_size != options.FilterHeight() or stride != options.StrideH():
+                print("Non-square pooling is not supported, can't convert this network.")
+                sys.exit(1)
+            if options.FusedActivationFunction() != ActivationFunctionType.NONE:
+                print("Fused activation on pooling is not supported, can't convert this network.")
+                sys.exit(1)
+            pad = 0
+            if options.Padding() == Padding.SAME:
+                pad = same_padding(in_shape[2], out_shape[2], k_size, stride)
+            ptype = 0 if code == BuiltinOperator.MAX_POOL_2D else 1
+            layers += [('pooling', out_shape, struct.pack('4i', ptype, k_size, pad, stride))]
+
+        else:
+            print("Op %d is not supported, can't convert this network."%(code))
+            sys.exit(1)
+
+    fout = open(output_file, 'wb')
+
+    # Write network type
+    fout.write(struct.pack('4c', b'T', b'F', b'S', b'8'))
+
+    # Write number of layers
+    fout.write(struct.pack('i', len(layers)))
+
+    for layer_type, shape, data in layers:
+        print('Type: {0: <15}Shape: {1: <20}'.format(layer_type, str(shape)))
+        # Write layer type code and shape (n, c, h, w)
+        fout.write(struct.pack('i', nn_layers[layer_type]))
+        fout.write(struct.pack('4i', *shape))
+        if layer_type in ['data', 'pooling']:
+            fout.write(data)
+        else:
+            record, wts, bias, mult, shift = data
+            fout.write(record)
+            write_weights(fout, wts)
+            write_array(fout, 'i', bias)
+            fout.write(struct.pack('%di'%(len(mult)), *mult))
+            fout.write(struct.pack('%di'%(len(shift)), *shift))
+
+    # No PLAN section, nn.load() plans the arena for _S8 layers.
+    fout.close()
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--model', type=str, help='int8 quantized tflite model')
+    parser.add_argument('--input_range', type=str, default='0_1', choices=input_ranges.keys(),
+                        help='range the model expects its input pixels in')
+    parser.add_argument('--output',type=str, default="model.network", help='output file')
+
+    args, _ = parser.parse_known_args()
+    dump_network(args.model, args.output, args.input_range)
@@ -38,6 +38,7 @@ class Caffe_Quantizer(object):
         self.quant_weight_file=""
         self.conv_layer=[]
         self.ip_layer=[]
+        self.fused_relu=[]
         self.start_layer=[]
         self.end_layer=[]
         self.layer=[]
@@ -81,6 +82,7 @@ class Caffe_Quantizer(object):
         self.quant_weight_file=model_par.quant_weight_file
         self.conv_layer=model_par.conv_layer
         self.ip_layer=model_par.ip_layer
+        self.fused_relu=getattr(model_par,'fused_relu',[])
         self.start_layer=model_par.start_layer
         self.end_layer=model_par.end_layer
         self.layer=model_par.layer
@@ -152,6 +154,81 @@ class Caffe_Quantizer(object):
         print("Accuracy with quantized weights/biases and activations: %.2f%%" %(accuracy))
         return accuracy
 
+    #   Fold BatchNorm (and the Scale layer after it) into the preceding convolution/innerproduct
+    #       w' = w * gamma / sqrt(var + eps)
+    #       b' = (b - mean) * gamma / sqrt(var + eps) + beta
+    #   The folded model and weights are saved next to the originals and used from here on.
+
+    def fold_batchnorm(self):
+        net=caffe_pb2.NetParameter()
+        text_format.Merge(open(self.model_file,'r').read(),net)
+        if len(net.layer)==0:   #V1 "layers" prototxts have no BatchNorm layer
+            return
+        producer={}
+        folds={}
+        for layer in net.layer:
+            layer_type = str(layer.type).lower()
+            if layer_type in ['convolution','depthwiseconvolution','innerproduct']:
+                producer[str(layer.top[0])] = layer
+            elif layer_type == 'batchnorm' and str(layer.bottom[0]) in producer:
+                conv = producer.pop(str(layer.bottom[0]))
+                folds[str(conv.name)] = [conv, layer, None]
+                producer[str(layer.top[0])] = conv
+            elif layer_type == 'scale' and str(layer.bottom[0]) in producer and \
+                    str(producer[str(layer.bottom[0])].name) in folds and \
+                    folds[str(producer[str(layer.bottom[0])].name)][2] is None:
+                conv = producer.pop(str(layer.bottom[0]))
+                folds[str(conv.name)][2] = layer
+                producer[str(layer.top[0])] = conv
+            else:
+                for val in layer.top:
+                    producer.pop(str(val), None)
+        if len(folds)==0:
+            return
+
+        cnn = caffe.Net(self.model_file,self.weight_file,caffe.TEST)
+        folded_params={}
+        removed=[]
+        for name, (conv, bn, scale) in folds.items():
+            wt = cnn.params[name][0].data
+            out_ch = wt.shape[0]
+            bias = cnn.params[name][1].data if len(cnn.params[name])>1 else np.zeros(out_ch)
+            bn_scale = cnn.params[str(bn.name)][2].data[0]
+            bn_scale = 0 if bn_scale==0 else 1.0/bn_scale
+            mean = cnn.params[str(bn.name)][0].data*bn_scale
+            var = cnn.params[str(bn.name)][1].data*bn_scale
+            gamma = np.ones(out_ch)
+            beta = np.zeros(out_ch)
+            if scale is not None:
+                gamma = cnn.params[str(scale.name)][0].data
+                if len(cnn.params[str(scale.name)])>1:
+                    beta = cnn.params[str(scale.name)][1].data
+            factor = gamma/np.sqrt(var+bn.batch_norm_param.eps)
+            folded_params[name] = [wt*factor.reshape((out_ch,)+(1,)*(wt.ndim-1)), (bias-mean)*factor+beta]
+            # The folded layer writes the blob BN/Scale used to write.
+            conv.top[0] = (scale if scale is not None else bn).top[0]
+            if str(conv.type).lower() == 'innerproduct':
+                conv.inner_product_param.bias_term = True
+            else:
+                conv.convolution_param.bias_term = True
+            removed += [str(bn.name)] + ([str(scale.name)] if scale is not None else [])
+
+        kept = [layer for layer in net.layer if str(layer.name) not in removed]
+        del net.layer[:]
+        net.layer.extend(kept)
+        model_file = os.path.splitext(self.model_file)[0]+'_folded.prototxt'
+        weight_file = os.path.splitext(self.weight_file)[0]+'_folded.caffemodel'
+        open(model_file,'w').write(text_format.MessageToString(net))
+        folded = caffe.Net(model_file,caffe.TEST)
+        for name in folded.params:
+            params = folded_params[name] if name in folded_params else [p.data for p in cnn.params[name]]
+            for i in range(0,len(folded.params[name])):
+                folded.params[name][i].data[:] = params[i]
+        folded.save(weight_file)
+        print('Folded BatchNorm into: '+', '.join(folds.keys()))
+        self.model_file = model_file
+        self.weight_file = weight_file
+
     def get_layer_info(self):
         net=caffe_pb2.NetParameter()
         text_format.Merge(open(self.model_file,'r').read(),net)
@@ -174,7 +251,7 @@ class Caffe_Quantizer(object):
             self.bottom_blob[str(layer.name)]=layer_name
             self.layer_type[str(layer.name)] = str(layer.type).lower()
 
-            if str(layer.type).lower() == 'convolution' or str(layer.type)=='4':
+            if str(layer.type).lower() in ['convolution','depthwiseconvolution'] or str(layer.type)=='4':
                 self.layer_wt_shape[str(layer.name)]=cnn.params[self.top_blob[str(layer.name)][0]][0].data.shape
                 self.conv_layer.append(str(layer.name))
                 self.kernel_size[str(layer.name)] = layer.convolution_param.kernel_size[0]
@@ -216,7 +293,7 @@ class Caffe_Quantizer(object):
 
         net=caffe_pb2.NetParameter()
         text_format.Merge(open(self.model_file,'r').read(),net)
-        allowed_layer_types = ['data','convolution','innerproduct','pooling','lrn','relu',\
+        allowed_layer_types = ['data','convolution','depthwiseconvolution','innerproduct','pooling','lrn','relu',\
             'accuracy','concat','5','4','14','17','15','18','1','3']
         current_layer = self.accuracy_layer
         traversed=[]
@@ -246,6 +323,12 @@ class Caffe_Quantizer(object):
         traversed.reverse()
         self.layer=traversed[:]
 
+        # A ReLU right after a convolution runs fused with it, its activations are quantized post-ReLU.
+        for layer_no in range(1,len(self.layer)):
+            if self.layer[layer_no-1] in self.conv_layer and \
+                    (self.layer_type[self.layer[layer_no]]=='relu' or self.layer_type[self.layer[layer_no]]=='18'):
+                self.fused_relu+=[self.layer[layer_no-1]]
+
         self.start_layer+=['']
         for layer_no in range(0,len(self.layer)):
             layer = self.layer[layer_no]
@@ -377,6 +460,8 @@ class Caffe_Quantizer(object):
                     net.forward(start=str(self.start_layer[layer_no]),end=str(self.end_layer[layer_no]))
                 layer_max = net.blobs[self.end_layer[layer_no]].data.max()
                 layer_min = net.blobs[self.end_layer[layer_no]].data.min()
+                if self.end_layer[layer_no] in self.fused_relu:
+                    layer_min = max(layer_min, 0)
                 if(layer_max>max_val[self.end_layer[layer_no]]):
                     max_val[self.end_layer[layer_no]]=layer_max
                 if(layer_min<min_val[self.end_layer[layer_no]]):
@@ -604,6 +689,7 @@ if __name__ == '__main__':
     target_accuracy_layer=cmd_args.accuracy
    
     my_model=Caffe_Quantizer(model_file,weight_file,iterations,accuracy_layer=target_accuracy_layer,gpu=gpu_flag)
+    my_model.fold_batchnorm()
     my_model.get_layer_info()
     my_model.get_graph_connectivity()
     my_model.run_full_network()
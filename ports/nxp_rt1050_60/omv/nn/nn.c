@@ -6,6 +6,8 @@
  *
  */
 #include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
 #include "nn.h"
 #include "imlib.h"
 #include "common.h"
@@ -13,14 +15,18 @@
 #include "arm_math.h"
 #include "arm_nnfunctions.h"
 #include "omv_boardconfig.h"
+#ifdef IMLIB_ENABLE_PXP
+#include "fb_alloc.h"
+#include "pxp_2d.h"
+#endif
 #ifdef IMLIB_ENABLE_CNN
 
 static const char *layer_to_str(layer_type_t type)
 {
     static const char *layers[] = {
-        "DATA", "CONV", "RELU", "POOL", "IP"
+        "DATA", "CONV", "RELU", "POOL", "IP", "DWCONV", "PWCONV", "CONV_S8", "DWCONV_S8", "IP_S8"
     };
-    if (type > sizeof(layers)/sizeof(layers[0])) {
+    if (type >= sizeof(layers)/sizeof(layers[0])) {
         return "Unknown layer";
     } else {
         return layers[type];
@@ -31,66 +37,309 @@ int nn_dump_network(nn_t *net)
 {
     layer_t *layer = net->layers;
     
-    printf("Net type: %4s Num layers: %lu Max layer: %lu Max col buf: %lu Max scratch buf: %lu\n",
-            net->type, net->n_layers, net->max_layer_size, net->max_colbuf_size, net->max_scrbuf_size);
+    printf("Net type: %4s Num layers: %" PRIu32 " Arena: %" PRIu32 "\n", net->type, net->n_layers, net->arena_size);
 
     while (layer != NULL) {
-        printf("Layer: %s Shape: [%lu, %lu, %lu, %lu] ",
-                layer_to_str(layer->type), layer->n, layer->c, layer->h, layer->w);
+        printf("Layer: %s Shape: [%" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %" PRIu32 "] Out: %" PRIu32 " Col: %" PRIu32 " ",
+                layer_to_str(layer->type), layer->n, layer->c, layer->h, layer->w, layer->out_offset, layer->col_offset);
         switch (layer->type) {
             case LAYER_TYPE_DATA: {
                 data_layer_t *data_layer = (data_layer_t *) layer;
-                printf("r_mean: %lu g_mean: %lu b_mean: %lu scale: %lu\n",
+                printf("r_mean: %" PRIu32 " g_mean: %" PRIu32 " b_mean: %" PRIu32 " scale: %" PRIu32 "\n",
                         data_layer->r_mean, data_layer->g_mean, data_layer->b_mean, data_layer->scale);
                 break;
             }
 
-            case LAYER_TYPE_CONV: {
+            case LAYER_TYPE_CONV:
+            case LAYER_TYPE_DWCONV:
+            case LAYER_TYPE_PWCONV: {
                 conv_layer_t *conv_layer = (conv_layer_t *) layer;
-                printf("l_shift: %lu r_shift:%lu k_size: %lu k_stride: %lu k_padding: %lu\n",
+                printf("l_shift: %" PRIu32 " r_shift:%" PRIu32 " k_size: %" PRIu32 " k_stride: %" PRIu32 " k_padding: %" PRIu32 " relu: %" PRIu32 "\n",
                         conv_layer->l_shift, conv_layer->r_shift,
-                        conv_layer->krn_dim, conv_layer->krn_str, conv_layer->krn_pad);
+                        conv_layer->krn_dim, conv_layer->krn_str, conv_layer->krn_pad, conv_layer->relu);
                 break;
             }
 
             case LAYER_TYPE_RELU: {
-                // Nothing to read for RELU layer
-                printf("\n");
-                //relu_layer_t *relu_layer = layer;
+                relu_layer_t *relu_layer = (relu_layer_t *) layer;
+                printf("fused: %" PRIu32 "\n", relu_layer->fused);
                 break;
             }
 
             case LAYER_TYPE_POOL: {
                 pool_layer_t *pool_layer = (pool_layer_t *) layer;
-                printf("k_size: %lu k_stride: %lu k_padding: %lu\n",
-                        pool_layer->krn_dim, pool_layer->krn_str, pool_layer->krn_pad);
+                printf("k_size: %" PRIu32 " k_stride: %" PRIu32 " k_padding: %" PRIu32 " relu: %" PRIu32 "\n",
+                        pool_layer->krn_dim, pool_layer->krn_str, pool_layer->krn_pad, pool_layer->relu);
                 break;
             }
 
             case LAYER_TYPE_IP: {
                 ip_layer_t *ip_layer = (ip_layer_t*) layer;
-                printf("l_shift: %lu r_shift:%lu\n", ip_layer->l_shift, ip_layer->r_shift);
+                printf("l_shift: %" PRIu32 " r_shift:%" PRIu32 "\n", ip_layer->l_shift, ip_layer->r_shift);
+                break;
+            }
+
+            case LAYER_TYPE_CONV_S8:
+            case LAYER_TYPE_DWCONV_S8: {
+                conv_layer_t *conv_layer = (conv_layer_t *) layer;
+                printf("in_offset: %" PRId32 " out_offset: %" PRId32 " act: [%" PRId32 ", %" PRId32 "] k_size: %" PRIu32 " k_stride: %" PRIu32 " k_padding: %" PRIu32 "\n",
+                        conv_layer->quant.in_offset, conv_layer->quant.out_offset,
+                        conv_layer->quant.act_min, conv_layer->quant.act_max,
+                        conv_layer->krn_dim, conv_layer->krn_str, conv_layer->krn_pad);
+                break;
+            }
+
+            case LAYER_TYPE_IP_S8: {
+                ip_layer_t *ip_layer = (ip_layer_t*) layer;
+                printf("in_offset: %" PRId32 " out_offset: %" PRId32 " act: [%" PRId32 ", %" PRId32 "]\n",
+                        ip_layer->quant.in_offset, ip_layer->quant.out_offset,
+                        ip_layer->quant.act_min, ip_layer->quant.act_max);
                 break;
             }
         }
+        if (net->profile_runs) {
+            nn_layer_stats_t stats;
+            nn_layer_stats(layer, &stats);
+            printf("    cycles: %" PRIu32 " macs: %" PRIu32 " read: %" PRIu32 " written: %" PRIu32 "\n", (uint32_t) (layer->cycles / net->profile_runs),
+                    stats.macs, stats.bytes_read, stats.bytes_written);
+        }
         layer = layer->next;
     }
     return 0;
 }
 
-int nn_load_network(nn_t *net, const char *path)
+void nn_profile_reset(nn_t *net)
 {
-    FIL fp;
-    int res = 0;
+    for (layer_t *layer = net->layers; layer != NULL; layer = layer->next) {
+        layer->cycles = 0;
+    }
+    net->profile_runs = 0;
+}
 
-    file_read_open(&fp, path);
-    file_buffer_on(&fp);
+// Work and memory traffic of one forward pass through the layer, fixed by its shape.
+void nn_layer_stats(layer_t *layer, nn_layer_stats_t *stats)
+{
+    layer_t *prev_layer = layer->prev;
+    uint32_t in_size = (prev_layer == NULL) ? 0 : (prev_layer->c * prev_layer->h * prev_layer->w);
+    uint32_t out_size = layer->c * layer->h * layer->w;
+
+    stats->macs = 0;
+    stats->bytes_read = in_size;
+    stats->bytes_written = out_size;
+
+    switch (layer->type) {
+        case LAYER_TYPE_DATA: {
+            // Reads the ROI from the image, which depends on the ROI size.
+            stats->bytes_read = 0;
+            break;
+        }
+
+        case LAYER_TYPE_CONV:
+        case LAYER_TYPE_DWCONV:
+        case LAYER_TYPE_PWCONV:
+        case LAYER_TYPE_CONV_S8:
+        case LAYER_TYPE_DWCONV_S8: {
+            conv_layer_t *conv_layer = (conv_layer_t *) layer;
+            uint32_t krn_size = conv_layer->krn_dim * conv_layer->krn_dim;
+            if (layer->type == LAYER_TYPE_DWCONV || layer->type == LAYER_TYPE_DWCONV_S8) {
+                // Each output channel filters a single input channel.
+                stats->macs = out_size * krn_size;
+            } else if (layer->type == LAYER_TYPE_PWCONV) {
+                stats->macs = out_size * prev_layer->c;
+            } else {
+                stats->macs = out_size * krn_size * prev_layer->c;
+            }
+            stats->bytes_read += conv_layer->w_size + conv_layer->b_size;
+            if (layer->type == LAYER_TYPE_CONV_S8 || layer->type == LAYER_TYPE_DWCONV_S8) {
+                // int32 biases, multipliers and shifts.
+                stats->bytes_read += (conv_layer->b_size * 3) + (layer->c * 8);
+            }
+            break;
+        }
+
+        case LAYER_TYPE_RELU: {
+            if (((relu_layer_t *) layer)->fused) {
+                stats->bytes_read = 0;
+                stats->bytes_written = 0;
+            }
+            break;
+        }
+
+        case LAYER_TYPE_POOL: {
+            break;
+        }
+
+        case LAYER_TYPE_IP:
+        case LAYER_TYPE_IP_S8: {
+            ip_layer_t *ip_layer = (ip_layer_t *) layer;
+            stats->macs = in_size * ip_layer->c;
+            stats->bytes_read += ip_layer->w_size + ip_layer->b_size;
+            if (layer->type == LAYER_TYPE_IP_S8) {
+                stats->bytes_read += (ip_layer->b_size * 3) + (layer->c * 8);
+            }
+            break;
+        }
+    }
+}
+
+#define NN_ARENA_ALIGN(x) (((x) + 3) & ~3)
+
+// Output size of a layer in the arena, the last layer writes to net->output_data instead.
+static uint32_t nn_layer_out_size(layer_t *layer)
+{
+    return (layer->next == NULL) ? 0 : NN_ARENA_ALIGN(layer->c * layer->h * layer->w);
+}
+
+// Scratch buffer (im2col, pooling or fc vector) the layer's kernel needs.
+static uint32_t nn_layer_col_size(layer_t *layer)
+{
+    layer_t *prev_layer = layer->prev;
+    switch (layer->type) {
+        case LAYER_TYPE_CONV: {
+            // q15 im2col of two output pixels.
+            conv_layer_t *conv_layer = (conv_layer_t *) layer;
+            return NN_ARENA_ALIGN(2 * 2 * prev_layer->c * conv_layer->krn_dim * conv_layer->krn_dim);
+        }
+        case LAYER_TYPE_DWCONV: {
+            // q7 im2col of one output pixel (the C fallback needs none).
+            conv_layer_t *conv_layer = (conv_layer_t *) layer;
+            return NN_ARENA_ALIGN(2 * prev_layer->c * conv_layer->krn_dim * conv_layer->krn_dim);
+        }
+        case LAYER_TYPE_PWCONV:
+            // q15 columns of two input pixels.
+            return NN_ARENA_ALIGN(2 * 2 * prev_layer->c);
+        case LAYER_TYPE_POOL:
+            // q15 row sums of the average pool.
+            return NN_ARENA_ALIGN(2 * layer->w * prev_layer->c);
+        case LAYER_TYPE_IP:
+        case LAYER_TYPE_IP_S8:
+            // q15 input vector.
+            return NN_ARENA_ALIGN(2 * prev_layer->c * prev_layer->h * prev_layer->w);
+        case LAYER_TYPE_CONV_S8: {
+            // q15 im2col of one output pixel, input offset added.
+            conv_layer_t *conv_layer = (conv_layer_t *) layer;
+            return NN_ARENA_ALIGN(2 * prev_layer->c * conv_layer->krn_dim * conv_layer->krn_dim);
+        }
+        default:
+            return 0;
+    }
+}
+
+// An activation map only lives from the layer that writes it to the layer that reads it, so
+// every step fits one arena: the input at one end, the output at the other and the scratch
+// buffer in the gap. The ends swap every layer and RELU works in place, the arena is the
+// largest input + scratch + output of any layer. nn_convert.py stores the same plan.
+static void nn_plan_network(nn_t *net)
+{
+    net->arena_size = 0;
+    for (int pass=0; pass<2; pass++) {
+        bool in_top = true;
+        for (layer_t *layer = net->layers; layer != NULL; layer = layer->next) {
+            if (layer->type == LAYER_TYPE_RELU) {
+                layer->out_offset = layer->prev->out_offset;
+                layer->col_offset = 0;
+                continue;
+            }
+            uint32_t in_size  = (layer->prev == NULL) ? 0 : NN_ARENA_ALIGN(layer->prev->c * layer->prev->h * layer->prev->w);
+            uint32_t out_size = nn_layer_out_size(layer);
+            uint32_t col_size = nn_layer_col_size(layer);
+            if (pass == 0) {
+                net->arena_size = IM_MAX(net->arena_size, in_size + col_size + out_size);
+            } else {
+                layer->out_offset = in_top ? 0 : (net->arena_size - out_size);
+                layer->col_offset = in_top ? out_size : in_size;
+            }
+            in_top = !in_top;
+        }
+    }
+}
+
+// A stored plan must keep every buffer inside the arena.
+static bool nn_check_plan(nn_t *net)
+{
+    for (layer_t *layer = net->layers; layer != NULL; layer = layer->next) {
+        if ((layer->type == LAYER_TYPE_RELU) && (layer->out_offset != layer->prev->out_offset)) {
+            return false;
+        }
+        if (((layer->out_offset + nn_layer_out_size(layer)) > net->arena_size) ||
+            ((layer->col_offset + nn_layer_col_size(layer)) > net->arena_size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Network source, a file or a network image mapped in memory (XIP flash).
+typedef struct nn_reader {
+    FIL *fp;
+    const uint8_t *data;
+    uint32_t size, pos;
+    bool error;
+} nn_reader_t;
+
+static void nn_read(nn_reader_t *rd, void *data, uint32_t size)
+{
+    if (rd->fp != NULL) {
+        read_data(rd->fp, data, size);
+    } else if (size <= (rd->size - rd->pos)) {
+        memcpy(data, rd->data + rd->pos, size);
+        rd->pos += size;
+    } else {
+        memset(data, 0, size);
+        rd->pos = rd->size;
+        rd->error = true;
+    }
+}
+
+// Weights and biases of a mapped network are used in place, no RAM copy.
+static int8_t *nn_read_array(nn_reader_t *rd, uint32_t size)
+{
+    if (rd->fp != NULL) {
+        int8_t *array = xalloc(size);
+        read_data(rd->fp, array, size);
+        return array;
+    } else if (size <= (rd->size - rd->pos)) {
+        int8_t *array = (int8_t *) (rd->data + rd->pos);
+        rd->pos += size;
+        return array;
+    } else {
+        rd->pos = rd->size;
+        rd->error = true;
+        return NULL;
+    }
+}
+
+static uint32_t nn_read_remaining(nn_reader_t *rd)
+{
+    if (rd->fp != NULL) {
+        return file_size_w_buf(rd->fp) - file_tell_w_buf(rd->fp);
+    }
+    return rd->size - rd->pos;
+}
+
+static void nn_read_quant(nn_reader_t *rd, nn_s8_quant_t *quant)
+{
+    nn_read(rd, &quant->in_offset, 4);
+    nn_read(rd, &quant->out_offset, 4);
+    nn_read(rd, &quant->act_min, 4);
+    nn_read(rd, &quant->act_max, 4);
+}
+
+static void nn_read_quant_mult(nn_reader_t *rd, nn_s8_quant_t *quant, uint32_t channels)
+{
+    quant->mult = (int32_t *) nn_read_array(rd, channels * 4);
+    quant->shift = (int32_t *) nn_read_array(rd, channels * 4);
+}
+
+static int nn_load_network_reader(nn_t *net, nn_reader_t *rd)
+{
+    int res = 0;
 
     // Read network type
-    read_data(&fp, net->type, 4);
+    nn_read(rd, net->type, 4);
 
     // Read number of layers
-    read_data(&fp, &net->n_layers, 4);
+    nn_read(rd, &net->n_layers, 4);
 
     layer_t *prev_layer = NULL;
     for (int i=0; i<net->n_layers; i++) {
@@ -98,12 +347,16 @@ int nn_load_network(nn_t *net, const char *path)
         uint32_t layer_type;
 
         // Read layer type
-        read_data(&fp, &layer_type, 4);
+        nn_read(rd, &layer_type, 4);
         switch (layer_type) {
             case LAYER_TYPE_DATA:
                 layer = xalloc0(sizeof(data_layer_t));
                 break;
             case LAYER_TYPE_CONV:
+            case LAYER_TYPE_DWCONV:
+            case LAYER_TYPE_PWCONV:
+            case LAYER_TYPE_CONV_S8:
+            case LAYER_TYPE_DWCONV_S8:
                 layer = xalloc0(sizeof(conv_layer_t));
                 break;
             case LAYER_TYPE_RELU:
@@ -113,11 +366,11 @@ int nn_load_network(nn_t *net, const char *path)
                 layer = xalloc0(sizeof(pool_layer_t));
                 break;
             case LAYER_TYPE_IP:
+            case LAYER_TYPE_IP_S8:
                 layer = xalloc0(sizeof(ip_layer_t));
                 break;
             default:
-                res = -1;
-                goto error;
+                return -1;
         }
 
         if (prev_layer == NULL) { // First layer
@@ -132,41 +385,41 @@ int nn_load_network(nn_t *net, const char *path)
         layer->type = layer_type;
 
         // Read layer shape (NCHW)
-        read_data(&fp, &layer->n, 4);
-        read_data(&fp, &layer->c, 4);
-        read_data(&fp, &layer->h, 4);
-        read_data(&fp, &layer->w, 4);
+        nn_read(rd, &layer->n, 4);
+        nn_read(rd, &layer->c, 4);
+        nn_read(rd, &layer->h, 4);
+        nn_read(rd, &layer->w, 4);
 
         switch (layer_type) {
             case LAYER_TYPE_DATA: {
                 data_layer_t *data_layer = (data_layer_t *) layer;
                 // Read data layer R, G, B mean and input scale
-                read_data(&fp, &data_layer->r_mean, 4);
-                read_data(&fp, &data_layer->g_mean, 4);
-                read_data(&fp, &data_layer->b_mean, 4);
-                read_data(&fp, &data_layer->scale, 4);
+                nn_read(rd, &data_layer->r_mean, 4);
+                nn_read(rd, &data_layer->g_mean, 4);
+                nn_read(rd, &data_layer->b_mean, 4);
+                nn_read(rd, &data_layer->scale, 4);
                 break;
             }
 
-            case LAYER_TYPE_CONV: {
+            case LAYER_TYPE_CONV:
+            case LAYER_TYPE_DWCONV:
+            case LAYER_TYPE_PWCONV: {
                 conv_layer_t *conv_layer = (conv_layer_t *) layer;
                 // Read layer l_shift, r_shift
-                read_data(&fp, &conv_layer->l_shift, 4);
-                read_data(&fp, &conv_layer->r_shift, 4);
+                nn_read(rd, &conv_layer->l_shift, 4);
+                nn_read(rd, &conv_layer->r_shift, 4);
                 // Read krnel dim, stride and padding
-                read_data(&fp, &conv_layer->krn_dim, 4);
-                read_data(&fp, &conv_layer->krn_pad, 4);
-                read_data(&fp, &conv_layer->krn_str, 4);
+                nn_read(rd, &conv_layer->krn_dim, 4);
+                nn_read(rd, &conv_layer->krn_pad, 4);
+                nn_read(rd, &conv_layer->krn_str, 4);
                
                 // Alloc and read weights array
-                read_data(&fp, &conv_layer->w_size, 4);
-                conv_layer->wt = xalloc(conv_layer->w_size);
-                read_data(&fp, conv_layer->wt, conv_layer->w_size);
+                nn_read(rd, &conv_layer->w_size, 4);
+                conv_layer->wt = nn_read_array(rd, conv_layer->w_size);
 
                 // Alloc and read bias array
-                read_data(&fp, &conv_layer->b_size, 4);
-                conv_layer->bias = xalloc(conv_layer->b_size);
-                read_data(&fp, conv_layer->bias, conv_layer->b_size);
+                nn_read(rd, &conv_layer->b_size, 4);
+                conv_layer->bias = nn_read_array(rd, conv_layer->b_size);
                 break;
             }
 
@@ -178,31 +431,79 @@ int nn_load_network(nn_t *net, const char *path)
             case LAYER_TYPE_POOL: {
                 pool_layer_t *pool_layer = (pool_layer_t *) layer;
                 // Read pooling layer type
-                read_data(&fp, &pool_layer->ptype, 4);
+                nn_read(rd, &pool_layer->ptype, 4);
                 // Read krnel dim, stride and padding
-                read_data(&fp, &pool_layer->krn_dim, 4);
-                read_data(&fp, &pool_layer->krn_pad, 4);
-                read_data(&fp, &pool_layer->krn_str, 4);
+                nn_read(rd, &pool_layer->krn_dim, 4);
+                nn_read(rd, &pool_layer->krn_pad, 4);
+                nn_read(rd, &pool_layer->krn_str, 4);
                 break;
             }
 
             case LAYER_TYPE_IP: {
                 ip_layer_t *ip_layer = (ip_layer_t *) layer;
                 // Read layer l_shift, r_shift
-                read_data(&fp, &ip_layer->l_shift, 4);
-                read_data(&fp, &ip_layer->r_shift, 4);
+                nn_read(rd, &ip_layer->l_shift, 4);
+                nn_read(rd, &ip_layer->r_shift, 4);
 
                 // Alloc and read weights array
-                read_data(&fp, &ip_layer->w_size, 4);
-                ip_layer->wt = xalloc(ip_layer->w_size);
-                read_data(&fp, ip_layer->wt, ip_layer->w_size);
+                nn_read(rd, &ip_layer->w_size, 4);
+                ip_layer->wt = nn_read_array(rd, ip_layer->w_size);
 
                 // Alloc and read bias array
-                read_data(&fp, &ip_layer->b_size, 4);
-                ip_layer->bias = xalloc(ip_layer->b_size);
-                read_data(&fp, ip_layer->bias, ip_layer->b_size);
+                nn_read(rd, &ip_layer->b_size, 4);
+                ip_layer->bias = nn_read_array(rd, ip_layer->b_size);
                 break;
             }
+
+            case LAYER_TYPE_CONV_S8:
+            case LAYER_TYPE_DWCONV_S8: {
+                conv_layer_t *conv_layer = (conv_layer_t *) layer;
+                nn_read_quant(rd, &conv_layer->quant);
+                // Read krnel dim, stride and padding
+                nn_read(rd, &conv_layer->krn_dim, 4);
+                nn_read(rd, &conv_layer->krn_pad, 4);
+                nn_read(rd, &conv_layer->krn_str, 4);
+
+                // Read weights, int32 biases and per channel multipliers and shifts
+                nn_read(rd, &conv_layer->w_size, 4);
+                conv_layer->wt = nn_read_array(rd, conv_layer->w_size);
+                nn_read(rd, &conv_layer->b_size, 4);
+                conv_layer->bias = nn_read_array(rd, conv_layer->b_size * 4);
+                nn_read_quant_mult(rd, &conv_layer->quant, layer->c);
+                break;
+            }
+
+            case LAYER_TYPE_IP_S8: {
+                ip_layer_t *ip_layer = (ip_layer_t *) layer;
+                nn_read_quant(rd, &ip_layer->quant);
+
+                // Read weights, int32 biases and per channel multipliers and shifts
+                nn_read(rd, &ip_layer->w_size, 4);
+                ip_layer->wt = nn_read_array(rd, ip_layer->w_size);
+                nn_read(rd, &ip_layer->b_size, 4);
+                ip_layer->bias = nn_read_array(rd, ip_layer->b_size * 4);
+                nn_read_quant_mult(rd, &ip_layer->quant, layer->c);
+                break;
+            }
+        }
+    }
+
+    if (rd->error) {
+        return -1;
+    }
+
+    // Read the activation arena plan, networks converted without one are planned here.
+    bool planned = false;
+    if (nn_read_remaining(rd) >= 4) {
+        uint8_t plan_type[4];
+        nn_read(rd, plan_type, 4);
+        if (memcmp(plan_type, "PLAN", 4) == 0) {
+            nn_read(rd, &net->arena_size, 4);
+            for (layer_t *layer = net->layers; layer != NULL; layer = layer->next) {
+                nn_read(rd, &layer->out_offset, 4);
+                nn_read(rd, &layer->col_offset, 4);
+            }
+            planned = true;
         }
     }
 
@@ -211,48 +512,53 @@ int nn_load_network(nn_t *net, const char *path)
         // First layer is DATA will be skipped, so prev_layer *should* not be NULL.
         prev_layer = layer->prev;
 
-        if (layer->type == LAYER_TYPE_IP) {
-            uint32_t fc_buffer_size = 2 * prev_layer->c * prev_layer->w * prev_layer->h;
-            net->max_colbuf_size = IM_MAX(net->max_colbuf_size, fc_buffer_size);
-        }
-
-        if (layer->type == LAYER_TYPE_CONV) {
-            conv_layer_t *conv_layer = (conv_layer_t *) layer;
-            uint32_t im2col_buffer_size = 2 * 2 * conv_layer->c * conv_layer->krn_dim * conv_layer->krn_dim;
-            net->max_colbuf_size = IM_MAX(net->max_colbuf_size, im2col_buffer_size);
-        }
-
-        if (layer->type == LAYER_TYPE_IP) {
-            uint32_t buffer_size = layer->c;
-            if (prev_layer->type == LAYER_TYPE_IP) {
-                buffer_size = buffer_size + prev_layer->c; 
-            } else if (prev_layer->type == LAYER_TYPE_CONV || prev_layer->type == LAYER_TYPE_POOL) {
-                buffer_size = buffer_size + prev_layer->c * prev_layer->h * prev_layer->w;
+        if (layer->type == LAYER_TYPE_RELU && LAYER_IS_CONV(prev_layer)) {
+            // Fuse the ReLU into the conv. If a max pool follows, ReLU runs on the pool output
+            // instead, max(ReLU(x)) == ReLU(max(x)) and the pooled map is a fraction of the size.
+            layer_t *next_layer = layer->next;
+            ((relu_layer_t *) layer)->fused = 1;
+            if (next_layer != NULL && next_layer->type == LAYER_TYPE_POOL &&
+                ((pool_layer_t *) next_layer)->ptype == POOL_TYPE_MAX) {
+                ((pool_layer_t *) next_layer)->relu = 1;
+            } else {
+                ((conv_layer_t *) prev_layer)->relu = 1;
             }
-            net->max_scrbuf_size = IM_MAX(net->max_scrbuf_size, buffer_size);
-        }
-
-        if (layer->type == LAYER_TYPE_CONV || layer->type == LAYER_TYPE_POOL) {
-            uint32_t buffer_size = layer->c * layer->h * layer->w + prev_layer->c * prev_layer->h * prev_layer->w;
-            net->max_scrbuf_size = IM_MAX(net->max_scrbuf_size, buffer_size);
         }
 
-        uint32_t layer_size = layer->c * layer->h * layer->w;
-        net->max_layer_size = IM_MAX(net->max_layer_size, layer_size);
         if (layer->next == NULL) {
             net->output_size = layer->c;
         }
         layer = layer->next;
     }
 
+    if (!planned || !nn_check_plan(net)) {
+        nn_plan_network(net);
+    }
+
     // Alloc output buffer.
     net->output_data = xalloc(net->output_size);
-error:
+    return res;
+}
+
+int nn_load_network(nn_t *net, const char *path)
+{
+    FIL fp;
+    nn_reader_t rd = { .fp = &fp };
+
+    file_read_open(&fp, path);
+    file_buffer_on(&fp);
+    int res = nn_load_network_reader(net, &rd);
     file_buffer_off(&fp);
     file_close(&fp);
     return res;
 }
 
+int nn_load_network_xip(nn_t *net, const uint8_t *data, uint32_t size)
+{
+    nn_reader_t rd = { .data = data, .size = size };
+    return nn_load_network_reader(net, &rd);
+}
+
 #ifndef __SSAT
 #define __SSAT(a, b) ({ __typeof__ (a) _a = (a); \
                         __typeof__ (b) _b = (b); \
@@ -261,61 +567,386 @@ error:
                         _a > (-_b) ? _a : (-_b); })
 #endif
 
-void nn_transform_input(data_layer_t *data_layer, image_t *img, q7_t *input_data, rectangle_t *roi)
+// Depthwise convolution for the shapes arm_depthwise_separable_conv_HWC_q7 rejects, output channel
+// co filters input channel co / (ch_im_out / ch_im_in). Weights are HWC with the output channel
+// innermost, same as CMSIS-NN, and ReLU is applied before the output is stored.
+static void nn_depthwise_conv_q7_basic(const q7_t *Im_in, const uint16_t dim_im_in, const uint16_t ch_im_in,
+        const q7_t *wt, const uint16_t ch_im_out, const uint16_t dim_kernel, const uint16_t padding,
+        const uint16_t stride, const q7_t *bias, const uint16_t bias_shift, const uint16_t out_shift,
+        q7_t *Im_out, const uint16_t dim_im_out, bool relu)
 {
-    int input_scale = data_layer->scale;
-    // Scale, convert and normalize input image.
-    int x_ratio = (int)((roi->w<<16)/data_layer->w)+1;
-    int y_ratio = (int)((roi->h<<16)/data_layer->h)+1;
+    int ch_mult = ch_im_out / ch_im_in;
+    for (int y=0; y<dim_im_out; y++) {
+        for (int x=0; x<dim_im_out; x++, Im_out+=ch_im_out) {
+            for (int co=0; co<ch_im_out; co++) {
+                int ci = co / ch_mult;
+                q31_t sum = ((q31_t) bias[co] << bias_shift) + NN_ROUND(out_shift);
+                for (int ky=0; ky<dim_kernel; ky++) {
+                    int iy = (y * stride) - padding + ky;
+                    if (iy < 0 || iy >= dim_im_in) {
+                        continue;
+                    }
+                    for (int kx=0; kx<dim_kernel; kx++) {
+                        int ix = (x * stride) - padding + kx;
+                        if (ix < 0 || ix >= dim_im_in) {
+                            continue;
+                        }
+                        sum += Im_in[((iy * dim_im_in) + ix) * ch_im_in + ci] * wt[((ky * dim_kernel) + kx) * ch_im_out + co];
+                    }
+                }
+                q7_t v = (q7_t) __SSAT((sum >> out_shift), 8);
+                Im_out[co] = (relu && (v < 0)) ? 0 : v;
+            }
+        }
+    }
+}
 
-    if ((img->bpp == 2) && (data_layer->c == 3)) { // RGB565 to RGB888
-        for (int y=0, i=0; y<data_layer->h; y++) {
-            int sy = (y*y_ratio)>>16;
-            for (int x=0; x<data_layer->w; x++, i+=3) {
-                int sx = (x*x_ratio)>>16;
-                uint16_t p = IM_GET_RGB565_PIXEL(img, sx+roi->x, sy+roi->y);
-                input_data[i+0] = (q7_t)__SSAT((((((int) COLOR_RGB565_TO_R8(p))
-                                  - (int) data_layer->r_mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
-                input_data[i+1] = (q7_t)__SSAT((((((int) COLOR_RGB565_TO_G8(p))
-                                  - (int) data_layer->g_mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
-                input_data[i+2] = (q7_t)__SSAT((((((int) COLOR_RGB565_TO_B8(p))
-                                  - (int) data_layer->b_mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
+// 3x3 stride 1 convolutions are done directly on the HWC input: the three taps of a kernel row
+// are adjacent pixels, so each kernel row is one contiguous run of 3 * ch_im_in inputs that is
+// multiplied with the matching run of weights. There is no im2col copy, and output channels are
+// done in blocks whose weights fit half the D-cache, the input rows they slide over take the rest.
+#define NN_CONV_DCACHE_SIZE (32 * 1024)
+
+static bool nn_conv_3x3_direct(conv_layer_t *conv_layer, layer_t *prev_layer)
+{
+    return (conv_layer->krn_dim == 3) && (conv_layer->krn_str == 1) && (prev_layer->c % 4 == 0);
+}
+
+// Two pixels times two output channels, each input and weight word is unpacked once for two MACs.
+static inline void nn_dot_q7_2x2(const q7_t *in0, const q7_t *in1, const q7_t *wt0, const q7_t *wt1,
+        uint32_t len, q31_t *sum)
+{
+#if defined (ARM_MATH_DSP)
+    for (; len >= 4; len -= 4) {
+        q31_t a0, a1, b0, b1, w0, w1, v0, v1;
+        in0 = read_and_pad_reordered((void *) in0, &a0, &a1);
+        in1 = read_and_pad_reordered((void *) in1, &b0, &b1);
+        wt0 = read_and_pad_reordered((void *) wt0, &w0, &w1);
+        wt1 = read_and_pad_reordered((void *) wt1, &v0, &v1);
+        sum[0] = __SMLAD(a1, w1, __SMLAD(a0, w0, sum[0]));
+        sum[1] = __SMLAD(b1, w1, __SMLAD(b0, w0, sum[1]));
+        sum[2] = __SMLAD(a1, v1, __SMLAD(a0, v0, sum[2]));
+        sum[3] = __SMLAD(b1, v1, __SMLAD(b0, v0, sum[3]));
+    }
+#endif
+    while (len--) {
+        sum[0] += (*in0) * (*wt0);
+        sum[1] += (*in1) * (*wt0++);
+        sum[2] += (*in0++) * (*wt1);
+        sum[3] += (*in1++) * (*wt1++);
+    }
+}
+
+static inline q31_t nn_dot_q7(const q7_t *in, const q7_t *wt, uint32_t len, q31_t sum)
+{
+#if defined (ARM_MATH_DSP)
+    for (; len >= 4; len -= 4) {
+        q31_t a0, a1, w0, w1;
+        in = read_and_pad_reordered((void *) in, &a0, &a1);
+        wt = read_and_pad_reordered((void *) wt, &w0, &w1);
+        sum = __SMLAD(a1, w1, __SMLAD(a0, w0, sum));
+    }
+#endif
+    while (len--) {
+        sum += (*in++) * (*wt++);
+    }
+    return sum;
+}
+
+// Same arguments and rounding as arm_convolve_HWC_q7_basic() with dim_kernel 3 and stride 1,
+// the col buffer is not used.
+static void nn_convolve_3x3_q7_direct(const q7_t *Im_in, const uint16_t dim_im_in, const uint16_t ch_im_in,
+        const q7_t *wt, const uint16_t ch_im_out, const uint16_t padding, const q7_t *bias,
+        const uint16_t bias_shift, const uint16_t out_shift, q7_t *Im_out, const uint16_t dim_im_out)
+{
+    uint32_t row_len = 3 * ch_im_in;
+    uint32_t wt_len = 3 * row_len;
+    int co_block = IM_MAX((NN_CONV_DCACHE_SIZE / 2) / wt_len, 2) & ~1;
+
+    for (int co_start=0; co_start<ch_im_out; co_start+=co_block) {
+        int co_end = IM_MIN(co_start + co_block, ch_im_out);
+        for (int y=0; y<dim_im_out; y++) {
+            // Kernel rows outside the input add nothing.
+            int ky_start = IM_MAX(padding - y, 0);
+            int ky_end = IM_MIN(dim_im_in + padding - y, 3);
+            for (int x=0; x<dim_im_out;) {
+                int kx_start = IM_MAX(padding - x, 0);
+                int kx_end = IM_MIN(dim_im_in + padding - x, 3);
+                const q7_t *in = Im_in + ((((y - padding + ky_start) * dim_im_in) + (x - padding + kx_start)) * ch_im_in);
+                q7_t *out = Im_out + (((y * dim_im_out) + x) * ch_im_out);
+
+                // Pairs of pixels with all three taps inside the input.
+                bool pair = (kx_start == 0) && (kx_end == 3) && ((x + 1) < dim_im_out) &&
+                            ((x + 1 - padding + 2) < dim_im_in);
+                if (pair) {
+                    int co = co_start;
+                    for (; (co + 1) < co_end; co += 2) {
+                        q31_t sum[4];
+                        sum[0] = sum[1] = ((q31_t) bias[co] << bias_shift) + NN_ROUND(out_shift);
+                        sum[2] = sum[3] = ((q31_t) bias[co + 1] << bias_shift) + NN_ROUND(out_shift);
+                        for (int ky=ky_start; ky<ky_end; ky++) {
+                            const q7_t *in_row = in + ((ky - ky_start) * dim_im_in * ch_im_in);
+                            nn_dot_q7_2x2(in_row, in_row + ch_im_in, wt + (co * wt_len) + (ky * row_len),
+                                    wt + ((co + 1) * wt_len) + (ky * row_len), row_len, sum);
+                        }
+                        out[co] = (q7_t) __SSAT((sum[0] >> out_shift), 8);
+                        out[ch_im_out + co] = (q7_t) __SSAT((sum[1] >> out_shift), 8);
+                        out[co + 1] = (q7_t) __SSAT((sum[2] >> out_shift), 8);
+                        out[ch_im_out + co + 1] = (q7_t) __SSAT((sum[3] >> out_shift), 8);
+                    }
+                    for (; co < co_end; co++) {
+                        for (int p=0; p<2; p++) {
+                            q31_t sum = ((q31_t) bias[co] << bias_shift) + NN_ROUND(out_shift);
+                            for (int ky=ky_start; ky<ky_end; ky++) {
+                                sum = nn_dot_q7(in + (p * ch_im_in) + ((ky - ky_start) * dim_im_in * ch_im_in),
+                                        wt + (co * wt_len) + (ky * row_len), row_len, sum);
+                            }
+                            out[(p * ch_im_out) + co] = (q7_t) __SSAT((sum >> out_shift), 8);
+                        }
+                    }
+                    x += 2;
+                } else {
+                    // Border pixel, the taps inside the input are still one run per kernel row.
+                    uint32_t len = (kx_end - kx_start) * ch_im_in;
+                    for (int co=co_start; co<co_end; co++) {
+                        q31_t sum = ((q31_t) bias[co] << bias_shift) + NN_ROUND(out_shift);
+                        for (int ky=ky_start; ky<ky_end; ky++) {
+                            sum = nn_dot_q7(in + ((ky - ky_start) * dim_im_in * ch_im_in),
+                                    wt + (co * wt_len) + (ky * row_len) + (kx_start * ch_im_in), len, sum);
+                        }
+                        out[co] = (q7_t) __SSAT((sum >> out_shift), 8);
+                    }
+                    x += 1;
+                }
             }
         }
-    } else if ((img->bpp == 2) && (data_layer->c == 1)) { // RGB565 to GS
-        for (int y=0, i=0; y<data_layer->h; y++) {
-            int sy = (y*y_ratio)>>16;
-            for (int x=0; x<data_layer->w; x++, i++) {
-                int sx = (x*x_ratio)>>16;
-                uint16_t p = IM_GET_RGB565_PIXEL(img, sx+roi->x, sy+roi->y);
-                input_data[i] = (q7_t)__SSAT((((((int) COLOR_RGB565_TO_GRAYSCALE(p))
-                                - (int) data_layer->r_mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
+    }
+}
+
+// Requantizes an int32 accumulator the way TFLite's MultiplyByQuantizedMultiplier() does,
+// mult is a Q31 fraction in [0.5, 1) and shift the power of two around it.
+static inline int32_t nn_requantize_s8(int32_t acc, int32_t mult, int32_t shift)
+{
+    int32_t left = (shift > 0) ? shift : 0;
+    int32_t right = (shift > 0) ? 0 : -shift;
+
+    // Saturating rounding doubling high multiply, the only overflow is INT32_MIN * INT32_MIN.
+    int64_t prod = ((int64_t) (acc * (1 << left))) * mult;
+    int32_t nudge = (prod >= 0) ? (1 << 30) : (1 - (1 << 30));
+    int32_t high = (acc == INT32_MIN && mult == INT32_MIN) ? INT32_MAX : (int32_t) ((prod + nudge) / (1LL << 31));
+
+    // Rounding divide by power of two.
+    int32_t mask = (1 << right) - 1;
+    int32_t remainder = high & mask;
+    int32_t threshold = (mask >> 1) + ((high < 0) ? 1 : 0);
+    return (high >> right) + ((remainder > threshold) ? 1 : 0);
+}
+
+static inline q7_t nn_output_s8(int32_t acc, const nn_s8_quant_t *quant, int channel)
+{
+    acc = nn_requantize_s8(acc, quant->mult[channel], quant->shift[channel]) + quant->out_offset;
+    acc = IM_MAX(acc, quant->act_min);
+    return (q7_t) IM_MIN(acc, quant->act_max);
+}
+
+// Widens int8 activations to q15 with the input offset added, padding is then just 0.
+static void nn_q7_to_q15_offset(const q7_t *src, q15_t *dst, uint32_t len, int32_t offset)
+{
+#if defined (ARM_MATH_DSP)
+    q31_t offset_q15x2 = __PKHBT(offset, offset, 16);
+    for (; len >= 4; len -= 4) {
+        q31_t in1, in2;
+        src = read_and_pad((void *) src, &in1, &in2);
+        *__SIMD32(dst)++ = __SADD16(in1, offset_q15x2);
+        *__SIMD32(dst)++ = __SADD16(in2, offset_q15x2);
+    }
+#endif
+    while (len--) {
+        *dst++ = (q15_t) (*src++ + offset);
+    }
+}
+
+// Dot product of a q15 vector and a row of int8 weights, two __SMLAD per four weights.
+static int32_t nn_dot_q15_q7(const q15_t *vec, const q7_t *wt, uint32_t len, int32_t acc)
+{
+#if defined (ARM_MATH_DSP)
+    for (; len >= 4; len -= 4) {
+        q31_t wt1, wt2;
+        wt = read_and_pad((void *) wt, &wt1, &wt2);
+        acc = __SMLAD(*__SIMD32(vec)++, wt1, acc);
+        acc = __SMLAD(*__SIMD32(vec)++, wt2, acc);
+    }
+#endif
+    while (len--) {
+        acc += (*vec++) * (*wt++);
+    }
+    return acc;
+}
+
+// TFLite CONV_2D, HWC input and output, OHWI weights. The output may be smaller than a
+// symmetric padding gives (TFLite SAME pads bottom/right more), taps outside the input
+// are zeros in the im2col.
+static void nn_convolve_s8(const q7_t *input, uint16_t in_w, uint16_t in_h, uint16_t in_c,
+        const q7_t *wt, uint16_t out_c, uint16_t krn_dim, uint16_t pad, uint16_t stride,
+        const int32_t *bias, const nn_s8_quant_t *quant, q7_t *output, uint16_t out_w, uint16_t out_h, q15_t *col)
+{
+    uint32_t col_len = krn_dim * krn_dim * in_c;
+    for (int y=0; y<out_h; y++) {
+        for (int x=0; x<out_w; x++) {
+            q15_t *col_ptr = col;
+            for (int ky=0; ky<krn_dim; ky++) {
+                int iy = (y * stride) - pad + ky;
+                for (int kx=0; kx<krn_dim; kx++, col_ptr+=in_c) {
+                    int ix = (x * stride) - pad + kx;
+                    if (iy < 0 || iy >= in_h || ix < 0 || ix >= in_w) {
+                        memset(col_ptr, 0, in_c * sizeof(q15_t));
+                    } else {
+                        nn_q7_to_q15_offset(input + (((iy * in_w) + ix) * in_c), col_ptr, in_c, quant->in_offset);
+                    }
+                }
+            }
+
+            const q7_t *wt_ptr = wt;
+            for (int co=0; co<out_c; co++, wt_ptr+=col_len) {
+                int32_t acc = nn_dot_q15_q7(col, wt_ptr, col_len, bias[co]);
+                *output++ = nn_output_s8(acc, quant, co);
+            }
+        }
+    }
+}
+
+// TFLite DEPTHWISE_CONV_2D, weights are [1, H, W, C_out] with the output channel innermost.
+static void nn_depthwise_conv_s8(const q7_t *input, uint16_t in_w, uint16_t in_h, uint16_t in_c,
+        const q7_t *wt, uint16_t out_c, uint16_t krn_dim, uint16_t pad, uint16_t stride,
+        const int32_t *bias, const nn_s8_quant_t *quant, q7_t *output, uint16_t out_w, uint16_t out_h)
+{
+    int ch_mult = out_c / in_c;
+    for (int y=0; y<out_h; y++) {
+        for (int x=0; x<out_w; x++, output+=out_c) {
+            for (int co=0; co<out_c; co++) {
+                int ci = co / ch_mult;
+                int32_t acc = bias[co];
+                for (int ky=0; ky<krn_dim; ky++) {
+                    int iy = (y * stride) - pad + ky;
+                    if (iy < 0 || iy >= in_h) {
+                        continue;
+                    }
+                    for (int kx=0; kx<krn_dim; kx++) {
+                        int ix = (x * stride) - pad + kx;
+                        if (ix < 0 || ix >= in_w) {
+                            continue;
+                        }
+                        acc += (input[((iy * in_w) + ix) * in_c + ci] + quant->in_offset) *
+                               wt[((ky * krn_dim) + kx) * out_c + co];
+                    }
+                }
+                output[co] = nn_output_s8(acc, quant, co);
             }
         }
-    } else if ((img->bpp == 1) && (data_layer->c == 3)) { // GS to RGB88
+    }
+}
+
+// TFLite FULLY_CONNECTED, one row of in_len weights per output, input flattened HWC.
+static void nn_fully_connected_s8(const q7_t *input, const q7_t *wt, uint16_t in_len, uint16_t out_len,
+        const int32_t *bias, const nn_s8_quant_t *quant, q7_t *output, q15_t *vec)
+{
+    nn_q7_to_q15_offset(input, vec, in_len, quant->in_offset);
+    for (int i=0; i<out_len; i++, wt+=in_len) {
+        output[i] = nn_output_s8(nn_dot_q15_q7(vec, wt, in_len, bias[i]), quant, i);
+    }
+}
+
+#ifdef IMLIB_ENABLE_PXP
+// Let PXP scale (and convert) the ROI to the input size, only the normalization is left to the CPU.
+static int nn_transform_input_pxp(data_layer_t *data_layer, image_t *img, q7_t *input_data, rectangle_t *roi)
+{
+    int input_scale = data_layer->scale;
+    int size = data_layer->w * data_layer->h;
+    image_t scaled;
+
+    if ((img->bpp != IMAGE_BPP_GRAYSCALE) && (img->bpp != IMAGE_BPP_RGB565)) {
+        return -1;
+    }
+
+    scaled.w = data_layer->w;
+    scaled.h = data_layer->h;
+    scaled.bpp = ((img->bpp == IMAGE_BPP_RGB565) && (data_layer->c == 3)) ? PXP_2D_BPP_XRGB8888 : IMAGE_BPP_GRAYSCALE;
+
+    fb_alloc_mark();
+    scaled.data = fb_alloc(size * ((scaled.bpp == PXP_2D_BPP_XRGB8888) ? 4 : 1), FB_ALLOC_NO_HINT);
+    if (pxp_2d_blit(img, roi, &scaled, NULL, 0) != 0) {
+        fb_alloc_free_till_mark();
+        return -1;
+    }
+
+    if (scaled.bpp == PXP_2D_BPP_XRGB8888) { // RGB565 to RGB888
+        uint8_t *p = scaled.data; // B, G, R, X
+        for (int i=0; i<size; i++, p+=4, input_data+=3) {
+            input_data[0] = (q7_t)__SSAT(((((int) p[2] - (int) data_layer->r_mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
+            input_data[1] = (q7_t)__SSAT(((((int) p[1] - (int) data_layer->g_mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
+            input_data[2] = (q7_t)__SSAT(((((int) p[0] - (int) data_layer->b_mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
+        }
+    } else if (data_layer->c == 3) { // GS to RGB888
         int mean = (int) ((0.30f * data_layer->r_mean) +
                           (0.59f * data_layer->g_mean) +
                           (0.11f * data_layer->b_mean));
-        for (int y=0, i=0; y<data_layer->h; y++) {
-            int sy = (y*y_ratio)>>16;
-            for (int x=0; x<data_layer->w; x++, i+=3) {
-                int sx = (x*x_ratio)>>16;
-                int p = (int) IMAGE_GET_GRAYSCALE_PIXEL(img, sx+roi->x, sy+roi->y);
-                input_data[i+0] = (q7_t)__SSAT((((p - (int) mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
-                input_data[i+1] = (q7_t)__SSAT((((p - (int) mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
-                input_data[i+2] = (q7_t)__SSAT((((p - (int) mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
-            }
+        for (int i=0; i<size; i++, input_data+=3) {
+            q7_t v = (q7_t)__SSAT(((((int) scaled.data[i] - mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
+            input_data[0] = input_data[1] = input_data[2] = v;
         }
-    } else if ((img->bpp == 1) && (data_layer->c == 1)) { // GS to GS
-        for (int y=0, i=0; y<data_layer->h; y++) {
-            int sy = (y*y_ratio)>>16;
-            for (int x=0; x<data_layer->w; x++, i++) {
-                int sx = (x*x_ratio)>>16;
-                int p = (int) IMAGE_GET_GRAYSCALE_PIXEL(img, sx+roi->x, sy+roi->y);
-                input_data[i] = (q7_t)__SSAT((((p - (int) data_layer->r_mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
-            }
+    } else { // RGB565/GS to GS
+        for (int i=0; i<size; i++) {
+            input_data[i] = (q7_t)__SSAT(((((int) scaled.data[i] - (int) data_layer->r_mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
+        }
+    }
+
+    fb_alloc_free_till_mark();
+    return 0;
+}
+#endif
+
+// Folds the mean subtraction, input scale and int8 saturation of one channel into a table.
+static void nn_input_lut(uint8_t *lut, int mean, int input_scale)
+{
+    for (int i=0; i<256; i++) {
+        lut[i] = (uint8_t) (q7_t)__SSAT((((i - mean)<<7) + (1<<(input_scale-1))) >> input_scale, 8);
+    }
+}
+
+void nn_transform_input(data_layer_t *data_layer, image_t *img, q7_t *input_data, rectangle_t *roi)
+{
+    int input_scale = data_layer->scale;
+#ifdef IMLIB_ENABLE_PXP
+    if (nn_transform_input_pxp(data_layer, img, input_data, roi) == 0) {
+        return;
+    }
+#endif
+    if (img->bpp != IMAGE_BPP_BINARY) {
+        // Fused bilinear resize, color conversion and normalization.
+        uint8_t lut[3][256];
+        if ((img->bpp == IMAGE_BPP_GRAYSCALE) && (data_layer->c == 3)) {
+            int mean = (int) ((0.30f * data_layer->r_mean) +
+                              (0.59f * data_layer->g_mean) +
+                              (0.11f * data_layer->b_mean));
+            nn_input_lut(lut[0], mean, input_scale);
+            memcpy(lut[1], lut[0], 256);
+            memcpy(lut[2], lut[0], 256);
+        } else {
+            nn_input_lut(lut[0], data_layer->r_mean, input_scale);
+            nn_input_lut(lut[1], data_layer->g_mean, input_scale);
+            nn_input_lut(lut[2], data_layer->b_mean, input_scale);
         }
-    } else if ((img->bpp == 0) && (data_layer->c == 3)) { // BINARY to RGB88
+        if (imlib_resize_to_tensor(img, roi, data_layer->w, data_layer->h, data_layer->c,
+                                   lut[0], (uint8_t *) input_data) == 0) {
+            return;
+        }
+    }
+
+    // Scale, convert and normalize input image.
+    int x_ratio = (int)((roi->w<<16)/data_layer->w)+1;
+    int y_ratio = (int)((roi->h<<16)/data_layer->h)+1;
+
+    if ((img->bpp == 0) && (data_layer->c == 3)) { // BINARY to RGB88
         int mean = (int) ((0.30f * data_layer->r_mean) +
                           (0.59f * data_layer->g_mean) +
                           (0.11f * data_layer->b_mean));
@@ -341,48 +972,53 @@ void nn_transform_input(data_layer_t *data_layer, image_t *img, q7_t *input_data
     }
 }
 
-int nn_run_network(nn_t *net, image_t *img, rectangle_t *roi, bool softmax)
+static int nn_check_network(nn_t *net)
 {
-    uint32_t layer_idx = 0;
-    layer_t *layer = net->layers;
-
-    if (layer == NULL) {
+    if (net->layers == NULL) {
         printf("First layer is NULL!\n");
         return -1;
     }
 
-    if (layer->type != LAYER_TYPE_DATA) {
+    if (net->layers->type != LAYER_TYPE_DATA) {
         printf("First layer is not a DATA layer!\n");
         return -1;
     }
+    return 0;
+}
 
-    q7_t *input_data    = NULL;
-    q7_t *input_buffer  = NULL;
-    q7_t *output_buffer = NULL;
-
-    fb_alloc_mark();
-
-    q7_t *buffer1     = fb_alloc(net->max_scrbuf_size, FB_ALLOC_NO_HINT);
-    q7_t *buffer2     = buffer1 + net->max_layer_size;
-    q7_t *col_buffer  = fb_alloc(net->max_colbuf_size, FB_ALLOC_NO_HINT);
+// Runs all layers in the arena, without an image the DATA layer output is already filled in.
+static void nn_forward(nn_t *net, q7_t *arena, image_t *img, rectangle_t *roi, bool softmax)
+{
+    layer_t *layer = net->layers;
 
     while (layer != NULL) {
+        uint32_t cycles = DWT->CYCCNT;
         layer_t *prev_layer = layer->prev;
+        q7_t *input_buffer  = (prev_layer == NULL) ? NULL : (arena + prev_layer->out_offset);
+        q7_t *output_buffer = (layer->next == NULL) ? net->output_data : (arena + layer->out_offset);
+        q7_t *col_buffer    = arena + layer->col_offset;
 
         switch (layer->type) {
             case LAYER_TYPE_DATA: {
                 data_layer_t *data_layer = (data_layer_t *) layer;
-                input_data = fb_alloc(data_layer->c * data_layer->h * data_layer->w, FB_ALLOC_NO_HINT);
-                nn_transform_input(data_layer, img, input_data, roi);
-                // Set image data as input buffer for the next layer.
-                input_buffer = input_data;
-                output_buffer = buffer1;
+                if (img != NULL) {
+                    nn_transform_input(data_layer, img, output_buffer, roi);
+                }
                 break;
             }
 
             case LAYER_TYPE_CONV: {
                 conv_func_t conv_func = NULL;
                 conv_layer_t *conv_layer = (conv_layer_t *) layer;
+                if (nn_conv_3x3_direct(conv_layer, prev_layer)) {
+                    nn_convolve_3x3_q7_direct(input_buffer, prev_layer->h, prev_layer->c, conv_layer->wt, conv_layer->c,
+                            conv_layer->krn_pad, conv_layer->bias, conv_layer->l_shift, conv_layer->r_shift,
+                            output_buffer, conv_layer->h);
+                    if (conv_layer->relu) {
+                        arm_relu_q7(output_buffer, conv_layer->h * conv_layer->w * conv_layer->c);
+                    }
+                    break;
+                }
                 if (prev_layer->c % 4 != 0 ||
                     conv_layer->n % 2 != 0 || prev_layer->h % 2 != 0) {
                     conv_func = arm_convolve_HWC_q7_basic;
@@ -395,12 +1031,56 @@ int nn_run_network(nn_t *net, image_t *img, rectangle_t *roi, bool softmax)
                 conv_func(input_buffer, prev_layer->h, prev_layer->c, conv_layer->wt, conv_layer->c, 
                         conv_layer->krn_dim, conv_layer->krn_pad, conv_layer->krn_str, conv_layer->bias,
                         conv_layer->l_shift, conv_layer->r_shift, output_buffer, conv_layer->h, (q15_t*)col_buffer, NULL); 
+                if (conv_layer->relu) {
+                    arm_relu_q7(output_buffer, conv_layer->h * conv_layer->w * conv_layer->c);
+                }
+                break;
+            }
+
+            case LAYER_TYPE_DWCONV: {
+                conv_layer_t *conv_layer = (conv_layer_t *) layer;
+                if (prev_layer->c % 2 != 0 || conv_layer->c != prev_layer->c) {
+                    nn_depthwise_conv_q7_basic(input_buffer, prev_layer->h, prev_layer->c, conv_layer->wt, conv_layer->c,
+                            conv_layer->krn_dim, conv_layer->krn_pad, conv_layer->krn_str, conv_layer->bias,
+                            conv_layer->l_shift, conv_layer->r_shift, output_buffer, conv_layer->h, conv_layer->relu);
+                    break;
+                }
+                arm_depthwise_separable_conv_HWC_q7(input_buffer, prev_layer->h, prev_layer->c, conv_layer->wt, conv_layer->c,
+                        conv_layer->krn_dim, conv_layer->krn_pad, conv_layer->krn_str, conv_layer->bias,
+                        conv_layer->l_shift, conv_layer->r_shift, output_buffer, conv_layer->h, (q15_t*)col_buffer, NULL);
+                if (conv_layer->relu) {
+                    arm_relu_q7(output_buffer, conv_layer->h * conv_layer->w * conv_layer->c);
+                }
+                break;
+            }
+
+            case LAYER_TYPE_PWCONV: {
+                conv_layer_t *conv_layer = (conv_layer_t *) layer;
+                if (prev_layer->c % 4 != 0 || conv_layer->c % 2 != 0 ||
+                    conv_layer->krn_pad != 0 || conv_layer->krn_str != 1) {
+                    arm_convolve_HWC_q7_basic(input_buffer, prev_layer->h, prev_layer->c, conv_layer->wt, conv_layer->c,
+                            1, conv_layer->krn_pad, conv_layer->krn_str, conv_layer->bias,
+                            conv_layer->l_shift, conv_layer->r_shift, output_buffer, conv_layer->h, (q15_t*)col_buffer, NULL);
+                } else {
+                    arm_convolve_1x1_HWC_q7_fast_nonsquare(input_buffer, prev_layer->w, prev_layer->h, prev_layer->c,
+                            conv_layer->wt, conv_layer->c, 1, 1, 0, 0, 1, 1, conv_layer->bias, conv_layer->l_shift,
+                            conv_layer->r_shift, output_buffer, conv_layer->w, conv_layer->h, (q15_t*)col_buffer, NULL);
+                }
+                if (conv_layer->relu) {
+                    arm_relu_q7(output_buffer, conv_layer->h * conv_layer->w * conv_layer->c);
+                }
                 break;
             }
 
             case LAYER_TYPE_RELU: {
+                // In place, unless it is the last layer.
                 relu_layer_t *relu_layer = (relu_layer_t *) layer;
-                arm_relu_q7(input_buffer, relu_layer->h * relu_layer->w * relu_layer->c);
+                if (output_buffer != input_buffer) {
+                    memcpy(output_buffer, input_buffer, relu_layer->h * relu_layer->w * relu_layer->c);
+                }
+                if (!relu_layer->fused) {
+                    arm_relu_q7(output_buffer, relu_layer->h * relu_layer->w * relu_layer->c);
+                }
                 break;
             }
 
@@ -414,6 +1094,9 @@ int nn_run_network(nn_t *net, image_t *img, rectangle_t *roi, bool softmax)
                 }
                 pool_func(input_buffer, prev_layer->h, prev_layer->c, pool_layer->krn_dim,
                         pool_layer->krn_pad, pool_layer->krn_str, layer->w, col_buffer, output_buffer);
+                if (pool_layer->relu) {
+                    arm_relu_q7(output_buffer, pool_layer->h * pool_layer->w * pool_layer->c);
+                }
                 break;
             }
 
@@ -423,27 +1106,34 @@ int nn_run_network(nn_t *net, image_t *img, rectangle_t *roi, bool softmax)
                         ip_layer->c, ip_layer->l_shift, ip_layer->r_shift, ip_layer->bias, output_buffer, (q15_t*)col_buffer);
                 break;
             }
-        }
 
-        if (layer_idx++ > 0) {
-            if (input_buffer == input_data) {
-                // Image data has been processed
-                input_buffer = buffer2;
+            case LAYER_TYPE_CONV_S8: {
+                conv_layer_t *conv_layer = (conv_layer_t *) layer;
+                nn_convolve_s8(input_buffer, prev_layer->w, prev_layer->h, prev_layer->c, conv_layer->wt, conv_layer->c,
+                        conv_layer->krn_dim, conv_layer->krn_pad, conv_layer->krn_str, (int32_t *) conv_layer->bias,
+                        &conv_layer->quant, output_buffer, conv_layer->w, conv_layer->h, (q15_t*)col_buffer);
+                break;
             }
 
-            if (layer->type != LAYER_TYPE_RELU) {
-                // Switch buffers
-                q7_t *tmp_buffer = input_buffer;
-                input_buffer  = output_buffer;
-                output_buffer = tmp_buffer;
+            case LAYER_TYPE_DWCONV_S8: {
+                conv_layer_t *conv_layer = (conv_layer_t *) layer;
+                nn_depthwise_conv_s8(input_buffer, prev_layer->w, prev_layer->h, prev_layer->c, conv_layer->wt, conv_layer->c,
+                        conv_layer->krn_dim, conv_layer->krn_pad, conv_layer->krn_str, (int32_t *) conv_layer->bias,
+                        &conv_layer->quant, output_buffer, conv_layer->w, conv_layer->h);
+                break;
             }
 
-            // Last layer
-            if (layer->next && layer->next->next == NULL) {
-                output_buffer = net->output_data;
+            case LAYER_TYPE_IP_S8: {
+                ip_layer_t *ip_layer = (ip_layer_t*) layer;
+                nn_fully_connected_s8(input_buffer, ip_layer->wt, prev_layer->c * prev_layer->h * prev_layer->w,
+                        ip_layer->c, (int32_t *) ip_layer->bias, &ip_layer->quant, output_buffer, (q15_t*)col_buffer);
+                break;
             }
         }
 
+        if (net->profile) {
+            layer->cycles += DWT->CYCCNT - cycles;
+        }
         layer = layer->next;
     }
 
@@ -452,15 +1142,103 @@ int nn_run_network(nn_t *net, image_t *img, rectangle_t *roi, bool softmax)
         arm_softmax_q7(net->output_data, net->output_size, net->output_data);
     }
 
+    if (net->profile) {
+        net->profile_runs++;
+    }
+}
+
+int nn_run_network(nn_t *net, image_t *img, rectangle_t *roi, bool softmax)
+{
+    OMV_PROF_SCOPE("nn_run_network");
+    if (nn_check_network(net) != 0) {
+        return -1;
+    }
+
+    fb_alloc_mark();
+
+    // Every activation and im2col buffer lives in the planned arena, give it the fast tier.
+    q7_t *arena = fb_alloc(net->arena_size, FB_ALLOC_PREFER_SPEED);
+    nn_forward(net, arena, img, roi, softmax);
+
     fb_alloc_free_till_mark();
     return 0;
 }
 
+#ifdef IMLIB_ENABLE_PXP
+#define NN_PLANE_SCRATCH (4) // nn_transform_input_pxp() scales to XRGB8888 before normalizing
+#else
+#define NN_PLANE_SCRATCH (0)
+#endif
+
+int nn_run_network_batch(nn_t *net, image_t *img, rectangle_t *rois, int n_rois, bool softmax, int8_t *outputs)
+{
+    if (nn_check_network(net) != 0) {
+        return -1;
+    }
+
+    data_layer_t *data_layer = (data_layer_t *) net->layers;
+    uint32_t row_size = data_layer->w * data_layer->c;
+
+    fb_alloc_mark();
+
+    // One arena for all windows.
+    q7_t *arena = fb_alloc(net->arena_size, FB_ALLOC_PREFER_SPEED);
+    q7_t *input = arena + data_layer->out_offset;
+
+    for (int i=0, n; i<n_rois; i+=n) {
+        // Windows of one size share a single resized and normalized copy of their bounding
+        // box (the plane), each window's input is then a crop of it.
+        rectangle_t bounds = rois[i];
+        for (n=1; (i+n) < n_rois && rois[i+n].w == rois[i].w && rois[i+n].h == rois[i].h; n++) {
+            rectangle_united(&bounds, &rois[i+n]);
+        }
+
+        data_layer_t plane_layer = *data_layer;
+        plane_layer.w = (bounds.w * data_layer->w) / rois[i].w;
+        plane_layer.h = (bounds.h * data_layer->h) / rois[i].h;
+        uint32_t plane_pixels = plane_layer.w * plane_layer.h;
+        q7_t *plane = NULL;
+
+        if (n > 1 && plane_layer.w >= data_layer->w && plane_layer.h >= data_layer->h &&
+            plane_pixels * (data_layer->c + NN_PLANE_SCRATCH) <= fb_avail()) {
+            plane = fb_alloc(plane_pixels * data_layer->c, FB_ALLOC_NO_HINT);
+            nn_transform_input(&plane_layer, img, plane, &bounds);
+        }
+
+        for (int k=i; k<(i+n); k++) {
+            if (plane == NULL) {
+                nn_transform_input(data_layer, img, input, &rois[k]);
+            } else {
+                int x = IM_MIN((rois[k].x - bounds.x) * data_layer->w / rois[k].w, plane_layer.w - data_layer->w);
+                int y = IM_MIN((rois[k].y - bounds.y) * data_layer->h / rois[k].h, plane_layer.h - data_layer->h);
+                for (int j=0; j<data_layer->h; j++) {
+                    memcpy(input + (j * row_size), plane + ((((y + j) * plane_layer.w) + x) * data_layer->c), row_size);
+                }
+            }
+            nn_forward(net, arena, NULL, NULL, softmax);
+            memcpy(outputs + (k * net->output_size), net->output_data, net->output_size);
+        }
+
+        if (plane != NULL) {
+            fb_free();
+        }
+    }
+
+    fb_alloc_free_till_mark();
+    return 0;
+}
+
+static const char *nn_buffer_str(char *str, nn_t *net, q7_t *arena, q7_t *buffer)
+{
+    if (buffer == net->output_data) {
+        return "output_data";
+    }
+    snprintf(str, 16, "arena+%" PRIu32, (uint32_t) (buffer - arena));
+    return str;
+}
+
 #define BUFFER_2STR(buffer)\
-        (buffer == buffer1)     ? "buffer1":\
-        (buffer == buffer2)     ? "buffer2":\
-        (buffer == input_data)  ? "input_data":\
-        (buffer == net->output_data) ? "output_data": "???"
+        nn_buffer_str((buffer == input_buffer) ? input_str : output_str, net, arena, buffer)
 
 #define CONV_FUNC_2STR(conv_func)\
         (conv_func == arm_convolve_HWC_q7_basic) ? "arm_convolve_HWC_q7_basic" :\
@@ -471,7 +1249,6 @@ int nn_run_network(nn_t *net, image_t *img, rectangle_t *roi, bool softmax)
 
 int nn_dry_run_network(nn_t *net, image_t *img, bool softmax)
 {
-    uint32_t layer_idx = 0;
     layer_t *layer = net->layers;
 
     if (layer == NULL) {
@@ -484,23 +1261,20 @@ int nn_dry_run_network(nn_t *net, image_t *img, bool softmax)
         return -1;
     }
 
-    q7_t *input_data    = NULL;
-    q7_t *input_buffer  = NULL;
-    q7_t *output_buffer = NULL;
+    char input_str[16], output_str[16];
 
     fb_alloc_mark();
 
-    q7_t *buffer1     = fb_alloc(net->max_scrbuf_size, FB_ALLOC_NO_HINT);
-    q7_t *buffer2     = buffer1 + net->max_layer_size;
+    q7_t *arena = fb_alloc(net->arena_size, FB_ALLOC_PREFER_SPEED);
 
     while (layer != NULL) {
         layer_t *prev_layer = layer->prev;
+        q7_t *input_buffer  = (prev_layer == NULL) ? NULL : (arena + prev_layer->out_offset);
+        q7_t *output_buffer = (layer->next == NULL) ? net->output_data : (arena + layer->out_offset);
+
         switch (layer->type) {
             case LAYER_TYPE_DATA: {
-                data_layer_t *data_layer = (data_layer_t *) layer;
-                // Set image data as input buffer for the next layer.
-                input_buffer = input_data = fb_alloc(data_layer->c * data_layer->h * data_layer->w, FB_ALLOC_NO_HINT);
-                output_buffer = buffer1;
+                printf("forward: nn_transform_input(%s);\n", BUFFER_2STR(output_buffer));
                 break;
             }
 
@@ -516,19 +1290,62 @@ int nn_dry_run_network(nn_t *net, image_t *img, bool softmax)
                 } else {
                     conv_func = arm_convolve_HWC_q7_fast;
                 }
-                printf("forward: %s(%s, %lu, %lu, %s, %lu, %lu, %lu, %lu, %s, %lu, %lu, %s, %lu, %s, %p);\n",
-                        CONV_FUNC_2STR(conv_func), BUFFER_2STR(input_buffer),
+                printf("forward: %s(%s, %" PRIu32 ", %" PRIu32 ", %s, %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %s, %" PRIu32 ", %" PRIu32 ", %s, %" PRIu32 ", %s, %p);\n",
+                        nn_conv_3x3_direct(conv_layer, prev_layer) ? "nn_convolve_3x3_q7_direct" : CONV_FUNC_2STR(conv_func),
+                        BUFFER_2STR(input_buffer),
                         prev_layer->h, prev_layer->c, "conv_wt", conv_layer->c, 
                         conv_layer->krn_dim, conv_layer->krn_pad, conv_layer->krn_str,
                         "conv_bias", conv_layer->l_shift, conv_layer->r_shift,
                         BUFFER_2STR(output_buffer), conv_layer->h, "col_buffer", NULL);
+                if (conv_layer->relu) {
+                    printf("forward: arm_relu_q7(%s, %" PRIu32 "*%" PRIu32 "*%" PRIu32 "); // fused\n",
+                            BUFFER_2STR(output_buffer), conv_layer->h, conv_layer->w, conv_layer->c);
+                }
+                break;
+            }
+
+            case LAYER_TYPE_DWCONV: {
+                conv_layer_t *conv_layer = (conv_layer_t *) layer;
+                bool basic = (prev_layer->c % 2 != 0 || conv_layer->c != prev_layer->c);
+                printf("forward: %s(%s, %" PRIu32 ", %" PRIu32 ", %s, %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %s, %" PRIu32 ", %" PRIu32 ", %s, %" PRIu32 ", %s);\n",
+                        basic ? "nn_depthwise_conv_q7_basic" : "arm_depthwise_separable_conv_HWC_q7",
+                        BUFFER_2STR(input_buffer), prev_layer->h, prev_layer->c, "conv_wt", conv_layer->c,
+                        conv_layer->krn_dim, conv_layer->krn_pad, conv_layer->krn_str,
+                        "conv_bias", conv_layer->l_shift, conv_layer->r_shift,
+                        BUFFER_2STR(output_buffer), conv_layer->h, basic ? "relu" : "col_buffer");
+                if (conv_layer->relu && !basic) {
+                    printf("forward: arm_relu_q7(%s, %" PRIu32 "*%" PRIu32 "*%" PRIu32 "); // fused\n",
+                            BUFFER_2STR(output_buffer), conv_layer->h, conv_layer->w, conv_layer->c);
+                }
+                break;
+            }
+
+            case LAYER_TYPE_PWCONV: {
+                conv_layer_t *conv_layer = (conv_layer_t *) layer;
+                bool basic = (prev_layer->c % 4 != 0 || conv_layer->c % 2 != 0 ||
+                              conv_layer->krn_pad != 0 || conv_layer->krn_str != 1);
+                printf("forward: %s(%s, %" PRIu32 ", %" PRIu32 ", %s, %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %s, %" PRIu32 ", %" PRIu32 ", %s, %" PRIu32 ", %s);\n",
+                        basic ? "arm_convolve_HWC_q7_basic" : "arm_convolve_1x1_HWC_q7_fast_nonsquare",
+                        BUFFER_2STR(input_buffer), prev_layer->h, prev_layer->c, "conv_wt", conv_layer->c,
+                        conv_layer->krn_pad, conv_layer->krn_str, "conv_bias", conv_layer->l_shift, conv_layer->r_shift,
+                        BUFFER_2STR(output_buffer), conv_layer->h, "col_buffer");
+                if (conv_layer->relu) {
+                    printf("forward: arm_relu_q7(%s, %" PRIu32 "*%" PRIu32 "*%" PRIu32 "); // fused\n",
+                            BUFFER_2STR(output_buffer), conv_layer->h, conv_layer->w, conv_layer->c);
+                }
                 break;
             }
 
             case LAYER_TYPE_RELU: {
                 relu_layer_t *relu_layer = (relu_layer_t *) layer;
-                printf("forward: arm_relu_q7(%s, %lu*%lu*%lu);\n",
-                        BUFFER_2STR(input_buffer), relu_layer->h, relu_layer->w, relu_layer->c);
+                if (output_buffer != input_buffer) {
+                    printf("forward: memcpy(%s, %s, %" PRIu32 "*%" PRIu32 "*%" PRIu32 ");\n", BUFFER_2STR(output_buffer),
+                            BUFFER_2STR(input_buffer), relu_layer->h, relu_layer->w, relu_layer->c);
+                }
+                if (!relu_layer->fused) {
+                    printf("forward: arm_relu_q7(%s, %" PRIu32 "*%" PRIu32 "*%" PRIu32 ");\n",
+                            BUFFER_2STR(output_buffer), relu_layer->h, relu_layer->w, relu_layer->c);
+                }
                 break;
             }
 
@@ -540,40 +1357,46 @@ int nn_dry_run_network(nn_t *net, image_t *img, bool softmax)
                 } else {
                     pool_func = arm_avepool_q7_HWC;
                 }
-                printf("forward: %s(%s, %lu, %lu, %lu, %lu, %lu, %lu, %s, %s);\n",
+                printf("forward: %s(%s, %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %s, %s);\n",
                         POOL_FUNC_2STR(pool_func), BUFFER_2STR(input_buffer),
                         prev_layer->h, prev_layer->c, pool_layer->krn_dim,
                         pool_layer->krn_pad, pool_layer->krn_str, layer->w, "col_buffer", BUFFER_2STR(output_buffer));
+                if (pool_layer->relu) {
+                    printf("forward: arm_relu_q7(%s, %" PRIu32 "*%" PRIu32 "*%" PRIu32 "); // fused\n",
+                            BUFFER_2STR(output_buffer), pool_layer->h, pool_layer->w, pool_layer->c);
+                }
                 break;
             }
 
             case LAYER_TYPE_IP: {
                 ip_layer_t *ip_layer = (ip_layer_t*) layer;
-                printf("forward: arm_fully_connected_q7_opt(%s, %s, %lu, %lu, %lu, %lu, %s, %s, %s);\n",
+                printf("forward: arm_fully_connected_q7_opt(%s, %s, %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %s, %s, %s);\n",
                         BUFFER_2STR(input_buffer), "ip_wt", prev_layer->c * prev_layer->h * prev_layer->w,
                         ip_layer->c, ip_layer->l_shift, ip_layer->r_shift, "ip_bias", BUFFER_2STR(output_buffer), "col_buffer");
                 break;
             }
-        }
-
-        if (layer_idx++ > 0) {
-            if (input_buffer == input_data) {
-                // Image data has been processed
-                input_buffer = buffer2;
-            }
 
-            if (layer->type != LAYER_TYPE_RELU) {
-                // Switch buffers
-                q7_t *tmp_buffer = input_buffer;
-                input_buffer  = output_buffer;
-                output_buffer = tmp_buffer;
+            case LAYER_TYPE_CONV_S8:
+            case LAYER_TYPE_DWCONV_S8: {
+                conv_layer_t *conv_layer = (conv_layer_t *) layer;
+                bool dw = (layer->type == LAYER_TYPE_DWCONV_S8);
+                printf("forward: %s(%s, %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %s, %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %" PRIu32 ", %s, %s, %s, %" PRIu32 ", %" PRIu32 "%s);\n",
+                        dw ? "nn_depthwise_conv_s8" : "nn_convolve_s8", BUFFER_2STR(input_buffer),
+                        prev_layer->w, prev_layer->h, prev_layer->c, "conv_wt", conv_layer->c,
+                        conv_layer->krn_dim, conv_layer->krn_pad, conv_layer->krn_str, "conv_bias", "quant",
+                        BUFFER_2STR(output_buffer), conv_layer->w, conv_layer->h, dw ? "" : ", col_buffer");
+                break;
             }
 
-            // Last layer
-            if (layer->next && layer->next->next == NULL) {
-                output_buffer = net->output_data;
+            case LAYER_TYPE_IP_S8: {
+                ip_layer_t *ip_layer = (ip_layer_t*) layer;
+                printf("forward: nn_fully_connected_s8(%s, %s, %" PRIu32 ", %" PRIu32 ", %s, %s, %s, %s);\n",
+                        BUFFER_2STR(input_buffer), "ip_wt", prev_layer->c * prev_layer->h * prev_layer->w,
+                        ip_layer->c, "ip_bias", "quant", BUFFER_2STR(output_buffer), "col_buffer");
+                break;
             }
         }
+
         
         layer = layer->next;
     }
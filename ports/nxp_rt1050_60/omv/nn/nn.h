@@ -15,8 +15,17 @@ typedef enum {
     LAYER_TYPE_RELU,
     LAYER_TYPE_POOL,
     LAYER_TYPE_IP,
+    LAYER_TYPE_DWCONV,
+    LAYER_TYPE_PWCONV,
+    LAYER_TYPE_CONV_S8,
+    LAYER_TYPE_DWCONV_S8,
+    LAYER_TYPE_IP_S8,
 } layer_type_t;
 
+#define LAYER_IS_CONV(layer) ((layer)->type == LAYER_TYPE_CONV   ||\
+                              (layer)->type == LAYER_TYPE_DWCONV ||\
+                              (layer)->type == LAYER_TYPE_PWCONV)
+
 typedef enum {
     POOL_TYPE_MAX,
     POOL_TYPE_AVE,
@@ -26,9 +35,21 @@ typedef enum {
     NETWORK_TYPE_CAFFE = 0,
 } network_type_t;
 
+// TFLite int8 quantization of the _S8 layers, real = scale * (q - zero_point). Weights
+// are symmetric per output channel, each channel's scale is folded into mult/shift.
+typedef struct {
+    int32_t in_offset;          // -input zero point
+    int32_t out_offset;         // output zero point
+    int32_t act_min, act_max;   // Fused activation, clamps the output
+    int32_t *mult, *shift;      // Per output channel requantization, shift > 0 is a left shift
+} nn_s8_quant_t;
+
 #define NN_LAYER_BASE   \
     uint32_t type;      \
     uint32_t n, c, h, w;\
+    uint32_t out_offset;\
+    uint32_t col_offset;\
+    uint64_t cycles;    \
     struct _layer *prev;\
     struct _layer *next \
 
@@ -53,11 +74,14 @@ typedef struct {
     uint32_t krn_pad;
     uint32_t w_size;
     uint32_t b_size;
-    int8_t *wt, *bias;
+    int8_t *wt, *bias;  // _S8 layers have int32_t biases
+    uint32_t relu;  // ReLU applied to the output (fused)
+    nn_s8_quant_t quant;
 } conv_layer_t;
 
 typedef struct {
     NN_LAYER_BASE;
+    uint32_t fused; // Done by the conv layer before it
 } relu_layer_t;
 
 typedef struct {
@@ -66,6 +90,7 @@ typedef struct {
     uint32_t krn_dim;
     uint32_t krn_str;
     uint32_t krn_pad;
+    uint32_t relu;  // ReLU of the conv before it, moved after the max pool
 } pool_layer_t;
 
 typedef struct {
@@ -75,6 +100,7 @@ typedef struct {
     uint32_t w_size;
     uint32_t b_size;
     int8_t *wt, *bias;
+    nn_s8_quant_t quant;
 } ip_layer_t;
 
 typedef struct {
@@ -82,12 +108,18 @@ typedef struct {
     uint32_t n_layers;
     int8_t  *output_data;
     uint32_t output_size;
-    uint32_t max_layer_size;
-    uint32_t max_colbuf_size;
-    uint32_t max_scrbuf_size;
+    uint32_t arena_size;    // Activations and scratch buffers, see out_offset/col_offset
+    uint32_t profile;       // Add each layer's DWT cycles to layer->cycles
+    uint32_t profile_runs;  // Forward passes profiled
     layer_t *layers;
 } nn_t;
 
+typedef struct {
+    uint32_t macs;
+    uint32_t bytes_read;    // Input activations, weights and biases
+    uint32_t bytes_written;
+} nn_layer_stats_t;
+
 typedef arm_status (*conv_func_t) (const q7_t * Im_in, const uint16_t dim_im_in, const uint16_t ch_im_in,
         const q7_t * wt, const uint16_t ch_im_out, const uint16_t dim_kernel, const uint16_t padding,
         const uint16_t stride, const q7_t * bias, const uint16_t bias_shift, const uint16_t out_shift,
@@ -99,7 +131,13 @@ typedef void (*pool_func_t)(q7_t * Im_in, const uint16_t dim_im_in, const uint16
 
 
 int nn_dump_network(nn_t *net);
+void nn_profile_reset(nn_t *net);
+void nn_layer_stats(layer_t *layer, nn_layer_stats_t *stats);
 int nn_load_network(nn_t *net, const char *path);
+// Loads a network image mapped in memory, weights stay in place (e.g. the flash model store).
+int nn_load_network_xip(nn_t *net, const uint8_t *data, uint32_t size);
 int nn_run_network(nn_t *net, image_t *img, rectangle_t *roi, bool softmax);
+// Runs every ROI, outputs holds n_rois * net->output_size results in ROI order.
+int nn_run_network_batch(nn_t *net, image_t *img, rectangle_t *rois, int n_rois, bool softmax, int8_t *outputs);
 int nn_dry_run_network(nn_t *net, image_t *img, bool softmax);
 #endif //#define __CNN_H__
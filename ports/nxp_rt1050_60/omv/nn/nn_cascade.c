@@ -0,0 +1,97 @@
+/* This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Model cascades.
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "arm_math.h"
+#include "fmath.h"
+#include "nn_cascade.h"
+
+void nn_cascade_init(nn_cascade_t *cascade, nn_cascade_gate_t gate, float threshold)
+{
+    memset(cascade, 0, sizeof(nn_cascade_t));
+    cascade->gate = gate;
+    cascade->threshold = threshold;
+}
+
+void nn_cascade_start(nn_cascade_t *cascade)
+{
+    cascade->t0 = DWT->CYCCNT;
+}
+
+// Samples the ROI luminance on the grid, no more than one read per grid point.
+static void nn_cascade_sample(image_t *img, rectangle_t *roi, uint8_t *grid)
+{
+    for (int y = 0; y < NN_CASCADE_GRID_H; y++) {
+        int src_y = roi->y + (((y * 2 + 1) * roi->h) / (NN_CASCADE_GRID_H * 2));
+        for (int x = 0; x < NN_CASCADE_GRID_W; x++) {
+            int src_x = roi->x + (((x * 2 + 1) * roi->w) / (NN_CASCADE_GRID_W * 2));
+            switch (img->bpp) {
+                case IMAGE_BPP_BINARY: {
+                    uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, src_y);
+                    *grid++ = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, src_x));
+                    break;
+                }
+                case IMAGE_BPP_GRAYSCALE: {
+                    uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, src_y);
+                    *grid++ = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, src_x);
+                    break;
+                }
+                case IMAGE_BPP_RGB565: {
+                    uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, src_y);
+                    *grid++ = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, src_x));
+                    break;
+                }
+                default: {
+                    *grid++ = 0;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+float nn_cascade_score(nn_cascade_t *cascade, image_t *img, rectangle_t *roi)
+{
+    uint8_t grid[NN_CASCADE_GRID_W * NN_CASCADE_GRID_H];
+    nn_cascade_sample(img, roi, grid);
+
+    if (cascade->gate == NN_CASCADE_GATE_MOTION) {
+        // Nothing to compare the first frame with, let it through.
+        uint32_t sad = 0;
+        for (int i = 0; i < (NN_CASCADE_GRID_W * NN_CASCADE_GRID_H); i++) {
+            sad += abs(grid[i] - cascade->prev[i]);
+        }
+        float score = cascade->has_prev ? (sad / (255.0f * NN_CASCADE_GRID_W * NN_CASCADE_GRID_H)) : 1.0f;
+        memcpy(cascade->prev, grid, sizeof(grid));
+        cascade->has_prev = true;
+        return score;
+    }
+
+    uint32_t sum = 0, sum_sq = 0;
+    for (int i = 0; i < (NN_CASCADE_GRID_W * NN_CASCADE_GRID_H); i++) {
+        sum += grid[i];
+        sum_sq += grid[i] * grid[i];
+    }
+    float mean = sum / (float) (NN_CASCADE_GRID_W * NN_CASCADE_GRID_H);
+    float var = (sum_sq / (float) (NN_CASCADE_GRID_W * NN_CASCADE_GRID_H)) - (mean * mean);
+    // The largest 8-bit standard deviation is 127.5.
+    return fast_sqrtf(IM_MAX(var, 0.0f)) / 127.5f;
+}
+
+bool nn_cascade_gate_done(nn_cascade_t *cascade, float score)
+{
+    cascade->gate_cycles += DWT->CYCCNT - cascade->t0;
+    cascade->frames += 1;
+    cascade->score = score;
+    return score >= cascade->threshold;
+}
+
+void nn_cascade_model_done(nn_cascade_t *cascade)
+{
+    cascade->model_cycles += DWT->CYCCNT - cascade->t0;
+    cascade->runs += 1;
+}
@@ -0,0 +1,45 @@
+/* This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Model cascades.
+ *
+ * A cheap first stage scores each frame and the expensive model only runs when the
+ * score reaches the threshold, so empty frames cost the gate and nothing else.
+ *
+ */
+#ifndef __NN_CASCADE_H__
+#define __NN_CASCADE_H__
+#include <stdint.h>
+#include <imlib.h>
+
+typedef enum {
+    NN_CASCADE_GATE_VARIANCE,  // Luminance standard deviation of the ROI
+    NN_CASCADE_GATE_MOTION,    // Mean absolute difference from the previous frame
+    NN_CASCADE_GATE_MODEL,     // One output of a small model, run by the caller
+} nn_cascade_gate_t;
+
+// Grid the statistic gates sample the ROI on.
+#define NN_CASCADE_GRID_W  (32)
+#define NN_CASCADE_GRID_H  (24)
+
+typedef struct {
+    nn_cascade_gate_t gate;
+    float threshold;        // Scores are 0.0 to 1.0, the model runs at or above this
+    float score;            // Last frame's score
+    uint32_t frames, runs;  // Frames gated and frames the model ran on
+    uint32_t t0;
+    uint64_t gate_cycles, model_cycles;
+    bool has_prev;
+    uint8_t prev[NN_CASCADE_GRID_W * NN_CASCADE_GRID_H];
+} nn_cascade_t;
+
+void nn_cascade_init(nn_cascade_t *cascade, nn_cascade_gate_t gate, float threshold);
+// Starts timing a stage.
+void nn_cascade_start(nn_cascade_t *cascade);
+// Score of the statistic gates, to be called between nn_cascade_start() and nn_cascade_gate_done().
+float nn_cascade_score(nn_cascade_t *cascade, image_t *img, rectangle_t *roi);
+// Ends the gate stage, returns true if the model should run.
+bool nn_cascade_gate_done(nn_cascade_t *cascade, float score);
+// Ends the model stage.
+void nn_cascade_model_done(nn_cascade_t *cascade);
+#endif // __NN_CASCADE_H__
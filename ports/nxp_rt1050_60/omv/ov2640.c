@@ -352,9 +352,7 @@ static int reset(sensor_t *sensor)
     systick_sleep(5);
 
     // Write default regsiters
-    for (int i = 0; default_regs[i][0]; i++) {
-        ret |= cambus_writeb(sensor->slv_addr, default_regs[i][0], default_regs[i][1]);
-    }
+    ret |= cambus_write_regs(sensor->slv_addr, default_regs, -1);
 
     // Delay 300 ms
     systick_sleep(300);
@@ -413,9 +411,7 @@ static int set_pixformat(sensor_t *sensor, pixformat_t pixformat)
     }
 
     // Write regsiters
-    for (int i = 0; regs[i][0]; i++) {
-        ret |= cambus_writeb(sensor->slv_addr, regs[i][0], regs[i][1]);
-    }
+    ret |= cambus_write_regs(sensor->slv_addr, regs, -1);
 
     // Delay 300 ms
     systick_sleep(300);
@@ -452,9 +448,7 @@ static int set_framesize(sensor_t *sensor, framesize_t framesize)
     }
 
     // Write setup regsiters
-    for (int i = 0; regs[i][0]; i++) {
-        ret |= cambus_writeb(sensor->slv_addr, regs[i][0], regs[i][1]);
-    }
+    ret |= cambus_write_regs(sensor->slv_addr, regs, -1);
 
     uint64_t tmp_div = IM_MIN(sensor_w / w, sensor_h / h);
     uint16_t log_div = IM_MIN(IM_LOG2(tmp_div) - 1, 3);
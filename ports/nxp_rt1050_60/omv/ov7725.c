@@ -6,6 +6,7 @@
  * OV7725 driver.
  *
  */
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -152,9 +153,6 @@ static const uint8_t saturation_regs[NUM_SATURATION_LEVELS][2] = {
 
 static int reset(sensor_t *sensor)
 {
-    int i=0;
-    const uint8_t (*regs)[2];
-
     // Reset all registers
     cambus_writeb(sensor->slv_addr, COM7, COM7_RESET);
 
@@ -162,12 +160,10 @@ static int reset(sensor_t *sensor)
     systick_sleep(2+1);
 
     // Write default regsiters
-    for (i=0, regs = default_regs; regs[i][0]; i++) {
-        cambus_writeb(sensor->slv_addr, regs[i][0], regs[i][1]);
-    }
+    cambus_write_regs(sensor->slv_addr, default_regs, -1);
 
-    // Delay
-    systick_sleep(30);
+    // Let them settle before the first frame, not here
+    sensor_settle(30);
 
     return 0;
 }
@@ -201,84 +197,100 @@ static int write_reg(sensor_t *sensor, uint16_t reg_addr, uint16_t reg_data)
     return cambus_writeb(sensor->slv_addr, reg_addr, reg_data);
 }
 
-static int set_pixformat(sensor_t *sensor, pixformat_t pixformat)
+// The registers of a pixel format, COM7 keeps its other bits from com7.
+// Returns the number of ops, -1 if the format is not supported.
+static int pixformat_ops(pixformat_t pixformat, uint8_t com7, cambus_op_t *ops)
 {
-    uint8_t reg;
-    int ret = cambus_readb(sensor->slv_addr, COM7, &reg);
+    uint8_t fmt, ctrl4;
 
     switch (pixformat) {
         case PIXFORMAT_RGB565:
-            reg = COM7_SET_FMT(reg, COM7_FMT_RGB);
-            ret |= cambus_writeb(sensor->slv_addr, DSP_CTRL4, DSP_CTRL4_YUV_RGB);
+            fmt = COM7_FMT_RGB;
+            ctrl4 = DSP_CTRL4_YUV_RGB;
             break;
         case PIXFORMAT_YUV422:
         case PIXFORMAT_GRAYSCALE:
-            reg = COM7_SET_FMT(reg, COM7_FMT_YUV);
-            ret |= cambus_writeb(sensor->slv_addr, DSP_CTRL4, DSP_CTRL4_YUV_RGB);
+            fmt = COM7_FMT_YUV;
+            ctrl4 = DSP_CTRL4_YUV_RGB;
             break;
         case PIXFORMAT_BAYER:
-            reg = COM7_SET_FMT(reg, COM7_FMT_P_BAYER);
-            ret |= cambus_writeb(sensor->slv_addr, DSP_CTRL4, DSP_CTRL4_RAW8);
+            fmt = COM7_FMT_P_BAYER;
+            ctrl4 = DSP_CTRL4_RAW8;
             break;
         default:
             return -1;
     }
 
-    // Write back register
-    return cambus_writeb(sensor->slv_addr, COM7, reg) | ret;
+    ops[0] = (cambus_op_t) { DSP_CTRL4, ctrl4 };
+    ops[1] = (cambus_op_t) { COM7, COM7_SET_FMT(com7, fmt) };
+    return 2;
 }
 
-static int set_framesize(sensor_t *sensor, framesize_t framesize)
+static int set_pixformat(sensor_t *sensor, pixformat_t pixformat)
 {
-    int ret=0;
-    uint16_t w = resolution[framesize][0];
-    uint16_t h = resolution[framesize][1];
+    uint8_t reg;
+    cambus_op_t ops[2];
+    int ret = cambus_readb(sensor->slv_addr, COM7, &reg);
 
-    // Write MSBs
-    ret |= cambus_writeb(sensor->slv_addr, HOUTSIZE, w>>2);
-    ret |= cambus_writeb(sensor->slv_addr, VOUTSIZE, h>>1);
+    int n = pixformat_ops(pixformat, reg, ops);
+    if (n < 0) {
+        return -1;
+    }
+    return cambus_batch(sensor->slv_addr, ops, n) | ret;
+}
 
-    // Write LSBs
-    ret |= cambus_writeb(sensor->slv_addr, EXHCH, ((w&0x3) | ((h&0x1) << 2)));
+// The registers of a frame size, COM7 keeps its other bits from com7. Returns the number
+// of ops, at most FRAMESIZE_OPS_MAX.
+#define FRAMESIZE_OPS_MAX   (12)
+static int framesize_ops(framesize_t framesize, uint8_t com7, cambus_op_t *ops)
+{
+    uint16_t w = resolution[framesize][0];
+    uint16_t h = resolution[framesize][1];
+    bool qvga = (w <= 320) && (h <= 240);
+
+    const cambus_op_t regs[FRAMESIZE_OPS_MAX] = {
+        // Write MSBs, then LSBs
+        { HOUTSIZE, w>>2 },
+        { VOUTSIZE, h>>1 },
+        { EXHCH, ((w&0x3) | ((h&0x1) << 2)) },
+        // Set QVGA/VGA Resolution and Window Size
+        { COM7,   COM7_SET_RES(com7, qvga ? COM7_RES_QVGA : COM7_RES_VGA) },
+        { HSTART, qvga ? 0x3F : 0x23 },
+        { HSIZE,  qvga ? 0x50 : 0xA0 },
+        { VSTART, qvga ? 0x03 : 0x07 },
+        { VSIZE,  qvga ? 0x78 : 0xF0 },
+        // Enable auto-scaling/zooming factors on QVGA, disable and clear them on VGA
+        { DSPAUTO, qvga ? 0xFF : 0xF3 },
+        { SCAL0, 0x00 },
+        { SCAL1, 0x40 },
+        { SCAL2, 0x40 },
+    };
+
+    int n = qvga ? 9 : FRAMESIZE_OPS_MAX;
+    memcpy(ops, regs, n * sizeof(cambus_op_t));
+    return n;
+}
 
-    if ((w <= 320) && (h <= 240)) {
-        // Set QVGA Resolution
-        uint8_t reg;
-        int ret = cambus_readb(sensor->slv_addr, COM7, &reg);
-        reg = COM7_SET_RES(reg, COM7_RES_QVGA);
-        ret |= cambus_writeb(sensor->slv_addr, COM7, reg);
+static int set_framesize(sensor_t *sensor, framesize_t framesize)
+{
+    uint8_t reg;
+    cambus_op_t ops[FRAMESIZE_OPS_MAX];
+    int ret = cambus_readb(sensor->slv_addr, COM7, &reg);
 
-        // Set QVGA Window Size
-        ret |= cambus_writeb(sensor->slv_addr, HSTART, 0x3F);
-        ret |= cambus_writeb(sensor->slv_addr, HSIZE,  0x50);
-        ret |= cambus_writeb(sensor->slv_addr, VSTART, 0x03);
-        ret |= cambus_writeb(sensor->slv_addr, VSIZE,  0x78);
+    // one batch, so this is quick enough to change per frame
+    int n = framesize_ops(framesize, reg, ops);
+    return cambus_batch(sensor->slv_addr, ops, n) | ret;
+}
 
-        // Enable auto-scaling/zooming factors
-        ret |= cambus_writeb(sensor->slv_addr, DSPAUTO, 0xFF);
-    } else {
-        // Set VGA Resolution
-        uint8_t reg;
-        int ret = cambus_readb(sensor->slv_addr, COM7, &reg);
-        reg = COM7_SET_RES(reg, COM7_RES_VGA);
-        ret |= cambus_writeb(sensor->slv_addr, COM7, reg);
-
-        // Set VGA Window Size
-        ret |= cambus_writeb(sensor->slv_addr, HSTART, 0x23);
-        ret |= cambus_writeb(sensor->slv_addr, HSIZE,  0xA0);
-        ret |= cambus_writeb(sensor->slv_addr, VSTART, 0x07);
-        ret |= cambus_writeb(sensor->slv_addr, VSIZE,  0xF0);
-
-        // Disable auto-scaling/zooming factors
-        ret |= cambus_writeb(sensor->slv_addr, DSPAUTO, 0xF3);
-
-        // Clear auto-scaling/zooming factors
-        ret |= cambus_writeb(sensor->slv_addr, SCAL0, 0x00);
-        ret |= cambus_writeb(sensor->slv_addr, SCAL1, 0x40);
-        ret |= cambus_writeb(sensor->slv_addr, SCAL2, 0x40);
+// Both of the above, for sensor_set_mode() to keep, with COM7 only once.
+static int get_mode_regs(sensor_t *sensor, framesize_t framesize, pixformat_t pixformat, cambus_op_t *ops)
+{
+    uint8_t reg;
+    if (cambus_readb(sensor->slv_addr, COM7, &reg) != 0
+        || pixformat_ops(pixformat, reg, ops) < 0) {
+        return -1;
     }
-
-    return ret;
+    return 1 + framesize_ops(framesize, ops[1].val, ops + 1);
 }
 
 static int set_framerate(sensor_t *sensor, framerate_t framerate)
@@ -595,6 +607,7 @@ int ov7725_init(sensor_t *sensor)
     sensor->write_reg           = write_reg;
     sensor->set_pixformat       = set_pixformat;
     sensor->set_framesize       = set_framesize;
+    sensor->get_mode_regs       = get_mode_regs;
     sensor->set_framerate       = set_framerate;
     sensor->set_contrast        = set_contrast;
     sensor->set_brightness      = set_brightness;
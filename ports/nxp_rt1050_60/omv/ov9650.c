@@ -201,7 +201,6 @@ static const uint8_t yuv422_regs[][2] = {
 
 static int reset(sensor_t *sensor)
 {
-    int i=0;
     const uint8_t (*regs)[2]=default_regs;
 
     /* Reset all registers */
@@ -211,17 +210,13 @@ static int reset(sensor_t *sensor)
     systick_sleep(10);
 
     /* Write initial regsiters */
-    while (regs[i][0]) {
-        cambus_writeb(sensor->slv_addr, regs[i][0], regs[i][1]);
-        i++;
-    }
+    cambus_write_regs(sensor->slv_addr, regs, -1);
 
     return 0;
 }
 
 static int set_pixformat(sensor_t *sensor, pixformat_t pixformat)
 {
-    int i=0;
     const uint8_t (*regs)[2];
     uint8_t com7=0; /* framesize/RGB */
 
@@ -249,10 +244,7 @@ static int set_pixformat(sensor_t *sensor, pixformat_t pixformat)
     cambus_writeb(sensor->slv_addr, REG_COM7, com7);
 
     /* Write pixel format registers */
-    while (regs[i][0]) {
-        cambus_writeb(sensor->slv_addr, regs[i][0], regs[i][1]);
-        i++;
-    }
+    cambus_write_regs(sensor->slv_addr, regs, -1);
 
     return 0;
 }
@@ -0,0 +1,51 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Cycle counts per named scope, read with omv.perf().
+ *
+ */
+#include <stddef.h>
+#include "py/mphal.h"
+#include "perf.h"
+
+#if defined(OMV_ENABLE_PERF) && defined(__GNUC__)
+static omv_perf_t *perf_head, **perf_tail = &perf_head;
+
+void omv_perf_register(omv_perf_t *scope)
+{
+    mp_hal_ticks_cpu_enable();
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    if (!scope->registered) {
+        scope->registered = 1;
+        *perf_tail = scope;
+        perf_tail = &scope->next;
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+}
+
+struct _omv_perf_t *omv_perf_list(void)
+{
+    return perf_head;
+}
+
+void omv_perf_reset(void)
+{
+    for (omv_perf_t *scope = perf_head; scope; scope = scope->next) {
+        mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+        scope->calls = 0;
+        scope->cycles = 0;
+        scope->cycles_max = 0;
+        MICROPY_END_ATOMIC_SECTION(atomic_state);
+    }
+}
+#else
+struct _omv_perf_t *omv_perf_list(void)
+{
+    return NULL;
+}
+
+void omv_perf_reset(void)
+{
+}
+#endif
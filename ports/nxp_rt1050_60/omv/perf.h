@@ -0,0 +1,70 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Cycle counts per named scope, read with omv.perf().
+ *
+ */
+#ifndef __PERF_H__
+#define __PERF_H__
+#include <stdint.h>
+#include "imlib_config.h"
+
+#if defined(OMV_ENABLE_PERF) && defined(__GNUC__)
+#include "fsl_device_registers.h"
+
+typedef struct _omv_perf_t {
+    const char *name;
+    struct _omv_perf_t *next;   // registered scopes, in order of first use
+    uint8_t registered;
+    uint32_t calls;
+    uint32_t cycles_max;
+    uint64_t cycles;
+} omv_perf_t;
+
+typedef struct _omv_perf_mark_t {
+    omv_perf_t *scope;
+    uint32_t start;
+} omv_perf_mark_t;
+
+void omv_perf_register(omv_perf_t *scope);
+
+static inline omv_perf_mark_t omv_perf_begin(omv_perf_t *scope)
+{
+    if (!scope->registered) {
+        omv_perf_register(scope);
+    }
+    omv_perf_mark_t mark = { scope, DWT->CYCCNT };
+    return mark;
+}
+
+static inline void omv_perf_end(omv_perf_mark_t *mark)
+{
+    uint32_t cycles = DWT->CYCCNT - mark->start;
+    omv_perf_t *scope = mark->scope;
+    scope->calls++;
+    scope->cycles += cycles;
+    if (cycles > scope->cycles_max) {
+        scope->cycles_max = cycles;
+    }
+}
+
+#define OMV_PERF_CAT_(a, b) a##b
+#define OMV_PERF_CAT(a, b)  OMV_PERF_CAT_(a, b)
+
+// Counts the cycles from here to the end of the enclosing block, nested scopes count in
+// their parent's too. Declarations only, so it goes at the top of a block. A scope left
+// with nlr_raise() is not counted.
+#define OMV_PROF_SCOPE(name) \
+    static omv_perf_t OMV_PERF_CAT(omv_perf_, __LINE__) = { (name) }; \
+    omv_perf_mark_t OMV_PERF_CAT(omv_perf_mark_, __LINE__) __attribute__((cleanup(omv_perf_end))) = \
+        omv_perf_begin(&OMV_PERF_CAT(omv_perf_, __LINE__))
+#else
+#define OMV_PROF_SCOPE(name)
+#endif
+
+// Head of the registered scopes, NULL without OMV_ENABLE_PERF.
+struct _omv_perf_t *omv_perf_list(void);
+// Zeroes the counts of all scopes.
+void omv_perf_reset(void);
+#endif // __PERF_H__
@@ -0,0 +1,359 @@
+/*
+ * PXP 2D engine backend for imlib.
+ *
+ * Scales, flips and converts between RGB565 and grayscale with the i.MX RT PXP,
+ * so the CPU is free while a frame is being resized or converted.
+ *
+ */
+#include <stdbool.h>
+#include "fsl_pxp.h"
+#include "dma.h"
+#include "pxp_2d.h"
+
+// The PXP scaler shrinks by at most 16 (8x decimation, then 2x scaling).
+#define PXP_2D_MAX_DOWNSCALE (16)
+
+static bool pxp_2d_inited;
+static volatile bool pxp_2d_busy;
+
+// Output of the running job, imlib RGB565 output is byte swapped once it is done.
+static uint8_t *pxp_2d_dst;
+static uint32_t pxp_2d_dst_pitch, pxp_2d_dst_line_bytes, pxp_2d_dst_h;
+static bool pxp_2d_dst_swap;
+
+// imlib grayscale is the Y of YUV, keep the same weights.
+static const pxp_csc2_config_t pxp_2d_rgb_to_y = {
+    .mode = kPXP_Csc2RGB2YUV,
+    .A1 = 0.299f, .A2 = 0.587f, .A3 = 0.114f,
+    .B1 = 0.0f,   .B2 = 0.0f,   .B3 = 0.0f,
+    .C1 = 0.0f,   .C2 = 0.0f,   .C3 = 0.0f,
+    .D1 = 0, .D2 = 0, .D3 = 0,
+};
+
+// The JPEG full range YCbCr matrix, Cb and Cr are offset to be unsigned.
+static const pxp_csc2_config_t pxp_2d_rgb_to_ycbcr = {
+    .mode = kPXP_Csc2RGB2YUV,
+    .A1 = 0.299f,   .A2 = 0.587f,   .A3 = 0.114f,
+    .B1 = -0.1687f, .B2 = -0.3313f, .B3 = 0.5f,
+    .C1 = 0.5f,     .C2 = -0.4187f, .C3 = -0.0813f,
+    .D1 = 0, .D2 = 128, .D3 = 128,
+};
+
+static int pxp_2d_bytes_per_pixel(int bpp)
+{
+    switch (bpp) {
+        case IMAGE_BPP_GRAYSCALE:
+            return 1;
+        case IMAGE_BPP_RGB565:
+        case PXP_2D_BPP_RGB565_LE:
+            return 2;
+        case PXP_2D_BPP_XRGB8888:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+static bool pxp_2d_get_roi(image_t *img, rectangle_t *roi, rectangle_t *out)
+{
+    if (roi) {
+        *out = *roi;
+    } else {
+        rectangle_init(out, 0, 0, img->w, img->h);
+    }
+    return (out->w > 0) && (out->h > 0) && (out->x >= 0) && (out->y >= 0)
+        && ((out->x + out->w) <= img->w) && ((out->y + out->h) <= img->h);
+}
+
+int pxp_2d_start(image_t *src, rectangle_t *src_roi, image_t *dst, rectangle_t *dst_roi, int flip)
+{
+    rectangle_t s, d;
+    int src_bpp = pxp_2d_bytes_per_pixel(src->bpp);
+    int dst_bpp = pxp_2d_bytes_per_pixel(dst->bpp);
+
+    if ((src->bpp != IMAGE_BPP_GRAYSCALE) && (src->bpp != IMAGE_BPP_RGB565)) {
+        return -1;
+    }
+    if ((!dst_bpp) || (!pxp_2d_get_roi(src, src_roi, &s)) || (!pxp_2d_get_roi(dst, dst_roi, &d))) {
+        return -1;
+    }
+    if ((s.w > (d.w * PXP_2D_MAX_DOWNSCALE)) || (s.h > (d.h * PXP_2D_MAX_DOWNSCALE))) {
+        return -1;
+    }
+
+    uint32_t src_pitch = src->w * src_bpp, dst_pitch = dst->w * dst_bpp;
+    if ((src_pitch > 0xFFFF) || (dst_pitch > 0xFFFF)) {
+        return -1;
+    }
+
+    pxp_2d_wait();
+    if (!pxp_2d_inited) {
+        PXP_Init(PXP);
+        pxp_2d_inited = true;
+    }
+
+    uint8_t *src_addr = src->data + (s.y * src_pitch) + (s.x * src_bpp);
+    uint8_t *dst_addr = dst->data + (d.y * dst_pitch) + (d.x * dst_bpp);
+    uint32_t src_bytes = ((s.h - 1) * src_pitch) + (s.w * src_bpp);
+    uint32_t dst_bytes = ((d.h - 1) * dst_pitch) + (d.w * dst_bpp);
+
+    // PXP reads and writes memory behind the cache. The destination rows share lines
+    // with pixels outside the rectangle, so it is cleaned rather than just dropped.
+    dma_begin_write(src_addr, src_bytes);
+    dma_begin_write(dst_addr, dst_bytes);
+
+    pxp_ps_buffer_config_t ps_config = {
+        .pixelFormat = (src->bpp == IMAGE_BPP_GRAYSCALE) ? kPXP_PsPixelFormatY8 : kPXP_PsPixelFormatRGB565,
+        .swapByte = (src->bpp == IMAGE_BPP_RGB565), // imlib RGB565 is big endian
+        .bufferAddr = (uint32_t) src_addr,
+        .pitchBytes = src_pitch,
+    };
+    pxp_output_buffer_config_t out_config = {
+        .interlacedMode = kPXP_OutputProgressive,
+        .buffer0Addr = (uint32_t) dst_addr,
+        .pitchBytes = dst_pitch,
+        .width = d.w,
+        .height = d.h,
+    };
+    switch (dst->bpp) {
+        case IMAGE_BPP_GRAYSCALE:
+            out_config.pixelFormat = kPXP_OutputPixelFormatY8;
+            break;
+        case PXP_2D_BPP_XRGB8888:
+            out_config.pixelFormat = kPXP_OutputPixelFormatRGB888;
+            break;
+        default:
+            out_config.pixelFormat = kPXP_OutputPixelFormatRGB565;
+            break;
+    }
+
+    PXP_SetProcessSurfaceBackGroundColor(PXP, 0);
+    PXP_SetProcessSurfaceBufferConfig(PXP, &ps_config);
+    PXP_SetProcessSurfaceScaler(PXP, s.w, s.h, d.w, d.h);
+    PXP_SetProcessSurfacePosition(PXP, 0, 0, d.w - 1, d.h - 1);
+    PXP_SetAlphaSurfacePosition(PXP, 0xFFFF, 0xFFFF, 0, 0); // no alpha surface
+
+    // Gray in, color out.
+    if ((src->bpp == IMAGE_BPP_GRAYSCALE) && (dst->bpp != IMAGE_BPP_GRAYSCALE)) {
+        PXP_SetCsc1Mode(PXP, kPXP_Csc1YUV2RGB);
+        PXP_EnableCsc1(PXP, true);
+    } else {
+        PXP_EnableCsc1(PXP, false);
+    }
+
+    // Color in, gray out.
+    if ((src->bpp == IMAGE_BPP_RGB565) && (dst->bpp == IMAGE_BPP_GRAYSCALE)) {
+        PXP_SetCsc2Config(PXP, &pxp_2d_rgb_to_y);
+        PXP_EnableCsc2(PXP, true);
+    } else {
+        PXP_EnableCsc2(PXP, false);
+    }
+
+    PXP_SetRotateConfig(PXP, kPXP_RotateOutputBuffer, kPXP_Rotate0, (pxp_flip_mode_t) (flip & 3));
+    PXP_SetOutputBufferConfig(PXP, &out_config);
+
+    pxp_2d_dst = dst_addr;
+    pxp_2d_dst_pitch = dst_pitch;
+    pxp_2d_dst_line_bytes = d.w * dst_bpp;
+    pxp_2d_dst_h = d.h;
+    pxp_2d_dst_swap = (dst->bpp == IMAGE_BPP_RGB565);
+
+    PXP_ClearStatusFlags(PXP, kPXP_CompleteFlag);
+    pxp_2d_busy = true;
+    PXP_Start(PXP);
+    return 0;
+}
+
+void pxp_2d_wait()
+{
+    if (!pxp_2d_busy) {
+        return;
+    }
+
+    while (!(PXP_GetStatusFlags(PXP) & kPXP_CompleteFlag)) {
+    }
+    PXP_ClearStatusFlags(PXP, kPXP_CompleteFlag);
+    pxp_2d_busy = false;
+
+    dma_end_read(pxp_2d_dst, ((pxp_2d_dst_h - 1) * pxp_2d_dst_pitch) + pxp_2d_dst_line_bytes);
+
+    if (pxp_2d_dst_swap) {
+        for (uint32_t y = 0; y < pxp_2d_dst_h; y++) {
+            uint16_t *row_ptr = (uint16_t *) (pxp_2d_dst + (y * pxp_2d_dst_pitch));
+            for (uint32_t x = 0, xx = pxp_2d_dst_line_bytes / 2; x < xx; x++) {
+                row_ptr[x] = __REV16(row_ptr[x]);
+            }
+        }
+    }
+}
+
+int pxp_2d_blit(image_t *src, rectangle_t *src_roi, image_t *dst, rectangle_t *dst_roi, int flip)
+{
+    if (pxp_2d_start(src, src_roi, dst, dst_roi, flip) != 0) {
+        return -1;
+    }
+    pxp_2d_wait();
+    return 0;
+}
+
+int pxp_2d_ycbcr420(image_t *src, uint8_t *planes)
+{
+    if ((src->bpp != IMAGE_BPP_RGB565) || (src->w <= 0) || (src->h <= 0) || (src->w % 2) || (src->h % 2)) {
+        return -1;
+    }
+
+    uint32_t src_pitch = src->w * sizeof(uint16_t), size = src->w * src->h;
+    if (src_pitch > 0xFFFF) {
+        return -1;
+    }
+
+    pxp_2d_wait();
+    if (!pxp_2d_inited) {
+        PXP_Init(PXP);
+        pxp_2d_inited = true;
+    }
+
+    // PXP writes every byte of the planes, their stale lines are dropped instead of cleaned.
+    dma_begin_write(src->data, src_pitch * src->h);
+    dma_begin_read(planes, size + (size / 2));
+
+    pxp_ps_buffer_config_t ps_config = {
+        .pixelFormat = kPXP_PsPixelFormatRGB565,
+        .swapByte = true, // imlib RGB565 is big endian
+        .bufferAddr = (uint32_t) src->data,
+        .pitchBytes = src_pitch,
+    };
+    pxp_output_buffer_config_t out_config = {
+        .pixelFormat = kPXP_OutputPixelFormatYUV2P420,
+        .interlacedMode = kPXP_OutputProgressive,
+        .buffer0Addr = (uint32_t) planes,
+        .buffer1Addr = (uint32_t) (planes + size),
+        .pitchBytes = src->w,
+        .width = src->w,
+        .height = src->h,
+    };
+
+    PXP_SetProcessSurfaceBackGroundColor(PXP, 0);
+    PXP_SetProcessSurfaceBufferConfig(PXP, &ps_config);
+    PXP_SetProcessSurfaceScaler(PXP, src->w, src->h, src->w, src->h);
+    PXP_SetProcessSurfacePosition(PXP, 0, 0, src->w - 1, src->h - 1);
+    PXP_SetAlphaSurfacePosition(PXP, 0xFFFF, 0xFFFF, 0, 0); // no alpha surface
+    PXP_EnableCsc1(PXP, false);
+    PXP_SetCsc2Config(PXP, &pxp_2d_rgb_to_ycbcr);
+    PXP_EnableCsc2(PXP, true);
+    PXP_SetRotateConfig(PXP, kPXP_RotateOutputBuffer, kPXP_Rotate0, kPXP_FlipDisable);
+    PXP_SetOutputBufferConfig(PXP, &out_config);
+
+    // Both planes are one block of w byte rows.
+    pxp_2d_dst = planes;
+    pxp_2d_dst_pitch = src->w;
+    pxp_2d_dst_line_bytes = src->w;
+    pxp_2d_dst_h = src->h + (src->h / 2);
+    pxp_2d_dst_swap = false;
+
+    PXP_ClearStatusFlags(PXP, kPXP_CompleteFlag);
+    pxp_2d_busy = true;
+    PXP_Start(PXP);
+    pxp_2d_wait();
+    return 0;
+}
+
+// Below this many bytes the CPU is done before PXP is set up.
+#define PXP_2D_MIN_COPY_BYTES (4096)
+
+// Output rows of the copy or fill started by the caller, no swap.
+static void pxp_2d_run(uint8_t *dst, uint32_t dst_pitch, uint32_t line_bytes, int h)
+{
+    pxp_2d_dst = dst;
+    pxp_2d_dst_pitch = dst_pitch;
+    pxp_2d_dst_line_bytes = line_bytes;
+    pxp_2d_dst_h = h;
+    pxp_2d_dst_swap = false;
+
+    PXP_ClearStatusFlags(PXP, kPXP_CompleteFlag);
+    pxp_2d_busy = true;
+    PXP_Start(PXP);
+    pxp_2d_wait();
+}
+
+static void pxp_2d_setup(uint8_t *dst, uint32_t dst_pitch, int w, int h, pxp_output_pixel_format_t format)
+{
+    pxp_2d_wait();
+    if (!pxp_2d_inited) {
+        PXP_Init(PXP);
+        pxp_2d_inited = true;
+    }
+
+    pxp_output_buffer_config_t out_config = {
+        .pixelFormat = format,
+        .interlacedMode = kPXP_OutputProgressive,
+        .buffer0Addr = (uint32_t) dst,
+        .pitchBytes = dst_pitch,
+        .width = w,
+        .height = h,
+    };
+
+    PXP_SetAlphaSurfacePosition(PXP, 0xFFFF, 0xFFFF, 0, 0); // no alpha surface
+    PXP_EnableCsc1(PXP, false);
+    PXP_EnableCsc2(PXP, false);
+    PXP_SetRotateConfig(PXP, kPXP_RotateOutputBuffer, kPXP_Rotate0, kPXP_FlipDisable);
+    PXP_SetOutputBufferConfig(PXP, &out_config);
+}
+
+int pxp_2d_copy(uint8_t *dst, uint32_t dst_pitch, const uint8_t *src, uint32_t src_pitch, int w, int h, int bytes_pp)
+{
+    uint32_t line_bytes = w * bytes_pp;
+    if ((w <= 0) || (h <= 0) || ((line_bytes * h) < PXP_2D_MIN_COPY_BYTES)
+            || (dst_pitch > 0xFFFF) || (src_pitch > 0xFFFF)
+            || (((uint32_t) dst | (uint32_t) src | dst_pitch | src_pitch) & (bytes_pp - 1))) {
+        return -1;
+    }
+
+    uint32_t src_bytes = ((h - 1) * src_pitch) + line_bytes;
+    uint32_t dst_bytes = ((h - 1) * dst_pitch) + line_bytes;
+    if ((dst < (src + src_bytes)) && (src < (dst + dst_bytes))) {
+        return -1; // PXP does not order its reads before its writes
+    }
+
+    pxp_2d_setup(dst, dst_pitch, w, h, (bytes_pp == 1) ? kPXP_OutputPixelFormatY8 : kPXP_OutputPixelFormatRGB565);
+
+    // The destination rows share lines with the pixels outside them, they are cleaned.
+    dma_begin_write((void *) src, src_bytes);
+    dma_begin_write(dst, dst_bytes);
+
+    pxp_ps_buffer_config_t ps_config = {
+        .pixelFormat = (bytes_pp == 1) ? kPXP_PsPixelFormatY8 : kPXP_PsPixelFormatRGB565,
+        .swapByte = false,
+        .bufferAddr = (uint32_t) src,
+        .pitchBytes = src_pitch,
+    };
+
+    PXP_SetProcessSurfaceBackGroundColor(PXP, 0);
+    PXP_SetProcessSurfaceBufferConfig(PXP, &ps_config);
+    PXP_SetProcessSurfaceScaler(PXP, w, h, w, h);
+    PXP_SetProcessSurfacePosition(PXP, 0, 0, w - 1, h - 1);
+
+    pxp_2d_run(dst, dst_pitch, line_bytes, h);
+    return 0;
+}
+
+int pxp_2d_fill(uint8_t *dst, uint32_t dst_pitch, int w, int h, uint16_t col)
+{
+    uint32_t line_bytes = w * sizeof(uint16_t);
+    if ((w <= 0) || (h <= 0) || ((line_bytes * h) < PXP_2D_MIN_COPY_BYTES)
+            || (dst_pitch > 0xFFFF) || (((uint32_t) dst | dst_pitch) & 1)) {
+        return -1;
+    }
+
+    pxp_2d_setup(dst, dst_pitch, w, h, kPXP_OutputPixelFormatRGB565);
+    dma_begin_write(dst, ((h - 1) * dst_pitch) + line_bytes);
+
+    // Without a process surface every output pixel is the background color, RGB888 that
+    // the output truncates back to col.
+    uint32_t r = (col >> 11) << 3, g = ((col >> 5) & 0x3F) << 2, b = (col & 0x1F) << 3;
+    PXP_SetProcessSurfaceBackGroundColor(PXP, (r << 16) | (g << 8) | b);
+    PXP_SetProcessSurfacePosition(PXP, 0xFFFF, 0xFFFF, 0, 0);
+
+    pxp_2d_run(dst, dst_pitch, line_bytes, h);
+    return 0;
+}
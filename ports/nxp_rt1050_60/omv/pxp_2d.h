@@ -0,0 +1,43 @@
+/*
+ * PXP 2D engine backend for imlib.
+ *
+ * Scales, flips and converts between RGB565 and grayscale with the i.MX RT PXP,
+ * so the CPU is free while a frame is being resized or converted.
+ *
+ */
+#ifndef __PXP_2D_H__
+#define __PXP_2D_H__
+#include <stdint.h>
+#include "imlib.h"
+
+// Destination formats that are not imlib formats, only valid for pxp_2d_start().
+#define PXP_2D_BPP_XRGB8888     (-1)    // 32-bit pixels, 0x00RRGGBB
+#define PXP_2D_BPP_RGB565_LE    (-2)    // RGB565 in CPU byte order, as LCDIF wants it
+
+#define PXP_2D_FLIP_H   (1)
+#define PXP_2D_FLIP_V   (2)
+
+// Start converting src_roi of src into dst_roi of dst, scaling it to fit.
+// A NULL roi means the whole image. Returns 0 once PXP is started, or -1 when
+// the formats, scale or rectangles are not supported and the CPU must do it.
+int pxp_2d_start(image_t *src, rectangle_t *src_roi, image_t *dst, rectangle_t *dst_roi, int flip);
+
+// Wait for the last started job and make its output visible to the CPU.
+void pxp_2d_wait();
+
+// pxp_2d_start() followed by pxp_2d_wait().
+int pxp_2d_blit(image_t *src, rectangle_t *src_roi, image_t *dst, rectangle_t *dst_roi, int flip);
+
+// Convert an RGB565 image to JPEG YCbCr 4:2:0, a w*h Y plane followed by a (w/2)*(h/2) plane
+// of interleaved Cb/Cr pairs. Returns 0 once the planes are ready, or -1 when the image is
+// not supported and the CPU must do it.
+int pxp_2d_ycbcr420(image_t *src, uint8_t *planes);
+
+// Copy h rows of w pixels of 1 or 2 bytes from src to dst as they are, pitches in bytes.
+// Returns 0 once copied, or -1 when the job is too small for PXP to pay off, the rows
+// overlap or the layout is not supported and the CPU must do it.
+int pxp_2d_copy(uint8_t *dst, uint32_t dst_pitch, const uint8_t *src, uint32_t src_pitch, int w, int h, int bytes_pp);
+
+// Fill h rows of w 16 bit pixels with col, which is stored as it is. Returns like pxp_2d_copy().
+int pxp_2d_fill(uint8_t *dst, uint32_t dst_pitch, int w, int h, uint16_t col);
+#endif /* __PXP_2D_H__ */
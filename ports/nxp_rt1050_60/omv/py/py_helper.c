@@ -4,6 +4,7 @@
  */
 #include "py_helper.h"
 #include "py_assert.h"
+#include "xalloc.h"
 #ifdef __CC_ARM
 __WEAK bool rectangle_overlap(rectangle_t *ptr0, rectangle_t *ptr1)
 {
@@ -44,6 +45,7 @@ image_t *py_helper_arg_to_image_mutable(const mp_obj_t arg)
 {
     image_t *arg_img = py_image_cobj(arg);
     PY_ASSERT_TRUE_MSG(IMAGE_IS_MUTABLE(arg_img), "Image is not mutable!");
+    imlib_pyramid_invalidate(arg_img->data); // The caller may modify it.
     return arg_img;
 }
 
@@ -54,6 +56,26 @@ image_t *py_helper_arg_to_image_mutable_bayer(const mp_obj_t arg)
     return arg_img;
 }
 
+image_t *py_helper_image_unpack(image_t *img, rectangle_t *roi, int bpp)
+{
+    if ((img->bpp != IMAGE_BPP_BAYER) && (img->bpp != IMAGE_BPP_YUV422)) {
+        return img;
+    }
+
+    image_t *out = imlib_pyramid_unpack(img, roi, bpp);
+
+    if (!out) {
+        out = xalloc(sizeof(image_t));
+        out->w = img->w;
+        out->h = img->h;
+        out->bpp = bpp;
+        out->data = xalloc(img->w * img->h * bpp);
+        imlib_unpack(out, img, roi);
+    }
+
+    return out;
+}
+
 image_t *py_helper_arg_to_image_grayscale(const mp_obj_t arg)
 {
     image_t *arg_img = py_image_cobj(arg);
@@ -223,6 +245,7 @@ int py_helper_keyword_color(image_t *img, uint n_args, const mp_obj_t *args, uin
                     default_val = COLOR_RGB565_TO_BINARY(default_val);
                     break;
                 }
+                case IMAGE_BPP_YUV422:
                 case IMAGE_BPP_GRAYSCALE: {
                     default_val = COLOR_RGB565_TO_GRAYSCALE(default_val);
                     break;
@@ -246,6 +269,7 @@ int py_helper_keyword_color(image_t *img, uint n_args, const mp_obj_t *args, uin
                     default_val = COLOR_RGB565_TO_BINARY(default_val);
                     break;
                 }
+                case IMAGE_BPP_YUV422:
                 case IMAGE_BPP_GRAYSCALE: {
                     default_val = COLOR_RGB565_TO_GRAYSCALE(default_val);
                     break;
@@ -9,6 +9,9 @@
 extern const mp_obj_fun_builtin_var_t py_func_unavailable_obj;
 image_t *py_helper_arg_to_image_mutable(const mp_obj_t arg);
 image_t *py_helper_arg_to_image_mutable_bayer(const mp_obj_t arg);
+// A Bayer or YUV422 image converted to bpp (grayscale or RGB565) inside roi, other images as
+// they are.
+image_t *py_helper_image_unpack(image_t *img, rectangle_t *roi, int bpp);
 image_t *py_helper_arg_to_image_grayscale(const mp_obj_t arg);
 image_t *py_helper_arg_to_image_color(const mp_obj_t arg);
 image_t *py_helper_keyword_to_image_mutable(uint n_args, const mp_obj_t *args, uint arg_index,
@@ -36,4 +39,28 @@ void py_helper_keyword_thresholds(uint n_args, const mp_obj_t *args, uint arg_in
 int py_helper_arg_to_ksize(const mp_obj_t arg);
 int py_helper_ksize_to_n(int ksize);
 mp_obj_t py_helper_keyword_object(uint n_args, const mp_obj_t *args, uint arg_index, mp_map_t *kw_args, mp_obj_t kw);
+
+// Long C calls between these run without the GIL, other Python threads carry on meanwhile.
+// One thread at a time is inside (they share fb_alloc), the code must not call back into
+// Python nor return from the middle. An exception raised inside, fb_alloc or xalloc running
+// out, gets the GIL back before it propagates.
+#if MICROPY_PY_THREAD
+#include "py/nlr.h"
+#define PY_NATIVE_BEGIN() \
+    do { \
+        nlr_buf_t native_nlr; \
+        mp_thread_native_enter(); \
+        if (nlr_push(&native_nlr) == 0) {
+#define PY_NATIVE_END() \
+            nlr_pop(); \
+            mp_thread_native_exit(); \
+        } else { \
+            mp_thread_native_exit(); \
+            nlr_jump(native_nlr.ret_val); \
+        } \
+    } while (0)
+#else
+#define PY_NATIVE_BEGIN() do {
+#define PY_NATIVE_END() } while (0)
+#endif
 #endif // __PY_HELPER__
@@ -20,8 +20,13 @@
 #include "py_helper.h"
 #include "py_image.h"
 #include "omv_boardconfig.h"
+#ifdef IMLIB_ENABLE_PXP
+#include "pxp_2d.h"
+#endif
 #include "py/runtime0.h"
 #include "py/runtime.h"
+#include "py/objarray.h"
+#include "py/builtin.h"
 #undef M_PI
 #define M_PI    3.141592654f
 #ifndef M_PI_2
@@ -118,6 +123,48 @@ py_kp_obj_t *py_kpts_obj(mp_obj_t kpts_obj)
     return kpts_obj;
 }
 
+// Keypoints database object, the objects index to their ids.
+typedef struct _py_kp_db_obj_t {
+    mp_obj_base_t base;
+    orb_db_t db;
+} py_kp_db_obj_t;
+
+static void py_kp_db_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
+{
+    py_kp_db_obj_t *self = self_in;
+    mp_printf(print, "{\"objects\":%d, \"size\":%d}", self->db.count, array_length(self->db.kpts));
+}
+
+mp_obj_t py_kp_db_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
+    py_kp_db_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    switch (op) {
+        case MP_UNARY_OP_LEN:
+            return MP_OBJ_NEW_SMALL_INT(self->db.count);
+
+        default:
+            return MP_OBJ_NULL; // op not supported
+    }
+}
+
+static mp_obj_t py_kp_db_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value)
+{
+    if (value == MP_OBJ_SENTINEL) { // load
+        py_kp_db_obj_t *self = self_in;
+        int i = mp_get_index(self->base.type, self->db.count, index, false);
+        return mp_obj_new_int_from_uint(self->db.ids[i]);
+    }
+
+    return MP_OBJ_NULL; // op not supported
+}
+
+static const mp_obj_type_t py_kp_db_type = {
+    { &mp_type_type },
+    .name  = MP_QSTR_kp_db,
+    .print = py_kp_db_print,
+    .subscr = py_kp_db_subscr,
+    .unary_op = py_kp_db_unary_op,
+};
+
 #endif // IMLIB_ENABLE_FIND_KEYPOINTS
 
 // LBP descriptor /////////////////////////////////////////////////////////////
@@ -262,6 +309,28 @@ void *py_image_cobj(mp_obj_t img_obj)
     PY_ASSERT_TYPE(img_obj, &py_image_type);
     return &((py_image_obj_t *)img_obj)->_cobj;
 }
+
+// MICROPY_PY_FRAMEBUF_VIEW, the framebuf formats of the pixels of an image.
+int py_image_framebuf_view(mp_obj_t obj, void **buf, int *w, int *h)
+{
+    if (!MP_OBJ_IS_TYPE(obj, &py_image_type)) {
+        return -1;
+    }
+    image_t *img = &((py_image_obj_t *) obj)->_cobj;
+    *buf = img->data;
+    *w = img->w;
+    *h = img->h;
+    switch (img->bpp) {
+        case IMAGE_BPP_BINARY:
+            return 0;
+        case IMAGE_BPP_GRAYSCALE:
+            return 1;
+        case IMAGE_BPP_RGB565:
+            return 2;
+        default:
+            return -1;
+    }
+}
 mp_obj_t py_image_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
     py_image_obj_t *self = MP_OBJ_TO_PTR(self_in);
     switch (op) {
@@ -320,6 +389,18 @@ STATIC mp_obj_t py_image_it_iternext(mp_obj_t self_in)
                 return row;
             }
         }
+        case IMAGE_BPP_YUV422: {
+            if (self->cur >= img->h) {
+                return MP_OBJ_STOP_ITERATION;
+            } else {
+                mp_obj_t row = mp_obj_new_list(0, NULL);
+                for (int i=0; i<img->w; i++) {
+                    mp_obj_list_append(row, mp_obj_new_int(IMAGE_GET_YUV422_Y(img, i, self->cur)));
+                }
+                self->cur++;
+                return row;
+            }
+        }
         default: {// JPEG
             if (self->cur >= img->bpp) {
                 return MP_OBJ_STOP_ITERATION;
@@ -368,6 +449,12 @@ static void py_image_print(const mp_print_t *print, mp_obj_t self_in, mp_print_k
                       (self->_cobj.w * self->_cobj.h) * sizeof(uint8_t));
             break;
         }
+        case IMAGE_BPP_YUV422: {
+            mp_printf(print, "{\"w\":%d, \"h\":%d, \"type\"=\"yuv422\", \"size\":%d}",
+                      self->_cobj.w, self->_cobj.h,
+                      (self->_cobj.w * self->_cobj.h) * sizeof(uint16_t));
+            break;
+        }
         default: {
             if((self->_cobj.data[0] == 0xFE) && (self->_cobj.data[self->_cobj.bpp-1] == 0xFE)) { // for ide
                 print->print_strn(print->data, (const char *) self->_cobj.data, self->_cobj.bpp);
@@ -420,6 +507,23 @@ static mp_obj_t py_image_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value
                 uint8_t p = IMAGE_GET_GRAYSCALE_PIXEL(&(self->_cobj), i % self->_cobj.w, i / self->_cobj.w);
                 return mp_obj_new_int(p);
             }
+            case IMAGE_BPP_YUV422: {
+                if (MP_OBJ_IS_TYPE(index, &mp_type_slice)) {
+                    mp_bound_slice_t slice;
+                    if (!mp_seq_get_fast_slice_indexes(self->_cobj.w * self->_cobj.h, index, &slice)) {
+                        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "only slices with step=1 (aka None) are supported"));
+                    }
+                    mp_obj_tuple_t *result = mp_obj_new_tuple(slice.stop - slice.start, NULL);
+                    for (mp_uint_t i = 0; i < result->len; i++) {
+                        uint8_t p = IMAGE_GET_YUV422_Y(&(self->_cobj), (slice.start + i) % self->_cobj.w, (slice.start + i) / self->_cobj.w);
+                        result->items[i] = mp_obj_new_int(p);
+                    }
+                    return result;
+                }
+                mp_uint_t i = mp_get_index(self->base.type, self->_cobj.w * self->_cobj.h, index, false);
+                uint8_t p = IMAGE_GET_YUV422_Y(&(self->_cobj), i % self->_cobj.w, i / self->_cobj.w);
+                return mp_obj_new_int(p);
+            }
             case IMAGE_BPP_RGB565: {
                 if (MP_OBJ_IS_TYPE(index, &mp_type_slice)) {
                     mp_bound_slice_t slice;
@@ -514,6 +618,34 @@ static mp_obj_t py_image_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value
                 IMAGE_PUT_GRAYSCALE_PIXEL(&(self->_cobj), i % self->_cobj.w, i / self->_cobj.w, p);
                 return mp_const_none;
             }
+            case IMAGE_BPP_YUV422: {
+                if (MP_OBJ_IS_TYPE(index, &mp_type_slice)) {
+                    mp_bound_slice_t slice;
+                    if (!mp_seq_get_fast_slice_indexes(self->_cobj.w * self->_cobj.h, index, &slice)) {
+                        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "only slices with step=1 (aka None) are supported"));
+                    }
+                    if (MP_OBJ_IS_TYPE(value, &mp_type_list)) {
+                        mp_uint_t value_l_len;
+                        mp_obj_t *value_l;
+                        mp_obj_get_array(value, &value_l_len, &value_l);
+                        PY_ASSERT_TRUE_MSG(value_l_len == (slice.stop - slice.start), "cannot grow or shrink image");
+                        for (mp_uint_t i = 0; i < (slice.stop - slice.start); i++) {
+                            uint8_t p = mp_obj_get_int(value_l[i]);
+                            IMAGE_PUT_YUV422_Y(&(self->_cobj), (slice.start + i) % self->_cobj.w, (slice.start + i) / self->_cobj.w, p);
+                        }
+                    } else {
+                        uint8_t p = mp_obj_get_int(value);
+                        for (mp_uint_t i = 0; i < (slice.stop - slice.start); i++) {
+                            IMAGE_PUT_YUV422_Y(&(self->_cobj), (slice.start + i) % self->_cobj.w, (slice.start + i) / self->_cobj.w, p);
+                        }
+                    }
+                    return mp_const_none;
+                }
+                mp_uint_t i = mp_get_index(self->base.type, self->_cobj.w * self->_cobj.h, index, false);
+                uint8_t p = mp_obj_get_int(value);
+                IMAGE_PUT_YUV422_Y(&(self->_cobj), i % self->_cobj.w, i / self->_cobj.w, p);
+                return mp_const_none;
+            }
             case IMAGE_BPP_RGB565: {
                 if (MP_OBJ_IS_TYPE(index, &mp_type_slice)) {
                     mp_bound_slice_t slice;
@@ -618,6 +750,7 @@ static mp_obj_t py_image_format(mp_obj_t img_obj)
         case IMAGE_BPP_GRAYSCALE: return mp_obj_new_int(PIXFORMAT_GRAYSCALE);
         case IMAGE_BPP_RGB565: return mp_obj_new_int(PIXFORMAT_RGB565);
         case IMAGE_BPP_BAYER: return mp_obj_new_int(PIXFORMAT_BAYER);
+        case IMAGE_BPP_YUV422: return mp_obj_new_int(PIXFORMAT_YUV422);
         default: return mp_obj_new_int(PIXFORMAT_JPEG);
     }
 }
@@ -693,6 +826,19 @@ STATIC mp_obj_t py_image_get_pixel(uint n_args, const mp_obj_t *args, mp_map_t *
             } else {
                 return mp_obj_new_int(IMAGE_GET_GRAYSCALE_PIXEL(arg_img, arg_x, arg_y)); // Correct!
             }
+        case IMAGE_BPP_YUV422:
+            if (arg_rgbtuple) {
+                int pixel = imlib_yuv_to_rgb(IMAGE_GET_YUV422_Y(arg_img, arg_x, arg_y),
+                                             IMAGE_GET_YUV422_U(arg_img, arg_x, arg_y),
+                                             IMAGE_GET_YUV422_V(arg_img, arg_x, arg_y));
+                mp_obj_t pixel_tuple[3];
+                pixel_tuple[0] = mp_obj_new_int(COLOR_RGB565_TO_R8(pixel));
+                pixel_tuple[1] = mp_obj_new_int(COLOR_RGB565_TO_G8(pixel));
+                pixel_tuple[2] = mp_obj_new_int(COLOR_RGB565_TO_B8(pixel));
+                return mp_obj_new_tuple(3, pixel_tuple);
+            } else {
+                return mp_obj_new_int(IMAGE_GET_YUV422_Y(arg_img, arg_x, arg_y));
+            }
         default: return mp_const_none;
     }
 }
@@ -714,6 +860,8 @@ STATIC mp_obj_t py_image_set_pixel(uint n_args, const mp_obj_t *args, mp_map_t *
         return args[0];
     }
 
+    imlib_pyramid_invalidate(arg_img->data);
+
     switch (arg_img->bpp) {
         case IMAGE_BPP_BINARY: {
             IMAGE_PUT_BINARY_PIXEL(arg_img, arg_x, arg_y, arg_c);
@@ -731,6 +879,10 @@ STATIC mp_obj_t py_image_set_pixel(uint n_args, const mp_obj_t *args, mp_map_t *
             IMAGE_PUT_GRAYSCALE_PIXEL(arg_img, arg_x, arg_y, arg_c); // Correct!
             return args[0];
         }
+        case IMAGE_BPP_YUV422: {
+            IMAGE_PUT_YUV422_Y(arg_img, arg_x, arg_y, arg_c);
+            return args[0];
+        }
         default: return args[0];
     }
 }
@@ -997,6 +1149,12 @@ static mp_obj_t py_image_to_grayscale(uint n_args, const mp_obj_t *args, mp_map_
             break;
         }
         case IMAGE_BPP_RGB565: {
+            #ifdef IMLIB_ENABLE_PXP
+            // PXP works in blocks, it can only convert into another buffer.
+            if ((channel < 0) && (out.data != arg_img->data) && (pxp_2d_blit(arg_img, NULL, &out, NULL, 0) == 0)) {
+                break;
+            }
+            #endif
             for (int y = 0, yy = out.h; y < yy; y++) {
                 uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(arg_img, y);
                 uint8_t *out_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&out, y);
@@ -1334,16 +1492,30 @@ static mp_obj_t py_image_compress(uint n_args, const mp_obj_t *args, mp_map_t *k
     image_t *arg_img = py_helper_arg_to_image_mutable_bayer(args[0]);
     int arg_q = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_quality), 50);
     PY_ASSERT_TRUE_MSG((1 <= arg_q) && (arg_q <= 100), "Error: 1 <= quality <= 100!");
+    int arg_max_bytes = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_bytes), 0);
+    PY_ASSERT_TRUE_MSG((!arg_max_bytes) || (arg_max_bytes >= JPEG_BUDGET_MIN), "Error: max_bytes >= 1024!");
 
     uint32_t size;
+    PY_NATIVE_BEGIN();
     fb_alloc_mark();
-    uint8_t *buffer = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE);
+    uint8_t *buffer;
+    if (arg_max_bytes) {
+        size = arg_max_bytes;
+        buffer = fb_alloc(size, FB_ALLOC_PREFER_SIZE);
+    } else {
+        buffer = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE);
+    }
     image_t out = { .w=arg_img->w, .h=arg_img->h, .bpp=size, .data=buffer };
-    PY_ASSERT_FALSE_MSG(jpeg_compress(arg_img, &out, arg_q, false), "Out of Memory!");
+    if (arg_max_bytes) {
+        PY_ASSERT_FALSE_MSG(jpeg_compress_budget(arg_img, &out, arg_q), "max_bytes too small!");
+    } else {
+        PY_ASSERT_FALSE_MSG(jpeg_compress(arg_img, &out, arg_q, false), "Out of Memory!");
+    }
     PY_ASSERT_TRUE_MSG(out.bpp <= image_size(arg_img), "Can't compress in place!");
     memcpy(arg_img->data, out.data, out.bpp);
     arg_img->bpp = out.bpp;
     fb_alloc_free_till_mark();
+    PY_NATIVE_END();
 
     if (MAIN_FB()->pixels == arg_img->data) {
         MAIN_FB()->bpp = arg_img->bpp;
@@ -1360,6 +1532,7 @@ static mp_obj_t py_image_compress_for_ide(uint n_args, const mp_obj_t *args, mp_
     PY_ASSERT_TRUE_MSG((1 <= arg_q) && (arg_q <= 100), "Error: 1 <= quality <= 100!");
 
     uint32_t size;
+    PY_NATIVE_BEGIN();
     fb_alloc_mark();
     uint8_t *buffer = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE);
     image_t out = { .w=arg_img->w, .h=arg_img->h, .bpp=size, .data=buffer };
@@ -1372,6 +1545,7 @@ static mp_obj_t py_image_compress_for_ide(uint n_args, const mp_obj_t *args, mp_
 
     arg_img->bpp = out.bpp;
     fb_alloc_free_till_mark();
+    PY_NATIVE_END();
 
     if (MAIN_FB()->pixels == arg_img->data) {
         MAIN_FB()->bpp = arg_img->bpp;
@@ -1386,16 +1560,31 @@ static mp_obj_t py_image_compressed(uint n_args, const mp_obj_t *args, mp_map_t
     image_t *arg_img = py_helper_arg_to_image_mutable_bayer(args[0]);
     int arg_q = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_quality), 50);
     PY_ASSERT_TRUE_MSG((1 <= arg_q) && (arg_q <= 100), "Error: 1 <= quality <= 100!");
+    int arg_max_bytes = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_bytes), 0);
+    PY_ASSERT_TRUE_MSG((!arg_max_bytes) || (arg_max_bytes >= JPEG_BUDGET_MIN), "Error: max_bytes >= 1024!");
 
     uint32_t size;
+    image_t out;
+    PY_NATIVE_BEGIN();
     fb_alloc_mark();
-    uint8_t *buffer = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE);
-    image_t out = { .w=arg_img->w, .h=arg_img->h, .bpp=size, .data=buffer };
-    PY_ASSERT_FALSE_MSG(jpeg_compress(arg_img, &out, arg_q, false), "Out of Memory!");
+    uint8_t *buffer;
+    if (arg_max_bytes) {
+        size = arg_max_bytes;
+        buffer = fb_alloc(size, FB_ALLOC_PREFER_SIZE);
+    } else {
+        buffer = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE);
+    }
+    out = (image_t) { .w=arg_img->w, .h=arg_img->h, .bpp=size, .data=buffer };
+    if (arg_max_bytes) {
+        PY_ASSERT_FALSE_MSG(jpeg_compress_budget(arg_img, &out, arg_q), "max_bytes too small!");
+    } else {
+        PY_ASSERT_FALSE_MSG(jpeg_compress(arg_img, &out, arg_q, false), "Out of Memory!");
+    }
     uint8_t *temp = xalloc(out.bpp);
     memcpy(temp, out.data, out.bpp);
     out.data = temp;
     fb_alloc_free_till_mark();
+    PY_NATIVE_END();
 
     return py_image_from_struct(&out);
 }
@@ -1408,9 +1597,11 @@ static mp_obj_t py_image_compressed_for_ide(uint n_args, const mp_obj_t *args, m
     PY_ASSERT_TRUE_MSG((1 <= arg_q) && (arg_q <= 100), "Error: 1 <= quality <= 100!");
 
     uint32_t size;
+    image_t out;
+    PY_NATIVE_BEGIN();
     fb_alloc_mark();
     uint8_t *buffer = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE);
-    image_t out = { .w=arg_img->w, .h=arg_img->h, .bpp=size, .data=buffer };
+    out = (image_t) { .w=arg_img->w, .h=arg_img->h, .bpp=size, .data=buffer };
     PY_ASSERT_FALSE_MSG(jpeg_compress(arg_img, &out, arg_q, false), "Out of Memory!");
     int new_size = encode_for_ide_new_size(&out);
     uint8_t *temp = xalloc(new_size);
@@ -1420,6 +1611,7 @@ static mp_obj_t py_image_compressed_for_ide(uint n_args, const mp_obj_t *args, m
 
     out.data = temp;
     fb_alloc_free_till_mark();
+    PY_NATIVE_END();
 
     return py_image_from_struct(&out);
 }
@@ -1488,6 +1680,7 @@ static mp_obj_t py_image_copy_int(uint n_args, const mp_obj_t *args, mp_map_t *k
 
     if (copy_to_fb) {
         fb_update_jpeg_buffer();
+        imlib_pyramid_invalidate(MAIN_FB()->pixels);
     }
 
     image_t image;
@@ -1634,6 +1827,53 @@ static mp_obj_t py_image_save(uint n_args, const mp_obj_t *args, mp_map_t *kw_ar
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_save_obj, 2, py_image_save);
 
+task_t *py_image_submit(mp_obj_t meth, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    task_op_t op;
+    int arg_q;
+    mp_obj_t stream = MP_OBJ_NULL;
+    if ((meth == MP_OBJ_FROM_PTR(&py_image_compress_obj)) || (meth == MP_OBJ_FROM_PTR(&py_image_compressed_obj))) {
+        // Both give a new image, the one submitted may change before the task runs.
+        op = TASK_COMPRESS;
+        arg_q = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_quality), 50);
+    } else if (meth == MP_OBJ_FROM_PTR(&py_image_save_obj)) {
+        PY_ASSERT_TRUE_MSG((n_args == 2) || (n_args == 4), "Expected save(path[, roi, quality])");
+        const char *path = mp_obj_str_get_str(args[1]);
+        const char *ext = strrchr(path, '.');
+        PY_ASSERT_TRUE_MSG(ext && ((!strcasecmp(ext, ".jpg")) || (!strcasecmp(ext, ".jpeg"))),
+                "Only JPEG files can be saved in the background!");
+        op = TASK_SAVE;
+        arg_q = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_quality), 50);
+    } else {
+        return NULL;
+    }
+    PY_ASSERT_TRUE_MSG((1 <= arg_q) && (arg_q <= 100), "Error: 1 <= quality <= 100!");
+
+    image_t *arg_img = (op == TASK_SAVE) ? py_image_cobj(args[0]) : py_helper_arg_to_image_mutable_bayer(args[0]);
+    if (op == TASK_SAVE) {
+        mp_obj_t open_args[2] = { args[1], MP_OBJ_NEW_QSTR(MP_QSTR_wb) };
+        stream = mp_call_function_n_kw(MP_OBJ_FROM_PTR(&mp_builtin_open_obj), 2, 0, open_args);
+    }
+    task_t *task = task_new(op);
+    task->quality = arg_q;
+    task->stream = stream;
+    task->img = *arg_img;
+    task->img.pixels = xalloc(image_size(arg_img));
+    memcpy(task->img.pixels, arg_img->pixels, image_size(arg_img));
+
+    if (IM_IS_JPEG(arg_img)) {
+        // Nothing to encode, the copy goes to the file as it is.
+        task->data = task->img.pixels;
+        task->len = task->img.bpp;
+    } else {
+        task->out = (image_t) { .w=arg_img->w, .h=arg_img->h, .bpp=image_size(arg_img) + JPEG_BUDGET_MIN };
+        task->out.pixels = xalloc(task->out.bpp);
+    }
+
+    task_submit(task);
+    return task;
+}
+
 //////////////////
 // Drawing Methods
 //////////////////
@@ -1645,7 +1885,20 @@ STATIC mp_obj_t py_image_clear(uint n_args, const mp_obj_t *args, mp_map_t *kw_a
     image_t *arg_msk =
             py_helper_keyword_to_image_mutable_mask(n_args, args, 1, kw_args);
 
-    if (!arg_msk) {
+    imlib_pyramid_invalidate(arg_img->data);
+
+    if (IM_IS_YUV422(arg_img)) {
+        // Black is Y 0 with U and V at their zero, 128.
+        for (int y = 0; y < arg_img->h; y++) {
+            for (int x = 0; x < arg_img->w; x++) {
+                if ((!arg_msk) || image_get_mask_pixel(arg_msk, x, y)) {
+                    uint8_t *p = IMAGE_COMPUTE_YUV422_PIXEL_ROW_PTR(arg_img, y) + (x * 2);
+                    p[0] = 0;
+                    p[1] = 0x80;
+                }
+            }
+        }
+    } else if (!arg_msk) {
     memset(arg_img->data, 0, image_size(arg_img));
     } else {
         imlib_zero(arg_img, arg_msk, false);
@@ -1917,8 +2170,10 @@ STATIC mp_obj_t py_image_draw_image(uint n_args, const mp_obj_t *args, mp_map_t
     PY_ASSERT_TRUE_MSG((0 <= arg_alpha) && (arg_alpha <= 1), "Error: 0 <= alpha <= 256!");
     image_t *arg_msk =
         py_helper_keyword_to_image_mutable_mask(n_args, args, offset + 3, kw_args);
+    int arg_hint =
+        py_helper_keyword_int(n_args, args, offset + 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_hint), 0);
 
-    imlib_draw_image(arg_img, arg_other, arg_cx, arg_cy, arg_x_scale, arg_y_scale, arg_alpha, arg_msk);
+    imlib_draw_image(arg_img, arg_other, arg_cx, arg_cy, arg_x_scale, arg_y_scale, arg_alpha, arg_msk, arg_hint);
     return args[0];
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_draw_image_obj, 3, py_image_draw_image);
@@ -3074,6 +3329,138 @@ STATIC mp_obj_t py_image_cartoon(uint n_args, const mp_obj_t *args, mp_map_t *kw
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_cartoon_obj, 1, py_image_cartoon);
 #endif // IMLIB_ENABLE_CARTOON
+
+#ifdef IMLIB_ENABLE_PIPELINE
+// img.pipeline([("gamma_corr", gamma, contrast, brightness), ("gaussian", size, unsharp, mul, add),
+//               ("morph", size, kernel, mul, add), ("negate",), ("binary", thresholds, invert, zero)])
+STATIC mp_obj_t py_image_pipeline(mp_obj_t img_obj, mp_obj_t ops_obj)
+{
+    image_t *arg_img =
+        py_helper_arg_to_image_mutable(img_obj);
+
+    size_t ops_len;
+    mp_obj_t *ops;
+    mp_obj_get_array(ops_obj, &ops_len, &ops);
+    PY_ASSERT_TRUE_MSG(ops_len <= IMLIB_PIPELINE_OPS_MAX, "Too many pipeline ops!");
+
+    pipeline_op_t arg_ops[IMLIB_PIPELINE_OPS_MAX];
+    list_t arg_thresholds[IMLIB_PIPELINE_OPS_MAX];
+    size_t arg_thresholds_len = 0;
+
+    fb_alloc_mark();
+
+    for (size_t i = 0; i < ops_len; i++) {
+        size_t len;
+        mp_obj_t *items;
+        mp_obj_get_array(ops[i], &len, &items);
+        PY_ASSERT_TRUE_MSG(len, "Pipeline ops are (name, args...) tuples!");
+
+        pipeline_op_t *op = &arg_ops[i];
+        memset(op, 0, sizeof(pipeline_op_t));
+
+        switch (mp_obj_str_get_qstr(items[0])) {
+            case MP_QSTR_gamma_corr: {
+                op->type = PIPELINE_GAMMA_CORR;
+                op->gamma = (len > 1) ? mp_obj_get_float(items[1]) : 1.0f;
+                op->contrast = (len > 2) ? mp_obj_get_float(items[2]) : 1.0f;
+                op->brightness = (len > 3) ? mp_obj_get_float(items[3]) : 0.0f;
+                break;
+            }
+            case MP_QSTR_negate: {
+                op->type = PIPELINE_NEGATE;
+                break;
+            }
+            case MP_QSTR_binary: {
+                PY_ASSERT_TRUE_MSG(len > 1, "binary needs a thresholds list!");
+                op->type = PIPELINE_BINARY;
+                op->thresholds = &arg_thresholds[arg_thresholds_len++];
+                list_init(op->thresholds, sizeof(color_thresholds_list_lnk_data_t));
+                py_helper_arg_to_thresholds(items[1], op->thresholds);
+                op->invert = (len > 2) ? mp_obj_is_true(items[2]) : false;
+                op->zero = (len > 3) ? mp_obj_is_true(items[3]) : false;
+                break;
+            }
+            case MP_QSTR_gaussian: {
+                PY_ASSERT_TRUE_MSG(len > 1, "gaussian needs a kernel size!");
+                op->type = PIPELINE_MORPH;
+                op->ksize = py_helper_arg_to_ksize(items[1]);
+
+                int k_2 = op->ksize * 2;
+                int n = k_2 + 1;
+
+                int *pascal = fb_alloc(n * sizeof(int), FB_ALLOC_NO_HINT);
+                pascal[0] = 1;
+
+                for (int j = 0; j < k_2; j++) { // Compute a row of pascal's triangle.
+                    pascal[j + 1] = (pascal[j] * (k_2 - j)) / (j + 1);
+                }
+
+                int *krn = fb_alloc(n * n * sizeof(int), FB_ALLOC_NO_HINT);
+                int m = 0;
+
+                for (int j = 0; j < n; j++) {
+                    for (int k = 0; k < n; k++) {
+                        int temp = pascal[j] * pascal[k];
+                        krn[(j * n) + k] = temp;
+                        m += temp;
+                    }
+                }
+
+                if ((len > 2) && mp_obj_is_true(items[2])) {
+                    krn[((n/2)*n)+(n/2)] -= m * 2;
+                    m = -m;
+                }
+
+                op->krn = krn;
+                op->m = (len > 3) ? mp_obj_get_float(items[3]) : (1.0f / m);
+                op->b = (len > 4) ? mp_obj_get_float(items[4]) : 0.0f;
+                break;
+            }
+            case MP_QSTR_morph: {
+                PY_ASSERT_TRUE_MSG(len > 2, "morph needs a kernel size and a kernel!");
+                op->type = PIPELINE_MORPH;
+                op->ksize = py_helper_arg_to_ksize(items[1]);
+
+                int n = py_helper_ksize_to_n(op->ksize);
+
+                mp_obj_t *krn_obj;
+                mp_obj_get_array_fixed_n(items[2], n, &krn_obj);
+
+                int *krn = fb_alloc(n * sizeof(int), FB_ALLOC_NO_HINT);
+                int m = 0;
+
+                for (int j = 0; j < n; j++) {
+                    krn[j] = mp_obj_get_int(krn_obj[j]);
+                    m += krn[j];
+                }
+
+                if (m == 0) {
+                    m = 1;
+                }
+
+                op->krn = krn;
+                op->m = (len > 3) ? mp_obj_get_float(items[3]) : (1.0f / m);
+                op->b = (len > 4) ? mp_obj_get_float(items[4]) : 0.0f;
+                break;
+            }
+            default: {
+                nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Unknown pipeline op!"));
+                break;
+            }
+        }
+    }
+
+    imlib_pipeline(arg_img, arg_ops, ops_len);
+    fb_alloc_free_till_mark();
+
+    for (size_t i = 0; i < arg_thresholds_len; i++) {
+        list_free(&arg_thresholds[i]);
+    }
+
+    return img_obj;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(py_image_pipeline_obj, py_image_pipeline);
+#endif // IMLIB_ENABLE_PIPELINE
 /////////////////////////
 // Shadow Removal Methods
 /////////////////////////
@@ -3948,7 +4335,7 @@ static const mp_obj_type_t py_histogram_type = {
 
 static mp_obj_t py_image_get_histogram(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
 {
-    image_t *arg_img = py_helper_arg_to_image_mutable(args[0]);
+    image_t *arg_img = py_helper_arg_to_image_mutable_bayer(args[0]);
 
     list_t thresholds;
     list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
@@ -3957,6 +4344,7 @@ static mp_obj_t py_image_get_histogram(uint n_args, const mp_obj_t *args, mp_map
 
     rectangle_t roi;
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 3, kw_args, &roi);
+    arg_img = py_helper_image_unpack(arg_img, &roi, IMAGE_BPP_RGB565);
 
     histogram_t hist;
     switch(arg_img->bpp) {
@@ -4049,7 +4437,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_histogram_obj, 1, py_image_get_hi
 
 static mp_obj_t py_image_get_statistics(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
 {
-    image_t *arg_img = py_helper_arg_to_image_mutable(args[0]);
+    image_t *arg_img = py_helper_arg_to_image_mutable_bayer(args[0]);
 
     list_t thresholds;
     list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
@@ -4058,6 +4446,7 @@ static mp_obj_t py_image_get_statistics(uint n_args, const mp_obj_t *args, mp_ma
 
     rectangle_t roi;
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 3, kw_args, &roi);
+    arg_img = py_helper_image_unpack(arg_img, &roi, IMAGE_BPP_RGB565);
 
     histogram_t hist;
     switch(arg_img->bpp) {
@@ -4159,85 +4548,311 @@ static mp_obj_t py_image_get_statistics(uint n_args, const mp_obj_t *args, mp_ma
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_statistics_obj, 1, py_image_get_statistics);
 
-// Line Object //
-#define py_line_obj_size 8
-typedef struct py_line_obj {
-    mp_obj_base_t base;
-    mp_obj_t x1, y1, x2, y2, length, magnitude, theta, rho;
-} py_line_obj_t;
-
-static void py_line_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
+// Statistics of many ROIs from one pass over the image. Returns a bytearray with one 24 byte
+// record per ROI in statistics_t order: the L mean, median, mode, stdev, min, max, lq and uq
+// (unsigned) followed by the same 8 values for A and for B (signed).
+static mp_obj_t py_image_get_statistics_rois(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
 {
-    py_line_obj_t *self = self_in;
-    mp_printf(print,
-              "{\"x1\":%d, \"y1\":%d, \"x2\":%d, \"y2\":%d, \"length\":%d, \"magnitude\":%d, \"theta\":%d, \"rho\":%d}",
-              mp_obj_get_int(self->x1),
-              mp_obj_get_int(self->y1),
-              mp_obj_get_int(self->x2),
-              mp_obj_get_int(self->y2),
-              mp_obj_get_int(self->length),
-              mp_obj_get_int(self->magnitude),
-              mp_obj_get_int(self->theta),
-              mp_obj_get_int(self->rho));
-}
+    image_t *arg_img = py_helper_arg_to_image_mutable(args[0]);
 
-static mp_obj_t py_line_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value)
-{
-    if (value == MP_OBJ_SENTINEL) { // load
-        py_line_obj_t *self = self_in;
-        if (MP_OBJ_IS_TYPE(index, &mp_type_slice)) {
-            mp_bound_slice_t slice;
-            if (!mp_seq_get_fast_slice_indexes(py_line_obj_size, index, &slice)) {
-                nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "only slices with step=1 (aka None) are supported"));
-            }
-            mp_obj_tuple_t *result = mp_obj_new_tuple(slice.stop - slice.start, NULL);
-            mp_seq_copy(result->items, &(self->x1) + slice.start, result->len, mp_obj_t);
-            return result;
-        }
-        switch (mp_get_index(self->base.type, py_line_obj_size, index, false)) {
-            case 0: return self->x1;
-            case 1: return self->y1;
-            case 2: return self->x2;
-            case 3: return self->y2;
-            case 4: return self->length;
-            case 5: return self->magnitude;
-            case 6: return self->theta;
-            case 7: return self->rho;
-        }
-    }
-    return MP_OBJ_NULL; // op not supported
-}
+    size_t rois_len;
+    mp_obj_t *rois_obj;
+    mp_obj_get_array(args[1], &rois_len, &rois_obj);
+    PY_ASSERT_TRUE_MSG(rois_len >= 1, "Expected at least one ROI!");
 
-mp_obj_t py_line_line(mp_obj_t self_in)
-{
-    return mp_obj_new_tuple(4, (mp_obj_t []) {((py_line_obj_t *) self_in)->x1,
-                                              ((py_line_obj_t *) self_in)->y1,
-                                              ((py_line_obj_t *) self_in)->x2,
-                                              ((py_line_obj_t *) self_in)->y2});
-}
+    rectangle_t temp;
+    temp.x = 0;
+    temp.y = 0;
+    temp.w = arg_img->w;
+    temp.h = arg_img->h;
 
-mp_obj_t py_line_x1(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->x1; }
-mp_obj_t py_line_y1(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->y1; }
-mp_obj_t py_line_x2(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->x2; }
-mp_obj_t py_line_y2(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->y2; }
-mp_obj_t py_line_length(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->length; }
-mp_obj_t py_line_magnitude(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->magnitude; }
-mp_obj_t py_line_theta(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->theta; }
-mp_obj_t py_line_rho(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->rho; }
+    rectangle_t *rois = m_new(rectangle_t, rois_len);
+    for (size_t i = 0; i < rois_len; i++) {
+        mp_obj_t *arg_rectangle;
+        mp_obj_get_array_fixed_n(rois_obj[i], 4, &arg_rectangle);
+        rois[i].x = mp_obj_get_int(arg_rectangle[0]);
+        rois[i].y = mp_obj_get_int(arg_rectangle[1]);
+        rois[i].w = mp_obj_get_int(arg_rectangle[2]);
+        rois[i].h = mp_obj_get_int(arg_rectangle[3]);
+        PY_ASSERT_TRUE_MSG((rois[i].w >= 1) && (rois[i].h >= 1), "Invalid ROI dimensions!");
+        PY_ASSERT_TRUE_MSG(rectangle_overlap(&rois[i], &temp), "ROI does not overlap on the image!");
+        rectangle_intersected(&rois[i], &temp);
+    }
 
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_line_obj, py_line_line);
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_x1_obj, py_line_x1);
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_y1_obj, py_line_y1);
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_x2_obj, py_line_x2);
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_y2_obj, py_line_y2);
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_length_obj, py_line_length);
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_magnitude_obj, py_line_magnitude);
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_theta_obj, py_line_theta);
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_rho_obj, py_line_rho);
+    list_t thresholds;
+    list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
+    py_helper_keyword_thresholds(n_args, args, 2, kw_args, &thresholds);
+    bool invert = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_invert), false);
+    bool integral = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_integral), false);
 
-STATIC const mp_rom_map_elem_t py_line_locals_dict_table[] = {
-    { MP_ROM_QSTR(MP_QSTR_line), MP_ROM_PTR(&py_line_line_obj) },
-    { MP_ROM_QSTR(MP_QSTR_x1), MP_ROM_PTR(&py_line_x1_obj) },
+    histogram_t hist;
+    hist.ABinCount = 0;
+    hist.BBinCount = 0;
+    switch(arg_img->bpp) {
+        case IMAGE_BPP_BINARY: {
+            int bins = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_bins),
+                                             (COLOR_BINARY_MAX-COLOR_BINARY_MIN+1));
+            PY_ASSERT_TRUE_MSG(bins >= 2, "bins must be >= 2");
+            hist.LBinCount = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_l_bins), bins);
+            PY_ASSERT_TRUE_MSG(hist.LBinCount >= 2, "l_bins must be >= 2");
+            break;
+        }
+        case IMAGE_BPP_GRAYSCALE: {
+            int bins = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_bins),
+                                             (COLOR_GRAYSCALE_MAX-COLOR_GRAYSCALE_MIN+1));
+            PY_ASSERT_TRUE_MSG(bins >= 2, "bins must be >= 2");
+            hist.LBinCount = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_l_bins), bins);
+            PY_ASSERT_TRUE_MSG(hist.LBinCount >= 2, "l_bins must be >= 2");
+            break;
+        }
+        case IMAGE_BPP_RGB565: {
+            int l_bins = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_bins),
+                                               (COLOR_L_MAX-COLOR_L_MIN+1));
+            PY_ASSERT_TRUE_MSG(l_bins >= 2, "bins must be >= 2");
+            hist.LBinCount = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_l_bins), l_bins);
+            PY_ASSERT_TRUE_MSG(hist.LBinCount >= 2, "l_bins must be >= 2");
+            int a_bins = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_bins),
+                                               (COLOR_A_MAX-COLOR_A_MIN+1));
+            PY_ASSERT_TRUE_MSG(a_bins >= 2, "bins must be >= 2");
+            hist.ABinCount = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_a_bins), a_bins);
+            PY_ASSERT_TRUE_MSG(hist.ABinCount >= 2, "a_bins must be >= 2");
+            int b_bins = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_bins),
+                                               (COLOR_B_MAX-COLOR_B_MIN+1));
+            PY_ASSERT_TRUE_MSG(b_bins >= 2, "bins must be >= 2");
+            hist.BBinCount = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_b_bins), b_bins);
+            PY_ASSERT_TRUE_MSG(hist.BBinCount >= 2, "b_bins must be >= 2");
+            break;
+        }
+        default: {
+            return MP_OBJ_NULL;
+        }
+    }
+
+    statistics_t *stats = m_new(statistics_t, rois_len);
+
+    fb_alloc_mark();
+    histogram_t *hists = fb_alloc(rois_len * sizeof(histogram_t), FB_ALLOC_NO_HINT);
+    for (size_t i = 0; i < rois_len; i++) {
+        hists[i] = hist;
+        hists[i].LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_NO_HINT);
+        hists[i].ABins = hist.ABinCount ? fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_NO_HINT) : NULL;
+        hists[i].BBins = hist.BBinCount ? fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_NO_HINT) : NULL;
+    }
+
+    imlib_get_histograms(hists, arg_img, rois, rois_len, &thresholds, invert, integral);
+    list_free(&thresholds);
+
+    for (size_t i = 0; i < rois_len; i++) {
+        imlib_get_statistics(&stats[i], arg_img->bpp, &hists[i]);
+    }
+
+    fb_alloc_free_till_mark();
+    m_del(rectangle_t, rois, rois_len);
+
+    return mp_obj_new_bytearray_by_ref(rois_len * sizeof(statistics_t), stats);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_statistics_rois_obj, 2, py_image_get_statistics_rois);
+
+// Find Results //
+// What find_blobs(), find_lines() and find_qrcodes() found is picked in C before any of it
+// becomes Python: max_results keeps the best ones by sort_by, or the first ones found, and
+// lazy=True returns an iterator that turns one result at a time into its Python object, so a
+// loop that stops early pays only for the objects it took.
+typedef mp_obj_t (*py_image_results_convert_t)(void *lnk_data);
+typedef float (*py_image_results_key_t)(void *lnk_data, qstr sort_by);
+
+typedef struct py_image_results_obj {
+    mp_obj_base_t base;
+    py_image_results_convert_t convert;
+    size_t data_len, index, count;
+    char *data;
+} py_image_results_obj_t;
+
+static mp_obj_t py_image_results_iternext(mp_obj_t self_in)
+{
+    py_image_results_obj_t *self = self_in;
+    if (self->index >= self->count) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    return self->convert(self->data + (self->index++ * self->data_len));
+}
+
+static mp_obj_t py_image_results_unary_op(mp_unary_op_t op, mp_obj_t self_in)
+{
+    py_image_results_obj_t *self = self_in;
+    switch (op) {
+        case MP_UNARY_OP_BOOL: return mp_obj_new_bool(self->index < self->count);
+        case MP_UNARY_OP_LEN: return mp_obj_new_int(self->count - self->index);
+        default: return MP_OBJ_NULL; // op not supported
+    }
+}
+
+static const mp_obj_type_t py_image_results_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_iterator,
+    .unary_op = py_image_results_unary_op,
+    .getiter = mp_identity_getiter,
+    .iternext = py_image_results_iternext,
+};
+
+// Empties out into a list of Python objects, or with lazy into an iterator of them. The C
+// results the iterator holds are on the GC heap, one it does not get to is simply collected.
+static mp_obj_t py_image_results_new(list_t *out, py_image_results_convert_t convert, bool lazy)
+{
+    size_t count = list_size(out);
+
+    if (!lazy) {
+        mp_obj_list_t *objects_list = mp_obj_new_list(count, NULL);
+        for (size_t i = 0; list_size(out); i++) {
+            objects_list->items[i] = convert(out->head_ptr->data);
+            list_pop_front(out, NULL);
+        }
+        return objects_list;
+    }
+
+    py_image_results_obj_t *o = m_new_obj(py_image_results_obj_t);
+    o->base.type = &py_image_results_type;
+    o->convert = convert;
+    o->data_len = out->data_len;
+    o->index = 0;
+    o->count = count;
+    o->data = m_new(char, count * out->data_len);
+    for (size_t i = 0; list_size(out); i++) {
+        list_pop_front(out, o->data + (i * out->data_len));
+    }
+    return o;
+}
+
+// Puts lnk_data into best, kept by descending key, or in the order found without a key, and
+// at most max_results long (0 for no limit). Returns false when lnk_data did not make it, its
+// owner keeps it then; a result pushed out of a full list is handed to drop.
+static bool py_image_results_keep(list_t *best, void *lnk_data, size_t max_results,
+                                  py_image_results_key_t key, qstr sort_by, void (*drop)(void *))
+{
+    size_t index = list_size(best);
+
+    if (key) {
+        float k = key(lnk_data, sort_by);
+        index = 0;
+        for (list_lnk_t *it = iterator_start_from_head(best); it; it = iterator_next(it), index++) {
+            if (key(it->data, sort_by) < k) {
+                break;
+            }
+        }
+    }
+
+    if (max_results && (index >= max_results)) {
+        return false;
+    }
+
+    list_insert(best, lnk_data, index);
+
+    if (max_results && (list_size(best) > max_results)) {
+        if (drop) {
+            drop(best->tail_ptr->data);
+        }
+        list_pop_back(best, NULL);
+    }
+
+    return true;
+}
+
+// sort_by=None or one of the names given, MP_QSTRnull for None.
+static qstr py_image_results_sort_by(uint n_args, const mp_obj_t *args, uint arg_index, mp_map_t *kw_args,
+                                     const qstr *names, size_t names_len)
+{
+    mp_obj_t arg = py_helper_keyword_object(n_args, args, arg_index, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_sort_by));
+    if ((arg == NULL) || (arg == mp_const_none)) {
+        return MP_QSTRnull;
+    }
+    qstr sort_by = mp_obj_str_get_qstr(arg);
+    for (size_t i = 0; i < names_len; i++) {
+        if (names[i] == sort_by) {
+            return sort_by;
+        }
+    }
+    nlr_raise(mp_obj_new_exception_msg_varg(&mp_type_ValueError, "can't sort by '%q'", sort_by));
+}
+
+// Line Object //
+#define py_line_obj_size 8
+typedef struct py_line_obj {
+    mp_obj_base_t base;
+    mp_obj_t x1, y1, x2, y2, length, magnitude, theta, rho;
+} py_line_obj_t;
+
+static void py_line_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
+{
+    py_line_obj_t *self = self_in;
+    mp_printf(print,
+              "{\"x1\":%d, \"y1\":%d, \"x2\":%d, \"y2\":%d, \"length\":%d, \"magnitude\":%d, \"theta\":%d, \"rho\":%d}",
+              mp_obj_get_int(self->x1),
+              mp_obj_get_int(self->y1),
+              mp_obj_get_int(self->x2),
+              mp_obj_get_int(self->y2),
+              mp_obj_get_int(self->length),
+              mp_obj_get_int(self->magnitude),
+              mp_obj_get_int(self->theta),
+              mp_obj_get_int(self->rho));
+}
+
+static mp_obj_t py_line_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value)
+{
+    if (value == MP_OBJ_SENTINEL) { // load
+        py_line_obj_t *self = self_in;
+        if (MP_OBJ_IS_TYPE(index, &mp_type_slice)) {
+            mp_bound_slice_t slice;
+            if (!mp_seq_get_fast_slice_indexes(py_line_obj_size, index, &slice)) {
+                nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "only slices with step=1 (aka None) are supported"));
+            }
+            mp_obj_tuple_t *result = mp_obj_new_tuple(slice.stop - slice.start, NULL);
+            mp_seq_copy(result->items, &(self->x1) + slice.start, result->len, mp_obj_t);
+            return result;
+        }
+        switch (mp_get_index(self->base.type, py_line_obj_size, index, false)) {
+            case 0: return self->x1;
+            case 1: return self->y1;
+            case 2: return self->x2;
+            case 3: return self->y2;
+            case 4: return self->length;
+            case 5: return self->magnitude;
+            case 6: return self->theta;
+            case 7: return self->rho;
+        }
+    }
+    return MP_OBJ_NULL; // op not supported
+}
+
+mp_obj_t py_line_line(mp_obj_t self_in)
+{
+    return mp_obj_new_tuple(4, (mp_obj_t []) {((py_line_obj_t *) self_in)->x1,
+                                              ((py_line_obj_t *) self_in)->y1,
+                                              ((py_line_obj_t *) self_in)->x2,
+                                              ((py_line_obj_t *) self_in)->y2});
+}
+
+mp_obj_t py_line_x1(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->x1; }
+mp_obj_t py_line_y1(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->y1; }
+mp_obj_t py_line_x2(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->x2; }
+mp_obj_t py_line_y2(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->y2; }
+mp_obj_t py_line_length(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->length; }
+mp_obj_t py_line_magnitude(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->magnitude; }
+mp_obj_t py_line_theta(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->theta; }
+mp_obj_t py_line_rho(mp_obj_t self_in) { return ((py_line_obj_t *) self_in)->rho; }
+
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_line_obj, py_line_line);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_x1_obj, py_line_x1);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_y1_obj, py_line_y1);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_x2_obj, py_line_x2);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_y2_obj, py_line_y2);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_length_obj, py_line_length);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_magnitude_obj, py_line_magnitude);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_theta_obj, py_line_theta);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_line_rho_obj, py_line_rho);
+
+STATIC const mp_rom_map_elem_t py_line_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_line), MP_ROM_PTR(&py_line_line_obj) },
+    { MP_ROM_QSTR(MP_QSTR_x1), MP_ROM_PTR(&py_line_x1_obj) },
     { MP_ROM_QSTR(MP_QSTR_y1), MP_ROM_PTR(&py_line_y1_obj) },
     { MP_ROM_QSTR(MP_QSTR_x2), MP_ROM_PTR(&py_line_x2_obj) },
     { MP_ROM_QSTR(MP_QSTR_y2), MP_ROM_PTR(&py_line_y2_obj) },
@@ -4313,6 +4928,37 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_regression_obj, 2, py_image_get_r
 // Find Methods
 ///////////////
 
+#ifdef IMLIB_ENABLE_FIND_LINES
+static mp_obj_t py_line_from_lnk(void *lnk_data)
+{
+    find_lines_list_lnk_data_t *lnk = lnk_data;
+    py_line_obj_t *o = m_new_obj(py_line_obj_t);
+    o->base.type = &py_line_type;
+    o->x1 = mp_obj_new_int(lnk->line.x1);
+    o->y1 = mp_obj_new_int(lnk->line.y1);
+    o->x2 = mp_obj_new_int(lnk->line.x2);
+    o->y2 = mp_obj_new_int(lnk->line.y2);
+    int x_diff = lnk->line.x2 - lnk->line.x1;
+    int y_diff = lnk->line.y2 - lnk->line.y1;
+    o->length = mp_obj_new_int(fast_roundf(fast_sqrtf((x_diff * x_diff) + (y_diff * y_diff))));
+    o->magnitude = mp_obj_new_int(lnk->magnitude);
+    o->theta = mp_obj_new_int(lnk->theta);
+    o->rho = mp_obj_new_int(lnk->rho);
+    return o;
+}
+
+static float py_line_key(void *lnk_data, qstr sort_by)
+{
+    find_lines_list_lnk_data_t *lnk = lnk_data;
+    if (sort_by == MP_QSTR_length) {
+        int x_diff = lnk->line.x2 - lnk->line.x1;
+        int y_diff = lnk->line.y2 - lnk->line.y1;
+        return (x_diff * x_diff) + (y_diff * y_diff);
+    }
+    return lnk->magnitude;
+}
+#endif // IMLIB_ENABLE_FIND_LINES
+
 // Blob Object //
 #define py_blob_obj_size 12
 typedef struct py_blob_obj {
@@ -4721,7 +5367,7 @@ static const mp_obj_type_t py_blob_type = {
     .locals_dict = (mp_obj_t) &py_blob_locals_dict
 };
 
-static bool py_image_find_blobs_threshold_cb(void *fun_obj, find_blobs_list_lnk_data_t *blob)
+static mp_obj_t py_blob_obj_new(find_blobs_list_lnk_data_t *blob)
 {
     py_blob_obj_t *o = m_new_obj(py_blob_obj_t);
     o->base.type = &py_blob_type;
@@ -4764,99 +5410,72 @@ static bool py_image_find_blobs_threshold_cb(void *fun_obj, find_blobs_list_lnk_
         ((mp_obj_list_t *) o->y_hist_bins)->items[i] = mp_obj_new_int(blob->y_hist_bins[i]);
     }
 
-    return mp_obj_is_true(mp_call_function_1(fun_obj, o));
+    return o;
+}
+
+// The list and the lazy results of find_blobs() take the histograms over from C.
+static mp_obj_t py_blob_from_lnk(void *lnk_data)
+{
+    find_blobs_list_lnk_data_t *blob = lnk_data;
+    mp_obj_t o = py_blob_obj_new(blob);
+    if (blob->x_hist_bins) xfree(blob->x_hist_bins);
+    if (blob->y_hist_bins) xfree(blob->y_hist_bins);
+    return o;
+}
+
+static void py_blob_drop(void *lnk_data)
+{
+    find_blobs_list_lnk_data_t *blob = lnk_data;
+    if (blob->x_hist_bins) xfree(blob->x_hist_bins);
+    if (blob->y_hist_bins) xfree(blob->y_hist_bins);
+}
+
+static float py_blob_key(void *lnk_data, qstr sort_by)
+{
+    find_blobs_list_lnk_data_t *blob = lnk_data;
+    switch (sort_by) {
+        case MP_QSTR_area: return blob->rect.w * blob->rect.h;
+        case MP_QSTR_roundness: return blob->roundness;
+        default: return blob->pixels;
+    }
+}
+
+static bool py_image_find_blobs_threshold_cb(void *fun_obj, find_blobs_list_lnk_data_t *blob)
+{
+    return mp_obj_is_true(mp_call_function_1(fun_obj, py_blob_obj_new(blob)));
 }
 
 static bool py_image_find_blobs_merge_cb(void *fun_obj, find_blobs_list_lnk_data_t *blob0, find_blobs_list_lnk_data_t *blob1)
 {
-    py_blob_obj_t *o0 = m_new_obj(py_blob_obj_t);
-    o0->base.type = &py_blob_type;
-    o0->corners = mp_obj_new_tuple(4, (mp_obj_t [])
-        {mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(blob0->corners[(FIND_BLOBS_CORNERS_RESOLUTION*0)/4].x),
-                                            mp_obj_new_int(blob0->corners[(FIND_BLOBS_CORNERS_RESOLUTION*0)/4].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(blob0->corners[(FIND_BLOBS_CORNERS_RESOLUTION*1)/4].x),
-                                            mp_obj_new_int(blob0->corners[(FIND_BLOBS_CORNERS_RESOLUTION*1)/4].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(blob0->corners[(FIND_BLOBS_CORNERS_RESOLUTION*2)/4].x),
-                                            mp_obj_new_int(blob0->corners[(FIND_BLOBS_CORNERS_RESOLUTION*2)/4].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(blob0->corners[(FIND_BLOBS_CORNERS_RESOLUTION*3)/4].x),
-                                            mp_obj_new_int(blob0->corners[(FIND_BLOBS_CORNERS_RESOLUTION*3)/4].y)})});
-    point_t min_area_rect_corners0[4];
-    point_min_area_rectangle(blob0->corners, min_area_rect_corners0, FIND_BLOBS_CORNERS_RESOLUTION);
-    o0->min_corners = mp_obj_new_tuple(4, (mp_obj_t [])
-        {mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_area_rect_corners0[0].x), mp_obj_new_int(min_area_rect_corners0[0].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_area_rect_corners0[1].x), mp_obj_new_int(min_area_rect_corners0[1].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_area_rect_corners0[2].x), mp_obj_new_int(min_area_rect_corners0[2].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_area_rect_corners0[3].x), mp_obj_new_int(min_area_rect_corners0[3].y)})});
-    o0->x = mp_obj_new_int(blob0->rect.x);
-    o0->y = mp_obj_new_int(blob0->rect.y);
-    o0->w = mp_obj_new_int(blob0->rect.w);
-    o0->h = mp_obj_new_int(blob0->rect.h);
-    o0->pixels = mp_obj_new_int(blob0->pixels);
-    o0->cx = mp_obj_new_float(blob0->centroid_x);
-    o0->cy = mp_obj_new_float(blob0->centroid_y);
-    o0->rotation = mp_obj_new_float(blob0->rotation);
-    o0->code = mp_obj_new_int(blob0->code);
-    o0->count = mp_obj_new_int(blob0->count);
-    o0->perimeter = mp_obj_new_int(blob0->perimeter);
-    o0->roundness = mp_obj_new_float(blob0->roundness);
-    o0->x_hist_bins = mp_obj_new_list(blob0->x_hist_bins_count, NULL);
-    o0->y_hist_bins = mp_obj_new_list(blob0->y_hist_bins_count, NULL);
-
-    for (int i = 0; i < blob0->x_hist_bins_count; i++) {
-        ((mp_obj_list_t *) o0->x_hist_bins)->items[i] = mp_obj_new_int(blob0->x_hist_bins[i]);
-    }
-
-    for (int i = 0; i < blob0->y_hist_bins_count; i++) {
-        ((mp_obj_list_t *) o0->y_hist_bins)->items[i] = mp_obj_new_int(blob0->y_hist_bins[i]);
-    }
-
-    py_blob_obj_t *o1 = m_new_obj(py_blob_obj_t);
-    o1->base.type = &py_blob_type;
-    o1->corners = mp_obj_new_tuple(4, (mp_obj_t [])
-        {mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(blob1->corners[(FIND_BLOBS_CORNERS_RESOLUTION*0)/4].x),
-                                            mp_obj_new_int(blob1->corners[(FIND_BLOBS_CORNERS_RESOLUTION*0)/4].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(blob1->corners[(FIND_BLOBS_CORNERS_RESOLUTION*1)/4].x),
-                                            mp_obj_new_int(blob1->corners[(FIND_BLOBS_CORNERS_RESOLUTION*1)/4].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(blob1->corners[(FIND_BLOBS_CORNERS_RESOLUTION*2)/4].x),
-                                            mp_obj_new_int(blob1->corners[(FIND_BLOBS_CORNERS_RESOLUTION*2)/4].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(blob1->corners[(FIND_BLOBS_CORNERS_RESOLUTION*3)/4].x),
-                                            mp_obj_new_int(blob1->corners[(FIND_BLOBS_CORNERS_RESOLUTION*3)/4].y)})});
-    point_t min_area_rect_corners1[4];
-    point_min_area_rectangle(blob1->corners, min_area_rect_corners1, FIND_BLOBS_CORNERS_RESOLUTION);
-    o1->min_corners = mp_obj_new_tuple(4, (mp_obj_t [])
-        {mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_area_rect_corners1[0].x), mp_obj_new_int(min_area_rect_corners1[0].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_area_rect_corners1[1].x), mp_obj_new_int(min_area_rect_corners1[1].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_area_rect_corners1[2].x), mp_obj_new_int(min_area_rect_corners1[2].y)}),
-         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_area_rect_corners1[3].x), mp_obj_new_int(min_area_rect_corners1[3].y)})});
-    o1->x = mp_obj_new_int(blob1->rect.x);
-    o1->y = mp_obj_new_int(blob1->rect.y);
-    o1->w = mp_obj_new_int(blob1->rect.w);
-    o1->h = mp_obj_new_int(blob1->rect.h);
-    o1->pixels = mp_obj_new_int(blob1->pixels);
-    o1->cx = mp_obj_new_float(blob1->centroid_x);
-    o1->cy = mp_obj_new_float(blob1->centroid_y);
-    o1->rotation = mp_obj_new_float(blob1->rotation);
-    o1->code = mp_obj_new_int(blob1->code);
-    o1->count = mp_obj_new_int(blob1->count);
-    o1->perimeter = mp_obj_new_int(blob1->perimeter);
-    o1->roundness = mp_obj_new_float(blob1->roundness);
-    o1->x_hist_bins = mp_obj_new_list(blob1->x_hist_bins_count, NULL);
-    o1->y_hist_bins = mp_obj_new_list(blob1->y_hist_bins_count, NULL);
-
-    for (int i = 0; i < blob1->x_hist_bins_count; i++) {
-        ((mp_obj_list_t *) o1->x_hist_bins)->items[i] = mp_obj_new_int(blob1->x_hist_bins[i]);
-    }
-
-    for (int i = 0; i < blob1->y_hist_bins_count; i++) {
-        ((mp_obj_list_t *) o1->y_hist_bins)->items[i] = mp_obj_new_int(blob1->y_hist_bins[i]);
-    }
-
-    return mp_obj_is_true(mp_call_function_2(fun_obj, o0, o1));
+    return mp_obj_is_true(mp_call_function_2(fun_obj, py_blob_obj_new(blob0), py_blob_obj_new(blob1)));
+}
+
+typedef struct py_image_find_blobs_best {
+    mp_obj_t threshold_cb;
+    list_t best;
+    size_t max_results;
+    qstr sort_by;
+} py_image_find_blobs_best_t;
+
+// Without merging the best blobs are picked as they are found, the others are never listed.
+static bool py_image_find_blobs_best_cb(void *arg, find_blobs_list_lnk_data_t *blob)
+{
+    py_image_find_blobs_best_t *best = arg;
+    if (best->threshold_cb && (!py_image_find_blobs_threshold_cb(best->threshold_cb, blob))) {
+        return false;
+    }
+    if (py_image_results_keep(&best->best, blob, best->max_results,
+                              best->sort_by ? py_blob_key : NULL, best->sort_by, py_blob_drop)) {
+        // the best list owns the histograms now
+        blob->x_hist_bins = NULL;
+        blob->y_hist_bins = NULL;
+    }
+    return false;
 }
 
 static mp_obj_t py_image_find_blobs(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
 {
-    image_t *arg_img = py_helper_arg_to_image_mutable(args[0]);
+    image_t *arg_img = py_helper_arg_to_image_mutable_bayer(args[0]);
 
     list_t thresholds;
     list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
@@ -4869,6 +5488,12 @@ static mp_obj_t py_image_find_blobs(uint n_args, const mp_obj_t *args, mp_map_t
 	OverlaySwitch(OVLY_LAB_TAB);
 	#endif
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 3, kw_args, &roi);
+    if (IM_IS_YUV422(arg_img)) {
+        // YUV422 is classified in place, the thresholds are its Y, U and V ranges.
+        PY_ASSERT_TRUE_MSG(list_size(&thresholds) <= COLOR_YUV_THRESHOLDS_MAX, "YUV422 images take up to 32 thresholds!");
+    } else {
+        arg_img = py_helper_image_unpack(arg_img, &roi, IMAGE_BPP_RGB565);
+    }
 
     unsigned int x_stride =
         py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_stride), 2);
@@ -4892,67 +5517,57 @@ static mp_obj_t py_image_find_blobs(uint n_args, const mp_obj_t *args, mp_map_t
         py_helper_keyword_int(n_args, args, 12, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_hist_bins_max), 0);
     unsigned int y_hist_bins_max =
         py_helper_keyword_int(n_args, args, 13, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_hist_bins_max), 0);
+    int max_results =
+        py_helper_keyword_int(n_args, args, 14, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_results), 0);
+    PY_ASSERT_TRUE_MSG(max_results >= 0, "Error: max_results >= 0!");
+    static const qstr sort_by_names[] = { MP_QSTR_pixels, MP_QSTR_area, MP_QSTR_roundness };
+    qstr sort_by = py_image_results_sort_by(n_args, args, 15, kw_args, sort_by_names, MP_ARRAY_SIZE(sort_by_names));
+    bool lazy =
+        py_helper_keyword_int(n_args, args, 16, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_lazy), false);
+
+    py_image_find_blobs_best_t best = {
+        .threshold_cb = threshold_cb, .max_results = max_results, .sort_by = sort_by
+    };
+    list_init(&best.best, sizeof(find_blobs_list_lnk_data_t));
+    bool pick = max_results || sort_by;
+    // merging needs all the blobs, the best of the merged ones are picked after it
+    bool pick_early = pick && (!merge);
+    bool (*t_cb)(void*,find_blobs_list_lnk_data_t*) = pick_early ? py_image_find_blobs_best_cb : py_image_find_blobs_threshold_cb;
+    void *t_cb_arg = pick_early ? &best : threshold_cb;
 
     list_t out;
-    fb_alloc_mark();
-    imlib_find_blobs(&out, arg_img, &roi, x_stride, y_stride, &thresholds, invert,
-            area_threshold, pixels_threshold, merge, margin,
-            py_image_find_blobs_threshold_cb, threshold_cb, py_image_find_blobs_merge_cb, merge_cb, x_hist_bins_max, y_hist_bins_max);
-    fb_alloc_free_till_mark();
+    if (threshold_cb || merge_cb) {
+        // the callbacks run Python, this keeps the GIL
+        fb_alloc_mark();
+        imlib_find_blobs(&out, arg_img, &roi, x_stride, y_stride, &thresholds, invert,
+                area_threshold, pixels_threshold, merge, margin,
+                t_cb, t_cb_arg, py_image_find_blobs_merge_cb, merge_cb, x_hist_bins_max, y_hist_bins_max);
+        fb_alloc_free_till_mark();
+    } else {
+        PY_NATIVE_BEGIN();
+        fb_alloc_mark();
+        imlib_find_blobs(&out, arg_img, &roi, x_stride, y_stride, &thresholds, invert,
+                area_threshold, pixels_threshold, merge, margin,
+                t_cb, pick_early ? &best : NULL, py_image_find_blobs_merge_cb, NULL, x_hist_bins_max, y_hist_bins_max);
+        fb_alloc_free_till_mark();
+        PY_NATIVE_END();
+    }
     list_free(&thresholds);
 
-    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
-    for (size_t i = 0; list_size(&out); i++) {
-        find_blobs_list_lnk_data_t lnk_data;
-        list_pop_front(&out, &lnk_data);
-
-        py_blob_obj_t *o = m_new_obj(py_blob_obj_t);
-        o->base.type = &py_blob_type;
-        o->corners = mp_obj_new_tuple(4, (mp_obj_t [])
-            {mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk_data.corners[(FIND_BLOBS_CORNERS_RESOLUTION*0)/4].x),
-                                                mp_obj_new_int(lnk_data.corners[(FIND_BLOBS_CORNERS_RESOLUTION*0)/4].y)}),
-             mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk_data.corners[(FIND_BLOBS_CORNERS_RESOLUTION*1)/4].x),
-                                                mp_obj_new_int(lnk_data.corners[(FIND_BLOBS_CORNERS_RESOLUTION*1)/4].y)}),
-             mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk_data.corners[(FIND_BLOBS_CORNERS_RESOLUTION*2)/4].x),
-                                                mp_obj_new_int(lnk_data.corners[(FIND_BLOBS_CORNERS_RESOLUTION*2)/4].y)}),
-             mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk_data.corners[(FIND_BLOBS_CORNERS_RESOLUTION*3)/4].x),
-                                                mp_obj_new_int(lnk_data.corners[(FIND_BLOBS_CORNERS_RESOLUTION*3)/4].y)})});
-        point_t min_corners[4];
-        point_min_area_rectangle(lnk_data.corners, min_corners, FIND_BLOBS_CORNERS_RESOLUTION);
-        o->min_corners = mp_obj_new_tuple(4, (mp_obj_t [])
-            {mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_corners[0].x), mp_obj_new_int(min_corners[0].y)}),
-             mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_corners[1].x), mp_obj_new_int(min_corners[1].y)}),
-             mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_corners[2].x), mp_obj_new_int(min_corners[2].y)}),
-             mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(min_corners[3].x), mp_obj_new_int(min_corners[3].y)})});
-        o->x = mp_obj_new_int(lnk_data.rect.x);
-        o->y = mp_obj_new_int(lnk_data.rect.y);
-        o->w = mp_obj_new_int(lnk_data.rect.w);
-        o->h = mp_obj_new_int(lnk_data.rect.h);
-        o->pixels = mp_obj_new_int(lnk_data.pixels);
-        o->cx = mp_obj_new_float(lnk_data.centroid_x);
-        o->cy = mp_obj_new_float(lnk_data.centroid_y);
-        o->rotation = mp_obj_new_float(lnk_data.rotation);
-        o->code = mp_obj_new_int(lnk_data.code);
-        o->count = mp_obj_new_int(lnk_data.count);
-        o->perimeter = mp_obj_new_int(lnk_data.perimeter);
-        o->roundness = mp_obj_new_float(lnk_data.roundness);
-        o->x_hist_bins = mp_obj_new_list(lnk_data.x_hist_bins_count, NULL);
-        o->y_hist_bins = mp_obj_new_list(lnk_data.y_hist_bins_count, NULL);
-
-        for (int i = 0; i < lnk_data.x_hist_bins_count; i++) {
-            ((mp_obj_list_t *) o->x_hist_bins)->items[i] = mp_obj_new_int(lnk_data.x_hist_bins[i]);
-        }
-
-        for (int i = 0; i < lnk_data.y_hist_bins_count; i++) {
-            ((mp_obj_list_t *) o->y_hist_bins)->items[i] = mp_obj_new_int(lnk_data.y_hist_bins[i]);
+    if (pick && (!pick_early)) {
+        while (list_size(&out)) {
+            find_blobs_list_lnk_data_t lnk_data;
+            list_pop_front(&out, &lnk_data);
+            if (!py_image_results_keep(&best.best, &lnk_data, max_results, sort_by ? py_blob_key : NULL, sort_by, py_blob_drop)) {
+                py_blob_drop(&lnk_data);
+            }
         }
-
-        objects_list->items[i] = o;
-        if (lnk_data.x_hist_bins) xfree(lnk_data.x_hist_bins);
-        if (lnk_data.y_hist_bins) xfree(lnk_data.y_hist_bins);
+    }
+    if (pick) {
+        out = best.best;
     }
 
-    return objects_list;
+    return py_image_results_new(&out, py_blob_from_lnk, lazy);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_blobs_obj, 2, py_image_find_blobs);
 
@@ -4971,34 +5586,32 @@ static mp_obj_t py_image_find_lines(uint n_args, const mp_obj_t *args, mp_map_t
     uint32_t threshold = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 1000);
     unsigned int theta_margin = py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_theta_margin), 25);
     unsigned int rho_margin = py_helper_keyword_int(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_rho_margin), 25);
+    int max_results = py_helper_keyword_int(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_results), 0);
+    PY_ASSERT_TRUE_MSG(max_results >= 0, "Error: max_results >= 0!");
+    static const qstr sort_by_names[] = { MP_QSTR_magnitude, MP_QSTR_length };
+    qstr sort_by = py_image_results_sort_by(n_args, args, 8, kw_args, sort_by_names, MP_ARRAY_SIZE(sort_by_names));
+    bool lazy = py_helper_keyword_int(n_args, args, 9, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_lazy), false);
 
     list_t out;
+    PY_NATIVE_BEGIN();
     fb_alloc_mark();
     imlib_find_lines(&out, arg_img, &roi, x_stride, y_stride, threshold, theta_margin, rho_margin);
     fb_alloc_free_till_mark();
-
-    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
-    for (size_t i = 0; list_size(&out); i++) {
-        find_lines_list_lnk_data_t lnk_data;
-        list_pop_front(&out, &lnk_data);
-
-        py_line_obj_t *o = m_new_obj(py_line_obj_t);
-        o->base.type = &py_line_type;
-        o->x1 = mp_obj_new_int(lnk_data.line.x1);
-        o->y1 = mp_obj_new_int(lnk_data.line.y1);
-        o->x2 = mp_obj_new_int(lnk_data.line.x2);
-        o->y2 = mp_obj_new_int(lnk_data.line.y2);
-        int x_diff = lnk_data.line.x2 - lnk_data.line.x1;
-        int y_diff = lnk_data.line.y2 - lnk_data.line.y1;
-        o->length = mp_obj_new_int(fast_roundf(fast_sqrtf((x_diff * x_diff) + (y_diff * y_diff))));
-        o->magnitude = mp_obj_new_int(lnk_data.magnitude);
-        o->theta = mp_obj_new_int(lnk_data.theta);
-        o->rho = mp_obj_new_int(lnk_data.rho);
-
-        objects_list->items[i] = o;
+    PY_NATIVE_END();
+
+    // the lines are only known once the margins merged them, so they are picked after
+    if (max_results || sort_by) {
+        list_t best;
+        list_init(&best, sizeof(find_lines_list_lnk_data_t));
+        while (list_size(&out)) {
+            find_lines_list_lnk_data_t lnk_data;
+            list_pop_front(&out, &lnk_data);
+            py_image_results_keep(&best, &lnk_data, max_results, sort_by ? py_line_key : NULL, sort_by, NULL);
+        }
+        out = best;
     }
 
-    return objects_list;
+    return py_image_results_new(&out, py_line_from_lnk, lazy);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_lines_obj, 1, py_image_find_lines);
 #endif // IMLIB_ENABLE_FIND_LINES
@@ -5015,9 +5628,11 @@ static mp_obj_t py_image_find_line_segments(uint n_args, const mp_obj_t *args, m
     unsigned int max_theta_diff = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_theta_diff), 15);
 
     list_t out;
+    PY_NATIVE_BEGIN();
     fb_alloc_mark();
     imlib_lsd_find_line_segments(&out, arg_img, &roi, merge_distance, max_theta_diff);
     fb_alloc_free_till_mark();
+    PY_NATIVE_END();
 
     mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
     for (size_t i = 0; list_size(&out); i++) {
@@ -5145,10 +5760,12 @@ static mp_obj_t py_image_find_circles(uint n_args, const mp_obj_t *args, mp_map_
     unsigned int r_step = py_helper_keyword_int(n_args, args, 10, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_r_step), 2);
 
     list_t out;
+    PY_NATIVE_BEGIN();
     fb_alloc_mark();
     imlib_find_circles(&out, arg_img, &roi, x_stride, y_stride, threshold, x_margin, y_margin, r_margin,
                        r_min, r_max, r_step);
     fb_alloc_free_till_mark();
+    PY_NATIVE_END();
 
     mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
     for (size_t i = 0; list_size(&out); i++) {
@@ -5268,9 +5885,11 @@ static mp_obj_t py_image_find_rects(uint n_args, const mp_obj_t *args, mp_map_t
     uint32_t threshold = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 1000);
 
     list_t out;
+    PY_NATIVE_BEGIN();
     fb_alloc_mark();
     imlib_find_rects(&out, arg_img, &roi, threshold);
     fb_alloc_free_till_mark();
+    PY_NATIVE_END();
 
     mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
     for (size_t i = 0; list_size(&out); i++) {
@@ -5424,46 +6043,57 @@ static const mp_obj_type_t py_qrcode_type = {
     .locals_dict = (mp_obj_t) &py_qrcode_locals_dict
 };
 
-static mp_obj_t py_image_find_qrcodes(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+// The qrcode objects of the codes imlib_find_qrcodes() puts in out, emptying it.
+static mp_obj_t py_qrcode_from_lnk(void *lnk_data)
 {
-    image_t *arg_img = py_helper_arg_to_image_mutable(args[0]);
-
-    rectangle_t roi;
-    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
-
-    list_t out;
-    fb_alloc_mark();
-    imlib_find_qrcodes(&out, arg_img, &roi);
-    fb_alloc_free_till_mark();
+    find_qrcodes_list_lnk_data_t *lnk = lnk_data;
+    py_qrcode_obj_t *o = m_new_obj(py_qrcode_obj_t);
+    o->base.type = &py_qrcode_type;
+    o->corners = mp_obj_new_tuple(4, (mp_obj_t [])
+        {mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk->corners[0].x), mp_obj_new_int(lnk->corners[0].y)}),
+         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk->corners[1].x), mp_obj_new_int(lnk->corners[1].y)}),
+         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk->corners[2].x), mp_obj_new_int(lnk->corners[2].y)}),
+         mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk->corners[3].x), mp_obj_new_int(lnk->corners[3].y)})});
+    o->x = mp_obj_new_int(lnk->rect.x);
+    o->y = mp_obj_new_int(lnk->rect.y);
+    o->w = mp_obj_new_int(lnk->rect.w);
+    o->h = mp_obj_new_int(lnk->rect.h);
+    o->payload = mp_obj_new_str(lnk->payload, lnk->payload_len);
+    o->version = mp_obj_new_int(lnk->version);
+    o->ecc_level = mp_obj_new_int(lnk->ecc_level);
+    o->mask = mp_obj_new_int(lnk->mask);
+    o->data_type = mp_obj_new_int(lnk->data_type);
+    o->eci = mp_obj_new_int(lnk->eci);
+    xfree(lnk->payload);
+    return o;
+}
 
-    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
-    for (size_t i = 0; list_size(&out); i++) {
-        find_qrcodes_list_lnk_data_t lnk_data;
-        list_pop_front(&out, &lnk_data);
+static mp_obj_t py_image_qrcodes_list(list_t *out)
+{
+    return py_image_results_new(out, py_qrcode_from_lnk, false);
+}
 
-        py_qrcode_obj_t *o = m_new_obj(py_qrcode_obj_t);
-        o->base.type = &py_qrcode_type;
-        o->corners = mp_obj_new_tuple(4, (mp_obj_t [])
-            {mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk_data.corners[0].x), mp_obj_new_int(lnk_data.corners[0].y)}),
-             mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk_data.corners[1].x), mp_obj_new_int(lnk_data.corners[1].y)}),
-             mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk_data.corners[2].x), mp_obj_new_int(lnk_data.corners[2].y)}),
-             mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(lnk_data.corners[3].x), mp_obj_new_int(lnk_data.corners[3].y)})});
-        o->x = mp_obj_new_int(lnk_data.rect.x);
-        o->y = mp_obj_new_int(lnk_data.rect.y);
-        o->w = mp_obj_new_int(lnk_data.rect.w);
-        o->h = mp_obj_new_int(lnk_data.rect.h);
-        o->payload = mp_obj_new_str(lnk_data.payload, lnk_data.payload_len);
-        o->version = mp_obj_new_int(lnk_data.version);
-        o->ecc_level = mp_obj_new_int(lnk_data.ecc_level);
-        o->mask = mp_obj_new_int(lnk_data.mask);
-        o->data_type = mp_obj_new_int(lnk_data.data_type);
-        o->eci = mp_obj_new_int(lnk_data.eci);
+static mp_obj_t py_image_find_qrcodes(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    image_t *arg_img = py_helper_arg_to_image_mutable_bayer(args[0]);
 
-        objects_list->items[i] = o;
-        xfree(lnk_data.payload);
-    }
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+    arg_img = py_helper_image_unpack(arg_img, &roi, IMAGE_BPP_GRAYSCALE);
 
-    return objects_list;
+    bool locate = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_locate), true);
+    int max_codes = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_codes), 0);
+    PY_ASSERT_TRUE_MSG(max_codes >= 0, "Error: max_codes >= 0!");
+    bool lazy = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_lazy), false);
+
+    list_t out;
+    PY_NATIVE_BEGIN();
+    fb_alloc_mark();
+    imlib_find_qrcodes(&out, arg_img, &roi, locate, max_codes);
+    fb_alloc_free_till_mark();
+    PY_NATIVE_END();
+
+    return py_image_results_new(&out, py_qrcode_from_lnk, lazy);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_qrcodes_obj, 1, py_image_find_qrcodes);
 #endif // IMLIB_ENABLE_QRCODES
@@ -5626,38 +6256,13 @@ static const mp_obj_type_t py_apriltag_type = {
     .locals_dict = (mp_obj_t) &py_apriltag_locals_dict
 };
 
-static mp_obj_t py_image_find_apriltags(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+// The apriltag objects of the codes imlib_find_apriltags() puts in out, emptying it.
+static mp_obj_t py_image_apriltags_list(list_t *out)
 {
-    image_t *arg_img = py_helper_arg_to_image_mutable(args[0]);
-
-    rectangle_t roi;
-    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
-#ifndef IMLIB_ENABLE_HIGH_RES_APRILTAGS
-    PY_ASSERT_TRUE_MSG((roi.w * roi.h) < 65536, "The maximum supported resolution for find_apriltags() is < 64K pixels.");
-#endif
-    if ((roi.w < 4) || (roi.h < 4)) {
-        return mp_obj_new_list(0, NULL);
-    }
-
-    apriltag_families_t families = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_families), TAG36H11);
-    // 2.8mm Focal Length w/ OV7725 sensor for reference.
-    float fx = py_helper_keyword_float(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fx), (2.8 / 3.984) * arg_img->w);
-    // 2.8mm Focal Length w/ OV7725 sensor for reference.
-    float fy = py_helper_keyword_float(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fy), (2.8 / 2.952) * arg_img->h);
-    // Use the image versus the roi here since the image should be projected from the camera center.
-    float cx = py_helper_keyword_float(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cx), arg_img->w * 0.5);
-    // Use the image versus the roi here since the image should be projected from the camera center.
-    float cy = py_helper_keyword_float(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cy), arg_img->h * 0.5);
-
-    list_t out;
-    fb_alloc_mark();
-    imlib_find_apriltags(&out, arg_img, &roi, families, fx, fy, cx, cy);
-    fb_alloc_free_till_mark();
-
-    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
-    for (size_t i = 0; list_size(&out); i++) {
+    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(out), NULL);
+    for (size_t i = 0; list_size(out); i++) {
         find_apriltags_list_lnk_data_t lnk_data;
-        list_pop_front(&out, &lnk_data);
+        list_pop_front(out, &lnk_data);
 
         py_apriltag_obj_t *o = m_new_obj(py_apriltag_obj_t);
         o->base.type = &py_apriltag_type;
@@ -5690,6 +6295,49 @@ static mp_obj_t py_image_find_apriltags(uint n_args, const mp_obj_t *args, mp_ma
 
     return objects_list;
 }
+
+static mp_obj_t py_image_find_apriltags(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    image_t *arg_img = py_helper_arg_to_image_mutable_bayer(args[0]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+    arg_img = py_helper_image_unpack(arg_img, &roi, IMAGE_BPP_GRAYSCALE);
+
+    apriltag_families_t families = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_families), TAG36H11);
+    // 2.8mm Focal Length w/ OV7725 sensor for reference.
+    float fx = py_helper_keyword_float(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fx), (2.8 / 3.984) * arg_img->w);
+    // 2.8mm Focal Length w/ OV7725 sensor for reference.
+    float fy = py_helper_keyword_float(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fy), (2.8 / 2.952) * arg_img->h);
+    // Use the image versus the roi here since the image should be projected from the camera center.
+    float cx = py_helper_keyword_float(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cx), arg_img->w * 0.5);
+    // Use the image versus the roi here since the image should be projected from the camera center.
+    float cy = py_helper_keyword_float(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cy), arg_img->h * 0.5);
+    // Quads are found on an image decimated by this factor, tags are still decoded at full resolution.
+    int quad_decimate = py_helper_keyword_int(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_quad_decimate), 1);
+    PY_ASSERT_TRUE_MSG((1 <= quad_decimate) && (quad_decimate <= 4), "Error: 1 <= quad_decimate <= 4!");
+    bool refine_edges = py_helper_keyword_int(n_args, args, 8, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_refine_edges), true);
+    // When non-zero only search around the last tags found, with a full scan at least every track frames.
+    int track = py_helper_keyword_int(n_args, args, 9, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_track), 0);
+    PY_ASSERT_TRUE_MSG(track >= 0, "Error: track >= 0!");
+#ifndef IMLIB_ENABLE_HIGH_RES_APRILTAGS
+    // The limit is on the image quads are searched in.
+    PY_ASSERT_TRUE_MSG(((roi.w / quad_decimate) * (roi.h / quad_decimate)) < 65536,
+                       "The maximum supported resolution for find_apriltags() is < 64K pixels.");
+#endif
+    if (((roi.w / quad_decimate) < 4) || ((roi.h / quad_decimate) < 4)) {
+        return mp_obj_new_list(0, NULL);
+    }
+
+    list_t out;
+    PY_NATIVE_BEGIN();
+    fb_alloc_mark();
+    imlib_find_apriltags(&out, arg_img, &roi, families, fx, fy, cx, cy, quad_decimate, refine_edges, track);
+    fb_alloc_free_till_mark();
+    PY_NATIVE_END();
+
+    return py_image_apriltags_list(&out);
+}
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_apriltags_obj, 1, py_image_find_apriltags);
 #endif // IMLIB_ENABLE_APRILTAGS
 
@@ -5809,17 +6457,23 @@ static const mp_obj_type_t py_datamatrix_type = {
 
 static mp_obj_t py_image_find_datamatrices(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
 {
-    image_t *arg_img = py_helper_arg_to_image_mutable(args[0]);
+    image_t *arg_img = py_helper_arg_to_image_mutable_bayer(args[0]);
 
     rectangle_t roi;
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+    arg_img = py_helper_image_unpack(arg_img, &roi, IMAGE_BPP_GRAYSCALE);
 
     int effort = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_effort), 200);
+    bool locate = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_locate), true);
+    int timeout = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_timeout), 0);
+    PY_ASSERT_TRUE_MSG(timeout >= 0, "Error: timeout >= 0!");
 
     list_t out;
+    PY_NATIVE_BEGIN();
     fb_alloc_mark();
-    imlib_find_datamatrices(&out, arg_img, &roi, effort);
+    imlib_find_datamatrices(&out, arg_img, &roi, effort, locate, timeout);
     fb_alloc_free_till_mark();
+    PY_NATIVE_END();
 
     mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
     for (size_t i = 0; list_size(&out); i++) {
@@ -5957,22 +6611,13 @@ static const mp_obj_type_t py_barcode_type = {
     .locals_dict = (mp_obj_t) &py_barcode_locals_dict
 };
 
-static mp_obj_t py_image_find_barcodes(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+// The barcode objects of the codes imlib_find_barcodes() puts in out, emptying it.
+static mp_obj_t py_image_barcodes_list(list_t *out)
 {
-    image_t *arg_img = py_helper_arg_to_image_mutable(args[0]);
-
-    rectangle_t roi;
-    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
-
-    list_t out;
-    fb_alloc_mark();
-    imlib_find_barcodes(&out, arg_img, &roi);
-    fb_alloc_free_till_mark();
-
-    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
-    for (size_t i = 0; list_size(&out); i++) {
+    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(out), NULL);
+    for (size_t i = 0; list_size(out); i++) {
         find_barcodes_list_lnk_data_t lnk_data;
-        list_pop_front(&out, &lnk_data);
+        list_pop_front(out, &lnk_data);
 
         py_barcode_obj_t *o = m_new_obj(py_barcode_obj_t);
         o->base.type = &py_barcode_type;
@@ -5996,9 +6641,65 @@ static mp_obj_t py_image_find_barcodes(uint n_args, const mp_obj_t *args, mp_map
 
     return objects_list;
 }
+
+static mp_obj_t py_image_find_barcodes(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    image_t *arg_img = py_helper_arg_to_image_mutable_bayer(args[0]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+    arg_img = py_helper_image_unpack(arg_img, &roi, IMAGE_BPP_GRAYSCALE);
+
+    bool locate = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_locate), true);
+
+    list_t out;
+    PY_NATIVE_BEGIN();
+    fb_alloc_mark();
+    imlib_find_barcodes(&out, arg_img, &roi, locate);
+    fb_alloc_free_till_mark();
+    PY_NATIVE_END();
+
+    return py_image_barcodes_list(&out);
+}
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_barcodes_obj, 1, py_image_find_barcodes);
 #endif // IMLIB_ENABLE_BARCODES
 
+#if defined(IMLIB_ENABLE_QRCODES) && defined(IMLIB_ENABLE_APRILTAGS) && defined(IMLIB_ENABLE_BARCODES)
+// Returns the (qrcodes, apriltags, barcodes) lists, the kinds not searched for are empty.
+static mp_obj_t py_image_find_codes(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    image_t *arg_img = py_helper_arg_to_image_mutable_bayer(args[0]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+    arg_img = py_helper_image_unpack(arg_img, &roi, IMAGE_BPP_GRAYSCALE);
+
+    bool find_qrcodes = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_qrcodes), true);
+    bool find_apriltags = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_apriltags), true);
+    bool find_barcodes = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_barcodes), true);
+    apriltag_families_t families = py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_families), TAG36H11);
+    // The camera defaults of find_apriltags().
+    float fx = py_helper_keyword_float(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fx), (2.8 / 3.984) * arg_img->w);
+    float fy = py_helper_keyword_float(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fy), (2.8 / 2.952) * arg_img->h);
+    float cx = py_helper_keyword_float(n_args, args, 8, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cx), arg_img->w * 0.5);
+    float cy = py_helper_keyword_float(n_args, args, 9, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cy), arg_img->h * 0.5);
+
+    list_t qrcodes, apriltags, barcodes;
+    PY_NATIVE_BEGIN();
+    fb_alloc_mark();
+    imlib_find_codes(find_qrcodes ? &qrcodes : NULL, find_apriltags ? &apriltags : NULL, find_barcodes ? &barcodes : NULL,
+                     arg_img, &roi, families, fx, fy, cx, cy);
+    fb_alloc_free_till_mark();
+    PY_NATIVE_END();
+
+    return mp_obj_new_tuple(3, (mp_obj_t []) {
+        find_qrcodes ? py_image_qrcodes_list(&qrcodes) : mp_obj_new_list(0, NULL),
+        find_apriltags ? py_image_apriltags_list(&apriltags) : mp_obj_new_list(0, NULL),
+        find_barcodes ? py_image_barcodes_list(&barcodes) : mp_obj_new_list(0, NULL)});
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_codes_obj, 1, py_image_find_codes);
+#endif // IMLIB_ENABLE_QRCODES && IMLIB_ENABLE_APRILTAGS && IMLIB_ENABLE_BARCODES
+
 #ifdef IMLIB_ENABLE_FIND_DISPLACEMENT
 // Displacement Object //
 #define py_displacement_obj_size 5
@@ -6107,6 +6808,91 @@ static mp_obj_t py_image_find_displacement(uint n_args, const mp_obj_t *args, mp
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_displacement_obj, 2, py_image_find_displacement);
 #endif // IMLIB_ENABLE_FIND_DISPLACEMENT
 
+#ifdef IMLIB_ENABLE_TRACK_POINTS
+static mp_obj_t py_image_track_points(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    image_t *arg_img = py_helper_arg_to_image_mutable(args[0]);
+    image_t *arg_prev_img = py_helper_arg_to_image_mutable(args[1]);
+
+    PY_ASSERT_FALSE_MSG((arg_img->w != arg_prev_img->w) || (arg_img->h != arg_prev_img->h), "Image sizes do not match!");
+
+    mp_obj_t points_obj = py_helper_keyword_object(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_points));
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_prev_img, n_args, args, 3, kw_args, &roi);
+
+    int window =
+        py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_window), 15);
+    PY_ASSERT_TRUE_MSG(window >= 3, "Window must be >= 3!");
+    int levels =
+        py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_levels), 3);
+    PY_ASSERT_TRUE_MSG(levels >= 1, "Levels must be >= 1!");
+    int max_iterations =
+        py_helper_keyword_int(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_iterations), 10);
+    int threshold =
+        py_helper_keyword_int(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 20);
+    int max_points =
+        py_helper_keyword_int(n_args, args, 8, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_points), 50);
+    corner_detector_t corner_detector =
+        py_helper_keyword_int(n_args, args, 9, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_corner_detector), CORNER_FAST);
+
+    #ifndef IMLIB_ENABLE_FAST
+    // Force AGAST when FAST is disabled.
+    corner_detector = CORNER_AGAST;
+    #endif
+
+    list_t points;
+    fb_alloc_mark();
+
+    if (points_obj && (points_obj != mp_const_none)) {
+        size_t points_len;
+        mp_obj_t *points_array;
+        mp_obj_get_array(points_obj, &points_len, &points_array);
+        list_init(&points, sizeof(track_points_list_lnk_data_t));
+
+        for (size_t i = 0; i < points_len; i++) {
+            mp_obj_t *point;
+            mp_obj_get_array_fixed_n(points_array[i], 2, &point);
+
+            track_points_list_lnk_data_t lnk_data;
+            lnk_data.x0 = lnk_data.x1 = mp_obj_get_float(point[0]);
+            lnk_data.y0 = lnk_data.y1 = mp_obj_get_float(point[1]);
+            lnk_data.error = 0.0f;
+            lnk_data.found = false;
+            list_push_back(&points, &lnk_data);
+        }
+    } else {
+        // Start from the strongest corners of the previous image.
+        imlib_track_points_corners(&points, arg_prev_img, &roi, threshold, max_points, corner_detector);
+    }
+
+    imlib_track_points(&points, arg_img, arg_prev_img, window, levels, max_iterations);
+    fb_alloc_free_till_mark();
+
+    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&points), NULL);
+    for (size_t i = 0; list_size(&points); i++) {
+        track_points_list_lnk_data_t lnk_data;
+        list_pop_front(&points, &lnk_data);
+
+        if (lnk_data.found) {
+            mp_obj_t tuple[5] = {
+                mp_obj_new_float(lnk_data.x0),
+                mp_obj_new_float(lnk_data.y0),
+                mp_obj_new_float(lnk_data.x1),
+                mp_obj_new_float(lnk_data.y1),
+                mp_obj_new_float(lnk_data.error)
+            };
+            objects_list->items[i] = mp_obj_new_tuple(5, tuple);
+        } else {
+            objects_list->items[i] = mp_const_none;
+        }
+    }
+
+    return objects_list;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_track_points_obj, 2, py_image_track_points);
+#endif // IMLIB_ENABLE_TRACK_POINTS
+
 #ifdef IMLIB_FIND_TEMPLATE
 static mp_obj_t py_image_find_template(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
 {
@@ -6168,9 +6954,12 @@ static mp_obj_t py_image_find_features(uint n_args, const mp_obj_t *args, mp_map
             "Region of interest is smaller than detector window!");
 
     // Detect objects
+    array_t *objects_array;
+    PY_NATIVE_BEGIN();
     fb_alloc_mark();
-    array_t *objects_array = imlib_detect_objects(arg_img, cascade, &roi);
+    objects_array = imlib_detect_objects(arg_img, cascade, &roi);
     fb_alloc_free_till_mark();
+    PY_NATIVE_END();
 
     // Add detected objects to a new Python list...
     mp_obj_t objects_list = mp_obj_new_list(0, NULL);
@@ -6534,6 +7323,11 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_cartoon),             MP_ROM_PTR(&py_image_cartoon_obj)},
 #else
     {MP_ROM_QSTR(MP_QSTR_cartoon),             MP_ROM_PTR(&py_func_unavailable_obj)},
+#endif
+#ifdef IMLIB_ENABLE_PIPELINE
+    {MP_ROM_QSTR(MP_QSTR_pipeline),            MP_ROM_PTR(&py_image_pipeline_obj)},
+#else
+    {MP_ROM_QSTR(MP_QSTR_pipeline),            MP_ROM_PTR(&py_func_unavailable_obj)},
 #endif
     /* Shadow Removal Methods */
 #ifdef IMLIB_ENABLE_REMOVE_SHADOWS
@@ -6580,6 +7374,7 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_get_stats),           MP_ROM_PTR(&py_image_get_statistics_obj)},
     {MP_ROM_QSTR(MP_QSTR_get_statistics),      MP_ROM_PTR(&py_image_get_statistics_obj)},
     {MP_ROM_QSTR(MP_QSTR_statistics),          MP_ROM_PTR(&py_image_get_statistics_obj)},
+    {MP_ROM_QSTR(MP_QSTR_get_statistics_rois), MP_ROM_PTR(&py_image_get_statistics_rois_obj)},
     {MP_ROM_QSTR(MP_QSTR_get_regression),      MP_ROM_PTR(&py_image_get_regression_obj)},
     /* Find Methods */
     {MP_ROM_QSTR(MP_QSTR_find_blobs),          MP_ROM_PTR(&py_image_find_blobs_obj)},
@@ -6623,11 +7418,21 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
 #else
     {MP_ROM_QSTR(MP_QSTR_find_barcodes),       MP_ROM_PTR(&py_func_unavailable_obj)},
 #endif
+#if defined(IMLIB_ENABLE_QRCODES) && defined(IMLIB_ENABLE_APRILTAGS) && defined(IMLIB_ENABLE_BARCODES)
+    {MP_ROM_QSTR(MP_QSTR_find_codes),          MP_ROM_PTR(&py_image_find_codes_obj)},
+#else
+    {MP_ROM_QSTR(MP_QSTR_find_codes),          MP_ROM_PTR(&py_func_unavailable_obj)},
+#endif
 #ifdef IMLIB_ENABLE_FIND_DISPLACEMENT
     {MP_ROM_QSTR(MP_QSTR_find_displacement),   MP_ROM_PTR(&py_image_find_displacement_obj)},
 #else
     {MP_ROM_QSTR(MP_QSTR_find_displacement),   MP_ROM_PTR(&py_func_unavailable_obj)},
 #endif
+#ifdef IMLIB_ENABLE_TRACK_POINTS
+    {MP_ROM_QSTR(MP_QSTR_track_points),        MP_ROM_PTR(&py_image_track_points_obj)},
+#else
+    {MP_ROM_QSTR(MP_QSTR_track_points),        MP_ROM_PTR(&py_func_unavailable_obj)},
+#endif
 #ifdef IMLIB_FIND_TEMPLATE
     {MP_ROM_QSTR(MP_QSTR_find_template),       MP_ROM_PTR(&py_image_find_template_obj)},
 #else
@@ -6792,6 +7597,7 @@ mp_obj_t py_imagereader_next_frame(uint n_args, const mp_obj_t *args, mp_map_t *
 
     if (copy_to_fb) {
         fb_update_jpeg_buffer();
+        imlib_pyramid_invalidate(MAIN_FB()->pixels);
     }
 
     FIL *fp = &((py_imagereader_obj_t *) args[0])->fp;
@@ -6904,6 +7710,144 @@ mp_obj_t py_image_imagereader(mp_obj_t path)
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_image_imagereader_obj, py_image_imagereader);
 
+#ifdef IMLIB_ENABLE_TRACKER
+// Tracker Object //
+typedef struct py_tracker_obj {
+    mp_obj_base_t base;
+    tracker_t tracker;
+} py_tracker_obj_t;
+
+static void py_tracker_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
+{
+    py_tracker_obj_t *self = self_in;
+    mp_printf(print, "{\"tracks\":%d, \"max_age\":%d, \"min_hits\":%d}",
+              self->tracker.count, self->tracker.max_age, self->tracker.min_hits);
+}
+
+// Blobs and rects are read as they are, anything else as an (x, y, w, h) sequence.
+static void py_tracker_get_rect(mp_obj_t obj, rectangle_t *r)
+{
+    mp_obj_t x, y, w, h;
+    if (MP_OBJ_IS_TYPE(obj, &py_blob_type)) {
+        py_blob_obj_t *blob = obj;
+        x = blob->x, y = blob->y, w = blob->w, h = blob->h;
+    #ifdef IMLIB_ENABLE_FIND_RECTS
+    } else if (MP_OBJ_IS_TYPE(obj, &py_rect_type)) {
+        py_rect_obj_t *rect = obj;
+        x = rect->x, y = rect->y, w = rect->w, h = rect->h;
+    #endif
+    } else {
+        x = mp_obj_subscr(obj, MP_OBJ_NEW_SMALL_INT(0), MP_OBJ_SENTINEL);
+        y = mp_obj_subscr(obj, MP_OBJ_NEW_SMALL_INT(1), MP_OBJ_SENTINEL);
+        w = mp_obj_subscr(obj, MP_OBJ_NEW_SMALL_INT(2), MP_OBJ_SENTINEL);
+        h = mp_obj_subscr(obj, MP_OBJ_NEW_SMALL_INT(3), MP_OBJ_SENTINEL);
+    }
+    r->x = mp_obj_get_int(x);
+    r->y = mp_obj_get_int(y);
+    r->w = mp_obj_get_int(w);
+    r->h = mp_obj_get_int(h);
+    PY_ASSERT_TRUE_MSG((r->w > 0) && (r->h > 0), "Detection width and height must be > 0!");
+}
+
+mp_obj_t py_tracker_update(mp_obj_t self_in, mp_obj_t detections_obj)
+{
+    py_tracker_obj_t *self = self_in;
+    size_t detections_len;
+    mp_obj_t *detections_array;
+    mp_obj_get_array(detections_obj, &detections_len, &detections_array);
+
+    list_t detections;
+    list_init(&detections, sizeof(rectangle_t));
+    fb_alloc_mark();
+
+    for (size_t i = 0; i < detections_len; i++) {
+        rectangle_t r;
+        py_tracker_get_rect(detections_array[i], &r);
+        list_push_back(&detections, &r);
+    }
+
+    int *ids = fb_alloc(IM_MAX(detections_len, 1) * sizeof(int), FB_ALLOC_NO_HINT);
+    imlib_tracker_update(&self->tracker, &detections, 0, ids);
+    list_free(&detections);
+
+    mp_obj_list_t *objects_list = mp_obj_new_list(detections_len, NULL);
+    for (size_t i = 0; i < detections_len; i++) {
+        objects_list->items[i] = (ids[i] < 0) ? mp_const_none : mp_obj_new_int(ids[i]);
+    }
+
+    fb_alloc_free_till_mark();
+    return objects_list;
+}
+
+mp_obj_t py_tracker_tracks(mp_obj_t self_in)
+{
+    tracker_t *tracker = &((py_tracker_obj_t *) self_in)->tracker;
+    mp_obj_t objects_list = mp_obj_new_list(0, NULL);
+
+    for (int i = 0; i < tracker->count; i++) {
+        tracker_track_t *track = tracker->tracks + i;
+        if (track->id) {
+            mp_obj_t tuple[6] = {
+                mp_obj_new_int(track->id),
+                mp_obj_new_int(track->rect.x),
+                mp_obj_new_int(track->rect.y),
+                mp_obj_new_int(track->rect.w),
+                mp_obj_new_int(track->rect.h),
+                mp_obj_new_int(track->misses)
+            };
+            mp_obj_list_append(objects_list, mp_obj_new_tuple(6, tuple));
+        }
+    }
+
+    return objects_list;
+}
+
+mp_obj_t py_tracker_reset(mp_obj_t self_in)
+{
+    tracker_t *tracker = &((py_tracker_obj_t *) self_in)->tracker;
+    tracker->count = 0;
+    return mp_const_none;
+}
+
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(py_tracker_update_obj, py_tracker_update);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_tracker_tracks_obj, py_tracker_tracks);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_tracker_reset_obj, py_tracker_reset);
+
+STATIC const mp_rom_map_elem_t py_tracker_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&py_tracker_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_tracks), MP_ROM_PTR(&py_tracker_tracks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&py_tracker_reset_obj) }
+};
+
+STATIC MP_DEFINE_CONST_DICT(py_tracker_locals_dict, py_tracker_locals_dict_table);
+
+static const mp_obj_type_t py_tracker_type = {
+    { &mp_type_type },
+    .name  = MP_QSTR_tracker,
+    .print = py_tracker_print,
+    .locals_dict = (mp_obj_t) &py_tracker_locals_dict
+};
+
+mp_obj_t py_image_tracker(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    int max_age =
+        py_helper_keyword_int(n_args, args, 0, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_age), 3);
+    PY_ASSERT_TRUE_MSG(max_age >= 0, "max_age must be >= 0!");
+    int min_hits =
+        py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_min_hits), 3);
+    PY_ASSERT_TRUE_MSG(min_hits >= 1, "min_hits must be >= 1!");
+    float iou_threshold =
+        py_helper_keyword_float(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_iou_threshold), 0.3f);
+    PY_ASSERT_TRUE_MSG((0.0f <= iou_threshold) && (iou_threshold <= 1.0f), "0 <= iou_threshold <= 1!");
+
+    py_tracker_obj_t *obj = m_new_obj(py_tracker_obj_t);
+    obj->base.type = &py_tracker_type;
+    imlib_tracker_init(&obj->tracker, max_age, min_hits, iou_threshold);
+    return obj;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_tracker_obj, 0, py_image_tracker);
+#endif // IMLIB_ENABLE_TRACKER
+
 mp_obj_t py_image_binary_to_grayscale(mp_obj_t arg)
 {
     int8_t b = mp_obj_get_int(arg) & 1;
@@ -7177,6 +8121,92 @@ mp_obj_t py_image_from_struct(image_t *img)
     return o;
 }
 
+// Integer fields image.as_array() copies out of each result, in subscr order (float ones are rounded).
+typedef struct py_result_fields {
+    const mp_obj_type_t *type;
+    uint8_t len;
+    uint8_t field[10];
+} py_result_fields_t;
+
+#define RESULT_FIELD(t, f)  (offsetof(t, f) / sizeof(mp_obj_t))
+
+static const py_result_fields_t py_result_fields[] = {
+    {&py_line_type, 8, {RESULT_FIELD(py_line_obj_t, x1), RESULT_FIELD(py_line_obj_t, y1),
+                        RESULT_FIELD(py_line_obj_t, x2), RESULT_FIELD(py_line_obj_t, y2),
+                        RESULT_FIELD(py_line_obj_t, length), RESULT_FIELD(py_line_obj_t, magnitude),
+                        RESULT_FIELD(py_line_obj_t, theta), RESULT_FIELD(py_line_obj_t, rho)}},
+    {&py_blob_type, 10, {RESULT_FIELD(py_blob_obj_t, x), RESULT_FIELD(py_blob_obj_t, y),
+                         RESULT_FIELD(py_blob_obj_t, w), RESULT_FIELD(py_blob_obj_t, h),
+                         RESULT_FIELD(py_blob_obj_t, pixels), RESULT_FIELD(py_blob_obj_t, cx),
+                         RESULT_FIELD(py_blob_obj_t, cy), RESULT_FIELD(py_blob_obj_t, code),
+                         RESULT_FIELD(py_blob_obj_t, count), RESULT_FIELD(py_blob_obj_t, perimeter)}},
+#ifdef IMLIB_ENABLE_FIND_CIRCLES
+    {&py_circle_type, 4, {RESULT_FIELD(py_circle_obj_t, x), RESULT_FIELD(py_circle_obj_t, y),
+                          RESULT_FIELD(py_circle_obj_t, r), RESULT_FIELD(py_circle_obj_t, magnitude)}},
+#endif
+#ifdef IMLIB_ENABLE_FIND_RECTS
+    {&py_rect_type, 5, {RESULT_FIELD(py_rect_obj_t, x), RESULT_FIELD(py_rect_obj_t, y),
+                        RESULT_FIELD(py_rect_obj_t, w), RESULT_FIELD(py_rect_obj_t, h),
+                        RESULT_FIELD(py_rect_obj_t, magnitude)}},
+#endif
+#ifdef IMLIB_ENABLE_APRILTAGS
+    {&py_apriltag_type, 9, {RESULT_FIELD(py_apriltag_obj_t, x), RESULT_FIELD(py_apriltag_obj_t, y),
+                            RESULT_FIELD(py_apriltag_obj_t, w), RESULT_FIELD(py_apriltag_obj_t, h),
+                            RESULT_FIELD(py_apriltag_obj_t, id), RESULT_FIELD(py_apriltag_obj_t, family),
+                            RESULT_FIELD(py_apriltag_obj_t, cx), RESULT_FIELD(py_apriltag_obj_t, cy),
+                            RESULT_FIELD(py_apriltag_obj_t, hamming)}},
+#endif
+};
+
+// Flattens a list of results of one type into array('i'), len(fields) ints per result, so scripts
+// can walk hundreds of blobs per frame with plain indexing instead of a method call per field.
+// The array passed as out is reused when it has room.
+mp_obj_t py_image_as_array(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    size_t len;
+    mp_obj_t *items;
+    mp_obj_get_array(args[0], &len, &items);
+    mp_obj_t out = py_helper_keyword_object(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_out));
+
+    const py_result_fields_t *fields = NULL;
+    if (len) {
+        const mp_obj_type_t *type = mp_obj_get_type(items[0]);
+        for (int i = 0; i < MP_ARRAY_SIZE(py_result_fields); i++) {
+            if (py_result_fields[i].type == type) {
+                fields = &py_result_fields[i];
+            }
+        }
+        PY_ASSERT_TRUE_MSG(fields, "Unsupported result type!");
+    }
+
+    size_t n = fields ? (len * fields->len) : 0;
+    mp_obj_array_t *array = out;
+    if (out && MP_OBJ_IS_TYPE(out, &mp_type_array) && (array->typecode == 'i') && ((array->len + array->free) >= n)) {
+        array->free += array->len - n;
+        array->len = n;
+    } else {
+        array = m_new_obj(mp_obj_array_t);
+        array->base.type = &mp_type_array;
+        array->typecode = 'i';
+        array->free = 0;
+        array->len = n;
+        array->items = m_new(int32_t, n);
+    }
+
+    int32_t *data = array->items;
+    for (size_t i = 0; i < len; i++) {
+        PY_ASSERT_TRUE_MSG(mp_obj_get_type(items[i]) == fields->type, "Results must all be the same type!");
+        const mp_obj_t *obj = MP_OBJ_TO_PTR(items[i]);
+        for (int j = 0; j < fields->len; j++) {
+            mp_obj_t value = obj[fields->field[j]];
+            *data++ = mp_obj_is_float(value) ? fast_roundf(mp_obj_get_float(value)) : mp_obj_get_int(value);
+        }
+    }
+
+    return MP_OBJ_FROM_PTR(array);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_as_array_obj, 1, py_image_as_array);
+
 mp_obj_t py_image_load_image(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
 {
     // mode == false -> load behavior
@@ -7198,6 +8228,7 @@ mp_obj_t py_image_load_image(uint n_args, const mp_obj_t *args, mp_map_t *kw_arg
 
     if (copy_to_fb) {
         fb_update_jpeg_buffer();
+        imlib_pyramid_invalidate(MAIN_FB()->pixels);
 }
 
     image_t image = {0};
@@ -7494,6 +8525,104 @@ static mp_obj_t py_image_match_descriptor(uint n_args, const mp_obj_t *args, mp_
     return match_obj;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_match_descriptor_obj, 2, py_image_match_descriptor);
+
+#ifdef IMLIB_ENABLE_FIND_KEYPOINTS
+static void py_image_db_raise(int res)
+{
+    if (res == ORB_DB_INVALID) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "Not a descriptor database"));
+    } else if (res == ORB_DB_FULL) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "Descriptor database is full"));
+    } else if (res != FR_OK) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, ffs_strerror(res)));
+    }
+}
+
+// Appends the keypoints of an object to a database file, the file is created with room for
+// capacity objects.
+mp_obj_t py_image_append_db(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    FIL fp;
+    int res;
+
+    py_kp_obj_t *kpts = py_kpts_obj(args[0]);
+    const char *path = mp_obj_str_get_str(args[1]);
+    uint32_t id = mp_obj_get_int(args[2]);
+    int capacity = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_capacity), 256);
+    PY_ASSERT_TRUE_MSG((capacity > 0) && (capacity <= UINT16_MAX), "Expected capacity between 1 and 65535");
+
+    if ((res = f_open_helper(&fp, path, FA_READ|FA_WRITE|FA_OPEN_ALWAYS)) == FR_OK) {
+        res = orb_db_append(&fp, kpts->kpts, id, capacity);
+        f_close(&fp);
+    }
+
+    py_image_db_raise(res);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_append_db_obj, 3, py_image_append_db);
+
+// Reads every object of a database file into the heap, matching then needs no file access.
+mp_obj_t py_image_load_db(mp_obj_t path_obj)
+{
+    FIL fp;
+    int res;
+
+    py_kp_db_obj_t *o = m_new_obj(py_kp_db_obj_t);
+    o->base.type = &py_kp_db_type;
+
+    if ((res = f_open_helper(&fp, mp_obj_str_get_str(path_obj), FA_READ|FA_OPEN_EXISTING)) == FR_OK) {
+        res = orb_db_load(&fp, &o->db);
+        f_close(&fp);
+    }
+
+    py_image_db_raise(res);
+    return o;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_image_load_db_obj, py_image_load_db);
+
+// The (id, votes) of the count objects of the database most keypoints vote for, best first.
+static mp_obj_t py_image_match_db(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    PY_ASSERT_TYPE(args[0], &py_kp_db_type);
+    py_kp_db_obj_t *db = args[0];
+    py_kp_obj_t *kpts = py_kpts_obj(args[1]);
+    int threshold = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 85);
+    int count = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_count), 3);
+    PY_ASSERT_TRUE_MSG((threshold >=0 && threshold <= 100), "Expected threshold between 0 and 100");
+    PY_ASSERT_TRUE_MSG(count > 0, "Expected count > 0");
+
+    mp_obj_t match_list = mp_obj_new_list(0, NULL);
+
+    if (db->db.count && array_length(kpts->kpts)) {
+        fb_alloc_mark();
+        int *votes = fb_alloc(db->db.count * sizeof(int), FB_ALLOC_NO_HINT);
+        orb_db_match(&db->db, kpts->kpts, threshold, votes);
+
+        // Selection of the best count objects, ties go to the object stored first.
+        for (int n=0; n<count; n++) {
+            int best = -1;
+            for (int i=0; i<db->db.count; i++) {
+                if (votes[i] && ((best < 0) || (votes[i] > votes[best]))) {
+                    best = i;
+                }
+            }
+
+            if (best < 0) {
+                break;
+            }
+
+            mp_obj_list_append(match_list, mp_obj_new_tuple(2, (mp_obj_t []) {
+                mp_obj_new_int_from_uint(db->db.ids[best]), mp_obj_new_int(votes[best])}));
+            votes[best] = 0;
+        }
+
+        fb_alloc_free_till_mark();
+    }
+
+    return match_list;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_image_match_db_obj, 2, py_image_match_db);
+#endif // IMLIB_ENABLE_FIND_KEYPOINTS
 #endif // IMLIB_ENABLE_DESCRIPTOR
 
 int py_image_descriptor_from_roi(image_t *img, const char *path, rectangle_t *roi)
@@ -7528,6 +8657,7 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_EDGE_SIMPLE),         MP_ROM_INT(EDGE_SIMPLE)},
     {MP_ROM_QSTR(MP_QSTR_CORNER_FAST),         MP_ROM_INT(CORNER_FAST)},
     {MP_ROM_QSTR(MP_QSTR_CORNER_AGAST),        MP_ROM_INT(CORNER_AGAST)},
+    {MP_ROM_QSTR(MP_QSTR_BILINEAR),            MP_ROM_INT(IMAGE_HINT_BILINEAR)},
 #ifdef IMLIB_ENABLE_APRILTAGS
     {MP_ROM_QSTR(MP_QSTR_TAG16H5),             MP_ROM_INT(TAG16H5)},
     {MP_ROM_QSTR(MP_QSTR_TAG25H7),             MP_ROM_INT(TAG25H7)},
@@ -7556,6 +8686,9 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
 #endif
     {MP_ROM_QSTR(MP_QSTR_ImageWriter),         MP_ROM_PTR(&py_image_imagewriter_obj)},
     {MP_ROM_QSTR(MP_QSTR_ImageReader),         MP_ROM_PTR(&py_image_imagereader_obj)},
+#ifdef IMLIB_ENABLE_TRACKER
+    {MP_ROM_QSTR(MP_QSTR_Tracker),             MP_ROM_PTR(&py_image_tracker_obj)},
+#endif
     {MP_ROM_QSTR(MP_QSTR_binary_to_grayscale), MP_ROM_PTR(&py_image_binary_to_grayscale_obj)},
     {MP_ROM_QSTR(MP_QSTR_binary_to_rgb),       MP_ROM_PTR(&py_image_binary_to_rgb_obj)},
     {MP_ROM_QSTR(MP_QSTR_binary_to_lab),       MP_ROM_PTR(&py_image_binary_to_lab_obj)},
@@ -7578,14 +8711,24 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_yuv_to_lab),          MP_ROM_PTR(&py_image_yuv_to_lab_obj)},
     {MP_ROM_QSTR(MP_QSTR_Image),               MP_ROM_PTR(&py_image_load_image_obj)},
     {MP_ROM_QSTR(MP_QSTR_HaarCascade),         MP_ROM_PTR(&py_image_load_cascade_obj)},
+    {MP_ROM_QSTR(MP_QSTR_as_array),            MP_ROM_PTR(&py_image_as_array_obj)},
 #ifdef IMLIB_ENABLE_DESCRIPTOR
     {MP_ROM_QSTR(MP_QSTR_load_descriptor),     MP_ROM_PTR(&py_image_load_descriptor_obj)},
     {MP_ROM_QSTR(MP_QSTR_save_descriptor),     MP_ROM_PTR(&py_image_save_descriptor_obj)},
-    {MP_ROM_QSTR(MP_QSTR_match_descriptor),    MP_ROM_PTR(&py_image_match_descriptor_obj)}
+    {MP_ROM_QSTR(MP_QSTR_match_descriptor),    MP_ROM_PTR(&py_image_match_descriptor_obj)},
 #else
     {MP_ROM_QSTR(MP_QSTR_load_descriptor),     MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_save_descriptor),     MP_ROM_PTR(&py_func_unavailable_obj)},
-    {MP_ROM_QSTR(MP_QSTR_match_descriptor),    MP_ROM_PTR(&py_func_unavailable_obj)}
+    {MP_ROM_QSTR(MP_QSTR_match_descriptor),    MP_ROM_PTR(&py_func_unavailable_obj)},
+#endif
+#if defined(IMLIB_ENABLE_DESCRIPTOR) && defined(IMLIB_ENABLE_FIND_KEYPOINTS)
+    {MP_ROM_QSTR(MP_QSTR_append_db),           MP_ROM_PTR(&py_image_append_db_obj)},
+    {MP_ROM_QSTR(MP_QSTR_load_db),             MP_ROM_PTR(&py_image_load_db_obj)},
+    {MP_ROM_QSTR(MP_QSTR_match_db),            MP_ROM_PTR(&py_image_match_db_obj)},
+#else
+    {MP_ROM_QSTR(MP_QSTR_append_db),           MP_ROM_PTR(&py_func_unavailable_obj)},
+    {MP_ROM_QSTR(MP_QSTR_load_db),             MP_ROM_PTR(&py_func_unavailable_obj)},
+    {MP_ROM_QSTR(MP_QSTR_match_db),            MP_ROM_PTR(&py_func_unavailable_obj)},
 #endif
 };
 STATIC MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
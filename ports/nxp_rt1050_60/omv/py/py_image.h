@@ -10,8 +10,14 @@
 #define __PY_IMAGE_H__
 // DISABLED #include <mp.h>
 #include "imlib.h"
+#include "task.h"
 mp_obj_t py_image(int width, int height, int bpp, void *pixels);
 mp_obj_t py_image_from_struct(image_t *img);
 void *py_image_cobj(mp_obj_t img_obj);
+// The pixels of an image for framebuf.FrameBuffer(img), see MICROPY_PY_FRAMEBUF_VIEW.
+int py_image_framebuf_view(mp_obj_t obj, void **buf, int *w, int *h);
+// Queues meth (an image method, args[0] is the image) as a background task, see task.h. NULL if
+// meth can't be run in the background.
+task_t *py_image_submit(mp_obj_t meth, size_t n_args, const mp_obj_t *args, mp_map_t *kw_args);
 int py_image_descriptor_from_roi(image_t *img, const char *path, rectangle_t *roi);
 #endif // __PY_IMAGE_H__
@@ -5,6 +5,11 @@
  *
  * LCD Python module.
  *
+ * lcd.display() sends only what changed: the panel is cut into tiles whose pixels are hashed
+ * every frame, and the window of the tiles that changed is packed into one of two frames and
+ * queued on the SPI DMA behind the panel's window commands. The call returns while the frame
+ * goes out and the next one is drawn into the other frame.
+ *
  */
 #include <mp.h>
 #include <objstr.h>
@@ -17,6 +22,7 @@
 #include "py_assert.h"
 #include "py_helper.h"
 #include "py_image.h"
+#include "xalloc.h"
 
 extern const pin_obj_t pin_EMC_19;
 #define RST_PINOBJ			pin_EMC_19
@@ -52,6 +58,40 @@ static int height = 0;
 static enum { LCD_NONE, LCD_SHIELD } type = LCD_NONE;
 static bool s_backlight_init = false;
 
+// A panel: its size and its commands to set the window the memory write that follows fills,
+// the column and the row set take the first and the last address as 16 bit big endian.
+typedef struct {
+    int w, h;
+    uint8_t caset, raset, ramwr;
+} lcd_panel_t;
+
+static const lcd_panel_t lcd_panels[] = {
+    [LCD_SHIELD] = { 128, 160, 0x2A, 0x2B, 0x2C }, // ST7735R
+};
+
+#define LCD_TILE_W      (16)
+#define LCD_TILE_H      (8)
+#define LCD_MAX_TILES   ((128 / LCD_TILE_W) * (160 / LCD_TILE_H))
+
+// Hashes of the tiles last sent and the image part they were sent from, the whole panel is
+// sent when those change or after lcd.init() and lcd.clear().
+static uint32_t lcd_tile_hash[LCD_MAX_TILES];
+static bool lcd_tiles_valid;
+static rectangle_t lcd_last_rect;
+static bool lcd_last_gs;
+
+// A frame: what its DMA transfers send, the commands, the window and its pixels packed.
+typedef struct {
+    uint8_t cmd[3];
+    uint8_t caset[4], raset[4];
+    uint8_t pixels[] __attribute__((aligned(4)));
+} lcd_frame_t;
+
+static uint32_t lcd_frame_size;
+static int lcd_frame_slot;
+// Transfers the last frame queued.
+static uint32_t lcd_last_xfers;
+
 __WEAK void* fb_alloc0(uint32_t size, int hints) {
 	return m_malloc0(size);
 }
@@ -138,12 +178,156 @@ static void lcd_write_data(uint32_t len, uint8_t *dat)
     CS_PIN_WRITE(true);
 }
 
+#define LCD_SPI_NDX (((pyb_spi_obj_t *) s_spiPort)->ndx)
+
+// Queues 8-bit data or commands on the SPI DMA, dat must stay valid until lcd_wait().
+// Returns the number of transfers queued.
+static uint32_t lcd_queue(uint32_t len, const uint8_t *dat, bool data)
+{
+    uint32_t xfers = 0;
+    while (len) {
+        spi_dma_desc_t desc = {
+            .tx = dat,
+            .len = (len < SPI_DMA_MAX_LEN) ? len : SPI_DMA_MAX_LEN,
+            .cs = &CS_PINOBJ,
+            .dc = &RS_PINOBJ,
+            .flags = SPI_DMA_CS_ASSERT | SPI_DMA_CS_RELEASE | (data ? SPI_DMA_DC_HIGH : 0),
+        };
+        while (!spi_dma_queue(LCD_SPI_NDX, &desc)) {
+            spi_dma_wait(LCD_SPI_NDX, SPI_DMA_QUEUE_LEN - 1);
+        }
+        dat += desc.len;
+        len -= desc.len;
+        xfers++;
+    }
+    return xfers;
+}
+
+static void lcd_queue_data(uint32_t len, const uint8_t *dat)
+{
+    lcd_queue(len, dat, true);
+}
+
+static void lcd_wait(void)
+{
+    spi_dma_wait(LCD_SPI_NDX, 0);
+    lcd_last_xfers = 0;
+}
+
+// Sets the window the next memory write fills, blocking.
+static void lcd_set_window(const lcd_panel_t *panel, int x, int y, int w, int h)
+{
+    int x1 = x + w - 1, y1 = y + h - 1;
+    lcd_write_command(panel->caset, 4, (uint8_t []) {x >> 8, x, x1 >> 8, x1});
+    lcd_write_command(panel->raset, 4, (uint8_t []) {y >> 8, y, y1 >> 8, y1});
+}
+
+// Hashes the tiles of the panel and leaves in win those that changed since the last frame,
+// all of them when the image part shown moved or changed format. Pixels off the image are
+// the black padding around it and never change. Returns false if nothing changed.
+static bool lcd_dirty(image_t *img, rectangle_t *rect, int l_pad, int t_pad, rectangle_t *win)
+{
+    bool gs = IM_IS_GS(img);
+    int bpp = gs ? 1 : 2;
+    bool full = (!lcd_tiles_valid) || (gs != lcd_last_gs) || memcmp(rect, &lcd_last_rect, sizeof(rectangle_t));
+    int tiles_w = (s_width + LCD_TILE_W - 1) / LCD_TILE_W;
+    int tiles_h = (height + LCD_TILE_H - 1) / LCD_TILE_H;
+    int tx0 = tiles_w, ty0 = tiles_h, tx1 = -1, ty1 = -1;
+
+    for (int ty = 0; ty < tiles_h; ty++) {
+        int y0 = IM_MAX(ty * LCD_TILE_H, t_pad), y1 = IM_MIN((ty + 1) * LCD_TILE_H, t_pad + rect->h);
+        for (int tx = 0; tx < tiles_w; tx++) {
+            int x0 = IM_MAX(tx * LCD_TILE_W, l_pad), x1 = IM_MIN((tx + 1) * LCD_TILE_W, l_pad + rect->w);
+            uint32_t hash = 2166136261u; // FNV-1a
+            for (int y = y0; y < y1; y++) {
+                const uint8_t *p = img->pixels
+                    + ((((rect->y + y - t_pad) * img->w) + rect->x + x0 - l_pad) * bpp);
+                for (int i = 0, n = (x1 - x0) * bpp; i < n; i++) {
+                    hash = (hash ^ p[i]) * 16777619u;
+                }
+            }
+            uint32_t *tile_hash = &lcd_tile_hash[(ty * tiles_w) + tx];
+            if (full || (*tile_hash != hash)) {
+                *tile_hash = hash;
+                tx0 = IM_MIN(tx0, tx);
+                ty0 = IM_MIN(ty0, ty);
+                tx1 = IM_MAX(tx1, tx);
+                ty1 = IM_MAX(ty1, ty);
+            }
+        }
+    }
+
+    lcd_tiles_valid = true;
+    lcd_last_rect = *rect;
+    lcd_last_gs = gs;
+    if (tx1 < 0) {
+        return false;
+    }
+    win->x = tx0 * LCD_TILE_W;
+    win->y = ty0 * LCD_TILE_H;
+    win->w = IM_MIN((tx1 + 1) * LCD_TILE_W, s_width) - win->x;
+    win->h = IM_MIN((ty1 + 1) * LCD_TILE_H, height) - win->y;
+    return true;
+}
+
+// The frame not sent last, once the transfers before the last frame are done.
+static lcd_frame_t *lcd_next_frame(void)
+{
+    spi_dma_wait(LCD_SPI_NDX, lcd_last_xfers);
+    lcd_frame_slot ^= 1;
+    return (lcd_frame_t *) (((uint8_t *) MP_STATE_PORT(lcd_frames)) + (lcd_frame_slot * lcd_frame_size));
+}
+
+// Packs the pixels of win into the frame, RGB565 big endian as imlib has it and the panel
+// takes it.
+static void lcd_pack(lcd_frame_t *frame, image_t *img, rectangle_t *rect, int l_pad, int t_pad, rectangle_t *win)
+{
+    uint16_t *dst = (uint16_t *) frame->pixels;
+    int x0 = IM_MAX(win->x, l_pad), x1 = IM_MIN(win->x + win->w, l_pad + rect->w);
+
+    for (int y = win->y; y < (win->y + win->h); y++, dst += win->w) {
+        if ((y < t_pad) || (y >= (t_pad + rect->h)) || (x0 >= x1)) {
+            memset(dst, 0, win->w * 2);
+            continue;
+        }
+        memset(dst, 0, (x0 - win->x) * 2);
+        memset(dst + (x1 - win->x), 0, (win->x + win->w - x1) * 2);
+        uint16_t *d = dst + (x0 - win->x);
+        int sx = rect->x + x0 - l_pad, sy = rect->y + y - t_pad;
+        if (IM_IS_GS(img)) {
+            for (int j = 0; j < (x1 - x0); j++) {
+                uint8_t pixel = IM_GET_GS_PIXEL(img, sx + j, sy);
+                d[j] = IM_RGB565(IM_R825(pixel), IM_G826(pixel), IM_B825(pixel));
+            }
+        } else {
+            memcpy(d, ((uint16_t *) img->pixels) + (sy * img->w) + sx, (x1 - x0) * 2);
+        }
+    }
+}
+
+// Queues the window commands and the pixels of the frame, returns the transfers queued.
+static uint32_t lcd_queue_frame(const lcd_panel_t *panel, lcd_frame_t *frame, rectangle_t *win)
+{
+    int x1 = win->x + win->w - 1, y1 = win->y + win->h - 1;
+    frame->cmd[0] = panel->caset;
+    frame->cmd[1] = panel->raset;
+    frame->cmd[2] = panel->ramwr;
+    frame->caset[0] = win->x >> 8, frame->caset[1] = win->x, frame->caset[2] = x1 >> 8, frame->caset[3] = x1;
+    frame->raset[0] = win->y >> 8, frame->raset[1] = win->y, frame->raset[2] = y1 >> 8, frame->raset[3] = y1;
+
+    return lcd_queue(1, &frame->cmd[0], false) + lcd_queue(4, frame->caset, true)
+        + lcd_queue(1, &frame->cmd[1], false) + lcd_queue(4, frame->raset, true)
+        + lcd_queue(1, &frame->cmd[2], false) + lcd_queue(win->w * win->h * 2, frame->pixels, true);
+}
+
 static mp_obj_t py_lcd_deinit()
 {
     switch (type) {
         case LCD_NONE:
             return mp_const_none;
         case LCD_SHIELD:
+            lcd_wait();
+            MP_STATE_PORT(lcd_frames) = NULL;
             HAL_GPIO_DeInit(RST_PORT, RST_PIN);
             HAL_GPIO_DeInit(RS_PORT, RS_PIN);
             HAL_GPIO_DeInit(CS_PORT, CS_PIN);
@@ -187,8 +371,8 @@ static mp_obj_t py_lcd_init(uint n_args, const mp_obj_t *args, mp_map_t *kw_args
                     MP_OBJ_NEW_SMALL_INT(0)
                 }
             );
-            s_width = 128;
-            height = 160;
+            s_width = lcd_panels[LCD_SHIELD].w;
+            height = lcd_panels[LCD_SHIELD].h;
             type = LCD_SHIELD;
             s_backlight_init = false;
 
@@ -208,6 +392,11 @@ static mp_obj_t py_lcd_init(uint n_args, const mp_obj_t *args, mp_map_t *kw_args
             // Display on
             lcd_write_command_byte(0x29);
 
+            lcd_frame_size = (sizeof(lcd_frame_t) + (s_width * height * 2) + 31) & ~31;
+            MP_STATE_PORT(lcd_frames) = xalloc(lcd_frame_size * 2);
+            lcd_frame_slot = 0;
+            lcd_last_xfers = 0;
+            lcd_tiles_valid = false;
             return mp_const_none;
         }
     }
@@ -341,7 +530,7 @@ static mp_obj_t py_lcd_display(uint n_args, const mp_obj_t *args, mp_map_t *kw_a
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &rect);
 
     // Fit X.
-    int l_pad = 0, r_pad = 0;
+    int l_pad = 0;
     if (rect.w > s_width) {
         int adjust = rect.w - s_width;
         rect.w -= adjust;
@@ -349,11 +538,10 @@ static mp_obj_t py_lcd_display(uint n_args, const mp_obj_t *args, mp_map_t *kw_a
     } else if (rect.w < s_width) {
         int adjust = s_width - rect.w;
         l_pad = adjust / 2;
-        r_pad = (adjust + 1) / 2;
     }
 
     // Fit Y.
-    int t_pad = 0, b_pad = 0;
+    int t_pad = 0;
     if (rect.h > height) {
         int adjust = rect.h - height;
         rect.h -= adjust;
@@ -361,44 +549,21 @@ static mp_obj_t py_lcd_display(uint n_args, const mp_obj_t *args, mp_map_t *kw_a
     } else if (rect.h < height) {
         int adjust = height - rect.h;
         t_pad = adjust / 2;
-        b_pad = (adjust + 1) / 2;
     }
 
     switch (type) {
         case LCD_NONE:
             return mp_const_none;
         case LCD_SHIELD:
-            lcd_write_command_byte(0x2C);
-            uint8_t *zero = fb_alloc0(s_width*2, FB_ALLOC_NO_HINT);
-            uint16_t *line = fb_alloc(s_width*2, FB_ALLOC_NO_HINT);
-            for (int i=0; i<t_pad; i++) {
-                lcd_write_data(s_width*2, zero);
-            }
-            for (int i=0; i<rect.h; i++) {
-                if (l_pad) {
-                    lcd_write_data(l_pad*2, zero); // l_pad < s_width
-                }
-                if (IM_IS_GS(arg_img)) {
-                    for (int j=0; j<rect.w; j++) {
-                        uint8_t pixel = IM_GET_GS_PIXEL(arg_img, (rect.x + j), (rect.y + i));
-                        line[j] = IM_RGB565(IM_R825(pixel),IM_G826(pixel),IM_B825(pixel));
-                    }
-                    lcd_write_data(rect.w*2, (uint8_t *) line);
-                } else {
-                    lcd_write_data(rect.w*2, (uint8_t *)
-                        (((uint16_t *) arg_img->pixels) +
-                        ((rect.y + i) * arg_img->w) + rect.x));
-                }
-                if (r_pad) {
-                    lcd_write_data(r_pad*2, zero); // r_pad < s_width
-                }
-            }
-            for (int i=0; i<b_pad; i++) {
-                lcd_write_data(s_width*2, zero);
+        {
+            rectangle_t win;
+            if (lcd_dirty(arg_img, &rect, l_pad, t_pad, &win)) {
+                lcd_frame_t *frame = lcd_next_frame();
+                lcd_pack(frame, arg_img, &rect, l_pad, t_pad, &win);
+                lcd_last_xfers = lcd_queue_frame(&lcd_panels[type], frame, &win);
             }
-            fb_free();
-            fb_free();
             return mp_const_none;
+        }
     }
     return mp_const_none;
 }
@@ -411,12 +576,16 @@ static mp_obj_t py_lcd_clear()
         case LCD_NONE:
             return mp_const_none;
         case LCD_SHIELD:
-            lcd_write_command_byte(0x2C);
+            lcd_wait();
+            lcd_set_window(&lcd_panels[type], 0, 0, s_width, height);
+            lcd_write_command_byte(lcd_panels[type].ramwr);
             uint8_t* zero = fb_alloc0(s_width*2, FB_ALLOC_NO_HINT);
             for (int i=0; i<height; i++) {
-                lcd_write_data(s_width*2, zero);
+                lcd_queue_data(s_width*2, zero);
             }
+            lcd_wait();
             fb_free();
+            lcd_tiles_valid = false;
             return mp_const_none;
     }
     return mp_const_none;
@@ -20,9 +20,7 @@ typedef struct py_mjpeg_obj {
     mp_obj_base_t base;
     int width;
     int height;
-    uint32_t frames;
-    uint32_t bytes;
-    FIL fp;
+    mjpeg_t mjpeg;
 } py_mjpeg_obj_t;
 
 static mp_obj_t py_mjpeg_open(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
@@ -30,12 +28,12 @@ static mp_obj_t py_mjpeg_open(uint n_args, const mp_obj_t *args, mp_map_t *kw_ar
     py_mjpeg_obj_t *mjpeg = m_new_obj(py_mjpeg_obj_t);
     mjpeg->width  = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_width), MAIN_FB()->w);
     mjpeg->height = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_height), MAIN_FB()->h);
-    mjpeg->frames = 0; // private
-    mjpeg->bytes = 0; // private
+    int segment_size = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_segment_size), 32*1024*1024);
+    PY_ASSERT_TRUE_MSG(segment_size >= 0, "Invalid size");
     mjpeg->base.type = &py_mjpeg_type;
 
-    file_write_open(&mjpeg->fp, mp_obj_str_get_str(args[0]));
-    mjpeg_open(&mjpeg->fp, mjpeg->width, mjpeg->height);
+    file_write_open(&mjpeg->mjpeg.fp, mp_obj_str_get_str(args[0]));
+    mjpeg_open(&mjpeg->mjpeg, mjpeg->width, mjpeg->height, segment_size);
     return mjpeg;
 }
 
@@ -54,7 +52,7 @@ static mp_obj_t py_mjpeg_height(mp_obj_t mjpeg_obj)
 static mp_obj_t py_mjpeg_size(mp_obj_t mjpeg_obj)
 {
     py_mjpeg_obj_t *arg_mjpeg = mjpeg_obj;
-    return mp_obj_new_int(f_size(&arg_mjpeg->fp));
+    return mp_obj_new_int(f_size(&arg_mjpeg->mjpeg.fp));
 }
 
 static mp_obj_t py_mjpeg_add_frame(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
@@ -67,14 +65,14 @@ static mp_obj_t py_mjpeg_add_frame(uint n_args, const mp_obj_t *args, mp_map_t *
 
     int arg_q = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_quality), 50);
     arg_q = IM_MIN(IM_MAX(arg_q, 1), 100);
-    mjpeg_add_frame(&arg_mjpeg->fp, &arg_mjpeg->frames, &arg_mjpeg->bytes, arg_img, arg_q);
+    mjpeg_add_frame(&arg_mjpeg->mjpeg, arg_img, arg_q);
     return mp_const_none;
 }
 
 static mp_obj_t py_mjpeg_close(mp_obj_t mjpeg_obj, mp_obj_t fps_obj)
 {
     py_mjpeg_obj_t *arg_mjpeg = mjpeg_obj;
-    mjpeg_close(&arg_mjpeg->fp, &arg_mjpeg->frames, &arg_mjpeg->bytes, mp_obj_get_float(fps_obj));
+    mjpeg_close(&arg_mjpeg->mjpeg, mp_obj_get_float(fps_obj));
     return mp_const_none;
 }
 
@@ -106,10 +104,126 @@ static const mp_obj_type_t py_mjpeg_type = {
     .locals_dict = (mp_obj_t)&locals_dict,
 };
 
+#ifdef IMLIB_ENABLE_MJPEG_RECORDER
+static const mp_obj_type_t py_mjpeg_recorder_type; // forward declare
+// Recorder class
+typedef struct py_mjpeg_recorder_obj {
+    mp_obj_base_t base;
+    int width;
+    int height;
+    mjpeg_rec_t *rec;
+} py_mjpeg_recorder_obj_t;
+
+static mjpeg_rec_t *py_mjpeg_recorder_rec(mp_obj_t recorder_obj)
+{
+    py_mjpeg_recorder_obj_t *arg_recorder = recorder_obj;
+    PY_ASSERT_TRUE_MSG(arg_recorder->rec, "Recorder is closed");
+    return arg_recorder->rec;
+}
+
+static mp_obj_t py_mjpeg_recorder_open(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    py_mjpeg_recorder_obj_t *recorder = m_new_obj(py_mjpeg_recorder_obj_t);
+    recorder->width  = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_width), MAIN_FB()->w);
+    recorder->height = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_height), MAIN_FB()->h);
+    int buffer_size = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_buffer_size), 256*1024);
+    int file_size = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_file_size), 0);
+    PY_ASSERT_TRUE_MSG((buffer_size > 0) && (file_size >= 0), "Invalid size");
+    recorder->base.type = &py_mjpeg_recorder_type;
+
+    recorder->rec = mjpeg_rec_open(mp_obj_str_get_str(args[0]), recorder->width, recorder->height, buffer_size, file_size);
+    return recorder;
+}
+
+static mp_obj_t py_mjpeg_recorder_width(mp_obj_t recorder_obj)
+{
+    py_mjpeg_recorder_obj_t *arg_recorder = recorder_obj;
+    return mp_obj_new_int(arg_recorder->width);
+}
+
+static mp_obj_t py_mjpeg_recorder_height(mp_obj_t recorder_obj)
+{
+    py_mjpeg_recorder_obj_t *arg_recorder = recorder_obj;
+    return mp_obj_new_int(arg_recorder->height);
+}
+
+static mp_obj_t py_mjpeg_recorder_size(mp_obj_t recorder_obj)
+{
+    return mp_obj_new_int(mjpeg_rec_size(py_mjpeg_recorder_rec(recorder_obj)));
+}
+
+static mp_obj_t py_mjpeg_recorder_add_frame(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    py_mjpeg_recorder_obj_t *arg_recorder = args[0];
+    mjpeg_rec_t *rec = py_mjpeg_recorder_rec(args[0]);
+    image_t *arg_img = py_image_cobj(args[1]);
+    PY_ASSERT_FALSE_MSG((arg_recorder->width != arg_img->w)
+                     || (arg_recorder->height != arg_img->h),
+            "Unexpected image geometry");
+
+    int arg_q = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_quality), 50);
+    arg_q = IM_MIN(IM_MAX(arg_q, 1), 100);
+    mjpeg_rec_add_frame(rec, arg_img, arg_q);
+    return mp_const_none;
+}
+
+static mp_obj_t py_mjpeg_recorder_flush(mp_obj_t recorder_obj)
+{
+    mjpeg_rec_flush(py_mjpeg_recorder_rec(recorder_obj));
+    return mp_const_none;
+}
+
+static mp_obj_t py_mjpeg_recorder_close(mp_obj_t recorder_obj, mp_obj_t fps_obj)
+{
+    py_mjpeg_recorder_obj_t *arg_recorder = recorder_obj;
+    mjpeg_rec_t *rec = py_mjpeg_recorder_rec(recorder_obj);
+    arg_recorder->rec = NULL;
+    mjpeg_rec_close(rec, mp_obj_get_float(fps_obj));
+    return mp_const_none;
+}
+
+static void py_mjpeg_recorder_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
+{
+    py_mjpeg_recorder_obj_t *self = self_in;
+    mp_printf(print, "<recorder width:%d height:%d>", self->width, self->height);
+}
+
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_recorder_width_obj, py_mjpeg_recorder_width);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_recorder_height_obj, py_mjpeg_recorder_height);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_recorder_size_obj, py_mjpeg_recorder_size);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_mjpeg_recorder_add_frame_obj, 2, py_mjpeg_recorder_add_frame);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_recorder_flush_obj, py_mjpeg_recorder_flush);
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(py_mjpeg_recorder_close_obj, py_mjpeg_recorder_close);
+static const mp_map_elem_t recorder_locals_dict_table[] = {
+    { MP_OBJ_NEW_QSTR(MP_QSTR_width),       (mp_obj_t)&py_mjpeg_recorder_width_obj     },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_height),      (mp_obj_t)&py_mjpeg_recorder_height_obj    },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_size),        (mp_obj_t)&py_mjpeg_recorder_size_obj      },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_add_frame),   (mp_obj_t)&py_mjpeg_recorder_add_frame_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_flush),       (mp_obj_t)&py_mjpeg_recorder_flush_obj     },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_close),       (mp_obj_t)&py_mjpeg_recorder_close_obj     },
+    { NULL, NULL },
+};
+STATIC MP_DEFINE_CONST_DICT(recorder_locals_dict, recorder_locals_dict_table);
+
+static const mp_obj_type_t py_mjpeg_recorder_type = {
+    { &mp_type_type },
+    .name  = MP_QSTR_Recorder,
+    .print = py_mjpeg_recorder_print,
+    .locals_dict = (mp_obj_t)&recorder_locals_dict,
+};
+
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_mjpeg_recorder_open_obj, 1, py_mjpeg_recorder_open);
+#endif // IMLIB_ENABLE_MJPEG_RECORDER
+
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_mjpeg_open_obj, 1, py_mjpeg_open);
 static const mp_map_elem_t globals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___name__),    MP_OBJ_NEW_QSTR(MP_QSTR_mjpeg) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_Mjpeg),       (mp_obj_t)&py_mjpeg_open_obj   },
+    #ifdef IMLIB_ENABLE_MJPEG_RECORDER
+    { MP_OBJ_NEW_QSTR(MP_QSTR_Recorder),    (mp_obj_t)&py_mjpeg_recorder_open_obj },
+    #else
+    { MP_OBJ_NEW_QSTR(MP_QSTR_Recorder),    (mp_obj_t)&py_func_unavailable_obj },
+    #endif
     { NULL, NULL },
 };
 STATIC MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
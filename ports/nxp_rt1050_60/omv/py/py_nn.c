@@ -3,10 +3,17 @@
  * This work is licensed under the MIT license, see the file LICENSE for details.
  */
 #include <mp.h>
+#include "py/mphal.h"
 #include "nn.h"
+#include "nn_cascade.h"
 #include "py_helper.h"
 #include "py_image.h"
 #include "omv_boardconfig.h"
+#include "fb_alloc.h"
+#include "framebuffer.h"
+#include "sensor.h"
+#include "ff_wrapper.h"
+#include "model_store.h"
 
 #ifdef IMLIB_ENABLE_CNN
 static const mp_obj_type_t py_net_type;
@@ -41,7 +48,9 @@ STATIC mp_obj_t py_net_forward(uint n_args, const mp_obj_t *args, mp_map_t *kw_a
 
     mp_obj_t output_list = mp_obj_new_list(0, NULL);
     if (dry_run == false) {
+        PY_NATIVE_BEGIN();
         nn_run_network(net, img, &roi, softmax);
+        PY_NATIVE_END();
     } else {
         nn_dry_run_network(net, img, softmax);
     }
@@ -53,6 +62,49 @@ STATIC mp_obj_t py_net_forward(uint n_args, const mp_obj_t *args, mp_map_t *kw_a
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_net_forward_obj, 2, py_net_forward);
 
+STATIC mp_obj_t py_net_forward_batch(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    nn_t *net = py_net_cobj(args[0]);
+    image_t *img = py_helper_arg_to_image_mutable(args[1]);
+
+    mp_uint_t n_rois;
+    mp_obj_t *arg_rois;
+    mp_obj_get_array(args[2], &n_rois, &arg_rois);
+
+    bool softmax = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_softmax), false);
+
+    fb_alloc_mark();
+    rectangle_t *rois = fb_alloc(n_rois * sizeof(rectangle_t), FB_ALLOC_NO_HINT);
+    int8_t *outputs = fb_alloc(n_rois * net->output_size, FB_ALLOC_NO_HINT);
+
+    rectangle_t temp;
+    rectangle_init(&temp, 0, 0, img->w, img->h);
+    for (mp_uint_t i=0; i<n_rois; i++) {
+        mp_obj_t *arg_rectangle;
+        mp_obj_get_array_fixed_n(arg_rois[i], 4, &arg_rectangle);
+        rectangle_init(&rois[i], mp_obj_get_int(arg_rectangle[0]), mp_obj_get_int(arg_rectangle[1]),
+                                 mp_obj_get_int(arg_rectangle[2]), mp_obj_get_int(arg_rectangle[3]));
+        PY_ASSERT_TRUE_MSG((rois[i].w >= 1) && (rois[i].h >= 1), "Invalid ROI dimensions!");
+        PY_ASSERT_TRUE_MSG(rectangle_overlap(&rois[i], &temp), "ROI does not overlap on the image!");
+        rectangle_intersected(&rois[i], &temp);
+    }
+
+    nn_run_network_batch(net, img, rois, n_rois, softmax, outputs);
+
+    mp_obj_list_t *output_list = mp_obj_new_list(n_rois, NULL);
+    for (mp_uint_t i=0; i<n_rois; i++) {
+        mp_obj_list_t *roi_list = mp_obj_new_list(net->output_size, NULL);
+        for (int j=0; j<net->output_size; j++) {
+            roi_list->items[j] = mp_obj_new_float(((float) (outputs[(i * net->output_size) + j] + 128)) / 255);
+        }
+        output_list->items[i] = roi_list;
+    }
+
+    fb_alloc_free_till_mark();
+    return output_list;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_net_forward_batch_obj, 3, py_net_forward_batch);
+
 // NN Class Object
 #define py_nn_class_obj_size 6
 typedef struct py_nn_class_obj {
@@ -179,6 +231,9 @@ STATIC mp_obj_t py_net_search(uint n_args, const mp_obj_t *args, mp_map_t *kw_ar
     list_t out;
     list_init(&out, sizeof(py_nn_class_obj_list_lnk_data_t));
 
+    list_t windows;
+    list_init(&windows, sizeof(rectangle_t));
+
     for (float scale = 1; scale >= arg_min_scale; scale *= arg_scale_mul) {
         // Either provide a subtle offset to center multiple detection windows or center the only detection window.
         for (int y = roi.y + ((arg_y_overlap != -1) ? (fmodf(roi.h, (roi.h * scale)) / 2) : ((roi.h - (roi.h * scale)) / 2));
@@ -228,32 +283,49 @@ STATIC mp_obj_t py_net_search(uint n_args, const mp_obj_t *args, mp_map_t *kw_ar
                     int variance = (sum_2 / area) - (mean * mean);
 
                     if (fast_sqrtf(variance) >= arg_contrast_threshold) { // Skip flat regions...
-                        nn_run_network(arg_net, arg_img, &new_roi, softmax);
-
-                        int max_index = -1;
-                        float max_value = -1;
-                        for (int i=0; i<arg_net->output_size; i++) {
-                            float value = ((float) (arg_net->output_data[i] + 128)) / 255;
-                            if ((value >= arg_threshold) && (value > max_value)) {
-                                max_index = i;
-                                max_value = value;
-                            }
-                        }
+                        list_push_back(&windows, &new_roi);
+                    }
+                }
+            }
+        }
 
-                        if (max_index != -1) {
-                            py_nn_class_obj_list_lnk_data_t lnk_data;
-                            lnk_data.rect.x = new_roi.x;
-                            lnk_data.rect.y = new_roi.y;
-                            lnk_data.rect.w = new_roi.w;
-                            lnk_data.rect.h = new_roi.h;
-                            lnk_data.index = max_index;
-                            lnk_data.value = max_value;
-                            lnk_data.merge_number = 1;
-                            list_push_back(&out, &lnk_data);
-                        }
+        // All windows of a scale are the same size, run them as one batch.
+        size_t n_windows = list_size(&windows);
+        if (n_windows) {
+            fb_alloc_mark();
+            rectangle_t *rois = fb_alloc(n_windows * sizeof(rectangle_t), FB_ALLOC_NO_HINT);
+            int8_t *outputs = fb_alloc(n_windows * arg_net->output_size, FB_ALLOC_NO_HINT);
+            for (size_t i=0; i<n_windows; i++) {
+                list_pop_front(&windows, &rois[i]);
+            }
+
+            nn_run_network_batch(arg_net, arg_img, rois, n_windows, softmax, outputs);
+
+            for (size_t w=0; w<n_windows; w++) {
+                int8_t *output_data = outputs + (w * arg_net->output_size);
+                int max_index = -1;
+                float max_value = -1;
+                for (int i=0; i<arg_net->output_size; i++) {
+                    float value = ((float) (output_data[i] + 128)) / 255;
+                    if ((value >= arg_threshold) && (value > max_value)) {
+                        max_index = i;
+                        max_value = value;
                     }
                 }
+
+                if (max_index != -1) {
+                    py_nn_class_obj_list_lnk_data_t lnk_data;
+                    lnk_data.rect.x = rois[w].x;
+                    lnk_data.rect.y = rois[w].y;
+                    lnk_data.rect.w = rois[w].w;
+                    lnk_data.rect.h = rois[w].h;
+                    lnk_data.index = max_index;
+                    lnk_data.value = max_value;
+                    lnk_data.merge_number = 1;
+                    list_push_back(&out, &lnk_data);
+                }
             }
+            fb_alloc_free_till_mark();
         }
     }
 
@@ -357,9 +429,278 @@ STATIC mp_obj_t py_net_search(uint n_args, const mp_obj_t *args, mp_map_t *kw_ar
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_net_search_obj, 2, py_net_search);
 
+STATIC mp_obj_t py_net_profile(uint n_args, const mp_obj_t *args)
+{
+    nn_t *net = py_net_cobj(args[0]);
+
+    // net.profile(enable) starts or stops recording, counters restart when enabled.
+    if (n_args == 2) {
+        net->profile = mp_obj_is_true(args[1]);
+        if (net->profile) {
+            mp_hal_ticks_cpu_enable();
+            nn_profile_reset(net);
+        }
+        return mp_const_none;
+    }
+
+    // Per layer (type, cycles, macs, bytes_read, bytes_written), cycles are per forward pass.
+    mp_obj_t layers_list = mp_obj_new_list(0, NULL);
+    for (layer_t *layer = net->layers; layer != NULL; layer = layer->next) {
+        nn_layer_stats_t stats;
+        nn_layer_stats(layer, &stats);
+        mp_obj_t layer_tuple[5] = {
+            mp_obj_new_int(layer->type),
+            mp_obj_new_int_from_uint(net->profile_runs ? (layer->cycles / net->profile_runs) : 0),
+            mp_obj_new_int_from_uint(stats.macs),
+            mp_obj_new_int_from_uint(stats.bytes_read),
+            mp_obj_new_int_from_uint(stats.bytes_written)
+        };
+        mp_obj_list_append(layers_list, mp_obj_new_tuple(5, layer_tuple));
+    }
+    return layers_list;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_net_profile_obj, 1, 2, py_net_profile);
+
+// net.pipeline(): while the net runs on frame N, frame N+1 is captured into the other of two frame
+// slots, so the sensor readout is hidden behind the inference. A frame returned by next() is only
+// valid until the next call, its slot is being captured into by then.
+#define PY_NN_PIPELINE_SLOTS (2)
+static const char *py_nn_pipeline_slot_names[PY_NN_PIPELINE_SLOTS] = { "nn_pipe0", "nn_pipe1" };
+static const mp_obj_type_t py_nn_pipeline_type;
+extern sensor_t s_sensor;
+
+typedef struct _py_nn_pipeline_obj_t {
+    mp_obj_base_t base;
+    mp_obj_t net;
+    int cur;            // Slot of the next frame
+    bool armed;         // The next frame is already being captured into slots[cur]
+    bool softmax;
+    bool has_roi;
+    rectangle_t roi;
+} py_nn_pipeline_obj_t;
+
+static fb_slot_t *py_nn_pipeline_slot(int i)
+{
+    fb_slot_t *slot = fb_slot_find(py_nn_pipeline_slot_names[i]);
+    PY_ASSERT_TRUE_MSG(slot != NULL, "Pipeline frame slots were freed!");
+    return slot;
+}
+
+STATIC mp_obj_t py_net_pipeline(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    PY_ASSERT_TRUE_MSG((s_sensor.pixformat == PIXFORMAT_GRAYSCALE) || (s_sensor.pixformat == PIXFORMAT_RGB565),
+            "Pipeline needs GRAYSCALE or RGB565!");
+    int bpp = (s_sensor.pixformat == PIXFORMAT_GRAYSCALE) ? IMAGE_BPP_GRAYSCALE : IMAGE_BPP_RGB565;
+    int w = MAIN_FB()->w, h = MAIN_FB()->h;
+    PY_ASSERT_TRUE_MSG((w > 0) && (h > 0), "Set the frame size first!");
+
+    py_nn_pipeline_obj_t *pipeline = m_new_obj(py_nn_pipeline_obj_t);
+    pipeline->base.type = &py_nn_pipeline_type;
+    pipeline->net = args[0];
+    pipeline->cur = 0;
+    pipeline->armed = false;
+    pipeline->softmax = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_softmax), false);
+
+    mp_obj_t roi_obj = py_helper_keyword_object(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_roi));
+    pipeline->has_roi = (roi_obj != NULL) && (roi_obj != mp_const_none);
+    if (pipeline->has_roi) {
+        mp_obj_t *arg_rectangle;
+        mp_obj_get_array_fixed_n(roi_obj, 4, &arg_rectangle);
+        rectangle_init(&pipeline->roi, mp_obj_get_int(arg_rectangle[0]), mp_obj_get_int(arg_rectangle[1]),
+                                       mp_obj_get_int(arg_rectangle[2]), mp_obj_get_int(arg_rectangle[3]));
+        PY_ASSERT_TRUE_MSG((pipeline->roi.w >= 1) && (pipeline->roi.h >= 1), "Invalid ROI dimensions!");
+    }
+
+    // Slots are kept across pipelines of the same frame size.
+    for (int i=0; i<PY_NN_PIPELINE_SLOTS; i++) {
+        fb_slot_t *slot = fb_slot_find(py_nn_pipeline_slot_names[i]);
+        if (slot != NULL) {
+            PY_ASSERT_TRUE_MSG((slot->w == w) && (slot->h == h) && (slot->bpp == bpp),
+                    "Frame size changed, call sensor.free_slots() first!");
+        } else if (fb_slot_alloc(py_nn_pipeline_slot_names[i], w, h, bpp) == NULL) {
+            nlr_raise(mp_obj_new_exception_msg(&mp_type_MemoryError, "No room for the pipeline frame slots!"));
+        }
+    }
+    return pipeline;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_net_pipeline_obj, 1, py_net_pipeline);
+
+STATIC mp_obj_t py_nn_pipeline_next(mp_obj_t self_in)
+{
+    py_nn_pipeline_obj_t *self = self_in;
+    nn_t *net = py_net_cobj(self->net);
+    fb_slot_t *slot = py_nn_pipeline_slot(self->cur);
+    fb_slot_t *next_slot = py_nn_pipeline_slot(!self->cur);
+    mp_obj_t frame = py_image(0, 0, 0, 0);
+    image_t *img = py_image_cobj(frame);
+
+    // Frame N, already in flight unless this is the first call.
+    int ret = sensor_snapshot_into(img, slot->pixels, slot->size);
+    PY_ASSERT_TRUE_MSG(ret != -2, "Frame does not fit in the slot!");
+    if (ret == -1) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_RuntimeError, "Sensor Timeout!!"));
+    }
+
+    // Frame N+1 goes to the other slot while the net runs on this one.
+    sensor_snapshot_async_into(next_slot->pixels, next_slot->size);
+    self->armed = true;
+
+    rectangle_t roi;
+    rectangle_init(&roi, 0, 0, img->w, img->h);
+    if (self->has_roi) {
+        PY_ASSERT_TRUE_MSG(rectangle_overlap(&self->roi, &roi), "ROI does not overlap on the image!");
+        rectangle_intersected(&roi, &self->roi);
+    }
+    PY_NATIVE_BEGIN();
+    nn_run_network(net, img, &roi, self->softmax);
+    PY_NATIVE_END();
+
+    mp_obj_list_t *output_list = mp_obj_new_list(net->output_size, NULL);
+    for (int i=0; i<net->output_size; i++) {
+        output_list->items[i] = mp_obj_new_float(((float) (net->output_data[i] + 128)) / 255);
+    }
+
+    self->cur = !self->cur;
+    mp_obj_t tuple[2] = { frame, output_list };
+    return mp_obj_new_tuple(2, tuple);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_nn_pipeline_next_obj, py_nn_pipeline_next);
+
+STATIC const mp_rom_map_elem_t pipeline_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_next), MP_ROM_PTR(&py_nn_pipeline_next_obj) }
+};
+
+STATIC MP_DEFINE_CONST_DICT(pipeline_locals_dict, pipeline_locals_dict_table);
+
+static const mp_obj_type_t py_nn_pipeline_type = {
+    { &mp_type_type },
+    .name  = MP_QSTR_Pipeline,
+    .locals_dict = (mp_obj_t) &pipeline_locals_dict
+};
+
+// net.cascade(): a variance or motion statistic, or a small gate Net, decides per frame whether
+// this net runs. forward() returns None for the frames the gate drops.
+static const mp_obj_type_t py_nn_cascade_type;
+
+typedef struct _py_nn_cascade_obj_t {
+    mp_obj_base_t base;
+    mp_obj_t net;
+    mp_obj_t gate_net;  // NN_CASCADE_GATE_MODEL only
+    int index;          // Output of the gate net that is the score
+    nn_cascade_t _cobj;
+} py_nn_cascade_obj_t;
+
+STATIC mp_obj_t py_net_cascade(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    py_nn_cascade_obj_t *cascade = m_new_obj(py_nn_cascade_obj_t);
+    cascade->base.type = &py_nn_cascade_type;
+    cascade->net = args[0];
+    cascade->gate_net = mp_const_none;
+
+    nn_cascade_gate_t gate = NN_CASCADE_GATE_MOTION;
+    mp_obj_t gate_obj = py_helper_keyword_object(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_gate));
+    if ((gate_obj != NULL) && MP_OBJ_IS_TYPE(gate_obj, &py_net_type)) {
+        gate = NN_CASCADE_GATE_MODEL;
+        cascade->gate_net = gate_obj;
+    } else if (gate_obj != NULL) {
+        const char *name = mp_obj_str_get_str(gate_obj);
+        if (!strcmp(name, "variance")) {
+            gate = NN_CASCADE_GATE_VARIANCE;
+        } else if (strcmp(name, "motion")) {
+            nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Gate must be \"variance\", \"motion\" or a Net!"));
+        }
+    }
+
+    float threshold = py_helper_keyword_float(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 0.05f);
+    PY_ASSERT_TRUE_MSG((0.0f <= threshold) && (threshold <= 1.0f), "0 <= threshold <= 1");
+
+    cascade->index = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_index), 0);
+    if (gate == NN_CASCADE_GATE_MODEL) {
+        PY_ASSERT_TRUE_MSG((cascade->index >= 0) && (cascade->index < ((nn_t *) py_net_cobj(cascade->gate_net))->output_size),
+                "Gate output index out of range!");
+    }
+
+    nn_cascade_init(&cascade->_cobj, gate, threshold);
+    return cascade;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_net_cascade_obj, 1, py_net_cascade);
+
+STATIC mp_obj_t py_nn_cascade_forward(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    py_nn_cascade_obj_t *self = args[0];
+    nn_cascade_t *cascade = &self->_cobj;
+    nn_t *net = py_net_cobj(self->net);
+    image_t *img = py_helper_arg_to_image_mutable(args[1]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(img, n_args, args, 2, kw_args, &roi);
+    bool softmax = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_softmax), false);
+
+    float score;
+    nn_cascade_start(cascade);
+    if (cascade->gate == NN_CASCADE_GATE_MODEL) {
+        nn_t *gate_net = py_net_cobj(self->gate_net);
+        PY_NATIVE_BEGIN();
+        nn_run_network(gate_net, img, &roi, softmax);
+        PY_NATIVE_END();
+        score = ((float) (gate_net->output_data[self->index] + 128)) / 255;
+    } else {
+        score = nn_cascade_score(cascade, img, &roi);
+    }
+
+    if (!nn_cascade_gate_done(cascade, score)) {
+        return mp_const_none;
+    }
+
+    nn_cascade_start(cascade);
+    PY_NATIVE_BEGIN();
+    nn_run_network(net, img, &roi, softmax);
+    PY_NATIVE_END();
+    nn_cascade_model_done(cascade);
+
+    mp_obj_list_t *output_list = mp_obj_new_list(net->output_size, NULL);
+    for (int i=0; i<net->output_size; i++) {
+        output_list->items[i] = mp_obj_new_float(((float) (net->output_data[i] + 128)) / 255);
+    }
+    return output_list;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_nn_cascade_forward_obj, 2, py_nn_cascade_forward);
+
+// (frames, runs, last score, gate cycles per frame, model cycles per run)
+STATIC mp_obj_t py_nn_cascade_stats(mp_obj_t self_in)
+{
+    nn_cascade_t *cascade = &((py_nn_cascade_obj_t *) self_in)->_cobj;
+    mp_obj_t stats[5] = {
+        mp_obj_new_int(cascade->frames),
+        mp_obj_new_int(cascade->runs),
+        mp_obj_new_float(cascade->score),
+        mp_obj_new_int(cascade->frames ? (cascade->gate_cycles / cascade->frames) : 0),
+        mp_obj_new_int(cascade->runs ? (cascade->model_cycles / cascade->runs) : 0)
+    };
+    return mp_obj_new_tuple(5, stats);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_nn_cascade_stats_obj, py_nn_cascade_stats);
+
+STATIC const mp_rom_map_elem_t cascade_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_forward), MP_ROM_PTR(&py_nn_cascade_forward_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&py_nn_cascade_stats_obj) }
+};
+
+STATIC MP_DEFINE_CONST_DICT(cascade_locals_dict, cascade_locals_dict_table);
+
+static const mp_obj_type_t py_nn_cascade_type = {
+    { &mp_type_type },
+    .name  = MP_QSTR_Cascade,
+    .locals_dict = (mp_obj_t) &cascade_locals_dict
+};
+
 STATIC const mp_rom_map_elem_t locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_forward), MP_ROM_PTR(&py_net_forward_obj) },
-    { MP_ROM_QSTR(MP_QSTR_search), MP_ROM_PTR(&py_net_search_obj) }
+    { MP_ROM_QSTR(MP_QSTR_forward_batch), MP_ROM_PTR(&py_net_forward_batch_obj) },
+    { MP_ROM_QSTR(MP_QSTR_search), MP_ROM_PTR(&py_net_search_obj) },
+    { MP_ROM_QSTR(MP_QSTR_profile), MP_ROM_PTR(&py_net_profile_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pipeline), MP_ROM_PTR(&py_net_pipeline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cascade), MP_ROM_PTR(&py_net_cascade_obj) }
 };
 
 STATIC MP_DEFINE_CONST_DICT(locals_dict, locals_dict_table);
@@ -376,20 +717,85 @@ static mp_obj_t py_nn_load(mp_obj_t path_obj)
     const char *path = mp_obj_str_get_str(path_obj);
     py_net_obj_t *net = m_new_obj(py_net_obj_t);
     net->base.type = &py_net_type;
-    nn_load_network(py_net_cobj(net), path);
+
+    // Networks in the flash model store run in place, weights are not copied to RAM.
+    uint32_t size;
+    const uint8_t *data = model_store_find(path, &size);
+    if (data != NULL) {
+        PY_ASSERT_FALSE_MSG(nn_load_network_xip(py_net_cobj(net), data, size), "Invalid network!");
+    } else {
+        nn_load_network(py_net_cobj(net), path);
+    }
     return net;
 }
 
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_nn_load_obj, py_nn_load);
 
+static int py_nn_store_read(void *arg, void *buf, uint32_t len)
+{
+    read_data((FIL *) arg, buf, len);
+    return 0;
+}
+
+static mp_obj_t py_nn_store(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    const char *path = mp_obj_str_get_str(args[0]);
+    mp_obj_t name_obj = py_helper_keyword_object(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_name));
+    const char *name = (name_obj != NULL) ? mp_obj_str_get_str(name_obj) : path;
+    PY_ASSERT_TRUE_MSG(strlen(name) < MODEL_STORE_NAME_LEN, "Name is too long!");
+
+    FIL fp;
+    file_read_open(&fp, path);
+    uint32_t size = f_size(&fp);
+    if (size > model_store_avail()) {
+        file_close(&fp);
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "Not enough room in the model store!"));
+    }
+
+    file_buffer_on(&fp);
+    int res = model_store_add(name, size, py_nn_store_read, &fp);
+    file_buffer_off(&fp);
+    file_close(&fp);
+    PY_ASSERT_FALSE_MSG(res, "Failed to store the model, erase the model store and try again!");
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_nn_store_obj, 1, py_nn_store);
+
+static mp_obj_t py_nn_store_list()
+{
+    mp_obj_t models_list = mp_obj_new_list(0, NULL);
+    for (const model_store_entry_t *entry = model_store_next(NULL); entry; entry = model_store_next(entry)) {
+        mp_obj_t model[2] = {
+            mp_obj_new_str(entry->name, strnlen(entry->name, MODEL_STORE_NAME_LEN)),
+            mp_obj_new_int(entry->size)
+        };
+        mp_obj_list_append(models_list, mp_obj_new_tuple(2, model));
+    }
+    return models_list;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_nn_store_list_obj, py_nn_store_list);
+
+static mp_obj_t py_nn_store_erase()
+{
+    PY_ASSERT_FALSE_MSG(model_store_erase(), "Failed to erase the model store!");
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_nn_store_erase_obj, py_nn_store_erase);
+
 #endif // IMLIB_ENABLE_CNN
 
 STATIC const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR_nn) },
 #ifdef IMLIB_ENABLE_CNN
     { MP_ROM_QSTR(MP_QSTR_load),     MP_ROM_PTR(&py_nn_load_obj) },
+    { MP_ROM_QSTR(MP_QSTR_store),    MP_ROM_PTR(&py_nn_store_obj) },
+    { MP_ROM_QSTR(MP_QSTR_store_list), MP_ROM_PTR(&py_nn_store_list_obj) },
+    { MP_ROM_QSTR(MP_QSTR_store_erase), MP_ROM_PTR(&py_nn_store_erase_obj) },
 #else
-    { MP_ROM_QSTR(MP_QSTR_load),     MP_ROM_PTR(&py_func_unavailable_obj) }
+    { MP_ROM_QSTR(MP_QSTR_load),     MP_ROM_PTR(&py_func_unavailable_obj) },
+    { MP_ROM_QSTR(MP_QSTR_store),    MP_ROM_PTR(&py_func_unavailable_obj) },
+    { MP_ROM_QSTR(MP_QSTR_store_list), MP_ROM_PTR(&py_func_unavailable_obj) },
+    { MP_ROM_QSTR(MP_QSTR_store_erase), MP_ROM_PTR(&py_func_unavailable_obj) }
 #endif // IMLIB_ENABLE_CNN
 };
 
@@ -4,7 +4,20 @@
  */
 #include <mp.h>
 #include "usbdbg.h"
+#include "fb_alloc.h"
+#include "xalloc.h"
+#include "umm_malloc.h"
 #include "omv_boardconfig.h"
+#include "py_helper.h"
+#include "py_assert.h"
+#include "stream_server.h"
+#include "py_image.h"
+#include "task.h"
+#include "perf.h"
+#include "perf_profile.h"
+#include "sensor.h"
+#include "py/stream.h"
+#include "py/mperrno.h"
 
 static mp_obj_t py_omv_version_string()
 {
@@ -42,6 +55,271 @@ static mp_obj_t py_omv_board_id()
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_omv_board_id_obj, py_omv_board_id);
 
+static mp_obj_t py_omv_fb_stats_dict(fb_alloc_stats_t *stats)
+{
+    mp_obj_t dict = mp_obj_new_dict(0);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_bytes),  mp_obj_new_int_from_uint(stats->bytes));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_peak),   mp_obj_new_int_from_uint(stats->peak));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_allocs), mp_obj_new_int_from_uint(stats->allocs));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_fails),  mp_obj_new_int_from_uint(stats->fails));
+    return dict;
+}
+
+static mp_obj_t py_omv_fb_stats()
+{
+    fb_alloc_stats_t total, depths[FB_ALLOC_STATS_DEPTHS];
+    int n = fb_alloc_get_stats(&total, depths);
+    mp_obj_t dict = py_omv_fb_stats_dict(&total);
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (int i = 0; i < n; i++) {
+        mp_obj_list_append(list, py_omv_fb_stats_dict(&depths[i]));
+    }
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_avail),  mp_obj_new_int_from_uint(fb_avail()));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_depths), list);
+    return dict;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_omv_fb_stats_obj, py_omv_fb_stats);
+
+static mp_obj_t py_omv_fb_reset_peak()
+{
+    fb_alloc_reset_peak();
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_omv_fb_reset_peak_obj, py_omv_fb_reset_peak);
+
+static mp_obj_t py_omv_umm_stats()
+{
+    umm_stats_t stats;
+    umm_get_stats(&stats);
+    mp_obj_t dict = mp_obj_new_dict(0);
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (int i = 0; i < UMM_SLAB_CLASSES; i++) {
+        mp_obj_list_append(list, mp_obj_new_int_from_uint(stats.slab_in_use[i]));
+    }
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_heap),          mp_obj_new_int_from_uint(stats.heap_bytes));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_used),          mp_obj_new_int_from_uint(stats.used_bytes));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_peak),          mp_obj_new_int_from_uint(stats.peak_bytes));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_allocs),        mp_obj_new_int_from_uint(stats.allocs));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_slab_allocs),   mp_obj_new_int_from_uint(stats.slab_allocs));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_fails),         mp_obj_new_int_from_uint(stats.fails));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_free),          mp_obj_new_int_from_uint(stats.free_bytes));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_free_blocks),   mp_obj_new_int_from_uint(stats.free_blocks));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_largest_free),  mp_obj_new_int_from_uint(stats.largest_free));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_slab_pages),    mp_obj_new_int_from_uint(stats.slab_pages));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_slab_used),     mp_obj_new_int_from_uint(stats.slab_pages_used));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_slab_in_use),   list);
+    return dict;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_omv_umm_stats_obj, py_omv_umm_stats);
+
+#ifdef OMV_ENABLE_STREAM_SERVER
+static mp_obj_t py_omv_stream_server(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    int arg_q = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_quality), 50);
+    int clients = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_clients), 2);
+    int frame_size = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_frame_size), 32*1024);
+    PY_ASSERT_TRUE_MSG((clients > 0) && (clients <= STREAM_SERVER_MAX_CLIENTS), "Invalid number of clients");
+    PY_ASSERT_TRUE_MSG(frame_size >= JPEG_SINK_BUF_MIN, "Invalid size");
+    stream_server_start(mp_obj_get_int(args[0]), IM_MIN(IM_MAX(arg_q, 1), 100), clients, frame_size);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_omv_stream_server_obj, 1, py_omv_stream_server);
+
+static mp_obj_t py_omv_stream_stop()
+{
+    stream_server_stop();
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_omv_stream_stop_obj, py_omv_stream_stop);
+
+static mp_obj_t py_omv_stream_clients()
+{
+    return mp_obj_new_int(stream_server_clients());
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_omv_stream_clients_obj, py_omv_stream_clients);
+#endif
+
+typedef struct py_omv_future_obj {
+    mp_obj_base_t base;
+    task_t *task;
+    mp_obj_t image;
+} py_omv_future_obj_t;
+
+static mp_obj_t py_omv_future_done(mp_obj_t self_in)
+{
+    task_t *task = ((py_omv_future_obj_t *) self_in)->task;
+    return mp_obj_new_bool(task->state >= TASK_DONE);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_omv_future_done_obj, py_omv_future_done);
+
+static mp_obj_t py_omv_future_result(uint n_args, const mp_obj_t *args)
+{
+    py_omv_future_obj_t *self = args[0];
+    task_t *task = self->task;
+    int timeout = (n_args > 1) ? mp_obj_get_int(args[1]) : -1;
+
+    for (uint32_t start = mp_hal_ticks_ms(); task->state < TASK_DONE; ) {
+        if ((timeout >= 0) && ((mp_hal_ticks_ms() - start) >= timeout)) {
+            mp_raise_OSError(MP_ETIMEDOUT);
+        }
+        MICROPY_EVENT_POLL_HOOK
+    }
+
+    if (task->state == TASK_FAILED) {
+        mp_raise_OSError(task->error);
+    }
+    switch (task->op) {
+        case TASK_COMPRESS:
+            // Once, later calls get the same image.
+            if (self->image == MP_OBJ_NULL) {
+                task->out.pixels = xrealloc(task->out.pixels, task->out.bpp);
+                task->img.pixels = NULL;
+                self->image = py_image_from_struct(&task->out);
+            }
+            return self->image;
+        case TASK_WRITE:
+            return mp_obj_new_int(task->sent);
+        default:
+            return mp_const_none;
+    }
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_omv_future_result_obj, 1, 2, py_omv_future_result);
+
+STATIC const mp_rom_map_elem_t py_omv_future_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_done),    MP_ROM_PTR(&py_omv_future_done_obj) },
+    { MP_ROM_QSTR(MP_QSTR_result),  MP_ROM_PTR(&py_omv_future_result_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(py_omv_future_locals_dict, py_omv_future_locals_dict_table);
+
+static const mp_obj_type_t py_omv_future_type = {
+    { &mp_type_type },
+    .name  = MP_QSTR_Future,
+    .locals_dict = (mp_obj_t) &py_omv_future_locals_dict,
+};
+
+// Runs func(*args) in the background, func being one of image.compress(), compressed(), save()
+// to a .jpg file, or the write() or send() of a stream (file or socket). Returns a Future.
+static mp_obj_t py_omv_submit(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    mp_obj_t meth, self;
+    PY_ASSERT_TRUE_MSG(mp_obj_bound_meth_get(args[0], &meth, &self), "Expected a bound method!");
+
+    // The methods get self first, as they would if called.
+    mp_obj_t *meth_args = m_new(mp_obj_t, n_args);
+    meth_args[0] = self;
+    memcpy(meth_args + 1, args + 1, (n_args - 1) * sizeof(mp_obj_t));
+
+    task_t *task = py_image_submit(meth, n_args, meth_args, kw_args);
+    m_del(mp_obj_t, meth_args, n_args);
+    if ((task == NULL) && (n_args == 2)) {
+        mp_obj_t dest[2];
+        mp_load_method_maybe(self, MP_QSTR_write, dest);
+        bool is_write = (dest[0] == meth);
+        mp_load_method_maybe(self, MP_QSTR_send, dest);
+        if (is_write || (dest[0] == meth)) {
+            mp_get_stream_raise(self, MP_STREAM_OP_WRITE);
+            // A copy, the buffer is the script's again right away.
+            mp_buffer_info_t bufinfo;
+            mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_READ);
+            task = task_new(TASK_WRITE);
+            task->stream = self;
+            task->len = bufinfo.len;
+            task->data = memcpy(xalloc(IM_MAX(bufinfo.len, 1)), bufinfo.buf, bufinfo.len);
+            task_submit(task);
+        }
+    }
+    PY_ASSERT_TRUE_MSG(task != NULL, "This can't run in the background!");
+
+    py_omv_future_obj_t *o = m_new_obj(py_omv_future_obj_t);
+    o->base.type = &py_omv_future_type;
+    o->task = task;
+    o->image = MP_OBJ_NULL;
+    return o;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_omv_submit_obj, 1, py_omv_submit);
+
+// perf(reset=False): {name: (calls, total_us, max_us)} of the OMV_PROF_SCOPE()s run since
+// the last reset, empty without OMV_ENABLE_PERF. reset=True zeroes the counts after reading.
+static mp_obj_t py_omv_perf(size_t n_args, const mp_obj_t *args)
+{
+    mp_obj_t dict = mp_obj_new_dict(0);
+#if defined(OMV_ENABLE_PERF) && defined(__GNUC__)
+    uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    for (omv_perf_t *scope = omv_perf_list(); scope; scope = scope->next) {
+        if (!scope->calls) {
+            continue;
+        }
+        mp_obj_t tuple[3] = {
+            mp_obj_new_int_from_uint(scope->calls),
+            mp_obj_new_int_from_ull(scope->cycles / cycles_per_us),
+            mp_obj_new_int_from_uint(scope->cycles_max / cycles_per_us),
+        };
+        mp_obj_dict_store(dict, mp_obj_new_str(scope->name, strlen(scope->name)), mp_obj_new_tuple(3, tuple));
+    }
+#endif
+    if (n_args && mp_obj_is_true(args[0])) {
+        omv_perf_reset();
+    }
+    return dict;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_omv_perf_obj, 0, 1, py_omv_perf);
+
+// overlay_stats(reset=False): {name: (calls, loads, prefetches, bytes, us)} of the overlays,
+// loads being the calls that had to copy something in. reset=True zeroes them after reading.
+static mp_obj_t py_omv_overlay_stats(size_t n_args, const mp_obj_t *args)
+{
+    static const qstr names[OVLY_COUNT] = {
+        [OVLY_LAB_TAB] = MP_QSTR_lab_tab, [OVLY_HAAR] = MP_QSTR_haar, [OVLY_FLASHPGM] = MP_QSTR_flashpgm,
+    };
+    uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    mp_obj_t dict = mp_obj_new_dict(0);
+    for (int i = 0; i < OVLY_COUNT; i++) {
+        ovly_stats_t st;
+        OverlayGetStats(i, &st);
+        if (!names[i] || !st.calls) {
+            continue;
+        }
+        mp_obj_t tuple[5] = {
+            mp_obj_new_int_from_uint(st.calls),
+            mp_obj_new_int_from_uint(st.loads),
+            mp_obj_new_int_from_uint(st.prefetches),
+            mp_obj_new_int_from_uint(st.bytes),
+            mp_obj_new_int_from_uint(st.cycles / cycles_per_us),
+        };
+        mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(names[i]), mp_obj_new_tuple(5, tuple));
+    }
+    if (n_args && mp_obj_is_true(args[0])) {
+        OverlayResetStats();
+    }
+    return dict;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_omv_overlay_stats_obj, 0, 1, py_omv_overlay_stats);
+
+// set_perf_profile(name): switches the SDRAM, flash and sensor clocks to "default", "turbo"
+// or "eco" and checks SDRAM and flash reads with them. The sensor is stopped first, it restarts
+// with the profile's clock on the next sensor.reset(). OSError if the check failed, the
+// profile in use is kept then.
+static mp_obj_t py_omv_set_perf_profile(mp_obj_t name_obj)
+{
+    const char *name = mp_obj_str_get_str(name_obj);
+    sensor_abort();
+    int ret = perf_profile_set(name);
+    if (ret == -1) {
+        nlr_raise(mp_obj_new_exception_msg_varg(&mp_type_ValueError, "unknown profile %s", name));
+    } else if (ret) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_omv_set_perf_profile_obj, py_omv_set_perf_profile);
+
+static mp_obj_t py_omv_get_perf_profile()
+{
+    const char *name = perf_profile_get();
+    return mp_obj_new_str(name, strlen(name));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_omv_get_perf_profile_obj, py_omv_get_perf_profile);
+
 static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__),        MP_OBJ_NEW_QSTR(MP_QSTR_omv) },
     { MP_ROM_QSTR(MP_QSTR_version_major),   MP_ROM_INT(FIRMWARE_VERSION_MAJOR) },
@@ -50,7 +328,20 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_version_string),  MP_ROM_PTR(&py_omv_version_string_obj) },
     { MP_ROM_QSTR(MP_QSTR_arch),            MP_ROM_PTR(&py_omv_arch_obj) },
     { MP_ROM_QSTR(MP_QSTR_board_type),      MP_ROM_PTR(&py_omv_board_type_obj) },
-    { MP_ROM_QSTR(MP_QSTR_board_id),        MP_ROM_PTR(&py_omv_board_id_obj) }
+    { MP_ROM_QSTR(MP_QSTR_board_id),        MP_ROM_PTR(&py_omv_board_id_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fb_stats),        MP_ROM_PTR(&py_omv_fb_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fb_reset_peak),   MP_ROM_PTR(&py_omv_fb_reset_peak_obj) },
+    { MP_ROM_QSTR(MP_QSTR_umm_stats),       MP_ROM_PTR(&py_omv_umm_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_submit),          MP_ROM_PTR(&py_omv_submit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_perf),            MP_ROM_PTR(&py_omv_perf_obj) },
+    { MP_ROM_QSTR(MP_QSTR_overlay_stats),   MP_ROM_PTR(&py_omv_overlay_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_perf_profile), MP_ROM_PTR(&py_omv_set_perf_profile_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_perf_profile), MP_ROM_PTR(&py_omv_get_perf_profile_obj) },
+#ifdef OMV_ENABLE_STREAM_SERVER
+    { MP_ROM_QSTR(MP_QSTR_stream_server),   MP_ROM_PTR(&py_omv_stream_server_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stream_stop),     MP_ROM_PTR(&py_omv_stream_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stream_clients),  MP_ROM_PTR(&py_omv_stream_clients_obj) },
+#endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
@@ -8,6 +8,8 @@
  */
 #include <stdarg.h>
 #include "mp.h"
+#include "py/stream.h"
+#include "py/mperrno.h"
 #include "pin.h"
 #include "sensor.h"
 #include "imlib.h"
@@ -19,11 +21,24 @@
 #include "py_helper.h"
 #include "framebuffer.h"
 #include "systick.h"
+#include "usbdbg.h"
+#include "modmachine.h"
 
 extern sensor_t s_sensor;
 
+// Under the IDE's hot reload, and after a machine.soft_reset(True), sensor.reset() keeps the
+// sensor as the previous script left it once it was reset for real, and the skip_frames()
+// after it has nothing to wait for.
+static bool sensor_is_hot;
+static bool sensor_skip_once;
+
 static mp_obj_t py_sensor_reset() {
+    if ((usbdbg_get_hot_reload() || machine_fast_reset) && sensor_is_hot) {
+        sensor_skip_once = true;
+        return mp_const_none;
+    }
     PY_ASSERT_FALSE_MSG(sensor_reset() != 0, "Reset Failed");
+    sensor_is_hot = true;
     return mp_const_none;
 }
 
@@ -46,14 +61,33 @@ static mp_obj_t py_sensor_flush() {
     return mp_const_none;
 }
 
+static fb_slot_t *py_sensor_slot(mp_obj_t obj) {
+    fb_slot_t *slot = MP_OBJ_IS_STR(obj) ? fb_slot_find(mp_obj_str_get_str(obj))
+                                         : fb_slot_from_pixels(((image_t *) py_image_cobj(obj))->pixels);
+    if (!slot) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "No such frame slot!"));
+    }
+    return slot;
+}
+
 static mp_obj_t py_sensor_snapshot(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    // Snapshot image
-   mp_obj_t image = py_image(0, 0, 0, 0);
+    // Snapshot image, into a frame slot (by name or slot image) if asked to
+    mp_obj_t into = py_helper_keyword_object(n_args, args, 0, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_into));
+    fb_slot_t *slot = into ? py_sensor_slot(into) : NULL;
+    mp_obj_t image = (into && !MP_OBJ_IS_STR(into)) ? into : py_image(0, 0, 0, 0);
+    int ret;
+
+    if (slot) {
+        ret = sensor_snapshot_into((image_t*) py_image_cobj(image), slot->pixels, slot->size);
+    } else {
+        ret = sensor_snapshot(&s_sensor, (image_t*) py_image_cobj(image), NULL);
+    }
 
-    // Sanity checks
-    PY_ASSERT_TRUE_MSG((s_sensor.pixformat != PIXFORMAT_JPEG), "Operation not supported on JPEG");
+    if (ret == -2) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Frame does not fit in the slot!"));
+    }
 
-    if (sensor_snapshot(&s_sensor, (image_t*) py_image_cobj(image), NULL)==-1) {
+    if (ret == -1) {
         nlr_raise(mp_obj_new_exception_msg(&mp_type_RuntimeError, "Sensor Timeout!!"));
         return mp_const_false;
 	}
@@ -61,6 +95,123 @@ static mp_obj_t py_sensor_snapshot(uint n_args, const mp_obj_t *args, mp_map_t *
    return image;
 }
 
+static mp_obj_t py_sensor_alloc_slot(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    const char *name = mp_obj_str_get_str(args[0]);
+    int w = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_w), MAIN_FB()->w);
+    int h = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_h), MAIN_FB()->h);
+    int pixformat = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_pixformat), s_sensor.pixformat);
+
+    PY_ASSERT_TRUE_MSG((w > 0) && (h > 0), "Set the frame size first or pass w and h!");
+    PY_ASSERT_TRUE_MSG((pixformat == PIXFORMAT_GRAYSCALE) || (pixformat == PIXFORMAT_RGB565),
+            "Slots are GRAYSCALE or RGB565!");
+    if (fb_slot_find(name)) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Frame slot already exists!"));
+    }
+
+    fb_slot_t *slot = fb_slot_alloc(name, w, h, (pixformat == PIXFORMAT_GRAYSCALE) ? IMAGE_BPP_GRAYSCALE : IMAGE_BPP_RGB565);
+    if (!slot) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_MemoryError, "No room for another frame slot!"));
+    }
+    return py_image(slot->w, slot->h, slot->bpp, slot->pixels);
+}
+
+static mp_obj_t py_sensor_get_slot(mp_obj_t name) {
+    fb_slot_t *slot = py_sensor_slot(name);
+    return py_image(slot->w, slot->h, slot->bpp, slot->pixels);
+}
+
+static mp_obj_t py_sensor_free_slots() {
+    PY_ASSERT_TRUE_MSG(fb_slot_free_all(), "Frame buffer stack in use!");
+    return mp_const_none;
+}
+
+// What sensor.snapshot_async() returns: pollable, readable once the frame is in, and awaitable
+// under uasyncio, which then waits for it in poll() (WFI) and gets the image of snapshot().
+typedef enum {
+    CAPTURE_IDLE,
+    CAPTURE_WAITING,    // IORead given to the loop
+    CAPTURE_COLLECT,    // IOReadDone given, the image is next
+} py_sensor_capture_state_t;
+
+static py_sensor_capture_state_t capture_state;
+
+static mp_obj_t py_sensor_capture_call(qstr name, mp_obj_t self_in)
+{
+    mp_obj_t uasyncio = mp_import_name(MP_QSTR_uasyncio, mp_const_none, MP_OBJ_NEW_SMALL_INT(0));
+    return mp_call_function_1(mp_load_attr(uasyncio, name), self_in);
+}
+
+static mp_obj_t py_sensor_capture_iternext(mp_obj_t self_in)
+{
+    if (capture_state == CAPTURE_IDLE) {
+        sensor_snapshot_async();
+    }
+
+    if (!sensor_snapshot_ready()) {
+        capture_state = CAPTURE_WAITING;
+        return py_sensor_capture_call(MP_QSTR_IORead, self_in);
+    }
+
+    if (capture_state == CAPTURE_WAITING) {
+        // Off the poller again before the coroutine goes on.
+        capture_state = CAPTURE_COLLECT;
+        return py_sensor_capture_call(MP_QSTR_IOReadDone, self_in);
+    }
+
+    capture_state = CAPTURE_IDLE;
+    mp_map_t kw_args;
+    mp_map_init(&kw_args, 0);
+    nlr_raise(mp_obj_new_exception_arg1(&mp_type_StopIteration, py_sensor_snapshot(0, NULL, &kw_args)));
+}
+
+static mp_uint_t py_sensor_capture_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_t arg, int *errcode)
+{
+    if (request == MP_STREAM_POLL) {
+        return ((arg & MP_STREAM_POLL_RD) && sensor_snapshot_ready()) ? MP_STREAM_POLL_RD : 0;
+    } else if (request == MP_STREAM_POLL_NOTIFY) {
+        return MP_STREAM_POLL_RD;
+    }
+    *errcode = MP_EINVAL;
+    return MP_STREAM_ERROR;
+}
+
+static const mp_stream_p_t py_sensor_capture_stream_p = {
+    .ioctl = py_sensor_capture_ioctl,
+};
+
+static const mp_obj_type_t py_sensor_capture_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Capture,
+    .getiter = mp_identity_getiter,
+    .iternext = py_sensor_capture_iternext,
+    .protocol = &py_sensor_capture_stream_p,
+};
+
+const mp_obj_base_t py_sensor_capture_obj = { &py_sensor_capture_type };
+
+static mp_obj_t py_sensor_snapshot_async() {
+    sensor_snapshot_async();
+    capture_state = CAPTURE_IDLE;
+    return MP_OBJ_FROM_PTR(&py_sensor_capture_obj);
+}
+
+static mp_obj_t py_sensor_set_frame_callback(mp_obj_t cb) {
+    if (cb != mp_const_none && !mp_obj_is_callable(cb)) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Invalid callback object!"));
+    }
+    MP_STATE_PORT(sensor_frame_cb) = cb;
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_get_frame_info() {
+    uint32_t seq, stamp_us, dropped;
+    sensor_get_frame_info(&seq, &stamp_us, &dropped);
+    return mp_obj_new_tuple(3, (mp_obj_t []) {
+        mp_obj_new_int_from_uint(seq),
+        mp_obj_new_int_from_uint(stamp_us),
+        mp_obj_new_int_from_uint(dropped)});
+}
+
 static mp_obj_t py_sensor_skip_frames(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
 {
     mp_map_elem_t *kw_arg = mp_map_lookup(kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_time), MP_MAP_LOOKUP);
@@ -72,6 +223,11 @@ static mp_obj_t py_sensor_skip_frames(uint n_args, const mp_obj_t *args, mp_map_
 
     uint32_t millis = systick_current_millis();
 
+    if (sensor_skip_once) {
+        sensor_skip_once = false;
+        return mp_const_none;
+    }
+
     if (!n_args) {
         while ((systick_current_millis() - millis) < time) { // 32-bit math handles wrap arrounds...
             if (sensor_snapshot(&s_sensor, NULL, NULL) == -1) {
@@ -168,6 +324,9 @@ static mp_obj_t py_sensor_dealloc_extra_fb()
 }
 
 static mp_obj_t py_sensor_set_pixformat(mp_obj_t pixformat) {
+    if (mp_obj_get_int(pixformat) != s_sensor.pixformat) {
+        sensor_skip_once = false;
+    }
     if (sensor_set_pixformat(mp_obj_get_int(pixformat)) != 0) {
         PY_ASSERT_TRUE_MSG(0, "Pixel format is not supported!");
     }
@@ -205,12 +364,23 @@ static mp_obj_t py_sensor_set_framerate(mp_obj_t framerate) {
 }
 
 static mp_obj_t py_sensor_set_framesize(mp_obj_t framesize) {
+    // a hot sensor that changes size does need its frames skipped
+    if (mp_obj_get_int(framesize) != s_sensor.framesize) {
+        sensor_skip_once = false;
+    }
     if (sensor_set_framesize(mp_obj_get_int(framesize)) != 0) {
         nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Failed to set framesize!"));
     }
     return mp_const_true;
 }
 
+static mp_obj_t py_sensor_set_mode(mp_obj_t framesize, mp_obj_t pixformat) {
+    if (sensor_set_mode(mp_obj_get_int(framesize), mp_obj_get_int(pixformat)) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Failed to set mode!"));
+    }
+    return mp_const_true;
+}
+
 static mp_obj_t py_sensor_set_windowing(mp_obj_t roi_obj) {
     int x, y, w, h;
     int res_w = resolution[s_sensor.framesize][0];
@@ -252,6 +422,138 @@ static mp_obj_t py_sensor_set_windowing(mp_obj_t roi_obj) {
     return mp_const_true;
 }
 
+static mp_obj_t py_sensor_set_framebuffers(mp_obj_t count) {
+    if (sensor_set_framebuffers(mp_obj_get_int(count)) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Invalid number of framebuffers!"));
+    }
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_get_framebuffers() {
+    return mp_obj_new_int(sensor_get_framebuffers());
+}
+
+static mp_obj_t py_sensor_stats(uint n_args, const mp_obj_t *args) {
+    sensor_stats_t stats;
+    sensor_get_stats(&stats, (n_args > 0) && mp_obj_is_true(args[0]));
+    mp_obj_t dict = mp_obj_new_dict(0);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_frames),          mp_obj_new_int_from_uint(stats.frames));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_dropped),         mp_obj_new_int_from_uint(stats.dropped));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_fifo_overflows),  mp_obj_new_int_from_uint(stats.fifo_overflows));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_fragment_misses), mp_obj_new_int_from_uint(stats.fragment_misses));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_irq_cycles_max),  mp_obj_new_int_from_uint(stats.irq_cycles_max));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_irq_cycles_mean), mp_obj_new_int_from_uint(stats.irq_cycles_mean));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_jpeg_ms),         mp_obj_new_int_from_uint(stats.jpeg_ms));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_wait_us),         mp_obj_new_int_from_uint(stats.wait_us));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_wait_us_total),   mp_obj_new_int_from_ull(stats.wait_us_total));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_run_us_total),    mp_obj_new_int_from_ull(stats.run_us_total));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_run_uj_total),    mp_obj_new_int_from_ull(stats.run_uj_total));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_wait_uj_total),   mp_obj_new_int_from_ull(stats.wait_uj_total));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_uj_per_frame),    mp_obj_new_int_from_uint(stats.uj_per_frame));
+    return dict;
+}
+
+static mp_obj_t py_sensor_set_low_power(uint n_args, const mp_obj_t *args) {
+    int div = (n_args > 1) ? mp_obj_get_int(args[1]) : 2;
+    if (sensor_set_low_power(mp_obj_get_int(args[0]), div) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Invalid mode or divider!"));
+    }
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_set_usb_irq_in_snapshot(mp_obj_t enable) {
+    sensor_set_usb_irq_in_snapshot(mp_obj_is_true(enable));
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_set_motion_detect(uint n_args, const mp_obj_t *args) {
+    int threshold = (n_args > 1) ? mp_obj_get_int(args[1]) : 8;
+    if (sensor_set_motion_detect(mp_obj_is_true(args[0]), threshold) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Invalid threshold!"));
+    }
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_get_motion_mask() {
+    int w, h;
+    if (sensor_get_motion_mask(NULL, &w, &h) < 0) {
+        return mp_const_none;
+    }
+    uint8_t *mask = xalloc(w * h);
+    if (sensor_get_motion_mask(mask, &w, &h) < 0) {
+        xfree(mask);
+        return mp_const_none;
+    }
+    return py_image(w, h, IMAGE_BPP_GRAYSCALE, mask);
+}
+
+static mp_obj_t py_sensor_set_delta_preview(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    int keyframe_interval = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_keyframe_interval), 30);
+    int threshold = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 4);
+    if (fb_set_delta_preview(mp_obj_is_true(args[0]), keyframe_interval, threshold) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Invalid interval or threshold!"));
+    }
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_set_lcd_direct(mp_obj_t enable) {
+    PY_ASSERT_FALSE_MSG(sensor_set_lcd_direct(mp_obj_is_true(enable)) != 0, "No LCD monitor on this board");
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_set_gray_lut(mp_obj_t lut) {
+    if (lut == mp_const_none) {
+        sensor_set_gray_lut(NULL);
+    } else {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(lut, &bufinfo, MP_BUFFER_READ);
+        PY_ASSERT_TRUE_MSG(bufinfo.len == 256, "Lookup table must be 256 bytes!");
+        sensor_set_gray_lut(bufinfo.buf);
+    }
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_set_soft_auto_exposure(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    int target = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_target), 110);
+    int max_exposure_us = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_exposure_us), 33333);
+    float gain_db_ceiling = py_helper_keyword_float(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_gain_db_ceiling), 24.0f);
+    if (sensor_set_soft_auto_exposure(mp_obj_is_true(args[0]), target, max_exposure_us, gain_db_ceiling) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Sensor control failed!"));
+    }
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_set_auto_exposure_roi(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    int roi[4] = {0, 0, 0, 0};
+    py_helper_keyword_int_array(n_args, args, 0, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_roi), roi, 4);
+    int weight = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_weight), 8);
+    if (sensor_set_auto_exposure_roi(roi[0], roi[1], roi[2], roi[3], weight) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Invalid ROI or weight!"));
+    }
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_get_luma_histogram() {
+    uint32_t bins[SENSOR_LUMA_HIST_BINS];
+    int mean;
+    if (sensor_get_luma_histogram(bins, &mean) != 0) {
+        return mp_const_none;
+    }
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (int i = 0; i < SENSOR_LUMA_HIST_BINS; i++) {
+        mp_obj_list_append(list, mp_obj_new_int(bins[i]));
+    }
+    return mp_obj_new_tuple(2, (mp_obj_t []) {mp_obj_new_int(mean), list});
+}
+
+static mp_obj_t py_sensor_set_gray_gain(uint n_args, const mp_obj_t *args) {
+    int offset = (n_args > 1) ? mp_obj_get_int(args[1]) : 0;
+    if (sensor_set_gray_gain(mp_obj_get_float(args[0]), offset) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Invalid gain!"));
+    }
+    return mp_const_none;
+}
+
 static mp_obj_t py_sensor_set_gainceiling(mp_obj_t gainceiling) {
     gainceiling_t gain;
     switch (mp_obj_get_int(gainceiling)) {
@@ -556,6 +858,29 @@ static mp_obj_t py_sensor_ioctl(uint n_args, const mp_obj_t *args)
             break;
         }
 
+        case IOCTL_LEPTON_GET_FRAME: {
+            // No copy, the buffer is the capture's and changes with the next snapshot.
+            uint8_t *frame;
+            int width, height;
+            if (sensor_ioctl(request, &frame) != 0
+                || sensor_ioctl(IOCTL_LEPTON_GET_WIDTH, &width) != 0
+                || sensor_ioctl(IOCTL_LEPTON_GET_HEIGHT, &height) != 0) {
+                nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Sensor control failed!"));
+            }
+            ret_obj = mp_obj_new_bytearray_by_ref(width * height * sizeof(uint16_t), frame);
+            break;
+        }
+
+        case IOCTL_LEPTON_GET_STATS: {
+            uint32_t frames, crc_errors, resyncs;
+            if (sensor_ioctl(request, &frames, &crc_errors, &resyncs) != 0) {
+                nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Sensor control failed!"));
+            }
+            ret_obj = mp_obj_new_tuple(3, (mp_obj_t []) {mp_obj_new_int_from_uint(frames),
+                mp_obj_new_int_from_uint(crc_errors), mp_obj_new_int_from_uint(resyncs)});
+            break;
+        }
+
         default: {
             nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Operation not supported!"));
             break;
@@ -610,6 +935,9 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_shutdown_obj,            py_sensor_sh
 STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_flush_obj,               py_sensor_flush);
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_sensor_snapshot_obj, 0,        py_sensor_snapshot);
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_sensor_skip_frames_obj, 0,     py_sensor_skip_frames);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_snapshot_async_obj,      py_sensor_snapshot_async);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_frame_callback_obj,  py_sensor_set_frame_callback);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_frame_info_obj,      py_sensor_get_frame_info);
 STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_width_obj,               py_sensor_width);
 STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_height_obj,              py_sensor_height);
 STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_fb_obj,              py_sensor_get_fb);
@@ -619,7 +947,25 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_dealloc_extra_fb_obj,    py_sensor_de
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_pixformat_obj,       py_sensor_set_pixformat);
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_framerate_obj,       py_sensor_set_framerate);
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_framesize_obj,       py_sensor_set_framesize);
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(py_sensor_set_mode_obj,            py_sensor_set_mode);
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_windowing_obj,       py_sensor_set_windowing);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_framebuffers_obj,    py_sensor_set_framebuffers);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_framebuffers_obj,    py_sensor_get_framebuffers);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_sensor_stats_obj, 0, 1, py_sensor_stats);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_usb_irq_in_snapshot_obj, py_sensor_set_usb_irq_in_snapshot);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_sensor_set_low_power_obj, 1, 2, py_sensor_set_low_power);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_sensor_set_motion_detect_obj, 1, 2, py_sensor_set_motion_detect);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_motion_mask_obj,     py_sensor_get_motion_mask);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_sensor_set_delta_preview_obj, 1, py_sensor_set_delta_preview);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_lcd_direct_obj,      py_sensor_set_lcd_direct);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_gray_lut_obj,        py_sensor_set_gray_lut);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_sensor_set_soft_auto_exposure_obj, 1, py_sensor_set_soft_auto_exposure);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_sensor_set_auto_exposure_roi_obj, 0, py_sensor_set_auto_exposure_roi);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_luma_histogram_obj,  py_sensor_get_luma_histogram);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_sensor_alloc_slot_obj, 1,      py_sensor_alloc_slot);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_get_slot_obj,            py_sensor_get_slot);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_free_slots_obj,          py_sensor_free_slots);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_sensor_set_gray_gain_obj, 1, 2, py_sensor_set_gray_gain);
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_gainceiling_obj,     py_sensor_set_gainceiling);
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_contrast_obj,        py_sensor_set_contrast);
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_brightness_obj,      py_sensor_set_brightness);
@@ -657,6 +1003,11 @@ STATIC const mp_map_elem_t globals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_MT9V034),             MP_OBJ_NEW_SMALL_INT(MT9V034_ID)},
     { MP_OBJ_NEW_QSTR(MP_QSTR_LEPTON),              MP_OBJ_NEW_SMALL_INT(LEPTON_ID)},
 
+    // Capture waits
+    { MP_OBJ_NEW_QSTR(MP_QSTR_LP_OFF),              MP_OBJ_NEW_SMALL_INT(SENSOR_LP_OFF)},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_LP_WFI),              MP_OBJ_NEW_SMALL_INT(SENSOR_LP_WFI)},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_LP_SCALE),            MP_OBJ_NEW_SMALL_INT(SENSOR_LP_SCALE)},
+
     // Special effects
     { MP_OBJ_NEW_QSTR(MP_QSTR_NORMAL),              MP_OBJ_NEW_SMALL_INT(SDE_NORMAL)},          /* Normal/No SDE */
     { MP_OBJ_NEW_QSTR(MP_QSTR_NEGATIVE),            MP_OBJ_NEW_SMALL_INT(SDE_NEGATIVE)},        /* Negative image */
@@ -698,6 +1049,11 @@ STATIC const mp_map_elem_t globals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_WQXGA),               MP_OBJ_NEW_SMALL_INT(FRAMESIZE_WQXGA)},    /* 2560x1600 */
     { MP_OBJ_NEW_QSTR(MP_QSTR_WQXGA2),              MP_OBJ_NEW_SMALL_INT(FRAMESIZE_WQXGA2)},   /* 2592x1944 */
 
+    // Framebuffers
+    { MP_OBJ_NEW_QSTR(MP_QSTR_SINGLE_BUFFER),       MP_OBJ_NEW_SMALL_INT(1)},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_DOUBLE_BUFFER),       MP_OBJ_NEW_SMALL_INT(2)},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_TRIPLE_BUFFER),       MP_OBJ_NEW_SMALL_INT(3)},
+
     // Color Palettes
     { MP_OBJ_NEW_QSTR(MP_QSTR_PALETTE_RAINBOW),     MP_OBJ_NEW_SMALL_INT(COLOR_PALETTE_RAINBOW)},
     { MP_OBJ_NEW_QSTR(MP_QSTR_PALETTE_IRONBOW),     MP_OBJ_NEW_SMALL_INT(COLOR_PALETTE_IRONBOW)},
@@ -719,6 +1075,8 @@ STATIC const mp_map_elem_t globals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_IOCTL_LEPTON_GET_MEASUREMENT_MODE),   MP_OBJ_NEW_SMALL_INT(IOCTL_LEPTON_GET_MEASUREMENT_MODE)},
     { MP_OBJ_NEW_QSTR(MP_QSTR_IOCTL_LEPTON_SET_MEASUREMENT_RANGE),  MP_OBJ_NEW_SMALL_INT(IOCTL_LEPTON_SET_MEASUREMENT_RANGE)},
     { MP_OBJ_NEW_QSTR(MP_QSTR_IOCTL_LEPTON_GET_MEASUREMENT_RANGE),  MP_OBJ_NEW_SMALL_INT(IOCTL_LEPTON_GET_MEASUREMENT_RANGE)},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_IOCTL_LEPTON_GET_FRAME),              MP_OBJ_NEW_SMALL_INT(IOCTL_LEPTON_GET_FRAME)},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_IOCTL_LEPTON_GET_STATS),              MP_OBJ_NEW_SMALL_INT(IOCTL_LEPTON_GET_STATS)},
 
     // Sensor functions
     { MP_OBJ_NEW_QSTR(MP_QSTR_reset),               (mp_obj_t)&py_sensor_reset_obj },
@@ -727,6 +1085,9 @@ STATIC const mp_map_elem_t globals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_flush),               (mp_obj_t)&py_sensor_flush_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_snapshot),            (mp_obj_t)&py_sensor_snapshot_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_skip_frames),         (mp_obj_t)&py_sensor_skip_frames_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_snapshot_async),      (mp_obj_t)&py_sensor_snapshot_async_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_frame_callback),  (mp_obj_t)&py_sensor_set_frame_callback_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_frame_info),      (mp_obj_t)&py_sensor_get_frame_info_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_width),               (mp_obj_t)&py_sensor_width_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_height),              (mp_obj_t)&py_sensor_height_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_fb),              (mp_obj_t)&py_sensor_get_fb_obj },
@@ -736,7 +1097,25 @@ STATIC const mp_map_elem_t globals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_pixformat),       (mp_obj_t)&py_sensor_set_pixformat_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_framerate),       (mp_obj_t)&py_sensor_set_framerate_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_framesize),       (mp_obj_t)&py_sensor_set_framesize_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_mode),            (mp_obj_t)&py_sensor_set_mode_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_windowing),       (mp_obj_t)&py_sensor_set_windowing_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_framebuffers),    (mp_obj_t)&py_sensor_set_framebuffers_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_framebuffers),    (mp_obj_t)&py_sensor_get_framebuffers_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_gray_lut),        (mp_obj_t)&py_sensor_set_gray_lut_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_lcd_direct),      (mp_obj_t)&py_sensor_set_lcd_direct_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_stats),               (mp_obj_t)&py_sensor_stats_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_usb_irq_in_snapshot), (mp_obj_t)&py_sensor_set_usb_irq_in_snapshot_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_low_power),       (mp_obj_t)&py_sensor_set_low_power_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_motion_detect),   (mp_obj_t)&py_sensor_set_motion_detect_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_motion_mask),     (mp_obj_t)&py_sensor_get_motion_mask_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_delta_preview),   (mp_obj_t)&py_sensor_set_delta_preview_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_soft_auto_exposure), (mp_obj_t)&py_sensor_set_soft_auto_exposure_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_auto_exposure_roi), (mp_obj_t)&py_sensor_set_auto_exposure_roi_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_luma_histogram),  (mp_obj_t)&py_sensor_get_luma_histogram_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_alloc_slot),          (mp_obj_t)&py_sensor_alloc_slot_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_slot),            (mp_obj_t)&py_sensor_get_slot_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_free_slots),          (mp_obj_t)&py_sensor_free_slots_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_gray_gain),       (mp_obj_t)&py_sensor_set_gray_gain_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_gainceiling),     (mp_obj_t)&py_sensor_set_gainceiling_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_contrast),        (mp_obj_t)&py_sensor_set_contrast_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_brightness),      (mp_obj_t)&py_sensor_set_brightness_obj },
@@ -9,6 +9,8 @@
 #include "ff_wrapper.h"
 #include "libtf.h"
 #include "libtf_person_detect_model_data.h"
+#include "model_store.h"
+#include "nn_cascade.h"
 
 #ifdef IMLIB_ENABLE_TF
 
@@ -137,9 +139,16 @@ STATIC mp_obj_t int_py_tf_load(mp_obj_t path_obj, bool alloc_mode, bool helper_m
     py_tf_model_obj_t *tf_model = m_new_obj(py_tf_model_obj_t);
     tf_model->base.type = &py_tf_model_type;
 
+    uint32_t stored_len;
+    const uint8_t *stored = model_store_find(path, &stored_len);
+
     if (!strcmp(path, "person_detection")) {
         tf_model->model_data = (unsigned char *) g_person_detect_model_data;
         tf_model->model_data_len = g_person_detect_model_data_len;
+    } else if (stored != NULL) {
+        // Run in place from the flash model store.
+        tf_model->model_data = (unsigned char *) stored;
+        tf_model->model_data_len = stored_len;
     } else {
         FIL fp;
         file_read_open(&fp, path);
@@ -225,6 +234,17 @@ STATIC void py_tf_input_data_callback(void *callback_data,
     float x_offset = ((arg->roi->w * scale) - input_width) / 2;
     float y_offset = ((arg->roi->h * scale) - input_height) / 2;
 
+    // Grayscale and RGB565 go through the fused bilinear resize, on the centered crop
+    // that fills the input.
+    rectangle_t crop;
+    crop.w = IM_MAX(IM_MIN(fast_roundf(input_width * scale_inv), arg->roi->w), 1);
+    crop.h = IM_MAX(IM_MIN(fast_roundf(input_height * scale_inv), arg->roi->h), 1);
+    crop.x = arg->roi->x + ((arg->roi->w - crop.w) / 2);
+    crop.y = arg->roi->y + ((arg->roi->h - crop.h) / 2);
+    if (imlib_resize_to_tensor(arg->img, &crop, input_width, input_height, input_channels, NULL, model_input) == 0) {
+        return;
+    }
+
     switch (arg->img->bpp) {
         case IMAGE_BPP_BINARY: {
             for (int y = 0, yy = input_height; y < yy; y++) {
@@ -484,6 +504,151 @@ STATIC mp_obj_t py_tf_segment(uint n_args, const mp_obj_t *args, mp_map_t *kw_ar
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_tf_segment_obj, 2, py_tf_segment);
 
+// tf.cascade(): a variance or motion statistic, or a small gate model, decides per frame whether
+// the model runs. classify() returns None for the frames the gate drops.
+static const mp_obj_type_t py_tf_cascade_type;
+
+typedef struct py_tf_cascade_obj {
+    mp_obj_base_t base;
+    mp_obj_t model;
+    mp_obj_t gate_model;    // NN_CASCADE_GATE_MODEL only
+    int index;              // Output of the gate model that is the score
+    nn_cascade_t _cobj;
+} py_tf_cascade_obj_t;
+
+// Models given by path are loaded once here instead of on every frame.
+STATIC mp_obj_t py_tf_cascade_model(mp_obj_t model_obj)
+{
+    if (MP_OBJ_IS_TYPE(model_obj, &py_tf_model_type)) {
+        return model_obj;
+    }
+    return int_py_tf_load(model_obj, false, false);
+}
+
+STATIC mp_obj_t py_tf_cascade(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    py_tf_cascade_obj_t *cascade = m_new_obj(py_tf_cascade_obj_t);
+    cascade->base.type = &py_tf_cascade_type;
+    cascade->model = py_tf_cascade_model(args[0]);
+    cascade->gate_model = mp_const_none;
+
+    nn_cascade_gate_t gate = NN_CASCADE_GATE_MOTION;
+    mp_obj_t gate_obj = py_helper_keyword_object(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_gate));
+    if ((gate_obj != NULL) && MP_OBJ_IS_STR(gate_obj)
+    && (!strcmp(mp_obj_str_get_str(gate_obj), "variance") || !strcmp(mp_obj_str_get_str(gate_obj), "motion"))) {
+        gate = strcmp(mp_obj_str_get_str(gate_obj), "variance") ? NN_CASCADE_GATE_MOTION : NN_CASCADE_GATE_VARIANCE;
+    } else if (gate_obj != NULL) {
+        // Anything else is a gate model or the path to one.
+        gate = NN_CASCADE_GATE_MODEL;
+        cascade->gate_model = py_tf_cascade_model(gate_obj);
+    }
+
+    float threshold = py_helper_keyword_float(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 0.05f);
+    PY_ASSERT_TRUE_MSG((0.0f <= threshold) && (threshold <= 1.0f), "0 <= threshold <= 1");
+
+    cascade->index = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_index), 0);
+    if (gate == NN_CASCADE_GATE_MODEL) {
+        PY_ASSERT_TRUE_MSG((cascade->index >= 0) && (cascade->index < ((py_tf_model_obj_t *) cascade->gate_model)->channels),
+                "Gate output index out of range!");
+    }
+
+    nn_cascade_init(&cascade->_cobj, gate, threshold);
+    return cascade;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_tf_cascade_obj, 1, py_tf_cascade);
+
+// Runs the gate model once over the whole ROI.
+STATIC float py_tf_cascade_gate_score(py_tf_cascade_obj_t *self, image_t *img, rectangle_t *roi)
+{
+    fb_alloc_mark();
+    alloc_putchar_buffer();
+
+    py_tf_model_obj_t *gate_model = self->gate_model;
+
+    uint32_t tensor_arena_size;
+    uint8_t *tensor_arena = fb_alloc_all(&tensor_arena_size, FB_ALLOC_PREFER_SIZE);
+
+    py_tf_input_data_callback_data_t py_tf_input_data_callback_data;
+    py_tf_input_data_callback_data.img = img;
+    py_tf_input_data_callback_data.roi = roi;
+
+    py_tf_classify_output_data_callback_data_t py_tf_classify_output_data_callback_data;
+
+    PY_ASSERT_FALSE_MSG(libtf_invoke(gate_model->model_data,
+                                     tensor_arena,
+                                     tensor_arena_size,
+                                     py_tf_input_data_callback,
+                                     &py_tf_input_data_callback_data,
+                                     py_tf_classify_output_data_callback,
+                                     &py_tf_classify_output_data_callback_data),
+                        py_tf_putchar_buffer - (PY_TF_PUTCHAR_BUFFER_LEN - py_tf_putchar_buffer_len));
+
+    fb_alloc_free_till_mark();
+
+    return mp_obj_get_float(((mp_obj_list_t *) py_tf_classify_output_data_callback_data.out)->items[self->index]);
+}
+
+// Takes the same arguments as tf.classify() with the cascade in place of the model.
+STATIC mp_obj_t py_tf_cascade_classify(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    py_tf_cascade_obj_t *self = args[0];
+    nn_cascade_t *cascade = &self->_cobj;
+    image_t *arg_img = py_helper_arg_to_image_mutable(args[1]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 2, kw_args, &roi);
+
+    float score;
+    nn_cascade_start(cascade);
+    if (cascade->gate == NN_CASCADE_GATE_MODEL) {
+        score = py_tf_cascade_gate_score(self, arg_img, &roi);
+    } else {
+        score = nn_cascade_score(cascade, arg_img, &roi);
+    }
+
+    if (!nn_cascade_gate_done(cascade, score)) {
+        return mp_const_none;
+    }
+
+    mp_obj_t classify_args[n_args];
+    memcpy(classify_args, args, sizeof(classify_args));
+    classify_args[0] = self->model;
+
+    nn_cascade_start(cascade);
+    mp_obj_t objects_list = py_tf_classify(n_args, classify_args, kw_args);
+    nn_cascade_model_done(cascade);
+    return objects_list;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_tf_cascade_classify_obj, 2, py_tf_cascade_classify);
+
+// (frames, runs, last score, gate cycles per frame, model cycles per run)
+STATIC mp_obj_t py_tf_cascade_stats(mp_obj_t self_in)
+{
+    nn_cascade_t *cascade = &((py_tf_cascade_obj_t *) self_in)->_cobj;
+    mp_obj_t stats[5] = {
+        mp_obj_new_int(cascade->frames),
+        mp_obj_new_int(cascade->runs),
+        mp_obj_new_float(cascade->score),
+        mp_obj_new_int(cascade->frames ? (cascade->gate_cycles / cascade->frames) : 0),
+        mp_obj_new_int(cascade->runs ? (cascade->model_cycles / cascade->runs) : 0)
+    };
+    return mp_obj_new_tuple(5, stats);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_tf_cascade_stats_obj, py_tf_cascade_stats);
+
+STATIC const mp_rom_map_elem_t py_tf_cascade_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_classify), MP_ROM_PTR(&py_tf_cascade_classify_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&py_tf_cascade_stats_obj) }
+};
+
+STATIC MP_DEFINE_CONST_DICT(py_tf_cascade_locals_dict, py_tf_cascade_locals_dict_table);
+
+static const mp_obj_type_t py_tf_cascade_type = {
+    { &mp_type_type },
+    .name  = MP_QSTR_tf_cascade,
+    .locals_dict = (mp_obj_t) &py_tf_cascade_locals_dict
+};
+
 mp_obj_t py_tf_len(mp_obj_t self_in) { return mp_obj_new_int(((py_tf_model_obj_t *) self_in)->model_data_len); }
 mp_obj_t py_tf_height(mp_obj_t self_in) { return mp_obj_new_int(((py_tf_model_obj_t *) self_in)->height); }
 mp_obj_t py_tf_width(mp_obj_t self_in) { return mp_obj_new_int(((py_tf_model_obj_t *) self_in)->width); }
@@ -521,11 +686,13 @@ STATIC const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_free_from_fb),    MP_ROM_PTR(&py_tf_free_from_fb_obj) },
     { MP_ROM_QSTR(MP_QSTR_classify),        MP_ROM_PTR(&py_tf_classify_obj) },
     { MP_ROM_QSTR(MP_QSTR_segment),         MP_ROM_PTR(&py_tf_segment_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cascade),         MP_ROM_PTR(&py_tf_cascade_obj) },
 #else
     { MP_ROM_QSTR(MP_QSTR_load),            MP_ROM_PTR(&py_func_unavailable_obj) },
     { MP_ROM_QSTR(MP_QSTR_free_from_fb),    MP_ROM_PTR(&py_func_unavailable_obj) },
     { MP_ROM_QSTR(MP_QSTR_classify),        MP_ROM_PTR(&py_func_unavailable_obj) },
-    { MP_ROM_QSTR(MP_QSTR_segment),         MP_ROM_PTR(&py_func_unavailable_obj) }
+    { MP_ROM_QSTR(MP_QSTR_segment),         MP_ROM_PTR(&py_func_unavailable_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cascade),         MP_ROM_PTR(&py_func_unavailable_obj) }
 #endif // IMLIB_ENABLE_TF
 };
 
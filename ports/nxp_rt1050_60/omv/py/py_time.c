@@ -7,20 +7,103 @@
  *
  */
 #include <mp.h>
+#include "py/mphal.h"
 #include "systick.h"
+#include "imlib.h"
+#include "py_assert.h"
 #include "py_time.h"
 
+// Frame times, tick() to tick(), kept for the last CLOCK_WINDOW frames. The histogram has 8
+// buckets per octave of microseconds, so a percentile is within 12.5% of the real time.
+#define CLOCK_WINDOW    (128)
+#define CLOCK_BUCKETS   (240)
+
 /* Clock Type */
 typedef struct _py_clock_obj_t {
     mp_obj_base_t base;
     uint32_t t_start;
     uint32_t t_ticks;
     uint32_t t_frame;
+    uint32_t t_last_us;     // last tick(), valid once n_ticks > 0
+    uint32_t n_ticks;
+    uint32_t deadline_us;   // target period, 0 if none
+    uint32_t misses;        // frames over deadline_us since reset()
+    uint32_t window[CLOCK_WINDOW];
+    uint16_t hist[CLOCK_BUCKETS];
 } py_clock_obj_t;
 
+static uint32_t clock_bucket(uint32_t us)
+{
+    if (us < 8) {
+        return us;
+    }
+    uint32_t octave = 31 - __builtin_clz(us);
+    return ((octave - 2) * 8) + ((us >> (octave - 3)) & 7);
+}
+
+// Largest time that falls in bucket.
+static uint32_t clock_bucket_max(uint32_t bucket)
+{
+    if (bucket < 8) {
+        return bucket;
+    }
+    uint32_t shift = (bucket / 8) - 1;
+    return ((9 + (bucket % 8)) << shift) - 1;
+}
+
+static void clock_add_frame(py_clock_obj_t *clock, uint32_t us)
+{
+    uint32_t n = clock->n_ticks - 1, i = n % CLOCK_WINDOW;
+    if (n >= CLOCK_WINDOW) {
+        clock->hist[clock_bucket(clock->window[i])]--;
+    }
+    clock->window[i] = us;
+    clock->hist[clock_bucket(us)]++;
+    if (clock->deadline_us && (us > clock->deadline_us)) {
+        clock->misses++;
+    }
+}
+
+static uint32_t clock_frames(py_clock_obj_t *clock)
+{
+    return (clock->n_ticks > CLOCK_WINDOW) ? CLOCK_WINDOW : (clock->n_ticks ? (clock->n_ticks - 1) : 0);
+}
+
+static uint32_t clock_max_us(py_clock_obj_t *clock)
+{
+    uint32_t max = 0;
+    for (uint32_t i = 0, n = clock_frames(clock); i < n; i++) {
+        max = IM_MAX(max, clock->window[i]);
+    }
+    return max;
+}
+
+// The time p percent of the frames in the window took at most.
+static uint32_t clock_percentile_us(py_clock_obj_t *clock, float p)
+{
+    uint32_t n = clock_frames(clock);
+    if (!n) {
+        return 0;
+    }
+    uint32_t rank = fast_ceilf(n * p / 100.0f), sum = 0;
+    rank = IM_MIN(IM_MAX(rank, 1), n);
+    for (uint32_t i = 0; i < CLOCK_BUCKETS; i++) {
+        sum += clock->hist[i];
+        if (sum >= rank) {
+            return IM_MIN(clock_bucket_max(i), clock_max_us(clock));
+        }
+    }
+    return clock_max_us(clock);
+}
+
 mp_obj_t py_clock_tick(mp_obj_t clock_obj)
 {
     py_clock_obj_t *clock = (py_clock_obj_t*) clock_obj;
+    uint32_t us = mp_hal_ticks_us();
+    if (clock->n_ticks++) {
+        clock_add_frame(clock, us - clock->t_last_us);
+    }
+    clock->t_last_us = us;
     clock->t_start = systick_current_millis();
     return mp_const_none;
 }
@@ -53,28 +136,99 @@ mp_obj_t py_clock_reset(mp_obj_t clock_obj)
     clock->t_start = 0;
     clock->t_ticks = 0;
     clock->t_frame = 0;
+    clock->n_ticks = 0;
+    clock->misses = 0;
+    memset(clock->hist, 0, sizeof(clock->hist));
     return mp_const_none;
 }
 
+// percentile(p): the frame time in ms p percent of the last frames stayed within.
+mp_obj_t py_clock_percentile(mp_obj_t clock_obj, mp_obj_t p_obj)
+{
+    return mp_obj_new_float(clock_percentile_us(clock_obj, mp_obj_get_float(p_obj)) / 1000.0f);
+}
+
+mp_obj_t py_clock_max(mp_obj_t clock_obj)
+{
+    return mp_obj_new_float(clock_max_us(clock_obj) / 1000.0f);
+}
+
+// stats(): (p50, p95, p99, max) of the frame times in ms, and the deadline misses.
+mp_obj_t py_clock_stats(mp_obj_t clock_obj)
+{
+    py_clock_obj_t *clock = (py_clock_obj_t*) clock_obj;
+    mp_obj_t tuple[5] = {
+        mp_obj_new_float(clock_percentile_us(clock, 50) / 1000.0f),
+        mp_obj_new_float(clock_percentile_us(clock, 95) / 1000.0f),
+        mp_obj_new_float(clock_percentile_us(clock, 99) / 1000.0f),
+        mp_obj_new_float(clock_max_us(clock) / 1000.0f),
+        mp_obj_new_int_from_uint(clock->misses)
+    };
+    return mp_obj_new_tuple(5, tuple);
+}
+
+// deadline([ms]): sets the target period frames count as missed over, 0 disables, returns
+// the misses since reset().
+mp_obj_t py_clock_deadline(size_t n_args, const mp_obj_t *args)
+{
+    py_clock_obj_t *clock = (py_clock_obj_t*) args[0];
+    if (n_args > 1) {
+        float ms = mp_obj_get_float(args[1]);
+        PY_ASSERT_TRUE_MSG(ms >= 0, "Deadline must be >= 0");
+        clock->deadline_us = fast_roundf(ms * 1000.0f);
+        clock->misses = 0;
+    }
+    return mp_obj_new_int_from_uint(clock->misses);
+}
+
+// histogram(): [(ms, count), ...] of the frames in the window, ms being the top of the
+// bucket, empty buckets left out.
+mp_obj_t py_clock_histogram(mp_obj_t clock_obj)
+{
+    py_clock_obj_t *clock = (py_clock_obj_t*) clock_obj;
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (uint32_t i = 0; i < CLOCK_BUCKETS; i++) {
+        if (clock->hist[i]) {
+            mp_obj_t tuple[2] = {
+                mp_obj_new_float(clock_bucket_max(i) / 1000.0f),
+                mp_obj_new_int(clock->hist[i])
+            };
+            mp_obj_list_append(list, mp_obj_new_tuple(2, tuple));
+        }
+    }
+    return list;
+}
+
 static void py_clock_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
 {
     py_clock_obj_t *self = self_in;
 
     /* print some info */
-    mp_printf(print, "t_start:%d t_ticks:%d t_frame:%d\n",
-            self->t_start, self->t_ticks, self->t_frame);
+    mp_printf(print, "t_start:%d t_ticks:%d t_frame:%d p99:%dus max:%dus misses:%d\n",
+            self->t_start, self->t_ticks, self->t_frame,
+            clock_percentile_us(self, 99), clock_max_us(self), self->misses);
 }
 
 static MP_DEFINE_CONST_FUN_OBJ_1(py_clock_tick_obj,  py_clock_tick);
 static MP_DEFINE_CONST_FUN_OBJ_1(py_clock_fps_obj,   py_clock_fps);
 static MP_DEFINE_CONST_FUN_OBJ_1(py_clock_avg_obj,   py_clock_avg);
 static MP_DEFINE_CONST_FUN_OBJ_1(py_clock_reset_obj, py_clock_reset);
+static MP_DEFINE_CONST_FUN_OBJ_2(py_clock_percentile_obj, py_clock_percentile);
+static MP_DEFINE_CONST_FUN_OBJ_1(py_clock_max_obj,   py_clock_max);
+static MP_DEFINE_CONST_FUN_OBJ_1(py_clock_stats_obj, py_clock_stats);
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_clock_deadline_obj, 1, 2, py_clock_deadline);
+static MP_DEFINE_CONST_FUN_OBJ_1(py_clock_histogram_obj, py_clock_histogram);
 
 static const mp_map_elem_t locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_tick),   (mp_obj_t)&py_clock_tick_obj},
     { MP_OBJ_NEW_QSTR(MP_QSTR_fps),    (mp_obj_t)&py_clock_fps_obj},
     { MP_OBJ_NEW_QSTR(MP_QSTR_avg),    (mp_obj_t)&py_clock_avg_obj},
     { MP_OBJ_NEW_QSTR(MP_QSTR_reset),  (mp_obj_t)&py_clock_reset_obj},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_percentile), (mp_obj_t)&py_clock_percentile_obj},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_max),    (mp_obj_t)&py_clock_max_obj},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_stats),  (mp_obj_t)&py_clock_stats_obj},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_deadline), (mp_obj_t)&py_clock_deadline_obj},
+    { MP_OBJ_NEW_QSTR(MP_QSTR_histogram), (mp_obj_t)&py_clock_histogram_obj},
     { NULL, NULL },
 };
 
@@ -101,11 +255,8 @@ static mp_obj_t py_time_sleep(mp_obj_t ms)
 static mp_obj_t py_time_clock()
 {
     py_clock_obj_t *clock =NULL;
-    clock = m_new_obj(py_clock_obj_t);
+    clock = m_new0(py_clock_obj_t, 1);
     clock->base.type = &py_clock_type;
-    clock->t_start = 0;
-    clock->t_ticks = 0;
-    clock->t_frame = 0;
 
     return clock;
 }
@@ -264,23 +264,6 @@ static mp_obj_t SpiSendByte(register uint16_t b) {
     );
     return result;
 }
-static mp_obj_t SpiSendLine(uint8_t *line, uint16_t length) {
-    mp_map_t arg_map;
-    arg_map.all_keys_are_qstrs = true;
-    arg_map.is_fixed = true;
-    arg_map.is_ordered = true;
-    arg_map.used = 0;
-    arg_map.alloc = 0;
-    arg_map.table = NULL;
-    pyb_spi_send(
-        2, (mp_obj_t []) {
-            spi_port,
-            mp_obj_new_bytes(line, length)
-        },
-        &arg_map
-    );
-    return mp_const_none;
-}
 static mp_obj_t SpiSendWord(register uint16_t b) {
     mp_map_t arg_map;
     arg_map.all_keys_are_qstrs = true;
@@ -554,16 +537,22 @@ static mp_obj_t py_tv_display(uint n_args, const mp_obj_t *args, mp_map_t *kw_ar
     uint32_t address;
     uint16_t x = x1;
     uint16_t y = y1;
+    pyb_spi_obj_t *spi = (pyb_spi_obj_t *) spi_port;
 
+    // Each line goes out as one SRAM write, the WRITE header in front of the pixels, queued
+    // on the SPI DMA. Two lines in turn, one fills while the other goes out.
     fb_alloc_mark();
-    uint8_t *line = fb_alloc(w*2, FB_ALLOC_NO_HINT);
+    uint8_t *lines = fb_alloc((4 + w*2) * 2, FB_ALLOC_NO_HINT);
 
     while (y < y2) {
+        uint8_t *cmd = lines + (y & 1) * (4 + w*2);
+        uint8_t *line = cmd + 4;
+        spi_dma_wait(spi->ndx, 1);
         address = PICLINE_BYTE_ADDRESS(y) + x1;
-        CS_PIN_WRITE(false);
-        SpiSendByte(WRITE);
-        SpiSendByte(address >> 16);
-        SpiSendWord(address);
+        cmd[0] = WRITE;
+        cmd[1] = address >> 16;
+        cmd[2] = address >> 8;
+        cmd[3] = address;
         for(int i = 0; i < w; i++)
         {
             x = x1 + i;
@@ -582,10 +571,17 @@ static mp_obj_t py_tv_display(uint n_args, const mp_obj_t *args, mp_map_t *kw_ar
                 line[2*i + 1] = y8;
             }
         }
-        SpiSendLine(line, w*2);
-        CS_PIN_WRITE(true);
+        // the VS23 select is the bus' NSS
+        spi_dma_desc_t desc = {
+            .tx = cmd,
+            .len = 4 + w*2,
+            .cs = spi->pSSEL,
+            .flags = SPI_DMA_CS_ASSERT | SPI_DMA_CS_RELEASE,
+        };
+        spi_dma_queue(spi->ndx, &desc); // at most 2 queued
         y++;
     }
+    spi_dma_wait(spi->ndx, 0);
     fb_alloc_free_till_mark();
     return mp_const_none;
 }
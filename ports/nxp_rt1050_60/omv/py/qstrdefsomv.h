@@ -18,6 +18,23 @@ Q(version_string)
 Q(arch)
 Q(board_type)
 Q(board_id)
+Q(fb_stats)
+Q(fb_reset_peak)
+Q(umm_stats)
+Q(heap)
+Q(used)
+Q(slab_allocs)
+Q(free)
+Q(free_blocks)
+Q(largest_free)
+Q(slab_pages)
+Q(slab_used)
+Q(slab_in_use)
+Q(peak)
+Q(allocs)
+Q(fails)
+Q(avail)
+Q(depths)
 
 // Image module
 Q(image)
@@ -49,13 +66,18 @@ Q(EDGE_CANNY)
 Q(EDGE_SIMPLE)
 Q(CORNER_FAST)
 Q(CORNER_AGAST)
+Q(BILINEAR)
 Q(load_descriptor)
 Q(save_descriptor)
 Q(match_descriptor)
+Q(append_db)
+Q(load_db)
+Q(match_db)
 
 // Image class
 Q(find_template)
 Q(kp_desc)
+Q(kp_db)
 Q(lbp_desc)
 Q(Cascade)
 Q(cmp_lbp)
@@ -101,6 +123,11 @@ Q(loop)
 // Mjpeg module
 Q(mjpeg)
 Q(Mjpeg)
+Q(segment_size)
+Q(Recorder)
+Q(buffer_size)
+Q(file_size)
+// duplicate Q(flush)
 
 // Led Module
 Q(led)
@@ -123,6 +150,11 @@ Q(Clock)
 Q(tick)
 Q(fps)
 Q(avg)
+Q(percentile)
+Q(max)
+Q(stats)
+Q(deadline)
+Q(histogram)
 
 //Sensor Module
 Q(sensor)
@@ -148,6 +180,17 @@ Q(Net)
 
 // Forward
 Q(forward)
+Q(forward_batch)
+Q(profile)
+Q(Pipeline)
+Q(cascade)
+Q(gate)
+Q(variance)
+Q(motion)
+Q(tf_cascade)
+Q(store)
+Q(store_list)
+Q(store_erase)
 Q(dry_run)
 Q(softmax)
 
@@ -228,6 +271,13 @@ Q(IOCTL_LEPTON_SET_MEASUREMENT_MODE)
 Q(IOCTL_LEPTON_GET_MEASUREMENT_MODE)
 Q(IOCTL_LEPTON_SET_MEASUREMENT_RANGE)
 Q(IOCTL_LEPTON_GET_MEASUREMENT_RANGE)
+Q(IOCTL_LEPTON_GET_FRAME)
+Q(IOCTL_LEPTON_GET_STATS)
+
+// Framebuffers
+Q(SINGLE_BUFFER)
+Q(DOUBLE_BUFFER)
+Q(TRIPLE_BUFFER)
 
 // Color Palettes
 Q(PALETTE_RAINBOW)
@@ -237,6 +287,9 @@ Q(reset)
 Q(flush)
 Q(snapshot)
 Q(skip_frames)
+Q(snapshot_async)
+Q(set_frame_callback)
+Q(get_frame_info)
 Q(get_fb)
 Q(get_id)
 Q(alloc_extra_fb)
@@ -246,7 +299,47 @@ Q(set_framerate)
 Q(set_framesize)
 Q(set_vsync_output)
 Q(set_binning)
+Q(set_mode)
 Q(set_windowing)
+Q(set_framebuffers)
+Q(get_framebuffers)
+Q(set_gray_lut)
+Q(set_gray_gain)
+Q(set_soft_auto_exposure)
+Q(target)
+Q(max_exposure_us)
+Q(set_auto_exposure_roi)
+Q(weight)
+Q(get_luma_histogram)
+Q(alloc_slot)
+Q(get_slot)
+Q(free_slots)
+Q(into)
+Q(set_lcd_direct)
+Q(set_motion_detect)
+Q(get_motion_mask)
+Q(set_delta_preview)
+Q(keyframe_interval)
+// duplicate Q(threshold)
+Q(stats)
+Q(frames)
+Q(dropped)
+Q(fifo_overflows)
+Q(irq_cycles_max)
+Q(irq_cycles_mean)
+Q(jpeg_ms)
+Q(wait_us)
+Q(wait_us_total)
+Q(run_us_total)
+Q(run_uj_total)
+Q(wait_uj_total)
+Q(uj_per_frame)
+Q(fragment_misses)
+Q(set_usb_irq_in_snapshot)
+Q(set_low_power)
+Q(LP_OFF)
+Q(LP_WFI)
+Q(LP_SCALE)
 Q(set_gainceiling)
 Q(set_contrast)
 Q(set_brightness)
@@ -442,6 +535,7 @@ Q(color_palette)
 // Compress (in place)
 Q(compress)
 Q(quality)
+Q(max_bytes)
 
 // Compress for IDE (in place)
 Q(compress_for_ide)
@@ -450,6 +544,7 @@ Q(compress_for_ide)
 // Compressed (out of place)
 Q(compressed)
 // duplicate Q(quality)
+// duplicate Q(max_bytes)
 
 // Compressed for IDE (out of place)
 Q(compressed_for_ide)
@@ -539,6 +634,7 @@ Q(draw_image)
 // duplicate Q(y_scale)
 Q(alpha)
 // duplicate Q(mask)
+Q(hint)
 
 // Draw Keypoints
 Q(draw_keypoints)
@@ -773,6 +869,9 @@ Q(cartoon)
 // duplicate Q(floating_threshold)
 Q(mask)
 
+// Pipeline
+Q(pipeline)
+
 // Shadow Removal
 Q(remove_shadows)
 
@@ -857,6 +956,8 @@ Q(b_value)
 // duplicate Q(b_bins)
 // duplicate Q(thresholds)
 // duplicate Q(invert)
+Q(get_statistics_rois)
+Q(integral)
 // Statistics Object
 // duplicate Q(statistics)
 // duplicate Q(mean)
@@ -1014,6 +1115,12 @@ Q(find_rects)
 // Find QRCodes
 Q(find_qrcodes)
 // duplicate Q(roi)
+Q(locate)
+Q(max_codes)
+// Find results
+Q(max_results)
+Q(sort_by)
+Q(lazy)
 // QRCode Object
 Q(qrcode)
 // duplicate Q(corners)
@@ -1041,6 +1148,9 @@ Q(fx)
 Q(fy)
 // duplicate Q(cx)
 // duplicate Q(cy)
+Q(quad_decimate)
+Q(refine_edges)
+Q(track)
 // AprilTag Object
 Q(apriltag)
 // duplicate Q(corners)
@@ -1091,6 +1201,10 @@ Q(padding)
 
 // Find BarCodes
 Q(find_barcodes)
+Q(find_codes)
+Q(qrcodes)
+Q(apriltags)
+Q(barcodes)
 // duplicate Q(roi)
 // BarCode Object
 Q(barcode)
@@ -1134,6 +1248,17 @@ Q(displacement)
 // duplicate Q(scale)
 Q(response)
 
+// Track Points
+Q(track_points)
+Q(points)
+// duplicate Q(roi)
+Q(window)
+Q(levels)
+Q(max_iterations)
+// duplicate Q(threshold)
+Q(max_points)
+// duplicate Q(corner_detector)
+
 // Image Writer
 Q(ImageWriter)
 // Image Writer Object
@@ -1152,6 +1277,17 @@ Q(next_frame)
 // duplicate Q(loop)
 // duplicate Q(close)
 
+// Tracker
+Q(Tracker)
+Q(max_age)
+Q(min_hits)
+Q(iou_threshold)
+// Tracker Object
+Q(tracker)
+// duplicate Q(update)
+Q(tracks)
+// duplicate Q(reset)
+
 // FIR Module
 Q(fir)
 // duplicate Q(init)
@@ -1169,6 +1305,7 @@ Q(resolution)
 // duplicate Q(type)
 Q(read_ta)
 Q(read_ir)
+Q(read_async)
 Q(draw_ta)
 // duplicate Q(alpha)
 // duplicate Q(scale)
@@ -1215,3 +1352,84 @@ Q(output)
 // Segment
 // duplicate Q(segment)
 // duplicate Q(roi)
+
+// Flash littlefs
+Q(VfsLfs2)
+Q(readsize)
+Q(progsize)
+Q(lookahead)
+
+// Contiguous files
+Q(create_contiguous)
+Q(ContiguousFile)
+
+// Result export
+Q(as_array)
+Q(out)
+
+// Array ops
+Q(ops)
+Q(clip)
+Q(dot)
+Q(convert)
+// duplicate Q(scale)
+// duplicate Q(offset)
+Q(Biquad)
+Q(FIR)
+Q(process)
+// duplicate Q(reset)
+Q(taps)
+Q(decimate)
+
+// Socket
+Q(recv_into)
+
+// JSON pull parser
+Q(Parser)
+Q(VALUE)
+// duplicate Q(KEY)
+Q(START_ARRAY)
+Q(END_ARRAY)
+Q(START_OBJECT)
+Q(END_OBJECT)
+
+// uzlib CompIO
+Q(CompIO)
+
+// ure
+Q(match_into)
+Q(search_into)
+
+// btree
+Q(bulkload)
+
+// utimeq
+Q(Wheel)
+
+// Stream server
+Q(stream_server)
+Q(stream_stop)
+Q(stream_clients)
+Q(clients)
+Q(frame_size)
+
+// Background tasks
+Q(submit)
+Q(perf)
+Q(overlay_stats)
+Q(set_perf_profile)
+Q(get_perf_profile)
+Q(lab_tab)
+Q(haar)
+Q(flashpgm)
+Q(Future)
+Q(done)
+Q(result)
+Q(wb)
+Q(send)
+
+// Awaitable capture
+Q(uasyncio)
+Q(IORead)
+Q(IOReadDone)
+Q(Capture)
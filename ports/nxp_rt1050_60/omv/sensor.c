@@ -10,6 +10,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "mp.h"
+#include "py/stream.h"
 #include "irq.h"
 #include "cambus.h"
 #include "ov9650.h"
@@ -20,6 +21,8 @@
 #include "sensor.h"
 #include "systick.h"
 #include "framebuffer.h"
+#include "fb_alloc.h"
+#include "trace.h"
 #include "fsl_clock.h"
 #include "fsl_csi.h"
 #include "fsl_debug_console.h"
@@ -29,10 +32,15 @@
 #include "fsl_camera_device.h"
 #include "fsl_ov7725.h"
 #include "fsl_elcdif.h"
+#include "pxp_2d.h"
+#include "stream_server.h"
+#include "perf_profile.h"
+#include "task.h"
 #include "fsl_edma.h"
 #include "fsl_dmamux.h"
 #include "omv_boardconfig.h"
-#include "fsl_cache.h"
+#include "dma.h"
+#include "boottime.h"
 
 #define OV_CHIP_ID      (0x0A)
 #define ON_CHIP_ID      (0x00)
@@ -95,6 +103,7 @@ volatile bool g_Transfer_Done = false;
 #ifndef NO_LCD_MONITOR
 #define LCD_FB __attribute__((section(".lcd_fb")))
 /*static*/ LCD_FB uint16_t s_frameBuffer[2][272][480] ;
+static uint8_t s_isLcdInited;
 #endif
 
 typedef struct _ov7725_reg
@@ -409,40 +418,85 @@ void LCDMonitor_InitFB(void)
 	}
 }
 
-void LCDMonitor_Init(void)
+// Size of the picture LCDIF scans, smaller than the panel when showing a camera frame directly.
+static uint16_t s_lcdScanW, s_lcdScanH;
+// 1: RGB565 frames are scanned out of the capture ring, gray frames are converted by PXP
+static uint8_t s_isLcdDirect;
+static bool s_isLcdScanCamRgb;
+
+// Scan a w x h picture centered on the panel. The blanking grows by what the picture is
+// smaller than the panel, so the line and frame periods do not change.
+static void LCDMonitor_SetScanSize(uint32_t w, uint32_t h, uint32_t bufAddr, bool isCamRgb)
 {
-    // Initialize the camera bus.
-    BOARD_InitLcdifPixClock();
-   // BOARD_InitDebugConsole();
-    BOARD_InitLcd();	
+	uint32_t padW = APP_LCD_WIDTH - w, padH = APP_LCD_HEIGHT - h;
     elcdif_rgb_mode_config_t lcdConfig = {
-        .panelWidth = APP_LCD_WIDTH,
-        .panelHeight = APP_LCD_HEIGHT,
+        .panelWidth = w,
+        .panelHeight = h,
         .hsw = APP_HSW,
-        .hfp = APP_HFP,
-        .hbp = APP_HBP,
+        .hfp = APP_HFP + padW / 2,
+        .hbp = APP_HBP + padW - padW / 2,
         .vsw = APP_VSW,
-        .vfp = APP_VFP,
-        .vbp = APP_VBP,
+        .vfp = APP_VFP + padH / 2,
+        .vbp = APP_VBP + padH - padH / 2,
         .polarityFlags = APP_LCD_POL_FLAGS,
         .pixelFormat = kELCDIF_PixelFormatRGB565,
         .dataBus = APP_LCDIF_DATA_BUS,
-    };	
-	LCDMonitor_InitFB();
-
-    lcdConfig.bufferAddr = (uint32_t)activeFrameAddr;
-
+    };
+    lcdConfig.bufferAddr = bufAddr;
+	if (s_lcdScanW)
+		ELCDIF_RgbModeStop(APP_ELCDIF);
     ELCDIF_RgbModeInit(APP_ELCDIF, &lcdConfig);
+	if (isCamRgb) {
+		// camera RGB565 is big endian, swap the bytes of each pixel on the fly
+		APP_ELCDIF->CTRL_SET = LCDIF_CTRL_INPUT_DATA_SWIZZLE(3);
+	}
+	s_lcdScanW = w , s_lcdScanH = h , s_isLcdScanCamRgb = isCamRgb;
+    ELCDIF_RgbModeStart(APP_ELCDIF);
+}
 
+void LCDMonitor_Init(void)
+{
+    // Initialize the camera bus.
+    BOARD_InitLcdifPixClock();
+   // BOARD_InitDebugConsole();
+    BOARD_InitLcd();	
+	LCDMonitor_InitFB();
+	s_lcdScanW = 0;
+	LCDMonitor_SetScanSize(APP_LCD_WIDTH, APP_LCD_HEIGHT, (uint32_t)activeFrameAddr, false);
     ELCDIF_SetNextBufferAddr(APP_ELCDIF, (uint32_t)s_frameBuffer);
-    ELCDIF_RgbModeStart(APP_ELCDIF);  	
-
+	s_isLcdInited = 1;
 }
 void UnHook_OnUsbDbgScriptExec(void) {
     LCDMonitor_Init();
 }
 #endif
 
+// sensor_set_mode() keeps the register writes of the last few modes, switching only writes
+// the ones that differ from the mode the sensor is in.
+typedef struct _SensorMode_t
+{
+	framesize_t framesize;
+	pixformat_t pixformat;
+	int regCnt;		// 0 = unused
+	cambus_op_t regs[SENSOR_MODE_REGS_MAX];
+}SensorMode_t;
+static SensorMode_t s_modes[SENSOR_MODE_PROFILES];
+static int8_t s_modeCur = -1;	// profile the sensor registers match, -1 if unknown
+static uint8_t s_modeNext;
+// written by the CSI IRQ right after the next SOF
+static cambus_op_t s_modeDelta[SENSOR_MODE_REGS_MAX];
+static volatile int s_modeDeltaCnt;
+
+// Anything but sensor_set_mode() that writes the sensor makes the current profile unknown,
+// and a reset or a raw register write can change what the kept writes depend on.
+static void SensorModeInvalidate(bool isDropProfiles) {
+	s_modeCur = -1;
+	if (isDropProfiles) {
+		for (int i = 0; i < SENSOR_MODE_PROFILES; i++)
+			s_modes[i].regCnt = 0;
+	}
+}
+
 #define CSI_FRAG_MODE
 #ifdef CSI_FRAG_MODE
 CSI_Type *s_pCSI = CSI;
@@ -450,12 +504,20 @@ CSI_Type *s_pCSI = CSI;
 //				 			8bit | PixRisEdge | gatedClk  | SyncClrFifo| HSyncActHigh|SofOnVsyncRis|ExtVSync
 #define CSICR1_INIT_VAL 	0<<0 | 1<<1	      | 1<<4	  | 1<<8	   | 1<<11		 | 1<<17	   |1<<30   
 
-uint64_t s_dmaFragBufs[2][640 * 2 / 8];	// max supported line length
+// Fragment buffers hold up to 4 VGA lines, the IRQ then has 4 line times to empty each one,
+// deep enough to stay on time with the USB IRQ running.
+#define CSI_FRAG_MAX_BYTES	(640 * 2 * 4)
+DMA_BUF_ALIGN uint64_t s_dmaFragBufs[2][CSI_FRAG_MAX_BYTES / 8];
 
 typedef struct _CSIIrq_t
 {
 	uint8_t isStarted;
 	uint8_t isGray;
+	uint8_t isRaw;		// Bayer, one byte per pixel on the bus instead of two
+	uint8_t lumaFmt;	// CSI_LUMA_x, how motion and AE find the luma of the output lines
+	uint8_t busBpp;		// bytes per pixel on the bus
+	uint8_t isJpeg;		// sensor compressed, a byte stream of unknown length ended by VSync
+	uint8_t isInFrame;	// JPEG: SOF seen, the next one ends the frame
 	uint32_t base0;
 	uint32_t linePerFrag;
 	uint32_t cnt;
@@ -470,12 +532,117 @@ typedef struct _CSIIrq_t
 	uint32_t datCurBase;
 
 	uint32_t fragCnt;
+	uint32_t frameSeq;	// frames completed since boot
+	uint32_t sofUs;		// SOF time of the frame being captured
+	uint32_t jpegCap;	// JPEG: bytes the destination takes, a multiple of dmaBytePerFrag
+	uint32_t jpegBytes;	// JPEG: length of the last frame completed
 	// in color mode, dmaFragNdx should == datLineNdx
 	// in gray mode, to save memory, move backword nextDmaBulk every 4 lines
 	
 }CSIIrq_t;
 volatile CSIIrq_t s_irq;
 
+// Capture ring: with more than 1 framebuffer, DMA fills spare buffers carved out right
+// after MAIN_FB()->pixels while Python is still working on the previous frame, and
+// snapshot() only has to copy out the newest completed one.
+#define CSI_RING_MAX_BUFS	3
+typedef struct _CSIRing_t
+{
+	uint8_t fbCnt;		// framebuffers requested by sensor_set_framebuffers(), 1 = stop-and-wait
+	uint8_t bufCnt;		// capture buffers in use, fbCnt - 1 or less if fb memory is short
+	uint8_t isRunning;
+	int8_t wrNdx;		// buffer DMA is filling
+	int8_t readyNdx;	// newest completed buffer not yet consumed, -1 if none
+	int8_t readingNdx;	// buffer being copied out by snapshot(), -1 if none
+	int8_t doneNdx;		// newest completed buffer, also once it is consumed, -1 if none
+	uint32_t frameBytes;
+	uint32_t stride;	// 32 bytes aligned for cache maintenance
+	uint32_t bufs[CSI_RING_MAX_BUFS];
+	uint32_t bufSeq[CSI_RING_MAX_BUFS];
+	uint32_t bufUs[CSI_RING_MAX_BUFS];
+	uint32_t bufBytes[CSI_RING_MAX_BUFS];	// JPEG length of each buffer
+	uint32_t dropCnt;	// completed frames overwritten before snapshot() took them
+}CSIRing_t;
+volatile CSIRing_t s_ring = {.fbCnt = 1, .readyNdx = -1, .readingNdx = -1, .doneNdx = -1};
+
+// Sequence number and SOF time of the frame currently in MAIN_FB()->pixels.
+typedef struct _CSIFrameInfo_t
+{
+	uint32_t seq;
+	uint32_t stampUs;
+}CSIFrameInfo_t;
+volatile CSIFrameInfo_t s_fbInfo;
+volatile uint8_t s_isSnapshotArmed;	// stop-and-wait frame started by sensor_snapshot_async()
+
+// Capture-time motion detection: each frame is cut into blocks, the brightness of each block is
+// sampled (every other pixel of every other line) as fragments arrive and compared with the
+// previous frame when the frame ends.
+#define CSI_MOTION_MAX_BLOCKS	(40 * 30)
+typedef struct _CSIMotion_t
+{
+	uint8_t isEnabled;
+	uint8_t isPrevValid;	// prevSum holds a full frame
+	uint8_t isMaskValid;
+	uint8_t blkShift;		// block size is 1 << blkShift
+	uint16_t gridW, gridH;
+	uint16_t frameW, frameH;
+	uint16_t thresh;		// block sum difference that counts as motion
+	uint16_t changedCnt;	// blocks changed in the last compared frame
+	uint16_t curSum[CSI_MOTION_MAX_BLOCKS];
+	uint16_t prevSum[CSI_MOTION_MAX_BLOCKS];
+	uint8_t mask[CSI_MOTION_MAX_BLOCKS];	// 255 where the block changed
+}CSIMotion_t;
+static volatile CSIMotion_t s_motion = {.thresh = 8};
+
+// Software auto exposure / gain: a luma histogram is sampled (every 4th pixel of every 4th
+// line) as fragments arrive, sensor_snapshot() steers exposure and gain from the last one.
+#define CSI_AE_BINS		SENSOR_LUMA_HIST_BINS
+#define CSI_AE_TOLERANCE	(6)		// mean luma error that is left alone
+#define CSI_AE_SETTLE_FRAMES	(2)		// frames until a new exposure shows up in the histogram
+typedef struct _CSIAe_t
+{
+	uint8_t isEnabled;
+	uint8_t isHistValid;	// bins holds a full frame
+	uint8_t isHistNew;		// bins not yet used by CsiAeStep()
+	uint8_t settleCnt;
+	uint8_t target;			// wanted mean luma
+	uint8_t mean;			// mean luma of bins
+	uint16_t roiX, roiY, roiW, roiH;	// in output pixels
+	uint16_t roiWeight, outWeight;	// histogram weight of samples inside / outside the roi
+	int32_t expUs, expUsMax;
+	float gain, gainMax;	// linear
+	uint32_t curBins[CSI_AE_BINS];
+	uint32_t bins[CSI_AE_BINS];
+}CSIAe_t;
+static volatile CSIAe_t s_ae = {.target = 110, .roiWeight = 1, .outWeight = 1};
+
+// Capture path counters, see sensor_get_stats()
+typedef struct _CSIStats_t
+{
+	uint32_t fifoOvfCnt;	// CSISR RF_OR_INT seen
+	uint32_t fragMissCnt;	// a fragment was overwritten before its IRQ ran
+	uint32_t fragIrqCnt;
+	uint32_t fragIrqCycMax;
+	uint64_t fragIrqCycSum;
+	uint32_t waitUs;		// last wait for a frame
+	uint64_t waitUsSum;
+	uint32_t snapCnt;		// sensor_snapshot() calls
+	uint64_t runUsSum;		// time between them, outside the waits
+	uint64_t runUjSum, waitUjSum;	// power model estimates
+}CSIStats_t;
+static volatile CSIStats_t s_stats;
+
+// Capture waits, see sensor_set_low_power()
+typedef struct _CSIPower_t
+{
+	uint8_t mode;
+	uint8_t div;			// core clock divider of SENSOR_LP_SCALE waits
+	volatile uint8_t isScaled;
+	uint32_t fullHz;		// SystemCoreClock before scaling
+	uint32_t exitUs;		// the last sensor_snapshot() returned, 0 before the first
+}CSIPower_t;
+static CSIPower_t s_pwr = {.div = 1};
+
 typedef union {
 	uint8_t u8Ary[4][2];
 	struct {
@@ -488,73 +655,350 @@ typedef union {
 #ifdef __CC_ARM
 #define RAM_CODE __attribute__((section(".ram_code")))
 #else
-#define RAM_CODE
+// copied to ITCM by the startup code, so XIP flash latency does not eat into fragment deadlines
+#define RAM_CODE __attribute__((section("RamFunction")))
 #endif
 
-#ifdef __CC_ARM
-#define ARMCC_ASM_FUNC	__asm
-ARMCC_ASM_FUNC RAM_CODE uint32_t ExtractYFromYuv(uint32_t dmaBase, uint32_t datBase, uint32_t _128bitUnitCnt) {
-	push	{r4-r7, lr}
-10
-	LDMIA	R0!, {r3-r6}
-	// schedule code carefully to allow dual-issue on Cortex-M7
-	bfi		r7, r3, #0, #8	// Y0
-	bfi		ip, r5, #0, #8	// Y4
-	lsr		r3,	r3,	#16
-	lsr		r5,	r5,	#16
-	bfi		r7, r3, #8, #8	// Y1
-	bfi		ip, r5, #8, #8  // Y5
-	bfi		r7, r4, #16, #8 // Y2
-	bfi		ip, r6, #16, #8 // Y6
-	lsr		r4,	r4,	#16
-	lsr		r6,	r6,	#16
-	bfi		r7, r4, #24, #8 // Y3
-	bfi		ip, r6, #24, #8	// Y7
-	STMIA	r1!, {r7, ip}
-	
-	subs	r2,	#1
-	bne		%b10
-	mov		r0,	r1
-	pop		{r4-r7, pc}
-}
-#else
-__attribute__((naked))
+// Optional Y transform applied while extracting gray pixels, NULL for a plain copy.
+static uint8_t s_grayLut[256];
+static const uint8_t *s_pGrayLut;
+
+// Pack the Y bytes of 8 YUYV pixels per loop:
+// PKHBT/PKHTB gather Y0 U0 Y2 U2 and Y1 V0 Y3 V2, UXTB16 keeps the Y bytes of each half,
+// the second half is merged one byte up. Returns the next destination address.
 RAM_CODE uint32_t ExtractYFromYuv(uint32_t dmaBase, uint32_t datBase, uint32_t _128bitUnitCnt) {
-	__asm volatile (
-		"	push	{r1-r7, ip, lr}  \n "
-		"10:  \n "
-		"	ldmia	r0!, {r3-r6}  \n "
-			// schedule code carefully to allow dual-issue on Cortex-M7
-		"	bfi		r7, r3, #0, #8  \n "	// Y0
-		"	bfi		ip, r5, #0, #8  \n "	// Y4
-		"	lsr		r3,	r3,	#16  \n "
-		"	lsr		r5,	r5,	#16  \n "
-		"	bfi		r7, r3, #8, #8  \n "	// Y1
-		"	bfi		ip, r5, #8, #8  \n "  // Y5
-		"	bfi		r7, r4, #16, #8  \n " // Y2
-		"	bfi		ip, r6, #16, #8  \n " // Y6
-		"	lsr		r4,	r4,	#16  \n "
-		"	lsr		r6,	r6,	#16  \n "
-		"	bfi		r7, r4, #24, #8  \n " // Y3
-		"	bfi		ip, r6, #24, #8  \n "	// Y7
-		"	stmia	r1!, {r7, ip}  \n "	
-		"	subs	r2,	#1  \n "
-		"	bne		10b  \n "
-		"	mov		r0,	r1  \n "
-		"	pop		{r1-r7, ip, pc}  \n "		
-	);
+	const uint32_t *pSrc = (const uint32_t*) dmaBase;
+	uint32_t *pDst = (uint32_t*) datBase;
+	uint32_t w0, w1, w2, w3;
+	const uint8_t *pLut = s_pGrayLut;
+
+	if (pLut == NULL) {
+		while (_128bitUnitCnt--) {
+			w0 = pSrc[0], w1 = pSrc[1], w2 = pSrc[2], w3 = pSrc[3];
+			pSrc += 4;
+			pDst[0] = __UXTB16(__PKHBT(w0, w1, 16)) | __UXTB16(__PKHTB(w1, w0, 16)) << 8;
+			pDst[1] = __UXTB16(__PKHBT(w2, w3, 16)) | __UXTB16(__PKHTB(w3, w2, 16)) << 8;
+			pDst += 2;
+		}
+	} else {
+		while (_128bitUnitCnt--) {
+			w0 = pSrc[0], w1 = pSrc[1], w2 = pSrc[2], w3 = pSrc[3];
+			pSrc += 4;
+			pDst[0] = pLut[w0 & 0xFF] | pLut[(w0 >> 16) & 0xFF] << 8 | 
+				pLut[w1 & 0xFF] << 16 | pLut[(w1 >> 16) & 0xFF] << 24;
+			pDst[1] = pLut[w2 & 0xFF] | pLut[(w2 >> 16) & 0xFF] << 8 | 
+				pLut[w3 & 0xFF] << 16 | pLut[(w3 >> 16) & 0xFF] << 24;
+			pDst += 2;
+		}
+	}
+	return (uint32_t) pDst;
+}
+
+#ifdef CSI_FRAG_MODE
+// Fit the block grid to the output frame, blocks grow from 8x8 until the grid fits the tables.
+static void CsiMotionCalc(uint32_t w, uint32_t h) {
+	uint32_t shift = 3;
+	if (w == s_motion.frameW && h == s_motion.frameH)
+		return;
+	while ((w >> shift) * (h >> shift) > CSI_MOTION_MAX_BLOCKS)
+		shift++;
+	s_motion.blkShift = shift;
+	s_motion.gridW = w >> shift , s_motion.gridH = h >> shift;
+	s_motion.frameW = w , s_motion.frameH = h;
+	s_motion.isPrevValid = s_motion.isMaskValid = 0;
+	memset((void*)s_motion.curSum, 0, sizeof(s_motion.curSum));
+}
+
+// Output line formats for the luma of motion and AE: RGB565, a byte per pixel (grayscale, the
+// raw Bayer values stand in for it) and YUV422 with Y the first byte of every pixel.
+#define CSI_LUMA_RGB565	0
+#define CSI_LUMA_BYTE	1
+#define CSI_LUMA_YUV	2
+
+// Add the sampled brightness of lineCnt output lines starting at line lineNdx to their blocks.
+static RAM_CODE void CsiMotionAccumulate(uint32_t addr, uint32_t lineNdx, uint32_t lineCnt, uint32_t w, uint32_t lumaFmt) {
+	uint32_t shift = s_motion.blkShift, pitch = (lumaFmt == CSI_LUMA_BYTE) ? w : w * 2;
+	uint32_t x, sum, gridW = s_motion.gridW, blkW = 1 << shift;
+	const uint8_t *p;
+	volatile uint16_t *pSum;
+	for (; lineCnt; lineCnt--, lineNdx++, addr += pitch) {
+		if ((lineNdx & 1) || (lineNdx >> shift) >= s_motion.gridH)
+			continue;
+		pSum = s_motion.curSum + (lineNdx >> shift) * gridW;
+		p = (const uint8_t*) addr;
+		for (x=0; x<gridW; x++) {
+			uint32_t i;
+			sum = 0;
+			if (lumaFmt == CSI_LUMA_BYTE) {
+				for (i=0; i<blkW; i+=2)
+					sum += p[i];
+				p += blkW;
+			} else if (lumaFmt == CSI_LUMA_YUV) {
+				for (i=0; i<blkW * 2; i+=4)
+					sum += p[i];
+				p += blkW * 2;
+			} else {
+				// green of big endian RGB565, scaled to 8 bits
+				for (i=0; i<blkW * 2; i+=4)
+					sum += ((p[i] & 7) << 5) | ((p[i + 1] >> 3) & 0x1C);
+				p += blkW * 2;
+			}
+			pSum[x] += sum >> 2;
+		}
+	}
+}
+
+// End of frame: mark the blocks that changed since the previous frame.
+static RAM_CODE void CsiMotionFrameDone(void) {
+	uint32_t i, n = s_motion.gridW * s_motion.gridH, changed = 0;
+	int32_t diff;
+	// sums are of (blkW / 2)^2 samples, each divided by 4
+	uint32_t thresh = (s_motion.thresh << (2 * s_motion.blkShift - 2)) >> 2;
+	for (i=0; i<n; i++) {
+		diff = (int32_t)s_motion.curSum[i] - (int32_t)s_motion.prevSum[i];
+		if (diff < 0)
+			diff = -diff;
+		if (s_motion.isPrevValid && diff > thresh) {
+			s_motion.mask[i] = 255;
+			changed++;
+		} else {
+			s_motion.mask[i] = 0;
+		}
+		s_motion.prevSum[i] = s_motion.curSum[i];
+		s_motion.curSum[i] = 0;
+	}
+	s_motion.isMaskValid = s_motion.isPrevValid;
+	s_motion.isPrevValid = 1;
+	s_motion.changedCnt = changed;
+}
+
+// Add the sampled luma of lineCnt output lines starting at line lineNdx to the histogram.
+static RAM_CODE void CsiAeAccumulate(uint32_t addr, uint32_t lineNdx, uint32_t lineCnt, uint32_t w, uint32_t lumaFmt) {
+	uint32_t pitch = (lumaFmt == CSI_LUMA_BYTE) ? w : w * 2, step = (lumaFmt == CSI_LUMA_BYTE) ? 4 : 8;
+	uint32_t x, y, x0, x1, roiWeight = s_ae.roiWeight, outWeight = s_ae.outWeight;
+	const uint8_t *p;
+	volatile uint32_t *pBins = s_ae.curBins;
+	for (; lineCnt; lineCnt--, lineNdx++, addr += pitch) {
+		if (lineNdx & 3)
+			continue;
+		x0 = x1 = w;
+		if (lineNdx >= s_ae.roiY && lineNdx < s_ae.roiY + s_ae.roiH)
+			x0 = s_ae.roiX , x1 = s_ae.roiX + s_ae.roiW;
+		p = (const uint8_t*) addr;
+		for (x=0; x<w; x+=4, p+=step) {
+			if (lumaFmt != CSI_LUMA_RGB565) {
+				y = p[0];
+			} else {
+				// big endian RGB565, BT.601 weights
+				y = ((p[0] & 0xF8) * 77 + (((p[0] & 7) << 5) | ((p[1] >> 3) & 0x1C)) * 150 +
+					((p[1] & 0x1F) << 3) * 29) >> 8;
+			}
+			pBins[y >> 3] += (x >= x0 && x < x1) ? roiWeight : outWeight;
+		}
+	}
+}
+
+// End of frame: publish the histogram for CsiAeStep().
+static RAM_CODE void CsiAeFrameDone(void) {
+	uint32_t i, cnt = 0, sum = 0;
+	for (i=0; i<CSI_AE_BINS; i++) {
+		cnt += s_ae.curBins[i];
+		sum += s_ae.curBins[i] * (i * 8 + 4);
+		s_ae.bins[i] = s_ae.curBins[i];
+		s_ae.curBins[i] = 0;
+	}
+	s_ae.mean = cnt ? sum / cnt : 0;
+	s_ae.isHistValid = s_ae.isHistNew = 1;
 }
 
+// Tell Python a new frame is done, the callback gets the frame sequence number.
+// sensor.snapshot_async() hands this out, uselect is told when it turns readable.
+extern const mp_obj_base_t py_sensor_capture_obj;
+
+static void CsiNotifyFrameDone(void) {
+	mp_stream_poll_notify(&py_sensor_capture_obj);
+	mp_obj_t cb = MP_STATE_PORT(sensor_frame_cb);
+	if (cb != MP_OBJ_NULL && cb != mp_const_none)
+		mp_sched_schedule(cb, MP_OBJ_NEW_SMALL_INT(s_irq.frameSeq & 0x3FFFFFFF));
+}
+
+static RAM_CODE void CsiFragModeSetDmaBase(void) {
+	if (s_irq.isGray || s_sensor.isWindowing) {
+		s_pCSI->CSIDMASA_FB1 = (uint32_t) s_dmaFragBufs[0];
+		s_pCSI->CSIDMASA_FB2 = (uint32_t) s_dmaFragBufs[1];
+	} else {
+		s_pCSI->CSIDMASA_FB1 = s_irq.base0;
+		s_pCSI->CSIDMASA_FB2 = s_irq.base0 + s_irq.dmaBytePerFrag;
+	}
+	s_irq.datCurBase = s_irq.base0;
+}
+
+// Stop DMA and refill the current buffer from the next SOF, CSI keeps running.
+static RAM_CODE void CsiFragModeRestartFrame(void) {
+	//				 16 doubleWords| ReflashRFF
+	s_pCSI->CSICR3 = 2<<4		   | 1<<14;
+	s_pCSI->CSICR1 = CSICR1_INIT_VAL | 1<<16;	// wait for next SOF
+	s_irq.dmaFragNdx = 0;
+	s_irq.isInFrame = 0;
+	CsiFragModeSetDmaBase();
+	if (s_motion.isEnabled)
+		memset((void*)s_motion.curSum, 0, sizeof(s_motion.curSum));
+	if (s_ae.isEnabled)
+		memset((void*)s_ae.curBins, 0, sizeof(s_ae.curBins));
+}
+
+#ifndef NO_LCD_MONITOR
+// In direct mode LCDIF scans ring buffers in place, the one it shows and the one it shows from
+// its next VSync on.
+static RAM_CODE uint8_t CsiRingIsScanned(int8_t ndx) {
+	uint32_t addr = s_ring.bufs[ndx];
+	return s_isLcdScanCamRgb && (APP_ELCDIF->CUR_BUF == addr || APP_ELCDIF->NEXT_BUF == addr);
+}
+#else
+#define CsiRingIsScanned(ndx) 0
 #endif
 
-#ifdef CSI_FRAG_MODE
+// Called at the end of each frame in free-running mode: publish the buffer just filled
+// and re-arm DMA on the next free one. CSI keeps running, DMA resyncs on the next SOF.
+static RAM_CODE void CsiRingFrameDone(void) {
+	int8_t next = s_ring.wrNdx + 1 == s_ring.bufCnt ? 0 : s_ring.wrNdx + 1;
+	if (next == s_ring.readingNdx || CsiRingIsScanned(next)) {
+		// the next buffer is being copied out or shown, refill the same one and drop this frame
+		s_ring.dropCnt++;
+	} else {
+		if (s_ring.readyNdx >= 0)
+			s_ring.dropCnt++;
+		s_ring.bufSeq[s_ring.wrNdx] = ++s_irq.frameSeq;
+		s_ring.bufUs[s_ring.wrNdx] = s_irq.sofUs;
+		s_ring.readyNdx = s_ring.doneNdx = s_ring.wrNdx;
+		s_ring.wrNdx = next;
+		CsiNotifyFrameDone();
+	}
+	s_irq.base0 = s_ring.bufs[s_ring.wrNdx];
+	CsiFragModeRestartFrame();
+	s_isOmvSensorSnapshotReady = 1;
+}
+
+// The frame in s_irq.base0 is complete. Returns 1 if the ring keeps the CSI running,
+// 0 if it was stopped for stop-and-wait.
+static RAM_CODE uint8_t CsiFrameDone(void) {
+	trace_event(TRACE_CSI_EOF, s_irq.frameSeq + 1);
+	if (s_ring.bufCnt > 1) {
+		CsiRingFrameDone();
+		return 1;
+	}
+	CSI_Stop(CSI);
+	//				 16 doubleWords| ReflashRFF
+	s_pCSI->CSICR3 = 2<<4		   | 1<<14;
+	NVIC_DisableIRQ(CSI_IRQn);
+	++s_irq.frameSeq;
+	if (s_ring.bufCnt) {
+		s_ring.bufSeq[0] = s_irq.frameSeq;
+		s_ring.bufUs[0] = s_irq.sofUs;
+		s_ring.readyNdx = 0;
+	} else {
+		s_fbInfo.seq = s_irq.frameSeq;
+		s_fbInfo.stampUs = s_irq.sofUs;
+	}
+	s_isOmvSensorSnapshotReady = 1;
+	CsiNotifyFrameDone();
+	return 0;
+}
+
+// Length of the JPEG frame a VSync just ended, 0 if it is not one. DMA wrote the whole
+// fragments and, of the one in flight, all but what the RxFIFO still holds. The sensors pad
+// the last line well past the EOI marker, which pushes it out to memory, and entropy coded
+// data never holds an FFD9, so the first one from the last whole fragment on ends the frame.
+static RAM_CODE uint32_t CsiJpegLength(void) {
+	const uint8_t *p = (const uint8_t *) s_irq.base0;
+	uint32_t i = s_irq.dmaFragNdx ? (s_irq.dmaFragNdx - 1) * s_irq.dmaBytePerFrag : 2;
+	uint32_t end = (s_irq.dmaFragNdx + 1) * s_irq.dmaBytePerFrag;
+	dma_end_read((void*)p, 32);
+	if (p[0] != 0xFF || p[1] != 0xD8)
+		return 0;	// no SOI, DMA started mid frame
+	dma_end_read((void*)(p + i), end - i);
+	for (; i + 1 < end; i++) {
+		if (p[i] == 0xFF && p[i + 1] == 0xD9)
+			return i + 2;
+	}
+	return 0;
+}
+
+// Runs the core at its full clock / div or back at full with div 1. IPG stays at 150MHz by
+// taking the opposite divider, the SEMC has its own clock and keeps it as the CSI fills SDRAM.
+RAM_CODE static void CsiClockScale(uint32_t div)
+{
+	uint32_t atomic = disable_irq();
+	if ((div > 1) != s_pwr.isScaled) {
+		uint32_t val = SysTick->VAL, oldHz = SystemCoreClock, newHz;
+		if (div > 1) {
+			s_pwr.fullHz = oldHz;
+			// AHB before IPG, so IPG never goes over 150MHz on the way
+			CLOCK_SetDiv(kCLOCK_AhbDiv, div - 1);
+			CLOCK_SetDiv(kCLOCK_IpgDiv, 4 / div - 1);
+			newHz = oldHz / div;
+		} else {
+			CLOCK_SetDiv(kCLOCK_IpgDiv, 3);
+			CLOCK_SetDiv(kCLOCK_AhbDiv, 0);
+			newHz = s_pwr.fullHz;
+		}
+		systick_rescale(val, oldHz, newHz);
+		s_pwr.isScaled = div > 1;
+	}
+	enable_irq(atomic);
+}
+
+// One idle step of a capture wait: sleep until the next interrupt, at a lower clock in
+// SENSOR_LP_SCALE. The CSI IRQ takes the clock back up for its fragment work.
+static void CsiIdle(const volatile int8_t *pReadyNdx)
+{
+	if (s_pwr.mode == SENSOR_LP_OFF)
+		return;
+	uint32_t atomic = disable_irq();
+	if (pReadyNdx ? *pReadyNdx < 0 : !s_isOmvSensorSnapshotReady) {
+		// the boot dividers, pwm.c may have set others meanwhile
+		if (s_pwr.mode == SENSOR_LP_SCALE && CLOCK_GetDiv(kCLOCK_AhbDiv) == 0 && CLOCK_GetDiv(kCLOCK_IpgDiv) == 3)
+			CsiClockScale(s_pwr.div);
+		__WFI();
+	}
+	enable_irq(atomic);
+}
+
 RAM_CODE void CSI_IRQHandler(void) {
+	if (s_pwr.isScaled)
+		CsiClockScale(1);
+	uint32_t t0 = DWT->CYCCNT;
     uint32_t csisr = s_pCSI->CSISR;
     /* Clear the error flags. */
     s_pCSI->CSISR = csisr;
+	if ((csisr & (1<<16)) && s_modeDeltaCnt) {
+		// sensor_set_mode(): the frame just started, the writes land in its blanking
+		cambus_batch_async(s_sensor.slv_addr, s_modeDelta, s_modeDeltaCnt);
+		s_modeDeltaCnt = 0;
+		CSI_Stop(CSI);
+		NVIC_DisableIRQ(CSI_IRQn);
+		return;
+	}
+	if (csisr & CSI_CSISR_RF_OR_INT_MASK)
+		s_stats.fifoOvfCnt++;
 
 	if (csisr & (1<<16)) {
 		// VSync
+		if (s_irq.isJpeg && s_irq.isInFrame) {
+			// which also ends the JPEG frame of the last one
+			uint32_t len = CsiJpegLength();
+			if (len) {
+				s_irq.jpegBytes = s_ring.bufBytes[s_ring.wrNdx] = len;
+				if (!CsiFrameDone())
+					goto Cleanup;
+			} else {
+				s_ring.dropCnt++;
+				CsiFragModeRestartFrame();
+			}
+		}
+		s_irq.isInFrame = 1;
+		s_irq.sofUs = mp_hal_ticks_us();
+		trace_event(TRACE_CSI_SOF, s_irq.frameSeq + 1);
 		//               SOF    | FB1    | FB2    irqEn
 		s_pCSI->CSICR1 = 1U<<16 | 1U<<19 | 1U<<20 | CSICR1_INIT_VAL;
 		//				 16 doubleWords| RxFifoDmaReqEn| ReflashRFF|ResetFrmCnt
@@ -562,37 +1006,80 @@ RAM_CODE void CSI_IRQHandler(void) {
 	} else if (csisr & (3<<19))
 	{
 		uint32_t dmaBase, lineNdx = s_irq.dmaFragNdx * s_irq.linePerFrag;
+		trace_event(TRACE_CSI_FRAG, s_irq.dmaFragNdx);
+		if ((csisr & (3<<19)) == 3<<19 && s_irq.dmaFragNdx + 1 < s_irq.fragCnt) {
+			// Both buffers completed before we got here, one fragment is lost.
+			// Drop the frame and capture the next one instead of returning a torn picture.
+			s_stats.fragMissCnt++;
+			trace_event(TRACE_CSI_FRAG_LOST, s_irq.dmaFragNdx);
+			CsiFragModeRestartFrame();
+			goto Cleanup;
+		}
+		if (s_irq.isJpeg) {
+			// the frame ends at the next SOF, filling the destination first means it did not fit
+			if (++s_irq.dmaFragNdx == s_irq.fragCnt) {
+				s_ring.dropCnt++;
+				CsiFragModeRestartFrame();
+				goto Cleanup;
+			}
+			goto NextFrag;
+		}
 			if (s_irq.dmaFragNdx & 1)
 				dmaBase = s_pCSI->CSIDMASA_FB2;
 			else
 				dmaBase = s_pCSI->CSIDMASA_FB1;
-		if (dmaBase >= 0x20200000)
-			DCACHE_CleanInvalidateByRange(dmaBase, s_irq.dmaBytePerFrag);
-		if (s_irq.isGray || 
-			(s_sensor.isWindowing &&  lineNdx >= s_sensor.wndY && lineNdx - s_sensor.wndY <= s_sensor.wndH) )
+		dma_end_read((void*)dmaBase, s_irq.dmaBytePerFrag);
+		if (s_irq.isGray || s_sensor.isWindowing)
 		{
-
-			dmaBase += s_sensor.wndX * 2 * s_irq.linePerFrag;	// apply line window offset
-			if (s_irq.isGray) {
-				
-				s_irq.datCurBase = ExtractYFromYuv(dmaBase, s_irq.datCurBase, (s_sensor.wndW * s_irq.linePerFrag) >> 3);
-			} else {
-				uint32_t byteToCopy = (s_sensor.wndW * s_irq.linePerFrag) << 1;
-				memcpy((void*)s_irq.datCurBase, (void*)dmaBase, byteToCopy);
-				s_irq.datCurBase += byteToCopy;
+			// crop the window out of the lines of this fragment
+			uint32_t lineEnd = lineNdx + s_irq.linePerFrag, lineCnt;
+			uint32_t wndX = 0, wndY = 0, wndW = s_sensor.fb_w, wndEnd = s_sensor.fb_h;
+			if (s_sensor.isWindowing) {
+				wndX = s_sensor.wndX , wndY = s_sensor.wndY;
+				wndW = s_sensor.wndW , wndEnd = wndY + s_sensor.wndH;
 			}
+			if (lineNdx < wndY)
+				lineNdx = wndY;
+			if (lineEnd > wndEnd)
+				lineEnd = wndEnd;
+			if (lineNdx < lineEnd) {
+				uint32_t datStart = s_irq.datCurBase, outW = wndW;
+				dmaBase += (lineNdx - s_irq.dmaFragNdx * s_irq.linePerFrag) * s_irq.dmaBytePerLine + wndX * s_irq.busBpp;
+				// full width lines are contiguous and go in one pass
+				lineCnt = wndW == s_sensor.fb_w ? 1 : lineEnd - lineNdx;
+				if (lineCnt == 1)
+					wndW *= lineEnd - lineNdx;
+				for (; lineCnt; lineCnt--, dmaBase += s_irq.dmaBytePerLine) {
+					if (s_irq.isGray) {
+						s_irq.datCurBase = ExtractYFromYuv(dmaBase, s_irq.datCurBase, wndW >> 3);
+					} else {
+						memcpy((void*)s_irq.datCurBase, (void*)dmaBase, wndW * s_irq.busBpp);
+						s_irq.datCurBase += wndW * s_irq.busBpp;
+					}
+				}
+				if (s_motion.isEnabled)
+					CsiMotionAccumulate(datStart, lineNdx - wndY, lineEnd - lineNdx, outW, s_irq.lumaFmt);
+				if (s_ae.isEnabled)
+					CsiAeAccumulate(datStart, lineNdx - wndY, lineEnd - lineNdx, outW, s_irq.lumaFmt);
+			}
+		} else {
+			// DMA wrote the lines in place, raw Bayer values or Y stand in for the luma
+			if (s_motion.isEnabled)
+				CsiMotionAccumulate(dmaBase, lineNdx, s_irq.linePerFrag, s_sensor.fb_w, s_irq.lumaFmt);
+			if (s_ae.isEnabled)
+				CsiAeAccumulate(dmaBase, lineNdx, s_irq.linePerFrag, s_sensor.fb_w, s_irq.lumaFmt);
 		}
 		
 		if (++s_irq.dmaFragNdx == s_irq.fragCnt || (csisr & (3<<19)) == 3<<19 )
 		{
-			CSI_Stop(CSI);
-			//				 16 doubleWords| ReflashRFF
-			s_pCSI->CSICR3 = 2<<4		   | 1<<14;
-			NVIC_DisableIRQ(CSI_IRQn);
-			s_isOmvSensorSnapshotReady = 1;	
+			if (s_motion.isEnabled)
+				CsiMotionFrameDone();
+			if (s_ae.isEnabled)
+				CsiAeFrameDone();
+			CsiFrameDone();
 			goto Cleanup;
 		}
-		
+NextFrag:
 		if (csisr & (1<<19) ) {
 			if (!s_irq.isGray && !s_sensor.isWindowing)
 				s_pCSI->CSIDMASA_FB1 += 2 * s_irq.dmaBytePerFrag;
@@ -603,6 +1090,13 @@ RAM_CODE void CSI_IRQHandler(void) {
 		}
 	}
 Cleanup:
+	if (csisr & (3<<19)) {
+		t0 = DWT->CYCCNT - t0;
+		if (t0 > s_stats.fragIrqCycMax)
+			s_stats.fragIrqCycMax = t0;
+		s_stats.fragIrqCycSum += t0;
+		s_stats.fragIrqCnt++;
+	}
 	return;
 }
 #else
@@ -629,27 +1123,29 @@ void CsiFragModeInit(void) {
 	NVIC_SetPriority(CSI_IRQn, IRQ_PRI_CSI);
 }
 
-void CsiFragModeCalc(void) {
-	s_irq.datBytePerLine = s_irq.dmaBytePerLine = s_sensor.fb_w * 2;
-	if (s_sensor.pixformat == PIXFORMAT_GRAYSCALE) {
-		s_irq.datBytePerLine /= 2;	// only contain Y
-		s_irq.isGray = 1;
-		s_sensor.gs_bpp = 1;
-	} else {
-		s_irq.isGray = 0;
-		s_sensor.gs_bpp = 2;
-	}
-	if (s_sensor.fb_w == 0 || s_sensor.fb_h == 0)
-		return;
+// The fragment geometry only depends on the frame size and format but is needed at the start
+// of every frame, so the last few results are kept.
+typedef struct _CSIFragProfile_t
+{
+	uint16_t w, h;
+	uint8_t isGray, isRaw;
+	uint8_t burstSel;	// CSICR2 burst type: 3 = INCR16, 2 = INCR8, 1 = INCR4
+	uint16_t linePerFrag;
+	uint32_t dmaBytePerFrag;
+}CSIFragProfile_t;
+#define CSI_FRAG_PROFILES	4
+static CSIFragProfile_t s_fragProfiles[CSI_FRAG_PROFILES];
+static uint8_t s_fragProfileNext;
 
+static void CsiFragProfileCalc(CSIFragProfile_t *p, uint32_t dmaBytePerLine) {
 	// calculate max bytes per DMA frag
 	uint32_t dmaBytePerFrag, byteStep, dmaByteTotal;
 	uint32_t maxBytePerLine = sizeof(s_dmaFragBufs) / ARRAY_SIZE(s_dmaFragBufs);
-	dmaByteTotal = s_sensor.fb_w * s_sensor.fb_h * 2;	
-	if (s_sensor.wndX == 0 && s_sensor.wndY == 0) // (s_irq.isGray)
+	dmaByteTotal = p->w * p->h * 2;
+	// windows are cropped line by line out of each fragment, so they use the same fragment size
 	{
-		dmaBytePerFrag = s_irq.dmaBytePerLine;  // set a minial default value
-		for (byteStep = s_irq.dmaBytePerLine; byteStep < maxBytePerLine; byteStep += s_irq.dmaBytePerLine) {
+		dmaBytePerFrag = dmaBytePerLine;  // set a minial default value
+		for (byteStep = dmaBytePerLine; byteStep < maxBytePerLine; byteStep += dmaBytePerLine) {
 			if (0 == byteStep % 32 )
 			{
 				// find maximum allowed bytes per frag
@@ -665,53 +1161,92 @@ void CsiFragModeCalc(void) {
 				break;
 			}
 		}
-	} 
-	else {
-		// for window mode, we only accept 1 line per frag
-		dmaBytePerFrag = s_irq.dmaBytePerLine;
 	}
-	s_irq.linePerFrag = dmaBytePerFrag / s_irq.dmaBytePerLine;
-	s_irq.dmaBytePerFrag = dmaBytePerFrag;
-	s_irq.datBytePerLine = s_irq.isGray ? dmaBytePerFrag / 2 : dmaBytePerFrag;
+	p->linePerFrag = dmaBytePerFrag / dmaBytePerLine;
+	p->dmaBytePerFrag = dmaBytePerFrag;
+	if (!(dmaBytePerLine % (8 * 16)))
+		p->burstSel = 3;	// 128 bytes
+	else if (!(dmaBytePerLine % (8 * 8)))
+		p->burstSel = 2;	// 64 bytes
+	else
+		p->burstSel = 1;	// 32 bytes
+}
 
-	// >>> calculate how many lines per fragment (DMA xfer unit)
-	uint32_t burstBytes;
-	if (!(s_irq.dmaBytePerLine % (8 * 16)))
-	{
-		burstBytes = 128;
-		s_pCSI->CSICR2 = CSI_CSICR2_DMA_BURST_TYPE_RFF(3U);
-		s_pCSI->CSICR3 = (CSI->CSICR3 & ~CSI_CSICR3_RxFF_LEVEL_MASK) | ((2U << CSI_CSICR3_RxFF_LEVEL_SHIFT));
+void CsiFragModeCalc(void) {
+	const CSIFragProfile_t *p;
+	uint32_t i;
+	uint8_t isGray = s_sensor.pixformat == PIXFORMAT_GRAYSCALE;
+	// Raw Bayer comes one byte per pixel and lands as it is, demosaiced on demand by imlib.
+	uint8_t isRaw = s_sensor.pixformat == PIXFORMAT_BAYER;
+	// JPEG has no lines, it is a stream of bytes cut into whole fragments DMA writes in place.
+	uint8_t isJpeg = s_sensor.pixformat == PIXFORMAT_JPEG;
+	s_irq.busBpp = (isRaw || isJpeg) ? 1 : 2;
+	s_irq.isRaw = isRaw;
+	s_irq.isJpeg = isJpeg;
+	if (isJpeg) {
+		s_irq.isGray = 0;
+		s_sensor.gs_bpp = 1;
+		s_irq.lumaFmt = CSI_LUMA_BYTE;
+		s_irq.linePerFrag = 1;
+		s_irq.dmaBytePerLine = s_irq.dmaBytePerFrag = s_irq.datBytePerLine = CSI_FRAG_MAX_BYTES;
+		s_irq.fragCnt = s_irq.jpegCap / CSI_FRAG_MAX_BYTES;
+		// RxFIFO DMA request at INCR16, the fragments are a multiple of 128 bytes
+		s_pCSI->CSICR2 = CSI_CSICR2_DMA_BURST_TYPE_RFF(3);
+		s_pCSI->CSICR3 = (CSI->CSICR3 & ~CSI_CSICR3_RxFF_LEVEL_MASK) | (2U << CSI_CSICR3_RxFF_LEVEL_SHIFT);
+		return;
 	}
-	else if (!(s_irq.dmaBytePerLine % (8 * 8)))
-	{
-		burstBytes = 64;
-		s_pCSI->CSICR2 = CSI_CSICR2_DMA_BURST_TYPE_RFF(2U);
-		s_pCSI->CSICR3 = (CSI->CSICR3 & ~CSI_CSICR3_RxFF_LEVEL_MASK) | ((1U << CSI_CSICR3_RxFF_LEVEL_SHIFT));
+	// YUV422 lands as it is too, the same bus bytes as RGB565.
+	s_irq.lumaFmt = (isGray || isRaw) ? CSI_LUMA_BYTE :
+		((s_sensor.pixformat == PIXFORMAT_YUV422) ? CSI_LUMA_YUV : CSI_LUMA_RGB565);
+	s_irq.datBytePerLine = s_irq.dmaBytePerLine = s_sensor.fb_w * s_irq.busBpp;
+	if (isGray) {
+		s_irq.datBytePerLine /= 2;	// only contain Y
+		s_irq.isGray = 1;
+		s_sensor.gs_bpp = 1;
+	} else {
+		s_irq.isGray = 0;
+		s_sensor.gs_bpp = isRaw ? 1 : 2;
 	}
-	else
-	{
-		burstBytes = 32;
-		s_pCSI->CSICR2 = CSI_CSICR2_DMA_BURST_TYPE_RFF(1U);
-		s_pCSI->CSICR3 = (CSI->CSICR3 & ~CSI_CSICR3_RxFF_LEVEL_MASK) | ((0U << CSI_CSICR3_RxFF_LEVEL_SHIFT));
+	if (s_sensor.fb_w == 0 || s_sensor.fb_h == 0)
+		return;
+
+	for (i = 0; i < CSI_FRAG_PROFILES; i++) {
+		p = s_fragProfiles + i;
+		if (p->w == s_sensor.fb_w && p->h == s_sensor.fb_h && p->isGray == isGray && p->isRaw == isRaw && p->linePerFrag)
+			break;
+	}
+	if (i == CSI_FRAG_PROFILES) {
+		CSIFragProfile_t *q = s_fragProfiles + s_fragProfileNext;
+		s_fragProfileNext = (s_fragProfileNext + 1) % CSI_FRAG_PROFILES;
+		q->w = s_sensor.fb_w;
+		q->h = s_sensor.fb_h;
+		q->isGray = isGray;
+		q->isRaw = isRaw;
+		CsiFragProfileCalc(q, s_irq.dmaBytePerLine);
+		p = q;
 	}
+
+	s_irq.linePerFrag = p->linePerFrag;
+	s_irq.dmaBytePerFrag = p->dmaBytePerFrag;
+	s_irq.datBytePerLine = isGray ? p->dmaBytePerFrag / 2 : p->dmaBytePerFrag;
+	// RxFIFO DMA request at one burst
+	s_pCSI->CSICR2 = CSI_CSICR2_DMA_BURST_TYPE_RFF(p->burstSel);
+	s_pCSI->CSICR3 = (CSI->CSICR3 & ~CSI_CSICR3_RxFF_LEVEL_MASK) | ((p->burstSel - 1U) << CSI_CSICR3_RxFF_LEVEL_SHIFT);
 	s_irq.fragCnt = s_sensor.fb_h / s_irq.linePerFrag;
-	// <<<
+	if (s_irq.isGray || s_sensor.isWindowing)
+		CsiMotionCalc(s_sensor.wndW, s_sensor.wndH);
+	else
+		CsiMotionCalc(s_sensor.fb_w, s_sensor.fb_h);
 }
 
 void CsiFragModeStartNewFrame(void) {
 	CsiFragModeCalc();
 	s_irq.dmaFragNdx = 0;
+	s_irq.isInFrame = 0;
 	s_irq.cnt++;
 	// DMA also writes to this cache line, to avoid being invalidated, clean MAIN_FB header.
-	DCACHE_CleanByRange((uint32_t)MAIN_FB(), 32);
-	if (s_irq.isGray || s_sensor.isWindowing) {
-		s_pCSI->CSIDMASA_FB1 = (uint32_t) s_dmaFragBufs[0];
-		s_pCSI->CSIDMASA_FB2 = (uint32_t) s_dmaFragBufs[1];
-	} else {
-		s_pCSI->CSIDMASA_FB1 = s_irq.base0;
-		s_pCSI->CSIDMASA_FB2 = s_irq.base0 + s_irq.dmaBytePerFrag;
-	}
-	s_irq.datCurBase = s_irq.base0; // + s_sensor.wndY * s_irq.datBytePerLine + s_sensor.wndX * s_sensor.gs_bpp;
+	dma_begin_write(MAIN_FB(), sizeof(framebuffer_t));
+	CsiFragModeSetDmaBase();
 	s_pCSI->CSICR1 = CSICR1_INIT_VAL | 1<<16;	// enable SOF iRQ
 	if (s_irq.dmaBytePerFrag & 0xFFFF0000) {
 		
@@ -726,6 +1261,110 @@ void CsiFragModeStartNewFrame(void) {
 	NVIC_EnableIRQ(CSI_IRQn);
 	__set_PRIMASK(0);	
 }
+
+void CsiRingStop(void) {
+	if (s_ring.isRunning) {
+		NVIC_DisableIRQ(CSI_IRQn);
+		CSI_Stop(CSI);
+		s_pCSI->CSICR3 = 2<<4 | 1<<14;
+		s_ring.isRunning = 0;
+	}
+	s_ring.bufCnt = 0;
+	s_ring.readyNdx = s_ring.readingNdx = s_ring.doneNdx = -1;
+	s_irq.base0 = (uint32_t)(MAIN_FB()->pixels);
+	fb_ring_size = 0;
+	if (s_isSnapshotArmed) {
+		NVIC_DisableIRQ(CSI_IRQn);
+		CSI_Stop(CSI);
+		s_isSnapshotArmed = 0;
+	}
+	s_isOmvSensorSnapshotReady = 0;
+}
+
+// JPEG frames are given up to 2 bytes a pixel, as much of it as there is room for.
+static uint32_t CsiJpegCapacity(uint32_t room) {
+	uint32_t cap = IM_MIN(s_sensor.fb_w * s_sensor.fb_h * 2, room);
+	return cap - cap % CSI_FRAG_MAX_BYTES;
+}
+
+// Lay out the capture buffers for the current frame geometry and start capturing.
+static void CsiRingStart(void) {
+	uint32_t i, room, bufCnt;
+	// MAIN_FB()->pixels keeps the frame handed to Python, the rest of the ring follows it.
+	fb_ring_size = 0;
+	room = fb_avail_from(MAIN_FB()->pixels);
+	if (s_sensor.pixformat == PIXFORMAT_JPEG)
+		s_irq.jpegCap = CsiJpegCapacity(room / s_ring.fbCnt);
+	CsiFragModeCalc();
+	s_ring.frameBytes = s_irq.isJpeg ? s_irq.jpegCap : s_sensor.wndW * s_sensor.wndH * s_sensor.gs_bpp;
+	s_ring.stride = (s_ring.frameBytes + 31) & ~31;
+	bufCnt = s_ring.stride ? room / s_ring.stride : 0;
+	bufCnt = bufCnt ? IM_MIN(bufCnt - 1, s_ring.fbCnt - 1U) : 0;
+	s_ring.bufCnt = bufCnt;
+	if (!bufCnt)
+		return;	// not enough fb memory, fall back to stop-and-wait
+	for (i=0; i<bufCnt; i++)
+		s_ring.bufs[i] = (uint32_t) MAIN_FB()->pixels + (i + 1) * s_ring.stride;
+	fb_ring_size = (bufCnt + 1) * s_ring.stride;
+	// drop stale fb_alloc lines so they can not be written back over DMA data later
+	dma_begin_read((void*)s_ring.bufs[0], bufCnt * s_ring.stride);
+	s_ring.wrNdx = 0;
+	s_ring.readyNdx = s_ring.readingNdx = s_ring.doneNdx = -1;
+	s_ring.isRunning = 1;
+	s_irq.base0 = s_ring.bufs[0];
+	CsiFragModeStartNewFrame();
+}
+
+// Wait for the newest completed frame of the ring and copy it to MAIN_FB()->pixels.
+static void CsiStatsAddWait(uint32_t t0) {
+	uint32_t mw = OMV_PWR_STATIC_MW + OMV_PWR_RUN_MW;	// spinning
+	CsiClockScale(1);
+	s_stats.waitUs = mp_hal_ticks_us() - t0;
+	s_stats.waitUsSum += s_stats.waitUs;
+	if (s_pwr.mode == SENSOR_LP_WFI)
+		mw = OMV_PWR_STATIC_MW + OMV_PWR_WFI_MW;
+	else if (s_pwr.mode == SENSOR_LP_SCALE)
+		mw = OMV_PWR_STATIC_MW + OMV_PWR_WFI_MW / s_pwr.div;
+	s_stats.waitUjSum += (uint64_t)s_stats.waitUs * mw / 1000;
+}
+
+// The script ran at full clock from the last snapshot until this one.
+static void CsiStatsAddRun(void) {
+	uint32_t t = mp_hal_ticks_us();
+	if (s_pwr.exitUs) {
+		t -= s_pwr.exitUs;
+		s_stats.runUsSum += t;
+		s_stats.runUjSum += (uint64_t)t * (OMV_PWR_STATIC_MW + OMV_PWR_RUN_MW) / 1000;
+	}
+	s_stats.snapCnt++;
+}
+
+static void CsiRingGetFrame(uint8_t *pDst) {
+	int8_t ndx;
+	uint32_t bytes;
+	uint32_t t0 = mp_hal_ticks_us();
+	while (s_ring.readyNdx < 0) {CsiIdle(&s_ring.readyNdx);}
+	CsiStatsAddWait(t0);
+	__set_PRIMASK(1);
+	ndx = s_ring.readyNdx;
+	s_ring.readyNdx = -1;
+	s_ring.readingNdx = ndx;
+	s_isOmvSensorSnapshotReady = 0;
+	__set_PRIMASK(0);
+	bytes = s_irq.isJpeg ? s_ring.bufBytes[ndx] : s_ring.frameBytes;
+	if (s_irq.isJpeg)
+		MAIN_FB()->bpp = bytes;
+	dma_end_read((void*)s_ring.bufs[ndx], bytes);
+	memcpy(pDst, (void*)s_ring.bufs[ndx], bytes);
+	s_fbInfo.seq = s_ring.bufSeq[ndx];
+	s_fbInfo.stampUs = s_ring.bufUs[ndx];
+	s_ring.readingNdx = -1;
+	if (s_ring.bufCnt == 1) {
+		// double buffering: the capture buffer is free again, fill it while Python works
+		s_irq.base0 = s_ring.bufs[0];
+		CsiFragModeStartNewFrame();
+	}
+}
 #define CAMERA_TAKE_SNAPSHOT() CsiFragModeStartNewFrame()
 #else
 #define CAMERA_TAKE_SNAPSHOT() do { \
@@ -737,14 +1376,16 @@ CAMERA_RECEIVER_Start(&cameraReceiver);  \
 
 #endif
 
+// The wait is idle time, a recorder or stream server without its own thread works meanwhile.
 #define CAMERA_WAIT_FOR_SNAPSHOT() do { \
-	while (0 == s_isOmvSensorSnapshotReady) {} \
+	while (0 == s_isOmvSensorSnapshotReady) {mjpeg_rec_poll(); stream_server_poll(); task_poll(); CsiIdle(NULL);} \
 	s_isOmvSensorSnapshotReady = 0; \
 	}while(0)
 volatile uint8_t s_isEnUsbIrqForSnapshot;
 
 int sensor_init()
 {   
+	mp_hal_ticks_cpu_enable();	// DWT cycle counter for the capture stats
 	#ifndef XIP_EXTERNAL_FLASH
 	s_isEnUsbIrqForSnapshot = 1;
 	#endif
@@ -854,7 +1495,8 @@ int sensor_init()
     */
     CAMERA_RECEIVER_Init(&cameraReceiver, &cameraConfig, NULL, NULL);
 	#endif
-	#ifndef NO_LCD_MONITOR // #ifdef __CC_ARM
+	#if !defined(NO_LCD_MONITOR) && !MICROPY_HW_FAST_BOOT // #ifdef __CC_ARM
+	// with fast boot the first frame shown brings the LCD up
 	LCDMonitor_Init();
 	#endif
 	// CAMERA_TAKE_SNAPSHOT();	
@@ -868,27 +1510,65 @@ int sensor_init()
 }
 
 uint8_t s_isSensorInited;
+static uint32_t s_settleTick;	// systick ms the last reset's registers are in effect
+static uint8_t s_isSettling;
+#if MICROPY_HW_FAST_BOOT
+static uint8_t s_isBootReset;	// sensor_boot_start() reset it, nothing was written since
+static uint32_t s_bootResetWrites;
+#endif
+
+void sensor_settle(uint32_t ms)
+{
+	s_settleTick = systick_current_millis() + ms;
+	s_isSettling = 1;
+}
+
+static void sensor_wait_settled(void)
+{
+	while (s_isSettling && (int32_t)(systick_current_millis() - s_settleTick) < 0)
+		__WFI();
+	s_isSettling = 0;
+}
+
 int sensor_reset()
 {
-	if (!s_isSensorInited) {
+	#if MICROPY_HW_FAST_BOOT
+	uint8_t isBootReset = s_isBootReset && s_bootResetWrites == cambus_write_count();
+	s_isBootReset = 0;
+	#else
+	const uint8_t isBootReset = 0;
+	#endif
+	if (!s_isSensorInited && !isBootReset) {
 		sensor_init0();
 		sensor_init();	
 	
 	}	
 	#ifndef NO_LCD_MONITOR
-	LCDMonitor_InitFB();
+	if (s_isLcdInited)
+		LCDMonitor_InitFB();
 	#endif
+	CsiRingStop();
+	s_ring.fbCnt = 1;
+	s_pGrayLut = NULL;
+	s_motion.isEnabled = 0;
+	s_ae.isEnabled = 0;
+	fb_set_delta_preview(false, 1, 0);
 	s_sensor.isWindowing = 0;
 	s_sensor.wndH = s_sensor.fb_h;
 	s_sensor.wndW = s_sensor.fb_w;
 	s_sensor.wndX = s_sensor.wndY = 0;	
+	SensorModeInvalidate(true);
+	if (isBootReset) {
+		// the registers are still the defaults the boot wrote
+		return 0;
+	}
 
 	#ifdef BOARD_RTEVK
 	// CSI clk src: 24MHz XTAL,
 	sensor_set_framerate(0x80000000 | (0<<9|(2-1)<<11));	
 	#else
-	// CSI clk src: 480MHz USBPLL, CSI MCLK = 480 / 4 / 8 = 15MHz
-	sensor_set_framerate(0x80000000 | (2<<9|(8-1)<<11));
+	// CSI clk src: 480MHz USBPLL, CSI MCLK = 480 / 4 / 8 = 15MHz, or as the perf profile sets it
+	sensor_set_framerate(0x80000000 | (2<<9|perf_csi_div<<11));
 	#endif
     // Reset the sesnor state
     s_sensor.sde          = 0xFF;
@@ -909,6 +1589,22 @@ int sensor_reset()
     return 0;
 }
 
+int sensor_boot_start()
+{
+	#if MICROPY_HW_FAST_BOOT
+	// keeps the CSI and the sensor's reset pulses and registers off the first script's path,
+	// the settle time after them runs on while the file systems mount
+	s_isBootReset = 0;
+	if (sensor_reset() != 0)
+		return -1;
+	s_bootResetWrites = cambus_write_count();
+	s_isBootReset = 1;
+	return 0;
+	#else
+	return 0;
+	#endif
+}
+
 int sensor_get_id()
 {
     return s_sensor.chip_id;
@@ -946,6 +1642,7 @@ int sensor_write_reg(uint16_t reg_addr, uint16_t reg_data)
         // Operation not supported
         return -1;
     }
+    SensorModeInvalidate(true);
     return s_sensor.write_reg(&s_sensor, reg_addr, reg_data);
 }
 
@@ -965,11 +1662,8 @@ int sensor_set_pixformat(pixformat_t pixformat)
 
     // Set pixel format
     s_sensor.pixformat = pixformat;
-
-    // Set JPEG mode + no support function
-    if (pixformat == PIXFORMAT_JPEG) {
-        return -1;
-    }
+    SensorModeInvalidate(false);
+    CsiRingStop();
 
     // Skip the first frame.
     MAIN_FB()->bpp = 0;
@@ -989,6 +1683,8 @@ int sensor_set_framesize(framesize_t framesize)
 
     // Set framebuffer size
     s_sensor.framesize = framesize;
+    SensorModeInvalidate(false);
+    CsiRingStop();
 
     // Skip the first frame.
     MAIN_FB()->bpp = -1;
@@ -1004,6 +1700,112 @@ int sensor_set_framesize(framesize_t framesize)
     return 0;
 }
 
+static int SensorModeFind(framesize_t framesize, pixformat_t pixformat) {
+	int i;
+	for (i = 0; i < SENSOR_MODE_PROFILES; i++) {
+		if (s_modes[i].regCnt && s_modes[i].framesize == framesize && s_modes[i].pixformat == pixformat)
+			return i;
+	}
+	// take the next slot, but never the one the sensor is in, the delta is against it
+	i = s_modeNext;
+	if (i == s_modeCur)
+		i = (i + 1) % SENSOR_MODE_PROFILES;
+	s_modeNext = (i + 1) % SENSOR_MODE_PROFILES;
+	int n = s_sensor.get_mode_regs(&s_sensor, framesize, pixformat, s_modes[i].regs);
+	if (n <= 0 || n > SENSOR_MODE_REGS_MAX) {
+		s_modes[i].regCnt = 0;
+		return -1;
+	}
+	s_modes[i].framesize = framesize;
+	s_modes[i].pixformat = pixformat;
+	s_modes[i].regCnt = n;
+	return i;
+}
+
+// The writes of mode that differ from the current one, all of them if it is unknown.
+static int SensorModeDelta(const SensorMode_t *mode, cambus_op_t *ops) {
+	int i, j, n = 0;
+	const SensorMode_t *cur = s_modeCur >= 0 ? &s_modes[s_modeCur] : NULL;
+	for (i = 0; i < mode->regCnt; i++) {
+		const cambus_op_t *op = &mode->regs[i];
+		if (cur) {
+			for (j = 0; j < cur->regCnt; j++) {
+				if (cur->regs[j].reg == op->reg)
+					break;
+			}
+			if (j < cur->regCnt && cur->regs[j].val == op->val)
+				continue;
+		}
+		ops[n++] = *op;
+	}
+	return n;
+}
+
+#define SENSOR_MODE_SOF_TIMEOUT		(200)	// ms, a few frames at the lowest frame rate
+
+int sensor_set_mode(framesize_t framesize, pixformat_t pixformat)
+{
+	if (s_sensor.get_mode_regs == NULL || pixformat == PIXFORMAT_JPEG) {
+		if (sensor_set_pixformat(pixformat) != 0)
+			return -1;
+		return sensor_set_framesize(framesize);
+	}
+	if (s_modeCur >= 0 && s_sensor.framesize == framesize && s_sensor.pixformat == pixformat)
+		return 0;
+
+	int ndx = SensorModeFind(framesize, pixformat);
+	if (ndx < 0)
+		return -1;
+	CsiRingStop();
+	int n = SensorModeDelta(&s_modes[ndx], s_modeDelta);
+	int ret = 0;
+	if (n) {
+#ifdef CSI_FRAG_MODE
+		// run the CSI with only the SOF IRQ, which starts the writes and stops it again
+		__set_PRIMASK(1);
+		s_modeDeltaCnt = n;
+		s_pCSI->CSICR1 = CSICR1_INIT_VAL | 1<<16;
+		s_pCSI->CSISR = s_pCSI->CSISR;
+		s_pCSI->CSICR18 |= 1U<<31;
+		NVIC_EnableIRQ(CSI_IRQn);
+		__set_PRIMASK(0);
+		uint32_t t0 = HAL_GetTick();
+		while (s_modeDeltaCnt && HAL_GetTick() - t0 < SENSOR_MODE_SOF_TIMEOUT)
+			__WFI();
+		__set_PRIMASK(1);
+		if (s_modeDeltaCnt) {
+			// no frames coming, write them now
+			s_modeDeltaCnt = 0;
+			NVIC_DisableIRQ(CSI_IRQn);
+			CSI_Stop(CSI);
+			__set_PRIMASK(0);
+			ret = cambus_batch(s_sensor.slv_addr, s_modeDelta, n);
+		} else {
+			__set_PRIMASK(0);
+			ret = cambus_batch_wait();
+		}
+#else
+		ret = cambus_batch(s_sensor.slv_addr, s_modeDelta, n);
+#endif
+	}
+	if (ret != 0) {
+		SensorModeInvalidate(false);
+		return -1;
+	}
+	s_modeCur = ndx;
+
+	s_sensor.framesize = framesize;
+	s_sensor.pixformat = pixformat;
+	// Skip the first frame.
+	MAIN_FB()->bpp = -1;
+	s_sensor.fb_w = MAIN_FB()->w = MAIN_FB()->u = resolution[framesize][0];
+	s_sensor.fb_h = MAIN_FB()->h = MAIN_FB()->v = resolution[framesize][1];
+	s_sensor.isWindowing = 0;
+	s_sensor.wndX = 0; s_sensor.wndY = 0 ; s_sensor.wndW = s_sensor.fb_w ; s_sensor.wndH = s_sensor.fb_h;
+	CsiFragModeCalc();
+	return 0;
+}
+
 int sensor_set_framerate(framerate_t framerate)
 {
     if (s_sensor.framerate == framerate) {
@@ -1028,7 +1830,11 @@ int sensor_set_framerate(framerate_t framerate)
 
 int sensor_set_windowing(int x, int y, int w, int h)      //may no this function in our RT csi,be used to set the output window,draw a rect in the picture
 {
+	if (s_sensor.pixformat == PIXFORMAT_JPEG)
+		return -1;	// the sensor compressed the whole frame
 	w = (w + 7) & ~7 , x = (x + 7) & ~7;
+	if (s_sensor.pixformat == PIXFORMAT_BAYER)
+		y &= ~1;	// keep the BGGR phase of the window
 	if (x >= s_sensor.fb_w - 8)
 		x = s_sensor.fb_w - 8;
 	if (y >= s_sensor.fb_h - 1)
@@ -1038,13 +1844,182 @@ int sensor_set_windowing(int x, int y, int w, int h)      //may no this function
 	if (y + h > s_sensor.fb_h)
 		h = s_sensor.fb_h - y;
 
-	s_sensor.isWindowing = (w < s_sensor.fb_w && h < s_sensor.fb_h) ? 1 : 0;
+	CsiRingStop();
+	s_sensor.isWindowing = (w < s_sensor.fb_w || h < s_sensor.fb_h) ? 1 : 0;
 	s_sensor.wndX = x ; s_sensor.wndY = y ; s_sensor.wndW = w ; s_sensor.wndH = h;
     MAIN_FB()->w = w;
     MAIN_FB()->h = h;
     return 0;
 }
 
+int sensor_set_framebuffers(int count)
+{
+	if (count < 1 || count > CSI_RING_MAX_BUFS + 1)
+		return -1;
+	CsiRingStop();
+	s_ring.fbCnt = count;
+	return 0;
+}
+
+int sensor_get_framebuffers()
+{
+	return s_ring.fbCnt;
+}
+
+int sensor_abort()
+{
+	CsiRingStop();
+	MP_STATE_PORT(sensor_frame_cb) = mp_const_none;
+	return 0;
+}
+
+int sensor_set_gray_lut(const uint8_t *lut)
+{
+	if (lut == NULL) {
+		s_pGrayLut = NULL;
+		return 0;
+	}
+	s_pGrayLut = NULL;
+	memcpy(s_grayLut, lut, sizeof(s_grayLut));
+	s_pGrayLut = s_grayLut;
+	return 0;
+}
+
+int sensor_set_gray_gain(float gain, int offset)
+{
+	int i, v;
+	if (gain < 0.0f)
+		return -1;
+	// take the table out of use while it is rebuilt
+	s_pGrayLut = NULL;
+	for (i=0; i<256; i++) {
+		v = (int)(i * gain + 0.5f) + offset;
+		s_grayLut[i] = v < 0 ? 0 : v > 255 ? 255 : v;
+	}
+	s_pGrayLut = s_grayLut;
+	return 0;
+}
+
+#ifdef NO_LCD_MONITOR
+int sensor_set_lcd_direct(int enable)
+{
+	return -1;
+}
+#endif
+
+int sensor_set_motion_detect(int enable, int threshold)
+{
+	if (threshold < 0 || threshold > 255)
+		return -1;
+	NVIC_DisableIRQ(CSI_IRQn);
+	s_motion.thresh = threshold;
+	if (enable && !s_motion.isEnabled) {
+		// start from an empty frame, the first compare happens after the next full frame
+		s_motion.frameW = s_motion.frameH = 0;
+		CsiMotionCalc(MAIN_FB()->w, MAIN_FB()->h);
+		// a frame in progress has skipped fragments, do not compare against it
+		s_motion.isPrevValid = 0;
+	}
+	s_motion.isEnabled = enable ? 1 : 0;
+	s_motion.isMaskValid = 0;
+	if (s_ring.isRunning || s_isSnapshotArmed)
+		NVIC_EnableIRQ(CSI_IRQn);
+	return 0;
+}
+
+int sensor_get_motion_mask(uint8_t *mask, int *w, int *h)
+{
+	int ret;
+	uint32_t atomic = disable_irq();
+	*w = s_motion.gridW , *h = s_motion.gridH;
+	if (!s_motion.isEnabled || !s_motion.isMaskValid) {
+		ret = -1;
+	} else {
+		if (mask)
+			memcpy(mask, (void*)s_motion.mask, s_motion.gridW * s_motion.gridH);
+		ret = s_motion.changedCnt;
+	}
+	enable_irq(atomic);
+	return ret;
+}
+
+int sensor_set_soft_auto_exposure(int enable, int target, int exposure_us_max, float gain_db_ceiling)
+{
+	int expUs;
+	float gainDb;
+	if (target < 1 || target > 254 || exposure_us_max < 1)
+		return -1;
+	if (enable) {
+		// take over from wherever the sensor AEC / AGC left off
+		if (sensor_get_exposure_us(&expUs) != 0 || sensor_get_gain_db(&gainDb) != 0)
+			return -1;
+		if (expUs < 1)
+			expUs = 1;
+		if (sensor_set_auto_exposure(0, expUs) != 0 || sensor_set_auto_gain(0, gainDb, NAN) != 0)
+			return -1;
+	}
+	NVIC_DisableIRQ(CSI_IRQn);
+	if (enable) {
+		s_ae.expUs = expUs;
+		s_ae.gain = fast_expf((gainDb / 20.0f) * fast_log(10.0f));
+		if (!s_ae.isEnabled) {
+			memset((void*)s_ae.curBins, 0, sizeof(s_ae.curBins));
+			s_ae.isHistValid = s_ae.isHistNew = 0;
+			// the frame in progress has skipped fragments
+			s_ae.settleCnt = 1;
+		}
+	}
+	s_ae.target = target;
+	s_ae.expUsMax = exposure_us_max;
+	s_ae.gainMax = fast_expf((gain_db_ceiling / 20.0f) * fast_log(10.0f));
+	if (s_ae.gainMax < 1.0f)
+		s_ae.gainMax = 1.0f;
+	s_ae.isEnabled = enable ? 1 : 0;
+	if (s_ring.isRunning || s_isSnapshotArmed)
+		NVIC_EnableIRQ(CSI_IRQn);
+	return 0;
+}
+
+int sensor_set_auto_exposure_roi(int x, int y, int w, int h, int weight)
+{
+	if (x < 0 || y < 0 || w < 0 || h < 0 || weight < 0 || weight > 255)
+		return -1;
+	uint32_t atomic = disable_irq();
+	if (w == 0 || h == 0) {
+		s_ae.roiH = 0;
+		s_ae.roiWeight = s_ae.outWeight = 1;
+	} else {
+		s_ae.roiX = x , s_ae.roiY = y , s_ae.roiW = w , s_ae.roiH = h;
+		s_ae.roiWeight = weight ? weight : 1;
+		s_ae.outWeight = weight ? 1 : 0;
+	}
+	enable_irq(atomic);
+	return 0;
+}
+
+int sensor_get_luma_histogram(uint32_t *bins, int *mean)
+{
+	int ret = 0;
+	uint32_t atomic = disable_irq();
+	if (!s_ae.isEnabled || !s_ae.isHistValid) {
+		ret = -1;
+	} else {
+		if (bins)
+			memcpy(bins, (void*)s_ae.bins, sizeof(s_ae.bins));
+		*mean = s_ae.mean;
+	}
+	enable_irq(atomic);
+	return ret;
+}
+
+int sensor_get_frame_info(uint32_t *seq, uint32_t *stamp_us, uint32_t *dropped)
+{
+	*seq = s_fbInfo.seq;
+	*stamp_us = s_fbInfo.stampUs;
+	*dropped = s_ring.dropCnt;
+	return 0;
+}
+
 int sensor_set_contrast(int level)
 {
     if (s_sensor.set_contrast != NULL) {
@@ -1408,6 +2383,24 @@ uint16_t* LCDMonitor_UpdateLineRGB565(uint16_t *pLcdFB, uint16_t *pCamFB, uint32
 #endif
 
 #ifndef NO_LCD_MONITOR
+// Convert the gray frame into an LCD buffer with PXP, flipped like the CPU copy.
+// Waits for PXP, the next frame is written over MAIN_FB() as soon as this returns.
+static void LCDMonitor_UpdateGrayPxp(uint16_t *pLcdFB, uint32_t w, uint32_t h)
+{
+	image_t cam = {.w = w, .h = h, .bpp = IMAGE_BPP_GRAYSCALE, .pixels = MAIN_FB()->pixels};
+	image_t lcd = {.w = APP_LCD_WIDTH, .h = APP_LCD_HEIGHT, .bpp = PXP_2D_BPP_RGB565_LE, .pixels = (uint8_t*) pLcdFB};
+	rectangle_t lcdRoi = {(APP_LCD_WIDTH - w) >> 1, (APP_LCD_HEIGHT - h) >> 1, w, h};
+	pxp_2d_blit(&cam, NULL, &lcd, &lcdRoi, PXP_2D_FLIP_V);
+}
+
+int sensor_set_lcd_direct(int enable)
+{
+	s_isLcdDirect = enable ? 1 : 0;
+	if (!s_isLcdDirect && s_isLcdScanCamRgb)
+		LCDMonitor_SetScanSize(APP_LCD_WIDTH, APP_LCD_HEIGHT, (uint32_t)s_frameBuffer, false);
+	return 0;
+}
+
 void LCDMonitor_Update(uint32_t fbNdx)
 {
 	uint32_t y, t1;
@@ -1416,13 +2409,39 @@ void LCDMonitor_Update(uint32_t fbNdx)
 	uint16_t *pLcd = (uint16_t*) (s_frameBuffer[fbNdx & 1]);
 	uint16_t *pLcdBkup;
 	uint32_t h = s_sensor.wndH > 272 ? 272 : s_sensor.wndH;
+	if (!s_isLcdInited)
+		LCDMonitor_Init();
 	pLcdBkup = pLcd;
 	
 	pLcd += (480 - s_sensor.wndW) >> 1;
 	pLcd += ((272 - h) >> 1) * 480;
+
+	if (s_isLcdDirect && s_sensor.wndW <= APP_LCD_WIDTH) {
+		if (s_irq.isGray || s_irq.isRaw) {
+			if (s_isLcdScanCamRgb)
+				LCDMonitor_SetScanSize(APP_LCD_WIDTH, APP_LCD_HEIGHT, (uint32_t) pLcdBkup, false);
+			LCDMonitor_UpdateGrayPxp(pLcdBkup, s_sensor.wndW, h);
+			ELCDIF_SetNextBufferAddr(LCDIF, (uint32_t) pLcdBkup);
+			return;
+		}
+		int8_t doneNdx = s_ring.doneNdx;
+		// MAIN_FB() is written over by the next snapshot() while LCDIF would scan it, the ring keeps
+		// the buffer LCDIF shows and needs a third one to go on capturing meanwhile.
+		if ((s_sensor.wndH <= APP_LCD_HEIGHT) && (s_irq.lumaFmt == CSI_LUMA_RGB565)
+			&& s_ring.isRunning && s_ring.bufCnt >= 3 && doneNdx >= 0) {
+			// LCDIF reads the newest completed frame in place, shown as captured (no vertical flip)
+			uint32_t pixels = s_ring.bufs[doneNdx];
+			if (!s_isLcdScanCamRgb || s_lcdScanW != s_sensor.wndW || s_lcdScanH != h)
+				LCDMonitor_SetScanSize(s_sensor.wndW, h, pixels, true);
+			ELCDIF_SetNextBufferAddr(LCDIF, pixels);
+			return;
+		}
+	}
+	if (s_isLcdScanCamRgb)
+		LCDMonitor_SetScanSize(APP_LCD_WIDTH, APP_LCD_HEIGHT, (uint32_t) pLcdBkup, false);
 	
 	t1 = s_sensor.wndW * 2 / 8;
-	if (s_irq.isGray) {
+	if (s_irq.isGray || s_irq.isRaw) {	// raw Bayer previews as its gray values
 		pFBGray += (h - 1) * s_sensor.wndW;
 		for (y=0; y< h; y++, pFBGray -= s_sensor.wndW) {
 			LCDMonitor_UpdateLineGray(pLcd, (uint16_t*)pFBGray, t1);
@@ -1430,6 +2449,16 @@ void LCDMonitor_Update(uint32_t fbNdx)
 		}
 		ELCDIF_SetNextBufferAddr(LCDIF, (uint32_t) pLcdBkup);		
 	}
+	else if (s_irq.lumaFmt == CSI_LUMA_YUV) {	// YUV422 previews as its Y
+		pFBGray += (h - 1) * s_sensor.wndW * 2;
+		for (y=0; y< h; y++, pFBGray -= s_sensor.wndW * 2) {
+			for (uint32_t x=0; x<s_sensor.wndW; x++) {
+				uint32_t l = pFBGray[x * 2];
+				pLcd[x] = ((l >> 3) << 11) | ((l >> 2) << 5) | (l >> 3);
+			}
+			pLcd += 480;
+		}
+	}
 	else {
 		pFB += (h - 1) * s_sensor.wndW;
 		for (y=0; y< h; y++, pFB -= s_sensor.wndW) {
@@ -1448,95 +2477,233 @@ void LCDMonitor_Update(uint32_t fbNdx)
 // The offset size may need to be adjusted depending on the quality, otherwise JPEG data may
 // overwrite image pixels before they are compressed.
 volatile uint32_t s_minProcessTicks = 10, s_jpegEncTicks;
-int sensor_snapshot(sensor_t *sensor, image_t *pImg, streaming_cb_t streaming_cb)
+static uint32_t s_prevSnapshotTick;
+
+// Between frames: scale exposure, then gain, towards the target mean of the last histogram.
+// Steps are halved in the log domain and wait for the sensor to apply them, so it does not ring.
+static void CsiAeStep(void)
+{
+	int32_t expUs, mean;
+	float total, gain, ratio;
+	if (!s_ae.isEnabled || !s_ae.isHistNew)
+		return;
+	s_ae.isHistNew = 0;
+	if (s_ae.settleCnt) {
+		s_ae.settleCnt--;
+		return;
+	}
+	mean = s_ae.mean;
+	if (abs(mean - (int32_t)s_ae.target) <= CSI_AE_TOLERANCE)
+		return;
+	ratio = fast_sqrtf((float) s_ae.target / (mean ? mean : 1));
+	total = s_ae.expUs * s_ae.gain * IM_MIN(IM_MAX(ratio, 0.5f), 2.0f);
+	expUs = IM_MAX(IM_MIN(fast_roundf(total), s_ae.expUsMax), 1);
+	gain = IM_MAX(IM_MIN(total / expUs, s_ae.gainMax), 1.0f);
+	if (expUs != s_ae.expUs)
+		sensor_set_auto_exposure(0, expUs);
+	if (gain != s_ae.gain)
+		sensor_set_auto_gain(0, 20.0f * (fast_log(gain) / fast_log(10.0f)), NAN);
+	s_ae.expUs = expUs;
+	s_ae.gain = gain;
+	s_ae.settleCnt = CSI_AE_SETTLE_FRAMES;
+}
+
+static void sensor_update_fb_bpp(void)
 {
-    static uint32_t ls_prevTick;
- //   uint32_t activeADDR;//, length;
-  //  uint32_t inactiveADDR;
-  	sensor = sensor , streaming_cb = streaming_cb;	// keep compatible with original openMV
     sensor_check_bufsize();
 
     switch (s_sensor.pixformat) {
         case PIXFORMAT_GRAYSCALE:
             MAIN_FB()->bpp = 1;
             break;
-        case PIXFORMAT_YUV422:
         case PIXFORMAT_RGB565:
             MAIN_FB()->bpp = 2;
             break;
+        case PIXFORMAT_YUV422:
+            MAIN_FB()->bpp = 4;
+            break;
         case PIXFORMAT_BAYER:
             MAIN_FB()->bpp = 3;
             break;
         case PIXFORMAT_JPEG:
-            // Read the number of data items transferred
-            // MAIN_FB()->bpp = (MAX_XFER_SIZE - __HAL_DMA_GET_COUNTER(&DMAHandle))*4;
+            // The most a frame may take until it is captured, its length after. A running
+            // ring keeps the share of the fb memory each of its buffers was given.
+            if (!s_ring.isRunning)
+                s_irq.jpegCap = CsiJpegCapacity(fb_avail_from(MAIN_FB()->pixels));
+            MAIN_FB()->bpp = s_irq.jpegCap;
             break;
     }    
+}
+
+// Push the frame still in MAIN_FB() to the LCD monitor and the IDE before it is replaced.
+static void sensor_update_preview(void)
+{
 	static uint8_t n;
-    {
-		uint32_t t1;
-		#ifndef NO_LCD_MONITOR // #ifdef __CC_ARM
+	uint32_t t1;
+	#ifndef NO_LCD_MONITOR // #ifdef __CC_ARM
+	if (!s_irq.isJpeg)
 		LCDMonitor_Update(n);
-		#endif        
-		if (JPEG_FB()->enabled) {
-            if (!s_isEnUsbIrqForSnapshot) {
-                // if OpenMV IDE enables JPEG uploading, then we suppress the new frame rate
-                // so USB have enough time to upload previous jpeg frame
-                // note: we disable USB IRQ during taking new snapshot, otherwise,
-                // even if CSI IRQ priority is higher than USB and can be preempted,
-                // sometimes CSI IRQ handler misses deadline and picture tearing happen
-                while (HAL_GetTick() - ls_prevTick < s_minProcessTicks) {
-                    s_minProcessTicks = s_minProcessTicks;
-                }
-            }
-			t1 = HAL_GetTick();
-			fb_update_jpeg_buffer();
-			s_jpegEncTicks = HAL_GetTick() - t1;
+	#endif        
+	if (JPEG_FB()->enabled) {
+		if (!s_isEnUsbIrqForSnapshot) {
+			// if OpenMV IDE enables JPEG uploading, then we suppress the new frame rate
+			// so USB have enough time to upload previous jpeg frame
+			// note: we disable USB IRQ during taking new snapshot, otherwise,
+			// even if CSI IRQ priority is higher than USB and can be preempted,
+			// sometimes CSI IRQ handler misses deadline and picture tearing happen
+			while (HAL_GetTick() - s_prevSnapshotTick < s_minProcessTicks) {
+				s_minProcessTicks = s_minProcessTicks;
+			}
+		}
+		t1 = HAL_GetTick();
+		fb_update_jpeg_buffer();
+		s_jpegEncTicks = HAL_GetTick() - t1;
+	}
+	n++;
+}
+
+int sensor_snapshot_async()
+{
+	return sensor_snapshot_async_into(MAIN_FB()->pixels, fb_buffer_size());
+}
+
+int sensor_snapshot_async_into(uint8_t *pDst, uint32_t dstSize)
+{
+	sensor_update_fb_bpp();
+	if (dstSize < fb_buffer_size() || (s_sensor.pixformat == PIXFORMAT_JPEG && !s_irq.jpegCap))
+		return -2;
+	sensor_wait_settled();
+	if (s_ring.fbCnt > 1) {
+		if (!s_ring.isRunning)
+			CsiRingStart();
+		if (s_ring.bufCnt)
+			return 0;
+	}
+	if (!s_isSnapshotArmed) {
+		sensor_update_preview();
+		s_isSnapshotArmed = 1;
+		s_irq.base0 = (uint32_t) pDst;
+		CAMERA_TAKE_SNAPSHOT();
+	}
+	return 0;
+}
+
+int sensor_snapshot_ready()
+{
+	if (s_ring.bufCnt)
+		return s_ring.readyNdx >= 0;
+	return s_isSnapshotArmed && s_isOmvSensorSnapshotReady;
+}
+
+int sensor_snapshot(sensor_t *sensor, image_t *pImg, streaming_cb_t streaming_cb)
+{
+  	sensor = sensor , streaming_cb = streaming_cb;	// keep compatible with original openMV
+	return sensor_snapshot_into(pImg, NULL, 0);
+}
+
+int sensor_snapshot_into(image_t *pImg, uint8_t *pDst, uint32_t dstSize)
+{
+	OMV_PROF_SCOPE("sensor_snapshot");
+	uint8_t isCopy = 0;
+	CsiStatsAddRun();
+    sensor_update_fb_bpp();
+	if (s_sensor.pixformat == PIXFORMAT_JPEG && !s_irq.jpegCap)
+		return -2;	// not even a fragment fits
+	if (pDst == NULL)
+		pDst = MAIN_FB()->pixels;
+	else if (dstSize < fb_buffer_size())
+		return -2;
+	if (pDst == MAIN_FB()->pixels)
+		fb_wait_stream();	// the IDE may still be reading the last frame
+	sensor_wait_settled();
+	imlib_pyramid_invalidate(NULL);	// new frame, drop the levels of the old one
+	if (!s_isSnapshotArmed)
+		sensor_update_preview();
+	if (s_ring.fbCnt > 1) {
+		// free-running capture can not mask USB, frames are taken whenever they complete
+		if (!s_ring.isRunning)
+			CsiRingStart();
+		if (s_ring.bufCnt)
+			CsiRingGetFrame(pDst);
+	}
+	if (!s_ring.bufCnt) {
+		if (!s_isSnapshotArmed) {
+			// stop-and-wait: let the capture land in the destination directly
+			s_irq.base0 = (uint32_t) pDst;
+			CAMERA_TAKE_SNAPSHOT();
+		} else {
+			isCopy = (uint32_t) pDst != s_irq.base0;	// already in flight elsewhere
 		}
-		#if 1        
-        CAMERA_TAKE_SNAPSHOT();
+		uint32_t t0 = mp_hal_ticks_us();
 		if (!s_isEnUsbIrqForSnapshot)
 			NVIC_DisableIRQ(USB_OTG1_IRQn);
 		CAMERA_WAIT_FOR_SNAPSHOT();
+		CsiStatsAddWait(t0);
 		if (!s_isEnUsbIrqForSnapshot)
 			NVIC_EnableIRQ(USB_OTG1_IRQn);
-        ls_prevTick = HAL_GetTick();
-		#else
-		/*
-		uint32_t i;
-		uint16_t *p = (uint16_t*) fb_framebuffer->pixels;
-		
-		uint32_t j;		
-		for (i=0; i<s_sensor.fb_h; i++) {
-			for (j=0; j<s_sensor.fb_w; j++) {
-				if (i > 120)
-					p[0] = 0xBeef; //(n & 0x1F) <<0;
-				else
-					p[0] = 0xDead;
-				p++;
-			}
-		}
-		*/
-		s_irq.nextDmaBulk = 0;
-		s_pCSI->CSICR18 |= CSI_CSICR18_CSI_ENABLE_MASK;
-		#endif
-		
-		n++;
+		s_isSnapshotArmed = 0;
+		if (s_irq.isJpeg)
+			MAIN_FB()->bpp = s_irq.jpegBytes;
+		dma_end_read((void*)s_irq.base0, fb_buffer_size());
+		if (isCopy)
+			memcpy(pDst, (void*)s_irq.base0, fb_buffer_size());
+		s_irq.base0 = (uint32_t)(MAIN_FB()->pixels);
+	}
+	CsiAeStep();
+	s_prevSnapshotTick = HAL_GetTick();
+	boot_time_mark(MP_QSTR_first_frame);
 
-		/*
-		for (i=0, p = (uint16_t*) fb_framebuffer->pixels; i<s_sensor.fb_h; i++) {
-			PreprocessOneLine((uint32_t)p, i);
-			p += s_sensor.fb_w;
-		}
-		*/
-    }
 	if (pImg) {
 		pImg->w = MAIN_FB()->w , pImg->h = MAIN_FB()->h , pImg->bpp = MAIN_FB()->bpp;
-		pImg->pixels = (uint8_t*) MAIN_FB()->pixels;		
+		pImg->pixels = pDst;
 	}
+	image_t frame = { .w=MAIN_FB()->w, .h=MAIN_FB()->h, .bpp=MAIN_FB()->bpp, .pixels=pDst };
+	stream_server_frame(&frame);
+	s_pwr.exitUs = mp_hal_ticks_us();
     return 0;
 }
 
+int sensor_set_low_power(int mode, int div)
+{
+	if (mode < SENSOR_LP_OFF || mode > SENSOR_LP_SCALE)
+		return -1;
+	if (mode == SENSOR_LP_SCALE && div != 2 && div != 4)
+		return -1;
+	s_pwr.mode = mode;
+	s_pwr.div = (mode == SENSOR_LP_SCALE) ? div : 1;
+	return 0;
+}
+
+
+int sensor_set_usb_irq_in_snapshot(int enable)
+{
+	s_isEnUsbIrqForSnapshot = enable ? 1 : 0;
+	return 0;
+}
+
+int sensor_get_stats(sensor_stats_t *stats, int clear)
+{
+	uint32_t atomic = disable_irq();
+	stats->frames = s_irq.frameSeq;
+	stats->dropped = s_ring.dropCnt;
+	stats->fifo_overflows = s_stats.fifoOvfCnt;
+	stats->fragment_misses = s_stats.fragMissCnt;
+	stats->irq_cycles_max = s_stats.fragIrqCycMax;
+	stats->irq_cycles_mean = s_stats.fragIrqCnt ? (uint32_t)(s_stats.fragIrqCycSum / s_stats.fragIrqCnt) : 0;
+	stats->jpeg_ms = s_jpegEncTicks;
+	stats->wait_us = s_stats.waitUs;
+	stats->wait_us_total = s_stats.waitUsSum;
+	stats->run_us_total = s_stats.runUsSum;
+	stats->run_uj_total = s_stats.runUjSum;
+	stats->wait_uj_total = s_stats.waitUjSum;
+	stats->uj_per_frame = s_stats.snapCnt ? (uint32_t)((s_stats.runUjSum + s_stats.waitUjSum) / s_stats.snapCnt) : 0;
+	if (clear) {
+		memset((void*)&s_stats, 0, sizeof(s_stats));
+		s_ring.dropCnt = 0;
+	}
+	enable_irq(atomic);
+	return 0;
+}
 
 void CSI_OmvTransferHandleIRQ(CSI_Type *base, csi_handle_t *handle)
 {
@@ -1556,6 +2723,7 @@ void CSI_OmvTransferHandleIRQ(CSI_Type *base, csi_handle_t *handle)
 	handle->queueUserWriteIdx = 0;
 	handle->activeBufferNum = 0;
 	s_isOmvSensorSnapshotReady = 1;	
+	mp_stream_poll_notify(&py_sensor_capture_obj);
 /* Add for ARM errata 838869, affects Cortex-M4, Cortex-M4F Store immediate overlapping
   exception return operation might vector to incorrect interrupt */
 #if defined __CORTEX_M && (__CORTEX_M >= 4U)
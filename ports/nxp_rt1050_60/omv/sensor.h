@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <stdarg.h>
 #include "imlib.h"
+#include "cambus.h"
 #define OV7725_SLV_ADDR     (0x42)
 #define OV2640_SLV_ADDR     (0x60)
 #define MT9V034_SLV_ADDR    (0xB8)
@@ -128,7 +129,9 @@ typedef enum {
     IOCTL_LEPTON_SET_MEASUREMENT_MODE,
     IOCTL_LEPTON_GET_MEASUREMENT_MODE,
     IOCTL_LEPTON_SET_MEASUREMENT_RANGE,
-    IOCTL_LEPTON_GET_MEASUREMENT_RANGE
+    IOCTL_LEPTON_GET_MEASUREMENT_RANGE,
+    IOCTL_LEPTON_GET_FRAME,
+    IOCTL_LEPTON_GET_STATS
 } ioctl_t;
 
 #define SENSOR_HW_FLAGS_VSYNC        (0) // vertical sync polarity.
@@ -142,6 +145,10 @@ typedef enum {
 
 typedef bool (*streaming_cb_t)(image_t *image);
 
+// Register writes of one framesize/pixformat pair kept for sensor_set_mode().
+#define SENSOR_MODE_REGS_MAX    (24)
+#define SENSOR_MODE_PROFILES    (4)
+
 typedef struct _sensor sensor_t;
 typedef struct _sensor {
     uint8_t  chip_id;           // Sensor ID.
@@ -190,6 +197,9 @@ typedef struct _sensor {
     int  (*set_lens_correction) (sensor_t *sensor, int enable, int radi, int coef);
     int  (*ioctl)               (sensor_t *sensor, int request, va_list ap);
     int  (*snapshot)            (sensor_t *sensor, image_t *image, streaming_cb_t streaming_cb);
+    // Optional: the writes that set framesize and pixformat, at most SENSOR_MODE_REGS_MAX.
+    // Returns the number of ops, -1 if the mode is not supported.
+    int  (*get_mode_regs)       (sensor_t *sensor, framesize_t framesize, pixformat_t pixformat, cambus_op_t *ops);
 } sensor_t;
 
 // Resolution table
@@ -204,6 +214,13 @@ void sensor_init0();
 // Reset the sensor to its default state.
 int sensor_reset();
 
+// Reset the sensor while the board boots, the first sensor_reset() after it only waits for
+// the sensor to settle, unless its registers were written in between.
+int sensor_boot_start();
+
+// The registers just written take effect ms from now, snapshots wait for that.
+void sensor_settle(uint32_t ms);
+
 // Return sensor PID.
 int sensor_get_id();
 
@@ -225,12 +242,103 @@ int sensor_set_pixformat(pixformat_t pixformat);
 // Set the sensor frame size.
 int sensor_set_framesize(framesize_t framesize);
 
+// Set frame size and pixel format together, the registers that differ are written in the
+// blanking after the next start of frame. Falls back to the two calls above.
+int sensor_set_mode(framesize_t framesize, pixformat_t pixformat);
+
 // Set the sensor frame rate.
 int sensor_set_framerate(framerate_t framerate);
 
 // Set window size.
 int sensor_set_windowing(int x, int y, int w, int h);
 
+// Set the number of framebuffers, more than 1 keeps the sensor capturing into spare buffers.
+int sensor_set_framebuffers(int count);
+
+// Get the number of framebuffers.
+int sensor_get_framebuffers();
+
+// Stop any capture still in progress.
+int sensor_abort();
+
+// Start capturing the next frame and return, sensor_snapshot() then picks it up.
+int sensor_snapshot_async();
+// Same, captured straight into pDst (a frame slot), sensor_snapshot_into() with the same pDst
+// then only waits for it. Returns -2 if the frame does not fit in dstSize.
+int sensor_snapshot_async_into(uint8_t *pDst, uint32_t dstSize);
+// Whether the frame started above is in, sensor_snapshot() then returns without waiting.
+int sensor_snapshot_ready();
+
+// Set a 256 entry table applied to gray pixels as they are captured, NULL to disable.
+int sensor_set_gray_lut(const uint8_t *lut);
+
+// Apply y = y * gain + offset to gray pixels as they are captured.
+int sensor_set_gray_gain(float gain, int offset);
+
+// Let LCDIF show RGB565 frames straight from the capture ring and PXP convert gray ones,
+// instead of copying each frame to the LCD buffer on the CPU. RGB565 frames need 4
+// framebuffers, with fewer they are still copied. Returns -1 without LCD.
+int sensor_set_lcd_direct(int enable);
+
+// Compare blocks of each captured frame with the previous one, threshold is the mean
+// per pixel brightness change that marks a block as changed.
+int sensor_set_motion_detect(int enable, int threshold);
+
+// Copy the block change mask of the last frame (255 = changed) and its grid size.
+// Returns the number of changed blocks, or -1 when no mask is available. mask may be NULL.
+int sensor_get_motion_mask(uint8_t *mask, int *w, int *h);
+
+// Run auto exposure / gain from a luma histogram sampled while frames are captured, instead
+// of the sensor's own AEC / AGC. Exposure goes up to exposure_us_max before gain is raised.
+int sensor_set_soft_auto_exposure(int enable, int target, int exposure_us_max, float gain_db_ceiling);
+
+// Weight luma samples inside the roi (output pixels) weight times those outside it.
+// weight 0 only meters the roi, a 0 width or height meters the whole frame evenly.
+int sensor_set_auto_exposure_roi(int x, int y, int w, int h, int weight);
+
+#define SENSOR_LUMA_HIST_BINS   (32)
+
+// Copy the weighted luma histogram of the last frame and its mean.
+// Returns -1 while software auto exposure is off or no frame is done yet. bins may be NULL.
+int sensor_get_luma_histogram(uint32_t *bins, int *mean);
+
+typedef struct {
+    uint32_t frames;            // frames captured since boot
+    uint32_t dropped;           // frames overwritten before they were read
+    uint32_t fifo_overflows;    // CSI RxFIFO overruns
+    uint32_t fragment_misses;   // frames dropped because a DMA fragment was serviced too late
+    uint32_t irq_cycles_max;    // CPU cycles spent in the fragment IRQ
+    uint32_t irq_cycles_mean;
+    uint32_t jpeg_ms;           // last IDE preview JPEG encode
+    uint32_t wait_us;           // last wait for a frame in sensor_snapshot()
+    uint64_t wait_us_total;
+    uint64_t run_us_total;      // between snapshots, the script's processing
+    // Estimates from the OMV_PWR_* power model of the board, in microjoules
+    uint64_t run_uj_total;
+    uint64_t wait_uj_total;
+    uint32_t uj_per_frame;      // both over the snapshots taken
+} sensor_stats_t;
+
+// What sensor_snapshot() does while it waits for the frame.
+enum {
+    SENSOR_LP_OFF,              // spin on the recorder, stream server and task polls
+    SENSOR_LP_WFI,              // sleep until the next interrupt between the polls
+    SENSOR_LP_SCALE,            // and run the core at its clock / div meanwhile
+};
+
+// div is 2 or 4 for SENSOR_LP_SCALE. Returns -1 for an unknown mode or divider.
+int sensor_set_low_power(int mode, int div);
+
+// Keep the USB IRQ enabled while a frame is captured (default unless running from XIP flash).
+// Late fragments then show up in sensor_get_stats() instead of masking USB for the whole frame.
+int sensor_set_usb_irq_in_snapshot(int enable);
+
+// Read the capture counters, clear them afterwards if clear is set.
+int sensor_get_stats(sensor_stats_t *stats, int clear);
+
+// Get sequence number and SOF timestamp of the frame in MAIN_FB(), and dropped frames count.
+int sensor_get_frame_info(uint32_t *seq, uint32_t *stamp_us, uint32_t *dropped);
+
 // Set the sensor contrast level (from -3 to +3).
 int sensor_set_contrast(int level);
 
@@ -293,4 +401,7 @@ const uint16_t *sensor_get_color_palette();
 
 // Default snapshot function.
 int sensor_snapshot(sensor_t *sensor, image_t *image, streaming_cb_t streaming_cb);
+// Like sensor_snapshot() but the frame ends up in pDst (a frame slot) instead of MAIN_FB(),
+// captured there directly in stop-and-wait mode. Returns -2 if the frame does not fit in dstSize.
+int sensor_snapshot_into(image_t *image, uint8_t *pDst, uint32_t dstSize);
 #endif /* __SENSOR_H__ */
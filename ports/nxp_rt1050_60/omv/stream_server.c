@@ -0,0 +1,387 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * MJPEG over HTTP stream server.
+ *
+ * Frames are compressed as sensor_snapshot() hands them over into one of clients + 1 slots,
+ * each already wrapped in its multipart part header, and every client sends from the slot it
+ * got last. A client that finishes its frame moves on to the newest slot, so a slow client
+ * skips frames instead of holding the others back, and nothing is compressed while no client
+ * is waiting for a frame. Sending runs in its own thread with RT-Thread, else in the idle loop.
+ *
+ */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "mp.h"
+#include "py/mphal.h"
+#include "xalloc.h"
+#include "fb_alloc.h"
+#include "imlib.h"
+#include "omv_boardconfig.h"
+#include "stream_server.h"
+#ifdef OMV_ENABLE_STREAM_SERVER
+#include "winc.h"
+#include "socket.h"
+#ifdef MICROPY_PY_RTTHREAD
+#include "rtthread.h"
+#endif
+
+// Room in front of each frame for its part header.
+#define STREAM_HDR_SIZE         (64)
+// Most sent to one client in a go, then the next one gets its turn.
+#define STREAM_CHUNK_SIZE       (1460 * 2)
+#define STREAM_SEND_TIMEOUT     (1)
+#define STREAM_ACCEPT_TIMEOUT   (1)
+#define STREAM_ACCEPT_MS        (100)
+#define STREAM_NO_SLOT          (-1)
+
+#ifdef MICROPY_PY_RTTHREAD
+#define STREAM_THREAD_STACK_SIZE    (2048)
+#define STREAM_THREAD_TICKS         (5)
+// The thread and the capture path both pick slots.
+#define STREAM_LOCK()           rt_enter_critical()
+#define STREAM_UNLOCK()         rt_exit_critical()
+#else
+#define STREAM_LOCK()
+#define STREAM_UNLOCK()
+#endif
+
+#define TIMEDOUT(x) (x == -ETIMEDOUT || x == SOCK_ERR_TIMEOUT)
+
+static const char stream_http_header[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Server: OpenMV\r\n"
+    "Content-Type: multipart/x-mixed-replace;boundary=openmv\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Connection: close\r\n"
+    "\r\n";
+
+typedef struct stream_slot {
+    uint8_t *buf;
+    uint32_t start; // where the part header starts
+    uint32_t end;
+    uint32_t frame;
+    uint8_t users;
+} stream_slot_t;
+
+typedef struct stream_client {
+    int fd;
+    int slot;
+    uint32_t pos;
+    uint32_t frame; // last one sent
+} stream_client_t;
+
+typedef struct stream_server {
+    int fd;
+    int quality;
+    int n_clients;
+    uint32_t frame_size;
+    uint32_t frames;
+    volatile int latest;
+    int encoding;
+    uint32_t accept_ms;
+    bool busy;
+    stream_client_t clients[STREAM_SERVER_MAX_CLIENTS];
+    stream_slot_t slots[STREAM_SERVER_MAX_CLIENTS + 1];
+    #ifdef MICROPY_PY_RTTHREAD
+    rt_thread_t thread;
+    rt_sem_t done;
+    volatile bool stop;
+    #endif
+} stream_server_t;
+
+static void stream_client_close(stream_server_t *srv, stream_client_t *c)
+{
+    STREAM_LOCK();
+    if (c->slot != STREAM_NO_SLOT) {
+        srv->slots[c->slot].users -= 1;
+        c->slot = STREAM_NO_SLOT;
+    }
+    STREAM_UNLOCK();
+    winc_socket_close(c->fd);
+    c->fd = -1;
+}
+
+static void stream_server_accept(stream_server_t *srv)
+{
+    stream_client_t *c = NULL;
+    for (int i = 0; i < srv->n_clients; i++) {
+        if (srv->clients[i].fd < 0) {
+            c = &srv->clients[i];
+            break;
+        }
+    }
+
+    uint32_t now = mp_hal_ticks_ms();
+    if ((c == NULL) || ((now - srv->accept_ms) < STREAM_ACCEPT_MS)) {
+        return;
+    }
+    srv->accept_ms = now;
+
+    sockaddr addr;
+    int fd = -1;
+    if (winc_socket_accept(srv->fd, &addr, &fd, STREAM_ACCEPT_TIMEOUT) < 0) {
+        return;
+    }
+
+    // The request is not looked at, whatever was asked for gets the stream.
+    c->fd = fd;
+    c->slot = STREAM_NO_SLOT;
+    c->frame = srv->frames;
+    if (winc_socket_send(fd, (const uint8_t *) stream_http_header, sizeof(stream_http_header) - 1, 100) < 0) {
+        stream_client_close(srv, c);
+    }
+}
+
+static void stream_server_pump(stream_server_t *srv)
+{
+    stream_server_accept(srv);
+
+    for (int i = 0; i < srv->n_clients; i++) {
+        stream_client_t *c = &srv->clients[i];
+        if (c->fd < 0) {
+            continue;
+        }
+
+        if (c->slot == STREAM_NO_SLOT) {
+            STREAM_LOCK();
+            int latest = srv->latest;
+            if ((latest != STREAM_NO_SLOT) && (srv->slots[latest].frame != c->frame)) {
+                srv->slots[latest].users += 1;
+                c->slot = latest;
+                c->pos = srv->slots[latest].start;
+                c->frame = srv->slots[latest].frame;
+            }
+            STREAM_UNLOCK();
+            if (c->slot == STREAM_NO_SLOT) {
+                continue;
+            }
+        }
+
+        stream_slot_t *s = &srv->slots[c->slot];
+        int ret = winc_socket_send(c->fd, s->buf + c->pos, IM_MIN(s->end - c->pos, STREAM_CHUNK_SIZE), STREAM_SEND_TIMEOUT);
+        if (ret < 0) {
+            if (!TIMEDOUT(ret)) {
+                stream_client_close(srv, c);
+            }
+            continue;
+        }
+
+        c->pos += ret;
+        if (c->pos >= s->end) {
+            STREAM_LOCK();
+            s->users -= 1;
+            c->slot = STREAM_NO_SLOT;
+            STREAM_UNLOCK();
+        }
+    }
+}
+
+#ifdef MICROPY_PY_RTTHREAD
+static void stream_server_thread_entry(void *parameter)
+{
+    stream_server_t *srv = parameter;
+
+    while (!srv->stop) {
+        stream_server_pump(srv);
+        rt_thread_delay(1);
+    }
+
+    rt_sem_release(srv->done);
+}
+#endif
+
+static bool stream_server_sink(void *arg, const uint8_t *data, int size)
+{
+    stream_server_t *srv = arg;
+    stream_slot_t *s = &srv->slots[srv->encoding];
+
+    if ((s->end + size) > (STREAM_HDR_SIZE + srv->frame_size)) {
+        return false;
+    }
+
+    memcpy(s->buf + s->end, data, size);
+    s->end += size;
+    return true;
+}
+
+void stream_server_start(int port, int quality, int clients, uint32_t frame_size)
+{
+    if (MP_STATE_PORT(stream_server)) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "Stream server is running!"));
+    }
+
+    stream_server_t *srv = xalloc0(sizeof(stream_server_t));
+    srv->quality = quality;
+    srv->n_clients = IM_MIN(IM_MAX(clients, 1), STREAM_SERVER_MAX_CLIENTS);
+    srv->frame_size = frame_size;
+    srv->latest = STREAM_NO_SLOT;
+    for (int i = 0; i < STREAM_SERVER_MAX_CLIENTS; i++) {
+        srv->clients[i].fd = -1;
+        srv->clients[i].slot = STREAM_NO_SLOT;
+    }
+    for (int i = 0; i <= srv->n_clients; i++) {
+        srv->slots[i].buf = xalloc(STREAM_HDR_SIZE + frame_size);
+    }
+
+    sockaddr addr;
+    make_sockaddr(&addr, ((uint8_t [4]){0, 0, 0, 0}), port);
+    if ((srv->fd = winc_socket_socket(SOCK_STREAM)) < 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "Failed to open the stream socket!"));
+    }
+    if ((winc_socket_bind(srv->fd, &addr) < 0) || (winc_socket_listen(srv->fd, srv->n_clients) < 0)) {
+        winc_socket_close(srv->fd);
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "Failed to listen on the stream port!"));
+    }
+
+    MP_STATE_PORT(stream_server) = srv;
+
+    #ifdef MICROPY_PY_RTTHREAD
+    srv->done = rt_sem_create("stream", 0, RT_IPC_FLAG_FIFO);
+    srv->thread = rt_thread_create("stream", stream_server_thread_entry, srv,
+            STREAM_THREAD_STACK_SIZE, RT_MAIN_THREAD_PRIORITY, STREAM_THREAD_TICKS);
+    if (srv->thread) {
+        rt_thread_startup(srv->thread);
+    } else {
+        rt_sem_delete(srv->done);
+    }
+    #endif
+}
+
+void stream_server_stop()
+{
+    stream_server_t *srv = MP_STATE_PORT(stream_server);
+    if (srv == NULL) {
+        return;
+    }
+
+    #ifdef MICROPY_PY_RTTHREAD
+    if (srv->thread) {
+        srv->stop = true;
+        rt_sem_take(srv->done, RT_WAITING_FOREVER);
+        rt_sem_delete(srv->done);
+        srv->thread = NULL;
+    }
+    #endif
+
+    for (int i = 0; i < srv->n_clients; i++) {
+        if (srv->clients[i].fd >= 0) {
+            stream_client_close(srv, &srv->clients[i]);
+        }
+    }
+    winc_socket_close(srv->fd);
+    MP_STATE_PORT(stream_server) = NULL;
+}
+
+int stream_server_clients()
+{
+    stream_server_t *srv = MP_STATE_PORT(stream_server);
+    if (srv == NULL) {
+        return -1;
+    }
+
+    int n = 0;
+    for (int i = 0; i < srv->n_clients; i++) {
+        n += srv->clients[i].fd >= 0;
+    }
+    return n;
+}
+
+void stream_server_frame(image_t *img)
+{
+    stream_server_t *srv = MP_STATE_PORT(stream_server);
+    if ((srv == NULL) || ((img->bpp != IMAGE_BPP_GRAYSCALE) && (img->bpp != IMAGE_BPP_RGB565))) {
+        return;
+    }
+
+    // Only worth it for a client that already sent the newest frame.
+    bool waiting = false;
+    for (int i = 0; i < srv->n_clients; i++) {
+        stream_client_t *c = &srv->clients[i];
+        waiting |= (c->fd >= 0) && (c->slot == STREAM_NO_SLOT)
+                && ((srv->latest == STREAM_NO_SLOT) || (srv->slots[srv->latest].frame == c->frame));
+    }
+    if (!waiting) {
+        return;
+    }
+
+    // Clients only ever take the newest slot, any other one without users is free to fill.
+    srv->encoding = STREAM_NO_SLOT;
+    STREAM_LOCK();
+    for (int i = 0; i <= srv->n_clients; i++) {
+        if ((i != srv->latest) && (srv->slots[i].users == 0)) {
+            srv->encoding = i;
+            break;
+        }
+    }
+    STREAM_UNLOCK();
+    if (srv->encoding == STREAM_NO_SLOT) {
+        return;
+    }
+
+    stream_slot_t *s = &srv->slots[srv->encoding];
+    s->end = STREAM_HDR_SIZE;
+    uint8_t *buffer = fb_alloc(JPEG_SINK_BUF_SIZE, FB_ALLOC_NO_HINT);
+    image_t out = { .w=img->w, .h=img->h, .bpp=JPEG_SINK_BUF_SIZE, .pixels=buffer };
+    bool ok = (!jpeg_compress_sink(img, &out, srv->quality, stream_server_sink, srv))
+            && stream_server_sink(srv, (const uint8_t *) "\r\n", 2);
+    fb_free();
+
+    // The part header goes right in front of the data, its size is only known now.
+    if (ok) {
+        char hdr[STREAM_HDR_SIZE];
+        int len = snprintf(hdr, sizeof(hdr), "--openmv\r\nContent-Type: image/jpeg\r\nContent-Length: %lu\r\n\r\n",
+                (unsigned long) (s->end - 2 - STREAM_HDR_SIZE));
+        s->start = STREAM_HDR_SIZE - len;
+        memcpy(s->buf + s->start, hdr, len);
+        s->frame = ++srv->frames;
+        __DMB(); // the frame is in place before the sender sees it
+        srv->latest = srv->encoding;
+    }
+
+    #ifdef MICROPY_PY_RTTHREAD
+    if (srv->thread) {
+        return;
+    }
+    #endif
+    stream_server_poll();
+}
+
+void stream_server_poll()
+{
+    stream_server_t *srv = MP_STATE_PORT(stream_server);
+    if ((srv == NULL) || srv->busy) {
+        return;
+    }
+
+    #ifdef MICROPY_PY_RTTHREAD
+    if (srv->thread) {
+        return;
+    }
+    #endif
+
+    // The WINC driver may come back here while it waits.
+    srv->busy = true;
+    stream_server_pump(srv);
+    srv->busy = false;
+}
+
+void stream_server_init0()
+{
+    stream_server_stop();
+}
+#else
+void stream_server_poll()
+{
+}
+
+void stream_server_frame(image_t *img)
+{
+}
+
+void stream_server_init0()
+{
+}
+#endif // OMV_ENABLE_STREAM_SERVER
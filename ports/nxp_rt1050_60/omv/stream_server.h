@@ -0,0 +1,27 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * MJPEG over HTTP stream server.
+ *
+ */
+#ifndef __STREAM_SERVER_H__
+#define __STREAM_SERVER_H__
+#include <stdint.h>
+#include "imlib.h"
+
+#define STREAM_SERVER_MAX_CLIENTS   (4)
+
+// Serves multipart/x-mixed-replace JPEG to up to clients connections on port, frame_size bytes
+// are kept per compressed frame. Raises if the socket can't be opened or another server runs.
+void stream_server_start(int port, int quality, int clients, uint32_t frame_size);
+void stream_server_stop();
+// Number of connected clients, -1 if the server is not running.
+int stream_server_clients();
+// Offers a captured frame, it is only compressed when a client is ready for a new one.
+void stream_server_frame(image_t *img);
+// Accepts clients and sends queued data, from the idle loop without RT-Thread.
+void stream_server_poll();
+// Stops a server left running by the last script.
+void stream_server_init0();
+#endif // __STREAM_SERVER_H__
@@ -0,0 +1,197 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Background tasks behind omv.submit().
+ *
+ * Tasks run one after the other in the order they were submitted, in a worker thread with
+ * RT-Thread, else from the idle loop (EventPollHook and the snapshot wait). The worker never
+ * touches Python objects other than through the stream protocol and never allocates: images are
+ * copied and output buffers allocated on submit, and images are only encoded in software, since
+ * fb_alloc() and the PXP belong to the VM's thread. Writes go out in chunks so that without
+ * RT-Thread one poll only takes as long as compressing one image or sending one chunk.
+ *
+ */
+#include <string.h>
+#include "mp.h"
+#include "py/mperrno.h"
+#include "py/stream.h"
+#include "xalloc.h"
+#include "imlib.h"
+#include "task.h"
+#ifdef MICROPY_PY_RTTHREAD
+#include "rtthread.h"
+#endif
+
+#define TASK_CHUNK_SIZE         (4096)
+
+#ifdef MICROPY_PY_RTTHREAD
+#define TASK_THREAD_STACK_SIZE  (4096)
+#define TASK_THREAD_TICKS       (5)
+// The worker and the VM's thread both go through the queue.
+#define TASK_LOCK()             rt_enter_critical()
+#define TASK_UNLOCK()           rt_exit_critical()
+static rt_thread_t task_thread;
+static struct rt_semaphore task_sem;
+#else
+#define TASK_LOCK()
+#define TASK_UNLOCK()
+#endif
+
+// Set while a task runs, init0 waits for it before the queue goes.
+static volatile bool task_busy;
+
+task_t *task_new(task_op_t op)
+{
+    // Its own heap block, the queue and the future keep it alive.
+    task_t *task = xalloc0(sizeof(task_t));
+    task->op = op;
+    task->state = TASK_PENDING;
+    task->stream = MP_OBJ_NULL;
+    return task;
+}
+
+// Returns 0 when done, MP_EAGAIN to be called again or an errno.
+static int task_run(task_t *task)
+{
+    if ((task->op != TASK_WRITE) && (task->data == NULL)) {
+        if (jpeg_compress_soft(&task->img, &task->out, task->quality)) {
+            return MP_ENOMEM;
+        }
+        task->data = task->out.pixels;
+        task->len = task->out.bpp;
+        if (task->op == TASK_COMPRESS) {
+            return 0;
+        }
+    }
+
+    const mp_stream_p_t *stream_p = mp_get_stream(task->stream);
+    int err = 0;
+    if (task->sent < task->len) {
+        mp_uint_t ret = stream_p->write(task->stream, task->data + task->sent,
+                IM_MIN(task->len - task->sent, TASK_CHUNK_SIZE), &err);
+        if (ret == MP_STREAM_ERROR) {
+            return err;
+        }
+        task->sent += ret;
+        if (task->sent < task->len) {
+            return MP_EAGAIN;
+        }
+    }
+
+    if (task->op == TASK_SAVE) {
+        if (stream_p->ioctl(task->stream, MP_STREAM_CLOSE, 0, &err) == MP_STREAM_ERROR) {
+            return err;
+        }
+    }
+    return 0;
+}
+
+// Runs tasks until the queue is empty, or one has to wait and wait is false.
+static void task_pump(bool wait)
+{
+    for (;;) {
+        TASK_LOCK();
+        task_t *task = MP_STATE_PORT(omv_tasks);
+        if (task) {
+            task->state = TASK_RUNNING;
+            task_busy = true;
+        }
+        TASK_UNLOCK();
+        if (task == NULL) {
+            return;
+        }
+
+        int ret = task_run(task);
+        if (ret == MP_EAGAIN) {
+            task_busy = false;
+            if (!wait) {
+                return;
+            }
+            #ifdef MICROPY_PY_RTTHREAD
+            rt_thread_delay(1);
+            #endif
+            continue;
+        }
+
+        // Done before it leaves the queue, so the future never sees it idle.
+        TASK_LOCK();
+        task->error = ret;
+        task->state = ret ? TASK_FAILED : TASK_DONE;
+        if (MP_STATE_PORT(omv_tasks) == task) {
+            MP_STATE_PORT(omv_tasks) = task->next;
+        }
+        task_busy = false;
+        TASK_UNLOCK();
+    }
+}
+
+#ifdef MICROPY_PY_RTTHREAD
+static void task_thread_entry(void *parameter)
+{
+    for (;;) {
+        rt_sem_take(&task_sem, RT_WAITING_FOREVER);
+        task_pump(true);
+    }
+}
+#endif
+
+void task_submit(task_t *task)
+{
+    #ifdef MICROPY_PY_RTTHREAD
+    if (task_thread == NULL) {
+        rt_sem_init(&task_sem, "task", 0, RT_IPC_FLAG_FIFO);
+        task_thread = rt_thread_create("task", task_thread_entry, NULL,
+                TASK_THREAD_STACK_SIZE, RT_MAIN_THREAD_PRIORITY, TASK_THREAD_TICKS);
+        if (task_thread == NULL) {
+            rt_sem_detach(&task_sem);
+            nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "Failed to start the task thread!"));
+        }
+        rt_thread_startup(task_thread);
+    }
+    #endif
+
+    task->next = NULL;
+    TASK_LOCK();
+    task_t **tail = (task_t **) &MP_STATE_PORT(omv_tasks);
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = task;
+    TASK_UNLOCK();
+
+    #ifdef MICROPY_PY_RTTHREAD
+    rt_sem_release(&task_sem);
+    #endif
+}
+
+void task_poll()
+{
+    #ifdef MICROPY_PY_RTTHREAD
+    if (task_thread) {
+        return;
+    }
+    #endif
+
+    // Streams may come back here while they wait.
+    static bool busy;
+    if (busy || (MP_STATE_PORT(omv_tasks) == NULL)) {
+        return;
+    }
+    busy = true;
+    task_pump(false);
+    busy = false;
+}
+
+void task_init0()
+{
+    TASK_LOCK();
+    MP_STATE_PORT(omv_tasks) = NULL;
+    TASK_UNLOCK();
+
+    #ifdef MICROPY_PY_RTTHREAD
+    while (task_busy) {
+        rt_thread_delay(1);
+    }
+    #endif
+}
@@ -0,0 +1,49 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Background tasks behind omv.submit().
+ *
+ */
+#ifndef __TASK_H__
+#define __TASK_H__
+#include <stdint.h>
+#include "imlib.h"
+
+typedef enum task_op {
+    TASK_COMPRESS,  // img to a new JPEG image in out
+    TASK_SAVE,      // img as JPEG to the file in stream
+    TASK_WRITE,     // data to stream
+} task_op_t;
+
+typedef enum task_state {
+    TASK_PENDING,
+    TASK_RUNNING,
+    TASK_DONE,
+    TASK_FAILED,
+} task_state_t;
+
+// Everything a task touches is its own, copied or allocated when it is submitted (xalloc), so
+// the script is free to reuse its image and buffers at once.
+typedef struct task {
+    struct task *next;
+    task_op_t op;
+    volatile task_state_t state;
+    int error; // errno once FAILED
+    int quality;
+    image_t img;
+    image_t out;
+    mp_obj_t stream;
+    const uint8_t *data;
+    uint32_t len;
+    uint32_t sent;
+} task_t;
+
+// New task for op, the caller fills it in and hands it to task_submit().
+task_t *task_new(task_op_t op);
+void task_submit(task_t *task);
+// Runs the queued tasks, from the idle loop without RT-Thread.
+void task_poll();
+// Drops the queued tasks and waits for the running one.
+void task_init0();
+#endif // __TASK_H__
@@ -1,28 +1,108 @@
+/*
+ * This file is part of the OpenMV project.
+ * Copyright (c) 2013/2014 Ibrahim Abdelkader <i.abdalkader@gmail.com>
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Trace buffer.
+ *
+ */
+#include <string.h>
+#include <mp.h>
+#include "py/mphal.h"
 #include "trace.h"
-#include <stdint.h>
-#include STM32_HAL_H
+#ifdef MICROPY_PY_RTTHREAD
+#include <rtthread.h>
+#endif
 
-#define TRACEBUF_SIZE   (256)
 typedef struct _tracebuf_t {
-    uint8_t idx;
-    uint8_t buf[TRACEBUF_SIZE];
+    uint32_t head;      // free running, written by trace_insert()
+    uint32_t tail;      // free running, written by trace_read()
+    uint32_t lost;      // dropped since the last record that fit
+    uint32_t lost_total;
+    trace_rec_t buf[TRACE_EVENTS];
 } tracebuf_t;
 
 static tracebuf_t tracebuf;
+volatile bool trace_enabled;
+
+#ifdef MICROPY_PY_RTTHREAD
+static void trace_thread_hook(struct rt_thread *from, struct rt_thread *to)
+{
+    trace_event(TRACE_THREAD, (uint32_t) to);
+}
+#endif
 
 void trace_init()
 {
-    tracebuf.idx = 0;
-    for (int i=0; i<TRACEBUF_SIZE; i++) {
-        tracebuf.buf[i] = 0;
+    trace_enabled = false;
+    memset(&tracebuf, 0, sizeof(tracebuf));
+}
+
+void trace_insert(uint32_t event, uint32_t arg)
+{
+    mp_uint_t atomic_state = disable_irq();
+    tracebuf_t *t = &tracebuf;
+    // a lost record goes in first, once there is room for it and the event
+    uint32_t need = t->lost ? 2 : 1;
+    if ((TRACE_EVENTS - (t->head - t->tail)) < need) {
+        t->lost++;
+        t->lost_total++;
+    } else {
+        uint32_t cycles = DWT->CYCCNT;
+        if (t->lost) {
+            trace_rec_t *rec = &t->buf[t->head++ & (TRACE_EVENTS - 1)];
+            rec->cycles = cycles;
+            rec->event = (TRACE_LOST << 24) | MIN(t->lost, TRACE_ARG_MASK);
+            t->lost = 0;
+        }
+        trace_rec_t *rec = &t->buf[t->head++ & (TRACE_EVENTS - 1)];
+        rec->cycles = cycles;
+        rec->event = (event << 24) | (arg & TRACE_ARG_MASK);
     }
+    enable_irq(atomic_state);
 }
 
-void trace_insert(uint32_t x)
+void trace_enable(bool enable)
 {
-    __disable_irq();
-    if (tracebuf.idx < TRACEBUF_SIZE) {
-        tracebuf.buf[tracebuf.idx++] = x;
+    trace_enabled = false;
+    mp_uint_t atomic_state = disable_irq();
+    tracebuf.head = tracebuf.tail = 0;
+    tracebuf.lost = tracebuf.lost_total = 0;
+    enable_irq(atomic_state);
+    if (enable) {
+        mp_hal_ticks_cpu_enable();
     }
-    __enable_irq();
+    #ifdef MICROPY_PY_RTTHREAD
+    rt_scheduler_sethook(enable ? trace_thread_hook : NULL);
+    #endif
+    trace_enabled = enable;
+}
+
+uint32_t trace_available(void)
+{
+    return (tracebuf.head - tracebuf.tail) * sizeof(trace_rec_t);
+}
+
+uint32_t trace_read(void *buf, uint32_t bytes)
+{
+    tracebuf_t *t = &tracebuf;
+    uint32_t n = MIN(bytes / sizeof(trace_rec_t), t->head - t->tail);
+    // buf is a USB packet buffer, not necessarily aligned
+    for (uint32_t i = 0; i < n; i++) {
+        memcpy((uint8_t *) buf + (i * sizeof(trace_rec_t)), &t->buf[(t->tail + i) & (TRACE_EVENTS - 1)], sizeof(trace_rec_t));
+    }
+    // the records are copied before the producer may reuse them
+    __DMB();
+    t->tail += n;
+    return n * sizeof(trace_rec_t);
+}
+
+void trace_sched_hook(bool running)
+{
+    trace_event(running ? TRACE_SCHED_BEGIN : TRACE_SCHED_END, 0);
+}
+
+uint32_t trace_lost(void)
+{
+    return tracebuf.lost_total;
 }
@@ -5,10 +5,61 @@
  *
  * Trace buffer.
  *
+ * A ring of (cycle count, event, arg) records, filled from anywhere including IRQs while the
+ * host has tracing enabled and drained over the debug channel. omvtrace.py turns them into a
+ * Chrome trace. Off, an event costs a load and a branch.
+ *
  */
 #ifndef __TRACE_H__
 #define __TRACE_H__
+#include <stdbool.h>
 #include <stdint.h>
+
+#define TRACE_EVENTS    (1024)      // records in the ring, a power of 2
+#define TRACE_ARG_MASK  (0xFFFFFF)  // args are cut to 24 bits
+
+// Keep in step with omvtrace.py.
+enum trace_event {
+    TRACE_NONE          = 0,
+    TRACE_LOST          = 1,        // arg: records dropped because the ring was full
+    TRACE_CSI_SOF       = 2,        // arg: frame sequence
+    TRACE_CSI_FRAG      = 3,        // arg: fragment index
+    TRACE_CSI_EOF       = 4,        // arg: frame sequence
+    TRACE_CSI_FRAG_LOST = 5,        // arg: fragment index, the frame is dropped
+    TRACE_USB_IRQ       = 6,        // arg: 1 enabled, 0 disabled
+    TRACE_GC_BEGIN      = 7,
+    TRACE_GC_END        = 8,
+    TRACE_SCHED_BEGIN   = 9,
+    TRACE_SCHED_END     = 10,
+    TRACE_THREAD        = 11,       // arg: the thread switched to
+    TRACE_FB_MARK       = 12,       // arg: marks after
+    TRACE_FB_FREE       = 13,       // arg: marks after
+};
+
+typedef struct _trace_rec_t {
+    uint32_t cycles;                // DWT->CYCCNT
+    uint32_t event;                 // event << 24 | arg
+} trace_rec_t;
+
+extern volatile bool trace_enabled;
+void trace_insert(uint32_t event, uint32_t arg);
+
+static inline void trace_event(uint32_t event, uint32_t arg)
+{
+    if (trace_enabled) {
+        trace_insert(event, arg);
+    }
+}
+
 void trace_init();
-void trace_insert(uint32_t x);
+// Empties the ring and starts or stops recording.
+void trace_enable(bool enable);
+// Bytes of whole records waiting in the ring.
+uint32_t trace_available(void);
+// Copies out up to bytes of whole records and returns the bytes copied.
+uint32_t trace_read(void *buf, uint32_t bytes);
+// MICROPY_SCHED_HOOK, around each scheduled callback.
+void trace_sched_hook(bool running);
+// Records dropped since trace_enable().
+uint32_t trace_lost(void);
 #endif /* __TRACE_H__ */
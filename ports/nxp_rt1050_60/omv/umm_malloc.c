@@ -124,6 +124,44 @@ unsigned short int umm_numblocks = 0;
 
 #define UMM_NUMBLOCKS (umm_numblocks)
 
+/* ------------------------------------------------------------------------- */
+
+/*
+ * Slab front end for small requests. AprilTag and zbar make thousands of
+ * 8-64 byte allocations per frame and every one of them used to walk the
+ * whole free list (and burn a full OMV_UMM_BLOCK_SIZE body). A slice at the
+ * start of the heap is cut into UMM_SLAB_PAGE_SIZE pages, each page is bound
+ * to one size class the first time that class needs memory, and freed chunks
+ * go on a per-class singly linked list. Ownership is decided by address range,
+ * so malloc and free are both O(1). Pages are never given back, the whole
+ * slab is reset by the next umm_init_x().
+ */
+
+#define UMM_SLAB_PAGE_SIZE  (512)
+#define UMM_SLAB_MAX_PAGES  (128)
+#define UMM_SLAB_MAX_SIZE   (64)
+#define UMM_SLAB_SHIFT      (3) // slab gets at most 1/8th of the heap.
+#define UMM_SLAB_NO_CLASS   (0xFF)
+
+typedef struct umm_slab_chunk {
+  struct umm_slab_chunk *next;
+} umm_slab_chunk;
+
+static const unsigned char umm_slab_sizes[UMM_SLAB_CLASSES] = { 8, 16, 24, 32, 48, 64 };
+static const unsigned char umm_slab_index[UMM_SLAB_MAX_SIZE / 8] = { 0, 1, 2, 3, 4, 4, 5, 5 };
+
+static char *umm_slab_base = NULL;
+static unsigned short int umm_slab_pages = 0;
+static unsigned short int umm_slab_pages_used = 0;
+static unsigned char umm_slab_class[UMM_SLAB_MAX_PAGES];
+static umm_slab_chunk *umm_slab_free[UMM_SLAB_CLASSES];
+
+static umm_stats_t umm_stats;
+
+#define UMM_SLAB_OWNS(p) (((char *)(p) >= umm_slab_base) && \
+                          ((char *)(p) < (umm_slab_base + (umm_slab_pages * UMM_SLAB_PAGE_SIZE))))
+#define UMM_SLAB_PAGE(p) ((((char *)(p)) - umm_slab_base) / UMM_SLAB_PAGE_SIZE)
+
 /* ------------------------------------------------------------------------ */
 
 #define UMM_BLOCK(b)  (umm_heap[b])
@@ -239,6 +277,24 @@ void umm_init_x( size_t size ) {
   if (UMM_MALLOC_CFG_HEAP_SIZE < (sizeof(umm_block) * 128)) fb_alloc_fail();
   if (UMM_MALLOC_CFG_HEAP_SIZE > (sizeof(umm_block) * 32768)) UMM_MALLOC_CFG_HEAP_SIZE = sizeof(umm_block) * 32768;
   void *UMM_MALLOC_CFG_HEAP_ADDR = fb_alloc(UMM_MALLOC_CFG_HEAP_SIZE, FB_ALLOC_NO_HINT);
+
+  /* carve the slab pages off the front, the block heap keeps at least 128 blocks */
+  uint32_t slab_pages = (UMM_MALLOC_CFG_HEAP_SIZE >> UMM_SLAB_SHIFT) / UMM_SLAB_PAGE_SIZE;
+  if (slab_pages > UMM_SLAB_MAX_PAGES) slab_pages = UMM_SLAB_MAX_PAGES;
+  if ((UMM_MALLOC_CFG_HEAP_SIZE - (slab_pages * UMM_SLAB_PAGE_SIZE)) < (sizeof(umm_block) * 128)) slab_pages = 0;
+
+  umm_slab_base = (char *)UMM_MALLOC_CFG_HEAP_ADDR;
+  umm_slab_pages = slab_pages;
+  umm_slab_pages_used = 0;
+  memset(umm_slab_class, UMM_SLAB_NO_CLASS, sizeof(umm_slab_class));
+  memset(umm_slab_free, 0, sizeof(umm_slab_free));
+  UMM_MALLOC_CFG_HEAP_ADDR = umm_slab_base + (slab_pages * UMM_SLAB_PAGE_SIZE);
+  UMM_MALLOC_CFG_HEAP_SIZE -= slab_pages * UMM_SLAB_PAGE_SIZE;
+
+  memset(&umm_stats, 0, sizeof(umm_stats));
+  umm_stats.heap_bytes = UMM_MALLOC_CFG_HEAP_SIZE;
+  umm_stats.slab_pages = slab_pages;
+
   /* init heap pointer and size, and memset it to 0 */
   umm_heap = (umm_block *)UMM_MALLOC_CFG_HEAP_ADDR;
   umm_numblocks = (UMM_MALLOC_CFG_HEAP_SIZE / sizeof(umm_block));
@@ -300,6 +356,74 @@ void umm_init( void ) {
 
 /* ------------------------------------------------------------------------ */
 
+static void *umm_slab_malloc( size_t size ) {
+  unsigned char cls = umm_slab_index[(size - 1) >> 3];
+  umm_slab_chunk *chunk = umm_slab_free[cls];
+
+  if( (umm_slab_chunk *)NULL == chunk ) {
+    /* bind a fresh page to this class and thread all of its chunks */
+    if( umm_slab_pages_used >= umm_slab_pages )
+      return( (void *)NULL );
+
+    unsigned short int page = umm_slab_pages_used++;
+    unsigned int csize = umm_slab_sizes[cls];
+    char *p = umm_slab_base + (page * UMM_SLAB_PAGE_SIZE);
+
+    umm_slab_class[page] = cls;
+
+    for( unsigned int i = (UMM_SLAB_PAGE_SIZE / csize); i; i--, p += csize ) {
+      ((umm_slab_chunk *)p)->next = chunk;
+      chunk = (umm_slab_chunk *)p;
+    }
+
+    umm_stats.slab_pages_used = umm_slab_pages_used;
+  }
+
+  umm_slab_free[cls] = chunk->next;
+  umm_stats.slab_in_use[cls] += 1;
+  umm_stats.slab_allocs += 1;
+
+  return( (void *)chunk );
+}
+
+static void umm_slab_release( void *ptr ) {
+  unsigned char cls = umm_slab_class[UMM_SLAB_PAGE(ptr)];
+
+  ((umm_slab_chunk *)ptr)->next = umm_slab_free[cls];
+  umm_slab_free[cls] = (umm_slab_chunk *)ptr;
+  umm_stats.slab_in_use[cls] -= 1;
+}
+
+/* ------------------------------------------------------------------------ */
+
+/*
+ * Walks the free list once to record how fragmented the block heap is. Only
+ * done when an allocation fails, the heap lives in fb_alloc memory and is gone
+ * by the time anyone can look at the numbers.
+ */
+
+static void umm_sample_free_list( void ) {
+  unsigned int free_bytes = 0, free_blocks = 0, largest = 0;
+
+  for( unsigned short int cf = UMM_NFREE(0); cf; cf = UMM_NFREE(cf) ) {
+    unsigned int blockSize = ((UMM_NBLOCK(cf) & UMM_BLOCKNO_MASK) - cf) * sizeof(umm_block);
+    free_bytes += blockSize;
+    free_blocks += 1;
+    if( blockSize > largest )
+      largest = blockSize;
+  }
+
+  umm_stats.free_bytes = free_bytes;
+  umm_stats.free_blocks = free_blocks;
+  umm_stats.largest_free = largest;
+}
+
+void umm_get_stats( umm_stats_t *stats ) {
+  *stats = umm_stats;
+}
+
+/* ------------------------------------------------------------------------ */
+
 void umm_free( void *ptr ) {
 
   unsigned short int c;
@@ -321,6 +445,12 @@ void umm_free( void *ptr ) {
    *        on the free list!
    */
 
+  if( UMM_SLAB_OWNS(ptr) ) {
+    umm_slab_release( ptr );
+
+    return;
+  }
+
   /* Protect the critical section... */
   UMM_CRITICAL_ENTRY();
 
@@ -330,6 +460,8 @@ void umm_free( void *ptr ) {
 
   DBGLOG_DEBUG( "Freeing block %6i\n", c );
 
+  umm_stats.used_bytes -= (UMM_NBLOCK(c) - c) * sizeof(umm_block);
+
   /* Now let's assimilate this block with the next one if possible. */
 
   umm_assimilate_up( c );
@@ -389,6 +521,15 @@ void *umm_malloc( size_t size ) {
     return( (void *)NULL );
   }
 
+  umm_stats.allocs += 1;
+
+  if( size <= UMM_SLAB_MAX_SIZE ) {
+    void *ptr = umm_slab_malloc( size );
+
+    if( ptr )
+      return( ptr );
+  }
+
   /* Protect the critical section... */
   UMM_CRITICAL_ENTRY();
 
@@ -479,12 +620,19 @@ void *umm_malloc( size_t size ) {
 
     DBGLOG_DEBUG(  "Can't allocate %5i blocks\n", blocks );
 
+    umm_stats.fails += 1;
+    umm_sample_free_list();
+
     /* Release the critical section... */
     UMM_CRITICAL_EXIT();
 
     return( (void *)NULL );
   }
 
+  umm_stats.used_bytes += blocks * sizeof(umm_block);
+  if( umm_stats.used_bytes > umm_stats.peak_bytes )
+    umm_stats.peak_bytes = umm_stats.used_bytes;
+
   /* Release the critical section... */
   UMM_CRITICAL_EXIT();
 
@@ -536,6 +684,26 @@ void *umm_realloc( void *ptr, size_t size ) {
     return( (void *)NULL );
   }
 
+  /*
+   * Slab chunks stay put while the new size still fits their class, anything
+   * else moves to wherever umm_malloc() puts a block of the new size.
+   */
+
+  if( UMM_SLAB_OWNS(ptr) ) {
+    unsigned int csize = umm_slab_sizes[umm_slab_class[UMM_SLAB_PAGE(ptr)]];
+    void *newptr;
+
+    if( size <= csize )
+      return( ptr );
+
+    if( (newptr = umm_malloc( size )) ) {
+      memcpy( newptr, ptr, (size < csize) ? size : csize );
+      umm_slab_release( ptr );
+    }
+
+    return( newptr );
+  }
+
   /*
    * Otherwise we need to actually do a reallocation. A naiive approach
    * would be to malloc() a new block of the correct size, copy the old data
@@ -611,6 +779,7 @@ void *umm_realloc( void *ptr, size_t size ) {
         DBGLOG_DEBUG( "realloc using next block - %i\n", blocks );
   umm_assimilate_up( c );
         blockSize += nextBlockSize;
+        umm_stats.used_bytes += nextBlockSize * sizeof(umm_block);
     } else if ((prevBlockSize + blockSize) >= blocks) {
         DBGLOG_DEBUG( "realloc using prev block - %i\n", blocks );
     umm_disconnect_from_free_list( UMM_PBLOCK(c) );
@@ -618,6 +787,7 @@ void *umm_realloc( void *ptr, size_t size ) {
     memmove( (void *)&UMM_DATA(c), ptr, curSize );
     ptr    = (void *)&UMM_DATA(c);
         blockSize += prevBlockSize;
+        umm_stats.used_bytes += prevBlockSize * sizeof(umm_block);
     } else if ((prevBlockSize + blockSize + nextBlockSize) >= blocks) {
         DBGLOG_DEBUG( "realloc using prev and next block - %i\n", blocks );
         umm_assimilate_up( c );
@@ -626,6 +796,7 @@ void *umm_realloc( void *ptr, size_t size ) {
         memmove( (void *)&UMM_DATA(c), ptr, curSize );
         ptr = (void *)&UMM_DATA(c);
         blockSize += (prevBlockSize + nextBlockSize);
+        umm_stats.used_bytes += (prevBlockSize + nextBlockSize) * sizeof(umm_block);
   } else {
         DBGLOG_DEBUG( "realloc a completely new block %i\n", blocks );
     void *oldptr = ptr;
@@ -650,6 +821,9 @@ void *umm_realloc( void *ptr, size_t size ) {
         umm_free( (void *)&UMM_DATA(c+blocks) );
   }
 
+  if( umm_stats.used_bytes > umm_stats.peak_bytes )
+    umm_stats.peak_bytes = umm_stats.used_bytes;
+
   /* Release the critical section... */
   UMM_CRITICAL_EXIT();
 
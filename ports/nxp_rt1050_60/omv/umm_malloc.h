@@ -6,8 +6,30 @@
 #ifndef __UMM_MALLOC_H__
 #define __UMM_MALLOC_H__
 #include <stdlib.h>
+#include <stdint.h>
+
+#define UMM_SLAB_CLASSES (6) // 8, 16, 24, 32, 48 and 64 byte chunks.
+
+// Counters for the current (or last) umm heap, reset by umm_init_x(). The free
+// list fields are sampled when a block allocation fails, that's when the
+// fragmentation matters and the heap is still around to be walked.
+typedef struct umm_stats {
+    uint32_t heap_bytes;    // block heap size, without the slab pages.
+    uint32_t used_bytes;
+    uint32_t peak_bytes;
+    uint32_t allocs;
+    uint32_t slab_allocs;   // allocs served by the slab front end.
+    uint32_t fails;
+    uint32_t free_bytes;    // at the last failure.
+    uint32_t free_blocks;   // at the last failure.
+    uint32_t largest_free;  // at the last failure.
+    uint16_t slab_pages;
+    uint16_t slab_pages_used;
+    uint32_t slab_in_use[UMM_SLAB_CLASSES];
+} umm_stats_t;
 
 void umm_alloc_fail();
+void umm_get_stats(umm_stats_t *stats);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //////// "umm_malloc.h"
@@ -12,6 +12,7 @@
 #include "framebuffer.h"
 #include "ff.h"
 #include "usbdbg.h"
+#include "trace.h"
 #include "nlr.h"
 #include "lexer.h"
 #include "parse.h"
@@ -27,6 +28,10 @@ static enum usbdbg_cmd cmd;
 static volatile bool script_ready;
 volatile bool script_running;
 vstr_t script_buf;
+// USBDBG_SCRIPT_EXEC_MPY: script_buf holds a .mpy file mpy-cross compiled on the host.
+static bool script_is_mpy;
+// USBDBG_HOT_RELOAD: scripts run one after the other without a soft reset in between.
+static bool hot_reload;
 
 #define mp_const_ide_interrupt (MP_STATE_PORT(omv_ide_irq))
 // /*static*/ mp_obj_t mp_const_ide_interrupt = MP_OBJ_NULL;
@@ -35,6 +40,9 @@ extern void usbd_cdc_tx_buf_flush();
 extern uint32_t usbd_cdc_tx_buf_len();
 extern uint8_t *usbd_cdc_tx_buf(uint32_t bytes);
 extern const char *ffs_strerror(FRESULT res);
+extern bool usb_vnd_is_configured(void);
+extern int usb_vnd_send(const uint8_t *buf, uint32_t len, void (*done)(bool ok));
+extern void usb_vnd_cancel(void);
 
 void usbdbg_init()
 {
@@ -60,6 +68,16 @@ vstr_t *usbdbg_get_script()
     return &script_buf;
 }
 
+bool usbdbg_script_is_mpy()
+{
+    return script_is_mpy;
+}
+
+bool usbdbg_get_hot_reload()
+{
+    return hot_reload;
+}
+
 void usbdbg_set_script_running(bool running)
 {
     script_running = running;
@@ -72,6 +90,7 @@ bool usbdbg_script_running()
 
 inline void usbdbg_set_irq_enabled(bool enabled)
 {
+    trace_event(TRACE_USB_IRQ, enabled);
     if (enabled) {
 		NVIC_EnableIRQ(USB_OTG1_IRQn);
     } else {
@@ -91,6 +110,64 @@ inline void usbdbg_set_irq_enabled(bool enabled)
 #else
 #define DUMP_FB JPEG_FB
 #endif
+// USBDBG_FRAME_STREAM: the frame goes out on the vendor bulk IN endpoint (pyb.usb_mode('VCP+MSC+VND'))
+// and the reply is w, h and the bytes to read there. The IDE asks for the JPEG preview (0) or the
+// raw main frame (1), grayscale or RGB565 (big endian) when size is w * h or w * h * 2. Size 0
+// means no frame is ready or the endpoint is not there, the IDE falls back to FRAME_DUMP.
+#define USBDBG_STREAM_JPEG  (0)
+#define USBDBG_STREAM_RAW   (1)
+#ifndef OMV_MPY_ONLY
+static uint32_t stream_info[3];
+static int stream_src;
+
+static void usbdbg_stream_done(bool ok)
+{
+	if (stream_src == USBDBG_STREAM_RAW) {
+		fb_streaming = false;
+	} else {
+		JPEG_FB()->w = 0; JPEG_FB()->h = 0; JPEG_FB()->size = 0;
+		mutex_unlock(&JPEG_FB()->lock, MUTEX_TID_IDE);
+	}
+}
+
+static void usbdbg_stream_start(int src)
+{
+	// A frame the IDE gave up on is dropped.
+	usb_vnd_cancel();
+	memset(stream_info, 0, sizeof(stream_info));
+	if (!usb_vnd_is_configured()) {
+		return;
+	}
+	stream_src = src;
+	if (src == USBDBG_STREAM_RAW) {
+		uint32_t size = fb_buffer_size();
+		if ((!MAIN_FB()->w) || (!MAIN_FB()->h) || (!size)) {
+			return;
+		}
+		fb_streaming = true;
+		if (usb_vnd_send(MAIN_FB()->pixels, size, usbdbg_stream_done) != 0) {
+			fb_streaming = false;
+			return;
+		}
+		stream_info[0] = MAIN_FB()->w;
+		stream_info[1] = MAIN_FB()->h;
+		stream_info[2] = size;
+	} else {
+		if (!mutex_try_lock(&JPEG_FB()->lock, MUTEX_TID_IDE)) {
+			return;
+		}
+		if ((JPEG_FB()->size == 0)
+				|| (usb_vnd_send(JPEG_FB()->pixels, JPEG_FB()->size, usbdbg_stream_done) != 0)) {
+			mutex_unlock(&JPEG_FB()->lock, MUTEX_TID_IDE);
+			return;
+		}
+		stream_info[0] = JPEG_FB()->w;
+		stream_info[1] = JPEG_FB()->h;
+		stream_info[2] = JPEG_FB()->size;
+	}
+}
+#endif
+
 volatile uint8_t g_omvIdeConnecting;
 __WEAK int sensor_get_id(void) {return 1;}
 __WEAK void Hook_OnUsbDbgScriptExec(void) {}
@@ -116,6 +193,26 @@ void usbdbg_data_in(void *buffer, int length)
             cmd = USBDBG_NONE;
             break;
         }
+        case USBDBG_TRACE_LEN: {
+            // bytes waiting, cycles per second of the timestamps, records lost
+            uint32_t info[3] = { trace_available(), SystemCoreClock, trace_lost() };
+            memcpy(buffer, info, sizeof(info));
+            cmd = USBDBG_NONE;
+            break;
+        }
+
+        case USBDBG_TRACE_BUF: {
+            // the host asks for what USBDBG_TRACE_LEN returned, records that came in since
+            // are left for the next read and a shortfall is padded with TRACE_NONE
+            int n = trace_read(buffer, length);
+            memset((uint8_t *) buffer + n, 0, length - n);
+            xfer_bytes += length;
+            if (xfer_bytes >= xfer_length) {
+                cmd = USBDBG_NONE;
+            }
+            break;
+        }
+
         case USBDBG_SENSOR_ID: {
             int sensor_id = sensor_get_id();
             memcpy(buffer, &sensor_id, 4);
@@ -194,6 +291,16 @@ void usbdbg_data_in(void *buffer, int length)
 			#endif
             break;
 
+        case USBDBG_FRAME_STREAM:
+			g_omvIdeConnecting = 0;
+		#ifdef OMV_MPY_ONLY
+			memset(buffer, 0, 12);
+		#else
+			memcpy(buffer, stream_info, sizeof(stream_info));
+		#endif
+            cmd = USBDBG_NONE;
+            break;
+
         case USBDBG_ARCH_STR: {
 			// Note: this is not official OpenMV Cam board, thank 
 			// openmv llc who supported openMV i.MX RT porting!
@@ -230,7 +337,7 @@ void usbdbg_data_in(void *buffer, int length)
 }
 
 extern int py_image_descriptor_from_roi(image_t *image, const char *path, rectangle_t *roi);
-extern void ProfReset(void);
+#include "profiler.h"
 
 void usbdbg_try_run_script(void)
 {
@@ -245,7 +352,7 @@ void usbdbg_try_run_script(void)
     // Note: setting pendsv explicitly here because the VM is probably
     // waiting in REPL and the soft interrupt flag will not be checked.
     // PRINTF("nlr jumping to execute script\r\n");
-    ProfReset();
+    profiler_reset();
     pendsv_nlr_jump_hard(mp_const_ide_interrupt);
 }
 extern uint8_t g_isMainDotPyRunning;
@@ -268,6 +375,7 @@ void usbdbg_data_out(void *buffer, int length)
         }
 
         case USBDBG_SCRIPT_EXEC:
+        case USBDBG_SCRIPT_EXEC_MPY:
             // check if GC is locked before allocating memory for vstr. If GC was locked
             // at least once before the script is fully uploaded xfer_bytes will be less
             // than the total length (xfer_length) and the script will Not be executed.
@@ -396,15 +504,25 @@ void usbdbg_control(void *buffer, uint8_t request, uint32_t length)
             xfer_length = length;
             break;
 
+        case USBDBG_FRAME_STREAM:
+            xfer_bytes = 0;
+            xfer_length = length;
+			#ifndef OMV_MPY_ONLY
+            usbdbg_stream_start(*((int16_t*)buffer));
+			#endif
+            break;
+
         case USBDBG_ARCH_STR:
             xfer_bytes = 0;
             xfer_length = length;
             break;
 
         case USBDBG_SCRIPT_EXEC:
+        case USBDBG_SCRIPT_EXEC_MPY:
             xfer_bytes = 0;
             xfer_length = length;
             vstr_reset(&script_buf);
+            script_is_mpy = (cmd == USBDBG_SCRIPT_EXEC_MPY);
             break;
 
         case USBDBG_SCRIPT_STOP:
@@ -487,12 +605,39 @@ void usbdbg_control(void *buffer, uint8_t request, uint32_t length)
             break;
         }
 
+        case USBDBG_FB_FRAMING: {
+			#ifndef OMV_MPY_ONLY
+            // FB_IDE_FRAMING_*, an old IDE never sends it and keeps the text framing.
+            int16_t framing = *((int16_t*)buffer);
+            fb_set_ide_framing(framing);
+			#endif
+            cmd = USBDBG_NONE;
+            break;
+        }
+
         case USBDBG_TX_BUF:
         case USBDBG_TX_BUF_LEN:
+        case USBDBG_TRACE_LEN:
+        case USBDBG_TRACE_BUF:
             xfer_bytes = 0;
             xfer_length = length;
             break;
 
+        case USBDBG_TRACE_CTRL: {
+            int16_t enable = *((int16_t*)buffer);
+            trace_enable(enable);
+            cmd = USBDBG_NONE;
+            break;
+        }
+
+        case USBDBG_HOT_RELOAD: {
+            // Takes effect when the script running now ends.
+            int16_t enable = *((int16_t*)buffer);
+            hot_reload = enable;
+            cmd = USBDBG_NONE;
+            break;
+        }
+
         default: /* error */
             cmd = USBDBG_NONE;
             break;
@@ -507,8 +652,12 @@ void usbdbg_connect(void)
 void usbdbg_disconnect(void) {
 	#ifndef OMV_MPY_ONLY
 	JPEG_FB()->enabled = 0;
+	fb_set_ide_framing(FB_IDE_FRAMING_TEXT);
+	usb_vnd_cancel();
 	mutex_unlock(&JPEG_FB()->lock, MUTEX_TID_IDE);
 	#endif
+	trace_enable(false);
+	hot_reload = false;
 	// sensor_set_framerate(2<<9 | 1<<11);
 }
 
@@ -18,7 +18,7 @@
   * the IDE will Not connect if the major version number is different.
   */
 #define FIRMWARE_VERSION_MAJOR      (3)
-#define FIRMWARE_VERSION_MINOR      (15)
+#define FIRMWARE_VERSION_MINOR      (18)
 #define FIRMWARE_VERSION_PATCH      (0)
 
 /**
@@ -47,12 +47,21 @@ enum usbdbg_cmd {
     USBDBG_FB_ENABLE        =0x0D,
     USBDBG_TX_BUF_LEN       =0x8E,
     USBDBG_TX_BUF           =0x8F,
-    USBDBG_SENSOR_ID        =0x90
+    USBDBG_SENSOR_ID        =0x90,
+    USBDBG_FB_FRAMING       =0x11,
+    USBDBG_FRAME_STREAM     =0x92,
+    USBDBG_TRACE_CTRL       =0x13,
+    USBDBG_TRACE_LEN        =0x94,
+    USBDBG_TRACE_BUF        =0x95,
+    USBDBG_SCRIPT_EXEC_MPY  =0x16,
+    USBDBG_HOT_RELOAD       =0x17
 };
 void usbdbg_init();
 bool usbdbg_script_ready();
 void usbdbg_stop_script(void);
 vstr_t *usbdbg_get_script();
+bool usbdbg_script_is_mpy();
+bool usbdbg_get_hot_reload();
 bool usbdbg_get_irq_enabled();
 void usbdbg_set_irq_enabled(bool enabled);
 void usbdbg_set_script_running(bool running);
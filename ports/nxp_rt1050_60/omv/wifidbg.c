@@ -40,6 +40,11 @@
 #define SERVER_ADDR              ((uint8_t [5]){192, 168, 1, 1})
 #define SERVER_PORT              (9000)
 #define BUFFER_SIZE              (1024)
+// Frame dumps go out from the frame buffer in sends of this many bytes, back to back, the
+// module splits them into segments and the TCP window paces them.
+#define WIFIDBG_TX_PACKET        (8 * 1460)
+// IDE commands handled per wifidbg_dispatch() while more of them are waiting.
+#define WIFIDBG_DISPATCH_MAX_CMDS (8)
 
 #define UDPCAST_STRING           "%d.%d.%d.%d:%d:%s"
 #define UDPCAST_STRING_SIZE      4+4+4+4+6+WINC_MAX_BOARD_NAME_LEN+1
@@ -82,7 +87,8 @@ static uint8_t ip_addr[WINC_IP_ADDR_LEN] = {0x0};
 static char udpbcast_string[UDPCAST_STRING_SIZE] = {0x0};
 static winc_socket_buf_t sockbuf;
 
-#define WIFI_DBG_BUF_SIZE  256
+// The IDE reads the text output a block at a time, up to BUFFER_SIZE per read.
+#define WIFI_DBG_BUF_SIZE  BUFFER_SIZE
 #define WIFI_DBG_BUF_CNT	4
 static uint8_t s_SendBuf[WIFI_DBG_BUF_CNT][WIFI_DBG_BUF_SIZE];
 static uint8_t socket_buf[1024];
@@ -197,7 +203,7 @@ void wifidbg_TxBufWrite(const uint8_t *buf, uint32_t len)
 			}
 		}
 #endif
-		rt = RingBlk_Write(&s_txRB, buf, len - i);
+		rt = RingBlk_Write(&s_txRB, buf + i, len - i);
 		if(rt)
 			i += rt;
 		else
@@ -348,6 +354,7 @@ int wifidbg_dispatch()
     sockaddr client_sockaddr,udpbcast_sockaddr,server_sockaddr;
     static uint32_t dbg_tx_len =0;
     static uint32_t dbg_tx_rt =0;
+	int cmds = 0;
 
 	if (client_fd < 0)
 		return -1;
@@ -410,7 +417,22 @@ rx_loop:
 	//PRINTF("request:0x%x,cmd len:%d\r\n",request,xfer_length);
 
     while (xfer_length>0) {
-        if (request & 0x80) {
+        const uint8_t *direct;
+        int avail;
+        if ((request & 0x80) && ((direct = wifidbg_data_in_direct(&avail)) != NULL)) {
+            // Frame data straight from the frame buffer, no copy and no pause between sends
+            bytes = MIN(MIN(xfer_length, avail), WIFIDBG_TX_PACKET);
+			M8266_DBG_IO_Toggle(3);
+			if ((ret = winc_socket_sendblock(client_fd, (uint8_t *)direct, bytes, 100)) < 0) {
+                	close_all_sockets();
+					M8266_DBG_IO_Write(0,0);
+                	return -2;
+            }
+            M8266_DBG_IO_Toggle(3);
+			wifidbg_data_in_sent(ret);
+			xfer_length -= ret;
+        }
+        else if (request & 0x80) {
             // Device-to-host data phase
             bytes = MIN(xfer_length, BUFFER_SIZE);
             
@@ -461,8 +483,9 @@ rx_loop:
         }
     }
 
-//    if((sockbuf.size!= 0) || (winc_socket_rev(client_fd) >0))
-//    	goto rx_loop;
+	// The IDE sends its next command without waiting, take it now rather than a tick later.
+	if ((++cmds < WIFIDBG_DISPATCH_MAX_CMDS) && ((sockbuf.size != 0) || (winc_socket_has_rev(client_fd) != 0)))
+		goto rx_loop;
 
 	M8266_DBG_IO_Write(0,0);
     return 0;
@@ -23,4 +23,11 @@ int wifidbg_connect_IDE();
 
 int wifidbg_dispatch();
 
+// wifidbg_ctrl.c
+void wifidbg_control(void *buffer, uint8_t request, uint32_t length);
+void wifidbg_data_in(void *buffer, int length);
+void wifidbg_data_out(void *buffer, int length);
+const uint8_t *wifidbg_data_in_direct(int *length);
+void wifidbg_data_in_sent(int length);
+
 #endif /* __WIFIDBG_H__ */
@@ -40,7 +40,7 @@ extern const char *ffs_strerror(FRESULT res);
 #endif
 extern volatile uint8_t g_omvIdeConnecting;
 extern int py_image_descriptor_from_roi(image_t *image, const char *path, rectangle_t *roi);
-extern void ProfReset(void);
+#include "profiler.h"
 
 
 void wifidbg_data_out(void *buffer, int length)
@@ -69,7 +69,7 @@ void wifidbg_data_out(void *buffer, int length)
                     // Note: setting pendsv explicitly here because the VM is probably
                     // waiting in REPL and the soft interrupt flag will not be checked.
                     PRINTF("nlr jumping to execute script\r\n");
-					ProfReset();
+					profiler_reset();
                     pendsv_nlr_jump_hard(mp_const_ide_interrupt);
 					#else
 					rtt_wifidbg_hardjump();
@@ -282,6 +282,35 @@ void wifidbg_data_in(void *buffer, int length)
 #endif
 }
 
+// The bytes of a FRAME_DUMP not sent yet, straight from the frame buffer so they go out
+// without a copy, or NULL for the other commands.
+const uint8_t *wifidbg_data_in_direct(int *length)
+{
+#if MICROPY_HW_WIFIDBG_EN && !defined(OMV_MPY_ONLY)
+    if ((cmd == USBDBG_FRAME_DUMP) && (xfer_bytes < xfer_length)) {
+        *length = xfer_length - xfer_bytes;
+        return DUMP_FB()->pixels + xfer_bytes;
+    }
+#endif
+    return NULL;
+}
+
+// Moves past length bytes of wifidbg_data_in_direct() once they are sent, the JPEG frame
+// buffer is released after the last.
+void wifidbg_data_in_sent(int length)
+{
+#if MICROPY_HW_WIFIDBG_EN && !defined(OMV_MPY_ONLY)
+    xfer_bytes += length;
+    if (xfer_bytes >= xfer_length) {
+        cmd = USBDBG_NONE;
+        #ifndef DUMP_RAW
+        JPEG_FB()->w = 0; JPEG_FB()->h = 0; JPEG_FB()->size = 0;
+        mutex_unlock(&JPEG_FB()->lock, MUTEX_TID_IDE);
+        #endif
+    }
+#endif
+}
+
 void wifidbg_control(void *buffer, uint8_t request, uint32_t length)
 {
     cmd = (enum usbdbg_cmd) request;
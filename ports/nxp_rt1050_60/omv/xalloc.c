@@ -8,6 +8,7 @@
  */
 #include <mp.h>
 #include "xalloc.h"
+#include "omv_boardconfig.h"
 
 NORETURN static void xalloc_fail()
 {
@@ -59,3 +60,112 @@ void *xrealloc(void *mem, uint32_t size)
     }
     return mem;
 }
+
+// Scratch arena for short-lived imlib nodes (list links, temporary arrays), so detectors
+// do not churn the GC heap every frame. A bump allocator over a static buffer: frees only
+// count down and the arena rewinds once nothing in it is live. The used part is traced as
+// a GC root since nodes point to GC objects. Full arena falls back to the GC heap.
+#ifndef OMV_XALLOC_ARENA_SIZE
+#define OMV_XALLOC_ARENA_SIZE   (0)
+#endif
+
+#if (OMV_XALLOC_ARENA_SIZE > 0)
+static uint64_t arena_buf[OMV_XALLOC_ARENA_SIZE / sizeof(uint64_t)];
+static char *arena_top = (char *) arena_buf;
+static uint32_t arena_live;
+
+#define ARENA_END   ((char *) arena_buf + sizeof(arena_buf))
+#define ARENA_HDR   (sizeof(uint64_t)) // size of the block, keeps blocks 8 byte aligned
+
+static inline bool arena_owns(void *mem)
+{
+    return ((char *) mem >= (char *) arena_buf) && ((char *) mem < ARENA_END);
+}
+#endif
+
+// returns null pointer without error if size==0
+void *xalloc_arena(uint32_t size)
+{
+    #if (OMV_XALLOC_ARENA_SIZE > 0)
+    if (!size) {
+        return NULL;
+    }
+    uint32_t bytes = ARENA_HDR + ((size + 7) & ~7);
+    if ((uint32_t) (ARENA_END - arena_top) >= bytes) {
+        char *mem = arena_top + ARENA_HDR;
+        *((uint32_t *) arena_top) = bytes;
+        arena_top += bytes;
+        arena_live += 1;
+        return mem;
+    }
+    #endif
+    return xalloc(size);
+}
+
+// returns without error if mem==null
+void xfree_arena(void *mem)
+{
+    #if (OMV_XALLOC_ARENA_SIZE > 0)
+    if (arena_owns(mem)) {
+        char *blk = (char *) mem - ARENA_HDR;
+        if ((blk + *((uint32_t *) blk)) == arena_top) {
+            arena_top = blk; // last block, give it back
+        }
+        if (!(--arena_live)) {
+            arena_top = (char *) arena_buf;
+        }
+        return;
+    }
+    #endif
+    xfree(mem);
+}
+
+// same rules as xrealloc()
+void *xrealloc_arena(void *mem, uint32_t size)
+{
+    #if (OMV_XALLOC_ARENA_SIZE > 0)
+    if (!mem) {
+        return xalloc_arena(size);
+    }
+    if (!size) {
+        xfree_arena(mem);
+        return NULL;
+    }
+    if (arena_owns(mem)) {
+        char *blk = (char *) mem - ARENA_HDR;
+        uint32_t old_bytes = *((uint32_t *) blk);
+        uint32_t bytes = ARENA_HDR + ((size + 7) & ~7);
+        if (bytes <= old_bytes) {
+            return mem;
+        }
+        if (((blk + old_bytes) == arena_top) && ((uint32_t) (ARENA_END - blk) >= bytes)) {
+            // last block, grow in place
+            *((uint32_t *) blk) = bytes;
+            arena_top = blk + bytes;
+            return mem;
+        }
+        // moving would leave a hole the bump allocator can not reuse, carry on in the GC heap
+        void *new_mem = xalloc(size);
+        memcpy(new_mem, mem, old_bytes - ARENA_HDR);
+        xfree_arena(mem);
+        return new_mem;
+    }
+    #endif
+    return xrealloc(mem, size);
+}
+
+// Soft reset, nothing from the last script is alive anymore.
+void xalloc_arena_init0()
+{
+    #if (OMV_XALLOC_ARENA_SIZE > 0)
+    arena_top = (char *) arena_buf;
+    arena_live = 0;
+    #endif
+}
+
+void xalloc_arena_gc_collect()
+{
+    #if (OMV_XALLOC_ARENA_SIZE > 0)
+    gc_collect_root((void **) arena_buf, (arena_top - (char *) arena_buf) / sizeof(void *));
+    #endif
+}
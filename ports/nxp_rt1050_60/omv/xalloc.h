@@ -14,4 +14,11 @@ void *xalloc_try_alloc(uint32_t size);
 void *xalloc0(uint32_t size);
 void xfree(void *mem);
 void *xrealloc(void *mem, uint32_t size);
+// Short-lived scratch memory, falls back to the GC heap when the arena is full.
+// Memory from these must only be freed / resized with xfree_arena() / xrealloc_arena().
+void *xalloc_arena(uint32_t size);
+void xfree_arena(void *mem);
+void *xrealloc_arena(void *mem, uint32_t size);
+void xalloc_arena_init0();
+void xalloc_arena_gc_collect();
 #endif // __XALLOC_H__
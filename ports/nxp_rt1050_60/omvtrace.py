@@ -0,0 +1,156 @@
+"""
+Record the event trace of omv/trace.c over the debug channel and save it as a Chrome trace.
+
+With the IDE closed:
+
+    python3 omvtrace.py /dev/ttyACM0 -t 10 -o trace.json
+
+then open trace.json in chrome://tracing or ui.perfetto.dev. Capture frames show up as
+spans from SOF to EOF with their fragments as instants, next to GC runs, scheduled callbacks,
+fb_alloc mark nesting, the USB IRQ being off and, with RT-Thread, which thread ran.
+
+Timestamps are 32 bit cycle counts and are unwrapped here, which assumes no gap between two
+records is longer than one wrap, about 7s at 600MHz. The camera's SOF/EOF keep that true
+while it streams.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+import serial
+
+IDE_BAUDRATE = 12000000
+
+USBDBG_TRACE_CTRL = 0x13
+USBDBG_TRACE_LEN = 0x94
+USBDBG_TRACE_BUF = 0x95
+
+# enum trace_event in omv/trace.h
+TRACE_NONE = 0
+TRACE_LOST = 1
+TRACE_CSI_SOF = 2
+TRACE_CSI_FRAG = 3
+TRACE_CSI_EOF = 4
+TRACE_CSI_FRAG_LOST = 5
+TRACE_USB_IRQ = 6
+TRACE_GC_BEGIN = 7
+TRACE_GC_END = 8
+TRACE_SCHED_BEGIN = 9
+TRACE_SCHED_END = 10
+TRACE_THREAD = 11
+TRACE_FB_MARK = 12
+TRACE_FB_FREE = 13
+
+TID_CSI, TID_VM, TID_FB, TID_USB, TID_THREAD = 1, 2, 3, 4, 5
+TIDS = {TID_CSI: 'csi', TID_VM: 'vm', TID_FB: 'fb_alloc', TID_USB: 'usb', TID_THREAD: 'threads'}
+
+
+def command(port, cmd, length, payload=b''):
+    port.write(struct.pack('<BBI', 0x30, cmd, length) + payload)
+    return port.read(length) if cmd & 0x80 else b''
+
+
+def record(port, seconds):
+    command(port, USBDBG_TRACE_CTRL, 0, struct.pack('<h', 1))
+    data = []
+    hz = lost = 0
+    end = time.time() + seconds
+    try:
+        while time.time() < end:
+            n, hz, lost = struct.unpack('<III', command(port, USBDBG_TRACE_LEN, 12))
+            if n:
+                data.append(command(port, USBDBG_TRACE_BUF, n))
+            else:
+                time.sleep(0.01)
+    except KeyboardInterrupt:
+        pass
+    command(port, USBDBG_TRACE_CTRL, 0, struct.pack('<h', 0))
+    return b''.join(data), hz, lost
+
+
+def to_chrome(data, hz):
+    events = [{'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': tid, 'args': {'name': name}}
+              for tid, name in TIDS.items()]
+    base = last = None
+    wraps = 0
+    thread = None
+
+    def ev(name, ph, ts, tid, **args):
+        e = {'name': name, 'ph': ph, 'ts': ts, 'pid': 0, 'tid': tid}
+        if ph == 'i':
+            e['s'] = 't'
+        if args:
+            e['args'] = args
+        events.append(e)
+
+    for off in range(0, len(data) - 7, 8):
+        cycles, word = struct.unpack_from('<II', data, off)
+        event, arg = word >> 24, word & 0xFFFFFF
+        if event == TRACE_NONE:
+            continue
+        if last is not None and cycles < last:
+            wraps += 1
+        last = cycles
+        cycles += wraps << 32
+        if base is None:
+            base = cycles
+        ts = (cycles - base) * 1e6 / hz
+
+        if event == TRACE_LOST:
+            ev('lost %d records' % arg, 'i', ts, TID_VM)
+        elif event == TRACE_CSI_SOF:
+            ev('frame', 'B', ts, TID_CSI, seq=arg)
+        elif event == TRACE_CSI_FRAG:
+            ev('frag', 'i', ts, TID_CSI, n=arg)
+        elif event == TRACE_CSI_EOF:
+            ev('frame', 'E', ts, TID_CSI)
+        elif event == TRACE_CSI_FRAG_LOST:
+            ev('frag lost', 'i', ts, TID_CSI, n=arg)
+            ev('frame', 'E', ts, TID_CSI)
+        elif event == TRACE_USB_IRQ:
+            ev('usb irq off', 'E' if arg else 'B', ts, TID_USB)
+        elif event == TRACE_GC_BEGIN:
+            ev('gc', 'B', ts, TID_VM)
+        elif event == TRACE_GC_END:
+            ev('gc', 'E', ts, TID_VM)
+        elif event == TRACE_SCHED_BEGIN:
+            ev('sched', 'B', ts, TID_VM)
+        elif event == TRACE_SCHED_END:
+            ev('sched', 'E', ts, TID_VM)
+        elif event == TRACE_THREAD:
+            if thread is not None:
+                ev(thread, 'E', ts, TID_THREAD)
+            thread = 'thread %06x' % arg
+            ev(thread, 'B', ts, TID_THREAD)
+        elif event == TRACE_FB_MARK:
+            ev('mark', 'B', ts, TID_FB, marks=arg)
+        elif event == TRACE_FB_FREE:
+            ev('mark', 'E', ts, TID_FB)
+    return {'traceEvents': events, 'displayTimeUnit': 'ms'}
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Record the OpenMV event trace as a Chrome trace')
+    ap.add_argument('port', help='serial port of the board')
+    ap.add_argument('-t', type=float, default=5, help='seconds to record, Ctrl-C stops early')
+    ap.add_argument('-o', default='trace.json', help='output file, default %(default)s')
+    args = ap.parse_args()
+
+    port = serial.Serial(args.port, IDE_BAUDRATE, timeout=1)
+    data, hz, lost = record(port, args.t)
+    port.close()
+    if not hz:
+        sys.exit('no answer from the board')
+
+    with open(args.o, 'w') as f:
+        json.dump(to_chrome(data, hz), f)
+    print('%d records, %d lost, written to %s' % (len(data) // 8, lost, args.o))
+
+
+if __name__ == '__main__':
+    main()
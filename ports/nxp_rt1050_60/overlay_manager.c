@@ -1,4 +1,16 @@
+/*
+ * Overlays: code and tables linked to run from TCM but stored in flash, copied in when needed.
+ *
+ * An overlay is made of parts, each with a load and a run region. The parts remember whether
+ * they are still in their run region, copying one in only drops the parts whose run regions
+ * it overlaps, so going back and forth between overlays the linker put apart copies nothing,
+ * and between overlapping ones only what was overwritten. Larger parts are copied by eDMA,
+ * which OverlayPrefetch() can also start ahead of time.
+ */
+#include <string.h>
 #include "overlay_manager.h"
+#include "fsl_device_registers.h"
+#include "dma.h"
 
 #ifdef __CC_ARM
 
@@ -24,36 +36,209 @@ extern uint32_t Load$$OVERLAY_CODE_BLOB$$Base;
 extern uint32_t Load$$OVERLAY_CODE_BLOB$$Length;
 extern uint32_t Image$$OVERLAY_CODE_BLOB$$Base;
 
-#define OVERLAY_CASE(n) \
-	case OVLY_##n: \
-		pSrc = (const uint32_t*) &Load$$OVERLAY_##n##$$Base; \
-		pDst = (uint32_t*) &Image$$OVERLAY_##n##$$Base; \
-		cb = (uint32_t) &Load$$OVERLAY_##n##$$Length; \
-		break; \
+#define OVERLAY_PART(n) \
+	OvlyPartSet(&s_parts[PART_##n], &Load$$OVERLAY_##n##$$Base, \
+		(uint32_t) &Load$$OVERLAY_##n##$$Length, &Image$$OVERLAY_##n##$$Base)
 
 #else
-extern uint32_t _overlay_dtcm_base;	// 0x20002000
-extern uint32_t _overlay_itcm_base;	// 0x6000
-
-#define OVERLAY_CASE(n) \
-	case OVLY_##n: \
-		pSrc = (const uint32_t*) &__load_start_OVERLAY_##n;\
-		cb = (uint32_t)&__load_stop_OVERLAY_##n - (uint32_t)&__load_start_OVERLAY_##n; \
-		break; \
-
-extern uint32_t __load_start_OVERLAY_LAB_TAB;
-extern uint32_t __load_stop_OVERLAY_LAB_TAB;
-extern uint32_t __load_start_OVERLAY_HAAR;
-extern uint32_t __load_stop_OVERLAY_HAAR;
-extern uint32_t __load_start_OVERLAY_FLASHPGM;
-extern uint32_t __load_stop_OVERLAY_FLASHPGM;
-extern uint32_t __load_start_OVERLAY_CODE_JPEG;
-extern uint32_t __load_stop_OVERLAY_CODE_JPEG;
-extern uint32_t __load_start_OVERLAY_CODE_BLOB;
-extern uint32_t __load_stop_OVERLAY_CODE_BLOB;
+// Only MIMXRT1052_omv_overlay.ld links overlays, with other layouts the symbols are 0 and
+// the parts stay empty.
+#define OVERLAY_SYMS(n) \
+	extern uint32_t __load_start_OVERLAY_##n __attribute__((weak)); \
+	extern uint32_t __load_stop_OVERLAY_##n __attribute__((weak)); \
+	extern uint32_t __run_start_OVERLAY_##n __attribute__((weak));
+
+#define OVERLAY_PART(n) \
+	OvlyPartSet(&s_parts[PART_##n], &__load_start_OVERLAY_##n, \
+		(uint32_t) &__load_stop_OVERLAY_##n - (uint32_t) &__load_start_OVERLAY_##n, &__run_start_OVERLAY_##n)
+
+OVERLAY_SYMS(LAB_TAB)
+OVERLAY_SYMS(HAAR)
+OVERLAY_SYMS(FLASHPGM)
+OVERLAY_SYMS(CODE_BLOB)
 #endif
 
+enum {
+	PART_LAB_TAB,
+	PART_CODE_BLOB,
+	PART_HAAR,
+	PART_FLASHPGM,
+	PART_COUNT,
+	PART_NONE = 0xFF,
+};
+
+typedef struct _ovly_part_t {
+	const uint32_t *pSrc;
+	uint32_t *pDst;
+	uint32_t cb;
+	uint8_t isResident;
+} ovly_part_t;
+
+// The parts of each overlay, bit n for PART_n.
+static const uint8_t s_ovlyParts[OVLY_COUNT] = {
+	[OVLY_LAB_TAB] = 1 << PART_LAB_TAB | 1 << PART_CODE_BLOB,
+	[OVLY_HAAR] = 1 << PART_HAAR,
+	[OVLY_FLASHPGM] = 1 << PART_FLASHPGM,
+};
+
+static ovly_part_t s_parts[PART_COUNT];
+static ovly_stats_t s_stats[OVLY_COUNT];
+static uint8_t s_isInit;
+static uint8_t s_dmaPart = PART_NONE;	// being copied in by DMA
 uint8_t s_curOvly;
+
+// below this a memcpy() is done before the channel is set up
+#define OVLY_DMA_MIN	2048
+#define OVLY_DMA_CH		DMA_CH_OVERLAY
+
+static void OvlyPartSet(ovly_part_t *p, const void *pSrc, uint32_t cb, void *pDst) {
+	p->pSrc = pSrc;
+	p->pDst = pDst;
+	p->cb = pSrc ? cb : 0;
+}
+
+static void OvlyInit(void) {
+	#if !defined(OMV_SENSOR_ONLY) && !defined(OMV_MPY_ONLY)
+	OVERLAY_PART(LAB_TAB);
+	OVERLAY_PART(HAAR);
+	#endif
+	#if defined(XIP_EXTERNAL_FLASH) && defined(EVK1050_60_HYPER)
+	OVERLAY_PART(FLASHPGM);
+	#endif
+	OVERLAY_PART(CODE_BLOB);
+	s_isInit = 1;
+}
+
+static uint32_t OvlyPartsOverlapping(const ovly_part_t *p) {
+	uint32_t bm = 0;
+	for (uint32_t i = 0; i < PART_COUNT; i++) {
+		const ovly_part_t *q = &s_parts[i];
+		if (q->cb && (uint32_t) q->pDst < (uint32_t) p->pDst + p->cb &&
+			(uint32_t) p->pDst < (uint32_t) q->pDst + q->cb) {
+			bm |= 1 << i;
+		}
+	}
+	return bm;
+}
+
+// The part is about to be overwritten, and so is whatever shares its run region.
+static void OvlyEvict(const ovly_part_t *p) {
+	uint32_t bm = OvlyPartsOverlapping(p);
+	for (uint32_t i = 0; i < PART_COUNT; i++) {
+		if (bm & (1 << i))
+			s_parts[i].isResident = 0;
+	}
+}
+
+static bool OvlyDmaStart(uint32_t partNdx) {
+	ovly_part_t *p = &s_parts[partNdx];
+	// 32 bytes a request when it can, the major loop count is 15 bits
+	uint32_t bytesEach = (p->cb & 31) ? 4 : 32;
+	if (((uint32_t) p->pSrc | (uint32_t) p->pDst | p->cb) & 3 || p->cb / bytesEach > 0x7FFF)
+		return false;
+	edma_transfer_config_t cfg;
+	dma_edma_init();
+	EDMA_ResetChannel(DMA0, OVLY_DMA_CH);
+	EDMA_PrepareTransfer(&cfg, (void *) p->pSrc, 4, p->pDst, 4, bytesEach, p->cb, kEDMA_MemoryToMemory);
+	EDMA_SetTransferConfig(DMA0, OVLY_DMA_CH, &cfg, NULL);
+	OvlyEvict(p);
+	dma_begin_read(p->pDst, p->cb);
+	s_dmaPart = partNdx;
+	EDMA_TriggerChannelStart(DMA0, OVLY_DMA_CH);
+	return true;
+}
+
+static void OvlyDmaWait(void) {
+	if (s_dmaPart == PART_NONE)
+		return;
+	ovly_part_t *p = &s_parts[s_dmaPart];
+	while (!(EDMA_GetChannelStatusFlags(DMA0, OVLY_DMA_CH) & kEDMA_DoneFlag)) {
+	}
+	EDMA_ClearChannelStatusFlags(DMA0, OVLY_DMA_CH, kEDMA_DoneFlag);
+	dma_end_read(p->pDst, p->cb);
+	// parts can be code
+	__DSB();
+	__ISB();
+	p->isResident = 1;
+	s_dmaPart = PART_NONE;
+}
+
+static void OvlyCopy(uint32_t partNdx) {
+	ovly_part_t *p = &s_parts[partNdx];
+	if (p->cb >= OVLY_DMA_MIN && OvlyDmaStart(partNdx)) {
+		OvlyDmaWait();
+		return;
+	}
+	OvlyEvict(p);
+	memcpy(p->pDst, p->pSrc, p->cb);
+	__DSB();
+	__ISB();
+	p->isResident = 1;
+}
+
+int OverlaySwitch(uint8_t ovlyNdx) {
+	if (ovlyNdx >= OVLY_COUNT)
+		return -1L;
+	int prev = s_curOvly;
+	if (!s_isInit)
+		OvlyInit();
+	ovly_stats_t *st = &s_stats[ovlyNdx];
+	st->calls++;
+	uint32_t t0 = DWT->CYCCNT, bytes = 0;
+	// a prefetch may be filling the very part needed, or one that evicts it
+	OvlyDmaWait();
+	for (uint32_t i = 0; i < PART_COUNT; i++) {
+		ovly_part_t *p = &s_parts[i];
+		if ((s_ovlyParts[ovlyNdx] & (1 << i)) && p->cb && !p->isResident) {
+			OvlyCopy(i);
+			bytes += p->cb;
+		}
+	}
+	if (bytes) {
+		st->loads++;
+		st->bytes += bytes;
+	}
+	st->cycles += DWT->CYCCNT - t0;
+	s_curOvly = ovlyNdx;
+	return prev;
+}
+
+void OverlayPrefetch(uint8_t ovlyNdx) {
+	// nothing may read the flash while it is being programmed
+	if (ovlyNdx >= OVLY_COUNT || s_curOvly == OVLY_FLASHPGM || s_dmaPart != PART_NONE)
+		return;
+	if (!s_isInit)
+		OvlyInit();
+	uint32_t inUse = 0;
+	for (uint32_t i = 0; i < PART_COUNT; i++) {
+		if (s_ovlyParts[s_curOvly] & (1 << i))
+			inUse |= 1 << i;
+	}
+	for (uint32_t i = 0; i < PART_COUNT; i++) {
+		ovly_part_t *p = &s_parts[i];
+		if (!(s_ovlyParts[ovlyNdx] & (1 << i)) || !p->cb || p->isResident || p->cb < OVLY_DMA_MIN)
+			continue;
+		if (OvlyPartsOverlapping(p) & inUse & ~(1 << i))
+			continue;
+		if (OvlyDmaStart(i)) {
+			s_stats[ovlyNdx].prefetches++;
+			s_stats[ovlyNdx].bytes += p->cb;
+		}
+		return;
+	}
+}
+
+void OverlayGetStats(uint8_t ovlyNdx, ovly_stats_t *pStats) {
+	if (ovlyNdx < OVLY_COUNT)
+		*pStats = s_stats[ovlyNdx];
+	else
+		memset(pStats, 0, sizeof(*pStats));
+}
+
+void OverlayResetStats(void) {
+	memset(s_stats, 0, sizeof(s_stats));
+}
+
 #ifdef __CC_ARM
 __asm void OverlayMemCpy(void *pvDst, const void*pvSrc, uint32_t cb) {
 
@@ -91,86 +276,8 @@ __asm void OverlayMemCpy(void *pvDst, const void*pvSrc, uint32_t cb) {
 	pop		{r4-r10, pc}
 	
 }
-#if 0
-int OverlaySwitch(uint8_t ovlyNdx) {return 0;}
-#else
-int OverlaySwitch(uint8_t ovlyNdx) {
-	if (s_curOvly == ovlyNdx)
-		return ovlyNdx;
-	uint8_t ovlyNdxBkup = ovlyNdx;
-	const uint32_t *pSrc;
-	uint32_t *pDst;
-	uint32_t cb;
-	
-	switch (ovlyNdx) {
-		#if !defined(OMV_SENSOR_ONLY) && !defined(OMV_MPY_ONLY)		
-		OVERLAY_CASE(LAB_TAB)
-		OVERLAY_CASE(HAAR)
-		#endif
-		#if defined(XIP_EXTERNAL_FLASH) && defined(EVK1050_60_HYPER) 
-		OVERLAY_CASE(FLASHPGM)
-		#endif
-	default:
-		return -1L;
-	}
-
-	if (cb != 0) {
-		memcpy(pDst, pSrc, cb);
-	}
-	// >>> copy code
-	switch (ovlyNdx) {
-		OVERLAY_CASE(CODE_BLOB)
-	default:
-		return -1L;
-	}
-	if (cb != 0)
-		memcpy(pDst, pSrc, cb);	
-	// <<<
-Cleanup:	
-	return ovlyNdxBkup;
-}
 #endif
-#else
-int OverlaySwitch(uint8_t ovlyNdx) {return 0;}
 
-#if 0
-int OverlaySwitch(uint8_t ovlyNdx) {
-	if (s_curOvly == ovlyNdx)
-		return ovlyNdx;
-	uint8_t ovlyNdxBkup = ovlyNdx;
-	const uint32_t *pSrc;
-	uint32_t *pDst;
-	uint32_t cb;
-	
-	switch (ovlyNdx) {
-		OVERLAY_CASE(LAB_TAB)
-		OVERLAY_CASE(HAAR)
-		#if defined(XIP_EXTERNAL_FLASH) && defined(EVK1050_60_HYPER) 
-		OVERLAY_CASE(FLASHPGM)
-		#endif
-	default:
-		return -1L;
-	}
-	pDst = &_overlay_dtcm_base;
-	s_curOvly = ovlyNdx;
-	memcpy(pDst, pSrc, cb);		
-	// >>> copy code
-	switch (ovlyNdx) {
-		OVERLAY_CASE(CODE_JPEG)
-		OVERLAY_CASE(CODE_BLOB)
-	default:
-		return -1L;
-	}
-	
-	pDst = &_overlay_dtcm_base;
-	memcpy(pDst, pSrc, cb);	
-	// <<<
-	
-	return ovlyNdxBkup;
-}
-#endif
-#endif
 int OverlaySetToDefault(void) {
 	return OverlaySwitch(OVLY_LAB_TAB);
 }
-
@@ -11,7 +11,25 @@
 
 #define OVLY_FLASHPGM	3
 
+#define OVLY_COUNT		4
+
+typedef struct _ovly_stats_t {
+	uint32_t calls;		// OverlaySwitch() to it
+	uint32_t loads;		// calls that had to copy some of it in
+	uint32_t prefetches;	// copies OverlayPrefetch() started
+	uint32_t bytes;		// bytes copied in
+	uint32_t cycles;	// core cycles OverlaySwitch() spent copying or waiting for a prefetch
+} ovly_stats_t;
+
+// Makes an overlay the current one and returns the one before, so it can be restored.
+// Parts of the overlay still in their run region since they were last loaded are not copied
+// again, overlays the linker put apart all stay resident. -1 for an unknown overlay.
 extern int OverlaySwitch(uint8_t ovlyNdx);
 extern int OverlaySetToDefault(void);
+// Hint that ovlyNdx is needed soon: starts copying one of its parts in by DMA, if that does
+// not overwrite the current overlay. OverlaySwitch() waits for it.
+extern void OverlayPrefetch(uint8_t ovlyNdx);
+extern void OverlayGetStats(uint8_t ovlyNdx, ovly_stats_t *pStats);
+extern void OverlayResetStats(void);
 
 #endif
@@ -161,7 +161,7 @@ __asm void NativeNLR(void) {
 		//mov	r2,	#0x01000000
 		//str r2, [r1, #28]
 		
-#if MICROPY_PY_THREAD
+#if MICROPY_PY_PYBTHREAD
         ldr r0, =pendsv_object
         ldr r0, [r0]
         cmp r0, 0
@@ -210,7 +210,7 @@ no_obj                    // pendsv_object==NULL
 		mov	r2,	#0x01000000
 		str r2, [sp, #28]    // reset XPSR, as pendSV may interrupt LDM/STM instructions who saves progress to XPSR
 
-#if MICROPY_PY_THREAD
+#if MICROPY_PY_PYBTHREAD
         ldr r0, =pendsv_object
         ldr r0, [r0]
         cmp r0, 0
@@ -293,7 +293,7 @@ __attribute__((naked)) void NativeNLR(void) {
     //   sp[1]: 0xfffffff9
     //   sp[0]: ?
 
-#if MICROPY_PY_THREAD
+#if MICROPY_PY_PYBTHREAD
     __asm volatile (
 		"mov r2,	#0x01000000 \n"
 		"str r2, [sp, #28]      \n"    // modify stacked XPSR to make sure possible LDM/STM progress is cleared
@@ -0,0 +1,302 @@
+/*
+ * Memory and bus clock profiles.
+ *
+ * The profile is worked out as the register values it needs first and only then written, from
+ * ITCM with interrupts off: the code and vectors live in the SDRAM that is being retimed and
+ * the flash that may be reclocked. The SDRAM is idled and precharged, the SEMC divider changed,
+ * the new timings and mode register written and then the FlexSPI is reclocked the way
+ * flash_hyper.c does it. The SDRAM keeps its content, it misses a few us of refresh at most.
+ *
+ * A profile moving the SEMC clock gets SDRAM timings worked out from the part's ns figures,
+ * as SEMC_ConfigureSDRAM() does. Refresh uses the prescaler period and 85% margin the boot DCD
+ * uses.
+ *
+ */
+#include <string.h>
+#include "py/mphal.h"
+#include "fsl_device_registers.h"
+#include "fsl_cache.h"
+#include "fb_alloc.h"
+#include "perf_profile.h"
+
+#ifdef __CC_ARM
+#define RAM_CODE __attribute__((section(".ram_code")))
+#else
+#define RAM_CODE __attribute__((section("RamFunction")))
+#endif
+
+#define PERF_SDRAM_BASE         (0x80000000)
+#define PERF_FLASH_BASE         (0x60000000)
+#define PERF_FLASH_TEST_SIZE    (64 * 1024)
+#define PERF_SDRAM_TEST_SIZE    (256 * 1024)
+
+// SEMC IP commands, SEMC_SendIPCommand() sends them as 0xA55A000x.
+#define PERF_SEMC_CMD_MODESET   (0xA)
+#define PERF_SEMC_CMD_AUTOREF   (0xC)
+#define PERF_SEMC_CMD_PREALL    (0xF)
+
+// The 32MB 16 bit SDRAM of both boards, -6 speed grade, ns.
+#define SDRAM_T_RP      (18)
+#define SDRAM_T_RCD     (18)
+#define SDRAM_T_RFC     (67)
+#define SDRAM_T_WR      (12)
+#define SDRAM_T_CKEOFF  (42)
+#define SDRAM_T_RAS     (42)
+#define SDRAM_T_XSR     (67)
+#define SDRAM_T_RC      (60)
+#define SDRAM_T_RRD     (12)
+#define SDRAM_T_REFI    (7812) // 64ms / 8192 rows
+// Highest SEMC clock CL2 may be used at, MHz.
+#define SDRAM_CL2_MHZ   (100)
+
+typedef struct _perf_profile_t {
+    const char *name;
+    uint8_t semc_div;       // SEMC clock = PLL2 PFD2 / semc_div, 0 keeps all of the boot state
+    uint8_t refresh_burst;  // rows refreshed at a time
+    uint8_t flexspi_div;    // FlexSPI clock = PLL3 PFD0 / flexspi_div
+    uint8_t core_first;     // SEMC queue weights and a big AHB RX buffer for the core
+    uint8_t csi_div;        // CSI MCLK = 120MHz / csi_div, omvrt1 only
+} perf_profile_t;
+
+typedef struct _perf_regs_t {
+    uint32_t semc_podf;
+    uint32_t sdramcr[4];
+    uint32_t bmcr[2];
+    uint32_t mode;
+    uint32_t flexspi_podf;
+    uint32_t ahbcr;
+    uint32_t ahbrxbufcr[4];
+    uint32_t csi_podf;
+} perf_regs_t;
+
+STATIC const perf_profile_t perf_profiles[] = {
+    { "default", 0 },
+    // Same clocks, the SEMC favours page hits and runs of reads (the core's cache line fills,
+    // the CSI and LCD bursts), refreshes 8 rows at a time and the core's flash reads get 768
+    // of the 1KB of AHB RX buffers with prefetch.
+    { "turbo", 2, 8, 1, true, 6 },
+    // SEMC at PFD2 / 4 with CL2, flash at half its clock, CSI MCLK at 12MHz.
+    { "eco", 4, 4, 2, false, 10 },
+};
+
+uint8_t perf_flexspi_div;
+uint8_t perf_csi_div = 8 - 1;
+
+STATIC const perf_profile_t *perf_profile;
+STATIC perf_regs_t perf_boot_regs;
+
+STATIC void perf_regs_read(perf_regs_t *regs) {
+    regs->semc_podf = (CCM->CBCDR & CCM_CBCDR_SEMC_PODF_MASK) >> CCM_CBCDR_SEMC_PODF_SHIFT;
+    for (int i = 0; i < 4; i++) {
+        regs->sdramcr[i] = (&SEMC->SDRAMCR0)[i];
+        regs->ahbrxbufcr[i] = FLEXSPI->AHBRXBUFCR0[i];
+    }
+    regs->bmcr[0] = SEMC->BMCR0;
+    regs->bmcr[1] = SEMC->BMCR1;
+    // BL 8 and the CAS latency are all the DCD puts in the mode register.
+    regs->mode = 0x3 | (((regs->sdramcr[0] & SEMC_SDRAMCR0_CL_MASK) >> SEMC_SDRAMCR0_CL_SHIFT) << 4);
+    regs->flexspi_podf = (CCM->CSCMR1 & CCM_CSCMR1_FLEXSPI_PODF_MASK) >> CCM_CSCMR1_FLEXSPI_PODF_SHIFT;
+    regs->ahbcr = FLEXSPI->AHBCR;
+    regs->csi_podf = (CCM->CSCDR3 & CCM_CSCDR3_CSI_PODF_MASK) >> CCM_CSCDR3_CSI_PODF_SHIFT;
+}
+
+// Clocks of period 1000000 / mhz ps covering ns, as SEMC_ConvertTiming() does it.
+STATIC uint32_t perf_clocks(uint32_t ns, uint32_t mhz) {
+    uint32_t ps = 1000000 / mhz;
+    return ((ns * 1000) + ps - 1) / ps;
+}
+
+STATIC void perf_regs_make(perf_regs_t *regs, const perf_profile_t *p) {
+    *regs = perf_boot_regs;
+    if (p->semc_div == 0) {
+        return;
+    }
+
+    // PLL2 PFD2 = 528MHz * 18 / frac
+    uint32_t frac = (CCM_ANALOG->PFD_528 & CCM_ANALOG_PFD_528_PFD2_FRAC_MASK) >> CCM_ANALOG_PFD_528_PFD2_FRAC_SHIFT;
+    uint32_t mhz = ((528 * 18) / frac) / p->semc_div;
+    uint32_t cl = (mhz <= SDRAM_CL2_MHZ) ? 2 : 3;
+
+    // At the boot clock the DCD's timings stand, they are a clock tighter than the rounding here.
+    if (regs->semc_podf != (p->semc_div - 1)) {
+        regs->semc_podf = p->semc_div - 1;
+        regs->sdramcr[0] = (regs->sdramcr[0] & ~SEMC_SDRAMCR0_CL_MASK) | SEMC_SDRAMCR0_CL(cl);
+        regs->mode = 0x3 | (cl << 4);
+        regs->sdramcr[1] = SEMC_SDRAMCR1_PRE2ACT(perf_clocks(SDRAM_T_RP, mhz))
+                         | SEMC_SDRAMCR1_ACT2RW(perf_clocks(SDRAM_T_RCD, mhz))
+                         | SEMC_SDRAMCR1_RFRC(perf_clocks(SDRAM_T_RFC, mhz))
+                         | SEMC_SDRAMCR1_WRC(perf_clocks(SDRAM_T_WR, mhz))
+                         | SEMC_SDRAMCR1_CKEOFF(perf_clocks(SDRAM_T_CKEOFF, mhz))
+                         | SEMC_SDRAMCR1_ACT2PRE(perf_clocks(SDRAM_T_RAS, mhz));
+        regs->sdramcr[2] = (regs->sdramcr[2] & SEMC_SDRAMCR2_ITO_MASK)
+                         | SEMC_SDRAMCR2_SRRC(perf_clocks(SDRAM_T_XSR, mhz))
+                         | SEMC_SDRAMCR2_REF2REF(perf_clocks(SDRAM_T_RC, mhz))
+                         | SEMC_SDRAMCR2_ACT2ACT(perf_clocks(SDRAM_T_RRD, mhz));
+    }
+
+    // A prescaler period of just under 1us, the burst is refreshed at 85% of its rows' due time
+    // and goes urgent 2.5 periods of that later, the boot DCD's ratio.
+    uint32_t prescale = MAX(mhz / 16, 1);
+    uint32_t period_ns = (prescale * 16 * 1000) / mhz;
+    uint32_t rt = (p->refresh_burst * SDRAM_T_REFI * 85) / (100 * period_ns);
+    regs->sdramcr[3] = SEMC_SDRAMCR3_REN_MASK
+                     | SEMC_SDRAMCR3_REBL(p->refresh_burst - 1)
+                     | SEMC_SDRAMCR3_PRESCALE(prescale)
+                     | SEMC_SDRAMCR3_RT(rt)
+                     | SEMC_SDRAMCR3_UT(MIN((rt * 5) / 2, 255));
+
+    if (p->core_first) {
+        // Page hits ahead of age and read/write turnarounds, the SDRAM has no read prefetch.
+        regs->bmcr[0] = SEMC_BMCR0_WQOS(4) | SEMC_BMCR0_WAGE(2) | SEMC_BMCR0_WSH(8) | SEMC_BMCR0_WRWS(6);
+        regs->bmcr[1] = SEMC_BMCR1_WQOS(4) | SEMC_BMCR1_WAGE(2) | SEMC_BMCR1_WPH(8) | SEMC_BMCR1_WRWS(6) | SEMC_BMCR1_WBR(6);
+        // Buffer 0 for the core (master 0): 768 bytes, highest priority, the others share the rest.
+        regs->ahbrxbufcr[0] = FLEXSPI_AHBRXBUFCR0_PRIORITY(3) | FLEXSPI_AHBRXBUFCR0_MSTRID(0) | FLEXSPI_AHBRXBUFCR0_BUFSZ(768 / 8);
+        regs->ahbrxbufcr[1] = FLEXSPI_AHBRXBUFCR0_MSTRID(1) | FLEXSPI_AHBRXBUFCR0_BUFSZ(64 / 8);
+        regs->ahbrxbufcr[2] = FLEXSPI_AHBRXBUFCR0_MSTRID(2) | FLEXSPI_AHBRXBUFCR0_BUFSZ(64 / 8);
+        regs->ahbrxbufcr[3] = FLEXSPI_AHBRXBUFCR0_MSTRID(3) | FLEXSPI_AHBRXBUFCR0_BUFSZ(128 / 8);
+        regs->ahbcr |= FLEXSPI_AHBCR_PREFETCHEN_MASK | FLEXSPI_AHBCR_BUFFERABLEEN_MASK
+                     | FLEXSPI_AHBCR_CACHABLEEN_MASK | FLEXSPI_AHBCR_READADDROPT_MASK;
+    }
+    regs->flexspi_podf = p->flexspi_div - 1;
+    #ifndef BOARD_RTEVK
+    // The EVK's CSI runs from the 24MHz XTAL and keeps it.
+    regs->csi_podf = p->csi_div - 1;
+    #endif
+}
+
+RAM_CODE STATIC void perf_semc_ipcmd(uint32_t cmd, uint32_t data) {
+    SEMC->IPCR0 = PERF_SDRAM_BASE;
+    SEMC->IPTXDAT = data;
+    SEMC->IPCMD = SEMC_IPCMD_KEY(0xA55A) | cmd;
+    while (!(SEMC->INTR & (SEMC_INTR_IPCMDDONE_MASK | SEMC_INTR_IPCMDERR_MASK))) {
+    }
+    SEMC->INTR = SEMC_INTR_IPCMDDONE_MASK | SEMC_INTR_IPCMDERR_MASK;
+}
+
+// Nothing in here may touch the SDRAM or the flash, the stack is in DTCM.
+RAM_CODE STATIC void perf_regs_write(const perf_regs_t *regs) {
+    __DSB();
+    __ISB();
+
+    while (!(SEMC->STS0 & SEMC_STS0_IDLE_MASK)) {
+    }
+    SEMC->IPCR1 = SEMC_IPCR1_DATSZ(2);
+    SEMC->IPCR2 = 0;
+    perf_semc_ipcmd(PERF_SEMC_CMD_PREALL, 0);
+
+    CCM->CBCDR = (CCM->CBCDR & ~CCM_CBCDR_SEMC_PODF_MASK) | CCM_CBCDR_SEMC_PODF(regs->semc_podf);
+    while (CCM->CDHIPR & CCM_CDHIPR_SEMC_PODF_BUSY_MASK) {
+    }
+
+    SEMC->SDRAMCR0 = regs->sdramcr[0];
+    SEMC->SDRAMCR1 = regs->sdramcr[1];
+    SEMC->SDRAMCR2 = regs->sdramcr[2];
+    SEMC->SDRAMCR3 = regs->sdramcr[3];
+    SEMC->BMCR0 = regs->bmcr[0];
+    SEMC->BMCR1 = regs->bmcr[1];
+    perf_semc_ipcmd(PERF_SEMC_CMD_AUTOREF, 0);
+    perf_semc_ipcmd(PERF_SEMC_CMD_AUTOREF, 0);
+    perf_semc_ipcmd(PERF_SEMC_CMD_MODESET, regs->mode);
+
+    // SetFlexSPIDiv() of flash_hyper.c, with the AHB buffers set while it is stopped.
+    while ((FLEXSPI->STS0 & (FLEXSPI_STS0_ARBIDLE_MASK | FLEXSPI_STS0_SEQIDLE_MASK))
+        != (FLEXSPI_STS0_ARBIDLE_MASK | FLEXSPI_STS0_SEQIDLE_MASK)) {
+    }
+    FLEXSPI->MCR0 |= FLEXSPI_MCR0_MDIS_MASK;
+    CCM->CCGR6 &= ~CCM_CCGR6_CG5_MASK;
+    CCM->CSCMR1 = (CCM->CSCMR1 & ~CCM_CSCMR1_FLEXSPI_PODF_MASK) | CCM_CSCMR1_FLEXSPI_PODF(regs->flexspi_podf);
+    CCM->CCGR6 |= CCM_CCGR6_CG5_MASK;
+    FLEXSPI->AHBCR = regs->ahbcr;
+    for (int i = 0; i < 4; i++) {
+        FLEXSPI->AHBRXBUFCR0[i] = regs->ahbrxbufcr[i];
+    }
+    FLEXSPI->MCR0 &= ~FLEXSPI_MCR0_MDIS_MASK;
+    FLEXSPI->MCR0 |= FLEXSPI_MCR0_SWRESET_MASK;
+    while (FLEXSPI->MCR0 & FLEXSPI_MCR0_SWRESET_MASK) {
+    }
+
+    CCM->CSCDR3 = (CCM->CSCDR3 & ~CCM_CSCDR3_CSI_PODF_MASK) | CCM_CSCDR3_CSI_PODF(regs->csi_podf);
+
+    __DSB();
+    __ISB();
+}
+
+STATIC void perf_regs_apply(const perf_regs_t *regs) {
+    SCB_CleanDCache();
+    mp_uint_t irq_state = disable_irq();
+    perf_regs_write(regs);
+    enable_irq(irq_state);
+    // Flash lines fetched through the old AHB buffers.
+    DCACHE_InvalidateByRange(PERF_FLASH_BASE, PERF_FLASH_TEST_SIZE);
+    perf_flexspi_div = regs->flexspi_podf;
+    perf_csi_div = regs->csi_podf;
+}
+
+STATIC uint32_t perf_flash_sum(void) {
+    const uint32_t *p = (const uint32_t *) PERF_FLASH_BASE;
+    uint32_t sum = 0;
+    DCACHE_InvalidateByRange(PERF_FLASH_BASE, PERF_FLASH_TEST_SIZE);
+    for (int i = 0; i < (PERF_FLASH_TEST_SIZE / 4); i++) {
+        sum = ((sum << 5) | (sum >> 27)) ^ p[i];
+    }
+    return sum;
+}
+
+// Address in address, its inverse and both checkerboards, each pass pushed out of the cache
+// and read back from the SDRAM.
+STATIC bool perf_sdram_test(uint32_t *buf, uint32_t words) {
+    for (int pass = 0; pass < 4; pass++) {
+        for (uint32_t i = 0; i < words; i++) {
+            uint32_t v = (pass < 2) ? ((uint32_t) (buf + i)) : ((i & 1) ? 0xAAAAAAAA : 0x55555555);
+            buf[i] = (pass & 1) ? ~v : v;
+        }
+        DCACHE_CleanInvalidateByRange((uint32_t) buf, words * 4);
+        for (uint32_t i = 0; i < words; i++) {
+            uint32_t v = (pass < 2) ? ((uint32_t) (buf + i)) : ((i & 1) ? 0xAAAAAAAA : 0x55555555);
+            if (buf[i] != ((pass & 1) ? ~v : v)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const char *perf_profile_get(void) {
+    return (perf_profile == NULL) ? perf_profiles[0].name : perf_profile->name;
+}
+
+int perf_profile_set(const char *name) {
+    const perf_profile_t *p = NULL;
+    for (int i = 0; i < MP_ARRAY_SIZE(perf_profiles); i++) {
+        if (strcmp(name, perf_profiles[i].name) == 0) {
+            p = &perf_profiles[i];
+        }
+    }
+    if (p == NULL) {
+        return -1;
+    }
+
+    if (perf_profile == NULL) {
+        perf_regs_read(&perf_boot_regs);
+        perf_profile = &perf_profiles[0];
+    }
+
+    perf_regs_t regs, prev;
+    perf_regs_make(&prev, perf_profile);
+    perf_regs_make(&regs, p);
+
+    uint32_t words = MIN(fb_avail(), PERF_SDRAM_TEST_SIZE) / 4;
+    uint32_t *buf = fb_alloc(words * 4, FB_ALLOC_PREFER_SIZE);
+    uint32_t sum = perf_flash_sum();
+
+    perf_regs_apply(&regs);
+    bool ok = perf_sdram_test(buf, words) && (perf_flash_sum() == sum);
+    if (ok) {
+        perf_profile = p;
+    } else {
+        perf_regs_apply(&prev);
+    }
+
+    fb_free(); // buf
+    return ok ? 0 : -2;
+}
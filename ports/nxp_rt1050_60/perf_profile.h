@@ -0,0 +1,26 @@
+/*
+ * Memory and bus clock profiles.
+ *
+ * A profile sets the SEMC SDRAM clock and timings, the FlexSPI clock and AHB read buffers
+ * and the CSI master clock together. "default" is what the boot DCD and flexspi_nor_init()
+ * left, "turbo" tunes the SDRAM and flash for the core's reads at the same clocks and "eco"
+ * halves the SDRAM, flash and sensor clocks.
+ *
+ */
+#ifndef __PERF_PROFILE_H__
+#define __PERF_PROFILE_H__
+#include <stdint.h>
+
+// The FlexSPI clock divider (CCM_CSCMR1 FLEXSPI_PODF) reads are done at, flash_hyper.c
+// goes back to it after programming.
+extern uint8_t perf_flexspi_div;
+// The CSI master clock divider (CCM_CSCDR3 CSI_PODF) sensor_reset() sets, 480MHz / 4 / (div + 1).
+extern uint8_t perf_csi_div;
+
+// Name of the profile in use.
+const char *perf_profile_get(void);
+// Switches to the named profile and checks SDRAM and flash reads with it, on a failed check
+// the previous profile is put back. Returns 0, -1 for an unknown name or -2 if the check failed.
+int perf_profile_set(const char *name);
+
+#endif // __PERF_PROFILE_H__
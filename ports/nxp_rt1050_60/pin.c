@@ -485,6 +485,63 @@ STATIC mp_obj_t pin_af(mp_obj_t self_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(pin_af_obj, pin_af);
 
+STATIC const mp_obj_type_t pin_fast_type;
+
+typedef struct _pin_fast_obj_t {
+    mp_obj_base_t base;
+    const pin_obj_t *pin;
+    volatile uint32_t *dr;
+    volatile uint32_t *psr;
+    uint32_t mask;
+} pin_fast_obj_t;
+
+/// \method fast()
+/// Returns a PinFast of the pin: value(), on(), off() and toggle() straight on
+/// the cached GPIO registers. Configure the pin with init() first.
+STATIC mp_obj_t pin_fast(mp_obj_t self_in) {
+    const pin_obj_t *self = self_in;
+    pin_fast_obj_t *o = m_new_obj(pin_fast_obj_t);
+    o->base.type = &pin_fast_type;
+    o->pin = self;
+    o->dr = &self->gpio->DR;
+    o->psr = (volatile uint32_t *)&self->gpio->PSR;
+    o->mask = self->pin_mask;
+    return o;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pin_fast_obj, pin_fast);
+
+STATIC GPIO_Type *pin_port_gpio(mp_obj_t port_in) {
+    STATIC GPIO_Type *const gpios[] = { GPIO1, GPIO2, GPIO3, GPIO4, GPIO5 };
+    mp_int_t port = mp_obj_get_int(port_in);
+    if (port < 1 || port > MP_ARRAY_SIZE(gpios)) {
+        mp_raise_ValueError("invalid port");
+    }
+    return gpios[port - 1];
+}
+
+/// \classmethod read_port(port)
+/// Returns the levels of all 32 pins of GPIO port (1 to 5, see port()).
+STATIC mp_obj_t pin_read_port(mp_obj_t cls_in, mp_obj_t port_in) {
+    return mp_obj_new_int_from_uint(pin_port_gpio(port_in)->PSR);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pin_read_port_fun_obj, pin_read_port);
+STATIC MP_DEFINE_CONST_CLASSMETHOD_OBJ(pin_read_port_obj, (mp_obj_t)&pin_read_port_fun_obj);
+
+/// \classmethod write_port(port, mask, value)
+/// Sets the output pins of GPIO port in mask to their bits of value, all at once.
+STATIC mp_obj_t pin_write_port(size_t n_args, const mp_obj_t *args) {
+    GPIO_Type *gpio = pin_port_gpio(args[1]);
+    uint32_t mask = mp_obj_get_int_truncated(args[2]);
+    uint32_t value = mp_obj_get_int_truncated(args[3]) & mask;
+    // An interrupt changing other pins of the port must not be undone.
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    gpio->DR = (gpio->DR & ~mask) | value;
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pin_write_port_fun_obj, 4, 4, pin_write_port);
+STATIC MP_DEFINE_CONST_CLASSMETHOD_OBJ(pin_write_port_obj, (mp_obj_t)&pin_write_port_fun_obj);
+
 STATIC const mp_rom_map_elem_t pin_locals_dict_table[] = {
     // instance methods
     { MP_ROM_QSTR(MP_QSTR_init),    MP_ROM_PTR(&pin_init_obj) },
@@ -505,11 +562,14 @@ STATIC const mp_rom_map_elem_t pin_locals_dict_table[] = {
 	{ MP_ROM_QSTR(MP_QSTR_mode),    MP_ROM_PTR(&pin_mode_obj) },
     { MP_ROM_QSTR(MP_QSTR_pull),    MP_ROM_PTR(&pin_pull_obj) },
     { MP_ROM_QSTR(MP_QSTR_af),      MP_ROM_PTR(&pin_af_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fast),    MP_ROM_PTR(&pin_fast_obj) },
 
     // class methods
     { MP_ROM_QSTR(MP_QSTR_mapper),  MP_ROM_PTR(&pin_mapper_obj) },
     { MP_ROM_QSTR(MP_QSTR_dict),    MP_ROM_PTR(&pin_map_dict_obj) },
     { MP_ROM_QSTR(MP_QSTR_debug),   MP_ROM_PTR(&pin_debug_obj) },
+    { MP_ROM_QSTR(MP_QSTR_read_port),  MP_ROM_PTR(&pin_read_port_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write_port), MP_ROM_PTR(&pin_write_port_obj) },
 
     // class attributes
     { MP_ROM_QSTR(MP_QSTR_board),   MP_ROM_PTR(&pin_board_pins_obj_type) },
@@ -565,6 +625,118 @@ const mp_obj_type_t pin_type = {
     .locals_dict = (mp_obj_dict_t*)&pin_locals_dict,
 };
 
+/// \moduleref pyb
+/// \class PinFast - register level access to a GPIO
+///
+/// Made by Pin.fast(), it holds the addresses of the pin's data (DR) and pad status
+/// (PSR) registers and its bit, so a call is one load or read-modify-write of DR.
+/// The attributes addr, psr and mask are those for @viper code, which compiles
+/// accesses through ptr32 to single loads and stores:
+///
+///     p = pyb.Pin('D0', pyb.Pin.OUT).fast()
+///
+///     @micropython.viper
+///     def pulses(p, n: int):
+///         dr = ptr32(p.addr)
+///         m = int(p.mask)
+///         for i in range(n):
+///             dr[0] |= m
+///             dr[0] &= ~m
+///
+/// The read-modify-write is not atomic, an interrupt writing the same port in
+/// between is lost; Pin.write_port() is.
+
+STATIC void pin_fast_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    pin_fast_obj_t *self = self_in;
+    mp_printf(print, "PinFast(Pin.cpu.%q)", self->pin->name);
+}
+
+STATIC mp_obj_t pin_fast_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 0, 1, false);
+    pin_fast_obj_t *self = self_in;
+    if (n_args == 0) {
+        return MP_OBJ_NEW_SMALL_INT((*self->psr & self->mask) != 0);
+    }
+    if (mp_obj_is_true(args[0])) {
+        *self->dr |= self->mask;
+    } else {
+        *self->dr &= ~self->mask;
+    }
+    return mp_const_none;
+}
+
+STATIC mp_obj_t pin_fast_value(size_t n_args, const mp_obj_t *args) {
+    return pin_fast_call(args[0], n_args - 1, 0, args + 1);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pin_fast_value_obj, 1, 2, pin_fast_value);
+
+STATIC mp_obj_t pin_fast_on(mp_obj_t self_in) {
+    pin_fast_obj_t *self = self_in;
+    *self->dr |= self->mask;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pin_fast_on_obj, pin_fast_on);
+
+STATIC mp_obj_t pin_fast_off(mp_obj_t self_in) {
+    pin_fast_obj_t *self = self_in;
+    *self->dr &= ~self->mask;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pin_fast_off_obj, pin_fast_off);
+
+STATIC mp_obj_t pin_fast_toggle(mp_obj_t self_in) {
+    pin_fast_obj_t *self = self_in;
+    *self->dr ^= self->mask;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pin_fast_toggle_obj, pin_fast_toggle);
+
+STATIC const mp_rom_map_elem_t pin_fast_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_value),   MP_ROM_PTR(&pin_fast_value_obj) },
+    { MP_ROM_QSTR(MP_QSTR_on),      MP_ROM_PTR(&pin_fast_on_obj) },
+    { MP_ROM_QSTR(MP_QSTR_off),     MP_ROM_PTR(&pin_fast_off_obj) },
+    { MP_ROM_QSTR(MP_QSTR_high),    MP_ROM_PTR(&pin_fast_on_obj) },
+    { MP_ROM_QSTR(MP_QSTR_low),     MP_ROM_PTR(&pin_fast_off_obj) },
+    { MP_ROM_QSTR(MP_QSTR_toggle),  MP_ROM_PTR(&pin_fast_toggle_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(pin_fast_locals_dict, pin_fast_locals_dict_table);
+
+STATIC void pin_fast_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    pin_fast_obj_t *self = self_in;
+    if (dest[0] != MP_OBJ_NULL) {
+        // Read only.
+        return;
+    }
+    switch (attr) {
+        case MP_QSTR_addr:
+            dest[0] = mp_obj_new_int_from_uint((uintptr_t)self->dr);
+            break;
+        case MP_QSTR_psr:
+            dest[0] = mp_obj_new_int_from_uint((uintptr_t)self->psr);
+            break;
+        case MP_QSTR_mask:
+            dest[0] = mp_obj_new_int_from_uint(self->mask);
+            break;
+        default: {
+            // With .attr the methods aren't looked up in locals_dict for us.
+            mp_map_elem_t *elem = mp_map_lookup((mp_map_t *)&pin_fast_locals_dict.map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+            if (elem != NULL) {
+                mp_convert_member_lookup(self_in, &pin_fast_type, elem->value, dest);
+            }
+            break;
+        }
+    }
+}
+
+STATIC const mp_obj_type_t pin_fast_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_PinFast,
+    .print = pin_fast_print,
+    .call = pin_fast_call,
+    .attr = pin_fast_attr,
+    .locals_dict = (mp_obj_dict_t*)&pin_fast_locals_dict,
+};
+
 /// \moduleref pyb
 /// \class PinAF - Pin Alternate Functions
 ///
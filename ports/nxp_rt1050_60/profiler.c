@@ -0,0 +1,196 @@
+/*
+ * Statistical profiler, micropython.profile().
+ *
+ * GPT2 interrupts rate times a second and its IRQ counts the PC it interrupted, and at depth 2
+ * the stacked LR as its caller, in a hash table of PROF_GRAIN byte buckets. Its priority is
+ * just below the CSI's, so time in other IRQs is sampled too. When the PC is in the VM loop,
+ * the sample is also counted against the Python source line being run, found the same way
+ * micropython.alloc_stats() finds it. Addresses are symbolised on the host with profsym.py.
+ */
+#include <string.h>
+#include "py/runtime.h"
+#include "py/bc.h"
+#include "py/mphal.h"
+#include "irq.h"
+#include "fsl_clock.h"
+#include "profiler.h"
+
+typedef struct {
+	uint32_t r0, r1, r2, r3, r12, lr, pc, xpsr;
+} prof_frame_t;
+
+typedef struct {
+	uint32_t pc;		// bucket base, 0 if unused
+	uint32_t caller;	// return address the stacked LR holds, 0 at depth 1 or if none
+	uint32_t count;
+} prof_bucket_t;
+
+typedef struct {
+	qstr file;			// 0 if unused
+	uint32_t line;
+	uint32_t count;
+} prof_line_t;
+
+typedef struct {
+	uint8_t depth;
+	uint32_t dropped;	// samples that found their table full
+	prof_bucket_t buckets[PROF_BUCKETS];
+	prof_line_t lines[PROF_LINES];
+} prof_t;
+static prof_t s_prof;
+
+// the VM loop, all of MICROPY_HOT_TEXT, bracketed in hot_text.ld
+extern const uint8_t __vm_text_start[], __vm_text_end[];
+
+#define PROF_GPT		GPT2
+#define PROF_GPT_CLK	24000000U	// 24MHz crystal, independent of the core clock
+
+static void prof_count_line(void) {
+	#if MICROPY_PY_THREAD
+	// RT-Thread's own threads have no Python state
+	if (mp_thread_get_state() == NULL)
+		return;
+	#endif
+	const mp_code_state_t *code_state = MP_STATE_THREAD(current_code_state);
+	if (code_state == NULL)
+		return;
+	size_t line;
+	qstr file = mp_code_state_get_source(code_state, &line);
+	uint32_t i = (file * 31 + line) % PROF_LINES;
+	for (uint32_t n = PROF_LINES; n; n--) {
+		prof_line_t *p = &s_prof.lines[i];
+		if (p->file == 0) {
+			p->line = line;
+			p->file = file;
+		}
+		if (p->file == file && p->line == line) {
+			p->count++;
+			return;
+		}
+		if (++i == PROF_LINES)
+			i = 0;
+	}
+	s_prof.dropped++;
+}
+
+void profiler_sample(const prof_frame_t *frame) {
+	PROF_GPT->SR = GPT_SR_OF1_MASK;
+	uint32_t pc = frame->pc & ~(PROF_GRAIN - 1), caller = 0;
+	if (s_prof.depth > 1 && frame->lr < 0xFFFFFF00U)	// not an EXC_RETURN
+		caller = frame->lr & ~1U;
+
+	uint32_t n, i = (((pc / PROF_GRAIN) ^ (caller >> 1)) * 2654435761U) & (PROF_BUCKETS - 1);
+	for (n = PROF_BUCKETS; n; n--) {
+		prof_bucket_t *b = &s_prof.buckets[i];
+		if (b->pc == 0) {
+			b->caller = caller;
+			b->pc = pc;
+		}
+		if (b->pc == pc && b->caller == caller) {
+			b->count++;
+			break;
+		}
+		i = (i + 1) & (PROF_BUCKETS - 1);
+	}
+	if (n == 0)
+		s_prof.dropped++;
+
+	if (frame->pc - (uint32_t)__vm_text_start < (uint32_t)(__vm_text_end - __vm_text_start))
+		prof_count_line();
+	__DSB();
+}
+
+#ifdef __CC_ARM
+__asm void GPT2_IRQHandler(void) {
+	IMPORT	profiler_sample
+	PRESERVE8
+	tst lr, #4
+	ite eq
+	mrseq r0, msp
+	mrsne r0, psp
+	push	{r4, lr}
+	bl profiler_sample
+	pop		{r4, lr}
+	bx		lr
+}
+#else
+__attribute__((naked))
+void GPT2_IRQHandler(void) {
+	__asm volatile (
+		" tst lr, #4	\n"			// Test Bit 3 to see which stack pointer we should use.
+		" ite eq		\n"
+		" mrseq r0, msp \n"			// the frame the exception stacked
+		" mrsne r0, psp \n"
+		" push	{r4, lr} \n"		// r4 keeps the stack 8 byte aligned
+		" bl profiler_sample \n"
+		" pop	{r4, lr} \n"
+		" bx	lr	\n"
+	);
+}
+#endif
+
+void profiler_reset(void) {
+	mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+	s_prof.dropped = 0;
+	memset(s_prof.buckets, 0, sizeof(s_prof.buckets));
+	memset(s_prof.lines, 0, sizeof(s_prof.lines));
+	MICROPY_END_ATOMIC_SECTION(atomic_state);
+}
+
+bool profiler_start(uint32_t rate, uint32_t depth) {
+	if (rate > PROF_RATE_MAX)
+		return false;
+	NVIC_DisableIRQ(GPT2_IRQn);
+	PROF_GPT->CR = 0;
+	s_prof.depth = depth;
+	profiler_reset();
+	if (rate == 0)
+		return true;
+
+	CLOCK_EnableClock(kCLOCK_Gpt2);
+	CLOCK_EnableClock(kCLOCK_Gpt2S);
+	PROF_GPT->CR = GPT_CR_SWR_MASK;
+	while (PROF_GPT->CR & GPT_CR_SWR_MASK) {}
+	// restart mode on compare 1, also counting in WAIT so idle time shows up
+	PROF_GPT->CR = GPT_CR_CLKSRC(5) | GPT_CR_EN_24M_MASK | GPT_CR_ENMOD_MASK | GPT_CR_WAITEN_MASK;
+	PROF_GPT->PR = 0;
+	PROF_GPT->OCR[0] = PROF_GPT_CLK / rate - 1;
+	PROF_GPT->SR = 0x3F;
+	PROF_GPT->IR = GPT_IR_OF1IE_MASK;
+	NVIC_SetPriority(GPT2_IRQn, IRQ_PRI_PROF);
+	NVIC_EnableIRQ(GPT2_IRQn);
+	PROF_GPT->CR |= GPT_CR_EN_MASK;
+	return true;
+}
+
+bool mp_hal_profile_start(mp_uint_t rate, mp_uint_t depth) {
+	return profiler_start(rate, depth);
+}
+
+mp_obj_t mp_hal_profile_get(void) {
+	mp_obj_t dict = mp_obj_new_dict(0);
+	// sampling goes on meanwhile, entries only ever get filled in
+	for (uint32_t i = 0; i < PROF_BUCKETS; i++) {
+		const prof_bucket_t *b = &s_prof.buckets[i];
+		if (b->count == 0)
+			continue;
+		mp_obj_t key = mp_obj_new_int_from_uint(b->pc);
+		if (s_prof.depth > 1) {
+			mp_obj_t pair[2] = { key, mp_obj_new_int_from_uint(b->caller) };
+			key = mp_obj_new_tuple(2, pair);
+		}
+		mp_obj_dict_store(dict, key, mp_obj_new_int_from_uint(b->count));
+	}
+	for (uint32_t i = 0; i < PROF_LINES; i++) {
+		const prof_line_t *p = &s_prof.lines[i];
+		if (p->count == 0)
+			continue;
+		vstr_t vstr;
+		vstr_init(&vstr, 32);
+		vstr_printf(&vstr, "%q:%u", p->file, (unsigned)p->line);
+		mp_obj_dict_store(dict, mp_obj_new_str_from_vstr(&mp_type_str, &vstr), mp_obj_new_int_from_uint(p->count));
+	}
+	if (s_prof.dropped)
+		mp_obj_dict_store(dict, mp_const_none, mp_obj_new_int_from_uint(s_prof.dropped));
+	return dict;
+}
@@ -0,0 +1,20 @@
+/*
+ * Statistical profiler behind micropython.profile().
+ *
+ */
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PROF_GRAIN		16		// bytes of code one bucket covers
+#define PROF_BUCKETS	512		// (address, caller) pairs kept apart, a power of 2
+#define PROF_LINES		64		// Python source lines kept apart
+#define PROF_RATE_MAX	20000	// samples a second
+
+// Clears the samples and takes rate of them a second from GPT2, 0 stops. depth 2 also keeps
+// the caller, from the stacked LR. false if rate is out of range.
+bool profiler_start(uint32_t rate, uint32_t depth);
+// Clears the samples, sampling goes on. The IDE calls it when it starts a script.
+void profiler_reset(void);
+#endif // __PROFILER_H__
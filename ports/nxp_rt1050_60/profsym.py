@@ -0,0 +1,99 @@
+"""
+Symbolise the samples of micropython.profile() against the firmware ELF.
+
+On the board, after running the code to profile:
+
+    import micropython
+    micropython.profile(2000)      # or profile(2000, 2) to also keep callers
+    ...
+    print(micropython.profile())
+
+then save the printed dict to a file (or pipe it in) and run:
+
+    python3 profsym.py build-omvrt1/firmware.elf samples.txt
+
+Addresses are matched against the ELF's function symbols with nm, the output
+is the functions by sample count, then callers at depth 2, then the Python
+lines that were running when the VM loop was sampled.
+"""
+
+from __future__ import print_function
+
+import argparse
+import ast
+import bisect
+import subprocess
+import sys
+
+
+def load_symbols(nm, elf):
+    out = subprocess.check_output([nm, '-nS', '--defined-only', elf])
+    addrs, syms = [], []
+    for line in out.decode('utf8', 'replace').splitlines():
+        f = line.split()
+        # address size type name, only code symbols with a size
+        if len(f) == 4 and f[2] in 'tTwW':
+            addr, size = int(f[0], 16), int(f[1], 16)
+            addrs.append(addr)
+            syms.append((addr, size, f[3]))
+    return addrs, syms
+
+
+def symbolise(addrs, syms, addr):
+    i = bisect.bisect_right(addrs, addr) - 1
+    # buckets start up to PROF_GRAIN bytes before the sample, so allow that much slack
+    if i >= 0:
+        start, size, name = syms[i]
+        if addr < start + max(size, 16):
+            return name
+    return '0x%08x' % addr
+
+
+def report(title, counts, total, limit):
+    print(title)
+    for key, n in sorted(counts.items(), key=lambda kv: -kv[1])[:limit]:
+        print('  %5.1f%% %8d  %s' % (100.0 * n / total, n, key))
+    print()
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Symbolise micropython.profile() samples')
+    ap.add_argument('elf', help='firmware ELF the samples were taken with')
+    ap.add_argument('samples', nargs='?', help='printed micropython.profile() dict, default stdin')
+    ap.add_argument('--nm', default='arm-none-eabi-nm', help='nm of the toolchain')
+    ap.add_argument('-n', type=int, default=40, help='entries shown per table')
+    args = ap.parse_args()
+
+    text = open(args.samples).read() if args.samples else sys.stdin.read()
+    samples = ast.literal_eval(text.strip())
+    addrs, syms = load_symbols(args.nm, args.elf)
+
+    funcs, callers, lines = {}, {}, {}
+    total = 0
+    for key, n in samples.items():
+        if key is None:
+            print('%d samples did not fit in the tables on the board\n' % n)
+        elif isinstance(key, str):
+            lines[key] = lines.get(key, 0) + n
+        else:
+            pc, caller = key if isinstance(key, tuple) else (key, 0)
+            name = symbolise(addrs, syms, pc)
+            funcs[name] = funcs.get(name, 0) + n
+            total += n
+            if caller:
+                # the return address is just past the call
+                edge = '%s <- %s' % (name, symbolise(addrs, syms, caller - 2))
+                callers[edge] = callers.get(edge, 0) + n
+
+    if not total:
+        print('no samples')
+        return
+    report('functions (%d samples)' % total, funcs, total, args.n)
+    if callers:
+        report('callers', callers, total, args.n)
+    if lines:
+        report('Python lines, of all samples', lines, total, args.n)
+
+
+if __name__ == '__main__':
+    main()
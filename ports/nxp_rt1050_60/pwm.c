@@ -2,8 +2,12 @@
 #include "py/nlr.h"
 #include "py/runtime.h"
 #include "py/mphal.h"
+#include "py/binary.h"
 #include "fsl_xbara.h"
 #include "pwm.h"
+#include "dma.h"
+#include "irq.h"
+#include "fsl_dmamux.h"
 #include "genhdr/pins.h"
 #if 1
 #include "fsl_iomuxc.h"
@@ -59,6 +63,9 @@ uint32_t _CalcPrescale(pyb_pwm_obj_t *s, uint32_t clkSource) {
 	nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Allowed error is too small for this freq, chen qie zuo bu dao a!  %>_<% "));	
 }
 
+STATIC void pwm_play_sync(PWM_Type *base);
+STATIC void pwm_play_end(pyb_pwm_obj_t *self);
+
 void init_tmr(pyb_pwm_obj_t *s)
 {
 	uint32_t id = s-pyb_pwm_obj;
@@ -126,6 +133,7 @@ void init_tmr(pyb_pwm_obj_t *s)
 					 pwmSourceClockInHz);
 		PWM_SetPwmLdok(s->pwm_base, s->control_t, true);
 		PWM_StartTimer(s->pwm_base, s->control_t);	
+		pwm_play_sync(s->pwm_base);
 	}
 }
 
@@ -289,9 +297,185 @@ void pwm_init0()
 	#endif	
 }
 
+/******************************************************************************/
+// play(): a compare value per PWM period from a buffer, without the CPU.
+//
+// With DMAEN[VALDE] a FlexPWM submodule asks for a DMA write of its value registers once a
+// reload cleared its LDOK. DMA_CH_PWM_PLAY writes the next VAL3 (channel A) or VAL5 (B) and
+// links to DMA_CH_PWM_LDOK, which sets LDOK again so the value is loaded at the following
+// reload. The higher channel wins the arbitration, LDOK is set before the request is seen a
+// second time. One PWM plays at a time, its buffer and callback are in
+// MP_STATE_PORT(pwm_play_buf/cb).
+typedef struct _pwm_play_t {
+	pyb_pwm_obj_t *pwm;
+	int16_t *src;
+	size_t len;
+	volatile bool pending[2];
+	uint32_t overruns;
+	uint16_t mctrl;	// what DMA_CH_PWM_LDOK writes: RUN and IPOL of the module, with our LDOK
+} pwm_play_t;
+
+STATIC pwm_play_t pwm_play;
+
+// The other submodules of the module can be started and stopped while one plays, the
+// MCTRL written after each value must keep their RUN bits.
+STATIC void pwm_play_sync(PWM_Type *base) {
+	pyb_pwm_obj_t *s = pwm_play.pwm;
+	if (s && s->pwm_base == base) {
+		pwm_play.mctrl = (base->MCTRL & (PWM_MCTRL_RUN_MASK | PWM_MCTRL_IPOL_MASK)) | PWM_MCTRL_LDOK(s->control_t);
+	}
+}
+
+STATIC void pwm_play_start(pyb_pwm_obj_t *self, mp_obj_t buf, mp_obj_t callback) {
+	if (self->pwm_base == NULL) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "only pwm[5-10] can play a buffer"));
+	}
+	if (pwm_play.pwm) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "a PWM is already playing"));
+	}
+	mp_buffer_info_t bufinfo;
+	mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_READ);
+	if (mp_binary_get_size('@', bufinfo.typecode, NULL) != sizeof(int16_t)) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "need an array of 16-bit values"));
+	}
+	// a major loop count with channel linking has 9 bits
+	size_t len = bufinfo.len / sizeof(int16_t);
+	size_t unit = (callback != MP_OBJ_NULL) ? 2 : 1;
+	if (len == 0 || (len % unit) || len > DMA_CITER_ELINKYES_CITER_MASK) {
+		nlr_raise(mp_obj_new_exception_msg_varg(&mp_type_ValueError,
+			"buffer must hold a multiple of %d values, at most %d", unit, DMA_CITER_ELINKYES_CITER_MASK));
+	}
+
+	PWM_Type *base = self->pwm_base;
+	pwm_submodule_t sm = self->flexidex;
+	volatile uint16_t *val = (self->channel == kPWM_PwmA) ? &base->SM[sm].VAL3 : &base->SM[sm].VAL5;
+	pwm_play.pwm = self;
+	pwm_play.src = bufinfo.buf;
+	pwm_play.len = len;
+	pwm_play.pending[0] = pwm_play.pending[1] = false;
+	pwm_play.overruns = 0;
+	pwm_play_sync(base);
+	MP_STATE_PORT(pwm_play_buf) = buf;
+	MP_STATE_PORT(pwm_play_cb) = callback;
+
+	// the pulse starts with the period, the buffer holds where it ends (see ticks())
+	PWM_SetPwmLdok(base, self->control_t, false);
+	if (self->channel == kPWM_PwmA) {
+		base->SM[sm].VAL2 = base->SM[sm].INIT;
+	} else {
+		base->SM[sm].VAL4 = base->SM[sm].INIT;
+	}
+
+	dma_edma_init();
+	EDMA_ResetChannel(DMA0, DMA_CH_PWM_LDOK);
+	DMA0->TCD[DMA_CH_PWM_LDOK].SADDR = (uint32_t)&pwm_play.mctrl;
+	DMA0->TCD[DMA_CH_PWM_LDOK].SOFF = 0;
+	DMA0->TCD[DMA_CH_PWM_LDOK].ATTR = DMA_ATTR_SSIZE(kEDMA_TransferSize2Bytes) | DMA_ATTR_DSIZE(kEDMA_TransferSize2Bytes);
+	DMA0->TCD[DMA_CH_PWM_LDOK].NBYTES_MLNO = sizeof(uint16_t);
+	DMA0->TCD[DMA_CH_PWM_LDOK].SLAST = 0;
+	DMA0->TCD[DMA_CH_PWM_LDOK].DADDR = (uint32_t)&base->MCTRL;
+	DMA0->TCD[DMA_CH_PWM_LDOK].DOFF = 0;
+	DMA0->TCD[DMA_CH_PWM_LDOK].CITER_ELINKNO = 1;
+	DMA0->TCD[DMA_CH_PWM_LDOK].BITER_ELINKNO = 1;
+	DMA0->TCD[DMA_CH_PWM_LDOK].DLAST_SGA = 0;
+	DMA0->TCD[DMA_CH_PWM_LDOK].CSR = 0;
+
+	uint32_t source = ((base == PWM1) ? kDmaRequestMuxFlexPWM1ValueSub0 : kDmaRequestMuxFlexPWM3ValueSub0) + sm;
+	DMAMUX_SetSource(DMAMUX, DMA_CH_PWM_PLAY, source);
+	DMAMUX_EnableChannel(DMAMUX, DMA_CH_PWM_PLAY);
+	EDMA_ResetChannel(DMA0, DMA_CH_PWM_PLAY);
+	DMA0->TCD[DMA_CH_PWM_PLAY].SADDR = (uint32_t)pwm_play.src;
+	DMA0->TCD[DMA_CH_PWM_PLAY].SOFF = sizeof(int16_t);
+	DMA0->TCD[DMA_CH_PWM_PLAY].ATTR = DMA_ATTR_SSIZE(kEDMA_TransferSize2Bytes) | DMA_ATTR_DSIZE(kEDMA_TransferSize2Bytes);
+	DMA0->TCD[DMA_CH_PWM_PLAY].NBYTES_MLNO = sizeof(int16_t);
+	DMA0->TCD[DMA_CH_PWM_PLAY].DADDR = (uint32_t)val;
+	DMA0->TCD[DMA_CH_PWM_PLAY].DOFF = 0;
+	DMA0->TCD[DMA_CH_PWM_PLAY].DLAST_SGA = 0;
+	DMA0->TCD[DMA_CH_PWM_PLAY].CITER_ELINKYES = DMA_CITER_ELINKYES_ELINK_MASK |
+		DMA_CITER_ELINKYES_LINKCH(DMA_CH_PWM_LDOK) | DMA_CITER_ELINKYES_CITER(len);
+	DMA0->TCD[DMA_CH_PWM_PLAY].BITER_ELINKYES = DMA_BITER_ELINKYES_ELINK_MASK |
+		DMA_BITER_ELINKYES_LINKCH(DMA_CH_PWM_LDOK) | DMA_BITER_ELINKYES_BITER(len);
+	// the last minor loop links through the major loop link instead
+	uint16_t csr = DMA_CSR_MAJORELINK_MASK | DMA_CSR_MAJORLINKCH(DMA_CH_PWM_LDOK);
+	if (callback != MP_OBJ_NULL) {
+		DMA0->TCD[DMA_CH_PWM_PLAY].SLAST = -(int32_t)(len * sizeof(int16_t));
+		DMA0->TCD[DMA_CH_PWM_PLAY].CSR = csr | DMA_CSR_INTHALF_MASK | DMA_CSR_INTMAJOR_MASK;
+		NVIC_SetPriority(DMA8_DMA24_IRQn, IRQ_PRI_DMA);
+		EnableIRQ(DMA8_DMA24_IRQn);
+	} else {
+		DMA0->TCD[DMA_CH_PWM_PLAY].SLAST = 0;
+		DMA0->TCD[DMA_CH_PWM_PLAY].CSR = csr | DMA_CSR_DREQ_MASK;
+	}
+
+	dma_begin_write(pwm_play.src, len * sizeof(int16_t));
+	EDMA_EnableChannelRequest(DMA0, DMA_CH_PWM_PLAY);
+	base->SM[sm].DMAEN |= PWM_DMAEN_VALDE_MASK;
+}
+
+// The last value written stays.
+STATIC void pwm_play_end(pyb_pwm_obj_t *self) {
+	if (pwm_play.pwm == NULL || (self && self != pwm_play.pwm)) {
+		return;
+	}
+	pyb_pwm_obj_t *s = pwm_play.pwm;
+	s->pwm_base->SM[s->flexidex].DMAEN &= ~PWM_DMAEN_VALDE_MASK;
+	EDMA_DisableChannelRequest(DMA0, DMA_CH_PWM_PLAY);
+	DisableIRQ(DMA8_DMA24_IRQn);
+	DMAMUX_DisableChannel(DMAMUX, DMA_CH_PWM_PLAY);
+	pwm_play.pwm = NULL;
+	MP_STATE_PORT(pwm_play_buf) = MP_OBJ_NULL;
+	MP_STATE_PORT(pwm_play_cb) = MP_OBJ_NULL;
+}
+
+void pwm_play_stop(void) {
+	pwm_play_end(NULL);
+}
+
+// Scheduled per half that went out, which counts as overrun if it is due again before
+// this returns. The callback's writes are cleaned to memory for the DMA here.
+STATIC mp_obj_t pwm_play_dispatch(mp_obj_t half_in) {
+	mp_int_t half = MP_OBJ_SMALL_INT_VALUE(half_in);
+	mp_obj_t callback = MP_STATE_PORT(pwm_play_cb);
+	size_t n = pwm_play.len / 2;
+	nlr_buf_t nlr;
+	if (nlr_push(&nlr) == 0) {
+		if (callback != MP_OBJ_NULL) {
+			mp_call_function_1(callback, half_in);
+		}
+		nlr_pop();
+		dma_begin_write(pwm_play.src + half * n, n * sizeof(int16_t));
+		pwm_play.pending[half] = false;
+	} else {
+		pwm_play.pending[half] = false;
+		nlr_jump(nlr.ret_val);
+	}
+	return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pwm_play_dispatch_obj, pwm_play_dispatch);
+
+void DMA8_DMA24_IRQHandler(void) {
+	pwm_play_t *p = &pwm_play;
+	int half = 0;
+	if (DMA0->TCD[DMA_CH_PWM_PLAY].CSR & DMA_CSR_DONE_MASK) {
+		DMA0->CDNE = DMA_CH_PWM_PLAY;
+		half = 1;
+	}
+	DMA0->CINT = DMA_CH_PWM_PLAY;
+
+	if (p->pending[half]) {
+		p->overruns++;
+	} else if (mp_sched_schedule(MP_OBJ_FROM_PTR(&pwm_play_dispatch_obj), MP_OBJ_NEW_SMALL_INT(half))) {
+		p->pending[half] = true;
+	} else {
+		p->overruns++;
+	}
+	__DSB();
+}
+
 #define ANGLE_TO_DUTY_PERCENT(angle, offset, scale) (((angle) / 180.0f * (scale) + (offset)) / 20.0f * 100.0f)
 
 mp_obj_t pwm_init(pyb_pwm_obj_t *s) {
+	pwm_play_end(s);
 	init_tmr(s);
 	set_pwm(s);
     return mp_const_none;
@@ -312,6 +496,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(pwm_test_obj, pwm_test);
 mp_obj_t pyb_pwm_deinit(mp_obj_t self_in){
 	pyb_pwm_obj_t *self = self_in;
 	uint32_t id = self - pyb_pwm_obj;
+	pwm_play_end(self);
 	if(id<4)
 	{
 		/* Stop the qtimer */
@@ -323,6 +508,7 @@ mp_obj_t pyb_pwm_deinit(mp_obj_t self_in){
 		/* stop the timer of the flexpwm */
 		PWM_StopTimer(self->pwm_base, self->control_t);
 		PWM_Deinit(self->pwm_base, self->flexidex);
+		pwm_play_sync(self->pwm_base);
 	}
 	return mp_const_none;
 	
@@ -474,6 +660,49 @@ STATIC mp_obj_t pyb_pwm_inverted(size_t n_args, const mp_obj_t *args) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pyb_pwm_inverted_obj, 1, 2, pyb_pwm_inverted);
 
+/// \method ticks(percent)
+/// The value play() takes for a duty cycle in percent, where the pulse of the period ends.
+STATIC mp_obj_t pyb_pwm_ticks(mp_obj_t self_in, mp_obj_t percent_in) {
+	pyb_pwm_obj_t *self = self_in;
+	if (self->pwm_base == NULL) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "only pwm[5-10] can play a buffer"));
+	}
+	// signed center aligned, the counter runs from INIT = -VAL1 to VAL1
+	int32_t modulo = (int16_t)self->pwm_base->SM[self->flexidex].VAL1;
+	float percent = mp_obj_get_float(percent_in);
+	if (percent < 0 || percent > 100) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "only accept 0-100  %%>_<%% "));
+	}
+	return mp_obj_new_int(-modulo + (int32_t)(modulo * 2 * percent / 100.0f + 0.5f));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pyb_pwm_ticks_obj, pyb_pwm_ticks);
+
+/// \method play(buf, [rate, [callback]])
+/// Output the values of buf, an array('h') of ticks(), one per PWM period. rate sets the
+/// frequency first, values then change rate times a second. Without callback buf plays once
+/// and its last value stays. With one it plays over and over and callback(half) is scheduled
+/// each time a half of buf went out and can be refilled. pwm[5-10] only, at most 511 values.
+STATIC mp_obj_t pyb_pwm_play(size_t n_args, const mp_obj_t *args) {
+	pyb_pwm_obj_t *self = args[0];
+	if (n_args >= 3 && args[2] != mp_const_none) {
+		self->freq = mp_obj_get_int(args[2]);
+		pwm_init(self);
+	}
+	pwm_play_start(self, args[1], (n_args >= 4 && args[3] != mp_const_none) ? args[3] : MP_OBJ_NULL);
+	return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pyb_pwm_play_obj, 2, 4, pyb_pwm_play);
+
+/// \method stop()
+/// End play(). Returns the number of halves that were due again before their callback
+/// returned.
+STATIC mp_obj_t pyb_pwm_stop(mp_obj_t self_in) {
+	uint32_t overruns = (pwm_play.pwm == self_in) ? pwm_play.overruns : 0;
+	pwm_play_end(self_in);
+	return mp_obj_new_int(overruns);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_pwm_stop_obj, pyb_pwm_stop);
+
 STATIC const mp_rom_map_elem_t pwm_locals_dict_table[] = {
 
 	{ MP_ROM_QSTR(MP_QSTR_test), MP_ROM_PTR(&pwm_test_obj) },
@@ -483,6 +712,9 @@ STATIC const mp_rom_map_elem_t pwm_locals_dict_table[] = {
 	{ MP_ROM_QSTR(MP_QSTR_pwm_width), MP_ROM_PTR(&pyb_pwm_width_obj) },
 	{ MP_ROM_QSTR(MP_QSTR_pwm_freq), MP_ROM_PTR(&pyb_pwm_freq_obj) },
 	{ MP_ROM_QSTR(MP_QSTR_pwm_inverted), MP_ROM_PTR(&pyb_pwm_inverted_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_ticks), MP_ROM_PTR(&pyb_pwm_ticks_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_play), MP_ROM_PTR(&pyb_pwm_play_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&pyb_pwm_stop_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(pwm_locals_dict, pwm_locals_dict_table);
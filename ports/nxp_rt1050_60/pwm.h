@@ -54,4 +54,6 @@ typedef struct _pwm_obj_t{
 	const pin_obj_t *pin;
 } pyb_pwm_obj_t;
 void pwm_init0();
+// ends a play(), called on soft reset
+void pwm_play_stop(void);
 extern const mp_obj_type_t pyb_pwm_type;
\ No newline at end of file
@@ -32,7 +32,7 @@
 #include "irq.h"
 #include "pybthread.h"
 
-#if MICROPY_PY_THREAD
+#if MICROPY_PY_PYBTHREAD
 
 #define PYB_MUTEX_UNLOCKED ((void*)0)
 #define PYB_MUTEX_LOCKED ((void*)1)
@@ -235,4 +235,4 @@ void pyb_mutex_unlock(pyb_mutex_t *m) {
     RESTORE_IRQ_PRI(irq_state);
 }
 
-#endif // MICROPY_PY_THREAD
+#endif // MICROPY_PY_PYBTHREAD
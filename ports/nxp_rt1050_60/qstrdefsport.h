@@ -36,6 +36,7 @@ Q(/sd/lib)
 // for usb modes
 Q(MSC+HID)
 Q(VCP+MSC)
+Q(VCP+MSC+VND)
 Q(VCP+HID)
 Q(CDC+MSC)
 Q(CDC+HID)
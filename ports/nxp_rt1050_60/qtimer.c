@@ -33,6 +33,8 @@ void QTmrIRQHandler(int min, int max)
 		if((temp->isActive) && ((reg & TMR_SCTRL_TCF_MASK)>>TMR_SCTRL_TCF_SHIFT))
 		{
 			QTMR_ClearStatusFlags(temp->tmr_base, temp->idex, kQTMR_CompareFlag);
+			if (temp->irq_handler)
+				temp->irq_handler();
 			timer_handle_irq_channel(temp, temp->callback);
 			temp->ticks++;
 		}
@@ -107,6 +109,33 @@ mp_obj_t qtimer_init(pyb_qtimer_obj_t *self_in){
 	
 }
 
+// OFLAG toggles on every compare of half the period, so a whole period has one rising edge.
+bool qtimer_start_trigger(pyb_qtimer_obj_t *self, xbar_output_signal_t output)
+{
+	xbar_input_signal_t input;
+	if (self->tmr_base == TMR3)
+		input = kXBARA1_InputQtimer3Tmr0Output;
+	else if (self->tmr_base == TMR4)
+		input = kXBARA1_InputQtimer4Tmr0Output;
+	else
+		return false;
+	XBARA_Init(XBARA1);
+	XBARA_SetSignalsConnection(XBARA1, (xbar_input_signal_t)(input + self->idex), output);
+
+	QTMR_DisableInterrupts(self->tmr_base, self->idex, kQTMR_CompareInterruptEnable);
+	QTMR_SetTimerPeriod(self->tmr_base, self->idex, MSEC_FLOAT_TO_COUNT(self->period, (QTMR_SOURCE_CLOCK / (1<<self->prescale))) / 2);
+	self->tmr_base->CHANNEL[self->idex].CTRL = (self->tmr_base->CHANNEL[self->idex].CTRL & ~TMR_CTRL_OUTMODE_MASK) | TMR_CTRL_OUTMODE(kQTMR_ToggleOnCompare);
+	return true;
+}
+
+void qtimer_stop_trigger(pyb_qtimer_obj_t *self)
+{
+	self->tmr_base->CHANNEL[self->idex].CTRL &= ~TMR_CTRL_OUTMODE_MASK;
+	set_tmr_period(self);
+	QTMR_ClearStatusFlags(self->tmr_base, self->idex, kQTMR_CompareFlag);
+	QTMR_EnableInterrupts(self->tmr_base, self->idex, kQTMR_CompareInterruptEnable);
+}
+
 mp_obj_t qtimer_get_count(mp_obj_t self_in){
 	pyb_qtimer_obj_t *self = self_in;
 	uint16_t count = QTMR_GetCurrentTimerCount(self->tmr_base, self->idex);
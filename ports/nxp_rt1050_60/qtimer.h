@@ -1,5 +1,6 @@
 #include "py/obj.h"
 #include "fsl_qtmr.h"
+#include "fsl_xbara.h"
 
 typedef struct _qtimer_obj_t{
 	mp_obj_base_t base;
@@ -11,5 +12,11 @@ typedef struct _qtimer_obj_t{
 	uint16_t prescale;
 	bool isActive;
 	mp_obj_t callback;
+	void (*irq_handler)(void); // C code driven by the timer, called in the IRQ before callback
 } pyb_qtimer_obj_t;
-extern const mp_obj_type_t pyb_qtimer_type;
\ No newline at end of file
+extern const mp_obj_type_t pyb_qtimer_type;
+
+// Routes the timer's output through XBARA to output, one rising edge per period, and takes
+// its interrupt off meanwhile. Only TMR3 and TMR4 reach XBARA, false for the others.
+bool qtimer_start_trigger(pyb_qtimer_obj_t *self, xbar_output_signal_t output);
+void qtimer_stop_trigger(pyb_qtimer_obj_t *self);
\ No newline at end of file
@@ -40,20 +40,24 @@
 #if MICROPY_HW_ENABLE_RNG
 uint8_t s_isRngInited;
 uint32_t s_seed;
-uint32_t rng_get(void) {
-    uint32_t i;
+static void rng_init(void) {
     trng_config_t trngConfig;
-    status_t status;
-    uint32_t data[TRNG_EXAMPLE_RANDOM_NUMBER];
 	if (s_isRngInited == 0) {
-	
 		TRNG_GetDefaultConfig(&trngConfig);
 		/* Set sample mode of the TRNG ring oscillator to Von Neumann, for better random data.
 		 * It is optional.*/
 		trngConfig.sampleMode = kTRNG_SampleModeVonNeumann;
 		/* Initialize TRNG */
-		status = TRNG_Init(TRNG0, &trngConfig);
+		TRNG_Init(TRNG0, &trngConfig);
 		s_isRngInited = 1;
+	}
+}
+
+uint32_t rng_get(void) {
+    status_t status;
+    uint32_t data[TRNG_EXAMPLE_RANDOM_NUMBER];
+	if (s_isRngInited == 0) {
+		rng_init();
 		status = TRNG_GetRandomData(TRNG0, data, sizeof(data));
 		if (status == kStatus_Success)
 		{
@@ -64,6 +68,12 @@ uint32_t rng_get(void) {
 	return rand();
 }
 
+// Fills buf with TRNG output, for seeding where rand() won't do. Returns 0 on success.
+int rng_get_entropy(uint8_t *buf, size_t len) {
+	rng_init();
+	return (TRNG_GetRandomData(TRNG0, buf, len) == kStatus_Success) ? 0 : -1;
+}
+
 // Return a 30-bit hardware generated random number.
 STATIC mp_obj_t pyb_rng_getnum(void) {
 	return mp_obj_new_int(rng_get() >> 2);
@@ -26,5 +26,6 @@
 
 #include "py/obj.h"
 uint32_t rng_get(void);
+int rng_get_entropy(uint8_t *buf, size_t len);
 extern const mp_obj_type_t pyb_rng_type;
 MP_DECLARE_CONST_FUN_OBJ_0(pyb_rng_getnum_obj);
\ No newline at end of file
@@ -2,7 +2,11 @@
 #include "py/nlr.h"
 #include "py/runtime.h"
 #include "py/mphal.h"
+#include "py/binary.h"
 #include "rpm.h"
+#include "dma.h"
+#include "irq.h"
+#include "fsl_dmamux.h"
 #include "genhdr/pins.h"
 
 #define QTMR_SOURCE_CLOCK CLOCK_GetFreq(kCLOCK_IpgClk)
@@ -24,6 +28,8 @@ pyb_rpm_obj_t pyb_rpm_obj[5]={
 	{.base = {&pyb_rpm_type}, .tmr_base = TMR2, .idex = kQTMR_Channel_2, .isActive=false, NULL},
 };
 
+STATIC void rpm_capture_end(pyb_rpm_obj_t *self);
+
 #define RPM_INIT_PINS(n) \
 	pyb_rpm_obj[n].pin = &MICROPY_HW_RPM_##n;
 
@@ -59,7 +65,8 @@ void rpm_init0()
 	#else
 	RPM_INIT_PINS(4);
 	#endif
-	
+	// soft reset: the buffer of capture() is gone
+	rpm_capture_end(NULL);
 }
 mp_obj_t capture_init(pyb_rpm_obj_t *self_in){                                  /* Software Input On Field: Input Path is determined by functionality */
 	
@@ -79,10 +86,246 @@ mp_obj_t get_count(mp_obj_t self_in){
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(get_count_obj, get_count);
 
+/******************************************************************************/
+// capture(): the counter value at each rising edge into a buffer, without the CPU.
+//
+// The counter of RPM(4), TMR1 channel 3, runs free from the IP bus clock and captures its
+// value when the pin rises. With IEFDE the input edge flag is a DMA request of QTIMER1 and
+// DMA_CH_RPM_CAPTURE reads CAPT, which clears the flag, into the next halfword of the
+// buffer. Of the RPM pins only B1_08 is on a QTimer with DMA requests (QTIMER1 and 3).
+// The buffer is a ring holding the latest edges; with a callback it is called with the
+// half that filled. Buffer and callback are in MP_STATE_PORT(rpm_capture_buf/cb).
+#define RPM_CAPTURE_ID		(3)	// RPM(4)
+#define RPM_CAPTURE_AVG		(8)	// periods get_pps() averages
+
+typedef struct _rpm_capture_t {
+	pyb_rpm_obj_t *rpm;
+	uint16_t *dst;
+	size_t len;
+	uint32_t freq;		// of the timestamps
+	volatile bool pending[2];
+	uint32_t overruns;
+	// kept by RPM_TickHandler(): the next index the DMA writes, the edges in the ring
+	// and the ms since the last one
+	size_t next;
+	size_t filled;
+	uint32_t idle_ms;
+} rpm_capture_t;
+
+STATIC rpm_capture_t rpm_capture;
+
+STATIC size_t rpm_capture_index(void) {
+	size_t n = (DMA0->TCD[DMA_CH_RPM_CAPTURE].DADDR - (uint32_t)rpm_capture.dst) / sizeof(uint16_t);
+	return (n < rpm_capture.len) ? n : 0;
+}
+
+STATIC mp_obj_t rpm_capture_start(pyb_rpm_obj_t *self, mp_obj_t buf, mp_obj_t callback, mp_int_t div) {
+	if (self != &pyb_rpm_obj[RPM_CAPTURE_ID]) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "only RPM(4) can capture to a buffer"));
+	}
+	mp_buffer_info_t bufinfo;
+	mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_WRITE);
+	if (mp_binary_get_size('@', bufinfo.typecode, NULL) != sizeof(uint16_t)) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "need an array of 16-bit values"));
+	}
+	size_t len = bufinfo.len / sizeof(uint16_t);
+	if (len < 2 || (len & 1) || len > DMA_CITER_ELINKNO_CITER_MASK) {
+		nlr_raise(mp_obj_new_exception_msg_varg(&mp_type_ValueError,
+			"buffer must hold an even number of values, at most %d", DMA_CITER_ELINKNO_CITER_MASK));
+	}
+	int shift = 0;
+	while ((1 << shift) < div && shift < 7) {
+		shift++;
+	}
+	if ((1 << shift) != div) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "div must be 1, 2, 4 .. 128"));
+	}
+
+	rpm_capture_end(NULL);
+	TMR_Type *base = self->tmr_base;
+	qtmr_channel_selection_t ch = self->idex;
+	// the counts of RPM_TickHandler() mean nothing while the counter counts time
+	self->isActive = false;
+	mp_hal_pin_config_alt(self->pin, GPIO_MODE_OUTPUT_PP, AF_FN_TMR);
+	qtmr_config_t qtmrConfig;
+	QTMR_GetDefaultConfig(&qtmrConfig);
+	qtmrConfig.primarySource = kQTMR_ClockDivide_1 + shift;
+	QTMR_Init(base, ch, &qtmrConfig);
+	QTMR_SetupInputCapture(base, ch, kQTMR_Counter3InputPin, false, false, kQTMR_RisingEdge);
+
+	rpm_capture.rpm = self;
+	rpm_capture.dst = bufinfo.buf;
+	rpm_capture.len = len;
+	rpm_capture.freq = QTMR_SOURCE_CLOCK >> shift;
+	rpm_capture.pending[0] = rpm_capture.pending[1] = false;
+	rpm_capture.overruns = 0;
+	rpm_capture.next = 0;
+	rpm_capture.filled = 0;
+	rpm_capture.idle_ms = 0;
+	MP_STATE_PORT(rpm_capture_buf) = buf;
+	MP_STATE_PORT(rpm_capture_cb) = callback;
+
+	dma_edma_init();
+	DMAMUX_SetSource(DMAMUX, DMA_CH_RPM_CAPTURE, kDmaRequestMuxQTIMER1CaptTimer3);
+	DMAMUX_EnableChannel(DMAMUX, DMA_CH_RPM_CAPTURE);
+	EDMA_ResetChannel(DMA0, DMA_CH_RPM_CAPTURE);
+	DMA0->TCD[DMA_CH_RPM_CAPTURE].SADDR = (uint32_t)&base->CHANNEL[ch].CAPT;
+	DMA0->TCD[DMA_CH_RPM_CAPTURE].SOFF = 0;
+	DMA0->TCD[DMA_CH_RPM_CAPTURE].ATTR = DMA_ATTR_SSIZE(kEDMA_TransferSize2Bytes) | DMA_ATTR_DSIZE(kEDMA_TransferSize2Bytes);
+	DMA0->TCD[DMA_CH_RPM_CAPTURE].NBYTES_MLNO = sizeof(uint16_t);
+	DMA0->TCD[DMA_CH_RPM_CAPTURE].SLAST = 0;
+	DMA0->TCD[DMA_CH_RPM_CAPTURE].DADDR = (uint32_t)rpm_capture.dst;
+	DMA0->TCD[DMA_CH_RPM_CAPTURE].DOFF = sizeof(uint16_t);
+	DMA0->TCD[DMA_CH_RPM_CAPTURE].CITER_ELINKNO = len;
+	DMA0->TCD[DMA_CH_RPM_CAPTURE].BITER_ELINKNO = len;
+	DMA0->TCD[DMA_CH_RPM_CAPTURE].DLAST_SGA = -(int32_t)(len * sizeof(uint16_t));
+	if (callback != MP_OBJ_NULL) {
+		DMA0->TCD[DMA_CH_RPM_CAPTURE].CSR = DMA_CSR_INTHALF_MASK | DMA_CSR_INTMAJOR_MASK;
+		NVIC_SetPriority(DMA10_DMA26_IRQn, IRQ_PRI_DMA);
+		EnableIRQ(DMA10_DMA26_IRQn);
+	} else {
+		DMA0->TCD[DMA_CH_RPM_CAPTURE].CSR = 0;
+	}
+
+	dma_begin_read(rpm_capture.dst, len * sizeof(uint16_t));
+	EDMA_EnableChannelRequest(DMA0, DMA_CH_RPM_CAPTURE);
+	QTMR_EnableDma(base, ch, kQTMR_InputEdgeFlagDmaEnable);
+	QTMR_StartTimer(base, ch, kQTMR_PriSrcRiseEdge);
+	return mp_obj_new_int(rpm_capture.freq);
+}
+
+// The counter is left stopped, init() starts counting pulses again.
+STATIC void rpm_capture_end(pyb_rpm_obj_t *self) {
+	if (rpm_capture.rpm == NULL || (self && self != rpm_capture.rpm)) {
+		return;
+	}
+	pyb_rpm_obj_t *s = rpm_capture.rpm;
+	QTMR_StopTimer(s->tmr_base, s->idex);
+	QTMR_DisableDma(s->tmr_base, s->idex, kQTMR_InputEdgeFlagDmaEnable);
+	EDMA_DisableChannelRequest(DMA0, DMA_CH_RPM_CAPTURE);
+	DisableIRQ(DMA10_DMA26_IRQn);
+	DMAMUX_DisableChannel(DMAMUX, DMA_CH_RPM_CAPTURE);
+	rpm_capture.rpm = NULL;
+	MP_STATE_PORT(rpm_capture_buf) = MP_OBJ_NULL;
+	MP_STATE_PORT(rpm_capture_cb) = MP_OBJ_NULL;
+}
+
+// From the systick, follows the DMA to tell edges from silence.
+STATIC void rpm_capture_tick(void) {
+	rpm_capture_t *c = &rpm_capture;
+	size_t n = rpm_capture_index();
+	if (n == c->next) {
+		c->idle_ms++;
+		return;
+	}
+	size_t edges = (n + c->len - c->next) % c->len;
+	c->filled = (c->filled + edges < c->len) ? (c->filled + edges) : c->len;
+	c->next = n;
+	c->idle_ms = 0;
+}
+
+// Edges per second from the periods of the latest RPM_CAPTURE_AVG edges. Each period is at
+// most a wrap of the 16-bit counter, 65536 / freq s; a signal that slowed or stopped since its
+// last edge reads at most as fast as one edge in the time since.
+STATIC float rpm_capture_pps(void) {
+	rpm_capture_t *c = &rpm_capture;
+	uint32_t idle_ms = c->idle_ms;
+	size_t filled = c->filled, next = c->next;
+	size_t k = (filled - 1 < RPM_CAPTURE_AVG) ? (filled - 1) : RPM_CAPTURE_AVG;
+	if (filled < 2 || (uint64_t)idle_ms * c->freq >= 65536ULL * 1000) {
+		return 0.0f;
+	}
+	// the ring is only read here and in the callback, both after the DMA wrote it
+	dma_end_read(c->dst, c->len * sizeof(uint16_t));
+	uint32_t ticks = 0;
+	size_t i = (next + c->len - 1) % c->len;
+	for (size_t j = 0; j < k; j++) {
+		size_t prev = (i + c->len - 1) % c->len;
+		ticks += (uint16_t)(c->dst[i] - c->dst[prev]);
+		i = prev;
+	}
+	float pps = ticks ? ((float)c->freq * k / ticks) : 0.0f;
+	if (idle_ms && (pps * idle_ms > 1000.0f)) {
+		pps = 1000.0f / idle_ms;
+	}
+	return pps;
+}
+
+// Scheduled per half that filled, which counts as overrun if it is due again before this
+// returns.
+STATIC mp_obj_t rpm_capture_dispatch(mp_obj_t half_in) {
+	mp_int_t half = MP_OBJ_SMALL_INT_VALUE(half_in);
+	mp_obj_t callback = MP_STATE_PORT(rpm_capture_cb);
+	nlr_buf_t nlr;
+	if (nlr_push(&nlr) == 0) {
+		if (callback != MP_OBJ_NULL) {
+			mp_call_function_1(callback, half_in);
+		}
+		nlr_pop();
+		rpm_capture.pending[half] = false;
+	} else {
+		rpm_capture.pending[half] = false;
+		nlr_jump(nlr.ret_val);
+	}
+	return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(rpm_capture_dispatch_obj, rpm_capture_dispatch);
+
+void DMA10_DMA26_IRQHandler(void) {
+	rpm_capture_t *c = &rpm_capture;
+	int half = 0;
+	if (DMA0->TCD[DMA_CH_RPM_CAPTURE].CSR & DMA_CSR_DONE_MASK) {
+		DMA0->CDNE = DMA_CH_RPM_CAPTURE;
+		half = 1;
+	}
+	DMA0->CINT = DMA_CH_RPM_CAPTURE;
+
+	dma_end_read(c->dst + half * (c->len / 2), c->len / 2 * sizeof(uint16_t));
+	if (c->pending[half]) {
+		c->overruns++;
+	} else if (mp_sched_schedule(MP_OBJ_FROM_PTR(&rpm_capture_dispatch_obj), MP_OBJ_NEW_SMALL_INT(half))) {
+		c->pending[half] = true;
+	} else {
+		c->overruns++;
+	}
+	__DSB();
+}
+
+// capture(buf, [callback, [div]]): starts the stream and returns the frequency of the
+// timestamps, the IP bus clock / div. A buffer of None stops it.
+STATIC mp_obj_t pyb_rpm_capture(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+	static const mp_arg_t allowed_args[] = {
+		{ MP_QSTR_buf,      MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+		{ MP_QSTR_callback, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+		{ MP_QSTR_div,      MP_ARG_INT, {.u_int = 128} },
+	};
+	pyb_rpm_obj_t *self = pos_args[0];
+	mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+	mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+	if (args[0].u_obj == mp_const_none) {
+		rpm_capture_end(self);
+		return mp_const_none;
+	}
+	mp_obj_t callback = (args[1].u_obj == mp_const_none) ? MP_OBJ_NULL : args[1].u_obj;
+	return rpm_capture_start(self, args[0].u_obj, callback, args[2].u_int);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(pyb_rpm_capture_obj, 1, pyb_rpm_capture);
+
+// stop(): ends capture(), returns the halves the callback missed.
+STATIC mp_obj_t pyb_rpm_stop(mp_obj_t self_in) {
+	pyb_rpm_obj_t *self = self_in;
+	uint32_t overruns = (rpm_capture.rpm == self) ? rpm_capture.overruns : 0;
+	rpm_capture_end(self);
+	return mp_obj_new_int(overruns);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_rpm_stop_obj, pyb_rpm_stop);
+
 void RPM_TickHandler(void)
 {
 	uint32_t i;
 	uint16_t cntr;
+	if (rpm_capture.rpm)
+		rpm_capture_tick();
 	for(i=0;i<MAX_RPM;i++)
 	{
 		if(pyb_rpm_obj[i].isActive)
@@ -105,6 +348,8 @@ mp_obj_t get_pps(mp_obj_t self_in){
 	mp_hal_delay_ms(self->interval);
 	uint16_t count2 = QTMR_GetCurrentTimerCount(self->tmr_base, self->idex);
 	float speed = (count2-count1)*1.0*1000/self->interval;*/
+	if (rpm_capture.rpm == self)
+		return mp_obj_new_float(rpm_capture_pps());
 	return mp_obj_new_float(self->pps);	
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_get_pps_obj, get_pps);
@@ -120,6 +365,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_get_rpm_obj, get_rpm);
 
 mp_obj_t pyb_rpm_deinit(mp_obj_t self_in){
 	pyb_rpm_obj_t *self = self_in;
+	rpm_capture_end(self);
 	/* Stop the counter */
     QTMR_StopTimer(self->tmr_base, self->idex);
 	QTMR_Deinit(self->tmr_base, self->idex);
@@ -142,6 +388,8 @@ STATIC mp_obj_t pyb_rpm_init_helper(pyb_rpm_obj_t *self, mp_uint_t n_args, const
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 	self->interval = args[0].u_int; self->vtInterval = args[0].u_int; self->pprParam = args[1].u_int;self->prevCntr=0;
+	rpm_capture_end(self);
+	self->isActive = true;
 	capture_init(self);
     return mp_const_none;
 }
@@ -179,6 +427,8 @@ STATIC const mp_rom_map_elem_t rpm_locals_dict_table[] = {
 	{ MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&pyb_rpm_deinit_obj) },
 	{ MP_ROM_QSTR(MP_QSTR_get_pps), MP_ROM_PTR(&pyb_get_pps_obj) },
 	{ MP_ROM_QSTR(MP_QSTR_get_rpm), MP_ROM_PTR(&pyb_get_rpm_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_capture), MP_ROM_PTR(&pyb_rpm_capture_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&pyb_rpm_stop_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(rpm_locals_dict, rpm_locals_dict_table);
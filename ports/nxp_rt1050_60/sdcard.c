@@ -29,6 +29,7 @@
 #include "py/nlr.h"
 #include "py/runtime.h"
 #include "py/mphal.h"
+#include "py/mperrno.h"
 #include "lib/oofatfs/ff.h"
 #include "extmod/vfs_fat.h"
 #include "fsl_debug_console.h"
@@ -67,6 +68,19 @@ typedef sd_card_t SD_HandleTypeDef;
 // g_sd must NOT be put in cacheable RAM
 sd_card_t g_sd;
 
+// FatFS, USB MSC (in the USB IRQ) and the MJPEG recorder thread all queue requests here, the
+// card does them in order. A request is started from this borrowed IRQ rather than from the USDHC
+// completion callback, the USDHC handler still clears the flags of the transfer that just completed
+// after its callback returns. Both run at IRQ_PRI_SDIO so they never preempt each other.
+#define TRIGGER_SDCARD_IRQ()    NVIC->STIR = Reserved169_IRQn
+
+static sdcard_request_t *sdcard_queue_head, *sdcard_queue_tail;
+// The transfer on the card, for the request at the head of the queue.
+static SDMMCHOST_TRANSFER sdcard_xfer;
+static SDMMCHOST_COMMAND sdcard_xfer_command;
+static SDMMCHOST_DATA sdcard_xfer_data;
+static uint32_t sdcard_xfer_blocks;
+
 /*! @brief SDMMC host detect card configuration */
 
 bool s_cardInserted = false;
@@ -233,6 +247,8 @@ status_t sdcard_init(void) {
     status_t error = kStatus_Success;
 
     NVIC_SetPriority(SD_HOST_IRQ, IRQ_PRI_SDIO);
+    NVIC_SetPriority(Reserved169_IRQn, IRQ_PRI_SDIO);
+    NVIC_EnableIRQ(Reserved169_IRQn);   // reserved IRQ is borrowed to start queued transfers
     g_sd.host.base = SD_HOST_BASEADDR;
     g_sd.host.sourceClock_Hz = SD_HOST_CLK_FREQ;
 	g_sd.usrParam.cd = &s_sdCardDetect;
@@ -303,6 +319,7 @@ void sdcard_power_off(void) {
     if (!g_sd.isHostReady) {
         return;
     }
+    sdcard_wait_idle();
     SD_Deinit(&g_sd);
 }
 
@@ -318,42 +335,193 @@ uint64_t sdcard_get_capacity_in_bytes(void) {
 	return (uint64_t)g_sd.blockCount * g_sd.blockSize;
 }
 
-__STATIC_INLINE uint32_t MyNVIC_GetEnabledIRQ(IRQn_Type IRQn)
+// Called with the queue's head request done, from the USDHC or the trigger IRQ.
+static void sdcard_finish(status_t status)
+{
+    sdcard_request_t *req = sdcard_queue_head;
+    sdcard_queue_head = req->next;
+    if (sdcard_queue_head == NULL) {
+        sdcard_queue_tail = NULL;
+    }
+    sdcard_callback_t callback = req->callback;
+    // A waiter may drop the request as soon as it sees the status.
+    req->status = status;
+    if (callback) {
+        callback(req);
+    }
+}
+
+static void sdcard_xfer_done(status_t status, void *userData)
+{
+    sdcard_request_t *req = userData;
+    uint32_t size = sdcard_xfer_blocks * SDCARD_BLOCK_SIZE;
+    sdcard_xfer_blocks = 0;
+    if (!req->write) {
+        dma_end_read(req->buf, size);
+    }
+
+    req->buf += size;
+    req->block_num += size / SDCARD_BLOCK_SIZE;
+    req->num_blocks -= size / SDCARD_BLOCK_SIZE;
+    if ((status != kStatus_Success) || (req->num_blocks == 0)) {
+        sdcard_finish(status);
+    }
+    TRIGGER_SDCARD_IRQ();
+}
+
+// Starts the next transfer of the head request, one CMD18/CMD25 with auto CMD12.
+void sdcard_irq_handler(void)
+{
+    sdcard_request_t *req = sdcard_queue_head;
+    if ((req == NULL) || sdcard_xfer_blocks) {
+        return;
+    }
+
+    uint32_t n = (req->num_blocks < SDCARD_XFER_BLOCKS) ? req->num_blocks : SDCARD_XFER_BLOCKS;
+    if (n > g_sd.host.capability.maxBlockCount) {
+        n = g_sd.host.capability.maxBlockCount;
+    }
+
+    memset(&sdcard_xfer_data, 0, sizeof(sdcard_xfer_data));
+    memset(&sdcard_xfer_command, 0, sizeof(sdcard_xfer_command));
+    sdcard_xfer_data.blockSize = SDCARD_BLOCK_SIZE;
+    sdcard_xfer_data.blockCount = n;
+    sdcard_xfer_data.enableAutoCommand12 = true;
+    if (req->write) {
+        sdcard_xfer_data.txData = (const uint32_t *) req->buf;
+        sdcard_xfer_command.index = (n == 1) ? kSDMMC_WriteSingleBlock : kSDMMC_WriteMultipleBlock;
+    } else {
+        sdcard_xfer_data.rxData = (uint32_t *) req->buf;
+        sdcard_xfer_command.index = (n == 1) ? kSDMMC_ReadSingleBlock : kSDMMC_ReadMultipleBlock;
+    }
+    sdcard_xfer_command.argument = req->block_num;
+    if (!(g_sd.flags & kSD_SupportHighCapacityFlag)) {
+        sdcard_xfer_command.argument *= SDCARD_BLOCK_SIZE;
+    }
+    sdcard_xfer_command.responseType = kCARD_ResponseTypeR1;
+    sdcard_xfer_command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
+    sdcard_xfer.command = &sdcard_xfer_command;
+    sdcard_xfer.data = &sdcard_xfer_data;
+
+    // The card holds DAT0 low while it programs the last write, this is usually over already
+    // since the transfer only completes once the card released the busy after CMD12.
+    while ((GET_SDMMCHOST_STATUS(g_sd.host.base) & CARD_DATA0_STATUS_MASK) != CARD_DATA0_NOT_BUSY) {
+    }
+
+    sdcard_xfer_blocks = n;
+    status_t status = SDMMCHOST_TransferAsync(g_sd.host.base, &sdcard_xfer, sdcard_xfer_done, req);
+    if (status != kStatus_Success) {
+        sdcard_xfer_blocks = 0;
+        sdcard_finish(status);
+        TRIGGER_SDCARD_IRQ();
+    }
+}
+
+int sdcard_submit(sdcard_request_t *req)
+{
+    if ((g_sd.isHostReady == 0) || (req->num_blocks == 0) || ((uint32_t) req->buf & 3)
+    || ((req->block_num + req->num_blocks) > g_sd.blockCount)) {
+        return -1;
+    }
+
+    if (req->write) {
+        dma_begin_write(req->buf, req->num_blocks * SDCARD_BLOCK_SIZE);
+    } else {
+        dma_begin_read(req->buf, req->num_blocks * SDCARD_BLOCK_SIZE);
+    }
+
+    req->next = NULL;
+    req->status = SDCARD_PENDING;
+    mp_uint_t irq_state = disable_irq();
+    if (sdcard_queue_tail) {
+        sdcard_queue_tail->next = req;
+    } else {
+        sdcard_queue_head = req;
+    }
+    sdcard_queue_tail = req;
+    enable_irq(irq_state);
+
+    TRIGGER_SDCARD_IRQ();
+    return 0;
+}
+
+void sdcard_wait_idle(void)
 {
-  return((uint32_t)(((NVIC->ISER[(((uint32_t)(int32_t)IRQn) >> 5UL)] & (1UL << (((uint32_t)(int32_t)IRQn) & 0x1FUL))) != 0UL) ? 1UL : 0UL));
+    while (sdcard_queue_head) {
+        __WFI();
+    }
+}
+
+// Queues the request and waits for it. The USDHC IRQ preempts the USB IRQ MSC calls this from,
+// so USB can stay enabled, and a thread waiting here is switched out like at any other WFI.
+static mp_uint_t sdcard_transfer(uint8_t *buf, uint32_t block_num, uint32_t num_blocks, bool write)
+{
+    sdcard_request_t req = {
+        .buf = buf,
+        .block_num = block_num,
+        .num_blocks = num_blocks,
+        .write = write,
+    };
+    if (sdcard_submit(&req) != 0) {
+        return kStatus_Fail;
+    }
+    #if MICROPY_PY_THREAD
+    // Python threads run meanwhile, FatFs keeps them out of this volume (see fatfs_port.c).
+    if (mp_thread_is_python()) {
+        MP_THREAD_GIL_EXIT();
+        while (req.status == SDCARD_PENDING) {
+            rt_thread_yield();
+            __WFI();
+        }
+        MP_THREAD_GIL_ENTER();
+        return req.status;
+    }
+    #endif
+    while (req.status == SDCARD_PENDING) {
+        __WFI();
+    }
+    return req.status;
 }
 
 mp_uint_t sdcard_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
     // check that SD card is initialised
-    status_t ret;
     if (g_sd.isHostReady == 0) {
         return kStatus_Fail;
     }
-	uint32_t usbIrqEn = MyNVIC_GetEnabledIRQ(USB_OTG1_IRQn);
-	if (usbIrqEn)
-		NVIC_DisableIRQ(USB_OTG1_IRQn);
-	
-	ret = SD_ReadBlocks(&g_sd, dest, block_num, num_blocks);
-	if (usbIrqEn)
-		NVIC_EnableIRQ(USB_OTG1_IRQn);
-    return ret;
+    if (((uint32_t) dest & 3) == 0) {
+        return sdcard_transfer(dest, block_num, num_blocks, false);
+    }
+
+    // ADMA2 needs word aligned buffers, bounce through one on the stack.
+    uint32_t bounce[SDCARD_BLOCK_SIZE / 4];
+    for (uint32_t i = 0; i < num_blocks; i++) {
+        mp_uint_t ret = sdcard_transfer((uint8_t *) bounce, block_num + i, 1, false);
+        if (ret != 0) {
+            return ret;
+        }
+        memcpy(dest + (i * SDCARD_BLOCK_SIZE), bounce, SDCARD_BLOCK_SIZE);
+    }
+    return 0;
 }
 
 mp_uint_t sdcard_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
     // check that SD card is initialised
-    // check that SD card is initialised
-    status_t ret;
     if (g_sd.isHostReady == 0) {
         return kStatus_Fail;
     }
-	uint32_t usbIrqEn = MyNVIC_GetEnabledIRQ(USB_OTG1_IRQn);
-	if (usbIrqEn)
-		NVIC_DisableIRQ(USB_OTG1_IRQn);
-	
-	ret = SD_WriteBlocks(&g_sd, src, block_num, num_blocks);
-	if (usbIrqEn)
-		NVIC_EnableIRQ(USB_OTG1_IRQn);
-    return ret;
+    if (((uint32_t) src & 3) == 0) {
+        return sdcard_transfer((uint8_t *) src, block_num, num_blocks, true);
+    }
+
+    uint32_t bounce[SDCARD_BLOCK_SIZE / 4];
+    for (uint32_t i = 0; i < num_blocks; i++) {
+        memcpy(bounce, src + (i * SDCARD_BLOCK_SIZE), SDCARD_BLOCK_SIZE);
+        mp_uint_t ret = sdcard_transfer((uint8_t *) bounce, block_num + i, 1, true);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    return 0;
 }
 
 /******************************************************************************/
@@ -451,6 +619,47 @@ STATIC mp_obj_t pyb_sdcard_writeblocks(mp_obj_t self, mp_obj_t block_num, mp_obj
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(pyb_sdcard_writeblocks_obj, pyb_sdcard_writeblocks);
 
+// One Python request at a time, its buffer and callback are kept alive in root pointers.
+STATIC sdcard_request_t sd_async_req;
+
+STATIC void sd_async_done(sdcard_request_t *req)
+{
+    mp_obj_t callback = MP_STATE_PORT(sdcard_async_cb);
+    MP_STATE_PORT(sdcard_async_cb) = MP_OBJ_NULL;
+    MP_STATE_PORT(sdcard_async_buf) = MP_OBJ_NULL;
+    if ((callback != MP_OBJ_NULL) && (callback != mp_const_none)) {
+        mp_sched_schedule(callback, mp_obj_new_bool(req->status == kStatus_Success));
+    }
+}
+
+// read_async(block_num, buf, callback): starts reading len(buf) / 512 blocks into buf and returns,
+// callback(ok) is scheduled when they are in.
+STATIC mp_obj_t sd_read_async(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[2], &bufinfo, MP_BUFFER_WRITE);
+    if ((bufinfo.len == 0) || (bufinfo.len % SDCARD_BLOCK_SIZE != 0) || ((uint32_t) bufinfo.buf & 3)) {
+        nlr_raise(mp_obj_new_exception_msg_varg(&mp_type_ValueError, "buffer must be word aligned and a multiple of %d bytes", SDCARD_BLOCK_SIZE));
+    }
+    if (MP_STATE_PORT(sdcard_async_buf) != MP_OBJ_NULL) {
+        mp_raise_OSError(MP_EBUSY);
+    }
+
+    sd_async_req.buf = bufinfo.buf;
+    sd_async_req.block_num = mp_obj_get_int(args[1]);
+    sd_async_req.num_blocks = bufinfo.len / SDCARD_BLOCK_SIZE;
+    sd_async_req.write = false;
+    sd_async_req.callback = sd_async_done;
+    MP_STATE_PORT(sdcard_async_buf) = args[2];
+    MP_STATE_PORT(sdcard_async_cb) = (n_args > 3) ? args[3] : mp_const_none;
+    if (sdcard_submit(&sd_async_req) != 0) {
+        MP_STATE_PORT(sdcard_async_buf) = MP_OBJ_NULL;
+        MP_STATE_PORT(sdcard_async_cb) = MP_OBJ_NULL;
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "sdcard_submit failed"));
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(sd_read_async_obj, 3, 4, sd_read_async);
+
 STATIC mp_obj_t pyb_sdcard_ioctl(mp_obj_t self, mp_obj_t cmd_in, mp_obj_t arg_in) {
     mp_int_t cmd = mp_obj_get_int(cmd_in);
     switch (cmd) {
@@ -486,6 +695,7 @@ STATIC const mp_rom_map_elem_t pyb_sdcard_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_info), MP_ROM_PTR(&sd_info_obj) },
     { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&sd_read_obj) },
     { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&sd_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_read_async), MP_ROM_PTR(&sd_read_async_obj) },
     // block device protocol
     { MP_ROM_QSTR(MP_QSTR_readblocks), MP_ROM_PTR(&pyb_sdcard_readblocks_obj) },
     { MP_ROM_QSTR(MP_QSTR_writeblocks), MP_ROM_PTR(&pyb_sdcard_writeblocks_obj) },
@@ -46,6 +46,31 @@ uint32_t sdcard_get_lba_count(void);
 mp_uint_t sdcard_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks);
 mp_uint_t sdcard_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t num_blocks);
 
+// Requests are done one after the other in the order they were queued, each one by ADMA2
+// transfers of up to SDCARD_XFER_BLOCKS. The blocking calls above queue one and wait for it.
+#define SDCARD_XFER_BLOCKS  (1024)  // 512KB, what the ADMA2 descriptor table chains in one transfer
+#define SDCARD_PENDING      (-1)
+
+typedef struct _sdcard_request_t sdcard_request_t;
+// Called from the USDHC IRQ once status is set.
+typedef void (*sdcard_callback_t)(sdcard_request_t *req);
+struct _sdcard_request_t {
+    sdcard_request_t *next;
+    uint8_t *buf;               // word aligned, left alone until the request is done
+    uint32_t block_num;
+    uint32_t num_blocks;
+    bool write;
+    volatile status_t status;   // SDCARD_PENDING until done, then 0 on success
+    sdcard_callback_t callback; // may be NULL
+    void *arg;
+};
+
+// Queues the request, returns 0 if it was queued (the callback will be called).
+int sdcard_submit(sdcard_request_t *req);
+// Waits for all queued requests.
+void sdcard_wait_idle(void);
+void sdcard_irq_handler(void);
+
 extern const struct _mp_obj_type_t pyb_sdcard_type;
 extern const struct _mp_obj_base_t pyb_sdcard_obj;
 
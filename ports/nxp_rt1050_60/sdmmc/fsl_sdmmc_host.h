@@ -611,7 +611,7 @@ enum _host_capability
  * One ADMA2 table item occupy two words which can transfer maximum 0xFFFFU bytes one time.
  * The more data to be transferred in one time, the bigger value of SDHC_ADMA_TABLE_WORDS need to be set.
  */
-#define USDHC_ADMA_TABLE_WORDS (8U) /* define the ADMA descriptor table length */
+#define USDHC_ADMA_TABLE_WORDS (32U) /* define the ADMA descriptor table length, 16 items chain up to 1MB in one transfer */
 #define USDHC_ADMA2_ADDR_ALIGN (4U) /* define the ADMA2 descriptor table addr align size */
 #define USDHC_READ_BURST_LEN (8U)   /*!< number of words USDHC read in a single burst */
 #define USDHC_WRITE_BURST_LEN (8U)  /*!< number of words USDHC write in a single burst */
@@ -622,6 +622,9 @@ enum _host_capability
 /*! @brief card detect callback definition */
 typedef void (*sdmmchost_cd_callback_t)(bool isInserted, void *userData);
 
+/*! @brief asynchronous transfer complete callback definition, called from the host IRQ */
+typedef void (*sdmmchost_transfer_callback_t)(status_t status, void *userData);
+
 /*! @brief host Endian mode
  * corresponding to driver define
  */
@@ -760,6 +763,20 @@ void SDMMCHOST_Reset(SDMMCHOST_TYPE *base);
  */
 void SDMMCHOST_ErrorRecovery(SDMMCHOST_TYPE *base);
 
+/*!
+ * @brief start a transfer and return without waiting for it.
+ * @param base host base address.
+ * @param content transfer configurations, must stay valid until the callback.
+ * @param callback called once from the host IRQ when the transfer is done or failed.
+ * @param userData passed to callback.
+ * @retval kStatus_Success transfer started, callback will be called.
+ * @retval others transfer not started, callback will not be called.
+ */
+status_t SDMMCHOST_TransferAsync(SDMMCHOST_TYPE *base,
+                                 SDMMCHOST_TRANSFER *content,
+                                 sdmmchost_transfer_callback_t callback,
+                                 void *userData);
+
 /*!
  * @brief Deinit host controller.
  * @param host the pointer to host structure in card structure.
@@ -85,6 +85,9 @@ usdhc_handle_t g_usdhcHandle;
 volatile status_t g_usdhcTransferStatus = kStatus_Success;
 static volatile bool s_sdInsertedFlag   = false;
 volatile status_t g_reTuningFlag        = false;
+/* set only while a transfer started by SDMMCHOST_TransferAsync is in flight */
+static sdmmchost_transfer_callback_t s_usdhcAsyncCallback;
+static void *s_usdhcAsyncUserData;
 
 /*******************************************************************************
  * Code
@@ -164,6 +167,18 @@ static void SDMMCHOST_TransferCompleteCallback(SDMMCHOST_TYPE *base,
     /* if reading data from sdcard, ignore the command error, usdhc will continue transfer data */
     if (!((handle->data) && (handle->data->rxData) && (status == kStatus_USDHC_SendCommandFailed)))
     {
+        if (s_usdhcAsyncCallback)
+        {
+            sdmmchost_transfer_callback_t callback = s_usdhcAsyncCallback;
+            /* clear first, the data error that may follow a command error must not complete it twice */
+            s_usdhcAsyncCallback = NULL;
+            if (status != kStatus_Success)
+            {
+                SDMMCHOST_ErrorRecovery(base);
+            }
+            callback(status, s_usdhcAsyncUserData);
+            return;
+        }
         SDMMCEVENT_Notify(kSDMMCEVENT_TransferComplete);
     }
     /* wait the target status and then notify the transfer complete */
@@ -225,6 +240,42 @@ static status_t SDMMCHOST_TransferFunction(SDMMCHOST_TYPE *base, SDMMCHOST_TRANS
     return error;
 }
 
+status_t SDMMCHOST_TransferAsync(SDMMCHOST_TYPE *base,
+                                 SDMMCHOST_TRANSFER *content,
+                                 sdmmchost_transfer_callback_t callback,
+                                 void *userData)
+{
+    status_t error = kStatus_Success;
+    usdhc_adma_config_t dmaConfig;
+
+    assert(content->data != NULL);
+
+    memset(&dmaConfig, 0, sizeof(usdhc_adma_config_t));
+    /* config adma, the whole buffer is one descriptor chain */
+    dmaConfig.dmaMode = USDHC_DMA_MODE;
+#if !(defined(FSL_FEATURE_USDHC_HAS_NO_RW_BURST_LEN) && FSL_FEATURE_USDHC_HAS_NO_RW_BURST_LEN)
+    dmaConfig.burstLen = kUSDHC_EnBurstLenForINCR;
+#endif
+    dmaConfig.admaTable      = g_usdhcAdma2Table;
+    dmaConfig.admaTableWords = USDHC_ADMA_TABLE_WORDS;
+
+    /* the IRQ may complete the transfer before USDHC_TransferNonBlocking returns */
+    s_usdhcAsyncUserData = userData;
+    s_usdhcAsyncCallback = callback;
+
+    do
+    {
+        error = USDHC_TransferNonBlocking(base, &g_usdhcHandle, &dmaConfig, content);
+    } while (error == kStatus_USDHC_BusyTransferring);
+
+    if (error != kStatus_Success)
+    {
+        s_usdhcAsyncCallback = NULL;
+    }
+
+    return error;
+}
+
 void SDMMCHOST_ErrorRecovery(SDMMCHOST_TYPE *base)
 {
     uint32_t status = 0U;
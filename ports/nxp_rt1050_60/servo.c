@@ -3,6 +3,7 @@
 #include "py/nlr.h"
 #include "py/runtime.h"
 #include "py/mphal.h"
+#include "py/binary.h"
 #include "fsl_xbara.h"
 #include "servo.h"
 #include "genhdr/pins.h"
@@ -73,6 +74,46 @@ void ServoSetupQTmr(pyb_servo_obj_t *pObj) {
 	QTMR_EnableInterrupts(pObj->tmr_base, pObj->idex, kQTMR_Compare2InterruptEnable);
 }
 
+STATIC mp_obj_t servo_trajectory_dispatch(mp_obj_t arg_in);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(servo_trajectory_dispatch_obj, servo_trajectory_dispatch);
+
+// The next pulse of trajectory(), into the preload registers only: the timer takes it at
+// its next compares, so it goes out with the next period wherever in this one the IRQ ran.
+// At the end of each half the callback is scheduled, without one the last pulse stays.
+STATIC void ServoTrajectoryStep(pyb_servo_obj_t *s)
+{
+	servo_config_obj_t *p = &s->servo_obj;
+	uint32_t ndx = p->trajNdx;
+	int32_t cnt = (int32_t)((uint64_t)p->trajUs[ndx] * p->qtmrPeriodCnt / 20000);
+	if (cnt > p->tmrHighAllowedMax) {
+		cnt = p->tmrHighAllowedMax;
+	} else if (cnt < p->tmrHighAllowedMin) {
+		cnt = p->tmrHighAllowedMin;
+	}
+	p->tmrHighFrom = p->tmrHighTo = p->tmrHighNow = cnt;
+	s->tmr_base->CHANNEL[s->idex].CMPLD1 = (uint16_t)(p->qtmrPeriodCnt - cnt);
+	s->tmr_base->CHANNEL[s->idex].CMPLD2 = (uint16_t)cnt;
+
+	ndx++;
+	if (ndx == p->trajLen || ndx == p->trajLen / 2) {
+		int half = (ndx == p->trajLen);
+		if (MP_STATE_PORT(servo_traj_cb)[s - pyb_servo_obj] == MP_OBJ_NULL) {
+			if (half) {
+				p->trajUs = NULL;
+				QTMR_DisableInterrupts(s->tmr_base, s->idex, kQTMR_Compare2InterruptEnable);
+			}
+		} else if (p->trajPending[half]) {
+			p->trajOverruns++;
+		} else if (mp_sched_schedule(MP_OBJ_FROM_PTR(&servo_trajectory_dispatch_obj),
+				MP_OBJ_NEW_SMALL_INT(((s - pyb_servo_obj) << 1) | half))) {
+			p->trajPending[half] = true;
+		} else {
+			p->trajOverruns++;
+		}
+	}
+	p->trajNdx = (ndx == p->trajLen) ? 0 : ndx;
+}
+
 #define USE_INT_CODE (0)
 uint32_t _g_Vtimer;
 uint32_t g_scale = 16;
@@ -85,7 +126,15 @@ void servo_timer_irq_callback(void) {
 		uint16_t reg = s->tmr_base->CHANNEL[s->idex].CSCTRL;
 		p = &s->servo_obj;
 		//check if the timer channel is active, and if the interrupt in this channel is occur
-		if(s->isActive && p->periodNdx < p->periodCnt)
+		if (s->isActive && p->trajUs)
+		{
+			// both modules' IRQs come here, only step on our own compare
+			if (QTMR_GetStatus(s->tmr_base, s->idex) & kQTMR_Compare2Flag) {
+				QTMR_ClearStatusFlags(s->tmr_base, s->idex, kQTMR_Compare2Flag);
+				ServoTrajectoryStep(s);
+			}
+		}
+		else if(s->isActive && p->periodNdx < p->periodCnt)
 		{
 			QTMR_ClearStatusFlags(s->tmr_base, s->idex, kQTMR_Compare2Flag);
 			p->periodNdx++;
@@ -258,8 +307,52 @@ void servo_init0()
 
 #define ANGLE_TO_DUTY_PERCENT(angle, offset, scale) (((angle) / 180.0f * (scale) + (offset)) / 20.0f * 100.0f)
 
+STATIC void ServoTrajectoryEnd(pyb_servo_obj_t *self)
+{
+	servo_config_obj_t *p = &self->servo_obj;
+	if (p->trajUs == NULL) {
+		return;
+	}
+	NVIC_DisableIRQ(self->IRQn);
+	p->trajUs = NULL;
+	QTMR_DisableInterrupts(self->tmr_base, self->idex, kQTMR_Compare2InterruptEnable);
+	NVIC_EnableIRQ(self->IRQn);
+	MP_STATE_PORT(servo_traj_buf)[self - pyb_servo_obj] = MP_OBJ_NULL;
+	MP_STATE_PORT(servo_traj_cb)[self - pyb_servo_obj] = MP_OBJ_NULL;
+}
+
+void servo_trajectory_stop(void)
+{
+	for (int i = 0; i < SERVO_NUM; i++) {
+		ServoTrajectoryEnd(&pyb_servo_obj[i]);
+	}
+}
+
+// Scheduled per half that was used, which counts as overrun if it is due again before
+// this returns.
+STATIC mp_obj_t servo_trajectory_dispatch(mp_obj_t arg_in)
+{
+	mp_int_t arg = MP_OBJ_SMALL_INT_VALUE(arg_in);
+	int half = arg & 1;
+	servo_config_obj_t *p = &pyb_servo_obj[arg >> 1].servo_obj;
+	mp_obj_t callback = MP_STATE_PORT(servo_traj_cb)[arg >> 1];
+	nlr_buf_t nlr;
+	if (nlr_push(&nlr) == 0) {
+		if (callback != MP_OBJ_NULL) {
+			mp_call_function_1(callback, MP_OBJ_NEW_SMALL_INT(half));
+		}
+		nlr_pop();
+		p->trajPending[half] = false;
+	} else {
+		p->trajPending[half] = false;
+		nlr_jump(nlr.ret_val);
+	}
+	return mp_const_none;
+}
+
 mp_obj_t pyb_servo_deinit(mp_obj_t self_in){
 	pyb_servo_obj_t *self = self_in;
+	ServoTrajectoryEnd(self);
 	/* Stop the qtimer */
 	QTMR_StopTimer(self->tmr_base, self->idex);
 	QTMR_Deinit(self->tmr_base, self->idex);
@@ -300,6 +393,7 @@ STATIC mp_obj_t pyb_servo_make_new(const mp_obj_type_t *type, size_t n_args, siz
 	if (n_args >= 2) {
 		dgrOrDps = mp_obj_get_float(args[1]);
 	}
+	ServoTrajectoryEnd(s);
 	memset(&s->servo_obj, 0, sizeof(s->servo_obj));
 	init_servo_config(&s->servo_obj);
 	init_servo(s);
@@ -503,12 +597,61 @@ STATIC mp_obj_t pyb_servo_speed(size_t n_args, const mp_obj_t *args) {
 
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pyb_servo_speed_obj, 1, 3, pyb_servo_speed);
 
+/// \method trajectory(buf, [callback])
+/// Move through the pulse widths in us of buf, an array of 16-bit values, one per period
+/// (20ms) and within the calibration's us_min and us_max. The timer's IRQ hands them over,
+/// Python is not involved per period. Without callback buf plays once and the last pulse
+/// stays. With one it plays over and over and callback(half) is scheduled each time a half
+/// of buf was used and can be refilled. trajectory(None) stops it and returns the number of
+/// halves that were due again before their callback returned. Servos 1-4.
+STATIC mp_obj_t pyb_servo_trajectory(size_t n_args, const mp_obj_t *args) {
+	pyb_servo_obj_t *self = args[0];
+	servo_config_obj_t *p = &self->servo_obj;
+	uint32_t id = self - pyb_servo_obj;
+	if (args[1] == mp_const_none) {
+		uint32_t overruns = p->trajOverruns;
+		ServoTrajectoryEnd(self);
+		return mp_obj_new_int(overruns);
+	}
+	if (id >= SERVO_NUM) {
+		nlr_raise(mp_obj_new_exception_msg_varg(&mp_type_ValueError, "servo %d can't play a trajectory", id + 1));
+	}
+	mp_obj_t callback = (n_args >= 3 && args[2] != mp_const_none) ? args[2] : MP_OBJ_NULL;
+	mp_buffer_info_t bufinfo;
+	mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_READ);
+	if (mp_binary_get_size('@', bufinfo.typecode, NULL) != sizeof(uint16_t)) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "need an array of 16-bit values"));
+	}
+	size_t len = bufinfo.len / sizeof(uint16_t);
+	if (len == 0 || (callback != MP_OBJ_NULL && (len & 1))) {
+		nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "buffer must hold an even number of values"));
+	}
+
+	// ends a move of angle() as well
+	NVIC_DisableIRQ(self->IRQn);
+	MP_STATE_PORT(servo_traj_buf)[id] = args[1];
+	MP_STATE_PORT(servo_traj_cb)[id] = callback;
+	p->periodCnt = p->periodNdx = 0;
+	p->trajUs = bufinfo.buf;
+	p->trajLen = len;
+	p->trajNdx = 0;
+	p->trajPending[0] = p->trajPending[1] = false;
+	p->trajOverruns = 0;
+	ServoTrajectoryStep(self);
+	ServoSetupQTmr(self);
+	QTMR_StartTimer(self->tmr_base, self->idex, kQTMR_PriSrcRiseEdge);
+	NVIC_EnableIRQ(self->IRQn);
+	return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pyb_servo_trajectory_obj, 2, 3, pyb_servo_trajectory);
+
 STATIC const mp_rom_map_elem_t servo_locals_dict_table[] = {
 	{ MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&pyb_servo_deinit_obj) },
 	{ MP_ROM_QSTR(MP_QSTR_angle), MP_ROM_PTR(&pyb_servo_angle_obj) },
 	{ MP_ROM_QSTR(MP_QSTR_calibration), MP_ROM_PTR(&pyb_servo_calibration_obj) },
 	{ MP_ROM_QSTR(MP_QSTR_speed), MP_ROM_PTR(&pyb_servo_speed_obj) },
 	{ MP_ROM_QSTR(MP_QSTR_pulse_width), MP_ROM_PTR(&pyb_servo_width_obj) },
+	{ MP_ROM_QSTR(MP_QSTR_trajectory), MP_ROM_PTR(&pyb_servo_trajectory_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(servo_locals_dict, servo_locals_dict_table);
@@ -58,6 +58,13 @@ typedef struct _servo_config_obj_t {
 	volatile int32_t tmrHighTo;
 	volatile int32_t periodCnt;	// how many periods to complete this move
 	volatile int32_t periodNdx;	// how many periods already elapsed	
+	// ------------------
+	// trajectory(), the buffer and callback are in MP_STATE_PORT(servo_traj_buf/cb)
+	const uint16_t *trajUs;	// pulse widths in us, one per period, NULL when not playing
+	uint32_t trajLen;
+	volatile uint32_t trajNdx;	// next one to go out
+	volatile bool trajPending[2];	// callback of the half scheduled
+	uint32_t trajOverruns;
 } servo_config_obj_t;
 
 typedef struct _servo_obj_t{
@@ -75,5 +82,7 @@ typedef struct _servo_obj_t{
 	servo_config_obj_t servo_obj;
 } pyb_servo_obj_t;
 void servo_init0();
+// ends the trajectories, called on soft reset
+void servo_trajectory_stop(void);
 extern const mp_obj_type_t pyb_servo_type;
 MP_DECLARE_CONST_FUN_OBJ_2(pyb_servo_set_obj);
\ No newline at end of file
@@ -30,6 +30,7 @@
 #include "fsl_common.h"
 #include "fsl_debug_console.h"
 #include "fsl_clock.h"
+#include "fsl_dmamux.h"
 
 #include "py/nlr.h"
 #include "py/runtime.h"
@@ -219,6 +220,12 @@ void spi_init(pyb_spi_obj_t *self)
 
 void spi_deinit(pyb_spi_t ndx) {
 	pyb_spi_obj_t *pOb = pyb_spi_obj + ndx;
+	if (pOb->isDmaReady) {
+		spi_dma_abort(ndx);
+		DMAMUX_DisableChannel(DMAMUX, DMA_CH_LPSPI_RX(ndx));
+		DMAMUX_DisableChannel(DMAMUX, DMA_CH_LPSPI_TX(ndx));
+		pOb->isDmaReady = false;
+	}
 	LPSPI_Deinit(pOb->pSPI);
 	CLOCK_DisableClock(pOb->myClock);
 	NVIC_DisableIRQ(pOb->irqn);
@@ -231,6 +238,141 @@ void spi_deinit(pyb_spi_t ndx) {
     return HAL_OK;
 }
 
+// Queued eDMA transfers. Each bus has a ring of descriptors, the head one is on the bus and
+// its completion IRQ retires it and starts the next, so a display frame or a stream of
+// packets goes out back to back while the CPU does something else. The SDK driver only
+// does one transfer at a time, the ring is what chains them.
+static const uint16_t spi_dma_request[][2] = {
+	{0, 0},
+	{kDmaRequestMuxLPSPI1Rx, kDmaRequestMuxLPSPI1Tx},
+	{kDmaRequestMuxLPSPI2Rx, kDmaRequestMuxLPSPI2Tx},
+	{kDmaRequestMuxLPSPI3Rx, kDmaRequestMuxLPSPI3Tx},
+	{kDmaRequestMuxLPSPI4Rx, kDmaRequestMuxLPSPI4Tx},
+};
+
+STATIC void spi_dma_run(pyb_spi_obj_t *self);
+
+STATIC void spi_dma_retire(pyb_spi_obj_t *self, status_t st) {
+	spi_dma_desc_t *d = self->dmaQueue + self->dmaHead % SPI_DMA_QUEUE_LEN;
+	spi_dma_callback_t done = d->done;
+	void *arg = d->arg;
+
+	if (d->cs && (d->flags & SPI_DMA_CS_RELEASE))
+		mp_hal_pin_high(d->cs);
+	if (d->rx)
+		dma_end_read(d->rx, d->len);
+	self->dmaHead++;
+	// the next one goes out while this one is called back, which may queue more
+	spi_dma_run(self);
+	if (done)
+		done(arg, st);
+}
+
+STATIC void spi_dma_start(pyb_spi_obj_t *self) {
+	spi_dma_desc_t *d = self->dmaQueue + self->dmaHead % SPI_DMA_QUEUE_LEN;
+	lpspi_transfer_t xfer = {
+		.txData = (uint8_t*) d->tx,
+		.rxData = d->rx,
+		.dataSize = d->len,
+		.configFlags = 0,
+	};
+	status_t st;
+
+	if (d->dc) {
+		if (d->flags & SPI_DMA_DC_HIGH)
+			mp_hal_pin_high(d->dc);
+		else
+			mp_hal_pin_low(d->dc);
+	}
+	if (d->cs && (d->flags & SPI_DMA_CS_ASSERT))
+		mp_hal_pin_low(d->cs);
+	// the previous transfer is done with the bus once the DMA is, but not the shifter
+	while (LPSPI_GetStatusFlags(self->pSPI) & kLPSPI_ModuleBusyFlag) {}
+
+	self->isDmaBusy = true;
+	st = LPSPI_MasterTransferEDMA(self->pSPI, &self->hMstDma, &xfer);
+	if (st != kStatus_Success) {
+		self->isDmaBusy = false;
+		spi_dma_retire(self, st);
+	}
+}
+
+STATIC void spi_dma_run(pyb_spi_obj_t *self) {
+	while (!self->isDmaBusy && self->dmaHead != self->dmaTail)
+		spi_dma_start(self);
+}
+
+STATIC void spi_dma_callback(LPSPI_Type *base, lpspi_master_edma_handle_t *handle, status_t status, void *userData) {
+	pyb_spi_obj_t *self = userData;
+	while (LPSPI_GetStatusFlags(base) & kLPSPI_ModuleBusyFlag) {}
+	self->isDmaBusy = false;
+	spi_dma_retire(self, status);
+}
+
+STATIC void spi_dma_init(pyb_spi_obj_t *self) {
+	uint32_t chRx = DMA_CH_LPSPI_RX(self->ndx), chTx = DMA_CH_LPSPI_TX(self->ndx);
+
+	dma_edma_init();
+	DMAMUX_SetSource(DMAMUX, chRx, spi_dma_request[self->ndx][0]);
+	DMAMUX_EnableChannel(DMAMUX, chRx);
+	DMAMUX_SetSource(DMAMUX, chTx, spi_dma_request[self->ndx][1]);
+	DMAMUX_EnableChannel(DMAMUX, chTx);
+	EDMA_CreateHandle(&self->hDmaRx, DMA0, chRx);
+	EDMA_CreateHandle(&self->hDmaTx, DMA0, chTx);
+	LPSPI_MasterTransferCreateHandleEDMA(self->pSPI, &self->hMstDma, spi_dma_callback, self,
+		&self->hDmaRx, &self->hDmaTx);
+	// the RX channel completes the transfer
+	NVIC_SetPriority(DMA0_DMA16_IRQn + chRx, IRQ_PRI_DMA);
+	NVIC_SetPriority(DMA0_DMA16_IRQn + chTx, IRQ_PRI_DMA);
+	self->dmaHead = self->dmaTail = 0;
+	self->isDmaBusy = false;
+	self->isDmaReady = true;
+}
+
+bool spi_dma_queue(pyb_spi_t ndx, const spi_dma_desc_t *desc) {
+	pyb_spi_obj_t *self = pyb_spi_obj + ndx;
+
+	if (!self->isDmaReady)
+		spi_dma_init(self);
+	if (desc->tx)
+		dma_begin_write(desc->tx, desc->len);
+	if (desc->rx)
+		dma_begin_read(desc->rx, desc->len);
+
+	mp_uint_t irq_state = disable_irq();
+	if ((uint8_t)(self->dmaTail - self->dmaHead) >= SPI_DMA_QUEUE_LEN) {
+		enable_irq(irq_state);
+		return false;
+	}
+	self->dmaQueue[self->dmaTail % SPI_DMA_QUEUE_LEN] = *desc;
+	self->dmaTail++;
+	spi_dma_run(self);
+	enable_irq(irq_state);
+	return true;
+}
+
+uint32_t spi_dma_pending(pyb_spi_t ndx) {
+	pyb_spi_obj_t *self = pyb_spi_obj + ndx;
+	return (uint8_t)(self->dmaTail - self->dmaHead);
+}
+
+void spi_dma_wait(pyb_spi_t ndx, uint32_t n) {
+	while (spi_dma_pending(ndx) > n) {
+		__WFI();
+	}
+}
+
+void spi_dma_abort(pyb_spi_t ndx) {
+	pyb_spi_obj_t *self = pyb_spi_obj + ndx;
+	if (!self->isDmaReady)
+		return;
+	mp_uint_t irq_state = disable_irq();
+	LPSPI_MasterTransferAbortEDMA(self->pSPI, &self->hMstDma);
+	self->isDmaBusy = false;
+	self->dmaHead = self->dmaTail;
+	enable_irq(irq_state);
+}
+
 // A transfer of "len" bytes should take len*8*1000/baudrate milliseconds.
 // To simplify the calculation we assume the baudrate is never less than 8kHz
 // and use that value for the baudrate in the formula, plus a small constant.
@@ -267,6 +409,8 @@ void spi_transfer(pyb_spi_t ndx, size_t txLen, const uint8_t *src, size_t rxLen,
 	pyb_spi_obj_t *self = pyb_spi_obj + ndx;
     status_t st = kStatus_Success;
 
+	// behind whatever is queued
+	spi_dma_wait(ndx, 0);
 	// first , we send
 	if (isCtrlSSEL)
 		mp_hal_pin_low(self->pSSEL);
@@ -358,6 +502,14 @@ STATIC void pyb_spi_print(const mp_print_t *print, mp_obj_t self_in, mp_print_ki
     spi_print(print, self, true);
 }
 
+void spi_init_master(pyb_spi_t ndx, uint32_t baudrate, uint32_t polarity, uint32_t phase) {
+	pyb_spi_obj_t *self = pyb_spi_obj + ndx;
+	LPSPI_MasterGetDefaultConfig(&self->mstCfg);
+	spi_set_params(self, baudrate, polarity, phase, 8, 0);
+	spi_init(self);
+	self->flags |= SPI_OBJ_FLAG_ENABLED;
+}
+
 bool pyb_spi_init_c(pyb_spi_t ndx, mp_arg_val_t args[]) {
 	pyb_spi_obj_t *self = pyb_spi_obj + ndx;
     if (args[10].u_obj != mp_const_none) {
@@ -67,6 +67,27 @@ typedef enum {
 #define SPI_OBJ_FLAG_CPHA		3
 #define SPI_OBJ_FLAG_CPOL		4
 
+// Queued eDMA transfers, see spi_dma_queue().
+#define SPI_DMA_QUEUE_LEN		8
+#define SPI_DMA_MAX_LEN			32767	// eDMA major loop count, one iteration per byte
+
+#define SPI_DMA_CS_ASSERT		1	// pull cs low before the transfer
+#define SPI_DMA_CS_RELEASE		2	// and let it go high after
+#define SPI_DMA_DC_HIGH			4	// dc high for the transfer, else low
+
+typedef void (*spi_dma_callback_t)(void *arg, status_t status);
+
+typedef struct _spi_dma_desc_t {
+	const uint8_t *tx;		// NULL clocks out zeros
+	uint8_t *rx;			// NULL drops what comes in
+	uint32_t len;			// at most SPI_DMA_MAX_LEN
+	const pin_obj_t *cs;	// NULL to leave chip select alone
+	const pin_obj_t *dc;	// NULL for no data/command line
+	uint32_t flags;
+	spi_dma_callback_t done;	// in the DMA IRQ when the transfer is over, or NULL
+	void *arg;
+} spi_dma_desc_t;
+
 typedef struct _pyb_spi_obj_t {
     mp_obj_base_t base;
     LPSPI_Type *pSPI;
@@ -84,10 +105,17 @@ typedef struct _pyb_spi_obj_t {
 	const pin_obj_t *pMISO;	
 	const pin_obj_t *pMOSI;
 	lpspi_master_config_t mstCfg;
-	// lpspi_edma_handle_t hMstDma;
 	lpspi_slave_config_t slvCfg;
+	// eDMA transfers, a ring of descriptors whose head is on the bus
+	bool isDmaReady;
+	volatile bool isDmaBusy;	// the head is on the bus
+	volatile uint8_t dmaHead, dmaTail;	// free running, the queue is empty when equal
+	spi_dma_desc_t dmaQueue[SPI_DMA_QUEUE_LEN];
+	lpspi_master_edma_handle_t hMstDma;
+	edma_handle_t hDmaRx, hDmaTx;
 } pyb_spi_obj_t;
 
+extern pyb_spi_obj_t pyb_spi_obj[];
 extern const mp_obj_type_t pyb_spi_type;
 extern const mp_obj_type_t mp_machine_soft_spi_type;
 extern const mp_obj_type_t machine_hard_spi_type;
@@ -99,5 +127,19 @@ void spi_init(pyb_spi_obj_t *self);
 bool pyb_spi_init_c(pyb_spi_t ndx, mp_arg_val_t args[]);
 void spi_transfer(pyb_spi_t ndx, size_t txLen, const uint8_t *src, size_t rxLen, uint8_t *dest, uint32_t timeout, bool isCtrlSSEL);
 void spi_deinit(pyb_spi_t ndx);
+// Inits the bus as master for drivers in C, 8-bit frames MSB first.
+void spi_init_master(pyb_spi_t ndx, uint32_t baudrate, uint32_t polarity, uint32_t phase);
+
+// Queues a copy of desc behind the transfers already queued on the bus, started from the
+// DMA IRQ of the one before, so a chain of them runs without the CPU. The buffers must stay
+// valid until the transfer is done. Returns false if the queue is full.
+bool spi_dma_queue(pyb_spi_t ndx, const spi_dma_desc_t *desc);
+// Waits until at most n transfers are queued, 0 for the bus to be idle.
+void spi_dma_wait(pyb_spi_t ndx, uint32_t n);
+// Transfers queued and not done yet.
+uint32_t spi_dma_pending(pyb_spi_t ndx);
+// Stops the transfer on the bus and drops the queue without calling back, chip select of the
+// one on the bus is left as it is.
+void spi_dma_abort(pyb_spi_t ndx);
 
 int *spi_get_handle(mp_obj_t o);
@@ -2,6 +2,7 @@
 #include "py/nlr.h"
 #include "py/runtime.h"
 #include "py/mphal.h"
+#include "py/objtuple.h"
 #include "srpm.h"
 #include "genhdr/pins.h"
 
@@ -48,29 +49,46 @@ mp_obj_t scapture_init(pyb_srpm_obj_t *self_in){
 	
 }
 
+// The position with the counts since the last tick, call with the IRQs off.
+STATIC int32_t srpm_position(pyb_srpm_obj_t *self) {
+	int16_t cntr = (int16_t) QTMR_GetCurrentTimerCount(self->tmr_base, self->idex[0]);
+	return self->position + (int16_t)(cntr - self->prevCntr);
+}
+
 mp_obj_t get_scount(mp_obj_t self_in){
 	pyb_srpm_obj_t *self = self_in;
-	qtmr_channel_selection_t idex = self->idex[0]; // or self->idex[1] is fine too
-	int16_t count = (int16_t) QTMR_GetCurrentTimerCount(self->tmr_base, idex);
-	return mp_obj_new_int(count);			//mp_obj_new_int_from_uint   return mp_obj_new_int(count);	
+	mp_uint_t irq_state = disable_irq();
+	int32_t count = srpm_position(self);
+	enable_irq(irq_state);
+	return mp_obj_new_int(count);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(get_count_obj, get_scount);
 
+// The quadrature count is 16 bits, extended here every ms: it wraps only above 32767 counts
+// per ms. A velocity window closes once it is interval ms long and saw SRPM_MIN_COUNTS
+// counts, or after SRPM_MAX_WINDOWS intervals without, so a slow shaft still reads its
+// speed rather than 0 or 1 count per interval.
+#define SRPM_MIN_COUNTS		(4)
+#define SRPM_MAX_WINDOWS	(8)
+
 void SRPM_TickHandler(void)
 {
 	uint32_t i;
-	int16_t cntr;
 	for(i=0;i<MAX_SRPM;i++)
 	{
-		if(pyb_srpm_obj[i].isActive)
+		pyb_srpm_obj_t *s = &pyb_srpm_obj[i];
+		if(s->isActive)
 		{
-			if(--pyb_srpm_obj[i].vtInterval==0)
+			int16_t cntr = (int16_t) QTMR_GetCurrentTimerCount(s->tmr_base, s->idex[0]);
+			s->position += (int16_t)(cntr - s->prevCntr);
+			s->prevCntr = cntr;
+			int32_t delta = s->position - s->winPos;
+			if (++s->winMs >= s->interval &&
+				(delta >= SRPM_MIN_COUNTS || delta <= -SRPM_MIN_COUNTS || s->winMs >= s->interval * SRPM_MAX_WINDOWS))
 			{
-				qtmr_channel_selection_t idex = pyb_srpm_obj[i].idex[0]; // or self->idex[1] is fine too
-				cntr = (int16_t) QTMR_GetCurrentTimerCount(pyb_srpm_obj[i].tmr_base, idex);
-				pyb_srpm_obj[i].spps=(cntr - pyb_srpm_obj[i].prevCntr)*1.0*1000/pyb_srpm_obj[i].interval;
-				pyb_srpm_obj[i].prevCntr = cntr;
-				pyb_srpm_obj[i].vtInterval = pyb_srpm_obj[i].interval;
+				s->spps = delta * 1000.0f / s->winMs;
+				s->winPos = s->position;
+				s->winMs = 0;
 			}
 		}
 	}
@@ -118,8 +136,12 @@ STATIC mp_obj_t pyb_srpm_init_helper(pyb_srpm_obj_t *self, mp_uint_t n_args, con
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
-	self->interval = args[0].u_int; self->vtInterval = args[0].u_int; self->pprParam = args[1].u_int;self->prevCntr=0;
+	self->isActive = false;
+	self->interval = args[0].u_int; self->pprParam = args[1].u_int;
 	scapture_init(self);
+	self->prevCntr = (int16_t) QTMR_GetCurrentTimerCount(self->tmr_base, self->idex[0]);
+	self->position = 0; self->winPos = 0; self->winMs = 0; self->spps = 0;
+	self->isActive = true;
     return mp_const_none;
 }
 STATIC mp_obj_t pyb_srpm_init(mp_uint_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
@@ -160,10 +182,57 @@ STATIC const mp_rom_map_elem_t srpm_locals_dict_table[] = {
 
 STATIC MP_DEFINE_CONST_DICT(srpm_locals_dict, srpm_locals_dict_table);
 
+// position (counts, can be set), velocity (counts/s) and state, the two of them from one
+// moment: a control loop reads what it needs with one attribute access and no call.
+STATIC void pyb_srpm_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+	pyb_srpm_obj_t *self = self_in;
+	if (dest[0] == MP_OBJ_SENTINEL) {
+		if (attr == MP_QSTR_position && dest[1] != MP_OBJ_NULL) {
+			int32_t position = mp_obj_get_int(dest[1]);
+			mp_uint_t irq_state = disable_irq();
+			self->winPos += position - srpm_position(self);
+			self->position = position;
+			self->prevCntr = (int16_t) QTMR_GetCurrentTimerCount(self->tmr_base, self->idex[0]);
+			enable_irq(irq_state);
+			dest[0] = MP_OBJ_NULL;
+		}
+		return;
+	}
+	if (dest[0] != MP_OBJ_NULL) {
+		return;
+	}
+	mp_uint_t irq_state = disable_irq();
+	int32_t position = srpm_position(self);
+	float velocity = self->spps;
+	enable_irq(irq_state);
+	switch (attr) {
+		case MP_QSTR_position:
+			dest[0] = mp_obj_new_int(position);
+			break;
+		case MP_QSTR_velocity:
+			dest[0] = mp_obj_new_float(velocity);
+			break;
+		case MP_QSTR_state: {
+			mp_obj_t items[2] = { mp_obj_new_int(position), mp_obj_new_float(velocity) };
+			dest[0] = mp_obj_new_tuple(2, items);
+			break;
+		}
+		default: {
+			// With .attr the methods aren't looked up in locals_dict for us.
+			mp_map_elem_t *elem = mp_map_lookup((mp_map_t *)&srpm_locals_dict.map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+			if (elem != NULL) {
+				mp_convert_member_lookup(self_in, &pyb_srpm_type, elem->value, dest);
+			}
+			break;
+		}
+	}
+}
+
 const mp_obj_type_t pyb_srpm_type = {
     { &mp_type_type },
     .name = MP_QSTR_SRPM,
 	.print = pyb_srpm_print,
 	.make_new = pyb_srpm_make_new,
+	.attr = pyb_srpm_attr,
     .locals_dict = (mp_obj_dict_t*)&srpm_locals_dict,
 };
\ No newline at end of file
@@ -18,9 +18,13 @@ typedef struct _srpm_obj_t{
 	bool isActive;
 	uint16_t pprParam;
 	uint16_t interval;
-	uint16_t vtInterval;
 	int16_t prevCntr;
 	volatile float spps;
+	// SRPM_TickHandler() extends the 16-bit count to position every ms and estimates
+	// spps from a window of at least interval ms
+	volatile int32_t position;
+	int32_t winPos;
+	uint16_t winMs;
 	const pin_obj_t *pin[2];
 } pyb_srpm_obj_t;
 void srpm_init0();
@@ -47,7 +47,8 @@
 #endif
 
 #if 1 // USE_INTERNAL
-	uint64_t s_c8FlhCache[FLEG_PAGE_SIZE / 8];	
+	uint64_t s_c8FlhCache[STORAGE_CACHE_BLOCKS][FLEG_PAGE_SIZE / 8];
+	static uint64_t s_c8FlhRun[STORAGE_CACHE_BLOCKS][FLEG_PAGE_SIZE / 8];	// a dirty run gathered for one FTL write
 	FlegDevice_t s_dev;
 	#if 1 // defined(LPC54608) 
 		#define CACHE_MEM_START_ADDR (s_c8FlhCache) // CCM data RAM, 64k
@@ -71,8 +72,19 @@
 	#define FLASH_FLAG_ERASED       (4)
 	static bool flash_is_initialised = false;
 	static __IO uint8_t flash_flags = 0;
-	static uint32_t flash_cache_lba_id;
 	static uint32_t flash_tick_counter_last_write;
+	// cache slot of s_c8FlhCache, block 0 is the fake MBR and never cached, so a 0 lba is a free slot
+	typedef struct _flash_cache_t {
+		uint32_t lba;
+		uint32_t tick;	// last access, the least recently used slot is evicted
+		uint8_t dirty;
+		uint8_t fat;	// holds a FAT sector
+	} flash_cache_t;
+	static flash_cache_t flash_cache[STORAGE_CACHE_BLOCKS];
+	static uint32_t flash_cache_tick;
+	static uint32_t flash_fat_start, flash_fat_end;	// FAT sectors, from the boot sector of the partition
+	static volatile uint32_t flash_ftl_busy;
+	static uint32_t flash_tick_last_access;
 
 	static void flash_cache_flush(void) {
 		if (flash_flags & FLASH_FLAG_DIRTY) {
@@ -113,18 +125,29 @@ void storage_init(void) {
     if (!flash_is_initialised) {
         #if USE_INTERNAL
 	        flash_flags = 0;
-	        flash_cache_lba_id = 0;
+	        memset(flash_cache, 0, sizeof(flash_cache));
+	        flash_fat_start = flash_fat_end = 0;
 	        flash_tick_counter_last_write = 0;			
 			FlashPgmInit();
-			#ifndef XIP_EXTERNAL_FLASH
+			#if !defined(XIP_EXTERNAL_FLASH) && !MICROPY_HW_FLASH_FS_LFS2
 				FLEG_Init(&s_dev, 0, HyperErase, HyperPageProgram, Hyper16bitProgram, HyperRead, HyperFlush);
+			#elif MICROPY_HW_FLASH_FS_LFS2 && FLEG_CKPT
+				// littlefs owns the FTL's EUs, their checkpoint must not be mounted when FAT is back
+				uint32_t ckpt[2];
+				HyperRead(FLEG_CKPT_EU * FLEG_EU_SIZE, &ckpt[0], 4);
+				HyperRead(FLEG_CKPT_EU * FLEG_EU_SIZE + FLEG_PAGE_SIZE, &ckpt[1], 4);
+				if ((ckpt[0] & ckpt[1]) != 0xFFFFFFFF) {
+					HyperErase(FLEG_CKPT_EU);
+				}
 			#endif
         #else
         mp_spiflash_init((mp_spiflash_t*)&spiflash);
         #endif
         flash_is_initialised = true;
     }
+	#if !MICROPY_HW_FLASH_FS_LFS2
 	NVIC_EnableIRQ(Reserved168_IRQn);  // reserved IRQ is borrowed to trigger flash cache flush
+	#endif
     #if USE_INTERNAL
 	#if 0
     // Enable the flash IRQ, which is used to also call our storage IRQ handler
@@ -195,6 +218,91 @@ static void build_partition(uint8_t *buf, int boot, int type, uint32_t start_blo
 
 #if USE_INTERNAL
 
+static int flash_cache_find(uint32_t block) {
+    for (int i = 0; i < STORAGE_CACHE_BLOCKS; i++) {
+        if (flash_cache[i].lba == block) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool flash_is_fat_block(uint32_t block) {
+    return block >= flash_fat_start && block < flash_fat_end;
+}
+
+// FatFS reads the boot sector on mount and writes it on mkfs, both come through here
+static void flash_fat_parse(const uint8_t *buf, uint32_t block) {
+    if (block != FLASH_PART1_START_BLOCK || buf[510] != 0x55 || buf[511] != 0xaa) {
+        return;
+    }
+    uint32_t fat_size = buf[22] | (buf[23] << 8);
+    if (fat_size == 0) {
+        fat_size = buf[36] | (buf[37] << 8) | (buf[38] << 16) | (buf[39] << 24); // FAT32
+    }
+    flash_fat_start = block + (buf[14] | (buf[15] << 8));
+    flash_fat_end = flash_fat_start + buf[16] * fat_size;
+}
+
+// write the run of consecutive dirty blocks slot is in with one FTL write
+static int flash_cache_write_run(int slot) {
+    uint32_t first = flash_cache[slot].lba;
+    int i;
+    while ((i = flash_cache_find(first - 1)) >= 0 && flash_cache[i].dirty) {
+        first--;
+    }
+    uint32_t cnt = 0;
+    while ((i = flash_cache_find(first + cnt)) >= 0 && flash_cache[i].dirty) {
+        memcpy(s_c8FlhRun[cnt++], s_c8FlhCache[i], FLASH_BLOCK_SIZE);
+        flash_cache[i].dirty = 0;
+    }
+    return FLEG_PagesWrite(&s_dev, first, cnt, s_c8FlhRun);
+}
+
+static int flash_cache_write_back(void) {
+    int ret = 0;
+    for (int i = 0; i < STORAGE_CACHE_BLOCKS; i++) {
+        if (flash_cache[i].lba && flash_cache[i].dirty && flash_cache_write_run(i) < 0) {
+            ret = -1;
+        }
+    }
+    return ret;
+}
+
+// a slot for block: a free one, else the least recently used non FAT one. FAT sectors only replace
+// each other once they hold half of the cache, so file data can't push them out
+static int flash_cache_alloc(uint32_t block) {
+    int fat_cnt = 0, slot = -1;
+    for (int i = 0; i < STORAGE_CACHE_BLOCKS; i++) {
+        if (flash_cache[i].lba == 0) {
+            slot = i;
+            goto found;
+        }
+        fat_cnt += flash_cache[i].fat;
+    }
+    int fat = flash_is_fat_block(block) && (fat_cnt >= (STORAGE_CACHE_BLOCKS / 2));
+    for (int pass = 0; pass < 2 && slot < 0; pass++) {
+        // the second pass takes any slot, the FAT may have filled a cache that was empty
+        for (int i = 0; i < STORAGE_CACHE_BLOCKS; i++) {
+            if ((pass || flash_cache[i].fat == fat) && (slot < 0 || (int32_t)(flash_cache[i].tick - flash_cache[slot].tick) < 0)) {
+                slot = i;
+            }
+        }
+    }
+    if (flash_cache[slot].dirty) {
+        flash_cache_write_run(slot);
+    }
+found:
+    flash_cache[slot].lba = block;
+    flash_cache[slot].dirty = 0;
+    flash_cache[slot].fat = flash_is_fat_block(block);
+    return slot;
+}
+
+static void flash_cache_touch(int slot) {
+    flash_cache[slot].tick = ++flash_cache_tick;
+}
+
 #endif
 
 bool storage_read_block(uint8_t *dest, uint32_t block) {
@@ -218,8 +326,7 @@ bool storage_read_block(uint8_t *dest, uint32_t block) {
 
     } else {
         #if USE_INTERNAL
-		int ret = FLEG_PageRead(&s_dev, block, dest);
-      	return ret >= 0 ? true:false;
+        return storage_read_blocks(dest, block, 1) == 0;
         #else
 
 	        // non-MBR block, get data from SPI flash
@@ -251,8 +358,7 @@ bool storage_write_block(const uint8_t *src, uint32_t block) {
 
     } else {
         #if USE_INTERNAL
-		int ret = FLEG_PageWrite(&s_dev, block, src);
-		return ret >= 0 ? true : false;
+        return storage_write_blocks(src, block, 1) == 0;
         #else
 	        // non-MBR block, write to SPI flash
 
@@ -275,34 +381,145 @@ bool storage_write_block(const uint8_t *src, uint32_t block) {
 }
 
 mp_uint_t storage_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
+    #if USE_INTERNAL
+    if (num_blocks && block_num == 0) {
+        storage_read_block(dest, 0); // the fake MBR
+        dest += FLASH_BLOCK_SIZE, block_num++, num_blocks--;
+    }
+    int ret = 0;
+    flash_ftl_busy++;
+    while (num_blocks) {
+        int slot = flash_cache_find(block_num);
+        uint32_t cnt = 1;
+        if (slot >= 0) {
+            memcpy(dest, s_c8FlhCache[slot], FLASH_BLOCK_SIZE);
+            flash_cache_touch(slot);
+        } else {
+            // blocks that are not cached are read in one go, the FTL resolves the map once per erase unit
+            while (cnt < num_blocks && flash_cache_find(block_num + cnt) < 0) {
+                cnt++;
+            }
+            if (FLEG_PagesRead(&s_dev, block_num, cnt, dest) < 0) {
+                ret = -1;
+                break;
+            }
+            flash_fat_parse(dest, block_num);
+            if (cnt == 1 && flash_is_fat_block(block_num)) {
+                // FAT sectors are read and written all the time, keep them
+                slot = flash_cache_alloc(block_num);
+                memcpy(s_c8FlhCache[slot], dest, FLASH_BLOCK_SIZE);
+                flash_cache_touch(slot);
+            }
+        }
+        dest += cnt * FLASH_BLOCK_SIZE, block_num += cnt, num_blocks -= cnt;
+    }
+    flash_ftl_busy--;
+    flash_tick_last_access = HAL_GetTick();
+    return ret >= 0 ? 0 : 1;
+    #else
     for (size_t i = 0; i < num_blocks; i++) {
         if (!storage_read_block(dest + i * FLASH_BLOCK_SIZE, block_num + i)) {
             return 1; // error
         }
     }
     return 0; // success
+    #endif
 }
 
 mp_uint_t storage_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
+    #if USE_INTERNAL
+    if (num_blocks && block_num == 0) {
+        src += FLASH_BLOCK_SIZE, block_num++, num_blocks--; // can't write MBR
+    }
+    if (num_blocks == 0) {
+        return 0;
+    }
+    int ret = 0;
+    flash_ftl_busy++;
+    flash_fat_parse(src, block_num);
+    if (num_blocks > (STORAGE_CACHE_BLOCKS / 2)) {
+        // long runs are file data, write them through instead of flushing the whole cache for them.
+        // Pages that fit the current erase unit are programmed back to back and logged together
+        for (int i = 0; i < STORAGE_CACHE_BLOCKS; i++) {
+            uint32_t ofs = flash_cache[i].lba - block_num;
+            if (flash_cache[i].lba && ofs < num_blocks) {
+                flash_cache[i].lba = 0;
+                flash_cache[i].dirty = 0;
+            }
+        }
+        ret = FLEG_PagesWrite(&s_dev, block_num, num_blocks, src);
+    } else {
+        for (uint32_t i = 0; i < num_blocks; i++) {
+            int slot = flash_cache_find(block_num + i);
+            if (slot < 0) {
+                slot = flash_cache_alloc(block_num + i);
+            }
+            memcpy(s_c8FlhCache[slot], src + i * FLASH_BLOCK_SIZE, FLASH_BLOCK_SIZE);
+            flash_cache[slot].dirty = 1;
+            flash_cache_touch(slot);
+        }
+        flash_tick_counter_last_write = HAL_GetTick();
+        flash_flags |= FLASH_FLAG_DIRTY;
+        // indicate a dirty cache with LED on
+        led_state(PYB_LED_RED, 1);
+    }
+    flash_ftl_busy--;
+    flash_tick_last_access = HAL_GetTick();
+    return ret >= 0 ? 0 : 1;
+    #else
     for (size_t i = 0; i < num_blocks; i++) {
         if (!storage_write_block(src + i * FLASH_BLOCK_SIZE, block_num + i)) {
             return 1; // error
         }
     }
     return 0; // success
+    #endif
+}
+
+void storage_trim_blocks(uint32_t block_num, uint32_t num_blocks) {
+    #if USE_INTERNAL
+    if (block_num == 0) {
+        return;
+    }
+    flash_ftl_busy++;
+    // the data is gone, cached copies too, dirty or not
+    for (int i = 0; i < STORAGE_CACHE_BLOCKS; i++) {
+        if (flash_cache[i].lba && (flash_cache[i].lba - block_num) < num_blocks) {
+            flash_cache[i].lba = 0;
+            flash_cache[i].dirty = 0;
+        }
+    }
+    FLEG_PageTrim(&s_dev, block_num, num_blocks);
+    flash_ftl_busy--;
+    #endif
 }
 
 void storage_irq_handler(void) {
     #if USE_INTERNAL
 
     if (!(flash_flags & FLASH_FLAG_DIRTY)) {
+        // Use idle time to finish lazy moves and pre-erase PEUs, so block writes only program pages.
+        // Never in the middle of a block access this IRQ preempted.
+        if (!flash_ftl_busy && sys_tick_has_passed(flash_tick_last_access, STORAGE_BG_IDLE_MS)) {
+            uint32_t start = HAL_GetTick();
+            while (FLEG_Background(&s_dev) && !sys_tick_has_passed(start, STORAGE_BG_BUDGET_MS) && !flash_ftl_busy) {
+            }
+        }
+        return;
+    }
+
+    // the cache is being accessed by the code this IRQ preempted
+    if (flash_ftl_busy) {
         return;
     }
 
     // If not a forced write, wait at least 5 seconds after last write to flush
     // On file close and flash unmount we get a forced write, so we can afford to wait a while
-    if ((flash_flags & FLASH_FLAG_FORCE_WRITE) || sys_tick_has_passed(flash_tick_counter_last_write, 5000)) {
-		FLEG_PageWrite(&s_dev, flash_cache_lba_id, s_c8FlhCache);
+    if ((flash_flags & FLASH_FLAG_FORCE_WRITE) || sys_tick_has_passed(flash_tick_counter_last_write, STORAGE_FLUSH_MS)) {
+        // dirty blocks go out as runs of consecutive blocks, clean FAT sectors stay cached
+        flash_ftl_busy++;
+        flash_cache_write_back();
+        flash_ftl_busy--;
         flash_flags = 0;
         // indicate a clean cache with LED off
         led_state(PYB_LED_RED, 0);
@@ -328,6 +545,84 @@ STATIC mp_obj_t pyb_flash_make_new(const mp_obj_type_t *type, size_t n_args, siz
     return (mp_obj_t)&pyb_flash_obj;
 }
 
+#if MICROPY_HW_FLASH_FS_LFS2
+// littlefs does its own wear levelling and power loss recovery, so it gets the erase units
+// the FTL would otherwise own: one block per erase unit, read and programmed at any offset.
+#define FLASH_LFS_XIP(ofs)  ((uint32_t *) (FlexSPI_AMBA_BASE + FLEG_FLASH_OFFSET + (ofs)))
+
+STATIC mp_uint_t flash_lfs_read(uint32_t block, uint32_t ofs, uint8_t *dest, uint32_t len) {
+    if ((block >= FLEG_EU_CNT) || ((ofs + len) > FLEG_EU_SIZE)) {
+        return 1;
+    }
+    HyperRead(block * FLEG_EU_SIZE + ofs, dest, len);
+    return 0;
+}
+
+STATIC mp_uint_t flash_lfs_prog(uint32_t block, uint32_t ofs, const uint8_t *src, uint32_t len) {
+    if ((block >= FLEG_EU_CNT) || ((ofs + len) > FLEG_EU_SIZE)) {
+        return 1;
+    }
+    uint32_t addr = block * FLEG_EU_SIZE + ofs;
+    for (uint32_t done = 0; done < len;) {
+        uint32_t pg_ofs = (addr + done) % FLEG_PAGE_SIZE;
+        uint32_t cnt = MIN(len - done, FLEG_PAGE_SIZE - pg_ofs);
+        HyperPageProgram((addr + done) / FLEG_PAGE_SIZE, pg_ofs, cnt, src + done);
+        done += cnt;
+    }
+    // reads go through XIP, drop the stale lines
+    SCB_InvalidateDCache_by_Addr(FLASH_LFS_XIP(addr), len);
+    return 0;
+}
+
+STATIC mp_uint_t flash_lfs_erase(uint32_t block) {
+    if (block >= FLEG_EU_CNT) {
+        return 1;
+    }
+    HyperErase(block);
+    SCB_InvalidateDCache_by_Addr(FLASH_LFS_XIP(block * FLEG_EU_SIZE), FLEG_EU_SIZE);
+    return 0;
+}
+
+// readblocks(block, buf[, offset])
+STATIC mp_obj_t pyb_flash_readblocks(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[2], &bufinfo, MP_BUFFER_WRITE);
+    uint32_t ofs = (n_args == 4) ? mp_obj_get_int(args[3]) : 0;
+    mp_uint_t ret = flash_lfs_read(mp_obj_get_int(args[1]), ofs, bufinfo.buf, bufinfo.len);
+    return MP_OBJ_NEW_SMALL_INT(ret);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pyb_flash_readblocks_obj, 3, 4, pyb_flash_readblocks);
+
+// writeblocks(block, buf[, offset]), without an offset the block is erased first
+STATIC mp_obj_t pyb_flash_writeblocks(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[2], &bufinfo, MP_BUFFER_READ);
+    uint32_t block = mp_obj_get_int(args[1]);
+    mp_uint_t ret = 0;
+    if (n_args == 3) {
+        ret = flash_lfs_erase(block);
+    }
+    if (ret == 0) {
+        ret = flash_lfs_prog(block, (n_args == 4) ? mp_obj_get_int(args[3]) : 0, bufinfo.buf, bufinfo.len);
+    }
+    return MP_OBJ_NEW_SMALL_INT(ret);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pyb_flash_writeblocks_obj, 3, 4, pyb_flash_writeblocks);
+
+STATIC mp_obj_t pyb_flash_ioctl(mp_obj_t self, mp_obj_t cmd_in, mp_obj_t arg_in) {
+    mp_int_t cmd = mp_obj_get_int(cmd_in);
+    switch (cmd) {
+        case MP_BLOCKDEV_IOCTL_INIT: storage_init(); return MP_OBJ_NEW_SMALL_INT(0);
+        case MP_BLOCKDEV_IOCTL_DEINIT: return MP_OBJ_NEW_SMALL_INT(0);
+        case MP_BLOCKDEV_IOCTL_SYNC: return MP_OBJ_NEW_SMALL_INT(0); // programs are not buffered
+        case MP_BLOCKDEV_IOCTL_BLOCK_COUNT: return MP_OBJ_NEW_SMALL_INT(FLEG_EU_CNT);
+        case MP_BLOCKDEV_IOCTL_BLOCK_SIZE: return MP_OBJ_NEW_SMALL_INT(FLEG_EU_SIZE);
+        case MP_BLOCKDEV_IOCTL_BLOCK_ERASE: return MP_OBJ_NEW_SMALL_INT(flash_lfs_erase(mp_obj_get_int(arg_in)));
+        default: return mp_const_none;
+    }
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(pyb_flash_ioctl_obj, pyb_flash_ioctl);
+#else
 STATIC mp_obj_t pyb_flash_readblocks(mp_obj_t self, mp_obj_t block_num, mp_obj_t buf) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(buf, &bufinfo, MP_BUFFER_WRITE);
@@ -360,10 +655,12 @@ STATIC mp_obj_t pyb_flash_ioctl(mp_obj_t self, mp_obj_t cmd_in, mp_obj_t arg_in)
             }
             #endif
             return MP_OBJ_NEW_SMALL_INT(ret);
+        case MP_BLOCKDEV_IOCTL_BLOCK_TRIM: storage_trim_blocks(mp_obj_get_int(arg_in), 1); return MP_OBJ_NEW_SMALL_INT(0);
         default: return mp_const_none;
     }
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(pyb_flash_ioctl_obj, pyb_flash_ioctl);
+#endif
 
 STATIC const mp_rom_map_elem_t pyb_flash_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readblocks), MP_ROM_PTR(&pyb_flash_readblocks_obj) },
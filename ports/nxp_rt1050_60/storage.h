@@ -30,6 +30,10 @@
 #define FLASH_BLOCK_SIZE (512)	// this is not physical block sie, and must set to 512 for easy FatFS and USB MSC porting
 #define STORAGE_SYSTICK_MASK    (0x1ff) // 512 ticks
 #define STORAGE_IDLE_TICK(tick) (((tick) & STORAGE_SYSTICK_MASK) == 2)
+#define STORAGE_BG_IDLE_MS      (1000)  // no block access for this long before the FTL reclaims in the background
+#define STORAGE_BG_BUDGET_MS    (20)    // background steps started per idle tick, an erase always runs to the end
+#define STORAGE_CACHE_BLOCKS    (16)    // write-back cache blocks, FAT sectors are kept in up to half of them
+#define STORAGE_FLUSH_MS        (5000)  // dirty blocks are written back this long after the last write
 #if defined(MICROPY_HW_SPIFLASH_SIZE_BITS)
 #define USE_INTERNAL (0)
 #else
@@ -67,6 +71,7 @@ bool storage_write_block(const uint8_t *src, uint32_t block);
 // these return 0 on success, non-zero on error
 mp_uint_t storage_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks);
 mp_uint_t storage_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t num_blocks);
+void storage_trim_blocks(uint32_t block_num, uint32_t num_blocks);
 
 extern const struct _mp_obj_type_t pyb_flash_type;
 
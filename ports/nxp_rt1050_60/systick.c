@@ -30,6 +30,10 @@
 #include "pybthread.h"
 
 __IO uint32_t uwTick;
+// Microseconds of the current tick gone before systick_rescale() cut it short, the short
+// rest then counts for the one tick.
+static volatile uint32_t s_tickHeadUs;
+static volatile uint8_t s_isTickShort;
 
 // We provide our own version of HAL_Delay that calls __WFI while waiting,
 // and works when interrupts are disabled.  This function is intended to be
@@ -129,6 +133,8 @@ mp_uint_t mp_hal_ticks_us(void) {
     uint32_t counter = SysTick->VAL;
     uint32_t milliseconds = HAL_GetTick();
     uint32_t status  = SysTick->CTRL;
+    uint32_t load = SysTick->LOAD;
+    uint32_t head = s_tickHeadUs;
     enable_irq(irq_state);
 
     // It's still possible for the countflag bit to get set if the counter was
@@ -141,15 +147,41 @@ mp_uint_t mp_hal_ticks_us(void) {
         // time we read CTRL, which implies that there is an interrupt pending
         // to increment the tick counter.
         milliseconds++;
+        if (head) {
+            // the short tick is over, the new one has the normal length
+            head = 0;
+            load = SystemCoreClock / 1000 - 1;
+        }
     }
-    uint32_t load = SysTick->LOAD;
     counter = load - counter; // Convert from decrementing to incrementing
 
     // ((load + 1) / 1000) is the number of counts per microsecond.
     //
     // counter / ((load + 1) / 1000) scales from the systick clock to microseconds
     // and is the same thing as (counter * 1000) / (load + 1)
-    return milliseconds * 1000 + (counter * 1000) / (load + 1);
+    return milliseconds * 1000 + head + (counter * (1000 - head)) / (load + 1);
+}
+
+void systick_rescale(uint32_t val, uint32_t old_hz, uint32_t new_hz)
+{
+    uint32_t load = SysTick->LOAD;
+    // the time left in this tick, counted at the new rate
+    uint32_t left = (uint64_t)val * new_hz / old_hz;
+    s_tickHeadUs += ((load - val) * (1000 - s_tickHeadUs)) / (load + 1);
+    SystemCoreClock = new_hz;
+    SysTick->LOAD = MAX(left, 64);
+    SysTick->VAL = 0;
+    s_isTickShort = 1;
+}
+
+void systick_tick_done(void)
+{
+    if (s_isTickShort) {
+        SysTick->LOAD = SystemCoreClock / 1000 - 1;
+        SysTick->VAL = 0;
+        s_isTickShort = 0;
+        s_tickHeadUs = 0;
+    }
 }
 
 uint32_t systick_current_millis()
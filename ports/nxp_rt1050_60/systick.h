@@ -27,4 +27,9 @@
 void sys_tick_wait_at_least(uint32_t stc, uint32_t delay_ms);
 bool sys_tick_has_passed(uint32_t stc, uint32_t delay_ms);
 void systick_sleep(volatile uint32_t ms);
-uint32_t systick_current_millis(void);
\ No newline at end of file
+uint32_t systick_current_millis(void);
+// The core clock SysTick counts changes from old_hz to new_hz, call with IRQs off and val
+// the SysTick->VAL read before the switch. The tick in progress ends on time.
+void systick_rescale(uint32_t val, uint32_t old_hz, uint32_t new_hz);
+// From the SysTick IRQ, puts the normal reload back after a systick_rescale().
+void systick_tick_done(void);
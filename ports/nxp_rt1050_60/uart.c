@@ -31,15 +31,18 @@
 #include "fsl_debug_console.h"
 #include "fsl_clock.h"
 #include "fsl_lpuart.h"
+#include "fsl_dmamux.h"
 
 #include "py/nlr.h"
 #include "py/runtime.h"
 #include "py/stream.h"
 #include "py/mperrno.h"
 #include "py/mphal.h"
+#include "py/ringbuf.h"
 
 #include "uart.h"
 #include "irq.h"
+#include "dma.h"
 #include "genhdr/pins.h"
 
 #include "lib/utils/interrupt_char.h"
@@ -79,6 +82,9 @@
 /// To check if there is anything to be read, use:
 ///
 ///     uart.any()               # returns True if any characters waiting
+///
+/// With `dma=True` eDMA fills the read buffer and sends what `write()` is given in the
+/// background, see `init`.
 #define UART_CLKSRC_HZ	11059200
 #define CHAR_WIDTH_8BIT (0)
 #define CHAR_WIDTH_9BIT (1)
@@ -101,10 +107,15 @@ struct _pyb_uart_obj_t {
     
     lpuart_config_t config;
     // usart_handle_t uart;
-    volatile uint16_t read_buf_head;    // indexes first empty slot
-    uint16_t read_buf_tail;             // indexes first full slot (not full if equals head)	
-    byte *read_buf;                     // byte or uint16_t, depending on char size
-    uint16_t read_buf_len;
+    ringbuf_t read_buf;                 // filled by the IRQ, 9 bit chars take 2 bytes
+    uint16_t read_buf_len;              // len in chars; buf can hold len-1 chars
+    uint16_t rx_idle;                   // read_buf.iput at the last idle line
+    bool rx_dma;                        // read_buf is filled by eDMA, not by the IRQ
+    volatile bool tx_busy;              // write() is still going out by eDMA
+    byte *rx_dma_buf;                   // allocation read_buf lies in, cache line aligned
+    const byte *tx_buf;                 // the buffer given to write(), referenced until sent
+    size_t tx_pos, tx_left;
+    edma_handle_t tx_dma_handle;
 };
 
 pyb_uart_obj_t *s_pUarts[10];
@@ -118,6 +129,21 @@ pyb_uart_obj_t *s_pUarts[10];
 #define UART_RX_IRQ_EN(p) (p->CTRL |= (1 << 21))
 #define UART_RX_IRQ_DIS(p) (p->CTRL &= ~(1 << 21))
 
+// one eDMA major loop per transfer, CITER is 15 bits
+#define UART_DMA_MAX_LEN	(32767)
+
+static const uint16_t uart_dma_request[][2] = {
+	{0, 0},
+	{kDmaRequestMuxLPUART1Rx, kDmaRequestMuxLPUART1Tx},
+	{kDmaRequestMuxLPUART2Rx, kDmaRequestMuxLPUART2Tx},
+	{kDmaRequestMuxLPUART3Rx, kDmaRequestMuxLPUART3Tx},
+	{kDmaRequestMuxLPUART4Rx, kDmaRequestMuxLPUART4Tx},
+	{kDmaRequestMuxLPUART5Rx, kDmaRequestMuxLPUART5Tx},
+	{kDmaRequestMuxLPUART6Rx, kDmaRequestMuxLPUART6Tx},
+	{kDmaRequestMuxLPUART7Rx, kDmaRequestMuxLPUART7Tx},
+	{kDmaRequestMuxLPUART8Rx, kDmaRequestMuxLPUART8Tx},
+};
+
 
 STATIC mp_obj_t pyb_uart_deinit(mp_obj_t self_in);
 
@@ -295,13 +321,150 @@ bool uart_init(pyb_uart_obj_t *uart_obj, uint32_t baudrate) {
 }
 */
 
+// RX by eDMA: a circular major loop over read_buf, without interrupt. Where the write
+// pointer stands is read back from the TCD, the idle line interrupt only adds a wakeup.
+// Nothing holds the DMA back when read_buf is full, it then overwrites the oldest bytes.
+STATIC void uart_dma_rx_start(pyb_uart_obj_t *self) {
+	uint32_t ch = DMA_CH_LPUART_RX(self->uart_id);
+	dma_edma_init();
+	DMAMUX_SetSource(DMAMUX, ch, uart_dma_request[self->uart_id][0]);
+	DMAMUX_EnableChannel(DMAMUX, ch);
+	EDMA_ResetChannel(DMA0, ch);
+	DMA0->TCD[ch].SADDR = (uint32_t)&self->pDev->DATA;
+	DMA0->TCD[ch].SOFF = 0;
+	DMA0->TCD[ch].ATTR = DMA_ATTR_SSIZE(kEDMA_TransferSize1Bytes) | DMA_ATTR_DSIZE(kEDMA_TransferSize1Bytes);
+	DMA0->TCD[ch].NBYTES_MLNO = 1;
+	DMA0->TCD[ch].SLAST = 0;
+	DMA0->TCD[ch].DADDR = (uint32_t)self->read_buf.buf;
+	DMA0->TCD[ch].DOFF = 1;
+	DMA0->TCD[ch].CITER_ELINKNO = self->read_buf.size;
+	DMA0->TCD[ch].BITER_ELINKNO = self->read_buf.size;
+	DMA0->TCD[ch].DLAST_SGA = -(int32_t)self->read_buf.size;
+	DMA0->TCD[ch].CSR = 0;
+	dma_begin_read(self->read_buf.buf, self->read_buf.size);
+	EDMA_EnableChannelRequest(DMA0, ch);
+	LPUART_EnableRxDMA(self->pDev, true);
+}
+
+// Moves read_buf.iput up to the byte the DMA writes next.
+STATIC void uart_dma_rx_sync(pyb_uart_obj_t *self) {
+	ringbuf_t *r = &self->read_buf;
+	mp_uint_t irq_state = disable_irq();
+	uint32_t iput = DMA0->TCD[DMA_CH_LPUART_RX(self->uart_id)].DADDR - (uint32_t)r->buf;
+	if (iput >= r->size) {
+		iput = 0;
+	}
+	uint32_t from = r->iput;
+	while (from != iput) {
+		uint32_t to = (iput > from) ? iput : r->size;
+		dma_end_read(r->buf + from, to - from);
+		#ifdef repl_uart_id
+		if (self->uart_id == repl_uart_id && mp_interrupt_char != -1 &&
+			memchr(r->buf + from, mp_interrupt_char, to - from)) {
+			pendsv_kbd_intr();
+		}
+		#endif
+		from = (to == r->size) ? 0 : to;
+	}
+	r->iput = iput;
+	enable_irq(irq_state);
+}
+
+// TX by eDMA: straight from the caller's buffer, chunk by chunk of at most one major loop.
+STATIC void uart_dma_tx_next(pyb_uart_obj_t *self) {
+	edma_transfer_config_t cfg;
+	size_t n = MIN(self->tx_left, UART_DMA_MAX_LEN);
+	EDMA_PrepareTransfer(&cfg, (void*)(self->tx_buf + self->tx_pos), 1, (void*)&self->pDev->DATA, 1,
+		1, n, kEDMA_MemoryToPeripheral);
+	EDMA_SubmitTransfer(&self->tx_dma_handle, &cfg);
+	self->tx_pos += n;
+	self->tx_left -= n;
+	EDMA_StartTransfer(&self->tx_dma_handle);
+}
+
+STATIC void uart_dma_tx_callback(edma_handle_t *handle, void *param, bool transferDone, uint32_t tcds) {
+	pyb_uart_obj_t *self = param;
+	if (self->tx_left) {
+		uart_dma_tx_next(self);
+		return;
+	}
+	LPUART_EnableTxDMA(self->pDev, false);
+	self->tx_buf = NULL;
+	self->tx_busy = false;
+}
+
+STATIC void uart_dma_tx_start(pyb_uart_obj_t *self, const void *buf, size_t len) {
+	dma_begin_write(buf, len);
+	self->tx_buf = buf;
+	self->tx_pos = 0;
+	self->tx_left = len;
+	self->tx_busy = true;
+	uart_dma_tx_next(self);
+	LPUART_EnableTxDMA(self->pDev, true);
+}
+
+// Waits at most timeout milliseconds for the last write() to be handed to the FIFO.
+STATIC bool uart_dma_tx_wait(pyb_uart_obj_t *self, uint32_t timeout) {
+	uint32_t start = HAL_GetTick();
+	while (self->tx_busy) {
+		if (HAL_GetTick() - start >= timeout) {
+			return false;
+		}
+		MICROPY_EVENT_POLL_HOOK
+	}
+	return true;
+}
+
+STATIC void uart_dma_init(pyb_uart_obj_t *self) {
+	uint32_t ch = DMA_CH_LPUART_TX(self->uart_id);
+	dma_edma_init();
+	DMAMUX_SetSource(DMAMUX, ch, uart_dma_request[self->uart_id][1]);
+	DMAMUX_EnableChannel(DMAMUX, ch);
+	EDMA_CreateHandle(&self->tx_dma_handle, DMA0, ch);
+	EDMA_SetCallback(&self->tx_dma_handle, uart_dma_tx_callback, self);
+	NVIC_SetPriority(DMA0_DMA16_IRQn + (ch & 15), IRQ_PRI_DMA);
+	uart_dma_rx_start(self);
+}
+
+// Stops both directions, a write() still going out is cut short.
+STATIC void uart_dma_deinit(pyb_uart_obj_t *self) {
+	if (!self->rx_dma) {
+		return;
+	}
+	LPUART_EnableRxDMA(self->pDev, false);
+	LPUART_EnableTxDMA(self->pDev, false);
+	EDMA_DisableChannelRequest(DMA0, DMA_CH_LPUART_RX(self->uart_id));
+	EDMA_AbortTransfer(&self->tx_dma_handle);
+	DMAMUX_DisableChannel(DMAMUX, DMA_CH_LPUART_RX(self->uart_id));
+	DMAMUX_DisableChannel(DMAMUX, DMA_CH_LPUART_TX(self->uart_id));
+	self->tx_buf = NULL;
+	self->tx_left = 0;
+	self->tx_busy = false;
+	self->rx_dma = false;
+}
+
+// The bytes in read_buf, what eDMA wrote included.
+STATIC size_t uart_rx_buffered(pyb_uart_obj_t *self) {
+	if (self->read_buf_len == 0) {
+		return 0;
+	}
+	if (self->rx_dma) {
+		uart_dma_rx_sync(self);
+	}
+	return ringbuf_avail(&self->read_buf);
+}
+
+// Chars the IRQ left in the FIFO for lack of room get the IRQ back once there is room.
+STATIC void uart_rx_resume(pyb_uart_obj_t *self) {
+	if (!self->rx_dma && UART_RXFIFO_FILL_CNT(self->pDev)) {
+		UART_RX_IRQ_EN(self->pDev);
+	}
+}
+
 mp_uint_t uart_rx_any(pyb_uart_obj_t *self) {
-	
-    int buffer_bytes = self->read_buf_head - self->read_buf_tail;
-    if (buffer_bytes < 0) {
-        return buffer_bytes + self->read_buf_len;
-    } else if (buffer_bytes > 0) {
-        return buffer_bytes;
+    size_t buffer_bytes = uart_rx_buffered(self);
+    if (buffer_bytes > 0 || self->rx_dma) {
+        return buffer_bytes >> self->char_width;
     } else {
         return UART_RXFIFO_FILL_CNT(self->pDev);
     }
@@ -313,7 +476,7 @@ mp_uint_t uart_rx_any(pyb_uart_obj_t *self) {
 STATIC bool uart_rx_wait(pyb_uart_obj_t *self, uint32_t timeout) {
     uint32_t start = HAL_GetTick();
     for (;;) {
-        if (self->read_buf_tail != self->read_buf_head || UART_RXFIFO_FILL_CNT(self->pDev)) {
+        if (uart_rx_buffered(self) || (!self->rx_dma && UART_RXFIFO_FILL_CNT(self->pDev))) {
             return true; // have at least 1 char ready for reading
         }
         if (HAL_GetTick() - start >= timeout) {
@@ -325,19 +488,16 @@ STATIC bool uart_rx_wait(pyb_uart_obj_t *self, uint32_t timeout) {
 
 // assumes there is a character available
 int uart_rx_char(pyb_uart_obj_t *self) {
-    if (self->read_buf_tail != self->read_buf_head) {
-        // buffering via IRQ
+    if (uart_rx_buffered(self)) {
+        // buffering via IRQ or eDMA
         int data;
         if (self->char_width == CHAR_WIDTH_9BIT) {
-            data = ((uint16_t*)self->read_buf)[self->read_buf_tail];
+            data = ringbuf_get16(&self->read_buf);
         } else {
-            data = self->read_buf[self->read_buf_tail];
-        }
-        self->read_buf_tail = (self->read_buf_tail + 1) % self->read_buf_len;
-        if (UART_RXFIFO_FILL_CNT(self->pDev)) {
-            // UART was stalled by flow ctrl: re-enable IRQ now we have room in buffer
-            UART_RX_IRQ_EN(self->pDev);
+            data = ringbuf_get(&self->read_buf);
         }
+        // UART was stalled by flow ctrl: re-enable IRQ now we have room in buffer
+        uart_rx_resume(self);
         return data;
     } else {
         // no buffering
@@ -417,6 +577,12 @@ STATIC size_t uart_tx_data(pyb_uart_obj_t *self, const void *src_in, size_t num_
         timeout = 2 * self->timeout_char;
     }
 
+    // after what write() still sends by eDMA
+    if (!uart_dma_tx_wait(self, self->timeout)) {
+        *errcode = MP_ETIMEDOUT;
+        return 0;
+    }
+
     const uint8_t *src = (const uint8_t*)src_in;
     size_t num_tx = 0;
 
@@ -462,7 +628,8 @@ void uart_tx_strn_cooked(pyb_uart_obj_t *uart_obj, const char *str, uint len) {
     }
 }
 
-// this IRQ handler is set up to handle RXNE interrupts only
+// this IRQ handler is set up to handle RXNE and idle line interrupts only, with eDMA
+// only the idle line
 void uart_irq_handler(void *base, void* pCtx) {
     // get the uart object
     pyb_uart_obj_t *self = (pyb_uart_obj_t*)pCtx;
@@ -473,33 +640,48 @@ void uart_irq_handler(void *base, void* pCtx) {
         return;
     }
 	uint8_t rxCnt = (pDev->WATER >> 24) & 7;
+	uint32_t stat = pDev->STAT;
 	int data;
 	// clear all possible error flags
-	LPUART_ClearStatusFlags(pDev,
+	LPUART_ClearStatusFlags(pDev, kLPUART_IdleLineFlag |
 		kLPUART_RxOverrunFlag | kLPUART_NoiseErrorFlag | kLPUART_FramingErrorFlag | kLPUART_ParityErrorFlag);
-	while (rxCnt--) {
-		data = LPUART_ReadByte(pDev);
-		#ifdef repl_uart_id
-		if (self->uart_id == repl_uart_id && mp_interrupt_char != -1 && data == mp_interrupt_char) {
-			pendsv_kbd_intr();
-			// return;
+	if (self->rx_dma) {
+		uart_dma_rx_sync(self);
+		rxCnt = 0;
+	}
+	while (rxCnt && self->read_buf_len != 0) {
+		// the FIFO goes straight into the free span of the buffer, handed over once per span
+		uint8_t *span;
+		size_t n = ringbuf_put_span(&self->read_buf, &span) >> self->char_width;
+		if (n == 0) { // No room: leave chars in the FIFO, disable interrupt
+			UART_RX_IRQ_DIS(self->pDev);
+			break;
 		}
-		#endif
-		if (self->read_buf_len != 0) {
-			uint16_t next_head = (self->read_buf_head + 1) % self->read_buf_len;
-			if (next_head != self->read_buf_tail) {
-				if (self->char_width == CHAR_WIDTH_9BIT) {
-					((uint16_t*)self->read_buf)[self->read_buf_head] = data;
-				} else {
-					self->read_buf[self->read_buf_head] = data;
-				}
-				self->read_buf_head = next_head;
-			} else { // No room: leave char in buf, disable interrupt
-				UART_RX_IRQ_DIS(self->pDev);
+		n = MIN(n, rxCnt);
+		for (size_t i = 0; i < n; i++) {
+			data = LPUART_ReadByte(pDev);
+			#ifdef repl_uart_id
+			if (self->uart_id == repl_uart_id && mp_interrupt_char != -1 && data == mp_interrupt_char) {
+				pendsv_kbd_intr();
+				// return;
+			}
+			#endif
+			if (self->char_width == CHAR_WIDTH_9BIT) {
+				// big-endian, as ringbuf_get16() takes it
+				span[2 * i] = data >> 8;
+				span[2 * i + 1] = data;
+			} else {
+				span[i] = data;
 			}
 		}
-
+		ringbuf_put_commit(&self->read_buf, n << self->char_width);
+		rxCnt -= n;
+	}
+	if (stat & kLPUART_IdleLineFlag) {
+		// the sender paused: what came so far is a packet
+		self->rx_idle = self->read_buf.iput;
 	}
+	mp_stream_poll_notify(MP_OBJ_FROM_PTR(self));
 }
 
 #define LPUART_IRQHANDLER_ENTRY(n) \
@@ -552,7 +734,7 @@ STATIC void pyb_uart_print(const mp_print_t *print, mp_obj_t self_in, mp_print_k
     }
 }
 
-/// \method init(baudrate, bits=8, parity=None, stop=1, *, timeout=1000, timeout_char=0, flow=0, read_buf_len=64)
+/// \method init(baudrate, bits=8, parity=None, stop=1, *, timeout=1000, timeout_char=0, flow=0, read_buf_len=64, dma=False)
 ///
 /// Initialise the UART bus with the given parameters:
 ///
@@ -564,9 +746,13 @@ STATIC void pyb_uart_print(const mp_print_t *print, mp_obj_t self_in, mp_print_k
 ///   - `timeout_char` is the timeout in milliseconds to wait between characters.
 ///   - `flow` is RTS | CTS where RTS == 256, CTS == 512
 ///   - `read_buf_len` is the character length of the read buffer (0 to disable).
+///   - `dma` lets eDMA fill the read buffer, which can then be up to 32767 chars, and
+///     makes `write()` return at once while eDMA sends the buffer it was given. That
+///     buffer must then stay unchanged until `txdone()`. 7 and 8 bit chars only, and the
+///     read buffer must be read before it fills, eDMA overwrites the oldest chars.
 
 typedef struct _uart_init_helper_param{
-        mp_arg_val_t baudrate, bits, parity, stop, flow, timeout, timeout_char, read_buf_len;
+        mp_arg_val_t baudrate, bits, parity, stop, flow, timeout, timeout_char, read_buf_len, dma;
 } uart_init_helper_param_t;
 
 
@@ -580,6 +766,7 @@ STATIC mp_obj_t pyb_uart_init_helper(pyb_uart_obj_t *self, mp_uint_t n_args, con
         { MP_QSTR_timeout, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 1000} },
         { MP_QSTR_timeout_char, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
         { MP_QSTR_read_buf_len, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 64} },
+        { MP_QSTR_dma, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
     };
 
     // parse args
@@ -594,6 +781,9 @@ STATIC mp_obj_t pyb_uart_init_helper(pyb_uart_obj_t *self, mp_uint_t n_args, con
     LPUART_GetDefaultConfig(init);
     init->baudRate_Bps = args.baudrate.u_int;
 	  init->enableRx = init->enableTx = true;
+    // idle line after one char time from the last stop bit
+    init->rxIdleType = kLPUART_IdleTypeStopBit;
+    init->rxIdleConfig = kLPUART_IdleCharacter1;
 
     // parity
     mp_int_t bits = args.bits.u_int;
@@ -658,13 +848,26 @@ STATIC mp_obj_t pyb_uart_init_helper(pyb_uart_obj_t *self, mp_uint_t n_args, con
         }
     }
 
-	m_del(byte, self->read_buf, self->read_buf_len << self->char_width);
-    self->read_buf_head = 0;
-    self->read_buf_tail = 0;	
+    if (args.dma.u_bool && args.read_buf_len.u_int > UART_DMA_MAX_LEN) {
+        nlr_raise(mp_obj_new_exception_msg_varg(&mp_type_ValueError, "read_buf_len must be at most %d with dma", UART_DMA_MAX_LEN));
+    }
+
+    // the old buffer may still be written by eDMA
+    if (self->rx_dma) {
+        uart_dma_deinit(self);
+        m_del(byte, self->rx_dma_buf, self->read_buf.size + 2 * DMA_CACHE_LINE_SIZE);
+        self->rx_dma_buf = NULL;
+    } else {
+        m_del(byte, self->read_buf.buf, self->read_buf.size);
+    }
+    self->read_buf.iget = 0;
+    self->read_buf.iput = 0;
+    self->rx_idle = 0;
     if (args.read_buf_len.u_int <= 0) {
         // no read buffer, blocking mode
         self->read_buf_len = 0;
-        self->read_buf = NULL;
+        self->read_buf.buf = NULL;
+        self->read_buf.size = 0;
         NVIC_DisableIRQ(self->irqn);
 		LPUART_DisableInterrupts(self->pDev, (uint32_t)-1L);
     } else {
@@ -672,14 +875,27 @@ STATIC mp_obj_t pyb_uart_init_helper(pyb_uart_obj_t *self, mp_uint_t n_args, con
 			self->read_buf_len = 8;
 		else
 			self->read_buf_len = args.read_buf_len.u_int;
-        self->read_buf = m_new(byte, self->read_buf_len << self->char_width);
+        self->read_buf.size = self->read_buf_len << self->char_width;
+        if (args.dma.u_bool) {
+            // whole cache lines of its own, so they can be dropped while eDMA writes
+            self->rx_dma_buf = m_new(byte, self->read_buf.size + 2 * DMA_CACHE_LINE_SIZE);
+            self->read_buf.buf = (byte*)(((uint32_t)self->rx_dma_buf + DMA_CACHE_LINE_SIZE - 1) & ~(DMA_CACHE_LINE_SIZE - 1));
+        } else {
+            self->read_buf.buf = m_new(byte, self->read_buf.size);
+        }
 		uint32_t clk = _GetUartClock();
 		status_t ret = LPUART_Init(self->pDev, &self->config, clk);
 		if (ret != kStatus_Success) {
 			nlr_raise(mp_obj_new_exception_msg_varg(&mp_type_ValueError, "set baudrate %d is not possible", args.baudrate.u_int));
 		}
         HAL_NVIC_SetPriority(self->irqn, IRQ_PRI_UART, IRQ_SUBPRI_UART); 
+        if (args.dma.u_bool) {
+            self->rx_dma = true;
+            uart_dma_init(self);
+        } else {
 		    UART_RX_IRQ_EN(self->pDev);
+        }
+        LPUART_EnableInterrupts(self->pDev, kLPUART_IdleLineInterruptEnable);
         NVIC_EnableIRQ(self->irqn);
     }
 
@@ -795,6 +1011,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_KW(pyb_uart_init_obj, 1, pyb_uart_init);
 STATIC mp_obj_t pyb_uart_deinit(mp_obj_t self_in) {
     pyb_uart_obj_t *self = self_in;
     self->is_enabled = false;
+	uart_dma_deinit(self);
 	LPUART_Deinit(self->pDev);
 	NVIC_DisableIRQ(self->irqn);
 	CLOCK_DisableClock(self->clk_ip_name);
@@ -849,6 +1066,62 @@ STATIC mp_obj_t pyb_uart_readchar(mp_obj_t self_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_uart_readchar_obj, pyb_uart_readchar);
 
+/// \method rx_span()
+/// Return a memoryview of the buffered bytes that lie contiguously in the read buffer, no
+/// copy is made. They stay valid until given back with `rx_consume(n)`, 9 bit chars are
+/// two bytes each, big-endian.
+STATIC mp_obj_t pyb_uart_rx_span(mp_obj_t self_in) {
+    pyb_uart_obj_t *self = self_in;
+    uint8_t *span = NULL;
+    size_t n = uart_rx_buffered(self) ? ringbuf_get_span(&self->read_buf, &span) : 0;
+    return mp_obj_new_memoryview('B', n, span);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_uart_rx_span_obj, pyb_uart_rx_span);
+
+/// \method rx_consume(n)
+/// Drop the first n bytes of the span `rx_span()` gave, the IRQ may then fill them again.
+STATIC mp_obj_t pyb_uart_rx_consume(mp_obj_t self_in, mp_obj_t n_in) {
+    pyb_uart_obj_t *self = self_in;
+    uint8_t *span;
+    size_t avail = self->read_buf_len ? ringbuf_get_span(&self->read_buf, &span) : 0;
+    mp_int_t n = mp_obj_get_int(n_in);
+    if (n < 0 || (size_t)n > avail) {
+        mp_raise_ValueError(NULL);
+    }
+    ringbuf_get_commit(&self->read_buf, n);
+    if (n) {
+        uart_rx_resume(self);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pyb_uart_rx_consume_obj, pyb_uart_rx_consume);
+
+/// \method rx_packet()
+/// Return how many of the buffered chars came before the last idle line on RX, that is
+/// before the sender last paused for a char time, so `read(rx_packet())` takes whole packets.
+STATIC mp_obj_t pyb_uart_rx_packet(mp_obj_t self_in) {
+    pyb_uart_obj_t *self = self_in;
+    ringbuf_t *r = &self->read_buf;
+    size_t avail = uart_rx_buffered(self);
+    size_t n = avail ? (r->size + self->rx_idle - r->iget) % r->size : 0;
+    if (n > avail) {
+        // read past the boundary already
+        n = 0;
+    }
+    return MP_OBJ_NEW_SMALL_INT(n >> self->char_width);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_uart_rx_packet_obj, pyb_uart_rx_packet);
+
+/// \method txdone()
+/// Return `True` once all that was written has left the TX pin, `write()` with `dma=True`
+/// returns before that.
+STATIC mp_obj_t pyb_uart_txdone(mp_obj_t self_in) {
+    pyb_uart_obj_t *self = self_in;
+    return mp_obj_new_bool(!self->tx_busy &&
+        (LPUART_GetStatusFlags(self->pDev) & kLPUART_TransmissionCompleteFlag));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pyb_uart_txdone_obj, pyb_uart_txdone);
+
 // uart.sendbreak()
 STATIC mp_obj_t pyb_uart_sendbreak(mp_obj_t self_in) {
     pyb_uart_obj_t *self = self_in;
@@ -872,10 +1145,16 @@ STATIC const mp_rom_map_elem_t pyb_uart_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
     /// \method write(buf)
     { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    /// \method flush()
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&mp_stream_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_txdone), MP_ROM_PTR(&pyb_uart_txdone_obj) },
 
     { MP_ROM_QSTR(MP_QSTR_writechar), MP_ROM_PTR(&pyb_uart_writechar_obj) },
     { MP_ROM_QSTR(MP_QSTR_readchar), MP_ROM_PTR(&pyb_uart_readchar_obj) },
     { MP_ROM_QSTR(MP_QSTR_sendbreak), MP_ROM_PTR(&pyb_uart_sendbreak_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rx_span), MP_ROM_PTR(&pyb_uart_rx_span_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rx_consume), MP_ROM_PTR(&pyb_uart_rx_consume_obj) },
+    { MP_ROM_QSTR(MP_QSTR_rx_packet), MP_ROM_PTR(&pyb_uart_rx_packet_obj) },
 
     // class constants
     // { MP_ROM_QSTR(MP_QSTR_RTS), MP_ROM_INT(UART_HWCONTROL_RTS) },
@@ -912,14 +1191,23 @@ STATIC mp_uint_t pyb_uart_read(mp_obj_t self_in, void *buf_in, mp_uint_t size, i
     // read the data
     byte *orig_buf = buf;
     for (;;) {
-        int data = uart_rx_char(self);
-        if (self->char_width == CHAR_WIDTH_9BIT) {
-            *(uint16_t*)buf = data;
-            buf += 2;
+        if (self->char_width == CHAR_WIDTH_8BIT && uart_rx_buffered(self)) {
+            // all that is buffered in one go
+            size_t n = ringbuf_get_n(&self->read_buf, buf, size);
+            buf += n;
+            size -= n;
+            uart_rx_resume(self);
         } else {
-            *buf++ = data;
+            int data = uart_rx_char(self);
+            if (self->char_width == CHAR_WIDTH_9BIT) {
+                *(uint16_t*)buf = data;
+                buf += 2;
+            } else {
+                *buf++ = data;
+            }
+            --size;
         }
-        if (--size == 0 || !uart_rx_wait(self, self->timeout_char)) {
+        if (size == 0 || !uart_rx_wait(self, self->timeout_char)) {
             // return number of bytes read
             return buf - orig_buf;
         }
@@ -942,6 +1230,18 @@ STATIC mp_uint_t pyb_uart_write(mp_obj_t self_in, const void *buf_in, mp_uint_t
         return MP_STREAM_ERROR;
     }
 
+    if (self->rx_dma) {
+        // the previous buffer has to be out first
+        if (!uart_dma_tx_wait(self, self->timeout)) {
+            *errcode = MP_EAGAIN;
+            return MP_STREAM_ERROR;
+        }
+        if (size) {
+            uart_dma_tx_start(self, buf, size);
+        }
+        return size;
+    }
+
     // write the data
     size_t num_tx = uart_tx_data(self, buf, size >> self->char_width, errcode);
     if (*errcode == 0 || *errcode == MP_ETIMEDOUT) {
@@ -961,9 +1261,18 @@ STATIC mp_uint_t pyb_uart_ioctl(mp_obj_t self_in, mp_uint_t request, mp_uint_t a
         if ((flags & MP_STREAM_POLL_RD) && uart_rx_any(self)) {
             ret |= MP_STREAM_POLL_RD;
         }
-        if ((flags & MP_STREAM_POLL_WR) && UART_TXFIFO_FILL_CNT(self->pDev) ) {
+        if ((flags & MP_STREAM_POLL_WR) && !self->tx_busy && UART_TXFIFO_FILL_CNT(self->pDev) ) {
             ret |= MP_STREAM_POLL_WR;	// set whenever UART TXFIFO is not full
         }
+    } else if (request == MP_STREAM_FLUSH) {
+        if (!uart_dma_tx_wait(self, self->timeout) || !uart_wait_for_idle(self, 2 * self->timeout_char)) {
+            *errcode = MP_ETIMEDOUT;
+            return MP_STREAM_ERROR;
+        }
+        ret = 0;
+    } else if (request == MP_STREAM_POLL_NOTIFY) {
+        // only RX is interrupt driven, and only with a read buffer
+        ret = (self->read_buf_len != 0) ? MP_STREAM_POLL_RD : 0;
     } else {
         *errcode = MP_EINVAL;
         ret = MP_STREAM_ERROR;
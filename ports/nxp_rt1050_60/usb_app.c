@@ -44,6 +44,7 @@
 #include "usb_device_cdc_acm.h"
 #include "usb_device_ch9.h"
 #include "usb_device_descriptor.h"
+#include "usb_ehci.h"
 
 #include "py/objstr.h"
 #include "py/runtime.h"
@@ -192,6 +193,136 @@ void usb_vcp_send_strn_cooked(const char *str, int len) {
 #endif
 }
 
+/******************************************************************************/
+// Vendor bulk IN endpoint (USBD_MODE_VND), frames to the IDE without the CDC ring
+
+// The dci takes one transfer per endpoint at a time, so a frame goes out in chunks of
+// USB_VND_CHUNK_DTDS dTDs (16KB each). The controller walks a chunk's dTD chain on its own
+// and the completion IRQ queues the next chunk, the CPU only sees one IRQ per 128KB.
+#define USB_VND_CHUNK_DTDS  (8)
+#define USB_VND_CHUNK       (USB_VND_CHUNK_DTDS * USB_DEVICE_ECHI_DTD_TOTAL_BYTES)
+
+extern usb_device_endpoint_struct_t g_vndEndpoints[USB_VND_ENDPOINT_COUNT];
+
+static struct {
+    usb_device_handle handle;
+    volatile bool configured;
+    volatile bool busy;
+    const uint8_t *buf;
+    uint32_t len, sent;
+    void (*done)(bool ok);
+} usb_vnd;
+
+static void usb_vnd_finish(bool ok)
+{
+    void (*done)(bool ok) = usb_vnd.done;
+    usb_vnd.done = NULL;
+    usb_vnd.busy = false;
+    if (done) {
+        done(ok);
+    }
+}
+
+static usb_status_t usb_vnd_queue(void)
+{
+    uint32_t n = MIN(usb_vnd.len - usb_vnd.sent, USB_VND_CHUNK);
+    return USB_DeviceSendRequest(usb_vnd.handle, g_cfgFix.roVndEpInNdx,
+                                 (uint8_t *) usb_vnd.buf + usb_vnd.sent, n);
+}
+
+static usb_status_t usb_vnd_bulk_in(usb_device_handle handle,
+                                    usb_device_endpoint_callback_message_struct_t *message, void *param)
+{
+    if (!usb_vnd.busy) {
+        return kStatus_USB_Success;
+    }
+    // Cancelled (USB_UNINITIALIZED_VAL_32), reset or a short transfer: drop the frame.
+    if ((message->length == USB_UNINITIALIZED_VAL_32) || (!usb_vnd.configured)
+            || (message->length != MIN(usb_vnd.len - usb_vnd.sent, USB_VND_CHUNK))) {
+        usb_vnd_finish(false);
+        return kStatus_USB_Success;
+    }
+    usb_vnd.sent += message->length;
+    if (usb_vnd.sent == usb_vnd.len) {
+        usb_vnd_finish(true);
+    } else if (usb_vnd_queue() != kStatus_USB_Success) {
+        usb_vnd_finish(false);
+    }
+    return kStatus_USB_Success;
+}
+
+// Called by the composite device on SetConfiguration and bus reset (configure == 0).
+void usb_vnd_set_configure(usb_device_handle handle, uint8_t configure)
+{
+    usb_vnd.configured = false;
+    if (usb_vnd.busy) {
+        usb_vnd_finish(false);
+    }
+    if ((!configure) || (!(USBD_GetMode() & USBD_MODE_VND))) {
+        return;
+    }
+
+    usb_device_endpoint_init_struct_t epInit = {
+        .maxPacketSize = g_vndEndpoints[0].maxPacketSize,
+        .endpointAddress = g_cfgFix.roVndEpInNdx | (USB_IN << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT),
+        .transferType = USB_ENDPOINT_BULK,
+        .zlt = 0,
+    };
+    usb_device_endpoint_callback_struct_t epCallback = {
+        .callbackFn = usb_vnd_bulk_in,
+        .callbackParam = NULL,
+    };
+    usb_vnd.handle = handle;
+    USB_DeviceDeinitEndpoint(handle, epInit.endpointAddress);
+    if (USB_DeviceInitEndpoint(handle, &epInit, &epCallback) == kStatus_USB_Success) {
+        usb_vnd.configured = true;
+    }
+}
+
+bool usb_vnd_is_configured(void) {
+    return usb_vnd.configured;
+}
+
+bool usb_vnd_is_busy(void) {
+    return usb_vnd.busy;
+}
+
+// Queues len bytes at buf, done() is called from the USB IRQ once the host has read them all,
+// or with ok == false if the transfer was cancelled. The host must read exactly len bytes,
+// no zero length packet ends a transfer that is a multiple of the packet size.
+// Returns -1 if the endpoint is not configured or still busy.
+int usb_vnd_send(const uint8_t *buf, uint32_t len, void (*done)(bool ok))
+{
+    if ((!usb_vnd.configured) || usb_vnd.busy || (!len)) {
+        return -1;
+    }
+    usb_vnd.buf = buf;
+    usb_vnd.len = len;
+    usb_vnd.sent = 0;
+    usb_vnd.done = done;
+    usb_vnd.busy = true;
+    if (usb_vnd_queue() != kStatus_USB_Success) {
+        usb_vnd.done = NULL;
+        usb_vnd.busy = false;
+        return -1;
+    }
+    return 0;
+}
+
+// Drops the frame in flight, its done() is called with ok == false.
+void usb_vnd_cancel(void)
+{
+    mp_uint_t irq_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    if (usb_vnd.busy) {
+        USB_DeviceCancel(usb_vnd.handle,
+            g_cfgFix.roVndEpInNdx | (USB_IN << USB_DESCRIPTOR_ENDPOINT_ADDRESS_DIRECTION_SHIFT));
+        if (usb_vnd.busy) {
+            usb_vnd_finish(false);
+        }
+    }
+    MICROPY_END_ATOMIC_SECTION(irq_state);
+}
+
 /******************************************************************************/
 // Micro Python bindings for USB
 
@@ -206,6 +337,7 @@ void usb_vcp_send_strn_cooked(const char *str, int len) {
     pyb.usb_mode(None)      # disable USB
     pyb.usb_mode('VCP')     # enable with VCP interface
     pyb.usb_mode('VCP+MSC') # enable with VCP and MSC interfaces
+    pyb.usb_mode('VCP+MSC+VND') # and a vendor bulk IN interface for IDE frames
     pyb.usb_mode('VCP+HID') # enable with VCP and HID, defaulting to mouse protocol
     pyb.usb_mode('VCP+HID', vid=0xf055, pid=0x9800) # specify VID and PID
     pyb.usb_mode('VCP+HID', hid=pyb.hid_mouse)
@@ -234,7 +366,7 @@ STATIC mp_obj_t pyb_usb_mode(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_
     #if defined(USE_HOST_MODE)
         return MP_OBJ_NEW_QSTR(MP_QSTR_host);
     #elif defined(USE_DEVICE_MODE)
-        uint8_t mode = USBD_GetMode();
+        uint16_t mode = USBD_GetMode();
         switch (mode) {
             case USBD_MODE_CDC:
                 return MP_OBJ_NEW_QSTR(MP_QSTR_VCP);
@@ -244,6 +376,8 @@ STATIC mp_obj_t pyb_usb_mode(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_
                 return MP_OBJ_NEW_QSTR(MP_QSTR_HID);
             case USBD_MODE_CDC_MSC:
                 return MP_OBJ_NEW_QSTR(MP_QSTR_VCP_plus_MSC);
+            case USBD_MODE_CDC_MSC_VND:
+                return MP_OBJ_NEW_QSTR(MP_QSTR_VCP_plus_MSC_plus_VND);
             case USBD_MODE_CDC_HID:
                 return MP_OBJ_NEW_QSTR(MP_QSTR_VCP_plus_HID);
             case USBD_MODE_MSC_HID:
@@ -293,7 +427,12 @@ STATIC mp_obj_t pyb_usb_mode(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_
     uint16_t vid = args[1].u_int;
     uint16_t pid = args[2].u_int;
     usb_device_mode_t mode;
-    if (strcmp(mode_str, "CDC+MSC") == 0 || strcmp(mode_str, "VCP+MSC") == 0) {
+    if (strcmp(mode_str, "CDC+MSC+VND") == 0 || strcmp(mode_str, "VCP+MSC+VND") == 0) {
+        if (args[2].u_int == -1) {
+            pid = USBD_PID_CDC_MSC_VND;
+        }
+        mode = USBD_MODE_CDC_MSC_VND;
+    } else if (strcmp(mode_str, "CDC+MSC") == 0 || strcmp(mode_str, "VCP+MSC") == 0) {
         if (args[2].u_int == -1) {
             pid = USBD_PID_CDC_MSC;
         }
@@ -363,6 +502,11 @@ typedef struct _pyb_usb_vcp_obj_t {
 
 STATIC const pyb_usb_vcp_obj_t pyb_usb_vcp_obj = {{&pyb_usb_vcp_type}};
 
+// Called from the CDC callbacks when data came in or a TX block was freed.
+void usb_vcp_poll_notify(void) {
+    mp_stream_poll_notify(MP_OBJ_FROM_PTR(&pyb_usb_vcp_obj));
+}
+
 STATIC void pyb_usb_vcp_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
     mp_print_str(print, "USB_VCP()");
 }
@@ -528,6 +672,8 @@ STATIC mp_uint_t pyb_usb_vcp_ioctl(mp_obj_t self_in, mp_uint_t request, mp_uint_
         if ((flags & MP_STREAM_POLL_WR) && USBD_CDC_TxHalfEmpty()) {
             ret |= MP_STREAM_POLL_WR;
         }
+    } else if (request == MP_STREAM_POLL_NOTIFY) {
+        ret = MP_STREAM_POLL_RD | MP_STREAM_POLL_WR;
     } else {
         *errcode = MP_EINVAL;
         ret = MP_STREAM_ERROR;
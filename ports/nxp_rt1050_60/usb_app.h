@@ -39,6 +39,8 @@
 #define USBD_PID_CDC_HID (0x140d)
 // (0x1400 | USBD_MODE_CDC)
 #define USBD_PID_CDC     (0x1401)
+// USBD_MODE_CDC | USBD_MODE_MSC | USBD_MODE_VND, the vendor interface needs a WinUSB/libusb binding
+#define USBD_PID_CDC_MSC_VND (0xABD2)
 
 typedef enum {
     PYB_USB_STORAGE_MEDIUM_NONE = 0,
@@ -68,6 +70,14 @@ bool usb_vcp_is_enabled(void);
 int usb_vcp_recv_byte(uint8_t *c); // if a byte is available, return 1 and put the byte in *c, else return 0
 void usb_vcp_send_strn(const char* str, int len);
 void usb_vcp_send_strn_cooked(const char *str, int len);
+void usb_vcp_poll_notify(void);
+
+// Vendor bulk IN frame stream, see usbdbg.c USBDBG_FRAME_STREAM.
+void usb_vnd_set_configure(usb_device_handle handle, uint8_t configure);
+bool usb_vnd_is_configured(void);
+bool usb_vnd_is_busy(void);
+int usb_vnd_send(const uint8_t *buf, uint32_t len, void (*done)(bool ok));
+void usb_vnd_cancel(void);
 
 void pyb_usb_host_init(void);
 void pyb_usb_host_process(void);
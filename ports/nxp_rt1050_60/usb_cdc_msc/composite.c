@@ -98,6 +98,8 @@ extern usb_device_class_struct_t g_usbdMscConfig;
 extern usb_device_class_struct_t g_usbdHidKeyboardConfig;
 extern usb_device_class_struct_t g_usbdHidMouseConfig;
 extern usb_device_class_struct_t g_usbdHidGenericConfig;
+/* The vendor frame stream has no class driver, usb_app.c runs its endpoint. */
+extern void usb_vnd_set_configure(usb_device_handle handle, uint8_t configure);
 
 /* USB device class information, support at most 5 classes */
 usb_device_class_config_struct_t g_classes[class_ndx_end] = {
@@ -136,6 +138,7 @@ usb_status_t USB_DeviceCallback(usb_device_handle handle, uint32_t event, void *
         case kUSB_DeviceEventBusReset:
         {
             g_composite.attach = 0;
+            usb_vnd_set_configure(handle, 0);
             error = kStatus_USB_Success;
 #if (defined(USB_DEVICE_CONFIG_EHCI) && (USB_DEVICE_CONFIG_EHCI > 0U)) || \
     (defined(USB_DEVICE_CONFIG_LPCIP3511HS) && (USB_DEVICE_CONFIG_LPCIP3511HS > 0U))
@@ -160,6 +163,7 @@ usb_status_t USB_DeviceCallback(usb_device_handle handle, uint32_t event, void *
                 g_composite.currentConfiguration = *temp8;
                 USB_DeviceCdcVcomSetConfigure(g_composite.cdcVcom.cdcAcmHandle, *temp8);
                 USB_DeviceMscDiskSetConfigure(g_composite.mscDisk.mscHandle, *temp8);
+                usb_vnd_set_configure(handle, *temp8);
                 error = kStatus_USB_Success;
             }
             break;
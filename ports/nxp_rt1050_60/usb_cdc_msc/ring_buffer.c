@@ -35,7 +35,7 @@
 #include "irq.h"
 #ifdef RINGBUF_IRQ_SAFE
 #define INIT_CRITICAL_RBF() uint32_t basePri = __get_BASEPRI()
-#define ENTER_CRITICAL_RBF() __set_BASEPRI(IRQ_PRI_CSI + 1)
+#define ENTER_CRITICAL_RBF() __set_BASEPRI((IRQ_PRI_CSI + 1) << (8 - __NVIC_PRIO_BITS))
 #define LEAVE_CRITICAL_RBF() __set_BASEPRI(basePri)
 #else
 #define INIT_CRITICAL_RBF()
@@ -187,9 +187,10 @@ int32_t RingBuf_Free(ring_buffer_t* pRB, uint32_t bytesToFree)
 }
 
 #ifdef RINGBLK_IRQ_SAFE
-#define INIT_CRITICAL_RBK() uint32_t priMask = __get_PRIMASK()
-#define ENTER_CRITICAL_RBK() __set_PRIMASK(1)
-#define LEAVE_CRITICAL_RBK() __set_PRIMASK(priMask)
+// mask everything but CSI, the camera fragment IRQ must never wait for USB
+#define INIT_CRITICAL_RBK() uint32_t basePri
+#define ENTER_CRITICAL_RBK() basePri = raise_irq_pri(IRQ_PRI_CSI + 1)
+#define LEAVE_CRITICAL_RBK() restore_irq_pri(basePri)
 #else
 #define INIT_CRITICAL_RBK()
 #define ENTER_CRITICAL_RBK()
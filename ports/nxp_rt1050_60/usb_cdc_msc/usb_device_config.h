@@ -104,7 +104,7 @@
 #define USB_DEVICE_CONFIG_SELF_POWER (1U)
 
 /*! @brief How many endpoints are supported in the stack. */
-#define USB_DEVICE_CONFIG_ENDPOINTS (4U)
+#define USB_DEVICE_CONFIG_ENDPOINTS (5U)
 
 /*! @brief Whether the device task is enabled. */
 #define USB_DEVICE_CONFIG_USE_TASK (0U)
@@ -145,7 +145,7 @@
 
 #if ((defined(USB_DEVICE_CONFIG_EHCI)) && (USB_DEVICE_CONFIG_EHCI > 0U))
 /*! @brief How many the DTD are supported. */
-#define USB_DEVICE_CONFIG_EHCI_MAX_DTD (16U)
+#define USB_DEVICE_CONFIG_EHCI_MAX_DTD (32U)
 
 /*! @brief Whether the EHCI ID pin detect feature enabled. */
 #define USB_DEVICE_CONFIG_EHCI_ID_PIN_DETECT (0U)
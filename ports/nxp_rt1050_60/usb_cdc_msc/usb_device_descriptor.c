@@ -146,6 +146,14 @@ usb_device_class_struct_t g_usbdCdcVcomConfig = {
 	USB_DEVICE_CONFIGURATION_COUNT,
 };
 
+/* vendor frame stream endpoint information, no class driver, endpoint is run by usb_app.c */
+usb_device_endpoint_struct_t g_vndEndpoints[USB_VND_ENDPOINT_COUNT] = {
+    {
+        0 | (USB_IN << 7U), // fixed during desc linkage
+		USB_ENDPOINT_BULK, FS_VND_BULK_IN_PACKET_SIZE,
+    },
+};
+
 /* hid keyboard endpoint information */
 usb_device_endpoint_struct_t g_hidKeyboardEndpoints[USB_HID_KEYBOARD_ENDPOINT_COUNT] = {
     /* HID keyboard interrupt IN pipe */
@@ -440,6 +448,23 @@ uint8_t s_UsbDevCfgDescCdcPart[] =
 
 };
 
+uint8_t s_UsbDevCfgDescVndPart[] = 
+{
+    0x09, // 0 USB_DESCRIPTOR_LENGTH_INTERFACE, 
+    0x04, // 1 USB_DESCRIPTOR_TYPE_INTERFACE, 
+    0x00, // 2 interface index, fixed during desc linkage 
+    0x00, // 3 Alternate setting
+    USB_VND_ENDPOINT_COUNT, USB_VND_CLASS, USB_VND_SUBCLASS, USB_VND_PROTOCOL,
+    11, // String Desc Ndx
+
+    /*Bulk IN Endpoint descriptor, ofs = 9 */
+    USB_DESCRIPTOR_LENGTH_ENDPOINT, USB_DESCRIPTOR_TYPE_ENDPOINT, 
+    0 | (USB_IN << 7U), // ofs = 11, fixed during desc linkage
+    USB_ENDPOINT_BULK, USB_SHORT_GET_LOW(FS_VND_BULK_IN_PACKET_SIZE),
+    USB_SHORT_GET_HIGH(FS_VND_BULK_IN_PACKET_SIZE), 
+    0x00, /* The polling interval value is every 0 Frames */
+};
+
 // Ruyi mouse
 const uint8_t cs_hidMouseReportDesc[] = {
 	HID_UsagePage(HID_USAGE_PAGE_GENERIC),
@@ -784,18 +809,26 @@ uint8_t g_UsbDeviceString10[] = {
     'D',0,'e',0,'v',0,'i',0,'c',0,'e',0,'.',0,
 };
 
+uint8_t g_UsbDeviceString11[] = {
+    0,
+    USB_DESCRIPTOR_TYPE_STRING,
+    'm',0,'p',0,'y',0,' ',0, 
+    'F',0,'r',0,'a',0,'m',0,'e',0,' ',0,
+    'S',0,'t',0,'r',0,'e',0,'a',0,'m',0,
+};
+
 
 /* Define string descriptor size */
 uint32_t g_UsbDeviceStringDescriptorLength[USB_DEVICE_STRING_COUNT] = {
     sizeof(g_UsbDeviceString0), sizeof(g_UsbDeviceString1), sizeof(g_UsbDeviceString2), sizeof(g_UsbDeviceString3),
     sizeof(g_UsbDeviceString4), sizeof(g_UsbDeviceString5), sizeof(g_UsbDeviceString6), sizeof(g_UsbDeviceString7),
-    sizeof(g_UsbDeviceString8), sizeof(g_UsbDeviceString9), sizeof(g_UsbDeviceString10), 
+    sizeof(g_UsbDeviceString8), sizeof(g_UsbDeviceString9), sizeof(g_UsbDeviceString10), sizeof(g_UsbDeviceString11),
 };
 
 uint8_t *g_UsbDeviceStringDescriptorArray[USB_DEVICE_STRING_COUNT] = {
     g_UsbDeviceString0, g_UsbDeviceString1, g_UsbDeviceString2, g_UsbDeviceString3,
 	g_UsbDeviceString4, g_UsbDeviceString5, g_UsbDeviceString6, g_UsbDeviceString7,
-	g_UsbDeviceString8, g_UsbDeviceString9, g_UsbDeviceString10,
+	g_UsbDeviceString8, g_UsbDeviceString9, g_UsbDeviceString10, g_UsbDeviceString11,
 };
 
 usb_language_t g_UsbDeviceLanguage[USB_DEVICE_LANGUAGE_COUNT] = {{
@@ -865,6 +898,8 @@ void USBD_BeginFixCfgData(void)
 	FIX_STR_DESC_SIZE(8);
 	FIX_STR_DESC_SIZE(9);
 	FIX_STR_DESC_SIZE(10);
+	FIX_STR_DESC_SIZE(11);
+	g_cfgFix.roVndEpInNdx = g_cfgFix.roVndItfNdx = 0;
 
 	g_cfgFix.epInNdx = g_cfgFix.epOutNdx = 1;
 	memcpy(g_UsbDevCfgDesc, s_UsbDevCfgDescHdr, sizeof(s_UsbDevCfgDescHdr));
@@ -1058,6 +1093,20 @@ const uint8_t* USBD_GetHidGenericReportDesc(void)
 	return g_cfgFix.pcHidGRptDesc;
 }
 
+int USBD_AddItf_VND(void)
+{
+	if (g_cfgFix.epInNdx + 1 > MAX_IN_EP_CNT)
+		return -1L;  // not enough free endpoints!
+	g_vndEndpoints[0].endpointAddress = g_cfgFix.epInNdx | (USB_IN << 7U);
+	s_UsbDevCfgDescVndPart[2] = g_cfgFix.itfNdx; 
+	s_UsbDevCfgDescVndPart[11] = g_cfgFix.epInNdx | (USB_IN << 7U);
+	g_cfgFix.roVndEpInNdx = g_cfgFix.epInNdx++;
+	g_cfgFix.roVndItfNdx = g_cfgFix.itfNdx++;
+
+	APPEND_ITF_DESC(s_UsbDevCfgDescVndPart);
+	return 0;
+}
+
 int USBD_AddItf_AudPlayback(void) {
 	return 0;
 }
@@ -1066,9 +1115,9 @@ int USBD_AddItf_AudRecord(void) {
 	return 0;
 }
 
-uint8_t usbd_mode;
+uint16_t usbd_mode;
 
-uint8_t USBD_GetMode(void) {
+uint16_t USBD_GetMode(void) {
     return usbd_mode;
 }
 
@@ -1099,6 +1148,8 @@ int USBD_SelectMode(uint32_t mode, USBD_HID_ModeInfoTypeDef *hid_info) {
 		ret |= USBD_AddItf_AudPlayback();
 	if (mode & USBD_MODE_AUDR)
 		ret |= USBD_AddItf_AudRecord();
+	if (mode & USBD_MODE_VND)
+		ret |= USBD_AddItf_VND();
 	USBD_EndFixCfgData();
     return ret;
 }
@@ -1319,6 +1370,10 @@ usb_status_t USB_DeviceSetSpeed(usb_device_handle handle, uint8_t speed)
                 {
                     USB_SHORT_TO_LITTLE_ENDIAN_ADDRESS(HS_MSC_DISK_BULK_OUT_PACKET_SIZE, ptr1->endpoint.wMaxPacketSize);
                 }
+                else if (g_cfgFix.roVndEpInNdx == (ptr1->endpoint.bEndpointAddress & USB_ENDPOINT_NUMBER_MASK))
+                {
+                    USB_SHORT_TO_LITTLE_ENDIAN_ADDRESS(HS_VND_BULK_IN_PACKET_SIZE, ptr1->endpoint.wMaxPacketSize);
+                }
                 else
                 {
                 }
@@ -1351,6 +1406,10 @@ usb_status_t USB_DeviceSetSpeed(usb_device_handle handle, uint8_t speed)
                 {
                     USB_SHORT_TO_LITTLE_ENDIAN_ADDRESS(FS_MSC_DISK_BULK_OUT_PACKET_SIZE, ptr1->endpoint.wMaxPacketSize);
                 }
+                else if (g_cfgFix.roVndEpInNdx == (ptr1->endpoint.bEndpointAddress & USB_ENDPOINT_NUMBER_MASK))
+                {
+                    USB_SHORT_TO_LITTLE_ENDIAN_ADDRESS(FS_VND_BULK_IN_PACKET_SIZE, ptr1->endpoint.wMaxPacketSize);
+                }
                 else
                 {
                 }
@@ -1395,6 +1454,9 @@ usb_status_t USB_DeviceSetSpeed(usb_device_handle handle, uint8_t speed)
             g_mscDiskEndpoints[i].maxPacketSize = FS_MSC_DISK_BULK_IN_PACKET_SIZE;
         }
     }
+
+    g_vndEndpoints[0].maxPacketSize = (USB_SPEED_HIGH == speed) ?
+        HS_VND_BULK_IN_PACKET_SIZE : FS_VND_BULK_IN_PACKET_SIZE;
 	// todo: if add more classes, need to adjust as above
     return kStatus_USB_Success;
 }
@@ -116,7 +116,7 @@
 #define USB_DESCRIPTOR_LENGTH_CDC_UNION_FUNC (5)
 
 #define USB_DEVICE_CONFIGURATION_COUNT (1)
-#define USB_DEVICE_STRING_COUNT (11)
+#define USB_DEVICE_STRING_COUNT (12)
 #define USB_DEVICE_LANGUAGE_COUNT (1)
 #define USB_INTERFACE_COUNT (4)	// 20171124
 
@@ -166,6 +166,14 @@
 #define HS_CDC_VCOM_BULK_OUT_PACKET_SIZE (512)
 #define FS_CDC_VCOM_BULK_OUT_PACKET_SIZE (64)
 
+/* Vendor bulk IN interface, raw frame stream for the IDE (usb_app.c). */
+#define USB_VND_CLASS (0xFF)
+#define USB_VND_SUBCLASS (0x00)
+#define USB_VND_PROTOCOL (0x00)
+#define USB_VND_ENDPOINT_COUNT (1)
+#define HS_VND_BULK_IN_PACKET_SIZE (512)
+#define FS_VND_BULK_IN_PACKET_SIZE (64)
+
 /* String descriptor length. */
 #define USB_DESCRIPTOR_LENGTH_STRING0 (4)
 #define USB_DESCRIPTOR_LENGTH_STRING1 (38)
@@ -606,6 +614,8 @@ typedef union _USBDCfgFix_t
 	uint8_t roHidKItfNdx;
 	uint8_t roHidGEpInNdx;
 	uint8_t roHidGItfNdx;
+	uint8_t roVndEpInNdx;
+	uint8_t roVndItfNdx;
 	const uint8_t *pcHidGRptDesc;
 	uint8_t hidGRptDescLen;
 	};
@@ -648,6 +658,7 @@ typedef enum {
     USBD_MODE_AUDP = 0x40,  // audio playback
     USBD_MODE_AUDR = 0x80,  // audio record
     USBD_MODE_AUD  = USBD_MODE_AUDP | USBD_MODE_AUDR,
+    USBD_MODE_VND = 0x100,  // vendor bulk IN, frame stream
     USBD_MODE_CDC_MSC = USBD_MODE_CDC | USBD_MODE_MSC,
     USBD_MODE_CDC_HID = USBD_MODE_CDC | USBD_MODE_HID,
     USBD_MODE_MSC_HID = USBD_MODE_MSC | USBD_MODE_HID,
@@ -655,6 +666,7 @@ typedef enum {
     USBD_MODE_CDC_MSC_AUD = USBD_MODE_CDC | USBD_MODE_MSC | USBD_MODE_AUD, // epIn: 2+1+(1rec+1fdbk), epOut: 1+1+(1plbk + 1ctrl)
     USBD_MODE_CDC_MSC_HIDM = USBD_MODE_CDC_MSC | USBD_MODE_HIDM,
     USBD_MODE_CDC_MSC_HIDG = USBD_MODE_CDC_MSC | USBD_MODE_HIDG,
+    USBD_MODE_CDC_MSC_VND = USBD_MODE_CDC_MSC | USBD_MODE_VND, // epIn: 2+1+1, epOut: 1+1
 } usb_device_mode_t;
 
 typedef struct _USBD_HID_ModeInfoTypeDef {
@@ -741,7 +753,7 @@ usb_status_t USB_DeviceGetStringDescriptor(usb_device_handle handle,
 
 const uint8_t* USBD_GetHidGenericReportDesc(void);
 int USBD_SelectMode(uint32_t mode, USBD_HID_ModeInfoTypeDef *hid_info);
-uint8_t USBD_GetMode(void);
+uint16_t USBD_GetMode(void);
 
 uint32_t USBD_GetEpNdx(usbd_ep_ndx_enum_t ep);
 
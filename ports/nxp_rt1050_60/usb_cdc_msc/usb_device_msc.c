@@ -477,18 +477,19 @@ usb_status_t USB_DeviceMscBulkOut(usb_device_handle handle,
 
         if ((mscHandle->configurationStruct->classCallback != NULL))
         {
+            /* prime the next buffer first, the device writes this one while the host fills the other */
+            if (mscHandle->transferRemaining)
+            {
+                mscHandle->currentOffset += (message->length / mscHandle->lengthOfEachLba);
+                error = USB_DeviceMscRecv(mscHandle);
+            }
+
             if ((USB_DEVICE_MSC_WRITE_10_COMMAND == mscHandle->mscCbw->cbwcb[0]) ||
                 (USB_DEVICE_MSC_WRITE_12_COMMAND == mscHandle->mscCbw->cbwcb[0]))
             {
                 mscHandle->configurationStruct->classCallback((class_handle_t)mscHandle,
                                                               kUSB_DeviceMscEventWriteResponse, (void *)&lbaData);
             }
-
-            if (mscHandle->transferRemaining)
-            {
-                mscHandle->currentOffset += (message->length / mscHandle->lengthOfEachLba);
-                error = USB_DeviceMscRecv(mscHandle);
-            }
         }
 
         if (!mscHandle->transferRemaining)
@@ -1098,6 +1099,17 @@ usb_status_t USB_DeviceMscSend(usb_device_msc_struct_t *mscHandle)
     if (mscHandle->currentOffset < mscHandle->totalLogicalBlockNumber)
     {
         error = USB_DeviceSendRequest(mscHandle->handle, mscHandle->bulkInEndpoint, lba.buffer, lba.size);
+        if (kStatus_USB_Success == error)
+        {
+            /* let the device fetch the next buffer while this one is on the bus */
+            usb_device_lba_app_struct_t next;
+            next.offset = lba.offset + (lba.size / mscHandle->lengthOfEachLba);
+            next.size = mscHandle->transferRemaining - lba.size;
+            next.size = (next.size > lba.size) ? lba.size : next.size;
+            next.buffer = NULL;
+            mscHandle->configurationStruct->classCallback((class_handle_t)mscHandle, kUSB_DeviceMscEventReadAhead,
+                                                          &next);
+        }
     }
     else
     {
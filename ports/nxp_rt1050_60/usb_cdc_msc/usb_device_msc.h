@@ -180,6 +180,8 @@ typedef enum
     kUSB_DeviceMscEventRemovalRequest,     /*!< Prevent_allow_medium_command */
     kUSB_DeviceMscEventSendDiagnostic,     /*!< Send Diagnostic command */
     kUSB_DeviceMscEventStopEjectMedia,     /*!< Start_stop_unit_command */
+    kUSB_DeviceMscEventReadAhead, /*!< a read buffer is on the bus, the device may fetch the next one (offset and size,
+                                     size is 0 after the last buffer of the command) while it goes out */
 
 } USB_DeviceMscEvent_t;
 /*! @brief The MSC device UFI command status structure */
@@ -46,6 +46,7 @@
 #include "usb_device_descriptor.h"
 #include "composite.h"
 #include "hal_wrapper.h"
+#include "irq.h"
 
 #include "lib/utils/interrupt_char.h"
 #include "pendsv.h"
@@ -61,6 +62,7 @@
 * Variables
 ******************************************************************************/
 extern usb_device_endpoint_struct_t g_cdcVcomDicEndpoints[];
+extern void usb_vcp_poll_notify(void); // usb_app.c
 uint8_t g_isVcpOpen;
 volatile uint8_t g_isUsbHostOpen;
 
@@ -131,8 +133,8 @@ usb_status_t _Start_USB_VCOM_Write(class_handle_t handle)
 	usb_status_t error = kStatus_USB_Error;
 	uint32_t len;
 	uint8_t txIdleBkup;
-	uint32_t primask = __get_PRIMASK();
-	__set_PRIMASK(1);	// must disable IRQ, otherwise a buffer can be sent 2 times
+	// must mask USB IRQ, otherwise a buffer can be sent 2 times; CSI stays unmasked
+	uint32_t basepri = raise_irq_pri(IRQ_PRI_CSI + 1);
 	/* User: add your own code for send complete event */
 	len = RingBlk_GetOldestBlk(&s_txRB, &s_pCurTxBuf); 
 	if (len > 0) {
@@ -145,7 +147,7 @@ usb_status_t _Start_USB_VCOM_Write(class_handle_t handle)
 		} else
 			RingBlk_FreeOldestBlk(&s_txRB, 0);	// no longer allow to continue to append data on this block
 	}
-	__set_PRIMASK(primask);
+	restore_irq_pri(basepri);
 	return error;
 }
 
@@ -267,6 +269,7 @@ usb_status_t USB_DeviceCdcVcomCallback(class_handle_t handle, uint32_t event, vo
 				}
 			}
 			// <<<
+			usb_vcp_poll_notify();
         }
         break;
         case kUSB_DeviceCdcEventRecvResponse:
@@ -283,6 +286,7 @@ usb_status_t USB_DeviceCdcVcomCallback(class_handle_t handle, uint32_t event, vo
 							RingBlk_ReuseTakenBlk(&s_rxRB, &s_pCurRxBuf);
 						} else {
 							RingBlk_FixBlkFillCnt(&s_rxRB, epCbParam->length, &s_pCurRxBuf);
+							usb_vcp_poll_notify();
 						}
 						// provide USBD IP to receive next buffer
 						if (s_pCurRxBuf)
@@ -91,9 +91,30 @@ USB_DATA_ALIGNMENT usb_device_mode_parameters_header_struct_t g_ModeParametersHe
     {0x00, 0x00, 0x00, 0x00} /*!<This bit should be set to zero*/
 };
 
-uint32_t g_mscReadRequestBuffer[USB_DEVICE_MSC_READ_BUFF_SIZE >> 2] __attribute__((aligned(16)));
+// 128KB does not fit next to the heap in DTCM, the USB and USDHC drivers keep SDRAM coherent.
+#define MSC_BUF __attribute__((section(".usb_msc_buf"), aligned(32)))
 
-uint32_t g_mscWriteRequestBuffer[USB_DEVICE_MSC_WRITE_BUFF_SIZE >> 2] __attribute__((aligned(16))) ;
+MSC_BUF uint32_t g_mscReadRequestBuffer[2][USB_DEVICE_MSC_READ_BUFF_SIZE >> 2];
+
+MSC_BUF uint32_t g_mscWriteRequestBuffer[2][USB_DEVICE_MSC_WRITE_BUFF_SIZE >> 2];
+
+// Reads are double buffered: while one buffer is on the bus the next part of the command, or
+// after its last buffer the blocks right behind it, is fetched into the other.
+typedef struct _msc_read_ahead {
+	uint8_t cur;		// buffer handed to the bus
+	uint8_t valid;		// the other buffer holds count blocks from offset
+	uint32_t offset;
+	uint32_t count;
+	uint32_t ms;		// when it was fetched
+} msc_read_ahead_t;
+
+// Blocks fetched behind a command are only used by a read that comes soon after, the
+// firmware may have written the disk in the meantime.
+#define MSC_READ_AHEAD_MS	(100)
+
+static msc_read_ahead_t s_readAhead;
+static uint8_t s_writeBuf;
+static uint32_t s_lbaCount;
 
 
 /*******************************************************************************
@@ -124,18 +145,74 @@ void _ConfigLBA(usb_device_lba_information_struct_t *lbaInf)
 	{
 		s_isUseSDCard = 1; //1;
 		lbaInf->totalLbaNumberSupports = sdcard_get_lba_count();
+		s_lbaCount = lbaInf->totalLbaNumberSupports;
 	}
 	else {
-		#if MICROPY_HW_HAS_FLASH
+		// a littlefs /flash is not something a host can mount, the disk stays empty
+		#if MICROPY_HW_HAS_FLASH && !MICROPY_HW_FLASH_FS_LFS2
 		lbaInf->totalLbaNumberSupports = storage_get_block_count();
+		s_lbaCount = lbaInf->totalLbaNumberSupports;
 		#endif
 	}
+	s_readAhead.valid = 0;
 	lbaInf->lengthOfEachLba = 512;
-	lbaInf->bulkInBufferSize = sizeof(g_mscReadRequestBuffer);
-	lbaInf->bulkOutBufferSize = sizeof(g_mscWriteRequestBuffer);
+	lbaInf->bulkInBufferSize = sizeof(g_mscReadRequestBuffer[0]);
+	lbaInf->bulkOutBufferSize = sizeof(g_mscWriteRequestBuffer[0]);
 	lbaInf->logicalUnitNumberSupported = LOGICAL_UNIT_SUPPORTED;
 }
 
+static mp_uint_t _ReadBlocks(uint8_t *buf, uint32_t offset, uint32_t count)
+{
+	mp_uint_t t1 = kStatus_Fail;
+	if (s_isUseSDCard) {
+		if (sdcard_is_present())
+			t1 = sdcard_read_blocks(buf, offset, count);
+	} else {
+	#if MICROPY_HW_HAS_FLASH && !MICROPY_HW_FLASH_FS_LFS2
+		t1 = storage_read_blocks(buf, offset + storage_get_block_offset(), count);
+	#endif
+	}
+	return t1;
+}
+
+// Fetch the blocks after the buffer just put on the bus, size 0 means the command ends there.
+static void _ReadAhead(usb_device_lba_app_struct_t *lba)
+{
+	msc_read_ahead_t *ra = &s_readAhead;
+	uint32_t count = lba->size ? (lba->size >> USB_MSC_BLOCK_SIZE_LOG2)
+								: (sizeof(g_mscReadRequestBuffer[0]) >> USB_MSC_BLOCK_SIZE_LOG2);
+	ra->valid = 0;
+	if (lba->offset >= s_lbaCount) {
+		return;
+	}
+	if (count > (s_lbaCount - lba->offset)) {
+		count = s_lbaCount - lba->offset;
+	}
+	if (0 == _ReadBlocks((uint8_t *)&g_mscReadRequestBuffer[ra->cur ^ 1][0], lba->offset, count)) {
+		ra->offset = lba->offset;
+		ra->count = count;
+		ra->ms = mp_hal_ticks_ms();
+		ra->valid = 1;
+	}
+}
+
+// Hand out the read-ahead buffer if it holds the request, otherwise read into the other one.
+static mp_uint_t _ReadRequest(usb_device_lba_app_struct_t *lba)
+{
+	msc_read_ahead_t *ra = &s_readAhead;
+	uint32_t count = lba->size >> USB_MSC_BLOCK_SIZE_LOG2;
+	if (ra->valid && (ra->offset == lba->offset) && (ra->count >= count)
+		&& ((mp_hal_ticks_ms() - ra->ms) < MSC_READ_AHEAD_MS)) {
+		ra->valid = 0;
+		ra->cur ^= 1;
+		lba->buffer = (uint8_t *)&g_mscReadRequestBuffer[ra->cur][0];
+		return 0;
+	}
+	ra->valid = 0;
+	lba->buffer = (uint8_t *)&g_mscReadRequestBuffer[ra->cur][0];
+	return _ReadBlocks(lba->buffer, lba->offset, count);
+}
+
 usb_status_t USB_DeviceMscCallback2(class_handle_t handle, uint32_t event, void *param)
 {
     usb_status_t error = kStatus_USB_Success;
@@ -156,7 +233,7 @@ usb_status_t USB_DeviceMscCallback2(class_handle_t handle, uint32_t event, void
 					if (sdcard_is_present())
 						t1 = sdcard_write_blocks(lba->buffer,lba->offset, lba->size >> USB_MSC_BLOCK_SIZE_LOG2);
 				} else {
-					#if MICROPY_HW_HAS_FLASH
+					#if MICROPY_HW_HAS_FLASH && !MICROPY_HW_FLASH_FS_LFS2
 					t1 = storage_write_blocks(lba->buffer,lba->offset + storage_get_block_offset(), lba->size >> USB_MSC_BLOCK_SIZE_LOG2);
 					#endif
 				}
@@ -174,16 +251,16 @@ usb_status_t USB_DeviceMscCallback2(class_handle_t handle, uint32_t event, void
             break;
         case kUSB_DeviceMscEventWriteRequest:
             lba = (usb_device_lba_app_struct_t *)param;
-			lba->buffer = (uint8_t *)&g_mscWriteRequestBuffer[0];  // for LPC USBIP, SDK's MSC module handles 64-byte alignment
+			lba->buffer = (uint8_t *)&g_mscWriteRequestBuffer[0][0];  // for LPC USBIP, SDK's MSC module handles 64-byte alignment
             break;
         case kUSB_DeviceMscEventReadRequest:
             lba = (usb_device_lba_app_struct_t *)param;
-            lba->buffer = (uint8_t *)&g_mscReadRequestBuffer[0];
+            lba->buffer = (uint8_t *)&g_mscReadRequestBuffer[0][0];
 			if (s_isUseSDCard) {
 				if (sdcard_is_present())
 					t1 = sdcard_read_blocks(lba->buffer,lba->offset, lba->size >> USB_MSC_BLOCK_SIZE_LOG2);
 			} else {
-			#if MICROPY_HW_HAS_FLASH
+			#if MICROPY_HW_HAS_FLASH && !MICROPY_HW_FLASH_FS_LFS2
 				t1 = storage_read_blocks(lba->buffer,lba->offset + storage_get_block_offset(), lba->size >> USB_MSC_BLOCK_SIZE_LOG2);
 			#endif
 			}
@@ -273,7 +350,7 @@ usb_status_t USB_DeviceMscCallback(class_handle_t handle, uint32_t event, void *
 					if (sdcard_is_present())
 						t1 = sdcard_write_blocks(lba->buffer,lba->offset, lba->size >> USB_MSC_BLOCK_SIZE_LOG2);
 				} else {
-				#if MICROPY_HW_HAS_FLASH
+				#if MICROPY_HW_HAS_FLASH && !MICROPY_HW_FLASH_FS_LFS2
 					t1 = storage_write_blocks(lba->buffer,lba->offset + storage_get_block_offset(), lba->size >> USB_MSC_BLOCK_SIZE_LOG2);
 				#endif
 				}
@@ -307,21 +384,15 @@ usb_status_t USB_DeviceMscCallback(class_handle_t handle, uint32_t event, void *
             lba->buffer = tempbuffer->buffer;
             currentTrasfer = tempbuffer;
 #else
-            lba->buffer = (uint8_t *)&g_mscWriteRequestBuffer[0];
+            // the class primes the next buffer before writing the last one out
+            s_writeBuf ^= 1;
+            lba->buffer = (uint8_t *)&g_mscWriteRequestBuffer[s_writeBuf][0];
 #endif
+            s_readAhead.valid = 0;
             break;
         case kUSB_DeviceMscEventReadRequest:
             lba = (usb_device_lba_app_struct_t *)param;
-            lba->buffer = (uint8_t *)&g_mscReadRequestBuffer[0];
-
-			if (s_isUseSDCard) {
-				if (sdcard_is_present())
-					t1 = sdcard_read_blocks(lba->buffer,lba->offset, lba->size >> USB_MSC_BLOCK_SIZE_LOG2);
-			} else {
-			#if MICROPY_HW_HAS_FLASH
-				t1 = storage_read_blocks(lba->buffer,lba->offset + storage_get_block_offset(), lba->size >> USB_MSC_BLOCK_SIZE_LOG2);
-			#endif
-			}
+			t1 = _ReadRequest(lba);
 
 			if (0 != t1)
             {
@@ -333,6 +404,9 @@ usb_status_t USB_DeviceMscCallback(class_handle_t handle, uint32_t event, void *
                 error = kStatus_USB_Error;
             }
 
+            break;
+        case kUSB_DeviceMscEventReadAhead:
+            _ReadAhead((usb_device_lba_app_struct_t *)param);
             break;
         case kUSB_DeviceMscEventGetLbaInformation:
             _ConfigLBA((usb_device_lba_information_struct_t *)param);
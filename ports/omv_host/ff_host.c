@@ -0,0 +1,233 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * The FatFS calls of imlib on host files.
+ *
+ * The lookup of ff_wrapper.c gives every path to these as it is, relative paths are the
+ * host's working directory. f_tell(), f_size() and f_eof() are macros reading the FIL,
+ * so fptr and obj.objsize are kept up to date. obj.id is the slot of the FILE.
+ *
+ */
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "py/mpconfig.h"
+#include "lib/oofatfs/ff.h"
+
+#define FF_HOST_FILES   (16)
+
+STATIC FILE *ff_host_files[FF_HOST_FILES];
+
+STATIC FRESULT ff_host_result(void) {
+    switch (errno) {
+        case ENOENT: return FR_NO_FILE;
+        case ENOTDIR: return FR_NO_PATH;
+        case EEXIST: return FR_EXIST;
+        case EACCES: case EPERM: case EISDIR: return FR_DENIED;
+        case EROFS: return FR_WRITE_PROTECTED;
+        case ENOMEM: return FR_NOT_ENOUGH_CORE;
+        case EMFILE: case ENFILE: return FR_TOO_MANY_OPEN_FILES;
+        case EINVAL: return FR_INVALID_PARAMETER;
+        default: return FR_DISK_ERR;
+    }
+}
+
+STATIC FILE *ff_host_file(FIL *fp) {
+    return (fp->obj.id < FF_HOST_FILES) ? ff_host_files[fp->obj.id] : NULL;
+}
+
+const char *ffs_strerror(FRESULT res) {
+    switch (res) {
+        case FR_OK: return "Succeeded";
+        case FR_NO_FILE: return "Could not find the file";
+        case FR_NO_PATH: return "Could not find the path";
+        case FR_EXIST: return "Access denied due to prohibited access";
+        case FR_DENIED: return "Access denied due to prohibited access or directory full";
+        case FR_INVALID_OBJECT: return "The file/directory object is invalid";
+        case FR_WRITE_PROTECTED: return "The physical drive is write protected";
+        case FR_NOT_ENOUGH_CORE: return "LFN working buffer could not be allocated";
+        case FR_TOO_MANY_OPEN_FILES: return "Number of open files > _FS_SHARE";
+        case FR_INVALID_PARAMETER: return "Given parameter is invalid";
+        case FR_DISK_ERR: return "A hard error occurred in the low level disk I/O layer";
+        default: return "unknown error";
+    }
+}
+
+FRESULT f_open(FATFS *fs, FIL *fp, const TCHAR *path, BYTE mode) {
+    memset(fp, 0, sizeof(FIL));
+    fp->obj.id = FF_HOST_FILES;
+
+    int slot = 0;
+    for (; (slot < FF_HOST_FILES) && ff_host_files[slot]; slot++);
+    if (slot == FF_HOST_FILES) {
+        return FR_TOO_MANY_OPEN_FILES;
+    }
+
+    struct stat st;
+    bool exists = (stat(path, &st) == 0);
+    if (exists && S_ISDIR(st.st_mode)) {
+        return FR_DENIED;
+    }
+    if ((mode & FA_CREATE_NEW) && exists) {
+        return FR_EXIST;
+    }
+    if (!(mode & (FA_CREATE_NEW | FA_CREATE_ALWAYS | FA_OPEN_ALWAYS)) && !exists) {
+        return FR_NO_FILE;
+    }
+
+    // FatFS can read a file opened FA_WRITE only, stdio can't: always open for update.
+    const char *fmode = "rb";
+    if (mode & (FA_WRITE | FA_CREATE_NEW | FA_CREATE_ALWAYS | FA_OPEN_ALWAYS)) {
+        fmode = (!exists || (mode & FA_CREATE_ALWAYS)) ? "w+b" : "r+b";
+    }
+    FILE *f = fopen(path, fmode);
+    if (f == NULL) {
+        return ff_host_result();
+    }
+
+    fseek(f, 0, SEEK_END);
+    fp->obj.objsize = ftell(f);
+    if ((mode & FA_OPEN_APPEND) == FA_OPEN_APPEND) {
+        fp->fptr = fp->obj.objsize;
+    } else {
+        fseek(f, 0, SEEK_SET);
+    }
+    fp->obj.fs = fs;
+    fp->obj.id = slot;
+    fp->flag = mode;
+    ff_host_files[slot] = f;
+    return FR_OK;
+}
+
+FRESULT f_close(FIL *fp) {
+    FILE *f = ff_host_file(fp);
+    if (f == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    ff_host_files[fp->obj.id] = NULL;
+    fp->obj.id = FF_HOST_FILES;
+    return fclose(f) ? ff_host_result() : FR_OK;
+}
+
+FRESULT f_read(FIL *fp, void *buff, UINT btr, UINT *br) {
+    FILE *f = ff_host_file(fp);
+    *br = 0;
+    if (f == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    *br = fread(buff, 1, btr, f);
+    fp->fptr += *br;
+    return ferror(f) ? FR_DISK_ERR : FR_OK;
+}
+
+FRESULT f_write(FIL *fp, const void *buff, UINT btw, UINT *bw) {
+    FILE *f = ff_host_file(fp);
+    *bw = 0;
+    if (f == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    // A read may have been last, stdio needs a seek between the two.
+    fseek(f, fp->fptr, SEEK_SET);
+    *bw = fwrite(buff, 1, btw, f);
+    fp->fptr += *bw;
+    if (fp->fptr > fp->obj.objsize) {
+        fp->obj.objsize = fp->fptr;
+    }
+    return ferror(f) ? FR_DISK_ERR : FR_OK;
+}
+
+FRESULT f_lseek(FIL *fp, FSIZE_t ofs) {
+    FILE *f = ff_host_file(fp);
+    if (f == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    // As FatFS, a seek past the end of a read-only file stops at the end.
+    if ((ofs > fp->obj.objsize) && !(fp->flag & FA_WRITE)) {
+        ofs = fp->obj.objsize;
+    }
+    if (fseek(f, ofs, SEEK_SET)) {
+        return ff_host_result();
+    }
+    fp->fptr = ofs;
+    return FR_OK;
+}
+
+FRESULT f_truncate(FIL *fp) {
+    FILE *f = ff_host_file(fp);
+    if (f == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    fflush(f);
+    if (ftruncate(fileno(f), fp->fptr)) {
+        return ff_host_result();
+    }
+    fp->obj.objsize = fp->fptr;
+    return FR_OK;
+}
+
+FRESULT f_sync(FIL *fp) {
+    FILE *f = ff_host_file(fp);
+    if (f == NULL) {
+        return FR_INVALID_OBJECT;
+    }
+    return fflush(f) ? ff_host_result() : FR_OK;
+}
+
+FRESULT f_expand(FIL *fp, FSIZE_t szf, BYTE opt) {
+    // Only a hint to keep the file contiguous, the host has nothing to do.
+    return (ff_host_file(fp) == NULL) ? FR_INVALID_OBJECT : FR_OK;
+}
+
+FRESULT f_stat(FATFS *fs, const TCHAR *path, FILINFO *fno) {
+    struct stat st;
+    if (stat(path, &st)) {
+        return ff_host_result();
+    }
+    if (fno) {
+        memset(fno, 0, sizeof(FILINFO));
+        fno->fsize = st.st_size;
+        fno->fattrib = S_ISDIR(st.st_mode) ? AM_DIR : 0;
+        const char *name = strrchr(path, '/');
+        strncpy(fno->fname, name ? (name + 1) : path, sizeof(fno->fname) - 1);
+    }
+    return FR_OK;
+}
+
+FRESULT f_opendir(FATFS *fs, FF_DIR *dp, const TCHAR *path) {
+    // Only used to test that a directory exists.
+    struct stat st;
+    if (stat(path, &st)) {
+        return FR_NO_PATH;
+    }
+    memset(dp, 0, sizeof(FF_DIR));
+    dp->obj.fs = fs;
+    return S_ISDIR(st.st_mode) ? FR_OK : FR_NO_PATH;
+}
+
+FRESULT f_closedir(FF_DIR *dp) {
+    return FR_OK;
+}
+
+FRESULT f_mkdir(FATFS *fs, const TCHAR *path) {
+    #ifdef _WIN32
+    return mkdir(path) ? ff_host_result() : FR_OK;
+    #else
+    return mkdir(path, 0777) ? ff_host_result() : FR_OK;
+    #endif
+}
+
+FRESULT f_unlink(FATFS *fs, const TCHAR *path) {
+    struct stat st;
+    if (stat(path, &st)) {
+        return ff_host_result();
+    }
+    return (S_ISDIR(st.st_mode) ? rmdir(path) : unlink(path)) ? ff_host_result() : FR_OK;
+}
+
+FRESULT f_rename(FATFS *fs, const TCHAR *path_old, const TCHAR *path_new) {
+    return rename(path_old, path_new) ? ff_host_result() : FR_OK;
+}
@@ -0,0 +1,12 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-in for the port's board header, the omv code only takes the CMSIS
+ * attributes from it.
+ *
+ */
+#ifndef __BOARD_H__
+#define __BOARD_H__
+#include "core_cm3.h"
+#endif // __BOARD_H__
@@ -0,0 +1,178 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-in for the CMSIS core header.
+ *
+ * arm_math.h picks it with ARM_MATH_CM3, so its own C versions of the DSP intrinsics are
+ * used. The core intrinsics and the few DSP ones imlib uses directly are done in C here,
+ * bit exact with the instructions. __USUB8 sets the GE flags __SEL reads, in a global.
+ *
+ */
+#ifndef __CORE_CM3_H__
+#define __CORE_CM3_H__
+#include <stdint.h>
+
+#define __ASM               __asm__
+#define __INLINE            inline
+#define __STATIC_INLINE     static inline
+#define __STATIC_FORCEINLINE static inline __attribute__((always_inline))
+#define __WEAK              __attribute__((weak))
+#define __PACKED            __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)        __attribute__((aligned(x)))
+#define __UNUSED            __attribute__((unused))
+#define __USED              __attribute__((used))
+#define __NO_RETURN         __attribute__((__noreturn__))
+#define __RESTRICT          __restrict
+// and the two of the board's HAL, hal_wrapper.h
+#define __weak              __attribute__((weak))
+#define __packed            __attribute__((__packed__))
+
+struct __attribute__((packed)) T_UINT16_READ { uint16_t v; };
+struct __attribute__((packed)) T_UINT32_READ { uint32_t v; };
+#define __UNALIGNED_UINT16_READ(addr) (((const struct T_UINT16_READ *) (const void *) (addr))->v)
+#define __UNALIGNED_UINT32_READ(addr) (((const struct T_UINT32_READ *) (const void *) (addr))->v)
+struct __attribute__((packed)) T_UINT32_WRITE { uint32_t v; };
+#define __UNALIGNED_UINT32_WRITE(addr, val) (void) ((((struct T_UINT32_WRITE *) (void *) (addr))->v) = (val))
+
+#define __NOP()             do { } while (0)
+#define __WFI()             do { } while (0)
+#define __WFE()             do { } while (0)
+#define __SEV()             do { } while (0)
+#define __ISB()             __sync_synchronize()
+#define __DSB()             __sync_synchronize()
+#define __DMB()             __sync_synchronize()
+
+extern uint32_t host_apsr_ge;
+
+// A device header type, only passed around by pointer.
+typedef struct _GPIO_Type GPIO_Type;
+
+// The core timers imlib and nn read, updated from the host clock on every access:
+// DWT->CYCCNT counts nanoseconds, SysTick->VAL the ms tick down from LOAD as on the board.
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+extern DWT_Type *host_dwt(void);
+extern SysTick_Type *host_systick(void);
+#define DWT                 (host_dwt())
+#define SysTick             (host_systick())
+
+__STATIC_INLINE int32_t __SSAT(int32_t val, uint32_t sat)
+{
+    const int32_t max = (int32_t) ((1U << (sat - 1)) - 1), min = -max - 1;
+    return (val > max) ? max : ((val < min) ? min : val);
+}
+
+__STATIC_INLINE uint32_t __USAT(int32_t val, uint32_t sat)
+{
+    const int32_t max = (int32_t) ((1ULL << sat) - 1);
+    return (val > max) ? max : ((val < 0) ? 0 : val);
+}
+
+__STATIC_INLINE uint32_t __CLZ(uint32_t x)
+{
+    return x ? __builtin_clz(x) : 32;
+}
+
+__STATIC_INLINE uint32_t __RBIT(uint32_t x)
+{
+    x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+    x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F) | ((x & 0x0F0F0F0F) << 4);
+    return __builtin_bswap32(x);
+}
+
+__STATIC_INLINE uint32_t __REV(uint32_t x)
+{
+    return __builtin_bswap32(x);
+}
+
+__STATIC_INLINE uint32_t __REV16(uint32_t x)
+{
+    return ((x >> 8) & 0x00FF00FF) | ((x & 0x00FF00FF) << 8);
+}
+
+__STATIC_INLINE int32_t __REVSH(int32_t x)
+{
+    return (int16_t) __builtin_bswap16(x);
+}
+
+__STATIC_INLINE uint32_t __ROR(uint32_t x, uint32_t n)
+{
+    n &= 31;
+    return n ? ((x >> n) | (x << (32 - n))) : x;
+}
+
+__STATIC_INLINE uint32_t __UXTB16(uint32_t x)
+{
+    return x & 0x00FF00FF;
+}
+
+__STATIC_INLINE uint32_t __SADD16(uint32_t x, uint32_t y)
+{
+    return ((x + y) & 0x0000FFFF) | (((x >> 16) + (y >> 16)) << 16);
+}
+
+__STATIC_INLINE uint32_t __UQADD8(uint32_t x, uint32_t y)
+{
+    uint32_t r = 0;
+    for (int i = 0; i < 32; i += 8) {
+        uint32_t s = ((x >> i) & 0xFF) + ((y >> i) & 0xFF);
+        r |= ((s > 0xFF) ? 0xFF : s) << i;
+    }
+    return r;
+}
+
+__STATIC_INLINE uint32_t __UQSUB8(uint32_t x, uint32_t y)
+{
+    uint32_t r = 0;
+    for (int i = 0; i < 32; i += 8) {
+        int32_t d = (int32_t) ((x >> i) & 0xFF) - (int32_t) ((y >> i) & 0xFF);
+        r |= ((d < 0) ? 0 : d) << i;
+    }
+    return r;
+}
+
+__STATIC_INLINE uint32_t __UHADD8(uint32_t x, uint32_t y)
+{
+    uint32_t r = 0;
+    for (int i = 0; i < 32; i += 8) {
+        r |= ((((x >> i) & 0xFF) + ((y >> i) & 0xFF)) >> 1) << i;
+    }
+    return r;
+}
+
+__STATIC_INLINE uint32_t __USUB8(uint32_t x, uint32_t y)
+{
+    uint32_t r = 0, ge = 0;
+    for (int i = 0; i < 4; i++) {
+        uint32_t a = (x >> (i * 8)) & 0xFF, b = (y >> (i * 8)) & 0xFF;
+        r |= ((a - b) & 0xFF) << (i * 8);
+        ge |= (a >= b) << i;
+    }
+    host_apsr_ge = ge;
+    return r;
+}
+
+__STATIC_INLINE uint32_t __SEL(uint32_t x, uint32_t y)
+{
+    uint32_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        if (host_apsr_ge & (1 << i)) {
+            mask |= 0xFFU << (i * 8);
+        }
+    }
+    return (x & mask) | (y & ~mask);
+}
+
+#endif // __CORE_CM3_H__
@@ -0,0 +1,10 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-in for the port's extint.h, which mp.h includes. There is no such hardware here.
+ *
+ */
+#ifndef __EXTINT_H__
+#define __EXTINT_H__
+#endif // __EXTINT_H__
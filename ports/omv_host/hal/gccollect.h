@@ -0,0 +1,11 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-in for the port's GC header, the heap is a static array in main.c.
+ *
+ */
+#ifndef __GCCOLLECT_H__
+#define __GCCOLLECT_H__
+void gc_collect(void);
+#endif // __GCCOLLECT_H__
@@ -0,0 +1,28 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-in for the port's flash model store, which is always empty here: models are
+ * loaded from files.
+ *
+ */
+#ifndef __MODEL_STORE_H__
+#define __MODEL_STORE_H__
+#include <stdint.h>
+#define MODEL_STORE_NAME_LEN        (52)
+
+typedef struct model_store_entry {
+    uint32_t magic;
+    uint32_t size;
+    uint32_t reserved;
+    char name[MODEL_STORE_NAME_LEN];
+} model_store_entry_t;
+
+typedef int (*model_store_read_t)(void *arg, void *buf, uint32_t len);
+
+const uint8_t *model_store_find(const char *name, uint32_t *size);
+const model_store_entry_t *model_store_next(const model_store_entry_t *prev);
+uint32_t model_store_avail();
+int model_store_add(const char *name, uint32_t size, model_store_read_t read, void *arg);
+int model_store_erase();
+#endif // __MODEL_STORE_H__
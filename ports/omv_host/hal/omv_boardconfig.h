@@ -0,0 +1,32 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Board configuration of the omv host port.
+ *
+ */
+#ifndef __OMV_BOARDCONFIG_H__
+#define __OMV_BOARDCONFIG_H__
+// Architecture info
+#define OMV_ARCH_STR            "OpenMV host port" // 33 chars max
+#define OMV_BOARD_TYPE          "HOST"
+
+// If buffer size is bigger than this threshold, the quality is reduced.
+// This is only used for JPEG images sent to the IDE not normal compression.
+#define JPEG_QUALITY_THRESH     (160*120*2)
+// Low and high JPEG QS.
+#define JPEG_QUALITY_LOW        35
+#define JPEG_QUALITY_HIGH       80
+
+#define OMV_UMM_BLOCK_SIZE      16
+// The framebuffer and fb_alloc share OMV_HOST_FB_MEMORY_SIZE (Makefile), as much as the
+// largest board has, so the benchmarks' MemoryError skips match it. No speed tiers.
+#define OMV_FB_ALLOC_DTCM_SIZE  (0)
+#define OMV_FB_ALLOC_OCRAM_SIZE (0)
+// Scratch arena for imlib list nodes and temporary arrays, 0 to keep them on the GC heap.
+#define OMV_XALLOC_ARENA_SIZE   (8 * 1024)
+// fb_alloc read-ahead of file_buffer_on(), the file parsers and model loaders.
+#define OMV_FILE_BUFFER_SIZE    (32 * 1024)
+
+#define OMV_JPEG_BUF_SIZE       (24 * 1024) // IDE JPEG buffer (header + data).
+#endif //__OMV_BOARDCONFIG_H__
@@ -0,0 +1,22 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-in for the port's overlay manager, all code is resident on the host.
+ *
+ */
+#ifndef __OVERLAY_MANAGER_C__
+#define __OVERLAY_MANAGER_C__
+#include <stdint.h>
+#define OVLY_NOT_MOVED	0
+#define OVLY_LAB_TAB	1
+#define OVLY_CODE_BLOB	OVLY_LAB_TAB
+#define OVLY_HAAR		2
+#define OVLY_CODE_HAAR	2
+#define OVLY_FLASHPGM	3
+#define OVLY_COUNT		4
+
+extern int OverlaySwitch(uint8_t ovlyNdx);
+extern int OverlaySetToDefault(void);
+extern void OverlayPrefetch(uint8_t ovlyNdx);
+#endif
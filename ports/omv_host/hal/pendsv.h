@@ -0,0 +1,11 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-in for the port's PendSV header, there is nothing to pend on the host.
+ *
+ */
+#ifndef __PENDSV_H__
+#define __PENDSV_H__
+static inline void pendsv_init(void) { }
+#endif // __PENDSV_H__
@@ -0,0 +1,10 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-in for the port's pin.h, which mp.h includes. There is no such hardware here.
+ *
+ */
+#ifndef __PIN_H__
+#define __PIN_H__
+#endif // __PIN_H__
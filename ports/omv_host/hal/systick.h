@@ -0,0 +1,18 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-in for the port's SysTick header, the millisecond clock is the host's.
+ *
+ */
+#ifndef __SYSTICK_H__
+#define __SYSTICK_H__
+#include <stdint.h>
+#include <stdbool.h>
+
+void systick_sleep(volatile uint32_t ms);
+uint32_t systick_current_millis(void);
+bool sys_tick_has_passed(uint32_t stc, uint32_t delay_ms);
+// the board's idle wait between ticks, declared by its hal_wrapper.h
+void HAL_WFI(void);
+#endif // __SYSTICK_H__
@@ -0,0 +1,10 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-in for the port's usb.h, which mp.h includes. There is no such hardware here.
+ *
+ */
+#ifndef __USB_H__
+#define __USB_H__
+#endif // __USB_H__
@@ -0,0 +1,208 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * omv host port: runs a script against imlib and nn on a PC.
+ *
+ *     omv_host [-X heapsize=<n>[k|m]] [-X xmpy=<file>] script.py [args...]
+ *
+ * A sensor that plays back image files, or a synthetic frame, stands in for the camera.
+ * The exit status is 0, 1 for an uncaught exception or the code given to sys.exit().
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "py/compile.h"
+#include "py/runtime.h"
+#include "py/gc.h"
+#include "py/stackctrl.h"
+#include "py/mphal.h"
+#include "extmod/vfs.h"
+#include "extmod/vfs_posix.h"
+#include "genhdr/mpversion.h"
+#ifdef _WIN32
+#include "ports/windows/fmode.h"
+#endif
+
+#include "fb_alloc.h"
+#include "framebuffer.h"
+#include "ff_wrapper.h"
+#include "xalloc.h"
+#include "imlib.h"
+#include "task.h"
+
+// As on the board the heap is a few MB, larger on a 64 bit host because pointers are larger.
+STATIC long heap_size = 4 * 1024 * 1024 * (sizeof(mp_uint_t) / 4);
+
+// The .xmpy image standing in for the board's modules.xmpy in the model store.
+STATIC uint8_t *xmpy_image;
+STATIC uint32_t xmpy_len;
+
+const uint8_t *omv_host_xmpy(uint32_t *len) {
+    *len = xmpy_len;
+    return xmpy_image;
+}
+
+STATIC bool load_xmpy(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    xmpy_len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    xmpy_image = malloc(xmpy_len);
+    bool ok = (xmpy_image != NULL) && (fread(xmpy_image, 1, xmpy_len, f) == xmpy_len);
+    fclose(f);
+    return ok;
+}
+
+extern void modsensor_init0(void);
+
+// As the board's main.c, the upper part of the heap is the large object pool.
+STATIC void gc_init_heap(char *start, char *end) {
+    char *split = start + (end - start) / 100 * (100 - MICROPY_GC_LARGE_POOL_PERCENT);
+    split = (char*)((uintptr_t)split & ~(uintptr_t)(MICROPY_BYTES_PER_GC_BLOCK - 1));
+    gc_init(start, split);
+    gc_add_large_pool(split, end);
+}
+
+STATIC int usage(char **argv) {
+    printf(
+"usage: %s [<opts>] <script> [args...]\n"
+"Options:\n"
+"--version : show version information\n"
+"-X heapsize=<n>[k|m] : set the heap size for the GC (default %ld)\n"
+"-X xmpy=<file> : import the modules of a tools/mpy-tool.py --xip image\n",
+    argv[0], heap_size);
+    return 1;
+}
+
+STATIC void omv_init0(void) {
+    fb_alloc_init0();
+    fb_slots_init0();
+    xalloc_arena_init0();
+    imlib_thresholds_lut_init0();
+    imlib_pyramid_init0();
+    imlib_remap_init0();
+    task_init0();
+    file_buffer_init0();
+    modsensor_init0();
+}
+
+// The status of SystemExit, 1 for other exceptions, as the unix port does it.
+STATIC int handle_uncaught_exception(mp_obj_base_t *exc) {
+    if (mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(exc->type), MP_OBJ_FROM_PTR(&mp_type_SystemExit))) {
+        mp_obj_t exit_val = mp_obj_exception_get_value(MP_OBJ_FROM_PTR(exc));
+        mp_int_t val = 0;
+        if (exit_val != mp_const_none && !mp_obj_get_int_maybe(exit_val, &val)) {
+            val = 1;
+        }
+        return val & 255;
+    }
+    mp_obj_print_exception(&mp_plat_print, MP_OBJ_FROM_PTR(exc));
+    return 1;
+}
+
+STATIC int run_file(const char *path) {
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_lexer_t *lex = mp_lexer_new_from_file(path);
+        qstr source_name = lex->source_name;
+        mp_store_global(MP_QSTR___file__, MP_OBJ_NEW_QSTR(source_name));
+        #if MICROPY_COMP_STREAM
+        // a statement at a time, as pyexec runs the board's scripts
+        mp_parse_stream_t ps;
+        mp_parse_stream_init(&ps, lex);
+        mp_obj_t stmt_fun;
+        while ((stmt_fun = mp_compile_stream_next(&ps, source_name, false)) != MP_OBJ_NULL) {
+            mp_call_function_0(stmt_fun);
+        }
+        mp_parse_stream_deinit(&ps);
+        #else
+        mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+        mp_obj_t module_fun = mp_compile(&parse_tree, source_name, false);
+        mp_call_function_0(module_fun);
+        #endif
+        nlr_pop();
+        return 0;
+    } else {
+        return handle_uncaught_exception(nlr.ret_val);
+    }
+}
+
+MP_NOINLINE int main_(int argc, char **argv) {
+    mp_stack_set_limit(40000 * (BYTES_PER_WORD / 4));
+
+    int a = 1;
+    for (; (a < argc) && (argv[a][0] == '-'); a++) {
+        if (strcmp(argv[a], "--version") == 0) {
+            printf("MicroPython " MICROPY_GIT_TAG " on " MICROPY_BUILD_DATE "; omv host port\n");
+            return 0;
+        } else if ((strcmp(argv[a], "-X") == 0) && (a + 1 < argc)
+                && (strncmp(argv[a + 1], "heapsize=", sizeof("heapsize=") - 1) == 0)) {
+            char *end;
+            heap_size = strtol(argv[++a] + sizeof("heapsize=") - 1, &end, 0);
+            if ((*end | 0x20) == 'k') {
+                heap_size *= 1024;
+            } else if ((*end | 0x20) == 'm') {
+                heap_size *= 1024 * 1024;
+            }
+        } else if ((strcmp(argv[a], "-X") == 0) && (a + 1 < argc)
+                && (strncmp(argv[a + 1], "xmpy=", sizeof("xmpy=") - 1) == 0)) {
+            if (!load_xmpy(argv[++a] + sizeof("xmpy=") - 1)) {
+                printf("%s: can't read %s\n", argv[0], argv[a] + sizeof("xmpy=") - 1);
+                return 1;
+            }
+        } else {
+            return usage(argv);
+        }
+    }
+    if (a >= argc) {
+        return usage(argv);
+    }
+
+    char *heap = malloc(heap_size);
+    gc_init_heap(heap, heap + heap_size);
+
+    mp_init();
+    #ifdef _WIN32
+    set_fmode_binary();
+    #endif
+
+    // The host file system is the root, relative paths are the host's working directory.
+    mp_obj_t args[2] = {
+        mp_type_vfs_posix.make_new(&mp_type_vfs_posix, 0, 0, NULL),
+        MP_OBJ_NEW_QSTR(MP_QSTR__slash_),
+    };
+    mp_vfs_mount(2, args, (mp_map_t *) &mp_const_empty_map);
+    MP_STATE_VM(vfs_cur) = MP_STATE_VM(vfs_mount_table);
+
+    mp_obj_list_init(mp_sys_path, 0);
+    mp_obj_list_append(mp_sys_path, MP_OBJ_NEW_QSTR(MP_QSTR_));
+    mp_obj_list_init(mp_sys_argv, 0);
+    for (int i = a; i < argc; i++) {
+        mp_obj_list_append(mp_sys_argv, MP_OBJ_NEW_QSTR(qstr_from_str(argv[i])));
+    }
+
+    omv_init0();
+
+    int ret = run_file(argv[a]);
+
+    mp_deinit();
+    free(heap);
+    free(xmpy_image);
+    return ret;
+}
+
+int main(int argc, char **argv) {
+    mp_stack_ctrl_init();
+    return main_(argc, argv);
+}
+
+void nlr_jump_fail(void *val) {
+    fprintf(stderr, "FATAL: uncaught NLR %p\n", val);
+    exit(1);
+}
@@ -0,0 +1,422 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Sensor module of the omv host port.
+ *
+ * Frames are played back from image files given to sensor.set_source(), in a loop, scaled
+ * (nearest) and converted to the frame size and pixel format set, BAYER frames are mosaiced
+ * as the BGGR raw frames of the board and YUV422 frames are its Y0 U Y1 V. Without a source every
+ * frame is a synthetic test pattern that moves one pixel per frame, the same on every run.
+ * The C functions py_nn.c captures with behave as sensor.c's: async captures are done at
+ * once and picked up by the next sensor_snapshot_into() of the same destination.
+ *
+ */
+#include "py/runtime.h"
+#include "py/mphal.h"
+
+#include "sensor.h"
+#include "framebuffer.h"
+#include "imlib.h"
+#include "py_helper.h"
+#include "py_image.h"
+#include "py_assert.h"
+
+sensor_t s_sensor;
+
+const int resolution[][2] = {
+    {0,    0   },
+    // C/SIF Resolutions
+    {88,   72  },    /* QQCIF     */
+    {176,  144 },    /* QCIF      */
+    {352,  288 },    /* CIF       */
+    {88,   60  },    /* QQSIF     */
+    {176,  120 },    /* QSIF      */
+    {352,  240 },    /* SIF       */
+    // VGA Resolutions
+    {40,   30  },    /* QQQQVGA   */
+    {80,   60  },    /* QQQVGA    */
+    {160,  120 },    /* QQVGA     */
+    {320,  240 },    /* QVGA      */
+    {640,  480 },    /* VGA       */
+    {60,   40  },    /* HQQQVGA   */
+    {120,  80  },    /* HQQVGA    */
+    {240,  160 },    /* HQVGA     */
+    // FFT Resolutions
+    {64,   32  },    /* 64x32     */
+    {64,   64  },    /* 64x64     */
+    {128,  64  },    /* 128x64    */
+    {128,  128 },    /* 128x128   */
+    // Other
+    {128,  160 },    /* LCD       */
+    {128,  160 },    /* QQVGA2    */
+    {720,  480 },    /* WVGA      */
+    {752,  480 },    /* WVGA2     */
+    {800,  600 },    /* SVGA      */
+    {1024, 768 },    /* XGA       */
+    {1280, 1024},    /* SXGA      */
+    {1600, 1200},    /* UXGA      */
+};
+
+static uint32_t s_frameSeq;
+static uint8_t *s_armedDst;     // captured by sensor_snapshot_async_into(), not picked up yet
+
+void modsensor_init0(void)
+{
+    memset(&s_sensor, 0, sizeof(s_sensor));
+    s_sensor.pixformat = PIXFORMAT_RGB565;
+    s_sensor.framesize = FRAMESIZE_QVGA;
+    MAIN_FB()->w = MAIN_FB()->u = s_sensor.fb_w = resolution[FRAMESIZE_QVGA][0];
+    MAIN_FB()->h = MAIN_FB()->v = s_sensor.fb_h = resolution[FRAMESIZE_QVGA][1];
+    MAIN_FB()->x = MAIN_FB()->y = 0;
+    MAIN_FB()->bpp = 0;
+    fb_ring_size = 0;
+    s_frameSeq = 0;
+    s_armedDst = NULL;
+    MP_STATE_PORT(sensor_source) = mp_const_none;
+}
+
+static int sensor_fb_bpp(void)
+{
+    switch (s_sensor.pixformat) {
+        case PIXFORMAT_GRAYSCALE: return IMAGE_BPP_GRAYSCALE;
+        case PIXFORMAT_BAYER: return IMAGE_BPP_BAYER;
+        case PIXFORMAT_YUV422: return IMAGE_BPP_YUV422;
+        default: return IMAGE_BPP_RGB565;
+    }
+}
+
+// Stores a pixel in the frame's format, a BAYER pixel keeps the color of its BGGR site and a
+// YUV422 pixel its Y and the U (left) or V (right) of its pair.
+static void sensor_put_pixel(image_t *img, int x, int y, int r, int g, int b)
+{
+    if (img->bpp == IMAGE_BPP_GRAYSCALE) {
+        IMAGE_PUT_GRAYSCALE_PIXEL(img, x, y, (r * 38 + g * 75 + b * 15) >> 7);
+    } else if (img->bpp == IMAGE_BPP_YUV422) {
+        uint8_t *p = IMAGE_COMPUTE_YUV422_PIXEL_ROW_PTR(img, y) + (x * 2);
+        int c = (x & 1) ? (((128 * r) - (107 * g) - (21 * b)) >> 8) : (((-43 * r) - (85 * g) + (128 * b)) >> 8);
+        p[0] = (r * 38 + g * 75 + b * 15) >> 7;
+        p[1] = IM_MAX(IM_MIN(c + 128, 255), 0);
+    } else if (img->bpp == IMAGE_BPP_BAYER) {
+        IMAGE_PUT_GRAYSCALE_PIXEL(img, x, y, (y & 1) ? ((x & 1) ? r : g) : ((x & 1) ? g : b));
+    } else {
+        IMAGE_PUT_RGB565_PIXEL(img, x, y, COLOR_R8_G8_B8_TO_RGB565(r, g, b));
+    }
+}
+
+// The test pattern: a gradient, a bar grid and a square, all moving with the frame number.
+static void sensor_draw_pattern(image_t *img, uint32_t seq)
+{
+    int sq = img->h / 4, sqX = seq % (img->w - sq), sqY = (seq / 2) % (img->h - sq);
+    for (int y = 0; y < img->h; y++) {
+        for (int x = 0; x < img->w; x++) {
+            int r, g, b;
+            if ((x >= sqX) && (x < sqX + sq) && (y >= sqY) && (y < sqY + sq)) {
+                r = 255, g = 255, b = 255;
+            } else if ((((x + seq) / 16) + (y / 16)) % 5 == 0) {
+                r = 0, g = 0, b = 0;
+            } else {
+                r = (x * 255) / img->w, g = (y * 255) / img->h, b = ((x + y + seq) * 2) & 255;
+            }
+            sensor_put_pixel(img, x, y, r, g, b);
+        }
+    }
+}
+
+// Nearest scaling of a source frame, with the GRAYSCALE <-> RGB565 conversion.
+static void sensor_draw_source(image_t *img, image_t *src)
+{
+    for (int y = 0; y < img->h; y++) {
+        int srcY = (y * src->h) / img->h;
+        for (int x = 0; x < img->w; x++) {
+            int srcX = (x * src->w) / img->w;
+            if (src->bpp == IMAGE_BPP_GRAYSCALE) {
+                int p = IMAGE_GET_GRAYSCALE_PIXEL(src, srcX, srcY);
+                if (img->bpp == IMAGE_BPP_RGB565) {
+                    IMAGE_PUT_RGB565_PIXEL(img, x, y, COLOR_R8_G8_B8_TO_RGB565(p, p, p));
+                } else if (img->bpp == IMAGE_BPP_YUV422) {
+                    sensor_put_pixel(img, x, y, p, p, p);
+                } else {
+                    IMAGE_PUT_GRAYSCALE_PIXEL(img, x, y, p);
+                }
+            } else {
+                int p = IMAGE_GET_RGB565_PIXEL(src, srcX, srcY);
+                if (img->bpp == IMAGE_BPP_GRAYSCALE) {
+                    IMAGE_PUT_GRAYSCALE_PIXEL(img, x, y, COLOR_RGB565_TO_Y(p));
+                } else if ((img->bpp == IMAGE_BPP_BAYER) || (img->bpp == IMAGE_BPP_YUV422)) {
+                    sensor_put_pixel(img, x, y, COLOR_RGB565_TO_R8(p), COLOR_RGB565_TO_G8(p), COLOR_RGB565_TO_B8(p));
+                } else {
+                    IMAGE_PUT_RGB565_PIXEL(img, x, y, p);
+                }
+            }
+        }
+    }
+}
+
+static int sensor_capture(uint8_t *pDst)
+{
+    MAIN_FB()->bpp = sensor_fb_bpp();
+    image_t frame = { .w=MAIN_FB()->w, .h=MAIN_FB()->h, .bpp=MAIN_FB()->bpp, .pixels=pDst };
+    imlib_pyramid_invalidate(NULL);    // new frame, drop the levels of the old one
+
+    mp_obj_t source = MP_STATE_PORT(sensor_source);
+    if (source != mp_const_none) {
+        size_t len;
+        mp_obj_t *frames;
+        mp_obj_get_array(source, &len, &frames);
+        sensor_draw_source(&frame, py_image_cobj(frames[s_frameSeq % len]));
+    } else {
+        sensor_draw_pattern(&frame, s_frameSeq);
+    }
+    s_frameSeq++;
+    return 0;
+}
+
+int sensor_snapshot_into(image_t *pImg, uint8_t *pDst, uint32_t dstSize)
+{
+    OMV_PROF_SCOPE("sensor_snapshot");
+    MAIN_FB()->bpp = sensor_fb_bpp();
+    if (pDst == NULL) {
+        pDst = MAIN_FB()->pixels;
+    } else if (dstSize < fb_buffer_size()) {
+        return -2;
+    }
+    if (pDst != s_armedDst) {
+        sensor_capture(pDst);
+    }
+    s_armedDst = NULL;
+
+    if (pImg) {
+        pImg->w = MAIN_FB()->w, pImg->h = MAIN_FB()->h, pImg->bpp = MAIN_FB()->bpp;
+        pImg->pixels = pDst;
+    }
+    return 0;
+}
+
+int sensor_snapshot(sensor_t *sensor, image_t *pImg, streaming_cb_t streaming_cb)
+{
+    return sensor_snapshot_into(pImg, NULL, 0);
+}
+
+int sensor_snapshot_async_into(uint8_t *pDst, uint32_t dstSize)
+{
+    MAIN_FB()->bpp = sensor_fb_bpp();
+    if (dstSize < fb_buffer_size()) {
+        return -2;
+    }
+    sensor_capture(pDst);
+    s_armedDst = pDst;
+    return 0;
+}
+
+int sensor_set_pixformat(pixformat_t pixformat)
+{
+    if ((pixformat != PIXFORMAT_GRAYSCALE) && (pixformat != PIXFORMAT_RGB565) && (pixformat != PIXFORMAT_BAYER)
+    && (pixformat != PIXFORMAT_YUV422)) {
+        return -1;
+    }
+    s_sensor.pixformat = pixformat;
+    s_armedDst = NULL;
+    MAIN_FB()->bpp = 0;
+    return 0;
+}
+
+int sensor_set_framesize(framesize_t framesize)
+{
+    if ((framesize <= FRAMESIZE_INVALID) || (framesize >= (sizeof(resolution) / sizeof(resolution[0])))) {
+        return -1;
+    }
+    s_sensor.framesize = framesize;
+    s_armedDst = NULL;
+    MAIN_FB()->bpp = -1;
+    s_sensor.fb_w = MAIN_FB()->w = MAIN_FB()->u = resolution[framesize][0];
+    s_sensor.fb_h = MAIN_FB()->h = MAIN_FB()->v = resolution[framesize][1];
+    return 0;
+}
+
+static mp_obj_t py_sensor_reset()
+{
+    mp_obj_t source = MP_STATE_PORT(sensor_source);
+    uint32_t seq = s_frameSeq;
+    modsensor_init0();
+    MP_STATE_PORT(sensor_source) = source;
+    s_frameSeq = seq;
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_set_pixformat(mp_obj_t pixformat)
+{
+    if (sensor_set_pixformat(mp_obj_get_int(pixformat)) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Pixel format is not supported!"));
+    }
+    return mp_const_true;
+}
+
+static mp_obj_t py_sensor_set_framesize(mp_obj_t framesize)
+{
+    if (sensor_set_framesize(mp_obj_get_int(framesize)) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "Failed to set framesize!"));
+    }
+    return mp_const_true;
+}
+
+static mp_obj_t py_sensor_get_pixformat()
+{
+    return mp_obj_new_int(s_sensor.pixformat);
+}
+
+static mp_obj_t py_sensor_get_framesize()
+{
+    return mp_obj_new_int(s_sensor.framesize);
+}
+
+static mp_obj_t py_sensor_snapshot()
+{
+    mp_obj_t image = py_image(0, 0, 0, 0);
+    sensor_snapshot(&s_sensor, (image_t*) py_image_cobj(image), NULL);
+    return image;
+}
+
+static mp_obj_t py_sensor_skip_frames(uint n_args, const mp_obj_t *args, mp_map_t *kw_args)
+{
+    // Frames are ready at once, time= only matters together with a count.
+    mp_map_elem_t *kw_arg = mp_map_lookup(kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_time), MP_MAP_LOOKUP);
+    int n = n_args ? mp_obj_get_int(args[0]) : 10;
+    uint32_t millis = mp_hal_ticks_ms();
+
+    for (int i = 0; i < n; i++) {
+        if ((kw_arg != NULL) && ((mp_hal_ticks_ms() - millis) >= mp_obj_get_int(kw_arg->value))) {
+            break;
+        }
+        sensor_snapshot(&s_sensor, NULL, NULL);
+    }
+    return mp_const_none;
+}
+
+static mp_obj_t py_sensor_width()
+{
+    return mp_obj_new_int(resolution[s_sensor.framesize][0]);
+}
+
+static mp_obj_t py_sensor_height()
+{
+    return mp_obj_new_int(resolution[s_sensor.framesize][1]);
+}
+
+static mp_obj_t py_sensor_get_fb()
+{
+    if (MAIN_FB()->bpp <= 0) {
+        return mp_const_none;
+    }
+    return py_image(MAIN_FB()->w, MAIN_FB()->h, MAIN_FB()->bpp, MAIN_FB()->pixels);
+}
+
+static mp_obj_t py_sensor_get_id()
+{
+    return mp_obj_new_int(0);
+}
+
+// sensor.set_source(path or [paths]), None for the test pattern again. Files are decoded
+// here, once, BMP/PPM/PGM as image.Image() reads them.
+static mp_obj_t py_sensor_set_source(mp_obj_t source)
+{
+    s_frameSeq = 0;
+    s_armedDst = NULL;
+    if (source == mp_const_none) {
+        MP_STATE_PORT(sensor_source) = mp_const_none;
+        return mp_const_none;
+    }
+
+    size_t len = 1;
+    mp_obj_t *paths = &source;
+    if (!MP_OBJ_IS_STR(source)) {
+        mp_obj_get_array(source, &len, &paths);
+    }
+    PY_ASSERT_TRUE_MSG(len > 0, "No frames!");
+
+    mp_obj_t frames = mp_obj_new_list(0, NULL);
+    for (size_t i = 0; i < len; i++) {
+        image_t img = {};
+        imlib_load_image(&img, mp_obj_str_get_str(paths[i]));
+        PY_ASSERT_TRUE_MSG((img.bpp == IMAGE_BPP_GRAYSCALE) || (img.bpp == IMAGE_BPP_RGB565),
+                "Frames must be GRAYSCALE or RGB565!");
+        mp_obj_list_append(frames, py_image(img.w, img.h, img.bpp, img.pixels));
+    }
+    MP_STATE_PORT(sensor_source) = frames;
+    return mp_const_none;
+}
+
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_reset_obj,               py_sensor_reset);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_pixformat_obj,       py_sensor_set_pixformat);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_framesize_obj,       py_sensor_set_framesize);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_pixformat_obj,       py_sensor_get_pixformat);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_framesize_obj,       py_sensor_get_framesize);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_snapshot_obj,            py_sensor_snapshot);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(py_sensor_skip_frames_obj, 0,     py_sensor_skip_frames);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_width_obj,               py_sensor_width);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_height_obj,              py_sensor_height);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_fb_obj,              py_sensor_get_fb);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_id_obj,              py_sensor_get_id);
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_source_obj,          py_sensor_set_source);
+
+STATIC const mp_map_elem_t globals_dict_table[] = {
+    { MP_OBJ_NEW_QSTR(MP_QSTR___name__),            MP_OBJ_NEW_QSTR(MP_QSTR_sensor)},
+
+    // Pixel Formats
+    { MP_OBJ_NEW_QSTR(MP_QSTR_GRAYSCALE),           MP_OBJ_NEW_SMALL_INT(PIXFORMAT_GRAYSCALE)},/* 1BPP/GRAYSCALE*/
+    { MP_OBJ_NEW_QSTR(MP_QSTR_RGB565),              MP_OBJ_NEW_SMALL_INT(PIXFORMAT_RGB565)},   /* 2BPP/RGB565*/
+    { MP_OBJ_NEW_QSTR(MP_QSTR_BAYER),               MP_OBJ_NEW_SMALL_INT(PIXFORMAT_BAYER)},    /* 1BPP/RAW*/
+    { MP_OBJ_NEW_QSTR(MP_QSTR_YUV422),              MP_OBJ_NEW_SMALL_INT(PIXFORMAT_YUV422)},   /* 2BPP/YUV422*/
+
+    // C/SIF Resolutions
+    { MP_OBJ_NEW_QSTR(MP_QSTR_QQCIF),               MP_OBJ_NEW_SMALL_INT(FRAMESIZE_QQCIF)},    /* 88x72     */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_QCIF),                MP_OBJ_NEW_SMALL_INT(FRAMESIZE_QCIF)},     /* 176x144   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_CIF),                 MP_OBJ_NEW_SMALL_INT(FRAMESIZE_CIF)},      /* 352x288   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_QQSIF),               MP_OBJ_NEW_SMALL_INT(FRAMESIZE_QQSIF)},    /* 88x60     */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_QSIF),                MP_OBJ_NEW_SMALL_INT(FRAMESIZE_QSIF)},     /* 176x120   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_SIF),                 MP_OBJ_NEW_SMALL_INT(FRAMESIZE_SIF)},      /* 352x240   */
+    // VGA Resolutions
+    { MP_OBJ_NEW_QSTR(MP_QSTR_QQQQVGA),             MP_OBJ_NEW_SMALL_INT(FRAMESIZE_QQQQVGA)},  /* 40x30     */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_QQQVGA),              MP_OBJ_NEW_SMALL_INT(FRAMESIZE_QQQVGA)},   /* 80x60     */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_QQVGA),               MP_OBJ_NEW_SMALL_INT(FRAMESIZE_QQVGA)},    /* 160x120   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_QVGA),                MP_OBJ_NEW_SMALL_INT(FRAMESIZE_QVGA)},     /* 320x240   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_VGA),                 MP_OBJ_NEW_SMALL_INT(FRAMESIZE_VGA)},      /* 640x480   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_HQQQVGA),             MP_OBJ_NEW_SMALL_INT(FRAMESIZE_HQQQVGA)},  /* 60x40     */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_HQQVGA),              MP_OBJ_NEW_SMALL_INT(FRAMESIZE_HQQVGA)},   /* 120x80    */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_HQVGA),               MP_OBJ_NEW_SMALL_INT(FRAMESIZE_HQVGA)},    /* 240x160   */
+    // FFT Resolutions
+    { MP_OBJ_NEW_QSTR(MP_QSTR_B64X32),              MP_OBJ_NEW_SMALL_INT(FRAMESIZE_64X32)},    /* 64x32     */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_B64X64),              MP_OBJ_NEW_SMALL_INT(FRAMESIZE_64X64)},    /* 64x64     */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_B128X64),             MP_OBJ_NEW_SMALL_INT(FRAMESIZE_128X64)},   /* 128x64    */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_B128X128),            MP_OBJ_NEW_SMALL_INT(FRAMESIZE_128X128)},  /* 128x128   */
+    // Other
+    { MP_OBJ_NEW_QSTR(MP_QSTR_LCD),                 MP_OBJ_NEW_SMALL_INT(FRAMESIZE_LCD)},      /* 128x160   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_QQVGA2),              MP_OBJ_NEW_SMALL_INT(FRAMESIZE_QQVGA2)},   /* 128x160   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_WVGA),                MP_OBJ_NEW_SMALL_INT(FRAMESIZE_WVGA)},     /* 720x480   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_WVGA2),               MP_OBJ_NEW_SMALL_INT(FRAMESIZE_WVGA2)},    /* 752x480   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_SVGA),                MP_OBJ_NEW_SMALL_INT(FRAMESIZE_SVGA)},     /* 800x600   */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_XGA),                 MP_OBJ_NEW_SMALL_INT(FRAMESIZE_XGA)},      /* 1024x768  */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_SXGA),                MP_OBJ_NEW_SMALL_INT(FRAMESIZE_SXGA)},     /* 1280x1024 */
+    { MP_OBJ_NEW_QSTR(MP_QSTR_UXGA),                MP_OBJ_NEW_SMALL_INT(FRAMESIZE_UXGA)},     /* 1600x1200 */
+
+    // Sensor functions
+    { MP_OBJ_NEW_QSTR(MP_QSTR_reset),               (mp_obj_t)&py_sensor_reset_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_pixformat),       (mp_obj_t)&py_sensor_set_pixformat_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_framesize),       (mp_obj_t)&py_sensor_set_framesize_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_pixformat),       (mp_obj_t)&py_sensor_get_pixformat_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_framesize),       (mp_obj_t)&py_sensor_get_framesize_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_snapshot),            (mp_obj_t)&py_sensor_snapshot_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_skip_frames),         (mp_obj_t)&py_sensor_skip_frames_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_width),               (mp_obj_t)&py_sensor_width_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_height),              (mp_obj_t)&py_sensor_height_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_fb),              (mp_obj_t)&py_sensor_get_fb_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_id),              (mp_obj_t)&py_sensor_get_id_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_source),          (mp_obj_t)&py_sensor_set_source_obj },
+};
+
+STATIC MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
+
+const mp_obj_module_t sensor_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_t)&globals_dict,
+};
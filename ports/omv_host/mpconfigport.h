@@ -0,0 +1,250 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013-2015 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Options to control how MicroPython is built for the omv host port: the interpreter
+// and the omv image/nn stack of nxp_rt1050_60 running on a PC, for profiling and CI.
+
+#ifndef __INCLUDED_MPCONFIGPORT_H
+#define __INCLUDED_MPCONFIGPORT_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// memory allocation policies
+#define MICROPY_ALLOC_PATH_MAX      (PATH_MAX)
+
+// emitters
+#define MICROPY_PERSISTENT_CODE_LOAD (1)
+// the .xmpy image given with -X xmpy=<file>, see main.c
+#define MICROPY_MODULE_FROZEN_XIP   (1)
+const uint8_t *omv_host_xmpy(uint32_t *len);
+#define MICROPY_MODULE_FROZEN_XIP_IMAGE(len) omv_host_xmpy(len)
+
+// compiler configuration
+#define MICROPY_COMP_MODULE_CONST   (1)
+#define MICROPY_COMP_TRIPLE_TUPLE_ASSIGN (1)
+#define MICROPY_COMP_RETURN_IF_EXPR (1)
+#define MICROPY_COMP_STREAM         (1)
+
+// optimisations, the same as the board's so Python overhead compares
+#define MICROPY_OPT_COMPUTED_GOTO   (1)
+#define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (1)
+#define MICROPY_OPT_MAP_COMPACT (1)
+#define MICROPY_OPT_SUPERINSTRUCTIONS (1)
+#define MICROPY_OPT_MPZ_BITWISE     (1)
+
+// Python internal features
+// scripts, imports and open() go to the host file system, mounted at / by main.c
+#define MICROPY_READER_VFS          (1)
+#define MICROPY_VFS                 (1)
+#define MICROPY_VFS_POSIX           (1)
+#define MICROPY_ENABLE_GC           (1)
+#define MICROPY_ENABLE_FINALISER    (1)
+// the board's heap layout and sweep, see gc_init_heap in main.c
+#define MICROPY_GC_SPLIT_POOLS      (1)
+#define MICROPY_GC_LARGE_THRESHOLD  (1024)
+#define MICROPY_GC_LARGE_POOL_PERCENT (50)
+#define MICROPY_GC_INCREMENTAL_SWEEP (1)
+#define MICROPY_GC_IDLE_SWEEP_BLOCKS (256)
+#define MICROPY_STACK_CHECK         (1)
+#define MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF (1)
+#define MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE (256)
+#define MICROPY_PREALLOC_EXCEPTIONS (1)
+#define MICROPY_LONGINT_IMPL        (MICROPY_LONGINT_IMPL_MPZ)
+#define MICROPY_LONGINT_MPZ_INLINE  (1)
+#define MICROPY_ENABLE_SOURCE_LINE  (1)
+#define MICROPY_ERROR_REPORTING     (MICROPY_ERROR_REPORTING_DETAILED)
+// imlib's results are floats as on the board
+#define MICROPY_FLOAT_IMPL          (MICROPY_FLOAT_IMPL_FLOAT)
+#define MICROPY_USE_INTERNAL_PRINTF (0)
+#define MICROPY_MODULE_WEAK_LINKS   (1)
+#define MICROPY_CAN_OVERRIDE_BUILTINS (1)
+#define MICROPY_ENABLE_SCHEDULER    (1)
+#define MICROPY_SCHEDULER_DEPTH     (8)
+
+// Define to 1 to use undertested inefficient GC helper implementation
+// (if more efficient arch-specific one is not available).
+#ifndef MICROPY_GCREGS_SETJMP
+    #ifdef __mips__
+        #define MICROPY_GCREGS_SETJMP (1)
+    #else
+        #define MICROPY_GCREGS_SETJMP (0)
+    #endif
+#endif
+
+// control over Python builtins
+#define MICROPY_PY_FUNCTION_ATTRS   (1)
+#define MICROPY_PY_BUILTINS_STR_UNICODE (1)
+#define MICROPY_PY_BUILTINS_STR_PARTITION (1)
+#define MICROPY_PY_BUILTINS_MEMORYVIEW (1)
+#define MICROPY_PY_BUILTINS_FROZENSET (1)
+#define MICROPY_PY_BUILTINS_SLICE_ATTRS (1)
+#define MICROPY_PY_ALL_SPECIAL_METHODS (1)
+#define MICROPY_PY_BUILTINS_COMPILE (1)
+#define MICROPY_PY_BUILTINS_EXECFILE (1)
+#define MICROPY_PY_BUILTINS_POW3    (1)
+#define MICROPY_PY_MICROPYTHON_MEM_INFO (1)
+#define MICROPY_PY_MICROPYTHON_POOL (1)
+#define MICROPY_PY_MICROPYTHON_POOL_ARENA_SIZE (8 * 1024)
+#define MICROPY_PY_ARRAY_SLICE_ASSIGN (1)
+#define MICROPY_PY_COLLECTIONS_ORDEREDDICT (1)
+#define MICROPY_PY_MATH_SPECIAL_FUNCTIONS (1)
+#define MICROPY_PY_SYS_MAXSIZE      (1)
+#define MICROPY_PY_SYS_EXIT         (1)
+#define MICROPY_PY_SYS_PLATFORM     "omv_host"
+// open() and sys.std* are VFS posix files, with binary modes as on the board
+#define MICROPY_PY_SYS_STDFILES     (1)
+#define MICROPY_PY_IO_FILEIO        (1)
+#define MICROPY_PY_UERRNO           (1)
+
+// extended modules
+#define MICROPY_PY_UCTYPES          (1)
+#define MICROPY_PY_UZLIB            (1)
+#define MICROPY_PY_UZLIB_COMPIO     (1)
+#define MICROPY_PY_UJSON            (1)
+#define MICROPY_PY_UJSON_PARSER     (1)
+#define MICROPY_PY_UJSON_DUMP_BUF   (128)
+#define MICROPY_PY_URE              (1)
+#define MICROPY_PY_URE_MATCH_INTO   (1)
+#define MICROPY_PY_URE_CACHE        (4)
+#define MICROPY_PY_UHEAPQ           (1)
+#define MICROPY_PY_UTIMEQ           (1)
+#define MICROPY_PY_UTIMEQ_WHEEL     (1)
+#define MICROPY_PY_UBINASCII        (1)
+#define MICROPY_PY_URANDOM          (1)
+#define MICROPY_PY_URANDOM_EXTRA_FUNCS (1)
+#define MICROPY_PY_UTIME_MP_HAL     (1)
+// as the board's, without the PXP the CPU does every fill and blit
+#define MICROPY_PY_FRAMEBUF         (1)
+#define MICROPY_PY_FRAMEBUF_IMLIB_FONT (1)
+int py_image_framebuf_view(void *obj, void **buf, int *w, int *h);
+#define MICROPY_PY_FRAMEBUF_VIEW(obj, buf, w, h) py_image_framebuf_view((obj), (buf), (w), (h))
+
+// use vfs's functions for import stat and builtin open
+#define mp_import_stat mp_vfs_import_stat
+#define mp_builtin_open mp_vfs_open
+#define mp_builtin_open_obj mp_vfs_open_obj
+#define mp_type_fileio mp_type_vfs_posix_fileio
+#define mp_type_textio mp_type_vfs_posix_textio
+
+// extra built in names to add to the global namespace
+#define MICROPY_PORT_BUILTINS \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_open), (mp_obj_t)&mp_builtin_open_obj },
+
+// extra built in modules to add to the list of known ones
+extern const struct _mp_obj_module_t mp_module_utime;
+extern const struct _mp_obj_module_t mp_module_uos;
+extern const struct _mp_obj_module_t sensor_module;
+extern const struct _mp_obj_module_t image_module;
+extern const struct _mp_obj_module_t nn_module;
+
+#define MICROPY_PORT_BUILTIN_MODULES \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_utime), (mp_obj_t)&mp_module_utime }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_uos), (mp_obj_t)&mp_module_uos }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_sensor), (mp_obj_t)&sensor_module }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_image), (mp_obj_t)&image_module }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_nn), (mp_obj_t)&nn_module }, \
+
+#define MICROPY_PORT_BUILTIN_MODULE_WEAK_LINKS \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_time), (mp_obj_t)&mp_module_utime }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_os), (mp_obj_t)&mp_module_uos }, \
+
+#define MP_STATE_PORT MP_STATE_VM
+
+#define MICROPY_PORT_ROOT_POINTERS \
+    /* last compiled imlib thresholds LUT */ \
+    void *imlib_thresholds_lut; \
+    \
+    /* imlib pyramid / integral image cache of the current frame */ \
+    void *imlib_pyramid; \
+    \
+    /* imlib lens_corr() / rotation_corr() remap tables */ \
+    void *imlib_remap[2]; \
+    \
+    /* omv.submit() tasks waiting to run */ \
+    void *omv_tasks; \
+    \
+    /* frames of the file-backed sensor, modsensor.c */ \
+    mp_obj_t sensor_source; \
+
+// type definitions for the specific machine
+
+#ifdef __LP64__
+typedef long mp_int_t; // must be pointer size
+typedef unsigned long mp_uint_t; // must be pointer size
+#elif defined ( __MINGW32__ ) && defined( _WIN64 )
+typedef __int64 mp_int_t;
+typedef unsigned __int64 mp_uint_t;
+#else
+// These are definitions for machines where sizeof(int) == sizeof(void*),
+// regardless for actual size.
+typedef int mp_int_t; // must be pointer size
+typedef unsigned int mp_uint_t; // must be pointer size
+#endif
+
+typedef long mp_off_t;
+
+// omv.submit() tasks run while Python waits, and the sweep a collection left over
+extern void task_poll();
+extern bool gc_sweep_step(size_t n_blocks);
+#define MICROPY_EVENT_POLL_HOOK \
+    do { \
+        task_poll(); \
+        gc_sweep_step(MICROPY_GC_IDLE_SWEEP_BLOCKS); \
+    } while (0);
+
+#define MP_PLAT_PRINT_STRN(str, len) mp_hal_stdout_tx_strn_cooked(str, len)
+
+// There are no interrupts on the host, the IRQ masks of the omv code are no-ops.
+static inline void enable_irq(mp_uint_t state) {
+    (void) state;
+}
+
+static inline mp_uint_t disable_irq(void) {
+    return 0;
+}
+
+#define MICROPY_BEGIN_ATOMIC_SECTION()     disable_irq()
+#define MICROPY_END_ATOMIC_SECTION(state)  enable_irq(state)
+
+// We need to provide a declaration/definition of alloca()
+#if defined( _WIN32 )
+#include <malloc.h>
+#else
+#include <alloca.h>
+#endif
+
+// chdir(), unlink() and rmdir() of extmod/vfs_posix.c
+#include <unistd.h>
+
+#ifdef _WIN32
+#include <limits.h>
+#ifndef PATH_MAX
+#define PATH_MAX                    (260)
+#endif
+#endif
+
+#endif // __INCLUDED_MPCONFIGPORT_H
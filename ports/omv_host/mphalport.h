@@ -0,0 +1,17 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * HAL of the omv host port, timing and stdio come from the host in omv_host.c.
+ *
+ */
+#ifndef __MPHALPORT_H__
+#define __MPHALPORT_H__
+
+static inline void mp_hal_set_interrupt_char(int c) {
+    (void) c;
+}
+
+// ticks_cpu() counts nanoseconds and is always running
+void mp_hal_ticks_cpu_enable(void);
+#endif // __MPHALPORT_H__
@@ -0,0 +1,187 @@
+/*
+ * This file is part of the OpenMV project.
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Host stand-ins for the board the omv code runs on.
+ *
+ * Timing and stdio use the host's. The framebuffer and IDE JPEG buffer are the arrays the
+ * Makefile points the board's linker symbols at. All code is resident, the model store is
+ * empty (nn loads models from files) and imlib_config.h leaves out the PXP, so imlib and nn
+ * take the code paths of a board without them. The IDE is never connected.
+ *
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "py/runtime.h"
+#include "py/mphal.h"
+#include "imlib.h"
+#include "mutex.h"
+#include "trace.h"
+#include "omv_boardconfig.h"
+#include "overlay_manager.h"
+#include "model_store.h"
+#include "systick.h"
+
+// _fb_base and _fballoc, see the Makefile
+char omv_host_fb_memory[OMV_HOST_FB_MEMORY_SIZE] __attribute__((aligned(32)));
+// _jpeg_buf
+char omv_host_jpeg_memory[OMV_JPEG_BUF_SIZE] __attribute__((aligned(32)));
+
+// The GE flags of __USUB8 for __SEL, hal/core_cm3.h.
+uint32_t host_apsr_ge;
+
+// Timing ////////////////////////////////////////////////////////////////////
+
+STATIC uint64_t host_ticks_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+mp_uint_t mp_hal_ticks_ms(void) {
+    return host_ticks_ns() / 1000000;
+}
+
+mp_uint_t mp_hal_ticks_us(void) {
+    return host_ticks_ns() / 1000;
+}
+
+mp_uint_t mp_hal_ticks_cpu(void) {
+    return host_ticks_ns();
+}
+
+void mp_hal_ticks_cpu_enable(void) {
+}
+
+void mp_hal_delay_us(mp_uint_t us) {
+    usleep(us);
+}
+
+void mp_hal_delay_ms(mp_uint_t ms) {
+    mp_uint_t t0 = mp_hal_ticks_ms();
+    while ((mp_hal_ticks_ms() - t0) < ms) {
+        MICROPY_EVENT_POLL_HOOK
+        usleep(1000);
+    }
+}
+
+DWT_Type *host_dwt(void) {
+    static DWT_Type dwt;
+    dwt.CYCCNT = host_ticks_ns();
+    return &dwt;
+}
+
+SysTick_Type *host_systick(void) {
+    static SysTick_Type systick = { .LOAD = 999999 };
+    systick.VAL = systick.LOAD - ((host_ticks_ns() % 1000000) * systick.LOAD) / 1000000;
+    return &systick;
+}
+
+// The board's idle wait.
+void HAL_WFI(void) {
+    usleep(100);
+}
+
+uint32_t systick_current_millis(void) {
+    return mp_hal_ticks_ms();
+}
+
+void systick_sleep(volatile uint32_t ms) {
+    mp_hal_delay_ms(ms);
+}
+
+bool sys_tick_has_passed(uint32_t stc, uint32_t delay_ms) {
+    return (systick_current_millis() - stc) >= delay_ms;
+}
+
+// Stdio /////////////////////////////////////////////////////////////////////
+
+int mp_hal_stdin_rx_chr(void) {
+    int c = getchar();
+    return (c == EOF) ? 4 : c; // ^D at the end
+}
+
+void mp_hal_stdout_tx_strn(const char *str, size_t len) {
+    fwrite(str, 1, len, stdout);
+}
+
+void mp_hal_stdout_tx_strn_cooked(const char *str, size_t len) {
+    mp_hal_stdout_tx_strn(str, len);
+}
+
+void mp_hal_stdout_tx_str(const char *str) {
+    mp_hal_stdout_tx_strn(str, strlen(str));
+}
+
+// Board hardware ///////////////////////////////////////////////////////////
+
+void mutex_init(mutex_t *mutex) {
+    mutex->tid = 0;
+    mutex->lock = 0;
+}
+
+void mutex_lock(mutex_t *mutex, uint32_t tid) {
+    mutex->tid = tid;
+    mutex->lock = 1;
+}
+
+int mutex_try_lock(mutex_t *mutex, uint32_t tid) {
+    if (mutex->lock && (mutex->tid != tid)) {
+        return 0;
+    }
+    mutex_lock(mutex, tid);
+    return 1;
+}
+
+void mutex_unlock(mutex_t *mutex, uint32_t tid) {
+    if (mutex->tid == tid) {
+        mutex->lock = 0;
+    }
+}
+
+int OverlaySwitch(uint8_t ovlyNdx) {
+    return 0;
+}
+
+int OverlaySetToDefault(void) {
+    return 0;
+}
+
+void OverlayPrefetch(uint8_t ovlyNdx) {
+}
+
+const uint8_t *model_store_find(const char *name, uint32_t *size) {
+    return NULL;
+}
+
+const model_store_entry_t *model_store_next(const model_store_entry_t *prev) {
+    return NULL;
+}
+
+uint32_t model_store_avail() {
+    return 0;
+}
+
+int model_store_add(const char *name, uint32_t size, model_store_read_t read, void *arg) {
+    return -1;
+}
+
+int model_store_erase() {
+    return -1;
+}
+
+// The IDE's frames go nowhere.
+void VCOM_OmvWriteAlways(const uint8_t *buf, uint32_t len) {
+}
+
+void usb_vnd_cancel(void) {
+}
+
+// Tracing is never enabled without the IDE's debug channel.
+volatile bool trace_enabled;
+
+void trace_insert(uint32_t event, uint32_t arg) {
+}
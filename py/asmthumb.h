@@ -235,6 +235,37 @@ static inline void asm_thumb_ldrb_rlo_rlo_i5(asm_thumb_t *as, uint rlo_dest, uin
 static inline void asm_thumb_ldrh_rlo_rlo_i5(asm_thumb_t *as, uint rlo_dest, uint rlo_base, uint byte_offset)
     { asm_thumb_format_9_10(as, ASM_THUMB_FORMAT_10_LDRH, rlo_dest, rlo_base, byte_offset); }
 
+// Thumb-2 loads/stores: register index scaled by the access size, or a 12-bit byte offset
+
+#define ASM_THUMB_OP_STRB_W (0xf800)
+#define ASM_THUMB_OP_STRH_W (0xf820)
+#define ASM_THUMB_OP_STR_W  (0xf840)
+#define ASM_THUMB_OP_LDRB_W (0xf810)
+#define ASM_THUMB_OP_LDRH_W (0xf830)
+#define ASM_THUMB_OP_LDR_W  (0xf850)
+#define ASM_THUMB_OP_W_IMM12 (0x0080)
+
+static inline void asm_thumb_ldst_w_reg_reg_reg(asm_thumb_t *as, uint op, uint r_dest, uint r_base, uint r_index, uint shift)
+    { asm_thumb_op32(as, op | r_base, (r_dest << 12) | (shift << 4) | r_index); }
+static inline void asm_thumb_ldst_w_reg_reg_i12(asm_thumb_t *as, uint op, uint r_dest, uint r_base, uint byte_offset)
+    { asm_thumb_op32(as, op | ASM_THUMB_OP_W_IMM12 | r_base, (r_dest << 12) | (byte_offset & 0xfff)); }
+
+// r_index is in units of the access size
+#define asm_thumb_strb_reg_reg_reg(as, r_src, r_base, r_index) asm_thumb_ldst_w_reg_reg_reg((as), ASM_THUMB_OP_STRB_W, (r_src), (r_base), (r_index), 0)
+#define asm_thumb_strh_reg_reg_reg(as, r_src, r_base, r_index) asm_thumb_ldst_w_reg_reg_reg((as), ASM_THUMB_OP_STRH_W, (r_src), (r_base), (r_index), 1)
+#define asm_thumb_str_reg_reg_reg(as, r_src, r_base, r_index) asm_thumb_ldst_w_reg_reg_reg((as), ASM_THUMB_OP_STR_W, (r_src), (r_base), (r_index), 2)
+#define asm_thumb_ldrb_reg_reg_reg(as, r_dest, r_base, r_index) asm_thumb_ldst_w_reg_reg_reg((as), ASM_THUMB_OP_LDRB_W, (r_dest), (r_base), (r_index), 0)
+#define asm_thumb_ldrh_reg_reg_reg(as, r_dest, r_base, r_index) asm_thumb_ldst_w_reg_reg_reg((as), ASM_THUMB_OP_LDRH_W, (r_dest), (r_base), (r_index), 1)
+#define asm_thumb_ldr_reg_reg_reg(as, r_dest, r_base, r_index) asm_thumb_ldst_w_reg_reg_reg((as), ASM_THUMB_OP_LDR_W, (r_dest), (r_base), (r_index), 2)
+
+// byte_offset is 0-4095
+#define asm_thumb_strb_w_reg_reg_i12(as, r_src, r_base, byte_offset) asm_thumb_ldst_w_reg_reg_i12((as), ASM_THUMB_OP_STRB_W, (r_src), (r_base), (byte_offset))
+#define asm_thumb_strh_w_reg_reg_i12(as, r_src, r_base, byte_offset) asm_thumb_ldst_w_reg_reg_i12((as), ASM_THUMB_OP_STRH_W, (r_src), (r_base), (byte_offset))
+#define asm_thumb_str_w_reg_reg_i12(as, r_src, r_base, byte_offset) asm_thumb_ldst_w_reg_reg_i12((as), ASM_THUMB_OP_STR_W, (r_src), (r_base), (byte_offset))
+#define asm_thumb_ldrb_w_reg_reg_i12(as, r_dest, r_base, byte_offset) asm_thumb_ldst_w_reg_reg_i12((as), ASM_THUMB_OP_LDRB_W, (r_dest), (r_base), (byte_offset))
+#define asm_thumb_ldrh_w_reg_reg_i12(as, r_dest, r_base, byte_offset) asm_thumb_ldst_w_reg_reg_i12((as), ASM_THUMB_OP_LDRH_W, (r_dest), (r_base), (byte_offset))
+#define asm_thumb_ldr_w_reg_reg_i12(as, r_dest, r_base, byte_offset) asm_thumb_ldst_w_reg_reg_i12((as), ASM_THUMB_OP_LDR_W, (r_dest), (r_base), (byte_offset))
+
 // TODO convert these to above format style
 
 #define ASM_THUMB_OP_MOVW (0xf240)
@@ -123,8 +123,10 @@ void mp_setup_code_state(mp_code_state_t *code_state, size_t n_args, size_t n_kw
     code_state->prev = NULL;
     #endif
 
-    #if MICROPY_PY_SYS_SETTRACE
+    #if MICROPY_TRACK_CODE_STATE
     code_state->prev_state = NULL;
+    #endif
+    #if MICROPY_PY_SYS_SETTRACE
     code_state->frame = NULL;
     #endif
 
@@ -300,6 +302,31 @@ continue2:;
     dump_args(code_state->state, n_state);
 }
 
+#if MICROPY_TRACK_CODE_STATE
+qstr mp_code_state_get_source(const mp_code_state_t *code_state, size_t *line) {
+    const byte *ip = code_state->fun_bc->bytecode;
+    MP_BC_PRELUDE_SIG_DECODE(ip);
+    MP_BC_PRELUDE_SIZE_DECODE(ip);
+    const byte *bytecode_start = ip + n_info + n_cell;
+    #if !MICROPY_PERSISTENT_CODE
+    // so bytecode is aligned
+    bytecode_start = MP_ALIGN(bytecode_start, sizeof(mp_uint_t));
+    #endif
+    size_t bc = code_state->ip - bytecode_start;
+    qstr source_file;
+    #if MICROPY_PERSISTENT_CODE
+    source_file = ip[2] | (ip[3] << 8);
+    ip += 4;
+    #else
+    ip = mp_decode_uint_skip(ip);
+    source_file = mp_decode_uint_value(ip);
+    ip = mp_decode_uint_skip(ip);
+    #endif
+    *line = mp_bytecode_get_source_line(ip, bc);
+    return source_file;
+}
+#endif
+
 #if MICROPY_PERSISTENT_CODE_LOAD || MICROPY_PERSISTENT_CODE_SAVE
 
 // The following table encodes the number of bytes that a specific opcode
@@ -310,6 +337,9 @@ continue2:;
 //     MP_BC_LOAD_GLOBAL
 //     MP_BC_LOAD_ATTR
 //     MP_BC_STORE_ATTR
+// The superinstructions carry the operands of the opcodes they fuse:
+//     MP_BC_LOAD_FAST_METHOD      qstr then 1 byte
+//     MP_BC_BINARY_OP_FAST_INT    3 bytes
 uint mp_opcode_format(const byte *ip, size_t *opcode_size, bool count_var_uint) {
     uint f = MP_BC_FORMAT(*ip);
     const byte *ip_start = ip;
@@ -322,7 +352,12 @@ uint mp_opcode_format(const byte *ip, size_t *opcode_size, bool count_var_uint)
                 ip += 1;
             }
         }
+        if (*ip == MP_BC_LOAD_FAST_METHOD) {
+            ip += 1;
+        }
         ip += 3;
+    } else if (*ip == MP_BC_BINARY_OP_FAST_INT) {
+        ip += 4;
     } else {
         int extra_byte = (*ip & MP_BC_MASK_EXTRA_BYTE) == 0;
         ip += 1;
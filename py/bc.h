@@ -209,8 +209,10 @@ typedef struct _mp_code_state_t {
     #if MICROPY_STACKLESS
     struct _mp_code_state_t *prev;
     #endif
-    #if MICROPY_PY_SYS_SETTRACE
+    #if MICROPY_TRACK_CODE_STATE
     struct _mp_code_state_t *prev_state;
+    #endif
+    #if MICROPY_PY_SYS_SETTRACE
     struct _mp_obj_frame_t *frame;
     #endif
     // Variable-length
@@ -270,4 +272,10 @@ static inline size_t mp_bytecode_get_source_line(const byte *line_info, size_t b
     return source_line;
 }
 
+#if MICROPY_TRACK_CODE_STATE
+// The file and line code_state is running, as an exception traceback finds
+// them.  Only reads the bytecode, so it can be used from an IRQ.
+qstr mp_code_state_get_source(const mp_code_state_t *code_state, size_t *line);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_BC_H
@@ -41,12 +41,12 @@
 
 // Load, Store, Delete, Import, Make, Build, Unpack, Call, Jump, Exception, For, sTack, Return, Yield, Op
 #define MP_BC_BASE_RESERVED                 (0x00) // ----------------
-#define MP_BC_BASE_QSTR_O                   (0x10) // LLLLLLSSSDDII---
+#define MP_BC_BASE_QSTR_O                   (0x10) // LLLLLLSSSDDIIL--
 #define MP_BC_BASE_VINT_E                   (0x20) // MMLLLLSSDDBBBBBB
 #define MP_BC_BASE_VINT_O                   (0x30) // UUMMCCCC--------
 #define MP_BC_BASE_JUMP_E                   (0x40) // J-JJJJJEEEEF----
 #define MP_BC_BASE_BYTE_O                   (0x50) // LLLLSSDTTTTTEEFF
-#define MP_BC_BASE_BYTE_E                   (0x60) // --BREEEYYI------
+#define MP_BC_BASE_BYTE_E                   (0x60) // --BREEEYYIO-----
 #define MP_BC_LOAD_CONST_SMALL_INT_MULTI    (0x70) // LLLLLLLLLLLLLLLL
                                          // (0x80) // LLLLLLLLLLLLLLLL
                                          // (0x90) // LLLLLLLLLLLLLLLL
@@ -147,4 +147,8 @@
 #define MP_BC_IMPORT_FROM                   (MP_BC_BASE_QSTR_O + 0x0c) // qstr
 #define MP_BC_IMPORT_STAR                   (MP_BC_BASE_BYTE_E + 0x09)
 
+// Superinstructions, emitted with MICROPY_OPT_SUPERINSTRUCTIONS
+#define MP_BC_LOAD_FAST_METHOD              (MP_BC_BASE_QSTR_O + 0x0d) // qstr; then local num byte
+#define MP_BC_BINARY_OP_FAST_INT            (MP_BC_BASE_BYTE_E + 0x0a) // local num byte, int8 byte, op byte
+
 #endif // MICROPY_INCLUDED_PY_BC0_H
@@ -90,6 +90,7 @@ MP_DECLARE_CONST_FUN_OBJ_2(mp_op_delitem_obj);
 extern const mp_obj_module_t mp_module___main__;
 extern const mp_obj_module_t mp_module_builtins;
 extern const mp_obj_module_t mp_module_uarray;
+extern const mp_obj_module_t mp_module_uarray_ops;
 extern const mp_obj_module_t mp_module_collections;
 extern const mp_obj_module_t mp_module_io;
 extern const mp_obj_module_t mp_module_math;
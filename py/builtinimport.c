@@ -144,7 +144,7 @@ STATIC void do_load_from_lexer(mp_obj_t module_obj, mp_lexer_t *lex) {
 }
 #endif
 
-#if MICROPY_PERSISTENT_CODE_LOAD || MICROPY_MODULE_FROZEN_MPY
+#if MICROPY_PERSISTENT_CODE_LOAD || MICROPY_MODULE_FROZEN_MPY || MICROPY_MODULE_FROZEN_XIP
 STATIC void do_execute_raw_code(mp_obj_t module_obj, mp_raw_code_t *raw_code, const char* source_name) {
     (void)source_name;
 
@@ -204,8 +204,16 @@ STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
 
     // If we support frozen mpy modules and we found a corresponding file (and
     // its data) in the list of frozen files, execute it.
-    #if MICROPY_MODULE_FROZEN_MPY
+    #if MICROPY_MODULE_FROZEN_MPY || MICROPY_MODULE_FROZEN_XIP
     if (frozen_type == MP_FROZEN_MPY) {
+        #if MICROPY_MODULE_FROZEN_GLOBALS
+        // a body that only binds constants and functions has its result in ROM
+        mp_obj_dict_t *globals = mp_find_frozen_globals(modref, mp_obj_module_get_globals(module_obj));
+        if (globals != NULL) {
+            ((mp_obj_module_t*)MP_OBJ_TO_PTR(module_obj))->globals = globals;
+            return;
+        }
+        #endif
         do_execute_raw_code(module_obj, modref, file_str);
         return;
     }
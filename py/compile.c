@@ -3537,12 +3537,20 @@ mp_raw_code_t *mp_compile_to_raw_code(mp_parse_tree_t *parse_tree, qstr source_f
                     break;
             }
 
-            // need a pass to compute stack size
-            compile_scope(comp, s, MP_PASS_STACK_SIZE);
+            if (comp->emit == emit_bc) {
+                // the bytecode emitter computes the stack size along with the code size,
+                // a second pass is only needed for a large const table
+                do {
+                    compile_scope(comp, s, MP_PASS_CODE_SIZE);
+                } while (comp->compile_error == MP_OBJ_NULL && emit_bc_need_code_size_pass(emit_bc));
+            } else {
+                // need a pass to compute stack size
+                compile_scope(comp, s, MP_PASS_STACK_SIZE);
 
-            // second last pass: compute code size
-            if (comp->compile_error == MP_OBJ_NULL) {
-                compile_scope(comp, s, MP_PASS_CODE_SIZE);
+                // second last pass: compute code size
+                if (comp->compile_error == MP_OBJ_NULL) {
+                    compile_scope(comp, s, MP_PASS_CODE_SIZE);
+                }
             }
 
             // final pass: emit code
@@ -3599,4 +3607,34 @@ mp_obj_t mp_compile(mp_parse_tree_t *parse_tree, qstr source_file, bool is_repl)
     return mp_make_function_from_raw_code(rc, MP_OBJ_NULL, MP_OBJ_NULL);
 }
 
+#if MICROPY_COMP_STREAM
+mp_obj_t mp_compile_stream_next(mp_parse_stream_t *ps, qstr source_file, bool is_repl) {
+    // The statements before this one have run and may have locked the heap. Parsing and
+    // compiling allocate for the script, as compiling the whole file before running it
+    // would, so the lock is lifted for them and put back, also when they raise.
+    #if MICROPY_ENABLE_GC
+    size_t lock_depth = MP_STATE_MEM(gc_lock_depth);
+    MP_STATE_MEM(gc_lock_depth) = 0;
+    #endif
+    mp_obj_t module_fun = MP_OBJ_NULL;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_parse_tree_t parse_tree;
+        if (mp_parse_stream_next(ps, &parse_tree)) {
+            module_fun = mp_compile(&parse_tree, source_file, is_repl);
+        }
+        nlr_pop();
+    } else {
+        #if MICROPY_ENABLE_GC
+        MP_STATE_MEM(gc_lock_depth) = lock_depth;
+        #endif
+        nlr_jump(nlr.ret_val);
+    }
+    #if MICROPY_ENABLE_GC
+    MP_STATE_MEM(gc_lock_depth) = lock_depth;
+    #endif
+    return module_fun;
+}
+#endif
+
 #endif // MICROPY_ENABLE_COMPILER
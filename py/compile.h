@@ -34,6 +34,12 @@
 // the compiler will clear the parse tree before it returns
 mp_obj_t mp_compile(mp_parse_tree_t *parse_tree, qstr source_file, bool is_repl);
 
+#if MICROPY_COMP_STREAM
+// parses and compiles the next statement of ps, MP_OBJ_NULL at the end of the input;
+// a heap locked by the statements run so far is unlocked while it does so
+mp_obj_t mp_compile_stream_next(mp_parse_stream_t *ps, qstr source_file, bool is_repl);
+#endif
+
 #if MICROPY_PERSISTENT_CODE_SAVE
 // this has the same semantics as mp_compile
 mp_raw_code_t *mp_compile_to_raw_code(mp_parse_tree_t *parse_tree, qstr source_file, bool is_repl);
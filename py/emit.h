@@ -191,6 +191,7 @@ emit_t *emit_native_xtensawin_new(mp_obj_t *error_slot, uint *label_slot, mp_uin
 void emit_bc_set_max_num_labels(emit_t* emit, mp_uint_t max_num_labels);
 
 void emit_bc_free(emit_t *emit);
+bool emit_bc_need_code_size_pass(emit_t *emit);
 void emit_native_x64_free(emit_t *emit);
 void emit_native_x86_free(emit_t *emit);
 void emit_native_thumb_free(emit_t *emit);
@@ -73,6 +73,15 @@ struct _emit_t {
     uint16_t ct_cur_raw_code;
     #endif
     mp_uint_t *const_table;
+
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    // the LOAD_FAST (and LOAD_CONST_SMALL_INT) just emitted, to be fused with what follows
+    byte peep_state;
+    byte peep_local;
+    int8_t peep_int;
+    size_t peep_offset;
+    size_t peep_end;
+    #endif
 };
 
 emit_t *emit_bc_new(void) {
@@ -90,6 +99,11 @@ void emit_bc_free(emit_t *emit) {
     m_del_obj(emit_t, emit);
 }
 
+bool emit_bc_need_code_size_pass(emit_t *emit) {
+    // the code is only allocated once its size is known
+    return emit->code_base == NULL;
+}
+
 typedef byte *(*emit_allocator_t)(emit_t *emit, int nbytes);
 
 STATIC void emit_write_uint(emit_t *emit, emit_allocator_t allocator, mp_uint_t val) {
@@ -181,6 +195,20 @@ STATIC byte *emit_get_cur_to_write_bytecode(emit_t *emit, int num_bytes_to_write
     }
 }
 
+#if MICROPY_OPT_SUPERINSTRUCTIONS
+enum {
+    PEEP_NONE,
+    PEEP_LOAD_FAST,
+    PEEP_LOAD_FAST_INT,
+};
+
+// Whether the last opcodes emitted, ending at offset, are the start of a
+// superinstruction.  The choice is the same in every pass, so sizes agree.
+STATIC bool emit_peep(emit_t *emit, byte state, size_t offset) {
+    return emit->peep_state == state && emit->peep_end == offset;
+}
+#endif
+
 STATIC void emit_write_bytecode_raw_byte(emit_t *emit, byte b1) {
     byte *c = emit_get_cur_to_write_bytecode(emit, 1);
     c[0] = b1;
@@ -311,6 +339,38 @@ STATIC void emit_write_bytecode_byte_signed_label(emit_t *emit, int stack_adj, b
     c[2] = bytecode_offset >> 8;
 }
 
+STATIC mp_uint_t emit_n_state(scope_t *scope) {
+    mp_uint_t n_state = scope->num_locals + scope->stack_size;
+    if (n_state == 0) {
+        // Need at least 1 entry in the state, in the case an exception is
+        // propagated through this function, the exception is returned in
+        // the highest slot in the state (fastn[0], see vm.c).
+        n_state = 1;
+    }
+    #if MICROPY_DEBUG_VM_STACK_OVERFLOW
+    // An extra slot in the stack is needed to detect VM stack overflow
+    n_state += 1;
+    #endif
+    return n_state;
+}
+
+STATIC void emit_count_byte(size_t *n, byte val) {
+    (void)val;
+    *n += 1;
+}
+
+// Size of the signature and sizes of the prelude with the final values of the scope.
+STATIC size_t emit_prelude_size(emit_t *emit) {
+    size_t n = 0;
+    mp_uint_t n_state = emit_n_state(emit->scope);
+    size_t n_exc_stack = emit->scope->exc_stack_size;
+    size_t n_info = emit->n_info;
+    size_t n_cell = emit->n_cell;
+    MP_BC_PRELUDE_SIG_ENCODE(n_state, n_exc_stack, emit->scope, emit_count_byte, &n);
+    MP_BC_PRELUDE_SIZE_ENCODE(n_info, n_cell, emit_count_byte, &n);
+    return n;
+}
+
 void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     emit->pass = pass;
     emit->stack_size = 0;
@@ -318,6 +378,9 @@ void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     emit->scope = scope;
     emit->last_source_line_offset = 0;
     emit->last_source_line = 1;
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    emit->peep_state = PEEP_NONE;
+    #endif
     #ifndef NDEBUG
     // With debugging enabled labels are checked for unique assignment
     if (pass < MP_PASS_EMIT && emit->label_offsets != NULL) {
@@ -329,18 +392,7 @@ void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
 
     // Write local state size, exception stack size, scope flags and number of arguments
     {
-        mp_uint_t n_state = scope->num_locals + scope->stack_size;
-        if (n_state == 0) {
-            // Need at least 1 entry in the state, in the case an exception is
-            // propagated through this function, the exception is returned in
-            // the highest slot in the state (fastn[0], see vm.c).
-            n_state = 1;
-        }
-        #if MICROPY_DEBUG_VM_STACK_OVERFLOW
-        // An extra slot in the stack is needed to detect VM stack overflow
-        n_state += 1;
-        #endif
-
+        mp_uint_t n_state = emit_n_state(scope);
         size_t n_exc_stack = scope->exc_stack_size;
         MP_BC_PRELUDE_SIG_ENCODE(n_state, n_exc_stack, scope, emit_write_code_info_byte, emit);
     }
@@ -399,6 +451,9 @@ void mp_emit_bc_end_pass(emit_t *emit) {
     // check stack is back to zero size
     assert(emit->stack_size == 0);
 
+    // what start_pass wrote of the prelude before the name
+    size_t prelude_size = emit->n_info;
+
     emit_write_code_info_byte(emit, 0); // end of line number info
 
     // Calculate size of source code info section
@@ -416,11 +471,26 @@ void mp_emit_bc_end_pass(emit_t *emit) {
     }
 
     #if MICROPY_PERSISTENT_CODE
-    assert(emit->pass <= MP_PASS_STACK_SIZE || (emit->ct_num_obj == emit->ct_cur_obj));
+    assert(emit->pass <= MP_PASS_CODE_SIZE || (emit->ct_num_obj == emit->ct_cur_obj));
+    // The code size pass numbers the raw codes after ct_num_obj objects, the count of the
+    // previous pass. Their indices took the same bytes as in the emit pass if all are below
+    // 0x80, otherwise the pass has to be run again with the count now known.
+    bool ct_resize = emit->pass == MP_PASS_CODE_SIZE && emit->ct_cur_raw_code > 0
+        && emit->ct_num_obj != emit->ct_cur_obj
+        && (emit->scope->num_pos_args + emit->scope->num_kwonly_args
+            + emit->ct_cur_obj + emit->ct_cur_raw_code) > 0x80;
     emit->ct_num_obj = emit->ct_cur_obj;
+    if (ct_resize) {
+        return;
+    }
     #endif
 
     if (emit->pass == MP_PASS_CODE_SIZE) {
+        // There is no stack size pass before this one (see mp_compile_to_raw_code), so
+        // start_pass encoded the stack size and the code info sizes with the values of
+        // another pass. The rest of the code info is relative to it, give it its final size.
+        emit->code_info_offset += emit_prelude_size(emit) - prelude_size;
+
         #if !MICROPY_PERSISTENT_CODE
         // so bytecode is aligned
         emit->code_info_offset = (size_t)MP_ALIGN(emit->code_info_offset, sizeof(mp_uint_t));
@@ -450,6 +520,12 @@ void mp_emit_bc_end_pass(emit_t *emit) {
             emit->ct_cur_obj, emit->ct_cur_raw_code,
             #endif
             emit->scope->scope_flags);
+
+        // the code is the raw code's now, the next scope starts without a const count
+        emit->code_base = NULL;
+        #if MICROPY_PERSISTENT_CODE
+        emit->ct_num_obj = 0;
+        #endif
     }
 }
 
@@ -477,6 +553,9 @@ void mp_emit_bc_set_source_line(emit_t *emit, mp_uint_t source_line) {
         return;
     }
     if (source_line > emit->last_source_line) {
+        #if MICROPY_OPT_SUPERINSTRUCTIONS
+        emit->peep_state = PEEP_NONE;
+        #endif
         mp_uint_t bytes_to_skip = emit->bytecode_offset - emit->last_source_line_offset;
         mp_uint_t lines_to_skip = source_line - emit->last_source_line;
         emit_write_code_info_bytes_lines(emit, bytes_to_skip, lines_to_skip);
@@ -491,6 +570,10 @@ void mp_emit_bc_set_source_line(emit_t *emit, mp_uint_t source_line) {
 
 void mp_emit_bc_label_assign(emit_t *emit, mp_uint_t l) {
     mp_emit_bc_adjust_stack_size(emit, 0);
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    // a jump may land between the opcodes
+    emit->peep_state = PEEP_NONE;
+    #endif
     if (emit->pass == MP_PASS_SCOPE) {
         return;
     }
@@ -527,6 +610,9 @@ void mp_emit_bc_load_const_tok(emit_t *emit, mp_token_kind_t tok) {
 }
 
 void mp_emit_bc_load_const_small_int(emit_t *emit, mp_int_t arg) {
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    size_t offset = emit->bytecode_offset;
+    #endif
     if (-MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS <= arg
         && arg < MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS) {
         emit_write_bytecode_byte(emit, 1,
@@ -534,6 +620,15 @@ void mp_emit_bc_load_const_small_int(emit_t *emit, mp_int_t arg) {
     } else {
         emit_write_bytecode_byte_int(emit, 1, MP_BC_LOAD_CONST_SMALL_INT, arg);
     }
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    if (emit_peep(emit, PEEP_LOAD_FAST, offset) && -128 <= arg && arg <= 127) {
+        emit->peep_state = PEEP_LOAD_FAST_INT;
+        emit->peep_int = arg;
+        emit->peep_end = emit->bytecode_offset;
+    } else {
+        emit->peep_state = PEEP_NONE;
+    }
+    #endif
 }
 
 void mp_emit_bc_load_const_str(emit_t *emit, qstr qst) {
@@ -552,11 +647,24 @@ void mp_emit_bc_load_local(emit_t *emit, qstr qst, mp_uint_t local_num, int kind
     MP_STATIC_ASSERT(MP_BC_LOAD_FAST_N + MP_EMIT_IDOP_LOCAL_FAST == MP_BC_LOAD_FAST_N);
     MP_STATIC_ASSERT(MP_BC_LOAD_FAST_N + MP_EMIT_IDOP_LOCAL_DEREF == MP_BC_LOAD_DEREF);
     (void)qst;
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    size_t offset = emit->bytecode_offset;
+    #endif
     if (kind == MP_EMIT_IDOP_LOCAL_FAST && local_num <= 15) {
         emit_write_bytecode_byte(emit, 1, MP_BC_LOAD_FAST_MULTI + local_num);
     } else {
         emit_write_bytecode_byte_uint(emit, 1, MP_BC_LOAD_FAST_N + kind, local_num);
     }
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    if (MICROPY_OPT_SUPERINSTRUCTIONS_DYNAMIC && kind == MP_EMIT_IDOP_LOCAL_FAST && local_num <= 255) {
+        emit->peep_state = PEEP_LOAD_FAST;
+        emit->peep_local = local_num;
+        emit->peep_offset = offset;
+        emit->peep_end = emit->bytecode_offset;
+    } else {
+        emit->peep_state = PEEP_NONE;
+    }
+    #endif
 }
 
 void mp_emit_bc_load_global(emit_t *emit, qstr qst, int kind) {
@@ -570,6 +678,16 @@ void mp_emit_bc_load_global(emit_t *emit, qstr qst, int kind) {
 }
 
 void mp_emit_bc_load_method(emit_t *emit, qstr qst, bool is_super) {
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    if (!is_super && emit_peep(emit, PEEP_LOAD_FAST, emit->bytecode_offset)) {
+        // LOAD_FAST; LOAD_METHOD -> LOAD_FAST_METHOD, the local was already pushed
+        emit->bytecode_offset = emit->peep_offset;
+        emit->peep_state = PEEP_NONE;
+        emit_write_bytecode_byte_qstr(emit, 1, MP_BC_LOAD_FAST_METHOD, qst);
+        emit_write_bytecode_raw_byte(emit, emit->peep_local);
+        return;
+    }
+    #endif
     int stack_adj = 1 - 2 * is_super;
     emit_write_bytecode_byte_qstr(emit, stack_adj, is_super ? MP_BC_LOAD_SUPER_METHOD : MP_BC_LOAD_METHOD, qst);
 }
@@ -746,6 +864,19 @@ void mp_emit_bc_binary_op(emit_t *emit, mp_binary_op_t op) {
         invert = true;
         op = MP_BINARY_OP_IS;
     }
+    #if MICROPY_OPT_SUPERINSTRUCTIONS
+    if (!invert && op != MP_BINARY_OP_IN && op != MP_BINARY_OP_IS && op != MP_BINARY_OP_EXCEPTION_MATCH
+        && emit_peep(emit, PEEP_LOAD_FAST_INT, emit->bytecode_offset)) {
+        // LOAD_FAST; LOAD_CONST_SMALL_INT; BINARY_OP -> BINARY_OP_FAST_INT
+        emit->bytecode_offset = emit->peep_offset;
+        emit->peep_state = PEEP_NONE;
+        emit_write_bytecode_byte(emit, -1, MP_BC_BINARY_OP_FAST_INT);
+        emit_write_bytecode_raw_byte(emit, emit->peep_local);
+        emit_write_bytecode_raw_byte(emit, emit->peep_int);
+        emit_write_bytecode_raw_byte(emit, op);
+        return;
+    }
+    #endif
     emit_write_bytecode_byte(emit, -1, MP_BC_BINARY_OP_MULTI + op);
     if (invert) {
         emit_write_bytecode_byte(emit, 0, MP_BC_UNARY_OP_MULTI + MP_UNARY_OP_NOT);
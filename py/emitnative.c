@@ -1536,6 +1536,10 @@ STATIC void emit_native_load_subscr(emit_t *emit) {
                             asm_thumb_ldrb_rlo_rlo_i5(emit->as, REG_RET, reg_base, index_value);
                             break;
                         }
+                        if (index_value > 0 && (index_value) < 4096) {
+                            asm_thumb_ldrb_w_reg_reg_i12(emit->as, REG_RET, reg_base, index_value);
+                            break;
+                        }
                         #endif
                         ASM_MOV_REG_IMM(emit->as, reg_index, index_value);
                         ASM_ADD_REG_REG(emit->as, reg_index, reg_base); // add index to base
@@ -1553,6 +1557,10 @@ STATIC void emit_native_load_subscr(emit_t *emit) {
                             asm_thumb_ldrh_rlo_rlo_i5(emit->as, REG_RET, reg_base, index_value);
                             break;
                         }
+                        if (index_value > 0 && (index_value << 1) < 4096) {
+                            asm_thumb_ldrh_w_reg_reg_i12(emit->as, REG_RET, reg_base, index_value << 1);
+                            break;
+                        }
                         #endif
                         ASM_MOV_REG_IMM(emit->as, reg_index, index_value << 1);
                         ASM_ADD_REG_REG(emit->as, reg_index, reg_base); // add 2*index to base
@@ -1570,6 +1578,10 @@ STATIC void emit_native_load_subscr(emit_t *emit) {
                             asm_thumb_ldr_rlo_rlo_i5(emit->as, REG_RET, reg_base, index_value);
                             break;
                         }
+                        if (index_value > 0 && (index_value << 2) < 4096) {
+                            asm_thumb_ldr_w_reg_reg_i12(emit->as, REG_RET, reg_base, index_value << 2);
+                            break;
+                        }
                         #endif
                         ASM_MOV_REG_IMM(emit->as, reg_index, index_value << 2);
                         ASM_ADD_REG_REG(emit->as, reg_index, reg_base); // add 4*index to base
@@ -1595,13 +1607,20 @@ STATIC void emit_native_load_subscr(emit_t *emit) {
             switch (vtype_base) {
                 case VTYPE_PTR8: {
                     // pointer to 8-bit memory
-                    // TODO optimise to use thumb ldrb r1, [r2, r3]
+                    #if N_THUMB
+                    asm_thumb_ldrb_reg_reg_reg(emit->as, REG_RET, REG_ARG_1, reg_index);
+                    break;
+                    #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_LOAD8_REG_REG(emit->as, REG_RET, REG_ARG_1); // store value to (base+index)
                     break;
                 }
                 case VTYPE_PTR16: {
                     // pointer to 16-bit memory
+                    #if N_THUMB
+                    asm_thumb_ldrh_reg_reg_reg(emit->as, REG_RET, REG_ARG_1, reg_index);
+                    break;
+                    #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_LOAD16_REG_REG(emit->as, REG_RET, REG_ARG_1); // load from (base+2*index)
@@ -1609,6 +1628,10 @@ STATIC void emit_native_load_subscr(emit_t *emit) {
                 }
                 case VTYPE_PTR32: {
                     // pointer to word-size memory
+                    #if N_THUMB
+                    asm_thumb_ldr_reg_reg_reg(emit->as, REG_RET, REG_ARG_1, reg_index);
+                    break;
+                    #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -1756,6 +1779,10 @@ STATIC void emit_native_store_subscr(emit_t *emit) {
                             asm_thumb_strb_rlo_rlo_i5(emit->as, reg_value, reg_base, index_value);
                             break;
                         }
+                        if (index_value > 0 && (index_value) < 4096) {
+                            asm_thumb_strb_w_reg_reg_i12(emit->as, reg_value, reg_base, index_value);
+                            break;
+                        }
                         #endif
                         ASM_MOV_REG_IMM(emit->as, reg_index, index_value);
                         #if N_ARM
@@ -1777,6 +1804,10 @@ STATIC void emit_native_store_subscr(emit_t *emit) {
                             asm_thumb_strh_rlo_rlo_i5(emit->as, reg_value, reg_base, index_value);
                             break;
                         }
+                        if (index_value > 0 && (index_value << 1) < 4096) {
+                            asm_thumb_strh_w_reg_reg_i12(emit->as, reg_value, reg_base, index_value << 1);
+                            break;
+                        }
                         #endif
                         ASM_MOV_REG_IMM(emit->as, reg_index, index_value << 1);
                         ASM_ADD_REG_REG(emit->as, reg_index, reg_base); // add 2*index to base
@@ -1794,6 +1825,10 @@ STATIC void emit_native_store_subscr(emit_t *emit) {
                             asm_thumb_str_rlo_rlo_i5(emit->as, reg_value, reg_base, index_value);
                             break;
                         }
+                        if (index_value > 0 && (index_value << 2) < 4096) {
+                            asm_thumb_str_w_reg_reg_i12(emit->as, reg_value, reg_base, index_value << 2);
+                            break;
+                        }
                         #endif
                         #if N_ARM
                         ASM_MOV_REG_IMM(emit->as, reg_index, index_value);
@@ -1835,10 +1870,12 @@ STATIC void emit_native_store_subscr(emit_t *emit) {
             switch (vtype_base) {
                 case VTYPE_PTR8: {
                     // pointer to 8-bit memory
-                    // TODO optimise to use thumb strb r1, [r2, r3]
                     #if N_ARM
                     asm_arm_strb_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
                     break;
+                    #elif N_THUMB
+                    asm_thumb_strb_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_STORE8_REG_REG(emit->as, reg_value, REG_ARG_1); // store value to (base+index)
@@ -1849,6 +1886,9 @@ STATIC void emit_native_store_subscr(emit_t *emit) {
                     #if N_ARM
                     asm_arm_strh_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
                     break;
+                    #elif N_THUMB
+                    asm_thumb_strh_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -1860,6 +1900,9 @@ STATIC void emit_native_store_subscr(emit_t *emit) {
                     #if N_ARM
                     asm_arm_str_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
                     break;
+                    #elif N_THUMB
+                    asm_thumb_str_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -89,6 +89,164 @@ static inline int fp_isless1(float x) { union floatbits fb = {x}; return fb.u <
 
 #endif
 
+#if MICROPY_FLOAT_FORMAT_FAST && MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
+
+// A float is m * 2^e2 with m below 2^24, so m * 10^prec fits in 64 bits for up
+// to 9 decimals and shifting it down gives f * 10^prec exactly rounded.
+
+#define FAST_MAX_PREC (9)
+
+static const uint32_t g_pow10[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+// Returns f * 10^prec rounded half to even, or -1 if it doesn't fit.  f is finite and >= 0.
+static int64_t fast_scaled(float f, int prec) {
+    union floatbits fb = {f};
+    uint64_t m = fb.u & FLT_MAN_MASK;
+    int be = (fb.u & FLT_EXP_MASK) >> 23;
+    if (be == 0) {
+        be = 1;
+    } else {
+        m |= 0x800000;
+    }
+    int e2 = be - 127 - 23;
+    if (e2 >= 0) {
+        if (e2 > 30) {
+            return -1;
+        }
+        m <<= e2;
+        if (m > (uint64_t)INT64_MAX / g_pow10[prec]) {
+            return -1;
+        }
+        return m * g_pow10[prec];
+    }
+    uint64_t q = m * g_pow10[prec];
+    int sh = -e2;
+    if (sh > 62) {
+        // q is below 2^54, less than half of the lowest digit
+        return 0;
+    }
+    uint64_t r = q >> sh;
+    uint64_t rem = q & ((1ULL << sh) - 1);
+    uint64_t half = 1ULL << (sh - 1);
+    if (rem > half || (rem == half && (r & 1))) {
+        r++;
+    }
+    return r;
+}
+
+static int fast_num_digits(uint64_t v) {
+    int n = 1;
+    while (v >= 10) {
+        v /= 10;
+        n++;
+    }
+    return n;
+}
+
+// Writes v with prec decimals (at least one digit before the point), returns the end.
+static char *fast_put_fixed(char *s, uint64_t v, int prec) {
+    char tmp[24];
+    int n = 0;
+    if (v <= UINT32_MAX) {
+        uint32_t v32 = v;
+        do {
+            tmp[n++] = '0' + v32 % 10;
+            v32 /= 10;
+        } while (v32 != 0 || n <= prec);
+    } else {
+        do {
+            tmp[n++] = '0' + v % 10;
+            v /= 10;
+        } while (v != 0 || n <= prec);
+    }
+    while (n > prec) {
+        *s++ = tmp[--n];
+    }
+    if (prec > 0) {
+        *s++ = '.';
+        while (n > 0) {
+            *s++ = tmp[--n];
+        }
+    }
+    return s;
+}
+
+// Formats 'f' and fixed notation 'g', returns NULL to leave it to the digit loop.
+static char *fast_format(float f, char *s, int buf_remaining, char fmt, int prec) {
+    if (fmt == 'f') {
+        if (prec > FAST_MAX_PREC) {
+            return NULL;
+        }
+        int64_t v = fast_scaled(f, prec);
+        if (v < 0) {
+            return NULL;
+        }
+        int n = fast_num_digits(v);
+        if (n <= prec) {
+            n = prec + 1;
+        }
+        if (n + 1 > buf_remaining) {
+            return NULL;
+        }
+        return fast_put_fixed(s, v, prec);
+    }
+
+    // 'g': find the decimal exponent of the rounded value, then print it with
+    // prec significant digits if that is fixed notation
+    assert(fmt == 'g');
+    if (fp_iszero(f) || prec > FAST_MAX_PREC) {
+        return NULL;
+    }
+    int e = 0;
+    if (f >= FPCONST(1.0)) {
+        if (f >= FPCONST(1e9)) {
+            return NULL;
+        }
+        e = fast_num_digits((uint32_t)f) - 1;
+    } else {
+        for (float p = FPCONST(0.1); f < p && e > -5; p *= FPCONST(0.1)) {
+            e--;
+        }
+        e--;
+    }
+    int64_t v = -1;
+    for (int tries = 0; tries < 3; tries++) {
+        int dec = prec - 1 - e;
+        if (e < -4 || e >= prec || dec > FAST_MAX_PREC) {
+            return NULL;
+        }
+        v = fast_scaled(f, dec);
+        if (v < 0) {
+            return NULL;
+        }
+        if (v >= g_pow10[prec]) {
+            e++;
+        } else if (v < g_pow10[prec - 1]) {
+            e--;
+        } else {
+            if (prec + 2 > buf_remaining) {
+                return NULL;
+            }
+            s = fast_put_fixed(s, v, dec);
+            if (dec > 0) {
+                // remove trailing zeros and a trailing decimal point
+                while (s[-1] == '0') {
+                    s--;
+                }
+                if (s[-1] == '.') {
+                    s--;
+                }
+            }
+            return s;
+        }
+    }
+    return NULL;
+}
+
+#endif
+
 static const FPTYPE g_pos_pow[] = {
     #if FPDECEXP > 32
     1e256, 1e128, 1e64,
@@ -158,6 +316,16 @@ int mp_format_float(FPTYPE f, char *buf, size_t buf_size, char fmt, int prec, ch
     if (fmt == 'g' && prec == 0) {
         prec = 1;
     }
+
+    #if MICROPY_FLOAT_FORMAT_FAST && MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
+    if (fmt == 'f' || fmt == 'g') {
+        char *end = fast_format(f, s, buf_remaining, fmt, prec);
+        if (end != NULL) {
+            *end = '\0';
+            return end - buf;
+        }
+    }
+    #endif
     int e, e1;
     int dec = 0;
     char e_sign = '\0';
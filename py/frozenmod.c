@@ -30,6 +30,8 @@
 
 #include "py/lexer.h"
 #include "py/frozenmod.h"
+#include "py/gc.h"
+#include "py/persistentcode.h"
 
 #if MICROPY_MODULE_FROZEN_STR
 
@@ -132,6 +134,13 @@ mp_import_stat_t mp_frozen_stat(const char *str) {
     }
     #endif
 
+    #if MICROPY_MODULE_FROZEN_XIP
+    stat = mp_frozen_stat_helper(mp_raw_code_xip_names(), str);
+    if (stat != MP_IMPORT_STAT_NO_EXIST) {
+        return stat;
+    }
+    #endif
+
     return MP_IMPORT_STAT_NO_EXIST;
 }
 
@@ -150,7 +159,51 @@ int mp_find_frozen_module(const char *str, size_t len, void **data) {
         return MP_FROZEN_MPY;
     }
     #endif
+    #if MICROPY_MODULE_FROZEN_XIP
+    // run as a frozen .mpy, from the image
+    mp_raw_code_t *xip_rc = mp_raw_code_xip_find(str, len);
+    if (xip_rc != NULL) {
+        *data = xip_rc;
+        return MP_FROZEN_MPY;
+    }
+    #endif
     return MP_FROZEN_NONE;
 }
 
 #endif
+
+#if MICROPY_MODULE_FROZEN_GLOBALS
+
+extern const mp_frozen_globals_t mp_frozen_mpy_globals[];
+extern const size_t mp_frozen_mpy_globals_len;
+extern mp_obj_dict_t mp_frozen_mpy_globals_ram[];
+
+void mp_frozen_globals_reset(void) {
+    for (size_t i = 0; i < mp_frozen_mpy_globals_len; i++) {
+        *mp_frozen_mpy_globals[i].ram = *mp_frozen_mpy_globals[i].rom;
+    }
+}
+
+// The RAM dicts live outside the heap, their tables (once copied) are only reachable from here
+void mp_frozen_globals_collect(void) {
+    gc_collect_root((void**)(void*)mp_frozen_mpy_globals_ram,
+        mp_frozen_mpy_globals_len * sizeof(mp_obj_dict_t) / sizeof(void*));
+}
+
+mp_obj_dict_t *mp_find_frozen_globals(const void *raw_code, mp_obj_dict_t *module_globals) {
+    for (size_t i = 0; i < mp_frozen_mpy_globals_len; i++) {
+        const mp_frozen_globals_t *g = &mp_frozen_mpy_globals[i];
+        if (g->raw_code == raw_code) {
+            // the ROM table has __name__ as the first entry, it must match the name imported as
+            mp_map_elem_t *elem = mp_map_lookup(&module_globals->map, MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_MAP_LOOKUP);
+            if (elem == NULL || elem->value != g->rom->map.table[0].value) {
+                return NULL;
+            }
+            *g->ram = *g->rom;
+            return g->ram;
+        }
+    }
+    return NULL;
+}
+
+#endif
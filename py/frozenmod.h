@@ -28,6 +28,7 @@
 #define MICROPY_INCLUDED_PY_FROZENMOD_H
 
 #include "py/lexer.h"
+#include "py/obj.h"
 
 enum {
     MP_FROZEN_NONE,
@@ -39,4 +40,17 @@ int mp_find_frozen_module(const char *str, size_t len, void **data);
 const char *mp_find_frozen_str(const char *str, size_t *len);
 mp_import_stat_t mp_frozen_stat(const char *str);
 
+#if MICROPY_MODULE_FROZEN_GLOBALS
+// Generated by mpy-tool.py for each frozen module that needs no execution
+typedef struct _mp_frozen_globals_t {
+    const void *raw_code;
+    const mp_obj_dict_t *rom;   // initial globals, a copy-on-write ROM table
+    mp_obj_dict_t *ram;         // the globals the module's functions are bound to
+} mp_frozen_globals_t;
+
+void mp_frozen_globals_reset(void);
+void mp_frozen_globals_collect(void);
+mp_obj_dict_t *mp_find_frozen_globals(const void *raw_code, mp_obj_dict_t *module_globals);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_FROZENMOD_H
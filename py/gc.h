@@ -33,6 +33,11 @@
 
 void gc_init(void *start, void *end);
 
+#if MICROPY_GC_SPLIT_POOLS
+// Give the GC a second pool for big allocations, call it after gc_init().
+void gc_add_large_pool(void *start, void *end);
+#endif
+
 // These lock/unlock functions can be nested.
 // They can be used to prevent the GC from allocating/freeing.
 void gc_lock(void);
@@ -45,6 +50,17 @@ void gc_collect_start(void);
 void gc_collect_root(void **ptrs, size_t len);
 void gc_collect_end(void);
 
+#if MICROPY_PY_MICROPYTHON_ALLOC_STATS
+// Clear the per source line allocation stats and start or stop recording them.
+void gc_alloc_stats_reset(bool enable);
+#endif
+
+#if MICROPY_GC_INCREMENTAL_SWEEP
+// Sweep up to n_blocks more blocks left by the last collection, returns true
+// if some are still left.  Does nothing if the GC is locked.
+bool gc_sweep_step(size_t n_blocks);
+#endif
+
 // Use this function to sweep the whole heap and run all finalisers
 void gc_sweep_all(void);
 
@@ -346,6 +346,29 @@ def print_qstr_data(qcfgs, qstrs):
         qbytes = make_bytes(cfg_bytes_len, cfg_bytes_hash, qstr)
         print('QDEF(MP_QSTR_%s, %s)' % (ident, qbytes))
 
+    print_qstr_index(cfg_bytes_hash, qstrs)
+
+# hash index of the pool for MICROPY_QSTR_HASH_INDEX, this must match the lookup in qstr.c
+def print_qstr_index(cfg_bytes_hash, qstrs):
+    if cfg_bytes_hash < 2:
+        return
+    entries = sorted(qstrs.values(), key=lambda x: x[0])
+    size = 1
+    while size < 2 * len(entries):
+        size *= 2
+    slots = [None] * size
+    for order, ident, qstr in entries:
+        i = compute_hash(bytes_cons(qstr, 'utf8'), cfg_bytes_hash) & (size - 1)
+        while slots[i] is not None:
+            i = (i + 1) & (size - 1)
+        slots[i] = ident
+    print('')
+    print('#ifdef QINDEX')
+    for ident in slots:
+        print('QINDEX(%s)' % ('MP_QSTRnull' if ident is None else 'MP_QSTR_' + ident))
+    print('QINDEX_END(%u)' % len(entries))
+    print('#endif')
+
 def do_work(infiles):
     qcfgs, qstrs = parse_input_headers(infiles)
     print_qstr_data(qcfgs, qstrs)
@@ -73,6 +73,156 @@ STATIC size_t get_hash_alloc_greater_or_equal_to(size_t x) {
     return (x + x / 2) | 1;
 }
 
+#if MICROPY_OPT_MAP_COMPACT
+
+// A compact (non-ordered) map is one block: the entries in insertion order,
+// which is what map->table points to so iterating and caching indices into
+// it work as for any map, then this header, the truncated hash of each entry
+// and an open addressing index whose slots hold entry number + 1 (0 is free).
+// Removed entries become MP_OBJ_SENTINEL until the block is next resized.
+typedef struct _mp_map_index_t {
+    size_t filled;          // entries handed out, removed ones included
+    uint16_t hash[];        // followed by the index slots
+} mp_map_index_t;
+
+#define MP_MAP_INDEX(map) ((mp_map_index_t*)(void*)&(map)->table[(map)->alloc])
+
+// index slots, a power of 2 over 1.5 times the entries
+STATIC size_t mp_map_index_mask(size_t alloc) {
+    size_t n = 4;
+    while (n < alloc + alloc / 2) {
+        n <<= 1;
+    }
+    return n - 1;
+}
+
+STATIC size_t mp_map_index_width(size_t alloc) {
+    return alloc < 0xff ? 1 : alloc < 0xffff ? 2 : 4;
+}
+
+size_t mp_map_table_size(size_t alloc) {
+    if (alloc == 0) {
+        return 0;
+    }
+    return alloc * (sizeof(mp_map_elem_t) + sizeof(uint16_t)) + sizeof(mp_map_index_t)
+        + (mp_map_index_mask(alloc) + 1) * mp_map_index_width(alloc);
+}
+
+size_t mp_map_iter_max(const mp_map_t *map) {
+    if (map->is_ordered || map->alloc == 0) {
+        return map->alloc;
+    }
+    return MP_MAP_INDEX(map)->filled;
+}
+
+STATIC size_t mp_map_index_get(const mp_map_index_t *idx, size_t alloc, size_t pos) {
+    const void *slots = &idx->hash[alloc];
+    switch (mp_map_index_width(alloc)) {
+        case 1: return ((const uint8_t*)slots)[pos];
+        case 2: return ((const uint16_t*)slots)[pos];
+        default: return ((const uint32_t*)slots)[pos];
+    }
+}
+
+STATIC void mp_map_index_set(mp_map_index_t *idx, size_t alloc, size_t pos, size_t e) {
+    void *slots = &idx->hash[alloc];
+    switch (mp_map_index_width(alloc)) {
+        case 1: ((uint8_t*)slots)[pos] = e; break;
+        case 2: ((uint16_t*)slots)[pos] = e; break;
+        default: ((uint32_t*)slots)[pos] = e; break;
+    }
+}
+
+// Move the live entries to a block of new_alloc, the index is rebuilt from the cached hashes
+STATIC void mp_map_compact_resize(mp_map_t *map, size_t new_alloc) {
+    size_t old_alloc = map->alloc;
+    mp_map_elem_t *old_table = map->table;
+    mp_map_elem_t *new_table = (mp_map_elem_t*)m_new0(byte, mp_map_table_size(new_alloc));
+    // If we reach this point, table resizing succeeded, now we can edit the old map.
+    map->alloc = new_alloc;
+    map->table = new_table;
+    mp_map_index_t *idx = MP_MAP_INDEX(map);
+    size_t mask = mp_map_index_mask(new_alloc);
+    size_t n = 0;
+    if (old_alloc != 0) {
+        const mp_map_index_t *old_idx = (const mp_map_index_t*)(const void*)&old_table[old_alloc];
+        for (size_t i = 0; i < old_idx->filled; i++) {
+            if (old_table[i].key != MP_OBJ_NULL && old_table[i].key != MP_OBJ_SENTINEL) {
+                uint16_t hash = old_idx->hash[i];
+                size_t pos = hash & mask;
+                while (mp_map_index_get(idx, new_alloc, pos) != 0) {
+                    pos = (pos + 1) & mask;
+                }
+                mp_map_index_set(idx, new_alloc, pos, n + 1);
+                idx->hash[n] = hash;
+                new_table[n++] = old_table[i];
+            }
+        }
+    }
+    idx->filled = n;
+    m_del(byte, old_table, mp_map_table_size(old_alloc));
+}
+
+STATIC mp_map_elem_t *mp_map_compact_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind, bool compare_only_ptrs) {
+    if (map->alloc == 0) {
+        if (lookup_kind != MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
+            return NULL;
+        }
+        mp_map_compact_resize(map, 4);
+    }
+
+    // get hash of index, with fast path for common case of qstr
+    uint16_t hash;
+    if (mp_obj_is_qstr(index)) {
+        hash = qstr_hash(MP_OBJ_QSTR_VALUE(index));
+    } else {
+        hash = MP_OBJ_SMALL_INT_VALUE(mp_unary_op(MP_UNARY_OP_HASH, index));
+    }
+
+    for (;;) {
+        mp_map_index_t *idx = MP_MAP_INDEX(map);
+        size_t mask = mp_map_index_mask(map->alloc);
+        size_t pos = hash & mask;
+        size_t e;
+        while ((e = mp_map_index_get(idx, map->alloc, pos)) != 0) {
+            mp_map_elem_t *elem = &map->table[e - 1];
+            // the cached hash settles most mismatches without comparing keys
+            if (idx->hash[e - 1] == hash && elem->key != MP_OBJ_SENTINEL
+                && (elem->key == index || (!compare_only_ptrs && mp_obj_equal(elem->key, index)))) {
+                if (lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND) {
+                    // keep elem->value so that caller can access it if needed
+                    map->used--;
+                    elem->key = MP_OBJ_SENTINEL;
+                }
+                return elem;
+            }
+            pos = (pos + 1) & mask;
+        }
+
+        // index is not in table
+        if (lookup_kind != MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
+            return NULL;
+        }
+        if (idx->filled < map->alloc) {
+            e = idx->filled++;
+            mp_map_index_set(idx, map->alloc, pos, e + 1);
+            idx->hash[e] = hash;
+            mp_map_elem_t *elem = &map->table[e];
+            elem->key = index;
+            elem->value = MP_OBJ_NULL;
+            map->used++;
+            if (!mp_obj_is_qstr(index)) {
+                map->all_keys_are_qstrs = 0;
+            }
+            return elem;
+        }
+        // out of entries, drop the removed ones and grow if still over half full
+        mp_map_compact_resize(map, map->used + map->used / 2 + 4);
+    }
+}
+
+#endif // MICROPY_OPT_MAP_COMPACT
+
 /******************************************************************************/
 /* map                                                                        */
 
@@ -82,12 +232,19 @@ void mp_map_init(mp_map_t *map, size_t n) {
         map->table = NULL;
     } else {
         map->alloc = n;
+        #if MICROPY_OPT_MAP_COMPACT
+        map->table = (mp_map_elem_t*)m_new0(byte, mp_map_table_size(n));
+        #else
         map->table = m_new0(mp_map_elem_t, map->alloc);
+        #endif
     }
     map->used = 0;
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 0;
     map->is_ordered = 0;
+    #if MICROPY_MODULE_FROZEN_GLOBALS
+    map->is_cow = 0;
+    #endif
 }
 
 void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
@@ -96,29 +253,63 @@ void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 1;
     map->is_ordered = 1;
+    #if MICROPY_MODULE_FROZEN_GLOBALS
+    map->is_cow = 0;
+    #endif
     map->table = (mp_map_elem_t*)table;
 }
 
+// Free the table with the size it was allocated with
+STATIC void mp_map_table_del(mp_map_t *map) {
+    #if MICROPY_OPT_MAP_COMPACT
+    if (!map->is_ordered) {
+        m_del(byte, map->table, mp_map_table_size(map->alloc));
+        return;
+    }
+    #endif
+    m_del(mp_map_elem_t, map->table, map->alloc);
+}
+
 // Differentiate from mp_map_clear() - semantics is different
 void mp_map_deinit(mp_map_t *map) {
     if (!map->is_fixed) {
-        m_del(mp_map_elem_t, map->table, map->alloc);
+        mp_map_table_del(map);
     }
     map->used = map->alloc = 0;
 }
 
 void mp_map_clear(mp_map_t *map) {
     if (!map->is_fixed) {
-        m_del(mp_map_elem_t, map->table, map->alloc);
+        mp_map_table_del(map);
     }
     map->alloc = 0;
     map->used = 0;
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 0;
+    #if MICROPY_MODULE_FROZEN_GLOBALS
+    map->is_cow = 0;
+    #endif
     map->table = NULL;
 }
 
+#if MICROPY_MODULE_FROZEN_GLOBALS
+// Replace a copy-on-write ROM table with a hashed heap copy of it, in place so
+// everything holding the map (functions hold their globals dict) sees the change.
+void mp_map_cow_copy(mp_map_t *map) {
+    size_t n = map->used;
+    const mp_map_elem_t *old_table = map->table;
+    mp_map_init(map, get_hash_alloc_greater_or_equal_to(n + n / 2 + 1));
+    for (size_t i = 0; i < n; i++) {
+        mp_map_lookup(map, old_table[i].key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = old_table[i].value;
+    }
+}
+#endif
+
 STATIC void mp_map_rehash(mp_map_t *map) {
+    #if MICROPY_OPT_MAP_COMPACT
+    // a compact table has its own layout, which the resize keeps
+    mp_map_compact_resize(map, get_hash_alloc_greater_or_equal_to(map->alloc + 1));
+    #else
     size_t old_alloc = map->alloc;
     size_t new_alloc = get_hash_alloc_greater_or_equal_to(map->alloc + 1);
     DEBUG_printf("mp_map_rehash(%p): " UINT_FMT " -> " UINT_FMT "\n", map, old_alloc, new_alloc);
@@ -135,6 +326,7 @@ STATIC void mp_map_rehash(mp_map_t *map) {
         }
     }
     m_del(mp_map_elem_t, old_table, old_alloc);
+    #endif
 }
 
 // MP_MAP_LOOKUP behaviour:
@@ -144,6 +336,12 @@ STATIC void mp_map_rehash(mp_map_t *map) {
 // MP_MAP_LOOKUP_REMOVE_IF_FOUND behaviour:
 //  - returns NULL if not found, else the slot if was found in with key null and value non-null
 mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind) {
+    #if MICROPY_MODULE_FROZEN_GLOBALS
+    if (map->is_cow && lookup_kind != MP_MAP_LOOKUP) {
+        mp_map_cow_copy(map);
+    }
+    #endif
+
     // If the map is a fixed array then we must only be called for a lookup
     assert(!map->is_fixed || lookup_kind == MP_MAP_LOOKUP);
 
@@ -206,6 +404,10 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
         #endif
     }
 
+    #if MICROPY_OPT_MAP_COMPACT
+    return mp_map_compact_lookup(map, index, lookup_kind, compare_only_ptrs);
+    #endif
+
     // map is a hash table (not an ordered array), so do a hash lookup
 
     if (map->alloc == 0) {
@@ -136,6 +136,25 @@ $(BUILD)/frozen_mpy.c: $(FROZEN_MPY_MPY_FILES) $(BUILD)/genhdr/qstrdefs.generate
 	$(Q)$(MPY_TOOL) -f -q $(BUILD)/genhdr/qstrdefs.preprocessed.h $(FROZEN_MPY_MPY_FILES) > $@
 endif
 
+ifneq ($(XMPY_DIR),)
+# make XMPY_DIR=app xmpy links the .py files of app/ into $(BUILD)/modules.xmpy,
+# for MICROPY_MODULE_FROZEN_XIP; it runs only on the firmware built with it
+XMPY_PY_FILES := $(shell find -L $(XMPY_DIR) -type f -name '*.py' | $(SED) -e 's=^$(XMPY_DIR)/==')
+XMPY_MPY_FILES := $(addprefix $(BUILD)/xmpy/,$(XMPY_PY_FILES:.py=.mpy))
+
+$(BUILD)/xmpy/%.mpy: $(XMPY_DIR)/%.py
+	@$(ECHO) "MPY $<"
+	$(Q)$(MKDIR) -p $(dir $@)
+	$(Q)$(MPY_CROSS) -o $@ -s $(<:$(XMPY_DIR)/%=%) $(MPY_CROSS_FLAGS) $<
+
+$(BUILD)/modules.xmpy: $(XMPY_MPY_FILES) $(FROZEN_MPY_MPY_FILES) $(BUILD)/genhdr/qstrdefs.generated.h
+	@$(ECHO) "GEN $@"
+	$(Q)$(MPY_TOOL) --xip -q $(BUILD)/genhdr/qstrdefs.preprocessed.h $(addprefix --frozen ,$(FROZEN_MPY_MPY_FILES)) -o $@ $(XMPY_MPY_FILES)
+
+.PHONY: xmpy
+xmpy: $(BUILD)/modules.xmpy
+endif
+
 ifneq ($(PROG),)
 # Build a standalone executable (unix does this)
 
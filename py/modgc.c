@@ -95,6 +95,39 @@ STATIC mp_obj_t gc_threshold(size_t n_args, const mp_obj_t *args) {
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_threshold_obj, 0, 1, gc_threshold);
 #endif
 
+#if MICROPY_GC_INCREMENTAL_SWEEP
+// sweep([n]): sweep about n more bytes of heap left by the last collection,
+// all of it if n is not given; returns True if some are still left
+STATIC mp_obj_t py_gc_sweep(size_t n_args, const mp_obj_t *args) {
+    size_t n_blocks = (size_t)-1;
+    if (n_args > 0) {
+        mp_int_t val = mp_obj_get_int(args[0]);
+        n_blocks = val < 0 ? 0 : (val + MICROPY_BYTES_PER_GC_BLOCK - 1) / MICROPY_BYTES_PER_GC_BLOCK;
+    }
+    return mp_obj_new_bool(gc_sweep_step(n_blocks));
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_sweep_obj, 0, 1, py_gc_sweep);
+
+// sweep_budget([n]): get or set how many bytes of heap a collection sweeps
+// before it leaves the rest for later, -1 for no limit
+STATIC mp_obj_t gc_sweep_budget(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 0) {
+        if (MP_STATE_MEM(gc_sweep_budget) == (size_t)-1) {
+            return MP_OBJ_NEW_SMALL_INT(-1);
+        }
+        return mp_obj_new_int(MP_STATE_MEM(gc_sweep_budget) * MICROPY_BYTES_PER_GC_BLOCK);
+    }
+    mp_int_t val = mp_obj_get_int(args[0]);
+    if (val < 0) {
+        MP_STATE_MEM(gc_sweep_budget) = (size_t)-1;
+    } else {
+        MP_STATE_MEM(gc_sweep_budget) = val / MICROPY_BYTES_PER_GC_BLOCK;
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_sweep_budget_obj, 0, 1, gc_sweep_budget);
+#endif
+
 STATIC const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_gc) },
     { MP_ROM_QSTR(MP_QSTR_collect), MP_ROM_PTR(&gc_collect_obj) },
@@ -106,6 +139,10 @@ STATIC const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     #if MICROPY_GC_ALLOC_THRESHOLD
     { MP_ROM_QSTR(MP_QSTR_threshold), MP_ROM_PTR(&gc_threshold_obj) },
     #endif
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    { MP_ROM_QSTR(MP_QSTR_sweep), MP_ROM_PTR(&gc_sweep_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sweep_budget), MP_ROM_PTR(&gc_sweep_budget_obj) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_gc_globals, mp_module_gc_globals_table);
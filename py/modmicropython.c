@@ -25,12 +25,14 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "py/builtin.h"
 #include "py/stackctrl.h"
 #include "py/runtime.h"
 #include "py/gc.h"
 #include "py/mphal.h"
+#include "py/objarray.h"
 
 // Various builtins specific to MicroPython runtime,
 // living in micropython module
@@ -107,6 +109,82 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_qstr_info_obj, 0, 1, m
 
 #endif // MICROPY_PY_MICROPYTHON_MEM_INFO
 
+#if MICROPY_PY_MICROPYTHON_ALLOC_STATS
+// alloc_stats(): return a list of (file, line, count, bytes) tuples, one per
+// source line that allocated from the heap, biggest first; file is '' for
+// allocations made with no bytecode running and None for those from lines
+// that did not fit in the table
+// alloc_stats(enable): clear the stats and start or stop recording them
+STATIC mp_obj_t mp_micropython_alloc_stats(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 1) {
+        gc_alloc_stats_reset(mp_obj_is_true(args[0]));
+        return mp_const_none;
+    }
+
+    // sort the used entries by bytes
+    const mp_alloc_stat_t *stats = MP_STATE_MEM(alloc_stats);
+    uint16_t order[MICROPY_ALLOC_STATS_SIZE];
+    size_t n = 0;
+    for (size_t i = 0; i < MICROPY_ALLOC_STATS_SIZE; i++) {
+        if (stats[i].count != 0) {
+            size_t j = n++;
+            for (; j > 0 && stats[order[j - 1]].bytes < stats[i].bytes; j--) {
+                order[j] = order[j - 1];
+            }
+            order[j] = i;
+        }
+    }
+
+    // don't record the allocations made to build the result
+    bool enabled = MP_STATE_MEM(alloc_stats_enabled);
+    MP_STATE_MEM(alloc_stats_enabled) = false;
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (size_t i = 0; i <= n; i++) {
+        const mp_alloc_stat_t *s = i < n ? &stats[order[i]] : &MP_STATE_MEM(alloc_stats_dropped);
+        if (s->count == 0) {
+            continue;
+        }
+        mp_obj_t tuple[4] = {
+            i < n ? MP_OBJ_NEW_QSTR(s->source_file) : mp_const_none,
+            MP_OBJ_NEW_SMALL_INT(s->source_line),
+            mp_obj_new_int_from_uint(s->count),
+            mp_obj_new_int_from_uint(s->bytes),
+        };
+        mp_obj_list_append(list, mp_obj_new_tuple(4, tuple));
+    }
+    MP_STATE_MEM(alloc_stats_enabled) = enabled;
+    return list;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_alloc_stats_obj, 0, 1, mp_micropython_alloc_stats);
+#endif
+
+#if MICROPY_PY_MICROPYTHON_PROFILE
+// Implemented by the port: clear the samples and take rate of them a second,
+// 0 stops, returning false if the rate cannot be done; and return them as
+// the dict profile() below describes.
+bool mp_hal_profile_start(mp_uint_t rate, mp_uint_t depth);
+mp_obj_t mp_hal_profile_get(void);
+
+// profile(rate, depth=1): clear the samples and start taking rate of them a
+// second, profile(0) stops; with depth 2 each sample also keeps its caller
+// profile(): return a dict of sample counts, keyed on the code address, or
+// (address, caller address) at depth 2, and for samples taken in the VM
+// also on 'file:line' of the Python code it was running; None counts the
+// samples that found the port's tables full
+STATIC mp_obj_t mp_micropython_profile(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 0) {
+        return mp_hal_profile_get();
+    }
+    mp_int_t rate = mp_obj_get_int(args[0]);
+    mp_int_t depth = (n_args > 1) ? mp_obj_get_int(args[1]) : 1;
+    if (rate < 0 || depth < 1 || depth > 2 || !mp_hal_profile_start(rate, depth)) {
+        mp_raise_ValueError(NULL);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_profile_obj, 0, 2, mp_micropython_profile);
+#endif
+
 #if MICROPY_PY_MICROPYTHON_STACK_USE
 STATIC mp_obj_t mp_micropython_stack_use(void) {
     return MP_OBJ_NEW_SMALL_INT(mp_stack_usage());
@@ -148,13 +226,144 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(mp_micropython_kbd_intr_obj, mp_micropython_kbd
 #endif
 
 #if MICROPY_ENABLE_SCHEDULER
-STATIC mp_obj_t mp_micropython_schedule(mp_obj_t function, mp_obj_t arg) {
-    if (!mp_sched_schedule(function, arg)) {
+STATIC mp_obj_t mp_micropython_schedule(size_t n_args, const mp_obj_t *args) {
+    // Higher levels run first, each level in order; the top ones also from long C calls.
+    unsigned int prio = (n_args > 2) ? mp_obj_get_int(args[2]) : 0;
+    if (!mp_sched_schedule_prio(args[0], args[1], prio)) {
         mp_raise_msg(&mp_type_RuntimeError, "schedule queue full");
     }
     return mp_const_none;
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_2(mp_micropython_schedule_obj, mp_micropython_schedule);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_schedule_obj, 2, 3, mp_micropython_schedule);
+
+#if MICROPY_SCHEDULER_STATS
+// A (run, dropped, latency_last, latency_max) tuple per level, latencies in scheduler ticks.
+STATIC mp_obj_t mp_micropython_sched_stats(size_t n_args, const mp_obj_t *args) {
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (int prio = 0; prio < MICROPY_SCHEDULER_PRIORITIES; prio++) {
+        mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+        mp_sched_stats_t stats = MP_STATE_VM(sched_stats)[prio];
+        if (n_args && mp_obj_is_true(args[0])) {
+            memset(&MP_STATE_VM(sched_stats)[prio], 0, sizeof(mp_sched_stats_t));
+        }
+        MICROPY_END_ATOMIC_SECTION(atomic_state);
+        mp_obj_t tuple[4] = {
+            mp_obj_new_int_from_uint(stats.run),
+            mp_obj_new_int_from_uint(stats.dropped),
+            mp_obj_new_int_from_uint(stats.latency_last),
+            mp_obj_new_int_from_uint(stats.latency_max),
+        };
+        mp_obj_list_append(list, mp_obj_new_tuple(4, tuple));
+    }
+    return list;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_sched_stats_obj, 0, 1, mp_micropython_sched_stats);
+#endif
+#endif
+
+#if MICROPY_PY_MICROPYTHON_POOL && MICROPY_PY_BUILTINS_MEMORYVIEW
+// Pool(n, size): n buffers of size bytes, and the memoryview objects for them,
+// carved out of a static region the GC neither owns nor scans.  get() and
+// put() never allocate, so they can be used from IRQ handlers with the heap
+// locked, eg to hand data to a callback given to micropython.schedule.
+// The region is only given back on soft reset.
+
+typedef struct _mp_obj_pool_t {
+    mp_obj_base_t base;
+    size_t n;
+    size_t next;
+    mp_obj_array_t *views;
+    uint8_t *in_use;
+} mp_obj_pool_t;
+
+STATIC uint8_t pool_arena[MICROPY_PY_MICROPYTHON_POOL_ARENA_SIZE] __attribute__((aligned(8)));
+
+STATIC void *pool_arena_take(size_t n_bytes) {
+    n_bytes = (n_bytes + 7) & ~7;
+    if (n_bytes > MICROPY_PY_MICROPYTHON_POOL_ARENA_SIZE - MP_STATE_VM(pool_arena_used)) {
+        mp_raise_msg(&mp_type_MemoryError, "pool region full");
+    }
+    void *p = pool_arena + MP_STATE_VM(pool_arena_used);
+    MP_STATE_VM(pool_arena_used) += n_bytes;
+    return p;
+}
+
+STATIC mp_obj_t pool_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 2, 2, false);
+    mp_int_t n = mp_obj_get_int(args[0]);
+    mp_int_t size = mp_obj_get_int(args[1]);
+    if (n <= 0 || size <= 0) {
+        mp_raise_ValueError(NULL);
+    }
+    // the views, the buffers and their in-use flags are taken in one go, so
+    // that a pool too big for what is left doesn't leak part of the region
+    size_t per_item = sizeof(mp_obj_array_t) + (size_t)size + 1;
+    if ((size_t)size > MICROPY_PY_MICROPYTHON_POOL_ARENA_SIZE
+        || (size_t)n > MICROPY_PY_MICROPYTHON_POOL_ARENA_SIZE / per_item) {
+        mp_raise_msg(&mp_type_MemoryError, "pool region full");
+    }
+
+    mp_obj_pool_t *self = m_new_obj(mp_obj_pool_t);
+    self->base.type = type;
+    self->n = n;
+    self->next = 0;
+    self->views = pool_arena_take(n * per_item);
+    byte *items = (byte*)&self->views[n];
+    self->in_use = items + n * size;
+    for (mp_int_t i = 0; i < n; i++) {
+        mp_obj_array_t *view = &self->views[i];
+        view->base.type = &mp_type_memoryview;
+        view->typecode = 'B' | MP_OBJ_ARRAY_TYPECODE_FLAG_RW;
+        view->free = 0;
+        view->len = size;
+        view->items = items + i * size;
+        self->in_use[i] = 0;
+    }
+    return MP_OBJ_FROM_PTR(self);
+}
+
+// get(): take a free buffer, or None if they are all taken
+STATIC mp_obj_t pool_get(mp_obj_t self_in) {
+    mp_obj_pool_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t ret = mp_const_none;
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    for (size_t k = 0, i = self->next; k < self->n; k++, i = (i + 1 == self->n) ? 0 : i + 1) {
+        if (!self->in_use[i]) {
+            self->in_use[i] = 1;
+            self->next = (i + 1 == self->n) ? 0 : i + 1;
+            ret = MP_OBJ_FROM_PTR(&self->views[i]);
+            break;
+        }
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+    return ret;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pool_get_obj, pool_get);
+
+// put(buf): give back a buffer taken with get()
+STATIC mp_obj_t pool_put(mp_obj_t self_in, mp_obj_t buf_in) {
+    mp_obj_pool_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_array_t *view = MP_OBJ_TO_PTR(buf_in);
+    if (view < self->views || view >= self->views + self->n) {
+        mp_raise_ValueError("not from this pool");
+    }
+    self->in_use[view - self->views] = 0;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(pool_put_obj, pool_put);
+
+STATIC const mp_rom_map_elem_t pool_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_get), MP_ROM_PTR(&pool_get_obj) },
+    { MP_ROM_QSTR(MP_QSTR_put), MP_ROM_PTR(&pool_put_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(pool_locals_dict, pool_locals_dict_table);
+
+STATIC const mp_obj_type_t mp_type_pool = {
+    { &mp_type_type },
+    .name = MP_QSTR_Pool,
+    .make_new = pool_make_new,
+    .locals_dict = (mp_obj_dict_t*)&pool_locals_dict,
+};
 #endif
 
 STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
@@ -172,6 +381,12 @@ STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_mem_info), MP_ROM_PTR(&mp_micropython_mem_info_obj) },
     { MP_ROM_QSTR(MP_QSTR_qstr_info), MP_ROM_PTR(&mp_micropython_qstr_info_obj) },
 #endif
+    #if MICROPY_PY_MICROPYTHON_ALLOC_STATS
+    { MP_ROM_QSTR(MP_QSTR_alloc_stats), MP_ROM_PTR(&mp_micropython_alloc_stats_obj) },
+    #endif
+    #if MICROPY_PY_MICROPYTHON_PROFILE
+    { MP_ROM_QSTR(MP_QSTR_profile), MP_ROM_PTR(&mp_micropython_profile_obj) },
+    #endif
     #if MICROPY_PY_MICROPYTHON_STACK_USE
     { MP_ROM_QSTR(MP_QSTR_stack_use), MP_ROM_PTR(&mp_micropython_stack_use_obj) },
     #endif
@@ -190,6 +405,12 @@ STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     #endif
     #if MICROPY_ENABLE_SCHEDULER
     { MP_ROM_QSTR(MP_QSTR_schedule), MP_ROM_PTR(&mp_micropython_schedule_obj) },
+    #if MICROPY_SCHEDULER_STATS
+    { MP_ROM_QSTR(MP_QSTR_sched_stats), MP_ROM_PTR(&mp_micropython_sched_stats_obj) },
+    #endif
+    #endif
+    #if MICROPY_PY_MICROPYTHON_POOL && MICROPY_PY_BUILTINS_MEMORYVIEW
+    { MP_ROM_QSTR(MP_QSTR_Pool), MP_ROM_PTR(&mp_type_pool) },
     #endif
 };
 
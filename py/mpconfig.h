@@ -142,6 +142,26 @@
 #define MICROPY_GC_CONSERVATIVE_CLEAR (MICROPY_ENABLE_GC)
 #endif
 
+// Support a second GC pool for big allocations, added with gc_add_large_pool().
+// Requests of MICROPY_GC_LARGE_THRESHOLD bytes or more are placed best-fit in
+// that pool, so long lived small objects can not fragment the space big
+// buffers need.  Either pool takes the other's requests once it is full.
+#ifndef MICROPY_GC_SPLIT_POOLS
+#define MICROPY_GC_SPLIT_POOLS (0)
+#endif
+
+#ifndef MICROPY_GC_LARGE_THRESHOLD
+#define MICROPY_GC_LARGE_THRESHOLD (1024)
+#endif
+
+// Support leaving part of the sweep of a collection for later, so the pause of
+// a collection can be bounded with gc.sweep_budget().  What is left is swept by
+// gc_sweep_step(), called from the idle path or gc.sweep(), or else at the
+// start of the next collection.
+#ifndef MICROPY_GC_INCREMENTAL_SWEEP
+#define MICROPY_GC_INCREMENTAL_SWEEP (0)
+#endif
+
 // Support automatic GC when reaching allocation threshold,
 // configurable by gc.threshold().
 #ifndef MICROPY_GC_ALLOC_THRESHOLD
@@ -236,6 +256,13 @@
 #define MICROPY_QSTR_BYTES_IN_HASH (2)
 #endif
 
+// Whether to find qstrs through hash indexes instead of scanning the pools:
+// one generated by makeqstrdata.py for the ROM pool and one on the heap,
+// grown as needed, for the rest.  Needs MICROPY_QSTR_BYTES_IN_HASH >= 2.
+#ifndef MICROPY_QSTR_HASH_INDEX
+#define MICROPY_QSTR_HASH_INDEX (0)
+#endif
+
 // Avoid using C stack when making Python function calls. C stack still
 // may be used if there's no free heap.
 #ifndef MICROPY_STACKLESS
@@ -358,9 +385,11 @@
 #if MICROPY_DYNAMIC_COMPILER
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC (mp_dynamic_compiler.opt_cache_map_lookup_in_bytecode)
 #define MICROPY_PY_BUILTINS_STR_UNICODE_DYNAMIC (mp_dynamic_compiler.py_builtins_str_unicode)
+#define MICROPY_OPT_SUPERINSTRUCTIONS_DYNAMIC (mp_dynamic_compiler.opt_superinstructions)
 #else
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
 #define MICROPY_PY_BUILTINS_STR_UNICODE_DYNAMIC MICROPY_PY_BUILTINS_STR_UNICODE
+#define MICROPY_OPT_SUPERINSTRUCTIONS_DYNAMIC MICROPY_OPT_SUPERINSTRUCTIONS
 #endif
 
 // Whether to enable constant folding; eg 1+2 rewritten as 3
@@ -383,6 +412,13 @@
 #define MICROPY_COMP_CONST (1)
 #endif
 
+// Whether pyexec compiles and runs file input one top-level statement at a time, so
+// only the parse tree of the statement being compiled is in RAM. A heap locked with
+// micropython.heap_lock() at module level is unlocked while the next statement compiles.
+#ifndef MICROPY_COMP_STREAM
+#define MICROPY_COMP_STREAM (0)
+#endif
+
 // Whether to enable optimisation of: a, b = c, d
 // Costs 124 bytes (Thumb2)
 #ifndef MICROPY_COMP_DOUBLE_TUPLE_ASSIGN
@@ -454,6 +490,34 @@
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (1)
 #endif
 
+// Number of map lookup cache bytes the VM keeps aside, indexed by bytecode
+// address, for bytecode that can't be written in place (see below) and for
+// LOAD_METHOD on native types, which has no cache byte in the bytecode.  The
+// cached index is only a hint so two opcodes sharing a byte just cost a full
+// lookup.  Set to 0 to disable.
+#ifndef MICROPY_OPT_CACHE_MAP_LOOKUP_SIDE_TABLE
+#define MICROPY_OPT_CACHE_MAP_LOOKUP_SIDE_TABLE (0)
+#endif
+
+// Whether the bytecode at ip is in read-only memory (eg frozen into flash)
+#ifndef MICROPY_BC_IS_READONLY
+#define MICROPY_BC_IS_READONLY(ip) (0)
+#endif
+
+// Whether the bytecode compiler fuses LOAD_FAST; LOAD_METHOD and LOAD_FAST;
+// LOAD_CONST_SMALL_INT; BINARY_OP into single opcodes the VM has handlers
+// for.  .mpy files holding such bytecode are flagged and need this to load.
+#ifndef MICROPY_OPT_SUPERINSTRUCTIONS
+#define MICROPY_OPT_SUPERINSTRUCTIONS (0)
+#endif
+
+// Whether dicts (non-ordered maps) are stored compactly, as in CPython 3.6:
+// the entries in insertion order with their hashes cached, found through a
+// small index of 1, 2 or 4 byte entry numbers.  Growing it never rehashes.
+#ifndef MICROPY_OPT_MAP_COMPACT
+#define MICROPY_OPT_MAP_COMPACT (0)
+#endif
+
 // Whether to use fast versions of bitwise operations (and, or, xor) when the
 // arguments are both positive.  Increases Thumb2 code size by about 250 bytes.
 #ifndef MICROPY_OPT_MPZ_BITWISE
@@ -507,6 +571,12 @@
 #define MICROPY_VM_HOOK_RETURN
 #endif
 
+// Hook for the scheduler, called with true before a scheduled callback runs and with
+// false after it returned
+#ifndef MICROPY_SCHED_HOOK
+#define MICROPY_SCHED_HOOK(running)
+#endif
+
 // Whether to include the garbage collector
 #ifndef MICROPY_ENABLE_GC
 #define MICROPY_ENABLE_GC (0)
@@ -544,6 +614,22 @@
 #   endif
 #endif
 
+// Whether StopIteration, KeyError and OSError(EAGAIN), which are raised for
+// routine control flow, are raised as instances kept in the VM state, with
+// their args and their tracebacks recorded in place.  One that C code
+// catches, like a for loop ending on StopIteration, costs no heap; one that
+// reaches a bytecode exception handler, which could keep hold of it, or that
+// unwinds more frames than the depth below is copied to the heap.  Raising
+// the same kind while its instance is busy allocates, and when the heap is
+// locked or full the busy instance is shared, like the emergency exception
+// object, so one kept past that raise shows the new args.
+#ifndef MICROPY_PREALLOC_EXCEPTIONS
+#define MICROPY_PREALLOC_EXCEPTIONS (0)
+#endif
+#ifndef MICROPY_PREALLOC_EXCEPTIONS_TRACEBACK_DEPTH
+#define MICROPY_PREALLOC_EXCEPTIONS_TRACEBACK_DEPTH (4)
+#endif
+
 // Whether to provide the mp_kbd_exception object, and micropython.kbd_intr function
 #ifndef MICROPY_KBD_EXCEPTION
 #define MICROPY_KBD_EXCEPTION (0)
@@ -593,6 +679,13 @@
 typedef long long mp_longint_impl_t;
 #endif
 
+// Whether mpz int objects keep up to 64 bits of digits inside the object, so
+// such values need no separate digit allocation; bigger values move their
+// digits to the heap.  Binary op results that fit a small int don't allocate.
+#ifndef MICROPY_LONGINT_MPZ_INLINE
+#define MICROPY_LONGINT_MPZ_INLINE (0)
+#endif
+
 // Whether to include information in the byte code to determine source
 // line number (increases RAM usage, but doesn't slow byte code execution)
 #ifndef MICROPY_ENABLE_SOURCE_LINE
@@ -663,6 +756,13 @@ typedef double mp_float_t;
 #define MICROPY_FLOAT_HIGH_QUALITY_HASH (0)
 #endif
 
+// Whether single precision floats are formatted with exact integer arithmetic
+// for 'f' (up to 9 decimals) and fixed notation 'g', instead of the per digit
+// float loop.  Output is correctly rounded; other cases use the loop.
+#ifndef MICROPY_FLOAT_FORMAT_FAST
+#define MICROPY_FLOAT_FORMAT_FAST (0)
+#endif
+
 // Enable features which improve CPython compatibility
 // but may lead to more code size/memory usage.
 // TODO: Originally intended as generic category to not
@@ -691,6 +791,12 @@ typedef double mp_float_t;
 #define MICROPY_STREAMS_POSIX_API (0)
 #endif
 
+// Number of readiness events kept for uselect (see mp_stream_poll_notify), streams
+// that signal them aren't polled on every wakeup. 0 to disable
+#ifndef MICROPY_STREAMS_POLL_NOTIFY
+#define MICROPY_STREAMS_POLL_NOTIFY (0)
+#endif
+
 // Whether to call __init__ when importing builtin modules for the first time
 #ifndef MICROPY_MODULE_BUILTIN_INIT
 #define MICROPY_MODULE_BUILTIN_INIT (0)
@@ -716,9 +822,24 @@ typedef double mp_float_t;
 #define MICROPY_MODULE_FROZEN_MPY (0)
 #endif
 
+// Whether modules can be imported from a .xmpy image (tools/mpy-tool.py --xip),
+// their bytecode run in place and their qstrs linked at boot without a copy.
+// Needs MICROPY_PERSISTENT_CODE_LOAD, the port points at the image with
+// MICROPY_MODULE_FROZEN_XIP_IMAGE(uint32_t *len) returning it or NULL.
+#ifndef MICROPY_MODULE_FROZEN_XIP
+#define MICROPY_MODULE_FROZEN_XIP (0)
+#endif
+
 // Convenience macro for whether frozen modules are supported
 #ifndef MICROPY_MODULE_FROZEN
-#define MICROPY_MODULE_FROZEN (MICROPY_MODULE_FROZEN_STR || MICROPY_MODULE_FROZEN_MPY)
+#define MICROPY_MODULE_FROZEN (MICROPY_MODULE_FROZEN_STR || MICROPY_MODULE_FROZEN_MPY || MICROPY_MODULE_FROZEN_XIP)
+#endif
+
+// Whether frozen .mpy modules whose body only binds constants and functions
+// are imported without running it, with globals and function objects in ROM
+// (the globals table is copied to the heap on the first store to it)
+#ifndef MICROPY_MODULE_FROZEN_GLOBALS
+#define MICROPY_MODULE_FROZEN_GLOBALS (0)
 #endif
 
 // Whether you can override builtins in the builtins module
@@ -755,6 +876,23 @@ typedef double mp_float_t;
 #define MICROPY_SCHEDULER_DEPTH (4)
 #endif
 
+// Number of scheduler priority levels, each with its own queue of MICROPY_SCHEDULER_DEPTH
+// entries; the highest level with a pending callback runs first, 0 is the lowest
+#ifndef MICROPY_SCHEDULER_PRIORITIES
+#define MICROPY_SCHEDULER_PRIORITIES (1)
+#endif
+
+// Lowest level mp_sched_check_in() runs callbacks of from inside long running C code
+#ifndef MICROPY_SCHEDULER_CHECK_IN_PRIORITY
+#define MICROPY_SCHEDULER_CHECK_IN_PRIORITY (MICROPY_SCHEDULER_PRIORITIES - 1)
+#endif
+
+// Whether to count callbacks run and dropped per level, and their latency from being
+// scheduled to running in units of MICROPY_SCHEDULER_TICKS() (which the port must provide)
+#ifndef MICROPY_SCHEDULER_STATS
+#define MICROPY_SCHEDULER_STATS (0)
+#endif
+
 // Support for generic VFS sub-system
 #ifndef MICROPY_VFS
 #define MICROPY_VFS (0)
@@ -873,6 +1011,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_BUILTINS_MEMORYVIEW_ITEMSIZE (0)
 #endif
 
+// Whether bytearray and memoryview have find/rfind/index/rindex/startswith/endswith
+// working on their data in place, and the bytes ones take any buffer to look for
+#ifndef MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND
+#define MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND (0)
+#endif
+
 // Whether to support set object
 #ifndef MICROPY_PY_BUILTINS_SET
 #define MICROPY_PY_BUILTINS_SET (1)
@@ -1028,6 +1172,39 @@ typedef double mp_float_t;
 #define MICROPY_PY_MICROPYTHON_MEM_INFO (0)
 #endif
 
+// Whether to provide "micropython.alloc_stats" function, which records the
+// number and size of heap allocations made by each source line
+#ifndef MICROPY_PY_MICROPYTHON_ALLOC_STATS
+#define MICROPY_PY_MICROPYTHON_ALLOC_STATS (0)
+#endif
+
+// Number of source lines micropython.alloc_stats can keep apart
+#ifndef MICROPY_ALLOC_STATS_SIZE
+#define MICROPY_ALLOC_STATS_SIZE (64)
+#endif
+
+// Whether to provide "micropython.profile" function, a statistical profiler
+// whose sampling the port implements with mp_hal_profile_start/get
+#ifndef MICROPY_PY_MICROPYTHON_PROFILE
+#define MICROPY_PY_MICROPYTHON_PROFILE (0)
+#endif
+
+// Whether the VM keeps MP_STATE_THREAD(current_code_state) up to date, for
+// sys.settrace and the profilers above that attribute to source lines
+#define MICROPY_TRACK_CODE_STATE (MICROPY_PY_SYS_SETTRACE || MICROPY_PY_MICROPYTHON_ALLOC_STATS || MICROPY_PY_MICROPYTHON_PROFILE)
+
+// Whether to provide "micropython.Pool", fixed size buffers carved out of a
+// static region outside the GC heap, which IRQ handlers can take and give
+// back without allocating
+#ifndef MICROPY_PY_MICROPYTHON_POOL
+#define MICROPY_PY_MICROPYTHON_POOL (0)
+#endif
+
+// Size in bytes of the static region micropython.Pool objects are carved from
+#ifndef MICROPY_PY_MICROPYTHON_POOL_ARENA_SIZE
+#define MICROPY_PY_MICROPYTHON_POOL_ARENA_SIZE (4096)
+#endif
+
 // Whether to provide "micropython.stack_use" function
 #ifndef MICROPY_PY_MICROPYTHON_STACK_USE
 #define MICROPY_PY_MICROPYTHON_STACK_USE (MICROPY_PY_MICROPYTHON_MEM_INFO)
@@ -1046,6 +1223,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_ARRAY_SLICE_ASSIGN (0)
 #endif
 
+// Whether to provide uarray.ops, saturating element-wise math on buffers.
+// The port supplies mp_module_uarray_ops.
+#ifndef MICROPY_PY_UARRAY_OPS
+#define MICROPY_PY_UARRAY_OPS (0)
+#endif
+
 // Whether to support attrtuple type (MicroPython extension)
 // It provides space-efficient tuples with attribute access
 #ifndef MICROPY_PY_ATTRTUPLE
@@ -1264,10 +1447,26 @@ typedef double mp_float_t;
 #define MICROPY_PY_UZLIB (0)
 #endif
 
+// Whether to provide uzlib.CompIO, a streaming deflate compressor
+#ifndef MICROPY_PY_UZLIB_COMPIO
+#define MICROPY_PY_UZLIB_COMPIO (0)
+#endif
+
 #ifndef MICROPY_PY_UJSON
 #define MICROPY_PY_UJSON (0)
 #endif
 
+// Whether to provide ujson.Parser, an event based pull parser reading a stream
+#ifndef MICROPY_PY_UJSON_PARSER
+#define MICROPY_PY_UJSON_PARSER (0)
+#endif
+
+// Size of the stack buffer ujson.dump() writes to the stream in chunks of;
+// 0 writes each token straight to the stream
+#ifndef MICROPY_PY_UJSON_DUMP_BUF
+#define MICROPY_PY_UJSON_DUMP_BUF (0)
+#endif
+
 #ifndef MICROPY_PY_URE
 #define MICROPY_PY_URE (0)
 #endif
@@ -1288,6 +1487,16 @@ typedef double mp_float_t;
 #define MICROPY_PY_URE_SUB (0)
 #endif
 
+// Whether to provide match_into()/search_into(), filling an existing match object
+#ifndef MICROPY_PY_URE_MATCH_INTO
+#define MICROPY_PY_URE_MATCH_INTO (0)
+#endif
+
+// Number of patterns ure.compile() and the module level functions keep compiled, 0 for none
+#ifndef MICROPY_PY_URE_CACHE
+#define MICROPY_PY_URE_CACHE (0)
+#endif
+
 #ifndef MICROPY_PY_UHEAPQ
 #define MICROPY_PY_UHEAPQ (0)
 #endif
@@ -1297,6 +1506,11 @@ typedef double mp_float_t;
 #define MICROPY_PY_UTIMEQ (0)
 #endif
 
+// Whether to provide utimeq.Wheel, a timer wheel with O(1) push
+#ifndef MICROPY_PY_UTIMEQ_WHEEL
+#define MICROPY_PY_UTIMEQ_WHEEL (0)
+#endif
+
 #ifndef MICROPY_PY_UHASHLIB
 #define MICROPY_PY_UHASHLIB (0)
 #endif
@@ -1313,6 +1527,11 @@ typedef double mp_float_t;
 #define MICROPY_PY_UHASHLIB_SHA256 (1)
 #endif
 
+// Whether uhashlib sha1/sha256 run on a hash engine the port provides (extmod/crypto_hw.h)
+#ifndef MICROPY_PY_UHASHLIB_HW
+#define MICROPY_PY_UHASHLIB_HW (0)
+#endif
+
 #ifndef MICROPY_PY_UCRYPTOLIB
 #define MICROPY_PY_UCRYPTOLIB (0)
 #endif
@@ -1326,6 +1545,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_UCRYPTOLIB_CONSTS (0)
 #endif
 
+// Whether ucryptolib AES runs on an engine the port provides (extmod/crypto_hw.h),
+// only 128-bit keys are accepted then
+#ifndef MICROPY_PY_UCRYPTOLIB_HW
+#define MICROPY_PY_UCRYPTOLIB_HW (0)
+#endif
+
 #ifndef MICROPY_PY_UBINASCII
 #define MICROPY_PY_UBINASCII (0)
 #endif
@@ -1524,6 +1749,12 @@ typedef double mp_float_t;
 #define MP_NOINLINE __attribute__((noinline))
 #endif
 
+// Modifier for the VM and other functions the port may want in faster memory,
+// eg a section its linker script places in tightly coupled RAM
+#ifndef MICROPY_HOT_TEXT
+#define MICROPY_HOT_TEXT
+#endif
+
 // Modifier for functions which should be always inlined
 #ifndef MP_ALWAYSINLINE
 #define MP_ALWAYSINLINE __attribute__((always_inline))
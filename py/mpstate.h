@@ -46,6 +46,7 @@ typedef struct mp_dynamic_compiler_t {
     uint8_t small_int_bits; // must be <= host small_int_bits
     bool opt_cache_map_lookup_in_bytecode;
     bool py_builtins_str_unicode;
+    bool opt_superinstructions;
     uint8_t native_arch;
     uint8_t nlr_buf_num_regs;
 } mp_dynamic_compiler_t;
@@ -60,8 +61,43 @@ extern mp_dynamic_compiler_t mp_dynamic_compiler;
 typedef struct _mp_sched_item_t {
     mp_obj_t func;
     mp_obj_t arg;
+    #if MICROPY_SCHEDULER_STATS
+    mp_uint_t ticks; // when it was scheduled
+    #endif
 } mp_sched_item_t;
 
+#if MICROPY_SCHEDULER_STATS
+typedef struct _mp_sched_stats_t {
+    uint32_t run;
+    uint32_t dropped; // queue full
+    uint32_t latency_last;
+    uint32_t latency_max;
+} mp_sched_stats_t;
+#endif
+
+#if MICROPY_PY_MICROPYTHON_ALLOC_STATS
+// Allocations made by one source line, an entry with a count of 0 is unused.
+typedef struct _mp_alloc_stat_t {
+    qstr source_file;
+    size_t source_line;
+    size_t count;
+    size_t bytes;
+} mp_alloc_stat_t;
+#endif
+
+// This structure holds one GC pool with its allocation (and finaliser) table.
+typedef struct _mp_state_mem_area_t {
+    byte *gc_alloc_table_start;
+    size_t gc_alloc_table_byte_len;
+    #if MICROPY_ENABLE_FINALISER
+    byte *gc_finaliser_table_start;
+    #endif
+    byte *gc_pool_start;
+    byte *gc_pool_end;
+
+    size_t gc_last_free_atb_index;
+} mp_state_mem_area_t;
+
 // This structure hold information about the memory allocation system.
 typedef struct _mp_state_mem_t {
     #if MICROPY_MEM_STATS
@@ -70,16 +106,17 @@ typedef struct _mp_state_mem_t {
     size_t peak_bytes_allocated;
     #endif
 
-    byte *gc_alloc_table_start;
-    size_t gc_alloc_table_byte_len;
-    #if MICROPY_ENABLE_FINALISER
-    byte *gc_finaliser_table_start;
+    mp_state_mem_area_t gc_area;
+    #if MICROPY_GC_SPLIT_POOLS
+    // pool for requests of MICROPY_GC_LARGE_THRESHOLD bytes or more, unused if gc_pool_start is NULL
+    mp_state_mem_area_t gc_large_area;
     #endif
-    byte *gc_pool_start;
-    byte *gc_pool_end;
 
     int gc_stack_overflow;
     MICROPY_GC_STACK_ENTRY_TYPE gc_stack[MICROPY_ALLOC_GC_STACK_SIZE];
+    #if MICROPY_GC_SPLIT_POOLS
+    mp_state_mem_area_t *gc_area_stack[MICROPY_ALLOC_GC_STACK_SIZE];
+    #endif
     uint16_t gc_lock_depth;
 
     // This variable controls auto garbage collection.  If set to 0 then the
@@ -92,12 +129,25 @@ typedef struct _mp_state_mem_t {
     size_t gc_alloc_threshold;
     #endif
 
-    size_t gc_last_free_atb_index;
-
     #if MICROPY_PY_GC_COLLECT_RETVAL
     size_t gc_collected;
     #endif
 
+    #if MICROPY_PY_MICROPYTHON_ALLOC_STATS
+    bool alloc_stats_enabled;
+    // allocations from lines that found the table full
+    mp_alloc_stat_t alloc_stats_dropped;
+    mp_alloc_stat_t alloc_stats[MICROPY_ALLOC_STATS_SIZE];
+    #endif
+
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // where the sweep left by the last collection resumes, gc_sweep_area is NULL if it is done
+    mp_state_mem_area_t *gc_sweep_area;
+    size_t gc_sweep_block;
+    // number of blocks a collection sweeps before leaving the rest for later
+    size_t gc_sweep_budget;
+    #endif
+
     #if MICROPY_PY_THREAD
     // This is a global mutex used to make the GC thread-safe.
     mp_thread_mutex_t gc_mutex;
@@ -116,6 +166,11 @@ typedef struct _mp_state_vm_t {
 
     qstr_pool_t *last_pool;
 
+    #if MICROPY_QSTR_HASH_INDEX
+    // index of the qstrs not in the ROM pool, see qstr.c
+    qstr *qstr_index;
+    #endif
+
     // non-heap memory for creating an exception if we can't allocate RAM
     mp_obj_exception_t mp_emergency_exception_obj;
 
@@ -135,6 +190,11 @@ typedef struct _mp_state_vm_t {
     mp_obj_exception_t mp_kbd_exception;
     #endif
 
+    #if MICROPY_PREALLOC_EXCEPTIONS
+    // exception objects reused for StopIteration, KeyError and OSError(EAGAIN)
+    mp_obj_exception_prealloc_t mp_prealloc_exc[MP_PREALLOC_EXC_NUM];
+    #endif
+
     // dictionary with loaded modules (may be exposed as sys.modules)
     mp_obj_dict_t mp_loaded_modules_dict;
 
@@ -142,7 +202,7 @@ typedef struct _mp_state_vm_t {
     volatile mp_obj_t mp_pending_exception;
 
     #if MICROPY_ENABLE_SCHEDULER
-    mp_sched_item_t sched_queue[MICROPY_SCHEDULER_DEPTH];
+    mp_sched_item_t sched_queue[MICROPY_SCHEDULER_PRIORITIES][MICROPY_SCHEDULER_DEPTH];
     #endif
 
     // current exception being handled, for sys.exc_info()
@@ -184,6 +244,10 @@ typedef struct _mp_state_vm_t {
     mp_obj_t lwip_slip_stream;
     #endif
 
+    #if MICROPY_PY_URE_CACHE
+    mp_obj_t ure_cache[MICROPY_PY_URE_CACHE * 2];
+    #endif
+
     #if MICROPY_VFS
     struct _mp_vfs_mount_t *vfs_cur;
     struct _mp_vfs_mount_t *vfs_mount_table;
@@ -203,6 +267,17 @@ typedef struct _mp_state_vm_t {
     size_t qstr_last_alloc;
     size_t qstr_last_used;
 
+    #if MICROPY_QSTR_HASH_INDEX
+    size_t qstr_index_alloc;
+    size_t qstr_index_len;
+    #endif
+
+    #if MICROPY_MODULE_FROZEN_XIP
+    // the .xmpy image linked at boot, or NULL
+    const void *xip_image;
+    size_t xip_image_len;
+    #endif
+
     #if MICROPY_PY_THREAD
     // This is a global mutex used to make qstr interning thread-safe.
     mp_thread_mutex_t qstr_mutex;
@@ -222,8 +297,18 @@ typedef struct _mp_state_vm_t {
 
     #if MICROPY_ENABLE_SCHEDULER
     volatile int16_t sched_state;
-    uint8_t sched_len;
-    uint8_t sched_idx;
+    uint8_t sched_len; // over all levels
+    uint8_t sched_urgent; // at MICROPY_SCHEDULER_CHECK_IN_PRIORITY and above
+    uint8_t sched_level_len[MICROPY_SCHEDULER_PRIORITIES];
+    uint8_t sched_idx[MICROPY_SCHEDULER_PRIORITIES];
+    #if MICROPY_SCHEDULER_STATS
+    mp_sched_stats_t sched_stats[MICROPY_SCHEDULER_PRIORITIES];
+    #endif
+    #endif
+
+    #if MICROPY_PY_MICROPYTHON_POOL
+    // bytes of the static micropython.Pool region handed out so far
+    size_t pool_arena_used;
     #endif
 
     #if MICROPY_PY_THREAD_GIL
@@ -262,6 +347,8 @@ typedef struct _mp_state_thread_t {
     #if MICROPY_PY_SYS_SETTRACE
     mp_obj_t prof_trace_callback;
     bool prof_callback_is_executing;
+    #endif
+    #if MICROPY_TRACK_CODE_STATE
     struct _mp_code_state_t *current_code_state;
     #endif
 } mp_state_thread_t;
@@ -696,6 +696,17 @@ STATIC void mpz_need_dig(mpz_t *z, size_t need) {
     }
 
     if (z->dig == NULL || z->alloc < need) {
+        #if MICROPY_LONGINT_MPZ_INLINE
+        if (z->fixed_dig) {
+            // outgrew its inline or stack digits, carry on with heap ones
+            mpz_dig_t *dig = m_new(mpz_dig_t, need);
+            memcpy(dig, z->dig, z->len * sizeof(mpz_dig_t));
+            z->fixed_dig = 0;
+            z->alloc = need;
+            z->dig = dig;
+            return;
+        }
+        #endif
         // if z has fixed digit buffer there's not much we can do as the caller will
         // be expecting a buffer with at least "need" bytes (but it shouldn't happen)
         assert(!z->fixed_dig);
@@ -1497,7 +1508,9 @@ void mpz_divmod_inpl(mpz_t *dest_quo, mpz_t *dest_rem, const mpz_t *lhs, const m
     if (lhs->neg != rhs->neg) {
         dest_quo->neg = 1;
         if (!mpz_is_zero(dest_rem)) {
-            mpz_t mpzone; mpz_init_from_int(&mpzone, -1);
+            mpz_t mpzone;
+            mpz_dig_t mpzone_dig[MPZ_NUM_DIG_FOR_INT];
+            mpz_init_fixed_from_int(&mpzone, mpzone_dig, MPZ_NUM_DIG_FOR_INT, -1);
             mpz_add_inpl(dest_quo, dest_quo, &mpzone);
             mpz_add_inpl(dest_rem, dest_rem, rhs);
         }
@@ -354,7 +354,12 @@ typedef struct _mp_map_t {
     size_t all_keys_are_qstrs : 1;
     size_t is_fixed : 1;    // a fixed array that can't be modified; must also be ordered
     size_t is_ordered : 1;  // an ordered array
+    #if MICROPY_MODULE_FROZEN_GLOBALS
+    size_t is_cow : 1;      // a fixed array that is copied to the heap on the first change
+    size_t used : (8 * sizeof(size_t) - 4);
+    #else
     size_t used : (8 * sizeof(size_t) - 3);
+    #endif
     size_t alloc;
     mp_map_elem_t *table;
 } mp_map_t;
@@ -378,6 +383,13 @@ void mp_map_deinit(mp_map_t *map);
 void mp_map_free(mp_map_t *map);
 mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind);
 void mp_map_clear(mp_map_t *map);
+#if MICROPY_MODULE_FROZEN_GLOBALS
+void mp_map_cow_copy(mp_map_t *map);
+#endif
+#if MICROPY_OPT_MAP_COMPACT
+size_t mp_map_table_size(size_t alloc);
+size_t mp_map_iter_max(const mp_map_t *map);
+#endif
 void mp_map_dump(mp_map_t *map);
 
 // Underlying set implementation (not set object)
@@ -665,6 +677,8 @@ mp_obj_t mp_obj_new_dict(size_t n_args);
 mp_obj_t mp_obj_new_set(size_t n_args, mp_obj_t *items);
 mp_obj_t mp_obj_new_slice(mp_obj_t start, mp_obj_t stop, mp_obj_t step);
 mp_obj_t mp_obj_new_bound_meth(mp_obj_t meth, mp_obj_t self);
+// Splits a bound method into the function and the object it is bound to, false if o_in is not one.
+bool mp_obj_bound_meth_get(mp_obj_t o_in, mp_obj_t *meth, mp_obj_t *self);
 mp_obj_t mp_obj_new_getitem_iter(mp_obj_t *args, mp_obj_iter_buf_t *iter_buf);
 mp_obj_t mp_obj_new_module(qstr module_name);
 mp_obj_t mp_obj_new_memoryview(byte typecode, size_t nitems, void *items);
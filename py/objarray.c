@@ -233,6 +233,10 @@ STATIC mp_obj_t memoryview_make_new(const mp_obj_type_t *type_in, size_t n_args,
 }
 
 #if MICROPY_PY_BUILTINS_MEMORYVIEW_ITEMSIZE
+#if MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND
+STATIC const mp_obj_dict_t memoryview_locals_dict;
+#endif
+
 STATIC void memoryview_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
     if (dest[0] != MP_OBJ_NULL) {
         return;
@@ -240,6 +244,14 @@ STATIC void memoryview_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
     if (attr == MP_QSTR_itemsize) {
         mp_obj_array_t *self = MP_OBJ_TO_PTR(self_in);
         dest[0] = MP_OBJ_NEW_SMALL_INT(mp_binary_get_size('@', self->typecode & TYPECODE_MASK, NULL));
+    #if MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND
+    } else {
+        // the attr hook hides locals_dict from the generic lookup
+        mp_map_elem_t *elem = mp_map_lookup((mp_map_t*)&memoryview_locals_dict.map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+        if (elem != NULL) {
+            mp_convert_member_lookup(self_in, &mp_type_memoryview, elem->value, dest);
+        }
+    #endif
     }
 }
 #endif
@@ -527,7 +539,7 @@ STATIC mp_int_t array_get_buffer(mp_obj_t o_in, mp_buffer_info_t *bufinfo, mp_ui
     return 0;
 }
 
-#if MICROPY_PY_BUILTINS_BYTEARRAY || MICROPY_PY_ARRAY
+#if MICROPY_PY_ARRAY || (MICROPY_PY_BUILTINS_BYTEARRAY && !MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND)
 STATIC const mp_rom_map_elem_t array_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_append), MP_ROM_PTR(&array_append_obj) },
     { MP_ROM_QSTR(MP_QSTR_extend), MP_ROM_PTR(&array_extend_obj) },
@@ -539,6 +551,38 @@ STATIC const mp_rom_map_elem_t array_locals_dict_table[] = {
 STATIC MP_DEFINE_CONST_DICT(array_locals_dict, array_locals_dict_table);
 #endif
 
+#if MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND
+// bytearray and memoryview search their data in place with the bytes methods.
+#define BUFFER_FIND_METHODS \
+    { MP_ROM_QSTR(MP_QSTR_find), MP_ROM_PTR(&str_find_obj) }, \
+    { MP_ROM_QSTR(MP_QSTR_rfind), MP_ROM_PTR(&str_rfind_obj) }, \
+    { MP_ROM_QSTR(MP_QSTR_index), MP_ROM_PTR(&str_index_obj) }, \
+    { MP_ROM_QSTR(MP_QSTR_rindex), MP_ROM_PTR(&str_rindex_obj) }, \
+    { MP_ROM_QSTR(MP_QSTR_startswith), MP_ROM_PTR(&str_startswith_obj) }, \
+    { MP_ROM_QSTR(MP_QSTR_endswith), MP_ROM_PTR(&str_endswith_obj) },
+
+#if MICROPY_PY_BUILTINS_BYTEARRAY
+STATIC const mp_rom_map_elem_t bytearray_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_append), MP_ROM_PTR(&array_append_obj) },
+    { MP_ROM_QSTR(MP_QSTR_extend), MP_ROM_PTR(&array_extend_obj) },
+    #if MICROPY_CPYTHON_COMPAT
+    { MP_ROM_QSTR(MP_QSTR_decode), MP_ROM_PTR(&bytes_decode_obj) },
+    #endif
+    BUFFER_FIND_METHODS
+};
+
+STATIC MP_DEFINE_CONST_DICT(bytearray_locals_dict, bytearray_locals_dict_table);
+#endif
+
+#if MICROPY_PY_BUILTINS_MEMORYVIEW
+STATIC const mp_rom_map_elem_t memoryview_locals_dict_table[] = {
+    BUFFER_FIND_METHODS
+};
+
+STATIC MP_DEFINE_CONST_DICT(memoryview_locals_dict, memoryview_locals_dict_table);
+#endif
+#endif
+
 #if MICROPY_PY_ARRAY
 const mp_obj_type_t mp_type_array = {
     { &mp_type_type },
@@ -565,7 +609,11 @@ const mp_obj_type_t mp_type_bytearray = {
     .binary_op = array_binary_op,
     .subscr = array_subscr,
     .buffer_p = { .get_buffer = array_get_buffer },
+    #if MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND
+    .locals_dict = (mp_obj_dict_t*)&bytearray_locals_dict,
+    #else
     .locals_dict = (mp_obj_dict_t*)&array_locals_dict,
+    #endif
 };
 #endif
 
@@ -582,6 +630,9 @@ const mp_obj_type_t mp_type_memoryview = {
     #endif
     .subscr = array_subscr,
     .buffer_p = { .get_buffer = array_get_buffer },
+    #if MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND
+    .locals_dict = (mp_obj_dict_t*)&memoryview_locals_dict,
+    #endif
 };
 #endif
 
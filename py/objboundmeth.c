@@ -114,3 +114,13 @@ mp_obj_t mp_obj_new_bound_meth(mp_obj_t meth, mp_obj_t self) {
     o->self = self;
     return MP_OBJ_FROM_PTR(o);
 }
+
+bool mp_obj_bound_meth_get(mp_obj_t o_in, mp_obj_t *meth, mp_obj_t *self) {
+    if (!MP_OBJ_IS_TYPE(o_in, &mp_type_bound_meth)) {
+        return false;
+    }
+    mp_obj_bound_meth_t *o = MP_OBJ_TO_PTR(o_in);
+    *meth = o->meth;
+    *self = o->self;
+    return true;
+}
@@ -41,7 +41,12 @@ STATIC mp_obj_t dict_update(size_t n_args, const mp_obj_t *args, mp_map_t *kwarg
 // the iteration is held in *cur and should be initialised with zero for the
 // first call.  Will return NULL when no more elements are available.
 STATIC mp_map_elem_t *dict_iter_next(mp_obj_dict_t *dict, size_t *cur) {
+    #if MICROPY_OPT_MAP_COMPACT
+    // entries are dense, only those handed out need looking at
+    size_t max = mp_map_iter_max(&dict->map);
+    #else
     size_t max = dict->map.alloc;
+    #endif
     mp_map_t *map = &dict->map;
 
     for (size_t i = *cur; i < max; i++) {
@@ -113,7 +118,12 @@ STATIC mp_obj_t dict_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
         case MP_UNARY_OP_LEN: return MP_OBJ_NEW_SMALL_INT(self->map.used);
         #if MICROPY_PY_SYS_GETSIZEOF
         case MP_UNARY_OP_SIZEOF: {
+            #if MICROPY_OPT_MAP_COMPACT
+            size_t sz = sizeof(*self) + (self->map.is_ordered ? sizeof(*self->map.table) * self->map.alloc
+                : mp_map_table_size(self->map.alloc));
+            #else
             size_t sz = sizeof(*self) + sizeof(*self->map.table) * self->map.alloc;
+            #endif
             return MP_OBJ_NEW_SMALL_INT(sz);
         }
         #endif
@@ -205,6 +215,13 @@ STATIC mp_obj_t dict_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
 /* dict methods                                                               */
 
 STATIC void mp_ensure_not_fixed(const mp_obj_dict_t *dict) {
+    #if MICROPY_MODULE_FROZEN_GLOBALS
+    if (dict->map.is_cow) {
+        // dict methods change the table without going through mp_map_lookup
+        mp_map_cow_copy((mp_map_t*)&dict->map);
+        return;
+    }
+    #endif
     if (dict->map.is_fixed) {
         mp_raise_TypeError(NULL);
     }
@@ -231,6 +248,13 @@ STATIC mp_obj_t dict_copy(mp_obj_t self_in) {
     other->map.all_keys_are_qstrs = self->map.all_keys_are_qstrs;
     other->map.is_fixed = 0;
     other->map.is_ordered = self->map.is_ordered;
+    #if MICROPY_OPT_MAP_COMPACT
+    if (!self->map.is_ordered) {
+        // the index and hashes after the entries are copied along, both blocks have the same layout
+        memcpy(other->map.table, self->map.table, mp_map_table_size(self->map.alloc));
+        return other_out;
+    }
+    #endif
     memcpy(other->map.table, self->map.table, self->map.alloc * sizeof(mp_map_elem_t));
     return other_out;
 }
@@ -100,6 +100,113 @@ mp_obj_t mp_alloc_emergency_exception_buf(mp_obj_t size_in) {
 #endif
 #endif  // MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
 
+#if MICROPY_PREALLOC_EXCEPTIONS
+void mp_obj_exception_prealloc_init(void) {
+    static const mp_obj_type_t *const types[MP_PREALLOC_EXC_NUM] = {
+        &mp_type_StopIteration, &mp_type_KeyError, &mp_type_OSError,
+    };
+    for (size_t i = 0; i < MP_PREALLOC_EXC_NUM; ++i) {
+        mp_obj_exception_prealloc_t *o = &MP_STATE_VM(mp_prealloc_exc)[i];
+        o->exc.base.type = types[i];
+        o->exc.traceback_alloc = MP_ARRAY_SIZE(o->traceback);
+        o->exc.traceback_len = 0;
+        o->exc.traceback_data = o->traceback;
+        o->exc.args = (mp_obj_tuple_t*)&o->args;
+        o->args.base.type = &mp_type_tuple;
+        o->args.len = 0;
+        o->busy = false;
+    }
+}
+
+STATIC bool exception_is_prealloc(mp_obj_exception_t *self) {
+    return (void*)self >= (void*)&MP_STATE_VM(mp_prealloc_exc)[0]
+        && (void*)self < (void*)&MP_STATE_VM(mp_prealloc_exc)[MP_PREALLOC_EXC_NUM];
+}
+
+// Returns the preallocated instance for these args with its traceback cleared,
+// or MP_OBJ_NULL if there is none.  An instance is busy from when it is handed
+// out until it is released, and a busy one is only handed out again if shared
+// is true, which is for when the heap can't give a new instance; a previous
+// raise of it that is still held onto then sees the new args and traceback.
+STATIC mp_obj_t exception_prealloc(const mp_obj_type_t *exc_type, size_t n_args, const mp_obj_t *args, bool shared) {
+    size_t kind;
+    if (exc_type == &mp_type_StopIteration && n_args <= 1) {
+        kind = MP_PREALLOC_EXC_STOP_ITERATION;
+    } else if (exc_type == &mp_type_KeyError && n_args == 1) {
+        kind = MP_PREALLOC_EXC_KEY_ERROR;
+    } else if (exc_type == &mp_type_OSError && n_args == 1 && args[0] == MP_OBJ_NEW_SMALL_INT(MP_EAGAIN)) {
+        kind = MP_PREALLOC_EXC_EAGAIN;
+    } else {
+        return MP_OBJ_NULL;
+    }
+    mp_obj_exception_prealloc_t *o = &MP_STATE_VM(mp_prealloc_exc)[kind];
+    if (o->busy && !shared) {
+        return MP_OBJ_NULL;
+    }
+    o->busy = true;
+    o->exc.traceback_len = 0;
+    o->args.len = n_args;
+    o->args.items[0] = n_args == 0 ? mp_const_none : args[0];
+    return MP_OBJ_FROM_PTR(&o->exc);
+}
+
+void mp_obj_exception_prealloc_release(mp_obj_t self_in) {
+    mp_obj_exception_t *self = MP_OBJ_TO_PTR(self_in);
+    if (exception_is_prealloc(self)) {
+        mp_obj_exception_prealloc_t *o = (mp_obj_exception_prealloc_t*)self;
+        o->busy = false;
+        // don't keep the arg alive until the next raise
+        o->args.items[0] = mp_const_none;
+    }
+}
+
+mp_obj_t mp_obj_exception_prealloc_copy(mp_obj_t self_in) {
+    mp_obj_exception_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!exception_is_prealloc(self)) {
+        return self_in;
+    }
+    mp_obj_exception_prealloc_t *pre = (mp_obj_exception_prealloc_t*)self;
+    size_t n_args = pre->args.len;
+    size_t tb_len = self->traceback_len;
+    mp_obj_exception_t *o = m_new_obj_maybe(mp_obj_exception_t);
+    mp_obj_tuple_t *o_tuple = (mp_obj_tuple_t*)&mp_const_empty_tuple_obj;
+    if (n_args != 0) {
+        o_tuple = m_new_obj_var_maybe(mp_obj_tuple_t, mp_obj_t, n_args);
+    }
+    size_t *tb_data = NULL;
+    if (tb_len != 0) {
+        tb_data = m_new_maybe(size_t, tb_len);
+    }
+    if (o == NULL || o_tuple == NULL || (tb_len != 0 && tb_data == NULL)) {
+        // no memory for a copy, so the handler gets the shared instance
+        return self_in;
+    }
+    if (n_args != 0) {
+        o_tuple->base.type = &mp_type_tuple;
+        o_tuple->len = n_args;
+        memcpy(o_tuple->items, pre->args.items, n_args * sizeof(mp_obj_t));
+    }
+    if (tb_len != 0) {
+        memcpy(tb_data, self->traceback_data, tb_len * sizeof(size_t));
+    }
+    o->base.type = self->base.type;
+    o->traceback_alloc = tb_len;
+    o->traceback_len = tb_len;
+    o->traceback_data = tb_data;
+    o->args = o_tuple;
+    mp_obj_exception_prealloc_release(self_in);
+    return MP_OBJ_FROM_PTR(o);
+}
+
+mp_obj_t mp_obj_exception_prealloc_make_room(mp_obj_t self_in) {
+    mp_obj_exception_t *self = MP_OBJ_TO_PTR(self_in);
+    if (exception_is_prealloc(self) && self->traceback_len + TRACEBACK_ENTRY_LEN > self->traceback_alloc) {
+        return mp_obj_exception_prealloc_copy(self_in);
+    }
+    return self_in;
+}
+#endif
+
 void mp_obj_exception_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_t kind) {
     mp_obj_exception_t *o = MP_OBJ_TO_PTR(o_in);
     mp_print_kind_t k = kind & ~PRINT_EXC_SUBCLASS;
@@ -210,6 +317,13 @@ void mp_obj_exception_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
         return;
     }
     if (attr == MP_QSTR_args) {
+        #if MICROPY_PREALLOC_EXCEPTIONS
+        if (exception_is_prealloc(self) && !gc_is_locked()) {
+            // the next raise reuses the tuple, so hand out a copy
+            dest[0] = mp_obj_new_tuple(self->args->len, self->args->items);
+            return;
+        }
+        #endif
         dest[0] = MP_OBJ_FROM_PTR(self->args);
     } else if (self->base.type == &mp_type_StopIteration && attr == MP_QSTR_value) {
         dest[0] = mp_obj_exception_get_value(self_in);
@@ -316,7 +430,25 @@ mp_obj_t mp_obj_new_exception_arg1(const mp_obj_type_t *exc_type, mp_obj_t arg)
 
 mp_obj_t mp_obj_new_exception_args(const mp_obj_type_t *exc_type, size_t n_args, const mp_obj_t *args) {
     assert(exc_type->make_new == mp_obj_exception_make_new);
+    #if MICROPY_PREALLOC_EXCEPTIONS
+    // use the preallocated instance if it isn't busy with an earlier raise;
+    // with the heap full use it anyway, as it keeps the args and traceback
+    // that the emergency exception object can't
+    mp_obj_t o = exception_prealloc(exc_type, n_args, args, false);
+    if (o != MP_OBJ_NULL) {
+        return o;
+    }
+    o = exc_type->make_new(exc_type, n_args, 0, args);
+    if (MP_OBJ_TO_PTR(o) == &MP_STATE_VM(mp_emergency_exception_obj)) {
+        mp_obj_t pre = exception_prealloc(exc_type, n_args, args, true);
+        if (pre != MP_OBJ_NULL) {
+            return pre;
+        }
+    }
+    return o;
+    #else
     return exc_type->make_new(exc_type, n_args, 0, args);
+    #endif
 }
 
 mp_obj_t mp_obj_new_exception_msg(const mp_obj_type_t *exc_type, const char *msg) {
@@ -483,6 +615,13 @@ bool mp_obj_exception_match(mp_obj_t exc, mp_const_obj_t exc_type) {
 
 void mp_obj_exception_clear_traceback(mp_obj_t self_in) {
     GET_NATIVE_EXCEPTION(self, self_in);
+    #if MICROPY_PREALLOC_EXCEPTIONS
+    if (exception_is_prealloc(self)) {
+        // keep the storage in the VM state
+        self->traceback_len = 0;
+        return;
+    }
+    #endif
     // just set the traceback to the null object
     // we don't want to call any memory management functions here
     self->traceback_data = NULL;
@@ -518,6 +657,12 @@ void mp_obj_exception_add_traceback(mp_obj_t self_in, qstr file, size_t line, qs
         }
         self->traceback_len = 0;
     } else if (self->traceback_len + TRACEBACK_ENTRY_LEN > self->traceback_alloc) {
+        #if MICROPY_PREALLOC_EXCEPTIONS
+        if (exception_is_prealloc(self)) {
+            // Can't grow the in-place storage, keep the innermost frames
+            return;
+        }
+        #endif
         #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
         if (self->traceback_data == (size_t*)MP_STATE_VM(mp_emergency_exception_buf)) {
             // Can't resize the emergency buffer
@@ -37,6 +37,37 @@ typedef struct _mp_obj_exception_t {
     mp_obj_tuple_t *args;
 } mp_obj_exception_t;
 
+#if MICROPY_PREALLOC_EXCEPTIONS
+enum {
+    MP_PREALLOC_EXC_STOP_ITERATION,
+    MP_PREALLOC_EXC_KEY_ERROR,
+    MP_PREALLOC_EXC_EAGAIN,
+    MP_PREALLOC_EXC_NUM,
+};
+
+// An exception instance that lives in the VM state together with its args
+// tuple (at most 1 item) and traceback storage.  It is busy from when it is
+// raised until C code that catches it releases it, or until it is copied to
+// the heap for a bytecode exception handler, which can keep hold of it.
+typedef struct _mp_obj_exception_prealloc_t {
+    mp_obj_exception_t exc;
+    struct {
+        mp_obj_base_t base;
+        size_t len;
+        mp_obj_t items[1];
+    } args;
+    size_t traceback[MICROPY_PREALLOC_EXCEPTIONS_TRACEBACK_DEPTH * 3];
+    bool busy;
+} mp_obj_exception_prealloc_t;
+
+void mp_obj_exception_prealloc_init(void);
+// These take any exception and do nothing unless it is a preallocated one.
+void mp_obj_exception_prealloc_release(mp_obj_t self_in);
+mp_obj_t mp_obj_exception_prealloc_copy(mp_obj_t self_in);
+// Returns a heap copy if the traceback storage can't take another frame.
+mp_obj_t mp_obj_exception_prealloc_make_room(mp_obj_t self_in);
+#endif
+
 void mp_obj_exception_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_t kind);
 void mp_obj_exception_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest);
 
@@ -29,12 +29,20 @@
 #include "py/mpz.h"
 #include "py/obj.h"
 
+#if MICROPY_LONGINT_MPZ_INLINE
+// A long long plus the carry digits add and mul ask for before normalising.
+#define MP_OBJ_INT_INLINE_DIG (MPZ_NUM_DIG_FOR_LL + 2)
+#endif
+
 typedef struct _mp_obj_int_t {
     mp_obj_base_t base;
 #if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_LONGLONG
     mp_longint_impl_t val;
 #elif MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ
     mpz_t mpz;
+    #if MICROPY_LONGINT_MPZ_INLINE
+    mpz_dig_t dig[MP_OBJ_INT_INLINE_DIG];
+    #endif
 #endif
 } mp_obj_int_t;
 
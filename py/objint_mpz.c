@@ -75,10 +75,40 @@ const mp_obj_int_t mp_maxsize_obj = {
 mp_obj_int_t *mp_obj_int_new_mpz(void) {
     mp_obj_int_t *o = m_new_obj(mp_obj_int_t);
     o->base.type = &mp_type_int;
+    #if MICROPY_LONGINT_MPZ_INLINE
+    mpz_init_fixed_from_int(&o->mpz, o->dig, MP_OBJ_INT_INLINE_DIG, 0);
+    #else
     mpz_init_zero(&o->mpz);
+    #endif
     return o;
 }
 
+#if MICROPY_LONGINT_MPZ_INLINE
+// Declares a zero mpz with digits on the stack, the size of an object's inline ones.
+#define MPZ_STACK_ZERO(z) \
+    mpz_t z; \
+    mpz_dig_t z ## _dig[MP_OBJ_INT_INLINE_DIG]; \
+    mpz_init_fixed_from_int(&z, z ## _dig, MP_OBJ_INT_INLINE_DIG, 0)
+
+// Returns a result computed in a stack mpz as a small int if it fits, else as an int object.
+STATIC mp_obj_t mp_obj_int_from_stack_mpz(mpz_t *z) {
+    mp_int_t value;
+    if (mpz_as_int_checked(z, &value) && MP_SMALL_INT_FITS(value)) {
+        mpz_deinit(z);
+        return MP_OBJ_NEW_SMALL_INT(value);
+    }
+    mp_obj_int_t *o = mp_obj_int_new_mpz();
+    if (z->fixed_dig) {
+        // still in the stack digits, which fit in the inline ones
+        mpz_set(&o->mpz, z);
+    } else {
+        // moved to the heap, take the digits over
+        o->mpz = *z;
+    }
+    return MP_OBJ_FROM_PTR(o);
+}
+#endif
+
 // This routine expects you to pass in a buffer and size (in *buf and buf_size).
 // If, for some reason, this buffer is too small, then it will allocate a
 // buffer and return the allocated buffer and size in *buf and *buf_size. It
@@ -206,20 +236,26 @@ mp_obj_t mp_obj_int_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_i
 #endif
 
     if (op >= MP_BINARY_OP_INPLACE_OR && op < MP_BINARY_OP_CONTAINS) {
-        mp_obj_int_t *res = mp_obj_int_new_mpz();
+        #if MICROPY_LONGINT_MPZ_INLINE
+        MPZ_STACK_ZERO(z_res);
+        mpz_t *res = &z_res;
+        #else
+        mp_obj_int_t *res_obj = mp_obj_int_new_mpz();
+        mpz_t *res = &res_obj->mpz;
+        #endif
 
         switch (op) {
             case MP_BINARY_OP_ADD:
             case MP_BINARY_OP_INPLACE_ADD:
-                mpz_add_inpl(&res->mpz, zlhs, zrhs);
+                mpz_add_inpl(res, zlhs, zrhs);
                 break;
             case MP_BINARY_OP_SUBTRACT:
             case MP_BINARY_OP_INPLACE_SUBTRACT:
-                mpz_sub_inpl(&res->mpz, zlhs, zrhs);
+                mpz_sub_inpl(res, zlhs, zrhs);
                 break;
             case MP_BINARY_OP_MULTIPLY:
             case MP_BINARY_OP_INPLACE_MULTIPLY:
-                mpz_mul_inpl(&res->mpz, zlhs, zrhs);
+                mpz_mul_inpl(res, zlhs, zrhs);
                 break;
             case MP_BINARY_OP_FLOOR_DIVIDE:
             case MP_BINARY_OP_INPLACE_FLOOR_DIVIDE: {
@@ -227,8 +263,12 @@ mp_obj_t mp_obj_int_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_i
                     zero_division_error:
                     mp_raise_msg(&mp_type_ZeroDivisionError, "divide by zero");
                 }
+                #if MICROPY_LONGINT_MPZ_INLINE
+                MPZ_STACK_ZERO(rem);
+                #else
                 mpz_t rem; mpz_init_zero(&rem);
-                mpz_divmod_inpl(&res->mpz, &rem, zlhs, zrhs);
+                #endif
+                mpz_divmod_inpl(res, &rem, zlhs, zrhs);
                 mpz_deinit(&rem);
                 break;
             }
@@ -237,23 +277,27 @@ mp_obj_t mp_obj_int_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_i
                 if (mpz_is_zero(zrhs)) {
                     goto zero_division_error;
                 }
+                #if MICROPY_LONGINT_MPZ_INLINE
+                MPZ_STACK_ZERO(quo);
+                #else
                 mpz_t quo; mpz_init_zero(&quo);
-                mpz_divmod_inpl(&quo, &res->mpz, zlhs, zrhs);
+                #endif
+                mpz_divmod_inpl(&quo, res, zlhs, zrhs);
                 mpz_deinit(&quo);
                 break;
             }
 
             case MP_BINARY_OP_AND:
             case MP_BINARY_OP_INPLACE_AND:
-                mpz_and_inpl(&res->mpz, zlhs, zrhs);
+                mpz_and_inpl(res, zlhs, zrhs);
                 break;
             case MP_BINARY_OP_OR:
             case MP_BINARY_OP_INPLACE_OR:
-                mpz_or_inpl(&res->mpz, zlhs, zrhs);
+                mpz_or_inpl(res, zlhs, zrhs);
                 break;
             case MP_BINARY_OP_XOR:
             case MP_BINARY_OP_INPLACE_XOR:
-                mpz_xor_inpl(&res->mpz, zlhs, zrhs);
+                mpz_xor_inpl(res, zlhs, zrhs);
                 break;
 
             case MP_BINARY_OP_LSHIFT:
@@ -265,9 +309,9 @@ mp_obj_t mp_obj_int_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_i
                     mp_raise_ValueError("negative shift count");
                 }
                 if (op == MP_BINARY_OP_LSHIFT || op == MP_BINARY_OP_INPLACE_LSHIFT) {
-                    mpz_shl_inpl(&res->mpz, zlhs, irhs);
+                    mpz_shl_inpl(res, zlhs, irhs);
                 } else {
-                    mpz_shr_inpl(&res->mpz, zlhs, irhs);
+                    mpz_shr_inpl(res, zlhs, irhs);
                 }
                 break;
             }
@@ -281,7 +325,7 @@ mp_obj_t mp_obj_int_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_i
                     mp_raise_ValueError("negative power with no float support");
                     #endif
                 }
-                mpz_pow_inpl(&res->mpz, zlhs, zrhs);
+                mpz_pow_inpl(res, zlhs, zrhs);
                 break;
 
             default: {
@@ -289,14 +333,24 @@ mp_obj_t mp_obj_int_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_i
                 if (mpz_is_zero(zrhs)) {
                     goto zero_division_error;
                 }
+                #if MICROPY_LONGINT_MPZ_INLINE
+                MPZ_STACK_ZERO(quo);
+                mpz_divmod_inpl(&quo, res, zlhs, zrhs);
+                mp_obj_t tuple[2] = {mp_obj_int_from_stack_mpz(&quo), mp_obj_int_from_stack_mpz(res)};
+                #else
                 mp_obj_int_t *quo = mp_obj_int_new_mpz();
-                mpz_divmod_inpl(&quo->mpz, &res->mpz, zlhs, zrhs);
-                mp_obj_t tuple[2] = {MP_OBJ_FROM_PTR(quo), MP_OBJ_FROM_PTR(res)};
+                mpz_divmod_inpl(&quo->mpz, res, zlhs, zrhs);
+                mp_obj_t tuple[2] = {MP_OBJ_FROM_PTR(quo), MP_OBJ_FROM_PTR(res_obj)};
+                #endif
                 return mp_obj_new_tuple(2, tuple);
             }
         }
 
-        return MP_OBJ_FROM_PTR(res);
+        #if MICROPY_LONGINT_MPZ_INLINE
+        return mp_obj_int_from_stack_mpz(res);
+        #else
+        return MP_OBJ_FROM_PTR(res_obj);
+        #endif
 
     } else {
         int cmp = mpz_cmp(zlhs, zrhs);
@@ -76,7 +76,11 @@ STATIC void module_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
     } else {
         // delete/store attribute
         mp_obj_dict_t *dict = self->globals;
-        if (dict->map.is_fixed) {
+        if (dict->map.is_fixed
+            #if MICROPY_MODULE_FROZEN_GLOBALS
+            && !dict->map.is_cow
+            #endif
+            ) {
             #if MICROPY_CAN_OVERRIDE_BUILTINS
             if (dict == &mp_module_builtins_globals) {
                 if (MP_STATE_VM(mp_module_builtins_override_dict) == NULL) {
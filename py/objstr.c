@@ -457,9 +457,32 @@ STATIC mp_obj_t str_join(mp_obj_t self_in, mp_obj_t arg) {
     mp_obj_t *seq_items;
 
     if (!mp_obj_is_type(arg, &mp_type_list) && !mp_obj_is_type(arg, &mp_type_tuple)) {
-        // arg is not a list nor a tuple, try to convert it to a list
-        // TODO: Try to optimize?
-        arg = mp_type_list.make_new(&mp_type_list, 1, 0, &arg);
+        // arg is not a list nor a tuple, join the items as they come rather than keeping
+        // them all in a list: each one can be collected once it is copied, and the string
+        // grows by doubling and is trimmed to its exact length at the end
+        vstr_t vstr;
+        vstr_init(&vstr, 16);
+        mp_obj_iter_buf_t iter_buf;
+        mp_obj_t iterable = mp_getiter(arg, &iter_buf);
+        mp_obj_t item;
+        bool first = true;
+        while ((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
+            if (mp_obj_get_type(item) != self_type) {
+                mp_raise_TypeError(
+                    "join expects a list of str/bytes objects consistent with self object");
+            }
+            GET_STR_DATA_LEN(item, s, l);
+            size_t n = (first ? 0 : sep_len) + l;
+            if (vstr.len + n > vstr.alloc) {
+                vstr_hint_size(&vstr, MAX(n, vstr.alloc));
+            }
+            if (!first) {
+                vstr_add_strn(&vstr, (const char*)sep_str, sep_len);
+            }
+            vstr_add_strn(&vstr, (const char*)s, l);
+            first = false;
+        }
+        return mp_obj_new_str_from_vstr(self_type, &vstr);
     }
     mp_obj_get_array(arg, &seq_len, &seq_items);
 
@@ -684,7 +707,38 @@ STATIC mp_obj_t str_rsplit(size_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(str_rsplit_obj, 1, 3, str_rsplit);
 
+#if MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND
+// The search methods treat a self that isn't str or bytes (bytearray, memoryview) as bytes.
+STATIC const mp_obj_type_t *str_search_type(mp_obj_t self_in) {
+    if (mp_obj_is_str_or_bytes(self_in)) {
+        return mp_obj_get_type(self_in);
+    }
+    return &mp_type_bytes;
+}
+
+// Gets the data of a search method's self or argument, which for bytes can be any buffer.
+STATIC const byte *str_search_data(const mp_obj_type_t *self_type, mp_obj_t arg, size_t *len) {
+    if (mp_obj_get_type(arg) == self_type) {
+        GET_STR_DATA_LEN(arg, data, data_len);
+        *len = data_len;
+        return data;
+    }
+    mp_buffer_info_t bufinfo;
+    if (self_type == &mp_type_bytes && !mp_obj_is_str(arg) && mp_get_buffer(arg, &bufinfo, MP_BUFFER_READ)) {
+        *len = bufinfo.len;
+        return bufinfo.buf;
+    }
+    bad_implicit_conversion(arg);
+}
+#endif
+
 STATIC mp_obj_t str_finder(size_t n_args, const mp_obj_t *args, int direction, bool is_index) {
+    #if MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND
+    const mp_obj_type_t *self_type = str_search_type(args[0]);
+    size_t haystack_len, needle_len;
+    const byte *haystack = str_search_data(self_type, args[0], &haystack_len);
+    const byte *needle = str_search_data(self_type, args[1], &needle_len);
+    #else
     const mp_obj_type_t *self_type = mp_obj_get_type(args[0]);
     mp_check_self(mp_obj_is_str_or_bytes(args[0]));
 
@@ -695,6 +749,7 @@ STATIC mp_obj_t str_finder(size_t n_args, const mp_obj_t *args, int direction, b
 
     GET_STR_DATA_LEN(args[0], haystack, haystack_len);
     GET_STR_DATA_LEN(args[1], needle, needle_len);
+    #endif
 
     const byte *start = haystack;
     const byte *end = haystack + haystack_len;
@@ -751,10 +806,17 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(str_rindex_obj, 2, 4, str_rindex);
 
 // TODO: (Much) more variety in args
 STATIC mp_obj_t str_startswith(size_t n_args, const mp_obj_t *args) {
+    #if MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND
+    const mp_obj_type_t *self_type = str_search_type(args[0]);
+    size_t str_len, prefix_len;
+    const byte *str = str_search_data(self_type, args[0], &str_len);
+    const byte *prefix = str_search_data(self_type, args[1], &prefix_len);
+    #else
     const mp_obj_type_t *self_type = mp_obj_get_type(args[0]);
     GET_STR_DATA_LEN(args[0], str, str_len);
     size_t prefix_len;
     const char *prefix = mp_obj_str_get_data(args[1], &prefix_len);
+    #endif
     const byte *start = str;
     if (n_args > 2) {
         start = str_index_to_ptr(self_type, str, str_len, args[2], true);
@@ -767,9 +829,16 @@ STATIC mp_obj_t str_startswith(size_t n_args, const mp_obj_t *args) {
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(str_startswith_obj, 2, 3, str_startswith);
 
 STATIC mp_obj_t str_endswith(size_t n_args, const mp_obj_t *args) {
+    #if MICROPY_PY_BUILTINS_BYTES_BUFFER_FIND
+    const mp_obj_type_t *self_type = str_search_type(args[0]);
+    size_t str_len, suffix_len;
+    const byte *str = str_search_data(self_type, args[0], &str_len);
+    const byte *suffix = str_search_data(self_type, args[1], &suffix_len);
+    #else
     GET_STR_DATA_LEN(args[0], str, str_len);
     size_t suffix_len;
     const char *suffix = mp_obj_str_get_data(args[1], &suffix_len);
+    #endif
     if (n_args > 2) {
         mp_raise_NotImplementedError("start/end indices");
     }
@@ -944,7 +1013,8 @@ STATIC NORETURN void terse_str_format_value_error(void) {
 STATIC vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *arg_i, size_t n_args, const mp_obj_t *args, mp_map_t *kwargs) {
     vstr_t vstr;
     mp_print_t print;
-    vstr_init_print(&vstr, 16, &print);
+    // sized for the literal text so short results don't regrow
+    vstr_init_print(&vstr, (top - str) + 16, &print);
 
     for (; str < top; str++) {
         if (*str == '}') {
@@ -1103,11 +1173,18 @@ STATIC vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *ar
                 assert(conversion == 'r');
                 print_kind = PRINT_REPR;
             }
-            vstr_t arg_vstr;
-            mp_print_t arg_print;
-            vstr_init_print(&arg_vstr, 16, &arg_print);
-            mp_obj_print_helper(&arg_print, arg, print_kind);
-            arg = mp_obj_new_str_from_vstr(&mp_type_str, &arg_vstr);
+            if (!format_spec) {
+                // nothing to pad or truncate, print straight into the result
+                mp_obj_print_helper(&print, arg, print_kind);
+                continue;
+            }
+            if (print_kind == PRINT_REPR || !mp_obj_is_str(arg)) {
+                vstr_t arg_vstr;
+                mp_print_t arg_print;
+                vstr_init_print(&arg_vstr, 16, &arg_print);
+                mp_obj_print_helper(&arg_print, arg, print_kind);
+                arg = mp_obj_new_str_from_vstr(&mp_type_str, &arg_vstr);
+            }
         }
 
         char fill = '\0';
@@ -1401,7 +1478,8 @@ STATIC mp_obj_t str_modulo_format(mp_obj_t pattern, size_t n_args, const mp_obj_
     size_t arg_i = 0;
     vstr_t vstr;
     mp_print_t print;
-    vstr_init_print(&vstr, 16, &print);
+    // sized for the literal text so short results don't regrow
+    vstr_init_print(&vstr, len + 16, &print);
 
     for (const byte *top = str + len; str < top; str++) {
         mp_obj_t arg = MP_OBJ_NULL;
@@ -1543,15 +1621,30 @@ not_enough_args:
             case 'r':
             case 's':
             {
-                vstr_t arg_vstr;
-                mp_print_t arg_print;
-                vstr_init_print(&arg_vstr, 16, &arg_print);
                 mp_print_kind_t print_kind = (*str == 'r' ? PRINT_REPR : PRINT_STR);
                 if (print_kind == PRINT_STR && is_bytes && mp_obj_is_type(arg, &mp_type_bytes)) {
                     // If we have something like b"%s" % b"1", bytes arg should be
                     // printed undecorated.
                     print_kind = PRINT_RAW;
                 }
+                if (width < 0 && prec < 0) {
+                    // nothing to pad or truncate, print straight into the result
+                    mp_obj_print_helper(&print, arg, print_kind);
+                    break;
+                }
+                if (print_kind != PRINT_REPR && (print_kind == PRINT_RAW || mp_obj_is_str(arg))) {
+                    // the text is the data itself
+                    GET_STR_DATA_LEN(arg, arg_data, arg_len);
+                    uint vlen = arg_len;
+                    if (prec >= 0 && vlen > (uint)prec) {
+                        vlen = prec;
+                    }
+                    mp_print_strn(&print, (const char*)arg_data, vlen, flags, ' ', width);
+                    break;
+                }
+                vstr_t arg_vstr;
+                mp_print_t arg_print;
+                vstr_init_print(&arg_vstr, 16, &arg_print);
                 mp_obj_print_helper(&arg_print, arg, print_kind);
                 uint vlen = arg_vstr.len;
                 if (prec < 0) {
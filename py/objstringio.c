@@ -28,6 +28,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "py/objarray.h"
 #include "py/objstr.h"
 #include "py/objstringio.h"
 #include "py/runtime.h"
@@ -67,9 +68,12 @@ STATIC mp_uint_t stringio_read(mp_obj_t o_in, void *buf, mp_uint_t size, int *er
     return size;
 }
 
-STATIC void stringio_copy_on_write(mp_obj_stringio_t *o) {
+// Also used once getbuffer() handed out the buffer: a write that does not fit it goes to a
+// new one and the old one is left to the memoryview, rather than being moved by a realloc.
+STATIC void stringio_copy_on_write(mp_obj_stringio_t *o, mp_uint_t alloc) {
     const void *buf = o->vstr->buf;
-    o->vstr->buf = m_new(char, o->vstr->len);
+    o->vstr->buf = m_new(char, alloc);
+    o->vstr->alloc = alloc;
     o->vstr->fixed_buf = false;
     o->ref_obj = MP_OBJ_NULL;
     memcpy(o->vstr->buf, buf, o->vstr->len);
@@ -80,16 +84,16 @@ STATIC mp_uint_t stringio_write(mp_obj_t o_in, const void *buf, mp_uint_t size,
     mp_obj_stringio_t *o = MP_OBJ_TO_PTR(o_in);
     check_stringio_is_open(o);
 
-    if (o->vstr->fixed_buf) {
-        stringio_copy_on_write(o);
-    }
-
     mp_uint_t new_pos = o->pos + size;
     if (new_pos < size) {
         // Writing <size> bytes will overflow o->pos beyond limit of mp_uint_t.
         *errcode = MP_EFBIG;
         return MP_STREAM_ERROR;
     }
+
+    if (o->vstr->fixed_buf || (o->ref_obj != MP_OBJ_NULL && new_pos > o->vstr->alloc)) {
+        stringio_copy_on_write(o, MAX(o->vstr->alloc, new_pos));
+    }
     mp_uint_t org_len = o->vstr->len;
     if (new_pos > o->vstr->alloc) {
         // Take all what's already allocated...
@@ -144,6 +148,10 @@ STATIC mp_uint_t stringio_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg,
         case MP_STREAM_FLUSH:
             return 0;
         case MP_STREAM_CLOSE:
+            if (o->ref_obj != MP_OBJ_NULL) {
+                // the buffer belongs to the object it came from or a getbuffer() view
+                o->vstr->fixed_buf = true;
+            }
             #if MICROPY_CPYTHON_COMPAT
             vstr_free(o->vstr);
             o->vstr = NULL;
@@ -170,6 +178,23 @@ STATIC mp_obj_t stringio_getvalue(mp_obj_t self_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(stringio_getvalue_obj, stringio_getvalue);
 
+#if MICROPY_PY_IO_BYTESIO && MICROPY_PY_BUILTINS_MEMORYVIEW
+// A writable memoryview of the contents, without a copy. Writes that fit the buffer show
+// through it, a write that needs a larger buffer leaves the view on the old one.
+STATIC mp_obj_t bytesio_getbuffer(mp_obj_t self_in) {
+    mp_obj_stringio_t *self = MP_OBJ_TO_PTR(self_in);
+    check_stringio_is_open(self);
+    if (self->vstr->fixed_buf) {
+        // the buffer is the bytes object it was made from
+        stringio_copy_on_write(self, self->vstr->len);
+    }
+    mp_obj_t view = mp_obj_new_memoryview('B' | MP_OBJ_ARRAY_TYPECODE_FLAG_RW, self->vstr->len, self->vstr->buf);
+    self->ref_obj = view;
+    return view;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(bytesio_getbuffer_obj, bytesio_getbuffer);
+#endif
+
 STATIC mp_obj_t stringio___exit__(size_t n_args, const mp_obj_t *args) {
     (void)n_args;
     return mp_stream_close(args[0]);
@@ -185,21 +210,36 @@ STATIC mp_obj_stringio_t *stringio_new(const mp_obj_type_t *type) {
 }
 
 STATIC mp_obj_t stringio_make_new(const mp_obj_type_t *type_in, size_t n_args, size_t n_kw, const mp_obj_t *args) {
-    (void)n_kw; // TODO check n_kw==0
-
     mp_uint_t sz = 16;
+    mp_uint_t capacity = 0;
     bool initdata = false;
     mp_buffer_info_t bufinfo;
 
+    // capacity=N allocates room for N bytes up front, any initial data are copied into it
+    if (n_kw > 0) {
+        if (n_kw > 1 || args[n_args] != MP_OBJ_NEW_QSTR(MP_QSTR_capacity)) {
+            mp_raise_TypeError("unexpected keyword argument");
+        }
+        mp_int_t cap = mp_obj_get_int(args[n_args + 1]);
+        if (cap < 0) {
+            mp_raise_ValueError("negative capacity");
+        }
+        capacity = cap;
+    }
+
     mp_obj_stringio_t *o = stringio_new(type_in);
 
     if (n_args > 0) {
         if (mp_obj_is_int(args[0])) {
-            sz = mp_obj_get_int(args[0]);
+            mp_int_t n = mp_obj_get_int(args[0]);
+            if (n < 0) {
+                mp_raise_ValueError("negative size");
+            }
+            sz = n;
         } else {
             mp_get_buffer_raise(args[0], &bufinfo, MP_BUFFER_READ);
 
-            if (mp_obj_is_str_or_bytes(args[0])) {
+            if (mp_obj_is_str_or_bytes(args[0]) && capacity == 0) {
                 o->vstr = m_new_obj(vstr_t);
                 vstr_init_fixed_buf(o->vstr, bufinfo.len, bufinfo.buf);
                 o->vstr->len = bufinfo.len;
@@ -212,7 +252,7 @@ STATIC mp_obj_t stringio_make_new(const mp_obj_type_t *type_in, size_t n_args, s
         }
     }
 
-    o->vstr = vstr_new(sz);
+    o->vstr = vstr_new(MAX(sz, capacity));
 
     if (initdata) {
         stringio_write(MP_OBJ_FROM_PTR(o), bufinfo.buf, bufinfo.len, NULL);
@@ -256,6 +296,24 @@ const mp_obj_type_t mp_type_stringio = {
 };
 
 #if MICROPY_PY_IO_BYTESIO
+STATIC const mp_rom_map_elem_t bytesio_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&mp_stream_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readline), MP_ROM_PTR(&mp_stream_unbuffered_readline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_seek), MP_ROM_PTR(&mp_stream_seek_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&mp_stream_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR_getvalue), MP_ROM_PTR(&stringio_getvalue_obj) },
+    #if MICROPY_PY_BUILTINS_MEMORYVIEW
+    { MP_ROM_QSTR(MP_QSTR_getbuffer), MP_ROM_PTR(&bytesio_getbuffer_obj) },
+    #endif
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&mp_identity_obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&stringio___exit___obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(bytesio_locals_dict, bytesio_locals_dict_table);
+
 STATIC const mp_stream_p_t bytesio_stream_p = {
     .read = stringio_read,
     .write = stringio_write,
@@ -270,7 +328,7 @@ const mp_obj_type_t mp_type_bytesio = {
     .getiter = mp_identity_getiter,
     .iternext = mp_stream_unbuffered_iter,
     .protocol = &bytesio_stream_p,
-    .locals_dict = (mp_obj_dict_t*)&stringio_locals_dict,
+    .locals_dict = (mp_obj_dict_t*)&bytesio_locals_dict,
 };
 #endif
 
@@ -237,7 +237,7 @@ typedef struct _parser_t {
     mp_parse_chunk_t *cur_chunk;
 
     #if MICROPY_COMP_CONST
-    mp_map_t consts;
+    mp_map_t *consts;
     #endif
 } parser_t;
 
@@ -476,7 +476,7 @@ STATIC void push_result_token(parser_t *parser, uint8_t rule_id) {
         // if name is a standalone identifier, look it up in the table of dynamic constants
         mp_map_elem_t *elem;
         if (rule_id == RULE_atom
-            && (elem = mp_map_lookup(&parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP)) != NULL) {
+            && (elem = mp_map_lookup(parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP)) != NULL) {
             if (mp_obj_is_small_int(elem->value)) {
                 pn = mp_parse_node_new_small_int_checked(parser, elem->value);
             } else {
@@ -710,7 +710,7 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
                 }
 
                 // store the value in the table of dynamic constants
-                mp_map_elem_t *elem = mp_map_lookup(&parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+                mp_map_elem_t *elem = mp_map_lookup(parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
                 assert(elem->value == MP_OBJ_NULL);
                 elem->value = value;
 
@@ -815,7 +815,9 @@ STATIC void push_result_rule(parser_t *parser, size_t src_line, uint8_t rule_id,
     push_result_node(parser, (mp_parse_node_t)pn);
 }
 
-mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
+// parses the input up to the end of top_level_rule, to the end of the input unless that
+// is RULE_stmt; consts holds the names bound with const() for the whole input
+STATIC mp_parse_tree_t parse_rule(mp_lexer_t *lex, mp_parse_input_kind_t input_kind, size_t top_level_rule, void *consts) {
 
     // initialise parser and allocate memory for its stacks
 
@@ -835,16 +837,11 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     parser.cur_chunk = NULL;
 
     #if MICROPY_COMP_CONST
-    mp_map_init(&parser.consts, 0);
+    parser.consts = consts;
+    #else
+    (void)consts;
     #endif
 
-    // work out the top-level rule to use, and push it on the stack
-    size_t top_level_rule;
-    switch (input_kind) {
-        case MP_PARSE_SINGLE_INPUT: top_level_rule = RULE_single_input; break;
-        case MP_PARSE_EVAL_INPUT: top_level_rule = RULE_eval_input; break;
-        default: top_level_rule = RULE_file_input;
-    }
     push_rule(&parser, lex->tok_line, top_level_rule, 0);
 
     // parse!
@@ -1105,10 +1102,6 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
         }
     }
 
-    #if MICROPY_COMP_CONST
-    mp_map_deinit(&parser.consts);
-    #endif
-
     // truncate final chunk and link into chain of chunks
     if (parser.cur_chunk != NULL) {
         (void)m_renew_maybe(byte, parser.cur_chunk,
@@ -1121,7 +1114,7 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     }
 
     if (
-        lex->tok_kind != MP_TOKEN_END // check we are at the end of the token stream
+        (top_level_rule != RULE_stmt && lex->tok_kind != MP_TOKEN_END) // check we are at the end of the token stream
         || parser.result_stack_top == 0 // check that we got a node (can fail on empty input)
         ) {
     syntax_error:;
@@ -1150,12 +1143,65 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     m_del(rule_stack_t, parser.rule_stack, parser.rule_stack_alloc);
     m_del(mp_parse_node_t, parser.result_stack, parser.result_stack_alloc);
 
+    return parser.tree;
+}
+
+mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
+    // work out the top-level rule to use
+    size_t top_level_rule;
+    switch (input_kind) {
+        case MP_PARSE_SINGLE_INPUT: top_level_rule = RULE_single_input; break;
+        case MP_PARSE_EVAL_INPUT: top_level_rule = RULE_eval_input; break;
+        default: top_level_rule = RULE_file_input;
+    }
+
+    #if MICROPY_COMP_CONST
+    mp_map_t consts;
+    mp_map_init(&consts, 0);
+    mp_parse_tree_t tree = parse_rule(lex, input_kind, top_level_rule, &consts);
+    mp_map_deinit(&consts);
+    #else
+    mp_parse_tree_t tree = parse_rule(lex, input_kind, top_level_rule, NULL);
+    #endif
+
     // we also free the lexer on behalf of the caller
     mp_lexer_free(lex);
 
-    return parser.tree;
+    return tree;
+}
+
+#if MICROPY_COMP_STREAM
+void mp_parse_stream_init(mp_parse_stream_t *ps, mp_lexer_t *lex) {
+    ps->lex = lex;
+    #if MICROPY_COMP_CONST
+    mp_map_init(&ps->consts, 0);
+    #endif
 }
 
+bool mp_parse_stream_next(mp_parse_stream_t *ps, mp_parse_tree_t *tree) {
+    // blank lines between statements make no nodes
+    while (ps->lex->tok_kind == MP_TOKEN_NEWLINE) {
+        mp_lexer_to_next(ps->lex);
+    }
+    if (ps->lex->tok_kind == MP_TOKEN_END) {
+        return false;
+    }
+    #if MICROPY_COMP_CONST
+    *tree = parse_rule(ps->lex, MP_PARSE_FILE_INPUT, RULE_stmt, &ps->consts);
+    #else
+    *tree = parse_rule(ps->lex, MP_PARSE_FILE_INPUT, RULE_stmt, NULL);
+    #endif
+    return true;
+}
+
+void mp_parse_stream_deinit(mp_parse_stream_t *ps) {
+    #if MICROPY_COMP_CONST
+    mp_map_deinit(&ps->consts);
+    #endif
+    mp_lexer_free(ps->lex);
+}
+#endif
+
 void mp_parse_tree_clear(mp_parse_tree_t *tree) {
     mp_parse_chunk_t *chunk = tree->chunk;
     while (chunk != NULL) {
@@ -104,4 +104,21 @@ typedef struct _mp_parse_t {
 mp_parse_tree_t mp_parse(struct _mp_lexer_t *lex, mp_parse_input_kind_t input_kind);
 void mp_parse_tree_clear(mp_parse_tree_t *tree);
 
+#if MICROPY_COMP_STREAM
+// file input parsed one top-level statement at a time, so that each can be compiled and
+// its parse tree freed before the next is parsed; const() names hold across statements
+typedef struct _mp_parse_stream_t {
+    struct _mp_lexer_t *lex;
+    #if MICROPY_COMP_CONST
+    mp_map_t consts;
+    #endif
+} mp_parse_stream_t;
+
+void mp_parse_stream_init(mp_parse_stream_t *ps, struct _mp_lexer_t *lex);
+// parses the next statement into tree, returns false at the end of the input
+bool mp_parse_stream_next(mp_parse_stream_t *ps, mp_parse_tree_t *tree);
+// frees the lexer
+void mp_parse_stream_deinit(mp_parse_stream_t *ps);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_PARSE_H
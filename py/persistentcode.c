@@ -541,6 +541,9 @@ mp_raw_code_t *mp_raw_code_load(mp_reader_t *reader) {
         || read_uint(reader, NULL) > QSTR_WINDOW_SIZE) {
         mp_raise_ValueError("incompatible .mpy file");
     }
+    if ((header[2] & MPY_FEATURE_SUPERINSTR) && !MICROPY_OPT_SUPERINSTRUCTIONS) {
+        mp_raise_ValueError("incompatible .mpy file");
+    }
     if (MPY_FEATURE_DECODE_ARCH(header[2]) != MP_NATIVE_ARCH_NONE) {
         byte arch = MPY_FEATURE_DECODE_ARCH(header[2]);
         if (!MPY_FEATURE_ARCH_TEST(arch)) {
@@ -570,6 +573,224 @@ mp_raw_code_t *mp_raw_code_load_file(const char *filename) {
 
 #endif // MICROPY_HAS_FILE_READER
 
+#if MICROPY_MODULE_FROZEN_XIP
+
+#define XIP_IMAGE ((const mp_xip_image_t*)MP_STATE_VM(xip_image))
+
+// djb2 of the hashes of qstrs 1 to n - 1, as mpy-tool.py computes it for the
+// firmware it links against: the image's qstr numbers are only right if equal
+STATIC uint32_t xip_base_hash(size_t n) {
+    uint32_t hash = 5381;
+    for (qstr q = 1; q < n; q++) {
+        hash = (hash * 33) ^ qstr_hash(q);
+    }
+    return hash;
+}
+
+// CRC-32 as zlib.crc32() computes it, a nibble at a time as uzlib does
+STATIC uint32_t xip_crc32(const byte *data, size_t len) {
+    static const uint32_t tab[16] = {
+        0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190,
+        0x6b6b51f4, 0x4db26158, 0x5005713c, 0xedb88320, 0xf00f9344,
+        0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278,
+        0xbdbdf21c
+    };
+    uint32_t crc = 0xffffffff;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        crc = tab[crc & 0x0f] ^ (crc >> 4);
+        crc = tab[crc & 0x0f] ^ (crc >> 4);
+    }
+    return crc ^ 0xffffffff;
+}
+
+// Whether the n bytes at offset are all within the len bytes of the image
+STATIC bool xip_in_image(uint32_t offset, size_t n, uint32_t len) {
+    return offset <= len && n <= len - offset;
+}
+
+// Whether a raw code record, its bytecode, constants and children are all in
+// the image and its argument names are qstrs the firmware or the image has
+STATIC bool xip_check_raw_code(const byte *base, uint32_t len, uint32_t offset, size_t n_qstr) {
+    if ((offset & 3) != 0 || !xip_in_image(offset, sizeof(mp_xip_raw_code_t), len)) {
+        return false;
+    }
+    const mp_xip_raw_code_t *xrc = (const mp_xip_raw_code_t*)(base + offset);
+    if (!xip_in_image(offset + sizeof(mp_xip_raw_code_t),
+            xrc->n_raw_code * sizeof(uint32_t) + xrc->n_arg * sizeof(uint16_t), len)
+        || !xip_in_image(xrc->fun_data, xrc->fun_data_len, len)
+        || xrc->fun_data_len == 0
+        || xrc->objs > len) {
+        return false;
+    }
+    const uint16_t *args = (const uint16_t*)&xrc->children[xrc->n_raw_code];
+    for (size_t i = 0; i < xrc->n_arg; ++i) {
+        if (args[i] == MP_QSTRnull || args[i] >= n_qstr) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < xrc->n_raw_code; ++i) {
+        // children are written before their parent, which also rules out loops
+        if (xrc->children[i] >= offset || !xip_check_raw_code(base, len, xrc->children[i], n_qstr)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns why the image can't be used with this firmware, or NULL if it can
+STATIC const char *xip_check(const mp_xip_image_t *image, uint32_t len) {
+    const byte *base = (const byte*)image;
+    if (len < sizeof(mp_xip_image_t) || memcmp(image->magic, "XMPY", 4) != 0) {
+        return "not an .xmpy image";
+    }
+    if (image->len < sizeof(mp_xip_image_t) || image->len > len) {
+        return "truncated";
+    }
+    len = image->len;
+    if (image->crc != xip_crc32(base + offsetof(mp_xip_image_t, base_len), len - offsetof(mp_xip_image_t, base_len))) {
+        return "bad CRC";
+    }
+    if (image->header[0] != MPY_VERSION
+        || MPY_FEATURE_DECODE_FLAGS(image->header[1]) != MPY_FEATURE_FLAGS
+        || MPY_FEATURE_DECODE_ARCH(image->header[1]) != MP_NATIVE_ARCH_NONE
+        || ((image->header[1] & MPY_FEATURE_SUPERINSTR) && !MICROPY_OPT_SUPERINSTRUCTIONS)
+        || image->header[2] > mp_small_int_bits()
+        || image->header[3] != (MICROPY_QSTR_BYTES_IN_HASH | MICROPY_QSTR_BYTES_IN_LEN << 4)
+        || image->base_len != QSTR_TOTAL()
+        || image->base_hash != xip_base_hash(image->base_len)) {
+        return "made for another firmware";
+    }
+
+    size_t n_offsets = (len - sizeof(mp_xip_image_t)) / sizeof(uint32_t);
+    if (image->n_qstr > n_offsets || image->n_module > n_offsets - image->n_qstr
+        || image->base_len + image->n_qstr > 0x10000) {
+        return "bad header";
+    }
+
+    // each qstr is its hash and length, then its data and a \0, all in the image
+    for (size_t i = 0; i < image->n_qstr; ++i) {
+        uint32_t offset = image->offsets[i];
+        if (!xip_in_image(offset, MICROPY_QSTR_BYTES_IN_HASH + MICROPY_QSTR_BYTES_IN_LEN, len)) {
+            return "bad qstr offset";
+        }
+        const byte *q = base + offset + MICROPY_QSTR_BYTES_IN_HASH;
+        size_t q_len = q[0];
+        #if MICROPY_QSTR_BYTES_IN_LEN == 2
+        q_len |= q[1] << 8;
+        #endif
+        offset += MICROPY_QSTR_BYTES_IN_HASH + MICROPY_QSTR_BYTES_IN_LEN;
+        if (!xip_in_image(offset, q_len + 1, len) || base[offset + q_len] != 0) {
+            return "bad qstr offset";
+        }
+    }
+
+    // one module name per raw code, ended by an empty name
+    if (image->names >= len) {
+        return "bad names offset";
+    }
+    const char *name = (const char*)base + image->names;
+    const char *end = (const char*)base + len;
+    for (size_t i = 0;; ++i) {
+        const char *nul = memchr(name, 0, end - name);
+        if (nul == NULL) {
+            return "bad names offset";
+        }
+        if (nul == name) {
+            if (i != image->n_module) {
+                return "bad names offset";
+            }
+            break;
+        }
+        name = nul + 1;
+    }
+
+    for (size_t i = 0; i < image->n_module; ++i) {
+        if (!xip_check_raw_code(base, len, image->offsets[image->n_qstr + i], image->base_len + image->n_qstr)) {
+            return "bad raw code offset";
+        }
+    }
+    return NULL;
+}
+
+void mp_raw_code_xip_init(void) {
+    MP_STATE_VM(xip_image) = NULL;
+    uint32_t len = 0;
+    const mp_xip_image_t *image = (const mp_xip_image_t*)MICROPY_MODULE_FROZEN_XIP_IMAGE(&len);
+    if (image == NULL) {
+        return;
+    }
+    const char *error = xip_check(image, len);
+    if (error == NULL && image->n_qstr != 0 && !qstr_link_pool((const byte*)image, image->offsets, image->n_qstr)) {
+        error = "no memory for its qstrs";
+    }
+    if (error != NULL) {
+        // its modules aren't found, so ones on the filesystem are imported instead
+        mp_printf(MICROPY_ERROR_PRINTER, "xmpy image not used: %s\n", error);
+        return;
+    }
+    MP_STATE_VM(xip_image) = image;
+    MP_STATE_VM(xip_image_len) = image->len;
+}
+
+const char *mp_raw_code_xip_names(void) {
+    if (XIP_IMAGE == NULL) {
+        return "";
+    }
+    return (const char*)XIP_IMAGE + XIP_IMAGE->names;
+}
+
+// The bytecode stays in the image, only the raw code and its constant table are
+// made in RAM (const objects, argument names and children, as load_raw_code does)
+STATIC mp_raw_code_t *load_raw_code_xip(uint32_t offset) {
+    const byte *base = (const byte*)XIP_IMAGE;
+    const mp_xip_raw_code_t *xrc = (const mp_xip_raw_code_t*)(base + offset);
+    const uint16_t *args = (const uint16_t*)&xrc->children[xrc->n_raw_code];
+
+    mp_uint_t *const_table = m_new(mp_uint_t, xrc->n_arg + xrc->n_obj + xrc->n_raw_code);
+    mp_uint_t *ct = const_table;
+    for (size_t i = 0; i < xrc->n_arg; ++i) {
+        *ct++ = (mp_uint_t)MP_OBJ_NEW_QSTR(args[i]);
+    }
+    if (xrc->n_obj != 0) {
+        mp_reader_t reader;
+        mp_reader_new_mem(&reader, base + xrc->objs, MP_STATE_VM(xip_image_len) - xrc->objs, 0);
+        for (size_t i = 0; i < xrc->n_obj; ++i) {
+            *ct++ = (mp_uint_t)load_obj(&reader);
+        }
+        reader.close(reader.data);
+    }
+    for (size_t i = 0; i < xrc->n_raw_code; ++i) {
+        *ct++ = (mp_uint_t)(uintptr_t)load_raw_code_xip(xrc->children[i]);
+    }
+
+    mp_raw_code_t *rc = mp_emit_glue_new_raw_code();
+    mp_emit_glue_assign_bytecode(rc, base + xrc->fun_data,
+        #if MICROPY_PERSISTENT_CODE_SAVE || MICROPY_DEBUG_PRINTERS
+        xrc->fun_data_len,
+        #endif
+        const_table,
+        #if MICROPY_PERSISTENT_CODE_SAVE
+        xrc->n_obj, xrc->n_raw_code,
+        #endif
+        xrc->scope_flags);
+    return rc;
+}
+
+mp_raw_code_t *mp_raw_code_xip_find(const char *str, size_t len) {
+    const char *name = mp_raw_code_xip_names();
+    for (size_t i = 0; *name != 0; i++) {
+        size_t l = strlen(name);
+        if (l == len && !memcmp(str, name, l)) {
+            return load_raw_code_xip(XIP_IMAGE->offsets[XIP_IMAGE->n_qstr + i]);
+        }
+        name += l + 1;
+    }
+    return NULL;
+}
+
+#endif // MICROPY_MODULE_FROZEN_XIP
+
 #endif // MICROPY_PERSISTENT_CODE_LOAD
 
 #if MICROPY_PERSISTENT_CODE_SAVE
@@ -801,6 +1022,9 @@ void mp_raw_code_save(mp_raw_code_t *rc, mp_print_t *print) {
     if (mp_raw_code_has_native(rc)) {
         header[2] |= MPY_FEATURE_ENCODE_ARCH(MPY_FEATURE_ARCH_DYNAMIC);
     }
+    if (MICROPY_OPT_SUPERINSTRUCTIONS_DYNAMIC) {
+        header[2] |= MPY_FEATURE_SUPERINSTR;
+    }
     mp_print_bytes(print, header, sizeof(header));
     mp_print_uint(print, QSTR_WINDOW_SIZE);
 
@@ -39,7 +39,11 @@
 
 // Macros to encode/decode native architecture to/from the feature byte
 #define MPY_FEATURE_ENCODE_ARCH(arch) ((arch) << 2)
-#define MPY_FEATURE_DECODE_ARCH(feat) ((feat) >> 2)
+#define MPY_FEATURE_DECODE_ARCH(feat) (((feat) >> 2) & 0xf)
+
+// Feature byte bit set when the bytecode uses superinstructions, only a VM
+// with MICROPY_OPT_SUPERINSTRUCTIONS can run it (it can run either kind)
+#define MPY_FEATURE_SUPERINSTR (0x40)
 
 // The feature flag bits encode the compile-time config options that
 // affect the generate bytecode.
@@ -107,6 +111,47 @@ mp_raw_code_t *mp_raw_code_load(mp_reader_t *reader);
 mp_raw_code_t *mp_raw_code_load_mem(const byte *buf, size_t len);
 mp_raw_code_t *mp_raw_code_load_file(const char *filename);
 
+#if MICROPY_MODULE_FROZEN_XIP
+
+#if !MICROPY_PERSISTENT_CODE_LOAD
+#error MICROPY_MODULE_FROZEN_XIP needs MICROPY_PERSISTENT_CODE_LOAD
+#endif
+
+// A .xmpy image: .mpy files linked by tools/mpy-tool.py --xip against the qstrs
+// of one firmware build, so their bytecode runs where the image is.  Offsets are
+// from the start of the image, records are 4 byte aligned.  An image that is cut
+// short, corrupt or has an offset outside of it is rejected at init.
+typedef struct _mp_xip_image_t {
+    byte magic[4];              // "XMPY"
+    byte header[4];             // .mpy version, feature byte, small int bits, qstr hash | len << 4 bytes
+    uint32_t len;               // of the whole image
+    uint32_t crc;               // CRC-32 (as zlib.crc32) of the image after this field
+    uint32_t base_len;          // qstrs of the firmware, the image's are numbered on from here
+    uint32_t base_hash;         // of the hashes of those qstrs, see xip_base_hash()
+    uint32_t n_qstr;
+    uint32_t n_module;
+    uint32_t names;             // module names, in the form of mp_frozen_mpy_names
+    uint32_t offsets[];         // the n_qstr qstrs (hash, len, data, \0), then the n_module raw codes
+} mp_xip_image_t;
+
+typedef struct _mp_xip_raw_code_t {
+    uint32_t fun_data;          // bytecode with its qstrs linked
+    uint32_t fun_data_len;
+    uint32_t objs;              // the n_obj constant objects, encoded as in .mpy
+    uint16_t n_obj;
+    uint16_t n_raw_code;
+    uint16_t n_arg;
+    uint16_t scope_flags;
+    uint32_t children[];        // the n_raw_code child raw codes, then n_arg qstrs as uint16_t
+} mp_xip_raw_code_t;
+
+// Checks the port's image against this firmware and links its qstrs, after qstr_init()
+void mp_raw_code_xip_init(void);
+const char *mp_raw_code_xip_names(void);
+mp_raw_code_t *mp_raw_code_xip_find(const char *str, size_t len);
+
+#endif
+
 void mp_raw_code_save(mp_raw_code_t *rc, mp_print_t *print);
 void mp_raw_code_save_file(mp_raw_code_t *rc, const char *filename);
 
@@ -121,15 +121,129 @@ extern const qstr_pool_t MICROPY_QSTR_EXTRA_POOL;
 #define CONST_POOL mp_qstr_const_pool
 #endif
 
+#if MICROPY_QSTR_HASH_INDEX
+
+#if MICROPY_QSTR_BYTES_IN_HASH < 2
+#error MICROPY_QSTR_HASH_INDEX needs MICROPY_QSTR_BYTES_IN_HASH >= 2
+#endif
+
+// Both indexes are open addressed tables of a power of 2 size, a qstr goes in
+// the first free slot from its hash & (size - 1) on, and 0 ends a probe.
+
+// Index of mp_qstr_const_pool generated by makeqstrdata.py, the last entry is
+// padding.  It's only trusted if it holds every qstr in the pool, so a header
+// from an older makeqstrdata.py just falls back to the pool scan.
+STATIC const uint16_t qstr_rom_index[] = {
+#ifndef NO_QSTR
+#define QDEF(id, str)
+#define QINDEX(id) id,
+#define QINDEX_END(n)
+#include "genhdr/qstrdefs.generated.h"
+#undef QINDEX_END
+#undef QINDEX
+#undef QDEF
+#endif
+    0
+};
+
+STATIC const size_t qstr_rom_index_len = 0
+#ifndef NO_QSTR
+#define QDEF(id, str)
+#define QINDEX(id)
+#define QINDEX_END(n) + n
+#include "genhdr/qstrdefs.generated.h"
+#undef QINDEX_END
+#undef QINDEX
+#undef QDEF
+#endif
+    ;
+
+#define QSTR_ROM_INDEX_SIZE (MP_ARRAY_SIZE(qstr_rom_index) - 1)
+#define QSTR_ROM_INDEX_VALID (qstr_rom_index_len == MP_QSTRnumber_of - 1 \
+    && QSTR_ROM_INDEX_SIZE != 0 && (QSTR_ROM_INDEX_SIZE & (QSTR_ROM_INDEX_SIZE - 1)) == 0)
+
+// Up to this load the heap index is kept, past it it's rebuilt twice as big.
+#define QSTR_INDEX_INIT (64)
+
+STATIC inline bool qstr_match(const byte *q, mp_uint_t hash, const char *str, size_t len) {
+    return Q_GET_HASH(q) == hash && Q_GET_LENGTH(q) == len && memcmp(Q_GET_DATA(q), str, len) == 0;
+}
+
+STATIC void qstr_index_insert(qstr *index, size_t alloc, const byte *q_ptr, qstr q) {
+    size_t i = Q_GET_HASH(q_ptr) & (alloc - 1);
+    while (index[i] != 0) {
+        i = (i + 1) & (alloc - 1);
+    }
+    index[i] = q;
+}
+
+// qstr_mutex must be taken while in this function
+STATIC void qstr_index_add(const byte *q_ptr, qstr q) {
+    if (MP_STATE_VM(qstr_index) == NULL || 2 * (MP_STATE_VM(qstr_index_len) + 1) > MP_STATE_VM(qstr_index_alloc)) {
+        // (re)build it from the pools, the old one is left to the GC in case a lookup is still using it
+        size_t len = MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len - MP_QSTRnumber_of;
+        size_t alloc = MAX(QSTR_INDEX_INIT, MP_STATE_VM(qstr_index_alloc));
+        while (2 * len > alloc) {
+            alloc *= 2;
+        }
+        qstr *index = m_new_maybe(qstr, alloc);
+        MP_STATE_VM(qstr_index) = NULL;
+        if (index == NULL) {
+            // pool scans until the next qstr_add manages it
+            return;
+        }
+        memset(index, 0, alloc * sizeof(qstr));
+        for (qstr_pool_t *pool = MP_STATE_VM(last_pool); pool->total_prev_len + pool->len > MP_QSTRnumber_of; pool = pool->prev) {
+            for (size_t i = 0; i < pool->len; i++) {
+                qstr_index_insert(index, alloc, pool->qstrs[i], pool->total_prev_len + i);
+            }
+        }
+        MP_STATE_VM(qstr_index_alloc) = alloc;
+        MP_STATE_VM(qstr_index_len) = len;
+        MP_STATE_VM(qstr_index) = index;
+    } else {
+        qstr_index_insert(MP_STATE_VM(qstr_index), MP_STATE_VM(qstr_index_alloc), q_ptr, q);
+        MP_STATE_VM(qstr_index_len) += 1;
+    }
+}
+
+#endif // MICROPY_QSTR_HASH_INDEX
+
 void qstr_init(void) {
     MP_STATE_VM(last_pool) = (qstr_pool_t*)&CONST_POOL; // we won't modify the const_pool since it has no allocated room left
     MP_STATE_VM(qstr_last_chunk) = NULL;
+    #if MICROPY_QSTR_HASH_INDEX
+    MP_STATE_VM(qstr_index) = NULL;
+    MP_STATE_VM(qstr_index_alloc) = 0;
+    MP_STATE_VM(qstr_index_len) = 0;
+    #endif
 
     #if MICROPY_PY_THREAD
     mp_thread_mutex_init(&MP_STATE_VM(qstr_mutex));
     #endif
 }
 
+#if MICROPY_MODULE_FROZEN_XIP
+// Appends a pool of the n qstrs at base + offsets[i], numbered on from QSTR_TOTAL(),
+// their data stays where it is.  Only before any qstr is made at runtime.
+bool qstr_link_pool(const byte *base, const uint32_t *offsets, size_t n) {
+    qstr_pool_t *pool = m_new_obj_var_maybe(qstr_pool_t, const char*, n);
+    if (pool == NULL) {
+        return false;
+    }
+    pool->prev = MP_STATE_VM(last_pool);
+    pool->total_prev_len = QSTR_TOTAL();
+    // full, the first qstr_add() starts a pool sized from this
+    pool->alloc = MIN(n, MICROPY_ALLOC_QSTR_ENTRIES_INIT);
+    pool->len = n;
+    for (size_t i = 0; i < n; i++) {
+        pool->qstrs[i] = base + offsets[i];
+    }
+    MP_STATE_VM(last_pool) = pool;
+    return true;
+}
+#endif
+
 STATIC const byte *find_qstr(qstr q) {
     // search pool for this qstr
     // total_prev_len==0 in the final pool, so the loop will always terminate
@@ -166,17 +280,50 @@ STATIC qstr qstr_add(const byte *q_ptr) {
 
     // add the new qstr
     MP_STATE_VM(last_pool)->qstrs[MP_STATE_VM(last_pool)->len++] = q_ptr;
+    qstr q = MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len - 1;
+
+    #if MICROPY_QSTR_HASH_INDEX
+    qstr_index_add(q_ptr, q);
+    #endif
 
     // return id for the newly-added qstr
-    return MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len - 1;
+    return q;
 }
 
 qstr qstr_find_strn(const char *str, size_t str_len) {
     // work out hash of str
     mp_uint_t str_hash = qstr_compute_hash((const byte*)str, str_len);
 
+    #if MICROPY_QSTR_HASH_INDEX
+    qstr *index = MP_STATE_VM(qstr_index);
+    if (index != NULL) {
+        size_t mask = MP_STATE_VM(qstr_index_alloc) - 1;
+        for (size_t i = str_hash & mask; index[i] != 0; i = (i + 1) & mask) {
+            if (qstr_match(find_qstr(index[i]), str_hash, str, str_len)) {
+                return index[i];
+            }
+        }
+    }
+    if (QSTR_ROM_INDEX_VALID) {
+        const size_t mask = QSTR_ROM_INDEX_SIZE - 1;
+        for (size_t i = str_hash & mask; qstr_rom_index[i] != 0; i = (i + 1) & mask) {
+            if (qstr_match(mp_qstr_const_pool.qstrs[qstr_rom_index[i]], str_hash, str, str_len)) {
+                return qstr_rom_index[i];
+            }
+        }
+        if (index != NULL) {
+            return 0;
+        }
+    }
+    #endif
+
     // search pools for the data
     for (qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
+        #if MICROPY_QSTR_HASH_INDEX
+        if (pool == &mp_qstr_const_pool && QSTR_ROM_INDEX_VALID) {
+            break;
+        }
+        #endif
         for (const byte **q = pool->qstrs, **q_top = pool->qstrs + pool->len; q < q_top; q++) {
             if (Q_GET_HASH(*q) == str_hash && Q_GET_LENGTH(*q) == str_len && memcmp(Q_GET_DATA(*q), str, str_len) == 0) {
                 return pool->total_prev_len + (q - pool->qstrs);
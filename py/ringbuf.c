@@ -23,6 +23,8 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <string.h>
+
 #include "ringbuf.h"
 
 int ringbuf_get16(ringbuf_t *r) {
@@ -71,3 +73,70 @@ int ringbuf_put16(ringbuf_t *r, uint16_t v) {
     r->iput = iput_b;
     return 0;
 }
+
+size_t ringbuf_put_span(ringbuf_t *r, uint8_t **ptr) {
+    uint32_t iget = r->iget;
+    uint32_t iput = r->iput;
+    *ptr = r->buf + iput;
+    if (iput < iget) {
+        return iget - iput - 1;
+    }
+    // one slot stays empty, at the end of the buffer if the consumer is at the start
+    return r->size - iput - (iget == 0);
+}
+
+void ringbuf_put_commit(ringbuf_t *r, size_t len) {
+    uint32_t iput = r->iput + len;
+    MICROPY_RINGBUF_BARRIER();
+    r->iput = (iput == r->size) ? 0 : iput;
+}
+
+size_t ringbuf_get_span(ringbuf_t *r, uint8_t **ptr) {
+    uint32_t iput = r->iput;
+    uint32_t iget = r->iget;
+    MICROPY_RINGBUF_BARRIER();
+    *ptr = r->buf + iget;
+    return (iget <= iput) ? iput - iget : r->size - iget;
+}
+
+void ringbuf_get_commit(ringbuf_t *r, size_t len) {
+    uint32_t iget = r->iget + len;
+    MICROPY_RINGBUF_BARRIER();
+    r->iget = (iget == r->size) ? 0 : iget;
+}
+
+size_t ringbuf_put_n(ringbuf_t *r, const uint8_t *data, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        uint8_t *span;
+        size_t n = ringbuf_put_span(r, &span);
+        if (n == 0) {
+            break;
+        }
+        if (n > len - done) {
+            n = len - done;
+        }
+        memcpy(span, data + done, n);
+        ringbuf_put_commit(r, n);
+        done += n;
+    }
+    return done;
+}
+
+size_t ringbuf_get_n(ringbuf_t *r, uint8_t *data, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        uint8_t *span;
+        size_t n = ringbuf_get_span(r, &span);
+        if (n == 0) {
+            break;
+        }
+        if (n > len - done) {
+            n = len - done;
+        }
+        memcpy(data + done, span, n);
+        ringbuf_get_commit(r, n);
+        done += n;
+    }
+    return done;
+}
@@ -29,13 +29,21 @@
 #include <stddef.h>
 #include <stdint.h>
 
+// One producer and one consumer (e.g. an IRQ and the code it interrupts) may use a ring
+// without locking: each only writes its own index, and publishes it after the data it covers.
 typedef struct _ringbuf_t {
     uint8_t *buf;
     uint16_t size;
-    uint16_t iget;
-    uint16_t iput;
+    volatile uint16_t iget;
+    volatile uint16_t iput;
 } ringbuf_t;
 
+#ifndef MICROPY_RINGBUF_BARRIER
+// Orders the data against the index published after it; a compiler barrier is enough
+// between an IRQ and the code it interrupts on the same core.
+#define MICROPY_RINGBUF_BARRIER() __asm volatile ("" : : : "memory")
+#endif
+
 // Static initialization:
 // byte buf_array[N];
 // ringbuf_t buf = {buf_array, sizeof(buf_array)};
@@ -85,4 +93,15 @@ int ringbuf_get16(ringbuf_t *r);
 int ringbuf_peek16(ringbuf_t *r);
 int ringbuf_put16(ringbuf_t *r, uint16_t v);
 
+// The contiguous free (put) or filled (get) span at the index, to be filled or read in place
+// (by DMA, say) and then handed over with the commit of the bytes actually used.
+size_t ringbuf_put_span(ringbuf_t *r, uint8_t **ptr);
+void ringbuf_put_commit(ringbuf_t *r, size_t len);
+size_t ringbuf_get_span(ringbuf_t *r, uint8_t **ptr);
+void ringbuf_get_commit(ringbuf_t *r, size_t len);
+
+// Copy up to len bytes in or out, at most two memcpy's each. Return the number copied.
+size_t ringbuf_put_n(ringbuf_t *r, const uint8_t *data, size_t len);
+size_t ringbuf_get_n(ringbuf_t *r, uint8_t *data, size_t len);
+
 #endif // MICROPY_INCLUDED_PY_RINGBUF_H
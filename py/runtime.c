@@ -41,6 +41,8 @@
 #include "py/builtin.h"
 #include "py/stackctrl.h"
 #include "py/gc.h"
+#include "py/frozenmod.h"
+#include "py/persistentcode.h"
 
 #if MICROPY_DEBUG_VERBOSE // print debugging info
 #define DEBUG_PRINT (1)
@@ -59,18 +61,33 @@ const mp_obj_module_t mp_module___main__ = {
 void mp_init(void) {
     qstr_init();
 
+    #if MICROPY_MODULE_FROZEN_XIP
+    // its qstrs come right after the firmware's
+    mp_raw_code_xip_init();
+    #endif
+
     // no pending exceptions to start with
     MP_STATE_VM(mp_pending_exception) = MP_OBJ_NULL;
     #if MICROPY_ENABLE_SCHEDULER
     MP_STATE_VM(sched_state) = MP_SCHED_IDLE;
-    MP_STATE_VM(sched_idx) = 0;
     MP_STATE_VM(sched_len) = 0;
+    MP_STATE_VM(sched_urgent) = 0;
+    memset(MP_STATE_VM(sched_level_len), 0, sizeof(MP_STATE_VM(sched_level_len)));
+    memset(MP_STATE_VM(sched_idx), 0, sizeof(MP_STATE_VM(sched_idx)));
+    #if MICROPY_SCHEDULER_STATS
+    memset(MP_STATE_VM(sched_stats), 0, sizeof(MP_STATE_VM(sched_stats)));
+    #endif
     #endif
 
 #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
     mp_init_emergency_exception_buf();
 #endif
 
+    #if MICROPY_MODULE_FROZEN_GLOBALS
+    // heap copies of frozen module globals don't survive a soft reset
+    mp_frozen_globals_reset();
+    #endif
+
     #if MICROPY_KBD_EXCEPTION
     // initialise the exception object for raising KeyboardInterrupt
     MP_STATE_VM(mp_kbd_exception).base.type = &mp_type_KeyboardInterrupt;
@@ -80,6 +97,10 @@ void mp_init(void) {
     MP_STATE_VM(mp_kbd_exception).args = (mp_obj_tuple_t*)&mp_const_empty_tuple_obj;
     #endif
 
+    #if MICROPY_PREALLOC_EXCEPTIONS
+    mp_obj_exception_prealloc_init();
+    #endif
+
     // call port specific initialization if any
 #ifdef MICROPY_PORT_INIT_FUNC
     MICROPY_PORT_INIT_FUNC;
@@ -115,6 +136,11 @@ void mp_init(void) {
     }
     #endif
 
+    #if MICROPY_PY_URE_CACHE
+    // compiled patterns were on the previous heap
+    memset(MP_STATE_VM(ure_cache), 0, sizeof(MP_STATE_VM(ure_cache)));
+    #endif
+
     #if MICROPY_VFS
     // initialise the VFS sub-system
     MP_STATE_VM(vfs_cur) = NULL;
@@ -125,9 +151,16 @@ void mp_init(void) {
     MP_STATE_VM(sys_exitfunc) = mp_const_none;
     #endif
 
+    #if MICROPY_PY_MICROPYTHON_POOL
+    // pools of the last run are gone with its heap
+    MP_STATE_VM(pool_arena_used) = 0;
+    #endif
+
     #if MICROPY_PY_SYS_SETTRACE
     MP_STATE_THREAD(prof_trace_callback) = MP_OBJ_NULL;
     MP_STATE_THREAD(prof_callback_is_executing) = false;
+    #endif
+    #if MICROPY_TRACK_CODE_STATE
     MP_STATE_THREAD(current_code_state) = NULL;
     #endif
 
@@ -1237,6 +1270,9 @@ mp_obj_t mp_iternext(mp_obj_t o_in) {
                 return ret;
             } else {
                 if (mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(((mp_obj_base_t*)nlr.ret_val)->type), MP_OBJ_FROM_PTR(&mp_type_StopIteration))) {
+                    #if MICROPY_PREALLOC_EXCEPTIONS
+                    mp_obj_exception_prealloc_release(MP_OBJ_FROM_PTR(nlr.ret_val));
+                    #endif
                     return MP_OBJ_STOP_ITERATION;
                 } else {
                     nlr_jump(nlr.ret_val);
@@ -1337,6 +1373,12 @@ mp_obj_t mp_make_raise_obj(mp_obj_t o) {
         // create and return a new exception instance by calling o
         // TODO could have an option to disable traceback, then builtin exceptions (eg TypeError)
         // could have const instances in ROM which we return here instead
+        #if MICROPY_PREALLOC_EXCEPTIONS
+        if (o == MP_OBJ_FROM_PTR(&mp_type_StopIteration)) {
+            // the bare class, as raised by iterators, can use the preallocated instance
+            return mp_obj_new_exception(&mp_type_StopIteration);
+        }
+        #endif
         return mp_call_function_n_kw(o, 0, 0, NULL);
     } else if (mp_obj_is_exception_instance(o)) {
         // o is an instance of an exception, so use it as the exception
@@ -72,6 +72,26 @@ void mp_sched_lock(void);
 void mp_sched_unlock(void);
 static inline unsigned int mp_sched_num_pending(void) { return MP_STATE_VM(sched_len); }
 bool mp_sched_schedule(mp_obj_t function, mp_obj_t arg);
+// prio is clamped to MICROPY_SCHEDULER_PRIORITIES - 1
+bool mp_sched_schedule_prio(mp_obj_t function, mp_obj_t arg, unsigned int prio);
+
+#if MICROPY_SCHEDULER_PRIORITIES > 1 && !MICROPY_PY_THREAD
+// Long running C code calls this now and then to run the callbacks pending at
+// MICROPY_SCHEDULER_CHECK_IN_PRIORITY and above; the others, and pending exceptions, wait
+// for the VM. With threads the code drops the GIL instead and the VM runs them elsewhere.
+void mp_sched_check_in_tail(void);
+static inline void mp_sched_check_in(void) {
+    if (MP_STATE_VM(sched_urgent)) {
+        mp_sched_check_in_tail();
+    }
+}
+#else
+static inline void mp_sched_check_in(void) {
+}
+#endif
+#else
+static inline void mp_sched_check_in(void) {
+}
 #endif
 
 // extra printing method specifically for mp_obj_t's which are integral type
@@ -27,16 +27,19 @@
 #include <stdio.h>
 
 #include "py/runtime.h"
+#if MICROPY_SCHEDULER_STATS
+#include "py/mphal.h"
+#endif
 
 #if MICROPY_ENABLE_SCHEDULER
 
 #define IDX_MASK(i) ((i) & (MICROPY_SCHEDULER_DEPTH - 1))
 
-static inline bool mp_sched_full(void) {
-    MP_STATIC_ASSERT(MICROPY_SCHEDULER_DEPTH <= 255); // MICROPY_SCHEDULER_DEPTH must fit in 8 bits
+static inline bool mp_sched_full(unsigned int prio) {
+    MP_STATIC_ASSERT(MICROPY_SCHEDULER_DEPTH * MICROPY_SCHEDULER_PRIORITIES <= 255); // all entries must fit in 8 bits
     MP_STATIC_ASSERT((IDX_MASK(MICROPY_SCHEDULER_DEPTH) == 0)); // MICROPY_SCHEDULER_DEPTH must be a power of 2
 
-    return mp_sched_num_pending() == MICROPY_SCHEDULER_DEPTH;
+    return MP_STATE_VM(sched_level_len)[prio] == MICROPY_SCHEDULER_DEPTH;
 }
 
 static inline bool mp_sched_empty(void) {
@@ -60,22 +63,73 @@ void mp_handle_pending(void) {
     }
 }
 
+// Takes the oldest entry of the highest level at or above min_prio, in an atomic section.
+STATIC bool mp_sched_pop(unsigned int min_prio, mp_sched_item_t *item) {
+    for (int prio = MICROPY_SCHEDULER_PRIORITIES - 1; prio >= (int)min_prio; prio--) {
+        if (MP_STATE_VM(sched_level_len)[prio]) {
+            *item = MP_STATE_VM(sched_queue)[prio][MP_STATE_VM(sched_idx)[prio]];
+            MP_STATE_VM(sched_idx)[prio] = IDX_MASK(MP_STATE_VM(sched_idx)[prio] + 1);
+            --MP_STATE_VM(sched_level_len)[prio];
+            --MP_STATE_VM(sched_len);
+            if (prio >= MICROPY_SCHEDULER_CHECK_IN_PRIORITY) {
+                --MP_STATE_VM(sched_urgent);
+            }
+            #if MICROPY_SCHEDULER_STATS
+            mp_sched_stats_t *stats = &MP_STATE_VM(sched_stats)[prio];
+            stats->run += 1;
+            stats->latency_last = MICROPY_SCHEDULER_TICKS() - item->ticks;
+            if (stats->latency_last > stats->latency_max) {
+                stats->latency_max = stats->latency_last;
+            }
+            #endif
+            return true;
+        }
+    }
+    return false;
+}
+
 // This function should only be called be mp_sched_handle_pending,
 // or by the VM's inlined version of that function.
 void mp_handle_pending_tail(mp_uint_t atomic_state) {
     MP_STATE_VM(sched_state) = MP_SCHED_LOCKED;
-    if (!mp_sched_empty()) {
-        mp_sched_item_t item = MP_STATE_VM(sched_queue)[MP_STATE_VM(sched_idx)];
-        MP_STATE_VM(sched_idx) = IDX_MASK(MP_STATE_VM(sched_idx) + 1);
-        --MP_STATE_VM(sched_len);
+    mp_sched_item_t item;
+    if (!mp_sched_empty() && mp_sched_pop(0, &item)) {
         MICROPY_END_ATOMIC_SECTION(atomic_state);
+        MICROPY_SCHED_HOOK(true);
         mp_call_function_1_protected(item.func, item.arg);
+        MICROPY_SCHED_HOOK(false);
     } else {
         MICROPY_END_ATOMIC_SECTION(atomic_state);
     }
     mp_sched_unlock();
 }
 
+#if MICROPY_SCHEDULER_PRIORITIES > 1 && !MICROPY_PY_THREAD
+void mp_sched_check_in_tail(void) {
+    for (;;) {
+        mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+        // Locked while a callback runs (nothing nests) or while the caller keeps them off.
+        if (MP_STATE_VM(sched_state) != MP_SCHED_PENDING) {
+            MICROPY_END_ATOMIC_SECTION(atomic_state);
+            return;
+        }
+        MP_STATE_VM(sched_state) = MP_SCHED_LOCKED;
+        mp_sched_item_t item;
+        bool run = mp_sched_pop(MICROPY_SCHEDULER_CHECK_IN_PRIORITY, &item);
+        MICROPY_END_ATOMIC_SECTION(atomic_state);
+        if (run) {
+            MICROPY_SCHED_HOOK(true);
+            mp_call_function_1_protected(item.func, item.arg);
+            MICROPY_SCHED_HOOK(false);
+        }
+        mp_sched_unlock();
+        if (!run) {
+            return;
+        }
+    }
+}
+#endif
+
 void mp_sched_lock(void) {
     mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
     if (MP_STATE_VM(sched_state) < 0) {
@@ -100,18 +154,36 @@ void mp_sched_unlock(void) {
 }
 
 bool mp_sched_schedule(mp_obj_t function, mp_obj_t arg) {
+    return mp_sched_schedule_prio(function, arg, 0);
+}
+
+bool mp_sched_schedule_prio(mp_obj_t function, mp_obj_t arg, unsigned int prio) {
+    if (prio >= MICROPY_SCHEDULER_PRIORITIES) {
+        prio = MICROPY_SCHEDULER_PRIORITIES - 1;
+    }
     mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
     bool ret;
-    if (!mp_sched_full()) {
+    if (!mp_sched_full(prio)) {
         if (MP_STATE_VM(sched_state) == MP_SCHED_IDLE) {
             MP_STATE_VM(sched_state) = MP_SCHED_PENDING;
         }
-        uint8_t iput = IDX_MASK(MP_STATE_VM(sched_idx) + MP_STATE_VM(sched_len)++);
-        MP_STATE_VM(sched_queue)[iput].func = function;
-        MP_STATE_VM(sched_queue)[iput].arg = arg;
+        uint8_t iput = IDX_MASK(MP_STATE_VM(sched_idx)[prio] + MP_STATE_VM(sched_level_len)[prio]++);
+        ++MP_STATE_VM(sched_len);
+        if (prio >= MICROPY_SCHEDULER_CHECK_IN_PRIORITY) {
+            ++MP_STATE_VM(sched_urgent);
+        }
+        mp_sched_item_t *item = &MP_STATE_VM(sched_queue)[prio][iput];
+        item->func = function;
+        item->arg = arg;
+        #if MICROPY_SCHEDULER_STATS
+        item->ticks = MICROPY_SCHEDULER_TICKS();
+        #endif
         ret = true;
     } else {
         // schedule queue is full
+        #if MICROPY_SCHEDULER_STATS
+        MP_STATE_VM(sched_stats)[prio].dropped += 1;
+        #endif
         ret = false;
     }
     MICROPY_END_ATOMIC_SECTION(atomic_state);
@@ -237,6 +237,11 @@ const byte *mp_bytecode_print_str(const byte *ip) {
             printf("LOAD_METHOD %s", qstr_str(qst));
             break;
 
+        case MP_BC_LOAD_FAST_METHOD:
+            DECODE_QSTR;
+            printf("LOAD_FAST_METHOD %s " UINT_FMT, qstr_str(qst), (mp_uint_t)*ip++);
+            break;
+
         case MP_BC_LOAD_SUPER_METHOD:
             DECODE_QSTR;
             printf("LOAD_SUPER_METHOD %s", qstr_str(qst));
@@ -526,6 +531,12 @@ const byte *mp_bytecode_print_str(const byte *ip) {
             printf("IMPORT_STAR");
             break;
 
+        case MP_BC_BINARY_OP_FAST_INT:
+            printf("BINARY_OP_FAST_INT " UINT_FMT " " INT_FMT " %s", (mp_uint_t)ip[0],
+                (mp_int_t)(int8_t)ip[1], qstr_str(mp_binary_op_method_name[ip[2]]));
+            ip += 3;
+            break;
+
         default:
             if (ip[-1] < MP_BC_LOAD_CONST_SMALL_INT_MULTI + 64) {
                 printf("LOAD_CONST_SMALL_INT " INT_FMT, (mp_int_t)ip[-1] - MP_BC_LOAD_CONST_SMALL_INT_MULTI - 16);
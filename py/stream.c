@@ -553,3 +553,25 @@ int mp_stream_posix_fsync(void *stream) {
 }
 
 #endif
+
+#if MICROPY_STREAMS_POLL_NOTIFY
+// Ring of the objects that signalled, indexed by sequence number. They are only
+// compared by id and never dereferenced, so this isn't a GC root.
+volatile mp_uint_t mp_stream_poll_seq;
+STATIC const void *volatile stream_poll_events[MICROPY_STREAMS_POLL_NOTIFY];
+
+void mp_stream_poll_notify(mp_const_obj_t obj) {
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    stream_poll_events[mp_stream_poll_seq % MICROPY_STREAMS_POLL_NOTIFY] = MP_OBJ_TO_PTR(obj);
+    mp_stream_poll_seq++;
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+}
+
+const void *mp_stream_poll_event(mp_uint_t seq) {
+    const void *obj = stream_poll_events[seq % MICROPY_STREAMS_POLL_NOTIFY];
+    if (mp_stream_poll_seq - seq > MICROPY_STREAMS_POLL_NOTIFY) {
+        return NULL;
+    }
+    return obj;
+}
+#endif
@@ -43,6 +43,7 @@
 #define MP_STREAM_GET_DATA_OPTS (8)  // Get data/message options
 #define MP_STREAM_SET_DATA_OPTS (9)  // Set data/message options
 #define MP_STREAM_GET_FILENO    (10) // Get fileno of underlying file
+#define MP_STREAM_POLL_NOTIFY   (11) // Get the poll flags signalled with mp_stream_poll_notify
 
 // These poll ioctl values are compatible with Linux
 #define MP_STREAM_POLL_RD       (0x0001)
@@ -65,6 +66,16 @@ struct mp_stream_seek_t {
 #define MP_SEEK_CUR (1)
 #define MP_SEEK_END (2)
 
+#if MICROPY_STREAMS_POLL_NOTIFY
+// Called by a stream, typically from its IRQ, when its poll flags may have changed.
+void mp_stream_poll_notify(mp_const_obj_t obj);
+// The object of event seq (less than mp_stream_poll_seq), NULL once it's overwritten.
+const void *mp_stream_poll_event(mp_uint_t seq);
+extern volatile mp_uint_t mp_stream_poll_seq;
+#else
+#define mp_stream_poll_notify(obj)
+#endif
+
 // Stream protocol
 typedef struct _mp_stream_p_t {
     // On error, functions should return MP_STREAM_ERROR and fill in *errcode (values
@@ -117,6 +128,7 @@ mp_uint_t mp_stream_rw(mp_obj_t stream, void *buf, mp_uint_t size, int *errcode,
 void mp_stream_write_adaptor(void *self, const char *buf, size_t len);
 
 #if MICROPY_STREAMS_POSIX_API
+#include <sys/types.h>
 // Functions with POSIX-compatible signatures
 // "stream" is assumed to be a pointer to a concrete object with the stream protocol
 ssize_t mp_stream_posix_write(void *stream, const void *buf, size_t len);
@@ -32,6 +32,7 @@
 #include "py/emitglue.h"
 #include "py/objtype.h"
 #include "py/runtime.h"
+#include "py/smallint.h"
 #include "py/bc0.h"
 #include "py/bc.h"
 #include "py/profile.h"
@@ -165,6 +166,24 @@
     } \
 } while(0)
 
+#elif MICROPY_TRACK_CODE_STATE
+
+// only keep track of the running code_state, for micropython.alloc_stats/profile
+#define FRAME_SETUP() do { \
+    MP_STATE_THREAD(current_code_state) = code_state; \
+} while(0)
+
+#define FRAME_ENTER() do { \
+    code_state->prev_state = MP_STATE_THREAD(current_code_state); \
+} while(0)
+
+#define FRAME_LEAVE() do { \
+    MP_STATE_THREAD(current_code_state) = code_state->prev_state; \
+} while(0)
+
+#define FRAME_UPDATE()
+#define TRACE_TICK(current_ip, current_sp, is_exception)
+
 #else // MICROPY_PY_SYS_SETTRACE
 #define FRAME_SETUP()
 #define FRAME_ENTER()
@@ -188,6 +207,14 @@ static inline mp_map_elem_t *mp_map_cached_lookup(mp_map_t *map, qstr qst, uint8
     }
     return elem;
 }
+
+#if MICROPY_OPT_CACHE_MAP_LOOKUP_SIDE_TABLE
+STATIC uint8_t map_cache_side_table[MICROPY_OPT_CACHE_MAP_LOOKUP_SIDE_TABLE];
+#define MAP_CACHE_SIDE(ip) (&map_cache_side_table[((uintptr_t)(ip) ^ ((uintptr_t)(ip) >> 8)) % MICROPY_OPT_CACHE_MAP_LOOKUP_SIDE_TABLE])
+#define MAP_CACHE(ip) (MICROPY_BC_IS_READONLY(ip) ? MAP_CACHE_SIDE(ip) : (uint8_t*)(ip))
+#else
+#define MAP_CACHE(ip) ((uint8_t*)(ip))
+#endif
 #endif
 
 // fastn has items in reverse order (fastn[0] is local[0], fastn[-1] is local[1], etc)
@@ -196,7 +223,7 @@ static inline mp_map_elem_t *mp_map_cached_lookup(mp_map_t *map, qstr qst, uint8
 //  MP_VM_RETURN_NORMAL, sp valid, return value in *sp
 //  MP_VM_RETURN_YIELD, ip, sp valid, yielded value in *sp
 //  MP_VM_RETURN_EXCEPTION, exception in state[0]
-mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state, volatile mp_obj_t inject_exc) {
+MICROPY_HOT_TEXT mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state, volatile mp_obj_t inject_exc) {
 #define SELECTIVE_EXC_IP (0)
 #if SELECTIVE_EXC_IP
 #define MARK_EXC_IP_SELECTIVE() { code_state->ip = ip; } /* stores ip 1 byte past last opcode */
@@ -365,7 +392,7 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_NAME): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
-                    mp_map_elem_t *elem = mp_map_cached_lookup(&mp_locals_get()->map, qst, (uint8_t*)ip);
+                    mp_map_elem_t *elem = mp_map_cached_lookup(&mp_locals_get()->map, qst, MAP_CACHE(ip));
                     mp_obj_t obj;
                     if (elem != NULL) {
                         obj = elem->value;
@@ -389,7 +416,7 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_GLOBAL): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
-                    mp_map_elem_t *elem = mp_map_cached_lookup(&mp_globals_get()->map, qst, (uint8_t*)ip);
+                    mp_map_elem_t *elem = mp_map_cached_lookup(&mp_globals_get()->map, qst, MAP_CACHE(ip));
                     mp_obj_t obj;
                     if (elem != NULL) {
                         obj = elem->value;
@@ -419,7 +446,7 @@ dispatch_loop:
                     mp_map_elem_t *elem = NULL;
                     if (mp_obj_is_instance_type(mp_obj_get_type(top))) {
                         mp_obj_instance_t *self = MP_OBJ_TO_PTR(top);
-                        elem = mp_map_cached_lookup(&self->members, qst, (uint8_t*)ip);
+                        elem = mp_map_cached_lookup(&self->members, qst, MAP_CACHE(ip));
                     }
                     mp_obj_t obj;
                     if (elem != NULL) {
@@ -436,11 +463,51 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    #if MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE && MICROPY_OPT_CACHE_MAP_LOOKUP_SIDE_TABLE
+                    // native types without their own attr handler only look in locals_dict
+                    mp_obj_type_t *type = mp_obj_get_type(*sp);
+                    if (type->attr == NULL && type->locals_dict != NULL
+                        && qst != MP_QSTR___next__ && qst != MP_QSTR___class__) {
+                        mp_map_elem_t *elem = mp_map_cached_lookup(&type->locals_dict->map, qst, MAP_CACHE_SIDE(ip));
+                        if (elem != NULL) {
+                            mp_convert_member_lookup(*sp, type, elem->value, sp);
+                            sp += 1;
+                            DISPATCH();
+                        }
+                    }
+                    #endif
                     mp_load_method(*sp, qst, sp);
                     sp += 1;
                     DISPATCH();
                 }
 
+                #if MICROPY_OPT_SUPERINSTRUCTIONS
+                ENTRY(MP_BC_LOAD_FAST_METHOD): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_QSTR;
+                    obj_shared = fastn[-(mp_uint_t)*ip++];
+                    if (obj_shared == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(obj_shared);
+                    #if MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE && MICROPY_OPT_CACHE_MAP_LOOKUP_SIDE_TABLE
+                    mp_obj_type_t *type = mp_obj_get_type(obj_shared);
+                    if (type->attr == NULL && type->locals_dict != NULL
+                        && qst != MP_QSTR___next__ && qst != MP_QSTR___class__) {
+                        mp_map_elem_t *elem = mp_map_cached_lookup(&type->locals_dict->map, qst, MAP_CACHE_SIDE(ip));
+                        if (elem != NULL) {
+                            mp_convert_member_lookup(obj_shared, type, elem->value, sp);
+                            sp += 1;
+                            DISPATCH();
+                        }
+                    }
+                    #endif
+                    mp_load_method(obj_shared, qst, sp);
+                    sp += 1;
+                    DISPATCH();
+                }
+                #endif
+
                 ENTRY(MP_BC_LOAD_SUPER_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
@@ -510,7 +577,7 @@ dispatch_loop:
                     mp_obj_t top = TOP();
                     if (mp_obj_is_instance_type(mp_obj_get_type(top)) && sp[-1] != MP_OBJ_NULL) {
                         mp_obj_instance_t *self = MP_OBJ_TO_PTR(top);
-                        elem = mp_map_cached_lookup(&self->members, qst, (uint8_t*)ip);
+                        elem = mp_map_cached_lookup(&self->members, qst, MAP_CACHE(ip));
                     }
                     if (elem != NULL) {
                         elem->value = sp[-1];
@@ -1322,6 +1389,65 @@ yield:
                     DISPATCH();
                 }
 
+                #if MICROPY_OPT_SUPERINSTRUCTIONS
+                ENTRY(MP_BC_BINARY_OP_FAST_INT): {
+                    MARK_EXC_IP_SELECTIVE();
+                    mp_obj_t lhs = fastn[-(mp_uint_t)ip[0]];
+                    mp_int_t rhs = (int8_t)ip[1];
+                    mp_binary_op_t op = ip[2];
+                    ip += 3;
+                    if (lhs == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    // the counter and index arithmetic of loops stays in small ints
+                    if (MP_OBJ_IS_SMALL_INT(lhs)) {
+                        mp_int_t l = MP_OBJ_SMALL_INT_VALUE(lhs);
+                        switch (op) {
+                            case MP_BINARY_OP_ADD:
+                            case MP_BINARY_OP_INPLACE_ADD:
+                                if (MP_SMALL_INT_FITS(l + rhs)) {
+                                    PUSH(MP_OBJ_NEW_SMALL_INT(l + rhs));
+                                    DISPATCH();
+                                }
+                                break;
+                            case MP_BINARY_OP_SUBTRACT:
+                            case MP_BINARY_OP_INPLACE_SUBTRACT:
+                                if (MP_SMALL_INT_FITS(l - rhs)) {
+                                    PUSH(MP_OBJ_NEW_SMALL_INT(l - rhs));
+                                    DISPATCH();
+                                }
+                                break;
+                            case MP_BINARY_OP_AND:
+                            case MP_BINARY_OP_INPLACE_AND:
+                                PUSH(MP_OBJ_NEW_SMALL_INT(l & rhs));
+                                DISPATCH();
+                            case MP_BINARY_OP_LESS:
+                                PUSH(mp_obj_new_bool(l < rhs));
+                                DISPATCH();
+                            case MP_BINARY_OP_MORE:
+                                PUSH(mp_obj_new_bool(l > rhs));
+                                DISPATCH();
+                            case MP_BINARY_OP_EQUAL:
+                                PUSH(mp_obj_new_bool(l == rhs));
+                                DISPATCH();
+                            case MP_BINARY_OP_LESS_EQUAL:
+                                PUSH(mp_obj_new_bool(l <= rhs));
+                                DISPATCH();
+                            case MP_BINARY_OP_MORE_EQUAL:
+                                PUSH(mp_obj_new_bool(l >= rhs));
+                                DISPATCH();
+                            case MP_BINARY_OP_NOT_EQUAL:
+                                PUSH(mp_obj_new_bool(l != rhs));
+                                DISPATCH();
+                            default:
+                                break;
+                        }
+                    }
+                    PUSH(mp_binary_op(op, lhs, MP_OBJ_NEW_SMALL_INT(rhs)));
+                    DISPATCH();
+                }
+                #endif
+
                 ENTRY_DEFAULT:
                     MARK_EXC_IP_SELECTIVE();
 #else
@@ -1428,6 +1554,9 @@ exception_handler:
                 if (code_state->ip) {
                     // check if it's a StopIteration within a for block
                     if (*code_state->ip == MP_BC_FOR_ITER) {
+                        #if MICROPY_PREALLOC_EXCEPTIONS
+                        mp_obj_exception_prealloc_release(MP_OBJ_FROM_PTR(nlr.ret_val));
+                        #endif
                         const byte *ip = code_state->ip + 1;
                         DECODE_ULABEL; // the jump offset if iteration finishes; for labels are always forward
                         code_state->ip = ip + ulab; // jump to after for-block
@@ -1438,6 +1567,9 @@ exception_handler:
                         // yield from, so inject exception's value as yield from's result
                         // (Instead of stack pop then push we just replace exhausted gen with value)
                         *code_state->sp = mp_obj_exception_get_value(MP_OBJ_FROM_PTR(nlr.ret_val));
+                        #if MICROPY_PREALLOC_EXCEPTIONS
+                        mp_obj_exception_prealloc_release(MP_OBJ_FROM_PTR(nlr.ret_val));
+                        #endif
                         code_state->ip++; // yield from is over, move to next instruction
                         goto outer_dispatch_loop; // continue with dispatch loop
                     }
@@ -1481,6 +1613,10 @@ unwind_loop:
                 ip = mp_decode_uint_skip(ip);
                 #endif
                 size_t source_line = mp_bytecode_get_source_line(ip, bc);
+                #if MICROPY_PREALLOC_EXCEPTIONS
+                // a deep traceback moves a preallocated instance to the heap
+                nlr.ret_val = MP_OBJ_TO_PTR(mp_obj_exception_prealloc_make_room(MP_OBJ_FROM_PTR(nlr.ret_val)));
+                #endif
                 mp_obj_exception_add_traceback(MP_OBJ_FROM_PTR(nlr.ret_val), source_file, source_line, block_name);
             }
 
@@ -1499,6 +1635,14 @@ unwind_loop:
 
             if (exc_sp >= exc_stack) {
                 // catch exception and pass to byte code
+                #if MICROPY_PREALLOC_EXCEPTIONS
+                // the handler can keep hold of the exception, so it gets a copy
+                // and the preallocated instance is free for the next raise
+                nlr.ret_val = MP_OBJ_TO_PTR(mp_obj_exception_prealloc_copy(MP_OBJ_FROM_PTR(nlr.ret_val)));
+                #if MICROPY_PY_SYS_EXC_INFO
+                MP_STATE_VM(cur_exception) = nlr.ret_val;
+                #endif
+                #endif
                 code_state->ip = exc_sp->handler;
                 mp_obj_t *sp = MP_TAGPTR_PTR(exc_sp->val_sp);
                 // save this exception in the stack so it can be used in a reraise, if needed
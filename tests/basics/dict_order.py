@@ -0,0 +1,42 @@
+# insertion order of dicts with the compact layout (MICROPY_OPT_MAP_COMPACT)
+
+d = {}
+for k in (3, 2, 1):
+    d[k] = None
+if list(d) != [3, 2, 1]:
+    # dicts are hash tables in the other layout
+    print("SKIP")
+    raise SystemExit
+
+# deleted keys leave the order, keys added again go to the end
+d = {'a': 1, 'b': 2, 'c': 3, 'd': 4}
+del d['b']
+print(list(d))
+d['b'] = 5
+print(list(d.items()))
+d['a'] = 6
+print(list(d.items()))
+
+# order is kept across resizes and the tombstones they compact
+d = {}
+for i in range(100):
+    d[(i * 37) % 101] = i
+    if i % 3 == 0:
+        del d[(i * 37) % 101]
+print(list(d)[:10], len(d))
+for i in range(50):
+    d.pop((i * 37) % 101, None)
+print(list(d)[:10], len(d))
+for i in range(200, 300):
+    d[str(i)] = i
+print(list(d)[25:35], len(d))
+print(all(d[k] == v for k, v in d.items()))
+
+# copies, updates and views see the same order
+e = d.copy()
+print(list(e) == list(d), list(e.values()) == list(d.values()))
+e = {}
+e.update([(9, 0), (4, 1), (7, 2)])
+e.update({4: 3, 1: 4})
+print(list(e.items()))
+print(list(reversed(list(e.keys()))))
@@ -0,0 +1,29 @@
+# each raise of a lookup or iteration error is a new instance
+
+d = {}
+
+try:
+    d['a']
+except KeyError as e:
+    try:
+        d['b']
+    except KeyError as e2:
+        print(e.args, e2.args, e is e2)
+    print(e.args)
+
+errs = []
+for k in ('x', 'y', 'z'):
+    try:
+        d[k]
+    except KeyError as e:
+        errs.append(e)
+print([e.args for e in errs])
+print(errs[0] is errs[1])
+
+errs = []
+for _ in range(2):
+    try:
+        next(iter(()))
+    except StopIteration as e:
+        errs.append(e)
+print(errs[0] is errs[1])
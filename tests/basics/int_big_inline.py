@@ -0,0 +1,33 @@
+# big ints around the 64 bits kept inline in the int object (MICROPY_LONGINT_MPZ_INLINE)
+
+M64 = (1 << 64) - 1
+
+# carries and borrows across the 64-bit boundary
+print(M64 + 1, hex(M64 + 1))
+print((1 << 64) - 1 == M64, (1 << 64) - M64)
+print(M64 * M64, hex(M64 * 3))
+print(-M64 - 1, -(1 << 63) - 1)
+x = 0xffffffff
+for _ in range(4):
+    x = x * 0x100000001 + 1
+print(x, x.bit_length() if hasattr(x, 'bit_length') else len(bin(x)) - 2)
+
+# values that grow past the inline digits and shrink back
+x = 1
+for i in range(200):
+    x = x * 3 + i
+print(x % 1000000007, x >> 300)
+while x > M64:
+    x >>= 17
+print(x, x <= M64)
+
+# results that fit a small int, computed from big operands
+a = 0x123456789abcdef01
+print(a & 0xff, a >> 60, a % 1000, (a * 5) // a, a - (a - 7))
+print((a | 0xff) - a, (a ^ a), -a // a, -a % 3, a // -3 * -3 - a)
+print(divmod(a, 0x100000000), divmod(-a, 7), divmod(a, -a))
+print((1 << 100) // (1 << 99), (1 << 100) % ((1 << 99) + 1) >> 90)
+
+# mixed with small ints and compared
+print(a > 5, 5 < a, a == a + 0, a != a + 1, -a < -(a - 1))
+print(sorted([a, -a, 1, M64, -M64, 0]))
@@ -28,6 +28,15 @@ try:
 except TypeError:
     print("TypeError")
 
+# items of an iterator are joined as they come
+print(','.join(str(i) for i in range(12)))
+print(b'-'.join(x for x in (b'a', b'bb', b'')))
+print(repr(''.join(iter([]))), repr(','.join(iter(['x']))))
+try:
+    ','.join(i for i in range(3))
+except TypeError:
+    print("TypeError")
+
 # joined by the compiler
 print("a" "b")
 print("a" '''b''')
@@ -0,0 +1,43 @@
+try:
+    import framebuf
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+if not hasattr(framebuf, 'FONT_IMLIB'):
+    print("SKIP")
+    raise SystemExit
+
+w = 20
+h = 10
+buf = bytearray(w * h)
+fbuf = framebuf.FrameBuffer(buf, w, h, framebuf.GS8)
+
+def printbuf():
+    for y in range(h):
+        print(''.join('#' if buf[y * w + x] else '.' for x in range(w)))
+    print('--')
+
+# the 8x10 glyphs of imlib, with their own advance
+fbuf.text('Hi!', 0, 0, 1, framebuf.FONT_IMLIB)
+printbuf()
+
+# 127 has no imlib glyph, it draws as '?'
+fbuf.fill(0)
+fbuf.text(chr(127), 0, 0, 1, framebuf.FONT_IMLIB)
+printbuf()
+
+# clipped at the edges
+fbuf.fill(0)
+fbuf.text('A', -3, 4, 1, framebuf.FONT_IMLIB)
+printbuf()
+
+# the default is still the 8x8 font
+fbuf.fill(0)
+fbuf.text('Hi', 0, 0, 1, framebuf.FONT_8X8)
+printbuf()
+
+try:
+    fbuf.text('x', 0, 0, 1, 2)
+except ValueError:
+    print('ValueError')
@@ -0,0 +1,71 @@
+try:
+    from uio import StringIO
+    import ujson
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+if not hasattr(ujson, 'Parser'):
+    print("SKIP")
+    raise SystemExit
+
+NAMES = {
+    ujson.VALUE: 'VALUE',
+    ujson.KEY: 'KEY',
+    ujson.START_ARRAY: 'START_ARRAY',
+    ujson.END_ARRAY: 'END_ARRAY',
+    ujson.START_OBJECT: 'START_OBJECT',
+    ujson.END_OBJECT: 'END_OBJECT',
+}
+
+def events(s):
+    p = ujson.Parser(StringIO(s))
+    for ev in p:
+        if ev in (ujson.VALUE, ujson.KEY):
+            print(NAMES[ev], repr(p.value))
+        else:
+            print(NAMES[ev])
+
+# the event stream of a document
+events('{"a": [1, 2.5, "x"], "b": {"c": null, "d": true}, "e": false}')
+print('--')
+# several top level values in a row
+events('1 "two"\n[3]\n{}')
+print('--')
+
+# load() mid-stream builds the next value and carries on after it
+p = ujson.Parser(StringIO('{"id": 7, "box": [1, 2, {"w": 3}], "tag": "t"}'))
+for ev in p:
+    if ev == ujson.KEY and p.value == 'box':
+        print('box', p.load())
+    elif ev == ujson.KEY:
+        print('key', p.value)
+    elif ev == ujson.VALUE:
+        print('value', p.value)
+print('--')
+
+# 32 levels of nesting at most
+s = '[' * 32 + ']' * 32
+print(sum(1 for _ in ujson.Parser(StringIO(s))))
+try:
+    for _ in ujson.Parser(StringIO('[' * 33 + ']' * 33)):
+        pass
+except ValueError:
+    print('ValueError deep')
+
+# malformed input raises ValueError
+for s in (']', '[}', '{"a": 1]', '{1: 2}', '[1, 2', '{"a"', '[tru]', '[[]]]'):
+    try:
+        for _ in ujson.Parser(StringIO(s)):
+            pass
+        print('ok', s)
+    except ValueError:
+        print('ValueError', s)
+
+# load() can't stand in for a key
+p = ujson.Parser(StringIO('{"a": 1}'))
+next(p)
+try:
+    p.load()
+except ValueError:
+    print('ValueError load')
@@ -0,0 +1,30 @@
+# patterns compiled again and again, as the pattern cache sees them
+
+try:
+    import ure as re
+except ImportError:
+    try:
+        import re
+    except ImportError:
+        print("SKIP")
+        raise SystemExit
+
+# more patterns than the cache holds, in turn, through compile() and the module functions
+pats = ['a+', 'b+', 'c(d)', 'e|f', 'g[0-9]', 'h.i', '^j']
+subj = 'xaa bb cd f g5 hxi'
+for _ in range(3):
+    out = []
+    for p in pats:
+        m = re.compile(p).search(subj)
+        out.append(m and m.group(0))
+        m = re.search(p, subj)
+        out.append(m and m.group(0))
+    print(out)
+
+# a cached pattern keeps its own groups
+for p in ('(a)(b)', '(a)', '(a)(b)'):
+    m = re.match(p, 'ab')
+    print(m.group(0), m.group(1))
+
+print(re.compile('[0-9]').split('a1b2'), re.compile('[0-9]').split('c3'))
+print(re.match('b', 'ab'), re.search('b', 'ab').group(0))
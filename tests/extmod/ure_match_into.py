@@ -0,0 +1,42 @@
+# match_into() and search_into() fill a match object from an earlier match
+
+try:
+    import ure as re
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+r = re.compile('([a-z]+)=([0-9]+)')
+if not hasattr(r, 'match_into'):
+    print("SKIP")
+    raise SystemExit
+
+m = r.match('a=1')
+print(m.group(0), m.group(1), m.group(2))
+
+# the same object comes back, filled from the new subject
+for line in ('bb=22', 'c=3;', ' d=4'):
+    m2 = r.match_into(line, m)
+    print(m2 is m, m2 and (m.group(0), m.group(1), m.group(2)))
+for line in (' d=4', 'x y=55', '=='):
+    m2 = r.search_into(line, m)
+    print(m2 is m, m2 and (m.group(0), m.group(2)))
+
+# after a failed match the object can still be filled
+print(r.search_into('z=9', m).group(1))
+
+# bytes subjects
+rb = re.compile(b'([a-z]+)=')
+mb = rb.match(b'k=')
+print(rb.search_into(b'.. xy=', mb).group(1))
+
+# a match object of a pattern with another number of groups is refused
+m1 = re.compile('(a)').match('a')
+try:
+    r.match_into('a=1', m1)
+except ValueError:
+    print('ValueError')
+try:
+    r.match_into('a=1', 'not a match')
+except TypeError:
+    print('TypeError')
@@ -0,0 +1,45 @@
+# searches of patterns that start with literal bytes, which are prefiltered
+
+try:
+    import ure as re
+except ImportError:
+    try:
+        import re
+    except ImportError:
+        print("SKIP")
+        raise SystemExit
+
+def s(p, subj):
+    m = re.search(p, subj)
+    print(m and m.group(0))
+
+# the prefix occurs before the match, at the very end and not at all
+s('abc+d', 'ab abc abcc abccd')
+s('abcd', 'xxabc')
+s('abcd', 'abcd')
+s('needle', 'haystack')
+s('a', '')
+s('', 'abc')
+
+# prefixes that end at a group, a repeat or an alternation
+s('ab(c|d)e', 'abce abde')
+s('ab(cd)*x', 'abcdcdy abcdx')
+s('key=[0-9]+', 'key=x key=42')
+s('hello|help', 'he hel help hello')
+s('ab?c', 'a ac abc')
+
+# anchored by ^, only tried at the start
+s('^abc', 'xabc')
+s('^abc', 'abcabc')
+s('^', 'abc')
+
+# match() needs the prefix at the start
+print(re.match('abc', 'xabc'), re.match('abc', 'abcx').group(0))
+print(re.match('ab[0-9]', 'ab5').group(0), re.match('ab[0-9]', 'abx'))
+
+# split() goes through the same search
+print(re.compile('--').split('a--b--c-d'))
+print(re.compile('x=').split('x=1,x=2,xx=3'))
+
+# bytes subjects
+s(b'\x01\x02', b'\x00\x01\x01\x02')
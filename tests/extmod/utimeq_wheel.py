@@ -0,0 +1,84 @@
+# utimeq.Wheel pops in the same order as utimeq, wraparound time included
+try:
+    from utime import ticks_add
+    from utimeq import utimeq, Wheel
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+MAX = ticks_add(0, -1)
+
+seed = 1
+def rand(n):
+    global seed
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff
+    return seed % n
+
+def check(base, spread, n, rounds):
+    q = utimeq(n)
+    w = Wheel(n)
+    a = [0, 0, 0]
+    b = [0, 0, 0]
+    ok = True
+    now = base
+    tag = 0
+    for _ in range(rounds):
+        # push a few around now, some before the earliest queued, some equal
+        for _ in range(rand(4) + 1):
+            if len(q) == n:
+                break
+            t = ticks_add(now, rand(spread) - spread // 8)
+            if rand(5) == 0:
+                t = now
+            q.push(t, tag, None)
+            w.push(t, tag, None)
+            tag += 1
+        if q.peektime() != w.peektime():
+            ok = False
+        for _ in range(rand(4)):
+            if not q:
+                break
+            q.pop(a)
+            w.pop(b)
+            if a != b:
+                ok = False
+            now = a[0]
+    while q:
+        q.pop(a)
+        w.pop(b)
+        if a != b:
+            ok = False
+    return ok and len(w) == 0 and not w
+
+print(check(0, 1000, 16, 200))
+print(check(MAX - 500, 1000, 16, 200))
+print(check(MAX - 100000, 1 << 20, 32, 300))
+print(check(12345, 64, 8, 200))
+print(check(MAX // 2, 1 << 24, 32, 300))
+
+# equal times pop in push order
+w = Wheel(4)
+for i in range(4):
+    w.push(MAX, i, i)
+out = [0, 0, 0]
+res = []
+while w:
+    w.pop(out)
+    res.append(out[1])
+print(res)
+
+# full and empty
+w = Wheel(2)
+w.push(1, 0, 0)
+w.push(2, 0, 0)
+try:
+    w.push(3, 0, 0)
+except IndexError:
+    print('IndexError full')
+print(len(w))
+w.pop(out)
+w.pop(out)
+try:
+    w.pop(out)
+except IndexError:
+    print('IndexError empty')
@@ -0,0 +1,63 @@
+try:
+    import uzlib as zlib
+    import uio as io
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+if not hasattr(zlib, 'CompIO'):
+    print("SKIP")
+    raise SystemExit
+
+data = b'the quick brown fox jumps over the lazy dog. ' * 40 + bytes(range(256)) * 2
+
+def compress(wbits, level, chunk=None):
+    buf = io.BytesIO()
+    c = zlib.CompIO(buf, wbits, level)
+    if chunk is None:
+        c.write(data)
+    else:
+        for i in range(0, len(data), chunk):
+            c.write(data[i:i + chunk])
+    c.close()
+    return buf.getvalue()
+
+def decompress(z, wbits):
+    return zlib.DecompIO(io.BytesIO(z), wbits).read()
+
+# zlib, gzip and raw deflate round trip at each level
+for wbits in (12, 16 + 12, -12):
+    sizes = []
+    for level in range(10):
+        z = compress(wbits, level)
+        assert decompress(z, wbits) == data, (wbits, level)
+        sizes.append(len(z) < len(data) if level else len(z) > len(data) // 2)
+    print(wbits, sizes)
+
+# other window sizes, and input written in small chunks
+for wbits in (9, 15, -9, 16 + 15):
+    print(wbits, decompress(compress(wbits, 6, 17), wbits) == data)
+
+# zlib streams also decompress with uzlib.decompress()
+print(zlib.decompress(compress(10, 9)) == data)
+print(zlib.decompress(compress(-10, 1), -10) == data)
+
+# a sync flush makes what was written so far readable
+buf = io.BytesIO()
+c = zlib.CompIO(buf, -9, 6)
+c.write(b'hello ' * 10)
+c.flush()
+print(zlib.DecompIO(io.BytesIO(buf.getvalue()), -9).read(60))
+c.close()
+
+# bad arguments
+for args in ((8, 6), (17 + 15, 6), (12, 10), (12, -1)):
+    try:
+        zlib.CompIO(io.BytesIO(), *args)
+    except ValueError:
+        print('ValueError', args)
+
+# DecompIO sizes the window from the zlib header (CINFO + 8), here 512 bytes
+# with references 200 bytes back
+z = b'\x18\xd3c`dbfaec\xe7\xe0\xe4\xe2\xe6\xe1\xe5\xe3\x17\x10\x14\x12\x16\x11\x15\x13\x97\x90\x94\x92\x96\x91\x95\x93WPTRVQUS\xd7\xd0\xd4\xd2\xd6\xd1\xd5\xd370426153\xb7\xb0\xb4\xb2\xb6\xb1\xb5\xb3wptrvqus\xf7\xf0\xf4\xf2\xf6\xf1\xf5\xf3\x0f\x08\x0c\n\x0e\t\r\x0b\x8f\x88\x8c\x8a\x8e\x89\x8d\x8bOHLJNIMK\xcf\xc8\xcc\xca\xce\xc9\xcd\xcb/(,*.)-+\xaf\xa8\xac\xaa\xae\xa9\xad\xabohljnimk\xef\xe8\xec\xea\xee\xe9\xed\xeb\x9f0q\xd2\xe4)S\xa7M\x9f1s\xd6\xec9s\xe7\xcd_\xb0p\xd1\xe2%K\x97-_\xb1r\xd5\xea5k\xd7\xad\xdf\xb0q\xd3\xe6-[\xb7m\xdf\xb1s\xd7\xee={\xf7\xed?p\xf0\xd0\xe1#G\x8f\x1dg\x18\xf5\xc7\xa0\xf2\x07\x00I\xd1\xe95'
+print(zlib.DecompIO(io.BytesIO(z)).read() == bytes(range(200)) * 3)
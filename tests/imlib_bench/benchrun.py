@@ -0,0 +1,68 @@
+# Appended by run-imlibbench.py to every benchmark, with bm_run(...) after it.
+#
+# A benchmark defines bm_setup(img, fmt), which gets a fresh synthetic frame and its
+# format, 'gray' or 'rgb565', and returns a callable to time. The callable returns a small summary of what it found, which must be
+# the same on every run, and optionally bm_formats/bm_sizes to limit where it runs.
+
+def bm_rand(seed):
+    # ZX81 LCG, small ints only so it is the same everywhere
+    x = seed
+    while True:
+        x = (x * 75 + 74) % 65537
+        yield x
+
+def bm_frame(w, h, pixformat, seed=1):
+    import image
+    img = image.Image(w, h, pixformat)
+    rnd = bm_rand(seed)
+    img.draw_rectangle(0, 0, w, h, color=(96, 96, 96), fill=True)
+    # blobs of all sizes and colours
+    for _ in range(24):
+        x, y = next(rnd) % w, next(rnd) % h
+        s = 4 + next(rnd) % (w // 8)
+        c = (next(rnd) & 255, next(rnd) & 255, next(rnd) & 255)
+        if next(rnd) & 1:
+            img.draw_rectangle(x, y, s, s, color=c, fill=True)
+        else:
+            img.draw_circle(x, y, s // 2, color=c, fill=True)
+    # lines for the edge detectors
+    for _ in range(16):
+        img.draw_line(next(rnd) % w, next(rnd) % h, next(rnd) % w, next(rnd) % h,
+                      color=(next(rnd) & 255, 255, 0), thickness=1 + next(rnd) % 3)
+    # nested black and white squares, finder pattern like, for the quad detectors
+    s = h // 6
+    for x, y in ((s // 2, s // 2), (w - s - s // 2, s // 2), (s // 2, h - s - s // 2)):
+        img.draw_rectangle(x, y, s, s, color=(0, 0, 0), fill=True)
+        img.draw_rectangle(x + s // 7, y + s // 7, s - 2 * (s // 7), s - 2 * (s // 7), color=(255, 255, 255), fill=True)
+        img.draw_rectangle(x + 2 * (s // 7), y + 2 * (s // 7), s - 4 * (s // 7), s - 4 * (s // 7), color=(0, 0, 0), fill=True)
+    img.draw_string(w // 3, h // 2, 'OpenMV 0123', color=(255, 255, 255), scale=1 + w // 320)
+    return img
+
+BM_SIZES = {'QQVGA': (160, 120), 'QVGA': (320, 240), 'VGA': (640, 480)}
+
+def bm_run(sizes, formats):
+    import gc
+    import sensor
+    import ujson
+    from utime import ticks_us, ticks_diff
+    pixformats = {'gray': sensor.GRAYSCALE, 'rgb565': sensor.RGB565}
+    for size in sizes:
+        for fmt in formats:
+            out = {'size': size, 'format': fmt}
+            if fmt not in globals().get('bm_formats', pixformats) or size not in globals().get('bm_sizes', BM_SIZES):
+                out['skip'] = 'n/a'
+            else:
+                gc.collect()
+                try:
+                    w, h = BM_SIZES[size]
+                    run = bm_setup(bm_frame(w, h, pixformats[fmt]), fmt)
+                    t0 = ticks_us()
+                    result = run()
+                    out['us'] = ticks_diff(ticks_us(), t0)
+                    out['result'] = result
+                except MemoryError:
+                    out['skip'] = 'nomem'
+                except Exception as e:
+                    out['skip'] = repr(e)
+                run = None
+            print(ujson.dumps(out))
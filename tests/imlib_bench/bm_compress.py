@@ -0,0 +1,4 @@
+def bm_setup(img, fmt):
+    def run():
+        return img.compressed(quality=50).size()
+    return run
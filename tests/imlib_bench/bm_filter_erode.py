@@ -0,0 +1,5 @@
+def bm_setup(img, fmt):
+    thresholds = [(128, 255)] if fmt == 'gray' else [(50, 100, -128, 127, -128, 127)]
+    def run():
+        return img.binary(thresholds).erode(1).get_statistics().mean()
+    return run
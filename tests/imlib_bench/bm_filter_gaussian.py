@@ -0,0 +1,4 @@
+def bm_setup(img, fmt):
+    def run():
+        return img.gaussian(1).get_statistics().mean()
+    return run
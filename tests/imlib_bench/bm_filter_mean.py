@@ -0,0 +1,4 @@
+def bm_setup(img, fmt):
+    def run():
+        return img.mean(2).get_statistics().mean()
+    return run
@@ -0,0 +1,7 @@
+# The tag detector's buffers only fit QQVGA and QVGA in the frame buffer.
+bm_sizes = ('QQVGA', 'QVGA')
+
+def bm_setup(img, fmt):
+    def run():
+        return len(img.find_apriltags())
+    return run
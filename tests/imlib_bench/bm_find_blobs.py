@@ -0,0 +1,8 @@
+def bm_setup(img, fmt):
+    if fmt == 'gray':
+        thresholds = [(128, 255)]
+    else:
+        thresholds = [(30, 100, 15, 127, 15, 127), (30, 100, -64, -8, -32, 32)]
+    def run():
+        return len(img.find_blobs(thresholds, pixels_threshold=8, area_threshold=8, merge=True))
+    return run
@@ -0,0 +1,7 @@
+bm_formats = ('gray',)
+
+def bm_setup(img, fmt):
+    import image
+    def run():
+        return img.find_edges(image.EDGE_CANNY, threshold=(50, 80)).get_statistics().mean()
+    return run
@@ -0,0 +1,10 @@
+# Needs a network on the board, run-imlibbench.py --nn sets bm_nn_model to its path.
+def bm_setup(img, fmt):
+    import nn
+    if not globals().get('bm_nn_model'):
+        raise OSError('no --nn model')
+    net = nn.load(bm_nn_model)
+    def run():
+        out = net.forward(img, softmax=True)
+        return out.index(max(out))
+    return run
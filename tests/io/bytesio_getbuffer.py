@@ -0,0 +1,50 @@
+# io.BytesIO capacity= and getbuffer()
+try:
+    import uio as io
+except ImportError:
+    import io
+
+a = io.BytesIO(capacity=16)
+a.write(b"abc")
+v = a.getbuffer()
+print(bytes(v))
+
+# writes that fit the buffer show through the view
+a.seek(0)
+a.write(b"X")
+print(bytes(v))
+v[1] = 0x59
+print(a.getvalue())
+
+# a write that needs a larger buffer leaves the view where it was
+a.seek(0, 2)
+a.write(b"z" * 20)
+print(bytes(v), len(a.getvalue()))
+
+# the view of a BytesIO made from bytes does not write to the bytes
+b = b"foo"
+a = io.BytesIO(b)
+v = a.getbuffer()
+v[0] = 0x46
+print(b, a.getvalue())
+
+# initial data are copied into the capacity
+a = io.BytesIO(b"foo", capacity=8)
+a.seek(0, 2)
+a.write(b"bar")
+print(a.getvalue())
+
+# the view outlives close()
+v = a.getbuffer()
+a.close()
+print(bytes(v))
+
+# negative sizes are refused
+try:
+    io.BytesIO(capacity=-1)
+except ValueError:
+    print("ValueError")
+try:
+    io.BytesIO(-1)
+except ValueError:
+    print("ValueError")
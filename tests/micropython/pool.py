@@ -0,0 +1,59 @@
+# micropython.Pool: static buffers that are taken and given back without allocating
+
+import micropython
+
+try:
+    micropython.Pool
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+p = micropython.Pool(3, 16)
+a = p.get()
+print(type(a).__name__, len(a))
+a[0] = 255
+a[15] = 1
+print(a[0], a[15], bytes(a[:2]))
+
+# all taken, then one given back and taken again
+b = p.get()
+c = p.get()
+print(p.get())
+p.put(b)
+d = p.get()
+print(d is b, a is not b and b is not c)
+
+# get() and put() work with the heap locked
+p.put(a)
+micropython.heap_lock()
+e = p.get()
+e[1] = 7
+p.put(e)
+micropython.heap_unlock()
+print(e[1])
+
+# buffers of another pool are refused
+q = micropython.Pool(1, 8)
+try:
+    p.put(q.get())
+except ValueError:
+    print('ValueError put')
+
+# bad sizes
+for args in ((0, 8), (2, 0), (-1, 8)):
+    try:
+        micropython.Pool(*args)
+    except ValueError:
+        print('ValueError', args)
+try:
+    micropython.Pool(1, 1 << 24)
+except MemoryError:
+    print('MemoryError')
+
+# a pool that doesn't fit takes none of the region
+for _ in range(3):
+    try:
+        micropython.Pool(150, 40)
+    except MemoryError:
+        print('MemoryError')
+print(len(micropython.Pool(1, 6000).get()))
@@ -0,0 +1,49 @@
+# Attribute and dict access: instance attributes, method lookups, class attributes and
+# str keyed dicts, the lookups a script's state machine does every frame.
+
+class Track:
+    scale = 3
+
+    def __init__(self, i):
+        self.x = i
+        self.y = i * 2
+        self.hits = 0
+
+    def update(self, dx):
+        self.x += dx
+        self.hits += 1
+        return self.x * self.scale
+
+
+def benchmark(n):
+    tracks = [Track(i) for i in range(8)]
+    counts = {'left': 0, 'right': 0, 'up': 0, 'down': 0}
+    keys = ('left', 'right', 'up', 'down')
+    total = 0
+    for i in range(n):
+        t = tracks[i & 7]
+        total += t.update(1) - t.y
+        k = keys[i & 3]
+        counts[k] = counts.get(k, 0) + 1
+    return total + sum(t.hits for t in tracks) + counts['up']
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (1, 1000),
+    (100, 100): (1, 5000),
+    (1000, 1000): (10, 10000),
+    (5000, 1000): (20, 20000),
+}
+
+def bm_setup(params):
+    state = None
+    def run():
+        nonlocal state
+        for _ in range(params[0]):
+            state = benchmark(params[1])
+    def result():
+        return params[0] * params[1], state
+    return run, result
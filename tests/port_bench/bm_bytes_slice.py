@@ -0,0 +1,39 @@
+# bytes and bytearray slicing, memoryview slices, find() and slice assignment, the work of
+# splitting packets and frame rows.
+
+
+def benchmark(n, buf):
+    mv = memoryview(buf)
+    out = bytearray(64)
+    acc = 0
+    for i in range(n):
+        o = (i * 7) & 255
+        line = buf[o:o + 32]
+        acc += line[3] + len(line)
+        acc += mv[o + 1:o + 17][5]
+        out[4:20] = line[:16]
+        acc += buf.find(b'\x2a', o)
+        acc &= 0xffffff
+    return acc + out[7]
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (1, 1000),
+    (100, 100): (1, 5000),
+    (1000, 1000): (10, 10000),
+    (5000, 1000): (20, 20000),
+}
+
+def bm_setup(params):
+    buf = bytes((i * 31 + 7) & 255 for i in range(320))
+    state = None
+    def run():
+        nonlocal state
+        for _ in range(params[0]):
+            state = benchmark(params[1], buf)
+    def result():
+        return params[0] * params[1], state
+    return run, result
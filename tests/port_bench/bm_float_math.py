@@ -0,0 +1,41 @@
+# Float arithmetic and libm calls. The result counts identities that hold to 1e-3, so it is
+# the same with the boards' single precision floats as with CPython's doubles.
+
+from math import sin, cos, sqrt, exp, log
+
+
+def benchmark(n):
+    ok = 0
+    for i in range(1, n + 1):
+        x = i * 0.01
+        s = sin(x)
+        c = cos(x)
+        if abs(s * s + c * c - 1.0) < 1e-3:
+            ok += 1
+        r = sqrt(x)
+        if abs(r * r - x) < 1e-3 * x:
+            ok += 1
+        if abs(exp(log(x)) - x) < 1e-3 * x:
+            ok += 1
+    return ok
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (1, 300),
+    (100, 100): (1, 1500),
+    (1000, 1000): (10, 3000),
+    (5000, 1000): (20, 6000),
+}
+
+def bm_setup(params):
+    state = None
+    def run():
+        nonlocal state
+        for _ in range(params[0]):
+            state = benchmark(params[1])
+    def result():
+        return params[0] * params[1], state
+    return run, result
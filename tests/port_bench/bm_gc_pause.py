@@ -0,0 +1,32 @@
+# GC pause: the time of a full collection with a live heap of small lists, tuples and dicts,
+# as a script that keeps its detections and tracks across frames has. The score is
+# collections per second.
+
+import gc
+
+
+def build(n):
+    live = []
+    for i in range(n):
+        live.append((i, [i, i + 1], {'id': i}))
+    return live
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (10, 100),
+    (100, 100): (20, 500),
+    (1000, 1000): (50, 5000),
+    (5000, 1000): (100, 10000),
+}
+
+def bm_setup(params):
+    live = build(params[1])
+    def run():
+        for _ in range(params[0]):
+            gc.collect()
+    def result():
+        return params[0], len(live)
+    return run, result
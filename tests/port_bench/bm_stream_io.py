@@ -0,0 +1,43 @@
+# Stream I/O through io.BytesIO: small writes, seek, read() and readinto(), the path of
+# telemetry records and of parsing a received message.
+
+try:
+    import uio as io
+except ImportError:
+    import io
+
+
+def benchmark(n):
+    rec = b'x=%d,y=%d\n'
+    buf = bytearray(16)
+    acc = 0
+    s = io.BytesIO()
+    for i in range(n):
+        s.write(rec % (i, i & 127))
+        if (i & 63) == 63:
+            s.seek(0)
+            acc += len(s.read(24))
+            acc += s.readinto(buf)
+            s.seek(0)
+    return acc + len(s.getvalue())
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (1, 500),
+    (100, 100): (1, 2000),
+    (1000, 1000): (10, 5000),
+    (5000, 1000): (20, 10000),
+}
+
+def bm_setup(params):
+    state = None
+    def run():
+        nonlocal state
+        for _ in range(params[0]):
+            state = benchmark(params[1])
+    def result():
+        return params[0] * params[1], state
+    return run, result
@@ -0,0 +1,38 @@
+# Bytecode dispatch: locals, small int arithmetic, compares, branches and calls.
+
+def step(a, b):
+    return (a + b) & 0xffff
+
+
+def benchmark(n):
+    acc = 0
+    i = 0
+    while i < n:
+        acc = step(acc, i)
+        if acc > 1000:
+            acc -= i >> 2
+        else:
+            acc ^= 3
+        i += 1
+    return acc
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (1, 2000),
+    (100, 100): (1, 10000),
+    (1000, 1000): (10, 20000),
+    (5000, 1000): (20, 50000),
+}
+
+def bm_setup(params):
+    state = None
+    def run():
+        nonlocal state
+        for _ in range(params[0]):
+            state = benchmark(params[1])
+    def result():
+        return params[0] * params[1], state
+    return run, result
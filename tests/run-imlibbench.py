@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+
+# Runs the imlib benchmarks in imlib_bench/ on an OpenMV board over pyboard.py, or with
+# --host on the omv host port (ports/omv_host), at PC speed for profiling and CI.
+#
+# Every benchmark times one call per frame size and pixel format on a synthetic frame that
+# is drawn the same way on every run, so builds can be compared. The results are one JSON
+# document, keyed by benchmark then "SIZE/format", with the average and standard deviation
+# of the times in microseconds. Compare two of them with --diff.
+
+import os
+import sys
+import json
+import argparse
+import subprocess
+import tempfile
+from glob import glob
+
+sys.path.append('../tools')
+import pyboard
+
+BENCH_SCRIPT_DIR = 'imlib_bench/'
+SIZES = ('QQVGA', 'QVGA', 'VGA')
+FORMATS = ('gray', 'rgb565')
+
+def compute_stats(lst):
+    avg = sum(lst) / len(lst)
+    var = max(0, sum(x * x for x in lst) / len(lst) - avg ** 2)
+    return avg, var ** 0.5
+
+def run_script_host(prog, script):
+    with tempfile.NamedTemporaryFile(suffix='.py', delete=False) as f:
+        f.write(script)
+    try:
+        p = subprocess.run([prog, f.name], stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    finally:
+        os.unlink(f.name)
+    output = str(p.stdout.strip(), 'ascii', 'replace')
+    if p.returncode != 0:
+        return None, 'CRASH: %r' % (output.splitlines()[-1:],)
+    return output, None
+
+# pyb is a Pyboard, or the path of the host port's executable
+def run_script(pyb, script):
+    if isinstance(pyb, str):
+        return run_script_host(pyb, script)
+    try:
+        pyb.enter_raw_repl()
+        return str(pyb.exec_(script).strip(), 'ascii'), None
+    except pyboard.PyboardError as er:
+        return None, 'CRASH: %r' % (er,)
+
+def run_benchmark(pyb, test_file, sizes, formats, n_average, nn_model):
+    with open(test_file, 'rb') as f:
+        script = f.read()
+    with open(BENCH_SCRIPT_DIR + 'benchrun.py', 'rb') as f:
+        script += f.read()
+    if nn_model:
+        script += ('bm_nn_model = %r\n' % nn_model).encode()
+    script += b'bm_run(%r, %r)\n' % (tuple(sizes), tuple(formats))
+
+    # the frame is rebuilt every run, so in place filters always start from the same pixels
+    runs = {}
+    for _ in range(n_average):
+        output, err = run_script(pyb, script)
+        if err:
+            return {'error': err}
+        for line in output.splitlines():
+            try:
+                r = json.loads(line)
+            except ValueError:
+                return {'error': 'CRASH: %r' % output}
+            runs.setdefault('%s/%s' % (r['size'], r['format']), []).append(r)
+
+    results = {}
+    for key, rs in runs.items():
+        if 'skip' in rs[0]:
+            if rs[0]['skip'] != 'n/a':
+                results[key] = {'skip': rs[0]['skip']}
+            continue
+        if any('skip' in r or r['result'] != rs[0]['result'] for r in rs):
+            results[key] = {'error': 'FAIL self'}
+            continue
+        avg, sd = compute_stats([r['us'] for r in rs])
+        results[key] = {'us': round(avg, 1), 'sd': round(sd, 1), 'result': rs[0]['result']}
+    return results
+
+def run_benchmarks(pyb, args, test_list):
+    out = {'average': args.average, 'results': {}}
+    if isinstance(pyb, str):
+        output, err = str(subprocess.check_output([pyb, '--version']).strip(), 'ascii'), None
+    else:
+        output, err = run_script(pyb, b'import os\nprint(os.uname().version)\n')
+    out['firmware'] = output if err is None else None
+    for test_file in sorted(test_list):
+        name = os.path.basename(test_file)[:-3]
+        print(name + ': ', end='', file=sys.stderr)
+        sys.stderr.flush()
+        res = run_benchmark(pyb, test_file, args.sizes, args.formats, args.average, args.nn)
+        out['results'][name] = res
+        if 'error' in res:
+            print(res['error'], file=sys.stderr)
+        else:
+            print(' '.join('%s=%s' % (k, v.get('us', v.get('skip', v.get('error'))))
+                           for k, v in sorted(res.items())), file=sys.stderr)
+    return out
+
+def compute_diff(file1, file2):
+    with open(file1) as f:
+        r1 = json.load(f)['results']
+    with open(file2) as f:
+        r2 = json.load(f)['results']
+
+    print('diff of microsecond times (lower is better)')
+    print('{:32} {:>10} -> {:>10}   {:>7}% (error%)'.format('', file1[-10:], file2[-10:], 'diff'))
+    for name in sorted(set(r1) & set(r2)):
+        for key in sorted(set(r1[name]) & set(r2[name])):
+            e1, e2 = r1[name][key], r2[name][key]
+            if 'us' not in e1 or 'us' not in e2:
+                continue
+            av1, sd1, av2, sd2 = e1['us'], e1['sd'], e2['us'], e2['sd']
+            percent = 100 * (av2 - av1) / av1
+            percent_sd = 100 * (sd1 ** 2 + sd2 ** 2) ** 0.5 / av1
+            flag = '' if e1['result'] == e2['result'] else '  (result changed)'
+            print('{:32} {:10.1f} -> {:10.1f} : {:+7.2f}% (+/-{:.2f}%){}'.format(
+                name + ' ' + key, av1, av2, percent, percent_sd, flag))
+
+def main():
+    cmd_parser = argparse.ArgumentParser(description='Run imlib benchmarks on an OpenMV board')
+    cmd_parser.add_argument('-d', '--device', default='/dev/ttyACM0', help='the device for pyboard.py')
+    cmd_parser.add_argument('--host', metavar='PROG', help='run on the omv host port PROG instead of a board')
+    cmd_parser.add_argument('-a', '--average', type=int, default=8, help='averaging number')
+    cmd_parser.add_argument('-o', '--output', help='write the JSON results to this file, default stdout')
+    cmd_parser.add_argument('--sizes', default=','.join(SIZES), help='frame sizes, default %(default)s')
+    cmd_parser.add_argument('--formats', default=','.join(FORMATS), help='pixel formats, default %(default)s')
+    cmd_parser.add_argument('--nn', help='path of a network on the board (or host) for bm_nn')
+    cmd_parser.add_argument('--diff', nargs=2, metavar='JSON', help='compare two previous results')
+    cmd_parser.add_argument('files', nargs='*', help='input test files')
+    args = cmd_parser.parse_args()
+
+    if args.diff:
+        compute_diff(*args.diff)
+        sys.exit(0)
+
+    args.sizes = args.sizes.split(',')
+    args.formats = args.formats.split(',')
+    for s in args.sizes:
+        if s not in SIZES:
+            cmd_parser.error('unknown size %s' % s)
+    for f in args.formats:
+        if f not in FORMATS:
+            cmd_parser.error('unknown format %s' % f)
+
+    if len(args.files) == 0:
+        tests = glob(BENCH_SCRIPT_DIR + 'bm_*.py')
+    else:
+        tests = args.files
+
+    if args.host:
+        out = run_benchmarks(args.host, args, tests)
+    else:
+        pyb = pyboard.Pyboard(args.device)
+        out = run_benchmarks(pyb, args, tests)
+        pyb.exit_raw_repl()
+
+    text = json.dumps(out, indent=1, sort_keys=True)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text + '\n')
+    else:
+        print(text)
+
+if __name__ == '__main__':
+    main()
@@ -8,6 +8,7 @@ import os
 import subprocess
 import sys
 import argparse
+import tempfile
 from glob import glob
 
 sys.path.append('../tools')
@@ -24,6 +25,14 @@ else:
 PYTHON_TRUTH = CPYTHON3
 
 BENCH_SCRIPT_DIR = 'perf_bench/'
+PORT_BENCH_DIR = 'port_bench/'
+
+# N, M of the boards of the nxp ports, M is the GC heap the board's build leaves a script
+BOARDS = {
+    'omvrt1': (600, 100),
+    'imxrtevk105x': (600, 100),
+    'lpx54608': (180, 80),
+}
 
 def compute_stats(lst):
     avg = 0
@@ -46,6 +55,16 @@ def run_script_on_target(target, script):
             output = target.exec_(script)
         except pyboard.PyboardError as er:
             err = er
+    elif isinstance(target, str):
+        # Run the omv host port, which takes the script as a file
+        with tempfile.NamedTemporaryFile(suffix='.py') as f:
+            f.write(script)
+            f.flush()
+            try:
+                p = subprocess.run([target, f.name], stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+                output = p.stdout
+            except OSError as er:
+                err = er
     else:
         # Run local executable
         try:
@@ -77,6 +96,7 @@ def run_benchmark_on_target(target, script):
         return -1, -1, 'CRASH: %r' % err
 
 def run_benchmarks(target, param_n, param_m, n_average, test_list):
+    lines = []
     skip_complex = run_feature_test(target, 'complex') != 'complex'
     skip_native = run_feature_test(target, 'native_check') != ''
 
@@ -134,12 +154,15 @@ def run_benchmarks(target, param_n, param_m, n_average, test_list):
             t_avg, t_sd = compute_stats(times)
             s_avg, s_sd = compute_stats(scores)
             print('{:.2f} {:.4f} {:.2f} {:.4f}'.format(t_avg, 100 * t_sd / t_avg, s_avg, 100 * s_sd / s_avg))
+            lines.append('{}: {:.2f} {:.4f} {:.2f} {:.4f}'.format(test_file, t_avg, 100 * t_sd / t_avg, s_avg, 100 * s_sd / s_avg))
             if 0:
                 print('  times: ', times)
                 print('  scores:', scores)
 
         sys.stdout.flush()
 
+    return lines
+
 def parse_output(filename):
     with open(filename) as f:
         params = f.readline()
@@ -154,7 +177,9 @@ def parse_output(filename):
                 data.append((name,) + values)
     return n, m, data
 
-def compute_diff(file1, file2, diff_score):
+def compute_diff(file1, file2, diff_score, tolerance=None):
+    # With a tolerance, entries more than that many percent worse, beyond their error, are
+    # flagged and the number of them is returned
     # Parse output data from previous runs
     n1, m1, d1 = parse_output(file1)
     n2, m2, d2 = parse_output(file2)
@@ -171,6 +196,7 @@ def compute_diff(file1, file2, diff_score):
     print('{:24} {:>10} -> {:>10}   {:>10}   {:>7}% (error%)'.format(hdr, file1, file2, 'diff', 'diff'))
 
     # Print entries
+    regressions = 0
     while d1 and d2:
         if d1[0][0] == d2[0][0]:
             # Found entries with matching names
@@ -185,12 +211,20 @@ def compute_diff(file1, file2, diff_score):
             sd_diff = (sd1 ** 2 + sd2 ** 2) ** 0.5
             percent = 100 * av_diff / av1
             percent_sd = 100 * sd_diff / av1
-            print('{:24} {:10.2f} -> {:10.2f} : {:+10.2f} = {:+7.3f}% (+/-{:.2f}%)'.format(name, av1, av2, av_diff, percent, percent_sd))
+            worse = percent if not diff_score else -percent
+            if tolerance is not None and worse > tolerance + percent_sd:
+                regressions += 1
+                flag = ' REGRESSION'
+            else:
+                flag = ''
+            print('{:24} {:10.2f} -> {:10.2f} : {:+10.2f} = {:+7.3f}% (+/-{:.2f}%){}'.format(name, av1, av2, av_diff, percent, percent_sd, flag))
         elif d1[0][0] < d2[0][0]:
             d1.pop(0)
         else:
             d2.pop(0)
 
+    return regressions
+
 def main():
     cmd_parser = argparse.ArgumentParser(description='Run benchmarks for MicroPython')
     cmd_parser.add_argument('-t', '--diff-time', action='store_true', help='diff time outputs from a previous run')
@@ -199,35 +233,53 @@ def main():
     cmd_parser.add_argument('-d', '--device', default='/dev/ttyACM0', help='the device for pyboard.py')
     cmd_parser.add_argument('-a', '--average', default='8', help='averaging number')
     cmd_parser.add_argument('--emit', default='bytecode', help='MicroPython emitter to use (bytecode or native)')
-    cmd_parser.add_argument('N', nargs=1, help='N parameter (approximate target CPU frequency)')
-    cmd_parser.add_argument('M', nargs=1, help='M parameter (approximate target heap in kbytes)')
+    cmd_parser.add_argument('--host', metavar='PROG', help='run tests with the omv host port PROG')
+    cmd_parser.add_argument('--board', choices=sorted(BOARDS), help='N and M of a board, runs via pyboard.py unless --host is given')
+    cmd_parser.add_argument('--port', action='store_true', help='run the port suite in ' + PORT_BENCH_DIR)
+    cmd_parser.add_argument('--baseline', metavar='FILE', help='compare with the run recorded in FILE, record it there if there is none')
+    cmd_parser.add_argument('--tolerance', type=float, default=3.0, help='percent a score may drop beyond its error before --baseline fails (default 3)')
+    cmd_parser.add_argument('N', nargs='?', help='N parameter (approximate target CPU frequency)')
+    cmd_parser.add_argument('M', nargs='?', help='M parameter (approximate target heap in kbytes)')
     cmd_parser.add_argument('files', nargs='*', help='input test files')
     args = cmd_parser.parse_args()
 
     if args.diff_time or args.diff_score:
-        compute_diff(args.N[0], args.M[0], args.diff_score)
+        compute_diff(args.N, args.M, args.diff_score)
         sys.exit(0)
 
+    if args.board:
+        # a board takes the place of N and M, the positionals are files
+        args.files = [a for a in (args.N, args.M) if a is not None] + args.files
+        args.N, args.M = BOARDS[args.board]
+        args.pyboard = args.host is None
+    elif args.N is None or args.M is None:
+        cmd_parser.error('N and M, or --board, are required')
+
     # N, M = 50, 25 # esp8266
     # N, M = 100, 100 # pyboard, esp32
+    # N, M = 180, 80 # lpx54608 (LPC54608)
+    # N, M = 600, 100 # omvrt1, imxrtevk105x (i.MX RT1050/1060)
     # N, M = 1000, 1000 # PC
-    N = int(args.N[0])
-    M = int(args.M[0])
+    N = int(args.N)
+    M = int(args.M)
     n_average = int(args.average)
 
-    if args.pyboard:
+    if args.host:
+        target = args.host
+    elif args.pyboard:
         target = pyboard.Pyboard(args.device)
         target.enter_raw_repl()
     else:
         target = [MICROPYTHON, '-X', 'emit=' + args.emit]
 
     if len(args.files) == 0:
+        bench_dir = PORT_BENCH_DIR if args.port else BENCH_SCRIPT_DIR
         tests_skip = ('benchrun.py',)
         if M <= 25:
             # These scripts are too big to be compiled by the target
             tests_skip += ('bm_chaos.py', 'bm_hexiom.py', 'misc_raytrace.py')
         tests = sorted(
-            BENCH_SCRIPT_DIR + test_file for test_file in os.listdir(BENCH_SCRIPT_DIR)
+            bench_dir + test_file for test_file in os.listdir(bench_dir)
                 if test_file.endswith('.py') and test_file not in tests_skip
         )
     else:
@@ -235,11 +287,28 @@ def main():
 
     print('N={} M={} n_average={}'.format(N, M, n_average))
 
-    run_benchmarks(target, N, M, n_average, tests)
+    lines = run_benchmarks(target, N, M, n_average, tests)
 
     if isinstance(target, pyboard.Pyboard):
         target.exit_raw_repl()
         target.close()
 
+    if args.baseline:
+        results = '\n'.join(['N={} M={} n_average={}'.format(N, M, n_average)] + lines) + '\n'
+        if not os.path.exists(args.baseline):
+            os.makedirs(os.path.dirname(args.baseline) or '.', exist_ok=True)
+            with open(args.baseline, 'w') as f:
+                f.write(results)
+            print('recorded baseline', args.baseline)
+        else:
+            with tempfile.NamedTemporaryFile('w', suffix='.txt') as f:
+                f.write(results)
+                f.flush()
+                print()
+                regressions = compute_diff(args.baseline, f.name, True, args.tolerance)
+            if regressions:
+                print('{} regression(s) against {}'.format(regressions, args.baseline))
+                sys.exit(1)
+
 if __name__ == "__main__":
     main()
@@ -43,6 +43,7 @@ else:
 
 import sys
 import struct
+import zlib
 from collections import namedtuple
 
 sys.path.append(sys.path[0] + '/../py')
@@ -74,6 +75,13 @@ global_qstrs = [None] # MP_QSTRnull should never be referenced
 for n in qstrutil.static_qstr_list:
     global_qstrs.append(QStrType(n))
 
+def global_qstr(s):
+    for q in global_qstrs[1:]:
+        if q.str == s:
+            return q
+    global_qstrs.append(QStrType(s))
+    return global_qstrs[-1]
+
 class QStrWindow:
     def __init__(self, size):
         self.window = []
@@ -117,6 +125,25 @@ MP_BC_LOAD_GLOBAL = 0x12
 MP_BC_LOAD_ATTR = 0x13
 MP_BC_STORE_ATTR = 0x18
 
+# superinstructions, with a local number byte after the qstr / 3 bytes of operands
+MP_BC_LOAD_FAST_METHOD = 0x1d
+MP_BC_BINARY_OP_FAST_INT = 0x6a
+
+# a module body made of only these can be frozen as ROM globals
+MP_BC_LOAD_CONST_FALSE = 0x50
+MP_BC_LOAD_CONST_NONE = 0x51
+MP_BC_LOAD_CONST_TRUE = 0x52
+MP_BC_LOAD_CONST_SMALL_INT = 0x22
+MP_BC_LOAD_CONST_STRING = 0x10
+MP_BC_LOAD_CONST_OBJ = 0x23
+MP_BC_LOAD_CONST_SMALL_INT_MULTI = 0x70
+MP_BC_STORE_NAME = 0x16
+MP_BC_STORE_GLOBAL = 0x17
+MP_BC_RETURN_VALUE = 0x63
+MP_BC_MAKE_FUNCTION = 0x32
+
+MP_SCOPE_FLAG_GENERATOR = 0x01
+
 # this function mirrors that in py/bc.c
 def mp_opcode_format(bytecode, ip, count_var_uint):
     opcode = bytecode[ip]
@@ -129,7 +156,11 @@ def mp_opcode_format(bytecode, ip, count_var_uint):
                 or opcode == MP_BC_LOAD_ATTR
                 or opcode == MP_BC_STORE_ATTR):
                 ip += 1
+        if opcode == MP_BC_LOAD_FAST_METHOD:
+            ip += 1
         ip += 3
+    elif opcode == MP_BC_BINARY_OP_FAST_INT:
+        ip += 4
     else:
         extra_byte = (opcode & MP_BC_MASK_EXTRA_BYTE) == 0
         ip += 1
@@ -315,24 +346,28 @@ class RawCode(object):
             for i in range(len(self.objs)):
                 if self.objs[i] is MPFunTable:
                     print('    &mp_fun_table,')
-                elif type(self.objs[i]) is float:
-                    print('#if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_A || MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_B')
-                    print('    MP_ROM_PTR(&const_obj_%s_%u),' % (self.escaped_name, i))
-                    print('#elif MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_C')
-                    n = struct.unpack('<I', struct.pack('<f', self.objs[i]))[0]
-                    n = ((n & ~0x3) | 2) + 0x80800000
-                    print('    (mp_rom_obj_t)(0x%08x),' % (n,))
-                    print('#elif MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_D')
-                    n = struct.unpack('<Q', struct.pack('<d', self.objs[i]))[0]
-                    n += 0x8004000000000000
-                    print('    (mp_rom_obj_t)(0x%016x),' % (n,))
-                    print('#endif')
                 else:
-                    print('    MP_ROM_PTR(&const_obj_%s_%u),' % (self.escaped_name, i))
+                    self.print_const_obj_ref(i, '    %s,')
             for rc in self.raw_codes:
                 print('    MP_ROM_PTR(&raw_code_%s),' % rc.escaped_name)
             print('};')
 
+    def print_const_obj_ref(self, i, fmt):
+        if type(self.objs[i]) is float:
+            print('#if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_A || MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_B')
+            print(fmt % ('MP_ROM_PTR(&const_obj_%s_%u)' % (self.escaped_name, i)))
+            print('#elif MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_C')
+            n = struct.unpack('<I', struct.pack('<f', self.objs[i]))[0]
+            n = ((n & ~0x3) | 2) + 0x80800000
+            print(fmt % ('(mp_rom_obj_t)(0x%08x)' % (n,)))
+            print('#elif MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_D')
+            n = struct.unpack('<Q', struct.pack('<d', self.objs[i]))[0]
+            n += 0x8004000000000000
+            print(fmt % ('(mp_rom_obj_t)(0x%016x)' % (n,)))
+            print('#endif')
+        else:
+            print(fmt % ('MP_ROM_PTR(&const_obj_%s_%u)' % (self.escaped_name, i)))
+
     def freeze_module(self, qstr_links=(), type_sig=0):
         # generate module
         if self.simple_name.str != '<module>':
@@ -390,6 +425,8 @@ class RawCodeBytecode(RawCode):
         print('STATIC ', end='')
         if not config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE:
             print('const ', end='')
+        else:
+            print('MP_FROZEN_BC_CONST ', end='')
         print('byte fun_data_%s[%u] = {' % (self.escaped_name, len(self.bytecode)))
         print('   ', end='')
         for i in range(self.ip2):
@@ -416,6 +453,83 @@ class RawCodeBytecode(RawCode):
         self.freeze_constants()
         self.freeze_module()
 
+    def xip_bytecode(self, qstr_num):
+        # the bytecode with its qstrs numbered as in the firmware plus image
+        bc = bytearray(self.bytecode)
+        def link(ip, q):
+            n = qstr_num[q.str]
+            bc[ip] = n & 0xff
+            bc[ip + 1] = n >> 8
+        link(self.ip2, self.simple_name)
+        link(self.ip2 + 2, self.source_file)
+        ip = self.ip
+        while ip < len(bc):
+            f, sz = mp_opcode_format(bc, ip, True)
+            if f == 1:
+                link(ip + 1, self._unpack_qstr(ip + 1))
+            ip += sz
+        return bc
+
+    def module_bindings(self):
+        # If the body (of a module) only binds constants and functions return
+        # the (name, value) pairs it binds, in order, else None.
+        bindings = []
+        value = None
+        ip = self.ip
+        while ip < len(self.bytecode):
+            op = self.bytecode[ip]
+            f, sz = mp_opcode_format(self.bytecode, ip, True)
+            if value is not None:
+                if op == MP_BC_STORE_NAME or op == MP_BC_STORE_GLOBAL:
+                    name = self._unpack_qstr(ip + 1)
+                    bindings = [b for b in bindings if b[0].str != name.str] + [(name, value)]
+                    value = None
+                elif op == MP_BC_RETURN_VALUE and value == ('rom', 'MP_ROM_PTR(&mp_const_none_obj)'):
+                    return bindings
+                else:
+                    return None
+            elif op == MP_BC_LOAD_CONST_FALSE:
+                value = ('rom', 'MP_ROM_PTR(&mp_const_false_obj)')
+            elif op == MP_BC_LOAD_CONST_NONE:
+                value = ('rom', 'MP_ROM_PTR(&mp_const_none_obj)')
+            elif op == MP_BC_LOAD_CONST_TRUE:
+                value = ('rom', 'MP_ROM_PTR(&mp_const_true_obj)')
+            elif MP_BC_LOAD_CONST_SMALL_INT_MULTI <= op < MP_BC_LOAD_CONST_SMALL_INT_MULTI + 64:
+                value = ('rom', 'MP_ROM_INT(%d)' % (op - MP_BC_LOAD_CONST_SMALL_INT_MULTI - 16))
+            elif op == MP_BC_LOAD_CONST_SMALL_INT:
+                num = -1 if self.bytecode[ip + 1] & 0x40 else 0
+                i = ip + 1
+                while True:
+                    num = (num << 7) | (self.bytecode[i] & 0x7f)
+                    if not self.bytecode[i] & 0x80:
+                        break
+                    i += 1
+                value = ('rom', 'MP_ROM_INT(%d)' % num)
+            elif op == MP_BC_LOAD_CONST_STRING:
+                value = ('rom', 'MP_ROM_QSTR(%s)' % self._unpack_qstr(ip + 1).qstr_id)
+            elif op in (MP_BC_LOAD_CONST_OBJ, MP_BC_MAKE_FUNCTION):
+                i = ip + 1
+                unum = 0
+                while True:
+                    unum = (unum << 7) | (self.bytecode[i] & 0x7f)
+                    if not self.bytecode[i] & 0x80:
+                        break
+                    i += 1
+                unum -= len(self.qstrs)
+                if op == MP_BC_LOAD_CONST_OBJ:
+                    if self.objs[unum] is MPFunTable:
+                        return None
+                    value = ('obj', unum)
+                else:
+                    rc = self.raw_codes[unum - len(self.objs)]
+                    if not isinstance(rc, RawCodeBytecode) or rc.prelude[2] & MP_SCOPE_FLAG_GENERATOR:
+                        return None
+                    value = ('fun', rc)
+            else:
+                return None
+            ip += sz
+        return None
+
 class RawCodeNative(RawCode):
     def __init__(self, code_kind, fun_data, prelude_offset, prelude, qstr_links, qstrs, objs, raw_codes, type_sig):
         super(RawCodeNative, self).__init__(code_kind, fun_data, prelude_offset, qstrs, objs, raw_codes)
@@ -667,11 +781,18 @@ def read_raw_code(f, qstr_win):
         qstrs = [read_qstr(f, qstr_win) for _ in range(prelude[3] + prelude[4])]
         if kind != MP_CODE_BYTECODE:
             objs.append(MPFunTable)
+        obj_pos = f.tell()
         objs.extend([read_obj(f) for _ in range(n_obj)])
+        # the encoded objects as well, for --xip
+        obj_end = f.tell()
+        f.seek(obj_pos)
+        obj_data = f.read(obj_end - obj_pos)
         raw_codes = [read_raw_code(f, qstr_win) for _ in range(n_raw_code)]
 
     if kind == MP_CODE_BYTECODE:
-        return RawCodeBytecode(fun_data.buf, qstrs, objs, raw_codes)
+        rc = RawCodeBytecode(fun_data.buf, qstrs, objs, raw_codes)
+        rc.obj_data = obj_data
+        return rc
     else:
         return RawCodeNative(kind, fun_data.buf, prelude_offset, prelude, qstr_links, qstrs, objs, raw_codes, type_sig)
 
@@ -686,7 +807,8 @@ def read_mpy(filename):
         qw_size = read_uint(f)
         config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE = (feature_byte & 1) != 0
         config.MICROPY_PY_BUILTINS_STR_UNICODE = (feature_byte & 2) != 0
-        mpy_native_arch = feature_byte >> 2
+        config.MICROPY_OPT_SUPERINSTRUCTIONS = (feature_byte & 0x40) != 0
+        mpy_native_arch = feature_byte >> 2 & 0xf
         if mpy_native_arch != MP_NATIVE_ARCH_NONE:
             if config.native_arch == MP_NATIVE_ARCH_NONE:
                 config.native_arch = mpy_native_arch
@@ -703,7 +825,19 @@ def dump_mpy(raw_codes):
     for rc in raw_codes:
         rc.dump()
 
-def freeze_mpy(base_qstrs, raw_codes):
+def frozen_qstrs(base_qstrs, raw_codes):
+    # the qstrs of mp_qstr_frozen_const_pool, in order, and the modules that can
+    # be imported as ROM globals (their __name__ qstrs are needed)
+    rom_globals = []
+    for rc in raw_codes:
+        if isinstance(rc, RawCodeBytecode):
+            bindings = rc.module_bindings()
+            if bindings is not None:
+                name = rc.source_file.str[:-3]
+                if name.endswith('/__init__'):
+                    name = name[:-9]
+                rom_globals.append((rc, global_qstr(name.replace('/', '.')), bindings))
+
     # add to qstrs
     new = {}
     for q in global_qstrs:
@@ -712,12 +846,18 @@ def freeze_mpy(base_qstrs, raw_codes):
             continue
         new[q.qstr_esc] = (len(new), q.qstr_esc, q.str)
     new = sorted(new.values(), key=lambda x: x[0])
+    return new, rom_globals
+
+def freeze_mpy(base_qstrs, raw_codes):
+    new, rom_globals = frozen_qstrs(base_qstrs, raw_codes)
 
     print('#include "py/mpconfig.h"')
     print('#include "py/objint.h"')
     print('#include "py/objstr.h"')
     print('#include "py/emitglue.h"')
     print('#include "py/nativeglue.h"')
+    print('#include "py/objfun.h"')
+    print('#include "py/frozenmod.h"')
     print()
 
     print('#if MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE != %u' % config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE)
@@ -725,6 +865,21 @@ def freeze_mpy(base_qstrs, raw_codes):
     print('#endif')
     print()
 
+    if config.MICROPY_OPT_SUPERINSTRUCTIONS:
+        print('#if !MICROPY_OPT_SUPERINSTRUCTIONS')
+        print('#error "bytecode uses superinstructions, MICROPY_OPT_SUPERINSTRUCTIONS needed"')
+        print('#endif')
+        print()
+
+    if config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE:
+        # with a side table the VM doesn't write read-only bytecode, so keep it in ROM
+        print('#if MICROPY_OPT_CACHE_MAP_LOOKUP_SIDE_TABLE')
+        print('#define MP_FROZEN_BC_CONST const')
+        print('#else')
+        print('#define MP_FROZEN_BC_CONST')
+        print('#endif')
+        print()
+
     print('#if MICROPY_LONGINT_IMPL != %u' % config.MICROPY_LONGINT_IMPL)
     print('#error "incompatible MICROPY_LONGINT_IMPL"')
     print('#endif')
@@ -795,6 +950,60 @@ def freeze_mpy(base_qstrs, raw_codes):
         print('    &raw_code_%s,' % rc.escaped_name)
     print('};')
 
+    # globals of the modules needing no execution, their functions are bound to
+    # the RAM dict which starts out as a copy-on-write map of the ROM table
+    print()
+    print('#if MICROPY_MODULE_FROZEN_GLOBALS')
+    print('mp_obj_dict_t mp_frozen_mpy_globals_ram[%u];' % max(len(rom_globals), 1))
+    for k, (rc, name, bindings) in enumerate(rom_globals):
+        for _, (kind, val) in bindings:
+            if kind == 'fun':
+                print('STATIC const mp_obj_fun_bc_t fun_obj_%s = {' % val.escaped_name)
+                print('    .base = {&mp_type_fun_bc},')
+                print('    .globals = &mp_frozen_mpy_globals_ram[%u],' % k)
+                print('    .bytecode = fun_data_%s,' % val.escaped_name)
+                if len(val.qstrs) + len(val.objs) + len(val.raw_codes):
+                    print('    .const_table = (mp_uint_t*)const_table_data_%s,' % val.escaped_name)
+                else:
+                    print('    .const_table = NULL,')
+                print('    #if MICROPY_PY_SYS_SETTRACE')
+                print('    .rc = &raw_code_%s,' % val.escaped_name)
+                print('    #endif')
+                print('};')
+        print('STATIC const mp_rom_map_elem_t globals_table_%s[] = {' % rc.escaped_name)
+        print('    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(%s) },' % name.qstr_id)
+        print('    #if MICROPY_PY___FILE__')
+        print('    { MP_ROM_QSTR(MP_QSTR___file__), MP_ROM_QSTR(%s) },' % rc.source_file.qstr_id)
+        print('    #endif')
+        for key, (kind, val) in bindings:
+            entry = '    { MP_ROM_QSTR(%s), %%s },' % key.qstr_id
+            if kind == 'rom':
+                print(entry % val)
+            elif kind == 'obj':
+                rc.print_const_obj_ref(val, entry)
+            else:
+                print(entry % ('MP_ROM_PTR(&fun_obj_%s)' % val.escaped_name))
+        print('};')
+        print('STATIC const mp_obj_dict_t globals_%s = {' % rc.escaped_name)
+        print('    .base = {&mp_type_dict},')
+        print('    .map = {')
+        print('        .all_keys_are_qstrs = 1,')
+        print('        .is_fixed = 1,')
+        print('        .is_ordered = 1,')
+        print('        .is_cow = 1,')
+        print('        .used = MP_ARRAY_SIZE(globals_table_%s),' % rc.escaped_name)
+        print('        .alloc = MP_ARRAY_SIZE(globals_table_%s),' % rc.escaped_name)
+        print('        .table = (mp_map_elem_t*)(mp_rom_map_elem_t*)globals_table_%s,' % rc.escaped_name)
+        print('    },')
+        print('};')
+    print('const size_t mp_frozen_mpy_globals_len = %u;' % len(rom_globals))
+    print('const mp_frozen_globals_t mp_frozen_mpy_globals[] = {')
+    for k, (rc, _, _) in enumerate(rom_globals):
+        print('    {&raw_code_%s, &globals_%s, &mp_frozen_mpy_globals_ram[%u]},' % (rc.escaped_name, rc.escaped_name, k))
+    print('    {NULL, NULL, NULL},')
+    print('};')
+    print('#endif')
+
 def merge_mpy(raw_codes, output_file):
     assert len(raw_codes) <= 31 # so var-uints all fit in 1 byte
     merged_mpy = bytearray()
@@ -806,7 +1015,8 @@ def merge_mpy(raw_codes, output_file):
         header = bytearray(5)
         header[0] = ord('M')
         header[1] = config.MPY_VERSION
-        header[2] = (config.native_arch << 2
+        header[2] = (config.MICROPY_OPT_SUPERINSTRUCTIONS << 6
+            | config.native_arch << 2
             | config.MICROPY_PY_BUILTINS_STR_UNICODE << 1
             | config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE)
         header[3] = config.mp_small_int_bits
@@ -844,6 +1054,89 @@ def merge_mpy(raw_codes, output_file):
         with open(output_file, 'wb') as f:
             f.write(merged_mpy)
 
+def xip_mpy(base_qstrs, frozen, raw_codes, output_file):
+    # The firmware's qstrs are MP_QSTRnull, mp_qstr_const_pool (as in
+    # qstrdefs.generated.h) then mp_qstr_frozen_const_pool, the image's follow.
+    base = [q[2] for q in sorted(base_qstrs.values(), key=lambda x: x[0])] + [q[2] for q in frozen]
+    qstr_num = {}
+    for i, s in enumerate(base):
+        qstr_num.setdefault(s, i + 1)
+    new = []
+    for q in global_qstrs[1:]:
+        if q.str not in qstr_num:
+            qstr_num[q.str] = len(base) + 1 + len(new)
+            new.append(q.str)
+    if len(base) + 1 + len(new) > 0x10000:
+        raise Exception('too many qstrs for 16 bit qstrs in bytecode')
+
+    # as xip_base_hash() in py/persistentcode.c
+    base_hash = 5381
+    for s in base:
+        base_hash = ((base_hash * 33) ^ qstrutil.compute_hash(bytes_cons(s, 'utf8'), config.MICROPY_QSTR_BYTES_IN_HASH)) & 0xffffffff
+
+    offsets_pos = 36
+    image = bytearray(offsets_pos + 4 * (len(new) + len(raw_codes)))
+    image[0:4] = b'XMPY'
+    image[4] = config.MPY_VERSION
+    image[5] = (config.MICROPY_OPT_SUPERINSTRUCTIONS << 6
+        | config.MICROPY_PY_BUILTINS_STR_UNICODE << 1
+        | config.MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE)
+    image[6] = config.mp_small_int_bits
+    image[7] = config.MICROPY_QSTR_BYTES_IN_HASH | config.MICROPY_QSTR_BYTES_IN_LEN << 4
+    # the length and CRC at 8 and 12 are filled in at the end
+    struct.pack_into('<IIII', image, 16, len(base) + 1, base_hash, len(new), len(raw_codes))
+
+    def set_offset(i, pos):
+        struct.pack_into('<I', image, offsets_pos + 4 * i, pos)
+
+    def align():
+        image.extend(bytes(-len(image) & 3))
+
+    for i, s in enumerate(new):
+        set_offset(i, len(image))
+        qbytes = bytes_cons(s, 'utf8')
+        if len(qbytes) >= 1 << (8 * config.MICROPY_QSTR_BYTES_IN_LEN):
+            raise Exception('qstr is too long: ' + s)
+        image.extend(struct.pack('<I', qstrutil.compute_hash(qbytes, config.MICROPY_QSTR_BYTES_IN_HASH))[:config.MICROPY_QSTR_BYTES_IN_HASH])
+        image.extend(struct.pack('<I', len(qbytes))[:config.MICROPY_QSTR_BYTES_IN_LEN])
+        image.extend(qbytes + b'\0')
+
+    struct.pack_into('<I', image, 32, len(image))
+    for rc in raw_codes:
+        image.extend(bytes_cons(rc.source_file.str, 'utf8') + b'\0')
+    image.extend(b'\0')
+
+    # children first, a record holds their offsets
+    def write_raw_code(rc):
+        if not isinstance(rc, RawCodeBytecode):
+            raise FreezeError(rc, 'native code can\'t run from an XIP image')
+        children = [write_raw_code(c) for c in rc.raw_codes]
+        align()
+        fun_data = len(image)
+        image.extend(rc.xip_bytecode(qstr_num))
+        objs = len(image)
+        image.extend(rc.obj_data)
+        align()
+        pos = len(image)
+        image.extend(struct.pack('<IIIHHHH', fun_data, len(rc.bytecode), objs,
+            len(rc.objs), len(children), len(rc.qstrs), rc.prelude[2]))
+        image.extend(struct.pack('<%uI' % len(children), *children))
+        image.extend(struct.pack('<%uH' % len(rc.qstrs), *[qstr_num[global_qstrs[q].str] for q in rc.qstrs]))
+        return pos
+
+    for i, rc in enumerate(raw_codes):
+        set_offset(len(new) + i, write_raw_code(rc))
+
+    # the firmware checks these before it uses anything else in the image
+    struct.pack_into('<I', image, 8, len(image))
+    struct.pack_into('<I', image, 12, zlib.crc32(image[16:]) & 0xffffffff)
+
+    if output_file is None:
+        sys.stdout.buffer.write(image)
+    else:
+        with open(output_file, 'wb') as f:
+            f.write(image)
+
 def main():
     import argparse
     cmd_parser = argparse.ArgumentParser(description='A tool to work with MicroPython .mpy files.')
@@ -853,6 +1146,10 @@ def main():
         help='freeze files')
     cmd_parser.add_argument('--merge', action='store_true',
         help='merge multiple .mpy files into one')
+    cmd_parser.add_argument('--xip', action='store_true',
+        help='link files into a .xmpy image that runs in place, for the firmware of -q and --frozen')
+    cmd_parser.add_argument('--frozen', action='append', default=[],
+        help='with --xip: a .mpy file frozen into the firmware, in the order given to -f')
     cmd_parser.add_argument('-q', '--qstr-header',
         help='qstr header file to freeze against')
     cmd_parser.add_argument('-mlongint-impl', choices=['none', 'longlong', 'mpz'], default='mpz',
@@ -884,6 +1181,19 @@ def main():
         config.MICROPY_QSTR_BYTES_IN_HASH = 1
         base_qstrs = {}
 
+    if args.xip:
+        if not args.qstr_header:
+            print('--xip needs the qstr header of the firmware (-q)', file=sys.stderr)
+            sys.exit(1)
+        # the firmware's frozen qstrs come from its frozen files alone
+        frozen, _ = frozen_qstrs(base_qstrs, [read_mpy(file) for file in args.frozen])
+        try:
+            xip_mpy(base_qstrs, frozen, [read_mpy(file) for file in args.files], args.output)
+        except FreezeError as er:
+            print(er, file=sys.stderr)
+            sys.exit(1)
+        return
+
     raw_codes = [read_mpy(file) for file in args.files]
 
     if args.dump: